@@ -6,178 +6,1805 @@
 #ifndef EKF_H
 #define EKF_H
 
-#include "math/matrix.h"
+#include "ekf/ekf_config.h"
+#include "math/matrix_fixed.h"
+#include "math/matrix_sparse.h"
+#include "math/matrix_sym.h"
+#include "math/matrix_ud.h"
 #include "math/quaternion.h"
 #include "math/vector3f.h"
+#include "sys/scratch.h"
+#include "ekf/ekf_mag_calibration.h"
+#include "ekf/ekf_wmm.h"
+#include <stddef.h>
 
 /**
- * @brief EKF 상태 벡터 크기
+ * @brief 공분산 예측 참조 경로 선택
  * 
- * 상태 벡터 구성:
- * - 위치 (x, y, z): 3
- * - 속도 (vx, vy, vz): 3
- * - 자세 (q0, q1, q2, q3): 4
- * - 각속도 바이어스 (bgx, bgy, bgz): 3
- * - 가속도 바이어스 (bax, bay, baz): 3
- * 총 16개 상태 변수
+ * 정의하면 ekf_predict가 희소 전이 행렬을 밀집 N x N F로 전개한 뒤
+ * 일반 F * P * F^T 전파를 수행한다. 희소 전파 경로 검증용이며,
+ * 기본값(미정의)은 F의 비영 블록만 적용하는 희소 전파를 사용한다.
  */
-#define EKF_STATE_DIM 16
+/* #define EKF_REFERENCE_COVARIANCE_PREDICT */
 
 /**
  * @brief EKF 상태 인덱스 정의
+ * 
+ * 상태 목록(ekf_config.h의 EKF_STATE_LIST) 순서대로 생성된다. 기본 구성:
+ * - 위치 (x, y, z): 0-2 (EKF_CONFIG_POSITION)
+ * - 속도 (vx, vy, vz): 3-5
+ * - 자세 (q0, q1, q2, q3): 6-9
+ * - 각속도 바이어스 (bgx, bgy, bgz): 10-12
+ * - 가속도 바이어스 (bax, bay, baz): 13-15 (EKF_CONFIG_ACCEL_BIAS)
+ * - 수신기 시계 바이어스, 드리프트 (m, m/s): 16-17 (EKF_CONFIG_GNSS_CLOCK)
+ * - 자력계 바이어스 (bmx, bmy, bmz): 16-18 (EKF_CONFIG_MAG_BIAS)
+ * - 항력 계수 k (1/m): 16 (EKF_CONFIG_DRAG)
+ * 제외된 블록의 인덱스는 정의되지 않으므로 사용하는 코드는 같은 조건으로 감싸야 한다.
+ */
+#define EKF_STATE_INDEX_ENTRY(name, p_init, p_reset) EKF_STATE_##name,
+typedef enum {
+    EKF_STATE_LIST(EKF_STATE_INDEX_ENTRY)
+    EKF_STATE_COUNT /**< 상태 수 (= EKF_STATE_DIM) */
+} EKF_StateIndex;
+#undef EKF_STATE_INDEX_ENTRY
+
+_Static_assert(EKF_STATE_COUNT == EKF_STATE_DIM, "EKF_STATE_DIM does not match EKF_STATE_LIST");
+
+/**
+ * @brief 상태 차원에 맞는 행렬 타입
+ */
+typedef EKF_STATE_VECTOR EKF_StateVector; /**< N x 1 상태 벡터 */
+typedef EKF_STATE_MATRIX EKF_StateMatrix; /**< N x N 밀집 행렬 */
+typedef EKF_STATE_SYM EKF_StateCovariance; /**< N x N 압축 대칭 공분산 */
+typedef EKF_STATE_UD EKF_StateUD;         /**< 공분산 U-D 분해 */
+
+/**
+ * @brief 상태 인덱스 비트 마스크 (고려 상태 지정용, ekf_set_consider_states)
+ */
+_Static_assert(EKF_STATE_DIM <= 32, "state mask does not fit in uint32_t");
+#define EKF_STATE_MASK(first, count) ((((uint32_t)1u << (count)) - 1u) << (first))
+#define EKF_CONSIDER_GYRO_BIAS EKF_STATE_MASK(EKF_STATE_GYRO_BIAS_X, 3) /**< 자이로 바이어스 블록 */
+#if EKF_CONFIG_ACCEL_BIAS
+#define EKF_CONSIDER_ACCEL_BIAS EKF_STATE_MASK(EKF_STATE_ACC_BIAS_X, 3) /**< 가속도 바이어스 블록 */
+#else
+#define EKF_CONSIDER_ACCEL_BIAS 0u
+#endif
+#if EKF_CONFIG_GNSS_CLOCK
+#define EKF_CONSIDER_GNSS_CLOCK EKF_STATE_MASK(EKF_STATE_CLK_BIAS, 2)  /**< 수신기 시계 블록 */
+#else
+#define EKF_CONSIDER_GNSS_CLOCK 0u
+#endif
+#if EKF_CONFIG_MAG_BIAS
+#define EKF_CONSIDER_MAG_BIAS EKF_STATE_MASK(EKF_STATE_MAG_BIAS_X, 3)    /**< 자력계 바이어스 블록 */
+#else
+#define EKF_CONSIDER_MAG_BIAS 0u
+#endif
+#if EKF_CONFIG_DRAG
+#define EKF_CONSIDER_DRAG EKF_STATE_MASK(EKF_STATE_DRAG_K, 1)             /**< 항력 계수 */
+#else
+#define EKF_CONSIDER_DRAG 0u
+#endif
+
+/**
+ * @brief 분할 공분산 전파의 블록 크기 (ekf_set_bias_decimation)
+ *
+ * 핵심 블록은 바이어스 앞의 상태(위치, 속도, 자세), 바이어스 블록은 자이로 바이어스와
+ * (구성에 있으면) 바로 뒤의 가속도 바이어스이다.
+ */
+#define EKF_PARTITION_CORE_DIM EKF_STATE_GYRO_BIAS_X
+#if EKF_CONFIG_ACCEL_BIAS
+#define EKF_PARTITION_BIAS_DIM 6
+#else
+#define EKF_PARTITION_BIAS_DIM 3
+#endif
+
+/**
+ * @brief 상태 벡터의 블록별 보기 (EKF.s, 저장 공간은 EKF.x와 공유)
+ *
+ * 필터 내부 코드가 ekf->s.vel, ekf->s.quat처럼 상태 블록을 Vector3f/Quaternion으로
+ * 바로 읽고 쓰도록 한다. 멤버 순서와 조건은 EKF_STATE_LIST와 같으며, 오프셋은 아래
+ * 정적 검사로 상태 인덱스와 맞춘다.
+ */
+typedef struct {
+#if EKF_CONFIG_POSITION
+    Vector3f pos;            /**< 위치 (m) */
+#endif
+    Vector3f vel;            /**< 속도 (m/s) */
+    Quaternion quat;         /**< 자세 사원수 (w, x, y, z) */
+    Vector3f bg;             /**< 자이로 바이어스 (rad/s) */
+#if EKF_CONFIG_ACCEL_BIAS
+    Vector3f ba;             /**< 가속도 바이어스 (m/s^2) */
+#endif
+#if EKF_CONFIG_GNSS_CLOCK
+    float clk_bias;          /**< 수신기 시계 바이어스 (m) */
+    float clk_drift;         /**< 수신기 시계 드리프트 (m/s) */
+#endif
+#if EKF_CONFIG_MAG_BIAS
+    Vector3f bm;             /**< 자력계 바이어스 (몸체 좌표계, 자력계 입력 단위) */
+#endif
+#if EKF_CONFIG_DRAG
+    float drag;              /**< 항력 계수 k (1/m) */
+#endif
+} EKF_StateView;
+
+#define EKF_STATE_VIEW_CHECK(member, index) \
+    _Static_assert(offsetof(EKF_StateView, member) == (index) * sizeof(float), "EKF_StateView." #member " offset")
+#if EKF_CONFIG_POSITION
+EKF_STATE_VIEW_CHECK(pos, EKF_STATE_POS_X);
+#endif
+EKF_STATE_VIEW_CHECK(vel, EKF_STATE_VEL_X);
+EKF_STATE_VIEW_CHECK(quat, EKF_STATE_QUAT_W);
+EKF_STATE_VIEW_CHECK(bg, EKF_STATE_GYRO_BIAS_X);
+#if EKF_CONFIG_ACCEL_BIAS
+EKF_STATE_VIEW_CHECK(ba, EKF_STATE_ACC_BIAS_X);
+#endif
+#if EKF_CONFIG_GNSS_CLOCK
+EKF_STATE_VIEW_CHECK(clk_bias, EKF_STATE_CLK_BIAS);
+EKF_STATE_VIEW_CHECK(clk_drift, EKF_STATE_CLK_DRIFT);
+#endif
+#if EKF_CONFIG_MAG_BIAS
+EKF_STATE_VIEW_CHECK(bm, EKF_STATE_MAG_BIAS_X);
+#endif
+#if EKF_CONFIG_DRAG
+EKF_STATE_VIEW_CHECK(drag, EKF_STATE_DRAG_K);
+#endif
+#undef EKF_STATE_VIEW_CHECK
+// EKF_StateVector는 MATRIX_ALIGN 배수로 올림되므로 보기가 원소 N개를 모두 덮는지만 확인
+_Static_assert(sizeof(EKF_StateView) == EKF_STATE_DIM * sizeof(float), "EKF_StateView size");
+_Static_assert(sizeof(EKF_StateView) <= sizeof(EKF_StateVector), "EKF_StateView size");
+
+/**
+ * @brief EKF 측정 갱신 방식
+ */
+typedef enum {
+    EKF_UPDATE_SEQUENTIAL = 0, /**< 스칼라 관측을 하나씩 순차 처리 (R 대각 가정, 역행렬 없음) */
+    EKF_UPDATE_BATCH = 1       /**< 측정 벡터 전체를 한 번에 처리 (S LDL^T 풀이) */
+} EKF_UpdateMode;
+
+/**
+ * @brief 공분산 갱신 방식
+ */
+typedef enum {
+    EKF_COVARIANCE_JOSEPH = 0,   /**< Joseph 형식 (수치 안정, 상삼각 원소당 약 3M 곱셈) */
+    EKF_COVARIANCE_STANDARD = 1  /**< P = P - K * (PH^T)^T (최소 연산) */
+} EKF_CovarianceUpdate;
+
+/**
+ * @brief 공분산 필터 엔진
+ * 
+ * U-D 엔진은 P = U * D * U^T 분해를 주 표현으로 유지하며, 예측은 Thornton 전파,
+ * 측정 갱신은 관측마다 Bierman 스칼라 갱신으로 수행한다 (역행렬 없음).
+ * 이때 ekf->P는 매 예측/갱신 후 U-D로부터 복원되는 읽기 전용 사본이다.
+ */
+typedef enum {
+    EKF_ENGINE_COVARIANCE = 0, /**< 압축 대칭 P 직접 갱신 */
+    EKF_ENGINE_UD = 1          /**< U-D 분해 (Bierman-Thornton) */
+} EKF_Engine;
+
+/**
+ * @brief GNSS 부분 갱신 성분 (ekf_update_gps_partial, 비트 조합)
+ */
+typedef enum {
+    EKF_GPS_USE_POS = 1u << 0,     /**< 위치 성분 */
+    EKF_GPS_USE_VEL = 1u << 1,     /**< 속도 성분 */
+    EKF_GPS_NO_VERTICAL = 1u << 2  /**< 수직(z) 성분 제외 (추진 중 수직 오차가 큰 수신기) */
+} EKF_GpsComponent;
+
+/**
+ * @brief 수신기 보고 GNSS 정확도 (UBX NAV-PVT hAcc/vAcc/sAcc, 0이면 보고 없음)
+ */
+typedef struct {
+    float h;                   /**< 수평 위치 표준 편차 (m) */
+    float v;                   /**< 수직 위치 표준 편차 (m) */
+    float s;                   /**< 속도 표준 편차 (m/s, 세 축 공통) */
+} EKF_GpsAccuracy;
+
+/**
+ * @brief 수신기 정확도 기반 GNSS R 하한과 기본 생략 문턱
+ */
+#define EKF_GPS_ACC_MIN_POS_STD 0.3f       /**< 위치 표준 편차 하한 (m, 수신기의 낙관적 보고 보정) */
+#define EKF_GPS_ACC_MIN_VEL_STD 0.05f      /**< 속도 표준 편차 하한 (m/s) */
+#define EKF_GPS_ACC_DEFAULT_POS_MAX 20.0f  /**< 이보다 큰 위치 정확도의 성분은 생략 (m) */
+#define EKF_GPS_ACC_DEFAULT_VEL_MAX 2.0f   /**< 이보다 큰 속도 정확도의 성분은 생략 (m/s) */
+
+/**
+ * @brief 이중 안테나 GNSS 기선 측정 (ekf_update_gnss_heading, UBX NAV-RELPOSNED)
+ */
+typedef struct {
+    float heading;             /**< 기선 방위 (rad, NED 북에서 동쪽으로) */
+    float pitch;               /**< 기선 앙각 (rad, 위가 양수, use_pitch일 때만) */
+    float heading_std;         /**< 방위 표준 편차 (rad, 0이면 R_gnss_heading) */
+    float pitch_std;           /**< 앙각 표준 편차 (rad, 0이면 R_gnss_pitch) */
+    uint8_t use_pitch;         /**< 앙각도 갱신 (0 또는 1) */
+} EKF_GnssHeading;
+
+/**
+ * @brief 혁신 게이트 대상 측정 종류
+ */
+typedef enum {
+    EKF_SENSOR_GPS_POS = 0,     /**< GPS 위치 전용 (3자유도) */
+    EKF_SENSOR_GPS_POS_VEL = 1, /**< GPS 위치 + 속도 (6자유도) */
+    EKF_SENSOR_BARO = 2,        /**< 기압계 (1자유도) */
+    EKF_SENSOR_MAG = 3,         /**< 자력계 (3자유도) */
+    EKF_SENSOR_ZUPT = 4,        /**< 영속도 갱신 (3자유도) */
+    EKF_SENSOR_ZARU = 5,        /**< 영각속도 갱신 (3자유도) */
+    EKF_SENSOR_PSEUDORANGE = 6, /**< 위성별 의사거리 (1자유도) */
+    EKF_SENSOR_RANGE_RATE = 7,  /**< 위성별 의사거리 변화율 (도플러, 1자유도) */
+    EKF_SENSOR_MAG_HEADING = 8, /**< 자력계 방위각 전용 (1자유도) */
+    EKF_SENSOR_GRAVITY = 9,     /**< 가속도계 중력 방향 (3자유도) */
+    EKF_SENSOR_RAIL = 10,       /**< 발사 레일 횡방향 영속도 (축마다 1자유도) */
+    EKF_SENSOR_DRAG = 11,       /**< 관성 비행 항력 비력 (3자유도, EKF_CONFIG_DRAG) */
+    EKF_SENSOR_GNSS_HEADING = 12, /**< 이중 안테나 GNSS 기선 방위/피치 (스칼라마다 1자유도) */
+    EKF_SENSOR_COUNT = 13       /**< 측정 종류 수 */
+} EKF_Sensor;
+
+/**
+ * @brief 기본 혁신 게이트 임계값 (카이제곱 99.9%)
+ */
+#define EKF_NIS_GATE_1DOF 10.83f
+#define EKF_NIS_GATE_3DOF 16.27f
+#define EKF_NIS_GATE_6DOF 22.46f
+
+/**
+ * @brief 기본 게이트 연속 거부 복구 조건 (먼저 닿는 쪽)
+ * 
+ * P가 실제 오차보다 작게 굳으면 (분산 상한 등) NIS가 게이트 위에 머물러 측정이 영영 거부된다.
+ * 연속 거부가 이 횟수나 시간에 닿으면 다음 측정 하나를 게이트 없이 받아들여 상태를 끌어온다.
+ */
+#define EKF_NIS_RECOVER_REJECTS 50u
+#define EKF_NIS_RECOVER_TIME_S 5.0f
+
+/**
+ * @brief 적응형 측정 노이즈 최대 측정 차원
+ */
+#define EKF_ADAPTIVE_MAX_DIM 6
+
+/**
+ * @brief 적응형 측정 노이즈 기본 설정
+ */
+#define EKF_ADAPTIVE_DEFAULT_WINDOW 32
+#define EKF_ADAPTIVE_DEFAULT_SCALE_MIN 0.25f
+#define EKF_ADAPTIVE_DEFAULT_SCALE_MAX 100.0f
+
+/**
+ * @brief 정상 상태 게인 모드 설정 (ekf_set_steady_gain)
+ */
+#define EKF_STEADY_GAIN_MAX_DIM 3                 /**< 게인을 고정할 수 있는 최대 측정 차원 */
+#define EKF_STEADY_GAIN_DEFAULT_TOLERANCE 5.0e-3f /**< 수렴 판정 게인 상대 변화 (max|ΔK| / max|K|) */
+#define EKF_STEADY_GAIN_DEFAULT_COUNT 20          /**< 수렴 판정 연속 측정 수 */
+
+/**
+ * @brief 공분산 지연 전파 기본 최대 누적 구간 (초)
+ *
+ * 누적 구간의 프로세스 노이즈는 Σdt 한 구간으로 이산화하므로 (ekf_predict_batch와 같은 근사,
+ * 바이어스를 거친 교차 항 생략) 너무 길게 두지 않는다. 항법 해의 공분산 대각도 이 구간만큼 늦을 수 있다.
+ */
+#define EKF_LAZY_DEFAULT_MAX_DT 0.1f
+
+/**
+ * @brief 항력 계수 추정 설정 (k = rho * Cd * A / (2 * m), 단위 1/m)
+ */
+#define EKF_DRAG_MIN_SPEED 20.0f     /**< 추정에 사용할 최소 속력 (m/s) */
+#define EKF_DRAG_FILTER_GAIN 0.01f   /**< 측정당 저역 통과 이득 */
+#define EKF_DRAG_MAX 0.05f           /**< 측정값 상한 (1/m) */
+#define EKF_DRAG_DEFAULT_STD 2e-6f   /**< 항력 계수 상태 프로세스 노이즈 (1/m/sqrt(s), EKF_CONFIG_DRAG, 고도별 밀도 변화) */
+#define EKF_DRAG_DEFAULT_ACCEL_STD 0.5f /**< 항력 비력 측정 축별 표준 편차 (m/s^2, 진동과 받음각 포함) */
+
+/**
+ * @brief 자력계 방위각 갱신 설정
+ */
+#define EKF_MAG_HEADING_DEFAULT_STD 0.1f     /**< 기본 방위각 표준 편차 (rad) */
+#define EKF_MAG_HEADING_MIN_HORIZONTAL 0.1f  /**< 수평 성분 / 전체 크기 최소 비율 (작으면 방위 불확실) */
+
+/**
+ * @brief 이중 안테나 GNSS 방위 갱신 설정
+ */
+#define EKF_GNSS_HEADING_DEFAULT_STD 0.01f     /**< 기본 방위 표준 편차 (rad, 1 m 기선 RTK 고정해) */
+#define EKF_GNSS_PITCH_DEFAULT_STD 0.02f       /**< 기본 앙각 표준 편차 (rad, 수직 오차가 수평의 약 두 배) */
+#define EKF_GNSS_HEADING_MIN_HORIZONTAL 0.2f   /**< 기선 NED 수평 성분 / 기선 길이 최소 비율 (작으면 방위 불확실) */
+
+/**
+ * @brief 자력계 외란 사전 검사 기본값 (ekf_update_mag, 0이면 검사 안 함)
+ */
+#define EKF_MAG_DISTURBANCE_DEFAULT_MAGNITUDE 0.0f    /**< 기준 크기 대비 허용 상대 오차 (입력 단위가 기준과 같을 때 0.2 정도) */
+#define EKF_MAG_DISTURBANCE_DEFAULT_INCLINATION 0.15f /**< 허용 복각 오차 (rad, 약 8.6 deg) */
+
+/**
+ * @brief 자력계 바이어스 상태 기본 프로세스 노이즈 (EKF_CONFIG_MAG_BIAS, 입력 단위/sqrt(s))
+ */
+#define EKF_MAG_BIAS_DEFAULT_STD 1e-4f
+
+/**
+ * @brief 가속도계 중력 방향 갱신 설정
+ */
+#define EKF_GRAVITY_DEFAULT_STD 0.5f         /**< 기본 축별 표준 편차 (m/s^2, 진동 포함) */
+#define EKF_GRAVITY_DEFAULT_TOLERANCE 0.5f   /**< 기본 허용 크기 오차 (| |a| - g |, m/s^2) */
+
+/**
+ * @brief 발사 레일 구속 설정
+ */
+#define EKF_RAIL_DEFAULT_VEL_STD 0.1f        /**< 기본 횡방향 속도 표준 편차 (m/s, 레일 유격/진동) */
+
+/**
+ * @brief 기압계 천음속 오차 모델 (마하수별 R 배율 표)
+ */
+#define EKF_BARO_MACH_STEP 0.1f              /**< 표 마하수 간격 */
+#define EKF_BARO_MACH_COUNT 21               /**< 표 항목 수 (마하 0..2.0, 그 위는 마지막 값) */
+#define EKF_BARO_DEFAULT_SOUND_SPEED 340.3f  /**< 기본 음속 (m/s, ISA 해수면) */
+
+/**
+ * @brief 측정 종류별 혁신 통계 (적응형 측정 노이즈)
+ * 
+ * 창 길이 W의 지수 이동 평균으로 축별 E[y_k^2]와 E[h_k P h_k^T]를 추정하면
+ * R_kk 추정값은 E[y_k^2] - E[h_k P h_k^T] 이고, 공칭 R_kk 대비 배율로 저장한다.
+ */
+typedef struct {
+    float innovation_sq[EKF_ADAPTIVE_MAX_DIM]; /**< 축별 혁신 제곱 이동 평균 */
+    float predicted_var[EKF_ADAPTIVE_MAX_DIM]; /**< 축별 예측 분산 h_k P h_k^T 이동 평균 */
+    float scale[EKF_ADAPTIVE_MAX_DIM];         /**< 축별 R 배율 (공칭 R 대비) */
+    uint32_t count;                            /**< 누적 측정 수 */
+} EKF_AdaptiveNoise;
+
+/**
+ * @brief 측정 종류별 NIS 창 누적 (게이트가 갱신할 때마다 더함, ekf_take_nis_window로 비움)
+ * 
+ * 갱신마다 이미 계산한 NIS를 합, 제곱 합, 최댓값에 더하기만 하므로 S를 다시 훑지 않는다.
+ * 평균/분산은 창을 비우는 쪽(nav/innovation_monitor.h)이 계산한다.
+ */
+typedef struct {
+    uint32_t count;            /**< 창의 유한한 NIS 수 (게이트 거부 포함) */
+    uint32_t rejects;          /**< 창의 게이트 거부 수 (NaN 포함) */
+    float sum;                 /**< NIS 합 */
+    float sum_sq;              /**< NIS 제곱 합 */
+    float max;                 /**< NIS 최댓값 */
+} EKF_NisWindow;
+
+/**
+ * @brief 측정 종류별 정상 상태 게인 기록
+ * 
+ * 측정마다 갱신 전 P로 구한 게인 K = P H^T S^-1 을 직전 값과 비교하여
+ * 상대 변화가 허용치 이하인 측정이 연속으로 쌓이면 수렴한 것으로 본다.
+ */
+typedef struct {
+    float K[EKF_STATE_DIM * EKF_STEADY_GAIN_MAX_DIM];               /**< 마지막 게인 (N x m, 행 우선) */
+    float S_inv[EKF_STEADY_GAIN_MAX_DIM * EKF_STEADY_GAIN_MAX_DIM]; /**< 혁신 공분산 역행렬 (m x m, 게이트용) */
+    float r_diag[EKF_STEADY_GAIN_MAX_DIM];                          /**< 게인 계산에 쓴 R 대각 */
+    uint8_t dim;                   /**< 측정 차원 (0이면 기록 없음) */
+    uint16_t stable;               /**< 게인 변화가 허용치 이하인 연속 측정 수 */
+} EKF_SteadyGain;
+
+/**
+ * @brief 구간 길이별 이산 프로세스 노이즈 Qd 캐시
+ * 
+ * Q의 대각 원소를 연속 시간 백색 잡음 세기로 보고, 적분 관계가 있는 블록
+ * (위치-속도, 시계 바이어스-드리프트)은 Van Loan 이산화의 닫힌 형태를 쓴다.
+ *   Qd_vv = q_v dt,  Qd_pv = q_v dt^2 / 2,  Qd_pp = q_p dt + q_v dt^3 / 3
+ * 나머지 상태는 대각 Q * dt이며, 바이어스를 거친 교차 항(자세-자이로 바이어스,
+ * 속도-가속도 바이어스)은 바이어스 잡음이 작아 생략한다.
+ */
+typedef struct {
+    float dt;                      /**< 캐시의 구간 길이 (초, 0이면 무효) */
+    float diag[EKF_STATE_DIM];     /**< 대각 원소 */
+    float pos_vel[3];              /**< 위치-속도 축별 교차 항 */
+    float clk;                     /**< 시계 바이어스-드리프트 교차 항 */
+} EKF_DiscreteNoise;
+
+/**
+ * @brief 자세에서 유도한 값의 에포크 캐시
+ * 
+ * 예측이 적분 뒤 자세의 회전 행렬을 여기에 두고, 같은 에포크의 측정 갱신(방위, 레일, 항력)은
+ * 다시 계산하지 않고 쓴다. 키는 계산에 쓴 사원수이므로 측정 보정, 재설정, 웜 스타트 복구 등
+ * 자세를 바꾸는 모든 경로에서 따로 무효화할 필요가 없다 (ekf_epoch_rotation이 비교).
+ */
+typedef struct {
+    Quaternion q;                  /**< R을 계산한 자세 */
+    float R[3][3];                 /**< 회전 행렬 (몸체 -> NED) */
+    bool valid;                    /**< 캐시 유효 여부 */
+} EKF_EpochCache;
+
+/**
+ * @brief 일괄 예측용 IMU 샘플
+ */
+typedef struct {
+    Vector3f gyro;  /**< 자이로 측정값 (rad/s) */
+    Vector3f accel; /**< 가속도 측정값 (m/s^2) */
+    float dt;       /**< 이전 샘플과의 시간 간격 (초) */
+} EKF_ImuSample;
+
+/**
+ * @brief 위성 하나의 GNSS 원시 관측 (강결합 갱신용)
+ * 
+ * 위성까지의 거리는 수천만 m라 단정밀도로 직접 빼면 미터 단위 오차가 생기므로,
+ * 호출자가 선형화 점(보통 직전 EKF 위치)에서 기하 거리와 시선 벡터를 배정밀도로
+ * 구해 뺀 작은 값만 넘긴다 (nav/geodetic.h의 geodetic_line_of_sight).
+ * 위성 시계, 전리층/대류권 지연, 지구 자전(Sagnac) 보정은 호출자 몫이다.
+ */
+typedef struct {
+    Vector3f los;          /**< 선형화 점 → 위성 단위 시선 벡터 (NED) */
+    float pseudorange;     /**< 의사거리 - 선형화 점 기하 거리 (m) */
+    float range_rate;      /**< 의사거리 변화율 - 위성 속도의 시선 성분 (m/s) */
+    float pseudorange_std; /**< 의사거리 표준 편차 (m, 0 이하이면 의사거리 미사용) */
+    float range_rate_std;  /**< 의사거리 변화율 표준 편차 (m/s, 0 이하이면 도플러 미사용) */
+} EKF_GnssObservation;
+
+/**
+ * @brief 동시 측정 묶음 갱신의 최대 스칼라 관측 수 (GNSS 위치/속도 6 + 기압계 1)
+ */
+#define EKF_COINCIDENT_MAX_ROWS 7
+
+/**
+ * @brief 같은 시각의 GNSS/기압계 측정 묶음 (ekf_update_coincident)
+ */
+typedef struct {
+    bool has_gps;          /**< GNSS 측정 포함 여부 */
+    Vector3f gps_pos;      /**< GNSS 위치 (NED, m) */
+    bool gps_use_vel;      /**< GNSS 속도 사용 여부 */
+    Vector3f gps_vel;      /**< GNSS 속도 (NED, m/s) */
+    bool has_baro;         /**< 기압계 측정 포함 여부 */
+    float baro_alt;        /**< 기압계 고도 (m) */
+    bool gps_accepted;     /**< 결과: GNSS 측정을 반영했음 */
+    bool baro_accepted;    /**< 결과: 기압계 측정을 반영했음 */
+} EKF_CoincidentMeasurement;
+
+/**
+ * @brief 정보 형식 묶음 갱신에서 관측이 닿을 수 있는 최대 상태 수
+ *
+ * 넘치는 관측이 들어오면 그때까지의 누적분을 먼저 반영하고 새로 누적한다.
+ */
+#define EKF_INFO_MAX_STATES 12
+
+/**
+ * @brief 정보 형식 누적기 (ekf_info_begin ~ ekf_info_apply)
+ *
+ * 관측이 닿은 상태 T만 모아 Λ_TT = Σ H^T R^-1 H, η_T = Σ H^T R^-1 y 를 저장한다.
+ */
+typedef struct {
+    bool open;                                /**< 누적 중 */
+    uint8_t count;                            /**< 관측이 닿은 상태 수 */
+    uint8_t states[EKF_INFO_MAX_STATES];      /**< 관측이 닿은 상태 인덱스 (추가 순) */
+    float lambda[EKF_INFO_MAX_STATES][EKF_INFO_MAX_STATES]; /**< Σ H^T R^-1 H (T 블록) */
+    float eta[EKF_INFO_MAX_STATES];           /**< Σ H^T R^-1 y (T 성분) */
+    uint16_t rows;                            /**< 누적한 스칼라 관측 수 */
+    uint32_t solves;                          /**< 반영한 누적분 수 */
+} EKF_InfoAccumulator;
+
+/**
+ * @brief EKF 작업 메모리 최악 배치
+ * 
+ * 예측과 측정 갱신은 중첩되지 않으므로 단계별 임시 행렬 묶음 중 가장 큰 것이
+ * 스크래치 영역 크기가 된다.
+ */
+typedef union {
+    float ud_propagate[MATRIX_UD_PROPAGATE_WORK_SIZE(EKF_STATE_DIM)]; /**< Thornton 전파 */
+    struct {
+        EKF_StateMatrix F;
+        EKF_StateCovariance P;
+    } reference_predict;  /**< 밀집 참조 공분산 예측 */
+    struct {
+        EKF_MAT_NXM(6) PHt;
+        EKF_MAT_NXM(6) K;
+        Mat6x6 S;
+        Mat6x6 S_inv;
+    } batch_update;       /**< 일괄 측정 갱신 (측정 차원 6) */
+    struct {
+        float PHt[EKF_STATE_DIM * EKF_COINCIDENT_MAX_ROWS];
+        float K[EKF_STATE_DIM * EKF_COINCIDENT_MAX_ROWS];
+    } coincident_update;  /**< 동시 측정 묶음 갱신 */
+    struct {
+        float PT[EKF_STATE_DIM * EKF_INFO_MAX_STATES];
+        float G[EKF_STATE_DIM * EKF_INFO_MAX_STATES];
+        float B[EKF_INFO_MAX_STATES * EKF_INFO_MAX_STATES];
+        float W[EKF_INFO_MAX_STATES * EKF_INFO_MAX_STATES];
+    } info_update;        /**< 정보 형식 누적분 반영 */
+} EKF_ScratchLayout;
+
+/**
+ * @brief EKF 스크래치 영역 크기 (바이트, 할당 4회 정렬 여유 포함)
+ */
+#define EKF_SCRATCH_SIZE (sizeof(EKF_ScratchLayout) + SCRATCH_ALIGN_SLACK(4))
+
+/**
+ * @brief 자력계 외란 통계 (ekf_mag_check_disturbance)
+ */
+typedef struct {
+    uint32_t checks;             /**< 검사 횟수 (지연 갱신은 되감기 전후 두 번) */
+    uint32_t magnitude_rejects;  /**< 크기 오차로 생략한 수 */
+    uint32_t inclination_rejects; /**< 복각 오차로 생략한 수 */
+    float last_magnitude_ratio;  /**< 마지막 측정 크기 / 기준 크기 */
+    float last_inclination_error; /**< 마지막 복각 오차 (측정 - 기준, rad) */
+} EKF_MagDisturbanceStats;
+
+/**
+ * @brief 공분산 전이 관찰 콜백
+ * 
+ * P에 전이를 반영한 직후(P = F P F^T + Qd, 분산 경계 적용 후) 호출된다. 지연/분할 전파에서는
+ * 실제로 P에 반영되는 누적 전이마다 한 번씩 불린다. 호스트 스무더가 구간 전이 행렬을
+ * 모으는 데 쓰며, 펌웨어에서는 설정하지 않는다.
+ * 
+ * @param context ekf_set_transition_observer에 넘긴 값
+ * @param F 반영한 희소 전이 행렬
+ * @param dt 전이 구간 길이 (초, 0이면 노이즈 없는 전이)
+ */
+typedef void (*EKF_TransitionObserver)(void *context, const MatrixSparseTransition *F, float dt);
+
+/**
+ * @brief 기록되는 공개 호출 (호출 기록기 log/call_recorder.h, 값은 기록 형식이므로 바꾸지 않음)
+ *
+ * 인자 모양은 괄호 안과 같다. 지연 융합(ekf_delay.h) 호출은 측정 시각(u32) 뒤에 같은 이름의
+ * 직접 호출 인자가 온다.
+ */
+typedef enum {
+    EKF_CALL_PREDICT = 1,              /**< ekf_predict (EKF_ImuSample) */
+    EKF_CALL_PREDICT_STATE_ONLY = 2,   /**< ekf_predict_state_only (EKF_ImuSample) */
+    EKF_CALL_PREDICT_ATTITUDE = 3,     /**< ekf_predict_attitude (EKF_ImuSample, accel 0) */
+    EKF_CALL_PREDICT_BATCH = 4,        /**< ekf_predict_batch (EKF_ImuSample x n) */
+    EKF_CALL_FLUSH_COVARIANCE = 5,     /**< ekf_flush_covariance (없음) */
+    EKF_CALL_UPDATE_GPS = 6,           /**< ekf_update_gps (EKF_CallGps, flags = use_vel) */
+    EKF_CALL_UPDATE_GPS_PARTIAL = 7,   /**< ekf_update_gps_partial (EKF_CallGps, flags = components) */
+    EKF_CALL_UPDATE_BARO = 8,          /**< ekf_update_baro (float) */
+    EKF_CALL_UPDATE_COINCIDENT = 9,    /**< ekf_update_coincident (EKF_CoincidentMeasurement) */
+    EKF_CALL_INFO_BEGIN = 10,          /**< ekf_info_begin (없음) */
+    EKF_CALL_INFO_APPLY = 11,          /**< ekf_info_apply (없음) */
+    EKF_CALL_UPDATE_GNSS_RAW = 12,     /**< ekf_update_gnss_raw (Vector3f ref_pos, EKF_GnssObservation x n) */
+    EKF_CALL_UPDATE_MAG = 13,          /**< ekf_update_mag (Vector3f) */
+    EKF_CALL_MAG_CHECK_DISTURBANCE = 14, /**< ekf_mag_check_disturbance (Vector3f) */
+    EKF_CALL_UPDATE_MAG_HEADING = 15,  /**< ekf_update_mag_heading (Vector3f) */
+    EKF_CALL_UPDATE_GRAVITY = 16,      /**< ekf_update_gravity (Vector3f) */
+    EKF_CALL_UPDATE_ZUPT = 17,         /**< ekf_update_zupt (없음) */
+    EKF_CALL_UPDATE_RAIL = 18,         /**< ekf_update_rail (float dt) */
+    EKF_CALL_UPDATE_ZERO_RATE = 19,    /**< ekf_update_zero_rate (EKF_ImuSample: gyro = 평균, dt = rate_std) */
+    EKF_CALL_UPDATE_DRAG = 20,         /**< ekf_update_drag (Vector3f) */
+    EKF_CALL_ESTIMATE_DRAG = 21,       /**< ekf_estimate_drag (Vector3f) */
+    EKF_CALL_UPDATE_NAV_ESTIMATE = 22, /**< ekf_update_nav_estimate (EKF_CallNavEstimate, P_ext 9x9) */
+    EKF_CALL_SET_INITIAL_STATE = 23,   /**< ekf_set_initial_state (EKF_CallNavEstimate, 공분산 항 0) */
+    EKF_CALL_SET_BARO_NOISE_SCALE = 24, /**< ekf_set_baro_noise_scale (float) */
+    EKF_CALL_SET_VELOCITY_NOISE_INFLATION = 25, /**< ekf_set_velocity_noise_inflation (float) */
+    EKF_CALL_STEADY_GAIN_RESET = 26,   /**< ekf_steady_gain_reset (없음) */
+    EKF_CALL_SET_EARTH_MAGNETIC_FIELD = 27, /**< ekf_set_earth_magnetic_field (Vector3f) */
+    EKF_CALL_SET_RAIL_CONSTRAINT = 28, /**< ekf_set_rail_constraint (float x 3: enable, 길이, 표준 편차) */
+    EKF_CALL_SET_ENGINE = 29,          /**< ekf_set_engine (u8) */
+    EKF_CALL_DELAY_PREDICT = 30,       /**< ekf_delay_predict (u32, EKF_ImuSample) */
+    EKF_CALL_DELAY_UPDATE_GPS = 31,    /**< ekf_delay_update_gps (u32, EKF_CallGps) */
+    EKF_CALL_DELAY_UPDATE_GPS_PARTIAL = 32, /**< ekf_delay_update_gps_partial (u32, EKF_CallGps) */
+    EKF_CALL_DELAY_UPDATE_BARO = 33,   /**< ekf_delay_update_baro (u32, float) */
+    EKF_CALL_DELAY_UPDATE_MAG = 34,    /**< ekf_delay_update_mag (u32, Vector3f) */
+    EKF_CALL_DELAY_UPDATE_COINCIDENT = 35, /**< ekf_delay_update_coincident (u32, EKF_CoincidentMeasurement) */
+    EKF_CALL_DELAY_CLEAR = 36,         /**< ekf_delay_clear (없음) */
+    EKF_CALL_SET_MAG_NOISE_SCALE = 37, /**< ekf_set_mag_noise_scale (float) */
+    EKF_CALL_SET_GPS_ACCURACY = 38,    /**< ekf_set_gps_accuracy (EKF_GpsAccuracy, NULL이면 0) */
+    EKF_CALL_UPDATE_GNSS_HEADING = 39, /**< ekf_update_gnss_heading (EKF_GnssHeading) */
+    EKF_CALL_DELAY_UPDATE_GNSS_HEADING = 40, /**< ekf_delay_update_gnss_heading (u32, EKF_GnssHeading) */
+    EKF_CALL_COUNT
+} EKF_CallId;
+
+/**
+ * @brief GNSS 위치/속도 갱신 호출 인자
+ */
+typedef struct {
+    Vector3f pos;              /**< 위치 (NED, m) */
+    Vector3f vel;              /**< 속도 (NED, m/s) */
+    uint32_t flags;            /**< use_vel 또는 components */
+} EKF_CallGps;
+
+/**
+ * @brief 외부 항법 해 갱신/초기 상태 호출 인자
+ */
+typedef struct {
+    Quaternion q;              /**< 자세 */
+    Vector3f vel;              /**< 속도 (m/s) */
+    Vector3f pos;              /**< 위치 (m) */
+    uint32_t components;       /**< 성분 (EKF_NAV_ERROR_*) */
+    float omega;               /**< CI 가중치 */
+} EKF_CallNavEstimate;
+
+/**
+ * @brief 공개 호출 관찰 콜백
+ *
+ * 기록 대상 공개 함수(EKF_CallId)가 불릴 때 인자를 바꾸기 전에 호출된다. 공개 함수가 안에서
+ * 다른 공개 함수를 부르면(예: 지연 융합이 ekf_update_*를 부름) 바깥 호출만 알린다. 따라서
+ * 알린 호출을 같은 순서와 인자로 다시 부르면 같은 빌드에서 같은 결과가 나온다.
+ * 인자는 앞부분(head)과 배열(tail) 두 조각으로 넘긴다 (tail은 없으면 NULL, 0).
+ *
+ * @param context ekf_set_call_observer에 넘긴 값
+ * @param call 호출 종류
+ * @param head 인자 앞부분
+ * @param head_len 앞부분 길이 (바이트)
+ * @param tail 인자 배열
+ * @param tail_len 배열 길이 (바이트)
+ */
+typedef void (*EKF_CallObserver)(void *context, EKF_CallId call, const void *head, uint16_t head_len,
+                                 const void *tail, uint16_t tail_len);
+
+/**
+ * @brief 항법 해의 사원수 공분산 블록 원소 수 (4x4 상삼각)
+ */
+#define EKF_NAV_QUAT_COV_SIZE 10
+
+/**
+ * @brief 항법 오차 표현 차원과 성분 (몸체 좌표계 회전각 0..2, 속도 3..5, 위치 6..8)
+ *
+ * 필터 구성과 무관한 공통 표현으로, 보드 간 연합 융합(federated.h)에서 쓴다.
+ */
+#define EKF_NAV_ERROR_DIM 9
+#define EKF_NAV_ERROR_ATT 0x01u      /**< 회전각 성분 */
+#define EKF_NAV_ERROR_VEL 0x02u      /**< 속도 성분 */
+#define EKF_NAV_ERROR_POS 0x04u      /**< 위치 성분 (위치 블록이 있는 구성만) */
+
+/**
+ * @brief 위치 블록이 없는 구성의 항법 오차 위치 분산 (m^2, 알 수 없음 표시)
+ */
+#define EKF_NAV_ERROR_UNKNOWN_VAR 1.0e8f
+
+/**
+ * @brief 항법 해 스냅샷
+ * 
+ * 제어/텔레메트리가 한 번에 읽는 출력 묶음. 8바이트 정렬되어 DMA 전송이나
+ * 메모리 복사에 그대로 사용할 수 있다. p_quat는 자세 불확도를 각도로 옮길 때
+ * (nav_frames_get_attitude_sigma) 쓰며, 게시 경로에서는 복사만 한다.
+ */
+typedef struct {
+    uint32_t timestamp_us;   /**< 해의 유효 시각 (us, 호출자 제공) */
+    Vector3f pos;            /**< 위치 (NED 좌표계, m, 위치 블록 제외 시 0) */
+    Vector3f vel;            /**< 속도 (NED 좌표계, m/s) */
+    Quaternion q;            /**< 자세 사원수 (정규화됨) */
+    Vector3f gyro_bias;      /**< 자이로 바이어스 (rad/s) */
+    Vector3f accel_bias;     /**< 가속도 바이어스 (m/s^2, 가속도 바이어스 블록 제외 시 0) */
+    float apogee_time;       /**< 정점까지 남은 시간 (s, 상승 중이 아니면 0) */
+    float apogee_alt;        /**< 예측 정점 고도 (m, 위치 블록 제외 시 현재 대비 상승량) */
+    float p_diag[EKF_STATE_DIM]; /**< 공분산 대각 원소 (상태 인덱스 순) */
+    float p_quat[EKF_NAV_QUAT_COV_SIZE]; /**< 사원수 (w, x, y, z) 4x4 공분산 블록 (상삼각 압축, 행 순) */
+} __attribute__((aligned(8))) EKF_NavSolution;
+
+/**
+ * @brief EKF 구조체
+ */
+typedef struct {
+    union {
+        EKF_StateVector x;  /**< 상태 벡터 (N x 1) */
+        EKF_StateView s;    /**< 같은 상태의 블록별 보기 */
+    };
+    EKF_StateCovariance P;  /**< 공분산 행렬 (N x N, 상삼각 압축 저장) */
+    EKF_StateUD UD;         /**< 공분산 U-D 분해 (U-D 엔진에서만 사용) */
+    EKF_StateCovariance Q;  /**< 프로세스 노이즈 세기 (대각, 단위/s, 상삼각 압축 저장) */
+    EKF_DiscreteNoise Qd;   /**< 마지막 구간 길이의 이산 프로세스 노이즈 */
+    EKF_EpochCache epoch;   /**< 현재 자세의 회전 행렬 캐시 */
+    float vel_noise_inflation; /**< 속도 프로세스 노이즈 추가 세기 ((m/s)^2/s, 가속도 포화/혼합 중) */
+    Mat6x6 R_gps;   /**< GPS 측정 노이즈 공분산 (6x6, 속도 미사용 시 좌상단 3x3 사용) */
+    EKF_GpsAccuracy gps_acc;   /**< 다음 GNSS 갱신의 수신기 정확도 (0이면 R_gps 대각) */
+    float gps_acc_pos_max;     /**< 위치 성분 생략 문턱 (m, 0이면 생략 안 함) */
+    float gps_acc_vel_max;     /**< 속도 성분 생략 문턱 (m/s, 0이면 생략 안 함) */
+    uint32_t gps_acc_skip_count; /**< 정확도 문턱으로 생략한 GNSS 성분 수 (누적) */
+    Vector3f gps_lever_arm; /**< IMU -> GNSS 안테나 레버 암 (몸체 좌표계, m, 0이면 보정 없음) */
+    Vector3f gyro_last;     /**< 마지막 예측의 자이로 측정값 (rad/s, 레버 암 속도 보정용) */
+    float quat_norm_error;  /**< 저장된 자세 사원수의 |q|^2 - 1 추정 한계 (마지막 재정규화 기준) */
+    float pos_comp[3];      /**< 위치 적분 보상 합산 오차 (m, 다음 증분에서 되돌릴 잘린 하위 비트) */
+    Mat1x1 R_baro;  /**< 기압계 측정 노이즈 공분산 (1x1) */
+    Mat3x3 R_mag;   /**< 자력계 측정 노이즈 공분산 (3x3) */
+    Mat1x1 R_mag_heading; /**< 자력계 방위각 측정 노이즈 분산 (rad^2) */
+    Vector3f gnss_baseline; /**< 이중 안테나 기선 (주 -> 보조 안테나, 몸체 좌표계, m, 0이면 미설정) */
+    Mat1x1 R_gnss_heading; /**< GNSS 기선 방위 기본 노이즈 분산 (rad^2) */
+    Mat1x1 R_gnss_pitch;   /**< GNSS 기선 앙각 기본 노이즈 분산 (rad^2) */
+    Mat3x3 R_gravity; /**< 중력 방향 갱신 노이즈 공분산 (3x3, (m/s^2)^2) */
+    float gravity_tolerance; /**< 중력 방향 갱신 허용 크기 오차 (m/s^2) */
+    Mat3x3 R_zupt;  /**< 영속도 갱신 노이즈 공분산 (3x3) */
+    Mat1x1 R_rail;  /**< 레일 횡방향 영속도 노이즈 분산 ((m/s)^2) */
+    Mat3x3 R_drag;  /**< 항력 비력 측정 노이즈 공분산 (3x3, (m/s^2)^2, EKF_CONFIG_DRAG) */
+    bool rail_active;      /**< 레일 구속 중 */
+    float rail_length;     /**< 레일 유효 길이 (m, 이동 거리가 넘으면 구속 해제) */
+    float rail_distance;   /**< 구속 시작 후 기체 축 방향 이동 거리 (m) */
+    float rail_speed_last; /**< 마지막 레일 갱신의 기체 축 방향 속력 (m/s, 사다리꼴 적분용) */
+    
+    float gravity;  /**< 중력 가속도 (m/s^2) */
+    
+    Vector3f earth_mag_ned; /**< 지구 자기장 벡터 (NED 좌표계) */
+    float mag_magnitude_tolerance;   /**< 자력계 외란 검사 허용 상대 크기 오차 (0이면 검사 안 함) */
+    float mag_inclination_tolerance; /**< 자력계 외란 검사 허용 복각 오차 (rad, 0이면 검사 안 함) */
+    EKF_MagDisturbanceStats mag_disturbance; /**< 자력계 외란 통계 */
+    bool mag_bias_enabled;   /**< 자력계 바이어스 상태 추정 중 (EKF_CONFIG_MAG_BIAS) */
+    float mag_r_scale;       /**< 자력계 R 외부 배율 (사전 평균, 기본 1) */
+    
+    float drag_k;   /**< 항력 계수 추정값 (1/m, 항력 가속도 = k * |v|^2, EKF_CONFIG_DRAG이면 상태의 사본) */
+    
+    float baro_sound_speed;                        /**< 천음속 모델 음속 (m/s, 0이면 비활성) */
+    float baro_mach_scale[EKF_BARO_MACH_COUNT];    /**< 마하수별 기압계 R 배율 (0이면 갱신 생략) */
+    uint32_t baro_suppress_count;                  /**< 천음속 구간 기압계 갱신 생략 횟수 */
+    float baro_r_scale;                            /**< 기압계 R 외부 배율 (이중 기압계 사전 융합, 기본 1) */
+    
+    EKF_UpdateMode update_mode; /**< 측정 갱신 방식 */
+    EKF_CovarianceUpdate covariance_update; /**< 공분산 갱신 방식 */
+    EKF_Engine engine; /**< 공분산 필터 엔진 */
+    uint32_t consider_mask; /**< 고려 상태 마스크 (Schmidt 갱신, 0이면 모든 상태 갱신) */
+    
+    bool variance_bounds;              /**< 상태별 분산 경계 사용 여부 (경계가 하나라도 있으면 true) */
+    float variance_min[EKF_STATE_DIM]; /**< 상태별 분산 하한 (0이면 없음) */
+    float variance_max[EKF_STATE_DIM]; /**< 상태별 분산 상한 (INFINITY이면 없음) */
+    uint32_t variance_bound_count;     /**< 경계로 제한한 대각 원소 누적 수 */
+    
+    bool lazy_covariance;          /**< 공분산 지연 전파 사용 여부 */
+    float lazy_max_dt;             /**< 지연 전파 최대 누적 구간 (초) */
+    float lazy_dt;                 /**< 아직 P에 반영하지 않은 누적 구간 (초, 0이면 없음) */
+    MatrixSparseTransition lazy_phi; /**< 아직 P에 반영하지 않은 누적 전이 Φ */
+    
+    uint16_t bias_decimation;      /**< 바이어스 결합 반영 간격 (예측 횟수, 1 이하이면 분할 전파 안 함) */
+    uint16_t bias_pending;         /**< 아직 P에 반영하지 않은 바이어스 결합 누적 횟수 */
+    float bias_coupling[EKF_PARTITION_CORE_DIM][EKF_PARTITION_BIAS_DIM]; /**< 누적 핵심-바이어스 전이 */
+    
+    float nis_gate[EKF_SENSOR_COUNT];           /**< 측정별 NIS 게이트 임계값 (0 이하이면 비활성) */
+    float nis_last[EKF_SENSOR_COUNT];           /**< 측정별 마지막 NIS */
+    uint32_t nis_reject_count[EKF_SENSOR_COUNT]; /**< 측정별 게이트 거부 횟수 */
+    float nis_sum[EKF_SENSOR_COUNT];            /**< 측정별 NIS 누적 (일관성 평가용) */
+    uint32_t nis_count[EKF_SENSOR_COUNT];       /**< 측정별 NIS 누적 횟수 */
+    EKF_NisWindow nis_window[EKF_SENSOR_COUNT]; /**< 측정별 NIS 창 누적 */
+    uint16_t nis_recover_rejects[EKF_SENSOR_COUNT]; /**< 측정별 강제 수용까지 연속 거부 수 (0이면 횟수 조건 없음) */
+    uint32_t nis_recover_time_us[EKF_SENSOR_COUNT]; /**< 측정별 강제 수용까지 연속 거부 시간 (us, 0이면 시간 조건 없음) */
+    uint16_t nis_reject_streak[EKF_SENSOR_COUNT];  /**< 측정별 현재 연속 거부 수 */
+    uint32_t nis_reject_start_us[EKF_SENSOR_COUNT]; /**< 측정별 연속 거부 시작 시각 (gate_clock_us) */
+    uint32_t nis_recover_count[EKF_SENSOR_COUNT];  /**< 측정별 연속 거부 뒤 강제 수용 횟수 */
+    uint32_t gate_clock_us;        /**< 예측 dt 누적 시계 (us, 연속 거부 시간용, 순환) */
+    
+    bool adaptive_noise;           /**< 적응형 측정 노이즈 사용 여부 */
+    uint16_t adaptive_window;      /**< 혁신 통계 창 길이 (측정 수) */
+    float adaptive_scale_min;      /**< R 배율 하한 */
+    float adaptive_scale_max;      /**< R 배율 상한 */
+    EKF_AdaptiveNoise adaptive[EKF_SENSOR_COUNT]; /**< 측정별 혁신 통계 */
+    
+    bool steady_gain;              /**< 정상 상태 게인 모드 사용 여부 */
+    uint32_t steady_gain_mask;     /**< 게인을 고정할 측정 종류 마스크 (1 << EKF_Sensor) */
+    float steady_gain_tolerance;   /**< 수렴 판정 게인 상대 변화 */
+    uint16_t steady_gain_count;    /**< 수렴 판정 연속 측정 수 */
+    bool steady_frozen;            /**< 게인 고정 중 (공분산 전파와 갱신 생략) */
+    uint32_t steady_used;          /**< 재시작 이후 갱신된 측정 종류 마스크 */
+    uint32_t steady_converged;     /**< 게인이 수렴한 측정 종류 마스크 */
+    uint32_t steady_updates;       /**< 고정 게인으로 처리한 측정 수 */
+    EKF_SteadyGain steady[EKF_SENSOR_COUNT]; /**< 측정별 게인 기록 */
+    
+    EKF_InfoAccumulator info; /**< 정보 형식 묶음 갱신 누적기 */
+    
+    ScratchArena *scratch; /**< 작업 메모리 영역 (기본은 공유 정적 영역) */
+    
+    EKF_TransitionObserver transition_observer; /**< 공분산 전이 관찰 콜백 (NULL이면 없음) */
+    void *transition_context; /**< 관찰 콜백 인자 */
+    
+    EKF_CallObserver call_observer; /**< 공개 호출 관찰 콜백 (NULL이면 없음) */
+    void *call_context; /**< 호출 관찰 콜백 인자 */
+    uint8_t call_depth; /**< 관찰 중인 공개 호출 깊이 (안쪽 호출은 알리지 않음) */
+    
+    bool initialized; /**< 초기화 여부 */
+} EKF;
+
+/**
+ * @brief EKF 초기화
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 초기화 성공 여부
+ */
+bool ekf_init(EKF *ekf);
+
+/**
+ * @brief EKF 스크래치 영역 조회
+ * 
+ * 필터 커널의 큰 임시 행렬은 스택 대신 이 정적 영역에서 할당된다.
+ * ekf_set_scratch_arena로 따로 영역을 주지 않은 EKF 인스턴스가 모두 공유하므로,
+ * 그런 인스턴스의 EKF 함수는 한 태스크에서만 호출해야 한다.
+ * high_water로 실제 최대 사용량을 확인할 수 있다.
+ * 
+ * @return ScratchArena* 스크래치 영역 (첫 ekf_init 이후 유효)
+ */
+ScratchArena *ekf_get_scratch_arena(void);
+
+/**
+ * @brief 인스턴스 전용 스크래치 영역 지정
+ * 
+ * 영역을 따로 가진 인스턴스끼리는 공유하는 가변 상태가 없으므로 서로 다른
+ * 태스크(호스트에서는 스레드)에서 동시에 예측/갱신할 수 있다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param arena 스크래치 영역 (EKF_SCRATCH_SIZE 이상, NULL이면 공유 정적 영역으로 복귀)
+ * @return bool 성공 여부 (영역이 작으면 false)
+ */
+bool ekf_set_scratch_arena(EKF *ekf, ScratchArena *arena);
+
+/**
+ * @brief 공분산 전이 관찰 콜백 지정 (호스트 스무더용)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param observer 콜백 (NULL이면 해제)
+ * @param context 콜백 인자
+ * @return bool 성공 여부
+ */
+bool ekf_set_transition_observer(EKF *ekf, EKF_TransitionObserver observer, void *context);
+
+/**
+ * @brief 공개 호출 관찰 콜백 지정 (호출 기록기용)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param observer 콜백 (NULL이면 해제)
+ * @param context 콜백 인자
+ * @return bool 성공 여부
+ */
+bool ekf_set_call_observer(EKF *ekf, EKF_CallObserver observer, void *context);
+
+/**
+ * @brief 호출 기록 스냅샷 범위 (포인터 필드 앞까지의 EKF 구조체, 바이트)
+ */
+#define EKF_SNAPSHOT_SIZE offsetof(EKF, scratch)
+
+/**
+ * @brief 스냅샷 범위의 배치 지문 (구성, 구조체 크기, 주요 필드 위치)
+ *
+ * 대상 빌드와 호스트 빌드가 같은 값을 내야 스냅샷을 그대로 옮길 수 있다
+ * (열거형 크기 같은 ABI 차이도 여기서 드러난다).
+ *
+ * @return uint32_t 지문
+ */
+uint32_t ekf_snapshot_layout(void);
+
+/**
+ * @brief 이 호출을 관찰 콜백에 알려야 하는지 (공개 함수 구현용)
+ */
+#define EKF_CALL_OBSERVED(ekf) ((ekf) != NULL && (ekf)->call_observer != NULL && (ekf)->call_depth == 0)
+
+/**
+ * @brief 관찰하는 공개 호출 시작 (EKF_CALL_OBSERVED일 때만, 끝나면 ekf_call_exit)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param call 호출 종류
+ * @param head 인자 앞부분
+ * @param head_len 앞부분 길이
+ * @param tail 인자 배열 (없으면 NULL)
+ * @param tail_len 배열 길이
+ */
+static inline void ekf_call_enter(EKF *ekf, EKF_CallId call, const void *head, uint16_t head_len,
+                                  const void *tail, uint16_t tail_len) {
+    ekf->call_observer(ekf->call_context, call, head, head_len, tail, tail_len);
+    ekf->call_depth++;
+}
+
+/**
+ * @brief 관찰하는 공개 호출 끝
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param result 호출 결과
+ * @return bool result 그대로
+ */
+static inline bool ekf_call_exit(EKF *ekf, bool result) {
+    ekf->call_depth--;
+    return result;
+}
+
+/**
+ * @brief EKF 초기 상태 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param pos 초기 위치 (NED 좌표계, 위치 블록이 제외된 구성에서는 무시)
+ * @param vel 초기 속도 (NED 좌표계)
+ * @param q 초기 자세 사원수
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_initial_state(EKF *ekf, Vector3f pos, Vector3f vel, Quaternion q);
+
+/**
+ * @brief EKF 프로세스 노이즈 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param pos_std 위치 표준 편차 (m, 위치 블록이 제외된 구성에서는 무시)
+ * @param vel_std 속도 표준 편차 (m/s)
+ * @param att_std 자세 표준 편차 (rad)
+ * @param gyro_bias_std 자이로 바이어스 표준 편차 (rad/s)
+ * @param acc_bias_std 가속도 바이어스 표준 편차 (m/s^2, 가속도 바이어스 블록이 제외된 구성에서는 무시)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_process_noise(EKF *ekf, float pos_std, float vel_std, float att_std, 
+                          float gyro_bias_std, float acc_bias_std);
+
+/**
+ * @brief 속도 프로세스 노이즈 일시 증가 (가속도계 포화/고중력 가속도계 혼합 구간)
+ * 
+ * 예측 입력 가속도의 신뢰도가 떨어진 동안 속도(와 적분되는 위치) 잡음 세기에 더한다.
+ * ekf_set_process_noise의 공칭값은 유지되며, 0으로 되돌리면 공칭값만 남는다.
+ * 가속도 잡음 분산 σa^2, IMU 샘플 간격 T이면 q_vel = σa^2 T 이다.
+ * 값이 바뀔 때만 이산 노이즈 캐시를 다시 계산하므로 샘플마다 호출해도 된다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param q_vel 추가 세기 ((m/s)^2/s, 0 이상)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_velocity_noise_inflation(EKF *ekf, float q_vel);
+
+/**
+ * @brief EKF GPS 측정 노이즈 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param pos_std 위치 표준 편차 (m)
+ * @param vel_std 속도 표준 편차 (m/s), 속도 측정이 없는 경우 0
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_gps_noise(EKF *ekf, float pos_std, float vel_std);
+
+/**
+ * @brief 수신기 보고 GNSS 정확도 설정 (다음 GNSS 갱신부터 적용)
+ * 
+ * 보고가 있는 성분은 R_gps 대신 대각 R을 쓴다: x/y 위치는 h, z 위치는 v, 속도 세 축은 s의
+ * 제곱이다 (EKF_GPS_ACC_MIN_* 하한 적용, R_gps의 비대각 항은 쓰지 않음). 문턱
+ * (ekf_set_gps_accuracy_cutoff)을 넘는 성분은 갱신에서 빼므로 나빠진 해의 성분에 게인과
+ * 공분산 갱신을 쓰지 않는다. 묶음 갱신(ekf_update_coincident)도 같은 R과 문턱을 쓴다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param acc 정확도 (NULL이거나 값이 0이면 해당 성분은 R_gps 그대로)
+ * @return bool 설정 성공 여부 (음수나 유한하지 않은 값이면 false)
+ */
+bool ekf_set_gps_accuracy(EKF *ekf, const EKF_GpsAccuracy *acc);
+
+/**
+ * @brief 수신기 정확도 기반 GNSS 성분 생략 문턱 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param pos_max 위치 문턱 (m, 0이면 생략 안 함)
+ * @param vel_max 속도 문턱 (m/s, 0이면 생략 안 함)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_gps_accuracy_cutoff(EKF *ekf, float pos_max, float vel_max);
+
+/**
+ * @brief GNSS 안테나 레버 암 설정
+ * 
+ * 안테나가 IMU에서 떨어져 있으면 GPS 측정 예측을 안테나 위치로 옮긴다.
+ *   위치: p + R(q) l,  속도: v + R(q) (ω × l)  (ω = 마지막 자이로 - 자이로 바이어스)
+ * 자코비안에는 두 항의 사원수 미분(ekf_gen_body_to_nav)을 더한다. 자이로 바이어스에 대한
+ * 속도 항 R(q) [l×]는 희소 행 크기 제한으로 생략한다 (바이어스 오차 × 팔 길이 크기).
+ * 지연 갱신에서는 측정 시각 대신 현재의 자이로 값을 쓴다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param lever_arm IMU -> 안테나 벡터 (몸체 좌표계, m, 0이면 보정 없음)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_gps_lever_arm(EKF *ekf, Vector3f lever_arm);
+
+/**
+ * @brief EKF 기압계 측정 노이즈 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param baro_std 고도 표준 편차 (m)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_baro_noise(EKF *ekf, float baro_std);
+
+/**
+ * @brief 기압계 천음속 오차 모델 설정
+ * 
+ * 마하 1 부근에서는 충격파가 정압공을 지나며 기압 고도가 수백 m 튀므로, EKF 속력으로
+ * 마하수를 구해 기압계 R에 표의 배율을 곱한다. 배율 0인 구간(기본: 마하 0.8..1.3)에서는
+ * 갱신을 아예 생략하여 오염된 측정에 갱신 시간을 쓰지 않고 이후 재수렴 비용도 없앤다.
+ * 바람은 무시하고 대기 속도를 EKF 지면 속력으로 근사한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sound_speed 음속 (m/s, 0이면 모델 비활성)
+ * @param mach_scale 마하 0, 0.1, ... 2.0의 R 배율 (EKF_BARO_MACH_COUNT개, 0은 갱신 생략,
+ *                   NULL이면 현재 표 유지, 항목 사이는 선형 보간하되 이웃이 0이면 생략)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_baro_transonic(EKF *ekf, float sound_speed, const float mach_scale[EKF_BARO_MACH_COUNT]);
+
+/**
+ * @brief 기압계 R 외부 배율 설정 (다음 기압계 갱신부터 적용)
+ * 
+ * 이중 기압계 사전 융합(baro_dual.h)이 기압 주기마다 구한 분산 / R_baro를 넘긴다.
+ * 천음속 배율과 곱해지므로 생략 구간은 그대로 생략된다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param scale R 배율 (양수, 1이면 R_baro 그대로)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_baro_noise_scale(EKF *ekf, float scale);
+
+/**
+ * @brief 현재 기압계 R 배율 (천음속 오차 모델 x 외부 배율)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return float R 배율 (모델 비활성이면 외부 배율, 갱신 생략 구간이면 0)
+ */
+float ekf_get_baro_noise_scale(const EKF *ekf);
+
+/**
+ * @brief EKF 자력계 측정 노이즈 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mag_std 자기장 표준 편차 (uT)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_mag_noise(EKF *ekf, float mag_std);
+
+/**
+ * @brief 자력계 R 외부 배율 설정 (다음 ekf_update_mag부터 적용)
+ * 
+ * 자력계 사전 평균(mag_average.h)이 평균한 샘플 수에 맞춘 배율을 넘긴다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param scale R 배율 (양수, 1이면 R_mag 그대로)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_mag_noise_scale(EKF *ekf, float scale);
+
+/**
+ * @brief 이중 안테나 GNSS 기선 설정 (ekf_update_gnss_heading)
+ * 
+ * 이동 기준국(주 안테나)에서 보조 안테나까지의 벡터이다. NAV-RELPOSNED는 보조 수신기가
+ * 주 수신기 기준의 상대 위치로 내보내므로 같은 방향으로 잰다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param baseline 주 -> 보조 안테나 벡터 (몸체 좌표계, m)
+ * @return bool 설정 성공 여부 (길이가 0이거나 유한하지 않으면 false)
+ */
+bool ekf_set_gnss_baseline(EKF *ekf, Vector3f baseline);
+
+/**
+ * @brief 이중 안테나 GNSS 기선 기본 노이즈 설정 (측정에 표준 편차가 없을 때)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param heading_std 방위 표준 편차 (rad)
+ * @param pitch_std 앙각 표준 편차 (rad)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_gnss_heading_noise(EKF *ekf, float heading_std, float pitch_std);
+
+/**
+ * @brief EKF 자력계 방위각 측정 노이즈 설정 (ekf_update_mag_heading)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param heading_std 방위각 표준 편차 (rad)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_mag_heading_noise(EKF *ekf, float heading_std);
+
+/**
+ * @brief 자력계 외란 사전 검사 설정 (ekf_update_mag)
+ * 
+ * 모터 점화, 분리 화약 등으로 자기장이 왜곡된 측정은 크기와 복각이 기준(earth_mag_ned)에서
+ * 벗어나므로 자코비안과 게인을 계산하기 전에 버린다. 복각은 현재 자세의 아래 방향으로 구하며,
+ * 허용 폭에 기울기 표준 편차의 3배를 더한다. 크기 검사는 입력이 earth_mag_ned와 같은 단위일 때만
+ * 쓴다 (fusion_scheduler는 보정 후 정규화한 벡터를 넘기므로 기본값은 끔, 복각은 단위와 무관).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param magnitude_tol 허용 상대 크기 오차 (| |m| / |m_earth| - 1 |, 0이면 검사 안 함)
+ * @param inclination_tol 허용 복각 오차 (rad, 0이면 검사 안 함)
+ * @return bool 설정 성공 여부 (음수이면 false)
+ */
+bool ekf_set_mag_disturbance_check(EKF *ekf, float magnitude_tol, float inclination_tol);
+
+/**
+ * @brief EKF 중력 방향 갱신 노이즈와 크기 허용 오차 설정 (ekf_update_gravity)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param accel_std 축별 가속도 표준 편차 (m/s^2, 진동과 남은 운동 가속도 포함)
+ * @param tolerance 허용 크기 오차 (m/s^2, | |a| - g |가 이보다 크면 갱신 생략)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_gravity_noise(EKF *ekf, float accel_std, float tolerance);
+
+/**
+ * @brief EKF 영속도 갱신(ZUPT) 노이즈 설정
+ * 
+ * 정지 판정 중에도 남는 진동/흔들림 속도 크기로 설정한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param vel_std 속도 표준 편차 (m/s)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_zupt_noise(EKF *ekf, float vel_std);
+
+/**
+ * @brief EKF 발사 레일 구속 시작/해제
+ * 
+ * 레일 위에서는 기체가 몸체 z축(기체 길이 방향)으로만 움직이므로, 켜져 있는 동안
+ * ekf_update_rail이 몸체 x/y 속도 0을 의사 측정으로 융합한다. 이동 거리는 시작 시
+ * 0으로 돌아간다. 발사대 정지 중(ZUPT 구간)이나 발사 검출 시각에 켠다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param enable 구속 여부 (false이면 즉시 해제)
+ * @param rail_length 레일 유효 길이 (m, 레일 끝까지 남은 길이에서 런치 러그 위치를 뺀 값)
+ * @param vel_std 횡방향 속도 표준 편차 (m/s, 0 이하이면 EKF_RAIL_DEFAULT_VEL_STD)
+ * @return bool 설정 성공 여부 (켤 때 초기화 전이거나 rail_length가 양수가 아니면 false)
+ */
+bool ekf_set_rail_constraint(EKF *ekf, bool enable, float rail_length, float vel_std);
+
+/**
+ * @brief EKF 발사 레일 구속 중 여부
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 구속 중이면 true (레일 이탈 후 false)
+ */
+bool ekf_is_rail_constrained(const EKF *ekf);
+
+/**
+ * @brief EKF 지구 자기장 벡터 설정
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mag_ned 지구 자기장 벡터 (NED 좌표계)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_earth_magnetic_field(EKF *ekf, Vector3f mag_ned);
+
+/**
+ * @brief EKF 측정 갱신 방식 설정
+ * 
+ * 순차 방식은 R의 대각 원소만 사용하므로, 비대각 원소가 있는
+ * 측정 노이즈를 사용하려면 일괄 방식을 선택해야 한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mode 측정 갱신 방식
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_update_mode(EKF *ekf, EKF_UpdateMode mode);
+
+/**
+ * @brief 공분산 갱신 방식 설정
+ * 
+ * 기본값은 Joseph 형식이다. 단정밀도에서 긴 비행 동안 P의 대칭성과
+ * 양의 정부호성을 유지하며, 표준 형식은 연산량이 더 적다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mode 공분산 갱신 방식
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_covariance_update(EKF *ekf, EKF_CovarianceUpdate mode);
+
+/**
+ * @brief 공분산 필터 엔진 설정
+ * 
+ * U-D 엔진으로 전환하면 현재 P를 U-D로 분해한다. U-D 엔진에서는 측정 갱신 방식과
+ * 공분산 갱신 방식 설정을 무시하고 항상 순차 Bierman 갱신을 사용한다.
+ * P를 직접 수정한 경우에는 이 함수를 다시 호출하여 분해를 갱신해야 한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param engine 공분산 필터 엔진
+ * @return bool 설정 성공 여부 (P가 양의 정부호가 아니면 false, 엔진은 변경됨)
+ */
+bool ekf_set_engine(EKF *ekf, EKF_Engine engine);
+
+/**
+ * @brief 고려(consider) 상태 설정 (Schmidt-Kalman 갱신)
+ * 
+ * 마스크의 상태는 공분산이 게인 계산에 그대로 쓰이지만, 측정 갱신에서 그 상태값과
+ * 고려 상태끼리의 공분산 블록은 바뀌지 않는다 (해당 게인 행을 0으로 둔 갱신).
+ * 다른 상태와의 교차 공분산은 갱신되므로 필터는 일관성을 유지한다. 수렴한 바이어스를
+ * 추력 구간 동안 고정해 일시적 오차를 흡수하지 않게 하고, 고려 블록 갱신 연산을 줄인다.
+ * 예측(전파)은 그대로 적용된다. U-D 엔진은 Bierman 갱신을 쓰므로 마스크를 무시한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mask 상태 비트 마스크 (EKF_CONSIDER_GYRO_BIAS | EKF_CONSIDER_ACCEL_BIAS 등, 0이면 해제)
+ * @return bool 설정 성공 여부 (상태 차원 밖의 비트가 있으면 false)
+ */
+bool ekf_set_consider_states(EKF *ekf, uint32_t mask);
+
+/**
+ * @brief 상태 블록별 분산 하한/상한 설정
+ * 
+ * 긴 대기 구간에서 관측되는 바이어스 분산은 0으로 줄고 GNSS 없는 위치 분산은 끝없이
+ * 커지므로 단정밀도 P의 조건수가 나빠진다. 경계는 공분산 전파(노이즈 가산 뒤)와 측정
+ * 갱신(대칭 차감/Joseph 뒤)마다 압축 대칭 커널(bound_diagonal)로 적용한다. 경계 안이면
+ * 대각 N개만 읽고, 상한에 걸린 행만 sqrt(max / P_ii)배 하여 상관 계수를 유지한다.
+ * 하한은 대각만 올리므로 상관 계수가 줄기만 한다. 두 경우 모두 양의 준정부호가 유지된다.
+ * U-D 엔진은 분해가 양의 정부호를 보장하므로 경계를 적용하지 않는다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mask 상태 비트 마스크 (EKF_STATE_MASK(EKF_STATE_GYRO_BIAS_X, 3) 등)
+ * @param min_var 분산 하한 (0이면 하한 없음)
+ * @param max_var 분산 상한 (INFINITY이면 상한 없음, min_var 이상)
+ * @return bool 설정 성공 여부 (상태 차원 밖의 비트가 있거나 경계가 잘못되면 false)
+ */
+bool ekf_set_variance_bounds(EKF *ekf, uint32_t mask, float min_var, float max_var);
+
+/**
+ * @brief 측정 혁신 게이트 설정
+ * 
+ * 정규화 혁신 제곱 NIS = y^T * S^-1 * y 가 임계값을 넘으면 측정을 거부하고
+ * 게인/공분산 갱신 없이 false를 반환한다. 일괄 방식은 전체 S를 사용하고,
+ * 순차 방식은 갱신 전 P로 계산한 S의 대각 원소만 사용한다 (Σ y_k^2 / S_kk).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param threshold 카이제곱 임계값 (0 이하이면 게이트 비활성)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_innovation_gate(EKF *ekf, EKF_Sensor sensor, float threshold);
+
+/**
+ * @brief 마지막 측정 갱신의 NIS 조회
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @return float 마지막 NIS (갱신 기록이 없으면 0)
+ */
+float ekf_get_innovation_nis(const EKF *ekf, EKF_Sensor sensor);
+
+/**
+ * @brief 게이트 거부 횟수 조회
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @return uint32_t 거부 횟수
+ */
+uint32_t ekf_get_innovation_reject_count(const EKF *ekf, EKF_Sensor sensor);
+
+/**
+ * @brief 게이트 연속 거부 복구 조건 설정
+ * 
+ * 연속 거부가 max_rejects번이나 max_time_s초(예측 dt 누적)에 닿으면 다음 측정 하나를 게이트
+ * 없이 수용하고 연속 거부를 다시 센다. 둘 다 0이면 복구하지 않는다 (거부가 계속될 수 있음).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param max_rejects 연속 거부 수 한계 (0이면 횟수 조건 없음)
+ * @param max_time_s 연속 거부 시간 한계 (초, 0 이하이면 시간 조건 없음)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_innovation_gate_recovery(EKF *ekf, EKF_Sensor sensor, uint16_t max_rejects, float max_time_s);
+
+/**
+ * @brief 연속 거부 뒤 강제 수용 횟수 조회
+ * 
+ * 0이 아니면 필터 공분산이 실제 오차를 따라가지 못한 구간이 있었다는 뜻이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @return uint32_t 강제 수용 횟수
+ */
+uint32_t ekf_get_innovation_recover_count(const EKF *ekf, EKF_Sensor sensor);
+
+/**
+ * @brief 현재 연속 거부 수 조회
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @return uint16_t 마지막 수용 이후 거부 수
+ */
+uint16_t ekf_get_innovation_reject_streak(const EKF *ekf, EKF_Sensor sensor);
+
+/**
+ * @brief 측정별 평균 NIS 조회 (ekf_init 이후 모든 갱신, 게이트 거부 포함)
+ * 
+ * 잡음 모델이 맞으면 평균 NIS는 측정 차원에 가깝다 (필터 일관성 평가).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param count 누적 횟수 (NULL 가능)
+ * @return float 평균 NIS (기록이 없으면 0)
+ */
+float ekf_get_innovation_nis_mean(const EKF *ekf, EKF_Sensor sensor, uint32_t *count);
+
+/**
+ * @brief 측정별 NIS 창 누적을 꺼내고 비움 (융합 문맥)
+ * 
+ * 혁신 게이트 한 곳에서 누적하므로 다중 필터 건전성(ekf_lanes.h, nis_last)과 같은 NIS를 본다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param out 지난 호출 이후의 누적
+ * @return bool 성공 여부
+ */
+bool ekf_take_nis_window(EKF *ekf, EKF_Sensor sensor, EKF_NisWindow *out);
+
+/**
+ * @brief 적응형 측정 노이즈 설정
+ * 
+ * 활성화하면 측정 갱신마다 축별 혁신 통계를 갱신하고, 창 길이만큼 측정이 쌓인 뒤부터
+ * ekf_set_*_noise로 설정한 공칭 R을 축별 배율로 조정하여 사용한다
+ * (R_ij * sqrt(s_i * s_j), 대각 배율만 추정하므로 측정당 O(m)).
+ * 혁신 게이트로 거부된 측정도 통계에 포함하므로, 노이즈가 지속적으로 커지면
+ * R이 따라 커져 게이트를 다시 통과한다. 호출 시 통계를 초기화한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param enable 사용 여부 (기본 비활성)
+ * @param window 통계 창 길이 (측정 수, 1 이상)
+ * @param scale_min R 배율 하한 (양수)
+ * @param scale_max R 배율 상한 (scale_min 이상)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_adaptive_noise(EKF *ekf, bool enable, uint16_t window, float scale_min, float scale_max);
+
+/**
+ * @brief 현재 적용 중인 R 배율 조회
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param axis 측정 축 (0부터)
+ * @return float R 배율 (비활성 또는 잘못된 인자이면 1)
+ */
+float ekf_get_noise_scale(const EKF *ekf, EKF_Sensor sensor, uint8_t axis);
+
+/**
+ * @brief 정상 상태 게인 모드 설정
+ * 
+ * 발사대처럼 측정 주기가 일정한 구간에서는 칼만 게인이 수 초 안에 상수로 수렴한다.
+ * 활성화하면 sensor_mask의 측정은 갱신마다 게인 변화를 감시하고, 재시작 이후 갱신된
+ * 모든 측정 종류의 게인이 수렴하면 게인을 고정한다. 고정 중에는
+ * - 예측은 상태만 적분하고 공분산 전파(지연 전파, 분할 전파 포함)를 생략한다
+ * - 고정된 측정은 저장한 K와 S^-1로 x += K y 만 수행한다 (PH^T, HPH^T, 공분산 갱신 생략)
+ * 다음 경우 게인 기록을 지우고 전체 계산으로 돌아간다 (P는 고정 직전 값에서 이어감).
+ * - 고정 게인 측정이 혁신 게이트로 거부됨
+ * - 고정되지 않은 측정 종류(마스크 밖, 측정 차원 초과 포함)가 들어옴
+ * - 고정 당시와 R 대각이 다름
+ * - ekf_steady_gain_reset 호출 (비행 단계 전이 시 융합 스케줄러가 호출)
+ * 적응형 측정 노이즈를 쓰는 동안에는 R이 바뀌므로 이 모드를 적용하지 않는다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param enable 사용 여부 (기본 비활성)
+ * @param sensor_mask 게인을 고정할 측정 종류 마스크 (1 << EKF_Sensor, 예: 기압계/ZUPT/ZARU)
+ * @param tolerance 수렴 판정 게인 상대 변화 (0 이하이면 기본값)
+ * @param count 수렴 판정 연속 측정 수 (0이면 기본값)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_steady_gain(EKF *ekf, bool enable, uint32_t sensor_mask, float tolerance, uint16_t count);
+
+/**
+ * @brief 정상 상태 게인 기록 초기화 (전체 계산 재개)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool ekf_steady_gain_reset(EKF *ekf);
+
+/**
+ * @brief 게인 고정 여부
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 고정 게인으로 동작 중이면 true
+ */
+bool ekf_is_steady_gain_frozen(const EKF *ekf);
+
+/**
+ * @brief EKF 예측 단계 (IMU 데이터 기반)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param accel 가속도 측정값 (m/s^2)
+ * @param dt 시간 간격 (초)
+ * @return bool 예측 성공 여부
+ */
+bool ekf_predict(EKF *ekf, Vector3f gyro, Vector3f accel, float dt);
+
+/**
+ * @brief EKF 상태 적분만 수행 (공분산 전파 없음)
+ * 
+ * 지연 측정 융합 후 과거 IMU 샘플로 상태를 다시 적분할 때 사용한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param accel 가속도 측정값 (m/s^2)
+ * @param dt 시간 간격 (초)
+ * @return bool 적분 성공 여부
+ */
+bool ekf_predict_state_only(EKF *ekf, Vector3f gyro, Vector3f accel, float dt);
+
+/**
+ * @brief EKF 자세 전용 예측 단계 (정지 상태용)
+ * 
+ * 발사대 대기처럼 기체가 정지한 동안 사용한다. 자세만 적분하고 속도와 위치는
+ * 유지하며, 전이 행렬은 자세-자이로 바이어스 블록만 포함한다. 프로세스 노이즈는
+ * 전체 상태에 더해지므로 속도/위치 불확실성은 정지 측정 갱신으로 억제해야 한다.
+ * 여러 IMU 샘플의 평균 자이로와 합산 dt로 낮은 주기로 호출할 수 있다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param gyro 자이로 측정값 (rad/s, 구간 평균)
+ * @param dt 시간 간격 (초)
+ * @return bool 예측 성공 여부
  */
-typedef enum {
-    EKF_STATE_POS_X = 0,   /**< 위치 X */
-    EKF_STATE_POS_Y = 1,   /**< 위치 Y */
-    EKF_STATE_POS_Z = 2,   /**< 위치 Z */
-    EKF_STATE_VEL_X = 3,   /**< 속도 X */
-    EKF_STATE_VEL_Y = 4,   /**< 속도 Y */
-    EKF_STATE_VEL_Z = 5,   /**< 속도 Z */
-    EKF_STATE_QUAT_W = 6,  /**< 사원수 W */
-    EKF_STATE_QUAT_X = 7,  /**< 사원수 X */
-    EKF_STATE_QUAT_Y = 8,  /**< 사원수 Y */
-    EKF_STATE_QUAT_Z = 9,  /**< 사원수 Z */
-    EKF_STATE_GYRO_BIAS_X = 10, /**< 자이로 바이어스 X */
-    EKF_STATE_GYRO_BIAS_Y = 11, /**< 자이로 바이어스 Y */
-    EKF_STATE_GYRO_BIAS_Z = 12, /**< 자이로 바이어스 Z */
-    EKF_STATE_ACC_BIAS_X = 13,  /**< 가속도 바이어스 X */
-    EKF_STATE_ACC_BIAS_Y = 14,  /**< 가속도 바이어스 Y */
-    EKF_STATE_ACC_BIAS_Z = 15   /**< 가속도 바이어스 Z */
-} EKF_StateIndex;
+bool ekf_predict_attitude(EKF *ekf, Vector3f gyro, float dt);
 
 /**
- * @brief EKF 구조체
+ * @brief EKF 일괄 예측 단계 (IMU 샘플 n개마다 공분산 전파 1회)
+ * 
+ * 상태(자세, 속도, 위치)는 샘플마다 적분하고, 상태 전이 행렬은 누적하여
+ * 공분산 P는 일괄 끝에서 한 번만 전파한다. 일괄 크기 n으로 공분산 전파 주기를
+ * 정한다 (예: 1 kHz IMU, n = 10 이면 100 Hz 전파).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param samples IMU 샘플 배열 (시간 순서)
+ * @param n 샘플 수 (일괄 크기)
+ * @return bool 예측 성공 여부 (dt <= 0 인 샘플이 있으면 아무것도 갱신하지 않고 false)
  */
-typedef struct {
-    Matrix x;       /**< 상태 벡터 (16x1) */
-    Matrix P;       /**< 공분산 행렬 (16x16) */
-    Matrix Q;       /**< 프로세스 노이즈 공분산 (16x16) */
-    Matrix R_gps;   /**< GPS 측정 노이즈 공분산 (3x3 또는 6x6) */
-    Matrix R_baro;  /**< 기압계 측정 노이즈 공분산 (1x1) */
-    Matrix R_mag;   /**< 자력계 측정 노이즈 공분산 (3x3) */
-    
-    float gravity;  /**< 중력 가속도 (m/s^2) */
-    
-    Vector3f earth_mag_ned; /**< 지구 자기장 벡터 (NED 좌표계) */
-    
-    bool initialized; /**< 초기화 여부 */
-} EKF;
+bool ekf_predict_batch(EKF *ekf, const EKF_ImuSample *samples, uint16_t n);
 
 /**
- * @brief EKF 초기화
+ * @brief 공분산 지연 전파 설정
+ * 
+ * 보조 측정이 한동안 오지 않는 구간(GNSS 단절, 자력계 비활성 등)에서 IMU 샘플마다
+ * P를 전파하지 않고 전이 행렬만 Φ = F_k * Φ로 누적한다. F = I + E의 비영 블록
+ * (위치-속도-가속도 바이어스, 사원수-자이로 바이어스, 시계)은 곱해도 같은 구조를
+ * 유지하므로 누적은 희소 곱으로 끝난다. 누적분은 측정 갱신 직전, 누적 구간이
+ * max_dt에 이르렀을 때, 또는 ekf_flush_covariance 호출 시 한 번에 P에 반영한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @return bool 초기화 성공 여부
+ * @param enable 사용 여부 (끄면 누적분을 곧바로 반영)
+ * @param max_dt 최대 누적 구간 (초, 0 이하이면 EKF_LAZY_DEFAULT_MAX_DT)
+ * @return bool 성공 여부
  */
-bool ekf_init(EKF *ekf);
+bool ekf_set_lazy_covariance(EKF *ekf, bool enable, float max_dt);
 
 /**
- * @brief EKF 초기 상태 설정
+ * @brief 분할 공분산 전파 설정 (바이어스 결합 블록 간격 전파)
+ * 
+ * 전이 행렬 Φ = [[A, B], [0, I]] (A: 핵심 블록, B: 핵심-바이어스 결합)는
+ * [[I, B], [0, I]] * [[A, 0], [0, I]]로 나뉜다. 분할 전파는 매 예측마다 A와
+ * 프로세스 노이즈만 P에 적용하고, 결합은 Bc = A * Bc + B로 누적해 decimation번마다
+ * 한 번 P에 반영한다. 매 단계의 희소 전파에서 대부분을 차지하는 결합 항
+ * (사원수-자이로 바이어스, 속도-가속도 바이어스)이 간격마다 한 번으로 줄어든다.
+ * 누적 구간 안의 바이어스 노이즈는 1차 교차 항까지 반영하고, 결합을 두 번 거쳐
+ * 핵심 블록으로 들어가는 2차 항(Bc Qb Bc^T)은 무시한다. 누적분은 측정 갱신과
+ * ekf_flush_covariance에서도 반영되며, 지연 전파가 켜져 있으면 지연 전파가 우선한다.
+ * U-D 엔진에서는 P를 직접 고칠 수 없으므로 분할하지 않고 매번 전체 전파한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param pos 초기 위치 (NED 좌표계)
- * @param vel 초기 속도 (NED 좌표계)
- * @param q 초기 자세 사원수
- * @return bool 설정 성공 여부
+ * @param decimation 결합 반영 간격 (예측 횟수, 1 이하이면 매 예측마다 전체 전파)
+ * @return bool 성공 여부
  */
-bool ekf_set_initial_state(EKF *ekf, Vector3f pos, Vector3f vel, Quaternion q);
+bool ekf_set_bias_decimation(EKF *ekf, uint16_t decimation);
 
 /**
- * @brief EKF 프로세스 노이즈 설정
+ * @brief 지연 전파 또는 분할 전파 중인 누적 전이를 P에 반영
+ * 
+ * 현재 공분산이 필요한 곳(진단, 외부 공분산 조회)에서 호출한다. 측정 갱신은 자동으로 호출한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param pos_std 위치 표준 편차 (m)
- * @param vel_std 속도 표준 편차 (m/s)
- * @param att_std 자세 표준 편차 (rad)
- * @param gyro_bias_std 자이로 바이어스 표준 편차 (rad/s)
- * @param acc_bias_std 가속도 바이어스 표준 편차 (m/s^2)
- * @return bool 설정 성공 여부
+ * @return bool 성공 여부 (스크래치 영역 부족 시 false, 누적분 유지)
  */
-bool ekf_set_process_noise(EKF *ekf, float pos_std, float vel_std, float att_std, 
-                          float gyro_bias_std, float acc_bias_std);
+bool ekf_flush_covariance(EKF *ekf);
 
 /**
- * @brief EKF GPS 측정 노이즈 설정
+ * @brief EKF GPS 측정 갱신
+ * 
+ * ekf_update_gps_partial(위치, use_vel이면 위치 + 속도)과 같다.
+ * 위치 블록이 제외된 구성(EKF_CONFIG_POSITION = 0)에서는 gps_pos를 무시하고
+ * 속도만 EKF_SENSOR_GPS_POS_VEL 게이트(3자유도 기본값)로 갱신하며, use_vel이 false이면 false를 반환한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param pos_std 위치 표준 편차 (m)
- * @param vel_std 속도 표준 편차 (m/s), 속도 측정이 없는 경우 0
- * @return bool 설정 성공 여부
+ * @param gps_pos GPS 위치 측정값 (NED 좌표계, m)
+ * @param use_vel GPS 속도 사용 여부
+ * @param gps_vel GPS 속도 측정값 (NED 좌표계, m/s)
+ * @return bool 갱신 성공 여부
  */
-bool ekf_set_gps_noise(EKF *ekf, float pos_std, float vel_std);
+bool ekf_update_gps(EKF *ekf, Vector3f gps_pos, bool use_vel, Vector3f gps_vel);
 
 /**
- * @brief EKF 기압계 측정 노이즈 설정
+ * @brief EKF GPS 부분 측정 갱신
+ * 
+ * components로 고른 성분만 그 차원의 관측으로 융합한다 (버리는 행 없음).
+ * - 위치 전용 / 속도 전용: 3차원, 위치 + 속도: 6차원
+ * - EKF_GPS_NO_VERTICAL: 수평 위치 2, 수평 속도 2, 수평 위치 + 속도 4차원
+ * R은 R_gps에서 고른 성분의 부분 행렬이다 (수신기 정확도가 있으면 ekf_set_gps_accuracy의 대각 R이고,
+ * 문턱을 넘는 성분은 뺀다). 3/6차원이 아닌 관측은 갱신 방식과 무관하게 순차 갱신
+ * (정상 상태 게인 미적용)으로 처리한다. 게이트는 속도를 포함하면 EKF_SENSOR_GPS_POS_VEL,
+ * 아니면 EKF_SENSOR_GPS_POS를 쓴다 (수직 제외 시에도 같은 임계값).
+ * 위치 블록이 제외된 구성에서는 위치 성분을 무시한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param baro_std 고도 표준 편차 (m)
- * @return bool 설정 성공 여부
+ * @param gps_pos GPS 위치 측정값 (NED 좌표계, m)
+ * @param gps_vel GPS 속도 측정값 (NED 좌표계, m/s)
+ * @param components 융합할 성분 (EKF_GpsComponent 조합)
+ * @return bool 갱신 성공 여부 (융합할 성분이 없으면 false)
  */
-bool ekf_set_baro_noise(EKF *ekf, float baro_std);
+bool ekf_update_gps_partial(EKF *ekf, Vector3f gps_pos, Vector3f gps_vel, uint8_t components);
 
 /**
- * @brief EKF 자력계 측정 노이즈 설정
+ * @brief EKF 기압계 측정 갱신
+ * 
+ * R_baro에 천음속 오차 모델 배율(ekf_get_baro_noise_scale)을 곱해 융합한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param mag_std 자기장 표준 편차 (uT)
- * @return bool 설정 성공 여부
+ * @param baro_alt 기압계 고도 측정값 (m, 음수는 아래 방향)
+ * @return bool 갱신 성공 여부 (위치 블록이 제외된 구성이나 천음속 생략 구간에서는 false)
  */
-bool ekf_set_mag_noise(EKF *ekf, float mag_std);
+bool ekf_update_baro(EKF *ekf, float baro_alt);
 
 /**
- * @brief EKF 지구 자기장 벡터 설정
+ * @brief 같은 시각의 GNSS/기압계 측정을 한 번의 갱신으로 융합
+ * 
+ * 측정을 하나의 희소 H와 블록 대각 R(블록 안도 대각, 순차 갱신과 같은 가정)로 쌓아
+ * 한 번의 순차 패스로 처리한다 (ekf_can_coalesce가 true일 때).
+ * - PH^T는 모든 행에 대해 한 번만 모으고, 앞선 스칼라 갱신의 영향은 뒤 행의 PH^T에
+ *   랭크 1 보정 (PH^T)_j -= K_k (h_j (PH^T)_k) 으로 반영한다
+ * - 공분산은 마지막에 P -= Σ K_k (PH^T)_k^T 로 한 번만 다시 쓴다
+ * - 혁신 게이트는 측정 종류별로 갱신 전 P의 S 대각 근사로 따로 판정하며,
+ *   거부된 측정의 행만 빠진다
+ * ekf_can_coalesce가 false이면 GNSS, 기압계 순으로 ekf_update_gps/ekf_update_baro를 호출한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param mag_ned 지구 자기장 벡터 (NED 좌표계)
- * @return bool 설정 성공 여부
+ * @param m 측정 묶음 (결과 필드 기록)
+ * @return bool 하나 이상 반영했으면 true
  */
-bool ekf_set_earth_magnetic_field(EKF *ekf, Vector3f mag_ned);
+bool ekf_update_coincident(EKF *ekf, EKF_CoincidentMeasurement *m);
 
 /**
- * @brief EKF 예측 단계 (IMU 데이터 기반)
+ * @brief 동시 측정 묶음 갱신을 공유 패스로 처리할 수 있는지 여부
+ * 
+ * 표준 형식 공분산 갱신, 공분산 엔진, 고려 상태 없음, 적응형 R과 정상 상태 게인 비활성,
+ * 정보 형식 누적 중 아님, 위치 블록 포함 구성일 때만 true이다
+ * (그 밖에는 측정별 갱신과 결과가 달라짐).
  * 
  * @param ekf EKF 구조체 포인터
- * @param gyro 자이로 측정값 (rad/s)
- * @param accel 가속도 측정값 (m/s^2)
- * @param dt 시간 간격 (초)
- * @return bool 예측 성공 여부
+ * @return bool 공유 패스 사용 가능 여부
  */
-bool ekf_predict(EKF *ekf, Vector3f gyro, Vector3f accel, float dt);
+bool ekf_can_coalesce(const EKF *ekf);
 
 /**
- * @brief EKF GPS 측정 갱신
+ * @brief 정보 형식 묶음 갱신 시작
+ * 
+ * 이후 ekf_info_apply까지의 측정 갱신(ekf_update_gps, ekf_update_baro, ekf_update_mag 등
+ * 같은 API 그대로)은 공분산을 갱신하지 않고 정보 형식으로 누적만 한다.
+ * - 측정마다 R 대각(순차 갱신과 같은 가정)과 희소 H로 Λ += H^T R^-1 H, η += H^T R^-1 y 를
+ *   관측이 닿은 상태 성분에만 더한다 (행당 비영 원소 수의 제곱만큼의 곱셈)
+ * - 잔차와 혁신 게이트(S 대각 근사)는 묶음 시작 시각의 x, P로 계산한다
+ * - 적응형 R은 적용하고, 정상 상태 게인은 적용하지 않는다
+ * 누적 중 예측이 호출되면 먼저 누적분을 반영하고 묶음을 끝낸다.
+ * 외부에서 P를 바꾸면(초기 상태/공분산 설정, 엔진 변경 등) 누적분은 버린다.
+ * 공분산 엔진에서 고려 상태가 없을 때만 사용할 수 있다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param gps_pos GPS 위치 측정값 (NED 좌표계, m)
- * @param use_vel GPS 속도 사용 여부
- * @param gps_vel GPS 속도 측정값 (NED 좌표계, m/s)
- * @return bool 갱신 성공 여부
+ * @return bool 시작 여부 (U-D 엔진, 고려 상태 사용 중이면 false, 이미 누적 중이면 true)
  */
-bool ekf_update_gps(EKF *ekf, Vector3f gps_pos, bool use_vel, Vector3f gps_vel);
+bool ekf_info_begin(EKF *ekf);
 
 /**
- * @brief EKF 기압계 측정 갱신
+ * @brief 정보 형식 누적분 반영 후 묶음 종료
+ * 
+ * 관측이 닿은 상태 T (k개)에 대해 P+ = (P^-1 + Λ)^-1 을 k x k 풀이 한 번으로 계산한다.
+ *   W = (I + Λ_TT P_TT)^-1 Λ_TT
+ *   P+ = P - P_:T W P_T:,  Δx = P_:T (η_T - W P_TT η_T)
+ * 센서 수와 무관하게 공분산은 사이클당 한 번만 다시 쓴다 (표준 형식, Joseph 설정과 무관).
  * 
  * @param ekf EKF 구조체 포인터
- * @param baro_alt 기압계 고도 측정값 (m, 음수는 아래 방향)
- * @return bool 갱신 성공 여부
+ * @return bool 성공 여부 (누적 중이 아니었거나 누적분이 없으면 true, 풀이 실패 시 false)
  */
-bool ekf_update_baro(EKF *ekf, float baro_alt);
+bool ekf_info_apply(EKF *ekf);
+
+/**
+ * @brief EKF GNSS 원시 관측 강결합 갱신 (의사거리/도플러)
+ * 
+ * 위성마다 의사거리와 의사거리 변화율을 스칼라 관측으로 순차 융합한다.
+ * 관측 모델은 선형화 점 p0 기준으로
+ *   의사거리:  z = -los · (p - p0) + 시계 바이어스
+ *   변화율:    z = -los · v + 시계 드리프트
+ * 이며 H는 위치(또는 속도) 3개와 시계 상태 1개만 갖는 희소 행이다.
+ * 관측마다 1자유도 게이트(EKF_SENSOR_PSEUDORANGE, EKF_SENSOR_RANGE_RATE)를 따로
+ * 판정하므로 다중 경로 등으로 튀는 위성만 빠지고, 위성이 4개 미만이어도 갱신된다.
+ * 시계 상태는 첫 갱신 전에 ekf_set_clock_state로 맞춰 두어야 한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param ref_pos 선형화 점 (NED 좌표계, m, 관측 계산에 쓴 위치)
+ * @param obs 위성별 관측 배열
+ * @param count 위성 수
+ * @return uint8_t 게이트를 통과해 융합한 관측 수 (시계 블록이 제외된 구성에서는 항상 0)
+ */
+uint8_t ekf_update_gnss_raw(EKF *ekf, Vector3f ref_pos, const EKF_GnssObservation *obs, uint8_t count);
+
+/**
+ * @brief 수신기 시계 상태 설정
+ * 
+ * 시계 상태와 다른 상태 사이 상관을 지우고 분산을 다시 설정한다.
+ * 초기값은 수신기가 보고한 시계 바이어스(UBX NAV-CLOCK)나 첫 관측 묶음의
+ * 평균 의사거리 잔차로 잡는다. 수신기가 1 ms 시계 보정을 하면 다시 호출한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param bias 시계 바이어스 (m, 빛의 속도 × 시간)
+ * @param drift 시계 드리프트 (m/s)
+ * @param bias_std 바이어스 표준 편차 (m)
+ * @param drift_std 드리프트 표준 편차 (m/s)
+ * @return bool 설정 성공 여부 (시계 블록이 제외된 구성에서는 항상 false)
+ */
+bool ekf_set_clock_state(EKF *ekf, float bias, float drift, float bias_std, float drift_std);
+
+/**
+ * @brief 수신기 시계 프로세스 노이즈 설정
+ * 
+ * ekf_set_process_noise는 시계 항목을 유지하므로 따로 설정한다.
+ * TCXO 수신기는 대략 바이어스 0.1 m, 드리프트 0.05 m/s 수준이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param bias_std 바이어스 표준 편차 (m)
+ * @param drift_std 드리프트 표준 편차 (m/s)
+ * @return bool 설정 성공 여부 (시계 블록이 제외된 구성에서는 항상 false)
+ */
+bool ekf_set_clock_noise(EKF *ekf, float bias_std, float drift_std);
 
 /**
  * @brief EKF 자력계 측정 갱신
  * 
+ * 먼저 외란 사전 검사(ekf_mag_check_disturbance)를 하고, 외란으로 판정되면 갱신하지 않는다.
+ * 
  * @param ekf EKF 구조체 포인터
  * @param mag 자력계 측정값 (몸체 좌표계, uT)
- * @return bool 갱신 성공 여부
+ * @return bool 갱신 성공 여부 (외란 판정이면 false)
  */
 bool ekf_update_mag(EKF *ekf, Vector3f mag);
 
+/**
+ * @brief 자력계 외란 사전 검사 (크기와 복각을 기준과 비교, 통계 갱신)
+ * 
+ * 제곱근 두 번과 asin 두 번 정도의 비용이며, 지연 갱신은 되감기 전에 부른다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mag 자력계 측정값 (몸체 좌표계, earth_mag_ned와 같은 단위)
+ * @return bool 외란이면 true (기준 크기가 0이거나 측정이 유한하지 않아도 true)
+ */
+bool ekf_mag_check_disturbance(EKF *ekf, Vector3f mag);
+
+/**
+ * @brief 자력계 바이어스 상태 추정 켜기/끄기 (EKF_CONFIG_MAG_BIAS)
+ * 
+ * 켜져 있으면 자력계 갱신이 몸체 좌표계 바이어스를 빼서 예측하고 자코비안에 단위 블록을
+ * 더하며, 바이어스 분산에 프로세스 노이즈가 쌓인다. 끄면(자력계를 쓰지 않는 구간) 추정값은
+ * 그대로 빼되 자코비안에서 빠지고 분산도 자라지 않는다. 기본값은 켜짐이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param enable 추정 여부
+ * @return bool 설정 성공 여부 (바이어스 블록이 제외된 구성에서는 항상 false)
+ */
+bool ekf_set_mag_bias_enabled(EKF *ekf, bool enable);
+
+/**
+ * @brief 자력계 바이어스 프로세스 노이즈 설정 (EKF_CONFIG_MAG_BIAS)
+ * 
+ * ekf_set_process_noise는 이 항목을 유지하므로 따로 설정한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param bias_std 바이어스 랜덤 워크 세기 (입력 단위/sqrt(s))
+ * @return bool 설정 성공 여부 (바이어스 블록이 제외된 구성에서는 항상 false)
+ */
+bool ekf_set_mag_bias_noise(EKF *ekf, float bias_std);
+
+/**
+ * @brief EKF 상태에서 자력계 바이어스 추출
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return Vector3f 자력계 바이어스 (몸체 좌표계, 바이어스 블록이 제외된 구성에서는 0)
+ */
+Vector3f ekf_get_mag_bias(const EKF *ekf);
+
+/**
+ * @brief 자력계 외란 통계
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return const EKF_MagDisturbanceStats* 통계 (ekf가 NULL이면 NULL)
+ */
+const EKF_MagDisturbanceStats *ekf_get_mag_disturbance_stats(const EKF *ekf);
+
+/**
+ * @brief EKF 자력계 방위각 전용 측정 갱신
+ * 
+ * 측정 자기장을 현재 자세로 NED에 돌린 뒤 수평 성분의 방향만 지구 자기장 수평 성분의
+ * 방향(편각)과 비교하여 방위각 하나를 스칼라 관측으로 갱신한다. 자기장 크기와
+ * 복각을 쓰지 않으므로 earth_mag_ned는 방향(편각)만 맞으면 되고, 자기 외란이
+ * 롤/피치 관측으로 들어가지 않는다. 자코비안은 방위각의 사원수 편미분(1 x 4)이며,
+ * 피치가 롤보다 크면(수직 자세의 발사대 등) 321 대신 312 오일러 순서의 방위각을 쓴다.
+ * 게이트는 EKF_SENSOR_MAG_HEADING (1자유도 기본값)이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param mag 자력계 측정값 (몸체 좌표계, uT)
+ * @return bool 갱신 성공 여부 (수평 성분이 EKF_MAG_HEADING_MIN_HORIZONTAL 비율보다 작으면 false)
+ */
+bool ekf_update_mag_heading(EKF *ekf, Vector3f mag);
+
+/**
+ * @brief EKF 이중 안테나 GNSS 기선 방위(와 앙각) 측정 갱신
+ * 
+ * 설정한 기선 b를 현재 자세로 NED에 돌린 벡터 R(q) b = (n, e, d)의 방위 atan2(e, n)를
+ * 측정 방위와 비교해 스칼라 하나로 갱신한다. 자력계 3축 갱신(3x3 역행렬)과 달리 정보는
+ * 방위에만 들어가고 자기 외란, 점화 전류, 경철 보정과 무관하다. 자코비안은 방위의 사원수
+ * 편미분(1 x 4)이며, R(q)을 동차식으로 두어 단위 구면에 접한다 (ekf_update_mag_heading과 같음).
+ * use_pitch이면 방위 갱신 뒤의 자세로 다시 선형화해 앙각 atan2(-d, sqrt(n^2 + e^2))를
+ * 두 번째 스칼라로 갱신한다. 두 스칼라 모두 EKF_SENSOR_GNSS_HEADING (1자유도 기본값) 게이트를 쓴다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param m 기선 측정
+ * @return bool 갱신 성공 여부 (기선 미설정, 예측 기선의 수평 성분이
+ *         EKF_GNSS_HEADING_MIN_HORIZONTAL 비율보다 작거나 방위/앙각 모두 반영하지 못하면 false)
+ */
+bool ekf_update_gnss_heading(EKF *ekf, const EKF_GnssHeading *m);
+
+/**
+ * @brief EKF 가속도계 중력 방향 측정 갱신
+ * 
+ * 가속도가 작은 구간(발사대, 저추력 구간)에서는 가속도계가 중력만 측정한다고 보고,
+ * 예측값 R(q)^T (0, 0, g) + 가속도 바이어스를 측정값과 비교해 롤/피치를 보정한다.
+ * 관측 모델은 자력계 갱신과 같은 생성 커널(ekf_gen_mag_observation)을 쓰며,
+ * 방위각은 중력 방향에 수직이라 관측되지 않는다. 측정 크기가 g에서
+ * gravity_tolerance보다 벗어나면 운동 가속도가 섞인 것으로 보고 생략한다
+ * (추력 구간, 항력 감속이 큰 관성 비행 초기, 자유 낙하 등).
+ * 게이트는 EKF_SENSOR_GRAVITY (3자유도 기본값)이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param accel 가속도 측정값 (몸체 좌표계, m/s^2, 정지 시 크기 g)
+ * @return bool 갱신 성공 여부 (크기 검사에서 걸리면 false)
+ */
+bool ekf_update_gravity(EKF *ekf, Vector3f accel);
+
+/**
+ * @brief EKF 영속도 갱신 (ZUPT)
+ * 
+ * 기체가 정지해 있을 때 속도 측정값 0을 R_zupt로 융합한다.
+ * 측정 자코비안은 속도 상태 3개에만 1을 갖는 희소 행이다.
+ * 정지 판정은 호출자 책임이다 (sensors/static_detector.h).
+ * 자세/자이로 바이어스는 관측하지 않는다 (ekf_update_zero_rate 참고).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 갱신 성공 여부
+ */
+bool ekf_update_zupt(EKF *ekf);
+
+/**
+ * @brief EKF 발사 레일 구속 갱신
+ * 
+ * 몸체 횡방향 속도 v_b,i = Σ_j R(q)_ji v_j (i = x, y)의 측정값 0을 축마다 스칼라
+ * 갱신 두 번으로 융합한다. 자코비안은 속도 상태 3개에만 R(q) 열을 갖는 희소 행이다.
+ * 자세 편미분(|v|에 비례)은 넣지 않는다: 레일 위 횡방향 속도 오차는 대부분 추력 중
+ * 가속도계 노이즈/바이어스가 적분된 것이므로, 이를 자세로 돌리지 않고 속도에서 지운다.
+ * 
+ * 갱신 전에 기체 축 방향 속력을 dt 동안 사다리꼴 적분해 이동 거리에 더하고, 이동
+ * 거리가 rail_length 이상이 되면 구속을 해제하고 갱신 없이 false를 돌려준다
+ * (레일 이탈). 게이트는 EKF_SENSOR_RAIL (축마다 1자유도 기본값)이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param dt 마지막 레일 갱신 이후 경과 시간 (초, 첫 호출은 구속 시작 이후)
+ * @return bool 갱신 성공 여부 (구속 중이 아니거나 레일 이탈이면 false)
+ */
+bool ekf_update_rail(EKF *ekf, float dt);
+
+/**
+ * @brief EKF 영각속도 갱신 (ZARU, 정지 중 자이로 바이어스 관측)
+ * 
+ * 정지 중 평균 자이로 측정값은 자이로 바이어스와 같다고 보고 바이어스 상태
+ * 3개에만 1을 갖는 희소 H로 융합한다. 지구 자전 각속도(7.3e-5 rad/s)는 무시한다.
+ * 속도 상태와 자세 사이 결합이 전이 행렬에 없으므로 ZUPT만으로는 바이어스가
+ * 관측되지 않으며, 바이어스 보정에는 이 갱신을 함께 사용한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param gyro_mean 정지 구간 평균 자이로 측정값 (rad/s)
+ * @param rate_std 평균의 축별 표준 편차 (rad/s)
+ * @return bool 갱신 성공 여부
+ */
+bool ekf_update_zero_rate(EKF *ekf, Vector3f gyro_mean, float rate_std);
+
+/**
+ * @brief EKF 항력 비력 갱신 (관성 비행, EKF_CONFIG_DRAG)
+ * 
+ * 측정 모델과 자코비안은 ekf_estimate_drag 참고. 추력/속력 조건은 호출자(ekf_estimate_drag)가
+ * 확인한다. 게이트는 EKF_SENSOR_DRAG (3자유도 기본값)이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param accel 가속도계 측정값 (m/s^2, 몸체 좌표계)
+ * @return bool 갱신 성공 여부 (항력 계수 상태가 없는 구성이면 false)
+ */
+bool ekf_update_drag(EKF *ekf, Vector3f accel);
+
+/**
+ * @brief 외부 항법 추정으로 공분산 교차(CI) 갱신 (다른 보드 필터의 요약)
+ *
+ * 두 추정의 상관을 모를 때의 CI 결합 P^-1 = ω Pa^-1 + (1 - ω) Pb^-1 을, 전체 P를
+ * 1/ω 배 부풀린 뒤 외부 추정을 R = Pb / (1 - ω) 인 직접 측정으로 갱신하는 형태로
+ * 수행한다. 공통 상태 밖(바이어스 등)은 상관을 따라 함께 보정된다.
+ * 회전각 혁신은 2 vec(q^-1 ⊗ q_ext) (몸체 좌표계), 자코비안은 2 Xi^T 이다.
+ *
+ * 혁신 게이트, 적응형 R, 정상 상태 게인은 적용하지 않으며 (정상 상태 게인은 해제),
+ * 공분산은 표준 형식으로 갱신한다. 정보 형식 묶음 중에는 false를 반환한다.
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param q 외부 자세
+ * @param vel 외부 속도 (NED, m/s)
+ * @param pos 외부 위치 (NED, m, 같은 원점)
+ * @param P_ext 외부 항법 오차 공분산 (EKF_NAV_ERROR_DIM, 쓰지 않는 성분의 행/열은 무시)
+ * @param components 쓸 성분 (EKF_NAV_ERROR_* 조합, 위치 블록이 없으면 위치 제외)
+ * @param omega CI 가중치 (0, 1], 1이면 아무것도 하지 않음
+ * @return bool 갱신 성공 여부
+ */
+bool ekf_update_nav_estimate(EKF *ekf, Quaternion q, Vector3f vel, Vector3f pos,
+                             const float P_ext[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM],
+                             uint8_t components, float omega);
+
 /**
  * @brief EKF 상태에서 위치 추출
  * 
  * @param ekf EKF 구조체 포인터
- * @return Vector3f 위치 벡터 (NED 좌표계, m)
+ * @return Vector3f 위치 벡터 (NED 좌표계, m, 위치 블록이 제외된 구성에서는 0)
  */
 Vector3f ekf_get_position(const EKF *ekf);
 
@@ -197,6 +1824,14 @@ Vector3f ekf_get_velocity(const EKF *ekf);
  */
 Quaternion ekf_get_attitude(const EKF *ekf);
 
+/**
+ * @brief 현재 자세의 회전 행렬 (몸체 -> NED, 자세가 바뀌었을 때만 다시 계산)
+ * 
+ * @param ekf EKF 구조체 포인터 (초기화됨)
+ * @return const float (*)[3] 3x3 회전 행렬 (다음 상태 변경까지 유효)
+ */
+const float (*ekf_epoch_rotation(EKF *ekf))[3];
+
 /**
  * @brief EKF 상태에서 오일러 각 추출
  * 
@@ -208,6 +1843,21 @@ Quaternion ekf_get_attitude(const EKF *ekf);
  */
 bool ekf_get_euler(const EKF *ekf, float *roll, float *pitch, float *yaw);
 
+/**
+ * @brief EKF 상태에서 오일러 각 추출 (고속 근사)
+ * 
+ * 제어 주기 텔레메트리용. quaternion_to_euler_fast를 사용하며 각 각도의
+ * 오차는 2.5e-6 rad 이내이다. 호출마다 다시 계산하므로, 게시된 해를 여러 번 읽는
+ * 소비자는 게시마다 한 번만 계산하는 nav_frames_get_euler를 쓴다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param roll 롤 각도를 저장할 포인터 (rad)
+ * @param pitch 피치 각도를 저장할 포인터 (rad)
+ * @param yaw 요 각도를 저장할 포인터 (rad)
+ * @return bool 추출 성공 여부
+ */
+bool ekf_get_euler_fast(const EKF *ekf, float *roll, float *pitch, float *yaw);
+
 /**
  * @brief EKF 상태에서 자이로 바이어스 추출
  * 
@@ -220,10 +1870,114 @@ Vector3f ekf_get_gyro_bias(const EKF *ekf);
  * @brief EKF 상태에서 가속도 바이어스 추출
  * 
  * @param ekf EKF 구조체 포인터
- * @return Vector3f 가속도 바이어스 (m/s^2)
+ * @return Vector3f 가속도 바이어스 (m/s^2, 가속도 바이어스 블록이 제외된 구성에서는 0)
  */
 Vector3f ekf_get_accel_bias(const EKF *ekf);
 
+/**
+ * @brief 항법 해 스냅샷 추출
+ * 
+ * 위치, 속도, 자세, 바이어스, 정점 예측(ekf_predict_apogee), 공분산 대각을 한 번에 채운다.
+ * 사원수 정규화는 한 번만 수행한다. 공분산 지연 전파 중에는 공분산 대각이 마지막 반영
+ * 시점의 값이다 (최대 lazy_max_dt 늦음, 최신 값이 필요하면 먼저 ekf_flush_covariance).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param timestamp_us 해의 유효 시각 (us, 예: 마지막 IMU 샘플 시각)
+ * @param sol 결과 스냅샷
+ * @return bool 성공 여부 (초기화 전이면 false)
+ */
+bool ekf_get_nav_solution(const EKF *ekf, uint32_t timestamp_us, EKF_NavSolution *sol);
+
+/**
+ * @brief 항법 오차 공분산 (몸체 좌표계 회전각, 속도, 위치; EKF_NAV_ERROR_DIM 차원)
+ *
+ * 사원수 블록은 Xi로 회전각에 옮긴다: Pθθ = 4 Xi^T Pqq Xi, Pθv = 2 Xi^T Pqv.
+ * 위치 블록이 없는 구성은 위치 분산을 EKF_NAV_ERROR_UNKNOWN_VAR, 상관을 0으로 둔다.
+ * 지연 전파 중이면 마지막 반영 시점의 값이다.
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param P 결과 공분산
+ * @return bool 성공 여부 (초기화 전이면 false)
+ */
+bool ekf_get_nav_error_covariance(const EKF *ekf, float P[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM]);
+
+/**
+ * @brief 항력 계수 설정 (기체 제원 사전값)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param drag_k 항력 계수 k = rho * Cd * A / (2 * m) (1/m, 0이면 항력 무시)
+ * @return bool 설정 성공 여부
+ */
+bool ekf_set_drag_coefficient(EKF *ekf, float drag_k);
+
+/**
+ * @brief 관성 비행 중 항력 계수 추정 (IMU 샘플마다 호출 가능)
+ * 
+ * 추력이 없으면 가속도계 비력은 항력 가속도 k * |v|^2 뿐이므로
+ * k = |a - b_a| / |v|^2 를 저역 통과하여 drag_k에 반영한다.
+ * 속력이 EKF_DRAG_MIN_SPEED 미만이면 추정하지 않는다.
+ * 공기 밀도 변화(고도)는 추정값이 천천히 따라가는 것으로 대신한다.
+ * 
+ * EKF_CONFIG_DRAG 구성에서는 저역 통과 대신 비력 f = R(q)^T (-k |v| v) + b_a 를 측정
+ * 모델로 하는 EKF 갱신(EKF_SENSOR_DRAG, R_drag)을 수행한다. 행마다 k, b_a 한 축, 속도
+ * 3개의 희소 원소 5개이며 자세 편미분은 넣지 않는다 (받음각/바람 오차를 자세로 돌리지
+ * 않음). 바람은 무시한다 (대지 속도 = 대기 속도). 항력은 이미 가속도계 비력에 들어 있으므로
+ * 예측의 속도 적분에는 항력 항을 더하지 않으며, k는 랜덤 워크(EKF_DRAG_DEFAULT_STD)이다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param accel 가속도계 측정값 (m/s^2, 관성 비행 중)
+ * @return bool 추정값을 갱신했으면 true
+ */
+bool ekf_estimate_drag(EKF *ekf, Vector3f accel);
+
+/**
+ * @brief 항력 계수 추정값 조회
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param var 결과 분산 ((1/m)^2, NULL 가능, 상태가 없는 구성에서는 0)
+ * @return float 항력 계수 (1/m, 0 이상, ekf가 NULL이면 0)
+ */
+float ekf_get_drag_coefficient(const EKF *ekf, float *var);
+
+/**
+ * @brief 항력 계수 상태 노이즈 설정 (EKF_CONFIG_DRAG)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param drag_std 항력 계수 프로세스 노이즈 (1/m/sqrt(s))
+ * @param accel_std 항력 비력 측정 축별 표준 편차 (m/s^2)
+ * @return bool 설정 성공 여부 (상태가 없는 구성이면 false)
+ */
+bool ekf_set_drag_noise(EKF *ekf, float drag_std, float accel_std);
+
+/**
+ * @brief 탄도 모델 정점 예측 (이차 항력, 해석해)
+ * 
+ * 수직 운동 dv/dt = -g - k_v * v^2 의 해
+ *   t = atan(v * sqrt(k_v / g)) / sqrt(k_v * g),  Δh = ln(1 + k_v * v^2 / g) / (2 * k_v)
+ * 를 사용한다. 항력은 전체 속력에 비례하므로 k_v = k * |v| / v_z 로 현재 비행 경로각을
+ * 반영한다 (경로각 변화는 무시). 비용은 atanf, logf, sqrtf 각 1회이다.
+ * k는 ekf_get_drag_coefficient 값이다 (EKF_CONFIG_DRAG이면 항력 계수 상태).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param time_to_apogee 정점까지 남은 시간 (s, 상승 중이 아니면 0)
+ * @param apogee_alt 예측 정점 고도 (m, 위치 블록 제외 시 현재 대비 상승량)
+ * @return bool 성공 여부
+ */
+bool ekf_predict_apogee(const EKF *ekf, float *time_to_apogee, float *apogee_alt);
+
+/**
+ * @brief 상태 벡터 직접 접근 (읽기 전용)
+ * 
+ * EKF_StateIndex 순서의 연속된 float EKF_STATE_DIM개를 가리킨다. 확인 없이 매 루프 읽는
+ * 제어/텔레메트리용이며, 사원수는 마지막 갱신 시 정규화된 값이다.
+ * 
+ * @param ekf EKF 구조체 포인터 (NULL 아님)
+ * @return const float* 상태 배열
+ */
+static inline const float *ekf_get_state_data(const EKF *ekf) {
+    return &ekf->x.data[0][0];
+}
+
 /**
  * @brief EKF 상태 리셋
  * 
@@ -243,9 +1997,35 @@ bool ekf_reset(EKF *ekf);
  */
 bool ekf_initialize_magnetic_field(EKF *ekf, Vector3f *mag_samples, Vector3f *accel_samples, int sample_count);
 
+/**
+ * @brief 스트리밍 추정기 결과로 자기장 벡터 초기화
+ * 
+ * 대기 중 매 샘플을 ekf_mag_field_add_sample로 누적한 뒤 호출한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param est 현장 자기장 추정기 (ekf_mag_calibration.h)
+ * @return bool 초기화 성공 여부 (샘플이 없으면 false, 자기장 변경 없음)
+ */
+bool ekf_initialize_magnetic_field_streaming(EKF *ekf, const EKF_MagFieldEstimator *est);
+
+/**
+ * @brief 위치의 지구 자기장 모델 값으로 자기장 벡터 초기화
+ * 
+ * 첫 GNSS 고정 위치로 호출하면 발사 지점과 무관하게 기준 자기장이 맞춰져
+ * 초기 자세 수렴 과도 구간이 없어진다 (ekf_wmm.h).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param lat_deg 위도 (도)
+ * @param lon_deg 경도 (도)
+ * @return bool 초기화 성공 여부 (입력이 유한하지 않으면 false, 자기장 변경 없음)
+ */
+bool ekf_initialize_magnetic_field_from_location(EKF *ekf, float lat_deg, float lon_deg);
+
 /**
  * @brief 기본 자기장 값으로 초기화 (현장 측정이 불가능한 경우)
  * 
+ * 기본 발사 지점(EKF_WMM_DEFAULT_LAT_DEG, EKF_WMM_DEFAULT_LON_DEG)의 모델 값을 사용한다.
+ * 
  * @param ekf EKF 구조체 포인터
  * @return bool 초기화 성공 여부
  */
@@ -0,0 +1,122 @@
+/**
+ * @file ekf_align.h
+ * @brief 발사대 정지 중 센서 평균으로 초기 자세와 자세 공분산을 구하는 개략 정렬
+ *
+ * ekf_reset은 단위 사원수와 사원수 분산 1.0에서 시작하므로, 실제 자세가 크게 다르면
+ * 수렴에 수십 초가 걸린다. 정지 중 스트리밍 추정기(EKF_MagFieldEstimator)에 모인
+ * 가속도/자력계 평균으로 TRIAD 정렬을 하면 몇 초 만에 초기 자세를 정할 수 있다.
+ *
+ * - 수평: 평균 가속도를 아래 방향으로 본다. 부호는 ekf_predict와 같다
+ *   (정지 시 가속도 측정값 = R(q)^T (0, 0, g)).
+ * - 방위: 평균 자력계의 수평 성분을 earth_mag_ned의 수평 성분(편각)에 맞춘다.
+ * - 공분산: 평균의 표준 오차와 하한(가속도 바이어스, 자기 외란)으로 NED 기준
+ *   수평/방위 오차 분산을 정하고 이를 사원수 공분산으로 옮긴다. 복각이 크면 수평
+ *   오차가 방위 오차로 번지는 몫(tan I 배)을 더한다.
+ * - 자이로 나침반: 자이로 평균의 표준 오차가 지구 자전 수평 성분(Ω cos φ)보다 충분히
+ *   작으면 자전 방향으로 북쪽을 구해 자력계 방위와 분산 가중 평균한다. MEMS 자이로는
+ *   대개 바이어스 불안정성 때문에 거부되며, 광섬유급 자이로에서만 의미가 있다.
+ *
+ * 사용 순서: ekf_mag_field_add_sample로 누적 -> ekf_mag_field_is_ready 확인 ->
+ * ekf_align_coarse -> (선택) ekf_align_gyrocompass -> ekf_set_initial_state ->
+ * ekf_apply_alignment.
+ */
+
+#ifndef EKF_ALIGN_H
+#define EKF_ALIGN_H
+
+#include "ekf/ekf.h"
+#include "ekf/ekf_mag_calibration.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 정렬 오차 하한
+ */
+#define EKF_ALIGN_TILT_STD_MIN 0.01f       /**< 수평 오차 하한 (rad, 가속도 바이어스 약 0.1 m/s^2) */
+#define EKF_ALIGN_HEADING_STD_MIN 0.05f    /**< 방위 오차 하한 (rad, 편각 모델과 자기 외란) */
+
+/**
+ * @brief 최소 수평 자기장 비율 (수평 성분 / 전체 크기, 작으면 방위 정렬 불가)
+ */
+#define EKF_ALIGN_MIN_HORIZONTAL 0.1f
+
+/**
+ * @brief 사원수 크기 방향 분산 (정규화 구속 방향, U-D 분해를 위한 양정치 보정)
+ */
+#define EKF_ALIGN_RADIAL_VAR 1.0e-6f
+
+/**
+ * @brief 지구 자전 각속도 (rad/s)
+ */
+#define EKF_ALIGN_EARTH_RATE 7.292115e-5f
+
+/**
+ * @brief 자이로 나침반을 적용할 최대 방위 표준 오차 (rad, 소각 근사 한계)
+ */
+#define EKF_ALIGN_GYROCOMPASS_MAX_STD 0.3f
+
+/**
+ * @brief 정렬 결과
+ */
+typedef struct {
+    Quaternion q;              /**< 초기 자세 (몸체 -> NED) */
+    float tilt_std;            /**< 수평(롤/피치) 표준 편차 (rad) */
+    float heading_std;         /**< 방위 표준 편차 (rad) */
+    float inclination_tan;     /**< 측정 자기장 복각의 tan (수평 오차 -> 방위 오차 배율) */
+    bool gyrocompass;          /**< 자이로 나침반 보정 적용 여부 */
+} EKF_Alignment;
+
+/**
+ * @brief 가속도/자력계 평균으로 개략 정렬 (TRIAD)
+ *
+ * @param est 스트리밍 추정기 (정지 중 누적)
+ * @param earth_mag_ned 지구 자기장 기준 (NED, 편각만 사용)
+ * @param align 결과
+ * @return bool 성공 여부 (샘플이 2개 미만이거나 측정/기준의 수평 자기장이 너무 작으면 false)
+ */
+bool ekf_align_coarse(const EKF_MagFieldEstimator *est, Vector3f earth_mag_ned, EKF_Alignment *align);
+
+/**
+ * @brief 자이로 나침반으로 방위 보정
+ *
+ * 정렬 자세로 평균 각속도를 NED로 돌려 수평 성분의 방향을 북쪽으로 본다.
+ * 방위 표준 오차는 rate_stderr / (Ω cos φ)에 수평 오차가 수직 자전 성분을 섞는 몫
+ * (tilt_std x tan φ)을 더한 값이며, EKF_ALIGN_GYROCOMPASS_MAX_STD보다 크면 적용하지 않는다.
+ *
+ * @param align 정렬 결과 (ekf_align_coarse 결과, 갱신됨)
+ * @param gyro_mean 정지 중 평균 각속도 (몸체, rad/s, 알려진 바이어스 보정 후)
+ * @param rate_stderr 평균 각속도의 축별 표준 오차 (rad/s, 바이어스 불확실성 포함)
+ * @param lat_deg 위도 (도)
+ * @return bool 적용 여부 (자이로가 충분히 정확하지 않으면 false, 정렬 결과 변경 없음)
+ */
+bool ekf_align_gyrocompass(EKF_Alignment *align, Vector3f gyro_mean, float rate_stderr, float lat_deg);
+
+/**
+ * @brief 정렬 자세와 자세 공분산을 필터에 적용
+ *
+ * 사원수 상태를 정렬 자세로 바꾸고, 사원수 공분산 블록을 NED 기준 오차
+ * diag(tilt^2, tilt^2, heading^2)의 사원수 사상으로 채운다. 사원수와 다른 상태의
+ * 교차 공분산은 0으로 둔다. 다른 상태와 공분산은 그대로 둔다.
+ *
+ * @param ekf EKF 구조체 포인터 (초기화된 상태)
+ * @param align 정렬 결과
+ * @return bool 성공 여부
+ */
+bool ekf_apply_alignment(EKF *ekf, const EKF_Alignment *align);
+
+/**
+ * @brief 필터 방위를 기준 자세의 방위로 재설정 (비행 중 방위 복구)
+ *
+ * 상대 회전 q_ref ⊗ q^-1 의 NED 아래축 성분(twist)만큼 필터 자세를 아래축에 대해
+ * 돌리므로 기울기는 필터 값을 유지하며 오일러 특이점이 없다. 수평 분산은 현재
+ * 사원수 공분산에서 구하고 방위 분산은 yaw_std^2로 바꾸어 ekf_apply_alignment와
+ * 같이 적용한다 (사원수 교차 공분산은 0). yaw_gsf_get_attitude 결과 주입용이다.
+ *
+ * @param ekf EKF 구조체 포인터 (초기화된 상태)
+ * @param q_ref 기준 자세 (방위만 사용)
+ * @param yaw_std 기준 방위 표준 편차 (rad)
+ * @return bool 성공 여부
+ */
+bool ekf_reset_yaw(EKF *ekf, Quaternion q_ref, float yaw_std);
+
+#endif /* EKF_ALIGN_H */
@@ -0,0 +1,223 @@
+/**
+ * @file ekf_config.h
+ * @brief EKF 상태 벡터 구성 (X-매크로) 및 차원별 행렬 타입/함수 선택
+ *
+ * 상태 블록은 X-매크로 목록으로 정의되며, 빌드 설정에서 선택 블록을 끄면
+ * 해당 상태가 상태 인덱스, 공분산, 자코비안, 측정 모델에서 모두 빠진다.
+ * 상태 차원은 컴파일 타임 상수이므로 모든 행렬 커널이 결과 차원으로 특수화된다.
+ *
+ * | EKF_CONFIG_POSITION | EKF_CONFIG_ACCEL_BIAS | EKF_STATE_DIM |
+ * |---------------------|-----------------------|---------------|
+ * | 1                   | 1                     | 16 (기본)     |
+ * | 1                   | 0                     | 13            |
+ * | 0                   | 1                     | 13            |
+ * | 0                   | 0                     | 10            |
+ *
+ * 위치 블록이 없으면 GPS는 속도만, 기압계 갱신은 지원하지 않는다 (false 반환).
+ * 가속도 바이어스 블록이 없으면 가속도 측정값을 보정 없이 적분한다.
+ *
+ * EKF_CONFIG_GNSS_CLOCK을 켜면 기본 구성 뒤에 수신기 시계 바이어스/드리프트 상태가
+ * 붙어 18차원이 된다 (의사거리/도플러 강결합 갱신용). 위치 블록 없이는 의사거리를
+ * 쓸 수 없고 15차원은 오차 상태 필터 타입과 겹치므로 기본 구성에서만 지원한다.
+ *
+ * EKF_CONFIG_MAG_BIAS를 켜면 기본 구성 뒤에 몸체 좌표계 자력계 바이어스(경철) 상태가 붙어
+ * 19차원이 된다. 자력계 갱신 자코비안에 단위 블록(행당 원소 1개)만 더해지므로 별도의 타원체
+ * 맞춤 없이 비행 중 남은 경철 오차를 추정한다. 시계 블록과 함께 쓰는 구성은 지원하지 않는다.
+ *
+ * EKF_CONFIG_DRAG를 켜면 기본 구성 뒤에 항력 계수 k = rho * Cd * A / (2 * m) 상태가 붙어
+ * 17차원이 된다. 관성 비행 중 가속도계 비력을 항력 모델로 갱신하며(ekf_estimate_drag),
+ * 정점 예측이 이 추정값을 쓴다. 시계/자력계 바이어스 블록과 함께 쓰는 구성은 지원하지 않는다.
+ *
+ * 빌드 설정에서 정하지 않은 EKF_CONFIG_*는 보드 프로파일(sys/board_profile.h)이 먼저 정한다.
+ */
+
+#ifndef EKF_CONFIG_H
+#define EKF_CONFIG_H
+
+#include "sys/board_profile.h"
+
+/**
+ * @brief 위치 상태 블록 (x, y, z) 포함 여부
+ */
+#ifndef EKF_CONFIG_POSITION
+#define EKF_CONFIG_POSITION 1
+#endif
+
+/**
+ * @brief 가속도 바이어스 상태 블록 (bax, bay, baz) 포함 여부
+ */
+#ifndef EKF_CONFIG_ACCEL_BIAS
+#define EKF_CONFIG_ACCEL_BIAS 1
+#endif
+
+/**
+ * @brief 수신기 시계 상태 블록 (바이어스, 드리프트) 포함 여부
+ */
+#ifndef EKF_CONFIG_GNSS_CLOCK
+#define EKF_CONFIG_GNSS_CLOCK 0
+#endif
+
+/**
+ * @brief 자력계 바이어스 상태 블록 (bmx, bmy, bmz) 포함 여부
+ */
+#ifndef EKF_CONFIG_MAG_BIAS
+#define EKF_CONFIG_MAG_BIAS 0
+#endif
+
+/**
+ * @brief 항력 계수 상태 (k) 포함 여부
+ */
+#ifndef EKF_CONFIG_DRAG
+#define EKF_CONFIG_DRAG 0
+#endif
+
+#if EKF_CONFIG_GNSS_CLOCK && !(EKF_CONFIG_POSITION && EKF_CONFIG_ACCEL_BIAS)
+#error "EKF_CONFIG_GNSS_CLOCK requires EKF_CONFIG_POSITION and EKF_CONFIG_ACCEL_BIAS"
+#endif
+
+#if EKF_CONFIG_MAG_BIAS && !(EKF_CONFIG_POSITION && EKF_CONFIG_ACCEL_BIAS && !EKF_CONFIG_GNSS_CLOCK)
+#error "EKF_CONFIG_MAG_BIAS requires EKF_CONFIG_POSITION and EKF_CONFIG_ACCEL_BIAS without EKF_CONFIG_GNSS_CLOCK"
+#endif
+
+#if EKF_CONFIG_DRAG && !(EKF_CONFIG_POSITION && EKF_CONFIG_ACCEL_BIAS && !EKF_CONFIG_GNSS_CLOCK && !EKF_CONFIG_MAG_BIAS)
+#error "EKF_CONFIG_DRAG requires EKF_CONFIG_POSITION and EKF_CONFIG_ACCEL_BIAS without EKF_CONFIG_GNSS_CLOCK or EKF_CONFIG_MAG_BIAS"
+#endif
+
+/**
+ * @brief 상태 블록 X-매크로
+ *
+ * 각 항목은 X(이름, 초기 분산, 리셋 분산) 형식이며, 목록 순서가 상태 인덱스 순서이다.
+ * 이름은 EKF_STATE_ 접두사가 붙은 상태 인덱스가 된다.
+ */
+#if EKF_CONFIG_POSITION
+#define EKF_STATES_POSITION(X)          \
+    X(POS_X, 10.0f, 100.0f)  /* m^2 */  \
+    X(POS_Y, 10.0f, 100.0f)             \
+    X(POS_Z, 10.0f, 100.0f)
+#else
+#define EKF_STATES_POSITION(X)
+#endif
+
+#define EKF_STATES_VELOCITY(X)              \
+    X(VEL_X, 1.0f, 10.0f)  /* (m/s)^2 */    \
+    X(VEL_Y, 1.0f, 10.0f)                   \
+    X(VEL_Z, 1.0f, 10.0f)
+
+#define EKF_STATES_ATTITUDE(X)  \
+    X(QUAT_W, 0.1f, 1.0f)       \
+    X(QUAT_X, 0.1f, 1.0f)       \
+    X(QUAT_Y, 0.1f, 1.0f)       \
+    X(QUAT_Z, 0.1f, 1.0f)
+
+#define EKF_STATES_GYRO_BIAS(X)                     \
+    X(GYRO_BIAS_X, 0.01f, 0.01f)  /* (rad/s)^2 */   \
+    X(GYRO_BIAS_Y, 0.01f, 0.01f)                    \
+    X(GYRO_BIAS_Z, 0.01f, 0.01f)
+
+#if EKF_CONFIG_ACCEL_BIAS
+#define EKF_STATES_ACCEL_BIAS(X)                    \
+    X(ACC_BIAS_X, 0.1f, 0.1f)  /* (m/s^2)^2 */      \
+    X(ACC_BIAS_Y, 0.1f, 0.1f)                       \
+    X(ACC_BIAS_Z, 0.1f, 0.1f)
+#else
+#define EKF_STATES_ACCEL_BIAS(X)
+#endif
+
+/* 시계 상태는 빛의 속도를 곱한 거리 단위 (바이어스 m, 드리프트 m/s) */
+#if EKF_CONFIG_GNSS_CLOCK
+#define EKF_STATES_GNSS_CLOCK(X)                    \
+    X(CLK_BIAS, 100.0f, 100.0f)  /* m^2 */          \
+    X(CLK_DRIFT, 1.0f, 1.0f)     /* (m/s)^2 */
+#else
+#define EKF_STATES_GNSS_CLOCK(X)
+#endif
+
+/* 자력계 바이어스는 자력계 갱신 입력과 같은 단위 (earth_mag_ned 단위) */
+#if EKF_CONFIG_MAG_BIAS
+#define EKF_STATES_MAG_BIAS(X)                      \
+    X(MAG_BIAS_X, 0.01f, 0.01f)  /* 단위^2 */       \
+    X(MAG_BIAS_Y, 0.01f, 0.01f)                     \
+    X(MAG_BIAS_Z, 0.01f, 0.01f)
+#else
+#define EKF_STATES_MAG_BIAS(X)
+#endif
+
+/* 항력 계수 초기 표준 편차 1e-3 1/m (소형 기체 k ~ 1e-4 .. 1e-3) */
+#if EKF_CONFIG_DRAG
+#define EKF_STATES_DRAG(X)                          \
+    X(DRAG_K, 1e-6f, 1e-6f)  /* (1/m)^2 */
+#else
+#define EKF_STATES_DRAG(X)
+#endif
+
+/**
+ * @brief 전체 상태 목록
+ */
+#define EKF_STATE_LIST(X)       \
+    EKF_STATES_POSITION(X)      \
+    EKF_STATES_VELOCITY(X)      \
+    EKF_STATES_ATTITUDE(X)      \
+    EKF_STATES_GYRO_BIAS(X)     \
+    EKF_STATES_ACCEL_BIAS(X)    \
+    EKF_STATES_GNSS_CLOCK(X)    \
+    EKF_STATES_MAG_BIAS(X)      \
+    EKF_STATES_DRAG(X)
+
+/**
+ * @brief EKF 상태 벡터 크기
+ *
+ * 타입/함수 이름 생성에 쓰이므로 식이 아닌 정수 리터럴이어야 한다.
+ * 상태 목록 길이와의 일치는 ekf.h의 정적 검사로 확인한다.
+ */
+#if EKF_CONFIG_MAG_BIAS
+#define EKF_STATE_DIM 19
+#elif EKF_CONFIG_GNSS_CLOCK
+#define EKF_STATE_DIM 18
+#elif EKF_CONFIG_DRAG
+#define EKF_STATE_DIM 17
+#elif EKF_CONFIG_POSITION && EKF_CONFIG_ACCEL_BIAS
+#define EKF_STATE_DIM 16
+#elif EKF_CONFIG_POSITION || EKF_CONFIG_ACCEL_BIAS
+#define EKF_STATE_DIM 13
+#else
+#define EKF_STATE_DIM 10
+#endif
+
+/**
+ * @brief 토큰 연결 (인자를 먼저 전개)
+ */
+#define EKF_CAT_(a, b) a##b
+#define EKF_CAT(a, b) EKF_CAT_(a, b)
+
+/**
+ * @brief 상태 차원 N에 맞는 행렬 타입 이름
+ *
+ * EKF_MAT_NXM(M): Mat<N>x<M>, 그 외 N x 1 벡터, N x N 밀집, 압축 대칭, U-D 분해
+ */
+#define EKF_MAT_NXM(M) EKF_CAT(EKF_CAT(EKF_CAT(Mat, EKF_STATE_DIM), x), M)
+#define EKF_STATE_VECTOR EKF_MAT_NXM(1)
+#define EKF_STATE_MATRIX EKF_MAT_NXM(EKF_STATE_DIM)
+#define EKF_STATE_SYM EKF_CAT(MatSym, EKF_STATE_DIM)
+#define EKF_STATE_UD EKF_CAT(MatUD, EKF_STATE_DIM)
+
+/**
+ * @brief 상태 차원 N에 맞는 행렬 함수 이름
+ *
+ * - EKF_VEC_FN(fn): mat<N>x1_fn
+ * - EKF_SYM_FN(fn): matsym<N>_fn
+ * - EKF_UD_FN(fn): matud<N>_fn
+ * - EKF_SYM_NXM_FN(fn, M): matsym<N>_fn_<N>x<M>
+ * - EKF_MULTIPLY_NXM_MXM(M): mat_multiply_<N>x<M>_<M>x<M>
+ * - EKF_MULTIPLY_ADD_NXM_MX1(M): mat_multiply_add_<N>x<M>_<M>x1
+ */
+#define EKF_NXM_(M) EKF_CAT(EKF_CAT(EKF_STATE_DIM, x), M)
+#define EKF_VEC_FN(fn) EKF_CAT(EKF_CAT(mat, EKF_NXM_(1)), EKF_CAT(_, fn))
+#define EKF_SYM_FN(fn) EKF_CAT(EKF_CAT(matsym, EKF_STATE_DIM), EKF_CAT(_, fn))
+#define EKF_UD_FN(fn) EKF_CAT(EKF_CAT(matud, EKF_STATE_DIM), EKF_CAT(_, fn))
+#define EKF_SYM_NXM_FN(fn, M) EKF_CAT(EKF_SYM_FN(fn), EKF_CAT(_, EKF_NXM_(M)))
+#define EKF_MULTIPLY_NXM_MXM(M) \
+    EKF_CAT(EKF_CAT(mat_multiply_, EKF_NXM_(M)), EKF_CAT(EKF_CAT(EKF_CAT(_, M), x), M))
+#define EKF_MULTIPLY_ADD_NXM_MX1(M) \
+    EKF_CAT(EKF_CAT(mat_multiply_add_, EKF_NXM_(M)), EKF_CAT(EKF_CAT(_, M), x1))
+
+#endif /* EKF_CONFIG_H */
@@ -0,0 +1,225 @@
+/**
+ * @file ekf_delay.h
+ * @brief 고정 크기 상태 이력 버퍼를 이용한 지연 측정 융합
+ *
+ * 예측 단계마다 (타임스탬프, 적분 후 상태, IMU 샘플)을 링 버퍼에 기록한다.
+ * 측정값이 늦게 도착하면 측정 시각의 과거 상태로 되돌려 측정 갱신을 수행하고,
+ * 이후 기록된 IMU 샘플로 상태만 다시 적분하여(공분산 재계산 없음) 현재 시각으로 돌아온다.
+ *
+ * 공분산은 재생하지 않으므로 측정 갱신에는 현재 시각의 P를 사용한다.
+ * 지연이 수백 ms 이내이면 P의 변화가 작아 근사 오차는 무시할 수 있다.
+ *
+ * EKF_DELAY_COMPACT(기본 1)이면 항목을 줄여 저장한다 (16 상태 기준 항목 96 -> 56바이트,
+ * 블록 기준 포함 버퍼 약 6.1 -> 4.1 KB).
+ * - IMU 자이로/가속도: binary16 (math/float16.h, 상대 오차 2^-12 이하, 반올림 오차는 평균 0).
+ *   dt는 반올림 오차가 매 샘플 같은 쪽으로 쌓이므로 float 그대로 둔다.
+ * - 상태: EKF_DELAY_BLOCK개 항목마다 블록 첫 항목의 상태를 float 기준으로 두고, 나머지 항목은
+ *   기준과의 차이를 상태 종류별 2의 거듭제곱 눈금으로 양자화한 int16로 둔다. 눈금과 범위는
+ *   아래 EKF_DELAY_STEP_* (블록 첫 항목은 정확). 범위를 넘으면 잘라 저장하고 saturated를 센다.
+ * 되감은 상태의 사원수는 양자화 오차만큼 다시 정규화한다.
+ */
+
+#ifndef EKF_DELAY_H
+#define EKF_DELAY_H
+
+#include "ekf/ekf.h"
+
+/**
+ * @brief 압축 저장 사용 여부 (빌드 설정에서 0으로 정의하면 float 항목)
+ */
+#ifndef EKF_DELAY_COMPACT
+#define EKF_DELAY_COMPACT 1
+#endif
+
+/**
+ * @brief 상태 이력 버퍼 크기
+ *
+ * 최대 지연 = 크기 x 예측 주기 (예: 64 x 5 ms = 320 ms, 사전 적분 200 Hz 기준).
+ * 항목당 약 100 바이트(압축 저장이면 약 56바이트)를 차지한다.
+ */
+#define EKF_DELAY_HISTORY_SIZE 64
+
+#if EKF_DELAY_COMPACT
+
+/**
+ * @brief 상태 기준 블록 길이 (항목, EKF_DELAY_HISTORY_SIZE의 약수)
+ *
+ * 블록이 길수록 기준 수가 줄지만 기준과의 차이가 커진다. 8 x 5 ms = 40 ms 동안 20 g이면
+ * 속도 차 약 8 m/s, 300 m/s이면 위치 차 약 12 m로 아래 범위 안이다.
+ */
+#define EKF_DELAY_BLOCK 8u
+
+_Static_assert(EKF_DELAY_HISTORY_SIZE % EKF_DELAY_BLOCK == 0, "EKF_DELAY_BLOCK must divide EKF_DELAY_HISTORY_SIZE");
+
+/**
+ * @brief 상태 기준 수 (살아 있는 블록 수 최대값, 가장 오래된 블록이 일부 남을 수 있어 하나 더)
+ */
+#define EKF_DELAY_REF_COUNT (EKF_DELAY_HISTORY_SIZE / EKF_DELAY_BLOCK + 1u)
+
+/**
+ * @brief 기준과의 차이 양자화 눈금 (int16이므로 범위는 눈금 x 32767)
+ */
+#define EKF_DELAY_STEP_POS (1.0f / 2048.0f)           /**< 위치 (m, 0.49 mm, +-16 m) */
+#define EKF_DELAY_STEP_VEL (1.0f / 1024.0f)           /**< 속도 (m/s, 0.98 mm/s, +-32 m/s) */
+#define EKF_DELAY_STEP_QUAT (1.0f / 32768.0f)         /**< 사원수 원소 (3.1e-5, +-1) */
+#define EKF_DELAY_STEP_GYRO_BIAS (1.0f / 1048576.0f)  /**< 자이로 바이어스 (rad/s, 9.5e-7, +-0.031) */
+#define EKF_DELAY_STEP_ACC_BIAS (1.0f / 32768.0f)     /**< 가속도 바이어스 (m/s^2, 3.1e-5, +-1) */
+#define EKF_DELAY_STEP_CLK_BIAS (1.0f / 512.0f)       /**< 시계 바이어스 (m, 2 mm, +-64 m) */
+#define EKF_DELAY_STEP_CLK_DRIFT (1.0f / 4096.0f)     /**< 시계 드리프트 (m/s, 0.24 mm/s, +-8 m/s) */
+#define EKF_DELAY_STEP_MAG_BIAS (1.0f / 65536.0f)     /**< 자력계 바이어스 (자력계 단위, 1.5e-5, +-0.5) */
+#define EKF_DELAY_STEP_DRAG (1.0f / 268435456.0f)     /**< 항력 계수 (1/m, 3.7e-9, +-1.2e-4) */
+
+/**
+ * @brief 기준 번호의 "이 항목이 기준" 표시
+ */
+#define EKF_DELAY_REF_OWNER 0x80u
+
+/**
+ * @brief 상태 이력 항목 (압축)
+ */
+typedef struct {
+    uint32_t timestamp_us;          /**< 예측 구간 끝 시각 (us) */
+    int16_t dx[EKF_STATE_DIM];      /**< 기준과의 상태 차이 (상태별 눈금 단위) */
+    uint16_t gyro[3];               /**< 자이로 (rad/s, binary16) */
+    uint16_t accel[3];              /**< 가속도 (m/s^2, binary16) */
+    float dt;                       /**< 적분 간격 (초) */
+    uint8_t ref;                    /**< 기준 번호 (EKF_DELAY_REF_OWNER: 블록 첫 항목) */
+} EKF_HistoryEntry;
+
+/**
+ * @brief 상태 이력 링 버퍼
+ */
+typedef struct {
+    EKF_HistoryEntry entries[EKF_DELAY_HISTORY_SIZE]; /**< 이력 항목 */
+    float ref[EKF_DELAY_REF_COUNT][EKF_STATE_DIM];    /**< 블록별 상태 기준 */
+    uint16_t head;  /**< 가장 최근 항목 다음 위치 */
+    uint16_t count; /**< 저장된 항목 수 */
+    uint8_t ref_next; /**< 다음 블록의 기준 번호 */
+    uint32_t saturated; /**< 범위를 넘어 잘라 저장한 상태 원소 수 */
+} EKF_DelayBuffer;
+
+#else /* EKF_DELAY_COMPACT */
+
+/**
+ * @brief 상태 이력 항목
+ */
+typedef struct {
+    uint32_t timestamp_us; /**< 예측 구간 끝 시각 (us) */
+    EKF_StateVector x;     /**< 예측 직후 상태 */
+    EKF_ImuSample imu;     /**< 해당 예측에 사용한 IMU 샘플 */
+} EKF_HistoryEntry;
+
+/**
+ * @brief 상태 이력 링 버퍼
+ */
+typedef struct {
+    EKF_HistoryEntry entries[EKF_DELAY_HISTORY_SIZE]; /**< 이력 항목 */
+    uint16_t head;  /**< 가장 최근 항목 다음 위치 */
+    uint16_t count; /**< 저장된 항목 수 */
+} EKF_DelayBuffer;
+
+#endif /* EKF_DELAY_COMPACT */
+
+/**
+ * @brief 이력 버퍼 초기화
+ *
+ * @param buf 이력 버퍼 포인터
+ * @return bool 성공 여부
+ */
+bool ekf_delay_init(EKF_DelayBuffer *buf);
+
+/**
+ * @brief 비행 중 이력 비우기 (ekf_delay_init과 같으며 호출 관찰 콜백에 알림)
+ *
+ * @param ekf 이력을 쓰는 EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @return bool 성공 여부
+ */
+bool ekf_delay_clear(EKF *ekf, EKF_DelayBuffer *buf);
+
+/**
+ * @brief 예측 단계 수행 후 이력 기록
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param imu IMU 샘플
+ * @param timestamp_us 샘플 시각 (us, 예측 구간 끝)
+ * @return bool 예측 성공 여부
+ */
+bool ekf_delay_predict(EKF *ekf, EKF_DelayBuffer *buf, const EKF_ImuSample *imu, uint32_t timestamp_us);
+
+/**
+ * @brief 지연 GPS 측정 갱신
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param gps_pos GPS 위치 측정값 (NED 좌표계, m)
+ * @param use_vel GPS 속도 사용 여부
+ * @param gps_vel GPS 속도 측정값 (NED 좌표계, m/s)
+ * @return bool 갱신 성공 여부 (측정 시각이 이력 범위 밖이면 false)
+ */
+bool ekf_delay_update_gps(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                          Vector3f gps_pos, bool use_vel, Vector3f gps_vel);
+
+/**
+ * @brief 지연 GPS 부분 측정 갱신 (ekf_update_gps_partial)
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param gps_pos GPS 위치 측정값 (NED 좌표계, m)
+ * @param gps_vel GPS 속도 측정값 (NED 좌표계, m/s)
+ * @param components 융합할 성분 (EKF_GpsComponent 조합)
+ * @return bool 갱신 성공 여부 (측정 시각이 이력 범위 밖이면 false)
+ */
+bool ekf_delay_update_gps_partial(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                                  Vector3f gps_pos, Vector3f gps_vel, uint8_t components);
+
+/**
+ * @brief 지연 기압계 측정 갱신
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param baro_alt 기압계 고도 측정값 (m)
+ * @return bool 갱신 성공 여부 (측정 시각이 이력 범위 밖이면 false)
+ */
+bool ekf_delay_update_baro(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us, float baro_alt);
+
+/**
+ * @brief 지연 자력계 측정 갱신
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param mag 자력계 측정값 (정규화된 벡터)
+ * @return bool 갱신 성공 여부 (측정 시각이 이력 범위 밖이면 false)
+ */
+bool ekf_delay_update_mag(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us, Vector3f mag);
+
+/**
+ * @brief 지연 이중 안테나 GNSS 기선 측정 갱신
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param m 기선 측정
+ * @return bool 갱신 성공 여부 (측정 시각이 이력 범위 밖이면 false)
+ */
+bool ekf_delay_update_gnss_heading(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                                   const EKF_GnssHeading *m);
+
+/**
+ * @brief 지연 동시 측정 묶음 갱신 (GNSS + 기압계, ekf_update_coincident)
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us, 묶음 전체에 적용)
+ * @param m 측정 묶음 (결과 필드 기록)
+ * @return bool 하나 이상 반영했으면 true (측정 시각이 이력 범위 밖이면 false)
+ */
+bool ekf_delay_update_coincident(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                                 EKF_CoincidentMeasurement *m);
+
+#endif /* EKF_DELAY_H */
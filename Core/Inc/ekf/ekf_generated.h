@@ -0,0 +1,45 @@
+/**
+ * @file ekf_generated.h
+ * @brief 기호 미분으로 생성한 EKF 모델 커널 (예측값과 자코비안을 한 번에 계산)
+ *
+ * 구현은 Tools/codegen/ekf_codegen.c 로 생성한다 (Core/Src/ekf/ekf_generated.c).
+ * 모델식은 생성 프로그램에 다항식으로 정의되어 있으며, 기호 미분 후 출력 전체에서
+ * 반복되는 곱을 임시 변수로 뽑아 손으로 전개한 식보다 곱셈 수가 적다.
+ * 모델을 바꾸면 생성 프로그램을 고치고 다시 생성한다 (생성 파일 직접 수정 금지).
+ *
+ * 배열 인자는 상태 순서(사원수 w, x, y, z)를 따르며, 희소 자코비안 기록은 호출자가 한다.
+ */
+
+#ifndef EKF_GENERATED_H
+#define EKF_GENERATED_H
+
+/**
+ * @brief 자력계 측정 모델 h = R(q)^T m 과 자코비안 H = dh/dq
+ *
+ * @param q 단위 자세 사원수 (w, x, y, z)
+ * @param m 지구 자기장 (NED)
+ * @param h 예측 측정 (몸체)
+ * @param H 사원수 네 열에 대한 자코비안
+ */
+void ekf_gen_mag_observation(const float q[4], const float m[3], float h[3], float H[3][4]);
+
+/**
+ * @brief 자세 전이의 자이로 바이어스 블록 F = dq'/db
+ *
+ * @param q 적분 후 단위 자세 사원수 (w, x, y, z)
+ * @param dt 시간 간격 (초)
+ * @param F 사원수 네 행 x 자이로 바이어스 세 열
+ */
+void ekf_gen_attitude_transition(const float q[4], float dt, float F[4][3]);
+
+/**
+ * @brief 몸체 벡터 회전 h = R(q) v 와 자코비안 H = dh/dq (GNSS 안테나 레버 암)
+ *
+ * @param q 단위 자세 사원수 (w, x, y, z, 몸체 -> NED)
+ * @param v 몸체 벡터
+ * @param h 회전한 벡터 (NED)
+ * @param H 사원수 네 열에 대한 자코비안
+ */
+void ekf_gen_body_to_nav(const float q[4], const float v[3], float h[3], float H[3][4]);
+
+#endif /* EKF_GENERATED_H */
@@ -0,0 +1,57 @@
+/**
+ * @file ekf_golden.h
+ * @brief 호스트/보드 비트 일치 확인용 표준 재생 (고정 시드 합성 입력)
+ *
+ * 같은 소스가 호스트와 STM32L4에서 같은 비트를 내는지(math/fp_mode.h의 FP_DETERMINISTIC),
+ * 또는 최적화 전후 결과가 같은지 자동으로 확인하기 위한 고정 입력 재생이다. 발사대 정지
+ * 2초(1 kHz 지연 예측, 기압/자력계/GNSS 지연 갱신, ZUPT)를 8구간으로 나누어 돌리며, 중간에
+ * U-D 엔진으로 바꿨다가 되돌리고 마지막 구간은 묶음 예측과 직접 갱신을 쓴다. 초기 자세는
+ * 오일러 각 변환(sinf/cosf), 구간 끝마다 오일러 각(atan2f/asinf)과 정점 예측(atanf/logf)을
+ * 구해 추정 경로의 초월 함수도 함께 확인한다.
+ *
+ * 구간 지문은 구간 끝의 x, P와 위 파생 값의 FNV-1a이다. 처음 다른 구간으로 어긋난 위치를
+ * 좁히고, 마지막 상태(x, P 대각)로 허용 오차 안인지 판단한다.
+ * 보드에서는 벤치마크 빌드(sys/bench.h)가 "BENCH,golden" 줄로 출력하고, 호스트에서는
+ * Tools/bench/golden_check.c가 같은 재생을 돌려 비교한다.
+ */
+
+#ifndef EKF_GOLDEN_H
+#define EKF_GOLDEN_H
+
+#include "ekf/ekf.h"
+#include "ekf/ekf_delay.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 재생 크기
+ */
+#define EKF_GOLDEN_SEGMENTS 8u         /**< 구간 수 */
+#define EKF_GOLDEN_SEGMENT_STEPS 250u  /**< 구간당 IMU 샘플 수 (1 kHz) */
+#define EKF_GOLDEN_SEED 0x12345678u    /**< 합성 입력 난수 시드 */
+
+/**
+ * @brief 재생 결과
+ */
+typedef struct {
+    uint32_t segment[EKF_GOLDEN_SEGMENTS]; /**< 구간 끝 지문 (FNV-1a) */
+    uint32_t digest;           /**< 전체 지문 (구간 지문의 FNV-1a) */
+    float x[EKF_STATE_DIM];    /**< 마지막 상태 */
+    float p_diag[EKF_STATE_DIM]; /**< 마지막 공분산 대각 */
+    uint32_t calls;            /**< 부른 공개 호출 수 */
+    uint32_t rejected;         /**< false를 돌려준 호출 수 */
+} EKF_GoldenResult;
+
+/**
+ * @brief 표준 재생 실행
+ *
+ * ekf와 history는 처음부터 다시 초기화한다 (기본 공유 작업 메모리 영역 사용).
+ *
+ * @param ekf 작업용 EKF
+ * @param history 작업용 지연 이력
+ * @param result 결과
+ * @return bool 성공 여부
+ */
+bool ekf_golden_run(EKF *ekf, EKF_DelayBuffer *history, EKF_GoldenResult *result);
+
+#endif /* EKF_GOLDEN_H */
@@ -0,0 +1,148 @@
+/**
+ * @file ekf_lanes.h
+ * @brief 다중 IMU 중복 필터 레인 (레인별 EKF, 공유 보조 측정, 건전성 점수, 절체)
+ *
+ * IMU마다 EKF 레인을 하나씩 두고, 기압계/자력계/GNSS 측정은 모든 레인에 같은 값으로
+ * 갱신한다. 측정 전처리(자력계 보정, 좌표 변환, 지연 정렬)는 호출자가 한 번만 수행해
+ * 같은 측정값을 넘기면 되고, 상수 측정 자코비안(기압계, GNSS)도 레인 간 차이가 없다.
+ * 자세에 의존하는 부분(자력계 자코비안, 칼만 갱신)만 레인별로 계산된다.
+ *
+ * 비용을 단일 레인의 2배보다 충분히 낮게 유지하기 위해 주 레인만 샘플마다 예측하고,
+ * 보조 레인은 IMU 샘플을 secondary_batch개 모아 ekf_predict_batch로 공분산을 한 번만
+ * 전파한다 (상태는 샘플마다 적분). 보조 측정 갱신 전에는 모든 레인의 남은 샘플을
+ * 먼저 전파해 측정 시각을 맞춘다.
+ *
+ * 건전성 점수는 갱신마다 검정비 r = NIS / 게이트 임계값(EKF_LANES_RATIO_CAP으로 제한)의
+ * 지수 이동 평균이며 작을수록 건전하다. 주 레인 점수가 최선 레인의 EKF_LANES_SWITCH_RATIO
+ * 배를 넘고 EKF_LANES_SWITCH_MIN 이상이면 절체한다. 예측 실패나 상태 발산(유한하지 않음)이
+ * 나면 그 레인을 제외하고 즉시 절체한다.
+ *
+ * 모든 레인의 EKF는 스크래치 영역을 공유하므로 한 태스크에서만 호출해야 한다.
+ */
+
+#ifndef EKF_LANES_H
+#define EKF_LANES_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 최대 레인 수
+ */
+#define EKF_LANES_MAX 3
+
+/**
+ * @brief 보조 레인 일괄 예측 최대 샘플 수
+ */
+#define EKF_LANES_BATCH_MAX 8
+
+/**
+ * @brief 기본 보조 레인 일괄 예측 샘플 수
+ */
+#define EKF_LANES_DEFAULT_BATCH 4
+
+/**
+ * @brief 건전성 점수 설정
+ */
+#define EKF_LANES_SCORE_GAIN 0.05f    /**< 갱신당 지수 이동 평균 이득 */
+#define EKF_LANES_RATIO_CAP 4.0f      /**< 검정비 상한 (이상치 한 번의 영향 제한) */
+#define EKF_LANES_SWITCH_RATIO 2.0f   /**< 절체 점수 비 */
+#define EKF_LANES_SWITCH_MIN 0.1f     /**< 절체 최소 주 레인 점수 (일관된 필터의 기대값은 자유도 / 게이트) */
+
+/**
+ * @brief 필터 레인 묶음
+ */
+typedef struct {
+    EKF *lane[EKF_LANES_MAX];      /**< 레인별 초기화된 EKF */
+    uint8_t count;                 /**< 레인 수 */
+    uint8_t primary;               /**< 주 레인 인덱스 */
+    uint8_t secondary_batch;       /**< 보조 레인 일괄 예측 샘플 수 (1이면 샘플마다) */
+
+    bool healthy[EKF_LANES_MAX];   /**< 레인 사용 가능 여부 (발산 시 false) */
+    float score[EKF_LANES_MAX];    /**< 건전성 점수 (작을수록 건전) */
+
+    EKF_ImuSample pending[EKF_LANES_MAX][EKF_LANES_BATCH_MAX]; /**< 보조 레인 대기 샘플 */
+    uint8_t pending_count[EKF_LANES_MAX]; /**< 대기 샘플 수 */
+
+    uint32_t switch_count;         /**< 절체 횟수 */
+} EKF_Lanes;
+
+/**
+ * @brief 레인 묶음 초기화
+ *
+ * @param lanes 레인 묶음
+ * @param filters 초기화된 EKF 배열 (레인 순서, 0번이 초기 주 레인)
+ * @param count 레인 수 (1 ~ EKF_LANES_MAX)
+ * @param secondary_batch 보조 레인 일괄 예측 샘플 수 (1 ~ EKF_LANES_BATCH_MAX)
+ * @return bool 성공 여부
+ */
+bool ekf_lanes_init(EKF_Lanes *lanes, EKF *const *filters, uint8_t count, uint8_t secondary_batch);
+
+/**
+ * @brief 레인 하나에 IMU 샘플 예측
+ *
+ * @param lanes 레인 묶음
+ * @param lane 레인 인덱스 (샘플을 낸 IMU)
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param accel 가속도 측정값 (m/s^2)
+ * @param dt 시간 간격 (초)
+ * @return bool 성공 여부 (예측 실패 시 레인을 제외하고 false)
+ */
+bool ekf_lanes_predict(EKF_Lanes *lanes, uint8_t lane, Vector3f gyro, Vector3f accel, float dt);
+
+/**
+ * @brief 모든 레인에 GPS 측정 갱신
+ *
+ * @param lanes 레인 묶음
+ * @param gps_pos GPS 위치 (NED, m)
+ * @param use_vel GPS 속도 사용 여부
+ * @param gps_vel GPS 속도 (NED, m/s)
+ * @return bool 주 레인 갱신 성공 여부 (절체 후 기준)
+ */
+bool ekf_lanes_update_gps(EKF_Lanes *lanes, Vector3f gps_pos, bool use_vel, Vector3f gps_vel);
+
+/**
+ * @brief 모든 레인에 기압계 측정 갱신
+ *
+ * @param lanes 레인 묶음
+ * @param baro_alt 기압계 고도 (m)
+ * @return bool 주 레인 갱신 성공 여부 (절체 후 기준)
+ */
+bool ekf_lanes_update_baro(EKF_Lanes *lanes, float baro_alt);
+
+/**
+ * @brief 모든 레인에 자력계 측정 갱신
+ *
+ * @param lanes 레인 묶음
+ * @param mag 자력계 측정값 (보정 후, 몸체 좌표계)
+ * @return bool 주 레인 갱신 성공 여부 (절체 후 기준)
+ */
+bool ekf_lanes_update_mag(EKF_Lanes *lanes, Vector3f mag);
+
+/**
+ * @brief 주 레인 필터
+ *
+ * @param lanes 레인 묶음
+ * @return EKF* 주 레인 (lanes가 NULL이면 NULL)
+ */
+EKF *ekf_lanes_primary(const EKF_Lanes *lanes);
+
+/**
+ * @brief 주 레인 인덱스
+ *
+ * @param lanes 레인 묶음
+ * @return uint8_t 주 레인 인덱스
+ */
+uint8_t ekf_lanes_get_primary_index(const EKF_Lanes *lanes);
+
+/**
+ * @brief 레인 건전성 점수
+ *
+ * @param lanes 레인 묶음
+ * @param lane 레인 인덱스
+ * @return float 점수 (작을수록 건전, 제외된 레인이나 잘못된 인덱스는 음수)
+ */
+float ekf_lanes_get_score(const EKF_Lanes *lanes, uint8_t lane);
+
+#endif /* EKF_LANES_H */
@@ -6,11 +6,91 @@
 #ifndef EKF_MAG_CALIBRATION_H
 #define EKF_MAG_CALIBRATION_H
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "math/vector3f.h"
 
+/**
+ * @brief 현장 자기장 스트리밍 추정기
+ * 
+ * 샘플 배열 없이 Welford 방식으로 자력계/가속도계의 평균과 편차 제곱합을
+ * 누적한다. 샘플 수와 관계없이 메모리 사용량이 일정하다 (52 바이트).
+ */
+typedef struct {
+    uint32_t count;      /**< 누적 샘플 수 */
+    Vector3f mag_mean;   /**< 자력계 평균 (몸체 좌표계) */
+    Vector3f mag_m2;     /**< 자력계 축별 편차 제곱합 */
+    Vector3f accel_mean; /**< 가속도계 평균 (몸체 좌표계) */
+    Vector3f accel_m2;   /**< 가속도계 축별 편차 제곱합 */
+} EKF_MagFieldEstimator;
+
+/**
+ * @brief 현장 자기장 추정 품질 지표
+ */
+typedef struct {
+    uint32_t count;          /**< 누적 샘플 수 */
+    float mag_std;           /**< 자력계 표본 표준 편차 (축별 분산 합의 제곱근) */
+    float accel_std;         /**< 가속도계 표본 표준 편차 (m/s^2) */
+    float direction_stderr;  /**< 평균 자기장 방향의 표준 오차 (rad, 자력계/가속도계 중 큰 값) */
+} EKF_MagFieldQuality;
+
+/**
+ * @brief 스트리밍 추정기 초기화
+ * 
+ * @param est 추정기
+ * @return bool 성공 여부
+ */
+bool ekf_mag_field_init(EKF_MagFieldEstimator *est);
+
+/**
+ * @brief 자력계/가속도계 샘플 한 쌍 누적
+ * 
+ * @param est 추정기
+ * @param mag 자력계 측정값 (몸체 좌표계)
+ * @param accel 가속도계 측정값 (몸체 좌표계, m/s^2)
+ * @return bool 성공 여부
+ */
+bool ekf_mag_field_add_sample(EKF_MagFieldEstimator *est, Vector3f mag, Vector3f accel);
+
+/**
+ * @brief 현재까지의 추정 품질 계산
+ * 
+ * 방향 표준 오차는 평균의 표준 오차를 평균 벡터 크기로 나눈 소각 근사이며,
+ * 자력계(자기장 방향)와 가속도계(수평면 기준) 중 큰 값을 사용한다.
+ * 
+ * @param est 추정기
+ * @param quality 품질 지표
+ * @return bool 성공 여부 (샘플이 2개 미만이면 false)
+ */
+bool ekf_mag_field_get_quality(const EKF_MagFieldEstimator *est, EKF_MagFieldQuality *quality);
+
+/**
+ * @brief 충분한 샘플이 모였는지 판정
+ * 
+ * @param est 추정기
+ * @param min_samples 최소 샘플 수
+ * @param max_direction_stderr 허용 방향 표준 오차 (rad)
+ * @return bool 샘플 수와 방향 표준 오차가 모두 기준을 만족하면 true
+ */
+bool ekf_mag_field_is_ready(const EKF_MagFieldEstimator *est, uint32_t min_samples, float max_direction_stderr);
+
+/**
+ * @brief 누적된 평균으로 NED 좌표계 자기장 단위 벡터 계산
+ * 
+ * ekf_calibrate_magnetic_field와 같은 변환(평균 가속도로 수평면, 평균 자력계 변환)을 수행한다.
+ * 
+ * @param est 추정기
+ * @param mag_ned NED 좌표계의 자기장 단위 벡터
+ * @return bool 성공 여부 (샘플이 없으면 false)
+ */
+bool ekf_mag_field_finalize(const EKF_MagFieldEstimator *est, Vector3f *mag_ned);
+
 /**
  * @brief 자력계와 가속도계 샘플을 수집하여 NED 좌표계로 변환된 자기장 벡터 계산
  * 
+ * 이미 배열로 모은 샘플용이며, 내부적으로 스트리밍 추정기를 사용한다.
+ * 대기 중 실시간 수집에는 EKF_MagFieldEstimator를 직접 사용한다.
+ * 
  * @param mag_samples 자력계 샘플 배열
  * @param accel_samples 가속도계 샘플 배열
  * @param sample_count 샘플 개수
@@ -0,0 +1,117 @@
+/**
+ * @file ekf_preintegration.h
+ * @brief 코닝/스컬링 보정 IMU 각도/속도 증분 사전 적분
+ *
+ * 고속 IMU 샘플을 필터 단계 사이에 누적하여 각도 증분 Δθ와
+ * 속도 증분 Δv(구간 시작 몸체 좌표계)를 만든다.
+ * - 코닝 보정: Ignagni 방식 β += 1/2 (α + Δθ_prev / 6) × Δθ_k
+ * - 스컬링/회전 보정: Δv += dv_k + (α + Δθ_k / 2) × dv_k
+ *
+ * 누적 결과는 등가 EKF_ImuSample(평균 각속도, 등가 가속도, 구간 길이)로 변환되어
+ * ekf_predict 또는 ekf_predict_batch에 그대로 전달할 수 있다.
+ *
+ * 스핀 모드 (ekf_preint_set_spin, 스핀 안정 상단 5~10 rev/s):
+ * 구간 안의 롤 회전이 커지면(10 rev/s, 10 ms에서 0.63 rad) 작은 각 가정의 코닝 보정이
+ * 맞지 않으므로, 자세를 q = q_d ⊗ Rz(φ)로 나눠 스핀축(몸체 z축, 기체 길이 방향) 회전 φ는
+ * 샘플마다 스칼라로 정확히 적분하고, 횡축 각속도와 비력은 샘플 중간 롤각으로 역회전하여
+ * 탈스핀 좌표계(구간 시작 몸체 좌표계와 φ만큼 다름)에서 누적한다.
+ *   φ += ω_z dt,  Δθ_d += Rz(φ_mid) [ω_x ω_y 0]^T dt,  dv_d = Rz(φ_mid) f dt
+ * 탈스핀 증분은 세차/장동만큼 느리게 변하므로 기존 코닝/스컬링 보정이 그대로 맞고,
+ * 추출 시 dq = exp(Δθ_d + β) ⊗ Rz(φ)를 로그 사상으로 등가 각속도로 바꾼다.
+ * 횡축 동역학과 공분산은 추출 주기(느린 필터 주기)로 ekf_predict가 전파한다.
+ * 구간 롤각은 π 미만이어야 등가 각속도가 실제 회전 방향과 맞는다 (10 rev/s에서 50 ms 미만).
+ *
+ * 자이로 바이어스를 설정하면(ekf_preint_set_gyro_bias) 누적 전에 빼고 추출 시 평균 각속도에
+ * 되돌려 더하므로, 같은 바이어스를 쓰는 EKF가 빼면 누적한 회전이 그대로 적용된다.
+ */
+
+#ifndef EKF_PREINTEGRATION_H
+#define EKF_PREINTEGRATION_H
+
+#include "ekf/ekf.h"
+
+/**
+ * @brief 사전 적분 누적기
+ */
+typedef struct {
+    Vector3f alpha;        /**< 누적 각도 증분 (보정 전, rad) */
+    Vector3f beta;         /**< 코닝 보정 누적 (rad) */
+    Vector3f last_dtheta;  /**< 직전 샘플 각도 증분 (rad) */
+    Vector3f delta_vel;    /**< 누적 속도 증분 (구간 시작 몸체 좌표계, m/s) */
+    float dt;              /**< 누적 시간 (초) */
+    uint16_t count;        /**< 누적 샘플 수 */
+    float roll;            /**< 누적 스핀축 회전 φ (스핀 모드, rad) */
+    Vector3f gyro_bias;    /**< 누적 전에 빼는 자이로 바이어스 (rad/s, 초기화해도 유지) */
+    bool spin;             /**< 스핀 모드 (초기화해도 유지) */
+} EKF_Preintegrator;
+
+/**
+ * @brief 누적기 초기화 (누적분만 지우고 스핀 모드와 바이어스는 유지)
+ *
+ * @param preint 누적기 포인터
+ * @return bool 성공 여부
+ */
+bool ekf_preint_reset(EKF_Preintegrator *preint);
+
+/**
+ * @brief 누적기 생성 (일반 모드, 바이어스 0)
+ *
+ * @param preint 누적기 포인터
+ * @return bool 성공 여부
+ */
+bool ekf_preint_init(EKF_Preintegrator *preint);
+
+/**
+ * @brief 스핀 모드 설정 (누적 중이면 false, 구간 경계에서 바꿀 것)
+ *
+ * @param preint 누적기 포인터
+ * @param enable 스핀축(몸체 z축) 회전을 분리 적분할지 여부
+ * @return bool 성공 여부
+ */
+bool ekf_preint_set_spin(EKF_Preintegrator *preint, bool enable);
+
+/**
+ * @brief 누적 전에 뺄 자이로 바이어스 설정 (보통 추출 직후 EKF 추정값)
+ *
+ * @param preint 누적기 포인터
+ * @param bias 자이로 바이어스 (rad/s)
+ * @return bool 성공 여부 (누적 중이면 false)
+ */
+bool ekf_preint_set_gyro_bias(EKF_Preintegrator *preint, Vector3f bias);
+
+/**
+ * @brief IMU 샘플 1개 누적
+ *
+ * @param preint 누적기 포인터
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param accel 가속도 측정값 (m/s^2)
+ * @param dt 샘플 간격 (초)
+ * @return bool 성공 여부
+ */
+bool ekf_preint_add(EKF_Preintegrator *preint, Vector3f gyro, Vector3f accel, float dt);
+
+/**
+ * @brief 보정된 각도/속도 증분 조회
+ *
+ * @param preint 누적기 포인터
+ * @param delta_angle 각도 증분 (rad, 코닝 보정 포함, 스핀 모드에서는 합성 회전의 회전 벡터)
+ * @param delta_vel 속도 증분 (m/s, 구간 시작 몸체 좌표계, 스컬링 보정 포함)
+ * @param dt 누적 시간 (초)
+ * @return bool 성공 여부 (누적 샘플이 없으면 false)
+ */
+bool ekf_preint_get_delta(const EKF_Preintegrator *preint, Vector3f *delta_angle,
+                          Vector3f *delta_vel, float *dt);
+
+/**
+ * @brief 누적 결과를 등가 IMU 샘플로 변환하고 누적기 초기화
+ *
+ * gyro = Δθ / T + b, accel = exp(Δθ)^(-1) Δv / T 로 두면 EKF 예측 단계가
+ * 구간 끝 자세로 가속도를 회전할 때 구간 시작 기준 Δv가 그대로 적용된다.
+ *
+ * @param preint 누적기 포인터
+ * @param sample 등가 IMU 샘플
+ * @return bool 성공 여부 (누적 샘플이 없으면 false)
+ */
+bool ekf_preint_extract(EKF_Preintegrator *preint, EKF_ImuSample *sample);
+
+#endif /* EKF_PREINTEGRATION_H */
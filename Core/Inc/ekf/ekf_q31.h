@@ -0,0 +1,253 @@
+/**
+ * @file ekf_q31.h
+ * @brief 저전력 예비 프로세서용 Q31 고정 소수점 자세/수직 채널 필터
+ *
+ * 복구 보드의 저전력 상태에서 예비 항법 해를 내기 위한 축소 필터이다.
+ * 상태는 자세 사원수(4), 자이로 바이어스(3), 고도, 수직 속도로 9개이며, 예측은
+ * ekf_predict와 같은 식을 쓴다.
+ * - 자세: q = q ⊗ exp((ω - b_ω) dt / 2), 적분 후 1/|q| ~= (3 - |q|^2) / 2 보정
+ * - 자코비안: 사원수-자이로 바이어스 블록 -0.5 q ⊗ b_ω, 고도-수직 속도 블록 dt
+ * - 수직 채널: 회전 행렬 셋째 행으로 비력을 변환하고 중력을 뺀 가속도로 적분
+ *
+ * 공분산은 자세 블록(7x7)과 수직 블록(2x2)으로 나누어 두며 블록 사이 상관은 버린다.
+ * 측정은 정지/등속 구간의 비력 방향(중력 방향, 수평 자세 관측)과 기압 고도이다.
+ * 비력 방향은 비력 크기가 중력에 가까운 상태가 gravity_settle_us 이상 이어졌고 상승 속도가
+ * gravity_max_climb 이하일 때만 쓴다. 추진 종료처럼 크기가 중력을 잠깐 지나가는 순간이나,
+ * 고속 관성 상승 중 항력 감속이 1 g 근처인 구간(비력이 몸체 축 반대 방향)을 중력으로
+ * 오인하지 않기 위함이다. 낙하산 하강 중에는 항력이 중력과 평형이므로 그대로 쓴다.
+ * 자력계가 없으므로 방위는 자이로 적분만으로 유지된다.
+ *
+ * 수치 형식:
+ * - 상태와 입력은 EKF_Q31_*_EXP 범위 지수의 고정 소수점 (math/q31.h)
+ * - 공분산은 상태별 표준 편차 척도 s_i로 나눈 정규화 값 P_ij / (s_i s_j)를 Q31로 저장
+ * - 모든 연산은 64비트 중간값에서 반올림 후 포화하며, 한 단계 증분이 최하위 비트보다
+ *   작은 적분(고도/속도, 프로세스 노이즈)은 나머지를 이월한다
+ * - 설정 변환(ekf_q31_init)에서만 부동소수점을 쓰고, 예측/갱신은 정수 연산만 쓴다
+ *
+ * 공분산은 EKF의 지연 전파와 같이 cov_period_us마다 누적 구간의 전이 행렬로 한 번
+ * 전파한다 (측정 갱신 전에는 항상 반영). 자세 적분과 수직 적분은 매 샘플 수행한다.
+ */
+
+#ifndef EKF_Q31_H
+#define EKF_Q31_H
+
+#include "math/q31.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 입력/상태 범위 지수 (전체 범위 ±2^exp)
+ */
+#define EKF_Q31_QUAT_EXP 1    /**< 사원수 (Q30) */
+#define EKF_Q31_GYRO_EXP 6    /**< 각속도 입력 (±64 rad/s, Q25) */
+#define EKF_Q31_BIAS_EXP -1   /**< 자이로 바이어스 (±0.5 rad/s, Q32) */
+#define EKF_Q31_ACCEL_EXP 8   /**< 비력 입력 (±256 m/s^2, Q23) */
+#define EKF_Q31_POS_EXP 16    /**< 고도 (±65536 m, Q15) */
+#define EKF_Q31_VEL_EXP 11    /**< 수직 속도 (±2048 m/s, Q20) */
+
+/**
+ * @brief 공분산 정규화 척도 지수 (표준 편차 척도 s = 2^exp)
+ */
+#define EKF_Q31_P_QUAT_EXP 0  /**< 사원수 (1) */
+#define EKF_Q31_P_BIAS_EXP -1 /**< 자이로 바이어스 (0.5 rad/s) */
+#define EKF_Q31_P_POS_EXP 5   /**< 고도 (32 m) */
+#define EKF_Q31_P_VEL_EXP 4   /**< 수직 속도 (16 m/s) */
+
+/**
+ * @brief 블록 차원
+ */
+#define EKF_Q31_ATT_DIM 7     /**< 사원수 4 + 자이로 바이어스 3 */
+#define EKF_Q31_VERT_DIM 2    /**< 고도 + 수직 속도 */
+
+/**
+ * @brief 한 번에 적분할 수 있는 최대 간격 (us, 이보다 길면 잘라서 적분)
+ *
+ * 회전 벡터 |ω dt|가 Q31 범위(1 rad) 안에 들도록 정한다.
+ */
+#define EKF_Q31_MAX_DT_US 10000u
+
+/**
+ * @brief 기본 공분산 전파 주기 (us)
+ */
+#define EKF_Q31_DEFAULT_COV_PERIOD_US 10000u
+
+/**
+ * @brief 기본 혁신 게이트 (1자유도 카이제곱 99.9%, EKF_NIS_GATE_1DOF와 같음)
+ */
+#define EKF_Q31_DEFAULT_NIS_GATE 10.83f
+
+/**
+ * @brief 기본 비력 방향 갱신 조건
+ */
+#define EKF_Q31_DEFAULT_GRAVITY_GATE 0.5f          /**< 비력 크기 허용 오차 (m/s^2) */
+#define EKF_Q31_DEFAULT_GRAVITY_SETTLE_US 200000u  /**< 조건 유지 시간 (us) */
+#define EKF_Q31_DEFAULT_GRAVITY_MAX_CLIMB 10.0f    /**< 최대 상승 속도 (m/s) */
+
+/**
+ * @brief 필터 설정 (물리 단위, ekf_q31_init에서 고정 소수점으로 변환)
+ */
+typedef struct {
+    float att_std;             /**< 자세 프로세스 노이즈 (ekf_set_process_noise와 같은 의미) */
+    float gyro_bias_std;       /**< 자이로 바이어스 프로세스 노이즈 */
+    float pos_std;             /**< 고도 프로세스 노이즈 */
+    float vel_std;             /**< 수직 속도 프로세스 노이즈 */
+    float p_att;               /**< 사원수 초기 분산 */
+    float p_gyro_bias;         /**< 자이로 바이어스 초기 분산 ((rad/s)^2) */
+    float p_pos;               /**< 고도 초기 분산 (m^2) */
+    float p_vel;               /**< 수직 속도 초기 분산 ((m/s)^2) */
+    float gravity_std;         /**< 비력 방향 측정 노이즈 (단위 벡터 성분 표준 편차) */
+    float gravity_gate;        /**< 비력 크기 허용 오차 (m/s^2, 넘으면 가속 중으로 보고 갱신 생략) */
+    uint32_t gravity_settle_us; /**< 비력 크기 조건이 유지되어야 하는 시간 (us) */
+    float gravity_max_climb;   /**< 비력 방향 갱신을 허용하는 최대 상승 속도 (m/s) */
+    float baro_std;            /**< 기압 고도 측정 노이즈 표준 편차 (m) */
+    float nis_gate;            /**< 혁신 게이트 (정규화 혁신 제곱, 0이면 사용 안 함) */
+    float gravity;             /**< 중력 가속도 (m/s^2) */
+    uint32_t cov_period_us;    /**< 공분산 전파 주기 (us, 0이면 매 예측) */
+} EKF_Q31_Config;
+
+/**
+ * @brief 갱신 통계
+ */
+typedef struct {
+    uint32_t gravity_updates;  /**< 적용한 비력 방향 갱신 수 */
+    uint32_t gravity_skips;    /**< 비력 크기/유지 시간 조건으로 생략한 수 */
+    uint32_t gravity_rejects;  /**< 혁신 게이트로 거부한 측정 수 (세 성분 중 하나라도 넘으면 거부) */
+    uint32_t baro_updates;     /**< 적용한 기압 갱신 수 */
+    uint32_t baro_rejects;     /**< 혁신 게이트로 거부한 기압 측정 수 */
+} EKF_Q31_Stats;
+
+/**
+ * @brief Q31 자세/수직 채널 필터
+ */
+typedef struct {
+    int32_t q[4];              /**< 자세 사원수 (w, x, y, z, 몸체 -> NED, EKF_Q31_QUAT_EXP) */
+    int32_t gyro_bias[3];      /**< 자이로 바이어스 (EKF_Q31_BIAS_EXP) */
+    int32_t pos_z;             /**< 고도 (EKF 위치 z와 같은 방향, EKF_Q31_POS_EXP) */
+    int32_t vel_z;             /**< 수직 속도 (EKF_Q31_VEL_EXP) */
+    int64_t pos_residue;       /**< 고도 적분 이월 나머지 */
+    int64_t vel_residue;       /**< 속도 적분 이월 나머지 */
+
+    int32_t P_att[EKF_Q31_ATT_DIM][EKF_Q31_ATT_DIM];    /**< 자세 블록 정규화 공분산 (Q31) */
+    int32_t P_vert[EKF_Q31_VERT_DIM][EKF_Q31_VERT_DIM]; /**< 수직 블록 정규화 공분산 (Q31) */
+    int32_t P0_att[EKF_Q31_ATT_DIM];                    /**< 자세 블록 초기 분산 (정규화 Q31) */
+    int32_t P0_vert[EKF_Q31_VERT_DIM];                  /**< 수직 블록 초기 분산 (정규화 Q31) */
+
+    int32_t q_att[EKF_Q31_ATT_DIM];   /**< 자세 블록 연속 프로세스 노이즈 (정규화 Q31, 1/s) */
+    int32_t q_vert[EKF_Q31_VERT_DIM]; /**< 수직 블록 연속 프로세스 노이즈 (정규화 Q31, 1/s) */
+    int64_t q_residue[EKF_Q31_ATT_DIM + EKF_Q31_VERT_DIM]; /**< 대각 노이즈 이월 나머지 */
+
+    int32_t r_gravity;         /**< 비력 방향 측정 분산 (정규화 Q31) */
+    int32_t r_baro;            /**< 기압 측정 분산 (정규화 Q31) */
+    int32_t gravity;           /**< 중력 가속도 (EKF_Q31_ACCEL_EXP) */
+    uint64_t gravity_sq_min;   /**< 허용 비력 크기 제곱 하한 (EKF_Q31_ACCEL_EXP 제곱) */
+    uint64_t gravity_sq_max;   /**< 허용 비력 크기 제곱 상한 */
+    uint32_t gravity_settle_us; /**< 비력 크기 조건 유지 시간 (us) */
+    uint32_t quiet_us;         /**< 비력 크기 조건이 이어진 시간 (us, 예측마다 갱신) */
+    int32_t gravity_max_climb; /**< 최대 상승 속도 (EKF_Q31_VEL_EXP) */
+    int64_t nis_gate_q8;       /**< 혁신 게이트 (Q8, 0이면 사용 안 함) */
+
+    uint32_t cov_period_us;    /**< 공분산 전파 주기 (us) */
+    uint32_t cov_dt_us;        /**< 공분산에 반영하지 않은 누적 시간 (us) */
+
+    EKF_Q31_Stats stats;
+} EKF_Q31;
+
+/**
+ * @brief 기본 설정
+ *
+ * 초기 분산은 EKF 기본값(ekf_config.h)과 같다. 자력계/GNSS 없이 자이로 적분으로 오래
+ * 버텨야 하므로 자세/바이어스 프로세스 노이즈는 EKF 기본값보다 작게 잡는다.
+ *
+ * @param config 설정
+ */
+void ekf_q31_default_config(EKF_Q31_Config *config);
+
+/**
+ * @brief 필터 초기화 (수평 자세, 고도/속도 0, 초기 분산)
+ *
+ * @param f 필터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool ekf_q31_init(EKF_Q31 *f, const EKF_Q31_Config *config);
+
+/**
+ * @brief 초기 상태 설정 (바이어스 0, 공분산은 초기 분산으로)
+ *
+ * @param f 필터
+ * @param q 자세 사원수 (EKF_Q31_QUAT_EXP, 단위 사원수)
+ * @param pos_z 고도 (EKF_Q31_POS_EXP)
+ * @param vel_z 수직 속도 (EKF_Q31_VEL_EXP)
+ * @return bool 성공 여부
+ */
+bool ekf_q31_set_initial_state(EKF_Q31 *f, const int32_t q[4], int32_t pos_z, int32_t vel_z);
+
+/**
+ * @brief 예측 (IMU 샘플 하나)
+ *
+ * @param f 필터
+ * @param gyro 각속도 (rad/s, EKF_Q31_GYRO_EXP)
+ * @param accel 비력 (m/s^2, EKF_Q31_ACCEL_EXP)
+ * @param dt_us 이전 샘플부터의 간격 (us)
+ * @return bool 성공 여부
+ */
+bool ekf_q31_predict(EKF_Q31 *f, const int32_t gyro[3], const int32_t accel[3], uint32_t dt_us);
+
+/**
+ * @brief 비력 방향 갱신 (수평 자세와 x/y 자이로 바이어스 관측)
+ *
+ * 비력 크기가 중력과 gravity_gate 이상 다르거나(추진, 기동) 그 조건이 gravity_settle_us 동안
+ * 이어지지 않았거나 상승 속도가 gravity_max_climb을 넘으면 갱신하지 않는다.
+ *
+ * @param f 필터
+ * @param accel 비력 (m/s^2, EKF_Q31_ACCEL_EXP)
+ * @return bool 갱신했으면 true (생략하거나 게이트로 거부하면 false)
+ */
+bool ekf_q31_update_gravity(EKF_Q31 *f, const int32_t accel[3]);
+
+/**
+ * @brief 기압 고도 갱신
+ *
+ * @param f 필터
+ * @param alt 기압 고도 (m, EKF_Q31_POS_EXP)
+ * @return bool 갱신했으면 true
+ */
+bool ekf_q31_update_baro(EKF_Q31 *f, int32_t alt);
+
+/**
+ * @brief 자세 사원수 조회
+ *
+ * @param f 필터
+ * @param q 사원수 (EKF_Q31_QUAT_EXP)
+ * @return bool 성공 여부
+ */
+bool ekf_q31_get_attitude(const EKF_Q31 *f, int32_t q[4]);
+
+/**
+ * @brief 수직 채널 조회
+ *
+ * @param f 필터
+ * @param pos_z 고도 (EKF_Q31_POS_EXP, NULL 가능)
+ * @param vel_z 수직 속도 (EKF_Q31_VEL_EXP, NULL 가능)
+ * @return bool 성공 여부
+ */
+bool ekf_q31_get_vertical(const EKF_Q31 *f, int32_t *pos_z, int32_t *vel_z);
+
+/**
+ * @brief 분산 조회 (진단용, 물리 단위)
+ *
+ * @param f 필터
+ * @param var 상태 순서(사원수 4, 자이로 바이어스 3, 고도, 수직 속도) 분산 9개
+ * @return bool 성공 여부
+ */
+bool ekf_q31_get_variances(const EKF_Q31 *f, float var[EKF_Q31_ATT_DIM + EKF_Q31_VERT_DIM]);
+
+/**
+ * @brief 갱신 통계 조회
+ *
+ * @param f 필터
+ * @return const EKF_Q31_Stats* 통계 (f가 NULL이면 NULL)
+ */
+const EKF_Q31_Stats *ekf_q31_get_stats(const EKF_Q31 *f);
+
+#endif /* EKF_Q31_H */
@@ -0,0 +1,94 @@
+/**
+ * @file ekf_wmm.h
+ * @brief 지구 자기장 모델 격자 표 조회 (EKF 기준 자기장 초기화용)
+ *
+ * 구면 조화 함수 전개를 대신해, 미리 계산한 편각(declination)/복각(inclination)/
+ * 전자기력(intensity) 격자 표를 플래시(const)에 두고 위도/경도로 쌍선형 보간한다.
+ * 조회 비용은 보간 3회와 sin/cos 2쌍으로 수백 사이클이다.
+ *
+ * 표는 Tools/wmm/wmm_grid.c 로 생성하며 (Core/Src/ekf/ekf_wmm_table.c),
+ * 모델 계수와 기준 연도(epoch)는 생성 도구와 표 파일 머리말에 기록된다.
+ * 고도 영향(발사 고도 범위에서 0.1% 미만)과 연도 변화는 무시한다.
+ *
+ * 5도 격자의 보간 오차 (|위도| <= 50도, 격자 중간점): 편각 0.8도, 복각 0.3도,
+ * 전자기력 170 nT. 자극 부근에서는 편각 변화가 급해 오차가 커진다.
+ */
+
+#ifndef EKF_WMM_H
+#define EKF_WMM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/vector3f.h"
+
+/**
+ * @brief 격자 간격 (도)
+ */
+#define EKF_WMM_GRID_STEP_DEG 5
+
+/**
+ * @brief 격자 범위 (도, 양 끝 포함)
+ */
+#define EKF_WMM_LAT_MIN_DEG (-90)
+#define EKF_WMM_LON_MIN_DEG (-180)
+
+/**
+ * @brief 격자 크기 (위도 -90..90, 경도 -180..180, 180도 열은 -180도 열과 같음)
+ */
+#define EKF_WMM_LAT_COUNT (180 / EKF_WMM_GRID_STEP_DEG + 1)
+#define EKF_WMM_LON_COUNT (360 / EKF_WMM_GRID_STEP_DEG + 1)
+
+/**
+ * @brief 표 저장 단위
+ *
+ * - 편각, 복각: 0.01도 (int16)
+ * - 전자기력: 10 nT (int16)
+ */
+#define EKF_WMM_ANGLE_SCALE 0.01f
+#define EKF_WMM_INTENSITY_SCALE 10.0f
+
+/**
+ * @brief 기본 발사 지점 (GNSS 고정 전 초기값, 서울 37.5°N 127°E)
+ */
+#define EKF_WMM_DEFAULT_LAT_DEG 37.5f
+#define EKF_WMM_DEFAULT_LON_DEG 127.0f
+
+/**
+ * @brief 격자 표 (Core/Src/ekf/ekf_wmm_table.c, 생성 파일)
+ */
+extern const int16_t ekf_wmm_declination[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT];
+extern const int16_t ekf_wmm_inclination[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT];
+extern const int16_t ekf_wmm_intensity[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT];
+
+/**
+ * @brief 보간된 지구 자기장 요소
+ */
+typedef struct {
+    float declination;  /**< 편각 (rad, 진북 기준 동쪽 양수) */
+    float inclination;  /**< 복각 (rad, 아래쪽 양수) */
+    float intensity;    /**< 전자기력 (nT) */
+} EKF_WmmField;
+
+/**
+ * @brief 위도/경도에서 자기장 요소 조회
+ *
+ * @param lat_deg 위도 (도, [-90, 90]으로 제한)
+ * @param lon_deg 경도 (도, 임의 범위, [-180, 180)으로 순환)
+ * @param field 자기장 요소
+ * @return bool 성공 여부 (입력이 유한하지 않으면 false)
+ */
+bool ekf_wmm_lookup(float lat_deg, float lon_deg, EKF_WmmField *field);
+
+/**
+ * @brief 위도/경도에서 NED 좌표계 지구 자기장 벡터 조회
+ *
+ * EKF 기준 자기장(earth_mag_ned)과 같은 가우스 단위로 반환한다 (1 G = 1e5 nT).
+ *
+ * @param lat_deg 위도 (도)
+ * @param lon_deg 경도 (도)
+ * @param mag_ned 지구 자기장 벡터 (NED, G)
+ * @return bool 성공 여부
+ */
+bool ekf_wmm_get_field_ned(float lat_deg, float lon_deg, Vector3f *mag_ned);
+
+#endif /* EKF_WMM_H */
@@ -0,0 +1,249 @@
+/**
+ * @file eskf.h
+ * @brief 오차 상태(곱셈형) 확장 칼만 필터(Error-State Kalman Filter) 구현
+ *
+ * 명목 상태(위치, 속도, 자세 사원수, 바이어스)는 비선형 식으로 직접 적분하고,
+ * 공분산은 15차원 오차 상태(자세는 3성분 회전 벡터 오차)에 대해서만 유지한다.
+ * 측정 갱신 후 추정된 오차를 명목 상태에 주입하고 오차를 0으로 리셋한다.
+ *
+ * EKF와 같은 형태의 API를 제공하므로, 상위 모듈에서 필터 엔진을
+ * EKF(16차원 가산 사원수) 또는 ESKF(15차원 오차 상태) 중에서 선택할 수 있다.
+ * 측정 노이즈는 대각 분산으로 저장하며, 갱신은 항상 순차 스칼라 방식이다.
+ */
+
+#ifndef ESKF_H
+#define ESKF_H
+
+#include "math/matrix_fixed.h"
+#include "math/matrix_sym.h"
+#include "math/quaternion.h"
+#include "math/vector3f.h"
+
+/**
+ * @brief ESKF 오차 상태 벡터 크기
+ *
+ * 오차 상태 벡터 구성:
+ * - 위치 오차 (dx, dy, dz): 3
+ * - 속도 오차 (dvx, dvy, dvz): 3
+ * - 자세 오차 (dθx, dθy, dθz, 몸체 좌표계 회전 벡터): 3
+ * - 각속도 바이어스 오차 (dbgx, dbgy, dbgz): 3
+ * - 가속도 바이어스 오차 (dbax, dbay, dbaz): 3
+ * 총 15개 오차 상태 변수
+ */
+#define ESKF_ERROR_DIM 15
+
+/**
+ * @brief ESKF 오차 상태 인덱스 정의
+ */
+typedef enum {
+    ESKF_ERR_POS_X = 0,        /**< 위치 오차 X */
+    ESKF_ERR_POS_Y = 1,        /**< 위치 오차 Y */
+    ESKF_ERR_POS_Z = 2,        /**< 위치 오차 Z */
+    ESKF_ERR_VEL_X = 3,        /**< 속도 오차 X */
+    ESKF_ERR_VEL_Y = 4,        /**< 속도 오차 Y */
+    ESKF_ERR_VEL_Z = 5,        /**< 속도 오차 Z */
+    ESKF_ERR_ATT_X = 6,        /**< 자세 오차 X */
+    ESKF_ERR_ATT_Y = 7,        /**< 자세 오차 Y */
+    ESKF_ERR_ATT_Z = 8,        /**< 자세 오차 Z */
+    ESKF_ERR_GYRO_BIAS_X = 9,  /**< 자이로 바이어스 오차 X */
+    ESKF_ERR_GYRO_BIAS_Y = 10, /**< 자이로 바이어스 오차 Y */
+    ESKF_ERR_GYRO_BIAS_Z = 11, /**< 자이로 바이어스 오차 Z */
+    ESKF_ERR_ACC_BIAS_X = 12,  /**< 가속도 바이어스 오차 X */
+    ESKF_ERR_ACC_BIAS_Y = 13,  /**< 가속도 바이어스 오차 Y */
+    ESKF_ERR_ACC_BIAS_Z = 14   /**< 가속도 바이어스 오차 Z */
+} ESKF_ErrorIndex;
+
+/**
+ * @brief ESKF 구조체
+ */
+typedef struct {
+    Vector3f pos;         /**< 명목 위치 (NED 좌표계, m) */
+    Vector3f vel;         /**< 명목 속도 (NED 좌표계, m/s) */
+    Quaternion q;         /**< 명목 자세 사원수 (몸체 -> NED) */
+    Vector3f gyro_bias;   /**< 명목 자이로 바이어스 (rad/s) */
+    Vector3f acc_bias;    /**< 명목 가속도 바이어스 (m/s^2) */
+
+    MatSym15 P;           /**< 오차 공분산 행렬 (15x15, 상삼각 압축 저장) */
+    MatSym15 Q;           /**< 프로세스 노이즈 공분산 (15x15, 상삼각 압축 저장) */
+
+    float R_gps[6];       /**< GPS 측정 노이즈 분산 (위치 3, 속도 3) */
+    float R_baro;         /**< 기압계 측정 노이즈 분산 */
+    float R_mag[3];       /**< 자력계 측정 노이즈 분산 */
+
+    float gravity;        /**< 중력 가속도 (m/s^2) */
+
+    Vector3f earth_mag_ned; /**< 지구 자기장 벡터 (NED 좌표계) */
+
+    bool initialized;     /**< 초기화 여부 */
+} ESKF;
+
+/**
+ * @brief ESKF 초기화
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return bool 초기화 성공 여부
+ */
+bool eskf_init(ESKF *eskf);
+
+/**
+ * @brief ESKF 초기 상태 설정
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param pos 초기 위치 (NED 좌표계)
+ * @param vel 초기 속도 (NED 좌표계)
+ * @param q 초기 자세 사원수
+ * @return bool 설정 성공 여부
+ */
+bool eskf_set_initial_state(ESKF *eskf, Vector3f pos, Vector3f vel, Quaternion q);
+
+/**
+ * @brief ESKF 프로세스 노이즈 설정
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param pos_std 위치 표준 편차 (m)
+ * @param vel_std 속도 표준 편차 (m/s)
+ * @param att_std 자세 표준 편차 (rad)
+ * @param gyro_bias_std 자이로 바이어스 표준 편차 (rad/s)
+ * @param acc_bias_std 가속도 바이어스 표준 편차 (m/s^2)
+ * @return bool 설정 성공 여부
+ */
+bool eskf_set_process_noise(ESKF *eskf, float pos_std, float vel_std, float att_std,
+                            float gyro_bias_std, float acc_bias_std);
+
+/**
+ * @brief ESKF GPS 측정 노이즈 설정
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param pos_std 위치 표준 편차 (m)
+ * @param vel_std 속도 표준 편차 (m/s)
+ * @return bool 설정 성공 여부
+ */
+bool eskf_set_gps_noise(ESKF *eskf, float pos_std, float vel_std);
+
+/**
+ * @brief ESKF 기압계 측정 노이즈 설정
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param baro_std 고도 표준 편차 (m)
+ * @return bool 설정 성공 여부
+ */
+bool eskf_set_baro_noise(ESKF *eskf, float baro_std);
+
+/**
+ * @brief ESKF 자력계 측정 노이즈 설정
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param mag_std 자기장 표준 편차 (uT)
+ * @return bool 설정 성공 여부
+ */
+bool eskf_set_mag_noise(ESKF *eskf, float mag_std);
+
+/**
+ * @brief ESKF 지구 자기장 벡터 설정
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param mag_ned 지구 자기장 벡터 (NED 좌표계)
+ * @return bool 설정 성공 여부
+ */
+bool eskf_set_earth_magnetic_field(ESKF *eskf, Vector3f mag_ned);
+
+/**
+ * @brief ESKF 예측 단계 (IMU 데이터 기반)
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param accel 가속도 측정값 (m/s^2)
+ * @param dt 시간 간격 (초)
+ * @return bool 예측 성공 여부
+ */
+bool eskf_predict(ESKF *eskf, Vector3f gyro, Vector3f accel, float dt);
+
+/**
+ * @brief ESKF GPS 측정 갱신
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param gps_pos GPS 위치 측정값 (NED 좌표계, m)
+ * @param use_vel GPS 속도 사용 여부
+ * @param gps_vel GPS 속도 측정값 (NED 좌표계, m/s)
+ * @return bool 갱신 성공 여부
+ */
+bool eskf_update_gps(ESKF *eskf, Vector3f gps_pos, bool use_vel, Vector3f gps_vel);
+
+/**
+ * @brief ESKF 기압계 측정 갱신
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param baro_alt 기압계 고도 측정값 (m, 음수는 아래 방향)
+ * @return bool 갱신 성공 여부
+ */
+bool eskf_update_baro(ESKF *eskf, float baro_alt);
+
+/**
+ * @brief ESKF 자력계 측정 갱신
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param mag 자력계 측정값 (몸체 좌표계, uT)
+ * @return bool 갱신 성공 여부
+ */
+bool eskf_update_mag(ESKF *eskf, Vector3f mag);
+
+/**
+ * @brief ESKF 명목 상태에서 위치 추출
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return Vector3f 위치 벡터 (NED 좌표계, m)
+ */
+Vector3f eskf_get_position(const ESKF *eskf);
+
+/**
+ * @brief ESKF 명목 상태에서 속도 추출
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return Vector3f 속도 벡터 (NED 좌표계, m/s)
+ */
+Vector3f eskf_get_velocity(const ESKF *eskf);
+
+/**
+ * @brief ESKF 명목 상태에서 자세 추출
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return Quaternion 자세 사원수
+ */
+Quaternion eskf_get_attitude(const ESKF *eskf);
+
+/**
+ * @brief ESKF 명목 상태에서 오일러 각 추출
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param roll 롤 각도를 저장할 포인터 (rad)
+ * @param pitch 피치 각도를 저장할 포인터 (rad)
+ * @param yaw 요 각도를 저장할 포인터 (rad)
+ * @return bool 추출 성공 여부
+ */
+bool eskf_get_euler(const ESKF *eskf, float *roll, float *pitch, float *yaw);
+
+/**
+ * @brief ESKF 명목 상태에서 자이로 바이어스 추출
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return Vector3f 자이로 바이어스 (rad/s)
+ */
+Vector3f eskf_get_gyro_bias(const ESKF *eskf);
+
+/**
+ * @brief ESKF 명목 상태에서 가속도 바이어스 추출
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return Vector3f 가속도 바이어스 (m/s^2)
+ */
+Vector3f eskf_get_accel_bias(const ESKF *eskf);
+
+/**
+ * @brief ESKF 상태 리셋
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @return bool 리셋 성공 여부
+ */
+bool eskf_reset(ESKF *eskf);
+
+#endif /* ESKF_H */
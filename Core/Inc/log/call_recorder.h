@@ -0,0 +1,169 @@
+/**
+ * @file call_recorder.h
+ * @brief EKF 공개 호출 기록기 (비행 중 호출열을 기록해 호스트에서 같은 호출을 그대로 재생)
+ *
+ * 비행 중 이상을 호스트에서 재현하려면 센서 기록으로 융합 스케줄러를 다시 돌리는 것
+ * (Tools/replay/log_replay.c)만으로는 부족하다. 스케줄러 판단(지연 되감기, 합치기, 단계 전환)과
+ * 시간 예산에 따른 생략이 호스트에서 달라질 수 있기 때문이다. 이 기록기는 EKF 공개 호출
+ * 관찰 콜백(ekf_set_call_observer)을 받아 EKF가 실제로 받은 호출(EKF_CallId, 인자 원본 바이트,
+ * 시각)을 flash_log 레코드로 남긴다. 시작할 때 EKF 상태 전체(EKF_SNAPSHOT_SIZE)와 지연 이력을
+ * 스냅샷으로 남기므로, 호스트 재생기(Tools/replay/call_player.c)는 같은 라이브러리 빌드로
+ * 같은 호출을 같은 순서로 불러 비트 단위로 같은 결과를 얻고, 다른 엔진으로 바꿔 비교할 수 있다.
+ *
+ * 레코드 (리틀 엔디언, 호출 번호는 시작부터 0, 1, 2...):
+ * @verbatim
+ *   EKF_CALL:  index(u32) | t_us(u32) | call(u8) | n(u16) | 인자 조각
+ *              첫 조각은 n = 인자 전체 길이, 이어지는 조각은 call | 0x80, n = 조각 시작 위치
+ *              인자 = head | tail (EKF_CallObserver 두 조각을 이어 붙인 것, EKF_CallId 설명 참고)
+ *   EKF_CHECK: index(u32) | crc(x) u32 | crc(P) u32       index번 호출 직전 상태의 CRC-32
+ *   EKF_SNAP:  index(u32) | 0xFFFF | ekf_size u16 | history_size u16 | layout u32 | initialized u8
+ *              index(u32) | offset(u16) | 조각            (EKF 스냅샷 범위 다음에 지연 이력)
+ * @endverbatim
+ * 스냅샷은 index번 호출 직전 상태이다. 레코드를 잃으면(기록 가득 참 등) 다음 호출 전에
+ * 스냅샷을 다시 남겨 재생기가 거기서부터 다시 맞출 수 있게 한다. ekf_set_engine 호출 직전에도
+ * 스냅샷을 남기는데(snapshot_on_engine), 필터 건강 감시기(filter_health.h) 수리나 보정값/웜
+ * 스타트 복원처럼 P를 직접 고친 뒤 ekf_set_engine을 부르는 경로도 그대로 재생되게 하기 위해서다.
+ *
+ * 비용: 호출마다 콜백 하나와 레코드 하나(1 kHz 지연 예측이면 약 45 B/ms). 검사값은
+ * check_interval 호출마다 x와 P를 CRC-32로 한 번 훑는다 (HwCrc가 있으면 주변장치 계산).
+ * 스냅샷은 약 14 kB(레코드 60개 남짓)로 시작과 엔진 전환, 기록 손실 뒤에만 남는다.
+ *
+ * 기록은 flash_log_write와 같은 문맥(EKF를 부르는 융합 태스크)에서만 일어난다. 설정 함수
+ * (노이즈, 게이트 등)는 기록하지 않으므로 설정을 마친 뒤 call_recorder_start를 부른다.
+ */
+
+#ifndef CALL_RECORDER_H
+#define CALL_RECORDER_H
+
+#include "log/flash_log.h"
+#include "ekf/ekf.h"
+#include "ekf/ekf_delay.h"
+#include "sys/hw_crc.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 레코드 헤더 크기
+ */
+#define CALL_RECORDER_CALL_HEADER 11u  /**< EKF_CALL 레코드 헤더 (index, t_us, call, n) */
+#define CALL_RECORDER_SNAP_HEADER 6u   /**< EKF_SNAP 레코드 헤더 (index, offset) */
+
+/**
+ * @brief 이어지는 인자 조각 표시 (call 바이트 최상위 비트)
+ */
+#define CALL_RECORDER_CONTINUED 0x80u
+
+/**
+ * @brief 스냅샷 배치 레코드 표시 (offset 자리)
+ */
+#define CALL_RECORDER_SNAP_LAYOUT 0xFFFFu
+
+/**
+ * @brief 기본 설정
+ */
+#define CALL_RECORDER_DEFAULT_CHECK_INTERVAL 100u  /**< 검사값 간격 (호출 수, 0이면 남기지 않음) */
+#define CALL_RECORDER_DEFAULT_SNAPSHOT_ON_ENGINE true /**< ekf_set_engine 직전 스냅샷 */
+
+/**
+ * @brief 시각 콜백 (us, 예: timebase_now_us)
+ */
+typedef uint32_t (*CallRecorderClockFn)(void);
+
+/**
+ * @brief 기록기 설정
+ */
+typedef struct {
+    uint32_t check_interval;   /**< 검사값 간격 (호출 수, 0이면 남기지 않음) */
+    bool snapshot_on_engine;   /**< ekf_set_engine 직전 스냅샷 */
+} CallRecorderConfig;
+
+/**
+ * @brief 기록기 통계
+ */
+typedef struct {
+    uint32_t calls;            /**< 기록한 호출 수 (잃은 호출 포함) */
+    uint32_t records;          /**< 쓴 레코드 수 */
+    uint32_t dropped;          /**< 기록이 받지 않은 레코드 수 */
+    uint32_t lost_calls;       /**< 레코드를 잃은 호출 수 */
+    uint32_t checks;           /**< 남긴 검사값 수 */
+    uint32_t snapshots;        /**< 끝까지 남긴 스냅샷 수 */
+    uint32_t max_args;         /**< 가장 긴 호출 인자 (바이트) */
+} CallRecorderStats;
+
+/**
+ * @brief 호출 기록기
+ */
+typedef struct {
+    FlashLog *log;             /**< 비행 기록 */
+    HwCrc *crc;                /**< 검사값 CRC 주변장치 (NULL이면 소프트웨어) */
+    CallRecorderClockFn clock; /**< 시각 콜백 (NULL이면 0) */
+    CallRecorderConfig config; /**< 설정 */
+
+    EKF *ekf;                  /**< 기록 중인 EKF (NULL이면 멈춤) */
+    EKF_DelayBuffer *history;  /**< 함께 스냅샷할 지연 이력 (NULL 가능) */
+    uint32_t index;            /**< 다음 호출 번호 */
+    uint32_t since_check;      /**< 마지막 검사값 이후 호출 수 */
+    bool resync;               /**< 다음 호출 전에 스냅샷을 다시 남겨야 함 */
+
+    CallRecorderStats stats;   /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} CallRecorder;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool call_recorder_default_config(CallRecorderConfig *config);
+
+/**
+ * @brief 기록기 초기화
+ *
+ * @param rec 구조체 포인터
+ * @param log 비행 기록
+ * @param crc 검사값 CRC 주변장치 (NULL이면 소프트웨어)
+ * @param clock 시각 콜백 (NULL이면 시각 0)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool call_recorder_init(CallRecorder *rec, FlashLog *log, HwCrc *crc, CallRecorderClockFn clock,
+                        const CallRecorderConfig *config);
+
+/**
+ * @brief 기록 시작 (스냅샷을 남기고 EKF 호출 관찰 콜백을 건다)
+ *
+ * 스냅샷을 다 남기지 못하면 다음 호출 전에 다시 시도한다.
+ *
+ * @param rec 구조체 포인터
+ * @param ekf 설정을 마친 EKF
+ * @param history 같이 쓰는 지연 이력 (지연 융합을 쓰지 않으면 NULL)
+ * @return bool 성공 여부 (스냅샷을 다 남겼으면 true)
+ */
+bool call_recorder_start(CallRecorder *rec, EKF *ekf, EKF_DelayBuffer *history);
+
+/**
+ * @brief 기록 멈춤 (관찰 콜백 해제)
+ *
+ * @param rec 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool call_recorder_stop(CallRecorder *rec);
+
+/**
+ * @brief 지금 상태로 스냅샷 남기기 (공개 호출 밖에서 EKF 상태를 직접 고친 뒤)
+ *
+ * @param rec 구조체 포인터
+ * @return bool 성공 여부 (실패하면 다음 호출 전에 다시 시도)
+ */
+bool call_recorder_snapshot(CallRecorder *rec);
+
+/**
+ * @brief 통계
+ *
+ * @param rec 구조체 포인터
+ * @return const CallRecorderStats* 통계 (rec이 NULL이면 NULL)
+ */
+const CallRecorderStats *call_recorder_get_stats(const CallRecorder *rec);
+
+#endif /* CALL_RECORDER_H */
@@ -0,0 +1,133 @@
+/**
+ * @file cov_log.h
+ * @brief 공분산 스냅샷 압축 기록 (표준 편차 로그 눈금 + 양자화 상관 계수, 솎은 주기)
+ *
+ * P 전체(16 x 16 float, 1 KB)를 매 사이클 기록할 수는 없으므로 지금까지 기록에는 불확실성이
+ * 없었다. 이 모듈은 period_us마다 한 번 EKF 공분산을 FLASH_LOG_REC_COV 레코드 하나로 줄여 기록한다.
+ * - 표준 편차: int16 log2 눈금, 코드 = round(256 log2 σ) = round(128 log2 P_ii). 간격 1/256 옥타브
+ *   (상대 오차 0.14% 이하)로 float 전 범위를 덮으므로 상태마다 단위가 달라도 눈금을 정할 필요가 없다.
+ *   P_ii가 양수가 아니거나 유한하지 않으면 COV_LOG_STD_INVALID.
+ * - 상관 계수: ρ_ij = P_ij / (σ_i σ_j)를 [-1, 1]로 제한한 int8, 코드 = round(127 ρ)
+ *   (간격 0.0079). 위 삼각(i < j) 행 순서. 어느 한쪽 표준 편차가 무효이면 0.
+ * 재구성: P_ij = ρ_ij σ_i σ_j, 대각은 σ_i^2.
+ *
+ * 페이로드 (리틀 엔디언):
+ * @verbatim
+ *   t_us(u32) | n(u8) | std_code[n](i16) | corr_code[n(n-1)/2](i8)
+ * @endverbatim
+ * 16 상태이면 157바이트로 P 전체의 약 15%, 위 삼각 float(544바이트)의 약 29%이다. 10 Hz이면
+ * 약 1.6 KB/s. 호스트 복원기(Tools/log/log_decode.c)는 cov 행으로 σ와 ρ를 출력한다.
+ *
+ * 지연 공분산 전파 중에는 마지막으로 전파한 P를 기록한다 (ekf_get_nav_solution의 p_diag와 같음).
+ * 기록 작성자 문맥(융합 태스크) 한 곳에서만 호출해야 한다.
+ */
+
+#ifndef COV_LOG_H
+#define COV_LOG_H
+
+#include "log/flash_log.h"
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 레코드 페이로드 길이 (n 상태)
+ */
+#define COV_LOG_SIZE(n) (4u + 1u + 2u * (n) + (n) * ((n) - 1u) / 2u)
+
+/**
+ * @brief 최대 차원 (레코드 하나에 들어가는 크기)
+ */
+#define COV_LOG_MAX_DIM 20u
+
+_Static_assert(COV_LOG_SIZE(COV_LOG_MAX_DIM) <= FLASH_LOG_MAX_PAYLOAD, "COV_LOG_MAX_DIM does not fit in one record");
+_Static_assert(EKF_STATE_DIM <= COV_LOG_MAX_DIM, "EKF_STATE_DIM exceeds COV_LOG_MAX_DIM");
+
+/**
+ * @brief 부호화 눈금
+ */
+#define COV_LOG_STD_SCALE 256.0f        /**< 표준 편차 코드 / log2 σ */
+#define COV_LOG_CORR_SCALE 127.0f       /**< 상관 계수 코드 / ρ */
+#define COV_LOG_STD_INVALID INT16_MIN   /**< 분산이 양수가 아니거나 유한하지 않음 */
+
+/**
+ * @brief 기본 설정
+ */
+#define COV_LOG_DEFAULT_PERIOD_US 100000u  /**< 기록 간격 (us, 10 Hz) */
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t period_us;        /**< 기록 간격 (us, 0이면 호출마다) */
+} CovLogConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t written;          /**< 기록한 스냅샷 수 */
+    uint32_t dropped;          /**< 기록기가 받지 않은 스냅샷 수 (다음 호출에서 다시) */
+    uint32_t invalid_std;      /**< 무효로 기록한 표준 편차 수 (누적) */
+} CovLogStats;
+
+/**
+ * @brief 공분산 스냅샷 기록기
+ */
+typedef struct {
+    CovLogConfig config;       /**< 설정 */
+    uint32_t next_us;          /**< 다음 기록 시각 (us) */
+    bool started;              /**< 첫 스냅샷을 기록했는지 */
+    CovLogStats stats;         /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} CovLog;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool cov_log_default_config(CovLogConfig *config);
+
+/**
+ * @brief 초기화
+ *
+ * @param cl 구조체 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool cov_log_init(CovLog *cl, const CovLogConfig *config);
+
+/**
+ * @brief 스냅샷 부호화
+ *
+ * @param timestamp_us 시각 (us)
+ * @param n 차원 (1..COV_LOG_MAX_DIM)
+ * @param P 위 삼각 행 순서로 압축한 대칭 행렬 (n(n+1)/2개, EKF_StateCovariance와 같은 배치)
+ * @param payload 페이로드 (COV_LOG_SIZE(n) 바이트 이상)
+ * @param invalid 무효 표준 편차 수 (NULL 가능)
+ * @return uint8_t 페이로드 길이 (실패하면 0)
+ */
+uint8_t cov_log_encode(uint32_t timestamp_us, uint8_t n, const float *P, uint8_t *payload, uint8_t *invalid);
+
+/**
+ * @brief 간격이 되었으면 EKF 공분산 스냅샷 기록
+ *
+ * @param cl 구조체 포인터
+ * @param log 비행 기록
+ * @param ekf 항법 필터
+ * @param timestamp_us 현재 시각 (us)
+ * @return bool 이번 호출에서 기록했으면 true
+ */
+bool cov_log_write(CovLog *cl, FlashLog *log, const EKF *ekf, uint32_t timestamp_us);
+
+/**
+ * @brief 통계
+ *
+ * @param cl 구조체 포인터
+ * @return const CovLogStats* 통계 (NULL이면 NULL)
+ */
+const CovLogStats *cov_log_get_stats(const CovLog *cl);
+
+#endif /* COV_LOG_H */
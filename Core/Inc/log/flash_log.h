@@ -0,0 +1,648 @@
+/**
+ * @file flash_log.h
+ * @brief 비행 기록기 (섹터 정렬 이중 버퍼, DMA 기록, 발사대 대기 중 사전 지우기, NOR/SD 저장소)
+ *
+ * 기록은 융합 태스크가 활성 버퍼에 레코드를 복사하는 것으로 끝난다. 버퍼가 차면
+ * 다른 버퍼로 바꾸고, 찬 버퍼는 기록 엔진이 페이지 단위 DMA 쓰기(qspi_nor)로
+ * 플래시에 옮긴다. 엔진은 QUADSPI 완료 인터럽트에서 다음 페이지를 이어서 시작하므로
+ * 기록 중 CPU가 기다리는 일이 없다. 두 버퍼가 모두 차 있으면 새 레코드를 버리고
+ * dropped를 센다 (융합 루프는 절대 기다리지 않음).
+ *
+ * 버퍼 하나는 플래시 섹터 하나(4 KB)이며 블록 헤더(FlashLogBlockHeader)로 시작한다.
+ * 레코드는 {종류, 페이로드 길이, 페이로드} 이고 블록 경계를 넘지 않는다. 블록의
+ * 남은 부분은 지워진 값(0xFF)으로 두며, 종류 0xFF는 블록 끝을 뜻한다.
+ *
+ * 블록 헤더의 CRC-32(zlib 호환)는 헤더의 seq부터 블록 끝까지(FLASH_LOG_CRC_OFFSET..)를
+ * 덮는다. 기록 엔진이 블록을 쓰기 직전에 CRC 주변장치 DMA(sys/hw_crc.h)로 계산하며,
+ * 주변장치가 없거나 사용 중이면 소프트웨어로 계산한다. 블록 순번(seq)은 세션 안에서
+ * 1씩 늘어나므로 호스트는 헤더만 보고 빠진 블록을 알 수 있다.
+ *
+ * 플래시 쓰기 전에는 해당 섹터가 지워져 있어야 한다. 블록 지우기(64 KB)는 수백 ms가
+ * 걸리므로 발사대 대기 중 flash_log_pre_erase로 비행 기록 분량을 미리 지워 둔다.
+ * 지워진 영역을 다 쓰면 엔진이 섹터 지우기를 끼워 넣지만, 그동안 버퍼가 밀리면
+ * 레코드가 버려질 수 있다.
+ *
+ * 배경 지우기 (flash_log_set_erase_reserve, flash_log_set_erase_gate): 비행 중에도 기록 위치 앞에
+ * 지워 둔 예비 영역을 유지하도록 블록을 쓸 때마다 사전 지우기 목표를 밀어 올린다. 배경 지우기는
+ * 기록 대기 블록이 없고, 부하 감시기(nav/fusion_monitor.h)의 마지막 사이클 부하율이 한계 이하일
+ * 때만 시작한다. 배경 지우기 중에 데이터 블록이 차면 flash_log_service가 지우기를 일시 중지하고
+ * (장치가 지원할 때, qspi_nor_erase_suspend) 블록을 먼저 쓴 뒤 재개하므로, 예비 영역이 남아 있는
+ * 한 블록 기록은 지우기를 기다리지 않는다 (기다린 횟수는 erase_stalls).
+ *
+ * 1 kHz IMU(30 B) + 100 Hz 항법 해(약 150 B)는 약 45 KB/s로, 4 KB 버퍼가 90 ms마다
+ * 차고 한 섹터 기록(16 페이지)은 약 10 ms 걸린다.
+ *
+ * 저장소는 QUADSPI NOR(flash_log_init) 또는 SD 카드의 미리 할당된 연속 파일
+ * (flash_log_init_sd, log/sd_file.h)이다. 블록 형식과 버퍼링은 같고, SD에서는 블록 하나를
+ * 8블록 다중 쓰기 DMA 한 번으로 보낸다. 파일 시스템은 초기화 때 파일 위치를 찾을 때만
+ * 쓰므로 FAT/디렉터리 갱신으로 인한 수백 ms 지연이 없다. SD는 쓰기 전에 지울 필요가
+ * 없으며, 사전 지우기는 카드 내부 지우기 지연을 줄이는 용도로만 쓴다. 카드 자체의
+ * 기록 지연(수십 ms)은 이중 버퍼가 흡수하고, 그보다 길면 dropped로 센다.
+ *
+ * 연결 예 (NOR, CubeMX: QUADSPI 간접 모드, TX DMA, QUADSPI 전역 인터럽트 활성화):
+ * - HAL_QSPI_TxCpltCallback: flash_log_handle_tx_complete(&log)
+ * - HAL_QSPI_StatusMatchCallback: flash_log_handle_status_match(&log)
+ * - HAL_QSPI_ErrorCallback: flash_log_handle_error(&log)
+ * - 주 루프 또는 저우선순위 태스크: flash_log_service(&log)
+ *
+ * 연결 예 (SD, log/sd_card.h):
+ * - HAL_SD_TxCpltCallback: flash_log_handle_tx_complete(&log)
+ * - HAL_SD_ErrorCallback: flash_log_handle_error(&log)
+ * - 주 루프 또는 저우선순위 태스크: flash_log_service(&log) (카드 기록 완료를 CMD13으로 확인)
+ *
+ * 블록 압축 (선택, NOR, flash_log_set_compression): 작성자가 봉인한 블록을 flash_log_service
+ * 문맥(기록 태스크)이 LZ4 형식(log/log_lz.h)으로 압축한 뒤 엔진에 넘긴다. 압축 블록과 압축해도
+ * 페이지가 줄지 않아 원본 그대로 둔 블록은 섹터가 아니라 페이지 단위로 이어 붙여 저장하므로
+ * (FLASH_LOG_LZ_MAGIC, FLASH_LOG_PACKED_MAGIC) 같은 칩에 더 긴 비행이 들어가고 블록당 페이지
+ * 쓰기 수도 준다. 블록 CRC는 압축 전 블록(FLASH_LOG_MAGIC 형식)에 대해 계산하며,
+ * flash_log_read_block은 원래 블록으로 풀어 주므로 내려받기와 호스트 도구는 그대로 쓴다.
+ * 블록 번호는 저장 순서이며 압축 블록이 있으면 헤더를 따라가 위치를 찾는다 (순차 읽기는 O(1)).
+ *
+ * 기록 색인 (선택, flash_log_set_index):
+ * - 초기화 직후: flash_log_set_index(&log, 64, 0)
+ * - 작성자 사이클마다: flash_log_index_time(&log, 샘플 시각)
+ * - 비행 이벤트/단계 변경 때: flash_log_index_event, flash_log_index_phase
+ *
+ * 기록 정책 (선택, flash_log_set_filter, log/log_policy.h): 레코드를 버퍼에 넣기 전에 거르는 콜백이다.
+ * 비행 단계/스트림별 기록 주기, 변화 시 기록, 이벤트 전후 전체 주기 보관을 log_policy가 이 콜백으로
+ * 적용하므로 flash_log_imu 등을 부르는 쪽은 바꿀 필요가 없다.
+ *
+ * 기록을 멈춘 뒤 탑재 복호기(텔레메트리 따라잡기, 착지 후 비컨 요약)는 NOR 블록을
+ * flash_log_map_block으로 메모리 매핑해 복사 없이 읽고, flash_log_next_record로 레코드를
+ * 차례로 훑는다. 엔진이 다시 쓰기를 시작하면 QUADSPI가 간접 모드로 돌아가 매핑 포인터는
+ * 무효가 되므로, 매핑 읽기와 기록 재개는 같은 문맥에서 해야 한다.
+ *
+ * 블록/레코드 형식 상수와 레코드 구조체는 호스트 도구와 함께 쓰는 log/log_format.h에 있다.
+ *
+ * 레코드 쓰기(flash_log_write, flash_log_index_* 등)는 한 문맥(융합 태스크)에서만 호출해야 한다.
+ */
+
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include "log/log_format.h"
+#include "log/qspi_nor.h"
+#include "log/sd_card.h"
+#include "log/sd_file.h"
+#include "sys/hw_crc.h"
+#include "log/log_lz.h"
+#include "sensors/imu_ring.h"
+#include "sensors/ubx_gnss.h"
+#include "ekf/ekf.h"
+#include "nav/convergence_monitor.h"
+#include "nav/fusion_monitor.h"
+#include "nav/flight_phase.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 버퍼(블록) 크기 (바이트, 플래시 섹터 크기)
+ */
+#define FLASH_LOG_BUFFER_SIZE QSPI_NOR_SECTOR_SIZE
+
+_Static_assert(FLASH_LOG_BUFFER_SIZE == FLASH_LOG_BLOCK_SIZE && QSPI_NOR_PAGE_SIZE == FLASH_LOG_PAGE_SIZE,
+               "log_format.h block/page size does not match the NOR geometry");
+
+/**
+ * @brief 배경 지우기 기본값
+ */
+#define FLASH_LOG_DEFAULT_ERASE_RESERVE (64u * 1024u)  /**< 예비 지움 영역 (바이트, 45 KB/s에서 약 1.4 s) */
+#define FLASH_LOG_DEFAULT_ERASE_MAX_LOAD 700u          /**< 배경 지우기를 시작할 최대 부하율 (0.1% 단위) */
+
+/**
+ * @brief 기본 시각 색인 간격 (데이터 블록 수, 약 0.7 s)
+ */
+#define FLASH_LOG_DEFAULT_INDEX_INTERVAL 8u
+
+/**
+ * @brief 블록 버퍼 수 (데이터 이중 버퍼 + 색인 블록)
+ */
+#define FLASH_LOG_BUFFER_COUNT 3u
+
+/**
+ * @brief 색인 블록 기록 중에 받아 둘 수 있는 항목 수
+ */
+#define FLASH_LOG_INDEX_QUEUE 8u
+
+/**
+ * @brief 수렴/준비 레코드 (36바이트, 수렴 상태가 바뀔 때)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 항법 해 시각 (us) */
+    uint32_t ready_us;         /**< 첫 준비까지 경과 시간 (us, 없으면 CONVERGENCE_NEVER) */
+    uint32_t converged_us[CONVERGENCE_BLOCK_COUNT]; /**< 블록별 첫 수렴까지 경과 시간 (us) */
+    uint8_t converged;         /**< 수렴 블록 (ConvergenceBlock 비트) */
+    uint8_t ready;             /**< 준비 여부 */
+    uint8_t reserved[2];       /**< 예약 (0) */
+} FlashLogReadyRecord;
+
+_Static_assert(sizeof(EKF_NavSolution) <= FLASH_LOG_MAX_PAYLOAD, "EKF_NavSolution does not fit a log record");
+
+/**
+ * @brief 레코드 거르기 콜백 (flash_log_write 안에서 작성자 문맥으로 호출)
+ *
+ * @param context 설정 시 넘긴 포인터
+ * @param type 레코드 종류
+ * @param payload 페이로드
+ * @param len 페이로드 길이
+ * @return bool 지금 기록하면 true (false이면 버퍼에 넣지 않고 성공으로 처리)
+ */
+typedef bool (*FlashLogFilterFn)(void *context, uint8_t type, const void *payload, uint8_t len);
+
+/**
+ * @brief 버퍼 상태
+ */
+typedef enum {
+    FLASH_LOG_BUFFER_FREE = 0, /**< 비어 있음 또는 채우는 중 */
+    FLASH_LOG_BUFFER_FULL,     /**< 기록 대기 */
+    FLASH_LOG_BUFFER_FLUSHING, /**< 기록 중 */
+    FLASH_LOG_BUFFER_SEALED    /**< 압축 대기 (압축 모드, flash_log_service가 FULL로 넘김) */
+} FlashLogBufferState;
+
+/**
+ * @brief 블록 압축 작업 공간 (압축 모드에서만, 약 6 KB)
+ */
+typedef struct {
+    uint8_t out[FLASH_LOG_BUFFER_SIZE];   /**< 압축 출력 */
+    uint16_t table[LOG_LZ_HASH_SIZE];     /**< 일치 찾기 해시 표 */
+} FlashLogPackWork;
+
+/**
+ * @brief 저장소 종류
+ */
+typedef enum {
+    FLASH_LOG_BACKEND_NOR = 0, /**< QUADSPI NOR 플래시 (페이지 쓰기, 지운 뒤 쓰기) */
+    FLASH_LOG_BACKEND_SD       /**< SD 카드 연속 파일 (블록당 다중 블록 쓰기 1회) */
+} FlashLogBackend;
+
+/**
+ * @brief 기록 엔진 작업
+ */
+typedef enum {
+    FLASH_LOG_OP_NONE = 0,     /**< 유휴 */
+    FLASH_LOG_OP_CRC,          /**< 블록 CRC DMA 계산 중 */
+    FLASH_LOG_OP_ERASE,        /**< 지우기 완료 대기 */
+    FLASH_LOG_OP_PROGRAM_DATA, /**< 페이지(SD는 블록) 데이터 DMA 전송 중 */
+    FLASH_LOG_OP_PROGRAM_WAIT  /**< 페이지(SD는 블록) 쓰기 완료 대기 */
+} FlashLogOp;
+
+/**
+ * @brief 비행 기록기
+ */
+typedef struct {
+    FlashLogBackend backend;   /**< 저장소 종류 */
+    QspiNor *nor;              /**< NOR 플래시 장치 (NOR 저장소) */
+    SdCard *sd;                /**< SD 카드 (SD 저장소) */
+    uint32_t sd_first_lba;     /**< 기록 파일 시작 블록 (SD 저장소, 주소는 파일 안 바이트 위치) */
+    HwCrc *crc;                /**< 블록 CRC 주변장치 (NULL이면 소프트웨어) */
+    FlashLogPackWork *pack;    /**< 블록 압축 작업 공간 (NULL이면 압축 안 함) */
+    FlashLogFilterFn filter;   /**< 레코드 거르기 콜백 (NULL이면 모두 기록) */
+    void *filter_context;      /**< 거르기 콜백 인자 */
+
+    uint8_t buffer[FLASH_LOG_BUFFER_COUNT][FLASH_LOG_BUFFER_SIZE] __attribute__((aligned(8))); /**< 블록 이중 버퍼 + 색인 블록 */
+    atomic_uint_fast8_t buffer_state[FLASH_LOG_BUFFER_COUNT]; /**< 버퍼 상태 (FlashLogBufferState) */
+
+    // 작성자 (융합 태스크)
+    uint8_t active;            /**< 채우는 버퍼 */
+    uint16_t fill;             /**< 활성 버퍼 사용 바이트 */
+    uint32_t block_seq;        /**< 다음 블록 순번 */
+    uint16_t session;          /**< 기록 세션 번호 */
+    uint32_t dropped;          /**< 버퍼가 밀려 버린 레코드 수 */
+    uint32_t session_block;    /**< 이번 세션 첫 블록 번호 (기록 영역 시작 기준) */
+
+    // 색인 (작성자가 채우고 엔진이 색인 영역에 기록)
+    uint16_t index_fill;       /**< 색인 블록 사용 바이트 */
+    uint32_t index_seq;        /**< 다음 색인 블록 순번 */
+    uint32_t index_interval;   /**< 시각 색인 간격 (데이터 블록) */
+    uint32_t index_last_seq;   /**< 마지막 시각 색인의 블록 순번 */
+    uint32_t index_start;      /**< 색인 영역 시작 */
+    uint32_t index_addr;       /**< 다음 색인 블록 기록 주소 */
+    uint32_t index_end;        /**< 색인 영역 끝 (0이면 색인 없음) */
+    FlashLogIndexEntry index_queue[FLASH_LOG_INDEX_QUEUE]; /**< 색인 블록 기록 중 받은 항목 */
+    uint8_t index_queued;      /**< 대기 항목 수 */
+    uint32_t index_dropped;    /**< 버린 색인 항목/블록 수 */
+
+    // 기록 엔진 (엔진 소유권을 얻은 문맥 또는 QUADSPI 인터럽트)
+    atomic_flag engine_busy;   /**< 엔진 소유권 */
+    FlashLogOp op;             /**< 진행 중인 작업 */
+    int8_t flushing;           /**< 기록 중인 버퍼 (-1이면 없음) */
+    uint16_t page;             /**< 기록 중인 페이지 (SD는 0 또는 1) */
+    uint32_t write_addr;       /**< 다음 블록 기록 주소 */
+    uint32_t erase_addr;       /**< 지워진 영역 끝 (write_addr..erase_addr 지워짐) */
+    uint32_t erase_pending;    /**< 진행 중인 지우기 영역 끝 */
+    uint32_t erase_target;     /**< 사전 지우기 목표 끝 */
+    uint32_t start_addr;       /**< 기록 영역 시작 (SD 저장소는 0) */
+    uint32_t end_addr;         /**< 기록 영역 끝 */
+    uint32_t erase_reserve;    /**< 기록 위치 앞에 지워 둘 바이트 (0이면 사전 지우기 목표만) */
+    const FusionMonitor *load; /**< 배경 지우기 부하 조건 (NULL이면 조건 없음) */
+    uint16_t erase_max_load;   /**< 배경 지우기를 시작할 최대 부하율 (0.1% 단위) */
+    bool erase_suspended;      /**< 배경 지우기 일시 중지 중 (데이터 블록 먼저 기록) */
+    uint32_t stored_blocks;    /**< 저장된 블록 수 (이전 세션 포함) */
+
+    // 읽기 위치 (압축 블록이 있으면 헤더를 따라가 블록 주소를 찾음)
+    bool packed;               /**< 페이지 단위로 이어 붙인 블록이 있음 */
+    uint32_t seek_block;       /**< 마지막으로 찾은 블록 번호 */
+    uint32_t seek_addr;        /**< 그 블록의 주소 */
+
+    uint32_t blocks_written;   /**< 기록 완료 블록 수 */
+    uint32_t packed_blocks;    /**< 압축해 저장한 블록 수 */
+    uint32_t pack_raw_bytes;   /**< 압축 모드 블록의 원본 사용 바이트 합 */
+    uint32_t pack_stored_bytes; /**< 압축 모드 블록의 저장 바이트 합 (페이지 올림) */
+    uint32_t erase_suspends;   /**< 배경 지우기 일시 중지 수 */
+    uint32_t erase_stalls;     /**< 데이터 블록 기록이 지우기를 기다린 수 */
+    uint32_t flash_errors;     /**< QUADSPI/SDMMC 오류 수 */
+    bool full;                 /**< 기록 영역을 다 씀 */
+    bool initialized;          /**< 초기화 여부 */
+} FlashLog;
+
+/**
+ * @brief 기록기 초기화 (블로킹, 비행 전)
+ *
+ * 기록 영역의 섹터 헤더를 읽어 이전 기록의 끝을 찾고 그 다음 섹터부터 새 세션을 시작한다.
+ * 새 세션 번호는 마지막 블록의 세션 번호 + 1이다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param nor 초기화된 NOR 플래시 장치
+ * @param start_addr 기록 영역 시작 주소 (섹터 정렬)
+ * @param end_addr 기록 영역 끝 주소 (섹터 정렬, 장치 용량 이하, 0이면 장치 끝)
+ * @return bool 성공 여부
+ */
+bool flash_log_init(FlashLog *log, QspiNor *nor, uint32_t start_addr, uint32_t end_addr);
+
+/**
+ * @brief SD 카드 기록기 초기화 (블로킹, 비행 전)
+ *
+ * 미리 할당된 연속 파일(sd_file_find)을 기록 영역으로 쓴다. 파일은 앞에서부터 순서대로
+ * 채워지므로 블록 헤더를 이분 탐색하여 이전 기록의 끝을 찾는다 (파일은 0으로 채워 만듦).
+ *
+ * @param log 기록기 구조체 포인터
+ * @param sd 초기화된 SD 카드
+ * @param file 기록 파일 위치 (4 KB 단위로 내림하여 사용)
+ * @return bool 성공 여부
+ */
+bool flash_log_init_sd(FlashLog *log, SdCard *sd, const SdFile *file);
+
+/**
+ * @brief 블록 CRC 주변장치 설정 (기록 시작 전)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param crc 초기화된 CRC 주변장치 (DMA 포함 권장, NULL이면 소프트웨어 계산)
+ * @return bool 성공 여부
+ */
+bool flash_log_set_crc(FlashLog *log, HwCrc *crc);
+
+/**
+ * @brief 사전 지우기 목표 설정 (발사대 대기 중)
+ *
+ * 현재 기록 위치부터 bytes만큼을 flash_log_service가 엔진 유휴 때마다 섹터 단위로 지운다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param bytes 지울 분량 (바이트, 기록 영역 끝으로 제한)
+ * @return bool 성공 여부
+ */
+bool flash_log_pre_erase(FlashLog *log, uint32_t bytes);
+
+/**
+ * @brief 사전 지우기 완료 여부
+ *
+ * @param log 기록기 구조체 포인터
+ * @return bool 목표까지 지워졌으면 true
+ */
+bool flash_log_pre_erase_done(const FlashLog *log);
+
+/**
+ * @brief 예비 지움 영역 설정 (기록 위치 앞에 항상 지워 둘 양)
+ *
+ * 블록 기록이 끝날 때마다 사전 지우기 목표를 기록 위치 + bytes(섹터 올림, 기록 영역 끝 제한)로
+ * 올린다. 지우기는 flash_log_pre_erase와 같이 엔진 유휴 때 섹터 단위로 한다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param bytes 예비 영역 (바이트, 0이면 끔, 예: FLASH_LOG_DEFAULT_ERASE_RESERVE)
+ * @return bool 성공 여부
+ */
+bool flash_log_set_erase_reserve(FlashLog *log, uint32_t bytes);
+
+/**
+ * @brief 배경 지우기 부하 조건 설정
+ *
+ * 사전/예비 지우기는 감시기의 마지막 사이클 부하율(last_load)이 max_load 이하일 때만 시작한다.
+ * 기록할 블록이 쓸 섹터를 지우는 것은 조건과 관계없이 한다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param load 융합 루프 감시기 (NULL이면 조건 없음)
+ * @param max_load 최대 부하율 (0.1% 단위, 0이면 FLASH_LOG_DEFAULT_ERASE_MAX_LOAD)
+ * @return bool 성공 여부
+ */
+bool flash_log_set_erase_gate(FlashLog *log, const FusionMonitor *load, uint16_t max_load);
+
+/**
+ * @brief 블록 압축 설정 (NOR 저장소, 엔진 유휴일 때)
+ *
+ * 설정하면 봉인된 블록을 flash_log_service가 압축한다 (80 MHz에서 블록당 1 ms 안쪽, 융합 태스크가 아닌
+ * 기록 태스크 문맥). 압축해 한 페이지 이상 줄어들 때만 압축 블록으로, 아니면 원본을 그대로
+ * 페이지 단위로 이어 붙여 저장한다. 압축 모드에서는 flash_log_service를 블록 주기(약 90 ms)보다
+ * 자주 불러야 버퍼가 밀리지 않는다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param work 작업 공간 (기록하는 동안 유지, NULL이면 압축 끔)
+ * @return bool 성공 여부 (SD 저장소이거나 엔진 사용 중이면 false)
+ */
+bool flash_log_set_compression(FlashLog *log, FlashLogPackWork *work);
+
+/**
+ * @brief 레코드 거르기 콜백 설정 (작성자 문맥)
+ *
+ * 콜백 안에서 flash_log_write를 다시 부를 수 있다 (이때도 콜백을 거치므로 콜백이 걸러야 함).
+ *
+ * @param log 기록기 구조체 포인터
+ * @param filter 거르기 콜백 (NULL이면 해제)
+ * @param context 콜백 인자
+ * @return bool 성공 여부
+ */
+bool flash_log_set_filter(FlashLog *log, FlashLogFilterFn filter, void *context);
+
+/**
+ * @brief 색인 영역 설정 (초기화 직후, 사전 지우기/기록 전)
+ *
+ * 기록 영역 끝의 index_blocks 블록을 색인 영역으로 떼어 낸다. 색인은 시각 -> 데이터 블록
+ * 항목(interval_blocks마다), 비행 이벤트, 비행 단계 변경을 담아 내려받기/재생이 원하는 시간
+ * 구간의 블록만 읽게 한다. 데이터 블록은 블록마다 압축 스트림을 새로 시작하므로 모든 블록
+ * 시작이 키프레임 위치이다. 항목은 RAM 색인 블록에 모였다가 블록이 차거나, 이벤트가 들어오거나,
+ * flash_log_sync 때 색인 영역에 기록된다. 색인 블록은 데이터 블록과 같은 헤더 형식(magic만
+ * FLASH_LOG_INDEX_MAGIC)이다. 이전 세션의 색인 뒤에 이어 쓰며 영역이 차면 색인만 멈춘다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param index_blocks 색인 영역 블록 수 (64이면 색인 항목 약 1.6만 개)
+ * @param interval_blocks 시각 색인 간격 (데이터 블록 수, 0이면 FLASH_LOG_DEFAULT_INDEX_INTERVAL)
+ * @return bool 성공 여부 (이전 기록이 색인 영역까지 들어가 있으면 false)
+ */
+bool flash_log_set_index(FlashLog *log, uint32_t index_blocks, uint32_t interval_blocks);
+
+/**
+ * @brief 시각 색인 (작성자 전용, 사이클마다 호출해도 간격마다 한 항목만 추가)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param timestamp_us 지금 쓰는 레코드 시각 (us)
+ * @return bool 색인이 있고 항목을 버리지 않았으면 true
+ */
+bool flash_log_index_time(FlashLog *log, uint32_t timestamp_us);
+
+/**
+ * @brief 비행 이벤트 색인 (작성자 전용, 색인 블록을 바로 기록 대기로 넘김)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param event 비행 이벤트
+ * @return bool 성공 여부
+ */
+bool flash_log_index_event(FlashLog *log, const FlightEvent *event);
+
+/**
+ * @brief 비행 단계 변경 색인 (작성자 전용)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param phase 새 비행 단계
+ * @param timestamp_us 변경 시각 (us)
+ * @return bool 성공 여부
+ */
+bool flash_log_index_phase(FlashLog *log, FlightPhase phase, uint32_t timestamp_us);
+
+/**
+ * @brief 레코드 쓰기 (작성자 전용, 기다리지 않음)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param type 레코드 종류 (FlashLogRecordType, 0xFF 제외)
+ * @param payload 페이로드
+ * @param len 페이로드 길이 (FLASH_LOG_MAX_PAYLOAD 이하)
+ * @return bool 버퍼에 넣었거나 거르기 콜백이 걸렀으면 true (두 버퍼가 모두 밀려 있거나 영역을 다 썼으면 false)
+ */
+bool flash_log_write(FlashLog *log, uint8_t type, const void *payload, uint8_t len);
+
+/**
+ * @brief 현재 블록에 레코드들이 들어가는지 (작성자 전용)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param bytes 레코드 헤더를 포함한 총 길이 (바이트)
+ * @return bool 블록을 바꾸지 않고 들어가면 true
+ */
+bool flash_log_fits(const FlashLog *log, uint16_t bytes);
+
+/**
+ * @brief 채우는 블록의 순번 (작성자 전용, 블록이 바뀌었는지 판단용)
+ *
+ * @param log 기록기 구조체 포인터
+ * @return uint32_t 현재 채우는 블록이 마감될 때 받을 순번
+ */
+uint32_t flash_log_block(const FlashLog *log);
+
+/**
+ * @brief IMU 샘플 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param sample IMU 샘플
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool flash_log_imu(FlashLog *log, const ImuSample *sample);
+
+/**
+ * @brief 기압 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param pressure_pa 기압 (Pa)
+ * @param temp_c 센서 온도 (°C)
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool flash_log_baro(FlashLog *log, uint32_t timestamp_us, float pressure_pa, float temp_c);
+
+/**
+ * @brief 자기장 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param field 자기장 (uT, 센서 좌표계)
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool flash_log_mag(FlashLog *log, uint32_t timestamp_us, Vector3f field);
+
+/**
+ * @brief GNSS 해 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param fix GNSS 해
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool flash_log_gnss(FlashLog *log, const UbxGnssFix *fix);
+
+/**
+ * @brief 항법 해 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param sol 항법 해 스냅샷
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool flash_log_nav(FlashLog *log, const EKF_NavSolution *sol);
+
+/**
+ * @brief 수렴/준비 상태 기록 (convergence_monitor_update가 0이 아닌 값을 돌려준 뒤)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param mon 수렴 감시기
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool flash_log_ready(FlashLog *log, const ConvergenceMonitor *mon);
+
+/**
+ * @brief 채우던 버퍼와 색인 블록을 바로 기록 대기로 넘김 (착지 후, 전원 차단 전)
+ *
+ * @param log 기록기 구조체 포인터
+ * @return bool 넘겼거나 넘길 것이 없으면 true (다른 버퍼가 밀려 있으면 false, 다시 호출)
+ */
+bool flash_log_sync(FlashLog *log);
+
+/**
+ * @brief 기록 엔진 진행 (주 루프 등에서 주기 호출, 기다리지 않음)
+ *
+ * 엔진이 유휴이면 기록 대기 버퍼나 사전 지우기를 시작한다. SD 저장소에서는
+ * 쓰기/지우기 후 카드가 준비되었는지 확인하여 다음 작업으로 넘어간다. 압축 모드에서는
+ * 봉인된 블록을 먼저 압축한다 (이 호출 안에서 CPU로, 80 MHz에서 블록당 1 ms 안쪽).
+ * 배경 지우기 중에 데이터 블록이 차 있으면 지우기를 일시 중지하고 블록 기록을 먼저 시작한다.
+ *
+ * @param log 기록기 구조체 포인터
+ */
+void flash_log_service(FlashLog *log);
+
+/**
+ * @brief 기록 엔진 유휴 여부 (기록 대기 버퍼와 진행 중 작업 없음)
+ *
+ * @param log 기록기 구조체 포인터
+ * @return bool 유휴이면 true
+ */
+bool flash_log_idle(const FlashLog *log);
+
+/**
+ * @brief 저장된 블록 수 (기록 영역 시작부터 이번 세션 기록분까지)
+ *
+ * @param log 기록기 구조체 포인터
+ * @return uint32_t 블록 수 (초기화 전이면 0)
+ */
+uint32_t flash_log_block_count(const FlashLog *log);
+
+/**
+ * @brief 저장된 블록 하나 읽기 (블로킹, 비행 후 내려받기용)
+ *
+ * 기록 엔진과 같은 버스를 쓰므로 엔진이 유휴(flash_log_idle)일 때만 읽는다. 압축 블록은
+ * 메모리 매핑으로 읽어 원래 블록(FLASH_LOG_MAGIC, 0xFF 채움)으로 풀어 준다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param block 블록 번호 (기록 영역 시작 기준, flash_log_block_count 미만)
+ * @param data 블록 버퍼 (FLASH_LOG_BUFFER_SIZE 바이트, 4바이트 정렬)
+ * @return bool 성공 여부 (엔진 사용 중이거나 범위 밖이면 false)
+ */
+bool flash_log_read_block(FlashLog *log, uint32_t block, uint8_t *data);
+
+/**
+ * @brief 압축 모드 블록을 원래 블록으로 풀기 (FLASH_LOG_MAGIC 형식, 나머지는 0xFF)
+ *
+ * 원래 블록 CRC는 확인하지 않는다 (호스트 도구가 확인).
+ *
+ * @param stored 저장된 블록 (매핑 포인터 등, 헤더의 used 바이트)
+ * @param data 블록 버퍼 (FLASH_LOG_BUFFER_SIZE 바이트, stored와 겹치면 안 됨)
+ * @return bool 성공 여부 (헤더나 압축 데이터가 깨졌으면 false)
+ */
+bool flash_log_unpack_block(const uint8_t *stored, uint8_t *data);
+
+/**
+ * @brief 저장된 색인 블록 수 (이전 세션 포함)
+ *
+ * @param log 기록기 구조체 포인터
+ * @return uint32_t 색인 블록 수 (색인이 없으면 0)
+ */
+uint32_t flash_log_index_block_count(const FlashLog *log);
+
+/**
+ * @brief 저장된 색인 블록 하나 읽기 (블로킹, flash_log_read_block과 같은 조건)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param block 색인 블록 번호 (flash_log_index_block_count 미만)
+ * @param data 블록 버퍼 (FLASH_LOG_BUFFER_SIZE 바이트, 4바이트 정렬)
+ * @return bool 성공 여부
+ */
+bool flash_log_read_index_block(FlashLog *log, uint32_t block, uint8_t *data);
+
+/**
+ * @brief 저장된 블록 하나를 메모리 매핑으로 보기 (NOR 전용, 복사 없음)
+ *
+ * flash_log_read_block과 같이 엔진이 유휴일 때만 쓴다. 포인터는 다음 플래시 쓰기/지우기
+ * 전까지 유효하며, 매핑 중 flash_log_read_block 등은 매핑을 유지한 채 복사한다.
+ * 압축 모드의 원본 블록(FLASH_LOG_PACKED_MAGIC)은 헤더의 used까지만 그 블록이다. 압축 블록은
+ * 그대로 훑을 수 없으므로 flash_log_read_block으로 풀어 읽는다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param block 블록 번호 (flash_log_block_count 미만)
+ * @return const uint8_t* 블록 시작 (SD 저장소, 압축 블록이거나 실패하면 NULL)
+ */
+const uint8_t *flash_log_map_block(FlashLog *log, uint32_t block);
+
+/**
+ * @brief 저장된 색인 블록 하나를 메모리 매핑으로 보기 (flash_log_map_block과 같은 조건)
+ *
+ * @param log 기록기 구조체 포인터
+ * @param block 색인 블록 번호 (flash_log_index_block_count 미만)
+ * @return const uint8_t* 블록 시작 (SD 저장소이거나 실패하면 NULL)
+ */
+const uint8_t *flash_log_map_index_block(FlashLog *log, uint32_t block);
+
+/**
+ * @brief 블록의 다음 레코드 (복사 없음)
+ *
+ * offset을 0으로 두고 NULL이 나올 때까지 부르면 블록 헤더 뒤의 레코드를 헤더의 used까지
+ * 차례로 준다. CRC는 확인하지 않으며 압축 블록(FLASH_LOG_LZ_MAGIC)이면 바로 NULL이다.
+ *
+ * @param block 블록 시작 (매핑 포인터 또는 읽은 버퍼, FLASH_LOG_BUFFER_SIZE 바이트)
+ * @param offset 다음 레코드 위치 (처음 0, 호출마다 갱신)
+ * @param type 레코드 종류 (FlashLogRecordType)
+ * @param len 페이로드 길이 (바이트)
+ * @return const uint8_t* 페이로드 (블록 끝이거나 길이가 블록을 넘으면 NULL, 정렬 보장 없음)
+ */
+const uint8_t *flash_log_next_record(const uint8_t *block, uint16_t *offset, uint8_t *type, uint8_t *len);
+
+/**
+ * @brief 기록 세션 색인 만들기 (블로킹, 비행 후 내려받기용)
+ *
+ * 저장된 블록의 헤더를 차례로 읽어 세션별 첫 블록/블록 수를 모은다. 세션이
+ * max_sessions보다 많으면 최근 세션을 남긴다. SD 저장소에서는 헤더 하나에
+ * 카드 블록 하나(512 B)를 읽는다. flash_log_read_block과 같이 엔진이 유휴일 때만 쓴다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param scratch 임시 버퍼 (SD_CARD_BLOCK_SIZE 바이트, 4바이트 정렬)
+ * @param sessions 색인 배열
+ * @param max_sessions 배열 크기
+ * @param count 채운 항목 수
+ * @return bool 성공 여부
+ */
+bool flash_log_build_index(FlashLog *log, uint8_t *scratch, FlashLogSession *sessions,
+                           uint8_t max_sessions, uint8_t *count);
+
+/**
+ * @brief 데이터 DMA 전송 완료 처리 (HAL_QSPI_TxCpltCallback, HAL_SD_TxCpltCallback)
+ *
+ * @param log 기록기 구조체 포인터
+ */
+void flash_log_handle_tx_complete(FlashLog *log);
+
+/**
+ * @brief 쓰기/지우기 완료 처리 (HAL_QSPI_StatusMatchCallback, SD는 flash_log_service가 호출)
+ *
+ * @param log 기록기 구조체 포인터
+ */
+void flash_log_handle_status_match(FlashLog *log);
+
+/**
+ * @brief 전송 오류 처리 (HAL_QSPI_ErrorCallback, HAL_SD_ErrorCallback, 진행 중 작업을 처음부터 다시 시도)
+ *
+ * @param log 기록기 구조체 포인터
+ */
+void flash_log_handle_error(FlashLog *log);
+
+#endif /* FLASH_LOG_H */
@@ -0,0 +1,174 @@
+/**
+ * @file log_codec.h
+ * @brief 압축 기록 스트림 (고정소수점 양자화, 차분 + zigzag 가변 길이 정수, 블록별 스키마/키프레임)
+ *
+ * 스트림은 타임스탬프와 float 필드 최대 LOG_CODEC_MAX_FIELDS개로 된 샘플열이다.
+ * 필드는 스키마의 양자화 간격(scale)으로 나눠 반올림한 int32로 바꾸고, 직전 샘플과의
+ * 차를 zigzag 후 LEB128 가변 길이 정수(7비트 단위, 상위 비트 = 계속)로 기록한다.
+ * 타임스탬프는 간격의 차(일정 주기이면 0, 1바이트)를 같은 방식으로 기록한다.
+ * 차는 2^32로 순환시켜 계산하므로 복원은 정수 덧셈만으로 정확하다.
+ *
+ * 블록(4 KB)마다 스트림의 첫 레코드 앞에는 스키마 레코드가, 첫 샘플은 키프레임
+ * (절대값)이 오므로 어느 블록이든 그 블록만으로 복원된다. 블록 안에서도
+ * keyframe_interval 샘플마다 키프레임을 넣는다.
+ *
+ * 레코드 페이로드 (flash_log 레코드 {종류, 길이} 뒤):
+ * @verbatim
+ *   SCHEMA: id, field_count, keyframe_interval(u16 LE), name[8], scale[field_count](f32 LE)
+ *   KEY:    id, varint(t_us),               zigzag varint(q_i)            (i = 0..n-1)
+ *   DELTA:  id, zigzag varint(dt - dt_prev), zigzag varint(q_i - q_prev_i)
+ * @endverbatim
+ * 복원: q_i 누적 후 값 = q_i * scale_i, 키프레임 이후 dt_prev = 0.
+ * 호스트 복원기는 Tools/log/log_decode.c 이다. 필드 수/이름 길이 상수는 log/log_format.h에 있다.
+ *
+ * 레코드 헤더를 포함하여 1 kHz IMU(자이로 1e-4 rad/s, 가속도 1e-3 m/s^2)는 샘플당 약
+ * 10바이트(원시 30바이트), 100 Hz 항법 해 16필드는 약 28바이트(원시 약 150바이트)가 된다.
+ * 양자화 오차는 간격의 절반이며, 간격보다 큰 float 반올림 오차(큰 위치 값 등)는 그대로 남는다.
+ */
+
+#ifndef LOG_CODEC_H
+#define LOG_CODEC_H
+
+#include "log/flash_log.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 키프레임 간격 (샘플)
+ */
+#define LOG_CODEC_DEFAULT_KEYFRAME_INTERVAL 256u
+
+/**
+ * @brief 기본 양자화 간격
+ */
+#define LOG_CODEC_SCALE_GYRO 1e-4f         /**< 각속도 (rad/s, ICM-42688 2000 dps LSB의 1/10) */
+#define LOG_CODEC_SCALE_ACCEL 1e-3f        /**< 가속도 (m/s^2, 16 g LSB의 1/5) */
+#define LOG_CODEC_SCALE_POS 1e-3f          /**< 위치 (m) */
+#define LOG_CODEC_SCALE_VEL 1e-3f          /**< 속도 (m/s) */
+#define LOG_CODEC_SCALE_QUAT 1e-6f         /**< 사원수 성분 */
+#define LOG_CODEC_SCALE_GYRO_BIAS 1e-6f    /**< 자이로 바이어스 (rad/s) */
+#define LOG_CODEC_SCALE_ACCEL_BIAS 1e-5f   /**< 가속도 바이어스 (m/s^2) */
+#define LOG_CODEC_SCALE_PRESSURE 0.1f      /**< 기압 (Pa, MS5611 최고 해상도 약 1.2 Pa) */
+#define LOG_CODEC_SCALE_TEMP 0.01f         /**< 센서 온도 (°C) */
+
+/**
+ * @brief 압축 기록 스트림
+ */
+typedef struct {
+    uint8_t id;                            /**< 스트림 번호 (세션 안에서 고유) */
+    uint8_t field_count;                   /**< 필드 수 */
+    uint16_t keyframe_interval;            /**< 키프레임 간격 (샘플, 1이면 모두 키프레임) */
+    char name[LOG_CODEC_NAME_SIZE];        /**< 스트림 이름 */
+    float scale[LOG_CODEC_MAX_FIELDS];     /**< 필드별 양자화 간격 */
+    float inv_scale[LOG_CODEC_MAX_FIELDS]; /**< 1 / scale */
+
+    int32_t prev[LOG_CODEC_MAX_FIELDS];    /**< 직전 샘플 양자화 값 */
+    uint32_t prev_t;                       /**< 직전 샘플 시각 (us) */
+    uint32_t prev_dt;                      /**< 직전 샘플 간격 (us) */
+    uint32_t block;                        /**< 마지막으로 기록한 블록 순번 */
+    uint16_t since_key;                    /**< 마지막 키프레임 이후 샘플 수 */
+    bool primed;                           /**< 이 블록에 키프레임을 기록했는지 */
+
+    uint32_t samples;                      /**< 기록한 샘플 수 */
+    uint32_t bytes;                        /**< 기록한 페이로드 바이트 (스키마 포함) */
+} LogStream;
+
+/**
+ * @brief 스트림 초기화
+ *
+ * @param stream 스트림 구조체 포인터
+ * @param id 스트림 번호
+ * @param name 스트림 이름 (최대 8자, 넘으면 자름)
+ * @param field_count 필드 수 (1..LOG_CODEC_MAX_FIELDS)
+ * @param scale 필드별 양자화 간격 (양수)
+ * @param keyframe_interval 키프레임 간격 (샘플, 1 이상)
+ * @return bool 성공 여부
+ */
+bool log_stream_init(LogStream *stream, uint8_t id, const char *name, uint8_t field_count,
+                     const float *scale, uint16_t keyframe_interval);
+
+/**
+ * @brief 샘플 기록 (작성자 전용, 기다리지 않음)
+ *
+ * 기록하지 못한 샘플은 차분 기준에 반영하지 않으므로 이후 샘플도 정확히 복원된다.
+ *
+ * @param log 기록기 구조체 포인터
+ * @param stream 스트림 구조체 포인터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param values 필드 값 (field_count개)
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool log_stream_write(FlashLog *log, LogStream *stream, uint32_t timestamp_us, const float *values);
+
+/**
+ * @brief RAM 버퍼용 샘플 인코딩 (flash_log를 거치지 않는 보관 버퍼, log/pre_trigger.h)
+ *
+ * 기록 레코드와 같은 KEY/DELTA 페이로드를 rec에 쓰고 차분 기준을 바로 갱신한다. 처음 샘플과
+ * keyframe_interval마다는 key와 무관하게 키프레임이다. 버퍼 공간은 호출 전에 확인한다.
+ *
+ * @param stream 스트림 구조체 포인터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param values 필드 값 (field_count개)
+ * @param key 키프레임으로 쓸지 (버퍼 조각 시작 등)
+ * @param rec 페이로드 (LOG_CODEC_MAX_RECORD 바이트 이상)
+ * @return uint8_t 페이로드 길이 (실패하면 0)
+ */
+uint8_t log_stream_encode(LogStream *stream, uint32_t timestamp_us, const float *values, bool key, uint8_t *rec);
+
+/**
+ * @brief 스키마 레코드 페이로드 작성
+ *
+ * @param stream 스트림 구조체 포인터
+ * @param p 페이로드 (LOG_CODEC_SCHEMA_SIZE(field_count) 바이트 이상)
+ * @return uint8_t 페이로드 길이
+ */
+uint8_t log_stream_schema(const LogStream *stream, uint8_t *p);
+
+/**
+ * @brief IMU 스트림 초기화 (자이로 xyz, 가속도 xyz)
+ *
+ * @param stream 스트림 구조체 포인터
+ * @param id 스트림 번호
+ * @return bool 성공 여부
+ */
+bool log_stream_init_imu(LogStream *stream, uint8_t id);
+
+/**
+ * @brief IMU 샘플 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param stream log_stream_init_imu로 초기화한 스트림
+ * @param sample IMU 샘플
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool log_stream_write_imu(FlashLog *log, LogStream *stream, const ImuSample *sample);
+
+/**
+ * @brief 기압 스트림 초기화 (기압, 센서 온도)
+ *
+ * @param stream 스트림 구조체 포인터
+ * @param id 스트림 번호
+ * @return bool 성공 여부
+ */
+bool log_stream_init_baro(LogStream *stream, uint8_t id);
+
+/**
+ * @brief 항법 해 스트림 초기화 (위치, 속도, 사원수 wxyz, 자이로/가속도 바이어스)
+ *
+ * @param stream 스트림 구조체 포인터
+ * @param id 스트림 번호
+ * @return bool 성공 여부
+ */
+bool log_stream_init_nav(LogStream *stream, uint8_t id);
+
+/**
+ * @brief 항법 해 기록
+ *
+ * @param log 기록기 구조체 포인터
+ * @param stream log_stream_init_nav로 초기화한 스트림
+ * @param sol 항법 해 스냅샷
+ * @return bool 버퍼에 넣었으면 true
+ */
+bool log_stream_write_nav(FlashLog *log, LogStream *stream, const EKF_NavSolution *sol);
+
+#endif /* LOG_CODEC_H */
@@ -0,0 +1,302 @@
+/**
+ * @file log_format.h
+ * @brief 비행 기록 형식 (블록/레코드 상수, 레코드 배치, 압축 스트림 상수, CRC/가변 길이 정수 도우미)
+ *
+ * 펌웨어 기록기(flash_log.h, log_codec.h)와 호스트 도구(Tools/log, Tools/ground, Tools/replay,
+ * Tools/sim)가 함께 포함하는 형식 정의이다. HAL과 다른 펌웨어 헤더에 의존하지 않으므로
+ * 호스트에서는 -ICore/Inc만으로 포함할 수 있다. 형식이 바뀌면 이 파일만 고치고, 새 레코드 종류는
+ * 복원기(Tools/log/log_decode.c, Tools/ground/ground_decode.c)에 함께 추가한다.
+ *
+ * 모든 다중 바이트 값은 리틀 엔디언이다 (레코드 구조체를 그대로 복사하는 호스트는 리틀 엔디언 가정).
+ */
+
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief 블록 크기 (바이트, NOR 섹터 하나)
+ */
+#define FLASH_LOG_BLOCK_SIZE 4096u
+
+/**
+ * @brief 압축 모드 저장 단위 (바이트, NOR 페이지 하나)
+ */
+#define FLASH_LOG_PAGE_SIZE 256u
+
+/**
+ * @brief 블록 헤더 크기와 필드 위치 (바이트, FlashLogBlockHeader)
+ */
+#define FLASH_LOG_BLOCK_HEADER_SIZE 16u
+#define FLASH_LOG_HEADER_MAGIC 0u       /**< magic (u32) */
+#define FLASH_LOG_HEADER_CRC 4u         /**< crc (u32) */
+#define FLASH_LOG_HEADER_SEQ 8u         /**< seq (u32) */
+#define FLASH_LOG_HEADER_SESSION 12u    /**< session (u16) */
+#define FLASH_LOG_HEADER_USED 14u       /**< used (u16) */
+
+/**
+ * @brief 블록 헤더 표식 ("PLOG")
+ */
+#define FLASH_LOG_MAGIC 0x474F4C50u
+
+/**
+ * @brief 색인 블록 헤더 표식 ("PIDX")
+ */
+#define FLASH_LOG_INDEX_MAGIC 0x58444950u
+
+/**
+ * @brief 압축 블록 헤더 표식 ("PLGZ", 헤더 뒤 LZ4 블록 형식, used는 저장 바이트)
+ */
+#define FLASH_LOG_LZ_MAGIC 0x5A474C50u
+
+/**
+ * @brief 페이지 단위로 이어 붙인 원본 블록 헤더 표식 ("PLGP", 압축 모드에서 압축 이득이 없을 때)
+ */
+#define FLASH_LOG_PACKED_MAGIC 0x50474C50u
+
+/**
+ * @brief 블록 끝 표식 (지워진 플래시 값)
+ */
+#define FLASH_LOG_END_TYPE 0xFFu
+
+/**
+ * @brief 블록 CRC 범위 시작 (헤더의 seq 필드)
+ */
+#define FLASH_LOG_CRC_OFFSET FLASH_LOG_HEADER_SEQ
+
+/**
+ * @brief 레코드 헤더 크기 (종류, 길이)
+ */
+#define FLASH_LOG_RECORD_HEADER 2u
+
+/**
+ * @brief 레코드 최대 페이로드 (바이트)
+ */
+#define FLASH_LOG_MAX_PAYLOAD 255u
+
+/**
+ * @brief 색인 항목 크기 (바이트, FlashLogIndexEntry)
+ */
+#define FLASH_LOG_INDEX_ENTRY_SIZE 16u
+
+/**
+ * @brief 압축 스트림 최대 필드 수 (log_codec.h)
+ */
+#define LOG_CODEC_MAX_FIELDS 16
+
+/**
+ * @brief 압축 스트림 이름 길이 (NUL 종료 없이 고정 길이)
+ */
+#define LOG_CODEC_NAME_SIZE 8
+
+/**
+ * @brief 압축 스트림 레코드 최대 페이로드 (id + 타임스탬프 + 필드, 가변 길이 정수 최대 5바이트)
+ */
+#define LOG_CODEC_MAX_RECORD (1 + 5 + 5 * LOG_CODEC_MAX_FIELDS)
+
+/**
+ * @brief 스키마 레코드 페이로드 길이
+ */
+#define LOG_CODEC_SCHEMA_SIZE(n) (1 + 1 + 2 + LOG_CODEC_NAME_SIZE + 4 * (n))
+
+/**
+ * @brief 레코드 종류
+ */
+typedef enum {
+    FLASH_LOG_REC_IMU = 1,     /**< IMU 샘플 (FlashLogImuRecord) */
+    FLASH_LOG_REC_BARO = 2,    /**< 기압 (FlashLogBaroRecord) */
+    FLASH_LOG_REC_MAG = 3,     /**< 자기장 (FlashLogMagRecord) */
+    FLASH_LOG_REC_GNSS = 4,    /**< GNSS 해 (FlashLogGnssRecord) */
+    FLASH_LOG_REC_NAV = 5,     /**< 항법 해 (EKF_NavSolution 그대로) */
+    FLASH_LOG_REC_SCHEMA = 6,  /**< 압축 스트림 스키마 (log/log_codec.h) */
+    FLASH_LOG_REC_KEY = 7,     /**< 압축 스트림 키프레임 (절대값) */
+    FLASH_LOG_REC_DELTA = 8,   /**< 압축 스트림 차분 */
+    FLASH_LOG_REC_READY = 9,   /**< 수렴/준비 상태 (FlashLogReadyRecord) */
+    FLASH_LOG_REC_EKF_CALL = 10, /**< EKF 공개 호출 (log/call_recorder.h) */
+    FLASH_LOG_REC_EKF_CHECK = 11, /**< EKF 상태 검사값 (log/call_recorder.h) */
+    FLASH_LOG_REC_EKF_SNAP = 12, /**< EKF 상태 스냅샷 조각 (log/call_recorder.h) */
+    FLASH_LOG_REC_PRE_EVENT = 13, /**< 이벤트 전 보관 레코드 (log/log_policy.h, 원래 종류 u8 | 원래 페이로드) */
+    FLASH_LOG_REC_COV = 14,    /**< 공분산 스냅샷 (log/cov_log.h) */
+    FLASH_LOG_REC_NIS = 15,    /**< 측정별 NIS 창 통계 (nav/innovation_monitor.h) */
+    FLASH_LOG_REC_PIL = 16     /**< PIL 재생 상태 (sensors/pil_replay.h, PilReplayRecord) */
+} FlashLogRecordType;
+
+/**
+ * @brief 블록 헤더 (블록 시작, 16바이트)
+ */
+typedef struct {
+    uint32_t magic;            /**< FLASH_LOG_MAGIC (압축 모드: FLASH_LOG_LZ_MAGIC, FLASH_LOG_PACKED_MAGIC) */
+    uint32_t crc;              /**< CRC-32 (FLASH_LOG_CRC_OFFSET..블록 끝, 압축 블록은 풀어 낸 블록 기준) */
+    uint32_t seq;              /**< 블록 순번 (기록 세션 안에서 0부터) */
+    uint16_t session;          /**< 기록 세션 번호 (전원 투입마다 1 증가) */
+    uint16_t used;             /**< 헤더 포함 사용 바이트 (압축 블록은 저장 바이트) */
+} FlashLogBlockHeader;
+
+_Static_assert(sizeof(FlashLogBlockHeader) == FLASH_LOG_BLOCK_HEADER_SIZE, "FlashLogBlockHeader layout changed");
+_Static_assert(offsetof(FlashLogBlockHeader, crc) == FLASH_LOG_HEADER_CRC &&
+               offsetof(FlashLogBlockHeader, seq) == FLASH_LOG_CRC_OFFSET &&
+               offsetof(FlashLogBlockHeader, session) == FLASH_LOG_HEADER_SESSION &&
+               offsetof(FlashLogBlockHeader, used) == FLASH_LOG_HEADER_USED, "FlashLogBlockHeader offsets changed");
+
+/**
+ * @brief IMU 레코드 (28바이트)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 샘플 시각 (us) */
+    float gyro[3];             /**< 각속도 (rad/s) */
+    float accel[3];            /**< 가속도 (m/s^2) */
+} FlashLogImuRecord;
+
+_Static_assert(sizeof(FlashLogImuRecord) == 28, "FlashLogImuRecord layout changed");
+
+/**
+ * @brief 기압 레코드 (12바이트)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 샘플 시각 (us) */
+    float pressure_pa;         /**< 기압 (Pa) */
+    float temp_c;              /**< 센서 온도 (°C) */
+} FlashLogBaroRecord;
+
+_Static_assert(sizeof(FlashLogBaroRecord) == 12, "FlashLogBaroRecord layout changed");
+
+/**
+ * @brief 자기장 레코드 (16바이트)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 샘플 시각 (us) */
+    float field[3];            /**< 자기장 (uT, 센서 좌표계) */
+} FlashLogMagRecord;
+
+_Static_assert(sizeof(FlashLogMagRecord) == 16, "FlashLogMagRecord layout changed");
+
+/**
+ * @brief GNSS 레코드 (52바이트)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 측정 시각 (us) */
+    uint32_t itow_ms;          /**< GPS 주 시각 (ms) */
+    int32_t lat_e7;            /**< 위도 (1e-7 deg) */
+    int32_t lon_e7;            /**< 경도 (1e-7 deg) */
+    int32_t height_mm;         /**< 타원체 고도 (mm) */
+    int32_t hmsl_mm;           /**< 평균 해수면 고도 (mm) */
+    float vel_ned[3];          /**< 속도 (NED, m/s) */
+    float h_acc;               /**< 수평 위치 정확도 (m) */
+    float v_acc;               /**< 수직 위치 정확도 (m) */
+    float s_acc;               /**< 속도 정확도 (m/s) */
+    uint8_t fix_type;          /**< 측위 종류 */
+    uint8_t num_sv;            /**< 사용 위성 수 */
+    uint8_t flags;             /**< bit0 fix_ok, bit1 pulse_locked */
+    uint8_t reserved;          /**< 예약 (0) */
+} FlashLogGnssRecord;
+
+_Static_assert(sizeof(FlashLogGnssRecord) == 52, "FlashLogGnssRecord layout changed");
+
+/**
+ * @brief 기록 세션 색인 항목 (16바이트, 비행 후 내려받기용)
+ */
+typedef struct {
+    uint16_t session;          /**< 기록 세션 번호 */
+    uint16_t reserved;         /**< 예약 (0) */
+    uint32_t first_block;      /**< 첫 블록 번호 (기록 영역 시작 기준) */
+    uint32_t block_count;      /**< 블록 수 */
+    uint32_t last_seq;         /**< 마지막 블록 순번 (block_count - 1보다 크면 빠진 블록 있음) */
+} FlashLogSession;
+
+_Static_assert(sizeof(FlashLogSession) == 16, "FlashLogSession layout changed");
+
+/**
+ * @brief 색인 항목 종류
+ */
+typedef enum {
+    FLASH_LOG_INDEX_TIME = 1,  /**< 주기 시각 (블록 시작 = 압축 스트림 키프레임 위치) */
+    FLASH_LOG_INDEX_EVENT = 2, /**< 비행 이벤트 (arg FlightEventType, 시각 onset, value 검출 시각) */
+    FLASH_LOG_INDEX_PHASE = 3  /**< 비행 단계 변경 (arg FlightPhase) */
+} FlashLogIndexKind;
+
+/**
+ * @brief 색인 항목 (16바이트, 색인 블록에 헤더 뒤로 이어 붙음)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 시각 (us) */
+    uint32_t block;            /**< 그 시각의 레코드가 든 데이터 블록 번호 (기록 영역 시작 기준) */
+    uint32_t value;            /**< 종류별 값 */
+    uint16_t session;          /**< 기록 세션 번호 */
+    uint8_t kind;              /**< FlashLogIndexKind */
+    uint8_t arg;               /**< 종류별 인자 */
+} FlashLogIndexEntry;
+
+_Static_assert(sizeof(FlashLogIndexEntry) == FLASH_LOG_INDEX_ENTRY_SIZE, "FlashLogIndexEntry layout changed");
+
+/**
+ * @brief CRC-32 (zlib 호환, 비트 단위, 펌웨어 hw_crc32와 같은 값)
+ *
+ * @param data 데이터
+ * @param len 길이 (바이트)
+ * @return uint32_t CRC
+ */
+static inline uint32_t log_format_crc32(const uint8_t *data, size_t len) {
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        c ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1u)));
+        }
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief 부호 없는 가변 길이 정수 쓰기 (LEB128, 최대 5바이트)
+ *
+ * @param p 출력
+ * @param v 값
+ * @return uint8_t 쓴 바이트 수
+ */
+static inline uint8_t log_format_put_varint(uint8_t *p, uint32_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80u) {
+        p[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+
+    return n;
+}
+
+/**
+ * @brief 부호 없는 가변 길이 정수 읽기
+ *
+ * @param p 읽을 위치 (읽은 만큼 앞으로)
+ * @param end 버퍼 끝
+ * @param v 값
+ * @return bool 성공 여부 (끝을 넘거나 5바이트를 넘으면 false)
+ */
+static inline bool log_format_get_varint(const uint8_t **p, const uint8_t *end, uint32_t *v) {
+    uint32_t r = 0;
+    for (int shift = 0; shift < 35 && *p < end; shift += 7) {
+        uint8_t b = *(*p)++;
+        r |= (uint32_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            *v = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief zigzag (작은 음수도 작은 부호 없는 값으로)와 그 역
+ */
+static inline uint32_t log_format_zigzag(uint32_t v) {
+    return (v << 1) ^ (uint32_t)(-(int32_t)(v >> 31));
+}
+
+static inline uint32_t log_format_unzigzag(uint32_t v) {
+    return (v >> 1) ^ (uint32_t)(-(int32_t)(v & 1u));
+}
+
+#endif /* LOG_FORMAT_H */
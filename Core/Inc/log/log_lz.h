@@ -0,0 +1,60 @@
+/**
+ * @file log_lz.h
+ * @brief 기록 블록 압축기 (LZ4 블록 형식, 해시 한 번 탐욕 일치, 4 KB 이하 입력)
+ *
+ * 차분 부호화(log_codec) 뒤에도 블록에는 스키마/상태 워드, 천천히 변하는 값처럼
+ * 되풀이되는 바이트열이 남는다. 이를 LZ4 블록 형식의 {토큰, 리터럴, 거리, 일치 길이}
+ * 열로 줄인다. 호스트에서는 일반 LZ4 블록 복원기로도 풀 수 있다.
+ *
+ * 압축은 4바이트 해시 표 하나(LOG_LZ_HASH_SIZE 항목, 호출자 제공)로 바이트마다 후보를
+ * 한 번만 확인하고, 일치가 없으면 건너뛰는 폭을 늘려 가므로 블록당 시간은 입력 길이에
+ * 비례하고 압축되지 않는 데이터에서 가장 짧다. 출력이 capacity를 넘으면 실패를 돌려주고
+ * 호출자는 원본을 그대로 저장한다.
+ *
+ * 복원은 입력과 출력 범위를 모두 확인하므로 깨진 블록이 출력 버퍼를 넘지 않는다.
+ */
+
+#ifndef LOG_LZ_H
+#define LOG_LZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 해시 표 크기 (항목 수, uint16_t 표 2 KB)
+ */
+#define LOG_LZ_HASH_BITS 10u
+#define LOG_LZ_HASH_SIZE (1u << LOG_LZ_HASH_BITS)
+
+/**
+ * @brief 일치 최소 길이 (LZ4)
+ */
+#define LOG_LZ_MIN_MATCH 4u
+
+/**
+ * @brief 압축
+ *
+ * @param src 원본
+ * @param len 원본 길이 (바이트)
+ * @param dst 출력
+ * @param capacity 출력 한계 (바이트)
+ * @param table 해시 표 (LOG_LZ_HASH_SIZE 항목, 내용은 호출마다 새로 채움)
+ * @param out_len 출력 길이 (바이트)
+ * @return bool 성공 여부 (출력이 capacity를 넘으면 false)
+ */
+bool log_lz_compress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t capacity,
+                     uint16_t *table, uint16_t *out_len);
+
+/**
+ * @brief 복원
+ *
+ * @param src 압축 데이터
+ * @param len 압축 데이터 길이 (바이트)
+ * @param dst 출력
+ * @param capacity 출력 한계 (바이트)
+ * @param out_len 복원 길이 (바이트)
+ * @return bool 성공 여부 (형식 오류이거나 출력이 capacity를 넘으면 false)
+ */
+bool log_lz_decompress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t capacity, uint16_t *out_len);
+
+#endif /* LOG_LZ_H */
@@ -0,0 +1,183 @@
+/**
+ * @file log_policy.h
+ * @brief 비행 단계별 기록 주기 정책 (스트림별 간격, 변화 시 기록, 이벤트 전후 전체 주기 보관)
+ *
+ * 임무 전체를 전체 주기로 기록하면 수 시간의 발사대 대기와 하강 구간에 플래시 대역폭과 용량을
+ * 대부분 쓴다. 이 정책은 flash_log의 레코드 거르기 콜백(flash_log_set_filter)으로 붙어
+ * 레코드 종류를 스트림(LogPolicyStream)으로 나누고, 현재 비행 단계의 스트림 간격에 따라 기록한다.
+ * - 간격: period_us[단계][스트림]. 0이면 모든 레코드, LOG_POLICY_OFF이면 기록 안 함.
+ *   예: 원시 IMU는 추진/관성 비행 중 1 kHz 전체, 발사대에서 50 Hz.
+ * - 변화 시 기록: on_change에 든 스트림(기본: 수렴/준비 상태)은 시각(페이로드 앞 4바이트)을 뺀
+ *   내용이 바뀌었거나 heartbeat_us가 지났을 때만 기록한다.
+ * - 이벤트 보관: 간격 때문에 거른 레코드는 보관 링(LOG_POLICY_RING_SIZE 바이트)에 넣어 두고,
+ *   trigger_events의 비행 이벤트(log_policy_event, 발사/정점 등)나 log_policy_trigger(낙하산 사출 등
+ *   외부 사건)가 들어오면 링 내용을 FLASH_LOG_REC_PRE_EVENT 레코드(원래 종류 | 원래 페이로드)로
+ *   조금씩(drain_bytes/레코드) 내보내고, post_event_us 동안은 모든 스트림을 전체 주기로 기록한다.
+ *   발사대 대기 중 링 8 KB는 IMU만으로 약 270 ms 분량이다.
+ *
+ * 이벤트 전 레코드는 이벤트 뒤에 기록되므로 기록 순서대로 읽는 도구(Tools/replay)는 이를 무시하고,
+ * 복원 도구(Tools/log/log_decode.c)는 원래 종류 이름 앞에 pre_를 붙여 원래 시각으로 출력한다.
+ * 정책이 다루지 않는 종류(압축 스트림, EKF 호출 기록 등)는 그대로 기록한다.
+ *
+ * 모든 함수는 기록 작성자 문맥(융합 태스크) 한 곳에서만 호출해야 한다.
+ */
+
+#ifndef LOG_POLICY_H
+#define LOG_POLICY_H
+
+#include "log/flash_log.h"
+#include "nav/flight_phase.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 비행 단계 수 (FlightPhase)
+ */
+#define LOG_POLICY_PHASE_COUNT 4u
+
+/**
+ * @brief 기록 안 함 간격
+ */
+#define LOG_POLICY_OFF 0xFFFFFFFFu
+
+/**
+ * @brief 이벤트 전 보관 링 크기 (바이트, 2의 거듭제곱)
+ */
+#define LOG_POLICY_RING_SIZE 8192u
+
+/**
+ * @brief 기본 설정
+ */
+#define LOG_POLICY_DEFAULT_HEARTBEAT_US 1000000u   /**< 변화 시 기록 스트림의 최대 간격 (us) */
+#define LOG_POLICY_DEFAULT_POST_EVENT_US 2000000u  /**< 이벤트 뒤 전체 주기 구간 (us) */
+#define LOG_POLICY_DEFAULT_DRAIN_BYTES 128u        /**< 레코드 하나 기록할 때 함께 내보낼 보관분 (바이트) */
+
+/**
+ * @brief 기록 스트림
+ */
+typedef enum {
+    LOG_STREAM_IMU = 0,    /**< 원시 IMU (FLASH_LOG_REC_IMU) */
+    LOG_STREAM_BARO,       /**< 기압 (FLASH_LOG_REC_BARO) */
+    LOG_STREAM_MAG,        /**< 자기장 (FLASH_LOG_REC_MAG) */
+    LOG_STREAM_GNSS,       /**< GNSS 해 (FLASH_LOG_REC_GNSS) */
+    LOG_STREAM_NAV,        /**< 항법 해 (FLASH_LOG_REC_NAV) */
+    LOG_STREAM_STATUS,     /**< 수렴/준비 상태 (FLASH_LOG_REC_READY) */
+    LOG_STREAM_COUNT       /**< 스트림 수 */
+} LogPolicyStream;
+
+/**
+ * @brief 정책 설정
+ */
+typedef struct {
+    uint32_t period_us[LOG_POLICY_PHASE_COUNT][LOG_STREAM_COUNT]; /**< 단계/스트림별 기록 간격 (us, 0이면 전체, LOG_POLICY_OFF이면 끔) */
+    uint8_t on_change;         /**< 변화 시에만 기록할 스트림 (1 << LogPolicyStream) */
+    uint32_t heartbeat_us;     /**< 변화 시 기록 스트림의 최대 간격 (us) */
+    uint8_t trigger_events;    /**< 보관분을 내보낼 비행 이벤트 (1 << FlightEventType) */
+    uint32_t post_event_us;    /**< 이벤트 뒤 전체 주기 구간 (us) */
+    uint16_t drain_bytes;      /**< 레코드 하나 기록할 때 함께 내보낼 보관분 (바이트) */
+} LogPolicyConfig;
+
+/**
+ * @brief 스트림별 통계
+ */
+typedef struct {
+    uint32_t written;          /**< 기록한 레코드 수 */
+    uint32_t skipped;          /**< 간격/변화 없음으로 거른 레코드 수 */
+} LogPolicyStreamStats;
+
+/**
+ * @brief 정책 통계
+ */
+typedef struct {
+    LogPolicyStreamStats stream[LOG_STREAM_COUNT]; /**< 스트림별 통계 */
+    uint32_t triggers;         /**< 보관분 내보내기를 시작한 이벤트 수 */
+    uint32_t pre_event_written; /**< 내보낸 이벤트 전 레코드 수 */
+    uint32_t ring_evicted;     /**< 링이 차서 밀려난 보관 레코드 수 */
+    uint32_t drain_failures;   /**< 기록기가 받지 않아 멈춘 내보내기 수 (다음 레코드 때 재시도) */
+} LogPolicyStats;
+
+/**
+ * @brief 기록 정책
+ */
+typedef struct {
+    FlashLog *log;             /**< 비행 기록 */
+    const FlightPhaseMachine *phase; /**< 비행 단계 (NULL이면 발사대 단계 정책) */
+    LogPolicyConfig config;    /**< 설정 */
+
+    uint32_t next_us[LOG_STREAM_COUNT]; /**< 스트림별 다음 기록 시각 (us) */
+    uint32_t last_hash[LOG_STREAM_COUNT]; /**< 변화 시 기록 스트림의 마지막 내용 해시 */
+    uint8_t started;           /**< 첫 레코드를 기록한 스트림 (1 << LogPolicyStream) */
+    uint32_t post_end_us;      /**< 전체 주기 구간 끝 (us) */
+    bool post_active;          /**< 전체 주기 구간 중 */
+
+    uint8_t ring[LOG_POLICY_RING_SIZE]; /**< 보관 링 ({종류, 길이, 페이로드} 연속) */
+    uint32_t ring_head;        /**< 가장 오래된 레코드 위치 (누적 바이트) */
+    uint32_t ring_tail;        /**< 다음 쓰기 위치 (누적 바이트) */
+    uint32_t drain_end;        /**< 내보낼 보관분 끝 (누적 바이트, ring_head와 같으면 없음) */
+    bool draining;             /**< 보관분을 쓰는 중 (거르기 콜백 재진입 표시) */
+
+    LogPolicyStats stats;      /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} LogPolicy;
+
+/**
+ * @brief 기본 설정
+ *
+ * 발사대: IMU 50 Hz, 기압/자기장/항법 해 10 Hz, GNSS 1 Hz. 추진/관성 비행: 전체.
+ * 하강: IMU 100 Hz, 자기장 20 Hz, 항법 해 10 Hz, 기압/GNSS 전체. 수렴/준비 상태는 변화 시.
+ * 발사와 정점에서 보관분을 내보낸다.
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool log_policy_default_config(LogPolicyConfig *config);
+
+/**
+ * @brief 정책 초기화 및 기록기에 연결 (flash_log_set_filter)
+ *
+ * @param policy 구조체 포인터
+ * @param log 초기화된 비행 기록
+ * @param phase 비행 단계 상태 기계 (NULL이면 발사대 단계 정책)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool log_policy_init(LogPolicy *policy, FlashLog *log, const FlightPhaseMachine *phase,
+                     const LogPolicyConfig *config);
+
+/**
+ * @brief 비행 이벤트 반영 (trigger_events에 든 종류만 log_policy_trigger)
+ *
+ * @param policy 구조체 포인터
+ * @param event 비행 이벤트
+ * @return bool 보관분 내보내기를 시작했으면 true
+ */
+bool log_policy_event(LogPolicy *policy, const FlightEvent *event);
+
+/**
+ * @brief 보관분 내보내기와 전체 주기 구간 시작 (낙하산 사출 등 외부 사건)
+ *
+ * 이미 내보내는 중이면 지금까지 보관한 분까지 범위를 늘린다.
+ *
+ * @param policy 구조체 포인터
+ * @param timestamp_us 사건 시각 (us, 전체 주기 구간 기준)
+ * @return bool 성공 여부
+ */
+bool log_policy_trigger(LogPolicy *policy, uint32_t timestamp_us);
+
+/**
+ * @brief 남은 보관분 내보내기 (기록할 레코드가 없는 사이클에 호출, 선택)
+ *
+ * @param policy 구조체 포인터
+ * @return bool 내보낼 보관분이 남아 있으면 true
+ */
+bool log_policy_service(LogPolicy *policy);
+
+/**
+ * @brief 통계
+ *
+ * @param policy 구조체 포인터
+ * @return const LogPolicyStats* 통계 (NULL이면 NULL)
+ */
+const LogPolicyStats *log_policy_get_stats(const LogPolicy *policy);
+
+#endif /* LOG_POLICY_H */
@@ -0,0 +1,204 @@
+/**
+ * @file pre_trigger.h
+ * @brief 입력 단계 사전 트리거 버퍼 (이벤트 전 전체 주기 IMU/기압을 압축 형식으로 RAM에 보관)
+ *
+ * 평소에는 낮은 주기로 기록하더라도(log/log_policy.h) 발사 직전 2 s의 전체 주기 IMU와 기압은
+ * 남아야 한다. 이 버퍼는 입력 단계(ImuRing 생산자 탭, 기압계 읽기 문맥)에서 샘플을 받아
+ * 압축 기록 스트림 형식(log/log_codec.h, KEY/DELTA 페이로드)으로 RAM 조각 링에 쌓는다.
+ * - 조각(PRE_TRIGGER_CHUNK_SIZE 바이트)은 키프레임으로 시작하므로 링이 차면 가장 오래된
+ *   조각을 통째로 버리고, 남은 조각은 각자 복원된다. 1 kHz IMU는 샘플당 약 10바이트
+ *   (원시 30바이트)이므로 2 s가 약 20 KB, 기압은 100 Hz 2 s가 약 1.5 KB이다.
+ * - 트리거(pre_trigger_fire, 또는 비행 이벤트 콜백 pre_trigger_event_callback)는 어느 문맥에서나
+ *   부를 수 있다. 각 생산자는 다음 샘플에서 트리거를 보고 쌓기를 멈춘다(확인 표시).
+ * - 기록 작성자 문맥(융합 태스크)의 pre_trigger_service가 두 생산자가 멈춘 것을 확인한 뒤 트리거
+ *   시각 window_us 전 이후의 조각을 호출마다 service_chunks개씩 flash_log에 옮긴다 (비동기,
+ *   기다리지 않음). 조각은 필요하면 새 블록에서 시작하고, 블록마다 스키마 레코드를 앞에 붙이므로
+ *   복원은 기존 압축 스트림과 같다 (Tools/log/log_decode.c, 스트림 이름 imu_pre, baro_pre).
+ *   다 옮기면 링을 비우고 다시 쌓기 시작한다.
+ *
+ * 트리거 뒤 샘플은 쌓지 않으므로 트리거 이후 구간은 평소 기록 경로(정책의 이벤트 뒤 전체 주기
+ * 구간 등)로 남긴다. IMU 링의 생산자 탭은 하나이므로 비행 이벤트 검출기(nav/event_detector.h)와
+ * 함께 쓰면 탭 함수 하나에서 event_detector_push_imu와 pre_trigger_push_imu를 모두 부른다.
+ * IMU와 기압 생산자는 서로 다른 문맥이어도 되지만 각각은 한 문맥에서만 호출해야 한다.
+ */
+
+#ifndef PRE_TRIGGER_H
+#define PRE_TRIGGER_H
+
+#include "log/log_codec.h"
+#include "nav/flight_phase.h"
+#include "sensors/imu_ring.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 조각 크기 (바이트, {종류, 길이, 페이로드} 레코드 연속)
+ */
+#define PRE_TRIGGER_CHUNK_SIZE 256u
+
+/**
+ * @brief 스트림별 조각 수
+ */
+#define PRE_TRIGGER_IMU_CHUNKS 88u   /**< IMU (1 kHz 약 2.2 s) */
+#define PRE_TRIGGER_BARO_CHUNKS 8u   /**< 기압 (100 Hz 약 2.5 s) */
+
+/**
+ * @brief 기본 설정
+ */
+#define PRE_TRIGGER_DEFAULT_WINDOW_US 2000000u   /**< 트리거 전 보관 구간 (us) */
+#define PRE_TRIGGER_DEFAULT_IMU_ID 0xE0u         /**< IMU 압축 스트림 번호 */
+#define PRE_TRIGGER_DEFAULT_BARO_ID 0xE1u        /**< 기압 압축 스트림 번호 */
+#define PRE_TRIGGER_DEFAULT_EVENTS (1u << FLIGHT_EVENT_LAUNCH) /**< 이벤트 콜백이 트리거할 종류 */
+#define PRE_TRIGGER_DEFAULT_SERVICE_CHUNKS 2u    /**< pre_trigger_service 한 번에 옮길 조각 수 */
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t window_us;        /**< 트리거 전 보관 구간 (us) */
+    uint8_t imu_id;            /**< IMU 압축 스트림 번호 (평소 기록 스트림과 달라야 함) */
+    uint8_t baro_id;           /**< 기압 압축 스트림 번호 */
+    uint8_t trigger_events;    /**< 이벤트 콜백이 트리거할 종류 (1 << FlightEventType) */
+    uint8_t service_chunks;    /**< pre_trigger_service 한 번에 옮길 조각 수 */
+} PreTriggerConfig;
+
+/**
+ * @brief 압축 샘플 조각
+ */
+typedef struct {
+    uint32_t first_us;         /**< 첫 샘플 시각 (us) */
+    uint32_t last_us;          /**< 마지막 샘플 시각 (us) */
+    uint16_t used;             /**< 사용 바이트 */
+    uint8_t data[PRE_TRIGGER_CHUNK_SIZE]; /**< 레코드 ({KEY|DELTA, 길이, 페이로드}) */
+} PreTriggerChunk;
+
+/**
+ * @brief 스트림 하나의 조각 링 (생산자가 쌓고, 멈춘 뒤 작성자가 옮김)
+ */
+typedef struct {
+    LogStream codec;           /**< 압축 인코더 (생산자) */
+    PreTriggerChunk *chunks;   /**< 조각 저장소 */
+    uint16_t chunk_count;      /**< 조각 수 */
+    uint16_t newest;           /**< 쌓는 중인 조각 */
+    uint16_t valid;            /**< 내용이 있는 조각 수 */
+    atomic_uint_fast32_t ack;  /**< 생산자가 멈춘 트리거 순번 */
+
+    uint16_t commit_next;      /**< 다음에 옮길 조각 (작성자) */
+    uint16_t commit_left;      /**< 남은 조각 수 (작성자) */
+    uint32_t commit_block;     /**< 마지막으로 스키마를 쓴 블록 순번 (작성자) */
+    bool commit_schema;        /**< 이번 옮기기에서 스키마를 썼는지 (작성자) */
+
+    uint32_t samples;          /**< 쌓은 샘플 수 */
+    uint32_t evicted;          /**< 링이 차서 버린 조각 수 */
+} PreTriggerStream;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t triggers;         /**< 받아들인 트리거 수 (옮기는 중 트리거는 무시) */
+    uint32_t commits;          /**< 옮기기를 마친 수 */
+    uint32_t chunks_written;   /**< 기록한 조각 수 */
+    uint32_t chunks_skipped;   /**< 보관 구간보다 오래되어 건너뛴 조각 수 */
+    uint32_t bytes_written;    /**< 기록한 바이트 (스키마 포함, 레코드 헤더 제외) */
+    uint32_t retries;          /**< 기록기가 밀려 다음 호출로 미룬 수 */
+} PreTriggerStats;
+
+/**
+ * @brief 사전 트리거 버퍼
+ */
+typedef struct {
+    PreTriggerConfig config;   /**< 설정 */
+    PreTriggerChunk imu_chunks[PRE_TRIGGER_IMU_CHUNKS];   /**< IMU 조각 저장소 */
+    PreTriggerChunk baro_chunks[PRE_TRIGGER_BARO_CHUNKS]; /**< 기압 조각 저장소 */
+    PreTriggerStream imu;      /**< IMU 스트림 */
+    PreTriggerStream baro;     /**< 기압 스트림 */
+
+    atomic_bool triggered;     /**< 트리거됨 (옮기기를 마치면 해제) */
+    atomic_uint_fast32_t seq;  /**< 트리거 순번 */
+    uint32_t trigger_us;       /**< 트리거 기준 시각 (us) */
+    bool committing;           /**< 옮기는 중 (작성자) */
+
+    PreTriggerStats stats;     /**< 통계 (작성자, triggers는 트리거 문맥) */
+    bool initialized;          /**< 초기화 여부 */
+} PreTrigger;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool pre_trigger_default_config(PreTriggerConfig *config);
+
+/**
+ * @brief 버퍼 초기화 (생산자 시작 전)
+ *
+ * @param pt 구조체 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool pre_trigger_init(PreTrigger *pt, const PreTriggerConfig *config);
+
+/**
+ * @brief IMU 샘플 쌓기 (IMU 생산자 문맥)
+ *
+ * @param pt 구조체 포인터
+ * @param sample IMU 샘플
+ */
+void pre_trigger_push_imu(PreTrigger *pt, const ImuSample *sample);
+
+/**
+ * @brief ImuRing 생산자 탭 (imu_ring_set_tap(ring, pre_trigger_imu_tap, pt))
+ *
+ * @param sample IMU 샘플
+ * @param context PreTrigger 포인터
+ */
+void pre_trigger_imu_tap(const ImuSample *sample, void *context);
+
+/**
+ * @brief 기압 샘플 쌓기 (기압계 읽기 문맥)
+ *
+ * @param pt 구조체 포인터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param pressure_pa 기압 (Pa)
+ * @param temp_c 센서 온도 (°C)
+ */
+void pre_trigger_push_baro(PreTrigger *pt, uint32_t timestamp_us, float pressure_pa, float temp_c);
+
+/**
+ * @brief 트리거 (어느 문맥에서나 호출 가능)
+ *
+ * @param pt 구조체 포인터
+ * @param timestamp_us 트리거 기준 시각 (us, 이 시각 window_us 전부터 옮김)
+ * @return bool 받아들였으면 true (이미 트리거되어 옮기는 중이면 false)
+ */
+bool pre_trigger_fire(PreTrigger *pt, uint32_t timestamp_us);
+
+/**
+ * @brief 비행 이벤트 콜백 (FlightEventFn, trigger_events 종류면 추정 발생 시각으로 트리거)
+ *
+ * @param event 비행 이벤트
+ * @param context PreTrigger 포인터
+ */
+void pre_trigger_event_callback(const FlightEvent *event, void *context);
+
+/**
+ * @brief 트리거된 보관분을 기록기로 옮김 (기록 작성자 문맥, 기다리지 않음)
+ *
+ * @param pt 구조체 포인터
+ * @param log 비행 기록
+ * @return bool 옮길 보관분이 남아 있으면 true
+ */
+bool pre_trigger_service(PreTrigger *pt, FlashLog *log);
+
+/**
+ * @brief 통계
+ *
+ * @param pt 구조체 포인터
+ * @return const PreTriggerStats* 통계 (NULL이면 NULL)
+ */
+const PreTriggerStats *pre_trigger_get_stats(const PreTrigger *pt);
+
+#endif /* PRE_TRIGGER_H */
@@ -0,0 +1,215 @@
+/**
+ * @file qspi_nor.h
+ * @brief QUADSPI 직렬 NOR 플래시 드라이버 (JEDEC 공통 명령, DMA 페이지 쓰기, 인터럽트 완료 대기)
+ *
+ * W25Q/MX25/IS25 계열의 24비트 주소 NOR 플래시를 간접 모드로 다룬다.
+ * 페이지 쓰기 데이터는 DMA로 보내고, 쓰기/지우기 완료는 상태 레지스터 WIP 비트를
+ * QUADSPI 자동 폴링(인터럽트)으로 기다리므로 CPU는 완료 콜백까지 다른 일을 한다.
+ * 명령만 있는 짧은 전송(쓰기 허용, 지우기 명령)은 수 us이므로 블로킹으로 보낸다.
+ *
+ * STM32L476은 QUADSPI만 있으므로 HAL_QSPI를 사용한다 (OCTOSPI 계열은 같은 명령
+ * 순서를 HAL_OSPI로 옮기면 된다). 데이터는 단일 선(1-1-1)으로 보내며, 페이지
+ * 쓰기 시간(수백 us)이 전송 시간보다 훨씬 길어 4선 쓰기의 이득이 작다.
+ *
+ * 읽기는 메모리 매핑 모드(qspi_nor_map)로도 할 수 있다. 매핑하면 장치 전체가 QSPI_BASE
+ * (0x90000000)부터 읽기 전용 메모리로 보여, 복호기가 명령 없이 포인터로 바로 읽는다
+ * (QUADSPI가 순차 접근을 미리 읽음). 쓰기/지우기/간접 읽기/완료 대기는 시작 전에 스스로
+ * 간접 모드로 돌아가며, 그 뒤 매핑 영역을 읽으면 버스 오류가 나므로 매핑 포인터는
+ * 다음 간접 명령 전까지만 유효하다.
+ *
+ * 지우기 일시 중지/재개(qspi_nor_erase_suspend/resume)는 초기화 때 JEDEC 제조사로 명령을 고른다
+ * (Winbond/ISSI 0x75/0x7A, Macronix 0xB0/0x30, 그 밖은 지원 안 함). 중지 중에는 지우는 섹터가 아닌
+ * 곳에 페이지 쓰기/읽기를 할 수 있고, 재개 뒤 WIP 해제가 지우기 완료이다. 이미 끝난 지우기를
+ * 중지/재개하는 명령은 장치가 무시하므로 호출자는 둘을 구분하지 않아도 된다.
+ *
+ * 완료 통지는 HAL 콜백에서 호출자가 이어받는다 (flash_log 참조):
+ * - HAL_QSPI_TxCpltCallback: 페이지 데이터 전송 완료 → qspi_nor_wait_ready_it
+ * - HAL_QSPI_StatusMatchCallback: WIP 해제 (쓰기/지우기 완료)
+ */
+
+#ifndef QSPI_NOR_H
+#define QSPI_NOR_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief NOR 플래시 배치
+ */
+#define QSPI_NOR_PAGE_SIZE 256u        /**< 페이지 쓰기 단위 (바이트) */
+#define QSPI_NOR_SECTOR_SIZE 4096u     /**< 섹터 지우기 단위 (바이트) */
+#define QSPI_NOR_BLOCK_SIZE 65536u     /**< 블록 지우기 단위 (바이트) */
+#define QSPI_NOR_MAX_SIZE (1u << 24)   /**< 24비트 주소 한계 (16 MB) */
+
+/**
+ * @brief JEDEC 공통 명령
+ */
+#define QSPI_NOR_CMD_WRITE_ENABLE 0x06
+#define QSPI_NOR_CMD_READ_STATUS 0x05
+#define QSPI_NOR_CMD_READ_JEDEC_ID 0x9F
+#define QSPI_NOR_CMD_FAST_READ 0x0B
+#define QSPI_NOR_CMD_PAGE_PROGRAM 0x02
+#define QSPI_NOR_CMD_SECTOR_ERASE 0x20
+#define QSPI_NOR_CMD_BLOCK_ERASE 0xD8
+
+/**
+ * @brief 지우기 일시 중지/재개 명령 (제조사별)
+ */
+#define QSPI_NOR_CMD_SUSPEND 0x75        /**< Winbond, ISSI */
+#define QSPI_NOR_CMD_RESUME 0x7A
+#define QSPI_NOR_CMD_SUSPEND_MX 0xB0     /**< Macronix */
+#define QSPI_NOR_CMD_RESUME_MX 0x30
+
+/**
+ * @brief JEDEC 제조사 코드
+ */
+#define QSPI_NOR_MFR_WINBOND 0xEF
+#define QSPI_NOR_MFR_MACRONIX 0xC2
+#define QSPI_NOR_MFR_ISSI 0x9D
+
+/**
+ * @brief 상태 레지스터 비트
+ */
+#define QSPI_NOR_STATUS_WIP 0x01       /**< 쓰기/지우기 진행 중 */
+#define QSPI_NOR_STATUS_WEL 0x02       /**< 쓰기 허용 래치 */
+
+/**
+ * @brief 메모리 매핑 시작 주소 (장치 주소 0)
+ */
+#define QSPI_NOR_MAP_BASE QSPI_BASE
+
+/**
+ * @brief 메모리 매핑 읽기가 끊긴 뒤 칩 선택을 놓는 시간 (QUADSPI 클록 수, 장치 대기 전류 절감)
+ */
+#define QSPI_NOR_MAP_TIMEOUT_CYCLES 64u
+
+/**
+ * @brief 블로킹 명령 시간 제한 (ms)
+ */
+#define QSPI_NOR_TIMEOUT_MS 10u
+
+/**
+ * @brief 블록 지우기 최대 시간 (ms, 블로킹 대기용)
+ */
+#define QSPI_NOR_ERASE_TIMEOUT_MS 3000u
+
+/**
+ * @brief 지우기 중지가 받아들여질 때까지 최대 시간 (ms, 데이터시트 tSUS 20~30 us)
+ */
+#define QSPI_NOR_SUSPEND_TIMEOUT_MS 1u
+
+/**
+ * @brief NOR 플래시 장치
+ */
+typedef struct {
+    QSPI_HandleTypeDef *hqspi; /**< QUADSPI 핸들 (간접 모드, TX DMA 연결) */
+    uint32_t size;             /**< 용량 (바이트, JEDEC ID 용량 코드) */
+    uint8_t jedec_id[3];       /**< 제조사, 메모리 종류, 용량 코드 */
+    bool mapped;               /**< 메모리 매핑 모드 */
+    uint8_t suspend_cmd;       /**< 지우기 중지 명령 (0이면 지원 안 함) */
+    uint8_t resume_cmd;        /**< 지우기 재개 명령 */
+    bool initialized;          /**< 초기화 여부 */
+} QspiNor;
+
+/**
+ * @brief 장치 확인 및 초기화 (블로킹)
+ *
+ * JEDEC ID를 읽어 용량을 구하고, 진행 중인 쓰기/지우기가 끝나기를 기다린다.
+ *
+ * @param nor 장치 구조체 포인터
+ * @param hqspi QUADSPI 핸들 (FlashSize는 장치 용량 이상으로 설정)
+ * @return bool 성공 여부 (응답이 없거나 용량이 24비트 주소 범위를 넘으면 false)
+ */
+bool qspi_nor_init(QspiNor *nor, QSPI_HandleTypeDef *hqspi);
+
+/**
+ * @brief 읽기 (블로킹, 비행 전/후 전용)
+ *
+ * @param nor 장치 구조체 포인터
+ * @param addr 시작 주소
+ * @param data 읽은 데이터
+ * @param len 길이 (바이트)
+ * @return bool 성공 여부
+ */
+bool qspi_nor_read(QspiNor *nor, uint32_t addr, uint8_t *data, uint32_t len);
+
+/**
+ * @brief 메모리 매핑 모드로 전환 (읽기 전용, 이미 매핑이면 그대로)
+ *
+ * 진행 중인 쓰기/지우기가 없을 때만 부른다 (장치가 바쁘면 읽은 값이 상태 값이 됨).
+ *
+ * @param nor 장치 구조체 포인터
+ * @return const uint8_t* 장치 주소 0의 포인터 (실패하면 NULL)
+ */
+const uint8_t *qspi_nor_map(QspiNor *nor);
+
+/**
+ * @brief 간접 모드로 복귀 (매핑이 아니면 아무것도 안 함)
+ *
+ * @param nor 장치 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool qspi_nor_unmap(QspiNor *nor);
+
+/**
+ * @brief 페이지 쓰기 시작 (DMA, 완료 시 HAL_QSPI_TxCpltCallback)
+ *
+ * 쓰기 허용 명령을 보낸 뒤 데이터를 DMA로 보낸다. 페이지 경계를 넘으면 안 된다.
+ * 데이터 전송 후에도 장치 내부 쓰기가 끝날 때까지 qspi_nor_wait_ready_it로 기다려야 한다.
+ *
+ * @param nor 장치 구조체 포인터
+ * @param addr 시작 주소
+ * @param data 데이터 (전송이 끝날 때까지 유지)
+ * @param len 길이 (1..QSPI_NOR_PAGE_SIZE 바이트)
+ * @return bool 시작 여부
+ */
+bool qspi_nor_program_page_dma(QspiNor *nor, uint32_t addr, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 지우기 시작 (섹터 또는 블록, 완료는 qspi_nor_wait_ready_it로 대기)
+ *
+ * @param nor 장치 구조체 포인터
+ * @param addr 지울 영역 시작 주소 (크기에 정렬)
+ * @param size QSPI_NOR_SECTOR_SIZE 또는 QSPI_NOR_BLOCK_SIZE
+ * @return bool 시작 여부
+ */
+bool qspi_nor_erase_start(QspiNor *nor, uint32_t addr, uint32_t size);
+
+/**
+ * @brief 진행 중인 지우기 일시 중지 (블로킹, 수십 us)
+ *
+ * 완료 대기 자동 폴링을 멈추고(인터럽트와 플래그도 지움) 중지 명령을 보낸 뒤 장치가 쓰기를
+ * 받을 수 있을 때까지 기다린다. 호출자는 QUADSPI 인터럽트가 끼어들지 않게 해야 한다.
+ *
+ * @param nor 장치 구조체 포인터
+ * @return bool 성공 여부 (지원하지 않는 장치이면 false)
+ */
+bool qspi_nor_erase_suspend(QspiNor *nor);
+
+/**
+ * @brief 중지한 지우기 재개 (명령만, 완료는 qspi_nor_wait_ready_it로 대기)
+ *
+ * @param nor 장치 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool qspi_nor_erase_resume(QspiNor *nor);
+
+/**
+ * @brief 완료 대기 시작 (자동 폴링 인터럽트, WIP 해제 시 HAL_QSPI_StatusMatchCallback)
+ *
+ * @param nor 장치 구조체 포인터
+ * @return bool 시작 여부
+ */
+bool qspi_nor_wait_ready_it(QspiNor *nor);
+
+/**
+ * @brief 완료 대기 (블로킹)
+ *
+ * @param nor 장치 구조체 포인터
+ * @param timeout_ms 시간 제한 (ms)
+ * @return bool 제한 시간 안에 끝났으면 true
+ */
+bool qspi_nor_wait_ready(QspiNor *nor, uint32_t timeout_ms);
+
+#endif /* QSPI_NOR_H */
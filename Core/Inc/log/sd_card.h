@@ -0,0 +1,128 @@
+/**
+ * @file sd_card.h
+ * @brief SDMMC SD 카드 드라이버 (다중 블록 DMA 쓰기, 카드 상태 폴링 완료 확인)
+ *
+ * 512바이트 블록 번호(LBA)로 다룬다. SDSC 카드의 바이트 주소 변환은 HAL이 한다.
+ * 다중 블록 쓰기 데이터는 DMA로 보내며 HAL_SD_TxCpltCallback은 데이터 전송과
+ * 정지 명령이 끝났다는 뜻일 뿐, 카드는 그 뒤에도 내부 기록(programming 상태)을
+ * 계속할 수 있다. 다음 명령 전에는 sd_card_ready로 전송(transfer) 상태를 확인해야 한다
+ * (CMD13 한 번, 수 us).
+ *
+ * CubeMX: SDMMC1 4비트 버스, SDMMC1 DMA(TX/RX 같은 채널은 HAL이 방향을 바꿈), SDMMC1 전역
+ * 인터럽트 활성화. 완료 통지는 HAL 콜백에서 호출자가 이어받는다 (flash_log 참조).
+ *
+ * BOARD_HAS_SD_CARD가 0인 보드(sys/board_profile.h)에서는 SD HAL 모듈이 빠지므로 모든 API가
+ * false를 돌려주는 인라인 함수로 컴파일되고, flash_log의 SD 저장소는 초기화에서 거부된다.
+ */
+
+#ifndef SD_CARD_H
+#define SD_CARD_H
+
+#include "sys/board_profile.h"
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief SD 블록 크기 (바이트)
+ */
+#define SD_CARD_BLOCK_SIZE 512u
+
+/**
+ * @brief 블로킹 읽기 시간 제한 (ms)
+ */
+#define SD_CARD_TIMEOUT_MS 100u
+
+/**
+ * @brief SDMMC 핸들 (SD 카드가 없는 보드에서는 불완전 형식)
+ */
+#if BOARD_HAS_SD_CARD
+typedef SD_HandleTypeDef SdCardHandle;
+#else
+typedef struct SdCardAbsent SdCardHandle;
+#endif
+
+/**
+ * @brief SD 카드 장치
+ */
+typedef struct {
+    SdCardHandle *hsd;         /**< SDMMC 핸들 (HAL_SD_Init 완료) */
+    uint32_t block_count;      /**< 용량 (블록) */
+    uint32_t write_errors;     /**< 쓰기 시작 실패 수 */
+    bool initialized;          /**< 초기화 여부 */
+} SdCard;
+
+/**
+ * @brief 장치 확인 및 초기화 (블로킹)
+ *
+ * 카드 정보를 읽어 용량을 구하고, 논리 블록이 512바이트인지 확인한다.
+ *
+ * @param sd 장치 구조체 포인터
+ * @param hsd SDMMC 핸들 (HAL_SD_Init 완료, 4비트 버스 권장)
+ * @return bool 성공 여부
+ */
+#if BOARD_HAS_SD_CARD
+
+bool sd_card_init(SdCard *sd, SdCardHandle *hsd);
+
+/**
+ * @brief 블록 읽기 (블로킹, 비행 전 초기화용)
+ *
+ * @param sd 장치 구조체 포인터
+ * @param lba 시작 블록 번호
+ * @param data 읽은 데이터 (count * 512바이트, 4바이트 정렬)
+ * @param count 블록 수
+ * @return bool 성공 여부
+ */
+bool sd_card_read(SdCard *sd, uint32_t lba, uint8_t *data, uint32_t count);
+
+/**
+ * @brief 다중 블록 DMA 쓰기 시작
+ *
+ * 완료는 HAL_SD_TxCpltCallback, 이후 카드 내부 기록 완료는 sd_card_ready로 확인한다.
+ *
+ * @param sd 장치 구조체 포인터
+ * @param lba 시작 블록 번호
+ * @param data 데이터 (count * 512바이트, 4바이트 정렬, 완료 때까지 유지)
+ * @param count 블록 수
+ * @return bool 시작 여부
+ */
+bool sd_card_write_dma(SdCard *sd, uint32_t lba, const uint8_t *data, uint32_t count);
+
+/**
+ * @brief 블록 지우기 시작 (CMD32/33/38, 완료는 sd_card_ready)
+ *
+ * 미리 지운 영역은 카드가 쓰기 때 지우기를 끼워 넣지 않으므로 쓰기 지연이 줄어든다.
+ *
+ * @param sd 장치 구조체 포인터
+ * @param lba 시작 블록 번호
+ * @param count 블록 수
+ * @return bool 시작 여부
+ */
+bool sd_card_erase_start(SdCard *sd, uint32_t lba, uint32_t count);
+
+/**
+ * @brief 다음 명령을 받을 수 있는지 (HAL 유휴, 카드 전송 상태)
+ *
+ * @param sd 장치 구조체 포인터
+ * @return bool 준비되었으면 true (쓰기/지우기 진행 중이면 false)
+ */
+bool sd_card_ready(SdCard *sd);
+
+#else /* BOARD_HAS_SD_CARD */
+
+static inline bool sd_card_init(SdCard *sd, SdCardHandle *hsd) { (void)sd; (void)hsd; return false; }
+static inline bool sd_card_read(SdCard *sd, uint32_t lba, uint8_t *data, uint32_t count) {
+    (void)sd; (void)lba; (void)data; (void)count; return false;
+}
+static inline bool sd_card_write_dma(SdCard *sd, uint32_t lba, const uint8_t *data, uint32_t count) {
+    (void)sd; (void)lba; (void)data; (void)count; return false;
+}
+static inline bool sd_card_erase_start(SdCard *sd, uint32_t lba, uint32_t count) {
+    (void)sd; (void)lba; (void)count; return false;
+}
+static inline bool sd_card_ready(SdCard *sd) { (void)sd; return false; }
+
+#endif /* BOARD_HAS_SD_CARD */
+
+#endif /* SD_CARD_H */
@@ -0,0 +1,54 @@
+/**
+ * @file sd_file.h
+ * @brief FAT32 미리 할당된 연속 파일 찾기 (초기화 때 한 번, 기록 중에는 파일 시스템을 쓰지 않음)
+ *
+ * 비행 기록은 파일 시스템을 거치지 않고 연속 블록에 바로 쓴다. 카드에는 호스트가
+ * 미리 만든 고정 크기 파일이 있어야 하며, 초기화 때 MBR/BPB/루트 디렉터리/FAT를 읽어
+ * 파일의 시작 블록과 길이를 구하고 클러스터 사슬이 끊김 없이 이어지는지 확인한다.
+ * 기록은 파일 안의 블록만 덮어쓰고 디렉터리 항목과 FAT는 건드리지 않으므로, 비행 후
+ * 카드를 PC에 꽂으면 같은 파일로 그대로 읽힌다 (Tools/log/log_decode.c).
+ *
+ * 파일 준비 (FAT32로 새로 포맷한 카드, 빈 카드에 처음 쓰는 파일은 연속 할당됨):
+ * @verbatim
+ *   dd if=/dev/zero of=/media/sd/POLARIS.LOG bs=1M count=1024
+ * @endverbatim
+ * 0으로 채워 두면 이전 기록이 남지 않아 기록기가 끝 위치를 이분 탐색으로 찾을 수 있다.
+ */
+
+#ifndef SD_FILE_H
+#define SD_FILE_H
+
+#include "log/sd_card.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 8.3 파일 이름 길이 (공백 채움, 점 없음)
+ */
+#define SD_FILE_NAME_SIZE 11
+
+/**
+ * @brief 기본 기록 파일 이름 ("POLARIS.LOG")
+ */
+#define SD_FILE_DEFAULT_NAME "POLARIS LOG"
+
+/**
+ * @brief 연속 파일 위치
+ */
+typedef struct {
+    uint32_t first_lba;        /**< 파일 시작 블록 */
+    uint32_t block_count;      /**< 파일 길이 (블록, 512바이트 단위로 내림) */
+    uint32_t size;             /**< 파일 길이 (바이트) */
+} SdFile;
+
+/**
+ * @brief 루트 디렉터리에서 연속 파일 찾기 (블로킹, 비행 전)
+ *
+ * @param sd 초기화된 SD 카드
+ * @param name 8.3 이름 (SD_FILE_NAME_SIZE자, 대문자, 공백 채움)
+ * @param file 찾은 파일 위치
+ * @return bool 찾았고 연속이면 true (FAT32가 아니거나, 없거나, 조각나 있으면 false)
+ */
+bool sd_file_find(SdCard *sd, const char *name, SdFile *file);
+
+#endif /* SD_FILE_H */
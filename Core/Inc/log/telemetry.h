@@ -0,0 +1,278 @@
+/**
+ * @file telemetry.h
+ * @brief 항법 해 텔레메트리 하향 링크 (우선순위/주기별 필드 묶음, 고정 길이 프레임, UART DMA 송신)
+ *
+ * 융합 태스크는 nav_publisher에 스냅샷을 게시하는 것 말고는 아무 일도 하지 않는다.
+ * 저우선순위 태스크가 telemetry_service를 주기 호출하면 프레임 주기마다 최신 스냅샷을
+ * 무잠금으로 읽어 프레임을 만들고 HAL_UART_Transmit_DMA로 보낸다. 송신이 끝나지 않았으면
+ * 그 주기는 건너뛰며 기다리지 않는다.
+ *
+ * 프레임은 telemetry_frame 형식(종류 TELEMETRY_TYPE_NAV)이며 페이로드는 항상
+ * TELEMETRY_NAV_PAYLOAD_SIZE 바이트이다 (무선 모뎀의 고정 패킷 길이에 맞춤):
+ * @verbatim
+ *   t_us(u32) | mask(u16) | mask 비트 순서대로 묶음 | 0 채움
+ * @endverbatim
+ * 묶음 (리틀 엔디언):
+ * - ATTITUDE (4): smallest-three 사원수 (상위 2비트 = 가장 큰 성분 번호, 나머지 세 성분 10비트씩)
+ * - POSITION (12): 위치 xyz int32 (0.01 m)
+ * - VELOCITY (6): 속도 xyz int16 (0.05 m/s, ±1638 m/s)
+ * - COVARIANCE (4): 수평/수직 위치, 속도, 자세 표준 편차 u8 로그 눈금 (telemetry_encode_std)
+ * - APOGEE (6): 정점까지 시간 u16 (0.01 s), 예측 정점 고도 int32 (0.01 m)
+ * - BIAS (12): 자이로 바이어스 xyz int16 (1e-5 rad/s), 가속도 바이어스 xyz int16 (1e-3 m/s^2)
+ * - LOAD (8): 융합 부하 감시기 (fusion_monitor.h) 현재 단계 통계. 단계 u8, 마지막/최대 사이클
+ *   부하율 u8 x 2 (%, 255 포화), 최대 사이클 처리 시간 u16 (us), 지연 99% 분위 히스토그램 칸 u8,
+ *   마감 초과 샘플 수 u16 (포화). 감시기가 설정되지 않으면 보내지 않는다.
+ * - READY (13): 수렴 감시기 (convergence_monitor.h). 수렴 블록 u8 (ConvergenceBlock 비트,
+ *   bit7 = 준비), 첫 준비까지 시간 u16, 블록별 첫 수렴까지 시간 u16 x 5 (0.1 s, 0xFFFF = 아직,
+ *   포화 0xFFFE). 감시기가 설정되지 않으면 보내지 않는다.
+ * - LANDING (11): 착지 예측기 (landing_predictor.h). 예측 착지 지점 xy int16 (1 m, 포화),
+ *   착지까지 시간 u16 (0.1 s), 바람 xy int16 (0.05 m/s), 착지 지점 수평 표준 편차 u8 로그 눈금
+ *   (TELEMETRY_STD_BASE_LAND). 예측기가 설정되지 않았거나 결과가 유효하지 않으면 보내지 않는다.
+ * - HIL (10): HIL 센서 공급기 (hil_feed.h). 중계 링 사용량/최대 사용량 u8 x 2, 받은 프레임 수
+ *   u16 (순환), 늦은 IMU 레코드 u16, 버린 레코드(중계 링 + 측정 대기열) u16, 오류(CRC, 레코드,
+ *   잃은 프레임, UART) u16 (포화). 공급기가 설정되지 않으면 보내지 않는다.
+ * - VIBE (19): IMU 진동/포화 통계 (imu_vibration.h) 마지막 창. 가속도 진동 RMS xyz u16
+ *   (0.01 m/s^2), 자이로 진동 RMS xyz u16 (1e-3 rad/s), 가속도/자이로 |값| 최대(세 축 중 최대)
+ *   u16 x 2 (0.1 m/s^2, 0.01 rad/s), 창에서 포화된 축 u8 (bit0..2 자이로 xyz, bit3..5 가속도 xyz),
+ *   누적 포화 u16 (포화). 통계가 설정되지 않았거나 창이 아직 없으면 보내지 않는다.
+ * - NIS (12): 혁신 감시기 (innovation_monitor.h) 마지막 창에서 평균 NIS / 측정 차원이 가장 큰
+ *   두 측정. 측정마다 EKF_Sensor u8 (0xFF = 없음), NIS 수 u8, 거부 수 u8 (포화), 평균/표준 편차/최대
+ *   NIS u8 x 3 로그 눈금 (TELEMETRY_STD_BASE_NIS). 감시기가 설정되지 않았거나 창이 아직 없으면
+ *   보내지 않는다.
+ *
+ * 묶음마다 주기와 우선순위를 정한다. 매 프레임 주기가 된 묶음을 우선순위 순서로
+ * 넣고, 자리가 남으면 아직 주기가 안 된 묶음도 우선순위 순서로 앞당겨 넣는다.
+ * 자리가 없어 밀린 묶음은 다음 프레임에서 먼저 들어간다. 묶음 번호, 크기, 눈금은 지상국과 함께 쓰는
+ * log/telemetry_format.h에 있다.
+ *
+ * 연결 예 (CubeMX: USART TX DMA 일반 모드, USART 전역 인터럽트 활성화):
+ * - HAL_UART_TxCpltCallback: telemetry_handle_tx_complete(&tm)
+ * - HAL_UART_ErrorCallback: telemetry_handle_uart_error(&tm)
+ * - 저우선순위 태스크: telemetry_service(&tm, now_us)
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "stm32l4xx_hal.h"
+#include "log/telemetry_frame.h"
+#include "nav/nav_publisher.h"
+#include "nav/convergence_monitor.h"
+#include "nav/fusion_monitor.h"
+#include "nav/landing_predictor.h"
+#include "nav/innovation_monitor.h"
+#include "sensors/hil_feed.h"
+#include "sensors/imu_vibration.h"
+#include "math/quaternion.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 묶음 전송 설정
+ */
+typedef struct {
+    float rate_hz;             /**< 목표 전송률 (Hz, 0 이하이면 보내지 않음) */
+    uint8_t priority;          /**< 우선순위 (작을수록 먼저) */
+} TelemetryGroupConfig;
+
+/**
+ * @brief 텔레메트리 설정
+ */
+typedef struct {
+    uint32_t frame_period_us;  /**< 프레임 주기 (us, 링크 대역폭 / 프레임 크기 이하) */
+    TelemetryGroupConfig group[TELEMETRY_GROUP_COUNT]; /**< 묶음별 설정 */
+} TelemetryConfig;
+
+/**
+ * @brief 텔레메트리 하향 링크
+ */
+typedef struct {
+    UART_HandleTypeDef *huart; /**< UART 핸들 (TX DMA) */
+    const NavPublisher *pub;   /**< 항법 해 게시 버퍼 */
+    const FusionMonitor *monitor; /**< 융합 부하 감시기 (NULL이면 LOAD 묶음 안 보냄) */
+    const ConvergenceMonitor *convergence; /**< 수렴 감시기 (NULL이면 READY 묶음 안 보냄) */
+    const LandingPredictor *landing; /**< 착지 예측기 (NULL이면 LANDING 묶음 안 보냄) */
+    const HilFeed *hil;        /**< HIL 공급기 (NULL이면 HIL 묶음 안 보냄) */
+    const ImuVibration *vibration; /**< IMU 진동 통계 (NULL이면 VIBE 묶음 안 보냄) */
+    const InnovationMonitor *innovation; /**< 혁신 감시기 (NULL이면 NIS 묶음 안 보냄) */
+    TelemetryFramer framer;    /**< 프레임 조립기 */
+    TelemetryConfig config;    /**< 설정 */
+
+    uint8_t order[TELEMETRY_GROUP_COUNT];      /**< 우선순위 순서의 묶음 번호 */
+    uint32_t period_us[TELEMETRY_GROUP_COUNT]; /**< 묶음 주기 (us, 0이면 보내지 않음) */
+    uint32_t last_us[TELEMETRY_GROUP_COUNT];   /**< 마지막 전송 시각 (us) */
+    uint16_t sent_mask;                        /**< 한 번이라도 보낸 묶음 */
+
+    uint8_t tx_buffer[TELEMETRY_NAV_FRAME_SIZE] __attribute__((aligned(4))); /**< 송신 프레임 */
+    atomic_flag tx_busy;       /**< DMA 송신 중 */
+    uint32_t last_frame_us;    /**< 마지막 프레임 시각 (us) */
+    bool started;              /**< 첫 프레임을 보냈는지 */
+
+    uint32_t frames;           /**< 보낸 프레임 수 */
+    uint32_t busy_skips;       /**< 송신 중이라 건너뛴 프레임 주기 수 */
+    uint32_t deferred;         /**< 자리가 없어 밀린 묶음 수 */
+    uint32_t group_count[TELEMETRY_GROUP_COUNT]; /**< 묶음별 전송 수 */
+    uint32_t uart_errors;      /**< UART 송신 오류 수 */
+    bool initialized;          /**< 초기화 여부 */
+} Telemetry;
+
+/**
+ * @brief 기본 설정 (20 Hz 프레임, 자세/속도 20 Hz, 위치 10 Hz, 정점 5 Hz, 공분산 2 Hz,
+ *        HIL 2 Hz, 바이어스/부하/착지/진동 1 Hz, 준비 0.5 Hz)
+ *
+ * 프레임 42바이트 x 20 Hz = 840 B/s로 9600 bps 무선 모뎀에도 들어간다.
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool telemetry_default_config(TelemetryConfig *config);
+
+/**
+ * @brief 텔레메트리 초기화
+ *
+ * @param tm 구조체 포인터
+ * @param huart UART 핸들 (TX DMA)
+ * @param pub 항법 해 게시 버퍼
+ * @param crc 프레임 CRC 주변장치 (NULL이면 소프트웨어)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool telemetry_init(Telemetry *tm, UART_HandleTypeDef *huart, const NavPublisher *pub, HwCrc *crc,
+                    const TelemetryConfig *config);
+
+/**
+ * @brief 융합 부하 감시기 설정 (LOAD 묶음 출처)
+ *
+ * 감시기는 융합 태스크가 쓰고 텔레메트리 태스크가 잠금 없이 읽는다.
+ *
+ * @param tm 구조체 포인터
+ * @param monitor 감시기 (NULL이면 LOAD 묶음 중지)
+ * @return bool 성공 여부
+ */
+bool telemetry_set_monitor(Telemetry *tm, const FusionMonitor *monitor);
+
+/**
+ * @brief 수렴 감시기 설정 (READY 묶음 출처)
+ *
+ * @param tm 구조체 포인터
+ * @param convergence 감시기 (NULL이면 READY 묶음 중지)
+ * @return bool 성공 여부
+ */
+bool telemetry_set_convergence(Telemetry *tm, const ConvergenceMonitor *convergence);
+
+/**
+ * @brief 착지 예측기 설정 (LANDING 묶음 출처)
+ *
+ * 예측기는 telemetry_service를 부르는 태스크에서 갱신해야 잠금 없이 읽을 수 있다.
+ *
+ * @param tm 구조체 포인터
+ * @param landing 예측기 (NULL이면 LANDING 묶음 중지)
+ * @return bool 성공 여부
+ */
+bool telemetry_set_landing(Telemetry *tm, const LandingPredictor *landing);
+
+/**
+ * @brief HIL 공급기 설정 (HIL 묶음 출처)
+ *
+ * 통계는 인터럽트가 갱신하므로 묶음 하나 안에서 값끼리 시점이 조금 어긋날 수 있다.
+ *
+ * @param tm 구조체 포인터
+ * @param hil 공급기 (NULL이면 HIL 묶음 중지)
+ * @return bool 성공 여부
+ */
+bool telemetry_set_hil(Telemetry *tm, const HilFeed *hil);
+
+/**
+ * @brief IMU 진동 통계 설정 (VIBE 묶음 출처)
+ *
+ * 통계는 IMU 드라이버 인터럽트가 두 벌로 게시하므로 잠금 없이 읽는다.
+ *
+ * @param tm 구조체 포인터
+ * @param vibration 통계 (NULL이면 VIBE 묶음 중지)
+ * @return bool 성공 여부
+ */
+bool telemetry_set_vibration(Telemetry *tm, const ImuVibration *vibration);
+
+/**
+ * @brief 혁신 감시기 설정 (NIS 묶음 출처)
+ *
+ * 감시기는 융합 태스크가 두 벌로 게시하므로 잠금 없이 읽는다.
+ *
+ * @param tm 구조체 포인터
+ * @param innovation 감시기 (NULL이면 NIS 묶음 중지)
+ * @return bool 성공 여부
+ */
+bool telemetry_set_innovation(Telemetry *tm, const InnovationMonitor *innovation);
+
+/**
+ * @brief 프레임 주기가 되었으면 프레임을 만들어 송신 시작 (저우선순위 태스크, 기다리지 않음)
+ *
+ * @param tm 구조체 포인터
+ * @param now_us 현재 시각 (us)
+ * @return bool 이번 호출에서 송신을 시작했으면 true
+ */
+bool telemetry_service(Telemetry *tm, uint32_t now_us);
+
+/**
+ * @brief 항법 해 페이로드 만들기 (묶음 선택과 전송 시각 갱신 포함)
+ *
+ * telemetry_service가 쓰며, UART가 아닌 송신 경로(SPI 무선 모뎀 등)에서도 쓸 수 있다.
+ *
+ * @param tm 구조체 포인터
+ * @param sol 항법 해 스냅샷
+ * @param now_us 현재 시각 (us, 묶음 주기 판단)
+ * @param payload 페이로드 버퍼 (TELEMETRY_NAV_PAYLOAD_SIZE 바이트)
+ * @return uint16_t 넣은 묶음 mask
+ */
+uint16_t telemetry_build_nav(Telemetry *tm, const EKF_NavSolution *sol, uint32_t now_us, uint8_t *payload);
+
+/**
+ * @brief DMA 송신 완료 처리 (HAL_UART_TxCpltCallback)
+ *
+ * @param tm 구조체 포인터
+ */
+void telemetry_handle_tx_complete(Telemetry *tm);
+
+/**
+ * @brief UART 오류 처리 (HAL_UART_ErrorCallback, 진행 중 프레임은 버림)
+ *
+ * @param tm 구조체 포인터
+ */
+void telemetry_handle_uart_error(Telemetry *tm);
+
+/**
+ * @brief 사원수 smallest-three 부호화 (q와 -q는 같은 값)
+ *
+ * @param q 정규화된 사원수
+ * @return uint32_t 부호 (상위 2비트 = 가장 큰 성분, 10비트 x 3)
+ */
+uint32_t telemetry_encode_quat(Quaternion q);
+
+/**
+ * @brief 사원수 smallest-three 복호화 (성분 오차 약 1.4e-3)
+ *
+ * @param code telemetry_encode_quat 결과
+ * @return Quaternion 정규화된 사원수 (가장 큰 성분이 양수)
+ */
+Quaternion telemetry_decode_quat(uint32_t code);
+
+/**
+ * @brief 표준 편차 로그 눈금 부호화: round(16 log2(std / base)), 0..255로 제한
+ *
+ * @param std 표준 편차
+ * @param base 기준값 (TELEMETRY_STD_BASE_*)
+ * @return uint8_t 부호
+ */
+uint8_t telemetry_encode_std(float std, float base);
+
+/**
+ * @brief 표준 편차 로그 눈금 복호화: base * 2^(code / 16)
+ *
+ * @param code 부호
+ * @param base 기준값
+ * @return float 표준 편차
+ */
+float telemetry_decode_std(uint8_t code, float base);
+
+#endif /* TELEMETRY_H */
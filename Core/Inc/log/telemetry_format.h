@@ -0,0 +1,114 @@
+/**
+ * @file telemetry_format.h
+ * @brief 텔레메트리 프레임과 항법 해 페이로드 형식 (동기/헤더 상수, 묶음 번호와 크기, 고정소수점 눈금)
+ *
+ * 펌웨어 조립기(telemetry_frame.h, telemetry.h)와 지상국 복원기(Tools/ground/ground_decode.h)가
+ * 함께 포함한다. HAL과 다른 펌웨어 헤더에 의존하지 않는다. 프레임/묶음 배치 설명은
+ * telemetry_frame.h와 telemetry.h에 있으며, 묶음을 추가하거나 눈금을 바꾸면 이 파일과
+ * 부호기(Core/Src/log/telemetry.c), 복원기(ground_nav_decode)를 함께 고친다.
+ */
+
+#ifndef TELEMETRY_FORMAT_H
+#define TELEMETRY_FORMAT_H
+
+#include <stdint.h>
+
+/**
+ * @brief 프레임 동기 바이트
+ */
+#define TELEMETRY_FRAME_SYNC1 0xA5u
+#define TELEMETRY_FRAME_SYNC2 0x5Au
+
+/**
+ * @brief 프레임 헤더/꼬리 크기 (동기 2, 길이, 종류, 순번 2 / CRC 4)
+ */
+#define TELEMETRY_FRAME_HEADER 6u
+#define TELEMETRY_FRAME_TRAILER 4u
+
+/**
+ * @brief 최대 페이로드와 프레임 크기 (바이트)
+ */
+#define TELEMETRY_FRAME_MAX_PAYLOAD 255u
+#define TELEMETRY_FRAME_MAX_SIZE (TELEMETRY_FRAME_HEADER + TELEMETRY_FRAME_MAX_PAYLOAD + TELEMETRY_FRAME_TRAILER)
+
+/**
+ * @brief 항법 해 프레임 종류
+ */
+#define TELEMETRY_TYPE_NAV 0x01u
+
+/**
+ * @brief 항법 해 프레임 페이로드 크기 (바이트, 고정)
+ */
+#define TELEMETRY_NAV_PAYLOAD_SIZE 32u
+
+/**
+ * @brief 항법 해 프레임 헤더 크기 (t_us, mask)
+ */
+#define TELEMETRY_NAV_HEADER_SIZE 6u
+
+/**
+ * @brief 프레임 크기 (바이트)
+ */
+#define TELEMETRY_NAV_FRAME_SIZE (TELEMETRY_FRAME_HEADER + TELEMETRY_NAV_PAYLOAD_SIZE + TELEMETRY_FRAME_TRAILER)
+
+/**
+ * @brief 표준 편차 로그 눈금 기준값 (부호 0의 값, 한 단계 = 2^(1/16), 약 4.4%)
+ */
+#define TELEMETRY_STD_BASE_POS 0.01f     /**< 위치 (m, 0.01..655 m) */
+#define TELEMETRY_STD_BASE_VEL 0.001f    /**< 속도 (m/s, 0.001..65 m/s) */
+#define TELEMETRY_STD_BASE_ATT 1e-4f     /**< 자세 (rad, 1e-4..6.5 rad) */
+#define TELEMETRY_STD_BASE_LAND 0.1f     /**< 착지 지점 (m, 0.1..6550 m) */
+#define TELEMETRY_STD_BASE_NIS 0.01f     /**< NIS 통계 (무차원, 0.01..655) */
+
+/**
+ * @brief 필드 묶음 (mask 비트 번호 = 페이로드 순서)
+ */
+typedef enum {
+    TELEMETRY_GROUP_ATTITUDE = 0, /**< 자세 사원수 */
+    TELEMETRY_GROUP_POSITION,     /**< 위치 */
+    TELEMETRY_GROUP_VELOCITY,     /**< 속도 */
+    TELEMETRY_GROUP_COVARIANCE,   /**< 표준 편차 요약 */
+    TELEMETRY_GROUP_APOGEE,       /**< 정점 예측 */
+    TELEMETRY_GROUP_BIAS,         /**< IMU 바이어스 */
+    TELEMETRY_GROUP_LOAD,         /**< 융합 부하/마감 초과 */
+    TELEMETRY_GROUP_READY,        /**< 수렴/준비 시각 */
+    TELEMETRY_GROUP_LANDING,      /**< 착지 지점 예측 */
+    TELEMETRY_GROUP_HIL,          /**< HIL 공급기 상태 */
+    TELEMETRY_GROUP_VIBE,         /**< IMU 진동/포화 */
+    TELEMETRY_GROUP_NIS,          /**< 혁신 NIS 통계 */
+    TELEMETRY_GROUP_COUNT
+} TelemetryGroup;
+
+/**
+ * @brief 묶음 크기 (바이트, TelemetryGroup 순서, 배열 초기값)
+ */
+#define TELEMETRY_GROUP_SIZES { 4, 12, 6, 4, 6, 12, 8, 13, 11, 10, 19, 12 }
+
+/**
+ * @brief READY 묶음의 블록별 수렴 시각 수 (ConvergenceBlock 수)
+ */
+#define TELEMETRY_READY_BLOCKS 5u
+
+/**
+ * @brief smallest-three 성분 범위와 눈금 (|나머지 성분| <= 1/sqrt(2), 10비트)
+ */
+#define TELEMETRY_QUAT_RANGE 0.70710678f
+#define TELEMETRY_QUAT_HALF 511
+
+/**
+ * @brief 고정소수점 눈금
+ */
+#define TELEMETRY_POS_LSB 0.01f          /**< m */
+#define TELEMETRY_VEL_LSB 0.05f          /**< m/s */
+#define TELEMETRY_APOGEE_TIME_LSB 0.01f  /**< s */
+#define TELEMETRY_GYRO_BIAS_LSB 1e-5f    /**< rad/s */
+#define TELEMETRY_ACCEL_BIAS_LSB 1e-3f   /**< m/s^2 */
+#define TELEMETRY_READY_TIME_LSB_US 100000u /**< us (0.1 s) */
+#define TELEMETRY_LAND_POS_LSB 1.0f      /**< m */
+#define TELEMETRY_LAND_TIME_LSB 0.1f     /**< s */
+#define TELEMETRY_VIBE_ACCEL_LSB 0.01f   /**< m/s^2 (진동 RMS) */
+#define TELEMETRY_VIBE_GYRO_LSB 1e-3f    /**< rad/s (진동 RMS) */
+#define TELEMETRY_PEAK_ACCEL_LSB 0.1f    /**< m/s^2 */
+#define TELEMETRY_PEAK_GYRO_LSB 0.01f    /**< rad/s */
+
+#endif /* TELEMETRY_FORMAT_H */
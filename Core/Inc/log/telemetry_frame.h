@@ -0,0 +1,72 @@
+/**
+ * @file telemetry_frame.h
+ * @brief 텔레메트리 프레임 (동기 바이트, 순번, CRC-32)
+ *
+ * 프레임 형식 (리틀 엔디언):
+ * @verbatim
+ *   0xA5 0x5A | len(u8) | type(u8) | seq(u16) | payload[len] | crc32(u32)
+ * @endverbatim
+ * CRC-32(zlib 호환)는 len부터 payload 끝까지를 덮으며 CRC 주변장치(sys/hw_crc.h)로
+ * 계산한다. seq는 프레임마다 1씩 늘어나므로(종류와 무관) 수신 측은 순번 차로 잃은
+ * 프레임 수를 바로 알 수 있고, CRC가 맞지 않으면 다음 동기 바이트부터 다시 찾는다.
+ *
+ * 동기/헤더 상수는 지상국과 함께 쓰는 log/telemetry_format.h에 있다.
+ *
+ * 프레임 조립은 한 문맥(텔레메트리 태스크)에서만 호출해야 한다.
+ */
+
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include "log/telemetry_format.h"
+#include "sys/hw_crc.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 프레임 조립기
+ */
+typedef struct {
+    HwCrc *crc;                /**< CRC 주변장치 (NULL이면 소프트웨어) */
+    uint16_t seq;              /**< 다음 프레임 순번 */
+    uint32_t frames;           /**< 조립한 프레임 수 */
+} TelemetryFramer;
+
+/**
+ * @brief 프레임 조립기 초기화
+ *
+ * @param framer 조립기 구조체 포인터
+ * @param crc CRC 주변장치 (NULL이면 소프트웨어)
+ * @return bool 성공 여부
+ */
+bool telemetry_frame_init(TelemetryFramer *framer, HwCrc *crc);
+
+/**
+ * @brief 프레임 조립
+ *
+ * @param framer 조립기 구조체 포인터
+ * @param type 프레임 종류
+ * @param payload 페이로드 (len이 0이면 NULL 가능)
+ * @param len 페이로드 길이 (TELEMETRY_FRAME_MAX_PAYLOAD 이하)
+ * @param out 프레임 버퍼
+ * @param out_size 프레임 버퍼 크기 (len + 10 이상)
+ * @return uint16_t 프레임 길이 (실패 시 0)
+ */
+uint16_t telemetry_frame_pack(TelemetryFramer *framer, uint8_t type, const void *payload, uint8_t len,
+                              uint8_t *out, uint16_t out_size);
+
+/**
+ * @brief 수신 프레임 검사 (지상국 중계, 상향 링크 등)
+ *
+ * @param crc CRC 주변장치 (NULL이면 소프트웨어)
+ * @param frame 동기 바이트로 시작하는 프레임
+ * @param size 버퍼에 있는 바이트 수
+ * @param type 프레임 종류 (NULL 가능)
+ * @param seq 프레임 순번 (NULL 가능)
+ * @param payload_len 페이로드 길이 (NULL 가능, 페이로드는 frame + TELEMETRY_FRAME_HEADER)
+ * @return uint16_t 유효한 프레임 길이 (동기/길이/CRC가 맞지 않으면 0)
+ */
+uint16_t telemetry_frame_check(HwCrc *crc, const uint8_t *frame, uint16_t size,
+                               uint8_t *type, uint16_t *seq, uint8_t *payload_len);
+
+#endif /* TELEMETRY_FRAME_H */
@@ -0,0 +1,310 @@
+/**
+ * @file usb_download.h
+ * @brief 비행 후 기록 내려받기 (USB CDC ACM, 64바이트 벌크 다중 패킷 전송, 이어받기 가능한 블록 요청)
+ *
+ * 비행 기록(log/flash_log.h)을 USB 전속(FS) 가상 직렬 포트로 내려받는다. OTG_FS는 HAL_PCD로
+ * 직접 다루며 USB 미들웨어 없이 CDC ACM에 필요한 표준/클래스 요청만 처리한다. 호스트는 별도
+ * 드라이버 없이 /dev/ttyACM* 또는 COM 포트로 연다 (호스트 프로그램: Tools/log/log_fetch.c).
+ *
+ * - 전송: 블록 하나(4 KB)를 프레임 헤더와 함께 벌크 IN 전송 한 번으로 보낸다. HAL이 64바이트
+ *   패킷으로 나누어 TX FIFO를 채우므로 CPU는 프레임마다 인터럽트 한 번만 처리한다. 프레임
+ *   버퍼는 두 개이며, 한 버퍼를 보내는 동안 usb_download_service가 다음 블록을 저장소에서 읽는다.
+ *   OTG_FS에는 DMA가 없으므로 FIFO 채우기는 HAL의 TXFE 인터럽트가 맡는다.
+ * - 명령 (호스트 -> 장치, 벌크 OUT, UsbDownloadCommand 12바이트):
+ *   - INFO: 저장 블록 수와 현재 세션 (INFO 프레임)
+ *   - INDEX: 세션 색인 (INDEX 프레임, FlashLogSession 배열)
+ *   - READ(first, count): first 블록부터 count 블록(0이면 끝까지)을 DATA 프레임으로 보내고 DONE
+ *   - READ_MARKS(first, count): 색인 영역 블록(flash_log_set_index)을 MARKS 프레임으로 보내고 DONE.
+ *     호스트는 시각/이벤트 색인으로 원하는 구간(예: 발사~연소 종료)의 블록 범위만 READ 한다.
+ *   - ABORT: 보내던 READ를 멈추고 DONE
+ * - 이어받기: 프레임마다 블록 번호가 있으므로 연결이 끊기거나 일부 세션만 필요하면 호스트가
+ *   받은 다음 블록부터 READ를 다시 보낸다. 블록은 자체 CRC(FlashLogBlockHeader)로 검증한다.
+ * - 프레임 (장치 -> 호스트, 16바이트 UsbDownloadFrameHeader + 페이로드): 직렬 스트림으로 읽어도
+ *   magic과 길이로 경계를 찾을 수 있다.
+ *
+ * 내려받기는 기록이 멈춘 뒤(비행 후 착지 단계, flash_log_write/flash_log_service 호출 없음)에만
+ * 쓴다. 저장소 읽기는 기록 엔진이 유휴일 때만 하며, 읽는 동안 주 루프가 블로킹된다 (NOR 4 KB
+ * 약 0.2 ms, SD 약 1 ms).
+ *
+ * 연결 예 (CubeMX: USB_OTG_FS Device_Only, 벌크/인터럽트 3개, HSI48 + CRS, OTG_FS 인터럽트 활성화):
+ * - 초기화: usb_download_init(&dl, &hpcd_USB_OTG_FS, &log) (HAL_PCD_Init 뒤)
+ * - HAL_PCD_SetupStageCallback: usb_download_handle_setup(&dl)
+ * - HAL_PCD_DataOutStageCallback: usb_download_handle_data_out(&dl, epnum)
+ * - HAL_PCD_DataInStageCallback: usb_download_handle_data_in(&dl, epnum)
+ * - HAL_PCD_ResetCallback: usb_download_handle_reset(&dl)
+ * - 주 루프: usb_download_service(&dl)
+ */
+
+#ifndef USB_DOWNLOAD_H
+#define USB_DOWNLOAD_H
+
+#include "sys/board_profile.h"
+#include "stm32l4xx_hal.h"
+#include "log/flash_log.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#if !BOARD_HAS_USB
+#error "log/usb_download.h requires BOARD_HAS_USB (sys/board_profile.h)"
+#endif
+
+/**
+ * @brief USB 장치 식별자 (ST 가상 COM 포트 번호, 제품에 맞게 바꿀 수 있음)
+ */
+#define USB_DOWNLOAD_VID 0x0483u
+#define USB_DOWNLOAD_PID 0x5740u
+
+/**
+ * @brief 엔드포인트
+ */
+#define USB_DOWNLOAD_EP0_SIZE 64u      /**< 제어 엔드포인트 최대 패킷 */
+#define USB_DOWNLOAD_EP_OUT 0x01u      /**< 명령 벌크 OUT */
+#define USB_DOWNLOAD_EP_IN 0x81u       /**< 데이터 벌크 IN */
+#define USB_DOWNLOAD_EP_NOTIFY 0x82u   /**< CDC 알림 인터럽트 IN (사용하지 않음) */
+#define USB_DOWNLOAD_BULK_SIZE 64u     /**< 벌크 최대 패킷 (FS) */
+#define USB_DOWNLOAD_NOTIFY_SIZE 8u    /**< 알림 최대 패킷 */
+
+/**
+ * @brief 프레임 식별 값 ("PLDF", 리틀 엔디언)
+ */
+#define USB_DOWNLOAD_FRAME_MAGIC 0x46444C50u
+
+/**
+ * @brief 색인 최대 세션 수 (넘으면 최근 세션만)
+ */
+#define USB_DOWNLOAD_MAX_SESSIONS 32u
+
+/**
+ * @brief 명령 종류
+ */
+typedef enum {
+    USB_DOWNLOAD_CMD_INFO = 1,     /**< 저장 정보 */
+    USB_DOWNLOAD_CMD_INDEX = 2,    /**< 세션 색인 */
+    USB_DOWNLOAD_CMD_READ = 3,     /**< 블록 읽기 (arg0 첫 블록, arg1 블록 수, 0이면 끝까지) */
+    USB_DOWNLOAD_CMD_ABORT = 4,    /**< 읽기 중단 */
+    USB_DOWNLOAD_CMD_READ_MARKS = 5 /**< 색인 블록 읽기 (arg0 첫 색인 블록, arg1 블록 수, 0이면 끝까지) */
+} UsbDownloadCommandType;
+
+/**
+ * @brief 프레임 종류
+ */
+typedef enum {
+    USB_DOWNLOAD_FRAME_INFO = 1,   /**< UsbDownloadInfo */
+    USB_DOWNLOAD_FRAME_INDEX = 2,  /**< FlashLogSession 배열 */
+    USB_DOWNLOAD_FRAME_DATA = 3,   /**< 블록 하나 (FLASH_LOG_BUFFER_SIZE) */
+    USB_DOWNLOAD_FRAME_DONE = 4,   /**< 요청 끝 (status) */
+    USB_DOWNLOAD_FRAME_MARKS = 5   /**< 색인 블록 하나 (FLASH_LOG_BUFFER_SIZE, FlashLogIndexEntry 배열) */
+} UsbDownloadFrameType;
+
+/**
+ * @brief 프레임 상태
+ */
+typedef enum {
+    USB_DOWNLOAD_STATUS_OK = 0,    /**< 정상 */
+    USB_DOWNLOAD_STATUS_RANGE,     /**< 블록 범위 밖 */
+    USB_DOWNLOAD_STATUS_READ_ERROR,/**< 저장소 읽기 실패 (block에서 멈춤) */
+    USB_DOWNLOAD_STATUS_ABORTED,   /**< ABORT로 멈춤 */
+    USB_DOWNLOAD_STATUS_BAD_COMMAND /**< 알 수 없는 명령 */
+} UsbDownloadStatus;
+
+/**
+ * @brief 명령 (12바이트)
+ */
+typedef struct {
+    uint8_t type;              /**< UsbDownloadCommandType */
+    uint8_t reserved[3];       /**< 예약 (0) */
+    uint32_t arg0;             /**< 인자 0 */
+    uint32_t arg1;             /**< 인자 1 */
+} UsbDownloadCommand;
+
+_Static_assert(sizeof(UsbDownloadCommand) == 12, "UsbDownloadCommand layout changed");
+
+/**
+ * @brief 프레임 헤더 (16바이트)
+ */
+typedef struct {
+    uint32_t magic;            /**< USB_DOWNLOAD_FRAME_MAGIC */
+    uint8_t type;              /**< UsbDownloadFrameType */
+    uint8_t status;            /**< UsbDownloadStatus */
+    uint16_t length;           /**< 페이로드 바이트 */
+    uint32_t block;            /**< 블록 번호 (DATA/MARKS), 다음 블록 (DONE) */
+    uint32_t remaining;        /**< 이 요청에서 남은 블록 수 (DATA/MARKS) */
+} UsbDownloadFrameHeader;
+
+_Static_assert(sizeof(UsbDownloadFrameHeader) == 16, "UsbDownloadFrameHeader layout changed");
+
+/**
+ * @brief INFO 페이로드 (20바이트)
+ */
+typedef struct {
+    uint32_t block_count;      /**< 저장 블록 수 */
+    uint32_t block_size;       /**< 블록 크기 (FLASH_LOG_BUFFER_SIZE) */
+    uint32_t capacity;         /**< 기록 영역 블록 수 (색인 영역 제외) */
+    uint16_t session;          /**< 현재(마지막) 세션 번호 */
+    uint8_t backend;           /**< FlashLogBackend */
+    uint8_t reserved;          /**< 예약 (0) */
+    uint32_t index_blocks;     /**< 저장된 색인 블록 수 (색인 없으면 0) */
+} UsbDownloadInfo;
+
+_Static_assert(sizeof(UsbDownloadInfo) == 20, "UsbDownloadInfo layout changed");
+
+/**
+ * @brief 프레임 버퍼 (헤더 + 블록)
+ */
+typedef struct {
+    UsbDownloadFrameHeader header;               /**< 프레임 헤더 */
+    uint8_t data[FLASH_LOG_BUFFER_SIZE];         /**< 페이로드 */
+} __attribute__((aligned(4))) UsbDownloadFrame;
+
+/**
+ * @brief 프레임 버퍼 상태
+ */
+typedef enum {
+    USB_DOWNLOAD_BUFFER_FREE = 0,  /**< 비어 있음 또는 채우는 중 (주 루프 소유) */
+    USB_DOWNLOAD_BUFFER_READY,     /**< 전송 대기 */
+    USB_DOWNLOAD_BUFFER_SENDING    /**< 전송 중 */
+} UsbDownloadBufferState;
+
+/**
+ * @brief 제어 전송 단계
+ */
+typedef enum {
+    USB_DOWNLOAD_EP0_IDLE = 0,     /**< 설정 패킷 대기 */
+    USB_DOWNLOAD_EP0_DATA_IN,      /**< 데이터 IN 단계 */
+    USB_DOWNLOAD_EP0_DATA_OUT,     /**< 데이터 OUT 단계 */
+    USB_DOWNLOAD_EP0_STATUS_IN,    /**< 상태 IN 단계 (ZLP 송신) */
+    USB_DOWNLOAD_EP0_STATUS_OUT    /**< 상태 OUT 단계 (ZLP 수신) */
+} UsbDownloadEp0State;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t resets;           /**< 버스 리셋 수 */
+    uint32_t commands;         /**< 받은 명령 수 */
+    uint32_t bad_commands;     /**< 알 수 없는/잘린 명령 수 */
+    uint32_t frames;           /**< 보낸 프레임 수 */
+    uint32_t blocks;           /**< 보낸 블록 수 */
+    uint32_t bytes;            /**< 보낸 바이트 수 */
+    uint32_t read_errors;      /**< 저장소 읽기 실패 수 */
+    uint32_t stalls;           /**< 처리하지 않은 제어 요청 수 */
+} UsbDownloadStats;
+
+/**
+ * @brief 기록 내려받기
+ */
+typedef struct {
+    PCD_HandleTypeDef *hpcd;   /**< OTG_FS 장치 핸들 */
+    FlashLog *log;             /**< 비행 기록기 */
+
+    // 제어 전송 (USB 인터럽트)
+    UsbDownloadEp0State ep0_state; /**< 제어 전송 단계 */
+    const uint8_t *ep0_data;   /**< 보낼 나머지 데이터 */
+    uint16_t ep0_remaining;    /**< 보낼 나머지 바이트 */
+    bool ep0_zlp;              /**< 데이터 단계 끝에 ZLP 필요 */
+    uint8_t ep0_request;       /**< 데이터 OUT 단계 요청 */
+    uint8_t ep0_buffer[USB_DOWNLOAD_EP0_SIZE] __attribute__((aligned(4))); /**< 제어 데이터 버퍼 */
+    uint8_t line_coding[7];    /**< CDC 회선 설정 (속도는 의미 없음, 그대로 돌려줌) */
+    uint8_t configuration;     /**< 현재 설정 값 (0이면 미설정) */
+    volatile bool configured;  /**< 설정 완료 */
+    volatile bool dtr;         /**< 호스트 포트 열림 (DTR) */
+
+    // 명령 (OUT 인터럽트 -> 주 루프)
+    uint8_t rx_buffer[USB_DOWNLOAD_BULK_SIZE] __attribute__((aligned(4))); /**< 명령 수신 버퍼 */
+    volatile uint16_t rx_length; /**< 받은 명령 길이 */
+    atomic_bool rx_pending;    /**< 처리할 명령 있음 */
+
+    // 프레임 전송 (주 루프가 채우고 IN 인터럽트가 이어 보냄)
+    UsbDownloadFrame frame[2]; /**< 프레임 이중 버퍼 */
+    atomic_uint_fast8_t frame_state[2]; /**< 버퍼 상태 (UsbDownloadBufferState) */
+    uint8_t fill_next;         /**< 다음에 채울 버퍼 */
+    uint8_t send_next;         /**< 다음에 보낼 버퍼 */
+    atomic_flag tx_busy;       /**< 벌크 IN 전송 중 */
+    atomic_bool reset_pending; /**< 리셋/설정 변경 뒤 주 루프 정리 필요 */
+
+    // 읽기 요청 (주 루프)
+    bool streaming;            /**< READ/READ_MARKS 진행 중 */
+    bool marks;                /**< 색인 영역을 읽는 중 */
+    bool done_pending;         /**< DONE 프레임 보낼 차례 */
+    uint8_t done_status;       /**< DONE 상태 */
+    uint32_t next_block;       /**< 다음에 읽을 블록 */
+    uint32_t end_block;        /**< 읽기 끝 블록 (미포함) */
+    FlashLogSession index[USB_DOWNLOAD_MAX_SESSIONS]; /**< 세션 색인 */
+
+    UsbDownloadStats stats;    /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} UsbDownload;
+
+/**
+ * @brief 초기화 (FIFO 배분 후 장치 시작, 호스트 연결 대기)
+ *
+ * @param dl 기록 내려받기
+ * @param hpcd HAL_PCD_Init을 마친 OTG_FS 장치 핸들
+ * @param log 초기화된 비행 기록기
+ * @return bool 성공 여부
+ */
+bool usb_download_init(UsbDownload *dl, PCD_HandleTypeDef *hpcd, FlashLog *log);
+
+/**
+ * @brief 정지 (장치 분리)
+ *
+ * @param dl 기록 내려받기
+ * @return bool 성공 여부
+ */
+bool usb_download_stop(UsbDownload *dl);
+
+/**
+ * @brief 명령 처리와 다음 블록 읽기 (주 루프에서 주기 호출)
+ *
+ * @param dl 기록 내려받기
+ */
+void usb_download_service(UsbDownload *dl);
+
+/**
+ * @brief 호스트가 연결되어 포트를 열었는지
+ *
+ * @param dl 기록 내려받기
+ * @return bool 설정 완료이고 DTR이면 true
+ */
+bool usb_download_connected(const UsbDownload *dl);
+
+/**
+ * @brief 설정 패킷 처리 (HAL_PCD_SetupStageCallback)
+ *
+ * @param dl 기록 내려받기
+ */
+void usb_download_handle_setup(UsbDownload *dl);
+
+/**
+ * @brief OUT 전송 완료 처리 (HAL_PCD_DataOutStageCallback)
+ *
+ * @param dl 기록 내려받기
+ * @param epnum 엔드포인트 번호
+ */
+void usb_download_handle_data_out(UsbDownload *dl, uint8_t epnum);
+
+/**
+ * @brief IN 전송 완료 처리 (HAL_PCD_DataInStageCallback)
+ *
+ * @param dl 기록 내려받기
+ * @param epnum 엔드포인트 번호
+ */
+void usb_download_handle_data_in(UsbDownload *dl, uint8_t epnum);
+
+/**
+ * @brief 버스 리셋 처리 (HAL_PCD_ResetCallback)
+ *
+ * @param dl 기록 내려받기
+ */
+void usb_download_handle_reset(UsbDownload *dl);
+
+/**
+ * @brief 통계
+ *
+ * @param dl 기록 내려받기
+ * @return const UsbDownloadStats* 통계 (dl이 NULL이면 NULL)
+ */
+const UsbDownloadStats *usb_download_get_stats(const UsbDownload *dl);
+
+#endif /* USB_DOWNLOAD_H */
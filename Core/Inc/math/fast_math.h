@@ -0,0 +1,297 @@
+/**
+ * @file fast_math.h
+ * @brief 제어 루프용 고속 초월 함수 근사
+ *
+ * newlib libm의 sqrtf/atan2f/asinf/sinf/cosf는 errno 처리와 범용 범위 축소 때문에
+ * Cortex-M4F FPU가 직접 할 수 있는 것보다 수 배 느리다. 이 헤더의 함수들은
+ * 인라인 다항식과 FPU 명령만 사용하며, 정확한 libm 함수가 필요 없는 호출 지점에서
+ * 골라 쓸 수 있도록 별도 이름(fast_ 접두사)을 갖는다.
+ *
+ * 오차 한계 (float, 호스트에서 각 정의역을 조밀하게 전수 비교하여 측정):
+ * | 함수            | 정의역              | 최대 절대 오차     |
+ * |-----------------|---------------------|--------------------|
+ * | fast_sqrtf      | x >= 0              | 0 (IEEE 정확 반올림) |
+ * | fast_inv_sqrtf  | x > 0               | 상대 1.2e-7 (1 ulp) |
+ * | fast_atan2f     | 전체                | 2.0e-6 rad         |
+ * | fast_asinf      | [-1, 1]             | 2.5e-6 rad         |
+ * | fast_sincosf    | |x| <= 1000 rad     | 1.5e-7             |
+ * | fast_expf       | [-87, 88]           | 상대 8.1e-8         |
+ * | fast_logf       | x > 0               | 8.0e-8 (|ln x| > 1이면 상대) |
+ *
+ * 음수의 제곱근은 errno 설정 없이 NaN을 반환한다.
+ *
+ * 끝의 fp_ 함수(fp_sinf, fp_expf 등)는 추정 경로의 libm 호출을 대신하며, 기본 빌드에서는
+ * libm 그대로이고 FP_DETERMINISTIC 빌드에서는 fast_ 함수로 바뀐다 (math/fp_mode.h).
+ */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "math/fp_mode.h"
+
+/**
+ * @brief 원주율 관련 상수
+ */
+#define FAST_MATH_PI 3.14159265358979f
+#define FAST_MATH_PI_2 1.57079632679490f
+#define FAST_MATH_2_PI_INV 0.636619772367581f /**< 2 / pi */
+#define FAST_MATH_LOG2E 1.44269504088896f     /**< 1 / ln 2 */
+#define FAST_MATH_LN2 0.693147180559945f       /**< ln 2 */
+
+/**
+ * @brief 제곱근 (VSQRT.F32 단일 명령)
+ *
+ * FPU가 없는 빌드(호스트 포함)에서는 sqrtf를 사용한다.
+ *
+ * @param x 입력 (x >= 0)
+ * @return float sqrt(x)
+ */
+static inline float fast_sqrtf(float x) {
+#if defined(__ARM_FP) && (__ARM_FP & 0x4)
+    float result;
+    __asm__("vsqrt.f32 %0, %1" : "=t"(result) : "t"(x));
+    return result;
+#else
+    return sqrtf(x);
+#endif
+}
+
+/**
+ * @brief 역제곱근 (VSQRT + VDIV)
+ *
+ * 비트 조작 근사 대신 FPU 명령 두 개로 계산하므로 정확도 손실이 1 ulp 이내이다.
+ *
+ * @param x 입력 (x > 0)
+ * @return float 1 / sqrt(x)
+ */
+static inline float fast_inv_sqrtf(float x) {
+    return 1.0f / fast_sqrtf(x);
+}
+
+/**
+ * @brief [0, 1] 구간 아크탄젠트 다항식 (11차 홀수 최소최대 근사)
+ *
+ * @param z 입력 (0 <= z <= 1)
+ * @return float atan(z), 최대 오차 1.8e-6 rad
+ */
+static inline float fast_atan_unit(float z) {
+    float z2 = z * z;
+    return z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f +
+           z2 * (-0.11643287f + z2 * (0.05265332f + z2 * (-0.01172120f))))));
+}
+
+/**
+ * @brief 2인수 아크탄젠트
+ *
+ * 팔분면 축소 후 [0, 1] 다항식을 사용한다 (나눗셈 1회).
+ *
+ * @param y y 좌표
+ * @param x x 좌표
+ * @return float atan2(y, x) (rad, [-pi, pi], 원점에서는 0)
+ */
+static inline float fast_atan2f(float y, float x) {
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    float mx = (ay > ax) ? ay : ax;
+    float mn = (ay > ax) ? ax : ay;
+
+    if (mx == 0.0f) {
+        return 0.0f;
+    }
+
+    float a = fast_atan_unit(mn / mx);
+    if (ay > ax) {
+        a = FAST_MATH_PI_2 - a;
+    }
+    if (x < 0.0f) {
+        a = FAST_MATH_PI - a;
+    }
+    return (y < 0.0f) ? -a : a;
+}
+
+/**
+ * @brief 아크사인
+ *
+ * asin(x) = atan2(x, sqrt((1 - x)(1 + x))) 로 계산하므로 |x| -> 1 에서도
+ * 오차가 커지지 않는다. 범위를 벗어난 입력은 [-1, 1]로 제한한다.
+ *
+ * @param x 입력
+ * @return float asin(x) (rad, [-pi/2, pi/2])
+ */
+static inline float fast_asinf(float x) {
+    if (x >= 1.0f) {
+        return FAST_MATH_PI_2;
+    }
+    if (x <= -1.0f) {
+        return -FAST_MATH_PI_2;
+    }
+    return fast_atan2f(x, fast_sqrtf((1.0f - x) * (1.0f + x)));
+}
+
+/**
+ * @brief 사인과 코사인 동시 계산
+ *
+ * 가장 가까운 pi/2 배수로 3단계 Cody-Waite 범위 축소 후 [-pi/4, pi/4]에서
+ * 사인 7차, 코사인 8차 다항식(Cephes 계수)을 사용한다.
+ *
+ * @param x 각도 (rad, 정확도 보장 범위 |x| <= 1000)
+ * @param s sin(x) 결과
+ * @param c cos(x) 결과
+ */
+static inline void fast_sincosf(float x, float *s, float *c) {
+    int32_t k = (int32_t)(x * FAST_MATH_2_PI_INV + ((x >= 0.0f) ? 0.5f : -0.5f));
+    float kf = (float)k;
+
+    // r = x - k * pi/2 (pi/2 = 1.5703125 + 4.8375129699707031e-4 + 7.5497899548918822e-8)
+    float r = ((x - kf * 1.5703125f) - kf * 4.8375129699707031e-4f) - kf * 7.5497899548918822e-8f;
+    float r2 = r * r;
+
+    float sr = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * (-1.9515295891e-4f)));
+    float cr = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f +
+               r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+    // 사분면에 따라 교환 및 부호 결정
+    switch (k & 3) {
+        case 0:  *s = sr;  *c = cr;  break;
+        case 1:  *s = cr;  *c = -sr; break;
+        case 2:  *s = -sr; *c = -cr; break;
+        default: *s = -cr; *c = sr;  break;
+    }
+}
+
+/**
+ * @brief 자연 지수 함수
+ *
+ * 가장 가까운 ln 2 배수로 2단계 범위 축소 후 [-ln2/2, ln2/2]에서 Cephes 5차 다항식을 쓰고,
+ * 지수 비트를 직접 만들어 2^k를 곱한다.
+ *
+ * @param x 입력 (x > 88.7이면 +inf, x < -87.3이면 0)
+ * @return float exp(x)
+ */
+static inline float fast_expf(float x) {
+    if (x > 88.72f) {
+        return INFINITY;
+    }
+    if (x < -87.33f) {
+        return 0.0f;
+    }
+    int32_t k = (int32_t)(x * FAST_MATH_LOG2E + ((x >= 0.0f) ? 0.5f : -0.5f));
+    float kf = (float)k;
+
+    // r = x - k * ln2 (ln2 = 0.693359375 - 2.12194440e-4)
+    float r = (x - kf * 0.693359375f) + kf * 2.12194440e-4f;
+    float r2 = r * r;
+    float p = ((((1.9875691500e-4f * r + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r +
+               4.1665795894e-2f) * r + 1.6666665459e-1f) * r + 5.0000001201e-1f;
+    float e = p * r2 + r + 1.0f;
+
+    // 2^k (k = -126 .. 128, 128은 두 번에 나누어 곱함)
+    int32_t k1 = (k > 127) ? 127 : k;
+    uint32_t bits = (uint32_t)(k1 + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    e *= scale;
+    return (k > 127) ? e * 2.0f : e;
+}
+
+/**
+ * @brief 자연 로그
+ *
+ * 지수 비트를 떼어 가수를 [sqrt(1/2), sqrt(2)) 구간으로 옮긴 뒤 Cephes 9차 다항식을 쓴다.
+ *
+ * @param x 입력 (0이면 -inf, 음수이면 NaN)
+ * @return float ln(x)
+ */
+static inline float fast_logf(float x) {
+    if (!(x > 0.0f)) {
+        return (x == 0.0f) ? -INFINITY : NAN;
+    }
+    if (x == INFINITY) {
+        return x;
+    }
+    int32_t e = 0;
+    if (x < 1.17549435e-38f) {
+        // 비정규 수: 정규 범위로 올림
+        x *= 8388608.0f;
+        e = -23;
+    }
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    e += (int32_t)((bits >> 23) & 0xFFu) - 126;
+    bits = (bits & 0x807FFFFFu) | 0x3F000000u;
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+
+    // m in [0.5, 1) -> [sqrt(1/2) - 1, sqrt(2) - 1)
+    if (m < 0.707106781186547f) {
+        e -= 1;
+        m = m + m - 1.0f;
+    } else {
+        m = m - 1.0f;
+    }
+    float ef = (float)e;
+    float z = m * m;
+    float y = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m + 1.1676998740e-1f) * m -
+               1.2420140846e-1f) * m + 1.4249322787e-1f) * m - 1.6668057665e-1f) * m +
+               2.0000714765e-1f) * m - 2.4999993993e-1f) * m + 3.3333331174e-1f) * m * z;
+    y += -2.12194440e-4f * ef;
+    y += -0.5f * z;
+    return (m + y) + 0.693359375f * ef;
+}
+
+/* ---------------------------------------------------------------------------
+ * 추정 경로 초월 함수 (fp_mode.h)
+ *
+ * 기본 빌드는 libm을 그대로 부르고, FP_DETERMINISTIC 빌드는 위의 fast_ 함수를 불러
+ * 호스트와 보드가 같은 비트를 낸다.
+ * ------------------------------------------------------------------------- */
+
+#ifdef FP_DETERMINISTIC
+
+static inline float fp_sinf(float x) {
+    float s, c;
+    fast_sincosf(x, &s, &c);
+    return s;
+}
+
+static inline float fp_cosf(float x) {
+    float s, c;
+    fast_sincosf(x, &s, &c);
+    return c;
+}
+
+static inline float fp_tanf(float x) {
+    float s, c;
+    fast_sincosf(x, &s, &c);
+    return s / c;
+}
+
+static inline float fp_atanf(float x) { return fast_atan2f(x, 1.0f); }
+static inline float fp_atan2f(float y, float x) { return fast_atan2f(y, x); }
+static inline float fp_asinf(float x) { return fast_asinf(x); }
+static inline float fp_acosf(float x) { return FAST_MATH_PI_2 - fast_asinf(x); }
+static inline float fp_expf(float x) { return fast_expf(x); }
+static inline float fp_logf(float x) { return fast_logf(x); }
+static inline float fp_exp2f(float x) { return fast_expf(x * FAST_MATH_LN2); }
+static inline float fp_log2f(float x) { return fast_logf(x) * FAST_MATH_LOG2E; }
+
+#else /* FP_DETERMINISTIC */
+
+static inline float fp_sinf(float x) { return sinf(x); }
+static inline float fp_cosf(float x) { return cosf(x); }
+static inline float fp_tanf(float x) { return tanf(x); }
+static inline float fp_atanf(float x) { return atanf(x); }
+static inline float fp_atan2f(float y, float x) { return atan2f(y, x); }
+static inline float fp_asinf(float x) { return asinf(x); }
+static inline float fp_acosf(float x) { return acosf(x); }
+static inline float fp_expf(float x) { return expf(x); }
+static inline float fp_logf(float x) { return logf(x); }
+static inline float fp_exp2f(float x) { return exp2f(x); }
+static inline float fp_log2f(float x) { return log2f(x); }
+
+#endif /* FP_DETERMINISTIC */
+
+#endif /* FAST_MATH_H */
@@ -0,0 +1,114 @@
+/**
+ * @file float16.h
+ * @brief IEEE 754 binary16 (반정밀도) 저장 형식 변환
+ *
+ * 연산은 float로 하고 저장만 16비트로 줄일 때 쓴다 (가수 11비트, 상대 오차 2^-12 이하,
+ * 최대 65504). 변환은 가장 가까운 값으로 반올림한다 (동률이면 짝수).
+ * Cortex-M4F에서 -mfp16-format=ieee로 빌드하면 __fp16 변환이 VCVTB.F16.F32/F32.F16 명령 하나가
+ * 되고, 그 외(호스트 등)에서는 같은 결과를 내는 정수 연산으로 변환한다.
+ */
+
+#ifndef FLOAT16_H
+#define FLOAT16_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FP16_FORMAT_IEEE)
+
+/**
+ * @brief float -> binary16
+ *
+ * @param f 값
+ * @return uint16_t binary16 비트
+ */
+static inline uint16_t float16_from_float(float f) {
+    __fp16 h = (__fp16)f;
+    uint16_t bits;
+    memcpy(&bits, &h, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief binary16 -> float (정확)
+ *
+ * @param bits binary16 비트
+ * @return float 값
+ */
+static inline float float16_to_float(uint16_t bits) {
+    __fp16 h;
+    memcpy(&h, &bits, sizeof(h));
+    return (float)h;
+}
+
+#else /* __ARM_FP16_FORMAT_IEEE */
+
+static inline uint16_t float16_from_float(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    uint16_t sign = (uint16_t)((x >> 16) & 0x8000u);
+    uint32_t ax = x & 0x7FFFFFFFu;
+
+    // 무한대/NaN (NaN은 조용한 NaN으로)
+    if (ax >= 0x7F800000u) {
+        return (uint16_t)(sign | 0x7C00u | ((ax > 0x7F800000u) ? 0x0200u : 0u));
+    }
+    // 65536 이상은 무한대 (65520 이상은 아래 반올림에서 무한대가 됨)
+    if (ax >= 0x47800000u) {
+        return (uint16_t)(sign | 0x7C00u);
+    }
+    // 비정규 범위 (|f| < 2^-14, 2^-25 이하는 0)
+    if (ax < 0x38800000u) {
+        if (ax <= 0x33000000u) {
+            return sign;
+        }
+        uint32_t m = (ax & 0x007FFFFFu) | 0x00800000u;
+        uint32_t shift = 126u - (ax >> 23);
+        uint32_t h = m >> shift;
+        uint32_t rem = m & ((1u << shift) - 1u);
+        uint32_t half = 1u << (shift - 1u);
+        if (rem > half || (rem == half && (h & 1u))) {
+            h++;
+        }
+        return (uint16_t)(sign | h);
+    }
+
+    // 정규 범위 (지수 재편향, 반올림 올림이 지수로 넘어가도 맞는 값)
+    uint32_t h = (ax - 0x38000000u) >> 13;
+    uint32_t rem = ax & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) {
+        h++;
+    }
+    return (uint16_t)(sign | h);
+}
+
+static inline float float16_to_float(uint16_t bits) {
+    uint32_t sign = (uint32_t)(bits & 0x8000u) << 16;
+    uint32_t e = (bits >> 10) & 0x1Fu;
+    uint32_t m = bits & 0x03FFu;
+    uint32_t x;
+
+    if (e == 0x1Fu) {
+        x = sign | 0x7F800000u | (m << 13);
+    } else if (e != 0u) {
+        x = sign | ((e + 112u) << 23) | (m << 13);
+    } else if (m == 0u) {
+        x = sign;
+    } else {
+        // 비정규 값 정규화
+        e = 113u;
+        while ((m & 0x0400u) == 0u) {
+            m <<= 1;
+            e--;
+        }
+        x = sign | (e << 23) | ((m & 0x03FFu) << 13);
+    }
+
+    float f;
+    memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+#endif /* __ARM_FP16_FORMAT_IEEE */
+
+#endif /* FLOAT16_H */
@@ -0,0 +1,80 @@
+/**
+ * @file fp_mode.h
+ * @brief 부동소수점 결정적 모드 (호스트와 보드에서 비트 단위로 같은 결과)
+ *
+ * 호출 기록 재생(Tools/replay/call_player.c), 센서 기록 재생, 벤치마크 결과를 보드 결과와
+ * 그대로 비교하려면 같은 소스가 호스트(x86-64 SSE)와 Cortex-M4F에서 같은 비트를 내야 한다.
+ * 기본 빌드에서 어긋나는 원인은 세 가지이다.
+ * - 곱셈-덧셈 축약: arm-none-eabi-gcc는 a * b + c를 VFMA 한 번(반올림 1회)으로 바꾸지만
+ *   호스트 gcc -O2는 곱셈과 덧셈을 따로 반올림한다 (-march=native이면 반대로 축약).
+ * - 합산 순서: CMSIS-DSP 커널(MATRIX_USE_CMSIS_DSP)은 4개씩 부분합을 나누어 더하므로
+ *   이식성 있는 루프와 순서가 다르다.
+ * - 초월 함수: newlib과 glibc의 sinf/expf/atan2f 등은 마지막 비트가 다를 수 있다.
+ *
+ * FP_DETERMINISTIC을 정의하면 이 헤더 뒤에 정의되는 모든 함수에서 축약을 끄고, CMSIS-DSP 커널
+ * 또는 -ffast-math(재결합)와 함께 빌드하면 컴파일 오류를 낸다. 초월 함수는 fast_math.h의 fp_
+ * 함수(fp_sinf, fp_expf 등)가 libm 대신 인라인 다항식(fast_ 함수)을 쓰므로, 추정 경로의 호출
+ * 지점은 fp_ 이름으로 부른다. 제곱근은 IEEE 정확 반올림(VSQRT.F32, SSE sqrtss)이라 그대로 쓴다.
+ *
+ * 결정적 모드의 fp_ 함수는 libm과 오차가 다르므로(fast_math.h 표) 결정적 빌드와 기본 빌드의
+ * 결과는 서로 비교하지 않는다. 호스트와 보드를 같은 모드로 빌드해 표준 재생(ekf/ekf_golden.h)
+ * 지문을 비교한다 (Tools/bench/golden_check.c). 호스트는 FMA 없는 기본 x86-64 대상으로 빌드한다
+ * (-mfma, -march=native는 컴파일 오류).
+ *
+ * 범위 밖: double 측지 변환(nav/geodetic.c)은 libm sin/cos를 그대로 쓴다. GNSS 변환 결과는
+ * EKF 호출 인자로 기록되므로 호출 재생에는 영향이 없지만, 센서 기록 재생(GNSS 포함)은
+ * 드물게 마지막 비트가 다를 수 있다. 링크 시간 최적화(-flto)를 쓰면 모든 단위를 같은
+ * FP_DETERMINISTIC 설정으로 빌드해야 한다.
+ */
+
+#ifndef FP_MODE_H
+#define FP_MODE_H
+
+#include <float.h>
+
+/**
+ * @brief 결정적 모드 활성화
+ *
+ * 빌드 설정에서 호스트와 보드 모두 정의한다 (예: -DFP_DETERMINISTIC).
+ */
+/* #define FP_DETERMINISTIC */
+
+#ifdef FP_DETERMINISTIC
+
+#if defined(__FAST_MATH__)
+#error "FP_DETERMINISTIC cannot be combined with -ffast-math (reassociation changes summation order)"
+#endif
+
+// 16은 _Float16만 float로 계산한다는 뜻 (float 연산은 그대로, x86 -march=native)
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0 && FLT_EVAL_METHOD != 16
+#error "FP_DETERMINISTIC requires float evaluation in float (no x87 excess precision, use SSE on x86)"
+#endif
+
+// gcc 12는 -ffp-contract=off에서도 SLP 벡터화한 사원수 곱을 vfmaddsub로 축약한다
+#if defined(__FMA__) && (defined(__x86_64__) || defined(__i386__))
+#error "FP_DETERMINISTIC host builds must not enable x86 FMA (drop -mfma / -march=native)"
+#endif
+
+#if defined(MATRIX_USE_CMSIS_DSP)
+#error "FP_DETERMINISTIC cannot be combined with MATRIX_USE_CMSIS_DSP (different summation order)"
+#endif
+
+// 이 뒤에 정의되는 함수(인라인 포함)는 a * b + c를 곱셈과 덧셈으로 따로 반올림
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+/**
+ * @brief 벤치마크/지문 출력에 찍는 모드 이름
+ */
+#define FP_MODE_NAME "deterministic"
+
+#else /* FP_DETERMINISTIC */
+
+#define FP_MODE_NAME "native"
+
+#endif /* FP_DETERMINISTIC */
+
+#endif /* FP_MODE_H */
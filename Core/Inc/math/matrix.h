@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "math/fp_mode.h"
 
 /**
  * @brief 최대 행렬 크기 정의
@@ -16,15 +17,31 @@
  */
 #define MATRIX_MAX_SIZE 16
 
+/**
+ * @brief 행렬 저장 공간 정렬 (바이트, matrix_fixed.h의 MATRIX_ALIGN과 같음)
+ */
+#define MATRIX_DATA_ALIGN 8
+
 /**
  * @brief 행렬 구조체
+ *
+ * 원소는 활성 크기(rows x cols) 기준 행 우선으로 앞에서부터 연속 저장한다
+ * ((i, j)는 data[i * cols + j]). 고정 16 열 간격이 아니므로 작은 행렬도 연속된
+ * 8바이트 정렬 구간이 되어 LDRD/VLDM 전송과 CMSIS-DSP(arm_matrix_instance_f32)에
+ * 그대로 넘길 수 있다. 원소 접근은 MATRIX_ELEM으로 하며, rows/cols를 바꾸면 기존
+ * 원소 배치는 의미를 잃는다.
  */
 typedef struct {
-    float data[MATRIX_MAX_SIZE][MATRIX_MAX_SIZE]; /**< 행렬 데이터 */
+    float data[MATRIX_MAX_SIZE * MATRIX_MAX_SIZE] __attribute__((aligned(MATRIX_DATA_ALIGN))); /**< 행렬 데이터 */
     uint8_t rows;                                 /**< 행 수 */
     uint8_t cols;                                 /**< 열 수 */
 } Matrix;
 
+/**
+ * @brief 원소 접근 (좌변값, 경계 검사 없음)
+ */
+#define MATRIX_ELEM(m, i, j) ((m)->data[(uint16_t)(i) * (m)->cols + (j)])
+
 /**
  * @brief 행렬 초기화
  * 
@@ -67,6 +84,8 @@ bool matrix_get(const Matrix *m, uint8_t row, uint8_t col, float *value);
 /**
  * @brief 행렬 덧셈
  * 
+ * result는 a 또는 b와 같은 행렬이어도 된다.
+ * 
  * @param a 첫 번째 행렬
  * @param b 두 번째 행렬
  * @param result 결과 행렬
@@ -77,6 +96,8 @@ bool matrix_add(const Matrix *a, const Matrix *b, Matrix *result);
 /**
  * @brief 행렬 뺄셈
  * 
+ * result는 a 또는 b와 같은 행렬이어도 된다.
+ * 
  * @param a 첫 번째 행렬
  * @param b 두 번째 행렬
  * @param result 결과 행렬
@@ -87,6 +108,8 @@ bool matrix_subtract(const Matrix *a, const Matrix *b, Matrix *result);
 /**
  * @brief 행렬 곱셈
  * 
+ * result는 a, b와 다른 행렬이어야 한다.
+ * 
  * @param a 첫 번째 행렬
  * @param b 두 번째 행렬
  * @param result 결과 행렬
@@ -97,6 +120,8 @@ bool matrix_multiply(const Matrix *a, const Matrix *b, Matrix *result);
 /**
  * @brief 행렬 스칼라 곱
  * 
+ * result는 m과 같은 행렬이어도 된다.
+ * 
  * @param m 행렬
  * @param scalar 스칼라 값
  * @param result 결과 행렬
@@ -107,12 +132,56 @@ bool matrix_scale(const Matrix *m, float scalar, Matrix *result);
 /**
  * @brief 행렬 전치
  * 
+ * result는 m과 다른 행렬이어야 한다.
+ * 
  * @param m 행렬
  * @param result 결과 행렬
  * @return bool 성공 여부
  */
 bool matrix_transpose(const Matrix *m, Matrix *result);
 
+/**
+ * @brief 전치 행렬과의 곱셈 (result = a * b^T)
+ * 
+ * b의 전치 행렬을 따로 만들지 않고 곱한다. result는 a, b와 다른 행렬이어야 한다.
+ * 
+ * @param a 첫 번째 행렬
+ * @param b 두 번째 행렬 (전치되어 곱해짐)
+ * @param result 결과 행렬
+ * @return bool 성공 여부
+ */
+bool matrix_multiply_transpose(const Matrix *a, const Matrix *b, Matrix *result);
+
+/**
+ * @brief 곱셈 누적 (result = result + a * b)
+ * 
+ * 곱셈 결과를 임시 행렬 없이 result에 바로 더한다. result는 a, b와 다른 행렬이어야 한다.
+ * 
+ * @param a 첫 번째 행렬
+ * @param b 두 번째 행렬
+ * @param result 누적 대상 행렬 (a->rows x b->cols)
+ * @return bool 성공 여부
+ */
+bool matrix_multiply_accumulate(const Matrix *a, const Matrix *b, Matrix *result);
+
+/**
+ * @brief 제자리 행렬 덧셈 (m = m + b)
+ * 
+ * @param m 대상 행렬
+ * @param b 더할 행렬
+ * @return bool 성공 여부
+ */
+bool matrix_add_in_place(Matrix *m, const Matrix *b);
+
+/**
+ * @brief 제자리 스칼라 곱 (m = m * scalar)
+ * 
+ * @param m 대상 행렬
+ * @param scalar 스칼라 값
+ * @return bool 성공 여부
+ */
+bool matrix_scale_in_place(Matrix *m, float scalar);
+
 /**
  * @brief 행렬 역행렬 계산
  * 
@@ -0,0 +1,361 @@
+/**
+ * @file matrix.hpp
+ * @brief 고정 크기 행렬 C++ 래퍼 (헤더 전용, 식 템플릿)
+ *
+ * 호스트 도구와 C++ 펌웨어 모듈에서 matrix_fixed.h / matrix_sym.h 커널을 하나씩 옮길 수
+ * 있도록, 같은 저장 배치(행 우선 float[R][C], 상삼각 압축 float[N(N+1)/2])를 쓰는
+ * Matrix<R, C>와 복사 없는 보기(MatrixRef, SymRef)를 제공한다. 차원은 템플릿 상수이므로
+ * 차원 불일치는 컴파일 오류이고, 작은 곱은 컴파일러가 완전히 펼칠 수 있다.
+ *
+ * 연산자(+, -, 스칼라 *, 행렬 *, transpose())는 계산하지 않고 식 객체만 만들며, 대입할 때
+ * 한 루프에서 행 단위로 계산한다. 곱은 왼쪽 피연산자의 한 행만 스택에 계산하므로
+ *   math::sym(ekf.P) = F * P * F.transpose() + Q;
+ * 는 N x N 임시 행렬 없이 행마다 길이 N 버퍼 두 개와 2 N^3 곱셈(대칭 대상은 상삼각만)으로
+ * 끝난다. 곱의 오른쪽 피연산자는 원소를 바로 읽을 수 있는 식(행렬, 보기, 그 전치, 합,
+ * 스칼라 배)이어야 한다 (곱이면 원소마다 다시 계산하므로 컴파일 오류로 막음).
+ *
+ * 제약 (C 커널의 result != 입력 규칙과 같음):
+ * - 대입 대상이 곱의 피연산자와 같은 저장 공간이면 결과가 틀린다 (P = F * P 금지).
+ *   원소별 식(합, 스칼라 배, 전치가 아닌 같은 위치 읽기)은 같은 대상이어도 된다.
+ * - 식 객체는 피연산자 행렬을 참조로 들고 있으므로 같은 문장 안에서 대입한다.
+ *
+ * C 헤더(ekf/ekf.h 등)는 이 헤더 뒤에 extern "C" { } 안에서 포함한다.
+ * C 헤더의 _Static_assert는 C++에서 static_assert로 바꿔 쓴다.
+ */
+
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__cplusplus) && !defined(_Static_assert)
+#define _Static_assert static_assert
+#endif
+
+namespace math {
+
+template <class E> struct Transpose;
+
+/**
+ * @brief 식 기반 (CRTP)
+ *
+ * 파생 식은 rows, cols, direct(원소를 O(1)에 읽을 수 있는지)와 operator()(i, j)를 갖는다.
+ * eval_row는 i행의 [first, cols) 열을 out에 계산한다 (기본은 원소별).
+ */
+template <class E> struct Expr {
+    const E &self() const { return static_cast<const E &>(*this); }
+
+    void eval_row(std::size_t i, std::size_t first, float *out) const {
+        for (std::size_t j = first; j < E::cols; j++) {
+            out[j] = self()(i, j);
+        }
+    }
+
+    Transpose<E> transpose() const;
+};
+
+/**
+ * @brief 식 노드가 피연산자를 들고 있는 방식 (저장 공간이 있는 행렬은 참조, 나머지는 값)
+ */
+template <std::size_t R, std::size_t C> struct Matrix;
+template <class T> struct Operand { using type = const T; };
+template <std::size_t R, std::size_t C> struct Operand<Matrix<R, C>> { using type = const Matrix<R, C> &; };
+
+/**
+ * @brief 행/열 단위 대입 (대상은 at(i, j)를 가짐)
+ */
+template <class D, class E> inline void assign_dense(D &dst, const Expr<E> &expr) {
+    static_assert(D::rows == E::rows && D::cols == E::cols, "matrix dimension mismatch");
+    const E &e = expr.self();
+    if constexpr (E::direct) {
+        for (std::size_t i = 0; i < E::rows; i++) {
+            for (std::size_t j = 0; j < E::cols; j++) {
+                dst.at(i, j) = e(i, j);
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < E::rows; i++) {
+            float row[E::cols];
+            e.eval_row(i, 0, row);
+            for (std::size_t j = 0; j < E::cols; j++) {
+                dst.at(i, j) = row[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 고정 크기 행렬 (저장 공간 소유, C의 MATRIX_FIXED_DECLARE_TYPE와 같은 배치)
+ */
+template <std::size_t R, std::size_t C> struct Matrix : Expr<Matrix<R, C>> {
+    static constexpr std::size_t rows = R;
+    static constexpr std::size_t cols = C;
+    static constexpr bool direct = true;
+
+    alignas(8) float data[R][C]; // MATRIX_ALIGN
+
+    Matrix() = default;
+
+    template <class E> Matrix(const Expr<E> &e) { assign_dense(*this, e); }
+
+    template <class E> Matrix &operator=(const Expr<E> &e) {
+        assign_dense(*this, e);
+        return *this;
+    }
+
+    float operator()(std::size_t i, std::size_t j) const { return data[i][j]; }
+    float &at(std::size_t i, std::size_t j) { return data[i][j]; }
+
+    static Matrix zero() {
+        Matrix m{};
+        return m;
+    }
+
+    static Matrix identity() {
+        Matrix m{};
+        for (std::size_t i = 0; i < R && i < C; i++) {
+            m.data[i][i] = 1.0f;
+        }
+        return m;
+    }
+};
+
+/**
+ * @brief 행 우선 밀집 저장 공간 보기 (MatNxM.data, 복사 없음)
+ *
+ * @tparam T float (쓰기 가능) 또는 const float (읽기 전용)
+ */
+template <std::size_t R, std::size_t C, class T = float> struct MatrixRef : Expr<MatrixRef<R, C, T>> {
+    static constexpr std::size_t rows = R;
+    static constexpr std::size_t cols = C;
+    static constexpr bool direct = true;
+
+    T *p;
+
+    explicit MatrixRef(T *data) : p(data) {}
+    MatrixRef(const MatrixRef &) = default;
+
+    template <class E> MatrixRef &operator=(const Expr<E> &e) {
+        static_assert(!std::is_const<T>::value, "assignment to a read-only view");
+        assign_dense(*this, e);
+        return *this;
+    }
+    MatrixRef &operator=(const MatrixRef &e) { return operator=<MatrixRef>(e); }
+
+    float operator()(std::size_t i, std::size_t j) const { return p[i * C + j]; }
+    T &at(std::size_t i, std::size_t j) const { return p[i * C + j]; }
+};
+
+/**
+ * @brief 상삼각 압축 대칭 저장 공간 보기 (MatSymN.data, EKF.P, 복사 없음)
+ *
+ * 읽기는 (i, j)와 (j, i)가 같은 원소이다. 대입은 식의 상삼각(j >= i)만 계산해 쓴다
+ * (식이 대칭이라고 가정).
+ */
+template <std::size_t N, class T = float> struct SymRef : Expr<SymRef<N, T>> {
+    static constexpr std::size_t rows = N;
+    static constexpr std::size_t cols = N;
+    static constexpr bool direct = true;
+
+    T *p;
+
+    explicit SymRef(T *data) : p(data) {}
+    SymRef(const SymRef &) = default;
+
+    static constexpr std::size_t index(std::size_t i, std::size_t j) {
+        return (i <= j) ? i * (2 * N - i + 1) / 2 + (j - i) : j * (2 * N - j + 1) / 2 + (i - j);
+    }
+
+    template <class E> SymRef &operator=(const Expr<E> &expr) {
+        static_assert(!std::is_const<T>::value, "assignment to a read-only view");
+        static_assert(E::rows == N && E::cols == N, "matrix dimension mismatch");
+        const E &e = expr.self();
+        for (std::size_t i = 0; i < N; i++) {
+            float row[N];
+            e.eval_row(i, i, row);
+            T *dst = p + index(i, i);
+            for (std::size_t j = i; j < N; j++) {
+                dst[j - i] = row[j];
+            }
+        }
+        return *this;
+    }
+    SymRef &operator=(const SymRef &e) { return operator=<SymRef>(e); }
+
+    float operator()(std::size_t i, std::size_t j) const { return p[index(i, j)]; }
+};
+
+/**
+ * @brief 전치 (피연산자는 원소를 바로 읽을 수 있어야 함)
+ */
+template <class E> struct Transpose : Expr<Transpose<E>> {
+    static_assert(E::direct, "transpose of a product: evaluate into a Matrix first");
+    static constexpr std::size_t rows = E::cols;
+    static constexpr std::size_t cols = E::rows;
+    static constexpr bool direct = true;
+
+    typename Operand<E>::type e;
+
+    explicit Transpose(const E &expr) : e(expr) {}
+
+    float operator()(std::size_t i, std::size_t j) const { return e(j, i); }
+};
+
+template <class E> inline Transpose<E> Expr<E>::transpose() const { return Transpose<E>(self()); }
+
+/**
+ * @brief 원소별 합/차 (S = +1 또는 -1)
+ */
+template <class A, class B, int S> struct Sum : Expr<Sum<A, B, S>> {
+    static_assert(A::rows == B::rows && A::cols == B::cols, "matrix dimension mismatch");
+    static constexpr std::size_t rows = A::rows;
+    static constexpr std::size_t cols = A::cols;
+    static constexpr bool direct = A::direct && B::direct;
+
+    typename Operand<A>::type a;
+    typename Operand<B>::type b;
+
+    Sum(const A &lhs, const B &rhs) : a(lhs), b(rhs) {}
+
+    float operator()(std::size_t i, std::size_t j) const {
+        return (S > 0) ? a(i, j) + b(i, j) : a(i, j) - b(i, j);
+    }
+
+    void eval_row(std::size_t i, std::size_t first, float *out) const {
+        if constexpr (direct) {
+            Expr<Sum>::eval_row(i, first, out);
+        } else {
+            float rb[cols];
+            a.eval_row(i, first, out);
+            b.eval_row(i, first, rb);
+            for (std::size_t j = first; j < cols; j++) {
+                out[j] = (S > 0) ? out[j] + rb[j] : out[j] - rb[j];
+            }
+        }
+    }
+};
+
+/**
+ * @brief 스칼라 배
+ */
+template <class A> struct Scaled : Expr<Scaled<A>> {
+    static constexpr std::size_t rows = A::rows;
+    static constexpr std::size_t cols = A::cols;
+    static constexpr bool direct = A::direct;
+
+    typename Operand<A>::type a;
+    float s;
+
+    Scaled(const A &lhs, float scalar) : a(lhs), s(scalar) {}
+
+    float operator()(std::size_t i, std::size_t j) const { return s * a(i, j); }
+
+    void eval_row(std::size_t i, std::size_t first, float *out) const {
+        a.eval_row(i, first, out);
+        for (std::size_t j = first; j < cols; j++) {
+            out[j] *= s;
+        }
+    }
+};
+
+/**
+ * @brief 행렬 곱 (왼쪽은 행 단위로 계산, 오른쪽은 원소를 바로 읽음)
+ */
+template <class A, class B> struct Product : Expr<Product<A, B>> {
+    static_assert(A::cols == B::rows, "matrix dimension mismatch");
+    static_assert(B::direct, "right operand of a product must be directly readable: evaluate it into a Matrix");
+    static constexpr std::size_t rows = A::rows;
+    static constexpr std::size_t cols = B::cols;
+    static constexpr std::size_t inner = A::cols;
+    static constexpr bool direct = false;
+
+    typename Operand<A>::type a;
+    typename Operand<B>::type b;
+
+    Product(const A &lhs, const B &rhs) : a(lhs), b(rhs) {}
+
+    float operator()(std::size_t i, std::size_t j) const {
+        float ra[inner];
+        a.eval_row(i, 0, ra);
+        float sum = 0.0f;
+        for (std::size_t k = 0; k < inner; k++) {
+            sum += ra[k] * b(k, j);
+        }
+        return sum;
+    }
+
+    void eval_row(std::size_t i, std::size_t first, float *out) const {
+        float ra[inner];
+        a.eval_row(i, 0, ra);
+        for (std::size_t j = first; j < cols; j++) {
+            float sum = 0.0f;
+            for (std::size_t k = 0; k < inner; k++) {
+                sum += ra[k] * b(k, j);
+            }
+            out[j] = sum;
+        }
+    }
+};
+
+template <class A, class B> inline Sum<A, B, 1> operator+(const Expr<A> &a, const Expr<B> &b) {
+    return Sum<A, B, 1>(a.self(), b.self());
+}
+
+template <class A, class B> inline Sum<A, B, -1> operator-(const Expr<A> &a, const Expr<B> &b) {
+    return Sum<A, B, -1>(a.self(), b.self());
+}
+
+template <class A> inline Scaled<A> operator*(float s, const Expr<A> &a) { return Scaled<A>(a.self(), s); }
+
+template <class A> inline Scaled<A> operator*(const Expr<A> &a, float s) { return Scaled<A>(a.self(), s); }
+
+template <class A, class B> inline Product<A, B> operator*(const Expr<A> &a, const Expr<B> &b) {
+    return Product<A, B>(a.self(), b.self());
+}
+
+/**
+ * @brief C 행렬 구조체(data[R][C])의 보기
+ */
+template <class T>
+inline auto ref(T &m) -> MatrixRef<std::extent<decltype(m.data), 0>::value, std::extent<decltype(m.data), 1>::value> {
+    return MatrixRef<std::extent<decltype(m.data), 0>::value, std::extent<decltype(m.data), 1>::value>(&m.data[0][0]);
+}
+
+template <class T>
+inline auto ref(const T &m)
+    -> MatrixRef<std::extent<decltype(m.data), 0>::value, std::extent<decltype(m.data), 1>::value, const float> {
+    return MatrixRef<std::extent<decltype(m.data), 0>::value, std::extent<decltype(m.data), 1>::value, const float>(
+        &m.data[0][0]);
+}
+
+/**
+ * @brief 압축 원소 수에서 대칭 행렬 차원 (N(N+1)/2 = size)
+ */
+constexpr std::size_t sym_dim(std::size_t size) {
+    std::size_t n = 0;
+    while (n * (n + 1) / 2 < size) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief C 압축 대칭 구조체(data[N(N+1)/2])의 보기
+ */
+template <class T> inline auto sym(T &m) -> SymRef<sym_dim(std::extent<decltype(m.data)>::value)> {
+    constexpr std::size_t n = sym_dim(std::extent<decltype(m.data)>::value);
+    static_assert(n * (n + 1) / 2 == std::extent<decltype(m.data)>::value, "not a packed symmetric matrix");
+    return SymRef<n>(m.data);
+}
+
+template <class T> inline auto sym(const T &m) -> SymRef<sym_dim(std::extent<decltype(m.data)>::value), const float> {
+    constexpr std::size_t n = sym_dim(std::extent<decltype(m.data)>::value);
+    static_assert(n * (n + 1) / 2 == std::extent<decltype(m.data)>::value, "not a packed symmetric matrix");
+    return SymRef<n, const float>(m.data);
+}
+
+} // namespace math
+
+#endif /* MATRIX_HPP */
@@ -0,0 +1,275 @@
+/**
+ * @file matrix_fixed.h
+ * @brief 컴파일 타임에 크기가 정해지는 고정 크기 행렬 타입 및 연산
+ *
+ * 범용 Matrix는 항상 16x16 저장 공간(약 1KB)을 차지하므로,
+ * EKF 내부에서는 실제 차원에 맞는 저장 공간을 갖는 고정 크기 타입을 사용한다.
+ * 타입과 연산은 매크로로 생성되며, 차원이 타입에 포함되어 있으므로
+ * 차원 불일치는 컴파일 오류로 검출된다.
+ */
+
+#ifndef MATRIX_FIXED_H
+#define MATRIX_FIXED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "math/fp_mode.h"
+
+/**
+ * @brief 행렬 커널 백엔드 선택
+ *
+ * 정의하면 덧셈/뺄셈/스케일/전치/곱셈을 CMSIS-DSP(arm_add_f32, arm_mat_mult_f32 등)로
+ * 처리한다. CMSIS-DSP 헤더(arm_math.h)와 라이브러리(libarm_cortexM4lf_math)는
+ * 빌드 환경에서 제공해야 하며, ARM_MATH_CM4 정의가 필요하다.
+ * 미정의 시 이식성 있는 C 루프를 사용한다 (호스트 빌드 및 기본값).
+ */
+/* #define MATRIX_USE_CMSIS_DSP */
+
+/**
+ * @brief 행렬 저장 공간 정렬 (바이트)
+ *
+ * 모든 고정 크기/압축 대칭 행렬의 data를 8바이트 경계에 두어, 컴파일러가 연속 원소를
+ * LDRD/STRD와 VLDM/VSTM 다중 레지스터 전송(double word 단위)으로 읽고 쓰게 한다.
+ * 원소 단위 커널은 R x C 원소를 한 줄로 도는 루프이며 MATRIX_ASSUME_ALIGNED로 정렬을
+ * 알려 준다. 구조체 크기는 8바이트 배수로 올림되므로(예: Mat3x3 40바이트) 원소 수는
+ * sizeof(m)가 아니라 sizeof(m.data)나 R x C로 센다. scratch_alloc(SCRATCH_ALIGN)과
+ * block_pool(BLOCK_POOL_ALIGN)도 같은 정렬을 보장한다.
+ */
+#define MATRIX_ALIGN 8
+#define MATRIX_ASSUME_ALIGNED(p) __builtin_assume_aligned((p), MATRIX_ALIGN)
+
+/**
+ * @brief 고정 크기 행렬 타입 선언
+ *
+ * @param T 타입 이름 (예: Mat16x16)
+ * @param R 행 수
+ * @param C 열 수
+ */
+#define MATRIX_FIXED_DECLARE_TYPE(T, R, C)                 \
+    typedef struct {                                       \
+        float data[R][C];                                  \
+    } __attribute__((aligned(MATRIX_ALIGN))) T
+
+/**
+ * @brief 경계 검사 (디버그 빌드 전용)
+ *
+ * MATRIX_DEBUG_CHECKS를 정의하면 assert로 검사하고, 미정의 시 아무 코드도 만들지 않는다.
+ */
+/* #define MATRIX_DEBUG_CHECKS */
+#ifdef MATRIX_DEBUG_CHECKS
+#define MATRIX_ASSERT(cond) assert(cond)
+#else
+#define MATRIX_ASSERT(cond) ((void)0)
+#endif
+
+/**
+ * @brief 고정 크기 행렬의 행/열 수 (타입에서 계산)
+ */
+#define MATRIX_ROWS(m) ((uint8_t)(sizeof((m)->data) / sizeof((m)->data[0])))
+#define MATRIX_COLS(m) ((uint8_t)(sizeof((m)->data[0]) / sizeof((m)->data[0][0])))
+
+/**
+ * @brief 검사 없는 원소 접근 (좌변값, 필터 내부 커널용)
+ *
+ * P##_get/P##_set은 경계를 검사하는 함수 호출이므로 스칼라마다 비용이 든다.
+ * 인덱스가 상태 인덱스 상수 등으로 정해진 내부 코드는 이 매크로로 직접 접근한다.
+ * 경계는 MATRIX_DEBUG_CHECKS 빌드에서만 검사한다.
+ */
+#define MATRIX_AT(m, row, col) \
+    (*(MATRIX_ASSERT((row) < MATRIX_ROWS(m) && (col) < MATRIX_COLS(m)), &(m)->data[(row)][(col)]))
+
+/**
+ * @brief 고정 크기 행렬 원소 단위 연산 선언
+ *
+ * 생성되는 함수: P##_zero, P##_set, P##_get, P##_add, P##_subtract, P##_scale,
+ * P##_add_scaled (m = m + scalar * b, 제자리)
+ * add/subtract/scale은 result가 입력과 같은 행렬이어도 된다.
+ */
+#define MATRIX_FIXED_DECLARE_OPS(T, P)                                      \
+    void P##_zero(T *m);                                                    \
+    bool P##_set(T *m, uint8_t row, uint8_t col, float value);              \
+    bool P##_get(const T *m, uint8_t row, uint8_t col, float *value);       \
+    void P##_add(const T *a, const T *b, T *result);                        \
+    void P##_subtract(const T *a, const T *b, T *result);                   \
+    void P##_scale(const T *m, float scalar, T *result);                    \
+    void P##_add_scaled(T *m, const T *b, float scalar)
+
+/**
+ * @brief 정방 고정 크기 행렬 연산 선언
+ *
+ * 생성되는 함수: P##_identity, P##_diagonal_vector, P##_inverse
+ */
+#define MATRIX_FIXED_DECLARE_SQUARE_OPS(T, P)                               \
+    void P##_identity(T *m);                                                \
+    void P##_diagonal_vector(T *m, const float *values);                    \
+    bool P##_inverse(const T *m, T *result)
+
+/**
+ * @brief 대칭 양정치 행렬의 LDL^T 분해와 풀이 선언 (측정 혁신 공분산 S용)
+ *
+ * 생성되는 함수:
+ * - P##_ldlt(m, ld): m = L D L^T 분해. ld의 하삼각에 단위 하삼각 L(대각 제외),
+ *   대각에 1/D를 저장하며 상삼각은 쓰지 않는다. D가 양수가 아니면 false.
+ * - P##_ldlt_solve(ld, b): b = m^-1 b (길이 N 벡터, 제자리)
+ *
+ * 역행렬을 만들지 않고 풀이로 K = PH^T S^-1과 NIS를 계산하며, 피벗 탐색이 없으므로
+ * 연산 순서가 데이터와 무관하다.
+ */
+#define MATRIX_FIXED_DECLARE_LDLT(T, P)                                     \
+    bool P##_ldlt(const T *m, T *ld);                                       \
+    void P##_ldlt_solve(const T *ld, float *b)
+
+/**
+ * @brief 고정 크기 행렬 전치 선언 (TA: R x C, TR: C x R)
+ */
+#define MATRIX_FIXED_DECLARE_TRANSPOSE(FN, TA, TR) \
+    void FN(const TA *m, TR *result)
+
+/**
+ * @brief 고정 크기 행렬 곱셈 선언 (TA: R x K, TB: K x C, TR: R x C)
+ *
+ * result는 a, b와 다른 행렬이어야 한다.
+ */
+#define MATRIX_FIXED_DECLARE_MULTIPLY(FN, TA, TB, TR) \
+    void FN(const TA *a, const TB *b, TR *result)
+
+/**
+ * @brief 고정 크기 행렬 곱셈 누적 선언 (result = result + a * b)
+ *
+ * 곱셈 결과를 임시 행렬 없이 result에 바로 더한다.
+ * result는 a, b와 다른 행렬이어야 한다.
+ */
+#define MATRIX_FIXED_DECLARE_MULTIPLY_ADD(FN, TA, TB, TR) \
+    void FN(const TA *a, const TB *b, TR *result)
+
+/**
+ * @brief 고정 크기 전치 곱셈 선언 (TA: R x K, TB: C x K, result = a * b^T)
+ *
+ * b의 전치 행렬을 따로 만들지 않는다. result는 a, b와 다른 행렬이어야 한다.
+ */
+#define MATRIX_FIXED_DECLARE_MULTIPLY_TRANSPOSE(FN, TA, TB, TR) \
+    void FN(const TA *a, const TB *b, TR *result)
+
+/**
+ * @brief 상태 차원 N 필터용 행렬 묶음 선언
+ *
+ * N x N, N x 6, N x 3, N x 1 타입과 원소 연산, N x N 정방 연산,
+ * 측정 차원 6, 3, 1에 대한 게인 곱셈(N x M * M x M)과 상태 갱신 누적(N x M * M x 1)을 만든다.
+ * 축소 상태 구성과 수신기 시계 상태 구성(ekf_config.h)에서 사용한다.
+ */
+#define MATRIX_FIXED_DECLARE_FILTER_SET(N)                                                          \
+    MATRIX_FIXED_DECLARE_TYPE(Mat##N##x##N, N, N);                                                  \
+    MATRIX_FIXED_DECLARE_TYPE(Mat##N##x6, N, 6);                                                    \
+    MATRIX_FIXED_DECLARE_TYPE(Mat##N##x3, N, 3);                                                    \
+    MATRIX_FIXED_DECLARE_TYPE(Mat##N##x1, N, 1);                                                    \
+    MATRIX_FIXED_DECLARE_OPS(Mat##N##x##N, mat##N##x##N);                                           \
+    MATRIX_FIXED_DECLARE_OPS(Mat##N##x6, mat##N##x6);                                               \
+    MATRIX_FIXED_DECLARE_OPS(Mat##N##x3, mat##N##x3);                                               \
+    MATRIX_FIXED_DECLARE_OPS(Mat##N##x1, mat##N##x1);                                               \
+    MATRIX_FIXED_DECLARE_SQUARE_OPS(Mat##N##x##N, mat##N##x##N);                                    \
+    MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_##N##x6_6x6, Mat##N##x6, Mat6x6, Mat##N##x6);        \
+    MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_##N##x3_3x3, Mat##N##x3, Mat3x3, Mat##N##x3);        \
+    MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_##N##x1_1x1, Mat##N##x1, Mat1x1, Mat##N##x1);        \
+    MATRIX_FIXED_DECLARE_MULTIPLY_ADD(mat_multiply_add_##N##x6_6x1, Mat##N##x6, Mat6x1, Mat##N##x1); \
+    MATRIX_FIXED_DECLARE_MULTIPLY_ADD(mat_multiply_add_##N##x3_3x1, Mat##N##x3, Mat3x1, Mat##N##x1); \
+    MATRIX_FIXED_DECLARE_MULTIPLY_ADD(mat_multiply_add_##N##x1_1x1, Mat##N##x1, Mat1x1, Mat##N##x1)
+
+/* 고정 크기 행렬 타입 */
+MATRIX_FIXED_DECLARE_TYPE(Mat16x16, 16, 16);
+MATRIX_FIXED_DECLARE_TYPE(Mat16x6, 16, 6);
+MATRIX_FIXED_DECLARE_TYPE(Mat16x3, 16, 3);
+MATRIX_FIXED_DECLARE_TYPE(Mat16x1, 16, 1);
+MATRIX_FIXED_DECLARE_TYPE(Mat6x16, 6, 16);
+MATRIX_FIXED_DECLARE_TYPE(Mat3x16, 3, 16);
+MATRIX_FIXED_DECLARE_TYPE(Mat1x16, 1, 16);
+MATRIX_FIXED_DECLARE_TYPE(Mat15x15, 15, 15);
+MATRIX_FIXED_DECLARE_TYPE(Mat15x1, 15, 1);
+MATRIX_FIXED_DECLARE_TYPE(Mat9x9, 9, 9);
+MATRIX_FIXED_DECLARE_TYPE(Mat6x6, 6, 6);
+MATRIX_FIXED_DECLARE_TYPE(Mat6x1, 6, 1);
+MATRIX_FIXED_DECLARE_TYPE(Mat3x3, 3, 3);
+MATRIX_FIXED_DECLARE_TYPE(Mat3x1, 3, 1);
+MATRIX_FIXED_DECLARE_TYPE(Mat1x1, 1, 1);
+
+/* 원소 단위 연산 */
+MATRIX_FIXED_DECLARE_OPS(Mat16x16, mat16x16);
+MATRIX_FIXED_DECLARE_OPS(Mat16x6, mat16x6);
+MATRIX_FIXED_DECLARE_OPS(Mat16x3, mat16x3);
+MATRIX_FIXED_DECLARE_OPS(Mat16x1, mat16x1);
+MATRIX_FIXED_DECLARE_OPS(Mat6x16, mat6x16);
+MATRIX_FIXED_DECLARE_OPS(Mat3x16, mat3x16);
+MATRIX_FIXED_DECLARE_OPS(Mat1x16, mat1x16);
+MATRIX_FIXED_DECLARE_OPS(Mat15x15, mat15x15);
+MATRIX_FIXED_DECLARE_OPS(Mat15x1, mat15x1);
+MATRIX_FIXED_DECLARE_OPS(Mat6x6, mat6x6);
+MATRIX_FIXED_DECLARE_OPS(Mat6x1, mat6x1);
+MATRIX_FIXED_DECLARE_OPS(Mat3x3, mat3x3);
+MATRIX_FIXED_DECLARE_OPS(Mat3x1, mat3x1);
+MATRIX_FIXED_DECLARE_OPS(Mat1x1, mat1x1);
+
+/* 정방 행렬 연산 */
+MATRIX_FIXED_DECLARE_SQUARE_OPS(Mat16x16, mat16x16);
+MATRIX_FIXED_DECLARE_SQUARE_OPS(Mat15x15, mat15x15);
+MATRIX_FIXED_DECLARE_SQUARE_OPS(Mat6x6, mat6x6);
+MATRIX_FIXED_DECLARE_SQUARE_OPS(Mat3x3, mat3x3);
+MATRIX_FIXED_DECLARE_SQUARE_OPS(Mat1x1, mat1x1);
+
+/* LDL^T 분해/풀이: 측정 차원 9 (항법 오차 전체, 연합 필터), 6, 3, 1 */
+MATRIX_FIXED_DECLARE_LDLT(Mat9x9, mat9x9);
+MATRIX_FIXED_DECLARE_LDLT(Mat6x6, mat6x6);
+MATRIX_FIXED_DECLARE_LDLT(Mat3x3, mat3x3);
+MATRIX_FIXED_DECLARE_LDLT(Mat1x1, mat1x1);
+
+/* 전치 */
+MATRIX_FIXED_DECLARE_TRANSPOSE(mat16x16_transpose, Mat16x16, Mat16x16);
+MATRIX_FIXED_DECLARE_TRANSPOSE(mat6x16_transpose, Mat6x16, Mat16x6);
+MATRIX_FIXED_DECLARE_TRANSPOSE(mat3x16_transpose, Mat3x16, Mat16x3);
+MATRIX_FIXED_DECLARE_TRANSPOSE(mat1x16_transpose, Mat1x16, Mat16x1);
+
+/* 곱셈: 공분산 전파 */
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x16_16x16, Mat16x16, Mat16x16, Mat16x16);
+
+/* 곱셈: 측정 갱신 (측정 차원 6, 3, 1) */
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_6x16_16x16, Mat6x16, Mat16x16, Mat6x16);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_6x16_16x6, Mat6x16, Mat16x6, Mat6x6);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x16_16x6, Mat16x16, Mat16x6, Mat16x6);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x6_6x6, Mat16x6, Mat6x6, Mat16x6);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x6_6x1, Mat16x6, Mat6x1, Mat16x1);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x6_6x16, Mat16x6, Mat6x16, Mat16x16);
+
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_3x16_16x16, Mat3x16, Mat16x16, Mat3x16);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_3x16_16x3, Mat3x16, Mat16x3, Mat3x3);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x16_16x3, Mat16x16, Mat16x3, Mat16x3);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x3_3x3, Mat16x3, Mat3x3, Mat16x3);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x3_3x1, Mat16x3, Mat3x1, Mat16x1);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x3_3x16, Mat16x3, Mat3x16, Mat16x16);
+
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_1x16_16x16, Mat1x16, Mat16x16, Mat1x16);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_1x16_16x1, Mat1x16, Mat16x1, Mat1x1);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x16_16x1, Mat16x16, Mat16x1, Mat16x1);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x1_1x1, Mat16x1, Mat1x1, Mat16x1);
+MATRIX_FIXED_DECLARE_MULTIPLY(mat_multiply_16x1_1x16, Mat16x1, Mat1x16, Mat16x16);
+
+/* 곱셈 누적: 상태 갱신 x = x + K * y (측정 차원 6, 3, 1) */
+MATRIX_FIXED_DECLARE_MULTIPLY_ADD(mat_multiply_add_16x6_6x1, Mat16x6, Mat6x1, Mat16x1);
+MATRIX_FIXED_DECLARE_MULTIPLY_ADD(mat_multiply_add_16x3_3x1, Mat16x3, Mat3x1, Mat16x1);
+MATRIX_FIXED_DECLARE_MULTIPLY_ADD(mat_multiply_add_16x1_1x1, Mat16x1, Mat1x1, Mat16x1);
+
+/* 전치 곱셈: 공분산 전파 (F * P) * F^T */
+MATRIX_FIXED_DECLARE_MULTIPLY_TRANSPOSE(mat_multiply_transpose_16x16_16x16, Mat16x16, Mat16x16, Mat16x16);
+
+/* 수신기 시계 상태 포함 필터용 (18차원) */
+MATRIX_FIXED_DECLARE_FILTER_SET(18);
+
+/* 자력계 바이어스 상태 포함 필터용 (19차원) */
+MATRIX_FIXED_DECLARE_FILTER_SET(19);
+
+/* 항력 계수 상태 포함 필터용 (17차원) */
+MATRIX_FIXED_DECLARE_FILTER_SET(17);
+
+/* 축소 상태 필터용 (위치 또는 가속도 바이어스 제외 13차원, 둘 다 제외 10차원) */
+MATRIX_FIXED_DECLARE_FILTER_SET(13);
+MATRIX_FIXED_DECLARE_FILTER_SET(10);
+
+#endif /* MATRIX_FIXED_H */
@@ -0,0 +1,132 @@
+/**
+ * @file matrix_sparse.h
+ * @brief 희소 행 및 희소 상태 전이 표현
+ *
+ * EKF의 상태 전이 행렬 F는 단위 행렬에 몇 개의 알려진 블록
+ * (위치-속도, 사원수-자이로 바이어스, 속도-가속도 바이어스)이 더해진 형태이다.
+ * F = I + E 로 두고, E의 0이 아닌 행만 (열 인덱스, 값) 쌍으로 저장한다.
+ */
+
+#ifndef MATRIX_SPARSE_H
+#define MATRIX_SPARSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/fp_mode.h"
+
+/**
+ * @brief 희소 행 하나의 최대 비영 원소 수
+ *
+ * 오차 상태 필터의 속도 행(자세 오차 3 + 가속도 바이어스 3) 기준
+ */
+#define MATRIX_SPARSE_ROW_MAX 6
+
+/**
+ * @brief 희소 전이 행렬의 최대 비영 행 수
+ *
+ * EKF 전이 행렬 구조 기준 (위치 3 + 속도 3 + 사원수 4 + 수신기 시계 바이어스 1)
+ */
+#define MATRIX_SPARSE_TRANSITION_MAX_ROWS 11
+
+/**
+ * @brief 희소 행 (열 인덱스, 값) 쌍 목록
+ */
+typedef struct {
+    uint8_t count;                         /**< 비영 원소 수 */
+    uint8_t index[MATRIX_SPARSE_ROW_MAX];  /**< 열 인덱스 */
+    float value[MATRIX_SPARSE_ROW_MAX];    /**< 원소 값 */
+} MatrixSparseRow;
+
+/**
+ * @brief 희소 상태 전이 행렬 (F = I + E)
+ *
+ * E의 비영 행만 저장하며, 행 인덱스는 중복되지 않아야 한다.
+ */
+typedef struct {
+    uint8_t count;                                        /**< 비영 행 수 */
+    uint8_t row[MATRIX_SPARSE_TRANSITION_MAX_ROWS];       /**< 행 인덱스 */
+    MatrixSparseRow e[MATRIX_SPARSE_TRANSITION_MAX_ROWS]; /**< 행별 비영 원소 */
+} MatrixSparseTransition;
+
+/**
+ * @brief 희소 행 초기화 (영 행)
+ *
+ * @param row 희소 행
+ */
+void matrix_sparse_row_clear(MatrixSparseRow *row);
+
+/**
+ * @brief 희소 행에 비영 원소 추가
+ *
+ * @param row 희소 행
+ * @param col 열 인덱스 (행 내에서 중복되지 않아야 함)
+ * @param value 원소 값
+ * @return bool 성공 여부 (용량 초과 시 false)
+ */
+bool matrix_sparse_row_add(MatrixSparseRow *row, uint8_t col, float value);
+
+/**
+ * @brief 밀집 행에서 희소 행 생성
+ *
+ * 측정 자코비안 H의 한 행처럼 대부분이 0인 행을 (열, 값) 쌍으로 압축한다.
+ *
+ * @param dense 밀집 행 (길이 n)
+ * @param n 행 길이
+ * @param row 결과 희소 행
+ * @return bool 성공 여부 (비영 원소가 MATRIX_SPARSE_ROW_MAX 초과 시 false)
+ */
+bool matrix_sparse_row_from_dense(const float *dense, uint8_t n, MatrixSparseRow *row);
+
+/**
+ * @brief 희소 행과 밀집 벡터의 내적
+ *
+ * @param row 희소 행
+ * @param v 밀집 벡터
+ * @return float 내적 결과
+ */
+float matrix_sparse_row_dot(const MatrixSparseRow *row, const float *v);
+
+/**
+ * @brief 희소 전이 행렬 초기화 (F = I)
+ *
+ * @param t 희소 전이 행렬
+ */
+void matrix_sparse_transition_clear(MatrixSparseTransition *t);
+
+/**
+ * @brief 희소 전이 행렬에 E 원소 추가
+ *
+ * 같은 행이 이미 있으면 그 행에 원소를 추가하고, 없으면 새 행을 만든다.
+ *
+ * @param t 희소 전이 행렬
+ * @param row 행 인덱스
+ * @param col 열 인덱스
+ * @param value 원소 값 (F(row, col) - I(row, col))
+ * @return bool 성공 여부 (용량 초과 시 false)
+ */
+bool matrix_sparse_transition_add(MatrixSparseTransition *t, uint8_t row, uint8_t col, float value);
+
+/**
+ * @brief 두 희소 전이 행렬의 곱 (I + E_r) = (I + E_a) * (I + E_b)
+ *
+ * E_r = E_a + E_b + E_a * E_b 를 비영 원소만으로 계산한다.
+ * 여러 시간 단계의 전이를 누적할 때 a에 나중 단계, b에 누적값을 둔다.
+ *
+ * @param a 왼쪽 전이 행렬 (나중 단계)
+ * @param b 오른쪽 전이 행렬 (앞선 단계)
+ * @param result 결과 전이 행렬 (a, b와 겹치면 안 됨)
+ * @return bool 성공 여부 (용량 초과 시 false)
+ */
+bool matrix_sparse_transition_compose(const MatrixSparseTransition *a, const MatrixSparseTransition *b,
+                                      MatrixSparseTransition *result);
+
+/**
+ * @brief 희소 전이 행렬을 밀집 배열로 전개 (F = I + E)
+ *
+ * @param t 희소 전이 행렬
+ * @param dense 결과 행 우선 n x n 배열
+ * @param n 행렬 차원
+ */
+void matrix_sparse_transition_to_dense(const MatrixSparseTransition *t, float *dense, uint8_t n);
+
+#endif /* MATRIX_SPARSE_H */
@@ -0,0 +1,197 @@
+/**
+ * @file matrix_sym.h
+ * @brief 대칭 행렬 상삼각 압축 저장 타입 및 대칭성 활용 연산
+ *
+ * N x N 대칭 행렬의 상삼각 부분(i <= j)만 행 우선 순서로 저장한다.
+ * 16x16 공분산의 경우 256개 대신 136개의 float만 사용하며,
+ * 모든 연산은 고유 원소만 계산하므로 별도의 대칭화 과정이 필요 없다.
+ *
+ * 저장 순서 (N = 4 예시):
+ *   [ 0  1  2  3 ]
+ *   [    4  5  6 ]
+ *   [       7  8 ]
+ *   [          9 ]
+ */
+
+#ifndef MATRIX_SYM_H
+#define MATRIX_SYM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/matrix_fixed.h"
+#include "math/matrix_sparse.h"
+
+/**
+ * @brief N x N 대칭 행렬의 압축 저장 원소 수
+ */
+#define MATRIX_SYM_SIZE(N) ((N) * ((N) + 1) / 2)
+
+/**
+ * @brief 압축 대칭 행렬 타입 선언
+ *
+ * @param T 타입 이름 (예: MatSym16)
+ * @param N 행렬 차원
+ */
+#define MATRIX_SYM_DECLARE_TYPE(T, N)                      \
+    typedef struct {                                       \
+        float data[MATRIX_SYM_SIZE(N)];                    \
+    } __attribute__((aligned(MATRIX_ALIGN))) T
+
+/**
+ * @brief 압축 대칭 행렬 기본 연산 선언
+ *
+ * 생성되는 함수:
+ * - P##_index: (row, col) -> 압축 배열 인덱스 (순서 무관)
+ * - P##_zero, P##_identity, P##_diagonal_vector
+ * - P##_set, P##_get: (row, col)과 (col, row)는 같은 원소
+ * - P##_from_dense: 밀집 행렬의 상삼각 부분을 압축
+ * - P##_to_dense: 압축 행렬을 밀집 행렬로 전개
+ * - P##_add_scaled: m = m + scalar * b
+ * - P##_propagate: result = F * m * F^T (상삼각만 계산, result != m)
+ * - P##_bound_diagonal: 대각 원소를 [lo_i, hi_i]로 제한하고 제한한 원소 수 반환.
+ *   하한은 대각만 올리고(상관 계수는 줄기만 함), 상한은 행/열 i를 sqrt(hi_i / m_ii)배 하여
+ *   상관 계수를 유지한다. 두 경우 모두 양의 준정부호가 유지되며, 경계 안이면 대각 N개만 읽는다.
+ *   NaN 대각은 건드리지 않는다.
+ *
+ * @param T 압축 대칭 행렬 타입
+ * @param P 함수 접두사
+ * @param TD 같은 차원의 밀집 정방 행렬 타입
+ * @param N 행렬 차원
+ */
+#define MATRIX_SYM_DECLARE_OPS(T, P, TD, N)                                  \
+    static inline uint16_t P##_index(uint8_t row, uint8_t col) {             \
+        if (row > col) {                                                     \
+            uint8_t temp = row;                                              \
+            row = col;                                                       \
+            col = temp;                                                      \
+        }                                                                    \
+        return (uint16_t)(row * (2 * (N) - row + 1) / 2 + (col - row));      \
+    }                                                                        \
+    void P##_zero(T *m);                                                     \
+    void P##_identity(T *m);                                                 \
+    void P##_diagonal_vector(T *m, const float *values);                     \
+    bool P##_set(T *m, uint8_t row, uint8_t col, float value);               \
+    bool P##_get(const T *m, uint8_t row, uint8_t col, float *value);        \
+    void P##_from_dense(const TD *src, T *dst);                              \
+    void P##_to_dense(const T *src, TD *dst);                                \
+    void P##_add_scaled(T *m, const T *b, float scalar);                     \
+    void P##_propagate(const TD *F, const T *m, T *result);                  \
+    uint8_t P##_bound_diagonal(T *m, const float *lo, const float *hi)
+
+/**
+ * @brief 대칭 행렬과 밀집 행렬의 곱 선언 (result = S * B)
+ *
+ * S: N x N 압축 대칭, B/result: N x M 밀집. result는 b와 달라야 한다.
+ */
+#define MATRIX_SYM_DECLARE_MULTIPLY(FN, T, TB) \
+    void FN(const T *s, const TB *b, TB *result)
+
+/**
+ * @brief 대칭 저계수 차감 선언 (m = m - A * B^T)
+ *
+ * A, B: N x M 밀집. A * B^T가 대칭인 경우(예: K * (P H^T)^T)에만
+ * 의미가 있으며, 상삼각 원소만 계산한다.
+ */
+#define MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(FN, T, TA) \
+    void FN(T *m, const TA *a, const TA *b)
+
+/**
+ * @brief Joseph 형식 공분산 갱신 선언 (m = m - K*A^T - A*K^T + K*C*K^T)
+ *
+ * K, A: N x M 밀집, C: M x M. 측정 갱신에서 A = P * H^T, C = S 로 두면
+ * (I - K*H) * P * (I - K*H)^T + K * R * K^T 와 같다.
+ * 반올림된 K에 대해서도 대칭/양의 준정부호를 유지하며, 상삼각 원소만 계산한다.
+ */
+#define MATRIX_SYM_DECLARE_JOSEPH_UPDATE(FN, T, TA, TC) \
+    void FN(T *m, const TA *k, const TA *a, const TC *c)
+
+/**
+ * @brief 희소 전이 행렬을 이용한 제자리 공분산 전파 선언
+ *
+ * m = (I + E) * m * (I + E)^T
+ * = m + E*m + m*E^T + E*m*E^T 를 E의 비영 원소만으로 계산한다.
+ * W = m * E^T 를 비영 행에 대해서만 먼저 구하므로 각 원소는
+ * 자기 자신의 이전 값만 참조하며, 따라서 제자리 갱신이 가능하다.
+ */
+#define MATRIX_SYM_DECLARE_PROPAGATE_SPARSE(FN, T) \
+    void FN(T *m, const MatrixSparseTransition *E)
+
+/**
+ * @brief 대칭 행렬과 희소 행 묶음 전치의 곱 선언 (result = S * H^T)
+ *
+ * H: M개의 희소 행, result: N x M 밀집. 측정 갱신의 P * H^T 계산용이며,
+ * H의 비영 열에 해당하는 S의 열만 모은다 (비영 원소가 1개인 행은 열 복사).
+ */
+#define MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(FN, T, TB) \
+    void FN(const T *s, const MatrixSparseRow *h, TB *result)
+
+/**
+ * @brief 상태 차원 N 필터용 압축 대칭 행렬 묶음 선언
+ *
+ * MatSym##N 타입과 기본 연산, 희소 전파, 측정 차원 6, 3, 1에 대한
+ * 희소 H 곱셈/대칭 차감/Joseph 갱신을 만든다. 축소 상태 구성과 수신기 시계 상태 구성(ekf_config.h)에서 사용한다.
+ */
+#define MATRIX_SYM_DECLARE_FILTER_SET(N)                                                               \
+    MATRIX_SYM_DECLARE_TYPE(MatSym##N, N);                                                             \
+    MATRIX_SYM_DECLARE_OPS(MatSym##N, matsym##N, Mat##N##x##N, N);                                     \
+    MATRIX_SYM_DECLARE_PROPAGATE_SPARSE(matsym##N##_propagate_sparse, MatSym##N);                      \
+    MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym##N##_multiply_sparse_##N##x6, MatSym##N, Mat##N##x6);    \
+    MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym##N##_multiply_sparse_##N##x3, MatSym##N, Mat##N##x3);    \
+    MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym##N##_multiply_sparse_##N##x1, MatSym##N, Mat##N##x1);    \
+    MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym##N##_subtract_product_##N##x6, MatSym##N, Mat##N##x6);  \
+    MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym##N##_subtract_product_##N##x3, MatSym##N, Mat##N##x3);  \
+    MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym##N##_subtract_product_##N##x1, MatSym##N, Mat##N##x1);  \
+    MATRIX_SYM_DECLARE_JOSEPH_UPDATE(matsym##N##_joseph_update_##N##x6, MatSym##N, Mat##N##x6, Mat6x6); \
+    MATRIX_SYM_DECLARE_JOSEPH_UPDATE(matsym##N##_joseph_update_##N##x3, MatSym##N, Mat##N##x3, Mat3x3); \
+    MATRIX_SYM_DECLARE_JOSEPH_UPDATE(matsym##N##_joseph_update_##N##x1, MatSym##N, Mat##N##x1, Mat1x1)
+
+/* 압축 대칭 행렬 타입 */
+MATRIX_SYM_DECLARE_TYPE(MatSym16, 16);
+MATRIX_SYM_DECLARE_TYPE(MatSym15, 15);
+
+/* 기본 연산 */
+MATRIX_SYM_DECLARE_OPS(MatSym16, matsym16, Mat16x16, 16);
+
+/* 희소 전이 공분산 전파 */
+MATRIX_SYM_DECLARE_PROPAGATE_SPARSE(matsym16_propagate_sparse, MatSym16);
+
+/* 측정 갱신용 곱셈 (측정 차원 6, 3, 1) */
+MATRIX_SYM_DECLARE_MULTIPLY(matsym16_multiply_16x6, MatSym16, Mat16x6);
+MATRIX_SYM_DECLARE_MULTIPLY(matsym16_multiply_16x3, MatSym16, Mat16x3);
+MATRIX_SYM_DECLARE_MULTIPLY(matsym16_multiply_16x1, MatSym16, Mat16x1);
+
+/* 측정 갱신용 희소 H 곱셈 (측정 차원 6, 3, 1) */
+MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym16_multiply_sparse_16x6, MatSym16, Mat16x6);
+MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym16_multiply_sparse_16x3, MatSym16, Mat16x3);
+MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym16_multiply_sparse_16x1, MatSym16, Mat16x1);
+
+/* 측정 갱신용 대칭 차감 (측정 차원 6, 3, 1) */
+MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym16_subtract_product_16x6, MatSym16, Mat16x6);
+MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym16_subtract_product_16x3, MatSym16, Mat16x3);
+MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym16_subtract_product_16x1, MatSym16, Mat16x1);
+
+/* 측정 갱신용 Joseph 형식 공분산 갱신 (측정 차원 6, 3, 1) */
+MATRIX_SYM_DECLARE_JOSEPH_UPDATE(matsym16_joseph_update_16x6, MatSym16, Mat16x6, Mat6x6);
+MATRIX_SYM_DECLARE_JOSEPH_UPDATE(matsym16_joseph_update_16x3, MatSym16, Mat16x3, Mat3x3);
+MATRIX_SYM_DECLARE_JOSEPH_UPDATE(matsym16_joseph_update_16x1, MatSym16, Mat16x1, Mat1x1);
+
+/* 오차 상태 필터용 15차원 연산 */
+MATRIX_SYM_DECLARE_OPS(MatSym15, matsym15, Mat15x15, 15);
+MATRIX_SYM_DECLARE_PROPAGATE_SPARSE(matsym15_propagate_sparse, MatSym15);
+MATRIX_SYM_DECLARE_MULTIPLY_SPARSE(matsym15_multiply_sparse_15x1, MatSym15, Mat15x1);
+MATRIX_SYM_DECLARE_SUBTRACT_PRODUCT(matsym15_subtract_product_15x1, MatSym15, Mat15x1);
+
+/* 수신기 시계 상태 포함 필터용 (18차원) */
+MATRIX_SYM_DECLARE_FILTER_SET(18);
+
+/* 자력계 바이어스 상태 포함 필터용 (19차원) */
+MATRIX_SYM_DECLARE_FILTER_SET(19);
+
+/* 항력 계수 상태 포함 필터용 (17차원) */
+MATRIX_SYM_DECLARE_FILTER_SET(17);
+
+/* 축소 상태 필터용 (13차원, 10차원) */
+MATRIX_SYM_DECLARE_FILTER_SET(13);
+MATRIX_SYM_DECLARE_FILTER_SET(10);
+
+#endif /* MATRIX_SYM_H */
@@ -0,0 +1,81 @@
+/**
+ * @file matrix_ud.h
+ * @brief 공분산의 U-D 분해 표현 (P = U * D * U^T) 및 Bierman/Thornton 연산
+ *
+ * U는 대각 원소가 1인 상삼각 행렬, D는 대각 행렬이다.
+ * 압축 대칭 행렬(matrix_sym.h)과 같은 상삼각 행 우선 배열을 사용하며,
+ * 대각 위치에 D_i, 비대각 위치(i < j)에 U_ij를 저장한다 (U의 대각 1은 저장하지 않음).
+ *
+ * - 시간 전파: Thornton의 가중 수정 Gram-Schmidt (P = F * P * F^T + diag(q))
+ * - 측정 갱신: Bierman의 스칼라 갱신 (역행렬 없음)
+ *
+ * D가 항상 음이 아니게 유지되므로 단정밀도에서도 P가 양의 준정부호를 잃지 않는다.
+ */
+
+#ifndef MATRIX_UD_H
+#define MATRIX_UD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/matrix_fixed.h"
+#include "math/matrix_sparse.h"
+#include "math/matrix_sym.h"
+
+/**
+ * @brief Thornton 전파 작업 메모리 크기 (float 개수)
+ *
+ * N x 2N 가중 행렬 W와 가중치/임시 벡터 2개 (N = 16이면 2304 바이트)
+ */
+#define MATRIX_UD_PROPAGATE_WORK_SIZE(N) ((N) * 2 * (N) + 2 * 2 * (N))
+
+/**
+ * @brief U-D 분해 타입 선언
+ *
+ * @param T 타입 이름 (예: MatUD16)
+ * @param N 행렬 차원
+ */
+#define MATRIX_UD_DECLARE_TYPE(T, N)                       \
+    typedef struct {                                       \
+        float data[MATRIX_SYM_SIZE(N)];                    \
+    } __attribute__((aligned(MATRIX_ALIGN))) T
+
+/**
+ * @brief U-D 분해 연산 선언
+ *
+ * 생성되는 함수:
+ * - P##_from_sym: 압축 대칭 P를 U-D로 분해 (양의 정부호가 아니면 음수 D를 0으로 두고 false)
+ * - P##_to_sym: P = U * D * U^T 복원
+ * - P##_quadratic_form: h * P * h^T (h는 희소 행)
+ * - P##_scalar_update: Bierman 스칼라 갱신, 칼만 게인과 혁신 분산 반환
+ * - P##_propagate_sparse: Thornton 전파 U'D'U'^T = (I + E) U D U^T (I + E)^T + diag(q)
+ *   (work: MATRIX_UD_PROPAGATE_WORK_SIZE(N)개 float 작업 메모리)
+ *
+ * @param T U-D 분해 타입
+ * @param P 함수 접두사
+ * @param TS 같은 차원의 압축 대칭 행렬 타입
+ * @param TV 같은 차원의 N x 1 벡터 타입
+ */
+#define MATRIX_UD_DECLARE_OPS(T, P, TS, TV)                                          \
+    bool P##_from_sym(const TS *p, T *ud);                                           \
+    void P##_to_sym(const T *ud, TS *p);                                             \
+    float P##_quadratic_form(const T *ud, const MatrixSparseRow *h);                 \
+    bool P##_scalar_update(T *ud, const MatrixSparseRow *h, float r, TV *k, float *s); \
+    void P##_propagate_sparse(T *ud, const MatrixSparseTransition *E, const float *q, float *work)
+
+/* U-D 분해 타입 */
+MATRIX_UD_DECLARE_TYPE(MatUD16, 16);
+MATRIX_UD_DECLARE_TYPE(MatUD18, 18);
+MATRIX_UD_DECLARE_TYPE(MatUD19, 19);
+MATRIX_UD_DECLARE_TYPE(MatUD17, 17);
+MATRIX_UD_DECLARE_TYPE(MatUD13, 13);
+MATRIX_UD_DECLARE_TYPE(MatUD10, 10);
+
+/* U-D 분해 연산 */
+MATRIX_UD_DECLARE_OPS(MatUD16, matud16, MatSym16, Mat16x1);
+MATRIX_UD_DECLARE_OPS(MatUD18, matud18, MatSym18, Mat18x1);
+MATRIX_UD_DECLARE_OPS(MatUD19, matud19, MatSym19, Mat19x1);
+MATRIX_UD_DECLARE_OPS(MatUD17, matud17, MatSym17, Mat17x1);
+MATRIX_UD_DECLARE_OPS(MatUD13, matud13, MatSym13, Mat13x1);
+MATRIX_UD_DECLARE_OPS(MatUD10, matud10, MatSym10, Mat10x1);
+
+#endif /* MATRIX_UD_H */
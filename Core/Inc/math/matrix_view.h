@@ -0,0 +1,199 @@
+/**
+ * @file matrix_view.h
+ * @brief 행렬 블록 보기 (복사 없는 부분 행렬) 및 블록 커널
+ *
+ * 분할 전파/갱신 커널이 공분산의 블록(위치-속도, 자세-자이로 바이어스, 속도-가속도 바이어스)을
+ * 16x16 행렬 복사 없이 그 자리에서 읽고 쓰도록, 저장 공간 위의 R x C 블록을
+ * (시작 주소, 행 간격, 행 간격 감소량)으로 나타낸다.
+ *
+ * - 밀집 행 우선 행렬(MatRxC.data)의 블록: 행 간격 = 열 수, 감소량 0
+ * - 압축 대칭 행렬(MatSymN.data, EKF.P)의 대각 밖 상삼각 블록: 행 i에서 i+1까지의 간격이
+ *   N - i - 1이므로 행 간격 = N - r0 - 1, 감소량 1
+ *
+ * 행 r의 시작은 data + r * stride - step * r (r - 1) / 2 이며, 커널은 행 포인터를 차례로
+ * 옮기므로 원소 접근에 곱셈이 없다. 대각을 걸치는 압축 대칭 블록은 한 행이 연속이 아니므로
+ * 만들 수 없다 (matrix_view_sym_block이 false).
+ *
+ * 커널의 출력 보기는 입력 보기와 겹치면 안 된다 (scale, add_scaled에서 같은 보기는 가능).
+ */
+
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/matrix_fixed.h"
+
+/**
+ * @brief 쓰기 가능한 블록 보기
+ */
+typedef struct {
+    float *data;               /**< (0, 0) 원소 */
+    uint16_t stride;           /**< 0행에서 1행까지 원소 간격 */
+    uint8_t step;              /**< 행마다 간격 감소량 (밀집 0, 압축 대칭 1) */
+    uint8_t rows;              /**< 행 수 */
+    uint8_t cols;              /**< 열 수 */
+} MatrixView;
+
+/**
+ * @brief 읽기 전용 블록 보기
+ */
+typedef struct {
+    const float *data;         /**< (0, 0) 원소 */
+    uint16_t stride;           /**< 0행에서 1행까지 원소 간격 */
+    uint8_t step;              /**< 행마다 간격 감소량 (밀집 0, 압축 대칭 1) */
+    uint8_t rows;              /**< 행 수 */
+    uint8_t cols;              /**< 열 수 */
+} MatrixConstView;
+
+/**
+ * @brief 밀집 저장 공간 보기
+ *
+ * @param data (0, 0) 원소
+ * @param rows 행 수
+ * @param cols 열 수
+ * @param stride 행 간격 (원소 수, cols 이상)
+ * @return MatrixView 보기
+ */
+static inline MatrixView matrix_view(float *data, uint8_t rows, uint8_t cols, uint16_t stride) {
+    MatrixView v = { data, stride, 0, rows, cols };
+    return v;
+}
+
+/**
+ * @brief 밀집 저장 공간 읽기 전용 보기
+ */
+static inline MatrixConstView matrix_const_view(const float *data, uint8_t rows, uint8_t cols, uint16_t stride) {
+    MatrixConstView v = { data, stride, 0, rows, cols };
+    return v;
+}
+
+/**
+ * @brief 쓰기 가능한 보기를 읽기 전용으로
+ */
+static inline MatrixConstView matrix_view_const(MatrixView v) {
+    MatrixConstView c = { v.data, v.stride, v.step, v.rows, v.cols };
+    return c;
+}
+
+/**
+ * @brief 고정 크기 행렬(MatRxC)의 블록 보기 (경계는 MATRIX_DEBUG_CHECKS 빌드에서만 검사)
+ *
+ * @param m 고정 크기 행렬 포인터
+ * @param r0 시작 행
+ * @param c0 시작 열
+ * @param rows 행 수
+ * @param cols 열 수
+ */
+#define MATRIX_VIEW_BLOCK(m, r0, c0, rows, cols)                                                        \
+    (MATRIX_ASSERT((r0) + (rows) <= MATRIX_ROWS(m) && (c0) + (cols) <= MATRIX_COLS(m)),                 \
+     matrix_view(&(m)->data[(r0)][(c0)], (uint8_t)(rows), (uint8_t)(cols), MATRIX_COLS(m)))
+
+#define MATRIX_CONST_VIEW_BLOCK(m, r0, c0, rows, cols)                                                  \
+    (MATRIX_ASSERT((r0) + (rows) <= MATRIX_ROWS(m) && (c0) + (cols) <= MATRIX_COLS(m)),                 \
+     matrix_const_view(&(m)->data[(r0)][(c0)], (uint8_t)(rows), (uint8_t)(cols), MATRIX_COLS(m)))
+
+/**
+ * @brief 압축 대칭 행렬의 대각 밖 상삼각 블록 보기
+ *
+ * @param packed 압축 저장 공간 (MatSymN.data)
+ * @param n 행렬 차원 N
+ * @param r0 시작 행
+ * @param c0 시작 열
+ * @param rows 행 수
+ * @param cols 열 수
+ * @param view 보기
+ * @return bool 성공 여부 (블록이 행렬 밖이거나 대각을 걸치면 false, r0 + rows <= c0 필요)
+ */
+bool matrix_view_sym_block(float *packed, uint8_t n, uint8_t r0, uint8_t c0, uint8_t rows, uint8_t cols,
+                           MatrixView *view);
+
+/**
+ * @brief 압축 대칭 행렬의 대각 밖 상삼각 블록 읽기 전용 보기
+ */
+bool matrix_const_view_sym_block(const float *packed, uint8_t n, uint8_t r0, uint8_t c0, uint8_t rows,
+                                 uint8_t cols, MatrixConstView *view);
+
+/**
+ * @brief 보기 안의 부분 블록 보기
+ *
+ * @param v 보기
+ * @param r0 시작 행
+ * @param c0 시작 열
+ * @param rows 행 수
+ * @param cols 열 수
+ * @param sub 부분 보기
+ * @return bool 성공 여부 (v 밖이면 false)
+ */
+bool matrix_view_sub(const MatrixView *v, uint8_t r0, uint8_t c0, uint8_t rows, uint8_t cols, MatrixView *sub);
+
+/**
+ * @brief 블록 0으로 채우기
+ *
+ * @param c 블록
+ * @return bool 성공 여부
+ */
+bool matrix_view_zero(const MatrixView *c);
+
+/**
+ * @brief 블록 복사 (c = a)
+ *
+ * @param c 대상 블록
+ * @param a 원본 블록
+ * @return bool 성공 여부 (크기가 다르면 false)
+ */
+bool matrix_view_copy(const MatrixView *c, const MatrixConstView *a);
+
+/**
+ * @brief 블록 스케일 (c = s c)
+ *
+ * @param c 블록
+ * @param s 배율
+ * @return bool 성공 여부
+ */
+bool matrix_view_scale(const MatrixView *c, float s);
+
+/**
+ * @brief 블록 스케일 누적 (c = c + alpha a)
+ *
+ * @param c 대상 블록
+ * @param a 더할 블록 (c와 같은 크기)
+ * @param alpha 배율
+ * @return bool 성공 여부 (크기가 다르면 false)
+ */
+bool matrix_view_add_scaled(const MatrixView *c, const MatrixConstView *a, float alpha);
+
+/**
+ * @brief 블록 전치 누적 (c = c + alpha a^T)
+ *
+ * @param c 대상 블록 (R x C)
+ * @param a 더할 블록 (C x R)
+ * @param alpha 배율
+ * @return bool 성공 여부 (크기가 맞지 않으면 false)
+ */
+bool matrix_view_transpose_add(const MatrixView *c, const MatrixConstView *a, float alpha);
+
+/**
+ * @brief 블록 곱셈 누적 (c = c + alpha a b)
+ *
+ * @param c 대상 블록 (R x C)
+ * @param a 왼쪽 블록 (R x K)
+ * @param b 오른쪽 블록 (K x C)
+ * @param alpha 배율
+ * @return bool 성공 여부 (크기가 맞지 않으면 false)
+ */
+bool matrix_view_multiply_add(const MatrixView *c, const MatrixConstView *a, const MatrixConstView *b, float alpha);
+
+/**
+ * @brief 블록 전치 곱셈 누적 (c = c + alpha a b^T, b의 전치를 만들지 않음)
+ *
+ * @param c 대상 블록 (R x C)
+ * @param a 왼쪽 블록 (R x K)
+ * @param b 오른쪽 블록 (C x K)
+ * @param alpha 배율
+ * @return bool 성공 여부 (크기가 맞지 않으면 false)
+ */
+bool matrix_view_multiply_transpose_add(const MatrixView *c, const MatrixConstView *a, const MatrixConstView *b,
+                                        float alpha);
+
+#endif /* MATRIX_VIEW_H */
@@ -0,0 +1,154 @@
+/**
+ * @file q31.h
+ * @brief 포화 고정 소수점(Q31 계열) 정수 연산
+ *
+ * 값 v를 Qn 형식으로 저장하면 raw = v x 2^n 이며, 이 헤더에서는 표현 범위를 지수 e
+ * (전체 범위 ±2^e, n = 31 - e)로 나타낸다. 곱셈은 64비트 중간값에서 반올림 후 자르고,
+ * 모든 결과는 32비트 범위로 포화시키므로 넘침이 부호 반전으로 나타나지 않는다.
+ *
+ * 적분처럼 한 단계 증분이 최하위 비트보다 작을 수 있는 누적에는 q31_accumulate로
+ * 버린 비트를 나머지로 이월한다 (장기 편향 없음).
+ */
+
+#ifndef Q31_H
+#define Q31_H
+
+#include <stdint.h>
+#include <math.h>
+#include "math/fp_mode.h"
+
+/**
+ * @brief 64비트 중간값을 32비트로 포화
+ *
+ * @param v 입력
+ * @return int32_t 포화된 값
+ */
+static inline int32_t q31_saturate(int64_t v) {
+    if (v > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (v < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)v;
+}
+
+/**
+ * @brief 반올림 산술 오른쪽 이동 (shift > 0)
+ *
+ * @param v 입력
+ * @param shift 이동 비트 수 (1 ~ 62)
+ * @return int64_t v / 2^shift (가장 가까운 정수)
+ */
+static inline int64_t q31_round_shift(int64_t v, uint8_t shift) {
+    return (v + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief 포화 덧셈
+ */
+static inline int32_t q31_add(int32_t a, int32_t b) {
+    return q31_saturate((int64_t)a + b);
+}
+
+/**
+ * @brief 포화 뺄셈
+ */
+static inline int32_t q31_sub(int32_t a, int32_t b) {
+    return q31_saturate((int64_t)a - b);
+}
+
+/**
+ * @brief 곱셈 후 반올림 이동 (a x b / 2^shift, 포화)
+ *
+ * 두 입력의 소수 비트 합에서 결과 소수 비트를 뺀 값이 shift이다.
+ * 예: Q31 x Q31 -> Q31은 shift 31, Q30 x Q30 -> Q30은 shift 30.
+ *
+ * @param a 입력
+ * @param b 입력
+ * @param shift 이동 비트 수 (1 ~ 62)
+ * @return int32_t 결과
+ */
+static inline int32_t q31_mul_shift(int32_t a, int32_t b, uint8_t shift) {
+    return q31_saturate(q31_round_shift((int64_t)a * b, shift));
+}
+
+/**
+ * @brief Q31 곱셈
+ */
+static inline int32_t q31_mul(int32_t a, int32_t b) {
+    return q31_mul_shift(a, b, 31);
+}
+
+/**
+ * @brief 나머지를 이월하는 누적 (*acc += inc / 2^shift)
+ *
+ * 버림으로 잃은 하위 비트를 residue에 두었다가 다음 호출에 더하므로, 한 번의 증분이
+ * 최하위 비트보다 작아도 누적 결과에 빠짐없이 반영된다.
+ *
+ * @param acc 누적값 (포화)
+ * @param inc 증분 (acc의 2^-shift 단위)
+ * @param shift 이동 비트 수 (0 ~ 62)
+ * @param residue 이월 나머지 (0 이상 2^shift 미만, 처음에는 0)
+ */
+static inline void q31_accumulate(int32_t *acc, int64_t inc, uint8_t shift, int64_t *residue) {
+    int64_t total = inc + *residue;
+    int64_t step = total >> shift;
+    *residue = total - (step << shift);
+    *acc = q31_saturate((int64_t)*acc + step);
+}
+
+/**
+ * @brief 64비트 정수 제곱근 (내림)
+ *
+ * @param v 입력 (v >= 0)
+ * @return uint32_t floor(sqrt(v))
+ */
+static inline uint32_t q31_isqrt64(uint64_t v) {
+    uint64_t result = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= result + bit) {
+            v -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * @brief 부동소수점 -> 고정 소수점 (초기화/호스트 변환용, 포화)
+ *
+ * @param v 값
+ * @param exp 범위 지수 (전체 범위 ±2^exp)
+ * @return int32_t raw 값
+ */
+static inline int32_t q31_from_float(float v, int exp) {
+    double raw = ldexp((double)v, 31 - exp);
+    if (!(raw < 2147483647.0)) {
+        return (raw > 0.0) ? INT32_MAX : 0;
+    }
+    if (raw < -2147483648.0) {
+        return INT32_MIN;
+    }
+    return (int32_t)lrint(raw);
+}
+
+/**
+ * @brief 고정 소수점 -> 부동소수점 (진단/호스트 비교용)
+ *
+ * @param raw raw 값
+ * @param exp 범위 지수
+ * @return float 값
+ */
+static inline float q31_to_float(int32_t raw, int exp) {
+    return (float)ldexp((double)raw, exp - 31);
+}
+
+#endif /* Q31_H */
@@ -1,6 +1,9 @@
 /**
  * @file quaternion.h
- * @brief 사원수(Quaternion) 연산을 위한 라이브러리
+ * @brief 사원수(Quaternion) 연산을 위한 라이브러리 (헤더 전용)
+ *
+ * math/vector3f.h와 같이 모든 함수가 static inline 이다. 예측 단계의 자세 적분처럼
+ * 작은 사원수 연산이 이어지는 경로에서 중간값이 레지스터에 남는다.
  */
 
 #ifndef QUATERNION_H
@@ -8,6 +11,8 @@
 
 #include <stdint.h>
 #include <math.h>
+#include "math/fast_math.h"
+#include "math/vector3f.h"
 
 /**
  * @brief 사원수 구조체
@@ -22,21 +27,19 @@ typedef struct {
     float z;  /**< 벡터 부분 z */
 } Quaternion;
 
-/**
- * @brief 3차원 벡터 구조체
- */
-typedef struct {
-    float x;  /**< x 성분 */
-    float y;  /**< y 성분 */
-    float z;  /**< z 성분 */
-} Vector3f;
-
 /**
  * @brief 단위 사원수 생성
  * 
  * @return Quaternion 단위 사원수 (1, 0, 0, 0)
  */
-Quaternion quaternion_identity(void);
+static inline Quaternion quaternion_identity(void) {
+    Quaternion q;
+    q.w = 1.0f;
+    q.x = 0.0f;
+    q.y = 0.0f;
+    q.z = 0.0f;
+    return q;
+}
 
 /**
  * @brief 사원수 초기화
@@ -47,7 +50,24 @@ Quaternion quaternion_identity(void);
  * @param z 벡터 부분 z
  * @return Quaternion 초기화된 사원수
  */
-Quaternion quaternion_create(float w, float x, float y, float z);
+static inline Quaternion quaternion_create(float w, float x, float y, float z) {
+    Quaternion q;
+    q.w = w;
+    q.x = x;
+    q.y = y;
+    q.z = z;
+    return q;
+}
+
+/**
+ * @brief 사원수 크기(Magnitude)
+ * 
+ * @param q 사원수
+ * @return float 사원수의 크기
+ */
+static inline float quaternion_magnitude(Quaternion q) {
+    return sqrtf(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+}
 
 /**
  * @brief 사원수 정규화
@@ -55,7 +75,93 @@ Quaternion quaternion_create(float w, float x, float y, float z);
  * @param q 정규화할 사원수
  * @return Quaternion 정규화된 사원수
  */
-Quaternion quaternion_normalize(Quaternion q);
+static inline Quaternion quaternion_normalize(Quaternion q) {
+    float magnitude = quaternion_magnitude(q);
+    
+    // 0으로 나누기 방지
+    if (magnitude < 1e-6f) {
+        return quaternion_identity();
+    }
+    
+    Quaternion result;
+    float inv_magnitude = 1.0f / magnitude;
+    result.w = q.w * inv_magnitude;
+    result.x = q.x * inv_magnitude;
+    result.y = q.y * inv_magnitude;
+    result.z = q.z * inv_magnitude;
+    
+    return result;
+}
+
+/**
+ * @brief 사원수 정규화 (고속, fast_math.h)
+ * 
+ * VSQRT/VDIV로 계산하며 결과는 quaternion_normalize와 1 ulp 이내로 같다.
+ * 
+ * @param q 정규화할 사원수
+ * @return Quaternion 정규화된 사원수 (크기가 1e-6 미만이면 단위 사원수)
+ */
+static inline Quaternion quaternion_normalize_fast(Quaternion q) {
+    float magnitude_sq = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    
+    // 0으로 나누기 방지 (|q| < 1e-6)
+    if (magnitude_sq < 1e-12f) {
+        return quaternion_identity();
+    }
+    
+    float inv_magnitude = fast_inv_sqrtf(magnitude_sq);
+    Quaternion result;
+    result.w = q.w * inv_magnitude;
+    result.x = q.x * inv_magnitude;
+    result.y = q.y * inv_magnitude;
+    result.z = q.z * inv_magnitude;
+    
+    return result;
+}
+
+/**
+ * @brief 1차 재정규화를 쓰는 노름 오차 한계 (|q|^2 - 1, 넘으면 전체 정규화)
+ */
+#define QUATERNION_RENORM_MAX_ERROR 5e-4f
+
+/**
+ * @brief 재정규화 후 남는 반올림 오차 (|q|^2 - 1, 몇 ulp)
+ */
+#define QUATERNION_RENORM_ROUND_ERROR 4.8e-7f
+
+/**
+ * @brief 단위 근처 사원수 재정규화 (sqrt 없음)
+ *
+ * e = |q|^2 - 1 이 QUATERNION_RENORM_MAX_ERROR 이하이면 1/|q| ~= (3 - |q|^2) / 2 를 곱하고
+ * (남는 오차 약 0.75 e^2), 넘으면 quaternion_normalize_fast로 정규화한다.
+ * 적분과 측정 갱신 뒤에는 e가 반올림 수준이므로 거의 항상 앞쪽이다.
+ *
+ * @param q 사원수
+ * @param norm_error 재정규화 후 |q|^2 - 1 의 추정 한계 (NULL 가능)
+ * @return Quaternion 재정규화된 사원수
+ */
+static inline Quaternion quaternion_renormalize(Quaternion q, float *norm_error) {
+    float magnitude_sq = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    float e = magnitude_sq - 1.0f;
+
+    if (!(fabsf(e) <= QUATERNION_RENORM_MAX_ERROR)) {
+        if (norm_error != NULL) {
+            *norm_error = QUATERNION_RENORM_ROUND_ERROR;
+        }
+        return quaternion_normalize_fast(q);
+    }
+
+    float k = 1.5f - 0.5f * magnitude_sq;
+    q.w *= k;
+    q.x *= k;
+    q.y *= k;
+    q.z *= k;
+    if (norm_error != NULL) {
+        *norm_error = 0.75f * e * e + QUATERNION_RENORM_ROUND_ERROR;
+    }
+
+    return q;
+}
 
 /**
  * @brief 사원수 곱셈
@@ -64,7 +170,16 @@ Quaternion quaternion_normalize(Quaternion q);
  * @param q2 두 번째 사원수
  * @return Quaternion 곱셈 결과
  */
-Quaternion quaternion_multiply(Quaternion q1, Quaternion q2);
+static inline Quaternion quaternion_multiply(Quaternion q1, Quaternion q2) {
+    Quaternion result;
+    
+    result.w = q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z;
+    result.x = q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y;
+    result.y = q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x;
+    result.z = q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w;
+    
+    return result;
+}
 
 /**
  * @brief 사원수 켤레(Conjugate)
@@ -72,7 +187,14 @@ Quaternion quaternion_multiply(Quaternion q1, Quaternion q2);
  * @param q 원본 사원수
  * @return Quaternion 켤레 사원수
  */
-Quaternion quaternion_conjugate(Quaternion q);
+static inline Quaternion quaternion_conjugate(Quaternion q) {
+    Quaternion result;
+    result.w = q.w;
+    result.x = -q.x;
+    result.y = -q.y;
+    result.z = -q.z;
+    return result;
+}
 
 /**
  * @brief 사원수 역원(Inverse)
@@ -80,24 +202,84 @@ Quaternion quaternion_conjugate(Quaternion q);
  * @param q 원본 사원수
  * @return Quaternion 역원 사원수
  */
-Quaternion quaternion_inverse(Quaternion q);
+static inline Quaternion quaternion_inverse(Quaternion q) {
+    Quaternion conjugate = quaternion_conjugate(q);
+    float magnitude_squared = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    
+    // 0으로 나누기 방지
+    if (magnitude_squared < 1e-6f) {
+        return quaternion_identity();
+    }
+    
+    float inv_magnitude_squared = 1.0f / magnitude_squared;
+    
+    Quaternion result;
+    result.w = conjugate.w * inv_magnitude_squared;
+    result.x = conjugate.x * inv_magnitude_squared;
+    result.y = conjugate.y * inv_magnitude_squared;
+    result.z = conjugate.z * inv_magnitude_squared;
+    
+    return result;
+}
 
 /**
- * @brief 사원수 크기(Magnitude)
+ * @brief 사원수로 벡터 회전
  * 
- * @param q 사원수
- * @return float 사원수의 크기
+ * @param q 회전을 나타내는 사원수
+ * @param v 회전할 벡터
+ * @return Vector3f 회전된 벡터
  */
-float quaternion_magnitude(Quaternion q);
+static inline Vector3f quaternion_rotate_vector(Quaternion q, Vector3f v) {
+    // v' = q * v * q^(-1)
+    // 여기서 v는 (0, v.x, v.y, v.z) 형태의 순수 사원수
+    
+    // 최적화된 구현 (사원수 곱셈 공식 직접 적용)
+    Vector3f result;
+    
+    float qw2 = q.w * q.w;
+    float qx2 = q.x * q.x;
+    float qy2 = q.y * q.y;
+    float qz2 = q.z * q.z;
+    
+    float qwx = q.w * q.x;
+    float qwy = q.w * q.y;
+    float qwz = q.w * q.z;
+    float qxy = q.x * q.y;
+    float qxz = q.x * q.z;
+    float qyz = q.y * q.z;
+    
+    // 회전 행렬 요소들
+    float m11 = qw2 + qx2 - qy2 - qz2;
+    float m12 = 2.0f * (qxy - qwz);
+    float m13 = 2.0f * (qxz + qwy);
+    
+    float m21 = 2.0f * (qxy + qwz);
+    float m22 = qw2 - qx2 + qy2 - qz2;
+    float m23 = 2.0f * (qyz - qwx);
+    
+    float m31 = 2.0f * (qxz - qwy);
+    float m32 = 2.0f * (qyz + qwx);
+    float m33 = qw2 - qx2 - qy2 + qz2;
+    
+    // 행렬-벡터 곱
+    result.x = m11 * v.x + m12 * v.y + m13 * v.z;
+    result.y = m21 * v.x + m22 * v.y + m23 * v.z;
+    result.z = m31 * v.x + m32 * v.y + m33 * v.z;
+    
+    return result;
+}
 
 /**
- * @brief 사원수로 벡터 회전
+ * @brief 사원수의 역회전으로 벡터 회전
  * 
- * @param q 회전을 나타내는 사원수
+ * @param q 회전을 나타내는 사원수 (단위 사원수)
  * @param v 회전할 벡터
- * @return Vector3f 회전된 벡터
+ * @return Vector3f 역회전된 벡터 (q^(-1) * v * q)
  */
-Vector3f quaternion_rotate_vector(Quaternion q, Vector3f v);
+static inline Vector3f quaternion_rotate_vector_inverse(Quaternion q, Vector3f v) {
+    // 단위 사원수의 역원은 켤레와 같음
+    return quaternion_rotate_vector(quaternion_conjugate(q), v);
+}
 
 /**
  * @brief 각속도 벡터로부터 사원수 미분 계산
@@ -106,104 +288,231 @@ Vector3f quaternion_rotate_vector(Quaternion q, Vector3f v);
  * @param omega 각속도 벡터 (rad/s)
  * @return Quaternion 사원수 미분값
  */
-Quaternion quaternion_derivative(Quaternion q, Vector3f omega);
+static inline Quaternion quaternion_derivative(Quaternion q, Vector3f omega) {
+    // q̇ = 0.5 * q ⊗ ω
+    // 여기서 ω는 (0, ω.x, ω.y, ω.z) 형태의 순수 사원수
+    
+    Quaternion omega_quat;
+    omega_quat.w = 0.0f;
+    omega_quat.x = omega.x;
+    omega_quat.y = omega.y;
+    omega_quat.z = omega.z;
+    
+    Quaternion q_dot = quaternion_multiply(q, omega_quat);
+    
+    // 0.5를 곱함
+    q_dot.w *= 0.5f;
+    q_dot.x *= 0.5f;
+    q_dot.y *= 0.5f;
+    q_dot.z *= 0.5f;
+    
+    return q_dot;
+}
 
 /**
- * @brief 오일러 각(roll, pitch, yaw)에서 사원수 생성
+ * @brief 단위 사원수를 회전 행렬(DCM)로 변환
  * 
- * @param roll x축 회전 (라디안)
- * @param pitch y축 회전 (라디안)
- * @param yaw z축 회전 (라디안)
- * @return Quaternion 변환된 사원수
- */
-Quaternion quaternion_from_euler(float roll, float pitch, float yaw);
-
-/**
- * @brief 사원수에서 오일러 각 추출
+ * R * v 는 quaternion_rotate_vector(q, v)와 같다 (몸체 -> 기준 좌표계).
  * 
- * @param q 사원수
- * @param roll x축 회전 (라디안)을 저장할 포인터
- * @param pitch y축 회전 (라디안)을 저장할 포인터
- * @param yaw z축 회전 (라디안)을 저장할 포인터
+ * @param q 단위 사원수
+ * @param R 결과 3x3 회전 행렬 (행 우선)
  */
-void quaternion_to_euler(Quaternion q, float *roll, float *pitch, float *yaw);
+static inline void quaternion_to_rotation_matrix(Quaternion q, float R[3][3]) {
+    float qxx = q.x * q.x;
+    float qyy = q.y * q.y;
+    float qzz = q.z * q.z;
+    float qwx = q.w * q.x;
+    float qwy = q.w * q.y;
+    float qwz = q.w * q.z;
+    float qxy = q.x * q.y;
+    float qxz = q.x * q.z;
+    float qyz = q.y * q.z;
+    
+    R[0][0] = 1.0f - 2.0f * (qyy + qzz);
+    R[0][1] = 2.0f * (qxy - qwz);
+    R[0][2] = 2.0f * (qxz + qwy);
+    
+    R[1][0] = 2.0f * (qxy + qwz);
+    R[1][1] = 1.0f - 2.0f * (qxx + qzz);
+    R[1][2] = 2.0f * (qyz - qwx);
+    
+    R[2][0] = 2.0f * (qxz - qwy);
+    R[2][1] = 2.0f * (qyz + qwx);
+    R[2][2] = 1.0f - 2.0f * (qxx + qyy);
+}
 
 /**
- * @brief 영벡터 생성
+ * @brief 몸체 좌표계 자세 오차에 대한 사원수 자코비안
  * 
- * @return Vector3f (0, 0, 0)
- */
-Vector3f vector3f_zero(void);
-
-/**
- * @brief 벡터 생성
+ * q_true = q ⊗ (1, δθ/2) 일 때 δq = Xi δθ / 2 이다. 단위 사원수에서 Xi^T Xi = I 이므로
+ * δθ = 2 Xi^T δq 로 사원수 오차(공분산)를 회전각 오차로 옮긴다.
  * 
- * @param x x 성분
- * @param y y 성분
- * @param z z 성분
- * @return Vector3f 생성된 벡터
+ * @param q 단위 사원수
+ * @param Xi 결과 4x3 행렬 (행: w, x, y, z)
  */
-Vector3f vector3f_create(float x, float y, float z);
+static inline void quaternion_error_jacobian(Quaternion q, float Xi[4][3]) {
+    Xi[0][0] = -q.x; Xi[0][1] = -q.y; Xi[0][2] = -q.z;
+    Xi[1][0] = q.w;  Xi[1][1] = -q.z; Xi[1][2] = q.y;
+    Xi[2][0] = q.z;  Xi[2][1] = q.w;  Xi[2][2] = -q.x;
+    Xi[3][0] = -q.y; Xi[3][1] = q.x;  Xi[3][2] = q.w;
+}
 
 /**
- * @brief 벡터 덧셈
+ * @brief 회전 벡터(축 * 각도)에서 사원수 생성 (지수 사상)
  * 
- * @param v1 첫 번째 벡터
- * @param v2 두 번째 벡터
- * @return Vector3f 덧셈 결과
- */
-Vector3f vector3f_add(Vector3f v1, Vector3f v2);
-
-/**
- * @brief 벡터 뺄셈
+ * |θ| < 0.2 rad 에서는 4차 테일러 전개로 sqrt/sin/cos 없이 계산한다
+ * (단정밀도 반올림 오차 이하). 그 이상은 fast_sincosf(오차 1.5e-7)를 사용한다.
  * 
- * @param v1 첫 번째 벡터
- * @param v2 두 번째 벡터
- * @return Vector3f 뺄셈 결과
+ * @param theta 회전 벡터 (rad)
+ * @return Quaternion 단위 사원수 [cos(|θ|/2), sin(|θ|/2) * θ/|θ|]
  */
-Vector3f vector3f_subtract(Vector3f v1, Vector3f v2);
+static inline Quaternion quaternion_from_rotation_vector(Vector3f theta) {
+    float angle_sq = theta.x * theta.x + theta.y * theta.y + theta.z * theta.z;
+    float w, s;
+    
+    if (angle_sq < 0.04f) {
+        // 작은 각도: 4차 테일러 전개
+        // cos(a/2) ~= 1 - a^2/8 + a^4/384, sin(a/2)/a ~= 1/2 - a^2/48 + a^4/3840
+        w = 1.0f - angle_sq * (1.0f / 8.0f - angle_sq * (1.0f / 384.0f));
+        s = 0.5f - angle_sq * (1.0f / 48.0f - angle_sq * (1.0f / 3840.0f));
+    } else {
+        float angle = fast_sqrtf(angle_sq);
+        fast_sincosf(0.5f * angle, &s, &w);
+        s /= angle;
+    }
+    
+    return quaternion_create(w, s * theta.x, s * theta.y, s * theta.z);
+}
 
 /**
- * @brief 벡터 스칼라 곱
- * 
- * @param v 벡터
- * @param scalar 스칼라 값
- * @return Vector3f 스칼라 곱 결과
+ * @brief 단위 사원수에서 회전 벡터 추출 (로그 사상, quaternion_from_rotation_vector의 역)
+ *
+ * w < 0이면 -q로 바꿔 |θ| <= π 인 최단 회전을 돌려준다.
+ * 벡터부가 작을 때(|v| < 0.1)는 atan(z)/z 의 테일러 전개로 atan2f 없이 계산한다.
+ *
+ * @param q 단위 사원수
+ * @return Vector3f 회전 벡터 (rad, |θ| <= π)
  */
-Vector3f vector3f_scale(Vector3f v, float scalar);
+static inline Vector3f quaternion_to_rotation_vector(Quaternion q) {
+    if (q.w < 0.0f) {
+        q = quaternion_create(-q.w, -q.x, -q.y, -q.z);
+    }
+
+    float v_sq = q.x * q.x + q.y * q.y + q.z * q.z;
+    float k;
+
+    if (v_sq < 0.01f) {
+        // 2 atan(z)/s = (2/w) atan(z)/z ~= (2/w)(1 - z^2/3 + z^4/5 - z^6/7), z = s/w
+        float inv_w = 1.0f / q.w;
+        float z_sq = v_sq * inv_w * inv_w;
+        k = 2.0f * inv_w * (1.0f - z_sq * (1.0f / 3.0f - z_sq * (1.0f / 5.0f - z_sq * (1.0f / 7.0f))));
+    } else {
+        float s = sqrtf(v_sq);
+        k = 2.0f * fp_atan2f(s, q.w) / s;
+    }
+
+    return vector3f_create(k * q.x, k * q.y, k * q.z);
+}
 
 /**
- * @brief 벡터 내적
- * 
- * @param v1 첫 번째 벡터
- * @param v2 두 번째 벡터
- * @return float 내적 결과
+ * @brief 구면 선형 보간 q0 ⊗ exp(u log(q0* ⊗ q1))
+ *
+ * 상대 회전을 회전 벡터로 바꿔 비율만큼 적용하므로 최단 경로를 따르고 u > 1이면 같은 각속도로
+ * 외삽한다. 작은 상대 회전에서도 테일러 전개를 쓰므로 0으로 나누지 않는다.
+ *
+ * @param q0 시작 단위 사원수 (u = 0)
+ * @param q1 끝 단위 사원수 (u = 1)
+ * @param u 보간 비율
+ * @return Quaternion 보간된 단위 사원수
  */
-float vector3f_dot(Vector3f v1, Vector3f v2);
+static inline Quaternion quaternion_slerp(Quaternion q0, Quaternion q1, float u) {
+    Vector3f theta = quaternion_to_rotation_vector(quaternion_multiply(quaternion_conjugate(q0), q1));
+    Quaternion dq = quaternion_from_rotation_vector(vector3f_scale(theta, u));
+
+    return quaternion_normalize(quaternion_multiply(q0, dq));
+}
 
 /**
- * @brief 벡터 외적
+ * @brief 오일러 각(roll, pitch, yaw)에서 사원수 생성
  * 
- * @param v1 첫 번째 벡터
- * @param v2 두 번째 벡터
- * @return Vector3f 외적 결과
+ * @param roll x축 회전 (라디안)
+ * @param pitch y축 회전 (라디안)
+ * @param yaw z축 회전 (라디안)
+ * @return Quaternion 변환된 사원수
  */
-Vector3f vector3f_cross(Vector3f v1, Vector3f v2);
+static inline Quaternion quaternion_from_euler(float roll, float pitch, float yaw) {
+    // 각 축에 대한 회전을 나타내는 사원수 계산
+    float cr = fp_cosf(roll * 0.5f);
+    float sr = fp_sinf(roll * 0.5f);
+    float cp = fp_cosf(pitch * 0.5f);
+    float sp = fp_sinf(pitch * 0.5f);
+    float cy = fp_cosf(yaw * 0.5f);
+    float sy = fp_sinf(yaw * 0.5f);
+    
+    // ZYX 순서로 회전 (항공우주 컨벤션)
+    Quaternion q;
+    q.w = cr * cp * cy + sr * sp * sy;
+    q.x = sr * cp * cy - cr * sp * sy;
+    q.y = cr * sp * cy + sr * cp * sy;
+    q.z = cr * cp * sy - sr * sp * cy;
+    
+    return quaternion_normalize(q);
+}
 
 /**
- * @brief 벡터 정규화
+ * @brief 사원수에서 오일러 각 추출
  * 
- * @param v 정규화할 벡터
- * @return Vector3f 정규화된 벡터
+ * @param q 사원수
+ * @param roll x축 회전 (라디안)을 저장할 포인터
+ * @param pitch y축 회전 (라디안)을 저장할 포인터
+ * @param yaw z축 회전 (라디안)을 저장할 포인터
  */
-Vector3f vector3f_normalize(Vector3f v);
+static inline void quaternion_to_euler(Quaternion q, float *roll, float *pitch, float *yaw) {
+    // 사원수를 정규화
+    Quaternion qn = quaternion_normalize(q);
+    
+    // Roll (x-axis rotation)
+    *roll = fp_atan2f(2.0f * (qn.w * qn.x + qn.y * qn.z), 
+                  1.0f - 2.0f * (qn.x * qn.x + qn.y * qn.y));
+    
+    // Pitch (y-axis rotation)
+    float sinp = 2.0f * (qn.w * qn.y - qn.z * qn.x);
+    if (fabsf(sinp) >= 1.0f) {
+        // 특이점 처리 (90도)
+        *pitch = copysignf(FAST_MATH_PI_2, sinp);
+    } else {
+        *pitch = fp_asinf(sinp);
+    }
+    
+    // Yaw (z-axis rotation)
+    *yaw = fp_atan2f(2.0f * (qn.w * qn.z + qn.x * qn.y), 
+                 1.0f - 2.0f * (qn.y * qn.y + qn.z * qn.z));
+}
 
 /**
- * @brief 벡터 크기
+ * @brief 사원수에서 오일러 각 추출 (고속 다항식 근사, fast_math.h)
  * 
- * @param v 벡터
- * @return float 벡터의 크기
+ * 텔레메트리/표시처럼 제어 주기로 호출되는 지점용이다.
+ * 각 각도의 오차는 2.5e-6 rad 이내이다.
+ * 
+ * @param q 사원수
+ * @param roll x축 회전 (라디안)을 저장할 포인터
+ * @param pitch y축 회전 (라디안)을 저장할 포인터
+ * @param yaw z축 회전 (라디안)을 저장할 포인터
  */
-float vector3f_magnitude(Vector3f v);
+static inline void quaternion_to_euler_fast(Quaternion q, float *roll, float *pitch, float *yaw) {
+    Quaternion qn = quaternion_normalize_fast(q);
+    
+    // Roll (x-axis rotation)
+    *roll = fast_atan2f(2.0f * (qn.w * qn.x + qn.y * qn.z),
+                        1.0f - 2.0f * (qn.x * qn.x + qn.y * qn.y));
+    
+    // Pitch (y-axis rotation), |sinp| >= 1 이면 ±90도로 제한
+    *pitch = fast_asinf(2.0f * (qn.w * qn.y - qn.z * qn.x));
+    
+    // Yaw (z-axis rotation)
+    *yaw = fast_atan2f(2.0f * (qn.w * qn.z + qn.x * qn.y),
+                       1.0f - 2.0f * (qn.y * qn.y + qn.z * qn.z));
+}
 
 #endif /* QUATERNION_H */
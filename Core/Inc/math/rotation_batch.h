@@ -0,0 +1,106 @@
+/**
+ * @file rotation_batch.h
+ * @brief 센서 묶음(burst)의 몸체 -> NED 일괄 회전
+ *
+ * 로거, 수직 필터, 검출기처럼 IMU 묶음 전체를 NED로 돌리는 경로에서 샘플마다
+ * quaternion_rotate_vector를 부르면 사원수에서 회전 행렬을 매번 다시 만든다 (약 30 FLOP).
+ * 여기서는 DCM을 묶음마다 한 번 만들고 벡터당 곱셈-누산 9번으로 돌린다. 입력과 출력은
+ * 성분별 배열(SoA)이라 세 성분 루프가 각각 연속 접근이고, 컴파일러가 행렬 원소 9개를
+ * 레지스터에 두고 펼칠 수 있다.
+ *
+ * 묶음 동안 자세가 바뀌면 양 끝 사원수 q0, q1의 DCM을 원소별로 선형 보간한다 (샘플마다
+ * 덧셈 9번 추가). 선형 보간한 DCM은 직교에서 벗어나며 원소 오차는 구간 회전각 θ에 대해
+ * 약 θ^2 / 8 이므로, θ가 ROTATION_BATCH_INTERP_MAX_ANGLE을 넘으면 nlerp로 나눈 구간마다
+ * 보간한다.
+ */
+
+#ifndef ROTATION_BATCH_H
+#define ROTATION_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/quaternion.h"
+
+/**
+ * @brief 선형 DCM 보간 한 구간의 최대 회전각 (rad, 원소 오차 약 3e-4)
+ */
+#define ROTATION_BATCH_INTERP_MAX_ANGLE 0.05f
+
+/**
+ * @brief 성분별 배열 벡터 묶음 (쓰기 가능)
+ */
+typedef struct {
+    float *x;                  /**< x 성분 배열 */
+    float *y;                  /**< y 성분 배열 */
+    float *z;                  /**< z 성분 배열 */
+} Vector3fSoA;
+
+/**
+ * @brief 성분별 배열 벡터 묶음 (읽기 전용)
+ */
+typedef struct {
+    const float *x;            /**< x 성분 배열 */
+    const float *y;            /**< y 성분 배열 */
+    const float *z;            /**< z 성분 배열 */
+} Vector3fSoAConst;
+
+/**
+ * @brief 고정 DCM으로 묶음 회전 (out = R in)
+ *
+ * out은 in과 같은 배열이어도 된다.
+ *
+ * @param R 회전 행렬 (quaternion_to_rotation_matrix, 행 우선)
+ * @param in 입력 벡터
+ * @param out 출력 벡터
+ * @param n 벡터 수
+ * @return bool 성공 여부
+ */
+bool rotation_batch_apply(const float R[3][3], const Vector3fSoAConst *in, const Vector3fSoA *out, uint16_t n);
+
+/**
+ * @brief 사원수 하나로 묶음 회전 (DCM을 한 번 만들어 rotation_batch_apply)
+ *
+ * @param q 몸체 -> NED 단위 사원수
+ * @param in 입력 벡터
+ * @param out 출력 벡터 (in과 같아도 됨)
+ * @param n 벡터 수
+ * @return bool 성공 여부
+ */
+bool rotation_batch_rotate(Quaternion q, const Vector3fSoAConst *in, const Vector3fSoA *out, uint16_t n);
+
+/**
+ * @brief 묶음 양 끝 자세 사이를 보간하며 회전 (샘플 k는 t = k / (n - 1))
+ *
+ * @param q0 첫 샘플의 몸체 -> NED 단위 사원수
+ * @param q1 마지막 샘플의 몸체 -> NED 단위 사원수
+ * @param in 입력 벡터
+ * @param out 출력 벡터 (in과 같아도 됨)
+ * @param n 벡터 수 (1이면 q0만 사용)
+ * @return bool 성공 여부
+ */
+bool rotation_batch_rotate_interp(Quaternion q0, Quaternion q1, const Vector3fSoAConst *in, const Vector3fSoA *out,
+                                  uint16_t n);
+
+/**
+ * @brief 고정 DCM으로 묶음의 아래(D) 성분만 계산 (벡터당 곱셈-누산 3번, 수직 필터/검출기용)
+ *
+ * @param R 회전 행렬
+ * @param in 입력 벡터
+ * @param down 출력 D 성분 배열 (in의 성분 배열과 달라야 함)
+ * @param n 벡터 수
+ * @return bool 성공 여부
+ */
+bool rotation_batch_down(const float R[3][3], const Vector3fSoAConst *in, float *down, uint16_t n);
+
+/**
+ * @brief 고정 DCM으로 Vector3f 배열 회전 (구조체 배열 입력용, out은 in과 같아도 됨)
+ *
+ * @param R 회전 행렬
+ * @param in 입력 벡터 배열
+ * @param out 출력 벡터 배열
+ * @param n 벡터 수
+ * @return bool 성공 여부
+ */
+bool rotation_batch_apply_aos(const float R[3][3], const Vector3f *in, Vector3f *out, uint16_t n);
+
+#endif /* ROTATION_BATCH_H */
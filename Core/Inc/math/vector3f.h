@@ -1,12 +1,18 @@
 /**
  * @file vector3f.h
- * @brief 3차원 벡터 연산을 위한 라이브러리
+ * @brief 3차원 벡터 연산을 위한 라이브러리 (헤더 전용)
+ *
+ * 모든 함수가 static inline 이므로 호출 지점에서 풀려 Vector3f가 FPU 레지스터
+ * (S0..S31)에 머물고, 구조체 값 반환에 따른 호출/복귀와 스택 복사가 생기지 않는다.
+ * Vector3f는 이 헤더에만 정의되며 math/quaternion.h도 이 헤더를 포함한다.
  */
 
 #ifndef VECTOR3F_H
 #define VECTOR3F_H
 
 #include <stdbool.h>
+#include <math.h>
+#include "math/fast_math.h"
 
 /**
  * @brief 3차원 벡터 구조체
@@ -22,7 +28,13 @@ typedef struct {
  * 
  * @return Vector3f 영벡터 (0, 0, 0)
  */
-Vector3f vector3f_zero(void);
+static inline Vector3f vector3f_zero(void) {
+    Vector3f v;
+    v.x = 0.0f;
+    v.y = 0.0f;
+    v.z = 0.0f;
+    return v;
+}
 
 /**
  * @brief 벡터 생성
@@ -32,7 +44,13 @@ Vector3f vector3f_zero(void);
  * @param z z 성분
  * @return Vector3f 생성된 벡터
  */
-Vector3f vector3f_create(float x, float y, float z);
+static inline Vector3f vector3f_create(float x, float y, float z) {
+    Vector3f v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
 
 /**
  * @brief 벡터 덧셈
@@ -41,7 +59,13 @@ Vector3f vector3f_create(float x, float y, float z);
  * @param v2 두 번째 벡터
  * @return Vector3f 덧셈 결과 벡터
  */
-Vector3f vector3f_add(Vector3f v1, Vector3f v2);
+static inline Vector3f vector3f_add(Vector3f v1, Vector3f v2) {
+    Vector3f result;
+    result.x = v1.x + v2.x;
+    result.y = v1.y + v2.y;
+    result.z = v1.z + v2.z;
+    return result;
+}
 
 /**
  * @brief 벡터 뺄셈
@@ -50,7 +74,13 @@ Vector3f vector3f_add(Vector3f v1, Vector3f v2);
  * @param v2 두 번째 벡터
  * @return Vector3f 뺄셈 결과 벡터 (v1 - v2)
  */
-Vector3f vector3f_subtract(Vector3f v1, Vector3f v2);
+static inline Vector3f vector3f_subtract(Vector3f v1, Vector3f v2) {
+    Vector3f result;
+    result.x = v1.x - v2.x;
+    result.y = v1.y - v2.y;
+    result.z = v1.z - v2.z;
+    return result;
+}
 
 /**
  * @brief 벡터 스칼라 곱
@@ -59,7 +89,13 @@ Vector3f vector3f_subtract(Vector3f v1, Vector3f v2);
  * @param scalar 스칼라 값
  * @return Vector3f 스칼라 곱 결과 벡터
  */
-Vector3f vector3f_scale(Vector3f v, float scalar);
+static inline Vector3f vector3f_scale(Vector3f v, float scalar) {
+    Vector3f result;
+    result.x = v.x * scalar;
+    result.y = v.y * scalar;
+    result.z = v.z * scalar;
+    return result;
+}
 
 /**
  * @brief 벡터 내적
@@ -68,7 +104,9 @@ Vector3f vector3f_scale(Vector3f v, float scalar);
  * @param v2 두 번째 벡터
  * @return float 내적 결과 값
  */
-float vector3f_dot(Vector3f v1, Vector3f v2);
+static inline float vector3f_dot(Vector3f v1, Vector3f v2) {
+    return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+}
 
 /**
  * @brief 벡터 외적
@@ -77,7 +115,13 @@ float vector3f_dot(Vector3f v1, Vector3f v2);
  * @param v2 두 번째 벡터
  * @return Vector3f 외적 결과 벡터
  */
-Vector3f vector3f_cross(Vector3f v1, Vector3f v2);
+static inline Vector3f vector3f_cross(Vector3f v1, Vector3f v2) {
+    Vector3f result;
+    result.x = v1.y * v2.z - v1.z * v2.y;
+    result.y = v1.z * v2.x - v1.x * v2.z;
+    result.z = v1.x * v2.y - v1.y * v2.x;
+    return result;
+}
 
 /**
  * @brief 벡터 크기
@@ -85,15 +129,52 @@ Vector3f vector3f_cross(Vector3f v1, Vector3f v2);
  * @param v 벡터
  * @return float 벡터의 크기
  */
-float vector3f_magnitude(Vector3f v);
+static inline float vector3f_magnitude(Vector3f v) {
+    return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+}
 
 /**
  * @brief 벡터 정규화
  * 
  * @param v 벡터
- * @return Vector3f 정규화된 벡터
+ * @return Vector3f 정규화된 벡터 (크기가 1e-6 미만이면 영벡터)
  */
-Vector3f vector3f_normalize(Vector3f v);
+static inline Vector3f vector3f_normalize(Vector3f v) {
+    float magnitude = vector3f_magnitude(v);
+    
+    // 0으로 나누기 방지
+    if (magnitude < 1e-6f) {
+        return vector3f_zero();
+    }
+    
+    Vector3f result;
+    float inv_magnitude = 1.0f / magnitude;
+    result.x = v.x * inv_magnitude;
+    result.y = v.y * inv_magnitude;
+    result.z = v.z * inv_magnitude;
+    
+    return result;
+}
+
+/**
+ * @brief 벡터 정규화 (고속, fast_math.h)
+ * 
+ * @param v 벡터
+ * @return Vector3f 정규화된 벡터 (크기가 1e-6 이하이면 그대로)
+ */
+static inline Vector3f vector3f_normalize_fast(Vector3f v) {
+    float mag_sq = v.x * v.x + v.y * v.y + v.z * v.z;
+    Vector3f result = v;
+    
+    if (mag_sq > 1e-12f) {
+        float inv_mag = fast_inv_sqrtf(mag_sq);
+        result.x *= inv_mag;
+        result.y *= inv_mag;
+        result.z *= inv_mag;
+    }
+    
+    return result;
+}
 
 /**
  * @brief 두 벡터 사이의 각도
@@ -102,7 +183,26 @@ Vector3f vector3f_normalize(Vector3f v);
  * @param v2 두 번째 벡터
  * @return float 두 벡터 사이의 각도 (라디안)
  */
-float vector3f_angle(Vector3f v1, Vector3f v2);
+static inline float vector3f_angle(Vector3f v1, Vector3f v2) {
+    float mag1 = vector3f_magnitude(v1);
+    float mag2 = vector3f_magnitude(v2);
+    
+    if (mag1 < 1e-6f || mag2 < 1e-6f) {
+        return 0.0f;
+    }
+    
+    float dot = vector3f_dot(v1, v2);
+    float cos_angle = dot / (mag1 * mag2);
+    
+    // 수치 오차 처리
+    if (cos_angle > 1.0f) {
+        cos_angle = 1.0f;
+    } else if (cos_angle < -1.0f) {
+        cos_angle = -1.0f;
+    }
+    
+    return fp_acosf(cos_angle);
+}
 
 /**
  * @brief 벡터의 제곱 크기
@@ -110,7 +210,9 @@ float vector3f_angle(Vector3f v1, Vector3f v2);
  * @param v 벡터
  * @return float 벡터의 제곱 크기
  */
-float vector3f_magnitude_squared(Vector3f v);
+static inline float vector3f_magnitude_squared(Vector3f v) {
+    return v.x * v.x + v.y * v.y + v.z * v.z;
+}
 
 /**
  * @brief 두 벡터가 같은지 확인
@@ -120,6 +222,20 @@ float vector3f_magnitude_squared(Vector3f v);
  * @param epsilon 허용 오차
  * @return bool 두 벡터가 같으면 true, 다르면 false
  */
-bool vector3f_equals(Vector3f v1, Vector3f v2, float epsilon);
+static inline bool vector3f_equals(Vector3f v1, Vector3f v2, float epsilon) {
+    if (fabsf(v1.x - v2.x) > epsilon) {
+        return false;
+    }
+    
+    if (fabsf(v1.y - v2.y) > epsilon) {
+        return false;
+    }
+    
+    if (fabsf(v1.z - v2.z) > epsilon) {
+        return false;
+    }
+    
+    return true;
+}
 
 #endif /* VECTOR3F_H */
@@ -0,0 +1,184 @@
+/**
+ * @file attitude_fast.h
+ * @brief 제어 주기 자세 출력용 상보 필터 (Mahony 방식, EKF 자세를 기준으로 보정)
+ *
+ * IMU 샘플마다(예: 2 kHz) 바이어스를 뺀 자이로를 quaternion_derivative로 적분하고,
+ * 낮은 주기로 들어오는 EKF 항법 해(자세, 자이로 바이어스)를 기준 측정으로 써서
+ * 비례/적분 되먹임으로 자세 오차를 줄인다. 고전적인 Mahony 필터의 가속도 기준은
+ * 비행 중 중력 방향이 아니므로 EKF 자세로 바꾸었으며, 따라서 저주파 특성(드리프트)은
+ * EKF와 같고 고주파 특성은 자이로 적분과 같다.
+ *
+ * - EKF 해는 과거 시각(timestamp_us)의 상태이므로, 최근 자세 이력에서 같은 시각의
+ *   자세와 비교해 오차를 구한다 (융합 지연이 자세 오차로 보이지 않음).
+ * - 오차는 기준 좌표계 회전 벡터로 보관하고, 샘플마다 kp x dt 비율만큼 몸체 각속도
+ *   보정으로 적용한 뒤 그만큼 줄인다. 다음 해가 오기 전에 과보정하지 않는다.
+ * - 오차가 snap_angle을 넘거나 첫 해이면 지연 이후의 자이로 적분을 유지한 채 곧바로
+ *   EKF 자세로 맞춘다.
+ * - 자이로 바이어스는 해마다 EKF 값으로 바꾸고, ki가 0이 아니면 오차 적분으로
+ *   해 사이의 잔여 바이어스를 추가로 보정한다.
+ *
+ * attitude_fast_step과 attitude_fast_sync는 같은 문맥(제어 루프)에서 호출한다.
+ * 융합 태스크가 다른 문맥이면 NavPublisher를 통해 해를 받는다 (attitude_fast_sync).
+ */
+
+#ifndef ATTITUDE_FAST_H
+#define ATTITUDE_FAST_H
+
+#include "ekf/ekf.h"
+#include "nav/nav_publisher.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 자세 이력 길이 (샘플, 2 kHz에서 32 ms)
+ */
+#define ATTITUDE_FAST_HISTORY 64
+
+/**
+ * @brief 적분을 건너뛰는 최대 샘플 간격 (us, 넘으면 시각만 다시 잡음)
+ */
+#define ATTITUDE_FAST_MAX_DT_US 20000u
+
+/**
+ * @brief 기본 설정
+ */
+#define ATTITUDE_FAST_DEFAULT_KP 5.0f         /**< 비례 이득 (1/s) */
+#define ATTITUDE_FAST_DEFAULT_KI 0.0f         /**< 적분 이득 (1/s^2, EKF 바이어스 사용) */
+#define ATTITUDE_FAST_DEFAULT_SNAP_ANGLE 0.1f /**< 즉시 맞춤 오차 (rad) */
+
+/**
+ * @brief 필터 설정
+ */
+typedef struct {
+    float kp;                  /**< 비례 이득 (1/s, 오차 감쇠 시정수의 역수) */
+    float ki;                  /**< 적분 이득 (1/s^2, 0이면 사용 안 함) */
+    float snap_angle;          /**< 이 오차를 넘으면 즉시 맞춤 (rad) */
+} AttitudeFastConfig;
+
+/**
+ * @brief 자세 이력 항목
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 샘플 시각 (us) */
+    Quaternion q;              /**< 그 시각의 자세 */
+    Vector3f applied;          /**< 그 시각까지 적용한 누적 보정 (기준 좌표계, rad) */
+} AttitudeFastSample;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t steps;            /**< 적분한 샘플 수 */
+    uint32_t gaps;             /**< 간격 초과로 건너뛴 샘플 수 */
+    uint32_t injections;       /**< 반영한 EKF 해 수 */
+    uint32_t snaps;            /**< 즉시 맞춤 횟수 (첫 해 포함) */
+    uint32_t stale;            /**< 이력보다 오래된 해 수 (가장 오래된 이력과 비교) */
+    float last_error;          /**< 마지막 해의 자세 오차 (rad) */
+} AttitudeFastStats;
+
+/**
+ * @brief 상보 필터
+ */
+typedef struct {
+    AttitudeFastConfig config;
+    Quaternion q;              /**< 현재 자세 */
+    Vector3f gyro_bias;        /**< EKF 자이로 바이어스 (rad/s) */
+    Vector3f bias_integral;    /**< 적분 보정 바이어스 (rad/s) */
+    Vector3f rate;             /**< 마지막 보정 각속도 (몸체, rad/s, 자세 보정 제외) */
+    Vector3f error;            /**< 남은 자세 오차 (기준 좌표계 회전 벡터, rad) */
+    Vector3f applied;          /**< 적용한 누적 보정 (기준 좌표계, rad, 해 시각 이후 보정 차감용) */
+    uint32_t last_us;          /**< 마지막 샘플 시각 */
+    bool started;              /**< 첫 샘플 수신 */
+    bool ready;                /**< 첫 EKF 해 반영 */
+    uint32_t last_seq;         /**< 마지막으로 반영한 게시 시퀀스 */
+
+    AttitudeFastSample history[ATTITUDE_FAST_HISTORY]; /**< 최근 자세 (환형) */
+    uint16_t head;             /**< 다음 기록 위치 */
+    uint16_t count;            /**< 기록된 항목 수 */
+
+    AttitudeFastStats stats;
+} AttitudeFast;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool attitude_fast_default_config(AttitudeFastConfig *config);
+
+/**
+ * @brief 필터 초기화 (단위 자세, 바이어스 0, 첫 EKF 해 전까지 준비 안 됨)
+ *
+ * @param af 필터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool attitude_fast_init(AttitudeFast *af, const AttitudeFastConfig *config);
+
+/**
+ * @brief 되먹임 이득 설정 (비행 단계별 조정용)
+ *
+ * @param af 필터
+ * @param kp 비례 이득 (1/s, 0 이상)
+ * @param ki 적분 이득 (1/s^2, 0 이상, 0이면 적분 보정 초기화)
+ * @return bool 성공 여부
+ */
+bool attitude_fast_set_gains(AttitudeFast *af, float kp, float ki);
+
+/**
+ * @brief IMU 샘플 하나 적분 (제어 주기)
+ *
+ * @param af 필터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param gyro 자이로 측정 (몸체, rad/s)
+ * @return bool 적분했으면 true (첫 샘플이거나 간격 초과 시 false)
+ */
+bool attitude_fast_step(AttitudeFast *af, uint32_t timestamp_us, Vector3f gyro);
+
+/**
+ * @brief EKF 항법 해 반영 (자세 오차 계산, 바이어스 교체)
+ *
+ * @param af 필터
+ * @param sol EKF 항법 해 (timestamp_us 시각의 자세/바이어스)
+ * @return bool 성공 여부 (IMU 샘플 수신 전이면 false)
+ */
+bool attitude_fast_inject(AttitudeFast *af, const EKF_NavSolution *sol);
+
+/**
+ * @brief 게시 버퍼에 새 해가 있으면 반영
+ *
+ * 시퀀스가 바뀌지 않았으면 복사하지 않으므로 샘플마다 호출해도 된다.
+ *
+ * @param af 필터
+ * @param pub 항법 해 게시 버퍼
+ * @return bool 새 해를 반영했으면 true
+ */
+bool attitude_fast_sync(AttitudeFast *af, const NavPublisher *pub);
+
+/**
+ * @brief 현재 자세
+ *
+ * @param af 필터
+ * @param q 결과 자세
+ * @return bool 유효 여부 (첫 EKF 해 반영 전이면 false)
+ */
+bool attitude_fast_get_attitude(const AttitudeFast *af, Quaternion *q);
+
+/**
+ * @brief 마지막 샘플의 바이어스 보정 각속도 (제어 루프 각속도 되먹임용)
+ *
+ * @param af 필터
+ * @return Vector3f 각속도 (몸체, rad/s)
+ */
+Vector3f attitude_fast_get_rate(const AttitudeFast *af);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param af 필터
+ * @return const AttitudeFastStats* 통계
+ */
+const AttitudeFastStats *attitude_fast_get_stats(const AttitudeFast *af);
+
+#endif /* ATTITUDE_FAST_H */
@@ -0,0 +1,202 @@
+/**
+ * @file can_publisher.h
+ * @brief 항법 해 CAN 게시 (하드웨어 타이머 틱, 메시지별 주기, 인터럽트 안전 송신 대기열)
+ *
+ * 다른 보드(회수 장치, 카메라 제어기 등)가 쓰는 자세/고도/정점 예측을 표준 11비트 ID
+ * 몇 개로 나누어 주기적으로 보낸다. 하드웨어 타이머 주기 인터럽트에서 can_publisher_tick을
+ * 호출하면 주기가 된 메시지를 nav_publisher의 최신 스냅샷으로 채워 대기열에 넣고,
+ * 빈 송신 메일박스(3개)에 바로 옮긴다. 메일박스 완료 인터럽트에서도 대기열을 이어서
+ * 옮기므로 버스가 바빠도 틱과 융합 태스크는 기다리지 않는다 (대기열이 차면 버리고 센다).
+ *
+ * 메시지 (ID = base_id + 번호, 낮은 ID가 버스 우선순위 높음, 리틀 엔디언):
+ * @verbatim
+ *   +0 ATTITUDE (8): q w, x, y, z int16 (1/32767)
+ *   +1 ALTITUDE (8): 고도 int32 (0.01 m, pos.z), 상승 속도 int16 (0.05 m/s), 비행 단계 u8, 순번 u8
+ *   +2 APOGEE   (8): 정점까지 시간 u16 (0.01 s), 예측 정점 고도 int32 (0.01 m), 고도 표준 편차 u16 (0.01 m)
+ *   +3 VELOCITY (6): 속도 xyz int16 (0.05 m/s)
+ *   +4 POSITION (8): 위치 x, y int32 (0.01 m)
+ *   +5 EPOCH    (5): 항법 해 유효 시각 u32 (us, 공유 시간축), 순번 u8
+ * @endverbatim
+ * 순번은 ALTITUDE를 보낼 때마다 1씩 늘어나 수신 측이 게시 중단을 알 수 있다. EPOCH는
+ * 같은 틱에서 보낸 ALTITUDE와 같은 순번을 실어 두 메시지를 짝지을 수 있게 한다.
+ *
+ * 공유 시간축은 이 보드의 timebase_now_us이며, sync_rate_hz > 0이면 can_time_sync.h의
+ * SYNC/FOLLOW_UP을 함께 보낸다. SYNC 송신 완료 시각은 메일박스 완료 인터럽트에서 잡고
+ * 다음 틱에서 FOLLOW_UP으로 보낸다 (대기열 생산자는 여전히 틱 한 곳). 수신 보드는
+ * EPOCH 시각을 can_time_sync_master_to_local로 자기 시간축으로 옮겨 출력 예측기를 돌린다.
+ *
+ * 연결 예 (CubeMX: CAN1 정상 모드, CAN1 TX 인터럽트 활성화, 게시용 TIM 주기 인터럽트):
+ * - HAL_TIM_PeriodElapsedCallback (게시 타이머): can_publisher_tick(&cp, timestamp_us)
+ * - HAL_CAN_TxMailbox0/1/2CompleteCallback, ...AbortCallback: can_publisher_handle_tx_complete(&cp)
+ * - HAL_CAN_ErrorCallback: can_publisher_handle_error(&cp)
+ *
+ * 대기열 생산자는 틱 한 곳이며, 메일박스 채우기는 틱과 CAN 인터럽트 중 먼저 들어온
+ * 쪽이 소유권을 얻어 수행한다 (flash_log 엔진과 같은 방식). 시각 동기를 쓰면 게시
+ * 타이머와 CAN TX 인터럽트를 같은 우선순위로 둔다 (틱이 SYNC를 메일박스에 넣는 도중
+ * 완료 인터럽트가 끼어들면 그 주기의 송신 시각을 놓침, 다음 주기에 다시 보냄).
+ */
+
+#ifndef CAN_PUBLISHER_H
+#define CAN_PUBLISHER_H
+
+#include "sys/board_profile.h"
+#include "stm32l4xx_hal.h"
+#include "nav/nav_publisher.h"
+#include "nav/flight_phase.h"
+#include "sys/can_time_sync.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#if !BOARD_HAS_CAN
+#error "nav/can_publisher.h requires BOARD_HAS_CAN (sys/board_profile.h)"
+#endif
+
+/**
+ * @brief 송신 대기열 크기 (2의 거듭제곱)
+ */
+#define CAN_PUBLISHER_QUEUE_SIZE 16
+
+#if (CAN_PUBLISHER_QUEUE_SIZE & (CAN_PUBLISHER_QUEUE_SIZE - 1)) != 0
+#error "CAN_PUBLISHER_QUEUE_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief 기본 메시지 ID 시작값
+ */
+#define CAN_PUBLISHER_DEFAULT_BASE_ID 0x100u
+
+/**
+ * @brief 게시 메시지
+ */
+typedef enum {
+    CAN_NAV_MSG_ATTITUDE = 0,  /**< 자세 사원수 */
+    CAN_NAV_MSG_ALTITUDE,      /**< 고도, 상승 속도, 비행 단계 */
+    CAN_NAV_MSG_APOGEE,        /**< 정점 예측 */
+    CAN_NAV_MSG_VELOCITY,      /**< 속도 */
+    CAN_NAV_MSG_POSITION,      /**< 수평 위치 */
+    CAN_NAV_MSG_EPOCH,         /**< 유효 시각 (공유 시간축) */
+    CAN_NAV_MSG_COUNT
+} CanNavMessage;
+
+/**
+ * @brief 게시 설정
+ */
+typedef struct {
+    uint16_t base_id;                  /**< 첫 메시지 ID (표준 ID, base_id + CAN_NAV_MSG_COUNT <= 0x800) */
+    float rate_hz[CAN_NAV_MSG_COUNT];  /**< 메시지별 전송률 (Hz, 0 이하이면 보내지 않음, 틱 주기로 제한) */
+    uint16_t sync_id;                  /**< 시각 동기 SYNC ID (FOLLOW_UP = +1) */
+    float sync_rate_hz;                /**< 시각 동기 전송률 (Hz, 0 이하이면 보내지 않음) */
+} CanPublisherConfig;
+
+/**
+ * @brief 대기 중인 CAN 프레임
+ */
+typedef struct {
+    uint16_t id;               /**< 표준 ID */
+    uint8_t dlc;               /**< 데이터 길이 */
+    uint8_t data[8];           /**< 데이터 */
+} CanPublisherFrame;
+
+/**
+ * @brief 항법 해 CAN 게시기
+ */
+typedef struct {
+    CAN_HandleTypeDef *hcan;   /**< CAN 핸들 */
+    const NavPublisher *pub;   /**< 항법 해 게시 버퍼 */
+    const FlightPhaseMachine *phase; /**< 비행 단계 (NULL이면 발사대 단계로 보냄) */
+    CanPublisherConfig config; /**< 설정 */
+
+    // 틱 (타이머 인터럽트)
+    uint32_t period_us[CAN_NAV_MSG_COUNT]; /**< 메시지 주기 (us, 0이면 보내지 않음) */
+    uint32_t next_us[CAN_NAV_MSG_COUNT];   /**< 다음 전송 예정 시각 (us) */
+    bool started;              /**< 첫 틱을 처리했는지 */
+    uint8_t counter;           /**< ALTITUDE/EPOCH 순번 */
+
+    // 시각 동기 (상태: 틱이 대기열에 넣음 -> 메일박스 채우기가 송신 중으로 -> 완료 인터럽트가 시각 기록)
+    uint32_t sync_period_us;   /**< SYNC 주기 (us, 0이면 보내지 않음) */
+    uint32_t sync_next_us;     /**< 다음 SYNC 예정 시각 (us) */
+    uint8_t sync_seq;          /**< 마지막 SYNC 순번 */
+    atomic_uint_fast32_t sync_state; /**< SYNC 진행 상태 */
+    uint32_t sync_mailbox;     /**< SYNC가 들어간 송신 메일박스 */
+    uint32_t sync_tx_us;       /**< SYNC 송신 완료 시각 (us) */
+    uint32_t sync_sent;        /**< 보낸 FOLLOW_UP 수 */
+    uint32_t sync_lost;        /**< 송신 시각을 잡지 못해 버린 SYNC 수 */
+
+    // 송신 대기열 (생산자: 틱, 소비자: 메일박스 채우기 소유자)
+    CanPublisherFrame queue[CAN_PUBLISHER_QUEUE_SIZE]; /**< 프레임 저장소 */
+    atomic_uint_fast32_t head; /**< 다음 쓰기 위치 (생산자 전용) */
+    atomic_uint_fast32_t tail; /**< 다음 읽기 위치 (소비자 전용) */
+    atomic_flag feeding;       /**< 메일박스 채우기 소유권 */
+
+    uint32_t sent;             /**< 메일박스에 넣은 프레임 수 */
+    uint32_t queue_drops;      /**< 대기열이 차서 버린 프레임 수 */
+    uint32_t nav_misses;       /**< 스냅샷을 읽지 못해 건너뛴 틱 수 */
+    uint32_t bus_errors;       /**< CAN 오류 통지 수 */
+    bool initialized;          /**< 초기화 여부 */
+} CanPublisher;
+
+/**
+ * @brief 기본 설정 (자세/고도/유효 시각 50 Hz, 정점 10 Hz, 속도 20 Hz, 위치 5 Hz, 시각 동기 1 Hz)
+ *
+ * 6개 메시지와 시각 동기 약 187 frame/s로 500 kbit/s 버스의 약 4.5%를 쓴다.
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool can_publisher_default_config(CanPublisherConfig *config);
+
+/**
+ * @brief 게시기 초기화 (CAN 시작과 송신 메일박스 빈 인터럽트 활성화 포함)
+ *
+ * CAN이 이미 시작되어 있으면(수신 등 다른 용도와 공유) 그대로 쓴다.
+ *
+ * @param cp 게시기 구조체 포인터
+ * @param hcan CAN 핸들 (HAL_CAN_Init 완료)
+ * @param pub 항법 해 게시 버퍼
+ * @param phase 비행 단계 (NULL 가능)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool can_publisher_init(CanPublisher *cp, CAN_HandleTypeDef *hcan, const NavPublisher *pub,
+                        const FlightPhaseMachine *phase, const CanPublisherConfig *config);
+
+/**
+ * @brief 게시 틱 (하드웨어 타이머 주기 인터럽트, 기다리지 않음)
+ *
+ * @param cp 게시기 구조체 포인터
+ * @param now_us 현재 시각 (us)
+ * @return uint32_t 대기열에 넣은 프레임 수
+ */
+uint32_t can_publisher_tick(CanPublisher *cp, uint32_t now_us);
+
+/**
+ * @brief 메일박스 송신 완료/중단 처리 (HAL_CAN_TxMailboxNCompleteCallback, ...AbortCallback)
+ *
+ * 시각 동기를 쓰면 SYNC 송신 완료 시각을 여기서 잡으므로 인터럽트 진입 직후 호출한다.
+ *
+ * @param cp 게시기 구조체 포인터
+ */
+void can_publisher_handle_tx_complete(CanPublisher *cp);
+
+/**
+ * @brief CAN 오류 처리 (HAL_CAN_ErrorCallback, 오류를 세고 대기열 송신을 이어감)
+ *
+ * @param cp 게시기 구조체 포인터
+ */
+void can_publisher_handle_error(CanPublisher *cp);
+
+/**
+ * @brief 메시지 데이터 채우기 (게시 형식, 수신 보드 시험용으로도 사용)
+ *
+ * @param msg 메시지 번호
+ * @param sol 항법 해 스냅샷
+ * @param phase 비행 단계
+ * @param counter ALTITUDE/EPOCH 순번
+ * @param data 결과 데이터 (8바이트)
+ * @return uint8_t 데이터 길이 (DLC, 알 수 없는 메시지이면 0)
+ */
+uint8_t can_publisher_pack(CanNavMessage msg, const EKF_NavSolution *sol, FlightPhase phase, uint8_t counter,
+                           uint8_t data[8]);
+
+#endif /* CAN_PUBLISHER_H */
@@ -0,0 +1,206 @@
+/**
+ * @file convergence_monitor.h
+ * @brief 필터 수렴 시각(준비까지 걸린 시간) 감시
+ *
+ * 전원 투입 뒤 필터가 실제로 쓸 만해지기까지의 시간을 잰다. 항법 해마다 공분산 대각으로
+ * 블록별 표준 편차를 구해 문턱과 비교하고, 문턱 아래에 hold_us 동안 머물면 그 블록을
+ * 수렴으로 본다. 수렴한 블록은 문턱 x release_ratio를 넘으면 다시 미수렴이 된다 (히스테리시스).
+ * required 블록이 모두 수렴하면 준비(ready) 상태이다. 블록별 첫 수렴 시각과 첫 준비 시각은
+ * 시작 시각 기준 경과 시간으로 한 번만 기록하므로 정렬, 보정값 저장소(cal_store.h),
+ * 영속도 갱신을 켜고 끈 부팅끼리 비교할 수 있다.
+ *
+ * 블록 표준 편차:
+ * - ATTITUDE: 2|dq_xyz| (작은 각에서 회전각 오차, rad)
+ * - VELOCITY, POSITION, GYRO_BIAS, ACCEL_BIAS: 축별 표준 편차의 최댓값
+ * 빌드에서 제외된 블록(EKF_CONFIG_POSITION, EKF_CONFIG_ACCEL_BIAS)은 수렴하지 않으며
+ * required에 넣을 수 없다.
+ *
+ * 쓰기는 융합 태스크 한 곳(fusion_scheduler 또는 해를 만드는 곳)에서만 하며, 텔레메트리
+ * 태스크는 32비트 필드를 잠금 없이 읽는다. 융합 태스크는 stats.events가 바뀌었을 때
+ * flash_log_ready로 상태를 비행 기록에 남긴다.
+ */
+
+#ifndef CONVERGENCE_MONITOR_H
+#define CONVERGENCE_MONITOR_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 감시 블록 (비트 번호 = 수렴 mask 비트)
+ */
+typedef enum {
+    CONVERGENCE_BLOCK_ATTITUDE = 0, /**< 자세 */
+    CONVERGENCE_BLOCK_VELOCITY,     /**< 속도 */
+    CONVERGENCE_BLOCK_POSITION,     /**< 위치 */
+    CONVERGENCE_BLOCK_GYRO_BIAS,    /**< 자이로 바이어스 */
+    CONVERGENCE_BLOCK_ACCEL_BIAS,   /**< 가속도 바이어스 */
+    CONVERGENCE_BLOCK_COUNT         /**< 블록 수 */
+} ConvergenceBlock;
+
+/**
+ * @brief 블록 비트
+ */
+#define CONVERGENCE_BIT(block) (1u << (block))
+
+/**
+ * @brief 빌드에 있는 블록
+ */
+#if EKF_CONFIG_POSITION
+#define CONVERGENCE_BLOCK_POSITION_BIT CONVERGENCE_BIT(CONVERGENCE_BLOCK_POSITION)
+#else
+#define CONVERGENCE_BLOCK_POSITION_BIT 0u
+#endif
+#if EKF_CONFIG_ACCEL_BIAS
+#define CONVERGENCE_BLOCK_ACCEL_BIAS_BIT CONVERGENCE_BIT(CONVERGENCE_BLOCK_ACCEL_BIAS)
+#else
+#define CONVERGENCE_BLOCK_ACCEL_BIAS_BIT 0u
+#endif
+#define CONVERGENCE_AVAILABLE_MASK (CONVERGENCE_BIT(CONVERGENCE_BLOCK_ATTITUDE) | \
+                                    CONVERGENCE_BIT(CONVERGENCE_BLOCK_VELOCITY) | \
+                                    CONVERGENCE_BLOCK_POSITION_BIT | \
+                                    CONVERGENCE_BIT(CONVERGENCE_BLOCK_GYRO_BIAS) | \
+                                    CONVERGENCE_BLOCK_ACCEL_BIAS_BIT)
+
+/**
+ * @brief 아직 수렴(준비)하지 않은 시각 표시
+ */
+#define CONVERGENCE_NEVER UINT32_MAX
+
+/**
+ * @brief 기본 설정
+ */
+#define CONVERGENCE_DEFAULT_ATTITUDE_STD 0.035f    /**< 자세 (rad, 약 2 deg) */
+#define CONVERGENCE_DEFAULT_VELOCITY_STD 0.1f      /**< 속도 (m/s) */
+#define CONVERGENCE_DEFAULT_POSITION_STD 5.0f      /**< 위치 (m) */
+#define CONVERGENCE_DEFAULT_GYRO_BIAS_STD 1e-3f    /**< 자이로 바이어스 (rad/s) */
+#define CONVERGENCE_DEFAULT_ACCEL_BIAS_STD 0.05f   /**< 가속도 바이어스 (m/s^2) */
+#define CONVERGENCE_DEFAULT_HOLD_US 1000000u       /**< 수렴 판정 유지 시간 (us) */
+#define CONVERGENCE_DEFAULT_RELEASE_RATIO 2.0f     /**< 미수렴 복귀 문턱 배수 */
+
+/**
+ * @brief 기본 준비 조건 (위치는 GNSS 수신에 달려 있어 제외)
+ */
+#define CONVERGENCE_DEFAULT_REQUIRED (CONVERGENCE_BIT(CONVERGENCE_BLOCK_ATTITUDE) | \
+                                      CONVERGENCE_BIT(CONVERGENCE_BLOCK_VELOCITY) | \
+                                      CONVERGENCE_BIT(CONVERGENCE_BLOCK_GYRO_BIAS) | \
+                                      CONVERGENCE_BLOCK_ACCEL_BIAS_BIT)
+
+/**
+ * @brief 감시기 설정
+ */
+typedef struct {
+    float threshold[CONVERGENCE_BLOCK_COUNT]; /**< 블록별 수렴 표준 편차 문턱 */
+    uint32_t hold_us;          /**< 문턱 아래에 머물러야 하는 시간 (us, 0이면 즉시) */
+    float release_ratio;       /**< 수렴 블록이 미수렴으로 돌아가는 문턱 배수 (1 이상) */
+    uint8_t required;          /**< 준비 조건 블록 (CONVERGENCE_BIT 조합) */
+} ConvergenceMonitorConfig;
+
+/**
+ * @brief 블록별 통계
+ */
+typedef struct {
+    uint32_t converged_us;     /**< 첫 수렴까지 경과 시간 (us, 없으면 CONVERGENCE_NEVER) */
+    uint32_t losses;           /**< 수렴 뒤 다시 미수렴이 된 횟수 */
+    float std;                 /**< 마지막 표준 편차 */
+} ConvergenceBlockStats;
+
+/**
+ * @brief 감시기 통계
+ */
+typedef struct {
+    ConvergenceBlockStats block[CONVERGENCE_BLOCK_COUNT]; /**< 블록별 통계 */
+    uint32_t ready_us;         /**< 첫 준비까지 경과 시간 (us, 없으면 CONVERGENCE_NEVER) */
+    uint32_t ready_losses;     /**< 준비 뒤 다시 준비가 풀린 횟수 */
+    uint32_t updates;          /**< 처리한 항법 해 수 */
+    uint32_t events;           /**< 수렴 mask가 바뀐 횟수 (기록 태스크 변경 확인용) */
+} ConvergenceMonitorStats;
+
+/**
+ * @brief 수렴 감시기
+ */
+typedef struct {
+    ConvergenceMonitorConfig config; /**< 설정 */
+    uint32_t start_us;         /**< 경과 시간 기준 (전원 투입 또는 필터 초기화 시각, us) */
+    uint32_t below_since_us[CONVERGENCE_BLOCK_COUNT]; /**< 문턱 아래로 들어온 시각 (us) */
+    uint8_t below_mask;        /**< 문턱 아래에 있는 블록 */
+    uint8_t converged_mask;    /**< 수렴한 블록 */
+    bool ready;                /**< 준비 상태 */
+    uint32_t last_us;          /**< 마지막 항법 해 시각 (us) */
+    ConvergenceMonitorStats stats; /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} ConvergenceMonitor;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool convergence_monitor_default_config(ConvergenceMonitorConfig *config);
+
+/**
+ * @brief 감시기 초기화
+ *
+ * @param mon 감시기
+ * @param config 설정 (NULL이면 기본 설정)
+ * @param start_us 경과 시간 기준 시각 (us, 항법 해와 같은 시간축)
+ * @return bool 성공 여부 (문턱이 양수가 아니거나 빌드에 없는 블록을 요구하면 false)
+ */
+bool convergence_monitor_init(ConvergenceMonitor *mon, const ConvergenceMonitorConfig *config, uint32_t start_us);
+
+/**
+ * @brief 공분산 대각으로 한 단계 갱신
+ *
+ * @param mon 감시기
+ * @param p_diag 공분산 대각 (상태 인덱스 순, EKF_STATE_DIM개)
+ * @param timestamp_us 해의 유효 시각 (us)
+ * @return uint8_t 이번 호출에서 수렴 상태가 바뀐 블록 (CONVERGENCE_BIT 조합)
+ */
+uint8_t convergence_monitor_update(ConvergenceMonitor *mon, const float *p_diag, uint32_t timestamp_us);
+
+/**
+ * @brief 항법 해로 갱신 (nav_publisher 스냅샷, filter_engine 해)
+ *
+ * @param mon 감시기
+ * @param sol 항법 해
+ * @return uint8_t 수렴 상태가 바뀐 블록
+ */
+uint8_t convergence_monitor_update_solution(ConvergenceMonitor *mon, const EKF_NavSolution *sol);
+
+/**
+ * @brief 필터 공분산으로 바로 갱신 (항법 해를 만들지 않는 융합 루프용)
+ *
+ * @param mon 감시기
+ * @param ekf 필터
+ * @param timestamp_us 해의 유효 시각 (us)
+ * @return uint8_t 수렴 상태가 바뀐 블록
+ */
+uint8_t convergence_monitor_update_ekf(ConvergenceMonitor *mon, const EKF *ekf, uint32_t timestamp_us);
+
+/**
+ * @brief 수렴한 블록
+ *
+ * @param mon 감시기
+ * @return uint8_t CONVERGENCE_BIT 조합 (NULL이면 0)
+ */
+uint8_t convergence_monitor_converged(const ConvergenceMonitor *mon);
+
+/**
+ * @brief 준비 상태 (required 블록이 모두 수렴)
+ *
+ * @param mon 감시기
+ * @return bool 준비 여부 (NULL이면 false)
+ */
+bool convergence_monitor_is_ready(const ConvergenceMonitor *mon);
+
+/**
+ * @brief 통계
+ *
+ * @param mon 감시기
+ * @return const ConvergenceMonitorStats* 통계 (mon이 NULL이면 NULL)
+ */
+const ConvergenceMonitorStats *convergence_monitor_get_stats(const ConvergenceMonitor *mon);
+
+#endif /* CONVERGENCE_MONITOR_H */
@@ -0,0 +1,207 @@
+/**
+ * @file event_detector.h
+ * @brief 원시 IMU/기압계 입력에서 발사, 연소 종료, 정점 이벤트 검출
+ *
+ * 필터 출력은 필터 지연과 융합 태스크 부하만큼 늦으므로, 배치 이벤트는 입력 단계에서
+ * 직접 검출한다.
+ * - IMU: ImuRing 생산자 탭(event_detector_imu_tap)으로 DMA 완료 문맥에서 샘플마다
+ *   실행된다. 최근 EVENT_DETECTOR_ACCEL_WINDOW개 샘플의 비력 크기 RMS가
+ *   발사 임계값 이상이면 발사, 추진 최소 시간 이후 연소 종료 임계값 미만이면
+ *   연소 종료로 판정한다.
+ * - 기압계: 기압계 읽기 문맥에서 event_detector_push_baro로 넣는다. 최근
+ *   EVENT_DETECTOR_BARO_WINDOW개 샘플의 최소 제곱 직선 기울기로 수직 속도를 구하고,
+ *   발사 후 차단 시간(천음속 압력 교란)이 지난 뒤 하강 속도가 임계값 이상으로
+ *   연속 apogee_confirm회 나오면 정점으로 판정한다.
+ *
+ * 이벤트는 종류마다 한 번만 발생하며, 검출 시각과 추정 발생 시각을 함께 기록한다.
+ * 콜백이 설정되어 있으면 검출 문맥에서 즉시 호출되므로(배치 장치 구동 등) 지연은
+ * 판정 창 길이(수 ms)로 정해지고 필터 부하와 무관하다. 융합 태스크는
+ * event_detector_poll로 같은 이벤트를 시각 순으로 받아 비행 단계에 반영한다.
+ *
+ * IMU 탭과 기압계 입력은 서로 다른 문맥(생산자 2개)에서 호출되어도 되며,
+ * 이벤트 전달은 종류별 비트를 원자적으로 세우는 방식이라 잠금이 없다.
+ * event_detector_poll은 한 소비자에서만 호출해야 한다.
+ */
+
+#ifndef EVENT_DETECTOR_H
+#define EVENT_DETECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "math/vector3f.h"
+#include "nav/flight_phase.h"
+#include "sensors/imu_ring.h"
+
+/**
+ * @brief 비력 크기 창 길이 (IMU 샘플, 2의 거듭제곱, 1 kHz에서 16 ms)
+ */
+#define EVENT_DETECTOR_ACCEL_WINDOW 16
+
+#if (EVENT_DETECTOR_ACCEL_WINDOW & (EVENT_DETECTOR_ACCEL_WINDOW - 1)) != 0
+#error "EVENT_DETECTOR_ACCEL_WINDOW must be a power of two"
+#endif
+
+/**
+ * @brief 기압계 수직 속도 창 길이 (샘플, 2의 거듭제곱)
+ */
+#define EVENT_DETECTOR_BARO_WINDOW 8
+
+#if (EVENT_DETECTOR_BARO_WINDOW & (EVENT_DETECTOR_BARO_WINDOW - 1)) != 0
+#error "EVENT_DETECTOR_BARO_WINDOW must be a power of two"
+#endif
+
+/**
+ * @brief 기본 판정 조건
+ */
+#define EVENT_DETECTOR_DEFAULT_LAUNCH_ACCEL 29.4f      /**< 발사 비력 RMS 임계값 (m/s^2, 3 g) */
+#define EVENT_DETECTOR_DEFAULT_BURNOUT_ACCEL 11.8f     /**< 연소 종료 비력 RMS 임계값 (m/s^2, 1.2 g) */
+#define EVENT_DETECTOR_DEFAULT_BURNOUT_MIN_US 100000u  /**< 발사 후 연소 종료 판정 최소 시간 (us) */
+#define EVENT_DETECTOR_DEFAULT_APOGEE_DESCENT 2.0f     /**< 정점 판정 하강 속도 (m/s, 양수) */
+#define EVENT_DETECTOR_DEFAULT_APOGEE_CONFIRM 3u       /**< 정점 판정 연속 기압계 샘플 수 */
+#define EVENT_DETECTOR_DEFAULT_APOGEE_LOCKOUT_US 2000000u /**< 발사 후 정점 판정 차단 시간 (us) */
+
+/**
+ * @brief 정점 시각 예측에 사용하는 감속도 (m/s^2, 항력 무시)
+ */
+#define EVENT_DETECTOR_PREDICT_DECEL 9.80665f
+
+/**
+ * @brief 이벤트 콜백 (검출 문맥에서 호출, 짧게 끝나야 함)
+ */
+typedef void (*FlightEventFn)(const FlightEvent *event, void *context);
+
+/**
+ * @brief 판정 조건 설정
+ */
+typedef struct {
+    float launch_accel;        /**< 발사 비력 RMS 임계값 (m/s^2) */
+    float burnout_accel;       /**< 연소 종료 비력 RMS 임계값 (m/s^2) */
+    uint32_t burnout_min_us;   /**< 발사 후 연소 종료 판정 최소 시간 (us) */
+    float apogee_descent;      /**< 정점 판정 하강 속도 (m/s, 양수) */
+    uint8_t apogee_confirm;    /**< 정점 판정 연속 샘플 수 */
+    uint32_t apogee_lockout_us;/**< 발사 후 정점 판정 차단 시간 (us) */
+} EventDetectorConfig;
+
+/**
+ * @brief 비행 이벤트 검출기
+ */
+typedef struct {
+    EventDetectorConfig config; /**< 판정 조건 */
+    FlightEventFn callback;     /**< 이벤트 콜백 (NULL 가능) */
+    void *callback_context;     /**< 콜백 문맥 */
+
+    // IMU 생산자 전용
+    float accel_sq[EVENT_DETECTOR_ACCEL_WINDOW]; /**< 창 내 비력 크기 제곱 (m/s^2)^2 */
+    float accel_sq_sum;        /**< 창 내 비력 크기 제곱 합 */
+    uint8_t accel_index;       /**< 다음 기록 위치 */
+    uint8_t accel_count;       /**< 창 내 샘플 수 */
+    bool accel_above;          /**< 직전 샘플이 판정 임계값 쪽에 있었는지 */
+    uint32_t accel_run_us;     /**< 임계값 쪽 연속 구간 시작 시각 (us) */
+
+    // 기압계 생산자 전용
+    uint32_t baro_t[EVENT_DETECTOR_BARO_WINDOW]; /**< 창 내 기압계 샘플 시각 (us) */
+    float baro_alt[EVENT_DETECTOR_BARO_WINDOW];  /**< 창 내 기압계 고도 (m) */
+    uint8_t baro_index;        /**< 다음 기록 위치 */
+    uint8_t baro_count;        /**< 창 내 샘플 수 */
+    float baro_velocity;       /**< 최근 창 수직 속도 (m/s, 위쪽 양수) */
+    float baro_peak_alt;       /**< 발사 후 최고 적합 고도 (m) */
+    uint32_t baro_peak_us;     /**< 최고 적합 고도 시각 (us) */
+    uint8_t descent_count;     /**< 하강 판정 연속 샘플 수 */
+
+    FlightEvent events[FLIGHT_EVENT_COUNT]; /**< 종류별 이벤트 (발생 비트가 선 뒤 유효) */
+    atomic_uint_fast32_t fired;             /**< 발생 비트 (생산자가 세움) */
+    uint32_t consumed;                      /**< 전달 완료 비트 (소비자 전용) */
+} EventDetector;
+
+/**
+ * @brief 기본 판정 조건
+ *
+ * @param config 판정 조건
+ * @return bool 성공 여부
+ */
+bool event_detector_default_config(EventDetectorConfig *config);
+
+/**
+ * @brief 검출기 초기화
+ *
+ * 생산자(IMU 탭, 기압계 입력)가 동작하기 전에 호출해야 한다.
+ *
+ * @param det 검출기
+ * @param config 판정 조건 (NULL이면 기본값)
+ * @param callback 이벤트 콜백 (NULL이면 poll로만 전달)
+ * @param context 콜백 문맥
+ * @return bool 성공 여부 (apogee_confirm이 0이면 false)
+ */
+bool event_detector_init(EventDetector *det, const EventDetectorConfig *config,
+                         FlightEventFn callback, void *context);
+
+/**
+ * @brief IMU 샘플 판정 (발사, 연소 종료)
+ *
+ * @param det 검출기
+ * @param timestamp_us 샘플 시각 (us)
+ * @param accel 가속도계 측정값 (m/s^2, 비력)
+ */
+void event_detector_push_imu(EventDetector *det, uint32_t timestamp_us, Vector3f accel);
+
+/**
+ * @brief ImuRing 생산자 탭 (imu_ring_set_tap(ring, event_detector_imu_tap, det))
+ *
+ * @param sample IMU 샘플
+ * @param context 검출기 (EventDetector *)
+ */
+void event_detector_imu_tap(const ImuSample *sample, void *context);
+
+/**
+ * @brief 기압계 샘플 판정 (정점)
+ *
+ * @param det 검출기
+ * @param timestamp_us 측정 시각 (us)
+ * @param baro_alt 기압계 고도 (m)
+ */
+void event_detector_push_baro(EventDetector *det, uint32_t timestamp_us, float baro_alt);
+
+/**
+ * @brief 기압계 수직 속도 조회
+ *
+ * @param det 검출기
+ * @param vel_up 수직 속도 (m/s, 위쪽 양수)
+ * @return bool 성공 여부 (창이 차지 않았으면 false)
+ */
+bool event_detector_get_baro_velocity(const EventDetector *det, float *vel_up);
+
+/**
+ * @brief 정점 시각 예측 (상승 중, 감속도 EVENT_DETECTOR_PREDICT_DECEL 가정)
+ *
+ * 항력을 무시하므로 실제 정점보다 늦게 예측한다 (배치 준비용 상한).
+ *
+ * @param det 검출기
+ * @param apogee_us 예측 정점 시각 (us)
+ * @return bool 성공 여부 (창이 차지 않았거나 상승 중이 아니면 false)
+ */
+bool event_detector_predict_apogee(const EventDetector *det, uint32_t *apogee_us);
+
+/**
+ * @brief 다음 이벤트 꺼내기 (소비자 전용, 종류 순서: 발사, 연소 종료, 정점)
+ *
+ * 검출 시각이 until_us 이후인 이벤트는 남겨 두므로, IMU 샘플 시각을 넘겨
+ * 샘플 처리 순서와 이벤트 순서를 맞출 수 있다.
+ *
+ * @param det 검출기
+ * @param until_us 이 시각까지 검출된 이벤트만 반환 (us)
+ * @param event 이벤트 저장 위치
+ * @return bool 꺼냈으면 true
+ */
+bool event_detector_poll(EventDetector *det, uint32_t until_us, FlightEvent *event);
+
+/**
+ * @brief 이벤트 발생 여부 (어느 문맥에서나 호출 가능)
+ *
+ * @param det 검출기
+ * @param type 이벤트 종류
+ * @return bool 발생했으면 true
+ */
+bool event_detector_has_fired(const EventDetector *det, FlightEventType type);
+
+#endif /* EVENT_DETECTOR_H */
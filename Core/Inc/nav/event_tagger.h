@@ -0,0 +1,172 @@
+/**
+ * @file event_tagger.h
+ * @brief 외부 사건 시각(카메라 트리거, 파이로 점화 등)의 항법 상태를 짧은 출력 이력에서 보간
+ *
+ * 탑재 카메라나 파이로 사건은 마지막 융합 시각이 아니라 트리거 에지 시각의 상태가 필요하다.
+ * 출력 예측기(output_predictor_set_tagger)가 샘플마다 현재 출력(시각, 위치, 속도, 자세)을 환형
+ * 이력에 넣고, 입력 캡처(timebase_attach_capture)나 EXTI로 잡은 시각을 event_tagger_query에
+ * 넘기면 그 시각을 감싸는 두 샘플 사이를 보간한다.
+ *
+ * - 자세: quaternion_slerp (최단 경로)
+ * - 위치/속도: LINEAR는 선형, CUBIC은 두 끝의 위치와 속도를 맞추는 3차 에르미트 곡선
+ *   (속도는 그 도함수, 샘플 사이의 가속을 반영)
+ * - 가장 새 샘플보다 늦은 시각: max_extrapolate_us 이내면 마지막 두 샘플로 외삽 (자세는 같은
+ *   각속도, 속도는 같은 가속, 위치는 사다리꼴 적분), 넘으면 PENDING (다음 샘플 뒤에 다시 질의).
+ *   캡처 직후 질의하면 보통 샘플 하나만큼 늦으므로 외삽이나 다음 샘플 뒤 재질의 중 고른다.
+ * - 감싸는 두 샘플 간격이 max_span_us를 넘으면 (출력 예측기 중단 등) GAP으로 거부한다.
+ *
+ * 이력은 작성자 하나(출력 예측기 문맥)와 여러 읽는 쪽(융합 태스크, 인터럽트 포함 어느 우선순위든)
+ * 사이에서 잠금이 없다. 작성자는 슬롯을 쓴 뒤 누적 기록 수를 release로 올리고, 읽는 쪽은 탐색과
+ * 복사 뒤 기록 수를 다시 읽어 읽은 가장 오래된 슬롯이 덮어쓰이지 않았는지 확인한다 (아니면 재시도).
+ * 탐색은 이력 길이에 대한 이진 탐색이라 질의 시간은 시각과 무관하게 상한이 있다 (기본 64개에서
+ * 시각 읽기 8번과 샘플 복사 2번, 1 kHz 출력이면 최근 약 62 ms).
+ *
+ * 시각은 timebase_now_us와 같은 uint32_t us 시간축이다 (64비트 캡처 시각은 하위 32비트를 넘김).
+ */
+
+#ifndef EVENT_TAGGER_H
+#define EVENT_TAGGER_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 이력 길이 (2의 거듭제곱)
+ */
+#ifndef EVENT_TAGGER_HISTORY
+#define EVENT_TAGGER_HISTORY 64u
+#endif
+
+_Static_assert((EVENT_TAGGER_HISTORY & (EVENT_TAGGER_HISTORY - 1u)) == 0 && EVENT_TAGGER_HISTORY >= 4u,
+               "EVENT_TAGGER_HISTORY must be a power of two >= 4");
+
+/**
+ * @brief 기본 설정
+ */
+#define EVENT_TAGGER_DEFAULT_MAX_EXTRAPOLATE_US 2000u  /**< 외삽 한계 (us) */
+#define EVENT_TAGGER_DEFAULT_MAX_SPAN_US 20000u        /**< 감싸는 샘플 간격 한계 (us) */
+
+/**
+ * @brief 읽는 쪽의 최대 재시도 횟수
+ */
+#define EVENT_TAGGER_MAX_RETRIES 4
+
+/**
+ * @brief 위치/속도 보간 방식
+ */
+typedef enum {
+    EVENT_TAGGER_LINEAR = 0,   /**< 선형 */
+    EVENT_TAGGER_CUBIC         /**< 3차 에르미트 (위치와 속도를 함께 맞춤) */
+} EventTaggerMethod;
+
+/**
+ * @brief 질의 결과 상태
+ */
+typedef enum {
+    EVENT_TAGGER_OK = 0,       /**< 두 샘플 사이 보간 */
+    EVENT_TAGGER_EXTRAPOLATED, /**< 가장 새 샘플 뒤로 외삽 */
+    EVENT_TAGGER_PENDING,      /**< 외삽 한계보다 늦음 (다음 샘플 뒤 재질의) */
+    EVENT_TAGGER_TOO_OLD,      /**< 이력보다 오래됨 */
+    EVENT_TAGGER_GAP,          /**< 감싸는 샘플 간격이 한계 초과 */
+    EVENT_TAGGER_EMPTY,        /**< 샘플이 두 개 미만 */
+    EVENT_TAGGER_BUSY          /**< 재시도 한도 초과 (작성자가 계속 덮어씀) */
+} EventTaggerStatus;
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t max_extrapolate_us; /**< 가장 새 샘플 뒤 외삽 한계 (us, 0이면 외삽 안 함) */
+    uint32_t max_span_us;      /**< 감싸는 두 샘플 간격 한계 (us) */
+} EventTaggerConfig;
+
+/**
+ * @brief 이력 샘플
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 출력 시각 (us) */
+    Vector3f pos;              /**< 위치 (NED, m) */
+    Vector3f vel;              /**< 속도 (NED, m/s) */
+    Quaternion q;              /**< 자세 사원수 */
+} EventTaggerSample;
+
+/**
+ * @brief 질의 결과
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 질의 시각 (us) */
+    Vector3f pos;              /**< 위치 (NED, m) */
+    Vector3f vel;              /**< 속도 (NED, m/s) */
+    Quaternion q;              /**< 자세 사원수 (정규화됨) */
+    uint32_t span_us;          /**< 사용한 두 샘플 간격 (us) */
+    uint8_t status;            /**< EventTaggerStatus */
+} EventTaggerResult;
+
+/**
+ * @brief 통계 (작성자 문맥)
+ */
+typedef struct {
+    uint32_t pushes;           /**< 기록한 샘플 수 */
+    uint32_t out_of_order;     /**< 시각이 앞서지 않아 버린 샘플 수 */
+} EventTaggerStats;
+
+/**
+ * @brief 사건 시각 보간기
+ */
+typedef struct {
+    EventTaggerConfig config;  /**< 설정 */
+    EventTaggerSample ring[EVENT_TAGGER_HISTORY]; /**< 출력 이력 (슬롯 = 기록 번호 % 길이) */
+    atomic_uint_fast32_t head; /**< 누적 기록 수 (다음 기록 번호) */
+    uint32_t last_us;          /**< 마지막 기록 시각 (us) */
+    EventTaggerStats stats;    /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} EventTagger;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool event_tagger_default_config(EventTaggerConfig *config);
+
+/**
+ * @brief 초기화
+ *
+ * @param et 구조체 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool event_tagger_init(EventTagger *et, const EventTaggerConfig *config);
+
+/**
+ * @brief 출력 하나 기록 (작성자 문맥 하나, 보통 출력 예측기)
+ *
+ * @param et 구조체 포인터
+ * @param sol 현재 출력
+ * @return bool 성공 여부 (시각이 앞서지 않으면 false)
+ */
+bool event_tagger_push(EventTagger *et, const EKF_NavSolution *sol);
+
+/**
+ * @brief 사건 시각의 상태 보간 (어느 문맥이든, 잠금 없음)
+ *
+ * @param et 구조체 포인터
+ * @param timestamp_us 사건 시각 (us, 캡처 시각)
+ * @param method EventTaggerMethod
+ * @param out 결과 (status는 실패해도 채움)
+ * @return bool 상태를 냈으면 true (OK 또는 EXTRAPOLATED)
+ */
+bool event_tagger_query(const EventTagger *et, uint32_t timestamp_us, uint8_t method, EventTaggerResult *out);
+
+/**
+ * @brief 통계
+ *
+ * @param et 구조체 포인터
+ * @return const EventTaggerStats* 통계 (NULL이면 NULL)
+ */
+const EventTaggerStats *event_tagger_get_stats(const EventTagger *et);
+
+#endif /* EVENT_TAGGER_H */
@@ -0,0 +1,271 @@
+/**
+ * @file federated.h
+ * @brief 보드 간 연합 항법 (양자화 요약 교환, 교차 검사, 공분산 교차 융합)
+ *
+ * 항법 보드와 회수 보드가 각자 필터를 돌리고 (회수 보드는 축소 상태 빌드, 예:
+ * EKF_CONFIG_ACCEL_BIAS=0), 공통 항법 오차 표현(ekf.h, EKF_NAV_ERROR_DIM = 9: 몸체
+ * 좌표계 회전각, 속도, 위치)의 요약을 낮은 주기(1~5 Hz)로 CAN에 보낸다. 받은 쪽은
+ * 1. 교차 검사: 차이 y와 Pa + Pb로 NIS = y^T (Pa + Pb)^-1 y 를 구해 check_gate와 비교
+ *    (disagree_count 연속이면 불일치로 보고 융합을 멈춤, 어느 쪽이 틀렸는지는 상위 판단)
+ * 2. 공분산 교차(CI) 융합: 두 필터가 같은 IMU 계열/측정을 써 상관을 모르므로
+ *    det((ω Pa^-1 + (1 - ω) Pb^-1)^-1)을 최소로 하는 ω를 황금 분할로 찾고
+ *    ekf_update_nav_estimate로 자기 필터에 반영한다.
+ * 회수 보드가 항법 보드 요약을 계속 융합하므로, 항법 보드가 멈춰도(federated_remote_alive
+ * 가 false) 회수 보드 필터는 이미 같은 해 근처에 있어 다시 수렴할 필요가 없다.
+ *
+ * 요약 공분산은 "대각 + 저계수" 형태로 보낸다. 표준 편차 s_i를 올림 양자화한 S로
+ * 정규화한 M = S^-1 P S^-1 의 고유 분해(야코비 회전)에서 상위 FEDERATED_RANK개를 남기면
+ * M ⪯ λ I + U U^T (λ = 다음 고유값, U = V sqrt(Λ - λ))이다. U의 8비트 양자화 오차 E는
+ * (U - E)(U - E)^T ⪯ (1 + ε) U U^T + (1 + 1/ε) |E|_F^2 I 로 λ에 더하므로, 받은 쪽의
+ * P̂ = S (λ I + (1 + ε) Û Û^T) S 는 보낸 쪽 P보다 작지 않다 (CI의 일관성 전제).
+ *
+ * 전송 형식 (리틀 엔디언, FEDERATED_WIRE_SIZE 바이트를 프레임 FEDERATED_FRAME_COUNT개로):
+ * @verbatim
+ *   ID = base_id + node_id, DLC 8, 바이트 0 = 순번(상위 4비트) | 조각 번호(하위 4비트)
+ *   요약:  0 유효 시각 u32 (us, 공유 시간축)   4 성분 u8 (EKF_NAV_ERROR_*)
+ *          5 사원수 int16 x4 (1/32767)        13 속도 int16 x3 (0.02 m/s)
+ *         19 위치 int32 x3 (0.01 m)           31 표준 편차 코드 u8 x9
+ *         40 λ 코드 u8                         41 U 열 눈금 코드 u8 x2
+ *         43 U int8 (9 x 2, 행 순)            61 예약 (0)
+ * @endverbatim
+ * 표준 편차 코드 c: s = base x 2^(c/8) (base: 회전각 1e-5 rad, 속도 1e-4 m/s, 위치 1e-3 m),
+ * λ 코드 c: λ = c / 64, U 눈금 코드 c: 한 칸 = 2^((c - 128) / 8).
+ * 9 프레임 x 2 Hz는 500 kbit/s 버스의 약 0.5%, 요약 만들기(9x9 야코비)는 1 ms 미만이다.
+ *
+ * 시각은 can_time_sync.h의 공유 시간축(항법 보드 us)이다. 회수 보드는 자기 시각을
+ * can_time_sync_local_to_master로 옮겨 넘긴다. max_age_us보다 오래된 요약은 쓰지 않고,
+ * 그 안이면 위치만 속도로 나이만큼 옮긴다.
+ *
+ * 모든 함수는 융합 태스크 한 곳에서 호출한다 (수신 프레임은 CAN 수신 인터럽트에서
+ * 태스크로 넘겨 federated_handle_frame에 준다).
+ */
+
+#ifndef FEDERATED_H
+#define FEDERATED_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 공분산 저계수 부분 계수
+ */
+#define FEDERATED_RANK 2
+
+/**
+ * @brief 요약 크기와 프레임 수 (프레임당 7바이트)
+ */
+#define FEDERATED_WIRE_SIZE 63u
+#define FEDERATED_FRAME_PAYLOAD 7u
+#define FEDERATED_FRAME_COUNT (FEDERATED_WIRE_SIZE / FEDERATED_FRAME_PAYLOAD)
+
+/**
+ * @brief 저계수 양자화 보수화 계수 ε
+ */
+#define FEDERATED_LOW_RANK_MARGIN 0.125f
+
+/**
+ * @brief 야코비 고유 분해 최대 회전 주기 수
+ */
+#define FEDERATED_JACOBI_SWEEPS 8u
+
+/**
+ * @brief CI 가중치 황금 분할 반복 수
+ */
+#define FEDERATED_OMEGA_ITERATIONS 10u
+
+/**
+ * @brief 기본 설정
+ */
+#define FEDERATED_DEFAULT_BASE_ID 0x140u           /**< 요약 메시지 ID 시작값 (+ node_id) */
+#define FEDERATED_DEFAULT_CHECK_GATE 27.9f         /**< 교차 검사 NIS 문턱 (9자유도 99.9%) */
+#define FEDERATED_DEFAULT_DISAGREE_COUNT 3u        /**< 불일치 판정 연속 검사 수 */
+#define FEDERATED_DEFAULT_MAX_AGE_US 100000u       /**< 융합에 쓰는 요약 최대 나이 (us) */
+#define FEDERATED_DEFAULT_TIMEOUT_US 1000000u      /**< 원격 노드 중단 판정 (us) */
+#define FEDERATED_DEFAULT_OMEGA_MIN 0.05f          /**< CI 가중치 하한 (자기 P 부풀림 20배 이내) */
+
+/**
+ * @brief 연합 설정
+ */
+typedef struct {
+    uint16_t base_id;          /**< 요약 메시지 ID 시작값 (표준 ID, base_id + 16 <= 0x800) */
+    uint8_t node_id;           /**< 이 보드 번호 (0..15) */
+    float check_gate;          /**< 교차 검사 NIS 문턱 */
+    uint16_t disagree_count;   /**< 불일치 판정 연속 검사 수 */
+    uint32_t max_age_us;       /**< 융합에 쓰는 요약 최대 나이 (us) */
+    uint32_t timeout_us;       /**< 원격 노드 중단 판정 (us) */
+    float omega_min;           /**< CI 가중치 하한 (0, 1) */
+} FederatedConfig;
+
+/**
+ * @brief 항법 추정 요약 (복원 값)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 유효 시각 (us, 공유 시간축) */
+    uint8_t components;        /**< 유효 성분 (EKF_NAV_ERROR_*) */
+    Quaternion q;              /**< 자세 */
+    Vector3f vel;              /**< 속도 (NED, m/s) */
+    Vector3f pos;              /**< 위치 (NED, m) */
+    float P[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM]; /**< 항법 오차 공분산 */
+} FederatedEstimate;
+
+/**
+ * @brief 보낼 CAN 프레임
+ */
+typedef struct {
+    uint16_t id;               /**< 표준 ID */
+    uint8_t dlc;               /**< 데이터 길이 */
+    uint8_t data[8];           /**< 데이터 */
+} FederatedFrame;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t sent;             /**< 만든 요약 수 */
+    uint32_t received;         /**< 다 받은 원격 요약 수 */
+    uint32_t incomplete;       /**< 조각이 빠져 버린 원격 요약 수 */
+    uint32_t checks;           /**< 교차 검사 수 */
+    uint32_t gate_fails;       /**< NIS가 문턱을 넘은 검사 수 */
+    uint32_t fusions;          /**< CI 융합 수 */
+    uint32_t stale;            /**< 오래되어 쓰지 않은 요약 수 */
+    float last_nis;            /**< 마지막 교차 검사 NIS */
+    float last_omega;          /**< 마지막 CI 가중치 (자기 추정 쪽) */
+} FederatedStats;
+
+/**
+ * @brief 연합 노드 상태
+ */
+typedef struct {
+    FederatedConfig config;
+
+    uint8_t tx_seq;            /**< 보낸 요약 순번 (4비트) */
+
+    uint8_t rx_buf[FEDERATED_WIRE_SIZE]; /**< 조립 중인 원격 요약 */
+    uint16_t rx_id;            /**< 조립 중인 메시지 ID */
+    uint8_t rx_seq;            /**< 조립 중인 순번 */
+    uint16_t rx_mask;          /**< 받은 조각 */
+
+    FederatedEstimate remote;  /**< 마지막 원격 요약 */
+    bool has_remote;           /**< 원격 요약 유무 */
+    uint16_t disagree_run;     /**< 연속 문턱 초과 검사 수 */
+    bool disagree;             /**< 불일치 판정 (일치 검사 한 번으로 해제) */
+
+    FederatedStats stats;
+} FederatedNode;
+
+/**
+ * @brief 기본 설정 (노드 0)
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool federated_default_config(FederatedConfig *config);
+
+/**
+ * @brief 노드 초기화
+ *
+ * @param node 노드 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool federated_init(FederatedNode *node, const FederatedConfig *config);
+
+/**
+ * @brief EKF에서 요약 만들기 (양자화 전)
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param timestamp_us 유효 시각 (us, 공유 시간축)
+ * @param est 결과 요약
+ * @return bool 성공 여부
+ */
+bool federated_estimate_from_ekf(const EKF *ekf, uint32_t timestamp_us, FederatedEstimate *est);
+
+/**
+ * @brief 요약 양자화 (대각 + 저계수 공분산 압축 포함)
+ *
+ * @param est 요약
+ * @param buf 결과 전송 형식
+ * @return bool 성공 여부 (공분산 대각이 양수가 아니면 false)
+ */
+bool federated_encode(const FederatedEstimate *est, uint8_t buf[FEDERATED_WIRE_SIZE]);
+
+/**
+ * @brief 요약 복원 (공분산은 보낸 쪽보다 작지 않게, 평균 양자화 분산 포함)
+ *
+ * @param buf 전송 형식
+ * @param est 결과 요약
+ * @return bool 성공 여부
+ */
+bool federated_decode(const uint8_t buf[FEDERATED_WIRE_SIZE], FederatedEstimate *est);
+
+/**
+ * @brief 자기 요약 프레임 만들기 (호출자가 CAN으로 보냄)
+ *
+ * @param node 노드 상태
+ * @param ekf EKF 구조체 포인터
+ * @param timestamp_us 유효 시각 (us, 공유 시간축)
+ * @param frames 결과 프레임
+ * @return uint8_t 프레임 수 (실패하면 0)
+ */
+uint8_t federated_build_frames(FederatedNode *node, const EKF *ekf, uint32_t timestamp_us,
+                               FederatedFrame frames[FEDERATED_FRAME_COUNT]);
+
+/**
+ * @brief 수신 프레임 처리 (다른 노드 요약 조각만 받음)
+ *
+ * @param node 노드 상태
+ * @param id 표준 ID
+ * @param data 데이터
+ * @param dlc 데이터 길이
+ * @return bool 원격 요약 하나를 다 받았으면 true
+ */
+bool federated_handle_frame(FederatedNode *node, uint16_t id, const uint8_t *data, uint8_t dlc);
+
+/**
+ * @brief 교차 검사 (불일치 판정 갱신)
+ *
+ * @param node 노드 상태
+ * @param ekf EKF 구조체 포인터
+ * @param now_us 현재 시각 (us, 공유 시간축)
+ * @param nis 결과 NIS (NULL 가능)
+ * @return bool 검사 성공 여부 (원격 요약이 없거나 오래되면 false)
+ */
+bool federated_cross_check(FederatedNode *node, const EKF *ekf, uint32_t now_us, float *nis);
+
+/**
+ * @brief 교차 검사 후 CI 융합 (불일치 중이면 융합하지 않음)
+ *
+ * @param node 노드 상태
+ * @param ekf EKF 구조체 포인터
+ * @param now_us 현재 시각 (us, 공유 시간축)
+ * @return bool 융합했으면 true
+ */
+bool federated_fuse(FederatedNode *node, EKF *ekf, uint32_t now_us);
+
+/**
+ * @brief 원격 노드 동작 여부 (timeout_us 안에 요약을 받았는지)
+ *
+ * @param node 노드 상태
+ * @param now_us 현재 시각 (us, 공유 시간축)
+ * @return bool 동작 여부
+ */
+bool federated_remote_alive(const FederatedNode *node, uint32_t now_us);
+
+/**
+ * @brief 불일치 판정 여부
+ *
+ * @param node 노드 상태
+ * @return bool 불일치 중이면 true
+ */
+bool federated_is_disagreeing(const FederatedNode *node);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param node 노드 상태
+ * @return const FederatedStats* 통계 (node가 NULL이면 NULL)
+ */
+const FederatedStats *federated_get_stats(const FederatedNode *node);
+
+#endif /* FEDERATED_H */
@@ -0,0 +1,194 @@
+/**
+ * @file filter_engine.h
+ * @brief 필터 엔진 함수 테이블 (같은 입력으로 엔진을 바꿔 가며 비교)
+ *
+ * ekf_predict/ekf_update_*와 eskf_*는 필터별 직접 호출이라 엔진을 비교하려면 호출부를
+ * 다시 빌드해야 했다. 엔진마다 같은 모양의 함수 테이블(FilterEngineOps: init, predict,
+ * predict_batch, update, get_solution)을 두고 FilterEngine이 고른 테이블을 거쳐 부르므로,
+ * 모든 엔진을 함께 링크한 빌드(보드 벤치마크, 재생 도구)가 실행 중에 엔진을 바꿀 수 있다.
+ *
+ * 엔진 (FilterEngineId):
+ * - FILTER_ENGINE_EKF: 압축 대칭 P, 순차 스칼라 갱신 (비행 기본 설정)
+ * - FILTER_ENGINE_EKF_BATCH: 압축 대칭 P, 측정 묶음 일괄 갱신
+ * - FILTER_ENGINE_EKF_UD: U-D 분해 (Thornton 전파, Bierman 갱신)
+ * - FILTER_ENGINE_ESKF: 15차원 오차 상태 필터 (eskf.h)
+ *
+ * 측정은 EKF_Sensor로 종류를 붙여 넘긴다 (GPS 위치, GPS 위치+속도, 기압, 자력계; 모든
+ * 엔진이 지원하는 종류). 항법 해는 EKF_NavSolution 형식으로 통일하며, ESKF의 p_diag는
+ * 같은 뜻의 상태에 옮기고 사원수 벡터부 분산은 회전 벡터 오차 분산의 1/4로 둔다
+ * (δq ≈ δθ/2, 스칼라부는 0). 빌드 기본 엔진은 FILTER_ENGINE_DEFAULT로 정한다.
+ *
+ * 함수 테이블 간접 호출은 호출마다 수 사이클이라 측정 비교에는 영향이 없지만, 비행 빌드는
+ * 지금처럼 ekf_*를 직접 부른다 (fusion_scheduler는 EKF 전용 기능을 쓴다).
+ */
+
+#ifndef FILTER_ENGINE_H
+#define FILTER_ENGINE_H
+
+#include "ekf/ekf.h"
+#include "ekf/eskf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 엔진 종류
+ */
+typedef enum {
+    FILTER_ENGINE_EKF = 0,     /**< 압축 대칭 P, 순차 스칼라 갱신 */
+    FILTER_ENGINE_EKF_BATCH,   /**< 압축 대칭 P, 일괄 갱신 */
+    FILTER_ENGINE_EKF_UD,      /**< U-D 분해 */
+    FILTER_ENGINE_ESKF,        /**< 오차 상태 필터 */
+    FILTER_ENGINE_COUNT        /**< 엔진 수 */
+} FilterEngineId;
+
+/**
+ * @brief 빌드 기본 엔진 (예: -DFILTER_ENGINE_DEFAULT=FILTER_ENGINE_ESKF)
+ */
+#ifndef FILTER_ENGINE_DEFAULT
+#define FILTER_ENGINE_DEFAULT FILTER_ENGINE_EKF
+#endif
+
+/**
+ * @brief 엔진 초기화 설정
+ *
+ * 노이즈는 엔진의 설정 함수 단위로 적용한다. pos_std가 0 이하이면 프로세스 노이즈 다섯 개,
+ * gps_pos_std가 0 이하이면 GPS 노이즈 두 개, 그 밖의 값은 각각 0 이하이면 엔진 기본값을 쓴다.
+ */
+typedef struct {
+    Vector3f pos;              /**< 초기 위치 (m) */
+    Vector3f vel;              /**< 초기 속도 (m/s) */
+    Quaternion q;              /**< 초기 자세 */
+    float pos_std;             /**< 위치 프로세스 노이즈 (m) */
+    float vel_std;             /**< 속도 프로세스 노이즈 (m/s) */
+    float att_std;             /**< 자세 프로세스 노이즈 (rad) */
+    float gyro_bias_std;       /**< 자이로 바이어스 프로세스 노이즈 (rad/s) */
+    float accel_bias_std;      /**< 가속도 바이어스 프로세스 노이즈 (m/s^2) */
+    float gps_pos_std;         /**< GPS 위치 측정 노이즈 (m) */
+    float gps_vel_std;         /**< GPS 속도 측정 노이즈 (m/s) */
+    float baro_std;            /**< 기압 고도 측정 노이즈 (m) */
+    float mag_std;             /**< 자력계 측정 노이즈 */
+} FilterEngineConfig;
+
+/**
+ * @brief 측정 하나 (종류별로 쓰는 필드만 채움)
+ */
+typedef struct {
+    EKF_Sensor sensor;         /**< GPS_POS, GPS_POS_VEL, BARO, MAG */
+    Vector3f value;            /**< GPS 위치 (m) 또는 자기장 (몸체 좌표계) */
+    Vector3f vel;              /**< GPS 속도 (m/s, GPS_POS_VEL) */
+    float scalar;              /**< 기압 고도 (m, BARO) */
+} FilterEngineMeasurement;
+
+/**
+ * @brief 엔진 상태 저장소 (엔진마다 같은 자리를 씀)
+ */
+typedef union {
+    EKF ekf;                   /**< EKF 계열 엔진 */
+    ESKF eskf;                 /**< 오차 상태 필터 */
+} FilterEngineState;
+
+/**
+ * @brief 엔진 함수 테이블
+ */
+typedef struct {
+    const char *name;          /**< 엔진 이름 (공백 없음, 벤치마크/로그 표기) */
+    bool (*init)(FilterEngineState *state, const FilterEngineConfig *config); /**< 초기화와 초기 상태 */
+    bool (*predict)(FilterEngineState *state, Vector3f gyro, Vector3f accel, float dt); /**< IMU 예측 */
+    bool (*predict_batch)(FilterEngineState *state, const EKF_ImuSample *samples, uint16_t n); /**< 묶음 예측 */
+    bool (*update)(FilterEngineState *state, const FilterEngineMeasurement *m); /**< 측정 갱신 */
+    bool (*get_solution)(const FilterEngineState *state, uint32_t timestamp_us, EKF_NavSolution *sol); /**< 항법 해 */
+} FilterEngineOps;
+
+/**
+ * @brief 실행 중 고른 엔진
+ */
+typedef struct {
+    const FilterEngineOps *ops; /**< 고른 엔진 함수 테이블 (NULL이면 미초기화) */
+    FilterEngineId id;         /**< 고른 엔진 */
+    FilterEngineState state;   /**< 엔진 상태 */
+} FilterEngine;
+
+/**
+ * @brief 기본 설정 (원점, 정지, 단위 자세, 노이즈는 엔진 기본값)
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool filter_engine_default_config(FilterEngineConfig *config);
+
+/**
+ * @brief 엔진 함수 테이블
+ *
+ * @param id 엔진 종류
+ * @return const FilterEngineOps* 함수 테이블 (범위 밖이면 NULL)
+ */
+const FilterEngineOps *filter_engine_get_ops(FilterEngineId id);
+
+/**
+ * @brief 엔진 선택과 초기화 (이전 상태는 버림)
+ *
+ * @param engine 엔진
+ * @param id 엔진 종류
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (실패하면 engine은 미초기화)
+ */
+bool filter_engine_select(FilterEngine *engine, FilterEngineId id, const FilterEngineConfig *config);
+
+/**
+ * @brief 빌드 기본 엔진(FILTER_ENGINE_DEFAULT)으로 초기화
+ *
+ * @param engine 엔진
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool filter_engine_init(FilterEngine *engine, const FilterEngineConfig *config);
+
+/**
+ * @brief IMU 예측
+ *
+ * @param engine 엔진
+ * @param gyro 각속도 (rad/s)
+ * @param accel 비력 (m/s^2)
+ * @param dt 시간 간격 (초)
+ * @return bool 성공 여부
+ */
+bool filter_engine_predict(FilterEngine *engine, Vector3f gyro, Vector3f accel, float dt);
+
+/**
+ * @brief 묶음 예측 (엔진이 묶음 경로가 없으면 샘플마다 예측)
+ *
+ * @param engine 엔진
+ * @param samples IMU 샘플 배열
+ * @param n 샘플 수
+ * @return bool 성공 여부 (dt <= 0 인 샘플이 있으면 아무것도 하지 않고 false)
+ */
+bool filter_engine_predict_batch(FilterEngine *engine, const EKF_ImuSample *samples, uint16_t n);
+
+/**
+ * @brief 측정 갱신
+ *
+ * @param engine 엔진
+ * @param m 측정
+ * @return bool 성공 여부 (지원하지 않는 종류이거나 갱신이 거부되면 false)
+ */
+bool filter_engine_update(FilterEngine *engine, const FilterEngineMeasurement *m);
+
+/**
+ * @brief 항법 해
+ *
+ * @param engine 엔진
+ * @param timestamp_us 해의 유효 시각 (us)
+ * @param sol 항법 해
+ * @return bool 성공 여부 (초기화 전이면 false)
+ */
+bool filter_engine_get_solution(const FilterEngine *engine, uint32_t timestamp_us, EKF_NavSolution *sol);
+
+/**
+ * @brief 엔진 이름
+ *
+ * @param engine 엔진
+ * @return const char* 이름 (미초기화면 "none")
+ */
+const char *filter_engine_name(const FilterEngine *engine);
+
+#endif /* FILTER_ENGINE_H */
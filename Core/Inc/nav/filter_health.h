@@ -0,0 +1,153 @@
+/**
+ * @file filter_health.h
+ * @brief EKF 수치 건전성 감시 (분할 점검, 국소 수리, 스냅숏 복구)
+ *
+ * 공분산이 양의 정부호성을 잃거나 NaN이 상태에 들어가면 지금까지의 복구는
+ * ekf_reset뿐이라 수렴한 필터를 버리고 수 초를 다시 수렴해야 한다. 감시기는 융합
+ * 사이클마다 적은 비용으로 P와 x를 나눠 점검하고, 고칠 수 있는 것은 그 자리에서 고친다.
+ *
+ * 사이클마다 (filter_health_step):
+ * - 빠른 검사: x와 P 대각의 합이 유한한지 본다 (NaN/Inf는 합으로 전파, 덧셈 2N회).
+ *   실패하면 이번 호출에서 모든 행을 점검한다.
+ * - 분할 점검: 상태 rows_per_step개 행을 차례로 점검한다 (한 바퀴 N / rows_per_step 사이클).
+ *   행 i 점검과 국소 수리:
+ *   - x_i가 유한하지 않으면 수리 불가 (복구로 넘어감)
+ *   - P_ii가 유한하지 않거나 0 이하: 리셋 분산으로 다시 키우고 행 i의 공분산을 0으로 (상관 제거)
+ *   - P_ii < min_scale x 리셋 분산: 하한으로 올림 (상관 계수는 줄기만 함)
+ *   - P_ii > max_scale x 리셋 분산: 상한으로 내리고 행을 같은 비율로 줄여 상관 계수 유지
+ *   - P_ij가 유한하지 않으면 0, |P_ij| > max_correlation sqrt(P_ii P_jj)이면 경계로 자름
+ *     (Cauchy-Schwarz 위반은 양의 정부호가 아니라는 뜻. 압축 대칭 저장이라 대칭은 항상 유지됨)
+ *   - 사원수 행에서는 |q|^2가 1에서 quat_norm_tol 넘게 벗어나면 다시 정규화
+ *   수리한 P는 ekf_set_engine으로 다시 반영하므로 U-D 엔진이면 분해가 곧 전체 양의 정부호
+ *   검사가 된다 (분해 실패도 수리 실패로 봄).
+ * - 복구: 수리 불가이거나 한 바퀴 안의 수리가 max_repairs를 넘으면 복구 콜백으로 최신
+ *   스냅숏을 되돌리고 (보통 warm_start_find + warm_start_restore, 경과 시간만큼 외삽),
+ *   콜백이 없거나 실패하면 ekf_reset으로 떨어진다 (이후 초기화는 호출자 몫).
+ *   복구 경로를 콜백으로 받으므로 이 모듈은 저장소/CRC 주변장치에 의존하지 않는다.
+ *
+ * 점검은 지연 전파 중인 공분산(lazy)을 그대로 보며, 수리할 때만 먼저 반영한다.
+ */
+
+#ifndef FILTER_HEALTH_H
+#define FILTER_HEALTH_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define FILTER_HEALTH_DEFAULT_ROWS_PER_STEP 2        /**< 사이클당 점검 행 수 */
+#define FILTER_HEALTH_DEFAULT_MIN_SCALE 1e-12f       /**< 분산 하한 (리셋 분산 대비) */
+#define FILTER_HEALTH_DEFAULT_MAX_SCALE 1e4f         /**< 분산 상한 (리셋 분산 대비) */
+#define FILTER_HEALTH_DEFAULT_MAX_CORRELATION 1.0f   /**< 상관 계수 상한 */
+#define FILTER_HEALTH_DEFAULT_QUAT_NORM_TOL 1e-3f    /**< 사원수 |q|^2 허용 편차 */
+#define FILTER_HEALTH_DEFAULT_MAX_REPAIRS 4          /**< 한 바퀴 안에서 허용하는 수리 행 수 */
+
+/**
+ * @brief 스냅숏 복구 콜백
+ *
+ * @param ekf 복구할 필터
+ * @param now_us 현재 시각 (us)
+ * @param context 사용자 문맥
+ * @return bool 복구 성공 여부 (false이면 ekf_reset)
+ */
+typedef bool (*FilterHealthRestoreFn)(EKF *ekf, uint32_t now_us, void *context);
+
+/**
+ * @brief 감시 설정
+ */
+typedef struct {
+    uint8_t rows_per_step;     /**< 사이클당 점검 행 수 (1..EKF_STATE_DIM) */
+    float min_scale;           /**< 분산 하한 (리셋 분산 대비, 0 초과) */
+    float max_scale;           /**< 분산 상한 (리셋 분산 대비, 1 이상) */
+    float max_correlation;     /**< 상관 계수 상한 (0 초과 1 이하) */
+    float quat_norm_tol;       /**< 사원수 |q|^2 허용 편차 (0 초과) */
+    uint8_t max_repairs;       /**< 한 바퀴 안에서 허용하는 수리 행 수 (넘으면 복구) */
+} FilterHealthConfig;
+
+/**
+ * @brief 점검 결과
+ */
+typedef enum {
+    FILTER_HEALTH_OK = 0,      /**< 이상 없음 */
+    FILTER_HEALTH_REPAIRED,    /**< 국소 수리 */
+    FILTER_HEALTH_RESTORED,    /**< 스냅숏으로 복구 */
+    FILTER_HEALTH_RESET        /**< ekf_reset (재초기화 필요) */
+} FilterHealthAction;
+
+/**
+ * @brief 감시 통계
+ */
+typedef struct {
+    uint32_t steps;            /**< 점검 호출 수 */
+    uint32_t sweeps;           /**< 끝난 한 바퀴 수 */
+    uint32_t sentinel_trips;   /**< 빠른 검사 실패 수 */
+    uint32_t variance_repairs; /**< 대각(분산) 수리 수 */
+    uint32_t covariance_repairs; /**< 비대각(공분산) 수리 수 */
+    uint32_t quat_repairs;     /**< 사원수 재정규화 수 */
+    uint32_t restores;         /**< 스냅숏 복구 수 */
+    uint32_t resets;           /**< ekf_reset 수 */
+    uint8_t last_row;          /**< 마지막으로 수리한 행 */
+} FilterHealthStats;
+
+/**
+ * @brief 건전성 감시기
+ */
+typedef struct {
+    EKF *ekf;                  /**< 감시할 필터 */
+    FilterHealthConfig config; /**< 설정 */
+    FilterHealthRestoreFn restore; /**< 스냅숏 복구 콜백 (NULL이면 바로 ekf_reset) */
+    void *restore_context;     /**< 복구 콜백 문맥 */
+    uint8_t cursor;            /**< 다음 점검 행 */
+    uint8_t sweep_repairs;     /**< 이번 바퀴 수리 행 수 */
+    FilterHealthStats stats;   /**< 통계 */
+} FilterHealth;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool filter_health_default_config(FilterHealthConfig *config);
+
+/**
+ * @brief 감시기 초기화
+ *
+ * @param health 감시기
+ * @param ekf 감시할 필터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool filter_health_init(FilterHealth *health, EKF *ekf, const FilterHealthConfig *config);
+
+/**
+ * @brief 스냅숏 복구 콜백 설정
+ *
+ * @param health 감시기
+ * @param restore 복구 콜백 (NULL이면 복구 없이 ekf_reset)
+ * @param context 콜백 문맥
+ * @return bool 성공 여부
+ */
+bool filter_health_set_fallback(FilterHealth *health, FilterHealthRestoreFn restore, void *context);
+
+/**
+ * @brief 점검 한 단계 (융합 사이클마다)
+ *
+ * @param health 감시기
+ * @param now_us 현재 시각 (복구 콜백에 전달)
+ * @return FilterHealthAction 이번 단계에서 한 일 (초기화 전이거나 health가 NULL이면 OK)
+ */
+FilterHealthAction filter_health_step(FilterHealth *health, uint32_t now_us);
+
+/**
+ * @brief 통계
+ *
+ * @param health 감시기
+ * @return const FilterHealthStats* 통계 (health가 NULL이면 NULL)
+ */
+const FilterHealthStats *filter_health_get_stats(const FilterHealth *health);
+
+#endif /* FILTER_HEALTH_H */
@@ -0,0 +1,184 @@
+/**
+ * @file fixed_lag.h
+ * @brief 위치/속도 블록 고정 지연 평활기 (정점, 착지 추정용)
+ *
+ * 정점 뒤 바람 추정이나 착지 위치 보고처럼 몇 초 늦어도 되지만 정확도가 더 필요한 판단에
+ * 쓴다. 보조 측정 갱신 시각마다(interval_us 간격 이상) 위치/속도 블록 x_pv, 공분산 P_pv를
+ * 슬롯으로 창에 넣고, 슬롯 상태와 현재 위치/속도 사이의 교차 공분산 C_i만 들고 다닌다.
+ * 창이 차면 가장 오래된 슬롯(가장 많이 평활된 값)이 빠진다. 지연 = window x interval_us.
+ *
+ * 갱신은 EKF 갱신 경로(순차, 일괄, U-D, 정보 형식, 지연 측정)와 무관하게 갱신 앞뒤의
+ * 위치/속도 블록만 보고 한다. 위치/속도에만 걸리는 측정이면 x+ - x- = P- H^T S^-1 v 이므로
+ *   G_i = C_i (P-)^-1,  x_i += G_i (x+ - x-),  P_i -= G_i (P- - P+) G_i^T,  C_i = G_i P+
+ * 가 슬롯 상태를 현재 측정으로 정확히 갱신한다 (같은 시각 측정 여러 개를 묶어도 같다).
+ * 자력계처럼 다른 상태를 통해 위치/속도를 바꾸는 갱신도 같은 식으로 근사한다.
+ * 갱신 사이 C_i는 운동 전이 p += v dt 로만 전파한다 (자세/바이어스 결합은 무시).
+ * 비용은 갱신 사이클마다 슬롯당 N x N 풀이 N번과 곱 몇 번(N = FIXED_LAG_DIM)으로 일정하다.
+ *
+ * 쓰기는 융합 태스크 한 곳(fusion_scheduler)에서만 한다. 발사대 단계(영속도 갱신)와
+ * 필터 재설정 때는 창을 비운다.
+ */
+
+#ifndef FIXED_LAG_H
+#define FIXED_LAG_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 평활 블록 차원 (상태 0부터: 위치가 있으면 위치+속도, 없으면 속도)
+ */
+#if EKF_CONFIG_POSITION
+#define FIXED_LAG_DIM 6
+#else
+#define FIXED_LAG_DIM 3
+#endif
+
+/**
+ * @brief 창 최대 슬롯 수 (RAM에 맞게 빌드에서 줄일 수 있음)
+ *
+ * 슬롯당 (2 N^2 + 2 N + 1) x 4 바이트 (N = 6이면 340 바이트)를 차지한다.
+ */
+#ifndef FIXED_LAG_MAX_WINDOW
+#define FIXED_LAG_MAX_WINDOW 16
+#endif
+
+/**
+ * @brief 기본 설정
+ */
+#define FIXED_LAG_DEFAULT_WINDOW 16u          /**< 슬롯 수 */
+#define FIXED_LAG_DEFAULT_INTERVAL_US 250000u /**< 슬롯 최소 간격 (us, 기본 지연 4 s) */
+
+/**
+ * @brief 평활기 설정
+ */
+typedef struct {
+    uint8_t window;            /**< 슬롯 수 (1 ~ FIXED_LAG_MAX_WINDOW) */
+    uint32_t interval_us;      /**< 새 슬롯 최소 간격 (us, 0이면 갱신 사이클마다) */
+} FixedLagConfig;
+
+/**
+ * @brief 창 슬롯
+ */
+typedef struct {
+    uint32_t t_us;                          /**< 슬롯 시각 (us) */
+    float x[FIXED_LAG_DIM];                 /**< 평활 상태 */
+    float P[FIXED_LAG_DIM][FIXED_LAG_DIM];  /**< 평활 공분산 */
+    float C[FIXED_LAG_DIM][FIXED_LAG_DIM];  /**< 현재 위치/속도와의 교차 공분산 */
+    float filter_var[FIXED_LAG_DIM];        /**< 슬롯을 넣을 때의 필터 분산 */
+} FixedLagSlot;
+
+/**
+ * @brief 평활 추정
+ */
+typedef struct {
+    uint32_t t_us;             /**< 추정 시각 (us) */
+    uint32_t lag_us;           /**< 추정 시각 뒤로 반영된 측정 구간 (us) */
+    float x[FIXED_LAG_DIM];    /**< 평활 상태 (위치, 속도) */
+    float std[FIXED_LAG_DIM];  /**< 평활 표준 편차 */
+    float filter_std[FIXED_LAG_DIM]; /**< 슬롯을 넣을 때의 필터 표준 편차 */
+} FixedLagEstimate;
+
+/**
+ * @brief 평활기 통계
+ */
+typedef struct {
+    uint32_t updates;          /**< 반영한 갱신 사이클 수 */
+    uint32_t slots;            /**< 넣은 슬롯 수 */
+    uint32_t retired;          /**< 창에서 빠진 (평활이 끝난) 슬롯 수 */
+    uint32_t resets;           /**< 창을 비운 횟수 */
+    uint32_t failures;         /**< P-가 양정치가 아니어서 창을 비운 횟수 */
+} FixedLagStats;
+
+/**
+ * @brief 고정 지연 평활기
+ */
+typedef struct {
+    FixedLagConfig config;     /**< 설정 */
+    FixedLagSlot slot[FIXED_LAG_MAX_WINDOW]; /**< 슬롯 링 */
+    uint8_t head;              /**< 가장 오래된 슬롯 위치 */
+    uint8_t count;             /**< 슬롯 수 */
+    uint32_t t_us;             /**< C_i가 맞춰진 시각 (마지막 갱신, us) */
+    uint32_t last_slot_us;     /**< 마지막으로 슬롯을 넣은 시각 (us) */
+    float x_prior[FIXED_LAG_DIM];               /**< 갱신 전 위치/속도 */
+    float P_prior[FIXED_LAG_DIM][FIXED_LAG_DIM]; /**< 갱신 전 공분산 */
+    bool pending;              /**< fixed_lag_begin 뒤 fixed_lag_end 대기 */
+    FixedLagStats stats;       /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} FixedLagSmoother;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool fixed_lag_default_config(FixedLagConfig *config);
+
+/**
+ * @brief 평활기 초기화
+ *
+ * @param lag 평활기
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (window가 0이거나 FIXED_LAG_MAX_WINDOW보다 크면 false)
+ */
+bool fixed_lag_init(FixedLagSmoother *lag, const FixedLagConfig *config);
+
+/**
+ * @brief 창 비우기 (발사대 단계, 필터 재설정)
+ *
+ * @param lag 평활기
+ * @return bool 성공 여부
+ */
+bool fixed_lag_reset(FixedLagSmoother *lag);
+
+/**
+ * @brief 보조 측정 갱신 직전 (갱신 전 위치/속도 기록, 교차 공분산을 t_us로 전파)
+ *
+ * @param lag 평활기
+ * @param ekf 필터
+ * @param t_us 필터 시각 (마지막 예측 시각, us)
+ * @return bool 성공 여부
+ */
+bool fixed_lag_begin(FixedLagSmoother *lag, const EKF *ekf, uint32_t t_us);
+
+/**
+ * @brief 보조 측정 갱신 직후 (슬롯 갱신, 간격이 되었으면 새 슬롯)
+ *
+ * 필터 위치/속도 공분산이 바뀌지 않았으면(모두 거부) 슬롯은 그대로 둔다.
+ *
+ * @param lag 평활기
+ * @param ekf 필터
+ * @return bool 성공 여부 (fixed_lag_begin 없이 부르면 false)
+ */
+bool fixed_lag_end(FixedLagSmoother *lag, const EKF *ekf);
+
+/**
+ * @brief 주어진 시각에 가장 가까운 슬롯의 평활 추정
+ *
+ * @param lag 평활기
+ * @param t_us 찾을 시각 (us)
+ * @param est 평활 추정
+ * @return bool 성공 여부 (창이 비었거나 t_us가 창보다 이전이면 false)
+ */
+bool fixed_lag_get(const FixedLagSmoother *lag, uint32_t t_us, FixedLagEstimate *est);
+
+/**
+ * @brief 가장 오래된 (가장 많이 평활된) 슬롯의 평활 추정
+ *
+ * @param lag 평활기
+ * @param est 평활 추정
+ * @return bool 성공 여부 (창이 비었으면 false)
+ */
+bool fixed_lag_get_oldest(const FixedLagSmoother *lag, FixedLagEstimate *est);
+
+/**
+ * @brief 통계
+ *
+ * @param lag 평활기
+ * @return const FixedLagStats* 통계 (lag이 NULL이면 NULL)
+ */
+const FixedLagStats *fixed_lag_get_stats(const FixedLagSmoother *lag);
+
+#endif /* FIXED_LAG_H */
@@ -0,0 +1,161 @@
+/**
+ * @file flight_phase.h
+ * @brief 비행 단계 상태 기계 (발사대 대기, 추진, 관성 비행, 하강)
+ *
+ * 단계 전이는 다음 조건으로 판정한다.
+ * - 발사대 -> 추진: IMU 비력 크기가 발사 임계값 이상으로 유지 시간 동안 지속
+ *   (원시 IMU 샘플마다 판정하므로 필터 지연과 무관)
+ * - 추진 -> 관성 비행: 비력 크기가 연소 종료 임계값 미만으로 유지 시간 동안 지속
+ * - 관성 비행 -> 하강: 항법 해의 수직 속도가 -정점 임계값 이하
+ *   (z는 기압계 고도와 같이 위쪽이 양수)
+ *
+ * 발사대 단계에서는 기체가 정지해 있으므로 융합 스케줄러가 자세 전용 예측을
+ * 낮은 주기로 수행하여 CPU 사용량과 소비 전력을 줄인다. 발사 조건이 처음 충족된
+ * 시각(launch_us)은 전달되므로, 확정 전 샘플을 전체 예측으로 다시 처리할 수 있다.
+ *
+ * 외부 검출기(nav/event_detector.h)의 비행 이벤트로 직접 전이할 수도 있다
+ * (flight_phase_apply_event). 이 경우 이벤트의 시작 시각이 launch_us 등에 기록된다.
+ *
+ * 단계는 되돌아가지 않는다 (재사용 시 flight_phase_init).
+ */
+
+#ifndef FLIGHT_PHASE_H
+#define FLIGHT_PHASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/vector3f.h"
+
+/**
+ * @brief 기본 전이 조건
+ */
+#define FLIGHT_PHASE_DEFAULT_LAUNCH_ACCEL 29.4f     /**< 발사 비력 임계값 (m/s^2, 3 g) */
+#define FLIGHT_PHASE_DEFAULT_LAUNCH_HOLD_US 50000u  /**< 발사 조건 유지 시간 (us) */
+#define FLIGHT_PHASE_DEFAULT_BURNOUT_ACCEL 11.8f    /**< 연소 종료 비력 임계값 (m/s^2, 1.2 g) */
+#define FLIGHT_PHASE_DEFAULT_BURNOUT_HOLD_US 100000u /**< 연소 종료 조건 유지 시간 (us) */
+#define FLIGHT_PHASE_DEFAULT_APOGEE_DESCENT 1.0f    /**< 정점 판정 하강 속도 (m/s, 양수) */
+#define FLIGHT_PHASE_DEFAULT_PAD_DECIMATION 10u     /**< 발사대 단계 예측 주기 분주비 */
+
+/**
+ * @brief 비행 단계
+ */
+typedef enum {
+    FLIGHT_PHASE_PAD = 0,     /**< 발사대 대기 (정지, 감소된 주기) */
+    FLIGHT_PHASE_BOOST = 1,   /**< 추진 (전체 주기) */
+    FLIGHT_PHASE_COAST = 2,   /**< 관성 비행 (전체 주기) */
+    FLIGHT_PHASE_DESCENT = 3  /**< 하강 (전체 주기) */
+} FlightPhase;
+
+/**
+ * @brief 비행 이벤트 종류
+ */
+typedef enum {
+    FLIGHT_EVENT_LAUNCH = 0,   /**< 발사 */
+    FLIGHT_EVENT_BURNOUT = 1,  /**< 연소 종료 */
+    FLIGHT_EVENT_APOGEE = 2,   /**< 정점 */
+    FLIGHT_EVENT_COUNT = 3     /**< 이벤트 종류 수 */
+} FlightEventType;
+
+/**
+ * @brief 타임스탬프가 붙은 비행 이벤트
+ */
+typedef struct {
+    FlightEventType type;  /**< 이벤트 종류 */
+    uint32_t timestamp_us; /**< 검출 시각 (판정에 사용한 마지막 샘플 시각, us) */
+    uint32_t onset_us;     /**< 추정 발생 시각 (us, 검출 시각 이전) */
+} FlightEvent;
+
+/**
+ * @brief 전이 조건 설정
+ */
+typedef struct {
+    float launch_accel;        /**< 발사 비력 임계값 (m/s^2) */
+    uint32_t launch_hold_us;   /**< 발사 조건 유지 시간 (us) */
+    float burnout_accel;       /**< 연소 종료 비력 임계값 (m/s^2) */
+    uint32_t burnout_hold_us;  /**< 연소 종료 조건 유지 시간 (us) */
+    float apogee_descent;      /**< 정점 판정 하강 속도 (m/s) */
+    uint16_t pad_decimation;   /**< 발사대 단계 예측 주기 분주비 (1이면 감소 없음) */
+} FlightPhaseConfig;
+
+/**
+ * @brief 비행 단계 상태 기계
+ */
+typedef struct {
+    FlightPhaseConfig config;  /**< 전이 조건 */
+    FlightPhase phase;         /**< 현재 단계 */
+    uint32_t phase_start_us;   /**< 현재 단계 진입 시각 (us) */
+
+    bool pending;              /**< 전이 조건 충족 중 (유지 시간 대기) */
+    uint32_t pending_start_us; /**< 전이 조건이 처음 충족된 시각 (us) */
+
+    uint32_t launch_us;        /**< 발사 시각 (발사 조건이 처음 충족된 시각, us) */
+    uint32_t burnout_us;       /**< 연소 종료 시각 (us) */
+    uint32_t apogee_us;        /**< 정점 시각 (us) */
+} FlightPhaseMachine;
+
+/**
+ * @brief 기본 전이 조건
+ *
+ * @param config 전이 조건
+ * @return bool 성공 여부
+ */
+bool flight_phase_default_config(FlightPhaseConfig *config);
+
+/**
+ * @brief 상태 기계 초기화 (발사대 단계에서 시작)
+ *
+ * @param fp 상태 기계
+ * @param config 전이 조건 (NULL이면 기본값)
+ * @return bool 성공 여부 (pad_decimation이 0이면 false)
+ */
+bool flight_phase_init(FlightPhaseMachine *fp, const FlightPhaseConfig *config);
+
+/**
+ * @brief 원시 IMU 샘플로 발사/연소 종료 판정
+ *
+ * @param fp 상태 기계
+ * @param timestamp_us 샘플 시각 (us)
+ * @param accel 가속도계 측정값 (m/s^2, 비력)
+ * @return bool 이번 샘플에서 단계가 바뀌었으면 true
+ */
+bool flight_phase_update_imu(FlightPhaseMachine *fp, uint32_t timestamp_us, Vector3f accel);
+
+/**
+ * @brief 항법 해로 정점 판정
+ *
+ * @param fp 상태 기계
+ * @param timestamp_us 항법 해 시각 (us)
+ * @param vel_up 수직 속도 (z, 위쪽 양수, m/s)
+ * @return bool 이번 호출에서 단계가 바뀌었으면 true
+ */
+bool flight_phase_update_nav(FlightPhaseMachine *fp, uint32_t timestamp_us, float vel_up);
+
+/**
+ * @brief 외부 검출 이벤트로 전이
+ *
+ * 발사는 발사대 단계에서, 연소 종료는 추진 단계에서, 정점은 추진/관성 비행 단계에서만
+ * 반영한다. 이미 지난 단계의 이벤트는 무시한다.
+ *
+ * @param fp 상태 기계
+ * @param event 비행 이벤트
+ * @return bool 이번 호출에서 단계가 바뀌었으면 true
+ */
+bool flight_phase_apply_event(FlightPhaseMachine *fp, const FlightEvent *event);
+
+/**
+ * @brief 현재 단계 조회
+ *
+ * @param fp 상태 기계
+ * @return FlightPhase 현재 단계 (fp가 NULL이면 FLIGHT_PHASE_PAD)
+ */
+FlightPhase flight_phase_get(const FlightPhaseMachine *fp);
+
+/**
+ * @brief 발사 조건 충족 중 여부 (발사대 단계에서 유지 시간 대기 중)
+ *
+ * @param fp 상태 기계
+ * @return bool 대기 중이면 true
+ */
+bool flight_phase_launch_pending(const FlightPhaseMachine *fp);
+
+#endif /* FLIGHT_PHASE_H */
@@ -0,0 +1,152 @@
+/**
+ * @file fusion_monitor.h
+ * @brief 융합 루프 CPU 부하와 IMU 샘플 처리 지연(마감 초과) 감시
+ *
+ * 융합 스케줄러에 붙여 사이클마다 처리 시간(busy)을 그 사이클이 처리한 IMU 샘플 수 x
+ * IMU 주기와 비교해 부하율을 구하고, IMU 샘플마다 샘플 시각부터 예측을 마칠 때까지의
+ * 지연을 로그 눈금 히스토그램에 누적한다. 지연이 마감을 넘은 샘플은 비행 단계별로 센다.
+ * 새 갱신(자력계, 영속도 등)을 켰을 때 L4에서 남은 여유를 확인하는 용도이다.
+ *
+ * 지연 히스토그램 칸 k의 범위:
+ * - k = 0: [0, FUSION_MONITOR_LATE_BASE_US)
+ * - 0 < k < 마지막: [BASE x 2^(k-1), BASE x 2^k)
+ * - 마지막 칸: BASE x 2^(FUSION_MONITOR_LATE_BINS - 2) 이상
+ *
+ * 지연은 IMU 샘플 시각과 스케줄러 시간 콜백이 같은 시간축(us)이어야 의미가 있다.
+ * 발사 확정 대기로 보류된 샘플은 링에서 꺼낸 시점까지의 지연으로 센다.
+ *
+ * 쓰기는 융합 태스크 한 곳에서만 하며, 다른 태스크(텔레메트리)는 32비트 필드를 잠금 없이
+ * 읽는다. 필드 사이의 일관성은 보장하지 않는다 (한 사이클 정도 어긋날 수 있음).
+ */
+
+#ifndef FUSION_MONITOR_H
+#define FUSION_MONITOR_H
+
+#include "nav/flight_phase.h"
+#include "sys/profile.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 비행 단계 수 (FlightPhase 마지막 값 + 1)
+ */
+#define FUSION_MONITOR_PHASE_COUNT (FLIGHT_PHASE_DESCENT + 1)
+
+/**
+ * @brief 지연 히스토그램 칸 수와 첫 칸 경계 (us, 64 us ~ 16.4 ms 이상)
+ */
+#define FUSION_MONITOR_LATE_BINS 10u
+#define FUSION_MONITOR_LATE_BASE_US 64u
+
+/**
+ * @brief 기본 마감 (IMU 주기 배수, 다음 샘플 다음까지 처리)
+ */
+#define FUSION_MONITOR_DEFAULT_DEADLINE_PERIODS 2u
+
+/**
+ * @brief 비행 단계별 통계
+ */
+typedef struct {
+    uint32_t cycles;           /**< IMU 샘플을 처리한 사이클 수 */
+    uint32_t samples;          /**< 처리한 IMU 샘플 수 */
+    uint32_t misses;           /**< 마감을 넘긴 샘플 수 */
+    uint32_t overloads;        /**< 부하율이 100%를 넘은 사이클 수 */
+    uint64_t busy_us;          /**< 누적 처리 시간 (us) */
+    uint32_t max_busy_us;      /**< 최대 사이클 처리 시간 (us) */
+    uint32_t max_late_us;      /**< 최대 샘플 지연 (us) */
+    uint16_t peak_load;        /**< 최대 사이클 부하율 (0.1% 단위) */
+    uint32_t late_hist[FUSION_MONITOR_LATE_BINS]; /**< 샘플 지연 히스토그램 */
+} FusionMonitorPhaseStats;
+
+/**
+ * @brief 융합 루프 감시기
+ */
+typedef struct {
+    uint32_t imu_period_us;    /**< IMU 주기 (us) */
+    uint32_t deadline_us;      /**< 샘플 처리 마감 (샘플 시각 기준, us) */
+    FlightPhase phase;         /**< 마지막으로 기록한 비행 단계 */
+    uint16_t last_load;        /**< 마지막 사이클 부하율 (0.1% 단위) */
+    FusionMonitorPhaseStats stats[FUSION_MONITOR_PHASE_COUNT];
+} FusionMonitor;
+
+/**
+ * @brief 감시기 초기화
+ *
+ * @param mon 감시기
+ * @param imu_period_us IMU 주기 (us, ODR의 역수)
+ * @param deadline_us 샘플 처리 마감 (us, 0이면 IMU 주기 x FUSION_MONITOR_DEFAULT_DEADLINE_PERIODS)
+ * @return bool 성공 여부
+ */
+bool fusion_monitor_init(FusionMonitor *mon, uint32_t imu_period_us, uint32_t deadline_us);
+
+/**
+ * @brief 통계 초기화 (주기와 마감은 유지)
+ *
+ * @param mon 감시기
+ */
+void fusion_monitor_reset(FusionMonitor *mon);
+
+/**
+ * @brief IMU 샘플 하나의 처리 지연 기록
+ *
+ * @param mon 감시기
+ * @param phase 처리 시점의 비행 단계
+ * @param late_us 샘플 시각부터 처리 완료까지 (us)
+ */
+void fusion_monitor_record_sample(FusionMonitor *mon, FlightPhase phase, uint32_t late_us);
+
+/**
+ * @brief 사이클 처리 시간 기록 (IMU 샘플이 없었던 사이클은 무시)
+ *
+ * @param mon 감시기
+ * @param phase 사이클 끝의 비행 단계
+ * @param busy_us 사이클 처리 시간 (us)
+ * @param samples 이번 사이클에 처리한 IMU 샘플 수
+ */
+void fusion_monitor_record_cycle(FusionMonitor *mon, FlightPhase phase, uint32_t busy_us, uint32_t samples);
+
+/**
+ * @brief 단계별 통계 조회
+ *
+ * @param mon 감시기
+ * @param phase 비행 단계
+ * @return const FusionMonitorPhaseStats* 통계 (범위 밖이면 NULL)
+ */
+const FusionMonitorPhaseStats *fusion_monitor_get_stats(const FusionMonitor *mon, FlightPhase phase);
+
+/**
+ * @brief 단계 평균 부하율 (누적 처리 시간 / 처리 샘플 수 x IMU 주기)
+ *
+ * @param mon 감시기
+ * @param phase 비행 단계
+ * @return uint16_t 평균 부하율 (0.1% 단위, 샘플이 없으면 0)
+ */
+uint16_t fusion_monitor_mean_load(const FusionMonitor *mon, FlightPhase phase);
+
+/**
+ * @brief 지연 분위수가 속한 히스토그램 칸
+ *
+ * @param mon 감시기
+ * @param phase 비행 단계
+ * @param permille 분위 (0.1% 단위, 예: 990 = 99%)
+ * @return uint8_t 칸 번호 (샘플이 없으면 0)
+ */
+uint8_t fusion_monitor_late_quantile_bin(const FusionMonitor *mon, FlightPhase phase, uint16_t permille);
+
+/**
+ * @brief 히스토그램 칸의 상한 (us, 마지막 칸은 UINT32_MAX)
+ *
+ * @param bin 칸 번호
+ * @return uint32_t 상한 (us, 미포함)
+ */
+uint32_t fusion_monitor_bin_upper_us(uint8_t bin);
+
+/**
+ * @brief 단계별 부하/지연 통계를 한 줄씩 출력
+ *
+ * @param mon 감시기
+ * @param write 출력 콜백
+ */
+void fusion_monitor_report(const FusionMonitor *mon, ProfileWriteFn write);
+
+#endif /* FUSION_MONITOR_H */
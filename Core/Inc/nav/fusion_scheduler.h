@@ -0,0 +1,677 @@
+/**
+ * @file fusion_scheduler.h
+ * @brief 이벤트 기반 다중 속도 센서 융합 스케줄러 (IMU, 기압계, 자력계, GNSS)
+ *
+ * IMU 샘플은 ImuRing에서, 보조 측정(기압계/자력계/GNSS)은 시각 순으로 정렬된
+ * 대기열에서 꺼내 시간 순서대로 처리한다.
+ * - 필터 시각(마지막 예측 시각)에 도달한 측정은 그 시각의 상태에 갱신한다.
+ *   늦게 도착한 측정은 EKF_DelayBuffer를 통해 측정 시각에 융합된다.
+ * - 측정 종류마다 처리 비용 추정(사이클 시간 측정의 지수 평균)과 우선순위가 있다.
+ *   갱신 하나를 하기 전에 남은 예산이 그 비용 + 남은 IMU 샘플 예측 비용 + 뒤에 도달한
+ *   더 높은 우선순위 측정 비용보다 작으면 그 갱신을 다음 사이클로 미루고, max_age_us보다
+ *   오래된 측정은 버린다. IMU 예측은 미루지 않으며, FUSION_PRIORITY_ALWAYS 종류(기본: GNSS)도
+ *   예산과 무관하게 처리한다 (fusion_scheduler_set_update_policy).
+ *
+ * - 게시 버퍼가 설정되어 있으면 사이클 끝에 항법 해를 게시한다.
+ * - 자력계 보정 추정기가 설정되어 있으면 원시 자력계 측정을 받아 추정기에 누적하고,
+ *   현재 보정값을 적용해 정규화한 뒤 대기열에 넣는다. 해 추출은 사이클마다
+ *   예산이 남을 때 한 단계씩 진행한다.
+ * - 비행 단계 상태 기계가 설정되어 있으면 원시 IMU 샘플마다 발사를 판정한다.
+ *   발사대 단계에서는 IMU 샘플 pad_decimation개의 평균 자이로로 자세 전용 예측을
+ *   수행하고, 보조 측정은 상태 이력 없이 현재 상태에 바로 갱신한다 (정지 상태).
+ *   발사 조건이 충족되면 확정될 때까지 샘플을 보류했다가, 확정 시 전체 예측으로
+ *   처리하므로 추진 초기 구간이 손실되지 않는다. 정점은 게시 시점의 항법 해로 판정한다.
+ * - 발사대 단계에서 정지 판정기가 설정되어 있으면 자세 전용 예측 대신 평균 IMU로
+ *   감소 주기 전체 예측을 수행하고, 정지 판정 중이면 매번 영속도 갱신(ZUPT)을,
+ *   판정 창이 끝날 때마다 창 평균 자이로로 영각속도 갱신(ZARU)을 융합한다.
+ *   속도 공분산이 수렴하고 자이로 바이어스가 발사 전에 보정된다.
+ * - 비행 이벤트 검출기가 설정되어 있으면 발사/연소 종료/정점은 입력 단계(ImuRing 탭,
+ *   기압계 입력)에서 검출된 이벤트로 전이한다. 이 경우 발사 보류가 없으므로 판정 창
+ *   구간(약 16 ms)의 샘플은 발사대 단계 방식으로 처리된다.
+ * - 관성 비행 단계에서는 IMU 샘플마다 항력 계수를 추정하며(ekf_estimate_drag),
+ *   게시되는 항법 해에 정점 예측이 포함된다.
+ * - 고중력 가속도계 혼합기가 설정되어 있으면 IMU 샘플마다 주 가속도계 포화 구간을
+ *   고중력 샘플로 혼합한 가속도를 예측/단계 판정/정지 판정에 쓰고, 혼합/포화 중에는
+ *   추가 가속도 분산만큼 속도 프로세스 노이즈를 키운다 (ekf_set_velocity_noise_inflation).
+ * - 진동 통계가 설정되어 있으면 사이클마다 입력 단계의 마지막 창에서 가속도 진동 분산
+ *   초과분(imu_vibration_accel_var)을 읽어 혼합기 분산에 더해 속도 프로세스 노이즈를 키운다.
+ * - 자이로 스펙트럼 분석기가 설정되어 있으면 사이클마다 예산이 남을 때 분석을 한 단계씩
+ *   진행한다 (동적 노치 재조정, gyro_spectrum.h).
+ * - 장착 위치 보정이 설정되어 있으면 예측한 사이클마다 EKF 자이로 바이어스를 게시한다
+ *   (보정 자체는 IMU 드라이버가 버스트 단위로 수행, imu_lever_arm.h).
+ * - 수직 채널 필터가 설정되어 있으면 IMU 샘플마다 EKF 자세로 예측하고 기압 측정은
+ *   필터 시각에 도달할 때마다 모두 반영한다 (EKF 갱신 성공 여부와 무관). 준비된 뒤에는
+ *   정점 판정에 EKF 속도 대신 이 필터의 수직 속도를 쓴다 (vertical_filter.h).
+ * - 필터 시각에 함께 도달한 GNSS와 기압계 측정의 시각 차가 FUSION_COALESCE_WINDOW_US
+ *   이하이고 EKF가 묶음 갱신을 지원하면(ekf_can_coalesce) 공분산 한 번 갱신으로 함께
+ *   융합한다. 비행 중에는 상태 이력 되감기/재적분도 한 번만 수행한다.
+ * - 정보 형식 묶음 갱신이 활성화되어 있으면 발사대 단계에서 함께 도달한 보조 측정을
+ *   누적해 공분산을 한 번만 갱신한다 (ekf_info_begin, 이때 GNSS/기압계 묶음 갱신은 쓰지 않음).
+ * - 비행 단계가 바뀌면 EKF 정상 상태 게인 기록을 지워 전체 계산으로 돌아간다
+ *   (ekf_set_steady_gain으로 활성화한 경우).
+ * - 건전성 감시기가 설정되어 있으면 예측한 사이클마다 P와 x를 몇 행씩 점검하고 국소 수리하며,
+ *   수리할 수 없으면 스냅숏 복구나 ekf_reset으로 넘어간다 (filter_health.h).
+ * - 수렴 감시기가 설정되어 있으면 게시한 사이클마다 P 대각으로 블록별 수렴과 준비 시각을
+ *   기록한다 (convergence_monitor.h).
+ * - 센서 인터럽트가 여럿이면 MPSC 측정 대기열(meas_queue.h) 하나로 받아
+ *   fusion_scheduler_drain_queue로 도착 순서대로 IMU 링과 보조 측정 대기열에 옮긴 뒤 실행한다.
+ * - 적응 예측 주기 제어기가 설정되어 있으면 비행 중 IMU 샘플은 사전 적분기에 모두 누적하고
+ *   공분산 전파는 각속도/저크/최근 NIS에 따라 1..max_samples 샘플마다 수행한다. 필터 시각에
+ *   도달한 보조 측정이 있으면 누적분을 먼저 예측하고, 갱신한 NIS는 제어기에 알린다
+ *   (predict_rate.h). 이때 게시되는 항법 해는 마지막 전파 시각의 상태다.
+ * - 부하 감시기가 설정되어 있으면 IMU 샘플마다 처리 지연을, 사이클마다 처리 시간을
+ *   현재 비행 단계(상태 기계가 없으면 발사대 단계)로 기록한다.
+ * - 지연 감시기가 설정되어 있으면 IMU 샘플을 예측에, 보조 측정을 갱신에 넘기기 직전에
+ *   측정 시각부터의 지연을 센서별로 기록한다 (latency_monitor.h).
+ * - 고정 지연 평활기가 설정되어 있으면 비행 중 보조 측정을 갱신한 사이클마다 갱신 앞뒤의
+ *   위치/속도 블록으로 창을 갱신한다. 발사대 단계와 건전성 감시기의 재설정 때는 창을 비운다
+ *   (fixed_lag.h).
+ *
+ * - 따라잡기 문턱이 설정되어 있으면(fusion_scheduler_set_catch_up) 사이클 시작 때 IMU 링에
+ *   문턱보다 많은 샘플이 쌓여 있을 경우(로그 기록/플래시 지우기로 태스크가 늦어진 경우) 비행 중
+ *   샘플을 사전 적분기에 누적해 FUSION_CATCH_UP_MAX_SAMPLES개마다 한 번만 예측한다. 필터 시각에
+ *   도달한 보조 측정이 있으면 누적분을 먼저 예측하므로 측정은 시각 순서대로 반영되고, 사이클 끝에
+ *   남은 누적분도 예측해 한 사이클 안에 실시간으로 돌아온다. 적응 예측 주기 제어기가 설정되어
+ *   있으면 이미 누적 예측 중이므로 따라잡기는 쓰지 않는다.
+ *
+ * 모든 함수는 융합 태스크 한 곳에서만 호출해야 한다 (대기열은 잠금 없음).
+ */
+
+#ifndef FUSION_SCHEDULER_H
+#define FUSION_SCHEDULER_H
+
+#include "ekf/ekf.h"
+#include "ekf/ekf_delay.h"
+#include "ekf/ekf_preintegration.h"
+#include "nav/convergence_monitor.h"
+#include "nav/event_detector.h"
+#include "nav/filter_health.h"
+#include "nav/fixed_lag.h"
+#include "nav/flight_phase.h"
+#include "nav/fusion_monitor.h"
+#include "nav/latency_monitor.h"
+#include "nav/nav_publisher.h"
+#include "nav/predict_rate.h"
+#include "nav/vertical_filter.h"
+#include "sensors/accel_blend.h"
+#include "sensors/baro_altitude.h"
+#include "sensors/gyro_spectrum.h"
+#include "sensors/imu_lever_arm.h"
+#include "sensors/imu_ring.h"
+#include "sensors/imu_vibration.h"
+#include "sensors/mag_average.h"
+#include "sensors/mag_iron_cal.h"
+#include "sensors/meas_queue.h"
+#include "sensors/static_detector.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 보조 측정 대기열 크기
+ */
+#define FUSION_QUEUE_SIZE 16
+
+/**
+ * @brief 지연된 자력계 측정의 최대 보관 시간 (us)
+ */
+#define FUSION_MAG_MAX_AGE_US 50000u
+
+/**
+ * @brief 지연된 이중 안테나 GNSS 방위 측정의 최대 보관 시간 (us, RTK 해 지연 포함)
+ */
+#define FUSION_HEADING_MAX_AGE_US 200000u
+
+/**
+ * @brief GNSS/기압계 측정을 한 번의 갱신으로 묶는 최대 시각 차 (us)
+ *
+ * 같은 사이클에 도달한 두 측정의 시각 차가 이 값 이하이면 앞선 측정 시각에
+ * 함께 융합한다 (ekf_update_coincident). 기압계 표본 주기보다 충분히 작아야 한다.
+ */
+#define FUSION_COALESCE_WINDOW_US 2000u
+
+/**
+ * @brief IMU 샘플 간격 허용 최대값 (초, 초과 시 예측 생략)
+ */
+#define FUSION_IMU_MAX_DT 0.1f
+
+/**
+ * @brief 발사 확정 대기 중 보류할 수 있는 최대 IMU 샘플 수
+ *
+ * 발사 조건 유지 시간 x IMU 주기 이상이어야 한다 (예: 50 ms x 1 kHz = 50).
+ * 넘치는 샘플은 자세 전용 예측으로 처리된다.
+ */
+#define FUSION_LAUNCH_PENDING_SIZE 64
+
+/**
+ * @brief 영각속도 갱신 측정 분산 하한 ((rad/s)^2)
+ *
+ * 창 평균의 분산은 창 길이에 반비례해 매우 작아지므로, 잔여 진동과 온도 변화에 의한
+ * 바이어스 변동(약 1e-3 rad/s)보다 과신하지 않도록 제한한다.
+ */
+#define FUSION_ZARU_MIN_VAR 1.0e-6f
+
+/**
+ * @brief 따라잡기 중 한 번의 예측으로 묶는 최대 IMU 샘플 수
+ *
+ * 묶음 구간이 길수록 공분산 전파의 선형화 오차가 커진다 (예: 1 kHz에서 20 ms).
+ */
+#define FUSION_CATCH_UP_MAX_SAMPLES 20u
+
+/**
+ * @brief 보조 측정 종류
+ */
+typedef enum {
+    FUSION_MEAS_GPS = 0,   /**< GNSS 위치/속도 */
+    FUSION_MEAS_BARO = 1,  /**< 기압계 고도 */
+    FUSION_MEAS_MAG = 2,   /**< 자력계 (낮은 우선순위, 지연 가능) */
+    FUSION_MEAS_HEADING = 3, /**< 이중 안테나 GNSS 기선 방위 (스칼라, 지연 가능) */
+    FUSION_MEAS_TYPE_COUNT /**< 종류 수 */
+} FusionMeasType;
+
+/**
+ * @brief 예산과 무관하게 항상 처리하는 우선순위
+ */
+#define FUSION_PRIORITY_ALWAYS 255u
+
+/**
+ * @brief 기본 갱신 정책 (우선순위가 높을수록 나중에 미뤄짐)
+ */
+#define FUSION_DEFAULT_GPS_PRIORITY FUSION_PRIORITY_ALWAYS /**< GNSS (되감기 비용이 커도 항상 처리) */
+#define FUSION_DEFAULT_BARO_PRIORITY 1u                   /**< 기압계 */
+#define FUSION_DEFAULT_MAG_PRIORITY 0u                    /**< 자력계 */
+#define FUSION_DEFAULT_HEADING_PRIORITY 1u                /**< 이중 안테나 GNSS 방위 (자력계보다 나중에 미룸) */
+#define FUSION_DEFAULT_BARO_MAX_AGE_US 50000u             /**< 기압계 최대 보관 시간 (us) */
+
+/**
+ * @brief 비용 추정 초기값 (us, 첫 측정부터 학습됨)
+ */
+#define FUSION_DEFAULT_GPS_COST_US 300.0f     /**< GNSS 갱신 (지연 되감기 포함) */
+#define FUSION_DEFAULT_BARO_COST_US 100.0f    /**< 기압계 갱신 */
+#define FUSION_DEFAULT_MAG_COST_US 150.0f     /**< 자력계 갱신 */
+#define FUSION_DEFAULT_HEADING_COST_US 80.0f  /**< GNSS 방위 갱신 (스칼라 한두 번) */
+#define FUSION_DEFAULT_PREDICT_COST_US 100.0f /**< IMU 샘플 하나 예측 */
+
+/**
+ * @brief 비용 추정 지수 평균 계수
+ */
+#define FUSION_COST_ALPHA 0.125f
+
+/**
+ * @brief 측정 종류별 갱신 정책과 비용 추정
+ */
+typedef struct {
+    uint8_t priority;      /**< 우선순위 (FUSION_PRIORITY_ALWAYS이면 미루지 않음) */
+    uint32_t max_age_us;   /**< 미룬 측정의 최대 보관 시간 (us, 0이면 제한 없음) */
+    float cost_us;         /**< 갱신 한 번의 처리 시간 추정 (us) */
+    uint32_t deferred;     /**< 사이클 끝에 미뤄져 남은 측정 수 (누적) */
+    uint32_t dropped;      /**< 노후로 버린 측정 수 */
+} FusionUpdateBudget;
+
+/**
+ * @brief 타임스탬프가 붙은 보조 측정
+ */
+typedef struct {
+    uint32_t timestamp_us; /**< 측정 시각 (us) */
+    FusionMeasType type;   /**< 측정 종류 */
+    union {
+        struct {
+            Vector3f pos;  /**< 위치 (NED, m) */
+            Vector3f vel;  /**< 속도 (NED, m/s) */
+            EKF_GpsAccuracy acc; /**< 수신기 보고 정확도 (0이면 R_gps) */
+            uint8_t components; /**< 융합할 성분 (EKF_GpsComponent 조합) */
+        } gps;
+        struct {
+            float alt;     /**< 기압계 고도 (m) */
+            float noise_scale; /**< 기압계 R 배율 (이중 기압계 사전 융합, 단일 기압계는 1) */
+        } baro;
+        struct {
+            Vector3f field; /**< 자력계 (보정 후 정규화된 벡터) */
+            float noise_scale; /**< 자력계 R 배율 (사전 평균, 샘플마다 갱신하면 1) */
+        } mag;
+        EKF_GnssHeading heading; /**< 이중 안테나 GNSS 기선 측정 */
+    } data;
+} FusionMeasurement;
+
+/**
+ * @brief 발사 확정 대기 중 보류한 IMU 샘플
+ */
+typedef struct {
+    uint32_t timestamp_us; /**< 샘플 시각 (us) */
+    EKF_ImuSample imu;     /**< 예측 입력 (dt 포함) */
+} FusionPendingImu;
+
+/**
+ * @brief 시간 측정 콜백 (us, 자유 증가 카운터)
+ */
+typedef uint32_t (*FusionClockFn)(void);
+
+/**
+ * @brief 스케줄러 통계
+ */
+typedef struct {
+    uint32_t predicts;       /**< 수행한 예측 수 */
+    uint32_t updates;        /**< 수행한 측정 갱신 수 */
+    uint32_t update_failures;/**< 실패한 측정 갱신 수 (이력 범위 밖 포함) */
+    uint32_t deferred;       /**< 예산 부족으로 사이클 끝에 미뤄져 남은 갱신 수 */
+    uint32_t dropped;        /**< 대기열 가득 참 또는 노후로 버린 측정 수 */
+    uint32_t overruns;       /**< 예산을 초과한 사이클 수 */
+    uint32_t max_cycle_us;   /**< 최대 사이클 처리 시간 (us) */
+    uint32_t catch_up_cycles;  /**< 따라잡기로 처리한 사이클 수 */
+    uint32_t catch_up_samples; /**< 따라잡기로 묶어 예측한 IMU 샘플 수 */
+} FusionStats;
+
+/**
+ * @brief 융합 스케줄러
+ */
+typedef struct {
+    EKF *ekf;                    /**< 융합 대상 필터 */
+    EKF_DelayBuffer *history;    /**< 지연 측정용 상태 이력 */
+    ImuRing *imu;                /**< IMU 샘플 입력 링 */
+    NavPublisher *publisher;     /**< 항법 해 게시 버퍼 (NULL이면 게시 안 함) */
+    MagIronCal *mag_cal;         /**< 자력계 경철/연철 보정 (NULL이면 정규화된 입력 사용) */
+    MagAverage *mag_average;     /**< 자력계 사전 평균 (NULL이면 샘플마다 갱신) */
+    FlightPhaseMachine *phase;   /**< 비행 단계 (NULL이면 항상 전체 주기) */
+    StaticDetector *static_detector; /**< 발사대 정지 판정 (NULL이면 영속도 갱신 안 함) */
+    EventDetector *events;       /**< 입력 단계 비행 이벤트 검출기 (NULL이면 상태 기계 자체 판정) */
+    FusionMonitor *monitor;      /**< 부하/지연 감시기 (NULL이면 기록 안 함) */
+    LatencyMonitor *latency;     /**< 센서별 소비 지연 감시기 (NULL이면 기록 안 함) */
+    AccelBlend *accel_blend;     /**< 고중력 가속도계 혼합기 (NULL이면 주 가속도만 사용) */
+    const ImuVibration *vibration; /**< 입력 단계 진동 통계 (NULL이면 진동으로 노이즈를 키우지 않음) */
+    GyroSpectrum *spectrum;      /**< 자이로 스펙트럼 분석기 (NULL이면 분석 안 함) */
+    ImuLeverArm *lever_arm;      /**< 바이어스를 게시할 장착 위치 보정 (NULL이면 없음) */
+    FilterHealth *health;        /**< 수치 건전성 감시기 (NULL이면 점검 안 함) */
+    ConvergenceMonitor *convergence; /**< 수렴 감시기 (NULL이면 기록 안 함) */
+    VerticalFilter *vertical;    /**< 수직 채널 필터 (NULL이면 EKF 수직 속도로 정점 판정) */
+    PredictRate *predict_rate;   /**< 적응 예측 주기 제어기 (NULL이면 샘플마다 예측) */
+    FixedLagSmoother *smoother;  /**< 위치/속도 고정 지연 평활기 (NULL이면 평활 안 함) */
+    bool info_batch;             /**< 발사대 단계 보조 측정을 정보 형식으로 묶어 반영 */
+    FusionClockFn clock;         /**< 시간 측정 콜백 */
+    uint32_t budget_us;          /**< 사이클당 처리 시간 예산 (us) */
+
+    FusionUpdateBudget update[FUSION_MEAS_TYPE_COUNT]; /**< 종류별 갱신 정책과 비용 추정 */
+    float predict_cost_us;       /**< IMU 샘플 하나 예측 처리 시간 추정 (us) */
+
+    FusionMeasurement queue[FUSION_QUEUE_SIZE]; /**< 시각 순 정렬 대기열 */
+    uint8_t queue_count;         /**< 대기 측정 수 */
+
+    uint32_t last_imu_us;        /**< 마지막 IMU 샘플 시각 (us) */
+    bool has_imu;                /**< IMU 샘플 수신 여부 */
+    FlightPhase last_phase;      /**< 마지막으로 확인한 비행 단계 (EKF 정상 상태 게인 재시작용) */
+
+    Vector3f pad_gyro_dt;        /**< 발사대 단계 자이로 적분 누적 (rad) */
+    Vector3f pad_accel_dt;       /**< 발사대 단계 가속도 적분 누적 (m/s) */
+    float pad_dt;                /**< 발사대 단계 누적 구간 길이 (초) */
+    uint16_t pad_count;          /**< 발사대 단계 누적 샘플 수 */
+    FusionPendingImu launch_pending[FUSION_LAUNCH_PENDING_SIZE]; /**< 발사 확정 대기 샘플 */
+    uint8_t launch_pending_count; /**< 보류 샘플 수 */
+
+    uint32_t catch_up_threshold; /**< 따라잡기 시작 IMU 링 적체 샘플 수 (0이면 사용 안 함) */
+    bool catching_up;            /**< 이번 사이클이 따라잡기 중인지 */
+    EKF_Preintegrator catch_up;  /**< 따라잡기 사전 적분기 */
+    uint32_t catch_up_last_us;   /**< 따라잡기 누적분의 마지막 IMU 시각 (us) */
+
+    FusionStats stats;           /**< 통계 */
+} FusionScheduler;
+
+/**
+ * @brief 스케줄러 초기화
+ *
+ * @param sched 스케줄러 포인터
+ * @param ekf 초기화된 EKF
+ * @param history 상태 이력 버퍼 (이 함수에서 초기화)
+ * @param imu IMU 샘플 링
+ * @param clock 시간 측정 콜백
+ * @param budget_us 사이클당 처리 시간 예산 (us)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_init(FusionScheduler *sched, EKF *ekf, EKF_DelayBuffer *history,
+                           ImuRing *imu, FusionClockFn clock, uint32_t budget_us);
+
+/**
+ * @brief 항법 해 게시 버퍼 설정
+ *
+ * 사이클마다 새 IMU 샘플을 처리했으면 마지막 샘플 시각으로 항법 해를 게시한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param publisher 초기화된 게시 버퍼 (NULL이면 게시 중지)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_publisher(FusionScheduler *sched, NavPublisher *publisher);
+
+/**
+ * @brief 자력계 경철/연철 보정 추정기 설정
+ *
+ * 설정 후 fusion_scheduler_push_mag에는 정규화하지 않은 원시 측정(추정기의
+ * 기준 자기장 세기와 같은 단위)을 넣어야 한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param mag_cal 초기화된 추정기 (NULL이면 보정 중지, 입력은 정규화된 벡터)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_mag_calibration(FusionScheduler *sched, MagIronCal *mag_cal);
+
+/**
+ * @brief 자력계 사전 평균 설정
+ *
+ * 설정 후 fusion_scheduler_push_mag는 보정한 샘플을 현재 필터 자세와 함께 모으고, 평균이
+ * 나올 때만 R 배율이 붙은 측정 하나를 대기열에 넣는다 (갱신 직전에 ekf_set_mag_noise_scale).
+ *
+ * @param sched 스케줄러 포인터
+ * @param mag_average 초기화된 평균기 (NULL이면 샘플마다 갱신)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_mag_average(FusionScheduler *sched, MagAverage *mag_average);
+
+/**
+ * @brief 비행 단계 상태 기계 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param phase 초기화된 상태 기계 (NULL이면 단계 구분 없이 전체 주기)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_flight_phase(FusionScheduler *sched, FlightPhaseMachine *phase);
+
+/**
+ * @brief 발사대 정지 판정기 설정
+ *
+ * 비행 단계 상태 기계가 설정된 경우에만 사용된다 (발사대 단계).
+ *
+ * @param sched 스케줄러 포인터
+ * @param detector 초기화된 판정기 (NULL이면 영속도 갱신 중지)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_static_detector(FusionScheduler *sched, StaticDetector *detector);
+
+/**
+ * @brief 비행 이벤트 검출기 설정
+ *
+ * 설정하면 발사/연소 종료는 상태 기계의 IMU 판정 대신 검출기 이벤트로 전이한다
+ * (정점은 이벤트와 항법 해 판정 중 먼저 오는 쪽). 이벤트는 검출 시각이 처리 중인
+ * IMU 샘플 시각에 도달했을 때 반영된다. 비행 단계 상태 기계가 설정된 경우에만 사용된다.
+ * 검출기는 링 생산자 탭과 기압계 입력으로 별도로 구동해야 한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param events 초기화된 검출기 (NULL이면 상태 기계 자체 판정)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_event_detector(FusionScheduler *sched, EventDetector *events);
+
+/**
+ * @brief 부하/지연 감시기 설정
+ *
+ * IMU 샘플 시각은 시간 콜백과 같은 시간축이어야 한다. 샘플마다 시간 콜백을 한 번 더 호출한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param monitor 초기화된 감시기 (NULL이면 기록 중지)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_monitor(FusionScheduler *sched, FusionMonitor *monitor);
+
+/**
+ * @brief 센서별 소비 지연 감시기 설정
+ *
+ * 측정 시각은 시간 콜백과 같은 시간축(입력 캡처 시각, sys/timebase.h)이어야 한다.
+ * 시간 콜백은 예측/갱신 비용 학습에 이미 읽는 값을 함께 쓴다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param latency 초기화된 감시기 (NULL이면 기록 중지)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_latency_monitor(FusionScheduler *sched, LatencyMonitor *latency);
+
+/**
+ * @brief 고중력 가속도계 혼합기 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param blend 초기화된 혼합기 (NULL이면 해제하고 속도 노이즈 증가분을 0으로 되돌림)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_accel_blend(FusionScheduler *sched, AccelBlend *blend);
+
+/**
+ * @brief 입력 단계 진동 통계 설정 (진동 분산만큼 속도 프로세스 노이즈 증가)
+ *
+ * 고중력 가속도계 혼합기와 함께 쓰면 포화는 혼합기가 처리하므로 통계 설정의
+ * clip_noise_std를 0으로 둔다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param vibration 드라이버에 연결된 통계 (NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_vibration(FusionScheduler *sched, const ImuVibration *vibration);
+
+/**
+ * @brief 자이로 스펙트럼 분석기 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param spectrum 초기화된 분석기 (입력은 IMU 드라이버가 공급, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_gyro_spectrum(FusionScheduler *sched, GyroSpectrum *spectrum);
+
+/**
+ * @brief 장착 위치 보정 설정 (자이로 바이어스 게시 대상)
+ *
+ * @param sched 스케줄러 포인터
+ * @param lever_arm 초기화된 보정 상태 (IMU 드라이버에 함께 설정, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_lever_arm(FusionScheduler *sched, ImuLeverArm *lever_arm);
+
+/**
+ * @brief 수치 건전성 감시기 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param health 초기화된 감시기 (같은 EKF 대상, NULL이면 해제)
+ * @return bool 성공 여부 (다른 EKF를 감시하면 false)
+ */
+bool fusion_scheduler_set_health_monitor(FusionScheduler *sched, FilterHealth *health);
+
+/**
+ * @brief 수렴 감시기 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param convergence 초기화된 감시기 (IMU 샘플과 같은 시간축, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_convergence_monitor(FusionScheduler *sched, ConvergenceMonitor *convergence);
+
+/**
+ * @brief 수직 채널 필터 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param vertical 초기화된 필터 (첫 기압 측정으로 시작, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_vertical_filter(FusionScheduler *sched, VerticalFilter *vertical);
+
+/**
+ * @brief 적응 예측 주기 제어기 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param predict_rate 초기화된 제어기 (NULL이면 해제, 누적분은 해제 전에 예측)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_predict_rate(FusionScheduler *sched, PredictRate *predict_rate);
+
+/**
+ * @brief 고정 지연 평활기 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param smoother 초기화된 평활기 (IMU 샘플과 같은 시간축, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_fixed_lag(FusionScheduler *sched, FixedLagSmoother *smoother);
+
+/**
+ * @brief 측정 종류별 갱신 정책 설정
+ *
+ * @param sched 스케줄러 포인터
+ * @param type 측정 종류
+ * @param priority 우선순위 (높을수록 나중에 미뤄짐, FUSION_PRIORITY_ALWAYS이면 미루지 않음)
+ * @param max_age_us 미룬 측정의 최대 보관 시간 (us, 0이면 제한 없음)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_update_policy(FusionScheduler *sched, FusionMeasType type,
+                                        uint8_t priority, uint32_t max_age_us);
+
+/**
+ * @brief 측정 종류별 정책과 비용 추정 조회
+ *
+ * @param sched 스케줄러 포인터
+ * @param type 측정 종류
+ * @return const FusionUpdateBudget* 정책 (잘못된 인자이면 NULL)
+ */
+const FusionUpdateBudget *fusion_scheduler_get_update_budget(const FusionScheduler *sched, FusionMeasType type);
+
+/**
+ * @brief 발사대 단계 정보 형식 묶음 갱신 설정
+ *
+ * 활성화하면 발사대 단계에서 필터 시각에 함께 도달한 보조 측정(다중 GNSS/기압계, 자력계 등)을
+ * ekf_info_begin/ekf_info_apply로 묶어 공분산을 한 번만 갱신한다. 비행 중에는 측정마다
+ * 측정 시각으로 되감으므로 적용하지 않는다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param enable 활성화 여부
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_information_batch(FusionScheduler *sched, bool enable);
+
+/**
+ * @brief 과부하 따라잡기 설정
+ *
+ * 사이클 시작 때 IMU 링에 threshold개보다 많은 샘플이 쌓여 있으면 그 사이클의 비행 중 샘플을
+ * 사전 적분해 묶어 예측한다. 정상 사이클의 샘플 수(태스크 주기 x IMU 주기)보다 충분히 크게 둔다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param threshold 적체 샘플 수 문턱 (0이면 사용 안 함)
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_set_catch_up(FusionScheduler *sched, uint32_t threshold);
+
+/**
+ * @brief GNSS 측정 추가
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param pos 위치 (NED, m)
+ * @param use_vel 속도 사용 여부
+ * @param vel 속도 (NED, m/s)
+ * @return bool 성공 여부 (대기열 가득 참 시 false)
+ */
+bool fusion_scheduler_push_gps(FusionScheduler *sched, uint32_t timestamp_us,
+                               Vector3f pos, bool use_vel, Vector3f vel);
+
+/**
+ * @brief GNSS 부분 측정 추가 (위치 전용, 속도 전용, 수직 제외 등)
+ *
+ * 수직 성분을 빼면(EKF_GPS_NO_VERTICAL) 기압계와 묶어 갱신하지 않는다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param pos 위치 (NED, m)
+ * @param vel 속도 (NED, m/s)
+ * @param components 융합할 성분 (EKF_GpsComponent 조합)
+ * @return bool 성공 여부 (대기열 가득 참 시 false)
+ */
+bool fusion_scheduler_push_gps_partial(FusionScheduler *sched, uint32_t timestamp_us,
+                                       Vector3f pos, Vector3f vel, uint8_t components);
+
+/**
+ * @brief 수신기 보고 정확도가 붙은 GNSS 측정 추가
+ *
+ * 갱신 직전에 ekf_set_gps_accuracy로 넘기므로 이 측정의 R은 acc의 대각이고, 문턱을 넘는
+ * 성분은 갱신에서 빠진다. 다른 push 함수로 넣은 측정은 정확도 없음(R_gps)으로 갱신한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param pos 위치 (NED, m)
+ * @param vel 속도 (NED, m/s)
+ * @param components 융합할 성분 (EKF_GpsComponent 조합)
+ * @param acc 수신기 정확도 (NULL이면 정확도 없음)
+ * @return bool 성공 여부 (대기열 가득 참 시 false)
+ */
+bool fusion_scheduler_push_gps_accuracy(FusionScheduler *sched, uint32_t timestamp_us, Vector3f pos,
+                                        Vector3f vel, uint8_t components, const EKF_GpsAccuracy *acc);
+
+/**
+ * @brief 기압계 측정 추가
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param baro_alt 기압계 고도 (m)
+ * @return bool 성공 여부 (대기열 가득 참 시 false)
+ */
+bool fusion_scheduler_push_baro(FusionScheduler *sched, uint32_t timestamp_us, float baro_alt);
+
+/**
+ * @brief R 배율이 붙은 기압계 측정 추가 (이중 기압계 사전 융합 출력, baro_dual.h)
+ *
+ * 갱신 직전에 ekf_set_baro_noise_scale로 배율을 건다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param baro_alt 융합 고도 (m)
+ * @param noise_scale 기압계 R 배율 (BaroDualOutput.noise_scale, 양수)
+ * @return bool 성공 여부 (대기열 가득 참 또는 배율이 잘못되면 false)
+ */
+bool fusion_scheduler_push_baro_scaled(FusionScheduler *sched, uint32_t timestamp_us, float baro_alt,
+                                       float noise_scale);
+
+/**
+ * @brief 자력계 측정 추가
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param mag 자력계 (보정 추정기가 있으면 원시 측정, 없으면 정규화된 벡터)
+ * @return bool 성공 여부 (대기열 가득 참 시 false)
+ */
+bool fusion_scheduler_push_mag(FusionScheduler *sched, uint32_t timestamp_us, Vector3f mag);
+
+/**
+ * @brief 이중 안테나 GNSS 기선 방위(와 앙각) 측정 추가
+ *
+ * 기선은 ekf_set_gnss_baseline으로 먼저 설정한다. 자력계를 믿을 수 없는 구간(점화 직후,
+ * 전장품 칸 안)에서도 쓸 수 있는 방위 관측이며, 자력계 3축 갱신 대신 스칼라 갱신 하나로 처리한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param m 기선 측정 (UbxGnssRelPos에서 옮긴 방위, 앙각, 정확도)
+ * @return bool 성공 여부 (대기열 가득 참 시 false)
+ */
+bool fusion_scheduler_push_gnss_heading(FusionScheduler *sched, uint32_t timestamp_us, const EKF_GnssHeading *m);
+
+/**
+ * @brief MPSC 측정 대기열 비우기 (fusion_scheduler_run 직전에 호출)
+ *
+ * IMU 메시지는 IMU 링에 넣고(이때 융합 태스크가 링의 유일한 생산자이며 링 탭도 이 문맥에서
+ * 호출됨), 기압 메시지는 baro로 고도로 바꿔(NULL이면 해수면 기준 ISA 고도), 자력계/GNSS 메시지는
+ * 해당 push 함수로 보조 측정 대기열에 넣는다. 옮기지 못한 측정은 각 대상의 버림 통계에 남는다.
+ *
+ * @param sched 스케줄러 포인터
+ * @param queue 측정 대기열
+ * @param baro 기압 고도 변환기 (NULL 가능)
+ * @return uint32_t 꺼낸 메시지 수
+ */
+uint32_t fusion_scheduler_drain_queue(FusionScheduler *sched, MeasQueue *queue, BaroAltitude *baro);
+
+/**
+ * @brief 융합 사이클 1회 실행
+ *
+ * IMU 링의 샘플을 모두 예측에 사용하면서, 각 샘플 이전 시각의 보조 측정을
+ * 먼저 갱신한다. 필터 시각보다 미래의 측정은 다음 사이클까지 대기한다.
+ *
+ * @param sched 스케줄러 포인터
+ * @return bool 성공 여부
+ */
+bool fusion_scheduler_run(FusionScheduler *sched);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param sched 스케줄러 포인터
+ * @return const FusionStats* 통계 (sched가 NULL이면 NULL)
+ */
+const FusionStats *fusion_scheduler_get_stats(const FusionScheduler *sched);
+
+#endif /* FUSION_SCHEDULER_H */
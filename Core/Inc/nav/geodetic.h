@@ -0,0 +1,154 @@
+/**
+ * @file geodetic.h
+ * @brief 측지 좌표(WGS-84 위도/경도/고도) → 지역 NED 변환 (원점 캐시, 선형화 변환, 재중심화)
+ *
+ * 원점(EKF 위치 좌표계 원점, 보통 발사대)의 sin/cos와 ECEF 좌표를 초기화 때 한 번
+ * 배정밀도로 계산해 둔다. 측위마다는 원점 대신 근처의 선형화 점에서 정수 위경도 차
+ * (1e-7 deg)에 미리 계산한 float 계수를 곱하는 2차 근사(자오선/묘유선 곡률, 고도,
+ * 지구 곡률에 의한 하강 항 포함)로 선형화 점 NED를 구하고, 선형화 점의 원점 NED
+ * 좌표와 두 NED 축 사이 회전으로 원점 NED에 옮긴다. 측위당 비용은 정수 뺄셈과
+ * float 곱셈 수십 회이며 삼각함수와 배정밀도 연산이 없다.
+ *
+ * 측위가 선형화 점에서 recenter_radius 이상 멀어지면 그 측위를 새 선형화 점으로
+ * 삼아 배정밀도로 정확히 다시 계산한다 (재중심화). 원점은 바뀌지 않으므로 출력
+ * 좌표계는 비행 내내 같고 EKF 상태를 옮길 필요가 없다. 반경 2 km에서 근사 오차는
+ * 수 mm 수준이다.
+ *
+ * GNSS 원시 관측 강결합 갱신용으로 원점 NED 점에서 위성(ECEF)까지의 기하 거리와
+ * 시선 벡터를 배정밀도로 구하는 함수와, 텔레메트리용 원점 NED → ECEF/측지 역변환도 제공한다.
+ */
+
+#ifndef GEODETIC_H
+#define GEODETIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/vector3f.h"
+
+/**
+ * @brief 기본 재중심화 반경 (m)
+ */
+#define GEODETIC_DEFAULT_RECENTER_RADIUS 2000.0f
+
+/**
+ * @brief 측지 → 지역 NED 변환 기준
+ */
+typedef struct {
+    // 원점 (초기화 후 고정, 배정밀도)
+    double sin_lat0;           /**< 원점 위도 sin */
+    double cos_lat0;           /**< 원점 위도 cos */
+    double sin_lon0;           /**< 원점 경도 sin */
+    double cos_lon0;           /**< 원점 경도 cos */
+    double ecef0[3];           /**< 원점 ECEF 좌표 (m) */
+
+    // 선형화 점 (재중심화마다 갱신)
+    int32_t lat_e7;            /**< 선형화 점 위도 (1e-7 deg) */
+    int32_t lon_e7;            /**< 선형화 점 경도 (1e-7 deg) */
+    int32_t height_mm;         /**< 선형화 점 타원체 고도 (mm) */
+    Vector3f offset;           /**< 선형화 점의 원점 NED 좌표 (m) */
+    float rot[3][3];           /**< 선형화 점 NED → 원점 NED 회전 */
+    float k_north;             /**< 북쪽 거리 계수 (m / 1e-7 deg) */
+    float k_east;              /**< 동쪽 거리 계수 (m / 1e-7 deg) */
+    float k_east_lat;          /**< 동쪽 거리의 위도 보정 계수 (1 / 1e-7 deg) */
+    float inv_m;               /**< 1 / 자오선 곡률 반경 (1/m, 고도 포함) */
+    float inv_n;               /**< 1 / 묘유선 곡률 반경 (1/m, 고도 포함) */
+    float c_north;             /**< 동쪽 이동에 의한 북쪽 보정 계수 tan(lat) / (2 N) (1/m) */
+
+    float recenter_radius;     /**< 재중심화 반경 (m) */
+    uint32_t recenter_count;   /**< 재중심화 횟수 */
+    bool initialized;          /**< 초기화 여부 */
+} GeodeticFrame;
+
+/**
+ * @brief 원점 설정 (선형화 점도 원점으로 초기화)
+ *
+ * @param frame 변환 기준
+ * @param lat_e7 원점 위도 (1e-7 deg)
+ * @param lon_e7 원점 경도 (1e-7 deg)
+ * @param height_mm 원점 타원체 고도 (mm)
+ * @param recenter_radius 재중심화 반경 (m, 양수)
+ * @return bool 성공 여부 (위도가 ±90도를 넘거나 반경이 양수가 아니면 false)
+ */
+bool geodetic_init(GeodeticFrame *frame, int32_t lat_e7, int32_t lon_e7, int32_t height_mm,
+                   float recenter_radius);
+
+/**
+ * @brief 선형화 점 재설정 (배정밀도 정확 변환)
+ *
+ * @param frame 변환 기준
+ * @param lat_e7 위도 (1e-7 deg)
+ * @param lon_e7 경도 (1e-7 deg)
+ * @param height_mm 타원체 고도 (mm)
+ * @return bool 성공 여부
+ */
+bool geodetic_recenter(GeodeticFrame *frame, int32_t lat_e7, int32_t lon_e7, int32_t height_mm);
+
+/**
+ * @brief 측지 좌표 → 원점 NED (재중심화 반경을 넘으면 자동 재중심화)
+ *
+ * @param frame 변환 기준
+ * @param lat_e7 위도 (1e-7 deg)
+ * @param lon_e7 경도 (1e-7 deg)
+ * @param height_mm 타원체 고도 (mm)
+ * @param ned 원점 기준 NED 좌표 (m)
+ * @return bool 성공 여부
+ */
+bool geodetic_to_ned(GeodeticFrame *frame, int32_t lat_e7, int32_t lon_e7, int32_t height_mm,
+                     Vector3f *ned);
+
+/**
+ * @brief 원점 NED → ECEF (배정밀도)
+ *
+ * @param frame 변환 기준
+ * @param ned 원점 기준 NED 좌표 (m)
+ * @param ecef ECEF 좌표 (m)
+ * @return bool 성공 여부
+ */
+bool geodetic_ned_to_ecef(const GeodeticFrame *frame, Vector3f ned, double ecef[3]);
+
+/**
+ * @brief ECEF → 측지 좌표 (배정밀도, Bowring 1회 근사, 지표 근처 오차 1 mm 미만)
+ *
+ * @param ecef ECEF 좌표 (m)
+ * @param lat_e7 위도 (1e-7 deg)
+ * @param lon_e7 경도 (1e-7 deg)
+ * @param height_mm 타원체 고도 (mm)
+ * @return bool 성공 여부
+ */
+bool geodetic_ecef_to_lla(const double ecef[3], int32_t *lat_e7, int32_t *lon_e7, int32_t *height_mm);
+
+/**
+ * @brief 원점 NED → 측지 좌표 (geodetic_ned_to_ecef 후 geodetic_ecef_to_lla)
+ *
+ * 텔레메트리용 역변환이며 삼각함수 여러 번과 배정밀도 연산이 들어가므로 고속 루프에서
+ * 매번 부르지 말고 nav_frames처럼 게시마다 한 번만 계산해 둔다.
+ *
+ * @param frame 변환 기준
+ * @param ned 원점 기준 NED 좌표 (m)
+ * @param lat_e7 위도 (1e-7 deg)
+ * @param lon_e7 경도 (1e-7 deg)
+ * @param height_mm 타원체 고도 (mm)
+ * @return bool 성공 여부
+ */
+bool geodetic_from_ned(const GeodeticFrame *frame, Vector3f ned, int32_t *lat_e7, int32_t *lon_e7,
+                       int32_t *height_mm);
+
+/**
+ * @brief 원점 NED 점 → 위성 기하 거리와 시선 벡터 (배정밀도)
+ *
+ * 거리에는 신호 전파 중 지구 자전 보정(Sagnac, 최대 약 30 m)을 더한다.
+ * 결과를 의사거리에서 빼면 EKF_GnssObservation의 단정밀도 잔차가 된다.
+ *
+ * @param frame 변환 기준
+ * @param ref_ned 수신기 선형화 점 (원점 NED, m)
+ * @param sat_ecef 위성 위치 (ECEF, m, 송신 시각 기준)
+ * @param sat_vel_ecef 위성 속도 (ECEF, m/s, NULL 가능)
+ * @param los 수신기 → 위성 단위 시선 벡터 (원점 NED)
+ * @param range 기하 거리 (m, Sagnac 보정 포함)
+ * @param sat_rate 위성 속도의 시선 성분 (m/s, NULL 가능, sat_vel_ecef가 NULL이면 0)
+ * @return bool 성공 여부
+ */
+bool geodetic_line_of_sight(const GeodeticFrame *frame, Vector3f ref_ned, const double sat_ecef[3],
+                            const double sat_vel_ecef[3], Vector3f *los, double *range, float *sat_rate);
+
+#endif /* GEODETIC_H */
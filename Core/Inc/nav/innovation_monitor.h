@@ -0,0 +1,176 @@
+/**
+ * @file innovation_monitor.h
+ * @brief 측정별 NIS 창 통계 (평균, 표준 편차, 최댓값, 거부 수) 게시와 압축 기록
+ *
+ * 필터 조정과 비행 중 감시에는 혁신 통계가 필요하지만, 따로 혁신과 S를 다시 계산해 기록하면
+ * 갱신마다 한 번 더 훑어야 한다. 혁신 게이트(ekf_update.c)는 이미 NIS를 계산하므로 측정 종류별
+ * EKF_NisWindow에 합, 제곱 합, 최댓값, 거부 수를 더하기만 한다 (덧셈 몇 번). 이 모듈은 융합
+ * 문맥에서 window_us마다 ekf_take_nis_window로 창을 꺼내 평균/표준 편차를 구하고 두 벌 버퍼로
+ * 게시한다. 텔레메트리(TELEMETRY_GROUP_NIS)와 다른 태스크는 잠금 없이 innovation_monitor_get_metrics로
+ * 읽는다.
+ *
+ * 측정 차원 d로 나눈 평균 NIS(ratio)는 잡음 모델이 맞으면 1 근처이다 (크면 R이나 Q가 작음,
+ * 작으면 큼). 차원은 EKF_Sensor 주석을 따른다 (GPS_POS_VEL은 6, 속도만 갱신하는 구성에서는
+ * ratio가 절반으로 보임). worst는 ratio가 가장 큰 두 측정이다.
+ *
+ * 같은 게이트가 nis_last와 nis_reject_count도 갱신하므로 다중 필터 건전성(ekf_lanes.h)과 이 통계는
+ * 같은 NIS를 본다. 적응형 측정 노이즈(EKF_AdaptiveNoise)는 축별 R을 추정해야 하므로 스칼라 NIS
+ * 대신 축별 혁신 통계를 따로 유지하며, ratio는 그 결과를 확인하는 지표로 쓴다.
+ *
+ * 기록 페이로드 (FLASH_LOG_REC_NIS, 리틀 엔디언, 창에 갱신이나 거부가 있었던 측정만):
+ * @verbatim
+ *   t_us(u32) | n(u8) | n x { sensor(u8) | count(u16) | rejects(u16) | mean(f16) | std(f16) | max(f16) }
+ * @endverbatim
+ * f16은 IEEE binary16 (math/float16.h, 상대 오차 2^-12 이하). 측정 13종이 모두 있으면 148바이트,
+ * 1 Hz이면 약 160 B/s이다. 호스트 복원기(Tools/log/log_decode.c)는 측정마다 nis 행을 출력한다.
+ */
+
+#ifndef INNOVATION_MONITOR_H
+#define INNOVATION_MONITOR_H
+
+#include "ekf/ekf.h"
+#include "log/flash_log.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define INNOVATION_MONITOR_DEFAULT_WINDOW_US 1000000u  /**< 통계 창 (us, 1 s) */
+
+/**
+ * @brief 레코드 페이로드 길이 (n 측정)
+ */
+#define INNOVATION_MONITOR_LOG_SIZE(n) (4u + 1u + 11u * (n))
+
+_Static_assert(INNOVATION_MONITOR_LOG_SIZE(EKF_SENSOR_COUNT) <= FLASH_LOG_MAX_PAYLOAD,
+               "NIS record does not fit in one log record");
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t window_us;        /**< 통계 창 (us, 0 초과) */
+} InnovationMonitorConfig;
+
+/**
+ * @brief 측정 하나의 창 통계
+ */
+typedef struct {
+    uint32_t count;            /**< 유한한 NIS 수 (게이트 거부 포함) */
+    uint32_t rejects;          /**< 게이트 거부 수 */
+    float mean;                /**< 평균 NIS */
+    float std;                 /**< NIS 표준 편차 */
+    float max;                 /**< NIS 최댓값 */
+    float ratio;               /**< 평균 NIS / 측정 차원 (일관이면 1 근처, 갱신이 없으면 0) */
+} InnovationSensorMetrics;
+
+/**
+ * @brief 게시한 창 통계
+ */
+typedef struct {
+    uint32_t window_end_us;    /**< 창 끝 시각 (us) */
+    uint32_t window_us;        /**< 창 길이 (us, 게시 전이면 0) */
+    uint16_t active;           /**< 창에 갱신이나 거부가 있었던 측정 (1 << EKF_Sensor) */
+    uint8_t worst[2];          /**< ratio가 가장 큰 두 측정 (없으면 EKF_SENSOR_COUNT) */
+    InnovationSensorMetrics sensor[EKF_SENSOR_COUNT]; /**< 측정별 통계 */
+} InnovationMetrics;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t windows;          /**< 게시한 창 수 */
+    uint32_t logged;           /**< 기록한 레코드 수 */
+    uint32_t log_dropped;      /**< 기록기가 받지 않은 레코드 수 */
+} InnovationMonitorStats;
+
+/**
+ * @brief NIS 창 통계 감시기
+ */
+typedef struct {
+    InnovationMonitorConfig config; /**< 설정 */
+    uint32_t window_start_us;  /**< 창 시작 시각 (us) */
+    bool started;              /**< 창 시작 시각 유효 */
+
+    InnovationMetrics metrics[2]; /**< 게시한 창 통계 두 벌 */
+    atomic_uint active;        /**< 읽을 통계 번호 */
+    InnovationMonitorStats stats; /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} InnovationMonitor;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool innovation_monitor_default_config(InnovationMonitorConfig *config);
+
+/**
+ * @brief 초기화
+ *
+ * @param im 구조체 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool innovation_monitor_init(InnovationMonitor *im, const InnovationMonitorConfig *config);
+
+/**
+ * @brief 창이 끝났으면 EKF의 NIS 창을 꺼내 통계 게시 (융합 문맥, 측정 갱신 뒤)
+ *
+ * 첫 호출은 창 시작만 잡고 그 전의 누적을 버린다.
+ *
+ * @param im 구조체 포인터
+ * @param ekf 항법 필터
+ * @param now_us 현재 시각 (us)
+ * @return bool 이번 호출에서 게시했으면 true
+ */
+bool innovation_monitor_update(InnovationMonitor *im, EKF *ekf, uint32_t now_us);
+
+/**
+ * @brief 마지막으로 게시한 창 통계 (어느 문맥이든)
+ *
+ * @param im 구조체 포인터
+ * @param out 통계
+ * @return bool 게시한 창이 있으면 true
+ */
+bool innovation_monitor_get_metrics(const InnovationMonitor *im, InnovationMetrics *out);
+
+/**
+ * @brief 마지막 창의 평균 NIS / 측정 차원
+ *
+ * @param im 구조체 포인터
+ * @param sensor 측정 종류
+ * @return float ratio (창이 없거나 갱신이 없었으면 0)
+ */
+float innovation_monitor_ratio(const InnovationMonitor *im, EKF_Sensor sensor);
+
+/**
+ * @brief 창 통계 부호화
+ *
+ * @param m 창 통계
+ * @param payload 페이로드 (INNOVATION_MONITOR_LOG_SIZE(EKF_SENSOR_COUNT) 바이트 이상)
+ * @return uint8_t 페이로드 길이 (실패하면 0)
+ */
+uint8_t innovation_monitor_encode(const InnovationMetrics *m, uint8_t *payload);
+
+/**
+ * @brief 마지막 창 통계를 비행 기록에 남김 (기록 작성자 문맥, 보통 update가 true일 때)
+ *
+ * @param im 구조체 포인터
+ * @param log 비행 기록
+ * @return bool 성공 여부
+ */
+bool innovation_monitor_log(InnovationMonitor *im, FlashLog *log);
+
+/**
+ * @brief 통계
+ *
+ * @param im 구조체 포인터
+ * @return const InnovationMonitorStats* 통계 (NULL이면 NULL)
+ */
+const InnovationMonitorStats *innovation_monitor_get_stats(const InnovationMonitor *im);
+
+#endif /* INNOVATION_MONITOR_H */
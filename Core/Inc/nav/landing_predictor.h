@@ -0,0 +1,150 @@
+/**
+ * @file landing_predictor.h
+ * @brief 낙하산 하강 중 바람 추정과 착지 지점 예측 (저주기, 항법 해 스냅샷 입력)
+ *
+ * 낙하산 하강 중 수평 속도는 대부분 바람이다. 축별 무작위 보행 바람 상태 두 개(x, y)를
+ * 항법 해의 수평 속도로 갱신하는 2상태 칼만 필터를 두고, 하강률은 밀도 고도 모형
+ * v(h) = v_g exp((h - h_g) / 2H) (종단 속도 ~ 1/sqrt(밀도), 밀도 ~ exp(-h/H))의 지상 하강률 v_g를
+ * 저역 통과로 추정한다. 착지까지 시간은 이 모형을 지상 고도까지 적분한 해석해이다:
+ * @verbatim
+ *   T = (2H / v_g) (1 - exp(-(h - h_g) / 2H))
+ *   p_land = p + w T + (v_h - w) tau (1 - exp(-T / tau))
+ * @endverbatim
+ * 둘째 항은 수평 속도가 시상수 tau로 바람 속도에 다가가는 과도 응답이다. 착지 지점 표준 편차는
+ * 바람 분산 x T^2과 현재 수평 위치 분산의 합이다.
+ *
+ * 입력은 nav_publisher 스냅샷이라 융합 태스크와 무관하며, 갱신 한 번에 스칼라 칼만 갱신 두 번과
+ * exp 몇 번이 전부이다. 텔레메트리 태스크에서 telemetry_service 전에 같은 태스크로 호출하면
+ * 텔레메트리 LANDING 묶음이 잠금 없이 결과를 읽는다. 위치/속도의 z는 위쪽이 양수
+ * (flight_phase와 같은 규약)이다.
+ */
+
+#ifndef LANDING_PREDICTOR_H
+#define LANDING_PREDICTOR_H
+
+#include "ekf/ekf.h"
+#include "nav/flight_phase.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define LANDING_DEFAULT_RATE_HZ 5.0f          /**< 갱신 주기 (Hz) */
+#define LANDING_DEFAULT_GROUND_ALT 0.0f       /**< 지상 고도 (m, 항법 해 z와 같은 기준) */
+#define LANDING_DEFAULT_SCALE_HEIGHT 8500.0f  /**< 대기 밀도 척도 높이 H (m) */
+#define LANDING_DEFAULT_WIND_WALK 0.3f        /**< 바람 무작위 보행 (m/s/sqrt(s)) */
+#define LANDING_DEFAULT_GUST_STD 1.5f         /**< 돌풍/흔들림 측정 잡음 (m/s) */
+#define LANDING_DEFAULT_INIT_WIND_STD 5.0f    /**< 초기 바람 표준 편차 (m/s) */
+#define LANDING_DEFAULT_DESCENT_TAU 2.0f      /**< 지상 하강률 저역 통과 시상수 (s) */
+#define LANDING_DEFAULT_DRIFT_TAU 1.0f        /**< 수평 속도가 바람을 따라가는 시상수 (s) */
+#define LANDING_DEFAULT_MIN_DESCENT 1.0f      /**< 예측에 쓰는 최소 하강률 (m/s) */
+
+/**
+ * @brief 예측기 설정
+ */
+typedef struct {
+    float rate_hz;             /**< 갱신 주기 (Hz, 더 자주 불러도 이 주기로 솎음) */
+    float ground_alt;          /**< 지상 고도 (m) */
+    float scale_height;        /**< 대기 밀도 척도 높이 (m, 양수) */
+    float wind_walk;           /**< 바람 무작위 보행 (m/s/sqrt(s)) */
+    float gust_std;            /**< 수평 속도 측정 잡음 (m/s, 항법 속도 분산에 더함) */
+    float init_wind_std;       /**< 하강 시작 때 바람 표준 편차 (m/s) */
+    float descent_tau;         /**< 지상 하강률 저역 통과 시상수 (s) */
+    float drift_tau;           /**< 수평 속도 수렴 시상수 (s, 0이면 과도 응답 무시) */
+    float min_descent;         /**< 최소 하강률 (m/s, 이보다 느리면 예측하지 않음) */
+} LandingPredictorConfig;
+
+/**
+ * @brief 예측 결과
+ */
+typedef struct {
+    float wind[2];             /**< 바람 속도 (x, y, m/s) */
+    float wind_var[2];         /**< 바람 분산 (x, y) */
+    float descent_rate;        /**< 지상 환산 하강률 v_g (m/s, 양수) */
+    float time_to_ground;      /**< 착지까지 시간 (s) */
+    float land[2];             /**< 예측 착지 지점 (x, y, m) */
+    float land_std;            /**< 착지 지점 수평 표준 편차 (m) */
+    uint32_t timestamp_us;     /**< 결과를 만든 항법 해 시각 (us) */
+    bool valid;                /**< 결과 유효 */
+} LandingPrediction;
+
+/**
+ * @brief 예측기 통계
+ */
+typedef struct {
+    uint32_t updates;          /**< 바람 필터 갱신 수 */
+    uint32_t skipped;          /**< 주기가 안 되어 솎은 호출 수 */
+    uint32_t descents;         /**< 하강 시작(초기화) 횟수 */
+    uint32_t slow;             /**< 하강률이 최소보다 느려 예측하지 않은 갱신 수 */
+} LandingPredictorStats;
+
+/**
+ * @brief 착지 지점 예측기
+ */
+typedef struct {
+    LandingPredictorConfig config; /**< 설정 */
+    uint32_t period_us;        /**< 갱신 주기 (us) */
+    uint32_t last_us;          /**< 마지막 갱신 항법 해 시각 (us) */
+    bool active;               /**< 하강 중 (바람 필터 동작) */
+    LandingPrediction out;     /**< 최근 결과 */
+    LandingPredictorStats stats; /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} LandingPredictor;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool landing_predictor_default_config(LandingPredictorConfig *config);
+
+/**
+ * @brief 예측기 초기화
+ *
+ * @param lp 예측기
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (주기, 척도 높이, 잡음, 시상수가 올바르지 않으면 false)
+ */
+bool landing_predictor_init(LandingPredictor *lp, const LandingPredictorConfig *config);
+
+/**
+ * @brief 지상 고도 설정 (발사대 고도 등)
+ *
+ * @param lp 예측기
+ * @param ground_alt 지상 고도 (m, 항법 해 z와 같은 기준)
+ * @return bool 성공 여부
+ */
+bool landing_predictor_set_ground(LandingPredictor *lp, float ground_alt);
+
+/**
+ * @brief 항법 해로 갱신
+ *
+ * 하강 단계에 들어오면 현재 수평 속도로 바람을 초기화하고, 하강 단계가 아니면 동작을 멈춘다
+ * (마지막 결과는 valid를 끈 채 남김).
+ *
+ * @param lp 예측기
+ * @param sol 항법 해 스냅샷
+ * @param phase 비행 단계
+ * @return bool 이번 호출에서 결과를 새로 만들었으면 true
+ */
+bool landing_predictor_update(LandingPredictor *lp, const EKF_NavSolution *sol, FlightPhase phase);
+
+/**
+ * @brief 최근 예측 결과
+ *
+ * @param lp 예측기
+ * @return const LandingPrediction* 결과 (NULL이면 NULL, valid로 유효 확인)
+ */
+const LandingPrediction *landing_predictor_get(const LandingPredictor *lp);
+
+/**
+ * @brief 통계
+ *
+ * @param lp 예측기
+ * @return const LandingPredictorStats* 통계 (NULL이면 NULL)
+ */
+const LandingPredictorStats *landing_predictor_get_stats(const LandingPredictor *lp);
+
+#endif /* LANDING_PREDICTOR_H */
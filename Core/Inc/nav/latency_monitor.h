@@ -0,0 +1,128 @@
+/**
+ * @file latency_monitor.h
+ * @brief 센서 데이터 준비 에지부터 융합 소비까지의 지연 감시 (센서별 히스토그램, 최악값)
+ *
+ * IMU 샘플 시각은 데이터 준비 핀 입력 캡처(sys/timebase.h)로 잡은 에지 시각이고, 보조 측정
+ * 시각도 같은 시간축이다. 융합 스케줄러에 붙이면 IMU 샘플은 링에서 꺼내 예측에 넘기는 순간,
+ * 보조 측정은 대기열에서 꺼내 갱신에 넘기는 순간의 시간 콜백 값과 측정 시각의 차이를
+ * 센서별 로그 눈금 히스토그램에 누적하고, 최악 지연과 그 샘플 시각을 남긴다.
+ *
+ * fusion_monitor.h의 지연은 예측을 마친 시점까지(처리 시간 포함)이고, 여기의 지연은 처리를
+ * 시작하기 전까지(인터럽트, DMA, 링 대기)이다. IMU 지연은 출력 예측기(output_predictor.h)가
+ * 메워야 하는 지연과 제어 루프 위상 여유의 기준이 된다. GNSS 측정 시각은 해 시각이므로
+ * 수신기 계산 지연이 포함된다.
+ *
+ * 히스토그램 칸 k의 범위 (fusion_monitor.h와 같은 규칙):
+ * - k = 0: [0, LATENCY_MONITOR_BASE_US)
+ * - 0 < k < 마지막: [BASE x 2^(k-1), BASE x 2^k)
+ * - 마지막 칸: BASE x 2^(LATENCY_MONITOR_BINS - 2) 이상
+ *
+ * 쓰기는 융합 태스크 한 곳에서만 하며, 다른 태스크는 32비트 필드를 잠금 없이 읽는다.
+ */
+
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include "sys/profile.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 히스토그램 칸 수와 첫 칸 경계 (us, 8 us ~ 131 ms 이상)
+ */
+#define LATENCY_MONITOR_BINS 16u
+#define LATENCY_MONITOR_BASE_US 8u
+
+/**
+ * @brief 측정원 (IMU 다음은 FusionMeasType 순서)
+ */
+typedef enum {
+    LATENCY_SOURCE_IMU = 0,    /**< IMU 샘플 (예측) */
+    LATENCY_SOURCE_GPS,        /**< GNSS 위치/속도 */
+    LATENCY_SOURCE_BARO,       /**< 기압계 고도 */
+    LATENCY_SOURCE_MAG,        /**< 자력계 */
+    LATENCY_SOURCE_HEADING,    /**< 이중 안테나 GNSS 방위 */
+    LATENCY_SOURCE_COUNT       /**< 측정원 수 */
+} LatencySource;
+
+/**
+ * @brief 측정원별 통계
+ */
+typedef struct {
+    uint32_t samples;          /**< 기록한 샘플 수 */
+    uint32_t early;            /**< 측정 시각이 소비 시각보다 뒤로 보인 샘플 수 (0으로 기록) */
+    uint64_t total_us;         /**< 누적 지연 (평균 = total_us / samples) */
+    uint32_t last_us;          /**< 마지막 지연 (us) */
+    uint32_t max_us;           /**< 최악 지연 (us) */
+    uint32_t max_timestamp_us; /**< 최악 지연 샘플의 측정 시각 (트레이스/기록과 대조용) */
+    uint32_t hist[LATENCY_MONITOR_BINS]; /**< 지연 히스토그램 */
+} LatencyStats;
+
+/**
+ * @brief 지연 감시기
+ */
+typedef struct {
+    LatencyStats source[LATENCY_SOURCE_COUNT];
+} LatencyMonitor;
+
+/**
+ * @brief 감시기 초기화 (통계 비움)
+ *
+ * @param mon 감시기
+ * @return bool 성공 여부
+ */
+bool latency_monitor_init(LatencyMonitor *mon);
+
+/**
+ * @brief 통계 초기화
+ *
+ * @param mon 감시기
+ */
+void latency_monitor_reset(LatencyMonitor *mon);
+
+/**
+ * @brief 샘플 하나의 지연 기록
+ *
+ * @param mon 감시기
+ * @param source 측정원
+ * @param timestamp_us 측정 시각 (에지 캡처 시간축, us)
+ * @param now_us 소비 시각 (같은 시간축, us)
+ */
+void latency_monitor_record(LatencyMonitor *mon, LatencySource source, uint32_t timestamp_us, uint32_t now_us);
+
+/**
+ * @brief 측정원별 통계 조회
+ *
+ * @param mon 감시기
+ * @param source 측정원
+ * @return const LatencyStats* 통계 (범위 밖이면 NULL)
+ */
+const LatencyStats *latency_monitor_get_stats(const LatencyMonitor *mon, LatencySource source);
+
+/**
+ * @brief 지연 분위수가 속한 히스토그램 칸
+ *
+ * @param mon 감시기
+ * @param source 측정원
+ * @param permille 분위 (0.1% 단위, 예: 990 = 99%)
+ * @return uint8_t 칸 번호 (샘플이 없으면 0)
+ */
+uint8_t latency_monitor_quantile_bin(const LatencyMonitor *mon, LatencySource source, uint16_t permille);
+
+/**
+ * @brief 히스토그램 칸의 상한 (us, 마지막 칸은 UINT32_MAX)
+ *
+ * @param bin 칸 번호
+ * @return uint32_t 상한 (us, 미포함)
+ */
+uint32_t latency_monitor_bin_upper_us(uint8_t bin);
+
+/**
+ * @brief 측정원별 지연 통계를 한 줄씩 출력
+ *
+ * @param mon 감시기
+ * @param write 출력 콜백
+ */
+void latency_monitor_report(const LatencyMonitor *mon, ProfileWriteFn write);
+
+#endif /* LATENCY_MONITOR_H */
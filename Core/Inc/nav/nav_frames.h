@@ -0,0 +1,156 @@
+/**
+ * @file nav_frames.h
+ * @brief 항법 해의 다중 좌표 표현 (오일러 각, DCM, ECEF, 측지 좌표) 지연 계산
+ *
+ * 소비자마다 필요한 표현이 다르다 (제어는 NED와 사원수, 조작자 표시는 오일러 각,
+ * 텔레메트리는 위경도). ekf_get_euler처럼 매 호출 삼각함수를 다시 계산하지 않도록,
+ * 독자 쪽에서 게시된 스냅샷을 하나 들고 있고 각 표현은 그 스냅샷(게시 시퀀스)에서
+ * 처음 요청될 때 한 번만 계산해 유효 비트와 함께 저장한다. 새 스냅샷을 받으면 유효
+ * 비트만 지운다.
+ *
+ * - 오일러 각: quaternion_to_euler_fast (fast_math.h 다항식, 오차 2.5e-6 rad 이내)
+ * - DCM: quaternion_to_rotation_matrix (곱셈만)
+ * - ECEF/측지: geodetic_ned_to_ecef / geodetic_from_ned (1e-7 deg 해상도가 필요해 배정밀도)
+ * - 자세 불확도: p_quat(사원수 4x4 공분산)를 몸체 좌표계 회전각 오차 공분산
+ *   Pθ = 4 Xi^T Pq Xi로 옮기고, DCM 원소로 만든 오일러 자코비안으로 각도별 표준 편차를 구함
+ *
+ * NavFrames는 독자 하나가 소유한다 (태스크 사이에 공유하지 않음). 게시 버퍼는 그대로
+ * 무잠금 단일 작성자 구조이며, nav_frames_update는 시퀀스가 바뀌지 않았으면 복사하지 않는다.
+ */
+
+#ifndef NAV_FRAMES_H
+#define NAV_FRAMES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nav/nav_publisher.h"
+#include "nav/geodetic.h"
+
+/**
+ * @brief 계산된 표현 유효 비트
+ */
+#define NAV_FRAMES_EULER 0x01u       /**< 오일러 각 */
+#define NAV_FRAMES_DCM 0x02u         /**< 몸체 -> NED 회전 행렬 */
+#define NAV_FRAMES_ECEF 0x04u        /**< ECEF 위치 */
+#define NAV_FRAMES_LLA 0x08u         /**< 측지 좌표 */
+#define NAV_FRAMES_ATT_SIGMA 0x10u   /**< 자세 불확도 */
+
+/**
+ * @brief 오일러 각 불확도를 낼 수 있는 최소 |cos(pitch)| (약 89.4도, 이보다 수직이면 롤/요 불확도 없음)
+ */
+#define NAV_FRAMES_GIMBAL_COS_MIN 0.01f
+
+/**
+ * @brief 자세 불확도
+ *
+ * 오일러 롤/요는 피치 ±90도 근처에서 정의되지 않으므로 (발사대의 로켓), 방위와 기울기는
+ * NED 좌표계 회전각 오차로도 낸다: 방위 = D축 회전, 기울기 = N/E축 회전의 합.
+ */
+typedef struct {
+    float cov[3][3];           /**< 몸체 좌표계 회전각 오차 공분산 (rad^2) */
+    float roll_std;            /**< 롤 표준 편차 (rad, euler_valid일 때만) */
+    float pitch_std;           /**< 피치 표준 편차 (rad) */
+    float yaw_std;             /**< 요 표준 편차 (rad, euler_valid일 때만) */
+    float heading_std;         /**< 방위(D축 회전) 표준 편차 (rad) */
+    float tilt_std;            /**< 기울기(N/E축 회전) 표준 편차 (rad) */
+    bool euler_valid;          /**< 롤/요 표준 편차 유효 여부 */
+} NavAttitudeSigma;
+
+/**
+ * @brief 다중 좌표 표현 캐시
+ */
+typedef struct {
+    EKF_NavSolution sol;       /**< 현재 스냅샷 */
+    uint32_t seq;              /**< 스냅샷의 게시 시퀀스 (0 = 없음) */
+    uint8_t valid;             /**< 계산된 표현 (NAV_FRAMES_* 비트) */
+
+    float roll;                /**< x축 회전 (rad) */
+    float pitch;               /**< y축 회전 (rad) */
+    float yaw;                 /**< z축 회전 (rad) */
+    float dcm[3][3];           /**< 몸체 -> NED 회전 행렬 */
+    double ecef[3];            /**< ECEF 위치 (m) */
+    int32_t lat_e7;            /**< 위도 (1e-7 deg) */
+    int32_t lon_e7;            /**< 경도 (1e-7 deg) */
+    int32_t height_mm;         /**< 타원체 고도 (mm) */
+    NavAttitudeSigma att_sigma; /**< 자세 불확도 */
+
+    const GeodeticFrame *geo;  /**< NED 원점 (NULL이면 ECEF/측지 없음) */
+    uint32_t compute_count;    /**< 표현 계산 횟수 (캐시 적중 확인용) */
+} NavFrames;
+
+/**
+ * @brief 캐시 초기화
+ *
+ * @param frames 캐시 포인터
+ * @param geo NED 원점 (NULL 가능, 측위로 원점이 정해진 뒤 호출자가 유지)
+ * @return bool 성공 여부
+ */
+bool nav_frames_init(NavFrames *frames, const GeodeticFrame *geo);
+
+/**
+ * @brief 최신 게시 스냅샷으로 갱신 (시퀀스가 같으면 아무것도 하지 않음)
+ *
+ * @param frames 캐시 포인터
+ * @param pub 게시 버퍼 포인터
+ * @return bool 유효한 스냅샷을 들고 있는지 (게시 전이거나 읽기 실패 시 이전 스냅샷 유지)
+ */
+bool nav_frames_update(NavFrames *frames, const NavPublisher *pub);
+
+/**
+ * @brief 스냅샷 직접 설정 (게시 버퍼를 거치지 않는 경로, 유효 비트를 지움)
+ *
+ * @param frames 캐시 포인터
+ * @param sol 항법 해
+ * @param seq 스냅샷 식별 번호 (0이 아닌 값, 같은 값을 다시 넘기면 무시)
+ * @return bool 성공 여부
+ */
+bool nav_frames_set(NavFrames *frames, const EKF_NavSolution *sol, uint32_t seq);
+
+/**
+ * @brief 오일러 각 (스냅샷마다 첫 호출에서 계산)
+ *
+ * @param frames 캐시 포인터
+ * @param roll x축 회전 (rad)
+ * @param pitch y축 회전 (rad)
+ * @param yaw z축 회전 (rad)
+ * @return bool 성공 여부 (스냅샷이 없으면 false)
+ */
+bool nav_frames_get_euler(NavFrames *frames, float *roll, float *pitch, float *yaw);
+
+/**
+ * @brief 몸체 -> NED 회전 행렬 (스냅샷마다 첫 호출에서 계산)
+ *
+ * @param frames 캐시 포인터
+ * @return const float (*)[3] 회전 행렬 (다음 갱신까지 유효, 스냅샷이 없으면 NULL)
+ */
+const float (*nav_frames_get_dcm(NavFrames *frames))[3];
+
+/**
+ * @brief ECEF 위치 (스냅샷마다 첫 호출에서 계산)
+ *
+ * @param frames 캐시 포인터
+ * @param ecef ECEF 위치 (m)
+ * @return bool 성공 여부 (스냅샷이나 원점이 없으면 false)
+ */
+bool nav_frames_get_ecef(NavFrames *frames, double ecef[3]);
+
+/**
+ * @brief 측지 좌표 (스냅샷마다 첫 호출에서 계산)
+ *
+ * @param frames 캐시 포인터
+ * @param lat_e7 위도 (1e-7 deg)
+ * @param lon_e7 경도 (1e-7 deg)
+ * @param height_mm 타원체 고도 (mm)
+ * @return bool 성공 여부 (스냅샷이나 원점이 없으면 false)
+ */
+bool nav_frames_get_lla(NavFrames *frames, int32_t *lat_e7, int32_t *lon_e7, int32_t *height_mm);
+
+/**
+ * @brief 자세 불확도 (스냅샷마다 첫 호출에서 계산, DCM 캐시 사용)
+ *
+ * @param frames 캐시 포인터
+ * @return const NavAttitudeSigma* 자세 불확도 (다음 갱신까지 유효, 스냅샷이 없으면 NULL)
+ */
+const NavAttitudeSigma *nav_frames_get_attitude_sigma(NavFrames *frames);
+
+#endif /* NAV_FRAMES_H */
@@ -0,0 +1,86 @@
+/**
+ * @file nav_publisher.h
+ * @brief 시퀀스 카운터 기반 이중 버퍼 항법 해 게시 (단일 작성자, 다중 무잠금 독자)
+ *
+ * 작성자(융합 태스크)는 항상 현재 게시되지 않은 버퍼에 완성된 스냅샷을 쓴 뒤
+ * 시퀀스를 1 증가시켜 게시한다. 독자는 시퀀스를 읽고 seq & 1 버퍼를 복사한 후
+ * 시퀀스를 다시 읽어, 값이 같으면 복사본이 완전한 스냅샷임을 보장받는다.
+ *
+ * - 작성자보다 높은 우선순위의 독자(제어 루프 인터럽트 등)는 작성 중인 버퍼를
+ *   읽지 않으므로 재시도 없이 항상 성공한다.
+ * - 낮은 우선순위의 독자는 복사 도중 두 번 이상 게시되면 재시도한다.
+ *
+ * 인터럽트 비활성화나 잠금이 필요 없으며, 작성자는 독자를 기다리지 않는다.
+ */
+
+#ifndef NAV_PUBLISHER_H
+#define NAV_PUBLISHER_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 독자의 최대 복사 재시도 횟수
+ */
+#define NAV_PUBLISHER_MAX_RETRIES 4
+
+/**
+ * @brief 항법 해 게시 버퍼
+ */
+typedef struct {
+    EKF_NavSolution buffer[2];  /**< 이중 버퍼 (게시된 버퍼 = seq & 1) */
+    atomic_uint_fast32_t seq;   /**< 게시 시퀀스 (작성자 전용 증가, 0 = 게시 전) */
+} NavPublisher;
+
+/**
+ * @brief 게시 버퍼 초기화
+ *
+ * 작성자와 독자가 동작하기 전에 호출해야 한다.
+ *
+ * @param pub 게시 버퍼 포인터
+ * @return bool 성공 여부
+ */
+bool nav_publisher_init(NavPublisher *pub);
+
+/**
+ * @brief 스냅샷 게시 (작성자 전용)
+ *
+ * @param pub 게시 버퍼 포인터
+ * @param sol 게시할 항법 해
+ * @return bool 성공 여부
+ */
+bool nav_publisher_write(NavPublisher *pub, const EKF_NavSolution *sol);
+
+/**
+ * @brief EKF의 현재 항법 해를 스냅샷으로 게시 (작성자 전용)
+ *
+ * 게시되지 않은 버퍼에 직접 채우므로 중간 복사가 없다.
+ *
+ * @param pub 게시 버퍼 포인터
+ * @param ekf EKF 구조체 포인터
+ * @param timestamp_us 해의 유효 시각 (us)
+ * @return bool 성공 여부
+ */
+bool nav_publisher_write_ekf(NavPublisher *pub, const EKF *ekf, uint32_t timestamp_us);
+
+/**
+ * @brief 최신 스냅샷 읽기 (모든 우선순위에서 호출 가능)
+ *
+ * @param pub 게시 버퍼 포인터
+ * @param sol 결과 항법 해
+ * @param seq 읽은 스냅샷의 시퀀스 (NULL 가능, 새 해 여부 판단용)
+ * @return bool 성공 여부 (게시 전이거나 재시도 한도 초과 시 false)
+ */
+bool nav_publisher_read(const NavPublisher *pub, EKF_NavSolution *sol, uint32_t *seq);
+
+/**
+ * @brief 최신 게시 시퀀스 (복사 없이 새 해 여부만 확인할 때)
+ *
+ * @param pub 게시 버퍼 포인터
+ * @return uint32_t 게시 시퀀스 (게시 전이거나 pub이 NULL이면 0)
+ */
+uint32_t nav_publisher_seq(const NavPublisher *pub);
+
+#endif /* NAV_PUBLISHER_H */
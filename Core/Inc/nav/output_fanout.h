@@ -0,0 +1,241 @@
+/**
+ * @file output_fanout.h
+ * @brief 다중 주기 출력 배포 (구독자별 주기/형식, 선택적 앤티에일리어싱, 무잠금 구독자 우편함)
+ *
+ * 제어(1 kHz), CAN(50 Hz), 무선(10 Hz), 기록 상태(5 Hz)처럼 주기와 형식이 다른 소비자가 각자
+ * 게터를 폴링하고 형식을 바꾸는 대신, 출력 예측기(output_predictor_set_fanout)가 샘플마다
+ * output_fanout_feed로 현재 출력을 넘기고 이 모듈이 구독자마다 정한 주기로 우편함에 넣는다.
+ *
+ * - 주기: 구독자마다 다음 게시 시각을 두고, 입력 시각이 그 시각(입력 간격의 절반 여유)에 이르면
+ *   게시한 뒤 주기만큼 민다. 입력이 끊겨 한 주기 넘게 밀리면 다음 입력부터 다시 맞춘다.
+ *   입력 주기보다 빠른 구독자는 입력마다 게시한다.
+ * - 형식 변환: 입력(epoch)마다 필요한 형식만 처음 쓰일 때 한 번 바꾸고, 같은 형식의 구독자는
+ *   그 결과를 복사한다. 앤티에일리어싱 구독자는 자기 평균값을 따로 바꾼다.
+ * - 앤티에일리어싱 (선택): 게시 주기 동안의 입력을 평균(상자 필터, 게시 주파수의 배수에서 영점)해
+ *   위치/속도/자세(부호를 맞춘 사원수 합의 정규화)를 내고 시각은 평균 시각으로 둔다. 나머지 필드
+ *   (바이어스, 공분산, 정점 예측)는 마지막 입력 값이다. 평균은 주기의 절반만큼 늦으므로 제어처럼
+ *   지연에 민감한 구독자는 끈다.
+ * - 우편함: 구독자마다 nav_publisher와 같은 시퀀스 이중 버퍼이다. 생산자는 기다리지 않으며, 읽는
+ *   쪽은 어느 우선순위에서든 output_fanout_read로 최신 메시지를 읽는다 (읽지 않은 메시지는 덮어씀).
+ *   notify를 주면 게시 직후 생산자 문맥에서 부른다 (태스크 알림 등, 짧아야 함).
+ *
+ * 형식:
+ * - NAV: EKF_NavSolution 그대로
+ * - STATE: OutputFanoutState (float 위치/속도/자세/오일러 각)
+ * - PACKED: OutputFanoutPacked (CAN 게시와 같은 눈금의 정수, 무선/CAN 프레임 채우기용)
+ *
+ * output_fanout_subscribe는 입력을 넣기 전에 부르고, output_fanout_feed는 한 문맥(출력 예측기와
+ * 같은 문맥)에서만 부른다.
+ */
+
+#ifndef OUTPUT_FANOUT_H
+#define OUTPUT_FANOUT_H
+
+#include "ekf/ekf.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 최대 구독자 수
+ */
+#ifndef OUTPUT_FANOUT_MAX_SUBSCRIBERS
+#define OUTPUT_FANOUT_MAX_SUBSCRIBERS 6u
+#endif
+
+/**
+ * @brief 구독 주기 한계 (Hz)
+ */
+#define OUTPUT_FANOUT_MAX_RATE_HZ 2000u
+
+/**
+ * @brief 읽는 쪽의 최대 복사 재시도 횟수
+ */
+#define OUTPUT_FANOUT_MAX_RETRIES 4
+
+/**
+ * @brief PACKED 형식 눈금 (can_publisher와 같음)
+ */
+#define OUTPUT_FANOUT_QUAT_LSB (1.0f / 32767.0f)
+#define OUTPUT_FANOUT_POS_LSB 0.01f          /**< m */
+#define OUTPUT_FANOUT_VEL_LSB 0.05f          /**< m/s */
+
+/**
+ * @brief 메시지 형식
+ */
+typedef enum {
+    OUTPUT_FANOUT_FORMAT_NAV = 0,  /**< EKF_NavSolution */
+    OUTPUT_FANOUT_FORMAT_STATE,    /**< OutputFanoutState */
+    OUTPUT_FANOUT_FORMAT_PACKED,   /**< OutputFanoutPacked */
+    OUTPUT_FANOUT_FORMAT_COUNT     /**< 형식 수 */
+} OutputFanoutFormat;
+
+/**
+ * @brief STATE 형식 (56바이트)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 유효 시각 (us) */
+    float pos[3];              /**< 위치 (NED, m) */
+    float vel[3];              /**< 속도 (NED, m/s) */
+    float q[4];                /**< 자세 사원수 (w, x, y, z) */
+    float euler[3];            /**< 롤, 피치, 요 (rad) */
+} OutputFanoutState;
+
+_Static_assert(sizeof(OutputFanoutState) == 56, "OutputFanoutState layout changed");
+
+/**
+ * @brief PACKED 형식 (32바이트, 범위 밖은 포화, NaN은 0)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 유효 시각 (us) */
+    int32_t pos[3];            /**< 위치 (NED, OUTPUT_FANOUT_POS_LSB) */
+    int16_t vel[3];            /**< 속도 (NED, OUTPUT_FANOUT_VEL_LSB) */
+    int16_t q[4];              /**< 자세 사원수 w, x, y, z (OUTPUT_FANOUT_QUAT_LSB) */
+    uint16_t seq;              /**< 구독자 게시 순번 하위 16비트 (끊김 확인용) */
+} OutputFanoutPacked;
+
+_Static_assert(sizeof(OutputFanoutPacked) == 32, "OutputFanoutPacked layout changed");
+
+/**
+ * @brief 우편함 메시지 (형식별 보기)
+ */
+typedef union {
+    EKF_NavSolution nav;       /**< NAV */
+    OutputFanoutState state;   /**< STATE */
+    OutputFanoutPacked packed; /**< PACKED */
+} OutputFanoutMessage;
+
+/**
+ * @brief 게시 알림 콜백 (생산자 문맥)
+ *
+ * @param context 구독 시 넘긴 포인터
+ * @param id 구독자 번호
+ * @param seq 게시 순번
+ */
+typedef void (*OutputFanoutNotifyFn)(void *context, uint8_t id, uint32_t seq);
+
+/**
+ * @brief 구독 설정
+ */
+typedef struct {
+    uint16_t rate_hz;          /**< 게시 주기 (1..OUTPUT_FANOUT_MAX_RATE_HZ) */
+    uint8_t format;            /**< OutputFanoutFormat */
+    bool anti_alias;           /**< 게시 주기 동안 평균 */
+    OutputFanoutNotifyFn notify; /**< 게시 알림 (NULL이면 없음) */
+    void *context;             /**< 알림 인자 */
+} OutputFanoutSubscriberConfig;
+
+/**
+ * @brief 구독자 (우편함 포함)
+ */
+typedef struct {
+    OutputFanoutSubscriberConfig config; /**< 설정 */
+    uint32_t period_us;        /**< 게시 주기 (us) */
+    uint32_t next_us;          /**< 다음 게시 시각 (us) */
+    bool started;              /**< 다음 게시 시각 유효 */
+
+    // 앤티에일리어싱 누적
+    Vector3f pos_sum;          /**< 위치 합 */
+    Vector3f vel_sum;          /**< 속도 합 */
+    float q_sum[4];            /**< 첫 샘플 쪽으로 부호를 맞춘 사원수 합 */
+    uint32_t first_us;         /**< 창 첫 입력 시각 (us) */
+    uint64_t offset_sum_us;    /**< 창 첫 입력 이후 시간 합 (us) */
+    uint16_t n;                /**< 창 입력 수 */
+
+    OutputFanoutMessage box[2]; /**< 우편함 이중 버퍼 (게시된 버퍼 = seq & 1) */
+    atomic_uint_fast32_t seq;  /**< 게시 순번 (0 = 게시 전) */
+} OutputFanoutSubscriber;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t feeds;            /**< 받은 입력 수 */
+    uint32_t posts;            /**< 모든 구독자에 게시한 메시지 수 */
+    uint32_t conversions[OUTPUT_FANOUT_FORMAT_COUNT]; /**< 형식별 변환 수 (입력당 최대 1 + 앤티에일리어싱) */
+    uint32_t resyncs;          /**< 한 주기 넘게 밀려 다시 맞춘 수 */
+} OutputFanoutStats;
+
+/**
+ * @brief 출력 배포기
+ */
+typedef struct {
+    OutputFanoutSubscriber sub[OUTPUT_FANOUT_MAX_SUBSCRIBERS]; /**< 구독자 */
+    uint8_t count;             /**< 구독자 수 */
+
+    uint32_t last_us;          /**< 마지막 입력 시각 (us) */
+    uint32_t last_dt_us;       /**< 마지막 입력 간격 (us) */
+    bool has_input;            /**< 입력을 받았는지 */
+
+    uint32_t epoch;            /**< 입력 번호 (1부터) */
+    OutputFanoutMessage cache[OUTPUT_FANOUT_FORMAT_COUNT]; /**< 이번 입력의 형식별 변환 결과 */
+    uint32_t cache_epoch[OUTPUT_FANOUT_FORMAT_COUNT]; /**< 변환 결과의 입력 번호 (0이면 없음) */
+
+    OutputFanoutStats stats;   /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} OutputFanout;
+
+/**
+ * @brief 배포기 초기화
+ *
+ * @param fan 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool output_fanout_init(OutputFanout *fan);
+
+/**
+ * @brief 구독자 추가 (입력 전)
+ *
+ * @param fan 구조체 포인터
+ * @param config 구독 설정
+ * @param id 구독자 번호 (output_fanout_read 인자)
+ * @return bool 성공 여부 (자리가 없거나 설정이 잘못되면 false)
+ */
+bool output_fanout_subscribe(OutputFanout *fan, const OutputFanoutSubscriberConfig *config, uint8_t *id);
+
+/**
+ * @brief 출력 하나 입력, 주기가 된 구독자 우편함에 게시 (생산자 문맥, 기다리지 않음)
+ *
+ * @param fan 구조체 포인터
+ * @param sol 현재 출력 (출력 예측기 해)
+ * @return uint8_t 이번 입력으로 게시한 구독자 수
+ */
+uint8_t output_fanout_feed(OutputFanout *fan, const EKF_NavSolution *sol);
+
+/**
+ * @brief 구독자의 최신 메시지 읽기 (모든 우선순위에서 호출 가능)
+ *
+ * @param fan 구조체 포인터
+ * @param id 구독자 번호
+ * @param out 결과 (output_fanout_format_size(형식) 바이트)
+ * @param seq 읽은 메시지 순번 (NULL 가능, 새 메시지 여부 판단용)
+ * @return bool 성공 여부 (게시 전이거나 재시도 한도 초과 시 false)
+ */
+bool output_fanout_read(const OutputFanout *fan, uint8_t id, void *out, uint32_t *seq);
+
+/**
+ * @brief 구독자의 최신 게시 순번 (복사 없이 새 메시지 여부만 확인)
+ *
+ * @param fan 구조체 포인터
+ * @param id 구독자 번호
+ * @return uint32_t 게시 순번 (게시 전이거나 잘못된 번호면 0)
+ */
+uint32_t output_fanout_seq(const OutputFanout *fan, uint8_t id);
+
+/**
+ * @brief 형식별 메시지 크기
+ *
+ * @param format OutputFanoutFormat
+ * @return uint16_t 크기 (바이트, 잘못된 형식이면 0)
+ */
+uint16_t output_fanout_format_size(uint8_t format);
+
+/**
+ * @brief 통계
+ *
+ * @param fan 구조체 포인터
+ * @return const OutputFanoutStats* 통계 (NULL이면 NULL)
+ */
+const OutputFanoutStats *output_fanout_get_stats(const OutputFanout *fan);
+
+#endif /* OUTPUT_FANOUT_H */
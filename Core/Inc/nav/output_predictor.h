@@ -0,0 +1,200 @@
+/**
+ * @file output_predictor.h
+ * @brief 최신 EKF 해를 IMU 샘플마다 앞으로 전파하는 저지연 출력 예측기
+ *
+ * 지연 융합을 쓰면 EKF 상태는 융합 시각(과거)의 상태이다. 출력 예측기는 최신 해의
+ * 사본에 IMU 샘플을 하나씩 적용해 현재 시각의 자세/속도/위치를 만들고, 새 해가 오면
+ * 같은 시각의 예측 출력과 비교한 오차를 상보 되먹임으로 조금씩 줄인다.
+ *
+ * - 자세는 AttitudeFast가 담당한다 (같은 설정과 보정 방식).
+ * - 속도/위치는 ekf_predict와 같은 식(바이어스 보정 비력을 회전하고 중력을 뺀 뒤
+ *   속도, 위치 순서로 적분)으로 전파한다.
+ * - 해마다 해 시각의 출력과 비교한 오차를 구한다. 이때 해 시각 이후 이미 적용한
+ *   보정은 빼고, 속도 오차가 지연 구간 동안 위치에 쌓인 몫은 더한다. 이 오차를
+ *   샘플마다 gain x dt 비율만큼 적용한다.
+ * - 첫 해는 오차를 곧바로 반영한다.
+ * - 게시 버퍼가 설정되어 있으면 publish_decimation 샘플마다 현재 출력을 게시한다.
+ *   공분산 대각/정점 예측은 마지막 EKF 해의 값을 그대로 싣는다.
+ * - 배포기(output_fanout.h)가 설정되어 있으면 준비된 뒤 샘플마다 현재 출력을 넘기고,
+ *   구독자별 주기/형식 게시는 배포기가 맡는다.
+ * - 사건 시각 보간기(event_tagger.h)가 설정되어 있으면 준비된 뒤 샘플마다 현재 출력을 이력에
+ *   남긴다.
+ *
+ * 융합 스케줄러의 게시 버퍼를 입력(output_predictor_sync)으로, 별도의 게시 버퍼를
+ * 출력으로 쓰면 두 버퍼 모두 작성자가 하나로 유지된다. 모든 함수는 같은 문맥
+ * (IMU 샘플 처리 또는 제어 루프)에서 호출한다.
+ */
+
+#ifndef OUTPUT_PREDICTOR_H
+#define OUTPUT_PREDICTOR_H
+
+#include "ekf/ekf.h"
+#include "nav/attitude_fast.h"
+#include "nav/nav_publisher.h"
+#include "nav/output_fanout.h"
+#include "nav/event_tagger.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define OUTPUT_PREDICTOR_DEFAULT_VEL_GAIN 5.0f   /**< 속도 오차 감쇠 이득 (1/s) */
+#define OUTPUT_PREDICTOR_DEFAULT_POS_GAIN 5.0f   /**< 위치 오차 감쇠 이득 (1/s) */
+#define OUTPUT_PREDICTOR_DEFAULT_GRAVITY 9.80665f /**< 중력 가속도 (m/s^2, ekf_init과 같음) */
+
+/**
+ * @brief 출력 예측기 설정
+ */
+typedef struct {
+    AttitudeFastConfig attitude; /**< 자세 상보 필터 설정 */
+    float vel_gain;            /**< 속도 오차 감쇠 이득 (1/s) */
+    float pos_gain;            /**< 위치 오차 감쇠 이득 (1/s) */
+    float gravity;             /**< 중력 가속도 (m/s^2) */
+    uint16_t publish_decimation; /**< 게시 간격 (샘플, 1이면 매 샘플) */
+} OutputPredictorConfig;
+
+/**
+ * @brief 속도/위치 이력 항목
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 샘플 시각 (us) */
+    Vector3f pos;              /**< 그 시각의 위치 (m) */
+    Vector3f vel;              /**< 그 시각의 속도 (m/s) */
+    Vector3f pos_applied;      /**< 그 시각까지 적용한 누적 위치 보정 (m) */
+    Vector3f vel_applied;      /**< 그 시각까지 적용한 누적 속도 보정 (m/s) */
+} OutputPredictorSample;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t steps;            /**< 전파한 샘플 수 */
+    uint32_t injections;       /**< 반영한 EKF 해 수 */
+    uint32_t publishes;        /**< 게시 횟수 */
+    uint32_t stale;            /**< 이력보다 오래된 해 수 */
+    float last_pos_error;      /**< 마지막 해의 위치 오차 크기 (m) */
+    float last_vel_error;      /**< 마지막 해의 속도 오차 크기 (m/s) */
+} OutputPredictorStats;
+
+/**
+ * @brief 출력 예측기
+ */
+typedef struct {
+    OutputPredictorConfig config;
+    AttitudeFast attitude;     /**< 자세 상보 필터 */
+    Vector3f pos;              /**< 현재 위치 (m) */
+    Vector3f vel;              /**< 현재 속도 (m/s) */
+    Vector3f accel_bias;       /**< EKF 가속도 바이어스 (m/s^2) */
+    Vector3f pos_error;        /**< 남은 위치 오차 (m) */
+    Vector3f vel_error;        /**< 남은 속도 오차 (m/s) */
+    Vector3f pos_applied;      /**< 적용한 누적 위치 보정 (m) */
+    Vector3f vel_applied;      /**< 적용한 누적 속도 보정 (m/s) */
+    EKF_NavSolution latest;    /**< 마지막 EKF 해 (공분산/정점 예측 전달용) */
+    uint32_t last_us;          /**< 마지막 샘플 시각 */
+    bool ready;                /**< 첫 EKF 해 반영 */
+    uint32_t last_seq;         /**< 마지막으로 반영한 게시 시퀀스 */
+
+    OutputPredictorSample history[ATTITUDE_FAST_HISTORY]; /**< 최근 출력 (환형) */
+    uint16_t head;             /**< 다음 기록 위치 */
+    uint16_t count;            /**< 기록된 항목 수 */
+
+    NavPublisher *publisher;   /**< 출력 게시 버퍼 (NULL이면 게시 안 함) */
+    uint16_t publish_count;    /**< 마지막 게시 이후 샘플 수 */
+    OutputFanout *fanout;      /**< 다중 주기 배포기 (NULL이면 넘기지 않음) */
+    EventTagger *tagger;       /**< 사건 시각 보간기 (NULL이면 기록 안 함) */
+
+    OutputPredictorStats stats;
+} OutputPredictor;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool output_predictor_default_config(OutputPredictorConfig *config);
+
+/**
+ * @brief 출력 예측기 초기화 (첫 EKF 해 전까지 준비 안 됨)
+ *
+ * @param op 출력 예측기
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool output_predictor_init(OutputPredictor *op, const OutputPredictorConfig *config);
+
+/**
+ * @brief 출력 게시 버퍼 설정
+ *
+ * @param op 출력 예측기
+ * @param publisher 게시 버퍼 (NULL이면 게시 안 함, 입력 버퍼와 달라야 함)
+ * @return bool 성공 여부
+ */
+bool output_predictor_set_publisher(OutputPredictor *op, NavPublisher *publisher);
+
+/**
+ * @brief 다중 주기 배포기 설정 (구독은 설정 전에 마침)
+ *
+ * @param op 출력 예측기
+ * @param fanout 배포기 (NULL이면 넘기지 않음)
+ * @return bool 성공 여부
+ */
+bool output_predictor_set_fanout(OutputPredictor *op, OutputFanout *fanout);
+
+/**
+ * @brief 사건 시각 보간기 설정
+ *
+ * @param op 출력 예측기
+ * @param tagger 보간기 (NULL이면 기록 안 함)
+ * @return bool 성공 여부
+ */
+bool output_predictor_set_tagger(OutputPredictor *op, EventTagger *tagger);
+
+/**
+ * @brief IMU 샘플 하나 전파 (필요하면 게시)
+ *
+ * @param op 출력 예측기
+ * @param timestamp_us 샘플 시각 (us)
+ * @param gyro 자이로 측정 (몸체, rad/s)
+ * @param accel 가속도 측정 (몸체, m/s^2)
+ * @return bool 전파했으면 true (첫 샘플이거나 간격 초과 시 false)
+ */
+bool output_predictor_step(OutputPredictor *op, uint32_t timestamp_us, Vector3f gyro, Vector3f accel);
+
+/**
+ * @brief EKF 항법 해 반영
+ *
+ * @param op 출력 예측기
+ * @param sol EKF 항법 해 (timestamp_us 시각의 상태)
+ * @return bool 성공 여부 (IMU 샘플 수신 전이면 false)
+ */
+bool output_predictor_inject(OutputPredictor *op, const EKF_NavSolution *sol);
+
+/**
+ * @brief 입력 게시 버퍼에 새 해가 있으면 반영
+ *
+ * @param op 출력 예측기
+ * @param source 융합 스케줄러의 게시 버퍼
+ * @return bool 새 해를 반영했으면 true
+ */
+bool output_predictor_sync(OutputPredictor *op, const NavPublisher *source);
+
+/**
+ * @brief 현재 출력 (게시하는 것과 같은 항법 해)
+ *
+ * @param op 출력 예측기
+ * @param sol 결과 항법 해
+ * @return bool 유효 여부 (첫 EKF 해 반영 전이면 false)
+ */
+bool output_predictor_get_solution(const OutputPredictor *op, EKF_NavSolution *sol);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param op 출력 예측기
+ * @return const OutputPredictorStats* 통계
+ */
+const OutputPredictorStats *output_predictor_get_stats(const OutputPredictor *op);
+
+#endif /* OUTPUT_PREDICTOR_H */
@@ -0,0 +1,151 @@
+/**
+ * @file predict_rate.h
+ * @brief 기체 동역학에 따른 적응 예측(공분산 전파) 주기
+ *
+ * 관성 비행(코스트)처럼 조용한 구간에서는 IMU 샘플마다 공분산을 전파할 필요가 없고, 추진
+ * 구간에서는 전파 주기를 늘리면 안 된다. IMU 샘플은 항상 코닝/스컬링 보정 사전 적분기
+ * (ekf_preintegration.h)에 전 주기로 누적하고, 비싼 예측(상태 전이 + 공분산 전파)만
+ * 샘플 min_samples..max_samples개마다 한 번으로 바꾼다.
+ *
+ * 활동도 a (0..1, 1이면 전 주기):
+ *   a = max(|ω| / rate_ref, |j| / jerk_ref, ν / nis_ref)
+ * - |ω|: 바이어스를 뺀 각속도 크기
+ * - |j|: 가속도 차분의 저역 통과 크기 (저크, m/s^3)
+ * - ν: 최근 측정 갱신의 NIS/자유도 (predict_rate_note_innovation, 시간 상수 nis_decay_s로 감소)
+ * 목표 간격 n = max_samples / (1 + a (max_samples / min_samples - 1)) 를 [min, max]로 제한하고,
+ * 누적 샘플 수가 n 이상이거나 누적 구간이 max_dt를 넘으면 예측한다. 활동도가 갑자기
+ * 커지면 그 샘플에서 바로 예측하므로 추진 시작이 늦게 반영되지 않는다.
+ *
+ * 측정 갱신 전에는 predict_rate_flush로 누적분을 먼저 예측해 필터 시각을 맞춘다
+ * (fusion_scheduler가 자동 수행).
+ */
+
+#ifndef PREDICT_RATE_H
+#define PREDICT_RATE_H
+
+#include "ekf/ekf.h"
+#include "ekf/ekf_preintegration.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define PREDICT_RATE_DEFAULT_MIN_SAMPLES 1u     /**< 최소 간격 (샘플, 활동도 1) */
+#define PREDICT_RATE_DEFAULT_MAX_SAMPLES 10u    /**< 최대 간격 (샘플, 1 kHz IMU에서 100 Hz 전파) */
+#define PREDICT_RATE_DEFAULT_MAX_DT 0.02f       /**< 최대 누적 구간 (초) */
+#define PREDICT_RATE_DEFAULT_RATE_REF 1.0f      /**< 전 주기가 되는 각속도 (rad/s) */
+#define PREDICT_RATE_DEFAULT_JERK_REF 100.0f    /**< 전 주기가 되는 저크 (m/s^3) */
+#define PREDICT_RATE_DEFAULT_NIS_REF 4.0f       /**< 전 주기가 되는 NIS/자유도 */
+#define PREDICT_RATE_DEFAULT_NIS_DECAY_S 0.5f   /**< 혁신 활동도 감소 시간 상수 (초) */
+#define PREDICT_RATE_DEFAULT_JERK_ALPHA 0.1f    /**< 저크 저역 통과 계수 (샘플마다) */
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint16_t min_samples;      /**< 최소 간격 (샘플, 1 이상) */
+    uint16_t max_samples;      /**< 최대 간격 (샘플, min_samples 이상) */
+    float max_dt;              /**< 최대 누적 구간 (초) */
+    float rate_ref;            /**< 전 주기 각속도 (rad/s) */
+    float jerk_ref;            /**< 전 주기 저크 (m/s^3) */
+    float nis_ref;             /**< 전 주기 NIS/자유도 */
+    float nis_decay_s;         /**< 혁신 활동도 감소 시간 상수 (초) */
+    float jerk_alpha;          /**< 저크 저역 통과 계수 (0..1] */
+} PredictRateConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t samples;          /**< 누적한 IMU 샘플 수 */
+    uint32_t predicts;         /**< 수행한 예측 수 */
+    uint32_t full_rate;        /**< 샘플 하나로 예측한 수 */
+    uint32_t flushes;          /**< 측정 갱신 전 강제 예측 수 */
+    float activity;            /**< 마지막 활동도 (0..1) */
+    uint16_t target;           /**< 마지막 목표 간격 (샘플) */
+} PredictRateStats;
+
+/**
+ * @brief 적응 예측 주기 제어기
+ */
+typedef struct {
+    PredictRateConfig config;  /**< 설정 */
+    EKF_Preintegrator preint;  /**< 전 주기 사전 적분기 */
+    uint32_t last_us;          /**< 마지막 누적 샘플 시각 (us) */
+    Vector3f last_accel;       /**< 직전 가속도 (m/s^2, 저크 계산용) */
+    bool has_accel;            /**< 직전 가속도 유효 */
+    float jerk;                /**< 저역 통과 저크 크기 (m/s^3) */
+    float nis_activity;        /**< 혁신 활동도 (NIS/자유도, 감소 중) */
+    PredictRateStats stats;    /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} PredictRate;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool predict_rate_default_config(PredictRateConfig *config);
+
+/**
+ * @brief 제어기 초기화
+ *
+ * @param rate 제어기
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (간격/계수가 잘못되면 false)
+ */
+bool predict_rate_init(PredictRate *rate, const PredictRateConfig *config);
+
+/**
+ * @brief 최근 측정 갱신의 혁신 크기 반영
+ *
+ * @param rate 제어기
+ * @param nis 정규화 혁신 제곱 (ekf_get_innovation_nis)
+ * @param dof 측정 자유도
+ * @return bool 성공 여부
+ */
+bool predict_rate_note_innovation(PredictRate *rate, float nis, uint8_t dof);
+
+/**
+ * @brief IMU 샘플 누적, 예측할 때가 되면 등가 샘플을 꺼냄
+ *
+ * @param rate 제어기
+ * @param imu IMU 샘플 (dt 포함)
+ * @param timestamp_us 샘플 시각 (us)
+ * @param ekf 필터 (자이로 바이어스 조회, NULL이면 바이어스 0)
+ * @param out 예측에 쓸 등가 IMU 샘플 (true일 때만 채움)
+ * @return bool 이번 샘플에서 예측해야 하면 true
+ */
+bool predict_rate_add(PredictRate *rate, const EKF_ImuSample *imu, uint32_t timestamp_us,
+                      const EKF *ekf, EKF_ImuSample *out);
+
+/**
+ * @brief 누적분 강제 추출 (측정 갱신 전 필터 시각 맞춤)
+ *
+ * @param rate 제어기
+ * @param ekf 필터 (다음 구간 자이로 바이어스 조회, NULL 가능)
+ * @param out 등가 IMU 샘플
+ * @param timestamp_us 마지막 누적 샘플 시각 (us)
+ * @return bool 누적분이 있었으면 true
+ */
+bool predict_rate_flush(PredictRate *rate, const EKF *ekf, EKF_ImuSample *out, uint32_t *timestamp_us);
+
+/**
+ * @brief 누적 중인 샘플 수
+ *
+ * @param rate 제어기
+ * @return uint16_t 샘플 수 (NULL이면 0)
+ */
+uint16_t predict_rate_pending(const PredictRate *rate);
+
+/**
+ * @brief 통계
+ *
+ * @param rate 제어기
+ * @return const PredictRateStats* 통계 (rate가 NULL이면 NULL)
+ */
+const PredictRateStats *predict_rate_get_stats(const PredictRate *rate);
+
+#endif /* PREDICT_RATE_H */
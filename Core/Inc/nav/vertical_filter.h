@@ -0,0 +1,161 @@
+/**
+ * @file vertical_filter.h
+ * @brief 분리된 고속 수직 채널 필터 (고도, 수직 속도, 수직 가속도 바이어스)
+ *
+ * 사출 판정에는 고도와 수직 속도만 필요하므로, 전체 EKF 갱신을 기다리지 않는
+ * 3상태 칼만 필터를 따로 둔다. EKF와 같은 좌표계(z 위쪽 양수)를 쓴다.
+ * - 예측: IMU 샘플마다 EKF 자세의 회전 행렬 셋째 행으로 비력을 변환하고 중력을 빼
+ *   수직 가속도 a = r3 · f - g 를 구한 뒤, 바이어스 b를 빼고 적분한다.
+ *     h += v dt + (a - b) dt^2 / 2,  v += (a - b) dt
+ *   F = [1 dt -dt^2/2; 0 1 -dt; 0 0 1], Q는 가속도 백색 잡음(σ_a)과 바이어스 무작위 행보(σ_b)
+ * - 갱신: 기압 고도 측정마다 H = [1 0 0] 스칼라 갱신 (NIS 게이트)
+ *
+ * 공분산은 대칭 3x3의 여섯 원소를 스칼라로 계산하므로 샘플당 수십 번의 곱셈이면 된다.
+ * 자세만 EKF에서 받고 속도/고도는 EKF와 독립이므로 EKF 위치/속도 갱신이 밀리거나
+ * 거부되어도 사출 판정용 수직 해는 IMU 주기로 계속 나온다.
+ *
+ * 첫 기압 측정(또는 vertical_filter_reset)으로 시작하며, 그 전의 예측은 무시한다.
+ */
+
+#ifndef VERTICAL_FILTER_H
+#define VERTICAL_FILTER_H
+
+#include "math/quaternion.h"
+#include "math/vector3f.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define VERTICAL_FILTER_DEFAULT_ACCEL_STD 0.5f      /**< 수직 가속도 잡음 (m/s^2/√Hz) */
+#define VERTICAL_FILTER_DEFAULT_BIAS_WALK 0.01f     /**< 바이어스 무작위 행보 (m/s^3/√Hz) */
+#define VERTICAL_FILTER_DEFAULT_BARO_STD 1.0f       /**< 기압 고도 측정 표준 편차 (m) */
+#define VERTICAL_FILTER_DEFAULT_NIS_GATE 10.83f     /**< 혁신 게이트 (1자유도 카이제곱 99.9%) */
+#define VERTICAL_FILTER_DEFAULT_INIT_VEL_STD 1.0f   /**< 초기 수직 속도 표준 편차 (m/s) */
+#define VERTICAL_FILTER_DEFAULT_INIT_BIAS_STD 0.2f  /**< 초기 바이어스 표준 편차 (m/s^2) */
+#define VERTICAL_FILTER_DEFAULT_GRAVITY 9.80665f    /**< 중력 가속도 (m/s^2) */
+
+/**
+ * @brief 적분 허용 최대 간격 (초, 넘으면 예측 생략)
+ */
+#define VERTICAL_FILTER_MAX_DT 0.1f
+
+/**
+ * @brief 필터 설정
+ */
+typedef struct {
+    float accel_std;          /**< 수직 가속도 잡음 (m/s^2/√Hz) */
+    float bias_walk;          /**< 바이어스 무작위 행보 (m/s^3/√Hz) */
+    float baro_std;           /**< 기압 고도 측정 표준 편차 (m) */
+    float nis_gate;           /**< 혁신 게이트 (0이면 게이트 없음) */
+    float init_vel_std;       /**< 초기 수직 속도 표준 편차 (m/s) */
+    float init_bias_std;      /**< 초기 바이어스 표준 편차 (m/s^2) */
+    float gravity;            /**< 중력 가속도 (m/s^2) */
+} VerticalFilterConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t predicts;        /**< 수행한 예측 수 */
+    uint32_t baro_updates;    /**< 반영한 기압 측정 수 */
+    uint32_t baro_rejects;    /**< 게이트로 거부한 기압 측정 수 */
+    float last_nis;           /**< 마지막 기압 측정 NIS */
+} VerticalFilterStats;
+
+/**
+ * @brief 수직 채널 필터
+ */
+typedef struct {
+    VerticalFilterConfig config;
+    float alt;                /**< 고도 (m, 위쪽 양수) */
+    float vel;                /**< 수직 속도 (m/s, 위쪽 양수) */
+    float bias;               /**< 수직 가속도 바이어스 (m/s^2) */
+    float accel;              /**< 마지막 바이어스 보정 수직 가속도 (m/s^2) */
+    float P[3][3];            /**< 공분산 (대칭, 고도/속도/바이어스) */
+    float r_baro;             /**< 기압 측정 분산 (m^2) */
+    bool ready;               /**< 초기화 완료 */
+    VerticalFilterStats stats;
+} VerticalFilter;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool vertical_filter_default_config(VerticalFilterConfig *config);
+
+/**
+ * @brief 필터 초기화 (첫 기압 측정 전까지 준비 안 됨)
+ *
+ * @param vf 필터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool vertical_filter_init(VerticalFilter *vf, const VerticalFilterConfig *config);
+
+/**
+ * @brief 상태 재설정 (바이어스 0, 초기 공분산)
+ *
+ * @param vf 필터
+ * @param alt 고도 (m)
+ * @param vel 수직 속도 (m/s)
+ * @return bool 성공 여부
+ */
+bool vertical_filter_reset(VerticalFilter *vf, float alt, float vel);
+
+/**
+ * @brief IMU 샘플 하나로 예측
+ *
+ * @param vf 필터
+ * @param q 몸체 -> 기준 좌표계 자세 (EKF 자세)
+ * @param accel 비력 (몸체, m/s^2)
+ * @param dt 샘플 간격 (초)
+ * @return bool 예측 수행 여부 (준비 전이거나 간격이 범위 밖이면 false)
+ */
+bool vertical_filter_predict(VerticalFilter *vf, Quaternion q, Vector3f accel, float dt);
+
+/**
+ * @brief 기압 고도 측정 갱신 (준비 전이면 이 측정으로 시작)
+ *
+ * @param vf 필터
+ * @param baro_alt 기압 고도 (m)
+ * @return bool 반영 여부 (게이트 거부 시 false)
+ */
+bool vertical_filter_update_baro(VerticalFilter *vf, float baro_alt);
+
+/**
+ * @brief 고도 (m, 위쪽 양수)
+ *
+ * @param vf 필터
+ * @return float 고도 (vf가 NULL이면 0)
+ */
+float vertical_filter_get_altitude(const VerticalFilter *vf);
+
+/**
+ * @brief 수직 속도 (m/s, 위쪽 양수)
+ *
+ * @param vf 필터
+ * @return float 수직 속도 (vf가 NULL이면 0)
+ */
+float vertical_filter_get_velocity(const VerticalFilter *vf);
+
+/**
+ * @brief 준비 여부
+ *
+ * @param vf 필터
+ * @return bool 첫 기압 측정(또는 재설정)을 반영했으면 true
+ */
+bool vertical_filter_is_ready(const VerticalFilter *vf);
+
+/**
+ * @brief 통계
+ *
+ * @param vf 필터
+ * @return const VerticalFilterStats* 통계 (vf가 NULL이면 NULL)
+ */
+const VerticalFilterStats *vertical_filter_get_stats(const VerticalFilter *vf);
+
+#endif /* VERTICAL_FILTER_H */
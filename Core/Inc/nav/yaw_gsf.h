@@ -0,0 +1,179 @@
+/**
+ * @file yaw_gsf.h
+ * @brief GNSS 속도와 IMU 증분으로 방위를 추정하는 가우스 합 가설 뱅크 (비행 중 방위 복구)
+ *
+ * 자력계를 쓸 수 없으면(모터 근처 비활성화, 자기 외란) 방위는 GNSS 속도가 수평
+ * 가속을 보일 때까지 관측되지 않고, 잘못 초기화된 방위는 EKF에서 소각 근사가
+ * 깨져 복구가 매우 느리다. 방위가 2π/N 간격으로 다른 N개의 작은 필터를 나란히
+ * 돌려 각각의 GNSS 속도 우도로 가중치를 갱신하면, 가중 평균 방위가 수평 가속
+ * 몇 초 만에 참값으로 모인다 (PX4 EKF-GSF와 같은 방식).
+ *
+ * - 기울기(롤/피치)는 모든 가설이 공유하는 자이로 적분 자세 하나로 둔다.
+ *   가설 i의 자세는 NED 아래축에 대한 회전 Rz(δ_i)를 공유 자세 앞에 곱한 것이므로
+ *   오일러 특이점(수직 자세)이 없다.
+ * - 가설마다 상태는 (v_N, v_E, δ) 3개뿐이며, 속도 증분의 수평 성분을 Rz(δ_i)로
+ *   돌려 더한다. 공분산은 대칭 6성분이다. 모든 가설 상태를 성분별 배열(SoA)로
+ *   두어 가설 루프가 분기 없이 같은 연산을 반복하며, 예측 단계에는 삼각 함수가
+ *   없다 (cos/sin δ_i는 갱신 때만 다시 계산).
+ * - GNSS 속도 갱신마다 가중치에 혁신 우도를 곱하고 정규화한다. 가중치 하한
+ *   (YAW_GSF_WEIGHT_MIN)으로 한 가설에 수렴한 뒤에도 다른 가설이 살아남아
+ *   잘못 수렴해도 다시 바뀔 수 있다.
+ * - 결과는 가중 원형 평균 보정 δ̄와 분산(가설 분산 + 퍼짐)이며, 분산이
+ *   yaw_var_max보다 작으면 유효하다. 유효한 결과를 ekf_reset_yaw(ekf/ekf_align.h)로
+ *   주 EKF에 주입한다.
+ *
+ * 사용 순서: EKF 자세가 정해진 뒤 yaw_gsf_start(공유 자세, 속도) -> IMU 증분마다
+ * yaw_gsf_predict(바이어스 보정 후) -> GNSS 속도마다 yaw_gsf_update_velocity ->
+ * yaw_gsf_get_attitude가 유효하고 EKF와 차이가 크면 ekf_reset_yaw 후 다시 yaw_gsf_start.
+ * 수평 속도 변화가 없으면(정지, 등속 수직 상승) 가중치가 바뀌지 않으므로 결과는
+ * 퍼진 채로 남으며 유효하지 않다.
+ */
+
+#ifndef YAW_GSF_H
+#define YAW_GSF_H
+
+#include "math/quaternion.h"
+#include "math/vector3f.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 가설 수
+ */
+#define YAW_GSF_MODELS 5
+
+/**
+ * @brief 정규화 후 가중치 하한 (가설 재활성화 허용)
+ */
+#define YAW_GSF_WEIGHT_MIN 1.0e-4f
+
+/**
+ * @brief 가설 분산 하한 (수치 안정성)
+ */
+#define YAW_GSF_VAR_MIN 1.0e-6f
+
+/**
+ * @brief 기본 설정
+ */
+#define YAW_GSF_DEFAULT_ACCEL_STD 2.0f     /**< 속도 증분 잡음 (m/s^2, 진동과 기울기 오차 포함) */
+#define YAW_GSF_DEFAULT_YAW_RATE_STD 0.05f /**< 방위 변화율 잡음 (rad/s, 자이로 바이어스 잔차) */
+#define YAW_GSF_DEFAULT_VEL_STD_MIN 0.5f   /**< GNSS 속도 표준 편차 하한 (m/s) */
+#define YAW_GSF_DEFAULT_YAW_VAR_MAX 0.04f  /**< 유효 판정 방위 분산 (rad^2, 약 11.5도) */
+
+/**
+ * @brief 추정기 설정
+ */
+typedef struct {
+    float accel_std;           /**< 속도 증분 잡음 (m/s^2) */
+    float yaw_rate_std;        /**< 방위 변화율 잡음 (rad/s) */
+    float vel_std_min;         /**< GNSS 속도 표준 편차 하한 (m/s) */
+    float yaw_var_max;         /**< 유효 판정 방위 분산 (rad^2) */
+} YawGsfConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t predicts;         /**< 반영한 IMU 증분 수 */
+    uint32_t updates;          /**< 반영한 GNSS 속도 수 */
+    uint32_t weight_resets;    /**< 우도가 모두 0이 되어 균등 가중치로 되돌린 횟수 */
+} YawGsfStats;
+
+/**
+ * @brief 가설 뱅크 (가설 상태는 성분별 배열)
+ */
+typedef struct {
+    YawGsfConfig config;
+    Quaternion q;              /**< 공유 자세 (몸체 -> NED, 가설 0 기준) */
+    bool started;              /**< yaw_gsf_start 호출 여부 */
+
+    float vn[YAW_GSF_MODELS];  /**< 북쪽 속도 (m/s) */
+    float ve[YAW_GSF_MODELS];  /**< 동쪽 속도 (m/s) */
+    float yaw[YAW_GSF_MODELS]; /**< 아래축 보정 δ (rad, [-π, π]) */
+    float cos_yaw[YAW_GSF_MODELS]; /**< cos δ (갱신 시 계산) */
+    float sin_yaw[YAW_GSF_MODELS]; /**< sin δ (갱신 시 계산) */
+    float p00[YAW_GSF_MODELS]; /**< 공분산 (vn, vn) */
+    float p01[YAW_GSF_MODELS]; /**< 공분산 (vn, ve) */
+    float p02[YAW_GSF_MODELS]; /**< 공분산 (vn, δ) */
+    float p11[YAW_GSF_MODELS]; /**< 공분산 (ve, ve) */
+    float p12[YAW_GSF_MODELS]; /**< 공분산 (ve, δ) */
+    float p22[YAW_GSF_MODELS]; /**< 공분산 (δ, δ) */
+    float weight[YAW_GSF_MODELS]; /**< 가설 가중치 (합 1) */
+
+    YawGsfStats stats;
+} YawGsf;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool yaw_gsf_default_config(YawGsfConfig *config);
+
+/**
+ * @brief 추정기 초기화 (yaw_gsf_start 전까지 예측/갱신 무시)
+ *
+ * @param gsf 추정기
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool yaw_gsf_init(YawGsf *gsf, const YawGsfConfig *config);
+
+/**
+ * @brief 가설 시작 (방위를 균등하게 퍼뜨리고 가중치 균등)
+ *
+ * 가설 i의 보정 δ_i = 2πi/N 이며 δ 분산은 (π/N)^2이다. 기울기만 맞으면 q의 방위는
+ * 아무 값이어도 된다.
+ *
+ * @param gsf 추정기
+ * @param q 공유 자세 초기값 (보통 EKF 자세)
+ * @param vel 속도 초기값 (NED, m/s, 수평 성분 사용)
+ * @param vel_std 속도 표준 편차 (m/s)
+ * @return bool 성공 여부
+ */
+bool yaw_gsf_start(YawGsf *gsf, Quaternion q, Vector3f vel, float vel_std);
+
+/**
+ * @brief IMU 증분 반영 (공유 자세 적분과 가설별 속도/공분산 예측)
+ *
+ * 속도 증분은 구간 시작 몸체 좌표계 기준이며 (ekf_preintegration과 같음),
+ * 중력을 포함한 비력 증분이다. 수평 성분만 쓰므로 중력은 빠진다.
+ *
+ * @param gsf 추정기
+ * @param delta_angle 각도 증분 (몸체, rad, 바이어스 보정 후)
+ * @param delta_velocity 속도 증분 (몸체, m/s, 바이어스 보정 후)
+ * @param dt 구간 길이 (초, 0보다 큼)
+ * @return bool 반영 여부 (시작 전이거나 입력이 유효하지 않으면 false)
+ */
+bool yaw_gsf_predict(YawGsf *gsf, Vector3f delta_angle, Vector3f delta_velocity, float dt);
+
+/**
+ * @brief GNSS 수평 속도로 가설 갱신과 가중치 갱신
+ *
+ * @param gsf 추정기
+ * @param vel GNSS 속도 (NED, m/s, 수평 성분 사용)
+ * @param vel_std GNSS 수평 속도 표준 편차 (m/s, vel_std_min으로 제한)
+ * @return bool 반영 여부
+ */
+bool yaw_gsf_update_velocity(YawGsf *gsf, Vector3f vel, float vel_std);
+
+/**
+ * @brief 가중 평균 방위로 보정한 공유 자세
+ *
+ * @param gsf 추정기
+ * @param q 결과 자세 (Rz(δ̄) ⊗ 공유 자세, NULL 가능)
+ * @param yaw_var 결과 방위 분산 (rad^2, NULL 가능)
+ * @return bool 유효 여부 (시작 전이거나 분산이 yaw_var_max 이상이면 false, 결과는 채움)
+ */
+bool yaw_gsf_get_attitude(const YawGsf *gsf, Quaternion *q, float *yaw_var);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param gsf 추정기
+ * @return const YawGsfStats* 통계
+ */
+const YawGsfStats *yaw_gsf_get_stats(const YawGsf *gsf);
+
+#endif /* YAW_GSF_H */
@@ -0,0 +1,117 @@
+/**
+ * @file accel_blend.h
+ * @brief 주 가속도계 포화 검출과 고중력 가속도계 혼합 (추진 구간)
+ *
+ * 주 IMU 가속도계(저잡음, 예: ±16 g)는 추진 중 축별로 포화되며, 잘린 가속도를 그대로
+ * 적분하면 속도가 크게 틀어져 연소 종료 후 재수렴에 오래 걸린다. 보조 고중력 가속도계
+ * (예: ±200 g, 잡음이 큼)의 샘플을 융합 태스크 입력 단계에서 주 IMU 샘플 시각에 맞춰
+ * 축별로 섞는다.
+ *
+ * 축별 혼합 가중치 w (주 가속도 크기 |a| 기준, range = 주 가속도계 범위):
+ *   w = 0                         |a| <= blend_start * range
+ *   w = 선형 증가                  blend_start * range < |a| < blend_end * range
+ *   w = 1                         |a| >= blend_end * range (포화로 봄)
+ *   a_out = (1 - w) a_primary + w a_high_g
+ * 포화 직전부터 천천히 넘어가므로 출력에 계단이 생기지 않고, 활주 구간에서는 저잡음
+ * 센서만 쓴다.
+ *
+ * 혼합 중에는 출력 잡음이 커지므로 추가 가속도 분산 w^2 σ_hg^2 (축 최대)를 돌려준다.
+ * 고중력 샘플이 없는데 포화된 축이 있으면 주 가속도를 그대로 두고 clip_noise_std^2를
+ * 돌려준다. 호출자(융합 스케줄러)는 이를 ekf_set_velocity_noise_inflation으로 필터에
+ * 알린다.
+ *
+ * 고중력 샘플은 별도 ImuRing(가속도만 사용, 주 IMU와 같은 몸체 좌표계)으로 받으며,
+ * 주 샘플 시각 앞뒤 샘플 사이를 선형 보간한다. 뒤 샘플이 아직 없으면 timeout_us 이내의
+ * 최신 샘플을 그대로 쓴다. 고중력 링의 소비자이므로 융합 태스크에서만 호출해야 한다.
+ */
+
+#ifndef ACCEL_BLEND_H
+#define ACCEL_BLEND_H
+
+#include "math/vector3f.h"
+#include "sensors/imu_ring.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define ACCEL_BLEND_DEFAULT_RANGE (16.0f * 9.80665f) /**< 주 가속도계 범위 (m/s^2, ±16 g) */
+#define ACCEL_BLEND_DEFAULT_START 0.80f              /**< 혼합 시작 (범위 대비) */
+#define ACCEL_BLEND_DEFAULT_END 0.95f                /**< 완전 전환 (범위 대비) */
+#define ACCEL_BLEND_DEFAULT_HIGH_G_NOISE_STD 0.5f    /**< 고중력 가속도계 잡음 (m/s^2) */
+#define ACCEL_BLEND_DEFAULT_CLIP_NOISE_STD 20.0f     /**< 보정 불가 포화 시 가속도 잡음 (m/s^2) */
+#define ACCEL_BLEND_DEFAULT_TIMEOUT_US 5000u         /**< 고중력 샘플 유효 시간 (us) */
+
+/**
+ * @brief 혼합 설정
+ */
+typedef struct {
+    float range;               /**< 주 가속도계 범위 (m/s^2) */
+    float blend_start;         /**< 혼합 시작 (범위 대비, 0..1) */
+    float blend_end;           /**< 완전 전환 (범위 대비, blend_start 초과 1 이하) */
+    float high_g_noise_std;    /**< 고중력 가속도계 잡음 표준 편차 (m/s^2) */
+    float clip_noise_std;      /**< 고중력 샘플 없이 포화된 동안의 가속도 잡음 (m/s^2) */
+    uint32_t timeout_us;       /**< 고중력 샘플 유효 시간 (us) */
+} AccelBlendConfig;
+
+/**
+ * @brief 혼합 통계
+ */
+typedef struct {
+    uint32_t samples;          /**< 처리한 주 샘플 수 */
+    uint32_t blended;          /**< 한 축 이상 고중력 샘플을 섞은 샘플 수 */
+    uint32_t clipped;          /**< 고중력 샘플 없이 포화된 샘플 수 */
+} AccelBlendStats;
+
+/**
+ * @brief 혼합기 상태
+ */
+typedef struct {
+    AccelBlendConfig config;   /**< 설정 */
+    ImuRing *high_g;           /**< 고중력 샘플 입력 링 */
+    ImuSample prev;            /**< 주 샘플 시각 이전(이하)의 고중력 샘플 */
+    ImuSample next;            /**< 가장 최근 고중력 샘플 */
+    bool has_prev;             /**< prev 유효 여부 */
+    bool has_next;             /**< next 유효 여부 */
+    AccelBlendStats stats;     /**< 통계 */
+} AccelBlend;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool accel_blend_default_config(AccelBlendConfig *config);
+
+/**
+ * @brief 혼합기 초기화
+ *
+ * @param blend 혼합기 포인터
+ * @param high_g 고중력 샘플 링
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool accel_blend_init(AccelBlend *blend, ImuRing *high_g, const AccelBlendConfig *config);
+
+/**
+ * @brief 주 가속도 샘플 하나 혼합
+ *
+ * @param blend 혼합기 포인터
+ * @param timestamp_us 주 샘플 시각 (us)
+ * @param accel 주 가속도 (m/s^2, 몸체 좌표계, 제자리 혼합)
+ * @param accel_var 추가 가속도 분산 ((m/s^2)^2, 혼합/포화가 없으면 0)
+ * @return bool 혼합 또는 포화가 있었으면 true
+ */
+bool accel_blend_apply(AccelBlend *blend, uint32_t timestamp_us, Vector3f *accel, float *accel_var);
+
+/**
+ * @brief 혼합 통계
+ *
+ * @param blend 혼합기 포인터
+ * @return const AccelBlendStats* 통계 (blend가 NULL이면 NULL)
+ */
+const AccelBlendStats *accel_blend_get_stats(const AccelBlend *blend);
+
+#endif /* ACCEL_BLEND_H */
@@ -0,0 +1,121 @@
+/**
+ * @file baro_altitude.h
+ * @brief 기압 → 고도 변환 (ISA 구간 다항식 표, 온도 보정, 지상 기준 캡처)
+ *
+ * 표준 대기(ISA, 0..47 km 네 층)의 기압-기하 고도 관계를 기압 옥타브(2의 거듭제곱)마다
+ * 16개 구간으로 나눈 3차 Hermite 다항식 표로 플래시(const)에 둔다. 구간 번호는 float
+ * 기압의 지수와 가수 상위 4비트를 그대로 쓰고, 구간 내 위치는 나머지 가수 비트이므로
+ * 변환 비용은 비트 연산과 곱셈-덧셈 4회이다 (powf/logf 없음). 구간 경계에서 고도와
+ * 기울기가 연속이며, 표 오차는 기온 감률이 바뀌는 층 경계 구간(11 km)에서 최대 3 cm,
+ * 그 밖에서는 단정밀도 반올림 수준(수 mm)이다.
+ *
+ * 표는 Tools/baro/isa_table.c 로 생성한다 (Core/Src/sensors/baro_isa_table.c).
+ *
+ * 지상(발사대) 대기 중 기압과 센서 온도를 창 평균하여 기준으로 삼고, 이후 고도는
+ * 기준 대비 상대 고도(AGL)로 출력한다. 온도 보정은 두 가지이다:
+ * - 대기 온도: 캡처 시 온도와 ISA 온도의 차 ΔT가 기둥 전체에 일정하다고 보고
+ *   ISA 고도 차에 1 + ΔT / T_ISA(구간 중간 고도)를 곱한다 (측고 공식).
+ * - 센서 온도 계수: 기판 발열 등으로 캡처 후 센서 온도가 바뀐 만큼
+ *   기압을 temp_coeff * (T - T_ground) 만큼 보정한다.
+ * 대기 온도 보정은 캡처 때 센서가 외기 온도에 가깝다고 가정한다.
+ */
+
+#ifndef BARO_ALTITUDE_H
+#define BARO_ALTITUDE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 표 범위 (기압 2^9..2^17 Pa, 고도 약 38 km..-2.5 km)
+ */
+#define BARO_ISA_OCTAVE_MIN 9                      /**< 최저 옥타브 지수 (512 Pa) */
+#define BARO_ISA_OCTAVES 8                         /**< 옥타브 수 */
+#define BARO_ISA_SUBDIV_BITS 4                     /**< 옥타브당 구간 수 지수 (16구간) */
+#define BARO_ISA_SEGMENTS (BARO_ISA_OCTAVES << BARO_ISA_SUBDIV_BITS)
+#define BARO_ISA_PRESSURE_MIN 512.0f               /**< 표 하한 기압 (Pa) */
+#define BARO_ISA_PRESSURE_MAX 131072.0f            /**< 표 상한 기압 (Pa, 미포함) */
+
+/**
+ * @brief 기본 지상 기준 캡처 샘플 수 (50 Hz에서 4초)
+ */
+#define BARO_ALTITUDE_DEFAULT_GROUND_SAMPLES 200u
+
+/**
+ * @brief ISA 구간 다항식 표 (Core/Src/sensors/baro_isa_table.c, 생성 파일)
+ *
+ * 구간 k의 고도 h(t) = c0 + t * (c1 + t * (c2 + t * c3)) (m, 기하 고도), t ∈ [0, 1)
+ */
+extern const float baro_isa_table[BARO_ISA_SEGMENTS][4];
+
+/**
+ * @brief 기압 고도 변환기
+ */
+typedef struct {
+    uint16_t ground_samples;   /**< 지상 기준 캡처 샘플 수 */
+    float temp_coeff;          /**< 센서 기압 온도 계수 (Pa/°C, 캡처 온도 기준) */
+
+    uint16_t count;            /**< 현재 캡처 샘플 수 */
+    float alt_ref;             /**< 캡처 첫 샘플 ISA 고도 (m) */
+    float alt_sum;             /**< 첫 샘플 대비 ISA 고도 편차 합 (m) */
+    float temp_sum;            /**< 온도 합 (°C) */
+
+    float ground_alt;          /**< 지상 기준 ISA 고도 (m) */
+    float ground_temp;         /**< 지상 기준 센서 온도 (°C) */
+    float temp_offset;         /**< 지상 대기 온도 - ISA 온도 (K) */
+    bool ground_valid;         /**< 지상 기준 확정 여부 */
+} BaroAltitude;
+
+/**
+ * @brief ISA 기압 고도 (표 조회)
+ *
+ * @param pressure_pa 기압 (Pa, 표 범위 밖이면 경계로 제한)
+ * @return float 해수면 기준 기하 고도 (m)
+ */
+float baro_altitude_isa(float pressure_pa);
+
+/**
+ * @brief 변환기 초기화 및 지상 기준 캡처 시작
+ *
+ * @param baro 변환기
+ * @param ground_samples 지상 기준 캡처 샘플 수 (1 이상)
+ * @param temp_coeff 센서 기압 온도 계수 (Pa/°C, 모르면 0)
+ * @return bool 성공 여부
+ */
+bool baro_altitude_init(BaroAltitude *baro, uint16_t ground_samples, float temp_coeff);
+
+/**
+ * @brief 지상 기준 캡처 다시 시작 (발사대 대기 중 기상 변화 반영)
+ *
+ * 캡처가 끝날 때까지 baro_altitude_update는 고도를 내지 않는다.
+ * 발사 감지 후에는 호출하지 않아야 한다.
+ *
+ * @param baro 변환기
+ * @return bool 성공 여부
+ */
+bool baro_altitude_capture_ground(BaroAltitude *baro);
+
+/**
+ * @brief 지상 기준 직접 설정 (저장된 기준 복원 등)
+ *
+ * @param baro 변환기
+ * @param pressure_pa 지상 기압 (Pa)
+ * @param temp_c 지상 센서 온도 (°C)
+ * @return bool 성공 여부
+ */
+bool baro_altitude_set_ground(BaroAltitude *baro, float pressure_pa, float temp_c);
+
+/**
+ * @brief 기압 샘플 처리
+ *
+ * 캡처 중에는 샘플을 기준 평균에 더하고, 캡처가 끝나면 지상 기준 상대 고도를 낸다.
+ *
+ * @param baro 변환기
+ * @param pressure_pa 기압 (Pa)
+ * @param temp_c 센서 온도 (°C)
+ * @param alt 지상 기준 고도 (m, 위 방향 양수, ekf_update_baro 입력)
+ * @return bool 고도 출력 여부 (캡처 중이거나 잘못된 인자이면 false)
+ */
+bool baro_altitude_update(BaroAltitude *baro, float pressure_pa, float temp_c, float *alt);
+
+#endif /* BARO_ALTITUDE_H */
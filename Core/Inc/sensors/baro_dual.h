@@ -0,0 +1,156 @@
+/**
+ * @file baro_dual.h
+ * @brief 이중 기압계 사전 융합 (일관성 가중 평균, 발산 검출, 단일 고도와 R 배율 출력)
+ *
+ * 정압공 기압계(A, 기준)와 내부 기압계(B)의 고도를 기압 주기마다 하나로 합쳐 EKF에
+ * 한 번만 갱신한다 (두 번 갱신하는 것보다 수직 채널 갱신 비용이 절반).
+ *
+ * 두 센서는 설치 위치 차이(전자 장비 칸 내압, 동압)만큼 고도에 느린 편차가 있으므로
+ * 차이 d = hB - hA의 저역 통과 추정 d_hat을 두고, 잔차 r = d - d_hat으로 일관성을 본다.
+ *   |r| <= gate   : hB - d_hat을 A 기준으로 옮겨 분산 가중 평균, d_hat 갱신
+ *                   분산 = σA² σB² / (σA² + σB²) + wA wB r² (두 센서가 벌어진 만큼 키움)
+ *   |r| > gate    : 불일치. fail_epochs 연속이면 발산으로 보고 한쪽을 배제한다.
+ *                   EKF 예측 고도가 있으면 그에 더 먼 쪽을, 없으면 B를 배제한다.
+ *                   확정 전에는 A만 쓰고 분산에 r²를 더한다.
+ * 배제된 센서는 잔차가 recover_epochs 연속 gate 안으로 들어오면 복귀한다. 한 센서만
+ * 측정이 있는 주기에는 그 센서만 쓴다 (B는 d_hat으로 A 기준에 맞춤).
+ *
+ * 발산 원인은 정압공 막힘/파손(계단, 고정값)과 내부 센서의 일사 가열(빠른 드리프트)이다.
+ * d_hat의 시정수(bias_tau)보다 느린 공통 드리프트는 구별할 수 없다.
+ *
+ * 출력 R 배율은 분산 / ref_std² 이며 호출자가 fusion_scheduler_push_baro_scaled로
+ * 넘긴다 (ref_std = ekf_set_baro_noise에 준 표준 편차).
+ */
+
+#ifndef BARO_DUAL_H
+#define BARO_DUAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define BARO_DUAL_DEFAULT_STD_A 0.5f               /**< 기압계 A 고도 잡음 (m) */
+#define BARO_DUAL_DEFAULT_STD_B 0.8f               /**< 기압계 B 고도 잡음 (m) */
+#define BARO_DUAL_DEFAULT_REF_STD 1.0f             /**< EKF 기압계 R 표준 편차 (m) */
+#define BARO_DUAL_DEFAULT_GATE 5.0f                /**< 일관성 잔차 한계 (m) */
+#define BARO_DUAL_DEFAULT_BIAS_ALPHA 0.02f         /**< 편차 추정 저역 통과 계수 (주기당, 50 Hz에서 약 1초) */
+#define BARO_DUAL_DEFAULT_FAIL_EPOCHS 10u          /**< 발산 확정 연속 불일치 주기 수 */
+#define BARO_DUAL_DEFAULT_RECOVER_EPOCHS 50u       /**< 복귀 연속 일치 주기 수 */
+
+/**
+ * @brief 기압계 번호
+ */
+typedef enum {
+    BARO_DUAL_A = 0,           /**< 정압공 기압계 (기준) */
+    BARO_DUAL_B,               /**< 내부 기압계 */
+    BARO_DUAL_COUNT
+} BaroDualSensor;
+
+/**
+ * @brief 출력에 쓴 센서
+ */
+typedef enum {
+    BARO_DUAL_SOURCE_NONE = 0, /**< 출력 없음 */
+    BARO_DUAL_SOURCE_A,        /**< A만 */
+    BARO_DUAL_SOURCE_B,        /**< B만 (편차 보정) */
+    BARO_DUAL_SOURCE_BOTH      /**< 가중 평균 */
+} BaroDualSource;
+
+/**
+ * @brief 사전 융합 설정
+ */
+typedef struct {
+    float std_a;               /**< 기압계 A 고도 잡음 표준 편차 (m) */
+    float std_b;               /**< 기압계 B 고도 잡음 표준 편차 (m) */
+    float ref_std;             /**< EKF 기압계 R 표준 편차 (m, R 배율 기준) */
+    float gate;                /**< 일관성 잔차 한계 (m) */
+    float bias_alpha;          /**< 편차 추정 저역 통과 계수 (0..1] */
+    uint16_t fail_epochs;      /**< 발산 확정 연속 불일치 주기 수 */
+    uint16_t recover_epochs;   /**< 배제된 센서 복귀 연속 일치 주기 수 */
+} BaroDualConfig;
+
+/**
+ * @brief 주기별 출력
+ */
+typedef struct {
+    float alt;                 /**< 융합 고도 (m, A 기준) */
+    float var;                 /**< 융합 고도 분산 (m^2) */
+    float noise_scale;         /**< EKF 기압계 R 배율 (var / ref_std^2) */
+    float residual;            /**< 일관성 잔차 r (m, 두 측정이 있을 때만, 아니면 0) */
+    BaroDualSource source;     /**< 출력에 쓴 센서 */
+} BaroDualOutput;
+
+/**
+ * @brief 사전 융합 통계
+ */
+typedef struct {
+    uint32_t epochs;           /**< 처리한 주기 수 */
+    uint32_t fused;            /**< 두 센서를 평균한 주기 수 */
+    uint32_t single;           /**< 한 센서만 쓴 주기 수 */
+    uint32_t inconsistent;     /**< 잔차가 gate를 넘은 주기 수 */
+    uint32_t divergences;      /**< 발산 확정 횟수 */
+    uint32_t recoveries;       /**< 배제된 센서 복귀 횟수 */
+} BaroDualStats;
+
+/**
+ * @brief 사전 융합 상태
+ */
+typedef struct {
+    BaroDualConfig config;     /**< 설정 */
+    float bias;                /**< 편차 추정 d_hat = hB - hA (m) */
+    bool bias_valid;           /**< 편차 추정 유효 여부 (첫 동시 측정에서 초기화) */
+    bool failed[BARO_DUAL_COUNT]; /**< 배제된 센서 */
+    uint16_t fail_count;       /**< 연속 불일치 주기 수 */
+    uint16_t recover_count;    /**< 배제 중 연속 일치 주기 수 */
+    BaroDualStats stats;       /**< 통계 */
+} BaroDual;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool baro_dual_default_config(BaroDualConfig *config);
+
+/**
+ * @brief 사전 융합 초기화
+ *
+ * @param dual 사전 융합 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool baro_dual_init(BaroDual *dual, const BaroDualConfig *config);
+
+/**
+ * @brief 기압 주기 하나 융합
+ *
+ * @param dual 사전 융합 상태
+ * @param alt_a 기압계 A 고도 (m, 이 주기에 측정이 없으면 NAN)
+ * @param alt_b 기압계 B 고도 (m, 이 주기에 측정이 없으면 NAN)
+ * @param predicted_alt EKF 예측 고도 (m, 발산 시 배제할 센서 판단용, 없으면 NAN)
+ * @param out 출력
+ * @return bool 출력 고도가 있으면 true (두 센서 모두 없거나 배제되면 false)
+ */
+bool baro_dual_update(BaroDual *dual, float alt_a, float alt_b, float predicted_alt, BaroDualOutput *out);
+
+/**
+ * @brief 센서 배제 여부
+ *
+ * @param dual 사전 융합 상태
+ * @param sensor 기압계 번호
+ * @return bool 배제되었으면 true
+ */
+bool baro_dual_is_failed(const BaroDual *dual, BaroDualSensor sensor);
+
+/**
+ * @brief 사전 융합 통계
+ *
+ * @param dual 사전 융합 상태
+ * @return const BaroDualStats* 통계 (dual이 NULL이면 NULL)
+ */
+const BaroDualStats *baro_dual_get_stats(const BaroDual *dual);
+
+#endif /* BARO_DUAL_H */
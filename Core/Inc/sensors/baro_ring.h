@@ -0,0 +1,81 @@
+/**
+ * @file baro_ring.h
+ * @brief 기압 샘플용 무잠금 단일 생산자/단일 소비자(SPSC) 링 버퍼
+ *
+ * imu_ring과 같은 구조이다. 생산자(기압계 드라이버 인터럽트)는 head만, 소비자(융합 태스크)는
+ * tail만 갱신한다. 소비자는 꺼낸 샘플을 baro_altitude_update로 고도로 바꿔
+ * fusion_scheduler_push_baro에 넘긴다. 버퍼가 가득 차면 새 샘플을 버리고 dropped를 늘린다.
+ */
+
+#ifndef BARO_RING_H
+#define BARO_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 링 버퍼 용량 (2의 거듭제곱)
+ */
+#define BARO_RING_SIZE 16
+
+#if (BARO_RING_SIZE & (BARO_RING_SIZE - 1)) != 0
+#error "BARO_RING_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief 타임스탬프가 붙은 기압 샘플
+ */
+typedef struct {
+    uint32_t timestamp_us; /**< 측정 시각 (us, 기압 변환 구간의 중간) */
+    float pressure_pa;     /**< 보상된 기압 (Pa) */
+    float temperature_c;   /**< 센서 온도 (°C) */
+} BaroSample;
+
+/**
+ * @brief 기압 샘플 링 버퍼
+ */
+typedef struct {
+    BaroSample buffer[BARO_RING_SIZE]; /**< 샘플 저장소 */
+    atomic_uint_fast32_t head;         /**< 다음 쓰기 위치 (생산자 전용) */
+    atomic_uint_fast32_t tail;         /**< 다음 읽기 위치 (소비자 전용) */
+    uint32_t dropped;                  /**< 버퍼 가득 참으로 버려진 샘플 수 (생산자 전용) */
+} BaroRing;
+
+/**
+ * @brief 링 버퍼 초기화
+ *
+ * 생산자와 소비자가 동작하기 전에 호출해야 한다.
+ *
+ * @param ring 링 버퍼 포인터
+ * @return bool 성공 여부
+ */
+bool baro_ring_init(BaroRing *ring);
+
+/**
+ * @brief 샘플 추가 (생산자 전용)
+ *
+ * @param ring 링 버퍼 포인터
+ * @param sample 추가할 샘플
+ * @return bool 성공 여부 (가득 차면 false)
+ */
+bool baro_ring_push(BaroRing *ring, const BaroSample *sample);
+
+/**
+ * @brief 가장 오래된 샘플 꺼내기 (소비자 전용)
+ *
+ * @param ring 링 버퍼 포인터
+ * @param sample 꺼낸 샘플 저장 위치
+ * @return bool 성공 여부 (비어 있으면 false)
+ */
+bool baro_ring_pop(BaroRing *ring, BaroSample *sample);
+
+/**
+ * @brief 저장된 샘플 수 (호출 시점의 근사값)
+ *
+ * @param ring 링 버퍼 포인터
+ * @return uint32_t 샘플 수
+ */
+uint32_t baro_ring_count(const BaroRing *ring);
+
+#endif /* BARO_RING_H */
@@ -0,0 +1,246 @@
+/**
+ * @file dma_poll.h
+ * @brief FIFO 없는 센서용 타이머 구동 SPI DMA 폴링 체인 (센서 묶음마다 인터럽트 한 번)
+ *
+ * FIFO가 없는 자력계/기압계(연속 변환 모드의 LIS3MDL, MMC5983, BMP388, DPS310 등)는 폴링마다
+ * 인터럽트와 차단형 HAL 전송이 필요하다. 이 체인은 한 묶음의 레지스터 블록 읽기(센서마다
+ * 명령 바이트 + 데이터 바이트)를 미리 바이트 슬롯 표로 만들어 두고, 하드웨어만으로 실행한다.
+ *
+ * 구성 (CPU 개입 없음):
+ * - 주 타이머 (사용자 설정, 예: TIM2/TIM15, TRGO = 갱신): 묶음 주기마다 슬롯 타이머를 트리거
+ * - 슬롯 타이머 (TIM1/TIM8/TIM15, 반복 카운터 필요): 트리거 모드 + 단발 모드, RCR = 슬롯 수 - 1
+ *   로 정확히 슬롯 수만큼 주기를 돌고 멈춘다. 슬롯마다
+ *   - cs_channel 비교 일치 -> DMA가 칩 선택 표의 워드를 GPIO BSRR에 씀 (DMA-to-GPIO 칩 선택)
+ *   - tx_channel 비교 일치 -> DMA가 송신 표의 바이트를 SPI DR에 씀
+ * - SPI RXNE -> 수신 DMA가 바이트를 수신 표에 씀. 모든 슬롯을 받으면 전송 완료 인터럽트 한 번
+ *   (dma_poll_handle_irq): 데이터 바이트만 이중 버퍼에 복사해 게시하고 준비 콜백을 부름
+ * 세 DMA 채널은 모두 순환 모드라 다음 묶음에서 다시 설정할 필요가 없다.
+ *
+ * 슬롯 배치: 센서마다 [명령][데이터 length개][간격] (간격 슬롯은 칩 선택을 모두 해제하고 더미
+ * 바이트를 보냄). 슬롯 길이는 칩 선택 설정 시간 + 바이트 전송 시간보다 길어야 한다 (초기화 시
+ * SPI 분주비로 확인). 모든 칩 선택 핀은 같은 GPIO 포트에 있어야 한다 (BSRR 하나).
+ *
+ * 타임스탬프는 묶음 시작 시각(완료 인터럽트 시각 - 체인 길이)이다. SPI 수신 넘침이 보이면
+ * 체인을 다시 시작해 슬롯 정렬을 되찾는다 (resyncs).
+ *
+ * I2C 센서는 타이머로 바이트를 구동할 수 없으므로 이 경로를 쓰지 않는다.
+ * SPI 버스는 이 체인 전용이어야 한다 (IMU FIFO 버스트와 중재하지 않음).
+ *
+ * 연결 예 (CubeMX: 송신/칩 선택 DMA는 메모리->주변장치 순환, 크기 byte/word, 수신 DMA는
+ * 주변장치->메모리 순환 byte, SPI 마스터 8비트, 슬롯 타이머 분주비 0):
+ * - 초기화: dma_poll_init(&poll, &hw, timebase_now_us, NULL), dma_poll_add_read(...) 반복,
+ *   dma_poll_start(&poll), 주 타이머 시작 (HAL_TIM_Base_Start)
+ * - 수신 DMA 채널 IRQHandler: dma_poll_handle_irq(&poll) (HAL_DMA_IRQHandler 대신)
+ * - 읽기: dma_poll_read(&poll, &set) 후 dma_poll_payload_offset으로 센서별 바이트 찾기
+ */
+
+#ifndef DMA_POLL_H
+#define DMA_POLL_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 최대 읽기 수 (센서 레지스터 블록)
+ */
+#define DMA_POLL_MAX_READS 4u
+
+/**
+ * @brief 최대 슬롯 수 (명령 + 데이터 + 간격 합, 반복 카운터 8비트 타이머 한계)
+ */
+#define DMA_POLL_MAX_SLOTS 128u
+
+/**
+ * @brief 최대 데이터 바이트 수 (묶음 전체)
+ */
+#define DMA_POLL_MAX_PAYLOAD 64u
+
+/**
+ * @brief 기본 설정
+ */
+#define DMA_POLL_DEFAULT_SLOT_NS 2000u       /**< 슬롯 길이 (ns) */
+#define DMA_POLL_DEFAULT_CS_SETUP_NS 200u    /**< 칩 선택 후 첫 클럭까지 (ns) */
+#define DMA_POLL_DUMMY_BYTE 0x00u            /**< 데이터/간격 슬롯 송신 바이트 */
+
+/**
+ * @brief 시각 함수 (us, timebase_now_us 등)
+ */
+typedef uint32_t (*DmaPollClockFn)(void);
+
+/**
+ * @brief 묶음 준비 콜백 (인터럽트 문맥, irq_sched_post 등)
+ */
+typedef void (*DmaPollReadyFn)(void *context);
+
+/**
+ * @brief 하드웨어 연결
+ */
+typedef struct {
+    SPI_HandleTypeDef *hspi;   /**< SPI 핸들 (마스터 8비트, hdmarx에 수신 DMA 연결) */
+    TIM_HandleTypeDef *htim;   /**< 슬롯 타이머 (TIM1/TIM8/TIM15, 분주비 0) */
+    uint32_t trigger;          /**< 주 타이머 TRGO 입력 (TIM_TS_ITRx) */
+    uint32_t cs_channel;       /**< 칩 선택 DMA 요청 채널 (TIM_CHANNEL_x) */
+    uint32_t tx_channel;       /**< 송신 DMA 요청 채널 (TIM_CHANNEL_x, cs_channel과 달라야 함) */
+    DMA_HandleTypeDef *cs_dma; /**< 칩 선택 DMA (cs_channel 요청, word, 순환) */
+    DMA_HandleTypeDef *tx_dma; /**< 송신 DMA (tx_channel 요청, byte, 순환) */
+    GPIO_TypeDef *cs_port;     /**< 칩 선택 포트 (모든 센서 공통) */
+} DmaPollHw;
+
+/**
+ * @brief 슬롯 설정
+ */
+typedef struct {
+    uint32_t slot_ns;          /**< 슬롯 길이 (ns) */
+    uint32_t cs_setup_ns;      /**< 칩 선택 후 송신까지 (ns) */
+} DmaPollConfig;
+
+/**
+ * @brief 읽은 묶음
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 묶음 시작 시각 (us) */
+    uint32_t seq;              /**< 묶음 번호 */
+    uint8_t data[DMA_POLL_MAX_PAYLOAD]; /**< 데이터 바이트 (읽기 순서로 이어 붙임) */
+} DmaPollSet;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t sets;             /**< 게시한 묶음 수 */
+    uint32_t dma_errors;       /**< DMA 전송 오류 수 */
+    uint32_t resyncs;          /**< 수신 넘침으로 체인을 다시 시작한 수 */
+} DmaPollStats;
+
+/**
+ * @brief 레지스터 블록 읽기 하나
+ */
+typedef struct {
+    uint16_t cs_pin;           /**< 칩 선택 핀 */
+    uint8_t command;           /**< 명령 바이트 (읽기 비트/자동 증가 비트 포함) */
+    uint8_t length;            /**< 데이터 바이트 수 */
+    uint8_t offset;            /**< 묶음 데이터 안의 위치 */
+} DmaPollRead;
+
+/**
+ * @brief 폴링 체인
+ */
+typedef struct {
+    DmaPollHw hw;                  /**< 하드웨어 연결 */
+    DmaPollConfig config;          /**< 슬롯 설정 */
+    DmaPollClockFn clock;          /**< 시각 함수 */
+    DmaPollReadyFn ready;          /**< 준비 콜백 (NULL 가능) */
+    void *ready_context;           /**< 준비 콜백 문맥 */
+
+    DmaPollRead reads[DMA_POLL_MAX_READS]; /**< 읽기 목록 */
+    uint8_t read_count;            /**< 읽기 수 */
+    uint16_t slot_count;           /**< 슬롯 수 */
+    uint16_t payload_size;         /**< 데이터 바이트 수 */
+    uint16_t payload_slot[DMA_POLL_MAX_PAYLOAD]; /**< 데이터 바이트 -> 슬롯 번호 */
+    uint32_t slot_ticks;           /**< 슬롯 길이 (타이머 틱) */
+    uint32_t tx_ticks;             /**< 슬롯 안 송신 시점 (타이머 틱) */
+    uint32_t chain_us;             /**< 체인 길이 (us) */
+
+    uint32_t cs_table[DMA_POLL_MAX_SLOTS]; /**< 슬롯별 BSRR 값 */
+    uint8_t tx_table[DMA_POLL_MAX_SLOTS];  /**< 슬롯별 송신 바이트 */
+    uint8_t rx_table[DMA_POLL_MAX_SLOTS];  /**< 슬롯별 수신 바이트 */
+
+    DmaPollSet buffer[2];          /**< 게시 이중 버퍼 (게시된 버퍼 = seq & 1) */
+    atomic_uint_fast32_t seq;      /**< 게시 시퀀스 (0 = 게시 전) */
+
+    DmaPollStats stats;            /**< 통계 */
+    bool running;                  /**< 체인 동작 여부 */
+    bool initialized;              /**< 초기화 여부 */
+} DmaPoll;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool dma_poll_default_config(DmaPollConfig *config);
+
+/**
+ * @brief 체인 초기화 (읽기 목록은 비어 있음)
+ *
+ * @param poll 체인
+ * @param hw 하드웨어 연결
+ * @param clock 시각 함수
+ * @param config 슬롯 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (반복 카운터 없는 타이머, 같은 DMA 요청 채널이면 false)
+ */
+bool dma_poll_init(DmaPoll *poll, const DmaPollHw *hw, DmaPollClockFn clock, const DmaPollConfig *config);
+
+/**
+ * @brief 준비 콜백 설정
+ *
+ * @param poll 체인
+ * @param ready 콜백 (NULL이면 해제)
+ * @param context 콜백 문맥
+ * @return bool 성공 여부
+ */
+bool dma_poll_set_ready_callback(DmaPoll *poll, DmaPollReadyFn ready, void *context);
+
+/**
+ * @brief 레지스터 블록 읽기 추가 (정지 상태에서만)
+ *
+ * @param poll 체인
+ * @param cs_pin 칩 선택 핀 (hw.cs_port)
+ * @param command 명령 바이트 (예: 레지스터 | 0x80)
+ * @param length 데이터 바이트 수 (1 이상)
+ * @return bool 성공 여부 (슬롯/데이터 한계를 넘으면 false)
+ */
+bool dma_poll_add_read(DmaPoll *poll, uint16_t cs_pin, uint8_t command, uint8_t length);
+
+/**
+ * @brief 읽기의 묶음 데이터 안 위치
+ *
+ * @param poll 체인
+ * @param index 읽기 번호 (추가 순서)
+ * @return int16_t 위치 (잘못된 번호이면 -1)
+ */
+int16_t dma_poll_payload_offset(const DmaPoll *poll, uint8_t index);
+
+/**
+ * @brief 체인 시작 (슬롯 타이머/DMA/SPI 설정, 이후 주 타이머 트리거마다 묶음 하나)
+ *
+ * @param poll 체인
+ * @return bool 성공 여부 (읽기가 없거나 슬롯이 바이트 전송보다 짧으면 false)
+ */
+bool dma_poll_start(DmaPoll *poll);
+
+/**
+ * @brief 체인 정지 (칩 선택 모두 해제)
+ *
+ * @param poll 체인
+ */
+void dma_poll_stop(DmaPoll *poll);
+
+/**
+ * @brief 수신 DMA 채널 인터럽트 처리 (묶음 게시)
+ *
+ * @param poll 체인
+ */
+void dma_poll_handle_irq(DmaPoll *poll);
+
+/**
+ * @brief 마지막 묶음 읽기 (어느 문맥에서나 가능)
+ *
+ * @param poll 체인
+ * @param set 묶음 저장 위치
+ * @return bool 게시된 묶음이 있으면 true
+ */
+bool dma_poll_read(const DmaPoll *poll, DmaPollSet *set);
+
+/**
+ * @brief 통계
+ *
+ * @param poll 체인
+ * @return const DmaPollStats* 통계 (poll이 NULL이면 NULL)
+ */
+const DmaPollStats *dma_poll_get_stats(const DmaPoll *poll);
+
+#endif /* DMA_POLL_H */
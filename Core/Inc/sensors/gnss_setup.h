@@ -0,0 +1,137 @@
+/**
+ * @file gnss_setup.h
+ * @brief u-blox 수신기 부팅 설정 (UBX-CFG-VALSET, ACK 확인)
+ *
+ * 수신기 공장 설정은 UART1로 NMEA 문장 여러 종류를 보내며, ubx_gnss 파서는 쓰지 않는
+ * 문장도 DMA 버퍼에서 동기 바이트를 찾느라 훑어야 한다. 부팅 때 ubx_gnss_init 전에
+ * 한 번 호출해 다음을 설정한다 (u-blox 9/10 세대 설정 키, RAM 층).
+ * - 보율: 목표 보율로 먼저 확인하고, 응답이 없으면 공장 기본 보율 등 후보 보율로 바꾸어 가며
+ *   CFG-UART1-BAUDRATE를 보낸 뒤 목표 보율에서 다시 확인한다 (보율 변경 자체는 ACK
+ *   전에 적용되므로 목표 보율에서의 CFG-VALGET ACK로 확인).
+ * - 출력: UART1 NMEA 출력/입력을 끄고 UBX만 남긴다. NAV-PVT를 매 해마다 내보내고,
+ *   수신기에 저장돼 있을 수 있는 다른 NAV 메시지는 끈다. raw_measurements이면
+ *   RXM-RAWX, RXM-SFRBX, NAV-CLOCK도 켠다 (강결합 갱신, ekf_update_gnss_raw). relative_position이면
+ *   이동 기준국 구성의 보조 수신기에서 NAV-RELPOSNED도 켠다 (이중 안테나 방위, ekf_update_gnss_heading).
+ * - 주기: 가장 빠른 측정 주기부터 시도해 ACK된 첫 값을 쓴다 (NAK이면 다음 후보).
+ * - 동적 모델: 공중 4g 이하 (CFG-NAVSPG-DYNMODEL).
+ *
+ * 단계마다 ACK-ACK를 기다리며, 제한 시간 안에 응답이 없으면 retries번 다시 보낸다.
+ * 설정은 HAL 폴링 송수신으로 하므로 DMA 수신(ubx_gnss_init) 전에 태스크 시작 전 문맥에서
+ * 호출한다. 실패해도 수신기는 이전 설정으로 계속 동작하므로, 호출자는 통계를 기록하고
+ * (보율이 바뀐 경우 huart 설정도 함께 바뀜) 그대로 ubx_gnss_init을 부른다.
+ */
+
+#ifndef GNSS_SETUP_H
+#define GNSS_SETUP_H
+
+#include "stm32l4xx_hal.h"
+#include "ekf/ekf_config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 측정 주기 후보 수
+ */
+#define GNSS_SETUP_RATE_STEPS 5u
+
+/**
+ * @brief 기본 설정
+ */
+#define GNSS_SETUP_DEFAULT_BAUD_RATE 460800u       /**< 목표 보율 */
+#define GNSS_SETUP_DEFAULT_FACTORY_BAUD 38400u     /**< 수신기 공장 기본 보율 (M9/M10) */
+#define GNSS_SETUP_DEFAULT_MIN_PERIOD_MS 40u       /**< 가장 빠른 측정 주기 (ms, 25 Hz) */
+#define GNSS_SETUP_DEFAULT_DYN_MODEL 8u            /**< 동적 모델 (8 = 공중 4g 이하) */
+#define GNSS_SETUP_DEFAULT_RAW EKF_CONFIG_GNSS_CLOCK /**< 원시 관측 출력 (강결합 구성에서 켬) */
+#define GNSS_SETUP_DEFAULT_RELPOS false            /**< NAV-RELPOSNED 출력 (이중 안테나 보조 수신기에서 켬) */
+#define GNSS_SETUP_DEFAULT_ACK_TIMEOUT_MS 250u     /**< ACK 대기 시간 (ms) */
+#define GNSS_SETUP_DEFAULT_RETRIES 3u              /**< 응답이 없을 때 다시 보낼 횟수 */
+#define GNSS_SETUP_DEFAULT_BAUD_SETTLE_MS 50u      /**< 보율 변경 뒤 대기 (ms) */
+
+/**
+ * @brief 설정 단계
+ */
+typedef enum {
+    GNSS_SETUP_STEP_NONE = 0,  /**< 실패 없음 */
+    GNSS_SETUP_STEP_BAUD,      /**< 보율 */
+    GNSS_SETUP_STEP_MESSAGES,  /**< 출력 메시지 */
+    GNSS_SETUP_STEP_RATE,      /**< 측정 주기 */
+    GNSS_SETUP_STEP_DYN_MODEL  /**< 동적 모델 */
+} GnssSetupStep;
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t baud_rate;        /**< 목표 보율 */
+    uint32_t factory_baud;     /**< 목표 보율에서 응답이 없을 때 먼저 시도할 보율 */
+    uint16_t min_period_ms;    /**< 가장 빠른 측정 주기 (ms, 후보 중 이 값 이상부터 시도) */
+    uint8_t dyn_model;         /**< 동적 모델 (CFG-NAVSPG-DYNMODEL 값) */
+    bool raw_measurements;     /**< RXM-RAWX/SFRBX, NAV-CLOCK 출력 */
+    bool relative_position;    /**< NAV-RELPOSNED 출력 (이동 기준국 보조 수신기) */
+    uint32_t ack_timeout_ms;   /**< ACK 대기 시간 (ms) */
+    uint8_t retries;           /**< 응답이 없을 때 다시 보낼 횟수 */
+    uint32_t baud_settle_ms;   /**< 보율 변경 뒤 대기 (ms) */
+} GnssSetupConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t baud_rate;        /**< 확인된 보율 (0이면 응답 없음) */
+    uint16_t period_ms;        /**< 적용된 측정 주기 (ms, 0이면 적용 실패) */
+    uint32_t acks;             /**< ACK-ACK 수 */
+    uint32_t naks;             /**< ACK-NAK 수 */
+    uint32_t timeouts;         /**< 응답 없이 시간이 지난 수 */
+    uint32_t baud_switches;    /**< 수신기 보율을 바꾼 수 */
+    GnssSetupStep failed_step; /**< 처음 실패한 단계 */
+    bool raw_enabled;          /**< 원시 관측 출력을 켰는지 */
+} GnssSetupStats;
+
+/**
+ * @brief 수신기 설정기
+ */
+typedef struct {
+    UART_HandleTypeDef *huart; /**< 수신기 UART 핸들 */
+    GnssSetupConfig config;    /**< 설정 */
+    GnssSetupStats stats;      /**< 통계 */
+    bool configured;           /**< 모든 단계가 ACK됐는지 */
+    bool initialized;          /**< 초기화 여부 */
+} GnssSetup;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool gnss_setup_default_config(GnssSetupConfig *config);
+
+/**
+ * @brief 설정기 초기화
+ *
+ * @param setup 구조체 포인터
+ * @param huart 수신기 UART 핸들 (DMA 수신 시작 전)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool gnss_setup_init(GnssSetup *setup, UART_HandleTypeDef *huart, const GnssSetupConfig *config);
+
+/**
+ * @brief 수신기 설정 실행 (블로킹, 보율 탐색 시 수 초까지 걸릴 수 있음)
+ *
+ * 성공하면 huart 보율은 목표 보율로 바뀌어 있다.
+ *
+ * @param setup 구조체 포인터
+ * @return bool 성공 여부 (모든 단계 ACK)
+ */
+bool gnss_setup_run(GnssSetup *setup);
+
+/**
+ * @brief 통계
+ *
+ * @param setup 구조체 포인터
+ * @return const GnssSetupStats* 통계 (NULL이면 NULL)
+ */
+const GnssSetupStats *gnss_setup_get_stats(const GnssSetup *setup);
+
+#endif /* GNSS_SETUP_H */
@@ -0,0 +1,108 @@
+/**
+ * @file gyro_notch.h
+ * @brief 자이로 입력 경로의 재조정 가능한 이차(biquad) 노치 필터 묶음
+ *
+ * 기체 공진은 자이로 스펙트럼에 강한 봉우리로 나타나며 연소에 따라 주파수가 바뀐다.
+ * 드라이버가 링에 넣기 직전 샘플마다 축별로 노치 필터를 적용하고(인터럽트 문맥),
+ * 중심 주파수는 스펙트럼 분석기(gyro_spectrum.h)가 태스크 문맥에서 바꾼다.
+ *
+ * 계수는 두 벌을 두고 태스크가 쓰지 않는 쪽에 새 계수를 계산한 뒤 사용 중인 쪽
+ * 번호를 원자적으로 바꾼다. 인터럽트는 샘플마다 번호를 한 번 읽으므로 절반만 바뀐
+ * 계수를 보지 않는다 (단일 코어에서 인터럽트가 태스크보다 우선). 필터 상태는 계수가
+ * 바뀌어도 유지하여 주파수가 조금씩 움직일 때 출력이 튀지 않게 한다.
+ *
+ * 노치(RBJ): w0 = 2π f0 / fs, α = sin(w0) / (2Q)
+ *   H(z) = (1 - 2cos(w0) z^-1 + z^-2) / ((1 + α) - 2cos(w0) z^-1 + (1 - α) z^-2)
+ * 대역폭은 약 f0 / Q 이다.
+ */
+
+#ifndef GYRO_NOTCH_H
+#define GYRO_NOTCH_H
+
+#include "math/vector3f.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 최대 노치 수
+ */
+#define GYRO_NOTCH_MAX 3
+
+/**
+ * @brief 기본 품질 계수
+ */
+#define GYRO_NOTCH_DEFAULT_Q 3.0f
+
+/**
+ * @brief 노치 하나의 정규화 계수 (a0 = 1)
+ */
+typedef struct {
+    float b0;                  /**< 분자 계수 */
+    float b1;                  /**< 분자 계수 */
+    float b2;                  /**< 분자 계수 (= b0) */
+    float a1;                  /**< 분모 계수 (= b1) */
+    float a2;                  /**< 분모 계수 */
+} GyroNotchCoeffs;
+
+/**
+ * @brief 계수 한 벌
+ */
+typedef struct {
+    GyroNotchCoeffs notch[GYRO_NOTCH_MAX]; /**< 노치별 계수 */
+    float center_hz[GYRO_NOTCH_MAX];       /**< 노치별 중심 주파수 (Hz) */
+    uint8_t count;             /**< 사용하는 노치 수 (0이면 통과) */
+} GyroNotchSet;
+
+/**
+ * @brief 노치 필터 묶음
+ */
+typedef struct {
+    float sample_rate_hz;      /**< 입력 샘플링 주파수 (Hz) */
+    float q;                   /**< 품질 계수 */
+    GyroNotchSet sets[2];      /**< 계수 두 벌 */
+    atomic_uint active;        /**< 인터럽트가 쓰는 계수 번호 */
+    float state[GYRO_NOTCH_MAX][3][2]; /**< 노치/축별 상태 (직접형 II 전치) */
+    uint32_t retunes;          /**< 계수 교체 횟수 */
+} GyroNotch;
+
+/**
+ * @brief 노치 필터 초기화 (노치 없음)
+ *
+ * @param notch 노치 필터 묶음
+ * @param sample_rate_hz 입력 샘플링 주파수 (Hz)
+ * @param q 품질 계수 (양수)
+ * @return bool 성공 여부
+ */
+bool gyro_notch_init(GyroNotch *notch, float sample_rate_hz, float q);
+
+/**
+ * @brief 중심 주파수 설정 (태스크 문맥)
+ *
+ * 나이퀴스트 이상이거나 0 이하인 주파수는 건너뛴다.
+ *
+ * @param notch 노치 필터 묶음
+ * @param center_hz 중심 주파수 배열 (Hz)
+ * @param count 주파수 수 (0이면 모든 노치 해제, 최대 GYRO_NOTCH_MAX)
+ * @return bool 성공 여부
+ */
+bool gyro_notch_set_frequencies(GyroNotch *notch, const float *center_hz, uint8_t count);
+
+/**
+ * @brief 샘플 하나 필터링 (인터럽트 문맥)
+ *
+ * @param notch 노치 필터 묶음
+ * @param gyro 각속도 (제자리 필터링)
+ */
+void gyro_notch_apply(GyroNotch *notch, Vector3f *gyro);
+
+/**
+ * @brief 현재 적용 중인 노치 수와 중심 주파수
+ *
+ * @param notch 노치 필터 묶음
+ * @param center_hz 결과 중심 주파수 (GYRO_NOTCH_MAX개 공간, NULL 가능)
+ * @return uint8_t 노치 수
+ */
+uint8_t gyro_notch_get_frequencies(const GyroNotch *notch, float *center_hz);
+
+#endif /* GYRO_NOTCH_H */
@@ -0,0 +1,169 @@
+/**
+ * @file gyro_spectrum.h
+ * @brief 자이로 스펙트럼 분석과 공진 봉우리 추적 (동적 노치 재조정, 단계 분할 실수 FFT)
+ *
+ * 드라이버가 링에 넣는 (데시메이션 후, 노치 전) 자이로 샘플을 인터럽트 문맥에서
+ * 두 벌의 입력 버퍼에 모으고, 한 벌이 차면 태스크 문맥의 분석기가 가져간다.
+ * 분석은 gyro_spectrum_step 호출마다 한 단계씩 진행하므로 융합 사이클의 남은 예산으로만
+ * 돌릴 수 있다 (융합 스케줄러가 자력계 보정 해 추출과 같은 방식으로 호출).
+ *
+ * 분석 한 번 (축마다 반복 후 봉우리 탐색, 모두 3 x (2 + log2(N/2)) + 1 단계):
+ * - 적재: 평균 제거, Hann 창, 짝/홀 샘플을 실수/허수로 묶고 비트 역순 정렬
+ * - 나비 단계: N/2점 복소 FFT의 기수 2 단계 하나
+ * - 분리: N/2점 복소 결과를 N점 실수 스펙트럼으로 풀고 전력을 세 축 합에 누적
+ * - 봉우리: [min_hz, max_hz]에서 대역 전력 중앙값(잡음 바닥)의 snr배를 넘는 극대값을 큰 순서로
+ *   peaks개까지 고르고, 포물선 보간으로 빈 사이 주파수를 구한다. 주파수 순으로 정렬해
+ *   이전 봉우리와 짝지어 저역 통과하고 노치 필터(gyro_notch.h)를 재조정한다.
+ *   봉우리가 hold번 연속 없으면 노치를 해제한다.
+ *
+ * 입력 버퍼가 분석보다 빨리 차면 그 버퍼를 덮어쓰고 overruns를 늘린다.
+ */
+
+#ifndef GYRO_SPECTRUM_H
+#define GYRO_SPECTRUM_H
+
+#include "math/vector3f.h"
+#include "sensors/gyro_notch.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief FFT 길이 (2의 거듭제곱)
+ */
+#define GYRO_SPECTRUM_FFT_SIZE 128
+
+#if (GYRO_SPECTRUM_FFT_SIZE & (GYRO_SPECTRUM_FFT_SIZE - 1)) != 0 || GYRO_SPECTRUM_FFT_SIZE < 8
+#error "GYRO_SPECTRUM_FFT_SIZE must be a power of two (8 or more)"
+#endif
+
+#define GYRO_SPECTRUM_HALF (GYRO_SPECTRUM_FFT_SIZE / 2)
+
+/**
+ * @brief 기본 설정
+ */
+#define GYRO_SPECTRUM_DEFAULT_MIN_HZ 40.0f     /**< 탐색 하한 (Hz) */
+#define GYRO_SPECTRUM_DEFAULT_MAX_HZ 400.0f    /**< 탐색 상한 (Hz, 나이퀴스트 미만으로 제한) */
+#define GYRO_SPECTRUM_DEFAULT_PEAKS 2          /**< 추적할 봉우리 수 */
+#define GYRO_SPECTRUM_DEFAULT_SNR 10.0f        /**< 대역 전력 중앙값 대비 봉우리 임계 배율 */
+#define GYRO_SPECTRUM_DEFAULT_SMOOTHING 0.5f   /**< 봉우리 주파수 저역 통과 계수 (분석당) */
+#define GYRO_SPECTRUM_DEFAULT_HOLD 3           /**< 봉우리 없이 노치를 유지하는 분석 수 */
+
+/**
+ * @brief 분석 설정
+ */
+typedef struct {
+    float min_hz;              /**< 탐색 하한 (Hz) */
+    float max_hz;              /**< 탐색 상한 (Hz) */
+    uint8_t peaks;             /**< 추적할 봉우리 수 (1..GYRO_NOTCH_MAX) */
+    float snr;                 /**< 봉우리 임계 배율 (1 이상) */
+    float smoothing;           /**< 주파수 저역 통과 계수 (0 초과 1 이하, 1이면 즉시 반영) */
+    uint8_t hold;              /**< 봉우리 없이 노치를 유지하는 분석 수 */
+} GyroSpectrumConfig;
+
+/**
+ * @brief 분석 단계
+ */
+typedef enum {
+    GYRO_SPECTRUM_WAIT = 0,    /**< 입력 버퍼 대기 */
+    GYRO_SPECTRUM_LOAD,        /**< 축 적재 */
+    GYRO_SPECTRUM_STAGE,       /**< 나비 단계 */
+    GYRO_SPECTRUM_SPLIT,       /**< 실수 스펙트럼 분리와 전력 누적 */
+    GYRO_SPECTRUM_PEAKS        /**< 봉우리 탐색과 노치 재조정 */
+} GyroSpectrumPhase;
+
+/**
+ * @brief 분석 통계
+ */
+typedef struct {
+    uint32_t analyses;         /**< 끝난 분석 수 */
+    uint32_t overruns;         /**< 분석 중 덮어쓴 입력 버퍼 수 (생산자 전용) */
+    uint32_t steps;            /**< 수행한 단계 수 */
+} GyroSpectrumStats;
+
+/**
+ * @brief 스펙트럼 분석기
+ */
+typedef struct {
+    GyroSpectrumConfig config; /**< 설정 */
+    float sample_rate_hz;      /**< 입력 샘플링 주파수 (Hz) */
+    GyroNotch *notch;          /**< 재조정할 노치 필터 (NULL이면 봉우리만 추적) */
+
+    float input[2][3][GYRO_SPECTRUM_FFT_SIZE]; /**< 입력 버퍼 두 벌 (축별) */
+    uint8_t write_buf;         /**< 기록 중인 버퍼 (생산자 전용) */
+    uint16_t write_pos;        /**< 기록 위치 (생산자 전용) */
+    uint8_t ready_buf;         /**< 분석할 버퍼 */
+    atomic_bool ready;         /**< 분석할 버퍼가 있음 */
+
+    float window[GYRO_SPECTRUM_FFT_SIZE];      /**< Hann 창 */
+    float twiddle_cos[GYRO_SPECTRUM_HALF];     /**< cos(2πk/N) */
+    float twiddle_sin[GYRO_SPECTRUM_HALF];     /**< sin(2πk/N) */
+    float re[GYRO_SPECTRUM_HALF];              /**< 작업 영역 (실수부) */
+    float im[GYRO_SPECTRUM_HALF];              /**< 작업 영역 (허수부) */
+    float power[GYRO_SPECTRUM_HALF];           /**< 세 축 합 전력 스펙트럼 (빈 0..N/2-1) */
+
+    GyroSpectrumPhase phase;   /**< 현재 단계 */
+    uint8_t axis;              /**< 현재 축 */
+    uint8_t stage;             /**< 현재 나비 단계 */
+
+    float peak_hz[GYRO_NOTCH_MAX]; /**< 추적 중인 봉우리 주파수 (Hz, 오름차순) */
+    uint8_t peak_count;        /**< 추적 중인 봉우리 수 */
+    uint8_t misses;            /**< 봉우리 없이 지난 연속 분석 수 */
+
+    GyroSpectrumStats stats;   /**< 통계 */
+} GyroSpectrum;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool gyro_spectrum_default_config(GyroSpectrumConfig *config);
+
+/**
+ * @brief 분석기 초기화 (창, 회전 인자 표 계산)
+ *
+ * @param spec 분석기 포인터
+ * @param sample_rate_hz 입력 샘플링 주파수 (Hz, 링에 들어가는 속도)
+ * @param notch 재조정할 노치 필터 (NULL 가능)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool gyro_spectrum_init(GyroSpectrum *spec, float sample_rate_hz, GyroNotch *notch,
+                        const GyroSpectrumConfig *config);
+
+/**
+ * @brief 자이로 샘플 하나 추가 (생산자 전용, 인터럽트 문맥)
+ *
+ * @param spec 분석기 포인터
+ * @param gyro 각속도 (rad/s, 노치 전)
+ */
+void gyro_spectrum_push(GyroSpectrum *spec, Vector3f gyro);
+
+/**
+ * @brief 분석 한 단계 진행 (소비자 전용, 태스크 문맥)
+ *
+ * @param spec 분석기 포인터
+ * @return bool 이번 호출에서 분석을 끝냈으면 true
+ */
+bool gyro_spectrum_step(GyroSpectrum *spec);
+
+/**
+ * @brief 추적 중인 봉우리
+ *
+ * @param spec 분석기 포인터
+ * @param peak_hz 결과 주파수 (GYRO_NOTCH_MAX개 공간, NULL 가능)
+ * @return uint8_t 봉우리 수
+ */
+uint8_t gyro_spectrum_get_peaks(const GyroSpectrum *spec, float *peak_hz);
+
+/**
+ * @brief 분석 통계
+ *
+ * @param spec 분석기 포인터
+ * @return const GyroSpectrumStats* 통계 (spec이 NULL이면 NULL)
+ */
+const GyroSpectrumStats *gyro_spectrum_get_stats(const GyroSpectrum *spec);
+
+#endif /* GYRO_SPECTRUM_H */
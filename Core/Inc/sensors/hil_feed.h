@@ -0,0 +1,232 @@
+/**
+ * @file hil_feed.h
+ * @brief HIL(hardware-in-the-loop) 센서 공급기: UART로 받은 센서 레코드를 실시간으로 수집 대기열에 주입
+ *
+ * 호스트 SIL은 대상 CPU 한계를 보지 못하고, 실제 보드는 궤적을 날 수 없다. HIL 빌드에서는 IMU,
+ * 기압계, 자력계, GNSS 드라이버를 초기화하지 않고 이 공급기가 그 자리를 맡는다. 나머지 펌웨어
+ * (측정 대기열 비우기, 융합 스케줄러, 기록, 텔레메트리)는 그대로 돌며, 부하/마감 초과와
+ * 항법 해는 평소 텔레메트리(LOAD 묶음, 항법 묶음)로, 공급기 상태는 HIL 묶음으로 돌아간다.
+ * 호스트 쪽은 Tools/hil/hil_host.c이다. 호스트 없이 보드에 남은 비행 기록을 재생하려면
+ * PIL 재생기(sensors/pil_replay.h)를 쓴다.
+ *
+ * 수신 프레임은 telemetry_frame 형식(종류 HIL_FEED_TYPE_RECORD)이며 페이로드는
+ * 비행 기록 원시 레코드 그대로이다:
+ * @verbatim
+ *   rec_type(u8, FLASH_LOG_REC_IMU/BARO/MAG/GNSS) | FlashLog*Record
+ * @endverbatim
+ * 따라서 flight_sim 합성 기록과 내려받은 비행 기록을 같은 방법으로 보낼 수 있다. 1 kHz IMU는
+ * 프레임 39바이트 x 1000 = 39 kB/s이므로 UART는 460800 bps 이상(또는 USB CDC)이어야 한다.
+ *
+ * 시간 맞추기: 첫 레코드를 받을 때 "로컬 시각 + lead_us - 레코드 시각"을 차이로 잡고, 레코드는
+ * 레코드 시각 + 차이(로컬 시간축)가 되었을 때 그 시각을 붙여 내보낸다. 호스트는 IMU 시각에 맞춰
+ * 보내기만 하면 되고, UART 지연 흔들림은 lead_us와 중계 링(HIL_FEED_STAGE_SIZE)이 흡수한다.
+ * 레코드 시각이 resync_us보다 크게 뒤로/앞으로 뛰면(호스트 재시작) 차이를 다시 잡는다.
+ * 측정 지연을 모사한 레코드(GNSS 등)는 받자마자 지난 시각을 달고 나가므로 실제 드라이버와 같다.
+ * IMU 레코드가 제 시각보다 late_us 넘게 늦게 도착하면 호스트가 실시간을 못 따라간 것으로 센다.
+ *
+ * - IMU/기압/자기장: meas_queue_push_imu/baro/mag (드라이버와 같은 단위: rad/s, m/s^2, Pa, °C, uT)
+ * - GNSS: ubx_gnss_read_fix와 같은 방식의 시퀀스 이중 버퍼 (hil_feed_read_fix)
+ *
+ * 연결 예 (CubeMX: USART RX DMA 순환 모드, USART 전역 인터럽트, IMU 주기 타이머 인터럽트):
+ * - HAL_UARTEx_RxEventCallback: hil_feed_handle_rx_event(&hil, Size, timebase_now_us())
+ * - HAL_UART_ErrorCallback: hil_feed_handle_uart_error(&hil)
+ * - 1 kHz 이상 타이머 인터럽트: hil_feed_service(&hil, timebase_now_us())가 IMU 샘플을 내보냈으면
+ *   rtos_tasks_notify_imu_from_isr (IMU 데이터 준비 인터럽트 대신)
+ * - GNSS 처리 경로: ubx_gnss_read_fix 대신 hil_feed_read_fix
+ * 수신 인터럽트와 타이머 인터럽트는 같은 우선순위이거나 수신이 더 높아야 한다 (중계 링은
+ * 단일 생산자/단일 소비자).
+ */
+
+#ifndef HIL_FEED_H
+#define HIL_FEED_H
+
+#include "stm32l4xx_hal.h"
+#include "log/flash_log.h"
+#include "log/telemetry_frame.h"
+#include "sensors/meas_queue.h"
+#include "sensors/ubx_gnss.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 수신 프레임 종류
+ */
+#define HIL_FEED_TYPE_RECORD 0x10u
+
+/**
+ * @brief DMA 수신 버퍼 크기 (바이트, 수신 이벤트 사이 도착량보다 커야 함)
+ */
+#define HIL_FEED_DMA_SIZE 512u
+
+/**
+ * @brief 중계 링 크기 (레코드, 2의 거듭제곱)
+ */
+#define HIL_FEED_STAGE_SIZE 64u
+
+#if (HIL_FEED_STAGE_SIZE & (HIL_FEED_STAGE_SIZE - 1u)) != 0
+#error "HIL_FEED_STAGE_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief 수신 프레임 최대 크기 (GNSS 레코드 프레임)
+ */
+#define HIL_FEED_FRAME_MAX (TELEMETRY_FRAME_HEADER + 1u + sizeof(FlashLogGnssRecord) + TELEMETRY_FRAME_TRAILER)
+
+/**
+ * @brief GNSS 해 읽기 최대 재시도 횟수
+ */
+#define HIL_FEED_MAX_RETRIES 4
+
+/**
+ * @brief 기본 설정
+ */
+#define HIL_FEED_DEFAULT_LEAD_US 5000u      /**< 첫 레코드 도착부터 첫 배출까지 여유 (us) */
+#define HIL_FEED_DEFAULT_LATE_US 2000u      /**< 늦은 IMU 레코드 판정 (us) */
+#define HIL_FEED_DEFAULT_RESYNC_US 1000000u /**< 시각 차이 다시 잡기 문턱 (us) */
+
+/**
+ * @brief 공급기 설정
+ */
+typedef struct {
+    uint32_t lead_us;          /**< 배출 여유 (us, 지연 흔들림 + 중계 링 보관 시간) */
+    uint32_t late_us;          /**< 늦은 IMU 레코드 판정 (us) */
+    uint32_t resync_us;        /**< 레코드 시각이 이보다 크게 뛰면 시각 차이 다시 잡음 (us) */
+} HilFeedConfig;
+
+/**
+ * @brief 중계 레코드 (로컬 배출 시각 포함)
+ */
+typedef struct {
+    uint32_t due_us;           /**< 배출 시각 (로컬 us, 내보내는 측정 시각) */
+    uint8_t type;              /**< 레코드 종류 (FLASH_LOG_REC_*) */
+    union {
+        FlashLogImuRecord imu; /**< IMU */
+        FlashLogBaroRecord baro; /**< 기압 */
+        FlashLogMagRecord mag; /**< 자기장 */
+        FlashLogGnssRecord gnss; /**< GNSS */
+    } rec;
+} HilFeedItem;
+
+/**
+ * @brief 공급기 통계
+ */
+typedef struct {
+    uint32_t frames;           /**< 받은 레코드 프레임 수 */
+    uint32_t crc_errors;       /**< 동기/길이/CRC가 맞지 않은 프레임 수 */
+    uint32_t bad_records;      /**< 종류나 크기가 맞지 않은 레코드 수 */
+    uint32_t lost;             /**< 프레임 순번으로 본 잃은 프레임 수 */
+    uint32_t overflow;         /**< 중계 링이 가득 차 버린 레코드 수 */
+    uint32_t queue_drops;      /**< 측정 대기열이 받지 않은 레코드 수 */
+    uint32_t late;             /**< 늦게 도착한 IMU 레코드 수 (호스트 실시간 미달) */
+    uint32_t resyncs;          /**< 시각 차이를 다시 잡은 횟수 (첫 레코드 제외) */
+    uint32_t released[MEAS_TYPE_COUNT]; /**< 종류별 내보낸 레코드 수 */
+    uint32_t max_fill;         /**< 중계 링 최대 사용량 */
+    uint32_t uart_errors;      /**< UART 수신 오류 수 */
+} HilFeedStats;
+
+/**
+ * @brief HIL 공급기
+ */
+typedef struct {
+    UART_HandleTypeDef *huart; /**< UART 핸들 (RX DMA 순환 모드) */
+    MeasQueue *queue;          /**< 측정 대기열 */
+    HwCrc *crc;                /**< 프레임 CRC 주변장치 (NULL이면 소프트웨어) */
+    HilFeedConfig config;      /**< 설정 */
+
+    uint8_t dma_buffer[HIL_FEED_DMA_SIZE]; /**< DMA 수신 버퍼 */
+    uint16_t read_index;       /**< 다음 처리 위치 */
+    uint8_t frame[HIL_FEED_FRAME_MAX]; /**< 조립 중인 프레임 */
+    uint16_t frame_len;        /**< 조립한 바이트 수 */
+
+    HilFeedItem stage[HIL_FEED_STAGE_SIZE]; /**< 중계 링 */
+    atomic_uint_fast32_t head; /**< 다음 쓰기 위치 (수신 인터럽트 전용) */
+    atomic_uint_fast32_t tail; /**< 다음 읽기 위치 (서비스 전용) */
+
+    bool anchored;             /**< 시각 차이를 잡았는지 */
+    uint32_t offset_us;        /**< 로컬 시각 - 레코드 시각 (us, 모듈로 2^32) */
+    uint32_t last_rec_us;      /**< 마지막 IMU 레코드 시각 (us) */
+    bool has_seq;              /**< 프레임 순번을 받았는지 */
+    uint16_t last_seq;         /**< 마지막 프레임 순번 */
+
+    UbxGnssFix fix[2];         /**< GNSS 해 이중 버퍼 (게시된 버퍼 = seq & 1) */
+    atomic_uint_fast32_t fix_seq; /**< GNSS 해 게시 시퀀스 (0 = 게시 전) */
+
+    HilFeedStats stats;        /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} HilFeed;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool hil_feed_default_config(HilFeedConfig *config);
+
+/**
+ * @brief 공급기 초기화 및 DMA 수신 시작
+ *
+ * @param hil 구조체 포인터
+ * @param huart UART 핸들 (RX DMA 순환 모드, 텔레메트리 TX와 같은 UART 가능)
+ * @param queue 측정 대기열
+ * @param crc 프레임 CRC 주변장치 (NULL이면 소프트웨어, 다른 문맥이 DMA로 쓰고 있으면 NULL)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool hil_feed_init(HilFeed *hil, UART_HandleTypeDef *huart, MeasQueue *queue, HwCrc *crc,
+                   const HilFeedConfig *config);
+
+/**
+ * @brief UART 수신 이벤트 처리 (HAL_UARTEx_RxEventCallback)
+ *
+ * @param hil 구조체 포인터
+ * @param position DMA 버퍼 쓰기 위치 (Size 인자)
+ * @param now_us 현재 시각 (us, 처음 레코드의 시각 차이 기준)
+ * @return uint32_t 중계 링에 넣은 레코드 수
+ */
+uint32_t hil_feed_handle_rx_event(HilFeed *hil, uint16_t position, uint32_t now_us);
+
+/**
+ * @brief UART 오류 처리 (조립 중인 프레임은 버리고 수신 재시작)
+ *
+ * @param hil 구조체 포인터
+ */
+void hil_feed_handle_uart_error(HilFeed *hil);
+
+/**
+ * @brief 배출 시각이 된 레코드를 수집 대기열로 내보냄 (타이머 인터럽트)
+ *
+ * @param hil 구조체 포인터
+ * @param now_us 현재 시각 (us)
+ * @return uint32_t 이번 호출에서 내보낸 IMU 샘플 수 (융합 태스크 알림 판단)
+ */
+uint32_t hil_feed_service(HilFeed *hil, uint32_t now_us);
+
+/**
+ * @brief 최신 GNSS 해 읽기 (ubx_gnss_read_fix와 같은 규약)
+ *
+ * @param hil 구조체 포인터
+ * @param fix 결과
+ * @param seq 읽은 해의 시퀀스 (NULL 가능, 새 해 여부 판단용)
+ * @return bool 성공 여부 (게시 전이거나 재시도 한도 초과 시 false)
+ */
+bool hil_feed_read_fix(const HilFeed *hil, UbxGnssFix *fix, uint32_t *seq);
+
+/**
+ * @brief 중계 링 사용량
+ *
+ * @param hil 구조체 포인터
+ * @return uint32_t 배출을 기다리는 레코드 수 (NULL이면 0)
+ */
+uint32_t hil_feed_pending(const HilFeed *hil);
+
+/**
+ * @brief 통계
+ *
+ * @param hil 구조체 포인터
+ * @return const HilFeedStats* 통계 (NULL이면 NULL)
+ */
+const HilFeedStats *hil_feed_get_stats(const HilFeed *hil);
+
+#endif /* HIL_FEED_H */
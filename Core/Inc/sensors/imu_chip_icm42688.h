@@ -0,0 +1,132 @@
+/**
+ * @file imu_chip_icm42688.h
+ * @brief ICM-42688-P 칩 모듈 (imu_driver.h가 IMU_DRIVER_CHIP == IMU_CHIP_ICM42688일 때 포함)
+ *
+ * FIFO 패킷 3 형식(헤더 1 + 가속도 6 + 자이로 6 + 온도 1 + 타임스탬프 2)을 쓴다.
+ * 지원 설정:
+ * - ODR: 12.5 Hz는 제외하고 25, 50, 100, 200, 500, 1000, 2000, 4000, 8000 Hz
+ * - 자이로: ±15.625/31.25/62.5는 제외하고 ±125, 250, 500, 1000, 2000 dps
+ * - 가속도: ±2, 4, 8, 16 g
+ * 자이로/가속도 ODR은 같게 둔다. FIFO 워터마크 이상이면 ODR마다 INT1로 알린다.
+ */
+
+#ifndef IMU_CHIP_ICM42688_H
+#define IMU_CHIP_ICM42688_H
+
+#ifndef IMU_DRIVER_H
+#error "include sensors/imu_driver.h instead of the chip module"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief FIFO 프레임 크기 (패킷 3)
+ */
+#define IMU_CHIP_FRAME_SIZE 16
+
+/**
+ * @brief 한 번의 버스트로 읽는 최대 프레임 수
+ */
+#define IMU_CHIP_MAX_FRAMES 32
+
+/**
+ * @brief 기본 설정
+ */
+#define IMU_CHIP_DEFAULT_ODR_HZ 1000
+#define IMU_CHIP_DEFAULT_GYRO_RANGE_DPS 2000
+#define IMU_CHIP_DEFAULT_ACCEL_RANGE_G 16
+#define IMU_CHIP_DEFAULT_FIFO_WATERMARK 8
+
+/**
+ * @brief FIFO 데이터 레지스터와 SPI 읽기 비트
+ */
+#define ICM42688_REG_FIFO_DATA 0x30
+#define ICM42688_SPI_READ      0x80
+
+/**
+ * @brief FIFO 패킷 헤더 비트
+ */
+#define ICM42688_FIFO_HEADER_EMPTY 0x80
+#define ICM42688_FIFO_HEADER_ACCEL 0x40
+#define ICM42688_FIFO_HEADER_GYRO  0x20
+
+/**
+ * @brief 무효 샘플 표시값
+ */
+#define ICM42688_INVALID_SAMPLE (-32768)
+
+/**
+ * @brief FIFO 온도 변환 (°C = raw / 2.07 + 25)
+ */
+#define ICM42688_FIFO_TEMP_SCALE  (1.0f / 2.07f)
+#define ICM42688_FIFO_TEMP_OFFSET 25.0f
+
+/**
+ * @brief 소프트 리셋과 WHO_AM_I 확인
+ *
+ * @param bus SPI 연결
+ * @return bool 성공 여부
+ */
+bool imu_chip_probe(const ImuBus *bus);
+
+/**
+ * @brief 측정/FIFO/인터럽트 설정
+ *
+ * @param bus SPI 연결
+ * @param config 측정 설정
+ * @param scale 결과 LSB 스케일
+ * @return bool 성공 여부 (지원하지 않는 값이면 레지스터를 쓰지 않고 false)
+ */
+bool imu_chip_configure(const ImuBus *bus, const ImuDriverConfig *config, ImuChipScale *scale);
+
+/**
+ * @brief FIFO에 쌓인 프레임 수
+ *
+ * @param bus SPI 연결
+ * @param frames 결과 프레임 수
+ * @return bool 성공 여부
+ */
+bool imu_chip_read_fifo_frames(const ImuBus *bus, uint16_t *frames);
+
+/**
+ * @brief 버스트 첫 바이트 (FIFO 데이터 연속 읽기 명령)
+ */
+static inline uint8_t imu_chip_fifo_read_command(void) {
+    return ICM42688_REG_FIFO_DATA | ICM42688_SPI_READ;
+}
+
+/**
+ * @brief 빅엔디안 16비트 부호 있는 값
+ */
+static inline int16_t imu_chip_be16(const uint8_t *p) {
+    return (int16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+/**
+ * @brief FIFO 프레임 하나 변환
+ *
+ * @param frame 프레임 (IMU_CHIP_FRAME_SIZE 바이트)
+ * @param raw 결과 원시 값
+ * @return bool 유효 여부 (빈 패킷, 가속도/자이로 누락, 무효 표시값이면 false)
+ */
+static inline bool imu_chip_decode_fifo_frame(const uint8_t *frame, ImuRawFrame *raw) {
+    uint8_t header = frame[0];
+    if ((header & ICM42688_FIFO_HEADER_EMPTY) != 0 ||
+        (header & (ICM42688_FIFO_HEADER_ACCEL | ICM42688_FIFO_HEADER_GYRO)) !=
+        (ICM42688_FIFO_HEADER_ACCEL | ICM42688_FIFO_HEADER_GYRO)) {
+        return false;
+    }
+
+    raw->accel[0] = imu_chip_be16(&frame[1]);
+    raw->accel[1] = imu_chip_be16(&frame[3]);
+    raw->accel[2] = imu_chip_be16(&frame[5]);
+    raw->gyro[0] = imu_chip_be16(&frame[7]);
+    raw->gyro[1] = imu_chip_be16(&frame[9]);
+    raw->gyro[2] = imu_chip_be16(&frame[11]);
+    raw->temperature_c = (float)(int8_t)frame[13] * ICM42688_FIFO_TEMP_SCALE + ICM42688_FIFO_TEMP_OFFSET;
+
+    return raw->accel[0] != ICM42688_INVALID_SAMPLE && raw->gyro[0] != ICM42688_INVALID_SAMPLE;
+}
+
+#endif /* IMU_CHIP_ICM42688_H */
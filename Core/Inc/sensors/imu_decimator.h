@@ -0,0 +1,135 @@
+/**
+ * @file imu_decimator.h
+ * @brief 고속 ODR IMU 샘플의 에일리어싱 방지 다상(polyphase) FIR 데시메이션
+ *
+ * 센서를 높은 ODR(예: 8 kHz)로 돌리면 모터/기체 진동이 센서 내부 필터를 지나 들어오는데,
+ * 이를 500 Hz~1 kHz로 그냥 솎으면 진동이 저주파로 접혀(에일리어싱) 바이어스처럼 보인다.
+ * 드라이버의 FIFO 버스트 변환 루프에서 샘플마다 이 단계를 거쳐 factor개 중 하나만
+ * 링에 넣으므로, 링/융합 태스크/ekf_predict_batch는 낮은 속도로만 돈다.
+ *
+ * 필터: 길이 taps의 선형 위상 저역 통과 FIR (Blackman 창 sinc, DC 이득 1).
+ * 차단 주파수는 출력 나이퀴스트의 cutoff배이다. 다상 구조라 출력 시각에만 합성곱을
+ * 계산하므로 입력 샘플당 연산은 채널당 taps/factor회 곱셈-덧셈이다. 이력은 채널별
+ * 두 배 길이 배열에 두 번 써서 창이 항상 연속이며, 내부 루프는 연속 float 배열의
+ * 곱셈-덧셈이라 FPU 파이프라인(또는 SIMD)에 맞는다.
+ *
+ * 군지연: 선형 위상이므로 (taps - 1) / 2 입력 샘플이다. 출력 타임스탬프는 최신 입력
+ * 시각에서 이 지연을 뺀 값이라, 링의 샘플 시각은 필터 출력이 실제로 나타내는 시각이다.
+ * imu_decimator_get_group_delay_us로 지연을 조회할 수 있다 (지연 측정 버퍼 크기 산정용).
+ */
+
+#ifndef IMU_DECIMATOR_H
+#define IMU_DECIMATOR_H
+
+#include "sensors/imu_ring.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 최대 필터 길이 (탭)
+ */
+#define IMU_DECIMATOR_MAX_TAPS 64
+
+/**
+ * @brief 최대 데시메이션 비율
+ */
+#define IMU_DECIMATOR_MAX_FACTOR 16
+
+/**
+ * @brief 채널 수 (자이로 3 + 가속도 3)
+ */
+#define IMU_DECIMATOR_CHANNELS 6
+
+/**
+ * @brief 기본 설정 (8 kHz -> 1 kHz)
+ */
+#define IMU_DECIMATOR_DEFAULT_FACTOR 8
+#define IMU_DECIMATOR_DEFAULT_TAPS 48
+#define IMU_DECIMATOR_DEFAULT_CUTOFF 0.8f   /**< 차단 주파수 (출력 나이퀴스트 대비) */
+
+/**
+ * @brief 데시메이션 설정
+ */
+typedef struct {
+    uint8_t factor;            /**< 데시메이션 비율 (1..IMU_DECIMATOR_MAX_FACTOR) */
+    uint8_t taps;              /**< 필터 길이 (factor 이상 IMU_DECIMATOR_MAX_TAPS 이하) */
+    float cutoff;              /**< 차단 주파수 (출력 나이퀴스트 대비, 0 초과 1 이하) */
+} ImuDecimatorConfig;
+
+/**
+ * @brief 데시메이션 통계
+ */
+typedef struct {
+    uint32_t inputs;           /**< 입력 샘플 수 */
+    uint32_t outputs;          /**< 출력 샘플 수 */
+} ImuDecimatorStats;
+
+/**
+ * @brief 데시메이터 상태
+ */
+typedef struct {
+    ImuDecimatorConfig config; /**< 설정 */
+    float coeffs[IMU_DECIMATOR_MAX_TAPS]; /**< FIR 계수 (대칭, 합 1) */
+    float history[IMU_DECIMATOR_CHANNELS][2 * IMU_DECIMATOR_MAX_TAPS]; /**< 채널별 이력 (두 번 기록) */
+    uint8_t pos;               /**< 다음 기록 위치 (가장 오래된 샘플 위치) */
+    uint8_t phase;             /**< 마지막 출력 이후 입력 수 */
+    uint8_t filled;            /**< 채워진 이력 수 (taps에서 멈춤) */
+    uint32_t group_delay_us;   /**< 군지연 (us) */
+    ImuDecimatorStats stats;   /**< 통계 */
+} ImuDecimator;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool imu_decimator_default_config(ImuDecimatorConfig *config);
+
+/**
+ * @brief 데시메이터 초기화 (계수 설계)
+ *
+ * @param dec 데시메이터 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool imu_decimator_init(ImuDecimator *dec, const ImuDecimatorConfig *config);
+
+/**
+ * @brief 이력 초기화와 입력 주기 설정 (군지연 재계산)
+ *
+ * @param dec 데시메이터 포인터
+ * @param input_period_us 입력 샘플 주기 (us)
+ * @return bool 성공 여부
+ */
+bool imu_decimator_reset(ImuDecimator *dec, uint32_t input_period_us);
+
+/**
+ * @brief 입력 샘플 하나 추가
+ *
+ * 이력이 taps개 찬 뒤 factor개마다 출력 하나를 만든다.
+ *
+ * @param dec 데시메이터 포인터
+ * @param in 입력 샘플
+ * @param out 출력 샘플 (true일 때만 유효, 시각은 군지연 보정)
+ * @return bool 출력 생성 여부
+ */
+bool imu_decimator_push(ImuDecimator *dec, const ImuSample *in, ImuSample *out);
+
+/**
+ * @brief 군지연 (us)
+ *
+ * @param dec 데시메이터 포인터
+ * @return uint32_t 군지연 (dec가 NULL이면 0)
+ */
+uint32_t imu_decimator_get_group_delay_us(const ImuDecimator *dec);
+
+/**
+ * @brief 데시메이션 통계
+ *
+ * @param dec 데시메이터 포인터
+ * @return const ImuDecimatorStats* 통계 (dec가 NULL이면 NULL)
+ */
+const ImuDecimatorStats *imu_decimator_get_stats(const ImuDecimator *dec);
+
+#endif /* IMU_DECIMATOR_H */
@@ -0,0 +1,328 @@
+/**
+ * @file imu_driver.h
+ * @brief 공통 IMU FIFO 버스트 드라이버 (SPI + DMA, 칩은 컴파일 시간에 선택)
+ *
+ * 보드마다 IMU가 달라도(ICM-42688, BMI088, LSM6DSO32 등) 워터마크 인터럽트 -> FIFO
+ * 버스트 DMA -> 프레임 변환 -> 보정 -> 타임스탬프 -> ImuRing의 흐름은 같다. 이 흐름은
+ * 여기서 한 번 구현하고, 칩마다 다른 부분만 칩 모듈(sensors/imu_chip_<칩>.h/.c)이 준다.
+ *
+ * 칩 모듈이 제공하는 것 (IMU_DRIVER_CHIP으로 하나만 선택, 이 헤더가 포함):
+ * - IMU_CHIP_FRAME_SIZE, IMU_CHIP_MAX_FRAMES, IMU_CHIP_DEFAULT_* (기본 설정)
+ * - imu_chip_probe: 소프트 리셋과 WHO_AM_I 확인
+ * - imu_chip_configure: ODR/측정 범위/FIFO 워터마크 설정과 LSB 스케일 반환
+ * - imu_chip_read_fifo_frames: FIFO에 쌓인 프레임 수
+ * - imu_chip_fifo_read_command: 버스트 첫 바이트 (FIFO 데이터 레지스터 읽기)
+ * - imu_chip_decode_fifo_frame: FIFO 프레임 하나 -> 원시 정수와 온도 (static inline,
+ *   버스트 변환 루프에 인라인됨)
+ *
+ * 공통 처리:
+ * - 버스트의 마지막 프레임을 인터럽트 시각으로 보고 앞선 프레임은 ODR 주기만큼씩 거슬러
+ *   타임스탬프를 준다. FIFO 인터럽트 핀을 timebase 입력 캡처 채널에 연결하면 캡처 시각을
+ *   쓸 수 있다 (timebase.h).
+ * - 보드 장착 방향은 IMU_DRIVER_BODY_{X,Y,Z}_AXIS/SIGN으로 정한다 (몸체 축 = 부호 x 센서 축).
+ *   링의 샘플은 몸체 좌표계이다. 보정이 없으면 부호를 LSB 스케일에 접어 축당 곱셈 하나로
+ *   변환하고, 보정이 있으면(imu_driver_set_calibration) F = R_board M s 를 한 번 만들어 두고
+ *   온도가 바뀔 때 오프셋 R_board M b(T)만 다시 계산한다 (imu_thermal_cal.h).
+ * - FIFO 온도는 저역 통과해 보정에 쓴다.
+ * - 데시메이터가 설정되어 있으면(imu_driver_set_decimator) 변환한 샘플을 에일리어싱 방지
+ *   FIR로 걸러 factor개 중 하나만, 군지연을 뺀 시각으로 링에 넣는다 (imu_decimator.h).
+ * - 동적 노치가 설정되어 있으면(imu_driver_set_dynamic_notch) 링에 넣을 자이로를 노치 전에
+ *   스펙트럼 분석기에 넘기고, 분석기가 재조정한 노치 필터를 적용한다 (gyro_spectrum.h).
+ * - 장착 위치 보정이 설정되어 있으면(imu_driver_set_lever_arm) 버스트에서 링에 넣을 샘플을
+ *   모아 한 번에 구심/접선 가속도를 빼고 링에 넣는다 (imu_lever_arm.h).
+ * - 진동 통계가 설정되어 있으면(imu_driver_set_vibration) 변환한 전체 ODR 샘플과 원시 값을
+ *   데시메이션 전에 누적하고 버스트 끝에 창 통계를 게시한다 (imu_vibration.h).
+ *
+ * 연결 예 (CubeMX 생성 콜백에서 호출):
+ * - 초기화: imu_driver_init(&imu, &bus, &ring, NULL)
+ * - HAL_GPIO_EXTI_Callback (FIFO 인터럽트 핀): imu_driver_start_dma_burst(&imu, timestamp_us)
+ * - HAL_SPI_TxRxCpltCallback: imu_driver_handle_dma_complete(&imu)
+ * - HAL_SPI_ErrorCallback: imu_driver_handle_dma_error(&imu)
+ *
+ * 새 칩 추가: imu_chip_<칩>.h/.c를 ICM-42688 모듈과 같은 형식으로 만들고 아래 선택 목록에
+ * 추가한다. 칩 .c 파일은 IMU_DRIVER_CHIP이 그 칩일 때만 컴파일되도록 감싼다.
+ */
+
+#ifndef IMU_DRIVER_H
+#define IMU_DRIVER_H
+
+#include "stm32l4xx_hal.h"
+#include "sensors/imu_ring.h"
+#include "sensors/imu_thermal_cal.h"
+#include "sensors/imu_decimator.h"
+#include "sensors/gyro_notch.h"
+#include "sensors/gyro_spectrum.h"
+#include "sensors/imu_lever_arm.h"
+#include "sensors/imu_vibration.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 지원 칩
+ */
+#define IMU_CHIP_ICM42688 1
+
+/**
+ * @brief 사용할 칩 (빌드 설정에서 재정의)
+ */
+#ifndef IMU_DRIVER_CHIP
+#define IMU_DRIVER_CHIP IMU_CHIP_ICM42688
+#endif
+
+/**
+ * @brief 보드 장착 방향 (몸체 축 = 부호 x 센서 축, 축 번호 0=X 1=Y 2=Z)
+ *
+ * 기본은 센서 축 = 몸체 축이다. 빌드 설정에서 재정의한다.
+ */
+#ifndef IMU_DRIVER_BODY_X_AXIS
+#define IMU_DRIVER_BODY_X_AXIS 0
+#define IMU_DRIVER_BODY_X_SIGN 1
+#define IMU_DRIVER_BODY_Y_AXIS 1
+#define IMU_DRIVER_BODY_Y_SIGN 1
+#define IMU_DRIVER_BODY_Z_AXIS 2
+#define IMU_DRIVER_BODY_Z_SIGN 1
+#endif
+
+_Static_assert(((1 << IMU_DRIVER_BODY_X_AXIS) | (1 << IMU_DRIVER_BODY_Y_AXIS) | (1 << IMU_DRIVER_BODY_Z_AXIS)) == 7,
+               "IMU board orientation must be a permutation of the sensor axes");
+_Static_assert((IMU_DRIVER_BODY_X_SIGN == 1 || IMU_DRIVER_BODY_X_SIGN == -1) &&
+               (IMU_DRIVER_BODY_Y_SIGN == 1 || IMU_DRIVER_BODY_Y_SIGN == -1) &&
+               (IMU_DRIVER_BODY_Z_SIGN == 1 || IMU_DRIVER_BODY_Z_SIGN == -1),
+               "IMU board orientation signs must be +1 or -1");
+
+/**
+ * @brief FIFO 온도 저역 통과 계수 (프레임당, 1 kHz에서 시정수 약 0.1 s)
+ *
+ * FIFO 온도는 분해능이 낮으므로(ICM-42688 약 0.48°C) 걸러서 보정 바이어스가 계단처럼
+ * 바뀌지 않게 한다.
+ */
+#define IMU_DRIVER_TEMP_FILTER_ALPHA 0.01f
+
+/**
+ * @brief SPI 연결
+ */
+typedef struct {
+    SPI_HandleTypeDef *hspi;   /**< SPI 핸들 (DMA 연결 필요) */
+    GPIO_TypeDef *cs_port;     /**< 칩 선택 포트 */
+    uint16_t cs_pin;           /**< 칩 선택 핀 */
+} ImuBus;
+
+/**
+ * @brief 측정 설정 (칩이 지원하는 값만 허용)
+ */
+typedef struct {
+    uint16_t odr_hz;           /**< 출력 데이터 속도 (Hz) */
+    uint16_t gyro_range_dps;   /**< 자이로 범위 (±dps) */
+    uint8_t accel_range_g;     /**< 가속도 범위 (±g) */
+    uint16_t fifo_watermark;   /**< FIFO 워터마크 (프레임 수) */
+} ImuDriverConfig;
+
+/**
+ * @brief FIFO 프레임 하나의 원시 값 (센서 좌표계)
+ */
+typedef struct {
+    int16_t accel[3];          /**< 가속도 (LSB) */
+    int16_t gyro[3];           /**< 자이로 (LSB) */
+    float temperature_c;       /**< 온도 (°C) */
+} ImuRawFrame;
+
+/**
+ * @brief LSB 스케일 (imu_chip_configure 결과)
+ */
+typedef struct {
+    float gyro;                /**< rad/s per LSB */
+    float accel;               /**< m/s^2 per LSB */
+} ImuChipScale;
+
+/**
+ * @brief 레지스터 쓰기 (차단형, 칩 모듈용)
+ *
+ * @param bus SPI 연결
+ * @param reg 레지스터 주소
+ * @param value 값
+ * @return bool 성공 여부
+ */
+bool imu_bus_write_reg(const ImuBus *bus, uint8_t reg, uint8_t value);
+
+/**
+ * @brief 연속 레지스터 읽기 (차단형, 최대 3바이트, 칩 모듈용)
+ *
+ * @param bus SPI 연결
+ * @param reg 첫 레지스터 주소 (읽기 비트는 칩 모듈이 붙임)
+ * @param data 결과
+ * @param len 바이트 수 (1~3)
+ * @return bool 성공 여부
+ */
+bool imu_bus_read_regs(const ImuBus *bus, uint8_t reg, uint8_t *data, uint8_t len);
+
+#if IMU_DRIVER_CHIP == IMU_CHIP_ICM42688
+#include "sensors/imu_chip_icm42688.h"
+#else
+#error "IMU_DRIVER_CHIP: unsupported IMU chip"
+#endif
+
+/**
+ * @brief DMA 전송 상태
+ */
+typedef enum {
+    IMU_DRIVER_DMA_IDLE = 0,   /**< 전송 없음 */
+    IMU_DRIVER_DMA_BUSY = 1    /**< FIFO 버스트 전송 중 */
+} ImuDriverDmaState;
+
+/**
+ * @brief 공통 IMU 드라이버 구조체
+ */
+typedef struct {
+    ImuBus bus;                    /**< SPI 연결 */
+    ImuRing *ring;                 /**< 샘플을 넣을 링 버퍼 */
+    ImuDriverConfig config;        /**< 현재 측정 설정 */
+    ImuChipScale scale;            /**< 현재 LSB 스케일 */
+    uint32_t period_us;            /**< 프레임 간격 (us) */
+
+    volatile ImuDriverDmaState dma_state; /**< DMA 전송 상태 */
+    uint16_t burst_frames;         /**< 진행 중인 버스트의 프레임 수 */
+    uint32_t burst_timestamp_us;   /**< 버스트 마지막 샘플 시각 (인터럽트 시각) */
+
+    uint8_t tx_buffer[1 + IMU_CHIP_FRAME_SIZE * IMU_CHIP_MAX_FRAMES]; /**< DMA 송신 버퍼 */
+    uint8_t rx_buffer[1 + IMU_CHIP_FRAME_SIZE * IMU_CHIP_MAX_FRAMES]; /**< DMA 수신 버퍼 */
+
+    ImuThermalCal *cal;            /**< 온도/스케일 보정 (NULL이면 원시 물리 단위) */
+    float body_scale_gyro[3];      /**< 보정 없는 경로의 몸체 축별 자이로 스케일 (부호 포함) */
+    float body_scale_accel[3];     /**< 보정 없는 경로의 몸체 축별 가속도 스케일 (부호 포함) */
+    float gyro_transform[3][3];    /**< 원시 LSB -> 몸체 자이로 (R_board M s) */
+    float accel_transform[3][3];   /**< 원시 LSB -> 몸체 가속도 (R_board M s) */
+    Vector3f gyro_offset;          /**< 몸체 자이로 오프셋 (R_board M b(T)) */
+    Vector3f accel_offset;         /**< 몸체 가속도 오프셋 (R_board M b(T)) */
+    float temperature_c;           /**< 저역 통과한 FIFO 온도 (°C) */
+    bool has_temperature;          /**< 온도 수신 여부 */
+    ImuDecimator *decimator;       /**< 데시메이션 단계 (NULL이면 ODR 그대로 링에 넣음) */
+    GyroSpectrum *spectrum;        /**< 자이로 스펙트럼 분석기 입력 (NULL이면 없음) */
+    GyroNotch *notch;              /**< 자이로 노치 필터 (NULL이면 없음) */
+    ImuLeverArm *lever_arm;        /**< 장착 위치 보정 (NULL이면 없음) */
+    ImuVibration *vibration;       /**< 진동/포화 통계 (NULL이면 없음) */
+    ImuSample burst_out[IMU_CHIP_MAX_FRAMES]; /**< 버스트에서 링에 넣을 샘플 (장착 위치 보정용) */
+
+    uint32_t overrun_count;        /**< 이전 버스트 진행 중 발생한 인터럽트 수 */
+    uint32_t invalid_count;        /**< 헤더/데이터가 잘못된 프레임 수 */
+    bool initialized;              /**< 초기화 여부 */
+} ImuDriver;
+
+/**
+ * @brief 칩 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool imu_driver_default_config(ImuDriverConfig *config);
+
+/**
+ * @brief 센서 확인, 측정/FIFO 설정
+ *
+ * 차단형 SPI 전송으로 레지스터를 설정한다. 인터럽트를 활성화하기 전에 호출해야 한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param bus SPI 연결
+ * @param ring 샘플 링 버퍼
+ * @param config 측정 설정 (NULL이면 칩 기본 설정)
+ * @return bool 성공 여부 (WHO_AM_I 불일치, 지원하지 않는 설정이면 false)
+ */
+bool imu_driver_init(ImuDriver *imu, const ImuBus *bus, ImuRing *ring, const ImuDriverConfig *config);
+
+/**
+ * @brief 측정 설정 변경 (configure(odr, range, fifo_watermark))
+ *
+ * DMA 전송이 없고 FIFO 인터럽트가 막혀 있을 때 호출해야 한다. 실패하면 이전 설정이
+ * 칩에 일부 남을 수 있으므로 다시 호출한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param config 측정 설정
+ * @return bool 성공 여부 (지원하지 않는 값이면 false)
+ */
+bool imu_driver_configure(ImuDriver *imu, const ImuDriverConfig *config);
+
+/**
+ * @brief 온도/스케일 보정 설정
+ *
+ * 인터럽트를 활성화하기 전, 또는 DMA 전송이 없을 때 호출해야 한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param cal 보정 상태 (imu_thermal_cal_init 완료, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool imu_driver_set_calibration(ImuDriver *imu, ImuThermalCal *cal);
+
+/**
+ * @brief 데시메이션 단계 설정
+ *
+ * 인터럽트를 활성화하기 전, 또는 DMA 전송이 없을 때 호출해야 한다. 현재 ODR 주기로
+ * 데시메이터 이력을 비우고 군지연을 계산한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param decimator 데시메이터 (imu_decimator_init 완료, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool imu_driver_set_decimator(ImuDriver *imu, ImuDecimator *decimator);
+
+/**
+ * @brief 동적 노치 단계 설정
+ *
+ * 인터럽트를 활성화하기 전, 또는 DMA 전송이 없을 때 호출해야 한다. 분석기와 노치의
+ * 샘플링 주파수는 링에 들어가는 속도(데시메이션 후)여야 한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param spectrum 스펙트럼 분석기 (NULL이면 분석 안 함)
+ * @param notch 노치 필터 (NULL이면 필터링 안 함)
+ * @return bool 성공 여부
+ */
+bool imu_driver_set_dynamic_notch(ImuDriver *imu, GyroSpectrum *spectrum, GyroNotch *notch);
+
+/**
+ * @brief 장착 위치(구심/접선 가속도) 보정 설정
+ *
+ * 인터럽트를 활성화하기 전, 또는 DMA 전송이 없을 때 호출해야 한다. 자이로 바이어스는
+ * 융합 태스크가 게시한다 (fusion_scheduler_set_lever_arm).
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param lever_arm 보정 상태 (imu_lever_arm_init 완료, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool imu_driver_set_lever_arm(ImuDriver *imu, ImuLeverArm *lever_arm);
+
+/**
+ * @brief 진동/포화 통계 설정
+ *
+ * 인터럽트를 활성화하기 전, 또는 DMA 전송이 없을 때 호출해야 한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param vibration 통계 상태 (imu_vibration_init 완료, NULL이면 해제)
+ * @return bool 성공 여부
+ */
+bool imu_driver_set_vibration(ImuDriver *imu, ImuVibration *vibration);
+
+/**
+ * @brief FIFO 버스트 DMA 시작 (FIFO 워터마크 인터럽트에서 호출)
+ *
+ * FIFO 프레임 수를 읽은 뒤 쌓인 프레임을 DMA 버스트로 읽기 시작한다.
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @param timestamp_us 인터럽트 발생 시각 (us)
+ * @return bool 버스트 시작 여부
+ */
+bool imu_driver_start_dma_burst(ImuDriver *imu, uint32_t timestamp_us);
+
+/**
+ * @brief SPI DMA 완료 처리 (프레임 변환, 보정 후 링 버퍼에 추가)
+ *
+ * @param imu 드라이버 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool imu_driver_handle_dma_complete(ImuDriver *imu);
+
+/**
+ * @brief SPI DMA 오류 처리 (버스트 폐기)
+ *
+ * @param imu 드라이버 구조체 포인터
+ */
+void imu_driver_handle_dma_error(ImuDriver *imu);
+
+#endif /* IMU_DRIVER_H */
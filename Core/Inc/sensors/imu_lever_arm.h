@@ -0,0 +1,112 @@
+/**
+ * @file imu_lever_arm.h
+ * @brief 무게 중심 밖 IMU 장착에 따른 구심/접선 가속도 보정 (입력 단계)
+ *
+ * IMU가 무게 중심(CG)에서 r만큼 떨어져 있으면 가속도계는 CG 비력에 더해
+ * 접선 항 α × r 과 구심 항 ω × (ω × r)을 함께 잰다. 이 항을 그대로 ekf_predict에 넘기면
+ * 회전이 있을 때마다 가속도 바이어스 상태가 동역학을 쫓으므로, 드라이버가 링에 넣기
+ * 전에 FIFO 버스트 단위로 빼 준다.
+ *   f_cg = f_imu - α × r - ω × (ω × r),  ω = ω_meas - b_ω
+ * 보정 후에는 가속도 바이어스 프로세스 노이즈를 회전 동역학 없이 정할 수 있다.
+ *
+ * - 각속도: 자이로 바이어스는 융합 태스크가 사이클마다 EKF 추정값을 게시한다
+ *   (imu_lever_arm_set_gyro_bias). 바이어스는 두 벌을 두고 태스크가 쓰지 않는 쪽에 쓴 뒤
+ *   번호를 원자적으로 바꾸므로 인터럽트가 절반만 바뀐 값을 보지 않는다 (gyro_notch.h와 같음).
+ * - 각가속도: 연속 샘플의 각속도 차분을 간격으로 나누고 1차 저역 통과(차단 alpha_cutoff_hz)
+ *   한다. 간격이 max_gap_us를 넘거나 0이면 차분을 다시 시작한다.
+ * - 버스트의 샘플은 블록(IMU_LEVER_ARM_BLOCK)마다 각속도/차분 -> 저역 통과 -> 보정의
+ *   세 단계 루프로 처리한다. 첫째/셋째 루프는 샘플 사이 의존성이 없는 연속 float 배열
+ *   연산이라 FPU 파이프라인(또는 SIMD)에 맞고, 순차 의존은 둘째 루프의 축당 곱셈-덧셈뿐이다.
+ *
+ * 보정은 링 직전(데시메이션과 노치 뒤)에 한다. 링 속도에서 차분해야 진동 잡음이 덜 커지고,
+ * 노치를 지난 자이로를 써야 공진이 구심 항으로 새지 않는다.
+ */
+
+#ifndef IMU_LEVER_ARM_H
+#define IMU_LEVER_ARM_H
+
+#include "math/vector3f.h"
+#include "sensors/imu_ring.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 블록 길이 (샘플, 스택 작업 영역 크기)
+ */
+#define IMU_LEVER_ARM_BLOCK 16
+
+/**
+ * @brief 기본 설정
+ */
+#define IMU_LEVER_ARM_DEFAULT_ALPHA_CUTOFF_HZ 30.0f /**< 각가속도 저역 통과 차단 (Hz) */
+#define IMU_LEVER_ARM_DEFAULT_MAX_GAP_US 20000u     /**< 차분을 다시 시작하는 샘플 간격 (us) */
+
+/**
+ * @brief 보정 설정
+ */
+typedef struct {
+    Vector3f offset;           /**< CG에서 IMU까지의 위치 (몸체 좌표계, m) */
+    float alpha_cutoff_hz;     /**< 각가속도 저역 통과 차단 주파수 (Hz, 0이면 각가속도 항 없음) */
+    uint32_t max_gap_us;       /**< 차분을 다시 시작하는 샘플 간격 (us) */
+} ImuLeverArmConfig;
+
+/**
+ * @brief 보정 통계
+ */
+typedef struct {
+    uint32_t samples;          /**< 보정한 샘플 수 */
+    uint32_t restarts;         /**< 간격 초과로 차분을 다시 시작한 횟수 */
+    float last_correction;     /**< 마지막 샘플의 보정량 크기 (m/s^2) */
+} ImuLeverArmStats;
+
+/**
+ * @brief 보정 상태
+ */
+typedef struct {
+    ImuLeverArmConfig config;  /**< 설정 */
+    Vector3f bias[2];          /**< 자이로 바이어스 두 벌 (rad/s) */
+    atomic_uint active;        /**< 인터럽트가 쓰는 바이어스 번호 */
+    Vector3f last_omega;       /**< 직전 샘플의 바이어스 보정 각속도 (rad/s) */
+    Vector3f alpha;            /**< 저역 통과한 각가속도 (rad/s^2) */
+    uint32_t last_us;          /**< 직전 샘플 시각 (us) */
+    bool has_last;             /**< 직전 샘플 유효 */
+    ImuLeverArmStats stats;    /**< 통계 (인터럽트 전용) */
+} ImuLeverArm;
+
+/**
+ * @brief 기본 설정 (위치 0, 보정 없음)
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool imu_lever_arm_default_config(ImuLeverArmConfig *config);
+
+/**
+ * @brief 보정 초기화 (바이어스 0)
+ *
+ * @param arm 보정 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool imu_lever_arm_init(ImuLeverArm *arm, const ImuLeverArmConfig *config);
+
+/**
+ * @brief 자이로 바이어스 게시 (태스크 문맥)
+ *
+ * @param arm 보정 상태
+ * @param bias 자이로 바이어스 (rad/s, 보통 EKF 추정값)
+ * @return bool 성공 여부
+ */
+bool imu_lever_arm_set_gyro_bias(ImuLeverArm *arm, Vector3f bias);
+
+/**
+ * @brief 버스트 샘플의 가속도 보정 (인터럽트 문맥)
+ *
+ * @param arm 보정 상태
+ * @param samples 샘플 배열 (시각 순서, 가속도를 제자리에서 보정)
+ * @param count 샘플 수
+ */
+void imu_lever_arm_apply(ImuLeverArm *arm, ImuSample *samples, uint16_t count);
+
+#endif /* IMU_LEVER_ARM_H */
@@ -0,0 +1,107 @@
+/**
+ * @file imu_ring.h
+ * @brief IMU 샘플용 무잠금 단일 생산자/단일 소비자(SPSC) 링 버퍼
+ *
+ * 생산자(DMA 완료 인터럽트)는 head만, 소비자(융합 태스크)는 tail만 갱신한다.
+ * 인덱스는 자유 증가 카운터이며 용량은 2의 거듭제곱이어야 한다.
+ * 버퍼가 가득 차면 새 샘플을 버리고 dropped 카운터를 증가시킨다.
+ *
+ * 생산자 탭(tap)이 설정되어 있으면 push마다 생산자 문맥에서 샘플을 먼저 전달한다.
+ * 소비자 지연과 무관하게 모든 샘플을 봐야 하는 처리(비행 이벤트 검출 등)에 사용하며,
+ * 버퍼가 가득 차 버려지는 샘플도 전달된다. 탭은 인터럽트 문맥에서 짧게 끝나야 한다.
+ */
+
+#ifndef IMU_RING_H
+#define IMU_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "math/vector3f.h"
+
+/**
+ * @brief 링 버퍼 용량 (2의 거듭제곱)
+ */
+#define IMU_RING_SIZE 128
+
+#if (IMU_RING_SIZE & (IMU_RING_SIZE - 1)) != 0
+#error "IMU_RING_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief 타임스탬프가 붙은 IMU 샘플
+ */
+typedef struct {
+    uint32_t timestamp_us; /**< 샘플 시각 (us) */
+    Vector3f gyro;         /**< 각속도 (rad/s, 센서 좌표계) */
+    Vector3f accel;        /**< 가속도 (m/s^2, 센서 좌표계) */
+} ImuSample;
+
+/**
+ * @brief 생산자 탭 콜백 (생산자 문맥에서 push마다 호출)
+ */
+typedef void (*ImuRingTapFn)(const ImuSample *sample, void *context);
+
+/**
+ * @brief IMU 샘플 링 버퍼
+ */
+typedef struct {
+    ImuSample buffer[IMU_RING_SIZE]; /**< 샘플 저장소 */
+    atomic_uint_fast32_t head;       /**< 다음 쓰기 위치 (생산자 전용) */
+    atomic_uint_fast32_t tail;       /**< 다음 읽기 위치 (소비자 전용) */
+    uint32_t dropped;                /**< 버퍼 가득 참으로 버려진 샘플 수 (생산자 전용) */
+    ImuRingTapFn tap;                /**< 생산자 탭 (NULL이면 없음) */
+    void *tap_context;               /**< 탭 콜백 문맥 */
+} ImuRing;
+
+/**
+ * @brief 링 버퍼 초기화
+ *
+ * 생산자와 소비자가 동작하기 전에 호출해야 한다.
+ *
+ * @param ring 링 버퍼 포인터
+ * @return bool 성공 여부
+ */
+bool imu_ring_init(ImuRing *ring);
+
+/**
+ * @brief 생산자 탭 설정
+ *
+ * 생산자가 동작하기 전에 호출해야 한다.
+ *
+ * @param ring 링 버퍼 포인터
+ * @param tap 탭 콜백 (NULL이면 해제)
+ * @param context 콜백 문맥
+ * @return bool 성공 여부
+ */
+bool imu_ring_set_tap(ImuRing *ring, ImuRingTapFn tap, void *context);
+
+/**
+ * @brief 샘플 추가 (생산자 전용)
+ *
+ * @param ring 링 버퍼 포인터
+ * @param sample 추가할 샘플
+ * @return bool 성공 여부 (가득 차면 false)
+ */
+bool imu_ring_push(ImuRing *ring, const ImuSample *sample);
+
+/**
+ * @brief 가장 오래된 샘플 꺼내기 (소비자 전용)
+ *
+ * @param ring 링 버퍼 포인터
+ * @param sample 꺼낸 샘플 저장 위치
+ * @return bool 성공 여부 (비어 있으면 false)
+ */
+bool imu_ring_pop(ImuRing *ring, ImuSample *sample);
+
+/**
+ * @brief 저장된 샘플 수
+ *
+ * 생산자/소비자 어느 쪽에서 호출해도 되며, 호출 시점의 근사값이다.
+ *
+ * @param ring 링 버퍼 포인터
+ * @return uint32_t 샘플 수
+ */
+uint32_t imu_ring_count(const ImuRing *ring);
+
+#endif /* IMU_RING_H */
@@ -0,0 +1,116 @@
+/**
+ * @file imu_thermal_cal.h
+ * @brief IMU 온도 보상 바이어스와 스케일/비정렬 보정을 한 번의 3x3 + 오프셋으로 적용
+ *
+ * IMU는 전원 투입부터 발사까지 약 20°C 더워지며, 그동안의 바이어스 변화를 EKF가
+ * 자이로/가속도 바이어스 상태로 따라가야 한다. 센서마다 챔버에서 구한 보정 계수
+ * (상수로 두면 플래시에 놓임)를 수집 단계(드라이버 DMA 완료)에서 적용하면, 바이어스
+ * 상태에는 보정 잔차만 남아 과정 잡음을 크게 줄일 수 있고 수렴도 빨라진다.
+ *
+ * 보정 모델 (센서마다 자이로/가속도 각각):
+ *   out = M (raw - b(T)),  b(T) = c0 + c1 ΔT + c2 ΔT^2 + c3 ΔT^3,  ΔT = T - t_ref
+ * - M은 스케일과 축 비정렬을 합친 3x3 행렬, b(T)는 축별 3차 다항식이다.
+ * - 온도는 보정 범위 [t_min, t_max]로 제한한다 (범위 밖 외삽 방지).
+ * - 온도는 샘플보다 훨씬 느리게 변하므로 o = M b(T)를 온도가 update_step 이상
+ *   바뀔 때만 다시 계산한다. 샘플마다의 연산은 out = M raw - o 하나이다.
+ *
+ * 사용 순서: imu_thermal_cal_init(&cal, &flash_coeffs) -> imu_driver_set_calibration(&imu, &cal).
+ * 드라이버가 패킷마다 FIFO 온도로 imu_thermal_cal_set_temperature를 호출하고, M과
+ * 오프셋을 보드 방향/LSB 스케일과 접은 변환을 원시 정수에 바로 적용한다 (같은 인터럽트
+ * 문맥). imu_thermal_cal_apply는 물리 단위 샘플을 받는 다른 경로용이다.
+ */
+
+#ifndef IMU_THERMAL_CAL_H
+#define IMU_THERMAL_CAL_H
+
+#include "math/vector3f.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 바이어스 다항식 차수 + 1
+ */
+#define IMU_THERMAL_CAL_TERMS 4
+
+/**
+ * @brief 오프셋 재계산 온도 변화 (°C)
+ */
+#define IMU_THERMAL_CAL_UPDATE_STEP 0.1f
+
+/**
+ * @brief 센서 하나(자이로 또는 가속도)의 보정 계수
+ */
+typedef struct {
+    float M[3][3];             /**< 스케일/비정렬 보정 행렬 (단위 행렬이면 바이어스만) */
+    float bias[3][IMU_THERMAL_CAL_TERMS]; /**< 축별 바이어스 다항식 계수 (c0..c3, 측정 단위) */
+} ImuThermalAxisCoeffs;
+
+/**
+ * @brief IMU 하나의 보정 계수 (챔버 보정 결과, 플래시 상수)
+ */
+typedef struct {
+    ImuThermalAxisCoeffs gyro;  /**< 자이로 (rad/s) */
+    ImuThermalAxisCoeffs accel; /**< 가속도 (m/s^2) */
+    float t_ref;               /**< 다항식 기준 온도 (°C) */
+    float t_min;               /**< 보정 범위 하한 (°C) */
+    float t_max;               /**< 보정 범위 상한 (°C) */
+} ImuThermalCoeffs;
+
+/**
+ * @brief 실행 중 보정 상태
+ */
+typedef struct {
+    const ImuThermalCoeffs *coeffs; /**< 보정 계수 */
+    float temperature;         /**< 오프셋을 계산한 온도 (°C, 제한 후) */
+    Vector3f gyro_offset;      /**< M_g b_g(T) (rad/s) */
+    Vector3f accel_offset;     /**< M_a b_a(T) (m/s^2) */
+    bool has_temperature;      /**< 온도 수신 여부 (없으면 t_ref 기준) */
+    uint32_t recomputes;       /**< 오프셋 재계산 횟수 */
+} ImuThermalCal;
+
+/**
+ * @brief 보정 계수 검사 (범위, 유한성)
+ *
+ * @param coeffs 보정 계수
+ * @return bool 유효 여부
+ */
+bool imu_thermal_cal_validate(const ImuThermalCoeffs *coeffs);
+
+/**
+ * @brief 보정 상태 초기화 (온도 수신 전에는 t_ref의 바이어스 사용)
+ *
+ * @param cal 보정 상태
+ * @param coeffs 보정 계수 (호출자 소유, 보통 플래시 상수)
+ * @return bool 성공 여부 (계수가 유효하지 않으면 false)
+ */
+bool imu_thermal_cal_init(ImuThermalCal *cal, const ImuThermalCoeffs *coeffs);
+
+/**
+ * @brief 센서 온도 반영 (update_step 이상 바뀌었을 때만 오프셋 재계산)
+ *
+ * @param cal 보정 상태
+ * @param temperature_c 센서 온도 (°C)
+ * @return bool 오프셋을 다시 계산했으면 true
+ */
+bool imu_thermal_cal_set_temperature(ImuThermalCal *cal, float temperature_c);
+
+/**
+ * @brief 샘플 하나 보정 (out = M raw - o)
+ *
+ * @param cal 보정 상태
+ * @param gyro 자이로 (rad/s, 제자리 보정)
+ * @param accel 가속도 (m/s^2, 제자리 보정)
+ */
+void imu_thermal_cal_apply(const ImuThermalCal *cal, Vector3f *gyro, Vector3f *accel);
+
+/**
+ * @brief 현재 온도의 보정 전 바이어스 b(T) (진단, 잔차 확인용)
+ *
+ * @param cal 보정 상태
+ * @param gyro_bias 자이로 바이어스 (rad/s, NULL 가능)
+ * @param accel_bias 가속도 바이어스 (m/s^2, NULL 가능)
+ * @return bool 성공 여부
+ */
+bool imu_thermal_cal_get_bias(const ImuThermalCal *cal, Vector3f *gyro_bias, Vector3f *accel_bias);
+
+#endif /* IMU_THERMAL_CAL_H */
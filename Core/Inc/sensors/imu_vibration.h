@@ -0,0 +1,176 @@
+/**
+ * @file imu_vibration.h
+ * @brief 입력 단계 IMU 진동/포화 통계 (축별 RMS, 최댓값, 포화 횟수)
+ *
+ * 텔레메트리만으로는 IMU가 포화되는지, 진동을 얼마나 받는지 알 수 없었다. 드라이버의 FIFO
+ * 버스트 변환 루프(imu_driver_set_vibration)가 보정/축 재배치 직후 데시메이션 전의 전체 ODR
+ * 샘플마다 imu_vibration_push를 부른다 (static inline, 루프에 인라인됨). 채널당 뺄셈,
+ * 곱셈-덧셈, 절댓값 비교뿐이라 변환 비용에 비해 작다.
+ * - RMS: 채널별 저역 통과 평균(mean_alpha, 프레임당)을 뺀 잔차의 RMS. 중력과 느린 기동은
+ *   평균으로 빠지므로 진동 세기를 나타낸다.
+ * - 최댓값: 창 안의 |값| 최대 (측정 범위에 얼마나 가까운지).
+ * - 포화: 원시 LSB의 |값|이 clip_fraction x 32767 이상인 프레임 수 (축별).
+ * 버스트 끝(imu_driver가 imu_vibration_end_burst 호출)에 window_us가 지났으면 창 통계를
+ * 두 벌 중 태스크가 읽지 않는 쪽에 쓰고 번호를 원자적으로 바꾼다 (gyro_notch.h와 같음).
+ *
+ * 태스크 문맥에서는 imu_vibration_get_metrics로 마지막 창을 읽어 건전성 지표로 게시하고
+ * (텔레메트리 VIBE 묶음), imu_vibration_accel_var로 가속도 진동 분산의 잡음 바닥 초과분과
+ * 포화 구간 분산을 받아 속도 프로세스 노이즈를 키운다 (fusion_scheduler_set_vibration,
+ * ekf_set_velocity_noise_inflation). 진동 대역 대부분은 데시메이션 FIR이 걸러 내므로 초과분에는
+ * q_gain(1 이하)을 곱한다.
+ */
+
+#ifndef IMU_VIBRATION_H
+#define IMU_VIBRATION_H
+
+#include "math/vector3f.h"
+#include "sensors/imu_ring.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <math.h>
+
+/**
+ * @brief 채널 수 (자이로 3 + 가속도 3, 몸체 축 순서)
+ */
+#define IMU_VIBRATION_CHANNELS 6
+
+/**
+ * @brief 기본 설정
+ */
+#define IMU_VIBRATION_DEFAULT_WINDOW_US 200000u     /**< 통계 창 (us) */
+#define IMU_VIBRATION_DEFAULT_MEAN_ALPHA 0.002f     /**< 평균 저역 통과 계수 (프레임당, 8 kHz에서 시정수 약 60 ms) */
+#define IMU_VIBRATION_DEFAULT_CLIP_FRACTION 0.98f   /**< 포화로 보는 원시 값 (전체 범위 대비) */
+#define IMU_VIBRATION_DEFAULT_ACCEL_FLOOR_STD 0.1f  /**< 가속도 잡음 바닥 (m/s^2, 이하는 부풀리지 않음) */
+#define IMU_VIBRATION_DEFAULT_Q_GAIN 0.25f          /**< 초과 분산 중 프로세스 노이즈에 반영할 비율 */
+#define IMU_VIBRATION_DEFAULT_CLIP_NOISE_STD 20.0f  /**< 가속도 포화가 있던 창의 가속도 잡음 (m/s^2) */
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t window_us;        /**< 통계 창 (us) */
+    float mean_alpha;          /**< 평균 저역 통과 계수 (프레임당, 0 초과 1 이하) */
+    float clip_fraction;       /**< 포화로 보는 원시 값 (전체 범위 대비, 0 초과 1 이하) */
+    float accel_floor_std;     /**< 가속도 잡음 바닥 (m/s^2) */
+    float q_gain;              /**< 초과 분산 반영 비율 (0 이상) */
+    float clip_noise_std;      /**< 가속도 포화 창의 가속도 잡음 (m/s^2, 0이면 포화로 부풀리지 않음) */
+} ImuVibrationConfig;
+
+/**
+ * @brief 창 하나의 통계 (몸체 좌표계)
+ */
+typedef struct {
+    uint32_t window_end_us;    /**< 창 끝 시각 (us, 마지막 버스트 시각) */
+    uint32_t samples;          /**< 창의 프레임 수 (0이면 아직 창 없음) */
+    Vector3f gyro_rms;         /**< 자이로 진동 RMS (rad/s) */
+    Vector3f accel_rms;        /**< 가속도 진동 RMS (m/s^2) */
+    Vector3f gyro_peak;        /**< 자이로 |값| 최대 (rad/s) */
+    Vector3f accel_peak;       /**< 가속도 |값| 최대 (m/s^2) */
+    uint16_t gyro_clips[3];    /**< 자이로 축별 포화 프레임 수 */
+    uint16_t accel_clips[3];   /**< 가속도 축별 포화 프레임 수 */
+    uint32_t clip_total;       /**< 시작 이후 누적 포화 (축-프레임 수) */
+} ImuVibrationMetrics;
+
+/**
+ * @brief 진동 통계 상태
+ */
+typedef struct {
+    ImuVibrationConfig config; /**< 설정 */
+    int16_t clip_lsb;          /**< 포화 문턱 (원시 LSB) */
+
+    float mean[IMU_VIBRATION_CHANNELS];  /**< 채널별 저역 통과 평균 */
+    float sumsq[IMU_VIBRATION_CHANNELS]; /**< 창의 잔차 제곱 합 */
+    float peak[IMU_VIBRATION_CHANNELS];  /**< 창의 |값| 최대 */
+    uint16_t clips[IMU_VIBRATION_CHANNELS]; /**< 창의 포화 프레임 수 */
+    uint32_t samples;          /**< 창의 프레임 수 */
+    uint32_t window_start_us;  /**< 창 시작 시각 (us) */
+    bool has_mean;             /**< 평균 유효 */
+    bool window_open;          /**< 창 시작 시각 유효 */
+
+    ImuVibrationMetrics metrics[2]; /**< 게시한 창 통계 두 벌 */
+    atomic_uint active;        /**< 태스크가 읽을 통계 번호 */
+    uint32_t clip_total;       /**< 누적 포화 (인터럽트 전용) */
+    uint32_t windows;          /**< 게시한 창 수 */
+    bool initialized;          /**< 초기화 여부 */
+} ImuVibration;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool imu_vibration_default_config(ImuVibrationConfig *config);
+
+/**
+ * @brief 초기화
+ *
+ * @param vib 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool imu_vibration_init(ImuVibration *vib, const ImuVibrationConfig *config);
+
+/**
+ * @brief 프레임 하나 누적 (인터럽트 문맥, 버스트 변환 루프)
+ *
+ * @param vib 상태
+ * @param sample 보정한 몸체 좌표계 샘플 (데시메이션 전)
+ * @param raw 몸체 축 순서의 원시 값 (자이로 xyz, 가속도 xyz, LSB, 부호 무관)
+ */
+static inline void imu_vibration_push(ImuVibration *vib, const ImuSample *sample, const int16_t raw[IMU_VIBRATION_CHANNELS]) {
+    const float x[IMU_VIBRATION_CHANNELS] = {
+        sample->gyro.x, sample->gyro.y, sample->gyro.z,
+        sample->accel.x, sample->accel.y, sample->accel.z
+    };
+
+    if (!vib->has_mean) {
+        for (uint8_t c = 0; c < IMU_VIBRATION_CHANNELS; c++) {
+            vib->mean[c] = x[c];
+        }
+        vib->has_mean = true;
+    }
+
+    const float alpha = vib->config.mean_alpha;
+    const int16_t lim = vib->clip_lsb;
+    for (uint8_t c = 0; c < IMU_VIBRATION_CHANNELS; c++) {
+        float r = x[c] - vib->mean[c];
+        vib->mean[c] += alpha * r;
+        vib->sumsq[c] += r * r;
+        float a = fabsf(x[c]);
+        vib->peak[c] = (a > vib->peak[c]) ? a : vib->peak[c];
+        vib->clips[c] += (raw[c] >= lim || raw[c] <= -lim) ? 1u : 0u;
+    }
+    vib->samples++;
+}
+
+/**
+ * @brief 버스트 끝 처리, 창이 끝났으면 통계 게시 (인터럽트 문맥)
+ *
+ * @param vib 상태
+ * @param timestamp_us 버스트 마지막 샘플 시각 (us)
+ */
+void imu_vibration_end_burst(ImuVibration *vib, uint32_t timestamp_us);
+
+/**
+ * @brief 마지막 창 통계 (태스크 문맥)
+ *
+ * @param vib 상태
+ * @param out 출력
+ * @return bool 게시된 창이 있으면 true
+ */
+bool imu_vibration_get_metrics(const ImuVibration *vib, ImuVibrationMetrics *out);
+
+/**
+ * @brief 속도 프로세스 노이즈에 더할 가속도 분산 (태스크 문맥)
+ *
+ * 마지막 창의 축 평균 진동 분산에서 잡음 바닥을 뺀 값에 q_gain을 곱하고, 가속도 포화가
+ * 있던 창이면 clip_noise_std^2를 더한다.
+ *
+ * @param vib 상태
+ * @return float 분산 ((m/s^2)^2, 창이 없으면 0)
+ */
+float imu_vibration_accel_var(const ImuVibration *vib);
+
+#endif /* IMU_VIBRATION_H */
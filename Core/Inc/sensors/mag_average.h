@@ -0,0 +1,134 @@
+/**
+ * @file mag_average.h
+ * @brief 자력계 샘플 사전 평균 (자세 변화 보상, 솎은 자력계 갱신)
+ *
+ * 자력계는 100 Hz로 나오지만 방위 정보는 천천히 변한다. 샘플마다 ekf_update_mag를 부르면
+ * 초당 100번 자코비안, 3x3 역행렬, 게인, 공분산 갱신을 한다. 이 단계는 count개 샘플을 측정
+ * 하나로 평균하고, 평균으로 줄어든 잡음만큼 R 배율(noise_scale)을 붙여 넘긴다. 독립 잡음이면
+ * 평균의 분산은 1 / count이므로 갱신 비용만 count배 줄고 정보는 그대로이다.
+ *
+ * 자세 보상 (rotate): 몸체 좌표계 샘플을 그대로 평균하면 창 안에서 기체가 돈 만큼 벡터가
+ * 뭉개진다. 샘플마다 그때의 자세 q(몸체 -> NED)로 NED에 돌려 더하고, 평균을 마지막 샘플의
+ * 자세로 몸체에 되돌린다. 짧은 창 안의 자세 변화는 자이로 적분(바이어스 보정 포함)이므로
+ * 자세 절대 오차는 상쇄되고 샘플 사이의 회전만 보상된다. 출력 시각은 마지막 샘플 시각이다.
+ * 보상하지 않으면 출력 시각은 첫 샘플과 마지막 샘플의 가운데이다.
+ *
+ * 잔여 경철/연철 오차, 기체 전류 자기장처럼 샘플 사이에 상관된 오차는 평균으로 줄지 않는다.
+ * 이런 오차가 크면 r_scale_min으로 배율 하한(예: 잡음 분산 대비 상관 오차 비율)을 둔다.
+ * 창이 max_span_us를 넘게 벌어지면(센서 끊김) 모은 샘플을 버리고 다시 모은다.
+ *
+ * 연결 예: fusion_scheduler_set_mag_average로 설정하면 fusion_scheduler_push_mag가 융합 문맥에서
+ * 현재 필터 자세로 샘플을 모으고, 평균이 나올 때만 측정을 대기열에 넣는다.
+ * 모든 함수는 한 태스크에서만 호출해야 한다.
+ */
+
+#ifndef MAG_AVERAGE_H
+#define MAG_AVERAGE_H
+
+#include "math/vector3f.h"
+#include "math/quaternion.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 최대 평균 샘플 수
+ */
+#define MAG_AVERAGE_MAX_COUNT 64u
+
+/**
+ * @brief 기본 설정 (100 Hz -> 10 Hz)
+ */
+#define MAG_AVERAGE_DEFAULT_COUNT 10u           /**< 평균 샘플 수 */
+#define MAG_AVERAGE_DEFAULT_MAX_SPAN_US 250000u /**< 첫 샘플부터 최대 창 길이 (us) */
+#define MAG_AVERAGE_DEFAULT_R_SCALE_MIN 0.0f    /**< R 배율 하한 (0이면 1 / count) */
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint8_t count;             /**< 평균 샘플 수 (1..MAG_AVERAGE_MAX_COUNT, 1이면 그대로 통과) */
+    bool rotate;               /**< 자세 변화 보상 */
+    uint32_t max_span_us;      /**< 첫 샘플부터 최대 창 길이 (us, 0 초과) */
+    float r_scale_min;         /**< R 배율 하한 (0 이상 1 이하) */
+} MagAverageConfig;
+
+/**
+ * @brief 평균 측정
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 측정 시각 (us) */
+    Vector3f mag;              /**< 평균 자기장 (몸체 좌표계, 입력 단위) */
+    float noise_scale;         /**< R 배율 (max(1 / count, r_scale_min)) */
+    uint8_t count;             /**< 평균한 샘플 수 */
+} MagAverageOutput;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t inputs;           /**< 받은 샘플 수 */
+    uint32_t outputs;          /**< 만든 평균 측정 수 */
+    uint32_t rejected;         /**< 버린 샘플 수 (유한하지 않음, 자세 없음) */
+    uint32_t restarts;         /**< 창이 max_span_us를 넘어 다시 모은 횟수 */
+} MagAverageStats;
+
+/**
+ * @brief 자력계 사전 평균
+ */
+typedef struct {
+    MagAverageConfig config;   /**< 설정 */
+    Vector3f sum;              /**< 샘플 합 (rotate이면 NED, 아니면 몸체) */
+    Quaternion last_q;         /**< 마지막 샘플 자세 (rotate) */
+    uint32_t first_us;         /**< 첫 샘플 시각 (us) */
+    uint32_t last_us;          /**< 마지막 샘플 시각 (us) */
+    uint8_t n;                 /**< 모은 샘플 수 */
+    MagAverageStats stats;     /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} MagAverage;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool mag_average_default_config(MagAverageConfig *config);
+
+/**
+ * @brief 초기화
+ *
+ * @param ma 구조체 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool mag_average_init(MagAverage *ma, const MagAverageConfig *config);
+
+/**
+ * @brief 모은 샘플 버림 (정렬/리셋 뒤)
+ *
+ * @param ma 구조체 포인터
+ */
+void mag_average_reset(MagAverage *ma);
+
+/**
+ * @brief 샘플 하나 추가
+ *
+ * @param ma 구조체 포인터
+ * @param timestamp_us 샘플 시각 (us)
+ * @param mag 자기장 (몸체 좌표계)
+ * @param q_nb 샘플 시각의 자세 (몸체 -> NED, rotate가 아니면 NULL 가능)
+ * @param out 평균 측정 (true일 때만 유효)
+ * @return bool 평균 측정을 만들었으면 true
+ */
+bool mag_average_push(MagAverage *ma, uint32_t timestamp_us, Vector3f mag, const Quaternion *q_nb,
+                      MagAverageOutput *out);
+
+/**
+ * @brief 통계
+ *
+ * @param ma 구조체 포인터
+ * @return const MagAverageStats* 통계 (NULL이면 NULL)
+ */
+const MagAverageStats *mag_average_get_stats(const MagAverage *ma);
+
+#endif /* MAG_AVERAGE_H */
@@ -0,0 +1,178 @@
+/**
+ * @file mag_iron_cal.h
+ * @brief 비행 중 자력계 경철/연철(hard-iron/soft-iron) 온라인 보정
+ *
+ * 왜곡된 자력계 측정 m은 타원체 (m - b)^T A (m - b) = 1 위에 놓인다.
+ * 이를 선형 이차 곡면 식
+ *   a x^2 + b y^2 + c z^2 + 2f yz + 2g xz + 2h xy + 2p x + 2q y + 2r z = 1
+ * 의 9개 계수에 대한 재귀 최소 제곱(RLS, 망각 인자 포함)으로 샘플마다 갱신하므로
+ * 샘플 배열 없이 일정한 메모리(약 400 바이트)만 사용한다.
+ *
+ * 계수에서 보정값(중심 b, 연철 행렬 W = sqrt(A))을 꺼내는 과정은 단계로 나누어
+ * mag_iron_cal_step 호출마다 한 단계씩 진행하며, 검증을 통과한 해만 게시한다.
+ * 보정된 측정은 m_c = W * (m - b) 이며 크기는 기준 자기장 세기와 같아진다.
+ *
+ * 계산 규모를 맞추기 위해 내부적으로 측정을 기준 자기장 세기로 나누어 다룬다.
+ * 모든 함수는 한 태스크에서만 호출해야 한다.
+ */
+
+#ifndef MAG_IRON_CAL_H
+#define MAG_IRON_CAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/vector3f.h"
+
+/**
+ * @brief 이차 곡면 계수 수
+ */
+#define MAG_IRON_CAL_PARAMS 9
+
+/**
+ * @brief RLS 망각 인자 (유효 기억 약 1 / (1 - λ) = 1000 샘플)
+ */
+#define MAG_IRON_CAL_FORGETTING 0.999f
+
+/**
+ * @brief RLS 공분산 초기값 (정규화 단위)
+ */
+#define MAG_IRON_CAL_P0 1.0f
+
+/**
+ * @brief RLS 공분산 대각합 상한 (정규화 단위)
+ *
+ * 회전이 한 축에 치우쳐 일부 계수가 관측되지 않으면 망각 인자 때문에 공분산이
+ * 계속 커진다(windup). 대각합이 상한을 넘으면 공분산 전체를 축소한다.
+ */
+#define MAG_IRON_CAL_P_TRACE_MAX (MAG_IRON_CAL_PARAMS * MAG_IRON_CAL_P0)
+
+/**
+ * @brief 채택할 샘플의 직전 채택 샘플과의 최소 거리 (정규화 단위)
+ *
+ * 정지 중 같은 방향 샘플이 반복되어 RLS 공분산이 한 방향으로만 줄어드는 것을 막는다.
+ */
+#define MAG_IRON_CAL_MIN_SEPARATION 0.05f
+
+/**
+ * @brief 첫 해 추출 전 최소 채택 샘플 수
+ */
+#define MAG_IRON_CAL_MIN_SAMPLES 100u
+
+/**
+ * @brief 허용 최대 타원체 축비 (연철 왜곡 한계)
+ */
+#define MAG_IRON_CAL_MAX_AXIS_RATIO 2.0f
+
+/**
+ * @brief 허용 최대 경철 오프셋 (기준 자기장 세기 배수)
+ */
+#define MAG_IRON_CAL_MAX_OFFSET 2.0f
+
+/**
+ * @brief Jacobi 고유값 분해 반복 횟수 (단계당 1회)
+ */
+#define MAG_IRON_CAL_JACOBI_SWEEPS 4u
+
+/**
+ * @brief 해 추출 단계
+ */
+typedef enum {
+    MAG_IRON_CAL_STAGE_IDLE = 0,   /**< 계수 누적만 수행 */
+    MAG_IRON_CAL_STAGE_CENTER,     /**< 중심과 정규화 A 계산 */
+    MAG_IRON_CAL_STAGE_EIGEN,      /**< A의 Jacobi 고유값 분해 */
+    MAG_IRON_CAL_STAGE_PUBLISH     /**< W = V sqrt(Λ) V^T 계산, 검증 후 게시 */
+} MagIronCalStage;
+
+/**
+ * @brief 보정값 (게시된 해)
+ */
+typedef struct {
+    Vector3f hard_iron;    /**< 경철 오프셋 b (측정 단위) */
+    float soft_iron[3][3]; /**< 연철 보정 행렬 W (대칭) */
+} MagIronCorrection;
+
+/**
+ * @brief 온라인 경철/연철 추정기
+ */
+typedef struct {
+    float field_strength;                  /**< 기준 자기장 세기 (측정 단위) */
+
+    float theta[MAG_IRON_CAL_PARAMS];      /**< 이차 곡면 계수 */
+    float P[MAG_IRON_CAL_PARAMS][MAG_IRON_CAL_PARAMS]; /**< RLS 공분산 */
+    Vector3f last_accepted;                /**< 직전 채택 샘플 (정규화 단위) */
+    uint32_t accepted;                     /**< 채택 샘플 수 */
+    uint32_t rejected;                     /**< 거리 조건으로 건너뛴 샘플 수 */
+    float residual;                        /**< 이차 곡면 잔차 절대값의 지수 이동 평균 */
+
+    MagIronCalStage stage;                 /**< 진행 중인 해 추출 단계 */
+    uint32_t solved_at;                    /**< 마지막 해 추출을 시작한 시점의 채택 샘플 수 */
+    uint8_t sweep;                         /**< 진행한 Jacobi 반복 수 */
+    Vector3f center;                       /**< 추출 중 중심 (정규화 단위) */
+    float A[3][3];                         /**< 추출 중 정규화 타원체 행렬 (고유값 분해 중 대각화) */
+    float V[3][3];                         /**< 추출 중 고유 벡터 */
+    uint32_t solutions;                    /**< 게시한 해 수 */
+    uint32_t invalid;                      /**< 검증 실패한 해 수 */
+
+    MagIronCorrection correction;          /**< 적용 중인 보정값 */
+    bool valid;                            /**< 보정값 게시 여부 (false이면 단위 보정) */
+} MagIronCal;
+
+/**
+ * @brief 추정기 초기화
+ *
+ * @param cal 추정기
+ * @param field_strength 기준 자기장 세기 (측정 단위, 예: uT), 보정 후 측정의 크기
+ * @return bool 성공 여부 (field_strength가 양수가 아니면 false)
+ */
+bool mag_iron_cal_init(MagIronCal *cal, float field_strength);
+
+/**
+ * @brief 원시 자력계 샘플 누적 (RLS 갱신 1회, 약 250회 곱셈-누적)
+ *
+ * @param cal 추정기
+ * @param mag 원시 자력계 측정값 (몸체 좌표계)
+ * @return bool 샘플 채택 여부 (직전 채택 샘플과 너무 가까우면 false)
+ */
+bool mag_iron_cal_add_sample(MagIronCal *cal, Vector3f mag);
+
+/**
+ * @brief 해 추출 한 단계 진행
+ *
+ * 주기적으로 (예: 융합 사이클마다) 호출한다. 한 번에 한 단계만 수행하므로
+ * 호출당 비용이 작고 일정하다.
+ *
+ * @param cal 추정기
+ * @return bool 이번 호출에서 새 해를 게시했으면 true
+ */
+bool mag_iron_cal_step(MagIronCal *cal);
+
+/**
+ * @brief 현재 보정값 적용
+ *
+ * @param cal 추정기
+ * @param mag 원시 자력계 측정값
+ * @return Vector3f 보정된 측정값 (해가 없으면 원시값 그대로)
+ */
+Vector3f mag_iron_cal_apply(const MagIronCal *cal, Vector3f mag);
+
+/**
+ * @brief 게시된 보정값 조회
+ *
+ * @param cal 추정기
+ * @param correction 보정값
+ * @return bool 게시된 해가 있으면 true
+ */
+bool mag_iron_cal_get_correction(const MagIronCal *cal, MagIronCorrection *correction);
+
+/**
+ * @brief 보정값 직접 설정 (재시작 복구, 저장된 지상 보정값 적용)
+ *
+ * 추정기의 누적 통계는 그대로 두며, 다음 해가 게시되면 그 값으로 바뀐다.
+ *
+ * @param cal 추정기
+ * @param correction 보정값
+ * @return bool 성공 여부
+ */
+bool mag_iron_cal_set_correction(MagIronCal *cal, const MagIronCorrection *correction);
+
+#endif /* MAG_IRON_CAL_H */
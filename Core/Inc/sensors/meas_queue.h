@@ -0,0 +1,290 @@
+/**
+ * @file meas_queue.h
+ * @brief 여러 센서 인터럽트용 무잠금 다중 생산자/단일 소비자(MPSC) 측정 대기열
+ *
+ * IMU, 기압계, 자력계, GNSS 측정은 우선순위가 서로 다른 인터럽트/DMA 완료 문맥에서
+ * 도착한다. 이 대기열은 그 측정들을 고정 크기 메시지 하나로 받아 도착 순서대로 융합 태스크에
+ * 넘긴다 (fusion_scheduler_drain_queue). 전역 인터럽트 금지 없이 동작하므로 높은 우선순위
+ * IMU 인터럽트가 낮은 우선순위 생산자 때문에 늦어지지 않는다.
+ *
+ * - 구조: 측정 종류마다 슬롯별 순번(seq)을 두는 유한 배열 링. 생산자는 자기 종류 링의 쓰기
+ *   위치를, 소비자는 읽기 위치를 비교-교환(C11 atomic_compare_exchange, Cortex-M4에서 LDREX/STREX)으로
+ *   차지한 뒤 슬롯을 채우거나 비우고 seq를 release로 올려 넘긴다.
+ * - 순서: 생산자는 자리를 차지한 뒤 공용 도착 번호(ticket)를 받아 슬롯에 적는다. 소비자는 링 머리
+ *   중 번호가 가장 작은 것을 꺼내므로 종류가 섞여도 도착 순서대로 나온다.
+ * - 낮은 우선순위 생산자가 자리를 차지한 채 선점되면 그 슬롯이 채워질 때까지 어느 링도 읽히지
+ *   않는다 (순서 유지). 소비자는 모든 생산자보다 우선순위가 낮은 태스크 문맥이므로 기다리는 일이
+ *   없고, 생산자 재시도는 선점한 더 높은 우선순위 생산자 수로 제한된다.
+ * - 가득 참: 링이 종류별이므로 한 종류가 넘쳐도 다른 종류의 자리는 줄지 않는다. 종류별 정책으로
+ *   처리한다. MEAS_QUEUE_DROP_NEWEST는 새 메시지를 버리고, MEAS_QUEUE_DROP_OLDEST는 같은 종류의
+ *   가장 오래된 메시지를 빼서 버린 뒤 다시 넣는다 (IMU가 넘쳐도 대기 중인 GNSS는 밀려나지 않음).
+ *   새 메시지를 버리면 그 종류의 overflow가, 밀어내면 evicted가 늘어난다 (push 하나에 overflow는
+ *   많아야 하나). 다른 문맥이 사용 중이라 빼낼 수 없으면(선점된 소비자/생산자) 새 메시지를 버린다.
+ * - 통계 카운터는 여러 문맥에서 원자적으로 늘리며 meas_queue_get_stats로 스냅숏을 읽는다.
+ *
+ * 슬롯 하나는 메시지와 순번을 합해 약 48바이트이므로 MEAS_QUEUE_SIZE(IMU 링)는 가장 긴 융합 사이클 동안
+ * 도착하는 IMU 샘플 수(1 kHz 기준 수 ms 분량)보다, MEAS_QUEUE_AUX_SIZE는 같은 동안의 기압/자력계/
+ * GNSS 측정 수보다 넉넉해야 한다.
+ */
+
+#ifndef MEAS_QUEUE_H
+#define MEAS_QUEUE_H
+
+#include "math/vector3f.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief IMU 링 용량 (2의 거듭제곱)
+ */
+#define MEAS_QUEUE_SIZE 64
+
+/**
+ * @brief 기압계/자력계/GNSS 링 용량 (각각, 2의 거듭제곱)
+ */
+#define MEAS_QUEUE_AUX_SIZE 16
+
+#if (MEAS_QUEUE_SIZE & (MEAS_QUEUE_SIZE - 1)) != 0
+#error "MEAS_QUEUE_SIZE must be a power of two"
+#endif
+#if (MEAS_QUEUE_AUX_SIZE & (MEAS_QUEUE_AUX_SIZE - 1)) != 0
+#error "MEAS_QUEUE_AUX_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief 한 번의 추가에서 자리 차지를 다시 시도하는 최대 횟수
+ *
+ * 단일 코어에서는 선점한 생산자 하나마다 한 번씩만 실패하므로 센서 인터럽트 수보다 크면 된다.
+ */
+#define MEAS_QUEUE_MAX_RETRIES 8u
+
+/**
+ * @brief 측정 종류
+ */
+typedef enum {
+    MEAS_TYPE_IMU = 0,  /**< IMU (각속도/가속도) */
+    MEAS_TYPE_BARO,     /**< 기압계 (보상된 기압/온도) */
+    MEAS_TYPE_MAG,      /**< 자력계 (원시 측정) */
+    MEAS_TYPE_GNSS,     /**< GNSS 위치/속도 */
+    MEAS_TYPE_COUNT     /**< 종류 수 */
+} MeasType;
+
+/**
+ * @brief 전체 슬롯 수 (IMU 링 + 나머지 종류 링)
+ */
+#define MEAS_QUEUE_CAPACITY (MEAS_QUEUE_SIZE + (MEAS_TYPE_COUNT - 1) * MEAS_QUEUE_AUX_SIZE)
+
+/**
+ * @brief 가득 찼을 때의 정책
+ */
+typedef enum {
+    MEAS_QUEUE_DROP_OLDEST = 0, /**< 같은 종류의 가장 오래된 메시지를 버리고 새 메시지를 넣음 */
+    MEAS_QUEUE_DROP_NEWEST      /**< 새 메시지를 버림 */
+} MeasQueuePolicy;
+
+/**
+ * @brief 고정 크기 측정 메시지
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 측정 시각 (us) */
+    uint8_t type;              /**< 측정 종류 (MeasType) */
+    union {
+        struct {
+            Vector3f gyro;     /**< 각속도 (rad/s, 센서 좌표계) */
+            Vector3f accel;    /**< 가속도 (m/s^2, 센서 좌표계) */
+        } imu;
+        struct {
+            float pressure_pa; /**< 보상된 기압 (Pa) */
+            float temperature_c; /**< 센서 온도 (°C) */
+        } baro;
+        Vector3f mag;          /**< 자력계 (원시 측정) */
+        struct {
+            Vector3f pos;      /**< 위치 (NED, m) */
+            Vector3f vel;      /**< 속도 (NED, m/s) */
+            uint16_t h_acc_cm; /**< 수평 위치 정확도 (cm, 0이면 보고 없음) */
+            uint16_t v_acc_cm; /**< 수직 위치 정확도 (cm, 0이면 보고 없음) */
+            uint16_t s_acc_cms; /**< 속도 정확도 (cm/s, 0이면 보고 없음) */
+            uint8_t components; /**< 융합할 성분 (EKF_GpsComponent 조합) */
+        } gnss;
+    } data;
+} MeasMessage;
+
+/**
+ * @brief 대기열 슬롯
+ */
+typedef struct {
+    atomic_uint_fast32_t seq;  /**< 슬롯 순번 (pos이면 빈 칸, pos + 1이면 채워진 칸) */
+    uint32_t ticket;           /**< 도착 번호 (종류 사이 순서, seq와 함께 게시) */
+    MeasMessage msg;           /**< 메시지 */
+} MeasQueueSlot;
+
+/**
+ * @brief 종류별 링 (슬롯은 MeasQueue.slot[base .. base + mask])
+ */
+typedef struct {
+    atomic_uint_fast32_t enqueue_pos; /**< 다음 쓰기 위치 (생산자끼리 비교-교환) */
+    atomic_uint_fast32_t dequeue_pos; /**< 다음 읽기 위치 (소비자와 밀어내는 생산자가 비교-교환) */
+    uint16_t base;             /**< 첫 슬롯 번호 */
+    uint16_t mask;             /**< 링 용량 - 1 */
+} MeasQueueRing;
+
+/**
+ * @brief 종류별 통계 카운터 (원자적 증가)
+ */
+typedef struct {
+    atomic_uint_fast32_t pushed;   /**< 넣은 메시지 수 */
+    atomic_uint_fast32_t overflow; /**< 가득 차서 버린 새 메시지 수 (실패한 push마다 하나) */
+    atomic_uint_fast32_t evicted;  /**< 새 메시지에 밀려난 메시지 수 (잃은 수는 overflow + evicted) */
+} MeasQueueCounters;
+
+/**
+ * @brief 종류별 통계 스냅숏
+ */
+typedef struct {
+    uint32_t pushed;           /**< 넣은 메시지 수 */
+    uint32_t overflow;         /**< 가득 차서 버린 새 메시지 수 */
+    uint32_t evicted;          /**< 밀려난 메시지 수 */
+} MeasQueueTypeStats;
+
+/**
+ * @brief 대기열 통계 스냅숏
+ */
+typedef struct {
+    MeasQueueTypeStats type[MEAS_TYPE_COUNT]; /**< 종류별 통계 */
+    uint32_t popped;           /**< 소비자가 꺼낸 메시지 수 */
+    uint32_t contended;        /**< 다른 생산자와 경합해 다시 시도한 수 */
+} MeasQueueStats;
+
+/**
+ * @brief MPSC 측정 대기열
+ */
+typedef struct {
+    MeasQueueSlot slot[MEAS_QUEUE_CAPACITY]; /**< 슬롯 (종류별 링이 나눠 씀) */
+    MeasQueueRing ring[MEAS_TYPE_COUNT]; /**< 종류별 링 */
+    atomic_uint_fast32_t ticket;   /**< 다음 도착 번호 */
+    uint8_t policy[MEAS_TYPE_COUNT]; /**< 종류별 가득 참 정책 (MeasQueuePolicy) */
+    MeasQueueCounters counters[MEAS_TYPE_COUNT]; /**< 종류별 카운터 */
+    atomic_uint_fast32_t popped;   /**< 꺼낸 메시지 수 */
+    atomic_uint_fast32_t contended; /**< 경합 재시도 수 */
+} MeasQueue;
+
+/**
+ * @brief 대기열 초기화 (모든 종류 MEAS_QUEUE_DROP_OLDEST)
+ *
+ * 생산자와 소비자가 동작하기 전에 호출해야 한다.
+ *
+ * @param queue 대기열
+ * @return bool 성공 여부
+ */
+bool meas_queue_init(MeasQueue *queue);
+
+/**
+ * @brief 종류별 가득 참 정책 설정 (생산자가 동작하기 전에 호출)
+ *
+ * @param queue 대기열
+ * @param type 측정 종류
+ * @param policy 정책
+ * @return bool 성공 여부
+ */
+bool meas_queue_set_policy(MeasQueue *queue, MeasType type, MeasQueuePolicy policy);
+
+/**
+ * @brief 메시지 추가 (생산자, 인터럽트 문맥 가능)
+ *
+ * @param queue 대기열
+ * @param msg 메시지 (type이 유효해야 함)
+ * @return bool 성공 여부 (새 메시지를 버렸으면 false, 같은 종류의 오래된 메시지를 밀어내고 넣었으면 true)
+ */
+bool meas_queue_push(MeasQueue *queue, const MeasMessage *msg);
+
+/**
+ * @brief IMU 샘플 추가
+ *
+ * @param queue 대기열
+ * @param timestamp_us 샘플 시각 (us)
+ * @param gyro 각속도 (rad/s)
+ * @param accel 가속도 (m/s^2)
+ * @return bool 성공 여부
+ */
+bool meas_queue_push_imu(MeasQueue *queue, uint32_t timestamp_us, Vector3f gyro, Vector3f accel);
+
+/**
+ * @brief 기압 샘플 추가
+ *
+ * @param queue 대기열
+ * @param timestamp_us 측정 시각 (us)
+ * @param pressure_pa 보상된 기압 (Pa)
+ * @param temperature_c 센서 온도 (°C)
+ * @return bool 성공 여부
+ */
+bool meas_queue_push_baro(MeasQueue *queue, uint32_t timestamp_us, float pressure_pa, float temperature_c);
+
+/**
+ * @brief 자력계 측정 추가
+ *
+ * @param queue 대기열
+ * @param timestamp_us 측정 시각 (us)
+ * @param mag 원시 자력계 측정
+ * @return bool 성공 여부
+ */
+bool meas_queue_push_mag(MeasQueue *queue, uint32_t timestamp_us, Vector3f mag);
+
+/**
+ * @brief GNSS 측정 추가
+ *
+ * @param queue 대기열
+ * @param timestamp_us 측정 시각 (us)
+ * @param pos 위치 (NED, m)
+ * @param vel 속도 (NED, m/s)
+ * @param components 융합할 성분 (EKF_GpsComponent 조합)
+ * @return bool 성공 여부
+ */
+bool meas_queue_push_gnss(MeasQueue *queue, uint32_t timestamp_us, Vector3f pos, Vector3f vel,
+                          uint8_t components);
+
+/**
+ * @brief 수신기 보고 정확도가 붙은 GNSS 측정 추가 (UBX NAV-PVT hAcc/vAcc/sAcc)
+ *
+ * 정확도는 슬롯을 키우지 않도록 cm 단위 u16으로 저장한다 (655 m 이상은 포화, 생략 문턱보다 큼).
+ *
+ * @param queue 대기열
+ * @param timestamp_us 측정 시각 (us)
+ * @param pos 위치 (NED, m)
+ * @param vel 속도 (NED, m/s)
+ * @param components 융합할 성분 (EKF_GpsComponent 조합)
+ * @param h_acc 수평 위치 정확도 (m, 0이면 보고 없음)
+ * @param v_acc 수직 위치 정확도 (m, 0이면 보고 없음)
+ * @param s_acc 속도 정확도 (m/s, 0이면 보고 없음)
+ * @return bool 성공 여부
+ */
+bool meas_queue_push_gnss_accuracy(MeasQueue *queue, uint32_t timestamp_us, Vector3f pos, Vector3f vel,
+                                   uint8_t components, float h_acc, float v_acc, float s_acc);
+
+/**
+ * @brief 가장 먼저 도착한 메시지 꺼내기 (소비자 전용)
+ *
+ * @param queue 대기열
+ * @param msg 꺼낸 메시지 저장 위치
+ * @return bool 성공 여부 (비었거나 어느 링의 맨 앞 슬롯을 아직 채우는 중이면 false)
+ */
+bool meas_queue_pop(MeasQueue *queue, MeasMessage *msg);
+
+/**
+ * @brief 저장된 메시지 수 (호출 시점의 근사값, 채우는 중인 슬롯 포함)
+ *
+ * @param queue 대기열
+ * @return uint32_t 메시지 수
+ */
+uint32_t meas_queue_count(const MeasQueue *queue);
+
+/**
+ * @brief 통계 스냅숏
+ *
+ * @param queue 대기열
+ * @param stats 통계 저장 위치
+ * @return bool 성공 여부
+ */
+bool meas_queue_get_stats(const MeasQueue *queue, MeasQueueStats *stats);
+
+#endif /* MEAS_QUEUE_H */
@@ -0,0 +1,222 @@
+/**
+ * @file ms5611.h
+ * @brief MS5611 기압계 비차단 변환 드라이버 (SPI + DMA, 단발 타이머 상태 기계)
+ *
+ * MS5611은 명령을 받은 뒤 D1(기압)/D2(온도) 변환에 OSR 4096 기준 약 9 ms씩 걸린다.
+ * 변환을 기다리며 HAL_Delay로 바쁜 대기하면 한 주기에 약 18 ms의 CPU를 버리므로,
+ * 변환 대기는 단발(one-pulse) 기본 타이머가, 명령/결과 전송은 SPI DMA가 맡고
+ * CPU는 각 단계 완료 인터럽트에서 다음 단계를 시작하는 일만 한다.
+ *
+ * 상태 기계 (한 주기):
+ *   [D2 주기이면] CMD_D2 -(DMA)-> CONV_D2 -(타이머)-> READ_D2 -(DMA)->
+ *   CMD_D1 -(DMA)-> CONV_D1 -(타이머)-> READ_D1 -(DMA)-> 보상, 링 추가 -> WAIT -(타이머)-> 다음 주기
+ * - 온도(D2)는 temperature_interval 주기마다 한 번만 변환한다 (온도는 천천히 변하므로
+ *   그 사이 주기는 기압 변환만 해서 기압 샘플 속도를 높일 수 있다).
+ * - 샘플 시각은 D1 변환 구간의 중간이다 (명령 완료 시각 + 변환 시간 / 2).
+ * - 주기 시작 간격은 period_us이며, 변환이 더 오래 걸리면 바로 다음 주기를 시작한다.
+ * - 보상은 데이터시트의 1차 + 2차(20°C 미만) 정수 보상이다.
+ * - ADC 결과가 0이면 변환이 끝나기 전에 읽었거나 중단된 것이므로 버리고 주기를 다시 시작한다.
+ *
+ * 링의 샘플은 융합 태스크가 꺼내 baro_altitude_update -> fusion_scheduler_push_baro로 넘긴다.
+ *
+ * 연결 예 (CubeMX: TIM6 또는 TIM7 전역 인터럽트 활성화, SPI DMA 송수신 연결):
+ * - 초기화: ms5611_init(&baro, &bus, &htim7, &baro_ring, timebase_now_us, NULL), ms5611_start(&baro)
+ * - HAL_TIM_PeriodElapsedCallback: ms5611_handle_timer(&baro, htim)
+ * - HAL_SPI_TxRxCpltCallback: ms5611_handle_dma_complete(&baro, hspi)
+ * - HAL_SPI_ErrorCallback: ms5611_handle_dma_error(&baro, hspi)
+ *
+ * SPI 버스는 기압계 전용이어야 한다 (IMU의 FIFO 버스트와 버스를 중재하지 않는다).
+ */
+
+#ifndef MS5611_H
+#define MS5611_H
+
+#include "stm32l4xx_hal.h"
+#include "sensors/baro_ring.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define MS5611_DEFAULT_PRESSURE_OSR MS5611_OSR_4096
+#define MS5611_DEFAULT_TEMPERATURE_OSR MS5611_OSR_4096
+#define MS5611_DEFAULT_TEMPERATURE_INTERVAL 1      /**< 매 주기 온도 변환 */
+#define MS5611_DEFAULT_PERIOD_US 20000u            /**< 50 Hz */
+
+/**
+ * @brief 변환 시간 여유 (us, 데이터시트 최대 변환 시간에 더함)
+ */
+#define MS5611_CONVERSION_MARGIN_US 100u
+
+/**
+ * @brief 오버샘플링 비율
+ */
+typedef enum {
+    MS5611_OSR_256 = 0,        /**< 최대 0.60 ms */
+    MS5611_OSR_512 = 1,        /**< 최대 1.17 ms */
+    MS5611_OSR_1024 = 2,       /**< 최대 2.28 ms */
+    MS5611_OSR_2048 = 3,       /**< 최대 4.54 ms */
+    MS5611_OSR_4096 = 4        /**< 최대 9.04 ms */
+} Ms5611Osr;
+
+/**
+ * @brief 시각 함수 (us, timebase_now_us 등)
+ */
+typedef uint32_t (*Ms5611ClockFn)(void);
+
+/**
+ * @brief SPI 연결
+ */
+typedef struct {
+    SPI_HandleTypeDef *hspi;   /**< SPI 핸들 (DMA 연결 필요, 모드 0 또는 3) */
+    GPIO_TypeDef *cs_port;     /**< 칩 선택 포트 */
+    uint16_t cs_pin;           /**< 칩 선택 핀 */
+} Ms5611Bus;
+
+/**
+ * @brief 변환 설정
+ */
+typedef struct {
+    Ms5611Osr pressure_osr;    /**< 기압(D1) 오버샘플링 */
+    Ms5611Osr temperature_osr; /**< 온도(D2) 오버샘플링 */
+    uint16_t temperature_interval; /**< 온도 변환 간격 (주기 수, 1 이상) */
+    uint32_t period_us;        /**< 주기 시작 간격 (us, 0이면 쉬지 않고 연속 변환) */
+} Ms5611Config;
+
+/**
+ * @brief 변환 상태
+ */
+typedef enum {
+    MS5611_STATE_IDLE = 0,     /**< 정지 */
+    MS5611_STATE_CMD_D2,       /**< 온도 변환 명령 전송 중 (DMA) */
+    MS5611_STATE_CONV_D2,      /**< 온도 변환 대기 (타이머) */
+    MS5611_STATE_READ_D2,      /**< 온도 결과 읽기 (DMA) */
+    MS5611_STATE_CMD_D1,       /**< 기압 변환 명령 전송 중 (DMA) */
+    MS5611_STATE_CONV_D1,      /**< 기압 변환 대기 (타이머) */
+    MS5611_STATE_READ_D1,      /**< 기압 결과 읽기 (DMA) */
+    MS5611_STATE_WAIT          /**< 다음 주기 대기 (타이머) */
+} Ms5611State;
+
+/**
+ * @brief 드라이버 통계
+ */
+typedef struct {
+    uint32_t samples;          /**< 링에 넣은 샘플 수 */
+    uint32_t temperature_updates; /**< 온도 변환 수 */
+    uint32_t invalid_reads;    /**< ADC 결과가 0이라 버린 변환 수 */
+    uint32_t dma_errors;       /**< SPI DMA 오류 수 */
+    uint32_t overruns;         /**< 주기보다 변환이 오래 걸린 수 */
+} Ms5611Stats;
+
+/**
+ * @brief MS5611 드라이버 구조체
+ */
+typedef struct {
+    Ms5611Bus bus;                 /**< SPI 연결 */
+    TIM_HandleTypeDef *htim;       /**< 변환 대기용 기본 타이머 (TIM6/TIM7, 1 MHz) */
+    BaroRing *ring;                /**< 샘플을 넣을 링 버퍼 */
+    Ms5611ClockFn clock;           /**< 시각 함수 */
+    Ms5611Config config;           /**< 변환 설정 */
+    uint16_t prom[8];              /**< 공장 보정 PROM (C1..C6 = prom[1..6]) */
+
+    volatile Ms5611State state;    /**< 변환 상태 */
+    volatile bool running;         /**< 변환 진행 여부 (false면 현재 주기 끝에 정지) */
+    uint32_t cycle_start_us;       /**< 현재 주기 시작 시각 (us) */
+    uint32_t d1_start_us;          /**< 기압 변환 시작 시각 (us) */
+    uint16_t cycles_since_temperature; /**< 마지막 온도 변환 이후 주기 수 */
+    bool has_temperature;          /**< 온도 결과 보유 여부 */
+    uint32_t d2;                   /**< 마지막 온도 원시값 */
+
+    uint8_t tx_buffer[4];          /**< DMA 송신 버퍼 */
+    uint8_t rx_buffer[4];          /**< DMA 수신 버퍼 */
+
+    Ms5611Stats stats;             /**< 통계 */
+    bool initialized;              /**< 초기화 여부 */
+} Ms5611;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool ms5611_default_config(Ms5611Config *config);
+
+/**
+ * @brief 센서 리셋, PROM 읽기와 CRC 확인, 타이머 설정
+ *
+ * 차단형 SPI 전송으로 PROM을 읽는다. 인터럽트를 활성화하기 전에 호출해야 한다.
+ * 타이머는 현재 APB1 타이머 클럭에서 1 MHz가 되도록 분주비를 다시 쓰고 단발 모드로 둔다.
+ *
+ * @param baro 드라이버 구조체 포인터
+ * @param bus SPI 연결
+ * @param htim 기본 타이머 핸들 (TIM6 또는 TIM7)
+ * @param ring 샘플 링 버퍼
+ * @param clock 시각 함수
+ * @param config 변환 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (PROM CRC 불일치, 지원하지 않는 타이머/설정이면 false)
+ */
+bool ms5611_init(Ms5611 *baro, const Ms5611Bus *bus, TIM_HandleTypeDef *htim, BaroRing *ring,
+                 Ms5611ClockFn clock, const Ms5611Config *config);
+
+/**
+ * @brief 연속 변환 시작 (첫 주기는 온도부터)
+ *
+ * @param baro 드라이버 구조체 포인터
+ * @return bool 성공 여부 (이미 진행 중이면 false)
+ */
+bool ms5611_start(Ms5611 *baro);
+
+/**
+ * @brief 연속 변환 정지 요청 (진행 중인 주기는 끝까지 수행)
+ *
+ * @param baro 드라이버 구조체 포인터
+ */
+void ms5611_stop(Ms5611 *baro);
+
+/**
+ * @brief 타이머 만료 처리 (변환 완료 또는 주기 대기 끝)
+ *
+ * @param baro 드라이버 구조체 포인터
+ * @param htim 만료된 타이머 핸들 (다른 타이머이면 무시)
+ */
+void ms5611_handle_timer(Ms5611 *baro, TIM_HandleTypeDef *htim);
+
+/**
+ * @brief SPI DMA 완료 처리 (다음 단계 시작, 결과 보상 후 링에 추가)
+ *
+ * @param baro 드라이버 구조체 포인터
+ * @param hspi 완료된 SPI 핸들 (다른 SPI이면 무시)
+ */
+void ms5611_handle_dma_complete(Ms5611 *baro, SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief SPI DMA 오류 처리 (현재 주기를 버리고 한 주기 뒤 온도부터 다시 시작)
+ *
+ * @param baro 드라이버 구조체 포인터
+ * @param hspi 오류가 난 SPI 핸들 (다른 SPI이면 무시)
+ */
+void ms5611_handle_dma_error(Ms5611 *baro, SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief 원시값 보상 (데이터시트 1차 + 2차 보상)
+ *
+ * @param prom 공장 보정 PROM
+ * @param d1 기압 원시값 (24비트)
+ * @param d2 온도 원시값 (24비트)
+ * @param pressure_pa 결과 기압 (Pa)
+ * @param temperature_c 결과 온도 (°C)
+ * @return bool 성공 여부
+ */
+bool ms5611_compensate(const uint16_t prom[8], uint32_t d1, uint32_t d2, float *pressure_pa, float *temperature_c);
+
+/**
+ * @brief 드라이버 통계
+ *
+ * @param baro 드라이버 구조체 포인터
+ * @return const Ms5611Stats* 통계 (baro가 NULL이면 NULL)
+ */
+const Ms5611Stats *ms5611_get_stats(const Ms5611 *baro);
+
+#endif /* MS5611_H */
@@ -0,0 +1,280 @@
+/**
+ * @file pil_replay.h
+ * @brief PIL(processor-in-the-loop) 재생기: 비행 기록의 센서 레코드를 QSPI 메모리 매핑으로 읽어 수집 대기열에 주입
+ *
+ * HIL(hil_feed.h)은 호스트가 센서 레코드를 보내야 한다. PIL 빌드에서는 보드 혼자 이전 비행 기록
+ * 세션(flash_log_build_index로 찾은 FlashLogSession)을 읽어 같은 자리(센서 드라이버 대신)에 넣는다.
+ * 나머지 펌웨어(측정 대기열 비우기, 융합 스케줄러, 기록)는 그대로 돌고, 항법 해와 재생 상태
+ * 레코드(FLASH_LOG_REC_PIL, PilReplayRecord)는 같은 기록기의 새 세션에 남는다. 새 세션은 이전 기록
+ * 뒤에 이어 쓰므로 재생하는 세션을 덮지 않는다. 실제 칩과 실제 비행 데이터로 CPU 부하와 마감 초과를
+ * 호스트 없이 잰다.
+ *
+ * 읽기 (기록 태스크, pil_replay_fill): 기록 엔진이 유휴일 때 다음 블록을 flash_log_map_block으로
+ * 매핑해 블록 버퍼(PIL_REPLAY_BLOCKS개, 블록당 4 KB)에 복사한다. 압축 모드 블록은
+ * flash_log_read_block이 매핑한 채로 풀어 준다. 매핑 포인터는 다음 플래시 쓰기 전까지만 유효하므로
+ * 복사는 flash_log_service와 같은 문맥에서 한다. 블록 CRC는 확인하지 않으며, 헤더 세션 번호가
+ * 다른 블록은 건너뛴다.
+ *
+ * 배출 (타이머 인터럽트, pil_replay_service): 레코드 시각이 재생 시계(pil_replay_now_us)에 이르면
+ * 기록 시각 그대로 내보낸다. 재생 시계는 "로컬 시각 x speed + 차이"이며, 시작할 때 첫 레코드가
+ * lead_us 뒤에 나오도록 차이를 잡는다. speed > 1이면 배속 재생이다. 측정 시각은 기록 시간축이므로
+ * 필터가 보는 dt와 항법 해는 배속과 관계없이 원래 비행과 같다.
+ *
+ * 부하와 마감: 융합 스케줄러(fusion_scheduler_init의 clock)와 rtos_tasks의 시간 콜백을
+ * pil_replay_now_us로 주면 처리 시간, 샘플 지연, 예산이 모두 재생 시간축(실제 시간 x speed)으로
+ * 재진다. 따라서 fusion_monitor의 부하율과 마감 초과는 "이 배속으로 들어오는 센서를 이 칩이 제때
+ * 처리하는가"를 나타낸다 (speed 4에서 부하 50%이면 실시간 부하 약 12.5%). pil_replay_log는
+ * 감시기 누적값을 report_us마다 기록한다. 시계는 시작 뒤 바뀌므로 pil_replay_start는 융합 태스크를
+ * 시작하기 전에 부른다.
+ *
+ * - IMU/기압/자기장: meas_queue_push_imu/baro/mag (기록 단위 그대로)
+ * - GNSS: hil_feed_read_fix와 같은 시퀀스 이중 버퍼 (pil_replay_read_fix)
+ * - 그 밖의 레코드(항법 해, 압축 스트림, 이벤트 전 보관 등)는 건너뛴다. 압축 스트림(log_codec.h)으로만
+ *   남긴 센서는 재생되지 않으므로 재생할 비행은 원시 센서 레코드(flash_log_imu 등)로 기록해야 한다.
+ * - 레코드 시각이 resync_us보다 크게 뛰면(기록 중단 등) 그 레코드가 바로 나오도록 차이를 다시 잡는다.
+ *
+ * 연결 예 (PIL 빌드, 센서 드라이버 대신):
+ * - 초기화: flash_log_build_index로 세션 선택 → pil_replay_init → pil_replay_fill → pil_replay_start
+ * - 기록 태스크: flash_log_service(&log) 뒤에 pil_replay_fill(&pil)
+ * - 1 kHz x speed 이상 타이머 인터럽트: pil_replay_service(&pil, timebase_now_us())가 IMU 샘플을
+ *   내보냈으면 rtos_tasks_notify_imu_from_isr
+ * - GNSS 처리 경로: ubx_gnss_read_fix 대신 pil_replay_read_fix
+ * - 작성자(융합 태스크) 사이클마다: pil_replay_log(&pil, &log, &monitor)
+ * 블록 버퍼는 단일 생산자(기록 태스크)/단일 소비자(타이머 인터럽트)이다.
+ */
+
+#ifndef PIL_REPLAY_H
+#define PIL_REPLAY_H
+
+#include "log/flash_log.h"
+#include "sensors/meas_queue.h"
+#include "sensors/ubx_gnss.h"
+#include "nav/fusion_monitor.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 블록 버퍼 수 (2의 거듭제곱)
+ */
+#define PIL_REPLAY_BLOCKS 2u
+
+#if (PIL_REPLAY_BLOCKS & (PIL_REPLAY_BLOCKS - 1u)) != 0
+#error "PIL_REPLAY_BLOCKS must be a power of two"
+#endif
+
+/**
+ * @brief 최대 배속
+ */
+#define PIL_REPLAY_MAX_SPEED 16u
+
+/**
+ * @brief GNSS 해 읽기 최대 재시도 횟수
+ */
+#define PIL_REPLAY_MAX_RETRIES 4
+
+/**
+ * @brief 기본 설정
+ */
+#define PIL_REPLAY_DEFAULT_SPEED 1u          /**< 배속 (1 = 실시간) */
+#define PIL_REPLAY_DEFAULT_LEAD_US 20000u    /**< 시작부터 첫 레코드 배출까지 (us) */
+#define PIL_REPLAY_DEFAULT_LATE_US 2000u     /**< 늦은 배출 판정 (재생 시간축 us) */
+#define PIL_REPLAY_DEFAULT_RESYNC_US 1000000u /**< 레코드 시각 도약 문턱 (us) */
+#define PIL_REPLAY_DEFAULT_REPORT_US 1000000u /**< 재생 상태 기록 주기 (재생 시간축 us) */
+
+/**
+ * @brief 재생 상태 레코드 플래그
+ */
+#define PIL_REPLAY_FLAG_FINISHED 0x01u       /**< 세션을 끝까지 재생함 */
+
+/**
+ * @brief 재생기 설정
+ */
+typedef struct {
+    uint8_t speed;             /**< 배속 (1..PIL_REPLAY_MAX_SPEED) */
+    uint32_t lead_us;          /**< 시작부터 첫 레코드 배출까지 (로컬 us) */
+    uint32_t late_us;          /**< 배출이 레코드 시각보다 이만큼 넘게 늦으면 늦음으로 셈 (재생 시간축 us) */
+    uint32_t resync_us;        /**< 레코드 시각이 이보다 크게 뛰면 차이 다시 잡음 (us, 0 초과) */
+    uint32_t report_us;        /**< 재생 상태 기록 주기 (재생 시간축 us, 0 초과) */
+} PilReplayConfig;
+
+/**
+ * @brief 재생 상태 레코드 (FLASH_LOG_REC_PIL, 56바이트)
+ *
+ * 감시기 값은 모든 비행 단계의 합(최댓값은 최댓값)이며 시간은 재생 시간축 us(실제 시간 x speed)이다.
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 재생 시각 (기록 시간축 us) */
+    uint32_t block;            /**< 다음에 읽을 블록 (세션 첫 블록 기준) */
+    uint32_t released;         /**< 내보낸 레코드 수 */
+    uint32_t cycles;           /**< IMU 샘플을 처리한 융합 사이클 수 */
+    uint32_t samples;          /**< 처리한 IMU 샘플 수 */
+    uint32_t misses;           /**< 마감을 넘긴 샘플 수 */
+    uint32_t overloads;        /**< 부하율이 100%를 넘은 사이클 수 */
+    uint32_t max_busy_us;      /**< 최대 사이클 처리 시간 */
+    uint32_t max_late_us;      /**< 최대 샘플 지연 */
+    uint32_t late;             /**< 늦게 내보낸 레코드 수 */
+    uint32_t queue_drops;      /**< 측정 대기열이 받지 않은 레코드 수 */
+    uint32_t underruns;        /**< 읽기가 재생을 못 따라간 횟수 */
+    uint16_t load;             /**< 마지막 사이클 부하율 (0.1% 단위) */
+    uint16_t peak_load;        /**< 최대 사이클 부하율 (0.1% 단위) */
+    uint8_t speed;             /**< 배속 */
+    uint8_t flags;             /**< PIL_REPLAY_FLAG_* */
+    uint8_t reserved[2];       /**< 예약 (0) */
+} PilReplayRecord;
+
+_Static_assert(sizeof(PilReplayRecord) == 56, "PilReplayRecord layout changed");
+
+/**
+ * @brief 재생기 통계
+ */
+typedef struct {
+    uint32_t blocks;           /**< 읽은 블록 수 */
+    uint32_t bad_blocks;       /**< 읽기 실패나 세션 불일치로 건너뛴 블록 수 */
+    uint32_t busy;             /**< 기록 엔진이 바빠 읽기를 미룬 횟수 */
+    uint32_t skipped;          /**< 재생하지 않는 레코드 수 */
+    uint32_t released[MEAS_TYPE_COUNT]; /**< 종류별 내보낸 레코드 수 */
+    uint32_t queue_drops;      /**< 측정 대기열이 받지 않은 레코드 수 */
+    uint32_t late;             /**< 늦게 내보낸 레코드 수 */
+    uint32_t underruns;        /**< 배출할 레코드가 블록 버퍼에 없던 횟수 (연속 구간은 한 번) */
+    uint32_t resyncs;          /**< 차이를 다시 잡은 횟수 */
+    uint32_t reports;          /**< 기록한 재생 상태 레코드 수 */
+    uint32_t report_drops;     /**< 기록기가 받지 않은 재생 상태 레코드 수 */
+} PilReplayStats;
+
+/**
+ * @brief PIL 재생기
+ */
+typedef struct {
+    FlashLog *log;             /**< 비행 기록기 (원본 세션 읽기, 새 세션 기록) */
+    MeasQueue *queue;          /**< 측정 대기열 */
+    PilReplayConfig config;    /**< 설정 */
+    uint16_t session;          /**< 재생 세션 번호 */
+    uint32_t first_block;      /**< 세션 첫 블록 번호 */
+    uint32_t block_count;      /**< 세션 블록 수 */
+
+    uint8_t block[PIL_REPLAY_BLOCKS][FLASH_LOG_BUFFER_SIZE] __attribute__((aligned(8))); /**< 블록 버퍼 */
+    atomic_uint_fast32_t head; /**< 다음 채울 버퍼 (기록 태스크 전용) */
+    atomic_uint_fast32_t tail; /**< 재생 중인 버퍼 (서비스 전용) */
+    atomic_uint_fast32_t next_block; /**< 다음에 읽을 블록 (세션 첫 블록 기준) */
+
+    // 배출 (서비스 문맥)
+    uint16_t offset;           /**< 재생 중인 버퍼의 다음 레코드 위치 */
+    const uint8_t *pending;    /**< 배출을 기다리는 레코드 페이로드 (NULL이면 없음) */
+    uint8_t pending_type;      /**< 그 레코드 종류 */
+    uint32_t pending_us;       /**< 그 레코드 시각 (us) */
+    uint32_t last_imu_us;      /**< 마지막 IMU 레코드 시각 (us) */
+    bool starved;              /**< 블록 버퍼가 빈 채 배출을 기다리는 중 */
+    atomic_uint_fast32_t offset_us; /**< 재생 시각 - 로컬 시각 x speed (us, 모듈로 2^32) */
+    atomic_bool running;       /**< 재생 중 (시계 전환) */
+    atomic_bool finished;      /**< 세션을 끝까지 재생함 */
+
+    UbxGnssFix fix[2];         /**< GNSS 해 이중 버퍼 (게시된 버퍼 = seq & 1) */
+    atomic_uint_fast32_t fix_seq; /**< GNSS 해 게시 시퀀스 (0 = 게시 전) */
+
+    // 상태 기록 (작성자 문맥)
+    uint32_t report_last_us;   /**< 마지막 기록 재생 시각 (us) */
+    bool reported_finish;      /**< 끝난 뒤 마지막 레코드를 기록함 */
+
+    PilReplayStats stats;      /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} PilReplay;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool pil_replay_default_config(PilReplayConfig *config);
+
+/**
+ * @brief 재생기 초기화 (블로킹 없음, 기록 시작 전)
+ *
+ * @param pil 구조체 포인터
+ * @param log 비행 기록기 (NOR 저장소면 메모리 매핑으로 읽음, 재생 세션 뒤에 새 세션 기록)
+ * @param queue 측정 대기열
+ * @param session 재생할 세션 (flash_log_build_index 결과)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (세션이 저장된 블록 범위를 넘거나 설정이 잘못되면 false)
+ */
+bool pil_replay_init(PilReplay *pil, FlashLog *log, MeasQueue *queue, const FlashLogSession *session,
+                     const PilReplayConfig *config);
+
+/**
+ * @brief 빈 블록 버퍼 채우기 (기록 태스크, flash_log_service와 같은 문맥)
+ *
+ * 기록 엔진이 유휴일 때만 읽으므로 엔진이 바쁘면 다음 호출로 미룬다.
+ *
+ * @param pil 구조체 포인터
+ * @return uint32_t 이번 호출에서 채운 블록 수
+ */
+uint32_t pil_replay_fill(PilReplay *pil);
+
+/**
+ * @brief 재생 시작 (첫 블록을 채운 뒤, 융합 태스크 시작 전)
+ *
+ * 첫 레코드가 now_us + lead_us에 나오도록 재생 시계를 맞추고 pil_replay_now_us를 재생 시계로 바꾼다.
+ * 동시에 재생할 수 있는 재생기는 하나이다.
+ *
+ * @param pil 구조체 포인터
+ * @param now_us 현재 로컬 시각 (us)
+ * @return bool 성공 여부 (채운 블록에 재생할 레코드가 없으면 false)
+ */
+bool pil_replay_start(PilReplay *pil, uint32_t now_us);
+
+/**
+ * @brief 재생 시계 (FusionClockFn 형식, 어느 문맥이든)
+ *
+ * @return uint32_t 재생 시각 (us, 재생 전이면 timebase_now_us)
+ */
+uint32_t pil_replay_now_us(void);
+
+/**
+ * @brief 배출 시각이 된 레코드를 수집 대기열로 내보냄 (타이머 인터럽트)
+ *
+ * @param pil 구조체 포인터
+ * @param now_us 현재 로컬 시각 (us)
+ * @return uint32_t 이번 호출에서 내보낸 IMU 샘플 수 (융합 태스크 알림 판단)
+ */
+uint32_t pil_replay_service(PilReplay *pil, uint32_t now_us);
+
+/**
+ * @brief 최신 GNSS 해 읽기 (ubx_gnss_read_fix와 같은 규약)
+ *
+ * @param pil 구조체 포인터
+ * @param fix 결과
+ * @param seq 읽은 해의 시퀀스 (NULL 가능, 새 해 여부 판단용)
+ * @return bool 성공 여부 (게시 전이거나 재시도 한도 초과 시 false)
+ */
+bool pil_replay_read_fix(const PilReplay *pil, UbxGnssFix *fix, uint32_t *seq);
+
+/**
+ * @brief 재생 상태를 주기마다 기록 (작성자 문맥, 융합 사이클마다 호출해도 report_us마다 한 번)
+ *
+ * 세션을 끝까지 재생하면 마지막 레코드를 한 번 더 남긴다.
+ *
+ * @param pil 구조체 포인터
+ * @param log 비행 기록기
+ * @param monitor 융합 루프 감시기 (NULL이면 감시기 값 0)
+ * @return bool 이번 호출에서 기록했으면 true
+ */
+bool pil_replay_log(PilReplay *pil, FlashLog *log, const FusionMonitor *monitor);
+
+/**
+ * @brief 세션을 끝까지 재생했는지
+ *
+ * @param pil 구조체 포인터
+ * @return bool 마지막 레코드까지 내보냈으면 true
+ */
+bool pil_replay_finished(const PilReplay *pil);
+
+/**
+ * @brief 통계
+ *
+ * @param pil 구조체 포인터
+ * @return const PilReplayStats* 통계 (NULL이면 NULL)
+ */
+const PilReplayStats *pil_replay_get_stats(const PilReplay *pil);
+
+#endif /* PIL_REPLAY_H */
@@ -0,0 +1,103 @@
+/**
+ * @file static_detector.h
+ * @brief 가속도계/자이로 분산 기반 정지 판정 (영속도 갱신 조건)
+ *
+ * IMU 샘플을 고정 길이 창 단위로 모아 가속도와 각속도의 분산(공분산 대각합)을
+ * 계산하고, 둘 다 임계값 이하이면 정지로 판정한다. 창 첫 샘플을 기준으로 편차를
+ * 누적하므로(shifted data) 중력(약 9.8 m/s^2) 위의 작은 분산도 float으로 정확히 구한다.
+ * 샘플당 비용은 덧셈/곱셈 십여 회이며 창 배열을 두지 않는다.
+ *
+ * 판정은 창이 끝날 때 갱신되지만, 정지 중 한 샘플의 가속도가 직전 창 평균에서
+ * 크게 벗어나면 창을 기다리지 않고 즉시 정지 판정을 해제한다 (발사 충격 등).
+ */
+
+#ifndef STATIC_DETECTOR_H
+#define STATIC_DETECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/vector3f.h"
+
+/**
+ * @brief 기본 판정 조건
+ */
+#define STATIC_DETECTOR_DEFAULT_WINDOW 100u        /**< 창 길이 (샘플, 1 kHz에서 0.1초) */
+#define STATIC_DETECTOR_DEFAULT_ACCEL_VAR 0.05f    /**< 가속도 분산 임계값 ((m/s^2)^2) */
+#define STATIC_DETECTOR_DEFAULT_GYRO_VAR 1.0e-4f   /**< 각속도 분산 임계값 ((rad/s)^2) */
+
+/**
+ * @brief 즉시 해제 임계값 (가속도 분산 임계값 배수, 4 시그마)
+ */
+#define STATIC_DETECTOR_SAMPLE_GATE 16.0f
+
+/**
+ * @brief 정지 판정기
+ */
+typedef struct {
+    uint16_t window;           /**< 창 길이 (샘플) */
+    float accel_var_max;       /**< 가속도 분산 임계값 ((m/s^2)^2) */
+    float gyro_var_max;        /**< 각속도 분산 임계값 ((rad/s)^2) */
+
+    uint16_t count;            /**< 현재 창 샘플 수 */
+    Vector3f accel_ref;        /**< 현재 창 기준 가속도 (첫 샘플) */
+    Vector3f gyro_ref;         /**< 현재 창 기준 각속도 (첫 샘플) */
+    Vector3f accel_sum;        /**< 기준 대비 가속도 편차 합 */
+    Vector3f gyro_sum;         /**< 기준 대비 각속도 편차 합 */
+    float accel_sq_sum;        /**< 기준 대비 가속도 편차 제곱합 */
+    float gyro_sq_sum;         /**< 기준 대비 각속도 편차 제곱합 */
+
+    Vector3f accel_mean;       /**< 마지막 창 가속도 평균 (m/s^2) */
+    Vector3f gyro_mean;        /**< 마지막 창 각속도 평균 (rad/s) */
+    float accel_var;           /**< 마지막 창 가속도 분산 ((m/s^2)^2) */
+    float gyro_var;            /**< 마지막 창 각속도 분산 ((rad/s)^2) */
+    bool has_window;           /**< 완료된 창 존재 여부 */
+    bool is_static;            /**< 정지 판정 */
+} StaticDetector;
+
+/**
+ * @brief 정지 판정기 초기화
+ *
+ * @param det 판정기
+ * @param window 창 길이 (샘플, 2 이상)
+ * @param accel_var_max 가속도 분산 임계값 ((m/s^2)^2)
+ * @param gyro_var_max 각속도 분산 임계값 ((rad/s)^2)
+ * @return bool 성공 여부
+ */
+bool static_detector_init(StaticDetector *det, uint16_t window, float accel_var_max, float gyro_var_max);
+
+/**
+ * @brief 판정 상태 초기화 (설정 유지, 비정지에서 다시 시작)
+ *
+ * @param det 판정기
+ * @return bool 성공 여부
+ */
+bool static_detector_reset(StaticDetector *det);
+
+/**
+ * @brief IMU 샘플 추가
+ *
+ * @param det 판정기
+ * @param accel 가속도계 측정값 (m/s^2)
+ * @param gyro 자이로 측정값 (rad/s)
+ * @return bool 이번 샘플로 창이 끝나 판정이 갱신되었으면 true
+ */
+bool static_detector_add_sample(StaticDetector *det, Vector3f accel, Vector3f gyro);
+
+/**
+ * @brief 정지 여부 조회
+ *
+ * @param det 판정기
+ * @return bool 정지 판정이면 true (det가 NULL이면 false)
+ */
+bool static_detector_is_static(const StaticDetector *det);
+
+/**
+ * @brief 마지막 창의 평균 각속도 조회 (정지 중이면 자이로 바이어스 추정값)
+ *
+ * @param det 판정기
+ * @param gyro_mean 평균 각속도 (rad/s)
+ * @return bool 성공 여부 (완료된 창이 없으면 false)
+ */
+bool static_detector_get_gyro_mean(const StaticDetector *det, Vector3f *gyro_mean);
+
+#endif /* STATIC_DETECTOR_H */
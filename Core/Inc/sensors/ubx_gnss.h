@@ -0,0 +1,241 @@
+/**
+ * @file ubx_gnss.h
+ * @brief u-blox UBX NAV-PVT/NAV-RELPOSNED 수신 드라이버 (UART 순환 DMA + IDLE 라인 이벤트)
+ *
+ * UART 수신은 순환 모드 DMA가 dma_buffer에 계속 쓰고, IDLE 라인/절반/완료 이벤트
+ * (HAL_UARTEx_RxEventCallback)마다 새로 들어온 구간만 DMA 버퍼 안에서 바로 파싱한다.
+ * 바이트 단위 인터럽트와 프레임 복사가 없으며, 체크섬은 바이트가 들어온 만큼
+ * 이벤트마다 이어서 누적하므로 프레임이 여러 이벤트에 걸쳐도 된다.
+ * NAV-PVT와 NAV-RELPOSNED 이외의 메시지는 체크섬 없이 길이만큼 건너뛴다.
+ *
+ * NAV-PVT가 검증되면 페이로드 필드를 DMA 버퍼에서 직접 읽어(순환 경계 포함)
+ * UbxGnssFix로 변환하고 이중 버퍼에 게시한다 (nav_publisher와 같은 시퀀스 방식).
+ * 측정 시각은 시간 펄스(TIMEPULSE, 정수 초 경계) 인터럽트 시각에 iTOW의 초 미만
+ * 부분을 더해 구하며, 최근 펄스가 없으면 수신 이벤트 시각을 쓴다. 발진기 주파수
+ * 오차까지 보정한 시각은 sys/time_sync.h의 time_sync_gnss_to_local로 다시 구한다.
+ *
+ * NAV-RELPOSNED(이동 기준국 구성의 보조 수신기, 버전 1)는 같은 방식으로 UbxGnssRelPos로
+ * 변환해 따로 게시한다 (ubx_gnss_read_relpos). 기선 방위와 앙각, 정확도를 rad로 바꿔 두므로
+ * 반송파 고정해(carr_soln == 2)이고 heading_valid이면 EKF_GnssHeading에 그대로 옮겨
+ * fusion_scheduler_push_gnss_heading으로 넘긴다 (기선은 ekf_set_gnss_baseline).
+ *
+ * 연결 예 (CubeMX: USART RX DMA 순환 모드, USART 전역 인터럽트 활성화):
+ * - HAL_UARTEx_RxEventCallback: ubx_gnss_handle_rx_event(&gnss, Size, timestamp_us)
+ * - HAL_UART_ErrorCallback: ubx_gnss_handle_uart_error(&gnss)
+ * - HAL_GPIO_EXTI_Callback (TIMEPULSE 핀): ubx_gnss_handle_timepulse(&gnss, timestamp_us)
+ *   (TIMEPULSE를 timebase 입력 캡처 채널에 연결하면 캡처 콜백에서 캡처 시각으로 호출)
+ *
+ * 수신 이벤트와 시간 펄스 처리는 인터럽트 문맥에서 호출되며, 해 읽기는
+ * 어느 문맥에서나 무잠금으로 할 수 있다.
+ */
+
+#ifndef UBX_GNSS_H
+#define UBX_GNSS_H
+
+#include "stm32l4xx_hal.h"
+#include "math/vector3f.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief DMA 순환 버퍼 크기 (바이트, 2의 거듭제곱, 절반 이벤트 사이에 NAV-PVT 프레임 2개 이상)
+ */
+#define UBX_GNSS_DMA_SIZE 512
+
+#if (UBX_GNSS_DMA_SIZE & (UBX_GNSS_DMA_SIZE - 1)) != 0
+#error "UBX_GNSS_DMA_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief 건너뛸 수 있는 최대 페이로드 길이 (초과 시 동기 재탐색, RXM-RAWX 관측 60개까지)
+ */
+#define UBX_GNSS_MAX_PAYLOAD 2048
+
+/**
+ * @brief NAV-PVT 페이로드 길이
+ */
+#define UBX_NAV_PVT_LENGTH 92
+
+/**
+ * @brief NAV-RELPOSNED 페이로드 길이 (버전 1, u-blox 9세대 이후)
+ */
+#define UBX_NAV_RELPOSNED_LENGTH 64
+
+/**
+ * @brief 시간 펄스 유효 시간 (us, 이보다 오래된 펄스는 무시)
+ */
+#define UBX_GNSS_PULSE_MAX_AGE_US 2000000u
+
+/**
+ * @brief 해 읽기 최대 재시도 횟수
+ */
+#define UBX_GNSS_MAX_RETRIES 4
+
+/**
+ * @brief NAV-PVT 측위 종류 (fixType)
+ */
+typedef enum {
+    UBX_FIX_NONE = 0,          /**< 측위 없음 */
+    UBX_FIX_DEAD_RECKONING = 1,/**< 추측 항법 */
+    UBX_FIX_2D = 2,            /**< 2차원 */
+    UBX_FIX_3D = 3,            /**< 3차원 */
+    UBX_FIX_GNSS_DR = 4,       /**< GNSS + 추측 항법 */
+    UBX_FIX_TIME_ONLY = 5      /**< 시각만 */
+} UbxFixType;
+
+/**
+ * @brief GNSS 해 (NAV-PVT)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 측정 시각 (us, 로컬 시계) */
+    uint32_t itow_ms;          /**< GPS 주 시각 (ms) */
+    int32_t lat_e7;            /**< 위도 (1e-7 deg) */
+    int32_t lon_e7;            /**< 경도 (1e-7 deg) */
+    int32_t height_mm;         /**< 타원체 고도 (mm) */
+    int32_t hmsl_mm;           /**< 평균 해수면 고도 (mm) */
+    Vector3f vel_ned;          /**< 속도 (NED, m/s) */
+    float h_acc;               /**< 수평 위치 정확도 추정 (m) */
+    float v_acc;               /**< 수직 위치 정확도 추정 (m) */
+    float s_acc;               /**< 속도 정확도 추정 (m/s) */
+    uint8_t fix_type;          /**< 측위 종류 (UbxFixType) */
+    uint8_t num_sv;            /**< 사용 위성 수 */
+    bool fix_ok;               /**< 측위 유효 (flags.gnssFixOK) */
+    bool pulse_locked;         /**< 시간 펄스 기준 시각 여부 (false면 수신 시각) */
+} UbxGnssFix;
+
+/**
+ * @brief RTK 반송파 해 종류 (NAV-RELPOSNED flags.carrSoln)
+ */
+typedef enum {
+    UBX_CARR_NONE = 0,         /**< 반송파 해 없음 */
+    UBX_CARR_FLOAT = 1,        /**< 미지정수 실수 해 */
+    UBX_CARR_FIXED = 2         /**< 미지정수 고정 해 */
+} UbxCarrSoln;
+
+/**
+ * @brief 이동 기준국 상대 위치 (NAV-RELPOSNED)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 측정 시각 (us, 로컬 시계) */
+    uint32_t itow_ms;          /**< GPS 주 시각 (ms) */
+    Vector3f rel_pos_ned;      /**< 기준국 -> 이 수신기 안테나 (NED, m, 0.1 mm 고정밀 부분 포함) */
+    Vector3f acc_ned;          /**< 상대 위치 정확도 추정 (NED, m) */
+    float length;              /**< 기선 길이 (m) */
+    float heading;             /**< 기선 방위 (rad, 0..2pi, NED 북에서 동쪽으로) */
+    float heading_acc;         /**< 방위 정확도 추정 (rad) */
+    float pitch;               /**< 기선 앙각 (rad, 위가 양수, rel_pos_ned로 계산) */
+    float pitch_acc;           /**< 앙각 정확도 근사 (rad, 아래 정확도 / 수평 길이) */
+    uint8_t carr_soln;         /**< 반송파 해 종류 (UbxCarrSoln) */
+    bool rel_pos_valid;        /**< 상대 위치 유효 (flags.relPosValid) */
+    bool heading_valid;        /**< 방위 유효 (flags.relPosHeadingValid) */
+    bool pulse_locked;         /**< 시간 펄스 기준 시각 여부 (false면 수신 시각) */
+} UbxGnssRelPos;
+
+/**
+ * @brief UBX 파서 상태
+ */
+typedef enum {
+    UBX_PARSE_SYNC1 = 0,       /**< 0xB5 대기 */
+    UBX_PARSE_SYNC2,           /**< 0x62 대기 */
+    UBX_PARSE_CLASS,           /**< 메시지 클래스 */
+    UBX_PARSE_ID,              /**< 메시지 ID */
+    UBX_PARSE_LENGTH1,         /**< 길이 하위 바이트 */
+    UBX_PARSE_LENGTH2,         /**< 길이 상위 바이트 */
+    UBX_PARSE_PAYLOAD,         /**< NAV-PVT/RELPOSNED 페이로드 (체크섬 누적) */
+    UBX_PARSE_SKIP,            /**< 기타 메시지 페이로드와 체크섬 건너뛰기 */
+    UBX_PARSE_CK_A,            /**< 체크섬 A */
+    UBX_PARSE_CK_B             /**< 체크섬 B */
+} UbxParseState;
+
+/**
+ * @brief UBX GNSS 드라이버 구조체
+ */
+typedef struct {
+    UART_HandleTypeDef *huart; /**< UART 핸들 (RX DMA 순환 모드) */
+    uint8_t dma_buffer[UBX_GNSS_DMA_SIZE]; /**< DMA 수신 버퍼 */
+    uint16_t read_index;       /**< 다음 파싱 위치 */
+
+    UbxParseState state;       /**< 파서 상태 */
+    uint8_t msg_class;         /**< 현재 메시지 클래스 */
+    uint8_t msg_id;            /**< 현재 메시지 ID */
+    uint16_t length;           /**< 현재 페이로드 길이 */
+    uint16_t remaining;        /**< 남은 페이로드 (건너뛰기는 체크섬 포함) 바이트 */
+    uint16_t payload_start;    /**< 페이로드 시작 위치 (DMA 버퍼 인덱스) */
+    uint8_t ck_a;              /**< 누적 체크섬 A */
+    uint8_t ck_b;              /**< 누적 체크섬 B */
+
+    volatile uint32_t pulse_us;    /**< 마지막 시간 펄스 시각 (us) */
+    volatile uint32_t pulse_count; /**< 시간 펄스 수 (0이면 없음) */
+
+    UbxGnssFix fix[2];         /**< 이중 버퍼 (게시된 버퍼 = seq & 1) */
+    atomic_uint_fast32_t seq;  /**< 게시 시퀀스 (0 = 게시 전) */
+    UbxGnssRelPos relpos[2];   /**< 상대 위치 이중 버퍼 (게시된 버퍼 = relpos_seq & 1) */
+    atomic_uint_fast32_t relpos_seq; /**< 상대 위치 게시 시퀀스 (0 = 게시 전) */
+
+    uint32_t fix_count;        /**< 수신한 NAV-PVT 수 */
+    uint32_t relpos_count;     /**< 수신한 NAV-RELPOSNED 수 */
+    uint32_t checksum_errors;  /**< NAV-PVT/RELPOSNED 체크섬 오류 수 */
+    uint32_t length_errors;    /**< 길이 오류로 동기를 다시 찾은 수 */
+    uint32_t uart_errors;      /**< UART 오류 후 수신 재시작 수 */
+    bool initialized;          /**< 초기화 여부 */
+} UbxGnss;
+
+/**
+ * @brief 드라이버 초기화 및 순환 DMA 수신 시작
+ *
+ * 수신기는 UBX 출력(NAV-PVT)과 시간 펄스가 설정되어 있어야 한다 (부팅 설정은
+ * sensors/gnss_setup.h의 gnss_setup_run을 먼저 호출).
+ *
+ * @param gnss 드라이버 구조체 포인터
+ * @param huart UART 핸들 (RX DMA 순환 모드)
+ * @return bool 성공 여부
+ */
+bool ubx_gnss_init(UbxGnss *gnss, UART_HandleTypeDef *huart);
+
+/**
+ * @brief UART 수신 이벤트 처리 (IDLE 라인, DMA 절반/완료)
+ *
+ * @param gnss 드라이버 구조체 포인터
+ * @param position DMA 버퍼 쓰기 위치 (HAL 콜백의 Size)
+ * @param timestamp_us 이벤트 시각 (us)
+ * @return uint32_t 이번 이벤트에서 게시한 해 수 (NAV-PVT만, 상대 위치는 세지 않음)
+ */
+uint32_t ubx_gnss_handle_rx_event(UbxGnss *gnss, uint16_t position, uint32_t timestamp_us);
+
+/**
+ * @brief UART 오류 처리 (파서 초기화 후 수신 재시작)
+ *
+ * @param gnss 드라이버 구조체 포인터
+ */
+void ubx_gnss_handle_uart_error(UbxGnss *gnss);
+
+/**
+ * @brief 시간 펄스 인터럽트 처리
+ *
+ * @param gnss 드라이버 구조체 포인터
+ * @param timestamp_us 펄스 상승 에지 시각 (us)
+ */
+void ubx_gnss_handle_timepulse(UbxGnss *gnss, uint32_t timestamp_us);
+
+/**
+ * @brief 최신 해 읽기 (모든 우선순위에서 호출 가능)
+ *
+ * @param gnss 드라이버 구조체 포인터
+ * @param fix 결과 해
+ * @param seq 읽은 해의 시퀀스 (NULL 가능, 새 해 여부 판단용)
+ * @return bool 성공 여부 (게시 전이거나 재시도 한도 초과 시 false)
+ */
+bool ubx_gnss_read_fix(const UbxGnss *gnss, UbxGnssFix *fix, uint32_t *seq);
+
+/**
+ * @brief 최신 상대 위치 읽기 (모든 우선순위에서 호출 가능)
+ *
+ * @param gnss 드라이버 구조체 포인터
+ * @param relpos 결과 상대 위치
+ * @param seq 읽은 상대 위치의 시퀀스 (NULL 가능, 새 측정 여부 판단용)
+ * @return bool 성공 여부 (게시 전이거나 재시도 한도 초과 시 false)
+ */
+bool ubx_gnss_read_relpos(const UbxGnss *gnss, UbxGnssRelPos *relpos, uint32_t *seq);
+
+#endif /* UBX_GNSS_H */
@@ -0,0 +1,125 @@
+/**
+ * @file virtual_imu.h
+ * @brief 다중 IMU 시간 정렬, 이상치 제거, 단일 가상 IMU 스트림 합성
+ *
+ * IMU마다 드라이버가 각자의 ImuRing에 샘플을 넣고, 융합 태스크가
+ * virtual_imu_process로 모든 입력 링을 꺼내 하나의 출력 링에 합성 샘플을 넣는다.
+ * 융합 스케줄러는 출력 링을 단일 IMU처럼 소비하므로 필터는 하나만 돈다
+ * (ekf_lanes보다 싼 대안).
+ *
+ * 출력 시각(epoch)마다 다른 IMU의 샘플은 앞뒤 샘플 사이 선형 보간으로 그 시각에 맞춘다.
+ * - 기준 모드: 첫 번째 사용 가능한 IMU의 샘플 시각마다 출력
+ * - 교차(interleave) 모드: 모든 IMU 샘플 시각마다 출력. 위상이 어긋난 IMU를 모으면
+ *   출력 속도가 IMU 수배로 높아진다.
+ *
+ * 합성은 축별 중앙값(2개이면 평균) 기준으로 자이로/가속도 편차가 허용값 이내인
+ * IMU만 평균한다. 3개 이상이면 하나의 고장을 중앙값이 걸러내고, 2개가 허용값 이상
+ * 어긋나면 직전 출력에 가까운 쪽을 쓴다. n개가 일치하면 출력 잡음 표준편차가
+ * 1/sqrt(n)로 줄어드므로 과정 잡음(ekf_set_process_noise)을 그만큼 낮출 수 있다.
+ *
+ * 출력 시각 이후 샘플이 아직 없는 IMU는 기다리되(FIFO 버스트 지연), 마지막 샘플이
+ * 현재 시각보다 timeout_us 이상 오래되면 끊긴 것으로 보고 제외한다. 출력 시각은
+ * 항상 증가하며, 끊겼다가 돌아온 IMU의 지난 샘플은 버린다.
+ *
+ * 입력 링의 소비자, 출력 링의 생산자이므로 한 태스크에서만 호출해야 한다.
+ * 입력 IMU 샘플은 같은 몸체 좌표계로 정렬되어 있어야 한다.
+ */
+
+#ifndef VIRTUAL_IMU_H
+#define VIRTUAL_IMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "math/vector3f.h"
+#include "sensors/imu_ring.h"
+
+/**
+ * @brief 최대 입력 IMU 수
+ */
+#define VIRTUAL_IMU_MAX_SOURCES 3
+
+#if VIRTUAL_IMU_MAX_SOURCES > 3
+#error "VIRTUAL_IMU_MAX_SOURCES above 3 needs a general median"
+#endif
+
+/**
+ * @brief 기본 합성 조건
+ */
+#define VIRTUAL_IMU_DEFAULT_GYRO_TOL 0.1f      /**< 중앙값 대비 자이로 허용 편차 (rad/s, 축별) */
+#define VIRTUAL_IMU_DEFAULT_ACCEL_TOL 2.0f     /**< 중앙값 대비 가속도 허용 편차 (m/s^2, 축별) */
+#define VIRTUAL_IMU_DEFAULT_TIMEOUT_US 20000u  /**< 끊김 판정 지연 (us, FIFO 버스트 간격보다 길게) */
+
+/**
+ * @brief 합성 조건 설정
+ */
+typedef struct {
+    bool interleave;       /**< 모든 IMU 샘플 시각마다 출력 (false면 기준 IMU 시각) */
+    float gyro_tol;        /**< 자이로 허용 편차 (rad/s) */
+    float accel_tol;       /**< 가속도 허용 편차 (m/s^2) */
+    uint32_t timeout_us;   /**< 끊김 판정 지연 (us) */
+} VirtualImuConfig;
+
+/**
+ * @brief 입력 IMU 상태
+ */
+typedef struct {
+    ImuRing *ring;         /**< 입력 링 */
+    ImuSample prev;        /**< 출력 시각 이전 최신 샘플 (보간 시작점) */
+    ImuSample next;        /**< 꺼냈지만 아직 지나지 않은 샘플 (보간 끝점) */
+    bool has_prev;         /**< prev 유효 여부 */
+    bool has_next;         /**< next 유효 여부 */
+    uint32_t used;         /**< 합성에 사용된 횟수 */
+    uint32_t rejected;     /**< 편차 초과로 제외된 횟수 */
+    uint32_t missing;      /**< 끊김으로 빠진 횟수 */
+} VirtualImuSource;
+
+/**
+ * @brief 가상 IMU
+ */
+typedef struct {
+    VirtualImuConfig config;                         /**< 합성 조건 */
+    VirtualImuSource source[VIRTUAL_IMU_MAX_SOURCES]; /**< 입력 IMU */
+    uint8_t count;                                   /**< 입력 IMU 수 */
+    ImuRing *out;                                    /**< 출력 링 */
+
+    ImuSample last;        /**< 직전 출력 샘플 */
+    bool has_last;         /**< 직전 출력 유효 여부 */
+    uint8_t last_used;     /**< 직전 출력에 평균된 IMU 수 */
+
+    uint32_t emitted;      /**< 출력 샘플 수 */
+    uint32_t dropped;      /**< 합성할 IMU가 없어 버린 출력 시각 수 */
+} VirtualImu;
+
+/**
+ * @brief 기본 합성 조건
+ *
+ * @param config 합성 조건
+ * @return bool 성공 여부
+ */
+bool virtual_imu_default_config(VirtualImuConfig *config);
+
+/**
+ * @brief 가상 IMU 초기화
+ *
+ * @param vimu 가상 IMU
+ * @param sources 입력 링 배열 (0번이 기준 모드의 우선 기준)
+ * @param count 입력 IMU 수 (1 ~ VIRTUAL_IMU_MAX_SOURCES)
+ * @param out 출력 링 (융합 스케줄러 입력)
+ * @param config 합성 조건 (NULL이면 기본값)
+ * @return bool 성공 여부 (허용 편차가 양수가 아니면 false)
+ */
+bool virtual_imu_init(VirtualImu *vimu, ImuRing *const *sources, uint8_t count,
+                      ImuRing *out, const VirtualImuConfig *config);
+
+/**
+ * @brief 입력 링을 꺼내 합성 샘플을 출력 링에 추가
+ *
+ * 출력 시각 이후 샘플을 기다리는 IMU가 있으면 그 시각에서 멈추고 다음 호출에서 이어간다.
+ *
+ * @param vimu 가상 IMU
+ * @param now_us 현재 시각 (us, IMU 타임스탬프와 같은 시계)
+ * @return uint32_t 이번 호출에서 출력한 샘플 수
+ */
+uint32_t virtual_imu_process(VirtualImu *vimu, uint32_t now_us);
+
+#endif /* VIRTUAL_IMU_H */
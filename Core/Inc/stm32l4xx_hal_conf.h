@@ -33,6 +33,9 @@
 /**
   * @brief This is the list of modules to be used in the HAL driver
   */
+#include "sys/board_profile.h"
+
+#ifdef BOARD_HAL_ALL_MODULES
 #define HAL_MODULE_ENABLED
 #define HAL_ADC_MODULE_ENABLED
 #define HAL_CAN_MODULE_ENABLED
@@ -85,6 +88,37 @@
 #define HAL_UART_MODULE_ENABLED
 #define HAL_USART_MODULE_ENABLED
 #define HAL_WWDG_MODULE_ENABLED
+#else /* BOARD_HAL_ALL_MODULES */
+/* 보드 프로파일(sys/board_profile.h)이 쓰는 모듈만 켠다 */
+#define HAL_MODULE_ENABLED
+#define HAL_CORTEX_MODULE_ENABLED
+#define HAL_CRC_MODULE_ENABLED
+#define HAL_DMA_MODULE_ENABLED
+#define HAL_EXTI_MODULE_ENABLED
+#define HAL_FLASH_MODULE_ENABLED
+#define HAL_GPIO_MODULE_ENABLED
+#define HAL_PWR_MODULE_ENABLED
+#define HAL_QSPI_MODULE_ENABLED
+#define HAL_RCC_MODULE_ENABLED
+#define HAL_SPI_MODULE_ENABLED
+#define HAL_TIM_MODULE_ENABLED
+#define HAL_UART_MODULE_ENABLED
+#if BOARD_HAS_CURRENT_SENSE
+#define HAL_ADC_MODULE_ENABLED
+#endif
+#if BOARD_HAS_CAN
+#define HAL_CAN_MODULE_ENABLED
+#endif
+#if BOARD_HAS_PAD_HOLD
+#define HAL_LPTIM_MODULE_ENABLED
+#endif
+#if BOARD_HAS_USB
+#define HAL_PCD_MODULE_ENABLED
+#endif
+#if BOARD_HAS_SD_CARD
+#define HAL_SD_MODULE_ENABLED
+#endif
+#endif /* BOARD_HAL_ALL_MODULES */
 
 
 /* ########################## Oscillator Values adaptation ####################*/
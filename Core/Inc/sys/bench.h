@@ -0,0 +1,93 @@
+/**
+ * @file bench.h
+ * @brief 실제 보드에서 수학 커널과 필터 성능을 사이클 단위로 측정하는 벤치마크 빌드
+ *
+ * 호스트 벤치마크(Tools/bench/ekf_bench.c)로는 플래시 대기 상태와 ART 가속기(명령/데이터
+ * 캐시, 프리페치)의 영향을 알 수 없으므로, 같은 종류의 고정 입력 벤치마크를 STM32L4에서
+ * DWT->CYCCNT로 측정한다. 비행 빌드와 같은 SystemClock_Config와 HAL_Init을 거친 뒤
+ * 비행 루프 대신 bench_run을 호출하는 별도 빌드 설정(BENCH_ENABLE 정의)에서 사용한다.
+ *
+ * 출력은 "BENCH,"으로 시작하는 CSV 줄이며 UART 로그에서 그대로 걸러 커밋별로 비교한다.
+ * - BENCH,begin,<빌드 ID>,<SYSCLK Hz>,<플래시 대기 상태>,<I-캐시>,<D-캐시>,<프리페치>,<측정 오버헤드>,
+ *   <RAM 함수 영역 바이트 (mem_section.h, 0이면 플래시 실행)>
+ * - BENCH,build,<컴파일러 버전>,<부동소수점 모드 (math/fp_mode.h)>,<빌드 플래그 (줄 끝까지)>
+ * - BENCH,<이름>,<반복 횟수>,<최소>,<최대>,<평균>,<표준편차>,<스택> (사이클, 측정 오버헤드 제외.
+ *   스택은 설정 함수를 뺀 커널의 최대 스택 깊이, 바이트, sys/memstat.h의 측정 창)
+ * - BENCH,golden,<부동소수점 모드 (math/fp_mode.h)>,<전체 지문>,<호출 수>,<거부 수>,<구간 지문 8개>
+ * - BENCH,golden_x,<마지막 상태>, BENCH,golden_p,<공분산 대각> (float 비트 16진수)
+ * - BENCH,end,<벤치마크 수>
+ *
+ * 표준 재생 줄은 Tools/bench/golden_check.c로 호스트 결과와 비교하고, 측정 줄은
+ * Tools/bench/bench_compare.c로 기준 기록과 비교해 유의한 성능/스택 저하를 찾는다.
+ * 호스트 벤치마크(ekf_bench -c)도 같은 형식(단위 ns)으로 출력한다.
+ *
+ * BENCH_ENABLE 미정의 시 모든 API는 빈 코드로 컴파일된다.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sys/profile.h"
+
+/**
+ * @brief 벤치마크 빌드 활성화
+ *
+ * 빌드 설정에서 정의한다. 정의 시 stm32l4xx_hal.h의 FLASH/DWT 레지스터를 사용한다.
+ */
+/* #define BENCH_ENABLE */
+
+/**
+ * @brief 결과에 함께 찍을 빌드 ID (예: -DBENCH_BUILD_ID=\"$(git rev-parse --short HEAD)\")
+ */
+#ifndef BENCH_BUILD_ID
+#define BENCH_BUILD_ID "unknown"
+#endif
+
+/**
+ * @brief 결과에 함께 찍을 빌드 플래그 (예: -DBENCH_BUILD_FLAGS="\"$(CFLAGS)\"")
+ */
+#ifndef BENCH_BUILD_FLAGS
+#define BENCH_BUILD_FLAGS "unknown"
+#endif
+
+/**
+ * @brief 반복 횟수 배율 (기본 반복 횟수에 곱함, 디버그 빌드에서 줄이는 용도)
+ */
+#ifndef BENCH_ITERATION_SCALE
+#define BENCH_ITERATION_SCALE 1u
+#endif
+
+#ifdef BENCH_ENABLE
+
+/**
+ * @brief 비행 설정과 같은 플래시 가속 설정 적용
+ *
+ * stm32l4xx_hal_conf.h의 PREFETCH_ENABLE, INSTRUCTION_CACHE_ENABLE, DATA_CACHE_ENABLE에
+ * 맞춰 ACR을 설정하고 캐시를 비운 뒤 DWT 사이클 카운터를 켠다. 대기 상태는
+ * SystemClock_Config가 정한 값을 그대로 쓰며, 클럭은 바꾸지 않는다.
+ *
+ * @return bool 성공 여부 (플래시 대기 상태가 SYSCLK에 비해 부족하면 false)
+ */
+bool bench_prepare(void);
+
+/**
+ * @brief 전체 벤치마크 실행 후 결과를 한 줄씩 출력
+ *
+ * 각 반복은 인터럽트를 막은 채 측정하므로 결과에 인터럽트 처리 시간이 섞이지 않는다.
+ * 필터 벤치마크는 정해진 반복마다 같은 초기 상태로 다시 시작한다 (설정 시간 제외).
+ *
+ * @param write 출력 콜백
+ * @return bool 성공 여부 (bench_prepare 실패 또는 write가 NULL이면 false)
+ */
+bool bench_run(ProfileWriteFn write);
+
+#else /* BENCH_ENABLE */
+
+static inline bool bench_prepare(void) { return false; }
+static inline bool bench_run(ProfileWriteFn write) { (void)write; return false; }
+
+#endif /* BENCH_ENABLE */
+
+#endif /* BENCH_H */
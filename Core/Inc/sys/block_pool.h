@@ -0,0 +1,138 @@
+/**
+ * @file block_pool.h
+ * @brief 고정 크기 블록 메모리 풀 (크기 등급별 무잠금 자유 목록)
+ *
+ * 크기가 다른 측정 메시지와 기록 레코드를 힙(malloc/_sbrk) 없이 할당한다. 크기 등급마다
+ * 부팅 시 정적 저장소(BLOCK_POOL_STORAGE)를 하나씩 등록하고, 할당은 요청 크기를 담는 가장
+ * 작은 등급에서, 그 등급이 비었으면 다음 큰 등급에서 블록 하나를 꺼낸다. 해제는 주소 범위로
+ * 등급을 찾아 되돌린다. 등급 수가 작은 상수(BLOCK_POOL_MAX_CLASSES)이므로 할당/해제 시간이
+ * 일정하고 단편화가 없다.
+ *
+ * - 자유 목록: 빈 블록의 첫 워드에 다음 블록 번호를 적은 스택. 머리는 (변경 태그 << 16 |
+ *   블록 번호) 32비트 하나이며 비교-교환(C11 atomic, Cortex-M4에서 LDREX/STREX)으로 바꾸므로
+ *   인터럽트 문맥에서도 전역 인터럽트 금지 없이 할당/해제할 수 있다. 태그는 꺼낸 블록이
+ *   그 사이에 다시 들어온 경우(ABA)를 구별한다.
+ * - 통계: 등급별 사용 중 블록 수, 최대 사용량(high water), 할당/실패/큰 등급 대체 수.
+ *   최대 사용량을 비행 기록으로 확인해 등급별 블록 수를 정한다.
+ *
+ * 등급 등록(block_pool_add_class)은 할당이 시작되기 전에 부팅 과정에서만 한다.
+ */
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 최대 크기 등급 수
+ */
+#define BLOCK_POOL_MAX_CLASSES 4u
+
+/**
+ * @brief 블록 정렬 단위와 최소 크기 (바이트)
+ */
+#define BLOCK_POOL_ALIGN 8u
+
+/**
+ * @brief 등급당 최대 블록 수 (블록 번호 16비트, 0xFFFF는 목록 끝)
+ */
+#define BLOCK_POOL_MAX_BLOCKS 0xFFFEu
+
+/**
+ * @brief 블록 크기를 정렬 단위로 올림
+ */
+#define BLOCK_POOL_BLOCK_SIZE(size) \
+    ((((size) + BLOCK_POOL_ALIGN - 1u) / BLOCK_POOL_ALIGN) * BLOCK_POOL_ALIGN)
+
+/**
+ * @brief 등급 저장소 선언 (정적 전역으로 선언)
+ */
+#define BLOCK_POOL_STORAGE(name, size, count) \
+    uint8_t name[BLOCK_POOL_BLOCK_SIZE(size) * (count)] __attribute__((aligned(BLOCK_POOL_ALIGN)))
+
+/**
+ * @brief 크기 등급
+ */
+typedef struct {
+    uint8_t *base;             /**< 저장소 시작 */
+    uint32_t block_size;       /**< 블록 크기 (바이트, BLOCK_POOL_ALIGN 배수) */
+    uint16_t count;            /**< 블록 수 */
+    atomic_uint_fast32_t head; /**< 자유 목록 머리 (태그 << 16 | 블록 번호) */
+    atomic_uint_fast32_t in_use;     /**< 사용 중 블록 수 */
+    atomic_uint_fast32_t high_water; /**< 최대 사용 블록 수 */
+    atomic_uint_fast32_t allocs;     /**< 이 등급에서 할당한 수 */
+    atomic_uint_fast32_t failures;   /**< 이 등급이 최소 등급인 요청 중 실패한 수 */
+    atomic_uint_fast32_t fallbacks;  /**< 이 등급이 비어 큰 등급에서 대신 할당한 수 */
+} BlockPoolClass;
+
+/**
+ * @brief 등급별 통계 스냅숏
+ */
+typedef struct {
+    uint32_t block_size;       /**< 블록 크기 (바이트) */
+    uint32_t count;            /**< 블록 수 */
+    uint32_t in_use;           /**< 사용 중 블록 수 */
+    uint32_t high_water;       /**< 최대 사용 블록 수 */
+    uint32_t allocs;           /**< 할당 수 */
+    uint32_t failures;         /**< 실패 수 */
+    uint32_t fallbacks;        /**< 큰 등급 대체 수 */
+} BlockPoolClassStats;
+
+/**
+ * @brief 블록 풀
+ */
+typedef struct {
+    BlockPoolClass cls[BLOCK_POOL_MAX_CLASSES]; /**< 크기 등급 (블록 크기 오름차순) */
+    uint8_t class_count;       /**< 등록한 등급 수 */
+} BlockPool;
+
+/**
+ * @brief 풀 초기화 (등급 없음)
+ *
+ * @param pool 풀
+ * @return bool 성공 여부
+ */
+bool block_pool_init(BlockPool *pool);
+
+/**
+ * @brief 크기 등급 등록 (블록 크기 오름차순으로, 할당 시작 전에만)
+ *
+ * @param pool 풀
+ * @param storage 저장소 (BLOCK_POOL_STORAGE, BLOCK_POOL_ALIGN 정렬)
+ * @param block_size 블록 크기 (바이트, BLOCK_POOL_ALIGN으로 올림)
+ * @param count 블록 수 (1..BLOCK_POOL_MAX_BLOCKS)
+ * @return bool 성공 여부 (등급이 가득 찼거나, 정렬/크기/순서가 잘못되면 false)
+ */
+bool block_pool_add_class(BlockPool *pool, void *storage, uint32_t block_size, uint32_t count);
+
+/**
+ * @brief 블록 할당 (인터럽트 문맥 가능)
+ *
+ * @param pool 풀
+ * @param size 필요한 크기 (바이트)
+ * @return void* 블록 (BLOCK_POOL_ALIGN 정렬, 맞는 등급이 모두 비었으면 NULL)
+ */
+void *block_pool_alloc(BlockPool *pool, uint32_t size);
+
+/**
+ * @brief 블록 해제 (인터럽트 문맥 가능)
+ *
+ * @param pool 풀
+ * @param block block_pool_alloc으로 받은 블록
+ * @return bool 성공 여부 (풀의 블록이 아니면 false)
+ */
+bool block_pool_free(BlockPool *pool, void *block);
+
+/**
+ * @brief 등급별 통계 스냅숏
+ *
+ * @param pool 풀
+ * @param index 등급 번호 (등록 순서)
+ * @param stats 통계 저장 위치
+ * @return bool 성공 여부 (등급이 없으면 false)
+ */
+bool block_pool_get_stats(const BlockPool *pool, uint8_t index, BlockPoolClassStats *stats);
+
+#endif /* BLOCK_POOL_H */
@@ -0,0 +1,115 @@
+/**
+ * @file board_profile.h
+ * @brief 컴파일 타임 보드 프로파일 (센서, 버스, 기능 선언과 HAL 모듈/드라이버/필터 상태 구성 유도)
+ *
+ * CubeMX 템플릿의 stm32l4xx_hal_conf.h는 모든 HAL 모듈(CAN, DCMI, DSI, LTDC, HASH, NAND 등)을
+ * 켜 두어, 쓰지 않는 드라이버 코드와 초기화가 링크되고 플래시와 ART 가속기 캐시를 낭비한다.
+ * 보드마다 이 헤더의 프로파일 하나가 장착 센서/버스/기능을 BOARD_HAS_*로 선언하고, 나머지는
+ * 여기서 유도한다.
+ * - HAL 모듈: stm32l4xx_hal_conf.h가 항상 쓰는 모듈(CORTEX, RCC, GPIO, EXTI, DMA, FLASH, PWR,
+ *   TIM, SPI, UART, QSPI, CRC)과 BOARD_HAS_*에 따른 모듈(SD, PCD, CAN, ADC, LPTIM)만 켠다.
+ * - 드라이버: 기능이 없는 보드에서는 해당 드라이버(.c)가 빈 번역 단위로 컴파일된다
+ *   (SD 카드는 flash_log가 참조하므로 false를 돌려주는 인라인 함수로 남음). 없는 기능의 헤더를
+ *   포함하면 #error로 알린다.
+ * - 필터 상태 구성: ekf_config.h가 이 헤더를 먼저 포함하므로, 빌드 설정에서 EKF_CONFIG_*를
+ *   정하지 않았으면 프로파일의 값을 쓴다. 장착되지 않은 센서가 필요한 상태 블록은 #error이다.
+ *
+ * 호스트 도구도 ekf_config.h를 거쳐 포함하므로 HAL 헤더에 의존하지 않는다.
+ *
+ * | 프로파일              | MCU   | 기압계 | 자력계 | SD | USB | CAN | 전류 감지 | Stop 2 대기 | EKF 상태 |
+ * |-----------------------|-------|--------|--------|----|-----|-----|-----------|-------------|----------|
+ * | BOARD_PROFILE_FLIGHT  | L476  | 2      | 있음   | O  | O   | O   | O         | O           | 16       |
+ * | BOARD_PROFILE_LITE    | L431  | 1      | 없음   | X  | X   | X   | X         | O           | 13       |
+ * | BOARD_PROFILE_CUSTOM  | -     | 빌드 설정에서 BOARD_HAS_* 등을 모두 정의                             |
+ *
+ * 모든 프로파일은 ICM-42688 IMU(SPI), QSPI NOR 기록, 텔레메트리 UART를 가진다.
+ * LITE는 SRAM이 작은 L431용으로 가속도 바이어스 블록을 빼 공분산을 13차원으로 줄인다.
+ */
+
+#ifndef BOARD_PROFILE_H
+#define BOARD_PROFILE_H
+
+/**
+ * @brief 보드 프로파일 선택
+ *
+ * 빌드 설정에서 하나를 정의한다. 없으면 BOARD_PROFILE_FLIGHT이다.
+ */
+/* #define BOARD_PROFILE_FLIGHT */
+/* #define BOARD_PROFILE_LITE */
+/* #define BOARD_PROFILE_CUSTOM */
+
+/**
+ * @brief 프로파일과 관계없이 템플릿의 HAL 모듈 전체를 켬 (CubeMX 생성 코드 확인용)
+ *
+ * 빌드 설정에서 정의한다.
+ */
+/* #define BOARD_HAL_ALL_MODULES */
+
+#if (defined(BOARD_PROFILE_FLIGHT) + defined(BOARD_PROFILE_LITE) + defined(BOARD_PROFILE_CUSTOM)) > 1
+#error "define at most one BOARD_PROFILE_*"
+#endif
+
+#if !defined(BOARD_PROFILE_LITE) && !defined(BOARD_PROFILE_CUSTOM) && !defined(BOARD_PROFILE_FLIGHT)
+#define BOARD_PROFILE_FLIGHT
+#endif
+
+#if defined(BOARD_PROFILE_FLIGHT)
+#define BOARD_NAME "flight"
+#define BOARD_BARO_COUNT 2          /**< MS5611 수 (SPI) */
+#define BOARD_HAS_GNSS 1            /**< u-blox GNSS (UART) */
+#define BOARD_HAS_MAG 1             /**< 자력계 */
+#define BOARD_HAS_SD_CARD 1         /**< SDMMC SD 카드 기록 */
+#define BOARD_HAS_USB 1             /**< USB OTG_FS 기록 내려받기 */
+#define BOARD_HAS_CAN 1             /**< CAN 항법 해 게시 */
+#define BOARD_HAS_CURRENT_SENSE 1   /**< 전류 감지 ADC (sys/energy.h) */
+#define BOARD_HAS_PAD_HOLD 1        /**< LSE + LPTIM1 Stop 2 대기 (sys/pad_hold.h) */
+#define BOARD_EKF_ACCEL_BIAS 1      /**< 가속도 바이어스 상태 블록 */
+#elif defined(BOARD_PROFILE_LITE)
+#define BOARD_NAME "lite"
+#define BOARD_BARO_COUNT 1
+#define BOARD_HAS_GNSS 1
+#define BOARD_HAS_MAG 0
+#define BOARD_HAS_SD_CARD 0
+#define BOARD_HAS_USB 0
+#define BOARD_HAS_CAN 0
+#define BOARD_HAS_CURRENT_SENSE 0
+#define BOARD_HAS_PAD_HOLD 1
+#define BOARD_EKF_ACCEL_BIAS 0
+#else
+#if !defined(BOARD_NAME) || !defined(BOARD_BARO_COUNT) || !defined(BOARD_HAS_GNSS) || !defined(BOARD_HAS_MAG) || \
+    !defined(BOARD_HAS_SD_CARD) || !defined(BOARD_HAS_USB) || !defined(BOARD_HAS_CAN) ||                       \
+    !defined(BOARD_HAS_CURRENT_SENSE) || !defined(BOARD_HAS_PAD_HOLD) || !defined(BOARD_EKF_ACCEL_BIAS)
+#error "BOARD_PROFILE_CUSTOM requires every BOARD_* feature macro"
+#endif
+#endif
+
+#if BOARD_BARO_COUNT < 0 || BOARD_BARO_COUNT > 2
+#error "BOARD_BARO_COUNT must be 0..2"
+#endif
+
+#if defined(ENERGY_ENABLE) && !BOARD_HAS_CURRENT_SENSE
+#error "ENERGY_ENABLE requires BOARD_HAS_CURRENT_SENSE"
+#endif
+
+/**
+ * @brief 필터 상태 구성 (빌드 설정의 EKF_CONFIG_*가 우선)
+ *
+ * 위치 블록은 기압계나 GNSS가 있을 때만 관측된다.
+ */
+#ifndef EKF_CONFIG_POSITION
+#define EKF_CONFIG_POSITION ((BOARD_BARO_COUNT > 0) || BOARD_HAS_GNSS)
+#endif
+
+#ifndef EKF_CONFIG_ACCEL_BIAS
+#define EKF_CONFIG_ACCEL_BIAS BOARD_EKF_ACCEL_BIAS
+#endif
+
+#if defined(EKF_CONFIG_MAG_BIAS) && EKF_CONFIG_MAG_BIAS && !BOARD_HAS_MAG
+#error "EKF_CONFIG_MAG_BIAS needs a magnetometer (BOARD_HAS_MAG)"
+#endif
+
+#if defined(EKF_CONFIG_GNSS_CLOCK) && EKF_CONFIG_GNSS_CLOCK && !BOARD_HAS_GNSS
+#error "EKF_CONFIG_GNSS_CLOCK needs a GNSS receiver (BOARD_HAS_GNSS)"
+#endif
+
+#endif /* BOARD_PROFILE_H */
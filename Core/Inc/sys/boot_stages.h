@@ -0,0 +1,164 @@
+/**
+ * @file boot_stages.h
+ * @brief 단계별 부팅 (항법 핵심 먼저, 기록/링크/보정 초기화는 예측이 돈 뒤)
+ *
+ * 비행 중 워치독 리셋 뒤에는 첫 예측 전의 모든 시간이 보조 없는 관성 공백이다. 모든 HAL 모듈과
+ * 기능을 차례로 올리면 SD 카드 마운트, GNSS 설정(ACK 대기), 자체 측정 같은 단계 때문에 첫
+ * 예측까지 수백 ms가 걸린다. 이 모듈은 초기화 단계 표를 세 부분으로 나누어 돌린다.
+ * - BOOT_CTX_CORE: 클럭, 시간 기준, IMU 드라이버, 항법 필터와 스케줄러(필요하면 warm_start 복구).
+ *   boot_stages_run_core가 스케줄러 시작 전에 차례로 모두 돌리며 하나라도 실패하면 멈춘다.
+ *   핵심 단계는 수 ms 안에 끝나야 한다 (SPI 설정과 필터 기본값뿐).
+ * - BOOT_CTX_IDLE: 기록(저장소 확인, 세션 시작), 텔레메트리, GNSS 설정, 자체 측정 등. 가장 낮은
+ *   우선순위 문맥(FreeRTOS vApplicationIdleHook 또는 메인 루프)에서 boot_stages_service_idle이
+ *   호출마다 단계 하나씩 돌리므로, 그동안에도 융합 태스크가 예측을 계속한다.
+ * - BOOT_CTX_FUSION: 필터 상태를 바꾸는 단계(cal_store 보정값 적용 등). 융합 사이클 뒤 콜백에서
+ *   boot_stages_service_fusion이 돌리므로 필터를 다른 문맥에서 건드리지 않는다.
+ *
+ * 나중 단계는 표 순서대로 하나씩 진행하며, 차례가 된 단계의 문맥에서만 돈다. 나중 단계가
+ * 실패해도 항법은 계속되므로 실패를 세고 다음 단계로 넘어간다 (기능만 빠짐).
+ *
+ * 시각은 clock 콜백 기준이다. 시간 기준(timebase)이 리셋 직후 0에서 시작하면 first_predict_us가
+ * 곧 리셋부터 첫 예측까지의 공백이다. 첫 예측은 융합 문맥에서 boot_stages_mark_predict로 알린다.
+ */
+
+#ifndef BOOT_STAGES_H
+#define BOOT_STAGES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 최대 단계 수
+ */
+#define BOOT_STAGES_MAX 24u
+
+/**
+ * @brief 단계 실행 문맥
+ */
+typedef enum {
+    BOOT_CTX_CORE = 0,         /**< 스케줄러 시작 전 (boot_stages_run_core) */
+    BOOT_CTX_IDLE,             /**< 가장 낮은 우선순위 문맥 (boot_stages_service_idle) */
+    BOOT_CTX_FUSION            /**< 융합 사이클 뒤 (boot_stages_service_fusion) */
+} BootContext;
+
+/**
+ * @brief 단계 함수
+ *
+ * @param context 사용자 문맥
+ * @return bool 성공 여부
+ */
+typedef bool (*BootStageFn)(void *context);
+
+/**
+ * @brief 시간 측정 콜백 (us)
+ */
+typedef uint32_t (*BootClockFn)(void);
+
+/**
+ * @brief 단계
+ */
+typedef struct {
+    const char *name;          /**< 이름 (보고용) */
+    BootContext ctx;           /**< 실행 문맥 */
+    BootStageFn fn;            /**< 단계 함수 */
+    void *context;             /**< 단계 함수 문맥 */
+} BootStage;
+
+/**
+ * @brief 단계 결과
+ */
+typedef struct {
+    uint32_t start_us;         /**< 시작 시각 (us) */
+    uint32_t duration_us;      /**< 걸린 시간 (us) */
+    bool done;                 /**< 실행 여부 */
+    bool ok;                   /**< 성공 여부 */
+} BootStageResult;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t core_done_us;     /**< 핵심 단계 완료 시각 (us) */
+    uint32_t first_predict_us; /**< 첫 예측 시각 (us, 아직이면 0) */
+    uint32_t all_done_us;      /**< 모든 단계 완료 시각 (us, 아직이면 0) */
+    uint8_t failed;            /**< 실패한 나중 단계 수 */
+    BootStageResult result[BOOT_STAGES_MAX]; /**< 단계별 결과 (표 순서) */
+} BootStagesStats;
+
+/**
+ * @brief 단계별 부팅
+ */
+typedef struct {
+    const BootStage *stages;   /**< 단계 표 (핵심 단계가 앞, 수명 동안 유지) */
+    uint8_t count;             /**< 단계 수 */
+    uint8_t core_count;        /**< 앞쪽 핵심 단계 수 */
+    BootClockFn clock;         /**< 시간 측정 콜백 */
+    atomic_uint next;          /**< 다음 단계 번호 */
+    bool core_done;            /**< 핵심 단계 완료 여부 */
+    bool predicted;            /**< 첫 예측을 알렸는지 */
+    BootStagesStats stats;     /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} BootStages;
+
+/**
+ * @brief 초기화
+ *
+ * 핵심 단계(BOOT_CTX_CORE)는 표 앞쪽에 모여 있어야 한다.
+ *
+ * @param bs 구조체 포인터
+ * @param stages 단계 표
+ * @param count 단계 수 (1..BOOT_STAGES_MAX)
+ * @param clock 시간 측정 콜백
+ * @return bool 성공 여부 (핵심 단계가 나중 단계 뒤에 있으면 false)
+ */
+bool boot_stages_init(BootStages *bs, const BootStage *stages, uint8_t count, BootClockFn clock);
+
+/**
+ * @brief 핵심 단계 실행 (블로킹, 스케줄러 시작 전 한 번)
+ *
+ * @param bs 구조체 포인터
+ * @return bool 모든 핵심 단계 성공 여부 (실패한 단계에서 멈춤)
+ */
+bool boot_stages_run_core(BootStages *bs);
+
+/**
+ * @brief 차례가 된 나중 단계가 BOOT_CTX_IDLE이면 실행 (가장 낮은 우선순위 문맥)
+ *
+ * @param bs 구조체 포인터
+ * @return bool 이번 호출에서 단계를 실행했으면 true
+ */
+bool boot_stages_service_idle(BootStages *bs);
+
+/**
+ * @brief 차례가 된 나중 단계가 BOOT_CTX_FUSION이면 실행 (융합 사이클 뒤 콜백)
+ *
+ * @param bs 구조체 포인터
+ * @return bool 이번 호출에서 단계를 실행했으면 true
+ */
+bool boot_stages_service_fusion(BootStages *bs);
+
+/**
+ * @brief 예측 알림 (융합 문맥, 첫 호출 시각만 기록)
+ *
+ * @param bs 구조체 포인터
+ */
+void boot_stages_mark_predict(BootStages *bs);
+
+/**
+ * @brief 모든 단계를 마쳤는지
+ *
+ * @param bs 구조체 포인터
+ * @return bool 완료 여부
+ */
+bool boot_stages_done(const BootStages *bs);
+
+/**
+ * @brief 통계
+ *
+ * @param bs 구조체 포인터
+ * @return const BootStagesStats* 통계 (NULL이면 NULL)
+ */
+const BootStagesStats *boot_stages_get_stats(const BootStages *bs);
+
+#endif /* BOOT_STAGES_H */
@@ -0,0 +1,165 @@
+/**
+ * @file boot_tune.h
+ * @brief 부팅 시 필터 커널 자체 측정과 IMU 적분/공분산 전파 주기 자동 선택
+ *
+ * L431, L476, L4R5는 클럭과 플래시 대기 상태가 달라 같은 주기로는 CPU 여유가 다르다.
+ * 부팅 시(항법 필터 초기화 전, 스케줄러 시작 전) 이 모듈이 필터 커널을 합성 입력으로
+ * 커널마다 measure_ms 동안 돌려 DWT->CYCCNT로 호출당 평균 사이클을 잰다.
+ * - 데시메이션 출력 하나 (입력 factor개 포함, 후보 factor마다)
+ * - 사전 적분 샘플 하나 (ekf_preint_add)
+ * - 예측 하나 (ekf_predict, 상태 전이 + 공분산 전파)
+ * - 측정 갱신 하나 (ekf_update_gps 속도 포함, ekf_update_baro, ekf_update_mag)
+ *
+ * 선택: 예산 B = cpu_budget * HCLK (사이클/초), 측정값에 margin을 곱한 비용으로
+ *   부하 = f_imu (c_dec + c_preint) + (f_imu / N) c_predict + Σ f_k c_update_k
+ * 가 B 이하가 되는 가장 높은 IMU 적분 주기 f_imu = odr_hz / factor를 고르고, 그 주기에서
+ * 가장 짧은 예측 간격 N(샘플)을 고른다. 공분산 전파 주기 f_imu / N이 min_cov_hz보다 낮아지면
+ * 그 IMU 주기는 맞지 않는 것으로 본다. 어떤 후보도 맞지 않으면 가장 낮은 주기와 가장 긴
+ * 간격을 고르고 fits를 false로 둔다.
+ *
+ * 결과는 boot_tune_apply_*로 데시메이터, 적응 예측 주기(nav/predict_rate.h), 융합 스케줄러의
+ * 비용 추정 초기값에 넣는다. 측정 중 인터럽트는 막지 않으므로 평균에 인터럽트 부하가 섞이며,
+ * 이는 비행 중 부하와 같은 쪽의 오차이다. 측정에 쓴 EKF와 데시메이터는 결과에 남지 않으므로
+ * 항법용 인스턴스를 초기화하기 전에 넘겨도 된다.
+ */
+
+#ifndef BOOT_TUNE_H
+#define BOOT_TUNE_H
+
+#include "ekf/ekf.h"
+#include "sensors/imu_decimator.h"
+#include "nav/predict_rate.h"
+#include "nav/fusion_scheduler.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define BOOT_TUNE_DEFAULT_CPU_BUDGET 0.5f    /**< 융합 경로에 쓸 CPU 비율 */
+#define BOOT_TUNE_DEFAULT_MARGIN 1.25f       /**< 측정 평균에 곱할 여유 */
+#define BOOT_TUNE_DEFAULT_ODR_HZ 8000u       /**< 센서 ODR (Hz, 데시메이터 입력) */
+#define BOOT_TUNE_DEFAULT_MAX_IMU_HZ 2000u   /**< 최대 IMU 적분 주기 (Hz) */
+#define BOOT_TUNE_DEFAULT_MIN_IMU_HZ 500u    /**< 최소 IMU 적분 주기 (Hz) */
+#define BOOT_TUNE_DEFAULT_MIN_COV_HZ 50u     /**< 최소 공분산 전파 주기 (Hz) */
+#define BOOT_TUNE_DEFAULT_GPS_HZ 10u         /**< GNSS 갱신 주기 (Hz) */
+#define BOOT_TUNE_DEFAULT_BARO_HZ 50u        /**< 기압계 갱신 주기 (Hz) */
+#define BOOT_TUNE_DEFAULT_MAG_HZ 50u         /**< 자력계 갱신 주기 (Hz) */
+#define BOOT_TUNE_DEFAULT_MEASURE_MS 40u     /**< 커널마다 측정 시간 (ms) */
+
+/**
+ * @brief 커널 재초기화 간격 (호출, 측정 시간에서 제외)
+ */
+#define BOOT_TUNE_BLOCK_SIZE 64u
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    float cpu_budget;          /**< 융합 경로에 쓸 CPU 비율 (0 초과 1 이하) */
+    float margin;              /**< 측정 평균에 곱할 여유 (1 이상) */
+    uint32_t odr_hz;           /**< 센서 ODR (Hz) */
+    uint32_t max_imu_hz;       /**< 최대 IMU 적분 주기 (Hz) */
+    uint32_t min_imu_hz;       /**< 최소 IMU 적분 주기 (Hz) */
+    uint32_t min_cov_hz;       /**< 최소 공분산 전파 주기 (Hz) */
+    uint32_t gps_hz;           /**< GNSS 갱신 주기 (Hz) */
+    uint32_t baro_hz;          /**< 기압계 갱신 주기 (Hz) */
+    uint32_t mag_hz;           /**< 자력계 갱신 주기 (Hz) */
+    uint32_t measure_ms;       /**< 커널마다 측정 시간 (ms) */
+    ImuDecimatorConfig decimator; /**< 데시메이터 설정 (factor는 선택값으로 바뀜) */
+} BootTuneConfig;
+
+/**
+ * @brief 측정과 선택 결과
+ */
+typedef struct {
+    uint32_t hclk_hz;          /**< 측정 시 HCLK (Hz) */
+    uint32_t preint_cycles;    /**< 사전 적분 샘플 하나 (사이클) */
+    uint32_t predict_cycles;   /**< 예측 하나 (사이클) */
+    uint32_t decimate_cycles;  /**< 선택한 factor의 데시메이션 출력 하나 (사이클) */
+    uint32_t gps_cycles;       /**< GNSS 갱신 하나 (사이클) */
+    uint32_t baro_cycles;      /**< 기압계 갱신 하나 (사이클) */
+    uint32_t mag_cycles;       /**< 자력계 갱신 하나 (사이클) */
+    uint8_t factor;            /**< 선택한 데시메이션 비율 */
+    uint32_t imu_hz;           /**< 선택한 IMU 적분 주기 (Hz) */
+    uint16_t predict_samples;  /**< 선택한 예측 간격 (샘플) */
+    uint16_t max_samples;      /**< min_cov_hz를 지키는 최대 예측 간격 (샘플) */
+    float cov_hz;              /**< 선택한 공분산 전파 주기 (Hz) */
+    float load;                /**< 선택한 주기의 예상 CPU 부하 (HCLK 대비, 여유 포함) */
+    bool fits;                 /**< 예산 안에 맞는 후보를 찾았는지 */
+    uint32_t elapsed_ms;       /**< 측정 전체 시간 (ms) */
+} BootTuneResult;
+
+/**
+ * @brief 부팅 자체 측정
+ */
+typedef struct {
+    BootTuneConfig config;     /**< 설정 */
+    BootTuneResult result;     /**< 결과 (boot_tune_run 뒤 유효) */
+    bool done;                 /**< 측정 완료 여부 */
+    bool initialized;          /**< 초기화 여부 */
+} BootTune;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool boot_tune_default_config(BootTuneConfig *config);
+
+/**
+ * @brief 초기화
+ *
+ * @param tune 구조체 포인터
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool boot_tune_init(BootTune *tune, const BootTuneConfig *config);
+
+/**
+ * @brief 커널 측정과 주기 선택 (부팅 시, 스케줄러 시작 전)
+ *
+ * @param tune 구조체 포인터
+ * @param ekf 측정용 필터 (내용을 덮어씀)
+ * @param dec 측정용 데시메이터 (내용을 덮어씀)
+ * @return bool 측정 성공 여부 (예산에 맞는지는 result.fits)
+ */
+bool boot_tune_run(BootTune *tune, EKF *ekf, ImuDecimator *dec);
+
+/**
+ * @brief 선택한 데시메이션 비율 반영 (taps가 factor보다 작으면 factor로 늘림)
+ *
+ * @param tune 구조체 포인터
+ * @param config 데시메이터 설정 (factor, taps 갱신)
+ * @return bool 성공 여부
+ */
+bool boot_tune_apply_decimator(const BootTune *tune, ImuDecimatorConfig *config);
+
+/**
+ * @brief 선택한 예측 간격 반영 (min_samples, max_samples, max_dt 갱신)
+ *
+ * @param tune 구조체 포인터
+ * @param config 적응 예측 주기 설정
+ * @return bool 성공 여부
+ */
+bool boot_tune_apply_predict_rate(const BootTune *tune, PredictRateConfig *config);
+
+/**
+ * @brief 측정 비용을 스케줄러의 비용 추정 초기값으로 반영 (이후 실행 중 학습)
+ *
+ * @param tune 구조체 포인터
+ * @param sched 초기화된 융합 스케줄러
+ * @return bool 성공 여부
+ */
+bool boot_tune_apply_scheduler(const BootTune *tune, FusionScheduler *sched);
+
+/**
+ * @brief 결과
+ *
+ * @param tune 구조체 포인터
+ * @return const BootTuneResult* 결과 (NULL이거나 측정 전이면 NULL)
+ */
+const BootTuneResult *boot_tune_get_result(const BootTune *tune);
+
+#endif /* BOOT_TUNE_H */
@@ -0,0 +1,180 @@
+/**
+ * @file cal_store.h
+ * @brief 내장 플래시 보정값 저장소 (추가 기록 전용 페이지, 부팅 시 필터 시드)
+ *
+ * 전원을 켤 때마다 지구 자기장을 다시 구하고 바이어스는 0에서 수렴시키므로 발사대
+ * 대기 융합이 준비되기까지 오래 걸린다. 지상에서 수렴한 보정값(자이로/가속도 바이어스와
+ * 분산, 지구 자기장 기준, 자력계 경철/연철)을 내장 플래시에 기록해 두고, 부팅 직후
+ * ekf_set_initial_state 다음에 cal_store_apply로 상태와 공분산에 그대로 넣는다.
+ *
+ * - 영역: config.base부터 config.pages개의 플래시 페이지 (FLASH_PAGE_SIZE, STM32L476 2 KB).
+ *   링커 스크립트에서 FLASH 영역 끝을 그만큼 줄여 코드가 들어가지 않게 한다. 코드와 다른
+ *   뱅크(기본: 뱅크 2 마지막 페이지)에 두면 기록/지우기 중에도 코드 읽기가 멈추지 않는다.
+ * - 기록: 고정 크기 레코드(CalStoreRecord, 8바이트 배수)를 지워진 칸에 이중 워드 단위로
+ *   차례로 쓴다 (추가 기록 전용). 페이지가 차면 다음 페이지를 지우고 이어 쓰므로 지우기는
+ *   페이지를 돌아가며 고르게 일어나고(마모 평준화), 지우는 동안에도 직전 페이지의 최신
+ *   레코드는 남는다.
+ * - 검증: 식별값, 형식 버전, 크기, CRC-32 (hw_crc.h). 기록 도중 전원이 꺼진 칸은 CRC로 걸러지고
+ *   지워진 칸도 아니므로 다음 기록은 그 뒤 칸으로 간다. 형식이 바뀌면 CAL_STORE_VERSION을
+ *   올리며 이전 레코드는 무시된다.
+ * - 부팅: cal_store_init이 영역 전체를 한 번 훑어(메모리 사상 읽기, 수십 레코드) 순번이 가장 큰
+ *   유효 레코드와 다음 기록 위치를 찾는다. 복사는 하지 않는다.
+ *
+ * 전원이 끊겨 이중 워드 기록이 반쯤 된 칸을 읽으면 ECC 이중 오류(NMI)가 날 수 있으므로
+ * NMI 처리기는 FLASH->ECCR의 주소가 이 영역이면 해당 칸을 무효로 보고 돌아가야 한다.
+ * 플래시 기록은 수 ms 걸리므로 지상(발사대 대기 중 보정 완료 시점)에서만 저장한다.
+ */
+
+#ifndef CAL_STORE_H
+#define CAL_STORE_H
+
+#include "ekf/ekf.h"
+#include "sensors/mag_iron_cal.h"
+#include "sys/hw_crc.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 레코드 식별값과 형식 버전 (형식이 바뀌면 버전 증가)
+ */
+#define CAL_STORE_MAGIC 0x4C414343u
+#define CAL_STORE_VERSION 1u
+
+/**
+ * @brief 기본 설정
+ */
+#define CAL_STORE_DEFAULT_BASE 0x080FF000u          /**< 영역 시작 (1 MB 부품의 뱅크 2 마지막 두 페이지) */
+#define CAL_STORE_DEFAULT_PAGES 2u                  /**< 영역 페이지 수 (2 이상) */
+#define CAL_STORE_DEFAULT_GYRO_TURN_ON_STD 0.005f   /**< 전원 투입마다의 자이로 바이어스 변화 (rad/s) */
+#define CAL_STORE_DEFAULT_ACCEL_TURN_ON_STD 0.02f   /**< 전원 투입마다의 가속도 바이어스 변화 (m/s^2) */
+
+/**
+ * @brief 레코드에 담긴 항목
+ */
+#define CAL_STORE_HAS_GYRO_BIAS  0x01u /**< 자이로 바이어스와 분산 */
+#define CAL_STORE_HAS_ACCEL_BIAS 0x02u /**< 가속도 바이어스와 분산 */
+#define CAL_STORE_HAS_EARTH_MAG  0x04u /**< 지구 자기장 기준 */
+#define CAL_STORE_HAS_MAG_IRON   0x08u /**< 자력계 경철/연철 보정값 */
+
+/**
+ * @brief 보정 레코드 (CRC는 crc 앞까지 전체를 덮음)
+ */
+typedef struct {
+    uint32_t magic;            /**< CAL_STORE_MAGIC */
+    uint16_t version;          /**< CAL_STORE_VERSION */
+    uint16_t size;             /**< sizeof(CalStoreRecord) */
+    uint32_t sequence;         /**< 기록 순번 (1부터) */
+    uint32_t flags;            /**< 담긴 항목 (CAL_STORE_HAS_*) */
+
+    Vector3f gyro_bias;        /**< 자이로 바이어스 (rad/s) */
+    Vector3f gyro_bias_var;    /**< 자이로 바이어스 분산 ((rad/s)^2) */
+    Vector3f accel_bias;       /**< 가속도 바이어스 (m/s^2) */
+    Vector3f accel_bias_var;   /**< 가속도 바이어스 분산 ((m/s^2)^2) */
+    Vector3f earth_mag_ned;    /**< 지구 자기장 기준 */
+    MagIronCorrection mag;     /**< 자력계 보정값 */
+
+    uint32_t crc;              /**< CRC-32 */
+} __attribute__((aligned(8))) CalStoreRecord;
+
+/**
+ * @brief 저장소 설정
+ */
+typedef struct {
+    uint32_t base;             /**< 영역 시작 주소 (페이지 정렬) */
+    uint32_t pages;            /**< 영역 페이지 수 (2 이상) */
+    float gyro_turn_on_std;    /**< 적용 시 자이로 바이어스 분산에 더할 표준 편차 (rad/s) */
+    float accel_turn_on_std;   /**< 적용 시 가속도 바이어스 분산에 더할 표준 편차 (m/s^2) */
+} CalStoreConfig;
+
+/**
+ * @brief 저장소 통계
+ */
+typedef struct {
+    uint32_t records;          /**< 부팅 시 찾은 유효 레코드 수 */
+    uint32_t corrupt;          /**< 부팅 시 찾은 손상 칸 수 (지워지지도 유효하지도 않음) */
+    uint32_t writes;           /**< 기록한 레코드 수 */
+    uint32_t erases;           /**< 지운 페이지 수 */
+    uint32_t errors;           /**< 플래시 기록/지우기 오류 수 */
+} CalStoreStats;
+
+/**
+ * @brief 보정값 저장소
+ */
+typedef struct {
+    CalStoreConfig config;     /**< 설정 */
+    HwCrc *crc;                /**< CRC 주변장치 (NULL이면 소프트웨어) */
+    const CalStoreRecord *latest; /**< 최신 유효 레코드 (플래시 안, 없으면 NULL) */
+    uint32_t next;             /**< 다음 기록 칸 주소 (페이지 시작이면 먼저 지움) */
+    uint32_t sequence;         /**< 최신 순번 */
+    CalStoreStats stats;       /**< 통계 */
+    bool initialized;          /**< 초기화 여부 */
+} CalStore;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool cal_store_default_config(CalStoreConfig *config);
+
+/**
+ * @brief 저장소 초기화 (영역을 훑어 최신 레코드와 다음 기록 위치를 찾음)
+ *
+ * @param store 저장소
+ * @param crc CRC 주변장치 (NULL이면 소프트웨어)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool cal_store_init(CalStore *store, HwCrc *crc, const CalStoreConfig *config);
+
+/**
+ * @brief 최신 유효 레코드
+ *
+ * @param store 저장소
+ * @return const CalStoreRecord* 레코드 (플래시 안, 없으면 NULL)
+ */
+const CalStoreRecord *cal_store_latest(const CalStore *store);
+
+/**
+ * @brief 필터와 자력계 보정에서 레코드 채우기 (지연 전파 중인 공분산은 먼저 반영)
+ *
+ * @param record 레코드 (머리말/CRC는 cal_store_save가 채움)
+ * @param ekf 수렴한 필터 (초기화된 상태)
+ * @param mag_cal 자력계 보정 추정기 (NULL 가능, 해가 있을 때만 담음)
+ * @return bool 성공 여부
+ */
+bool cal_store_capture(CalStoreRecord *record, EKF *ekf, const MagIronCal *mag_cal);
+
+/**
+ * @brief 레코드 기록 (다음 칸에 추가, 페이지가 차면 다음 페이지를 지우고 이어 씀)
+ *
+ * @param store 저장소
+ * @param record 레코드 (flags와 내용, 머리말/CRC는 여기서 채움)
+ * @return bool 성공 여부 (플래시 오류이면 false, 이전 최신 레코드는 그대로)
+ */
+bool cal_store_save(CalStore *store, const CalStoreRecord *record);
+
+/**
+ * @brief 레코드로 필터 시드 (ekf_set_initial_state 뒤 호출)
+ *
+ * 바이어스 상태를 저장값으로 두고 해당 대각 분산을 저장 분산 + 전원 투입 변화 분산으로,
+ * 교차 공분산은 0으로 둔다. 지구 자기장 기준과 자력계 보정값도 담겨 있으면 되돌린다.
+ *
+ * @param store 저장소 (전원 투입 변화 설정)
+ * @param record 레코드 (cal_store_latest 결과)
+ * @param ekf 필터
+ * @param mag_cal 보정값을 되돌릴 자력계 추정기 (NULL 가능)
+ * @return bool 성공 여부 (값이 유한하지 않거나 분산이 음수이면 false, 필터는 바뀌지 않음)
+ */
+bool cal_store_apply(const CalStore *store, const CalStoreRecord *record, EKF *ekf, MagIronCal *mag_cal);
+
+/**
+ * @brief 통계
+ *
+ * @param store 저장소
+ * @return const CalStoreStats* 통계 (store가 NULL이면 NULL)
+ */
+const CalStoreStats *cal_store_get_stats(const CalStore *store);
+
+#endif /* CAL_STORE_H */
@@ -0,0 +1,197 @@
+/**
+ * @file can_time_sync.h
+ * @brief CAN 보드 간 시각 동기 (SYNC + FOLLOW_UP, 수신 노드 2상태 편차/주파수 추정)
+ *
+ * 항법 보드(주)의 로컬 us 시간축을 공유 시간축으로 삼는다. CAN으로 나가는 항법 해의
+ * 유효 시각(EPOCH 메시지, can_publisher.h)이 이 시간축이므로, 회수/탑재체 보드는 자기
+ * 시간축으로 바꾼 유효 시각에서 출력 예측기(output_predictor 등)를 돌리면 된다.
+ *
+ * 프로토콜 (리틀 엔디언):
+ * @verbatim
+ *   sync_id     SYNC      (1): 순번 u8
+ *   sync_id + 1 FOLLOW_UP (5): 순번 u8, SYNC 송신 시각 u32 (주 시간축 us)
+ * @endverbatim
+ * 주 보드는 SYNC를 보낸 뒤 송신 완료 시각을 잡아 다음 FOLLOW_UP에 싣는다 (PTP 2단계
+ * 방식이라 송신 대기/중재 시간이 측정에 들어가지 않음). 수신 노드는 SYNC 수신 시각을
+ * 보관했다가 같은 순번의 FOLLOW_UP에서 측정 z = (수신 - 지연) - 송신을 만든다.
+ *
+ * 시각은 양쪽 모두 프레임 끝에서 잡는다 (주: 송신 메일박스 완료, 수신: FIFO 수신 인터럽트).
+ * bxCAN의 TTCM 타임스탬프는 SOF 시각이지만 카운터를 읽을 수 없어 로컬 시간축과 이을 수
+ * 없으므로, STM32L4에서는 인터럽트 진입 직후 timebase_now_us로 잡는다. 하드웨어 수신
+ * 타임스탬프를 로컬 시간축으로 줄 수 있는 컨트롤러(FDCAN + TIM 타임스탬프 등)는 그 값을
+ * 넘긴다. 양쪽 인터럽트 지연의 차이 평균은 latency_us로 뺀다.
+ *
+ * 추정기는 time_sync와 같은 2상태 칼만 필터이다 (상태: 기준점 대비 편차 us, 주파수 오차
+ * ppm, 측정마다 기준점 이동). 편차 = 로컬 - 주 이다.
+ *
+ * 수신 처리(can_time_sync_handle_frame)와 변환은 같은 문맥에서 호출한다. 수신 인터럽트에서
+ * 프레임을 태스크로 넘기는 경우에도 수신 시각은 인터럽트에서 잡아 함께 넘긴다.
+ */
+
+#ifndef CAN_TIME_SYNC_H
+#define CAN_TIME_SYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 기본 SYNC 메시지 ID (FOLLOW_UP = +1, 항법 메시지보다 높은 버스 우선순위)
+ */
+#define CAN_TIME_SYNC_DEFAULT_SYNC_ID 0x0F0u
+
+/**
+ * @brief 프레임 길이
+ */
+#define CAN_TIME_SYNC_SYNC_DLC 1u
+#define CAN_TIME_SYNC_FOLLOW_UP_DLC 5u
+
+/**
+ * @brief 연속 거부 한도 (넘으면 다시 시작)
+ */
+#define CAN_TIME_SYNC_MAX_REJECTS 3u
+
+/**
+ * @brief 기본 설정
+ */
+#define CAN_TIME_SYNC_DEFAULT_MEAS_STD_US 5.0f    /**< 측정 표준 편차 (us, 양쪽 인터럽트 지연 흔들림) */
+#define CAN_TIME_SYNC_DEFAULT_DRIFT_STD_PPM 200.0f /**< 초기 상대 주파수 오차 표준 편차 (ppm, 두 수정 합) */
+#define CAN_TIME_SYNC_DEFAULT_DRIFT_RW 0.02f      /**< 상대 주파수 랜덤 워크 (ppm/sqrt(s)) */
+#define CAN_TIME_SYNC_DEFAULT_GATE_SIGMA 5.0f     /**< 측정 거부 문턱 (혁신 표준 편차 배수) */
+#define CAN_TIME_SYNC_DEFAULT_LOCK_STD_US 10.0f   /**< 고정 판정 편차 표준 편차 (us) */
+#define CAN_TIME_SYNC_DEFAULT_LATENCY_US 0.0f     /**< 수신 - 송신 시각 잡기 지연 차 (us) */
+#define CAN_TIME_SYNC_DEFAULT_MAX_GAP_US 10000000u /**< 측정 간격 한도 (us, 넘으면 다시 시작) */
+
+/**
+ * @brief 동기 설정
+ */
+typedef struct {
+    uint16_t sync_id;          /**< SYNC 메시지 ID (FOLLOW_UP = +1, 표준 ID) */
+    float meas_std_us;         /**< 측정 표준 편차 (us) */
+    float drift_std_ppm;       /**< 초기 상대 주파수 오차 표준 편차 (ppm) */
+    float drift_rw;            /**< 상대 주파수 랜덤 워크 (ppm/sqrt(s)) */
+    float gate_sigma;          /**< 측정 거부 문턱 (혁신 표준 편차 배수) */
+    float lock_std_us;         /**< 고정 판정 편차 표준 편차 (us) */
+    float latency_us;          /**< 수신 - 송신 시각 잡기 지연 차 (us) */
+    uint32_t max_gap_us;       /**< 측정 간격 한도 (us) */
+} CanTimeSyncConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t syncs;            /**< 수신한 SYNC 수 */
+    uint32_t follow_ups;       /**< 수신한 FOLLOW_UP 수 */
+    uint32_t unmatched;        /**< 순번이 맞는 SYNC가 없던 FOLLOW_UP 수 */
+    uint32_t updates;          /**< 필터에 반영한 측정 수 */
+    uint32_t rejects;          /**< 거부한 측정 수 */
+    uint32_t restarts;         /**< 다시 시작한 횟수 */
+    float last_residual_us;    /**< 마지막 혁신 (us) */
+} CanTimeSyncStats;
+
+/**
+ * @brief 수신 노드 동기 상태
+ */
+typedef struct {
+    CanTimeSyncConfig config;
+
+    bool has_sync;             /**< FOLLOW_UP을 기다리는 SYNC 여부 */
+    uint8_t sync_seq;          /**< 기다리는 SYNC 순번 */
+    uint32_t sync_rx_us;       /**< SYNC 수신 시각 (로컬 us) */
+
+    bool initialized;          /**< 첫 측정 반영 여부 */
+    uint32_t anchor_local_us;  /**< 기준점 로컬 시각 (us) */
+    uint32_t anchor_master_us; /**< 기준점 주 시각 (us) */
+    float offset_us;           /**< 기준점 대비 편차 (us, 로컬 - 주) */
+    float drift_ppm;           /**< 상대 주파수 오차 (ppm, 로컬이 빠르면 양수) */
+    float P[2][2];             /**< 공분산 (us, ppm) */
+    uint32_t consecutive_rejects; /**< 연속 거부 수 */
+
+    CanTimeSyncStats stats;
+} CanTimeSync;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool can_time_sync_default_config(CanTimeSyncConfig *config);
+
+/**
+ * @brief 수신 노드 동기 초기화
+ *
+ * @param sync 동기 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부 (설정이 잘못되면 false)
+ */
+bool can_time_sync_init(CanTimeSync *sync, const CanTimeSyncConfig *config);
+
+/**
+ * @brief SYNC 데이터 채우기 (주 보드)
+ *
+ * @param seq 순번
+ * @param data 결과 데이터 (8바이트)
+ * @return uint8_t 데이터 길이
+ */
+uint8_t can_time_sync_pack_sync(uint8_t seq, uint8_t data[8]);
+
+/**
+ * @brief FOLLOW_UP 데이터 채우기 (주 보드)
+ *
+ * @param seq 짝이 되는 SYNC 순번
+ * @param tx_us SYNC 송신 완료 시각 (주 시간축 us)
+ * @param data 결과 데이터 (8바이트)
+ * @return uint8_t 데이터 길이
+ */
+uint8_t can_time_sync_pack_follow_up(uint8_t seq, uint32_t tx_us, uint8_t data[8]);
+
+/**
+ * @brief 수신 프레임 처리 (SYNC/FOLLOW_UP이 아니면 무시)
+ *
+ * @param sync 동기 상태
+ * @param id 표준 ID
+ * @param data 데이터
+ * @param dlc 데이터 길이
+ * @param rx_us 수신 시각 (로컬 us, 수신 인터럽트에서 잡은 값)
+ * @return bool 필터를 갱신했으면 true
+ */
+bool can_time_sync_handle_frame(CanTimeSync *sync, uint16_t id, const uint8_t *data, uint8_t dlc,
+                                uint32_t rx_us);
+
+/**
+ * @brief 고정 여부 (기준점 1초 뒤 예측 편차의 표준 편차가 lock_std_us 이하)
+ *
+ * @param sync 동기 상태
+ * @return bool 고정 여부
+ */
+bool can_time_sync_is_locked(const CanTimeSync *sync);
+
+/**
+ * @brief 주 시각 -> 로컬 시각 (EPOCH 유효 시각 변환)
+ *
+ * @param sync 동기 상태
+ * @param master_us 주 시각 (us, 기준점에서 ±35분 이내)
+ * @param local_us 결과 로컬 시각 (us)
+ * @return bool 성공 여부 (고정 전이면 false, 결과 변경 없음)
+ */
+bool can_time_sync_master_to_local(const CanTimeSync *sync, uint32_t master_us, uint32_t *local_us);
+
+/**
+ * @brief 로컬 시각 -> 주 시각
+ *
+ * @param sync 동기 상태
+ * @param local_us 로컬 시각 (us, 기준점에서 ±35분 이내)
+ * @param master_us 결과 주 시각 (us)
+ * @return bool 성공 여부 (고정 전이면 false, 결과 변경 없음)
+ */
+bool can_time_sync_local_to_master(const CanTimeSync *sync, uint32_t local_us, uint32_t *master_us);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param sync 동기 상태
+ * @return const CanTimeSyncStats* 통계 (sync가 NULL이면 NULL)
+ */
+const CanTimeSyncStats *can_time_sync_get_stats(const CanTimeSync *sync);
+
+#endif /* CAN_TIME_SYNC_H */
@@ -0,0 +1,178 @@
+/**
+ * @file energy.h
+ * @brief 전류 감지 ADC 기반 트레이스 구간별 에너지 측정
+ *
+ * sys/profile.h와 sys/trace.h는 사이클만 재므로, 기능 하나가 배터리를 얼마나 쓰는지는 알 수 없다.
+ * 보드 전류 감지선을 ADC로 타이머 트리거(TRGO) 변환하고 DMA 원형 모드로 ENERGY_RING_SIZE개
+ * 링에 받는다. DMA 반/완료 인터럽트가 끝난 반쪽을 누적 합에 더하고, 트레이스 표시
+ * (TRACE_BEGIN/TRACE_END)가 불릴 때마다 "누적 합 + 아직 더하지 않은 링 구간"으로 그 순간까지의
+ * 전하를 구해 구간 시작/끝의 차이를 이벤트(TraceEvent)별로 쌓는다. 따라서 예측, 갱신 종류별
+ * 처리, 기록 엔진 진행, 블록 기록(TRACE_EVENT_LOG_FLUSH) 한 번당 마이크로줄을 얻는다.
+ *
+ * 구간 에너지 = sum(code - offset_code) x ua_per_lsb x supply_v / sample_hz (uJ)
+ *
+ * 표본 주기보다 짧은 구간은 0 또는 표본 하나로 잡히므로 평균은 호출 수가 많아야 의미가 있다
+ * (기본 50 kHz면 20 us 해상도). 반쪽 링(ENERGY_RING_SIZE / 2 표본) 시간 안에 ADC DMA 인터럽트가
+ * 처리되어야 하며, 표시 한 번은 많아야 반쪽 링만큼 더한다 (64개 링이면 약 32회 덧셈).
+ * 함께 돌아가는 구간(사이클 안의 예측 등)은 각자 따로 센다. 같은 이벤트가 끝나기 전에 다시
+ * 시작하면 앞의 시작은 버린다.
+ *
+ * 연결 예 (CubeMX: ADC 외부 트리거 = TIMx TRGO, 연속 변환 끔, DMA 원형 반워드; TIMx 업데이트 TRGO):
+ * - HAL_ADC_ConvHalfCpltCallback: energy_handle_adc_half(hadc)
+ * - HAL_ADC_ConvCpltCallback: energy_handle_adc_complete(hadc)
+ * - 저우선순위 태스크: energy_report(write)
+ *
+ * ENERGY_ENABLE 미정의 시 모든 API는 빈 코드로 컴파일되며 트레이스 표시에도 비용이 없다.
+ */
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sys/board_profile.h"
+#include "stm32l4xx_hal.h"
+#include "sys/trace.h"
+
+#if !BOARD_HAS_CURRENT_SENSE
+#error "sys/energy.h requires BOARD_HAS_CURRENT_SENSE (sys/board_profile.h)"
+#endif
+
+/**
+ * @brief 에너지 측정 활성화
+ *
+ * 빌드 설정에서 정의한다. 정의 시 stm32l4xx_hal.h의 ADC/TIM/DMA HAL을 사용한다.
+ */
+/* #define ENERGY_ENABLE */
+
+/**
+ * @brief ADC DMA 링 크기 (표본, 짝수)
+ */
+#define ENERGY_RING_SIZE 64u
+
+/**
+ * @brief 기본 설정
+ */
+#define ENERGY_DEFAULT_SAMPLE_HZ 50000.0f  /**< 변환 주기 (Hz, 타이머 TRGO와 같아야 함) */
+#define ENERGY_DEFAULT_UA_PER_LSB 244.0f   /**< 부호 하나당 전류 (uA, 3.3 V / 4096 / (gain 50 x 0.0066 ohm)) */
+#define ENERGY_DEFAULT_OFFSET_CODE 0u      /**< 전류 0일 때 부호 */
+#define ENERGY_DEFAULT_SUPPLY_V 3.7f       /**< 전류 감지 지점 전압 (V, 배터리) */
+
+/**
+ * @brief 측정 설정
+ */
+typedef struct {
+    float sample_hz;           /**< 변환 주기 (Hz) */
+    float ua_per_lsb;          /**< 부호 하나당 전류 (uA) */
+    uint16_t offset_code;      /**< 전류 0일 때 부호 */
+    float supply_v;            /**< 전압 (V) */
+} EnergyConfig;
+
+/**
+ * @brief 이벤트별 측정 결과
+ */
+typedef struct {
+    uint32_t count;            /**< 끝난 구간 수 */
+    uint32_t overruns;         /**< 처리가 밀려 링이 덮여 버린 구간 수 */
+    float mean_uj;             /**< 구간당 평균 에너지 (uJ) */
+    float max_uj;              /**< 구간당 최대 에너지 (uJ) */
+    float mean_ma;             /**< 구간 동안 평균 전류 (mA, 표본 없는 구간은 제외) */
+    float total_mj;            /**< 누적 에너지 (mJ) */
+} EnergyEventStats;
+
+/**
+ * @brief 측정 결과 출력 콜백 (예: 디버그 UART 송신)
+ *
+ * @param line 널 종료 문자열 한 줄 ("\r\n" 포함)
+ */
+typedef void (*EnergyWriteFn)(const char *line);
+
+#ifdef ENERGY_ENABLE
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정 구조체 포인터
+ * @return bool 성공 여부
+ */
+bool energy_default_config(EnergyConfig *config);
+
+/**
+ * @brief 측정 시작 (ADC DMA 원형 변환과 트리거 타이머 시작)
+ *
+ * @param hadc ADC 핸들 (외부 트리거, DMA 원형 모드)
+ * @param htim 트리거 타이머 핸들 (TRGO = 업데이트)
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool energy_init(ADC_HandleTypeDef *hadc, TIM_HandleTypeDef *htim, const EnergyConfig *config);
+
+/**
+ * @brief 트레이스 표시 (TRACE_BEGIN/TRACE_END가 부름, 어느 문맥에서나)
+ *
+ * @param code 이벤트 번호 << 1 | 끝 표시 (트레이스 워드 하위 8비트와 같음)
+ */
+void energy_mark(uint32_t code);
+
+/**
+ * @brief ADC DMA 반 완료 처리 (HAL_ADC_ConvHalfCpltCallback)
+ *
+ * @param hadc ADC 핸들
+ */
+void energy_handle_adc_half(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief ADC DMA 완료 처리 (HAL_ADC_ConvCpltCallback)
+ *
+ * @param hadc ADC 핸들
+ */
+void energy_handle_adc_complete(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief 이벤트별 누적 초기화 (변환은 계속)
+ */
+void energy_reset(void);
+
+/**
+ * @brief 이벤트 측정 결과
+ *
+ * @param event 트레이스 이벤트
+ * @param stats 결과
+ * @return bool 성공 여부 (범위 밖이거나 측정 전이면 false)
+ */
+bool energy_get(TraceEvent event, EnergyEventStats *stats);
+
+/**
+ * @brief 전체 평균 전류 (측정 시작 또는 초기화 이후)
+ *
+ * @return float 평균 전류 (mA, 표본이 없으면 0)
+ */
+float energy_mean_current_ma(void);
+
+/**
+ * @brief 이벤트별 결과를 한 줄씩 출력
+ *
+ * - ENERGY,total,<덮인 반쪽 링 수>,<전체 평균 mA>
+ * - ENERGY,<이름>,<구간 수>,<평균 uJ>,<최대 uJ>,<평균 mA>,<누적 mJ> (구간이 있는 이벤트만)
+ *
+ * @param write 출력 콜백
+ */
+void energy_report(EnergyWriteFn write);
+
+#else /* ENERGY_ENABLE */
+
+static inline bool energy_default_config(EnergyConfig *config) { (void)config; return false; }
+static inline bool energy_init(ADC_HandleTypeDef *hadc, TIM_HandleTypeDef *htim, const EnergyConfig *config) {
+    (void)hadc; (void)htim; (void)config; return false;
+}
+static inline void energy_mark(uint32_t code) { (void)code; }
+static inline void energy_handle_adc_half(ADC_HandleTypeDef *hadc) { (void)hadc; }
+static inline void energy_handle_adc_complete(ADC_HandleTypeDef *hadc) { (void)hadc; }
+static inline void energy_reset(void) { }
+static inline bool energy_get(TraceEvent event, EnergyEventStats *stats) { (void)event; (void)stats; return false; }
+static inline float energy_mean_current_ma(void) { return 0.0f; }
+static inline void energy_report(EnergyWriteFn write) { (void)write; }
+
+#endif /* ENERGY_ENABLE */
+
+#endif /* ENERGY_H */
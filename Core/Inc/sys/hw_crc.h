@@ -0,0 +1,96 @@
+/**
+ * @file hw_crc.h
+ * @brief CRC 주변장치를 이용한 CRC-32 (zlib/이더넷 호환, CPU 입력 및 DMA 입력)
+ *
+ * 다항식 0x04C11DB7, 초기값 0xFFFFFFFF, 입출력 비트 반사, 최종 XOR 0xFFFFFFFF로
+ * 호스트의 zlib.crc32 / binascii.crc32 와 같은 값을 낸다.
+ *
+ * - hw_crc32: CPU가 HAL_CRC_Calculate로 바이트열을 넣는다 (워드당 1회 쓰기, 짧은 프레임용).
+ * - hw_crc32_start_dma: 메모리 → CRC_DR DMA(워드 단위)로 넣고 완료 콜백으로 결과를 준다
+ *   (4 KB 기록 블록용, CPU는 그동안 다른 일을 함).
+ *
+ * 바이트 입력은 HAL이 빅 엔디언으로 묶어 쓰므로 바이트 단위 반사, DMA는 리틀 엔디언
+ * 워드를 그대로 쓰므로 워드 단위 반사로 설정을 바꿔 같은 결과를 얻는다.
+ * DMA 진행 중에는 주변장치를 쓸 수 없으므로 hw_crc32는 소프트웨어 계산으로 대신한다.
+ *
+ * DMA 채널은 CubeMX에서 메모리 → 메모리(MEM2MEM), 원본 증가/대상 고정, 워드 폭,
+ * 일반 모드로 설정하고 채널 인터럽트를 활성화한다.
+ */
+
+#ifndef HW_CRC_H
+#define HW_CRC_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief CRC 초기값/최종 XOR
+ */
+#define HW_CRC_INIT 0xFFFFFFFFu
+
+/**
+ * @brief DMA 계산 완료 콜백 (DMA 인터럽트 문맥, DMA 오류이면 ok = false)
+ */
+typedef void (*HwCrcDoneFn)(bool ok, uint32_t crc, void *context);
+
+/**
+ * @brief CRC 주변장치
+ */
+typedef struct {
+    CRC_HandleTypeDef *hcrc;   /**< CRC 핸들 */
+    DMA_HandleTypeDef *hdma;   /**< MEM2MEM DMA 핸들 (NULL이면 DMA 계산 불가) */
+    atomic_flag busy;          /**< 주변장치 사용 중 */
+    HwCrcDoneFn done;          /**< 진행 중인 DMA 계산의 완료 콜백 */
+    void *done_context;        /**< 완료 콜백 문맥 */
+    uint32_t sw_fallbacks;     /**< 사용 중이라 소프트웨어로 계산한 횟수 */
+    bool initialized;          /**< 초기화 여부 */
+} HwCrc;
+
+/**
+ * @brief CRC-32 주변장치 초기화
+ *
+ * hcrc->Instance만 설정되어 있으면 되며, 나머지 설정은 이 함수가 채운다.
+ *
+ * @param crc 구조체 포인터
+ * @param hcrc CRC 핸들
+ * @param hdma MEM2MEM DMA 핸들 (NULL 가능)
+ * @return bool 성공 여부
+ */
+bool hw_crc_init(HwCrc *crc, CRC_HandleTypeDef *hcrc, DMA_HandleTypeDef *hdma);
+
+/**
+ * @brief 바이트열 CRC-32 (CPU 입력, 주변장치가 사용 중이면 소프트웨어)
+ *
+ * 다른 문맥과 동시에 호출할 수 있다 (주변장치를 얻지 못한 쪽이 소프트웨어로 계산).
+ *
+ * @param crc 구조체 포인터 (NULL이면 소프트웨어)
+ * @param data 데이터
+ * @param len 길이 (바이트)
+ * @return uint32_t CRC-32
+ */
+uint32_t hw_crc32(HwCrc *crc, const void *data, uint32_t len);
+
+/**
+ * @brief 소프트웨어 CRC-32 (4비트 표, 결과는 hw_crc32와 같음)
+ *
+ * @param data 데이터
+ * @param len 길이 (바이트)
+ * @return uint32_t CRC-32
+ */
+uint32_t hw_crc32_sw(const void *data, uint32_t len);
+
+/**
+ * @brief DMA CRC-32 계산 시작
+ *
+ * @param crc 구조체 포인터
+ * @param data 데이터 (4바이트 정렬, 완료 때까지 유지)
+ * @param len 길이 (바이트, 4의 배수)
+ * @param done 완료 콜백 (DMA 인터럽트 문맥에서 결과와 함께 호출)
+ * @param context 콜백 문맥
+ * @return bool 시작 여부 (주변장치 사용 중이거나 DMA가 없으면 false)
+ */
+bool hw_crc32_start_dma(HwCrc *crc, const void *data, uint32_t len, HwCrcDoneFn done, void *context);
+
+#endif /* HW_CRC_H */
@@ -0,0 +1,159 @@
+/**
+ * @file irq_sched.h
+ * @brief RTOS 없는 빌드용 우선순위 실행-완료(run-to-completion) 이벤트 스케줄러
+ *
+ * 작은 보드에서는 RTOS(rtos_tasks.h) 대신 NVIC 자체를 스케줄러로 쓴다. 우선순위 단계마다
+ * 쓰지 않는 주변장치 벡터(또는 가장 낮은 단계에 PendSV) 하나를 소프트웨어 인터럽트로 두고,
+ * 이벤트를 게시(irq_sched_post)하면 그 단계의 대기 비트를 원자적으로 세운 뒤 해당 벡터를
+ * 대기 상태로 만든다. 벡터 처리기(irq_sched_dispatch)는 대기 비트가 없어질 때까지 그 단계의
+ * 처리기를 등록 순서대로 끝까지 실행한다.
+ *
+ * - 선점: 높은 단계의 게시는 하드웨어 중첩으로 낮은 단계 처리기를 바로 선점한다. 모든 처리기가
+ *   주 스택(MSP) 하나를 공유하므로 스레드별 스택과 문맥 전환(레지스터 저장은 예외 진입이 함)이
+ *   없다. 스택은 단계별 최대 깊이의 합만큼만 필요하다 (memstat.h로 확인).
+ * - 실행-완료: 처리기는 기다리거나 막히지 않아야 한다 (FIFO 기록/DMA 시작 후 바로 반환).
+ *   같은 단계 처리기끼리는 서로 선점하지 않으므로 같은 단계에서만 쓰는 자료에는 잠금이 필요 없다.
+ * - 게시: 인터럽트나 다른 처리기에서 호출할 수 있다. 이미 대기 중인 이벤트를 다시 게시하면 한 번만
+ *   실행되며 coalesced로 센다 (이벤트는 "일이 있음" 표시이고 자료는 링/대기열에 있음).
+ *
+ * 단계 우선순위(NVIC 선점 우선순위)는 게시하는 센서 인터럽트보다 낮아야(숫자로 커야) 한다.
+ * 예 (STM32L476, 4비트 선점 우선순위):
+ * - IMU DMA/EXTI 5 -> 단계 0: 예측/갱신 (SWPMI1_IRQn, 6)
+ * - 단계 1: 기록 엔진 진행 (LCD_IRQn, 10)
+ * - 단계 2: 텔레메트리 (PendSV_IRQn, 14)
+ * 벡터 처리기 예: void SWPMI1_IRQHandler(void) { irq_sched_dispatch(&sched, 0); }
+ */
+
+#ifndef IRQ_SCHED_H
+#define IRQ_SCHED_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 최대 우선순위 단계 수
+ */
+#define IRQ_SCHED_MAX_LEVELS 4u
+
+/**
+ * @brief 최대 이벤트 수 (단계별 대기 비트 32개 이내)
+ */
+#define IRQ_SCHED_MAX_EVENTS 16u
+
+/**
+ * @brief 이벤트 처리기 (실행-완료, 기다리지 않음)
+ */
+typedef void (*IrqSchedHandlerFn)(void *context);
+
+/**
+ * @brief 이벤트 번호 (irq_sched_register 반환값)
+ */
+typedef uint8_t IrqSchedEvent;
+
+/**
+ * @brief 잘못된 이벤트 번호
+ */
+#define IRQ_SCHED_INVALID_EVENT 0xFFu
+
+/**
+ * @brief 이벤트 통계
+ */
+typedef struct {
+    uint32_t posts;            /**< 게시 수 */
+    uint32_t runs;             /**< 실행 수 */
+    uint32_t coalesced;        /**< 이미 대기 중이라 합쳐진 게시 수 */
+} IrqSchedEventStats;
+
+/**
+ * @brief 이벤트
+ */
+typedef struct {
+    IrqSchedHandlerFn handler; /**< 처리기 */
+    void *context;             /**< 처리기 문맥 */
+    uint8_t level;             /**< 우선순위 단계 */
+    uint8_t bit;               /**< 단계 안의 대기 비트 번호 */
+    atomic_uint_fast32_t posts; /**< 게시 수 */
+    atomic_uint_fast32_t coalesced; /**< 합쳐진 게시 수 */
+    uint32_t runs;             /**< 실행 수 (그 단계 처리기 문맥 전용) */
+} IrqSchedEventSlot;
+
+/**
+ * @brief 우선순위 단계
+ */
+typedef struct {
+    IRQn_Type irq;             /**< 소프트웨어 인터럽트로 쓰는 벡터 */
+    atomic_uint_fast32_t pending; /**< 대기 이벤트 비트 */
+    uint8_t events[32];        /**< 비트 번호 -> 이벤트 번호 */
+    uint8_t event_count;       /**< 이 단계 이벤트 수 */
+    uint32_t dispatches;       /**< 벡터 진입 수 */
+} IrqSchedLevel;
+
+/**
+ * @brief 스케줄러
+ */
+typedef struct {
+    IrqSchedLevel level[IRQ_SCHED_MAX_LEVELS]; /**< 단계 (0이 가장 높음) */
+    uint8_t level_count;       /**< 설정한 단계 수 */
+    IrqSchedEventSlot event[IRQ_SCHED_MAX_EVENTS]; /**< 이벤트 */
+    uint8_t event_count;       /**< 등록한 이벤트 수 */
+} IrqSched;
+
+/**
+ * @brief 스케줄러 초기화
+ *
+ * @param sched 스케줄러
+ * @return bool 성공 여부
+ */
+bool irq_sched_init(IrqSched *sched);
+
+/**
+ * @brief 우선순위 단계 추가 (높은 단계부터, 벡터 우선순위 설정과 허용까지 수행)
+ *
+ * @param sched 스케줄러
+ * @param irq 소프트웨어 인터럽트로 쓸 벡터 (쓰지 않는 주변장치 벡터 또는 PendSV_IRQn)
+ * @param preempt_priority NVIC 선점 우선순위 (앞 단계보다 숫자로 커야 함)
+ * @return bool 성공 여부
+ */
+bool irq_sched_add_level(IrqSched *sched, IRQn_Type irq, uint32_t preempt_priority);
+
+/**
+ * @brief 이벤트 처리기 등록 (부팅 중, 게시 시작 전)
+ *
+ * @param sched 스케줄러
+ * @param level 우선순위 단계 (irq_sched_add_level 순서)
+ * @param handler 처리기
+ * @param context 처리기 문맥
+ * @return IrqSchedEvent 이벤트 번호 (실패 시 IRQ_SCHED_INVALID_EVENT)
+ */
+IrqSchedEvent irq_sched_register(IrqSched *sched, uint8_t level, IrqSchedHandlerFn handler, void *context);
+
+/**
+ * @brief 이벤트 게시 (인터럽트/처리기 문맥 가능)
+ *
+ * @param sched 스케줄러
+ * @param event 이벤트 번호
+ * @return bool 성공 여부 (잘못된 이벤트이면 false, 합쳐진 게시도 true)
+ */
+bool irq_sched_post(IrqSched *sched, IrqSchedEvent event);
+
+/**
+ * @brief 단계 벡터 처리기 본체 (해당 벡터 IRQHandler에서 호출)
+ *
+ * @param sched 스케줄러
+ * @param level 우선순위 단계
+ */
+void irq_sched_dispatch(IrqSched *sched, uint8_t level);
+
+/**
+ * @brief 이벤트 통계
+ *
+ * @param sched 스케줄러
+ * @param event 이벤트 번호
+ * @param stats 통계 저장 위치
+ * @return bool 성공 여부
+ */
+bool irq_sched_get_stats(const IrqSched *sched, IrqSchedEvent event, IrqSchedEventStats *stats);
+
+#endif /* IRQ_SCHED_H */
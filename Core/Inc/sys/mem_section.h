@@ -0,0 +1,138 @@
+/**
+ * @file mem_section.h
+ * @brief 필터 작업 메모리와 핵심 함수의 SRAM 영역 배치용 섹션 지정 매크로
+ *
+ * STM32L476은 SRAM1(96KB, 0x20000000)과 SRAM2(32KB, 0x10000000)를 가진다.
+ * 필터 상태와 스크래치 영역은 SRAM1에, MSP 스택은 SRAM2에 두면 스택이 넘쳐도
+ * 힙이나 공분산을 덮어쓰지 않고 SRAM2 경계에서 버스 폴트로 드러난다.
+ *
+ * MEM_SECTIONS_ENABLE 을 정의하면 아래 매크로가 이름 있는 섹션으로 배치되며,
+ * 링커 스크립트(STM32CubeIDE 생성 *_FLASH.ld)에 다음 항목이 있어야 한다.
+ *
+ * @verbatim
+ *   .sram1_noinit (NOLOAD) : { . = ALIGN(8); *(.sram1_noinit*) . = ALIGN(8); } >RAM
+ *   _sstack = ORIGIN(RAM2);                  // 스택 영역 하한 (memstat.c)
+ *   _estack = ORIGIN(RAM2) + LENGTH(RAM2);   // MSP 스택을 SRAM2 끝으로 이동
+ * @endverbatim
+ *
+ * NOLOAD 섹션은 시작 코드가 0으로 채우지 않으므로, 배치되는 객체는
+ * 사용 전에 반드시 초기화 함수를 거쳐야 한다 (ekf_init, scratch_init 등).
+ * 미정의 시 매크로는 비어 있어 일반 .bss에 배치된다.
+ *
+ * MEM_RAMFUNC_ENABLE 을 정의하면 MEM_RAMFUNC/MEM_RAMDATA로 표시한 융합 핵심 함수와
+ * 상수 표를 SRAM2(0x10000000, I-Code/D-Code 버스, 대기 상태 없음)에서 실행/참조한다.
+ * 80 MHz에서 플래시는 4 대기 상태이고 ART 캐시(1 KB)는 필터 코드보다 작아 실행 시간이
+ * 캐시 적중에 따라 흔들리므로, 핵심 경로를 RAM에 두면 주기 시간이 결정적이 된다.
+ * 링커 스크립트에 다음 항목을 더하고 main 첫 줄에서 mem_section_init을 호출한다.
+ *
+ * @verbatim
+ *   .ramfunc : {
+ *     . = ALIGN(8);
+ *     _sramfunc = .;
+ *     *(.ramfunc*)
+ *     *(.ramdata*)
+ *     . = ALIGN(8);
+ *     _eramfunc = .;
+ *   } >RAM2 AT> FLASH
+ *   _siramfunc = LOADADDR(.ramfunc);
+ *   _sstack = _eramfunc;                     // MEM_SECTIONS_ENABLE 시 스택 하한을 RAM 함수 위로
+ * @endverbatim
+ *
+ * MEM_RETAIN_ENABLE 을 정의하면 MEM_SECTION_RETAIN으로 표시한 객체(예: 재시작 복구용
+ * 필터 스냅숏, sys/warm_start.h)를 SRAM2의 비초기화 영역에 둔다. SRAM2는 시스템 리셋
+ * (워치독, 소프트웨어, 리셋 핀, 전압이 유지 한계 위로 남는 저전압 리셋)에도 내용이
+ * 유지된다 (옵션 바이트 SRAM2_RST = 1, 기본값). 시작 코드가 건드리지 않도록 스택보다
+ * 아래에 둔다.
+ *
+ * @verbatim
+ *   .sram2_retain (NOLOAD) : { . = ALIGN(8); *(.sram2_retain*) . = ALIGN(8); _eretain = .; } >RAM2
+ *   _sstack = _eretain;                      // 스택 하한을 유지 영역 위로
+ * @endverbatim
+ *
+ * 섹션 이름에 함수/객체 이름을 붙이므로 --gc-sections가 쓰지 않는 크기 변형을 제거한다.
+ * 리터럴 풀은 함수 섹션에 함께 들어가므로 따로 표시하지 않는다. 플래시 함수와 RAM 함수
+ * 사이 호출은 BL 범위(±16 MB)를 벗어나 링커가 만든 veneer를 거치므로, 호출 사슬 전체를
+ * 함께 옮겨야 이득이 크다. 효과는 보드 벤치마크(sys/bench.h)의 begin 줄 RAM 함수 영역 열이
+ * 다른 두 빌드로 비교한다.
+ */
+
+#ifndef MEM_SECTION_H
+#define MEM_SECTION_H
+
+#include <stdint.h>
+
+/**
+ * @brief 섹션 배치 활성화
+ *
+ * 빌드 설정에서 링커 스크립트 수정과 함께 정의한다.
+ */
+/* #define MEM_SECTIONS_ENABLE */
+
+#ifdef MEM_SECTIONS_ENABLE
+/**
+ * @brief SRAM1 비초기화 영역 배치 (필터 상태, 스크래치 영역)
+ */
+#define MEM_SECTION_SRAM1 __attribute__((section(".sram1_noinit")))
+#else
+#define MEM_SECTION_SRAM1
+#endif
+
+/**
+ * @brief RAM 실행 배치 활성화
+ *
+ * 빌드 설정에서 링커 스크립트 수정과 함께 정의한다.
+ */
+/* #define MEM_RAMFUNC_ENABLE */
+
+#ifdef MEM_RAMFUNC_ENABLE
+/**
+ * @brief SRAM2 실행 함수 배치 (정의 앞에 붙임, name은 함수 이름)
+ */
+#define MEM_RAMFUNC(name) __attribute__((section(".ramfunc." #name)))
+
+/**
+ * @brief SRAM2 상수 표 배치 (정의 앞에 붙임, name은 객체 이름)
+ */
+#define MEM_RAMDATA(name) __attribute__((section(".ramdata." #name)))
+#else
+#define MEM_RAMFUNC(name)
+#define MEM_RAMDATA(name)
+#endif
+
+/**
+ * @brief 리셋 유지 영역 배치 활성화
+ *
+ * 빌드 설정에서 링커 스크립트 수정과 함께 정의한다.
+ */
+/* #define MEM_RETAIN_ENABLE */
+
+#ifdef MEM_RETAIN_ENABLE
+/**
+ * @brief SRAM2 리셋 유지 영역 배치 (내용은 CRC 등으로 검증한 뒤 사용)
+ */
+#define MEM_SECTION_RETAIN __attribute__((section(".sram2_retain")))
+#else
+#define MEM_SECTION_RETAIN
+#endif
+
+/**
+ * @brief RAM 함수/상수 영역을 플래시 적재 주소에서 SRAM2로 복사
+ *
+ * 표시된 함수를 처음 호출하기 전에, main 첫 줄(또는 시작 코드의 .data 복사 뒤)에서
+ * 한 번 호출한다. MEM_RAMFUNC_ENABLE 미정의 시 아무 일도 하지 않는다.
+ */
+void mem_section_init(void);
+
+/**
+ * @brief SRAM2에 복사한 RAM 함수/상수 영역 크기
+ *
+ * @return uint32_t 바이트 수 (비활성이면 0)
+ */
+uint32_t mem_section_ramfunc_size(void);
+
+/**
+ * @brief 8바이트 정렬 (double/LDRD 접근 및 DMA 전송용)
+ */
+#define MEM_ALIGN8 __attribute__((aligned(8)))
+
+#endif /* MEM_SECTION_H */
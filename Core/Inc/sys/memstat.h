@@ -0,0 +1,100 @@
+/**
+ * @file memstat.h
+ * @brief MSP 스택 최대 사용량(high water) 및 힙 사용량 측정
+ *
+ * 부팅 직후 힙 끝(_sbrk(0))부터 현재 스택 포인터 바로 아래까지를 고정 패턴으로
+ * 칠해 두고, 필요할 때 아래쪽부터 패턴이 지워진 첫 워드를 찾아 스택 최대 사용량을
+ * 계산한다. 힙 사용량은 _end 와 _sbrk(0)의 차이이다.
+ *
+ * MEM_SECTIONS_ENABLE(mem_section.h)로 스택을 SRAM2로 옮긴 경우 칠하는 영역의
+ * 하한은 링커 스크립트의 _sstack (= ORIGIN(RAM2)) 심볼을 사용한다.
+ *
+ * 결과는 프로파일링 카운터와 같은 출력 콜백(ProfileWriteFn)으로 보고한다.
+ *
+ * 특정 코드 구간의 스택 깊이는 memstat_window_begin/memstat_window_used로 잰다 (벤치마크
+ * 빌드의 커널별 스택 사용량, sys/bench.h).
+ */
+
+#ifndef MEMSTAT_H
+#define MEMSTAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sys/profile.h"
+
+/**
+ * @brief 스택 칠하기 패턴
+ */
+#define MEMSTAT_STACK_PATTERN 0xA5A5A5A5u
+
+/**
+ * @brief 칠하지 않고 남겨 둘 현재 스택 포인터 아래 여유 (바이트)
+ */
+#define MEMSTAT_STACK_GUARD 64u
+
+/**
+ * @brief 메모리 사용량
+ */
+typedef struct {
+    uint32_t stack_size;    /**< 스택 영역 크기 (_estack - 하한, 바이트) */
+    uint32_t stack_used;    /**< 스택 최대 사용량 (바이트) */
+    uint32_t heap_used;     /**< 힙 사용량 (바이트) */
+    uint32_t min_stack_reserve; /**< 링커의 _Min_Stack_Size (바이트) */
+} MemStats;
+
+/**
+ * @brief 구간 스택 측정 창
+ */
+typedef struct {
+    uint32_t *bottom;       /**< 칠한 영역 하한 */
+    uint32_t *top;          /**< 칠한 영역 상한 */
+    uint32_t sp;            /**< 시작 시 스택 포인터 */
+} MemStackWindow;
+
+/**
+ * @brief 스택 영역 칠하기
+ *
+ * main 진입 직후, 인터럽트와 태스크가 시작되기 전에 한 번 호출한다.
+ */
+void memstat_init(void);
+
+/**
+ * @brief 현재까지의 메모리 사용량 계산
+ *
+ * 칠한 영역을 아래쪽부터 검사하므로 스택 사용량이 적을수록 오래 걸린다.
+ * 제어 루프가 아닌 저우선순위 태스크에서 호출한다.
+ *
+ * @param stats 결과 사용량
+ * @return bool 성공 여부 (memstat_init 전이면 false)
+ */
+bool memstat_get(MemStats *stats);
+
+/**
+ * @brief 메모리 사용량을 한 줄씩 출력
+ *
+ * @param write 출력 콜백
+ */
+void memstat_report(ProfileWriteFn write);
+
+/**
+ * @brief 구간 스택 측정 시작 (현재 스택 포인터 아래 size 바이트를 다시 칠함)
+ *
+ * 칠하는 동안 인터럽트를 막는다. 스택 영역 하한 아래로는 칠하지 않으며, 칠한 창 안에서는
+ * memstat_get의 최대 사용량 기록도 지워진다. 구간 사이에 들어온 인터럽트 프레임도 사용량에
+ * 포함된다.
+ *
+ * @param window 측정 창
+ * @param size 칠할 크기 (바이트)
+ * @return bool 성공 여부
+ */
+bool memstat_window_begin(MemStackWindow *window, uint32_t size);
+
+/**
+ * @brief 구간 시작 뒤 최대 스택 깊이
+ *
+ * @param window memstat_window_begin으로 시작한 창
+ * @return uint32_t 시작 시 스택 포인터 아래로 쓰인 최대 바이트 (창 전체가 쓰였으면 창 크기 이상일 수 있음)
+ */
+uint32_t memstat_window_used(const MemStackWindow *window);
+
+#endif /* MEMSTAT_H */
@@ -0,0 +1,144 @@
+/**
+ * @file pad_hold.h
+ * @brief 발사대 장시간 대기용 Stop 2 저전력 모드 (LPTIM 시간 유지, IMU FIFO/LPUART 깨우기)
+ *
+ * 발사대 대기는 몇 시간이 될 수 있다. WFI(power_idle)는 코어만 재우지만 Stop 2는 고속 클럭과
+ * 대부분의 주변장치를 멈춰 전류를 수 uA로 줄인다. 발사대 단계(발사 대기 아님)에서 처리할 일이
+ * 없으면 pad_hold_idle이 Stop 2로 재우고, 그 밖에는 power_idle로 넘긴다.
+ *
+ * - 시간 유지: timebase 타이머(TIM2/TIM5)는 Stop 2에서 멈추므로 LSE 32.768 kHz로 도는 LPTIM1
+ *   카운터로 수면 시간을 재고, 깨면 timebase_skip으로 더한다. 나머지 분수 틱은 누적해 장시간
+ *   대기에도 시간축이 밀리지 않는다.
+ * - 깨우기 원천:
+ *   - IMU FIFO 워터마크 EXTI: 깨우면 평소 경로(imu_driver_start_dma_burst)로 버스트를 읽고
+ *     융합 스케줄러가 버스트 전체를 발사대 단계 감소 주기로 처리한다. 발사대에서는 워터마크를
+ *     크게 잡아 깨는 횟수를 줄인다. EXTI 인터럽트는 시간축 보정 뒤에 처리되므로 타임스탬프가
+ *     맞다 (입력 캡처 타임스탬프는 타이머가 멈춰 있어 쓸 수 없음).
+ *   - LPUART(GNSS) 시작 비트: 깨면 gnss_hold_ms 동안은 WFI만 써서 DMA가 나머지 프레임을 받게 한다.
+ *   - LPTIM 비교 일치: max_sleep_ms마다 한 번 깨어 텔레메트리/기록 같은 주기 작업을 돌린다
+ *     (16비트 카운터 한 바퀴 2 s 안쪽이어야 함).
+ * - 발사 판정: 발사 조건이 충족되기 시작하면(launch_pending) 그 사이클부터 Stop 2를 쓰지 않고,
+ *   power_update가 전체 클럭으로 올린다.
+ *
+ * 연결 예 (CubeMX: LPTIM1 클럭 LSE, LPUART1 커널 클럭 HSI16 + RX DMA 순환, IMU INT EXTI):
+ * - 초기화: pad_hold_init(&hold, &pm, &hlptim1, &hlpuart1, &phase, NULL)
+ * - 주 루프: power_update(&pm, &phase) 후 pad_hold_idle(&hold)
+ * - LPTIM1_IRQHandler: pad_hold_handle_lptim(&hold)
+ * - power 설정 clock_changed: timebase_retune()
+ */
+
+#ifndef PAD_HOLD_H
+#define PAD_HOLD_H
+
+#include "sys/board_profile.h"
+#include "stm32l4xx_hal.h"
+#include "sys/power.h"
+#include "nav/flight_phase.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !BOARD_HAS_PAD_HOLD
+#error "sys/pad_hold.h requires BOARD_HAS_PAD_HOLD (sys/board_profile.h)"
+#endif
+
+/**
+ * @brief LPTIM 카운터 클럭 (LSE, Hz)
+ */
+#define PAD_HOLD_LPTIM_HZ 32768u
+
+/**
+ * @brief 기본 설정
+ */
+#define PAD_HOLD_DEFAULT_MAX_SLEEP_MS 1000u  /**< 최대 수면 (ms, 주기 작업 간격) */
+#define PAD_HOLD_DEFAULT_GNSS_HOLD_MS 50u    /**< GNSS 깨우기 뒤 WFI만 쓰는 시간 (ms) */
+
+/**
+ * @brief 최대 수면 한계 (ms, 16비트 LPTIM 한 바퀴 안쪽)
+ */
+#define PAD_HOLD_MAX_SLEEP_LIMIT_MS 1900u
+
+/**
+ * @brief 설정
+ */
+typedef struct {
+    uint32_t max_sleep_ms;     /**< 최대 수면 (ms, PAD_HOLD_MAX_SLEEP_LIMIT_MS 이하) */
+    uint32_t gnss_hold_ms;     /**< GNSS 깨우기 뒤 WFI만 쓰는 시간 (ms) */
+} PadHoldConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t stops;            /**< Stop 2 수면 수 */
+    uint32_t idles;            /**< WFI로 넘긴 수 */
+    uint32_t lptim_wakeups;    /**< LPTIM 비교 일치로 깬 수 */
+    uint32_t gnss_wakeups;     /**< LPUART로 깬 수 */
+    uint64_t slept_us;         /**< Stop 2로 잔 시간 합 (us) */
+} PadHoldStats;
+
+/**
+ * @brief 발사대 저전력 모드
+ */
+typedef struct {
+    PowerManager *pm;              /**< 전력 관리자 */
+    LPTIM_HandleTypeDef *hlptim;   /**< LSE 기반 LPTIM (Stop 2에서 동작) */
+    UART_HandleTypeDef *gnss;      /**< GNSS LPUART (NULL이면 GNSS 깨우기 없음) */
+    const FlightPhaseMachine *phase; /**< 비행 단계 */
+    PadHoldConfig config;          /**< 설정 */
+
+    uint16_t sleep_start;          /**< 수면 시작 LPTIM 카운트 */
+    uint64_t sleep_start_us;       /**< 수면 시작 시각 (timebase, us) */
+    uint32_t frac;                 /**< 수면 시간 분수 나머지 (1/512 us 단위) */
+    uint32_t gnss_until_us;        /**< 이 시각까지 WFI만 사용 (us) */
+    bool gnss_hold;                /**< GNSS 수신 대기 중 */
+
+    PadHoldStats stats;            /**< 통계 */
+    bool initialized;              /**< 초기화 여부 */
+} PadHold;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool pad_hold_default_config(PadHoldConfig *config);
+
+/**
+ * @brief 초기화 (LPTIM 자유 증가 시작, LPUART Stop 모드 깨우기 설정)
+ *
+ * @param hold 저전력 모드
+ * @param pm 초기화된 전력 관리자 (now_us는 timebase_now_us)
+ * @param hlptim LSE 기반 LPTIM 핸들 (CubeMX 초기화, 정지 상태)
+ * @param gnss GNSS LPUART 핸들 (NULL 가능)
+ * @param phase 비행 단계 상태 기계
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool pad_hold_init(PadHold *hold, PowerManager *pm, LPTIM_HandleTypeDef *hlptim,
+                   UART_HandleTypeDef *gnss, const FlightPhaseMachine *phase, const PadHoldConfig *config);
+
+/**
+ * @brief 유휴 처리 (발사대 단계이면 Stop 2, 아니면 WFI)
+ *
+ * @param hold 저전력 모드
+ * @return bool 잤으면 true
+ */
+bool pad_hold_idle(PadHold *hold);
+
+/**
+ * @brief LPTIM 인터럽트 처리 (LPTIM1_IRQHandler)
+ *
+ * @param hold 저전력 모드
+ */
+void pad_hold_handle_lptim(PadHold *hold);
+
+/**
+ * @brief 통계
+ *
+ * @param hold 저전력 모드
+ * @return const PadHoldStats* 통계 (hold가 NULL이면 NULL)
+ */
+const PadHoldStats *pad_hold_get_stats(const PadHold *hold);
+
+#endif /* PAD_HOLD_H */
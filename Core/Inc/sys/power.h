@@ -0,0 +1,218 @@
+/**
+ * @file power.h
+ * @brief 비행 단계별 클럭/전압 범위 전환과 융합 사이클 사이 WFI 절전
+ *
+ * 필터는 IMU 주기의 일부만 80 MHz를 필요로 하므로, 처리할 일이 없을 때는 WFI로
+ * 코어를 재우고 다음 인터럽트(IMU 데이터 준비, SysTick 등)에 깨어난다.
+ * 발사대 대기처럼 부하가 낮은 단계에서는 저전력 단계(예: HSI16, 전압 범위 2)로,
+ * 추진/관성 비행/하강에서는 전체 단계(비행 클럭, 전압 범위 1)로 바꾼다.
+ *
+ * 전환 순서는 RM0351의 요구를 따른다.
+ * - 올림: 전압 범위 1 -> 발진기(PLL) 켜기 -> 시스템 클럭/대기 상태 설정
+ * - 내림: 시스템 클럭/대기 상태 설정 -> 발진기 설정(PLL 끄기) -> 전압 범위 2
+ * HAL_RCC_ClockConfig가 SysTick을 다시 맞추며, UART 보율처럼 버스 클럭에 묶인 설정은
+ * clock_changed 콜백에서 다시 계산한다.
+ *
+ * 저전력 단계의 처리 시간 비율이 한계를 넘으면 융합 마감을 지키기 위해 그 단계가
+ * 끝날 때까지 전체 단계로 고정한다. 발사 조건이 충족되기 시작하면(확정 전) 곧바로
+ * 올리므로 추진 초기 샘플도 전체 클럭에서 처리된다.
+ *
+ * 발사대 대기가 길면 WFI 대신 Stop 2로 재울 수 있다 (power_stop, 깨우기 원천과 시간축 보정은
+ * pad_hold.h). Stop 2에서 깨면 시스템 클럭이 HSI16/MSI로 돌아오므로 현재 단계 클럭을 다시
+ * 적용하고 clock_changed를 부른다.
+ *
+ * 단계별 활동/수면 시간은 시간 콜백으로 누적한다. 시간 콜백은 클럭 전환의 영향을
+ * 받지 않는 타이머(예: LSE 기반 LPTIM)이거나 clock_changed에서 다시 맞춰야 한다
+ * (timebase_now_us를 쓰면 clock_changed에서 timebase_retune 호출).
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32l4xx_hal.h"
+#include "nav/flight_phase.h"
+#include "sys/profile.h"
+
+/**
+ * @brief 비행 단계 수 (FlightPhase 마지막 값 + 1)
+ */
+#define POWER_PHASE_COUNT (FLIGHT_PHASE_DESCENT + 1)
+
+/**
+ * @brief 기본 마감 보호 설정
+ */
+#define POWER_DEFAULT_DUTY_LIMIT 0.6f        /**< 저전력 단계 처리 시간 비율 한계 */
+#define POWER_DEFAULT_DUTY_WINDOW_US 1000000u /**< 비율 측정 구간 (us) */
+
+/**
+ * @brief 전력 단계
+ */
+typedef enum {
+    POWER_LEVEL_LOW = 0,   /**< 저전력 (낮은 클럭, 전압 범위 2) */
+    POWER_LEVEL_FULL = 1,  /**< 전체 (비행 클럭, 전압 범위 1) */
+    POWER_LEVEL_COUNT = 2  /**< 단계 수 */
+} PowerLevel;
+
+/**
+ * @brief 전력 단계 하나의 클럭 설정 (SystemClock_Config와 같은 HAL 구조체)
+ */
+typedef struct {
+    RCC_OscInitTypeDef osc;    /**< 발진기 설정 (PLL 켜기/끄기 포함) */
+    RCC_ClkInitTypeDef clk;    /**< 시스템/버스 클럭 설정 */
+    uint32_t flash_latency;    /**< 플래시 대기 상태 (FLASH_LATENCY_x) */
+    uint32_t voltage_scale;    /**< 전압 범위 (PWR_REGULATOR_VOLTAGE_SCALEx) */
+} PowerClockConfig;
+
+/**
+ * @brief 시간 측정 콜백 (us, 자유 증가 카운터)
+ */
+typedef uint32_t (*PowerClockFn)(void);
+
+/**
+ * @brief 처리할 일이 남았는지 확인하는 콜백 (인터럽트가 막힌 상태에서 호출)
+ */
+typedef bool (*PowerWorkFn)(void *context);
+
+/**
+ * @brief 클럭 전환 완료 콜백 (버스 클럭에 묶인 주변 장치 재설정)
+ *
+ * @param hclk_hz 새 HCLK (Hz)
+ * @param context 사용자 문맥
+ */
+typedef void (*PowerClockChangedFn)(uint32_t hclk_hz, void *context);
+
+/**
+ * @brief 전력 관리 설정
+ */
+typedef struct {
+    PowerClockConfig level[POWER_LEVEL_COUNT]; /**< 단계별 클럭 설정 */
+    PowerLevel phase_level[POWER_PHASE_COUNT]; /**< 비행 단계별 전력 단계 */
+    float duty_limit;              /**< 저전력 단계 처리 시간 비율 한계 (0이면 보호 없음) */
+    uint32_t duty_window_us;       /**< 비율 측정 구간 (us) */
+    PowerClockFn now_us;           /**< 시간 콜백 */
+    PowerWorkFn has_work;          /**< 일 확인 콜백 (NULL이면 항상 없음) */
+    PowerClockChangedFn clock_changed; /**< 클럭 전환 콜백 (NULL 가능) */
+    void *context;                 /**< 콜백 문맥 */
+} PowerConfig;
+
+/**
+ * @brief 단계별 통계
+ */
+typedef struct {
+    uint64_t active_us;        /**< 깨어 있던 시간 (us) */
+    uint64_t sleep_us;         /**< WFI로 잔 시간 (us) */
+    uint32_t wakeups;          /**< WFI/Stop 2에서 깨어난 횟수 */
+    uint32_t stops;            /**< Stop 2로 잔 횟수 */
+    uint32_t guard_trips;      /**< 마감 보호로 전체 단계에 고정한 횟수 */
+} PowerPhaseStats;
+
+/**
+ * @brief Stop 2 수면 훅 (인터럽트가 막힌 상태에서 호출)
+ */
+typedef struct {
+    bool (*prepare)(void *context); /**< 깨우기 원천 설정 (false면 수면 취소) */
+    void (*resume)(void *context);  /**< 클럭 복구 뒤 시간축 보정 (now_us가 수면 시간을 포함하도록) */
+    void *context;                  /**< 훅 문맥 */
+} PowerStopHooks;
+
+/**
+ * @brief 전력 관리자
+ */
+typedef struct {
+    PowerConfig config;
+    PowerLevel level;          /**< 현재 전력 단계 */
+    FlightPhase phase;         /**< 현재 비행 단계 */
+    bool boosted;              /**< 마감 보호 또는 발사 대기로 전체 단계 고정 */
+    uint32_t mark_us;          /**< 마지막 계측 시각 */
+
+    uint32_t window_start_us;  /**< 비율 측정 구간 시작 */
+    uint32_t window_active_us; /**< 구간 내 깨어 있던 시간 */
+
+    PowerPhaseStats stats[POWER_PHASE_COUNT];
+    uint32_t level_changes;    /**< 클럭 전환 횟수 */
+    uint32_t clock_failures;   /**< HAL 전환 실패 횟수 */
+} PowerManager;
+
+/**
+ * @brief 기본 설정 (저전력: HSI16/전압 범위 2, 단계 배정: 발사대만 저전력)
+ *
+ * 전체 단계 클럭 설정은 비행 빌드의 SystemClock_Config와 같아야 하므로
+ * 호출자가 level[POWER_LEVEL_FULL]을 채운다.
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool power_default_config(PowerConfig *config);
+
+/**
+ * @brief 전력 관리자 초기화 (현재 클럭은 전체 단계로 간주)
+ *
+ * @param pm 전력 관리자
+ * @param config 설정 (now_us 필수)
+ * @return bool 성공 여부
+ */
+bool power_init(PowerManager *pm, const PowerConfig *config);
+
+/**
+ * @brief 비행 단계 반영 (단계 전이 또는 발사 대기 시 전력 단계 전환)
+ *
+ * 융합 주기마다 호출한다.
+ *
+ * @param pm 전력 관리자
+ * @param fp 비행 단계 상태 기계
+ * @return bool 성공 여부 (클럭 전환 실패 시 false, 현재 단계 유지)
+ */
+bool power_update(PowerManager *pm, const FlightPhaseMachine *fp);
+
+/**
+ * @brief 처리할 일이 없으면 다음 인터럽트까지 WFI 대기
+ *
+ * 인터럽트를 막은 채 has_work를 확인한 뒤 WFI에 들어가므로, 확인과 수면 사이에
+ * 들어온 인터럽트도 놓치지 않는다 (대기 중인 인터럽트가 있으면 WFI는 곧바로 끝남).
+ *
+ * @param pm 전력 관리자
+ * @return bool 잤으면 true
+ */
+bool power_idle(PowerManager *pm);
+
+/**
+ * @brief 처리할 일이 없으면 다음 깨우기 원천까지 Stop 2 대기
+ *
+ * power_idle과 같이 인터럽트를 막은 채 has_work를 확인한다. SysTick을 멈추고 prepare 뒤 Stop 2에
+ * 들어가며, 깨어나면 현재 단계 클럭을 다시 적용하고 resume으로 시간축을 보정한 뒤 인터럽트를
+ * 되돌린다 (깨운 인터럽트는 그 뒤에 보정된 시각으로 처리됨).
+ *
+ * @param pm 전력 관리자
+ * @param hooks 수면 훅 (resume 필수)
+ * @return bool 잤으면 true
+ */
+bool power_stop(PowerManager *pm, const PowerStopHooks *hooks);
+
+/**
+ * @brief 현재 전력 단계
+ *
+ * @param pm 전력 관리자
+ * @return PowerLevel 전력 단계
+ */
+PowerLevel power_get_level(const PowerManager *pm);
+
+/**
+ * @brief 단계별 통계 조회
+ *
+ * @param pm 전력 관리자
+ * @param phase 비행 단계
+ * @return const PowerPhaseStats* 통계 (범위 밖이면 NULL)
+ */
+const PowerPhaseStats *power_get_stats(const PowerManager *pm, FlightPhase phase);
+
+/**
+ * @brief 단계별 활동 비율을 한 줄씩 출력
+ *
+ * @param pm 전력 관리자
+ * @param write 출력 콜백
+ */
+void power_report(const PowerManager *pm, ProfileWriteFn write);
+
+#endif /* POWER_H */
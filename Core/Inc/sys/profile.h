@@ -0,0 +1,121 @@
+/**
+ * @file profile.h
+ * @brief DWT 사이클 카운터 기반 단계별 실행 시간 측정
+ *
+ * Cortex-M4 DWT->CYCCNT로 EKF 각 단계의 실행 사이클을 측정하고,
+ * 단계별 최소/최대/평균 사이클을 정적 테이블에 기록한다.
+ *
+ * PROFILE_ENABLE 미정의 시 PROFILE_BEGIN/PROFILE_END 매크로와 모든 API는
+ * 빈 코드로 컴파일되므로, 계측 지점을 코드에 그대로 남겨 둘 수 있다.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 사이클 측정 활성화
+ *
+ * 빌드 설정에서 정의한다. 정의 시 stm32l4xx.h(core_cm4.h)의 DWT 레지스터를 사용한다.
+ */
+/* #define PROFILE_ENABLE */
+
+/**
+ * @brief 측정 단계 정의
+ */
+typedef enum {
+    PROFILE_STAGE_PREDICT = 0,          /**< ekf_predict 전체 */
+    PROFILE_STAGE_JACOBIAN,             /**< 상태 전이 자코비안 계산 */
+    PROFILE_STAGE_PROPAGATION,          /**< 공분산 전파 (F * P * F^T + Q) */
+    PROFILE_STAGE_GAIN,                 /**< 칼만 게인 계산 (PH^T, S, K) */
+    PROFILE_STAGE_INVERSE,              /**< 혁신 공분산 S 역행렬 (일괄 갱신) */
+    PROFILE_STAGE_STATE_UPDATE,         /**< 상태 갱신 (x = x + K * y) */
+    PROFILE_STAGE_COVARIANCE_UPDATE,    /**< 공분산 갱신 (P = P - K * H * P) */
+    PROFILE_STAGE_COUNT                 /**< 단계 수 */
+} ProfileStage;
+
+/**
+ * @brief 단계별 측정 결과
+ */
+typedef struct {
+    const char *name;       /**< 단계 이름 */
+    uint32_t count;         /**< 측정 횟수 */
+    uint32_t min_cycles;    /**< 최소 사이클 */
+    uint32_t max_cycles;    /**< 최대 사이클 */
+    uint64_t total_cycles;  /**< 누적 사이클 (평균 = total_cycles / count) */
+} ProfileEntry;
+
+/**
+ * @brief 측정 결과 출력 콜백 (예: 디버그 UART 송신)
+ *
+ * @param line 널 종료 문자열 한 줄 ("\r\n" 포함)
+ */
+typedef void (*ProfileWriteFn)(const char *line);
+
+#ifdef PROFILE_ENABLE
+
+#include "stm32l4xx.h"
+
+/**
+ * @brief 측정 시작 (현재 블록에 시작 사이클 변수 선언)
+ */
+#define PROFILE_BEGIN(stage) \
+    uint32_t profile_start_##stage = DWT->CYCCNT
+
+/**
+ * @brief 측정 종료 및 기록
+ */
+#define PROFILE_END(stage) \
+    profile_record((stage), DWT->CYCCNT - profile_start_##stage)
+
+/**
+ * @brief DWT 사이클 카운터 활성화 및 측정 테이블 초기화
+ */
+void profile_init(void);
+
+/**
+ * @brief 측정 테이블 초기화 (DWT 설정은 유지)
+ */
+void profile_reset(void);
+
+/**
+ * @brief 단계 측정값 기록
+ *
+ * 인터럽트와 메인 루프에서 동시에 같은 단계를 기록하지 않아야 한다.
+ *
+ * @param stage 측정 단계
+ * @param cycles 측정 사이클
+ */
+void profile_record(ProfileStage stage, uint32_t cycles);
+
+/**
+ * @brief 단계 측정 결과 조회
+ *
+ * @param stage 측정 단계
+ * @return const ProfileEntry* 측정 결과 (범위 밖이면 NULL)
+ */
+const ProfileEntry *profile_get(ProfileStage stage);
+
+/**
+ * @brief 전체 측정 결과를 한 줄씩 출력
+ *
+ * @param write 출력 콜백
+ */
+void profile_report(ProfileWriteFn write);
+
+#else /* PROFILE_ENABLE */
+
+#define PROFILE_BEGIN(stage) do { } while (0)
+#define PROFILE_END(stage) do { } while (0)
+
+static inline void profile_init(void) { }
+static inline void profile_reset(void) { }
+static inline void profile_record(ProfileStage stage, uint32_t cycles) { (void)stage; (void)cycles; }
+static inline const ProfileEntry *profile_get(ProfileStage stage) { (void)stage; return 0; }
+static inline void profile_report(ProfileWriteFn write) { (void)write; }
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* PROFILE_H */
@@ -0,0 +1,156 @@
+/**
+ * @file rtos_tasks.h
+ * @brief FreeRTOS 통합 계층 (정적 할당 융합/기록/텔레메트리 태스크)
+ *
+ * 라이브러리 함수들(fusion_scheduler, flash_log, telemetry)을 우선순위가 다른 세 태스크로
+ * 묶는다. 모든 태스크, 스택, TCB는 정적으로 할당하며(xTaskCreateStatic) 힙을 쓰지 않는다.
+ *
+ * - 융합 태스크 (RTOS_FUSION_PRIORITY, 가장 높음): IMU DMA 완료 인터럽트가
+ *   rtos_tasks_notify_imu_from_isr로 직접 태스크 알림(vTaskNotifyGiveFromISR)을 주면 깨어나
+ *   측정 대기열을 비우고(meas_queue.h, 설정 시) fusion_scheduler_run을 한 번 돌린다.
+ *   대기열/세마포어 없이 알림 값 하나만 쓰므로 깨우는 비용이 가장 작다. 알림이
+ *   RTOS_FUSION_TIMEOUT_MS 안에 오지 않으면 IMU 정지로 보고 timeouts를 센다.
+ *   사이클 뒤 post_cycle 콜백에서 레코드를 쓰고(flash_log_* 는 이 문맥 전용), 기록 태스크를 깨운다.
+ * - 기록 태스크 (RTOS_LOG_PRIORITY): 융합 태스크 알림 또는 RTOS_LOG_PERIOD_MS마다
+ *   flash_log_service를 호출한다. 섹터 기록/지우기는 DMA와 완료 인터럽트로 진행되므로 이
+ *   태스크는 짧게 끝나며, 예측보다 낮은 우선순위이므로 예측을 늦추지 않는다.
+ * - 텔레메트리 태스크 (RTOS_TELEMETRY_PRIORITY, 가장 낮음): RTOS_TELEMETRY_PERIOD_MS마다
+ *   (vTaskDelayUntil) telemetry_service를 호출한다.
+ *
+ * 스택 크기(워드)는 비행 빌드에서 uxTaskGetStackHighWaterMark로 잰 최대 사용량에
+ * 여유를 더해 정한다. rtos_tasks_get_stats의 stack_free로 비행 기록/지상 시험에서 다시
+ * 확인하고 빌드 설정에서 덮어쓴다. 융합 태스크는 EKF 작업 메모리를 스크래치 영역(scratch.h)에서
+ * 받으므로 스택에는 호출 깊이만큼만 쓴다.
+ *
+ * FreeRTOSConfig.h 요구 사항: configSUPPORT_STATIC_ALLOCATION 1, configUSE_TASK_NOTIFICATIONS 1,
+ * INCLUDE_uxTaskGetStackHighWaterMark 1, INCLUDE_vTaskDelayUntil 1. IMU 인터럽트 우선순위는
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY 이하(숫자로 같거나 큼)여야 FromISR API를 쓸 수 있다.
+ * stm32l4xx_hal_conf.h의 USE_RTOS는 0으로 두며(HAL 잠금 미사용), HAL 시간 기준은 SysTick 대신
+ * 다른 타이머로 옮긴다.
+ *
+ * 빌드 설정에서 RTOS_ENABLE을 정의하지 않으면 모든 API는 빈 코드로 컴파일된다.
+ */
+
+#ifndef RTOS_TASKS_H
+#define RTOS_TASKS_H
+
+#include "nav/fusion_scheduler.h"
+#include "sensors/meas_queue.h"
+#include "sensors/baro_altitude.h"
+#include "log/flash_log.h"
+#include "log/telemetry.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief RTOS 통합 활성화
+ *
+ * 빌드 설정에서 정의한다. 정의 시 FreeRTOS 커널(FreeRTOS.h, task.h)이 필요하다.
+ */
+/* #define RTOS_ENABLE */
+
+/**
+ * @brief 태스크 스택 크기 (워드, 측정한 최대 사용량 + 여유로 빌드 설정에서 덮어씀)
+ */
+#ifndef RTOS_FUSION_STACK_WORDS
+#define RTOS_FUSION_STACK_WORDS 768u
+#endif
+#ifndef RTOS_LOG_STACK_WORDS
+#define RTOS_LOG_STACK_WORDS 256u
+#endif
+#ifndef RTOS_TELEMETRY_STACK_WORDS
+#define RTOS_TELEMETRY_STACK_WORDS 384u
+#endif
+
+/**
+ * @brief 태스크 우선순위 (높을수록 먼저, configMAX_PRIORITIES 미만)
+ */
+#ifndef RTOS_FUSION_PRIORITY
+#define RTOS_FUSION_PRIORITY 4u
+#endif
+#ifndef RTOS_LOG_PRIORITY
+#define RTOS_LOG_PRIORITY 2u
+#endif
+#ifndef RTOS_TELEMETRY_PRIORITY
+#define RTOS_TELEMETRY_PRIORITY 1u
+#endif
+
+/**
+ * @brief 주기 기본값
+ */
+#define RTOS_FUSION_TIMEOUT_MS 20u      /**< IMU 알림 대기 한계 (ms, 넘으면 IMU 정지로 셈) */
+#define RTOS_LOG_PERIOD_MS 10u          /**< 알림이 없을 때 기록 엔진 진행 주기 (ms) */
+#define RTOS_TELEMETRY_PERIOD_MS 10u    /**< 텔레메트리 서비스 주기 (ms, 프레임 주기보다 짧게) */
+
+/**
+ * @brief 융합 사이클 뒤 콜백 (융합 태스크 문맥, 레코드 쓰기 등)
+ */
+typedef void (*RtosPostCycleFn)(void *context);
+
+/**
+ * @brief 태스크 설정
+ */
+typedef struct {
+    FusionScheduler *sched;    /**< 초기화된 융합 스케줄러 */
+    MeasQueue *queue;          /**< 다중 생산자 측정 대기열 (NULL이면 스케줄러 push를 직접 사용) */
+    BaroAltitude *baro;        /**< 대기열 기압 메시지 변환기 (NULL 가능) */
+    RtosPostCycleFn post_cycle; /**< 융합 사이클 뒤 콜백 (NULL 가능) */
+    void *post_cycle_context;  /**< 콜백 문맥 */
+    FlashLog *log;             /**< 비행 기록기 (NULL이면 기록 태스크를 만들지 않음) */
+    Telemetry *telemetry;      /**< 텔레메트리 (NULL이면 텔레메트리 태스크를 만들지 않음) */
+    FusionClockFn clock;       /**< 시간 측정 콜백 (텔레메트리 now_us) */
+} RtosTasksConfig;
+
+/**
+ * @brief 태스크 통계
+ */
+typedef struct {
+    uint32_t fusion_cycles;    /**< 융합 사이클 수 */
+    uint32_t fusion_timeouts;  /**< IMU 알림 대기 시간 초과 수 */
+    uint32_t log_services;     /**< 기록 엔진 진행 호출 수 */
+    uint32_t telemetry_services; /**< 텔레메트리 서비스 호출 수 */
+    uint32_t fusion_stack_free; /**< 융합 태스크 최소 여유 스택 (워드) */
+    uint32_t log_stack_free;   /**< 기록 태스크 최소 여유 스택 (워드, 태스크 없으면 0) */
+    uint32_t telemetry_stack_free; /**< 텔레메트리 태스크 최소 여유 스택 (워드, 태스크 없으면 0) */
+} RtosTaskStats;
+
+#ifdef RTOS_ENABLE
+
+/**
+ * @brief 태스크 생성 (vTaskStartScheduler 전에 한 번 호출)
+ *
+ * @param config 설정 (sched, clock 필수, 포인터 필드는 태스크 수명 동안 유효해야 함)
+ * @return bool 성공 여부 (이미 시작했거나 설정이 잘못되면 false)
+ */
+bool rtos_tasks_start(const RtosTasksConfig *config);
+
+/**
+ * @brief IMU 샘플 도착 알림 (IMU DMA 완료 인터럽트에서 링/대기열에 넣은 뒤 호출)
+ *
+ * 융합 태스크가 더 높은 우선순위이면 인터럽트 복귀 시 바로 전환한다.
+ */
+void rtos_tasks_notify_imu_from_isr(void);
+
+/**
+ * @brief 기록 태스크 깨우기 (태스크 문맥)
+ */
+void rtos_tasks_notify_log(void);
+
+/**
+ * @brief 태스크 통계 (스택 여유는 호출 시점에 조회)
+ *
+ * @param stats 통계 저장 위치
+ * @return bool 성공 여부 (시작 전이면 false)
+ */
+bool rtos_tasks_get_stats(RtosTaskStats *stats);
+
+#else /* RTOS_ENABLE */
+
+static inline bool rtos_tasks_start(const RtosTasksConfig *config) { (void)config; return false; }
+static inline void rtos_tasks_notify_imu_from_isr(void) {}
+static inline void rtos_tasks_notify_log(void) {}
+static inline bool rtos_tasks_get_stats(RtosTaskStats *stats) { (void)stats; return false; }
+
+#endif /* RTOS_ENABLE */
+
+#endif /* RTOS_TASKS_H */
@@ -0,0 +1,74 @@
+/**
+ * @file scratch.h
+ * @brief 정적 스크래치 메모리 영역 (스택형 할당/해제)
+ *
+ * 컴파일 시 크기가 정해진 정적 버퍼에서 일시적인 작업 메모리를 할당한다.
+ * 해제는 mark/release 쌍으로 한 번에 되돌리며, 개별 해제는 없다.
+ * 최대 사용량(high water)을 기록하므로 실측으로 버퍼 크기를 검증할 수 있다.
+ *
+ * 단일 태스크 전용이다 (인터럽트나 다른 태스크와 공유하지 않는다).
+ */
+
+#ifndef SCRATCH_H
+#define SCRATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 할당 정렬 단위 (바이트)
+ */
+#define SCRATCH_ALIGN 8u
+
+/**
+ * @brief 할당 n회의 정렬 여유 (바이트)
+ */
+#define SCRATCH_ALIGN_SLACK(n) ((n) * (SCRATCH_ALIGN - 1u))
+
+/**
+ * @brief 스크래치 영역
+ */
+typedef struct {
+    uint8_t *base;       /**< 버퍼 시작 (SCRATCH_ALIGN 정렬) */
+    uint32_t size;       /**< 버퍼 크기 (바이트) */
+    uint32_t used;       /**< 현재 사용량 (바이트) */
+    uint32_t high_water; /**< 최대 사용량 (바이트) */
+    uint32_t failures;   /**< 용량 부족으로 실패한 할당 수 */
+} ScratchArena;
+
+/**
+ * @brief 스크래치 영역 초기화
+ *
+ * @param arena 스크래치 영역 포인터
+ * @param buffer 정적 버퍼 (SCRATCH_ALIGN 정렬이어야 함)
+ * @param size 버퍼 크기 (바이트)
+ * @return bool 성공 여부
+ */
+bool scratch_init(ScratchArena *arena, void *buffer, uint32_t size);
+
+/**
+ * @brief 작업 메모리 할당
+ *
+ * @param arena 스크래치 영역 포인터
+ * @param size 할당 크기 (바이트)
+ * @return void* 할당된 메모리 (SCRATCH_ALIGN 정렬, 용량 부족 시 NULL)
+ */
+void *scratch_alloc(ScratchArena *arena, uint32_t size);
+
+/**
+ * @brief 현재 사용 위치 기록
+ *
+ * @param arena 스크래치 영역 포인터
+ * @return uint32_t 사용 위치 (scratch_release에 전달)
+ */
+uint32_t scratch_mark(const ScratchArena *arena);
+
+/**
+ * @brief 기록한 위치 이후의 할당을 모두 해제
+ *
+ * @param arena 스크래치 영역 포인터
+ * @param mark scratch_mark로 얻은 위치
+ */
+void scratch_release(ScratchArena *arena, uint32_t mark);
+
+#endif /* SCRATCH_H */
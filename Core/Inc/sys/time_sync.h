@@ -0,0 +1,180 @@
+/**
+ * @file time_sync.h
+ * @brief GNSS 시간 펄스(PPS)로 로컬 us 시간축과 GNSS 시각을 잇는 시각 동기
+ *
+ * 센서 타임스탬프는 로컬 발진기 기준이고 GNSS 해의 시각(iTOW)은 GNSS 시각이다.
+ * 발진기 주파수 오차(수십 ppm)만큼 둘이 벌어지므로, 시간 펄스 직후의 수신 시각에
+ * iTOW의 초 미만 부분을 더하는 방식(ubx_gnss)은 초 안에서 최대 수십 us, 펄스가
+ * 빠지면 초 단위로 어긋나며, ekf_update_gps 혁신 오차로 보인다.
+ *
+ * - 시간 펄스를 timebase 입력 캡처 채널에 연결하면 상승 에지(GNSS 정수 초)의 로컬
+ *   시각이 하드웨어로 잡힌다. 펄스마다 정수 초 라벨을 붙여 (로컬 - GNSS) 편차를
+ *   측정으로 쓰는 2상태(편차 us, 주파수 오차 ppm) 칼만 필터로 추정한다.
+ * - 라벨: 고정 전에는 가장 최근 NAV-PVT의 iTOW와 수신 시각으로(ubx_gnss와 같은
+ *   규칙), 고정 후에는 필터 예측 GNSS 시각의 반올림으로 정한다. 예측과의 차이가
+ *   gate_sigma x 혁신 표준 편차를 넘는 펄스는 버리고, 연속 TIME_SYNC_MAX_REJECTS번이면
+ *   다시 고정한다 (수신기 재시작, 시간축 클럭 전환).
+ * - 편차 상태는 마지막 펄스 기준의 작은 값으로 유지하므로(기준점 이동) 단정밀도로
+ *   충분하다. 주 경계(iTOW 순환)는 반 주 이내 차이로 감는다.
+ * - 변환: time_sync_gnss_to_local로 NAV-PVT 시각을 로컬 us로 바꾸면 지연 융합
+ *   (ekf_delay, fusion_scheduler_push_gps)이 상태 이력의 정확한 시각에 갱신한다.
+ *
+ * 연결 예:
+ * - 초기화: time_sync_init(&sync, NULL), timebase_attach_capture(TIM_CHANNEL_2, pps_capture, &sync)
+ * - 캡처 콜백 pps_capture: time_sync_handle_pulse(&sync, timestamp_us) 와
+ *   ubx_gnss_handle_timepulse(&gnss, (uint32_t)timestamp_us)
+ * - 융합 태스크에서 새 해마다: time_sync_handle_fix(&sync, fix.itow_ms, fix.timestamp_us) 후
+ *   time_sync_gnss_to_local(&sync, fix.itow_ms, &fix.timestamp_us)가 성공하면 그 시각으로 push
+ *
+ * time_sync_handle_pulse는 인터럽트 문맥에서, 나머지는 융합 태스크 한 곳에서 호출한다.
+ */
+
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 연속 거부 한도 (넘으면 다시 고정)
+ */
+#define TIME_SYNC_MAX_REJECTS 3u
+
+/**
+ * @brief 펄스 간격 한도 (초, 넘으면 다시 고정)
+ */
+#define TIME_SYNC_MAX_GAP_S 60u
+
+/**
+ * @brief 반 주 (ms, iTOW 순환 처리)
+ */
+#define TIME_SYNC_HALF_WEEK_MS 302400000
+
+/**
+ * @brief 기본 설정
+ */
+#define TIME_SYNC_DEFAULT_PULSE_STD_US 0.5f    /**< 펄스 캡처 표준 편차 (us, 1 us 양자화 + 지터) */
+#define TIME_SYNC_DEFAULT_DRIFT_STD_PPM 100.0f /**< 초기 주파수 오차 표준 편차 (ppm, HSE 수정) */
+#define TIME_SYNC_DEFAULT_DRIFT_RW 0.01f       /**< 주파수 랜덤 워크 (ppm/sqrt(s), 온도 변화) */
+#define TIME_SYNC_DEFAULT_GATE_SIGMA 5.0f      /**< 펄스 거부 문턱 (혁신 표준 편차 배수) */
+#define TIME_SYNC_DEFAULT_LOCK_STD_US 2.0f     /**< 고정 판정 편차 표준 편차 (us) */
+
+/**
+ * @brief 동기 설정
+ */
+typedef struct {
+    float pulse_std_us;        /**< 펄스 캡처 표준 편차 (us) */
+    float drift_std_ppm;       /**< 초기 주파수 오차 표준 편차 (ppm) */
+    float drift_rw;            /**< 주파수 랜덤 워크 (ppm/sqrt(s)) */
+    float gate_sigma;          /**< 펄스 거부 문턱 (혁신 표준 편차 배수) */
+    float lock_std_us;         /**< 고정 판정 편차 표준 편차 (us) */
+} TimeSyncConfig;
+
+/**
+ * @brief 통계
+ */
+typedef struct {
+    uint32_t pulses;           /**< 수신한 펄스 수 */
+    uint32_t updates;          /**< 필터에 반영한 펄스 수 */
+    uint32_t rejects;          /**< 거부한 펄스 수 */
+    uint32_t relocks;          /**< 다시 고정한 횟수 */
+    float last_residual_us;    /**< 마지막 혁신 (us) */
+} TimeSyncStats;
+
+/**
+ * @brief 시각 동기 상태
+ */
+typedef struct {
+    TimeSyncConfig config;
+
+    volatile uint64_t pulse_local_us; /**< 마지막 펄스 로컬 시각 (인터럽트 기록) */
+    volatile uint32_t pulse_count;    /**< 펄스 수 (인터럽트 기록) */
+    uint32_t processed_count;  /**< 처리한 펄스 수 */
+
+    bool has_hint;             /**< 라벨용 NAV-PVT 수신 여부 */
+    uint32_t hint_itow_ms;     /**< 마지막 NAV-PVT iTOW (ms) */
+    uint32_t hint_arrival_us;  /**< 마지막 NAV-PVT 수신 시각 (로컬 us) */
+
+    bool initialized;          /**< 첫 펄스 반영 여부 */
+    uint64_t anchor_local_us;  /**< 기준 펄스 로컬 시각 (us) */
+    uint32_t anchor_tow_s;     /**< 기준 펄스 GNSS 주 시각 (s) */
+    float offset_us;           /**< 기준점 대비 편차 (us, 로컬 - GNSS) */
+    float drift_ppm;           /**< 주파수 오차 (ppm, 로컬이 빠르면 양수) */
+    float P[2][2];             /**< 공분산 (us, ppm) */
+    uint32_t consecutive_rejects; /**< 연속 거부 수 */
+
+    TimeSyncStats stats;
+} TimeSync;
+
+/**
+ * @brief 기본 설정
+ *
+ * @param config 설정
+ * @return bool 성공 여부
+ */
+bool time_sync_default_config(TimeSyncConfig *config);
+
+/**
+ * @brief 동기 초기화 (첫 라벨 펄스 전까지 변환 불가)
+ *
+ * @param sync 동기 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @return bool 성공 여부
+ */
+bool time_sync_init(TimeSync *sync, const TimeSyncConfig *config);
+
+/**
+ * @brief 시간 펄스 캡처 처리 (인터럽트 문맥)
+ *
+ * @param sync 동기 상태
+ * @param timestamp_us 상승 에지 시각 (timebase 64비트 us)
+ */
+void time_sync_handle_pulse(TimeSync *sync, uint64_t timestamp_us);
+
+/**
+ * @brief NAV-PVT 수신 처리 (펄스 라벨 힌트 갱신과 새 펄스 반영)
+ *
+ * @param sync 동기 상태
+ * @param itow_ms 해의 GPS 주 시각 (ms)
+ * @param arrival_us 해 수신 시각 (로컬 us, 펄스 이후)
+ * @return bool 새 펄스를 필터에 반영했으면 true
+ */
+bool time_sync_handle_fix(TimeSync *sync, uint32_t itow_ms, uint32_t arrival_us);
+
+/**
+ * @brief 고정 여부 (편차 표준 편차가 lock_std_us 이하)
+ *
+ * @param sync 동기 상태
+ * @return bool 고정 여부
+ */
+bool time_sync_is_locked(const TimeSync *sync);
+
+/**
+ * @brief GNSS 주 시각 -> 로컬 시각
+ *
+ * @param sync 동기 상태
+ * @param itow_ms GPS 주 시각 (ms)
+ * @param local_us 결과 로컬 시각 (us, 32비트 샘플 시간축)
+ * @return bool 성공 여부 (고정 전이면 false, 결과 변경 없음)
+ */
+bool time_sync_gnss_to_local(const TimeSync *sync, uint32_t itow_ms, uint32_t *local_us);
+
+/**
+ * @brief 로컬 시각 -> GNSS 주 시각
+ *
+ * @param sync 동기 상태
+ * @param local_us 로컬 시각 (us, 기준 펄스에서 ±35분 이내)
+ * @param tow_us 결과 GPS 주 시각 (us, [0, 604800 s))
+ * @return bool 성공 여부 (고정 전이면 false, 결과 변경 없음)
+ */
+bool time_sync_local_to_gnss(const TimeSync *sync, uint32_t local_us, uint64_t *tow_us);
+
+/**
+ * @brief 통계 조회
+ *
+ * @param sync 동기 상태
+ * @return const TimeSyncStats* 통계
+ */
+const TimeSyncStats *time_sync_get_stats(const TimeSync *sync);
+
+#endif /* TIME_SYNC_H */
@@ -0,0 +1,138 @@
+/**
+ * @file timebase.h
+ * @brief 32비트 범용 타이머 기반 단조 증가 마이크로초 시간축과 데이터 준비 핀 입력 캡처
+ *
+ * TIM2 또는 TIM5(32비트 카운터)를 1 MHz로 자유 증가시키고, 갱신(넘침) 인터럽트마다
+ * 상위 32비트를 늘려 64비트 us 시간축을 만든다 (넘침 주기 약 71.6분).
+ * 센서 데이터 준비 핀(ICM-42688 INT1, GNSS TIMEPULSE 등)을 타이머 채널에 연결하면
+ * 에지 시각이 하드웨어로 CCR에 잡히므로, 인터럽트 지연과 무관한 측정 시각을 얻는다.
+ * 캡처 콜백이 그 시각을 드라이버에 넘기면 링/대기열의 모든 샘플이 캡처 시각을 갖는다.
+ *
+ * 하위 32비트(timebase_now_us)는 FusionClockFn/PowerClockFn 형식이며, 샘플 타임스탬프
+ * (uint32_t us)와 같은 시간축이다. 순환은 2^32 us마다이므로 기존 순환 안전 비교를 그대로 쓴다.
+ *
+ * 연결 예 (CubeMX: TIM5 채널을 입력 캡처 직접 모드로 설정, TIM5 전역 인터럽트 활성화):
+ * - 초기화: timebase_init(&htim5), timebase_attach_capture(TIM_CHANNEL_1, imu_drdy, &imu)
+ * - HAL_TIM_PeriodElapsedCallback: timebase_handle_period_elapsed(htim)
+ * - HAL_TIM_IC_CaptureCallback: timebase_handle_capture(htim)
+ * - 캡처 콜백 imu_drdy: imu_driver_start_dma_burst(imu, (uint32_t)timestamp_us)
+ * - 클럭 전환 후 (power.h clock_changed): timebase_retune()
+ *
+ * 모든 처리 함수는 인터럽트 문맥에서, 시각 읽기는 어느 문맥에서나 호출할 수 있다.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "stm32l4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 타이머 분해능 (Hz)
+ */
+#define TIMEBASE_TICK_HZ 1000000u
+
+/**
+ * @brief 입력 캡처 채널 수 (TIM2/TIM5 채널 1~4)
+ */
+#define TIMEBASE_CAPTURE_CHANNELS 4u
+
+/**
+ * @brief 캡처 콜백 (인터럽트 문맥)
+ *
+ * @param timestamp_us 에지 시각 (64비트 us)
+ * @param context 사용자 문맥
+ */
+typedef void (*TimebaseCaptureFn)(uint64_t timestamp_us, void *context);
+
+/**
+ * @brief 시간축 통계
+ */
+typedef struct {
+    uint32_t overflows;        /**< 카운터 넘침 수 */
+    uint32_t captures[TIMEBASE_CAPTURE_CHANNELS];     /**< 채널별 캡처 수 */
+    uint32_t overcaptures[TIMEBASE_CAPTURE_CHANNELS]; /**< 처리 전에 덮어쓴 캡처 수 (에지 손실) */
+    uint32_t retunes;          /**< 클럭 전환에 따른 분주비 재설정 수 */
+} TimebaseStats;
+
+/**
+ * @brief 시간축 초기화 및 시작
+ *
+ * CubeMX가 초기화한 타이머의 분주비를 현재 타이머 클럭에서 1 MHz가 되도록,
+ * 자동 재적재 값을 0xFFFFFFFF로 다시 쓰고 갱신 인터럽트와 함께 시작한다.
+ *
+ * @param htim 32비트 타이머 핸들 (TIM2 또는 TIM5)
+ * @return bool 성공 여부 (32비트 타이머가 아니거나 타이머 클럭이 1 MHz의 정수배가 아니면 false)
+ */
+bool timebase_init(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief 입력 캡처 채널 시작
+ *
+ * 채널 극성/필터는 CubeMX 설정을 따른다.
+ *
+ * @param channel TIM_CHANNEL_1 ~ TIM_CHANNEL_4
+ * @param callback 캡처 콜백 (NULL이면 채널 중지)
+ * @param context 콜백 문맥
+ * @return bool 성공 여부
+ */
+bool timebase_attach_capture(uint32_t channel, TimebaseCaptureFn callback, void *context);
+
+/**
+ * @brief 현재 시각 (64비트 us, 단조 증가)
+ *
+ * @return uint64_t 시각 (us, 초기화 전이면 0)
+ */
+uint64_t timebase_now_us64(void);
+
+/**
+ * @brief 현재 시각 하위 32비트 (us, FusionClockFn/PowerClockFn 형식)
+ *
+ * @return uint32_t 시각 (us)
+ */
+uint32_t timebase_now_us(void);
+
+/**
+ * @brief 시스템 클럭 전환 후 분주비 재설정 (단조성 유지)
+ *
+ * 현재 시각을 기준값으로 접은 뒤 카운터를 0부터 새 분주비로 다시 시작한다.
+ * 전환 중 1 us 미만의 오차가 생길 수 있다.
+ *
+ * @return bool 성공 여부 (새 타이머 클럭이 1 MHz의 정수배가 아니면 false, 이전 분주비 유지)
+ */
+bool timebase_retune(void);
+
+/**
+ * @brief 타이머가 멈춰 있던 시간 반영 (Stop 2 수면 뒤, 분주비도 다시 설정)
+ *
+ * 현재 시각에 elapsed_us를 더해 기준값으로 접고 카운터를 0부터 다시 시작한다.
+ * 수면 시간은 Stop 2에서도 도는 타이머(LPTIM)로 잰다 (pad_hold.h).
+ *
+ * @param elapsed_us 수면 시간 (us)
+ * @return bool 성공 여부 (새 타이머 클럭이 1 MHz의 정수배가 아니면 false, 시간은 반영됨)
+ */
+bool timebase_skip(uint64_t elapsed_us);
+
+/**
+ * @brief 갱신(넘침) 인터럽트 처리 (HAL_TIM_PeriodElapsedCallback)
+ *
+ * @param htim 인터럽트가 발생한 타이머 (다른 타이머면 무시)
+ */
+void timebase_handle_period_elapsed(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief 입력 캡처 인터럽트 처리 (HAL_TIM_IC_CaptureCallback)
+ *
+ * @param htim 인터럽트가 발생한 타이머 (다른 타이머면 무시)
+ */
+void timebase_handle_capture(TIM_HandleTypeDef *htim);
+
+/**
+ * @brief 통계 조회
+ *
+ * @return const TimebaseStats* 통계
+ */
+const TimebaseStats *timebase_get_stats(void);
+
+#endif /* TIMEBASE_H */
@@ -0,0 +1,178 @@
+/**
+ * @file trace.h
+ * @brief ITM/SWO 이벤트 트레이스 (단계별 시작/끝 표시, RAM 링 보관)
+ *
+ * sys/profile.h의 DWT 통계는 단계별 최소/최대/평균만 남기므로, 특정 마감 초과가 어떤
+ * 순서로 일어났는지는 볼 수 없다. 트레이스는 파이프라인 단계(IMU 인터럽트, 예측, 갱신별,
+ * 기록 엔진)의 시작/끝을 32비트 워드 하나로 남긴다.
+ *
+ * 워드 형식: [31:8] DWT->CYCCNT 하위 24비트, [7:1] 이벤트 번호(TraceEvent), [0] 1이면 끝.
+ * 24비트 시각은 80 MHz에서 약 210 ms마다 돌아오므로, 호스트 디코더(Tools/trace/trace_decode.c)는
+ * 이벤트 사이 간격이 그보다 짧다고 보고 시각을 이어 붙인다 (IMU 인터럽트가 1 kHz로 들어오면
+ * 항상 성립).
+ *
+ * 워드는 항상 RAM 링(TRACE_RING_SIZE 워드)에 쓰고, 디버거가 ITM 포트 TRACE_ITM_PORT를 켰으면
+ * SWO로도 내보낸다. ITM FIFO가 차 있으면 SWO 쪽 워드만 버리고 itm_dropped를 센다 (FIFO를 기다리지
+ * 않음). 이벤트 하나는 인터럽트를 막은 채 링 쓰기와 ITM 쓰기를 하며 약 15 사이클이다.
+ *
+ * 폴트 처리기에서 trace_freeze를 부르면 링이 멈춰 폴트 직전 이벤트가 남는다. 링은
+ * MEM_SECTION_RETAIN(sys/mem_section.h)에 두므로 유지 영역이 켜져 있으면 리셋 뒤에도
+ * 남으며, trace_init은 멈춘 링을 지우지 않는다. trace_dump로 꺼낸 뒤 trace_release로 다시 쓴다.
+ *
+ * TRACE_ENABLE 미정의 시 TRACE_BEGIN/TRACE_END 매크로와 모든 API는 빈 코드로 컴파일된다.
+ * ENERGY_ENABLE(sys/energy.h)이 정의되어 있으면 TRACE_ENABLE과 관계없이 같은 표시로
+ * 구간별 에너지를 잰다.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 이벤트 트레이스 활성화
+ *
+ * 빌드 설정에서 정의한다. 정의 시 stm32l4xx.h(core_cm4.h)의 DWT/ITM 레지스터를 사용한다.
+ */
+/* #define TRACE_ENABLE */
+
+/**
+ * @brief RAM 링 크기 (워드, 2의 거듭제곱, 4 KB)
+ */
+#define TRACE_RING_SIZE 1024u
+
+/**
+ * @brief ITM 자극 포트 번호 (0은 printf 리디렉션용으로 남김)
+ */
+#define TRACE_ITM_PORT 1u
+
+/**
+ * @brief 링 유효 표시 (활성/멈춤)
+ */
+#define TRACE_RING_MAGIC 0x52544C50u   /**< "PLTR" */
+#define TRACE_FROZEN_MAGIC 0x5A544C50u /**< "PLTZ" */
+
+/**
+ * @brief 이벤트 번호 (호스트 디코더 표와 순서 일치)
+ */
+typedef enum {
+    TRACE_EVENT_IMU_ISR = 0,       /**< IMU SPI DMA 완료 처리 */
+    TRACE_EVENT_CYCLE,             /**< 융합 사이클 전체 */
+    TRACE_EVENT_PREDICT,           /**< IMU 샘플 하나의 예측 */
+    TRACE_EVENT_UPDATE_GPS,        /**< GNSS 갱신 (FusionMeasType 순서) */
+    TRACE_EVENT_UPDATE_BARO,       /**< 기압계 갱신 */
+    TRACE_EVENT_UPDATE_MAG,        /**< 자력계 갱신 */
+    TRACE_EVENT_UPDATE_HEADING,    /**< 이중 안테나 GNSS 방위 갱신 */
+    TRACE_EVENT_UPDATE_COINCIDENT, /**< GNSS + 기압계 묶음 갱신 */
+    TRACE_EVENT_LOG_SERVICE,       /**< 기록 엔진 진행 (압축 포함) */
+    TRACE_EVENT_LOG_FLUSH,         /**< 블록 하나 저장 (CRC 시작부터 마지막 페이지 완료 인터럽트까지) */
+    TRACE_EVENT_COUNT              /**< 이벤트 수 (최대 128) */
+} TraceEvent;
+
+/**
+ * @brief 트레이스 링 (폴트 뒤 덤프용)
+ */
+typedef struct {
+    uint32_t magic;                  /**< TRACE_RING_MAGIC 또는 TRACE_FROZEN_MAGIC */
+    uint32_t head;                   /**< 다음 쓰기 위치 (누적, 링 번호는 하위 비트) */
+    uint32_t itm_dropped;            /**< ITM FIFO가 차서 SWO로 못 보낸 워드 수 */
+    uint32_t words[TRACE_RING_SIZE]; /**< 이벤트 워드 */
+} TraceRing;
+
+/**
+ * @brief 덤프 출력 콜백 (예: 디버그 UART 송신)
+ *
+ * @param line 널 종료 문자열 한 줄 ("\r\n" 포함)
+ */
+typedef void (*TraceWriteFn)(const char *line);
+
+/**
+ * @brief 에너지 측정 표시 (sys/energy.h, ENERGY_ENABLE 미정의 시 빈 코드)
+ */
+#ifdef ENERGY_ENABLE
+void energy_mark(uint32_t code);
+#define TRACE_ENERGY(code) energy_mark(code)
+#else
+#define TRACE_ENERGY(code) ((void)0)
+#endif
+
+#ifdef TRACE_ENABLE
+
+#include "stm32l4xx.h"
+
+extern TraceRing trace_ring;
+extern bool trace_itm;
+
+/**
+ * @brief 이벤트 워드 하나 기록 (어느 문맥에서나)
+ *
+ * @param code 이벤트 번호 << 1 | 끝 표시
+ */
+static inline void trace_emit(uint32_t code) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (trace_ring.magic == TRACE_RING_MAGIC) {
+        uint32_t word = (DWT->CYCCNT << 8) | code;
+        trace_ring.words[trace_ring.head++ & (TRACE_RING_SIZE - 1u)] = word;
+        if (trace_itm) {
+            // 포트를 읽어 0이면 FIFO가 찬 것
+            if (ITM->PORT[TRACE_ITM_PORT].u32 != 0) {
+                ITM->PORT[TRACE_ITM_PORT].u32 = word;
+            } else {
+                trace_ring.itm_dropped++;
+            }
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 단계 시작/끝 표시
+ */
+#define TRACE_BEGIN(event) do { trace_emit((uint32_t)(event) << 1); TRACE_ENERGY((uint32_t)(event) << 1); } while (0)
+#define TRACE_END(event) do { TRACE_ENERGY(((uint32_t)(event) << 1) | 1u); trace_emit(((uint32_t)(event) << 1) | 1u); } while (0)
+
+/**
+ * @brief DWT 사이클 카운터 활성화, ITM 포트 확인, 링 초기화 (멈춘 링은 그대로 둠)
+ */
+void trace_init(void);
+
+/**
+ * @brief 링 기록 멈춤 (폴트 처리기에서 호출, 이후 이벤트는 버림)
+ */
+void trace_freeze(void);
+
+/**
+ * @brief 링이 멈춰 있는지 (이전 폴트의 이벤트가 남아 있음)
+ *
+ * @return bool 멈춰 있으면 true
+ */
+bool trace_frozen(void);
+
+/**
+ * @brief 멈춘 링을 비우고 기록 재개
+ */
+void trace_release(void);
+
+/**
+ * @brief 링 내용을 오래된 것부터 한 줄씩 출력 ("trace" 머리 줄, 워드 8개씩 16진수 줄)
+ *
+ * @param write 출력 콜백
+ */
+void trace_dump(TraceWriteFn write);
+
+#else /* TRACE_ENABLE */
+
+#define TRACE_BEGIN(event) do { TRACE_ENERGY((uint32_t)(event) << 1); } while (0)
+#define TRACE_END(event) do { TRACE_ENERGY(((uint32_t)(event) << 1) | 1u); } while (0)
+
+static inline void trace_init(void) { }
+static inline void trace_freeze(void) { }
+static inline bool trace_frozen(void) { return false; }
+static inline void trace_release(void) { }
+static inline void trace_dump(TraceWriteFn write) { (void)write; }
+
+#endif /* TRACE_ENABLE */
+
+#endif /* TRACE_H */
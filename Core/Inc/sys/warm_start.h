@@ -0,0 +1,117 @@
+/**
+ * @file warm_start.h
+ * @brief 리셋 유지 SRAM2에 필터 스냅숏을 주기적으로 저장하고 재시작 시 복구
+ *
+ * 비행 중 저전압이나 워치독(IWDG) 리셋으로 다시 시작하면 ekf_init/ekf_reset의 기본
+ * 분산(위치 100 m^2 등)에서 수렴하는 데 수 초가 걸린다. 비행 중 수백 ms마다 상태,
+ * 공분산, 보정값(지구 자기장, 항력 계수, 자력계 경철/연철)을 CRC와 함께 저장해 두면,
+ * 재시작 직후 한 사이클 만에 리셋 직전 상태로 돌아갈 수 있다.
+ *
+ * - 저장소는 슬롯 두 개이며 더 오래된 슬롯에 번갈아 쓴다. 쓰는 도중 리셋되어도 다른
+ *   슬롯은 온전하므로, 복구는 CRC가 맞는 슬롯 중 시퀀스가 큰 쪽을 쓴다.
+ * - 저장소는 MEM_SECTION_RETAIN(sys/mem_section.h)으로 SRAM2 유지 영역에 둔다.
+ *   전원 투입 시에는 내용이 임의의 값이므로 CRC 검사에서 걸러진다. 유지 영역을 쓰지
+ *   않는 빌드에서는 .bss가 0으로 채워지므로 항상 냉간 시작이 된다.
+ * - 발사대에서의 리셋(리셋 핀 등)이 전 비행의 스냅숏을 되살리지 않도록, 비행 단계에서만
+ *   저장하고 착지 후나 발사대 초기화 때 warm_start_invalidate를 호출한다.
+ *   복구 여부는 저장된 비행 단계(phase)로 한 번 더 판단할 수 있다.
+ *
+ * 복구 순서: ekf_init -> 잡음/엔진 설정 -> warm_start_find -> warm_start_restore.
+ * warm_start_restore는 스냅숏 이후 지난 시간(gap_s, 저장 주기 + 부팅 시간 추정)만큼
+ * 위치를 속도로 외삽하고 공분산 대각에 Q x gap_s를 더한다.
+ */
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include "ekf/ekf.h"
+#include "sensors/mag_iron_cal.h"
+#include "sys/hw_crc.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 스냅숏 식별값과 형식 버전 (형식이 바뀌면 버전 증가)
+ */
+#define WARM_START_MAGIC 0x5753534Eu
+#define WARM_START_VERSION 1u
+
+/**
+ * @brief 저장 슬롯 수
+ */
+#define WARM_START_SLOTS 2
+
+/**
+ * @brief 필터 스냅숏 (CRC는 crc 앞까지 전체를 덮음)
+ */
+typedef struct {
+    uint32_t magic;            /**< WARM_START_MAGIC */
+    uint16_t version;          /**< WARM_START_VERSION */
+    uint16_t size;             /**< sizeof(WarmStartSnapshot) (상태 차원 변경 검출) */
+    uint32_t sequence;         /**< 저장 순번 (1부터) */
+    uint32_t timestamp_us;     /**< 저장 시각 (리셋 전 시간축) */
+
+    float x[EKF_STATE_DIM];    /**< 상태 벡터 */
+    float P[MATRIX_SYM_SIZE(EKF_STATE_DIM)]; /**< 공분산 (상삼각 압축) */
+    Vector3f earth_mag_ned;    /**< 지구 자기장 기준 */
+    float drag_k;              /**< 항력 계수 추정값 (1/m) */
+    MagIronCorrection mag;     /**< 자력계 보정값 */
+    uint8_t mag_valid;         /**< 자력계 보정값 유효 여부 */
+    uint8_t phase;             /**< 호출자 비행 단계 (FlightPhase) */
+    uint16_t reserved;         /**< 0 */
+
+    uint32_t crc;              /**< CRC-32 */
+} WarmStartSnapshot;
+
+/**
+ * @brief 스냅숏 저장소 (MEM_SECTION_RETAIN으로 배치)
+ */
+typedef struct {
+    WarmStartSnapshot slot[WARM_START_SLOTS];
+} WarmStartStore;
+
+/**
+ * @brief 스냅숏 저장
+ *
+ * 지연 전파 중인 공분산은 먼저 반영한다. 더 오래된(또는 무효인) 슬롯에 쓴다.
+ *
+ * @param store 저장소
+ * @param crc CRC 주변장치 (NULL이면 소프트웨어)
+ * @param ekf 필터 (초기화된 상태)
+ * @param timestamp_us 저장 시각
+ * @param mag_cal 자력계 보정 추정기 (NULL 가능)
+ * @param phase 비행 단계
+ * @return bool 성공 여부
+ */
+bool warm_start_save(WarmStartStore *store, HwCrc *crc, EKF *ekf, uint32_t timestamp_us,
+                     const MagIronCal *mag_cal, uint8_t phase);
+
+/**
+ * @brief 가장 최근의 유효한 스냅숏 검색
+ *
+ * @param store 저장소
+ * @param crc CRC 주변장치 (NULL이면 소프트웨어)
+ * @return const WarmStartSnapshot* 스냅숏 (없으면 NULL)
+ */
+const WarmStartSnapshot *warm_start_find(const WarmStartStore *store, HwCrc *crc);
+
+/**
+ * @brief 스냅숏으로 필터 복구 (ekf_init과 잡음/엔진 설정 뒤 호출)
+ *
+ * @param ekf 필터
+ * @param snap 스냅숏 (warm_start_find 결과)
+ * @param gap_s 스냅숏 이후 지난 시간 추정 (초, 0 이상)
+ * @param mag_cal 보정값을 되돌릴 자력계 추정기 (NULL 가능)
+ * @return bool 성공 여부 (상태가 유한하지 않으면 false, 필터는 바뀌지 않음)
+ */
+bool warm_start_restore(EKF *ekf, const WarmStartSnapshot *snap, float gap_s, MagIronCal *mag_cal);
+
+/**
+ * @brief 저장소 무효화 (착지 후, 발사대 초기화 시)
+ *
+ * @param store 저장소
+ * @return bool 성공 여부
+ */
+bool warm_start_invalidate(WarmStartStore *store);
+
+#endif /* WARM_START_H */
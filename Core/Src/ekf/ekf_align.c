@@ -0,0 +1,259 @@
+/**
+ * @file ekf_align.c
+ * @brief 개략 정렬, 자이로 나침반 보정, 방위 재설정 구현
+ */
+
+#include "ekf/ekf_align.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief 도 -> 라디안
+ */
+#define EKF_ALIGN_DEG_TO_RAD (FAST_MATH_PI / 180.0f)
+
+/**
+ * @brief 회전 행렬 -> 단위 사원수 (Shepperd, 가장 큰 성분 기준)
+ *
+ * @param R 회전 행렬 (몸체 -> NED)
+ * @return Quaternion 단위 사원수 (w >= 0)
+ */
+static Quaternion ekf_align_quaternion_from_matrix(const float R[3][3]) {
+    float tr = R[0][0] + R[1][1] + R[2][2];
+    Quaternion q;
+    if (tr > R[0][0] && tr > R[1][1] && tr > R[2][2]) {
+        float s = 2.0f * sqrtf(1.0f + tr);
+        q = quaternion_create(0.25f * s, (R[2][1] - R[1][2]) / s, (R[0][2] - R[2][0]) / s, (R[1][0] - R[0][1]) / s);
+    } else if (R[0][0] > R[1][1] && R[0][0] > R[2][2]) {
+        float s = 2.0f * sqrtf(1.0f + R[0][0] - R[1][1] - R[2][2]);
+        q = quaternion_create((R[2][1] - R[1][2]) / s, 0.25f * s, (R[0][1] + R[1][0]) / s, (R[0][2] + R[2][0]) / s);
+    } else if (R[1][1] > R[2][2]) {
+        float s = 2.0f * sqrtf(1.0f + R[1][1] - R[0][0] - R[2][2]);
+        q = quaternion_create((R[0][2] - R[2][0]) / s, (R[0][1] + R[1][0]) / s, 0.25f * s, (R[1][2] + R[2][1]) / s);
+    } else {
+        float s = 2.0f * sqrtf(1.0f + R[2][2] - R[0][0] - R[1][1]);
+        q = quaternion_create((R[1][0] - R[0][1]) / s, (R[0][2] + R[2][0]) / s, (R[1][2] + R[2][1]) / s, 0.25f * s);
+    }
+
+    if (q.w < 0.0f) {
+        q = quaternion_create(-q.w, -q.x, -q.y, -q.z);
+    }
+    return quaternion_normalize(q);
+}
+
+/**
+ * @brief 가속도/자력계 평균으로 개략 정렬
+ *
+ * 몸체 기준 (아래, 자기 수평, 둘의 외적)과 NED 기준 (아래, 기준 자기 수평, 외적)
+ * 두 쌍의 직교 기저로 R = Σ r_k t_k^T 를 만든다. 아래 방향이 일차 기준이므로
+ * 자력계는 방위만 정한다.
+ */
+bool ekf_align_coarse(const EKF_MagFieldEstimator *est, Vector3f earth_mag_ned, EKF_Alignment *align) {
+    if (est == NULL || align == NULL) {
+        return false;
+    }
+
+    EKF_MagFieldQuality quality;
+    if (!ekf_mag_field_get_quality(est, &quality)) {
+        return false;
+    }
+
+    float accel_norm = vector3f_magnitude(est->accel_mean);
+    float mag_norm = vector3f_magnitude(est->mag_mean);
+    if (!(accel_norm > 0.0f) || !(mag_norm > 0.0f)) {
+        return false;
+    }
+
+    // 몸체 기저: 아래, 측정 자기장의 수평 성분, 그 외적
+    Vector3f t1 = vector3f_scale(est->accel_mean, 1.0f / accel_norm);
+    float mag_down = vector3f_dot(est->mag_mean, t1);
+    Vector3f mag_h = vector3f_subtract(est->mag_mean, vector3f_scale(t1, mag_down));
+    float mag_h_norm = vector3f_magnitude(mag_h);
+    if (!(mag_h_norm > EKF_ALIGN_MIN_HORIZONTAL * mag_norm)) {
+        return false;
+    }
+    Vector3f t2 = vector3f_scale(mag_h, 1.0f / mag_h_norm);
+    Vector3f t3 = vector3f_cross(t1, t2);
+
+    // NED 기저: 아래, 기준 자기장의 수평 방향, 그 외적
+    float ref_h = sqrtf(earth_mag_ned.x * earth_mag_ned.x + earth_mag_ned.y * earth_mag_ned.y);
+    if (!(ref_h > EKF_ALIGN_MIN_HORIZONTAL * vector3f_magnitude(earth_mag_ned))) {
+        return false;
+    }
+    Vector3f r1 = vector3f_create(0.0f, 0.0f, 1.0f);
+    Vector3f r2 = vector3f_create(earth_mag_ned.x / ref_h, earth_mag_ned.y / ref_h, 0.0f);
+    Vector3f r3 = vector3f_cross(r1, r2);
+
+    const float t[3][3] = { { t1.x, t1.y, t1.z }, { t2.x, t2.y, t2.z }, { t3.x, t3.y, t3.z } };
+    const float r[3][3] = { { r1.x, r1.y, r1.z }, { r2.x, r2.y, r2.z }, { r3.x, r3.y, r3.z } };
+    float R[3][3];
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            R[i][j] = r[0][i] * t[0][j] + r[1][i] * t[1][j] + r[2][i] * t[2][j];
+        }
+    }
+    align->q = ekf_align_quaternion_from_matrix(R);
+
+    // 오차: 평균 방향의 표준 오차 (소각), 수평 성분으로 나누어 방위 오차로 환산
+    float sqrt_n = sqrtf((float)quality.count);
+    float tilt = quality.accel_std / (sqrt_n * accel_norm);
+    align->tilt_std = fmaxf(tilt, EKF_ALIGN_TILT_STD_MIN);
+    align->inclination_tan = fabsf(mag_down) / mag_h_norm;
+
+    float heading_mag = quality.mag_std / (sqrt_n * mag_h_norm);
+    float heading_tilt = align->inclination_tan * align->tilt_std;
+    float heading = sqrtf(heading_mag * heading_mag + heading_tilt * heading_tilt);
+    align->heading_std = fmaxf(heading, EKF_ALIGN_HEADING_STD_MIN);
+    align->gyrocompass = false;
+
+    return true;
+}
+
+/**
+ * @brief 자이로 나침반으로 방위 보정
+ *
+ * 정렬 방위가 참값보다 d만큼 크면 NED로 돌린 자전 수평 성분은 북쪽에서 d만큼
+ * 돌아가 보이므로, 관측 방위 오차는 atan2(ω_E, ω_N)이다. 자력계 방위와 분산 가중
+ * 평균한 보정량만큼 아래축에 대해 되돌린다.
+ */
+bool ekf_align_gyrocompass(EKF_Alignment *align, Vector3f gyro_mean, float rate_stderr, float lat_deg) {
+    if (align == NULL || !(rate_stderr >= 0.0f) || !isfinite(lat_deg)) {
+        return false;
+    }
+
+    float lat = lat_deg * EKF_ALIGN_DEG_TO_RAD;
+    float horizontal_rate = EKF_ALIGN_EARTH_RATE * fp_cosf(lat);
+    if (!(horizontal_rate > 0.0f)) {
+        return false;
+    }
+
+    // 자이로 방위 표준 오차 (잡음/바이어스 + 수평 오차가 섞는 수직 자전 성분)
+    float sigma_rate = rate_stderr / horizontal_rate;
+    float sigma_tilt = align->tilt_std * fabsf(fp_tanf(lat));
+    float sigma_g = sqrtf(sigma_rate * sigma_rate + sigma_tilt * sigma_tilt);
+    if (!(sigma_g < EKF_ALIGN_GYROCOMPASS_MAX_STD)) {
+        return false;
+    }
+
+    float R[3][3];
+    quaternion_to_rotation_matrix(align->q, R);
+    float wn = R[0][0] * gyro_mean.x + R[0][1] * gyro_mean.y + R[0][2] * gyro_mean.z;
+    float we = R[1][0] * gyro_mean.x + R[1][1] * gyro_mean.y + R[1][2] * gyro_mean.z;
+    if (!(wn * wn + we * we > 0.0f)) {
+        return false;
+    }
+    float psi_err = fp_atan2f(we, wn);
+
+    // 분산 가중 결합
+    float var_m = align->heading_std * align->heading_std;
+    float var_g = sigma_g * sigma_g;
+    float w = var_m / (var_m + var_g);
+    float half = -0.5f * w * psi_err;
+    Quaternion dq = quaternion_create(fp_cosf(half), 0.0f, 0.0f, fp_sinf(half));
+    align->q = quaternion_normalize(quaternion_multiply(dq, align->q));
+    align->heading_std = sqrtf(var_m * var_g / (var_m + var_g));
+    align->gyrocompass = true;
+
+    return true;
+}
+
+/**
+ * @brief 정렬 자세와 자세 공분산을 필터에 적용
+ *
+ * NED 기준 소회전 d로 q' = [1, d/2] ⊗ q 이면 δq = J d,
+ * J = 0.5 [-q_v^T; q_w I - [q_v]x] 이므로 P_qq = J Σ J^T + ε q q^T 이다.
+ * ε 항은 정규화 구속 방향의 작은 분산으로 P를 양정치로 유지한다.
+ */
+bool ekf_apply_alignment(EKF *ekf, const EKF_Alignment *align) {
+    if (ekf == NULL || align == NULL || !ekf->initialized ||
+        !(align->tilt_std > 0.0f) || !(align->heading_std > 0.0f) || !ekf_flush_covariance(ekf)) {
+        return false;
+    }
+
+    Quaternion q = quaternion_normalize(align->q);
+    ekf->s.quat = q;
+    ekf->quat_norm_error = QUATERNION_RENORM_ROUND_ERROR;
+
+    const float J[4][3] = {
+        { -0.5f * q.x, -0.5f * q.y, -0.5f * q.z },
+        {  0.5f * q.w,  0.5f * q.z, -0.5f * q.y },
+        { -0.5f * q.z,  0.5f * q.w,  0.5f * q.x },
+        {  0.5f * q.y, -0.5f * q.x,  0.5f * q.w },
+    };
+    const float sigma[3] = {
+        align->tilt_std * align->tilt_std,
+        align->tilt_std * align->tilt_std,
+        align->heading_std * align->heading_std,
+    };
+    const float qa[4] = { q.w, q.x, q.y, q.z };
+
+    // 사원수 행/열의 교차 공분산 제거
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < EKF_STATE_DIM; j++) {
+            if (j < EKF_STATE_QUAT_W || j > EKF_STATE_QUAT_Z) {
+                EKF_SYM_FN(set)(&ekf->P, EKF_STATE_QUAT_W + i, j, 0.0f);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = i; j < 4; j++) {
+            float sum = EKF_ALIGN_RADIAL_VAR * qa[i] * qa[j];
+            for (uint8_t k = 0; k < 3; k++) {
+                sum += J[i][k] * sigma[k] * J[j][k];
+            }
+            EKF_SYM_FN(set)(&ekf->P, EKF_STATE_QUAT_W + i, EKF_STATE_QUAT_W + j, sum);
+        }
+    }
+
+    // U-D 엔진이면 바꾼 P로 다시 분해
+    return ekf_set_engine(ekf, ekf->engine);
+}
+
+/**
+ * @brief 필터 방위를 기준 자세의 방위로 재설정
+ *
+ * d = q_ref ⊗ q^* 의 아래축 twist 각은 2 atan2(d_z, d_w)이다. 수평 분산은
+ * NED 소회전 공분산 Σ = 4 J^T P_qq J (J^T J = I/4)의 북/동 대각 평균이다.
+ */
+bool ekf_reset_yaw(EKF *ekf, Quaternion q_ref, float yaw_std) {
+    if (ekf == NULL || !ekf->initialized || !(yaw_std > 0.0f) || !ekf_flush_covariance(ekf)) {
+        return false;
+    }
+
+    Quaternion q = quaternion_normalize(ekf->s.quat);
+    Quaternion d = quaternion_multiply(quaternion_normalize(q_ref), quaternion_conjugate(q));
+    float yaw = 2.0f * fp_atan2f(d.z, d.w);
+    if (yaw > FAST_MATH_PI) {
+        yaw -= 2.0f * FAST_MATH_PI;
+    } else if (yaw < -FAST_MATH_PI) {
+        yaw += 2.0f * FAST_MATH_PI;
+    }
+
+    const float J[4][2] = {
+        { -0.5f * q.x, -0.5f * q.y },
+        {  0.5f * q.w,  0.5f * q.z },
+        { -0.5f * q.z,  0.5f * q.w },
+        {  0.5f * q.y, -0.5f * q.x },
+    };
+    float tilt_var = 0.0f;
+    for (uint8_t k = 0; k < 2; k++) {
+        for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t j = 0; j < 4; j++) {
+                tilt_var += J[i][k] * ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_QUAT_W + i, EKF_STATE_QUAT_W + j)] * J[j][k];
+            }
+        }
+    }
+    tilt_var *= 2.0f; // 4 x (두 축 합 / 2)
+
+    EKF_Alignment align;
+    Quaternion dq = quaternion_create(fp_cosf(0.5f * yaw), 0.0f, 0.0f, fp_sinf(0.5f * yaw));
+    align.q = quaternion_multiply(dq, q);
+    align.tilt_std = fmaxf(sqrtf(fmaxf(tilt_var, 0.0f)), EKF_ALIGN_TILT_STD_MIN);
+    align.heading_std = yaw_std;
+    align.inclination_tan = 0.0f;
+    align.gyrocompass = false;
+
+    return ekf_apply_alignment(ekf, &align);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file ekf_apogee.c
+ * @brief EKF 상태 기반 탄도 정점 예측과 항력 계수 추정
+ */
+
+#include "ekf/ekf.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief 항력 무시 판정 (k * v^2 / g 가 이보다 작으면 진공 해 사용)
+ */
+#define EKF_APOGEE_DRAG_EPS 1e-4f
+
+/**
+ * @brief EKF 항력 계수 설정
+ */
+bool ekf_set_drag_coefficient(EKF *ekf, float drag_k) {
+    if (ekf == NULL || drag_k < 0.0f) {
+        return false;
+    }
+
+    ekf->drag_k = drag_k;
+#if EKF_CONFIG_DRAG
+    ekf->s.drag = drag_k;
+#endif
+
+    return true;
+}
+
+/**
+ * @brief 관성 비행 중 항력 계수 추정
+ */
+bool ekf_estimate_drag(EKF *ekf, Vector3f accel) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_ESTIMATE_DRAG, &accel, sizeof(accel), NULL, 0);
+        return ekf_call_exit(ekf, ekf_estimate_drag(ekf, accel));
+    }
+
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+
+    Vector3f vel = ekf->s.vel;
+    float speed_sq = vector3f_magnitude_squared(vel);
+    if (speed_sq < EKF_DRAG_MIN_SPEED * EKF_DRAG_MIN_SPEED) {
+        return false;
+    }
+
+#if EKF_CONFIG_DRAG
+    // 항력 계수 상태를 비력 측정으로 갱신
+    if (!ekf_update_drag(ekf, accel)) {
+        return false;
+    }
+    ekf->drag_k = fminf(fmaxf(ekf->s.drag, 0.0f), EKF_DRAG_MAX);
+
+    return true;
+#else
+
+    // 비력 = 항력 가속도 (추력 없음)
+    Vector3f f = vector3f_subtract(accel, ekf_get_accel_bias(ekf));
+    float k = sqrtf(vector3f_magnitude_squared(f)) / speed_sq;
+    if (k > EKF_DRAG_MAX) {
+        k = EKF_DRAG_MAX;
+    }
+
+    ekf->drag_k += EKF_DRAG_FILTER_GAIN * (k - ekf->drag_k);
+
+    return true;
+#endif
+}
+
+/**
+ * @brief 항력 계수 추정값 조회
+ */
+float ekf_get_drag_coefficient(const EKF *ekf, float *var) {
+    if (var != NULL) {
+        *var = 0.0f;
+    }
+    if (ekf == NULL) {
+        return 0.0f;
+    }
+
+#if EKF_CONFIG_DRAG
+    if (var != NULL) {
+        *var = ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_DRAG_K, EKF_STATE_DRAG_K)];
+    }
+#endif
+
+    return ekf->drag_k;
+}
+
+/**
+ * @brief 항력 계수 상태 노이즈 설정
+ */
+bool ekf_set_drag_noise(EKF *ekf, float drag_std, float accel_std) {
+#if EKF_CONFIG_DRAG
+    if (ekf == NULL || !(drag_std >= 0.0f) || !(accel_std > 0.0f)) {
+        return false;
+    }
+
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_DRAG_K, EKF_STATE_DRAG_K, drag_std * drag_std);
+    ekf->Qd.dt = 0.0f;
+
+    mat3x3_zero(&ekf->R_drag);
+    mat3x3_set(&ekf->R_drag, 0, 0, accel_std * accel_std);
+    mat3x3_set(&ekf->R_drag, 1, 1, accel_std * accel_std);
+    mat3x3_set(&ekf->R_drag, 2, 2, accel_std * accel_std);
+
+    return true;
+#else
+    (void)ekf;
+    (void)drag_std;
+    (void)accel_std;
+
+    // 항력 계수 상태가 없는 구성
+    return false;
+#endif
+}
+
+/**
+ * @brief 탄도 모델 정점 예측
+ */
+bool ekf_predict_apogee(const EKF *ekf, float *time_to_apogee, float *apogee_alt) {
+    if (ekf == NULL || time_to_apogee == NULL || apogee_alt == NULL || !ekf->initialized) {
+        return false;
+    }
+
+    Vector3f pos = ekf_get_position(ekf);
+    Vector3f vel = ekf->s.vel;
+    float g = ekf->gravity;
+    float vz = vel.z;
+
+    if (vz <= 0.0f) {
+        // 상승 중이 아님
+        *time_to_apogee = 0.0f;
+        *apogee_alt = pos.z;
+        return true;
+    }
+
+    // 수직 성분에 걸리는 항력: k * |v| * v_z = (k * |v| / v_z) * v_z^2
+    float speed = sqrtf(vector3f_magnitude_squared(vel));
+    float kv = ekf_get_drag_coefficient(ekf, NULL) * speed / vz;
+    float drag_ratio = kv * vz * vz / g;
+
+    if (drag_ratio < EKF_APOGEE_DRAG_EPS) {
+        // 진공 해
+        *time_to_apogee = vz / g;
+        *apogee_alt = pos.z + 0.5f * vz * vz / g;
+        return true;
+    }
+
+    float s = sqrtf(kv * g);
+    *time_to_apogee = fp_atanf(vz * kv / s) / s;
+    *apogee_alt = pos.z + fp_logf(1.0f + drag_ratio) / (2.0f * kv);
+
+    return true;
+}
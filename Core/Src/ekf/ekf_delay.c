@@ -0,0 +1,451 @@
+/**
+ * @file ekf_delay.c
+ * @brief 고정 크기 상태 이력 버퍼를 이용한 지연 측정 융합 구현
+ */
+
+#include "ekf/ekf_delay.h"
+#include "math/float16.h"
+#include "math/quaternion.h"
+#include <stddef.h>
+#include <math.h>
+
+#if EKF_DELAY_COMPACT
+
+/**
+ * @brief 상태별 양자화 눈금 (상태 목록 순서)
+ */
+#define EKF_DELAY_STEP_OF_POS(name, p0, pr) EKF_DELAY_STEP_POS,
+#define EKF_DELAY_STEP_OF_VEL(name, p0, pr) EKF_DELAY_STEP_VEL,
+#define EKF_DELAY_STEP_OF_QUAT(name, p0, pr) EKF_DELAY_STEP_QUAT,
+#define EKF_DELAY_STEP_OF_GYRO_BIAS(name, p0, pr) EKF_DELAY_STEP_GYRO_BIAS,
+#define EKF_DELAY_STEP_OF_ACC_BIAS(name, p0, pr) EKF_DELAY_STEP_ACC_BIAS,
+#define EKF_DELAY_STEP_OF_MAG_BIAS(name, p0, pr) EKF_DELAY_STEP_MAG_BIAS,
+#define EKF_DELAY_STEP_OF_DRAG(name, p0, pr) EKF_DELAY_STEP_DRAG,
+#define EKF_DELAY_STEP_OF_CLK(name, p0, pr) EKF_CAT(EKF_DELAY_STEP_, name),
+
+static const float ekf_delay_step[EKF_STATE_DIM] = {
+    EKF_STATES_POSITION(EKF_DELAY_STEP_OF_POS)
+    EKF_STATES_VELOCITY(EKF_DELAY_STEP_OF_VEL)
+    EKF_STATES_ATTITUDE(EKF_DELAY_STEP_OF_QUAT)
+    EKF_STATES_GYRO_BIAS(EKF_DELAY_STEP_OF_GYRO_BIAS)
+    EKF_STATES_ACCEL_BIAS(EKF_DELAY_STEP_OF_ACC_BIAS)
+    EKF_STATES_GNSS_CLOCK(EKF_DELAY_STEP_OF_CLK)
+    EKF_STATES_MAG_BIAS(EKF_DELAY_STEP_OF_MAG_BIAS)
+    EKF_STATES_DRAG(EKF_DELAY_STEP_OF_DRAG)
+};
+
+/**
+ * @brief 항목에 상태 저장 (블록 첫 항목은 기준으로 정확히, 나머지는 기준과의 차이)
+ */
+static void ekf_delay_store_state(EKF_DelayBuffer *buf, EKF_HistoryEntry *e, const EKF_StateVector *x) {
+    const float *v = &x->data[0][0];
+    float *ref = buf->ref[e->ref & (uint8_t)~EKF_DELAY_REF_OWNER];
+
+    if (e->ref & EKF_DELAY_REF_OWNER) {
+        for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+            ref[i] = v[i];
+            e->dx[i] = 0;
+        }
+        return;
+    }
+
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        // 눈금은 2의 거듭제곱이므로 나눗셈 대신 역수 곱이 정확함
+        float q = (v[i] - ref[i]) * (1.0f / ekf_delay_step[i]);
+        if (!(q >= -32767.0f && q <= 32767.0f)) {
+            q = (q > 0.0f) ? 32767.0f : -32767.0f;
+            buf->saturated++;
+        }
+        e->dx[i] = (int16_t)lrintf(q);
+    }
+}
+
+/**
+ * @brief 항목의 상태 복원
+ */
+static void ekf_delay_load_state(const EKF_DelayBuffer *buf, const EKF_HistoryEntry *e, EKF_StateVector *x) {
+    float *v = &x->data[0][0];
+    const float *ref = buf->ref[e->ref & (uint8_t)~EKF_DELAY_REF_OWNER];
+
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        v[i] = ref[i] + (float)e->dx[i] * ekf_delay_step[i];
+    }
+}
+
+/**
+ * @brief 항목에 IMU 샘플 저장
+ */
+static void ekf_delay_store_imu(EKF_HistoryEntry *e, const EKF_ImuSample *imu) {
+    e->gyro[0] = float16_from_float(imu->gyro.x);
+    e->gyro[1] = float16_from_float(imu->gyro.y);
+    e->gyro[2] = float16_from_float(imu->gyro.z);
+    e->accel[0] = float16_from_float(imu->accel.x);
+    e->accel[1] = float16_from_float(imu->accel.y);
+    e->accel[2] = float16_from_float(imu->accel.z);
+    e->dt = imu->dt;
+}
+
+/**
+ * @brief 항목의 IMU 샘플 복원
+ */
+static EKF_ImuSample ekf_delay_load_imu(const EKF_HistoryEntry *e) {
+    EKF_ImuSample imu;
+    imu.gyro = vector3f_create(float16_to_float(e->gyro[0]), float16_to_float(e->gyro[1]),
+                               float16_to_float(e->gyro[2]));
+    imu.accel = vector3f_create(float16_to_float(e->accel[0]), float16_to_float(e->accel[1]),
+                                float16_to_float(e->accel[2]));
+    imu.dt = e->dt;
+    return imu;
+}
+
+#else /* EKF_DELAY_COMPACT */
+
+static void ekf_delay_store_state(EKF_DelayBuffer *buf, EKF_HistoryEntry *e, const EKF_StateVector *x) {
+    (void)buf;
+    e->x = *x;
+}
+
+static void ekf_delay_load_state(const EKF_DelayBuffer *buf, const EKF_HistoryEntry *e, EKF_StateVector *x) {
+    (void)buf;
+    *x = e->x;
+}
+
+static void ekf_delay_store_imu(EKF_HistoryEntry *e, const EKF_ImuSample *imu) {
+    e->imu = *imu;
+}
+
+static EKF_ImuSample ekf_delay_load_imu(const EKF_HistoryEntry *e) {
+    return e->imu;
+}
+
+#endif /* EKF_DELAY_COMPACT */
+
+/**
+ * @brief 이력 항목의 버퍼 인덱스 (age = 0 이 가장 최근)
+ */
+static uint16_t ekf_delay_index(const EKF_DelayBuffer *buf, uint16_t age) {
+    return (uint16_t)((buf->head + EKF_DELAY_HISTORY_SIZE - 1 - age) % EKF_DELAY_HISTORY_SIZE);
+}
+
+/**
+ * @brief 측정 시각 이전의 가장 최근 이력 항목 검색
+ *
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param age 찾은 항목의 나이 (0 = 가장 최근)
+ * @return bool 검색 성공 여부 (측정 시각이 가장 오래된 항목보다 앞서면 false)
+ */
+static bool ekf_delay_find(const EKF_DelayBuffer *buf, uint32_t timestamp_us, uint16_t *age) {
+    for (uint16_t a = 0; a < buf->count; a++) {
+        const EKF_HistoryEntry *e = &buf->entries[ekf_delay_index(buf, a)];
+        // 타임스탬프 순환(약 71분)에 안전한 비교
+        if ((int32_t)(timestamp_us - e->timestamp_us) >= 0) {
+            *age = a;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 측정 시각의 상태로 되돌림
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param timestamp_us 측정 시각 (us)
+ * @param x_now 현재 상태 저장 위치 (갱신 실패 시 복원용)
+ * @param age 되돌린 항목의 나이
+ * @return bool 성공 여부
+ */
+static bool ekf_delay_rewind(EKF *ekf, const EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                             EKF_StateVector *x_now, uint16_t *age) {
+    if (ekf == NULL || buf == NULL || !ekf->initialized || buf->count == 0) {
+        return false;
+    }
+
+    if (!ekf_delay_find(buf, timestamp_us, age)) {
+        return false;
+    }
+
+    *x_now = ekf->x;
+    ekf_delay_load_state(buf, &buf->entries[ekf_delay_index(buf, *age)], &ekf->x);
+#if EKF_DELAY_COMPACT
+    // 양자화 오차만큼 어긋난 사원수 크기 보정
+    ekf->s.quat = quaternion_renormalize(ekf->s.quat, &ekf->quat_norm_error);
+#endif
+
+    return true;
+}
+
+/**
+ * @brief 측정 갱신 후 이후 IMU 샘플로 상태 재적분 (공분산 제외)
+ *
+ * 재적분한 상태로 이력도 갱신하여, 다음 지연 측정이 보정된 과거 상태를 사용하게 한다.
+ *
+ * @param ekf EKF 구조체 포인터
+ * @param buf 이력 버퍼 포인터
+ * @param age 측정 갱신을 적용한 항목의 나이
+ */
+static void ekf_delay_replay(EKF *ekf, EKF_DelayBuffer *buf, uint16_t age) {
+    ekf_delay_store_state(buf, &buf->entries[ekf_delay_index(buf, age)], &ekf->x);
+
+    while (age > 0) {
+        age--;
+        EKF_HistoryEntry *e = &buf->entries[ekf_delay_index(buf, age)];
+        EKF_ImuSample imu = ekf_delay_load_imu(e);
+        ekf_predict_state_only(ekf, imu.gyro, imu.accel, imu.dt);
+        ekf_delay_store_state(buf, e, &ekf->x);
+    }
+}
+
+/**
+ * @brief 이력 버퍼 초기화
+ */
+bool ekf_delay_init(EKF_DelayBuffer *buf) {
+    if (buf == NULL) {
+        return false;
+    }
+
+    buf->head = 0;
+    buf->count = 0;
+#if EKF_DELAY_COMPACT
+    buf->ref_next = 0;
+    buf->saturated = 0;
+#endif
+
+    return true;
+}
+
+/**
+ * @brief 비행 중 이력 비우기
+ */
+bool ekf_delay_clear(EKF *ekf, EKF_DelayBuffer *buf) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_DELAY_CLEAR, NULL, 0, NULL, 0);
+        return ekf_call_exit(ekf, ekf_delay_clear(ekf, buf));
+    }
+
+    return ekf_delay_init(buf);
+}
+
+/**
+ * @brief 예측 단계 수행 후 이력 기록
+ */
+bool ekf_delay_predict(EKF *ekf, EKF_DelayBuffer *buf, const EKF_ImuSample *imu, uint32_t timestamp_us) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_DELAY_PREDICT, &timestamp_us, sizeof(timestamp_us),
+                       imu, (imu != NULL) ? (uint16_t)sizeof(*imu) : 0u);
+        return ekf_call_exit(ekf, ekf_delay_predict(ekf, buf, imu, timestamp_us));
+    }
+
+    if (ekf == NULL || buf == NULL || imu == NULL) {
+        return false;
+    }
+
+    if (!ekf_predict(ekf, imu->gyro, imu->accel, imu->dt)) {
+        return false;
+    }
+
+    EKF_HistoryEntry *e = &buf->entries[buf->head];
+    e->timestamp_us = timestamp_us;
+#if EKF_DELAY_COMPACT
+    // 블록 첫 칸이면 새 기준, 아니면 앞 항목(같은 블록)의 기준
+    if (buf->head % EKF_DELAY_BLOCK == 0) {
+        e->ref = (uint8_t)(buf->ref_next | EKF_DELAY_REF_OWNER);
+        buf->ref_next = (uint8_t)((buf->ref_next + 1u) % EKF_DELAY_REF_COUNT);
+    } else {
+        e->ref = (uint8_t)(buf->entries[buf->head - 1u].ref & (uint8_t)~EKF_DELAY_REF_OWNER);
+    }
+#endif
+    ekf_delay_store_state(buf, e, &ekf->x);
+    ekf_delay_store_imu(e, imu);
+
+    buf->head = (uint16_t)((buf->head + 1) % EKF_DELAY_HISTORY_SIZE);
+    if (buf->count < EKF_DELAY_HISTORY_SIZE) {
+        buf->count++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 지연 GPS 측정 갱신
+ */
+bool ekf_delay_update_gps(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                          Vector3f gps_pos, bool use_vel, Vector3f gps_vel) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_CallGps args = { gps_pos, gps_vel, use_vel ? 1u : 0u };
+        ekf_call_enter(ekf, EKF_CALL_DELAY_UPDATE_GPS, &timestamp_us, sizeof(timestamp_us), &args, sizeof(args));
+        return ekf_call_exit(ekf, ekf_delay_update_gps(ekf, buf, timestamp_us, gps_pos, use_vel, gps_vel));
+    }
+
+    EKF_StateVector x_now;
+    uint16_t age;
+    if (!ekf_delay_rewind(ekf, buf, timestamp_us, &x_now, &age)) {
+        return false;
+    }
+
+    if (!ekf_update_gps(ekf, gps_pos, use_vel, gps_vel)) {
+        ekf->x = x_now;
+        return false;
+    }
+
+    ekf_delay_replay(ekf, buf, age);
+
+    return true;
+}
+
+/**
+ * @brief 지연 GPS 부분 측정 갱신
+ */
+bool ekf_delay_update_gps_partial(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                                  Vector3f gps_pos, Vector3f gps_vel, uint8_t components) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_CallGps args = { gps_pos, gps_vel, components };
+        ekf_call_enter(ekf, EKF_CALL_DELAY_UPDATE_GPS_PARTIAL, &timestamp_us, sizeof(timestamp_us),
+                       &args, sizeof(args));
+        return ekf_call_exit(ekf, ekf_delay_update_gps_partial(ekf, buf, timestamp_us, gps_pos, gps_vel, components));
+    }
+
+    EKF_StateVector x_now;
+    uint16_t age;
+    if (!ekf_delay_rewind(ekf, buf, timestamp_us, &x_now, &age)) {
+        return false;
+    }
+
+    if (!ekf_update_gps_partial(ekf, gps_pos, gps_vel, components)) {
+        ekf->x = x_now;
+        return false;
+    }
+
+    ekf_delay_replay(ekf, buf, age);
+
+    return true;
+}
+
+/**
+ * @brief 지연 기압계 측정 갱신
+ */
+bool ekf_delay_update_baro(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us, float baro_alt) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_DELAY_UPDATE_BARO, &timestamp_us, sizeof(timestamp_us),
+                       &baro_alt, sizeof(baro_alt));
+        return ekf_call_exit(ekf, ekf_delay_update_baro(ekf, buf, timestamp_us, baro_alt));
+    }
+
+    // 천음속 생략 구간이면 되감기 전에 버림 (측정 시각과 현재의 속력 차는 무시)
+    if (ekf != NULL && ekf->initialized && !(ekf_get_baro_noise_scale(ekf) > 0.0f)) {
+        ekf->baro_suppress_count++;
+        return false;
+    }
+
+    EKF_StateVector x_now;
+    uint16_t age;
+    if (!ekf_delay_rewind(ekf, buf, timestamp_us, &x_now, &age)) {
+        return false;
+    }
+
+    if (!ekf_update_baro(ekf, baro_alt)) {
+        ekf->x = x_now;
+        return false;
+    }
+
+    ekf_delay_replay(ekf, buf, age);
+
+    return true;
+}
+
+/**
+ * @brief 지연 자력계 측정 갱신
+ */
+bool ekf_delay_update_mag(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us, Vector3f mag) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_DELAY_UPDATE_MAG, &timestamp_us, sizeof(timestamp_us), &mag, sizeof(mag));
+        return ekf_call_exit(ekf, ekf_delay_update_mag(ekf, buf, timestamp_us, mag));
+    }
+
+    // 외란이면 되감기 전에 버림 (현재 자세로 복각 판정, 되감은 뒤 측정 시각 자세로 다시 검사)
+    if (ekf != NULL && ekf->initialized && ekf_mag_check_disturbance(ekf, mag)) {
+        return false;
+    }
+    
+    EKF_StateVector x_now;
+    uint16_t age;
+    if (!ekf_delay_rewind(ekf, buf, timestamp_us, &x_now, &age)) {
+        return false;
+    }
+
+    if (!ekf_update_mag(ekf, mag)) {
+        ekf->x = x_now;
+        return false;
+    }
+
+    ekf_delay_replay(ekf, buf, age);
+
+    return true;
+}
+
+/**
+ * @brief 지연 이중 안테나 GNSS 기선 측정 갱신
+ */
+bool ekf_delay_update_gnss_heading(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                                   const EKF_GnssHeading *m) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_DELAY_UPDATE_GNSS_HEADING, &timestamp_us, sizeof(timestamp_us),
+                       m, (m != NULL) ? (uint16_t)sizeof(*m) : 0u);
+        return ekf_call_exit(ekf, ekf_delay_update_gnss_heading(ekf, buf, timestamp_us, m));
+    }
+
+    if (m == NULL) {
+        return false;
+    }
+
+    EKF_StateVector x_now;
+    uint16_t age;
+    if (!ekf_delay_rewind(ekf, buf, timestamp_us, &x_now, &age)) {
+        return false;
+    }
+
+    if (!ekf_update_gnss_heading(ekf, m)) {
+        ekf->x = x_now;
+        return false;
+    }
+
+    ekf_delay_replay(ekf, buf, age);
+
+    return true;
+}
+
+/**
+ * @brief 지연 동시 측정 묶음 갱신
+ */
+bool ekf_delay_update_coincident(EKF *ekf, EKF_DelayBuffer *buf, uint32_t timestamp_us,
+                                 EKF_CoincidentMeasurement *m) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_DELAY_UPDATE_COINCIDENT, &timestamp_us, sizeof(timestamp_us),
+                       m, (m != NULL) ? (uint16_t)sizeof(*m) : 0u);
+        return ekf_call_exit(ekf, ekf_delay_update_coincident(ekf, buf, timestamp_us, m));
+    }
+
+    if (m == NULL) {
+        return false;
+    }
+    m->gps_accepted = false;
+    m->baro_accepted = false;
+
+    EKF_StateVector x_now;
+    uint16_t age;
+    if (!ekf_delay_rewind(ekf, buf, timestamp_us, &x_now, &age)) {
+        return false;
+    }
+
+    if (!ekf_update_coincident(ekf, m)) {
+        ekf->x = x_now;
+        return false;
+    }
+
+    ekf_delay_replay(ekf, buf, age);
+
+    return true;
+}
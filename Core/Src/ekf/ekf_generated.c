@@ -0,0 +1,110 @@
+/**
+ * @file ekf_generated.c
+ * @brief EKF 모델 커널 (Tools/codegen/ekf_codegen.c 생성 파일, 직접 수정 금지)
+ */
+
+#include "ekf/ekf_generated.h"
+#include "sys/mem_section.h"
+#include "math/fp_mode.h"
+
+/**
+ * @brief 자력계 측정 모델 h = R(q)^T m 과 자코비안 H = dh/dq
+ */
+MEM_RAMFUNC(ekf_gen_mag_observation)
+void ekf_gen_mag_observation(const float q[4], const float m[3], float h[3], float H[3][4]) {
+    const float qw = q[0], qx = q[1], qy = q[2], qz = q[3];
+    const float mx = m[0], my = m[1], mz = m[2];
+
+    const float t0 = qx * my;
+    const float t1 = qx * mz;
+    const float t2 = qy * mx;
+    const float t3 = qy * mz;
+    const float t4 = qz * mx;
+    const float t5 = qz * my;
+    const float t6 = qw * mx;
+    const float t7 = qw * my;
+    const float t8 = qw * mz;
+    const float t9 = qx * mx;
+    const float t10 = qy * my;
+    const float t11 = qz * mz;
+
+    h[0] = 2.0f * qw * t5 + 2.0f * qy * t0 - 2.0f * qy * t2 + 2.0f * qz * t1 - 2.0f * qz * t4 + mx - 2.0f * qw * t3;
+    h[1] = 2.0f * qw * t1 - 2.0f * qw * t4 - 2.0f * qx * t0 + 2.0f * qx * t2 + 2.0f * qz * t3 - 2.0f * qz * t5 + my;
+    h[2] = 2.0f * qw * t2 - 2.0f * qx * t1 + 2.0f * qx * t4 - 2.0f * qy * t3 + 2.0f * qy * t5 + mz - 2.0f * qw * t0;
+    H[0][0] = 2.0f * (t5 - t3);
+    H[0][1] = 2.0f * (t10 + t11);
+    H[0][2] = 2.0f * (t0 - 2.0f * t2 - t8);
+    H[0][3] = 2.0f * (t1 - 2.0f * t4 + t7);
+    H[1][0] = 2.0f * (t1 - t4);
+    H[1][1] = 2.0f * (t2 + t8 - 2.0f * t0);
+    H[1][2] = 2.0f * (t9 + t11);
+    H[1][3] = 2.0f * (t3 - 2.0f * t5 - t6);
+    H[2][0] = 2.0f * (t2 - t0);
+    H[2][1] = 2.0f * (t4 - t7 - 2.0f * t1);
+    H[2][2] = 2.0f * (t5 + t6 - 2.0f * t3);
+    H[2][3] = 2.0f * (t9 + t10);
+}
+
+/**
+ * @brief 자세 전이의 자이로 바이어스 블록 F = dq'/db (q' = q + dt * 0.5 * q ⊗ (ω - b))
+ */
+MEM_RAMFUNC(ekf_gen_attitude_transition)
+void ekf_gen_attitude_transition(const float q[4], float dt, float F[4][3]) {
+    const float qw = q[0], qx = q[1], qy = q[2], qz = q[3];
+
+    const float t0 = qw * dt;
+    const float t1 = qx * dt;
+    const float t2 = qy * dt;
+    const float t3 = qz * dt;
+
+    F[0][0] = 0.5f * t1;
+    F[0][1] = 0.5f * t2;
+    F[0][2] = 0.5f * t3;
+    F[1][0] = -0.5f * t0;
+    F[1][1] = 0.5f * t3;
+    F[1][2] = -0.5f * t2;
+    F[2][0] = -0.5f * t3;
+    F[2][1] = -0.5f * t0;
+    F[2][2] = 0.5f * t1;
+    F[3][0] = 0.5f * t2;
+    F[3][1] = -0.5f * t1;
+    F[3][2] = -0.5f * t0;
+}
+
+/**
+ * @brief 몸체 벡터 회전 h = R(q) v 와 자코비안 H = dh/dq
+ */
+MEM_RAMFUNC(ekf_gen_body_to_nav)
+void ekf_gen_body_to_nav(const float q[4], const float v[3], float h[3], float H[3][4]) {
+    const float qw = q[0], qx = q[1], qy = q[2], qz = q[3];
+    const float vx = v[0], vy = v[1], vz = v[2];
+
+    const float t0 = qx * vy;
+    const float t1 = qx * vz;
+    const float t2 = qy * vx;
+    const float t3 = qy * vz;
+    const float t4 = qz * vx;
+    const float t5 = qz * vy;
+    const float t6 = qw * vx;
+    const float t7 = qw * vy;
+    const float t8 = qw * vz;
+    const float t9 = qx * vx;
+    const float t10 = qy * vy;
+    const float t11 = qz * vz;
+
+    h[0] = 2.0f * qw * t3 - 2.0f * qw * t5 + 2.0f * qy * t0 - 2.0f * qy * t2 + 2.0f * qz * t1 - 2.0f * qz * t4 + vx;
+    h[1] = 2.0f * qw * t4 - 2.0f * qx * t0 + 2.0f * qx * t2 + 2.0f * qz * t3 - 2.0f * qz * t5 + vy - 2.0f * qw * t1;
+    h[2] = 2.0f * qw * t0 - 2.0f * qw * t2 - 2.0f * qx * t1 + 2.0f * qx * t4 - 2.0f * qy * t3 + 2.0f * qy * t5 + vz;
+    H[0][0] = 2.0f * (t3 - t5);
+    H[0][1] = 2.0f * (t10 + t11);
+    H[0][2] = 2.0f * (t0 - 2.0f * t2 + t8);
+    H[0][3] = 2.0f * (t1 - 2.0f * t4 - t7);
+    H[1][0] = 2.0f * (t4 - t1);
+    H[1][1] = 2.0f * (t2 - t8 - 2.0f * t0);
+    H[1][2] = 2.0f * (t9 + t11);
+    H[1][3] = 2.0f * (t3 - 2.0f * t5 + t6);
+    H[2][0] = 2.0f * (t0 - t2);
+    H[2][1] = 2.0f * (t4 + t7 - 2.0f * t1);
+    H[2][2] = 2.0f * (t5 - t6 - 2.0f * t3);
+    H[2][3] = 2.0f * (t9 + t10);
+}
@@ -0,0 +1,209 @@
+/**
+ * @file ekf_golden.c
+ * @brief 호스트/보드 비트 일치 확인용 표준 재생 구현
+ */
+
+#include "ekf/ekf_golden.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 합성 비행 구간 (IMU 샘플 번호)
+ */
+#define EKF_GOLDEN_BOOST_START (2u * EKF_GOLDEN_SEGMENT_STEPS)  /**< 발사대 정지 끝 */
+#define EKF_GOLDEN_COAST_START (5u * EKF_GOLDEN_SEGMENT_STEPS)  /**< 추진 끝 */
+#define EKF_GOLDEN_BATCH_START (7u * EKF_GOLDEN_SEGMENT_STEPS)  /**< 묶음 예측/직접 갱신 시작 */
+#define EKF_GOLDEN_UD_START (3u * EKF_GOLDEN_SEGMENT_STEPS)     /**< U-D 엔진 시작 */
+#define EKF_GOLDEN_UD_END (5u * EKF_GOLDEN_SEGMENT_STEPS)       /**< 공분산 엔진 복귀 */
+
+/**
+ * @brief 합성 비행 값
+ */
+#define EKF_GOLDEN_DT 0.001f           /**< IMU 주기 (s) */
+#define EKF_GOLDEN_BOOST_ACCEL 30.0f   /**< 추진 가속도 (m/s^2, 위쪽) */
+#define EKF_GOLDEN_COAST_ACCEL -10.3f  /**< 관성 비행 가속도 (m/s^2, 중력 + 항력) */
+#define EKF_GOLDEN_GPS_DELAY_US 60000u /**< GNSS 지연 (us) */
+#define EKF_GOLDEN_BARO_DELAY_US 15000u /**< 기압계 지연 (us) */
+
+/**
+ * @brief FNV-1a
+ */
+static uint32_t ekf_golden_hash(uint32_t h, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief xorshift32 난수 (-0.5 ~ 0.5)
+ */
+static float ekf_golden_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (float)(x >> 8) / 16777216.0f - 0.5f;
+}
+
+/**
+ * @brief 참 수직 가속도 (m/s^2)
+ */
+static float ekf_golden_accel(uint32_t step) {
+    if (step < EKF_GOLDEN_BOOST_START) {
+        return 0.0f;
+    }
+    return (step < EKF_GOLDEN_COAST_START) ? EKF_GOLDEN_BOOST_ACCEL : EKF_GOLDEN_COAST_ACCEL;
+}
+
+/**
+ * @brief 참 고도와 수직 속도 (구간별 등가속도 닫힌 해)
+ */
+static void ekf_golden_truth(uint32_t step, float *z, float *vz) {
+    float t_boost = (float)((step > EKF_GOLDEN_BOOST_START) ? step - EKF_GOLDEN_BOOST_START : 0u) * EKF_GOLDEN_DT;
+    float t_coast = (float)((step > EKF_GOLDEN_COAST_START) ? step - EKF_GOLDEN_COAST_START : 0u) * EKF_GOLDEN_DT;
+    float boost_len = (float)(EKF_GOLDEN_COAST_START - EKF_GOLDEN_BOOST_START) * EKF_GOLDEN_DT;
+    if (t_boost > boost_len) {
+        t_boost = boost_len;
+    }
+    float v_burnout = EKF_GOLDEN_BOOST_ACCEL * t_boost;
+    *vz = v_burnout + EKF_GOLDEN_COAST_ACCEL * t_coast;
+    *z = 0.5f * EKF_GOLDEN_BOOST_ACCEL * t_boost * t_boost + v_burnout * t_coast +
+         0.5f * EKF_GOLDEN_COAST_ACCEL * t_coast * t_coast;
+}
+
+/**
+ * @brief 구간 끝 지문 (x, P와 항법 해, 오일러 각, 정점 예측)
+ */
+static uint32_t ekf_golden_fingerprint(const EKF *ekf, uint32_t t_us, EKF_GoldenResult *result) {
+    EKF_NavSolution sol;
+    float euler[3] = { 0.0f, 0.0f, 0.0f };
+    float apogee[2] = { 0.0f, 0.0f };
+
+    memset(&sol, 0, sizeof(sol));
+    ekf_get_nav_solution(ekf, t_us, &sol);
+    ekf_get_euler(ekf, &euler[0], &euler[1], &euler[2]);
+    ekf_predict_apogee(ekf, &apogee[0], &apogee[1]);
+
+    uint32_t h = 2166136261u;
+    h = ekf_golden_hash(h, ekf->x.data, sizeof(ekf->x.data));
+    h = ekf_golden_hash(h, ekf->P.data, sizeof(ekf->P.data));
+    h = ekf_golden_hash(h, sol.p_diag, sizeof(sol.p_diag));
+    h = ekf_golden_hash(h, sol.p_quat, sizeof(sol.p_quat));
+    h = ekf_golden_hash(h, euler, sizeof(euler));
+    h = ekf_golden_hash(h, apogee, sizeof(apogee));
+
+    for (uint32_t i = 0; i < EKF_STATE_DIM; i++) {
+        result->x[i] = ekf->x.data[i][0];
+        result->p_diag[i] = sol.p_diag[i];
+    }
+    return h;
+}
+
+/**
+ * @brief 호출 결과 집계
+ */
+static void ekf_golden_count(EKF_GoldenResult *result, bool ok) {
+    result->calls++;
+    if (!ok) {
+        result->rejected++;
+    }
+}
+
+/**
+ * @brief 표준 재생 실행
+ */
+bool ekf_golden_run(EKF *ekf, EKF_DelayBuffer *history, EKF_GoldenResult *result) {
+    if (ekf == NULL || history == NULL || result == NULL) {
+        return false;
+    }
+
+    memset(result, 0, sizeof(EKF_GoldenResult));
+    if (!ekf_init(ekf) || !ekf_delay_init(history) || !ekf_initialize_default_magnetic_field(ekf)) {
+        return false;
+    }
+
+    const Quaternion q_true = quaternion_from_euler(0.02f, -0.015f, 0.3f);
+    const Quaternion q_inv = quaternion_conjugate(q_true);
+    const Vector3f mag_body = quaternion_rotate_vector(q_inv, ekf->earth_mag_ned);
+    if (!ekf_set_initial_state(ekf, vector3f_zero(), vector3f_zero(), quaternion_from_euler(0.0f, 0.0f, 0.25f)) ||
+        !ekf_set_process_noise(ekf, 0.01f, 0.1f, 0.01f, 0.001f, 0.01f)) {
+        return false;
+    }
+
+    uint32_t rng = EKF_GOLDEN_SEED;
+    uint32_t t_us = 0;
+    uint32_t segment = 0;
+    EKF_ImuSample batch[10];
+    uint16_t batch_count = 0;
+
+    for (uint32_t step = 0; step < EKF_GOLDEN_SEGMENTS * EKF_GOLDEN_SEGMENT_STEPS; step++) {
+        t_us += 1000u;
+
+        if (step == EKF_GOLDEN_UD_START) {
+            ekf_golden_count(result, ekf_set_engine(ekf, EKF_ENGINE_UD));
+        } else if (step == EKF_GOLDEN_UD_END) {
+            ekf_golden_count(result, ekf_set_engine(ekf, EKF_ENGINE_COVARIANCE));
+        }
+
+        // 측정 IMU = R^T (0, 0, g + a) + 잡음 (ekf_predict 부호)
+        EKF_ImuSample imu;
+        imu.gyro = vector3f_create(0.002f * ekf_golden_random(&rng), 0.002f * ekf_golden_random(&rng),
+                                   0.002f * ekf_golden_random(&rng));
+        imu.accel = quaternion_rotate_vector(q_inv, vector3f_create(0.0f, 0.0f, ekf->gravity + ekf_golden_accel(step)));
+        imu.accel = vector3f_add(imu.accel, vector3f_create(0.05f * ekf_golden_random(&rng),
+                                 0.05f * ekf_golden_random(&rng), 0.05f * ekf_golden_random(&rng)));
+        imu.dt = EKF_GOLDEN_DT;
+
+        float z, vz;
+        if (step < EKF_GOLDEN_BATCH_START) {
+            ekf_golden_count(result, ekf_delay_predict(ekf, history, &imu, t_us));
+
+            if ((step % 20u) == 10u && step >= 20u) {
+                ekf_golden_truth(step - EKF_GOLDEN_BARO_DELAY_US / 1000u, &z, &vz);
+                ekf_golden_count(result, ekf_delay_update_baro(ekf, history, t_us - EKF_GOLDEN_BARO_DELAY_US,
+                                                             z + 0.3f * ekf_golden_random(&rng)));
+            }
+            if ((step % 100u) == 70u) {
+                ekf_golden_truth(step - EKF_GOLDEN_GPS_DELAY_US / 1000u, &z, &vz);
+                Vector3f pos = vector3f_create(0.5f * ekf_golden_random(&rng), 0.5f * ekf_golden_random(&rng),
+                                               z + 0.5f * ekf_golden_random(&rng));
+                Vector3f vel = vector3f_create(0.1f * ekf_golden_random(&rng), 0.1f * ekf_golden_random(&rng),
+                                               vz + 0.1f * ekf_golden_random(&rng));
+                ekf_golden_count(result, ekf_delay_update_gps(ekf, history, t_us - EKF_GOLDEN_GPS_DELAY_US,
+                                                            pos, true, vel));
+            }
+            if (step < EKF_GOLDEN_BOOST_START && (step % 100u) == 99u) {
+                ekf_golden_count(result, ekf_update_zupt(ekf));
+            }
+        } else {
+            batch[batch_count++] = imu;
+            if (batch_count == 10u) {
+                ekf_golden_count(result, ekf_predict_batch(ekf, batch, batch_count));
+                batch_count = 0;
+            }
+            if ((step % 20u) == 10u) {
+                ekf_golden_truth(step, &z, &vz);
+                ekf_golden_count(result, ekf_update_baro(ekf, z + 0.3f * ekf_golden_random(&rng)));
+            }
+        }
+
+        if ((step % 50u) == 25u) {
+            Vector3f mag = vector3f_add(mag_body, vector3f_create(0.005f * ekf_golden_random(&rng),
+                                        0.005f * ekf_golden_random(&rng), 0.005f * ekf_golden_random(&rng)));
+            ekf_golden_count(result, ekf_update_mag(ekf, mag));
+        }
+
+        if (((step + 1u) % EKF_GOLDEN_SEGMENT_STEPS) == 0u) {
+            result->segment[segment++] = ekf_golden_fingerprint(ekf, t_us, result);
+        }
+    }
+
+    result->digest = ekf_golden_hash(2166136261u, result->segment, sizeof(result->segment));
+
+    return true;
+}
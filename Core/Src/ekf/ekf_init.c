@@ -5,205 +5,1259 @@
 
 #include "ekf/ekf.h"
 #include "ekf/ekf_mag_calibration.h"
+#include "sys/mem_section.h"
 #include <string.h>
 #include <math.h>
 
+/**
+ * @brief 상태 목록 항목에서 초기/리셋 분산 추출
+ */
+#define EKF_STATE_P_INIT(name, p_init, p_reset) p_init,
+#define EKF_STATE_P_RESET(name, p_init, p_reset) p_reset,
+
+/**
+ * @brief EKF 스크래치 버퍼 (SRAM1 배치)
+ */
+static uint8_t ekf_scratch_buffer[EKF_SCRATCH_SIZE] MEM_SECTION_SRAM1 MEM_ALIGN8;
+
+/**
+ * @brief EKF 스크래치 영역
+ */
+static ScratchArena ekf_scratch;
+
+/**
+ * @brief 기본 마하수별 기압계 R 배율 (마하 0, 0.1, ... 2.0)
+ *
+ * 아음속 0.5까지는 그대로, 0.6..0.8에서 동압 오차로 점차 키우고, 충격파가 정압공을
+ * 지나는 0.8..1.3 사이는 생략(0), 초음속에서는 정압 회복에 따라 다시 줄인다.
+ * 기체별 풍동/비행 자료가 있으면 ekf_set_baro_transonic으로 바꾼다.
+ */
+static const float ekf_baro_mach_scale_default[EKF_BARO_MACH_COUNT] = {
+    1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f,     // 0.0 .. 0.5
+    2.0f, 5.0f, 20.0f,                      // 0.6 .. 0.8
+    0.0f, 0.0f, 0.0f, 0.0f,                 // 0.9 .. 1.2
+    100.0f, 50.0f, 30.0f, 20.0f,            // 1.3 .. 1.6
+    15.0f, 10.0f, 10.0f, 10.0f              // 1.7 .. 2.0
+};
+
+/**
+ * @brief 정상 상태 게인 기록 삭제 (고정 해제)
+ * 
+ * @param ekf EKF 구조체 포인터
+ */
+static void ekf_clear_steady_gain(EKF *ekf) {
+    for (uint8_t i = 0; i < EKF_SENSOR_COUNT; i++) {
+        ekf->steady[i].dim = 0;
+        ekf->steady[i].stable = 0;
+    }
+    ekf->steady_frozen = false;
+    ekf->steady_used = 0;
+    ekf->steady_converged = 0;
+}
+
+/**
+ * @brief 외부에서 바꾼 P 반영 (U-D 엔진이면 U-D 분해 갱신)
+ * 
+ * P가 바뀌면 수렴한 게인도 더는 맞지 않으므로 정상 상태 게인 기록을 지운다.
+ * 정보 형식 누적분도 이전 P 기준이므로 버린다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 분해 성공 여부 (공분산 엔진이면 항상 true)
+ */
+static bool ekf_refactorize_covariance(EKF *ekf) {
+    ekf_clear_steady_gain(ekf);
+    ekf->info.open = false;
+    ekf->info.count = 0;
+    ekf->info.rows = 0;
+    memset(ekf->info.lambda, 0, sizeof(ekf->info.lambda));
+    memset(ekf->info.eta, 0, sizeof(ekf->info.eta));
+    
+    if (ekf->engine != EKF_ENGINE_UD) {
+        return true;
+    }
+    
+    return EKF_UD_FN(from_sym)(&ekf->P, &ekf->UD);
+}
+
+/**
+ * @brief 적응형 측정 노이즈 혁신 통계 초기화 (배율 1)
+ * 
+ * @param ekf EKF 구조체 포인터
+ */
+static void ekf_clear_adaptive_noise(EKF *ekf) {
+    for (uint8_t i = 0; i < EKF_SENSOR_COUNT; i++) {
+        EKF_AdaptiveNoise *a = &ekf->adaptive[i];
+        for (uint8_t k = 0; k < EKF_ADAPTIVE_MAX_DIM; k++) {
+            a->innovation_sq[k] = 0.0f;
+            a->predicted_var[k] = 0.0f;
+            a->scale[k] = 1.0f;
+        }
+        a->count = 0;
+    }
+}
+
 /**
  * @brief EKF 초기화
  */
-bool ekf_init(EKF *ekf) {
-    if (ekf == NULL) {
+bool ekf_init(EKF *ekf) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 스크래치 영역 초기화 (최초 1회)
+    if (ekf_scratch.base == NULL &&
+        !scratch_init(&ekf_scratch, ekf_scratch_buffer, sizeof(ekf_scratch_buffer))) {
+        return false;
+    }
+    ekf->scratch = &ekf_scratch;
+    
+    // 상태 벡터 초기화 (N x 1)
+    EKF_VEC_FN(zero)(&ekf->x);
+    
+    // 공분산 행렬 초기화 (N x N)
+    EKF_SYM_FN(identity)(&ekf->P); // 단위 행렬로 초기화
+    
+    // 프로세스 노이즈 공분산 초기화 (N x N)
+    EKF_SYM_FN(zero)(&ekf->Q);
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        EKF_SYM_FN(set)(&ekf->Q, i, i, 0.01f); // 기본값으로 초기화
+    }
+#if EKF_CONFIG_MAG_BIAS
+    for (uint8_t i = 0; i < 3; i++) {
+        EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_MAG_BIAS_X + i, EKF_STATE_MAG_BIAS_X + i,
+                        EKF_MAG_BIAS_DEFAULT_STD * EKF_MAG_BIAS_DEFAULT_STD);
+    }
+#endif
+#if EKF_CONFIG_DRAG
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_DRAG_K, EKF_STATE_DRAG_K, EKF_DRAG_DEFAULT_STD * EKF_DRAG_DEFAULT_STD);
+#endif
+    ekf->mag_bias_enabled = EKF_CONFIG_MAG_BIAS != 0;
+    ekf->Qd.dt = 0.0f;
+    ekf->epoch.valid = false;
+    ekf->vel_noise_inflation = 0.0f;
+    
+    // GPS 측정 노이즈 공분산 초기화 (6x6)
+    float gps_std[6] = {5.0f, 5.0f, 10.0f, 0.5f, 0.5f, 1.0f}; // 위치 5m, 5m, 10m, 속도 0.5m/s
+    mat6x6_diagonal_vector(&ekf->R_gps, gps_std);
+    memset(&ekf->gps_acc, 0, sizeof(ekf->gps_acc));
+    ekf->gps_acc_pos_max = EKF_GPS_ACC_DEFAULT_POS_MAX;
+    ekf->gps_acc_vel_max = EKF_GPS_ACC_DEFAULT_VEL_MAX;
+    ekf->gps_acc_skip_count = 0;
+    ekf->gps_lever_arm = vector3f_zero();
+    ekf->gyro_last = vector3f_zero();
+    memset(ekf->pos_comp, 0, sizeof(ekf->pos_comp));
+    
+    // 기압계 측정 노이즈 공분산 초기화 (1x1)
+    mat1x1_set(&ekf->R_baro, 0, 0, 1.0f); // 1m 표준 편차
+    
+    // 자력계 측정 노이즈 공분산 초기화 (3x3)
+    mat3x3_identity(&ekf->R_mag);
+    mat3x3_scale(&ekf->R_mag, 0.1f, &ekf->R_mag); // 0.1uT 표준 편차
+    
+    // 자력계 방위각 측정 노이즈 (1x1)
+    ekf->R_mag_heading.data[0][0] = EKF_MAG_HEADING_DEFAULT_STD * EKF_MAG_HEADING_DEFAULT_STD;
+    
+    // 이중 안테나 GNSS 기선 (설정 전에는 갱신 안 함)
+    ekf->gnss_baseline = vector3f_zero();
+    ekf->R_gnss_heading.data[0][0] = EKF_GNSS_HEADING_DEFAULT_STD * EKF_GNSS_HEADING_DEFAULT_STD;
+    ekf->R_gnss_pitch.data[0][0] = EKF_GNSS_PITCH_DEFAULT_STD * EKF_GNSS_PITCH_DEFAULT_STD;
+    
+    // 자력계 외란 사전 검사
+    ekf_set_mag_disturbance_check(ekf, EKF_MAG_DISTURBANCE_DEFAULT_MAGNITUDE, EKF_MAG_DISTURBANCE_DEFAULT_INCLINATION);
+    memset(&ekf->mag_disturbance, 0, sizeof(ekf->mag_disturbance));
+    
+    // 중력 방향 갱신 노이즈 공분산과 크기 허용 오차
+    ekf_set_gravity_noise(ekf, EKF_GRAVITY_DEFAULT_STD, EKF_GRAVITY_DEFAULT_TOLERANCE);
+    
+    // 영속도 갱신 노이즈 공분산 초기화 (3x3)
+    mat3x3_identity(&ekf->R_zupt);
+    mat3x3_scale(&ekf->R_zupt, 0.05f * 0.05f, &ekf->R_zupt); // 0.05m/s 표준 편차
+    
+    // 항력 비력 측정 노이즈 공분산 (EKF_CONFIG_DRAG)
+    mat3x3_identity(&ekf->R_drag);
+    mat3x3_scale(&ekf->R_drag, EKF_DRAG_DEFAULT_ACCEL_STD * EKF_DRAG_DEFAULT_ACCEL_STD, &ekf->R_drag);
+    
+    // 발사 레일 구속 (기본: 해제)
+    ekf->R_rail.data[0][0] = EKF_RAIL_DEFAULT_VEL_STD * EKF_RAIL_DEFAULT_VEL_STD;
+    ekf->rail_active = false;
+    ekf->rail_length = 0.0f;
+    ekf->rail_distance = 0.0f;
+    ekf->rail_speed_last = 0.0f;
+    
+    // 중력 가속도 설정
+    ekf->gravity = 9.80665f; // m/s^2
+    
+    // 항력 계수 (기본: 항력 무시, 관성 비행 중 추정 또는 기체 제원으로 설정)
+    ekf->drag_k = 0.0f;
+    
+    // 기압계 천음속 오차 모델 (기본 표, ISA 해수면 음속)
+    ekf_set_baro_transonic(ekf, EKF_BARO_DEFAULT_SOUND_SPEED, ekf_baro_mach_scale_default);
+    ekf->baro_suppress_count = 0;
+    ekf->baro_r_scale = 1.0f;
+    ekf->mag_r_scale = 1.0f;
+    
+    // 지구 자기장 벡터 초기화 (NED 좌표계, 기본 발사 지점의 모델 값)
+    // GNSS 고정 후 ekf_initialize_magnetic_field_from_location 또는 현장 측정으로 갱신
+    ekf_wmm_get_field_ned(EKF_WMM_DEFAULT_LAT_DEG, EKF_WMM_DEFAULT_LON_DEG, &ekf->earth_mag_ned);
+    
+    // 측정 갱신 방식 (기본: 순차 스칼라 갱신)
+    ekf->update_mode = EKF_UPDATE_SEQUENTIAL;
+    
+    // 공분산 갱신 방식 (기본: Joseph 형식)
+    ekf->covariance_update = EKF_COVARIANCE_JOSEPH;
+    
+    // 공분산 필터 엔진 (기본: 압축 대칭 P)
+    ekf->engine = EKF_ENGINE_COVARIANCE;
+    
+    // 고려 상태 (기본: 없음, 모든 상태 갱신)
+    ekf->consider_mask = 0;
+    
+    // 분산 경계 (기본: 없음)
+    ekf->variance_bounds = false;
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        ekf->variance_min[i] = 0.0f;
+        ekf->variance_max[i] = INFINITY;
+    }
+    ekf->variance_bound_count = 0;
+    
+    // 혁신 게이트 (카이제곱 99.9%)
+    ekf->nis_gate[EKF_SENSOR_GPS_POS] = EKF_NIS_GATE_3DOF;
+#if EKF_CONFIG_POSITION
+    ekf->nis_gate[EKF_SENSOR_GPS_POS_VEL] = EKF_NIS_GATE_6DOF;
+#else
+    ekf->nis_gate[EKF_SENSOR_GPS_POS_VEL] = EKF_NIS_GATE_3DOF; // 속도만 갱신
+#endif
+    ekf->nis_gate[EKF_SENSOR_BARO] = EKF_NIS_GATE_1DOF;
+    ekf->nis_gate[EKF_SENSOR_MAG] = EKF_NIS_GATE_3DOF;
+    ekf->nis_gate[EKF_SENSOR_ZUPT] = EKF_NIS_GATE_3DOF;
+    ekf->nis_gate[EKF_SENSOR_ZARU] = EKF_NIS_GATE_3DOF;
+    ekf->nis_gate[EKF_SENSOR_PSEUDORANGE] = EKF_NIS_GATE_1DOF;
+    ekf->nis_gate[EKF_SENSOR_RANGE_RATE] = EKF_NIS_GATE_1DOF;
+    ekf->nis_gate[EKF_SENSOR_MAG_HEADING] = EKF_NIS_GATE_1DOF;
+    ekf->nis_gate[EKF_SENSOR_GRAVITY] = EKF_NIS_GATE_3DOF;
+    ekf->nis_gate[EKF_SENSOR_RAIL] = EKF_NIS_GATE_1DOF;
+    ekf->nis_gate[EKF_SENSOR_DRAG] = EKF_NIS_GATE_3DOF;
+    ekf->nis_gate[EKF_SENSOR_GNSS_HEADING] = EKF_NIS_GATE_1DOF;
+    for (uint8_t i = 0; i < EKF_SENSOR_COUNT; i++) {
+        ekf->nis_last[i] = 0.0f;
+        ekf->nis_reject_count[i] = 0;
+        ekf->nis_sum[i] = 0.0f;
+        ekf->nis_count[i] = 0;
+        memset(&ekf->nis_window[i], 0, sizeof(ekf->nis_window[i]));
+        ekf->nis_recover_rejects[i] = EKF_NIS_RECOVER_REJECTS;
+        ekf->nis_recover_time_us[i] = (uint32_t)(EKF_NIS_RECOVER_TIME_S * 1e6f);
+        ekf->nis_reject_streak[i] = 0;
+        ekf->nis_reject_start_us[i] = 0;
+        ekf->nis_recover_count[i] = 0;
+    }
+    ekf->gate_clock_us = 0;
+    
+    // 공분산 지연 전파 (기본: 비활성, 매 예측마다 전파)
+    ekf->lazy_covariance = false;
+    ekf->lazy_max_dt = EKF_LAZY_DEFAULT_MAX_DT;
+    ekf->lazy_dt = 0.0f;
+    
+    // 분할 공분산 전파 (기본: 비활성, 매 예측마다 전체 전파)
+    ekf->bias_decimation = 1;
+    ekf->bias_pending = 0;
+    memset(ekf->bias_coupling, 0, sizeof(ekf->bias_coupling));
+    
+    // 적응형 측정 노이즈 (기본: 비활성, 공칭 R 사용)
+    ekf->adaptive_noise = false;
+    ekf->adaptive_window = EKF_ADAPTIVE_DEFAULT_WINDOW;
+    ekf->adaptive_scale_min = EKF_ADAPTIVE_DEFAULT_SCALE_MIN;
+    ekf->adaptive_scale_max = EKF_ADAPTIVE_DEFAULT_SCALE_MAX;
+    ekf_clear_adaptive_noise(ekf);
+    
+    // 정상 상태 게인 모드 (기본: 비활성, 매 측정마다 게인 계산)
+    ekf->steady_gain = false;
+    ekf->steady_gain_mask = 0;
+    ekf->steady_gain_tolerance = EKF_STEADY_GAIN_DEFAULT_TOLERANCE;
+    ekf->steady_gain_count = EKF_STEADY_GAIN_DEFAULT_COUNT;
+    ekf->steady_updates = 0;
+    ekf_clear_steady_gain(ekf);
+    
+    // 정보 형식 묶음 갱신 (기본: 묶음 없음, 측정마다 공분산 갱신)
+    memset(&ekf->info, 0, sizeof(ekf->info));
+    
+    // 공분산 전이 관찰 (기본: 없음)
+    ekf->transition_observer = NULL;
+    ekf->transition_context = NULL;
+    
+    // 공개 호출 관찰 (기본: 없음)
+    ekf->call_observer = NULL;
+    ekf->call_context = NULL;
+    ekf->call_depth = 0;
+    
+    // 초기화 완료
+    ekf->initialized = false;
+    
+    return true;
+}
+
+/**
+ * @brief EKF 초기 상태 설정
+ */
+bool ekf_set_initial_state(EKF *ekf, Vector3f pos, Vector3f vel, Quaternion q) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_CallNavEstimate args = { q, vel, pos, 0u, 0.0f };
+        ekf_call_enter(ekf, EKF_CALL_SET_INITIAL_STATE, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_initial_state(ekf, pos, vel, q));
+    }
+    
+    if (ekf == NULL) {
+        return false;
+    }
+    
+#if EKF_CONFIG_POSITION
+    // 위치 설정
+    ekf->s.pos = pos;
+#else
+    (void)pos;
+#endif
+    
+    // 속도 설정
+    ekf->s.vel = vel;
+    
+    // 자세 설정 (정규화된 사원수)
+    ekf->s.quat = quaternion_normalize(q);
+    ekf->quat_norm_error = QUATERNION_RENORM_ROUND_ERROR;
+    
+    // 바이어스 초기화
+    ekf->s.bg = vector3f_zero();
+#if EKF_CONFIG_ACCEL_BIAS
+    ekf->s.ba = vector3f_zero();
+#endif
+#if EKF_CONFIG_GNSS_CLOCK
+    ekf->s.clk_bias = 0.0f;
+    ekf->s.clk_drift = 0.0f;
+#endif
+#if EKF_CONFIG_MAG_BIAS
+    ekf->s.bm = vector3f_zero();
+#endif
+#if EKF_CONFIG_DRAG
+    // 항력 계수 사전값 (ekf_set_drag_coefficient, 기체 제원)
+    ekf->s.drag = ekf->drag_k;
+#endif
+    
+    // 공분산 행렬 초기화 (상태 목록의 초기 분산)
+    float p_diag[EKF_STATE_DIM] = { EKF_STATE_LIST(EKF_STATE_P_INIT) };
+    EKF_SYM_FN(diagonal_vector)(&ekf->P, p_diag);
+    ekf->lazy_dt = 0.0f;
+    ekf->bias_pending = 0;
+    memset(ekf->bias_coupling, 0, sizeof(ekf->bias_coupling));
+    ekf_refactorize_covariance(ekf);
+    
+    ekf->initialized = true;
+    
+    return true;
+}
+
+/**
+ * @brief EKF 스크래치 영역 조회
+ */
+ScratchArena *ekf_get_scratch_arena(void) {
+    return &ekf_scratch;
+}
+
+/**
+ * @brief 인스턴스 전용 스크래치 영역 지정
+ */
+bool ekf_set_scratch_arena(EKF *ekf, ScratchArena *arena) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    if (arena == NULL) {
+        ekf->scratch = &ekf_scratch;
+        return true;
+    }
+    
+    if (arena->base == NULL || arena->size < EKF_SCRATCH_SIZE) {
+        return false;
+    }
+    
+    ekf->scratch = arena;
+    
+    return true;
+}
+
+/**
+ * @brief 공분산 전이 관찰 콜백 지정
+ */
+bool ekf_set_transition_observer(EKF *ekf, EKF_TransitionObserver observer, void *context) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    ekf->transition_observer = observer;
+    ekf->transition_context = context;
+    
+    return true;
+}
+
+/**
+ * @brief 공개 호출 관찰 콜백 지정
+ */
+bool ekf_set_call_observer(EKF *ekf, EKF_CallObserver observer, void *context) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    ekf->call_observer = observer;
+    ekf->call_context = context;
+    ekf->call_depth = 0;
+    
+    return true;
+}
+
+/**
+ * @brief 스냅샷 범위의 배치 지문 (FNV-1a)
+ */
+uint32_t ekf_snapshot_layout(void) {
+    const uint32_t words[] = {
+        (uint32_t)EKF_SNAPSHOT_SIZE,
+        (uint32_t)EKF_STATE_DIM,
+        (uint32_t)offsetof(EKF, P),
+        (uint32_t)offsetof(EKF, UD),
+        (uint32_t)offsetof(EKF, earth_mag_ned),
+        (uint32_t)offsetof(EKF, update_mode),
+        (uint32_t)offsetof(EKF, engine),
+        (uint32_t)offsetof(EKF, lazy_phi),
+        (uint32_t)offsetof(EKF, nis_gate),
+        (uint32_t)offsetof(EKF, adaptive),
+        (uint32_t)offsetof(EKF, steady),
+        (uint32_t)offsetof(EKF, info),
+        (uint32_t)sizeof(EKF_ImuSample),
+        (uint32_t)sizeof(EKF_CoincidentMeasurement),
+        (uint32_t)sizeof(EKF_GnssObservation)
+    };
+    
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        for (uint8_t b = 0; b < 4; b++) {
+            h ^= (words[i] >> (8u * b)) & 0xFFu;
+            h *= 16777619u;
+        }
+    }
+    
+    return h;
+}
+
+/**
+ * @brief EKF 프로세스 노이즈 설정
+ */
+bool ekf_set_process_noise(EKF *ekf, float pos_std, float vel_std, float att_std, 
+                          float gyro_bias_std, float acc_bias_std) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 누적된 전이는 바뀌기 전 설정으로 반영
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    // 시계 프로세스 노이즈는 ekf_set_clock_noise로 따로 설정하므로 유지
+    float q_clk_bias = ekf->Q.data[EKF_SYM_FN(index)(EKF_STATE_CLK_BIAS, EKF_STATE_CLK_BIAS)];
+    float q_clk_drift = ekf->Q.data[EKF_SYM_FN(index)(EKF_STATE_CLK_DRIFT, EKF_STATE_CLK_DRIFT)];
+#endif
+#if EKF_CONFIG_MAG_BIAS
+    // 자력계 바이어스 프로세스 노이즈는 ekf_set_mag_bias_noise로 따로 설정하므로 유지
+    float q_mag_bias = ekf->Q.data[EKF_SYM_FN(index)(EKF_STATE_MAG_BIAS_X, EKF_STATE_MAG_BIAS_X)];
+#endif
+#if EKF_CONFIG_DRAG
+    // 항력 계수 프로세스 노이즈는 ekf_set_drag_noise로 따로 설정하므로 유지
+    float q_drag = ekf->Q.data[EKF_SYM_FN(index)(EKF_STATE_DRAG_K, EKF_STATE_DRAG_K)];
+#endif
+    
+    // 프로세스 노이즈 공분산 초기화
+    EKF_SYM_FN(zero)(&ekf->Q);
+    
+#if EKF_CONFIG_POSITION
+    // 위치 프로세스 노이즈
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_POS_X, EKF_STATE_POS_X, pos_std * pos_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_POS_Y, EKF_STATE_POS_Y, pos_std * pos_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_POS_Z, EKF_STATE_POS_Z, pos_std * pos_std);
+#else
+    (void)pos_std;
+#endif
+    
+    // 속도 프로세스 노이즈
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_VEL_X, EKF_STATE_VEL_X, vel_std * vel_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_VEL_Y, EKF_STATE_VEL_Y, vel_std * vel_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_VEL_Z, EKF_STATE_VEL_Z, vel_std * vel_std);
+    
+    // 자세 프로세스 노이즈
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_QUAT_W, EKF_STATE_QUAT_W, att_std * att_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_QUAT_X, EKF_STATE_QUAT_X, att_std * att_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_QUAT_Y, EKF_STATE_QUAT_Y, att_std * att_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_QUAT_Z, EKF_STATE_QUAT_Z, att_std * att_std);
+    
+    // 자이로 바이어스 프로세스 노이즈
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_GYRO_BIAS_X, EKF_STATE_GYRO_BIAS_X, gyro_bias_std * gyro_bias_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_GYRO_BIAS_Y, EKF_STATE_GYRO_BIAS_Y, gyro_bias_std * gyro_bias_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_GYRO_BIAS_Z, EKF_STATE_GYRO_BIAS_Z, gyro_bias_std * gyro_bias_std);
+    
+#if EKF_CONFIG_ACCEL_BIAS
+    // 가속도 바이어스 프로세스 노이즈
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_ACC_BIAS_X, EKF_STATE_ACC_BIAS_X, acc_bias_std * acc_bias_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_ACC_BIAS_Y, EKF_STATE_ACC_BIAS_Y, acc_bias_std * acc_bias_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_ACC_BIAS_Z, EKF_STATE_ACC_BIAS_Z, acc_bias_std * acc_bias_std);
+#else
+    (void)acc_bias_std;
+#endif
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_CLK_BIAS, EKF_STATE_CLK_BIAS, q_clk_bias);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_CLK_DRIFT, EKF_STATE_CLK_DRIFT, q_clk_drift);
+#endif
+#if EKF_CONFIG_MAG_BIAS
+    for (uint8_t i = 0; i < 3; i++) {
+        EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_MAG_BIAS_X + i, EKF_STATE_MAG_BIAS_X + i, q_mag_bias);
+    }
+#endif
+#if EKF_CONFIG_DRAG
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_DRAG_K, EKF_STATE_DRAG_K, q_drag);
+#endif
+    ekf->Qd.dt = 0.0f;
+    
+    return true;
+}
+
+/**
+ * @brief 속도 프로세스 노이즈 일시 증가
+ */
+bool ekf_set_velocity_noise_inflation(EKF *ekf, float q_vel) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_SET_VELOCITY_NOISE_INFLATION, &q_vel, sizeof(q_vel), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_velocity_noise_inflation(ekf, q_vel));
+    }
+    
+    if (ekf == NULL || !(q_vel >= 0.0f)) {
+        return false;
+    }
+    if (q_vel == ekf->vel_noise_inflation) {
+        return true;
+    }
+    
+    // 누적된 전이는 바뀌기 전 설정으로 반영
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+    ekf->vel_noise_inflation = q_vel;
+    ekf->Qd.dt = 0.0f;
+    
+    return true;
+}
+
+/**
+ * @brief 수신기 시계 프로세스 노이즈 설정
+ */
+bool ekf_set_clock_noise(EKF *ekf, float bias_std, float drift_std) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 누적된 전이는 바뀌기 전 설정으로 반영
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_CLK_BIAS, EKF_STATE_CLK_BIAS, bias_std * bias_std);
+    EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_CLK_DRIFT, EKF_STATE_CLK_DRIFT, drift_std * drift_std);
+    ekf->Qd.dt = 0.0f;
+    
+    return true;
+#else
+    (void)bias_std;
+    (void)drift_std;
+    
+    // 시계 상태가 없는 구성
+    return false;
+#endif
+}
+
+/**
+ * @brief 수신기 시계 상태 설정
+ */
+bool ekf_set_clock_state(EKF *ekf, float bias, float drift, float bias_std, float drift_std) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 누적된 전이는 바뀌기 전 설정으로 반영
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    ekf->s.clk_bias = bias;
+    ekf->s.clk_drift = drift;
+    
+    // 시계 행/열의 상관을 지우고 분산 재설정
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        EKF_SYM_FN(set)(&ekf->P, i, EKF_STATE_CLK_BIAS, 0.0f);
+        EKF_SYM_FN(set)(&ekf->P, i, EKF_STATE_CLK_DRIFT, 0.0f);
+    }
+    EKF_SYM_FN(set)(&ekf->P, EKF_STATE_CLK_BIAS, EKF_STATE_CLK_BIAS, bias_std * bias_std);
+    EKF_SYM_FN(set)(&ekf->P, EKF_STATE_CLK_DRIFT, EKF_STATE_CLK_DRIFT, drift_std * drift_std);
+    
+    return ekf_refactorize_covariance(ekf);
+#else
+    (void)bias;
+    (void)drift;
+    (void)bias_std;
+    (void)drift_std;
+    
+    // 시계 상태가 없는 구성
+    return false;
+#endif
+}
+
+/**
+ * @brief EKF GPS 측정 노이즈 설정
+ */
+bool ekf_set_gps_noise(EKF *ekf, float pos_std, float vel_std) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // GPS 측정 노이즈 공분산 초기화
+    mat6x6_zero(&ekf->R_gps);
+    
+    // 위치 측정 노이즈
+    mat6x6_set(&ekf->R_gps, 0, 0, pos_std * pos_std);
+    mat6x6_set(&ekf->R_gps, 1, 1, pos_std * pos_std);
+    mat6x6_set(&ekf->R_gps, 2, 2, pos_std * pos_std);
+    
+    // 속도 측정 노이즈
+    mat6x6_set(&ekf->R_gps, 3, 3, vel_std * vel_std);
+    mat6x6_set(&ekf->R_gps, 4, 4, vel_std * vel_std);
+    mat6x6_set(&ekf->R_gps, 5, 5, vel_std * vel_std);
+    
+    return true;
+}
+
+/**
+ * @brief 수신기 보고 GNSS 정확도 설정
+ */
+bool ekf_set_gps_accuracy(EKF *ekf, const EKF_GpsAccuracy *acc) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_GpsAccuracy none = { 0.0f, 0.0f, 0.0f };
+        const EKF_GpsAccuracy *args = (acc != NULL) ? acc : &none;
+        ekf_call_enter(ekf, EKF_CALL_SET_GPS_ACCURACY, args, sizeof(*args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_gps_accuracy(ekf, acc));
+    }
+    
+    if (ekf == NULL) {
+        return false;
+    }
+    if (acc == NULL) {
+        memset(&ekf->gps_acc, 0, sizeof(ekf->gps_acc));
+        return true;
+    }
+    // NaN도 여기서 거름
+    if (!(acc->h >= 0.0f && acc->v >= 0.0f && acc->s >= 0.0f) ||
+        !isfinite(acc->h) || !isfinite(acc->v) || !isfinite(acc->s)) {
+        return false;
+    }
+    
+    ekf->gps_acc = *acc;
+    
+    return true;
+}
+
+/**
+ * @brief 수신기 정확도 기반 GNSS 성분 생략 문턱 설정
+ */
+bool ekf_set_gps_accuracy_cutoff(EKF *ekf, float pos_max, float vel_max) {
+    if (ekf == NULL || !(pos_max >= 0.0f) || !(vel_max >= 0.0f)) {
+        return false;
+    }
+    
+    ekf->gps_acc_pos_max = pos_max;
+    ekf->gps_acc_vel_max = vel_max;
+    
+    return true;
+}
+
+/**
+ * @brief GNSS 안테나 레버 암 설정
+ */
+bool ekf_set_gps_lever_arm(EKF *ekf, Vector3f lever_arm) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    ekf->gps_lever_arm = lever_arm;
+    
+    return true;
+}
+
+/**
+ * @brief EKF 기압계 측정 노이즈 설정
+ */
+bool ekf_set_baro_noise(EKF *ekf, float baro_std) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 기압계 측정 노이즈 공분산 설정
+    mat1x1_set(&ekf->R_baro, 0, 0, baro_std * baro_std);
+    
+    return true;
+}
+
+/**
+ * @brief 기압계 천음속 오차 모델 설정
+ */
+bool ekf_set_baro_transonic(EKF *ekf, float sound_speed, const float mach_scale[EKF_BARO_MACH_COUNT]) {
+    if (ekf == NULL || !(sound_speed >= 0.0f)) {
+        return false;
+    }
+    
+    if (mach_scale != NULL) {
+        for (uint8_t i = 0; i < EKF_BARO_MACH_COUNT; i++) {
+            if (!(mach_scale[i] >= 0.0f)) {
+                return false;
+            }
+        }
+        for (uint8_t i = 0; i < EKF_BARO_MACH_COUNT; i++) {
+            ekf->baro_mach_scale[i] = mach_scale[i];
+        }
+    }
+    ekf->baro_sound_speed = sound_speed;
+    
+    return true;
+}
+
+/**
+ * @brief 기압계 R 외부 배율 설정
+ */
+bool ekf_set_baro_noise_scale(EKF *ekf, float scale) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_SET_BARO_NOISE_SCALE, &scale, sizeof(scale), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_baro_noise_scale(ekf, scale));
+    }
+    
+    if (ekf == NULL || !(scale > 0.0f)) {
+        return false;
+    }
+    
+    ekf->baro_r_scale = scale;
+    
+    return true;
+}
+
+/**
+ * @brief EKF 자력계 측정 노이즈 설정
+ */
+bool ekf_set_mag_noise(EKF *ekf, float mag_std) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 자력계 측정 노이즈 공분산 초기화
+    mat3x3_zero(&ekf->R_mag);
+    
+    // 자력계 측정 노이즈
+    mat3x3_set(&ekf->R_mag, 0, 0, mag_std * mag_std);
+    mat3x3_set(&ekf->R_mag, 1, 1, mag_std * mag_std);
+    mat3x3_set(&ekf->R_mag, 2, 2, mag_std * mag_std);
+    
+    return true;
+}
+
+/**
+ * @brief 자력계 R 외부 배율 설정
+ */
+bool ekf_set_mag_noise_scale(EKF *ekf, float scale) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_SET_MAG_NOISE_SCALE, &scale, sizeof(scale), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_mag_noise_scale(ekf, scale));
+    }
+    
+    if (ekf == NULL || !(scale > 0.0f)) {
+        return false;
+    }
+    
+    ekf->mag_r_scale = scale;
+    
+    return true;
+}
+
+/**
+ * @brief EKF 자력계 방위각 측정 노이즈 설정
+ */
+bool ekf_set_mag_heading_noise(EKF *ekf, float heading_std) {
+    if (ekf == NULL || !(heading_std > 0.0f)) {
+        return false;
+    }
+    
+    ekf->R_mag_heading.data[0][0] = heading_std * heading_std;
+    
+    return true;
+}
+
+/**
+ * @brief 이중 안테나 GNSS 기선 설정
+ */
+bool ekf_set_gnss_baseline(EKF *ekf, Vector3f baseline) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    float len_sq = vector3f_magnitude_squared(baseline);
+    if (!(len_sq > 0.0f) || !isfinite(len_sq)) {
+        return false;
+    }
+    
+    ekf->gnss_baseline = baseline;
+    
+    return true;
+}
+
+/**
+ * @brief 이중 안테나 GNSS 기선 기본 노이즈 설정
+ */
+bool ekf_set_gnss_heading_noise(EKF *ekf, float heading_std, float pitch_std) {
+    if (ekf == NULL || !(heading_std > 0.0f) || !(pitch_std > 0.0f)) {
+        return false;
+    }
+    
+    ekf->R_gnss_heading.data[0][0] = heading_std * heading_std;
+    ekf->R_gnss_pitch.data[0][0] = pitch_std * pitch_std;
+    
+    return true;
+}
+
+/**
+ * @brief 자력계 바이어스 상태 추정 켜기/끄기
+ */
+bool ekf_set_mag_bias_enabled(EKF *ekf, bool enable) {
+#if EKF_CONFIG_MAG_BIAS
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    // 누적된 전이는 바뀌기 전 설정으로 반영하고 이산 노이즈 캐시를 비움
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    ekf->mag_bias_enabled = enable;
+    ekf->Qd.dt = 0.0f;
+    
+    return true;
+#else
+    (void)ekf;
+    (void)enable;
+    
+    // 자력계 바이어스 상태가 없는 구성
+    return false;
+#endif
+}
+
+/**
+ * @brief 자력계 바이어스 프로세스 노이즈 설정
+ */
+bool ekf_set_mag_bias_noise(EKF *ekf, float bias_std) {
+#if EKF_CONFIG_MAG_BIAS
+    if (ekf == NULL || !(bias_std >= 0.0f)) {
+        return false;
+    }
+    
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        EKF_SYM_FN(set)(&ekf->Q, EKF_STATE_MAG_BIAS_X + i, EKF_STATE_MAG_BIAS_X + i, bias_std * bias_std);
+    }
+    ekf->Qd.dt = 0.0f;
+    
+    return true;
+#else
+    (void)ekf;
+    (void)bias_std;
+    
+    // 자력계 바이어스 상태가 없는 구성
+    return false;
+#endif
+}
+
+/**
+ * @brief 자력계 외란 사전 검사 설정
+ */
+bool ekf_set_mag_disturbance_check(EKF *ekf, float magnitude_tol, float inclination_tol) {
+    if (ekf == NULL || !(magnitude_tol >= 0.0f) || !(inclination_tol >= 0.0f)) {
+        return false;
+    }
+    
+    ekf->mag_magnitude_tolerance = magnitude_tol;
+    ekf->mag_inclination_tolerance = inclination_tol;
+    
+    return true;
+}
+
+/**
+ * @brief EKF 중력 방향 갱신 노이즈 설정
+ */
+bool ekf_set_gravity_noise(EKF *ekf, float accel_std, float tolerance) {
+    if (ekf == NULL || !(accel_std > 0.0f) || !(tolerance > 0.0f)) {
         return false;
     }
     
-    // 상태 벡터 초기화 (16x1)
-    ekf->x = matrix_create(EKF_STATE_DIM, 1);
+    mat3x3_zero(&ekf->R_gravity);
+    mat3x3_set(&ekf->R_gravity, 0, 0, accel_std * accel_std);
+    mat3x3_set(&ekf->R_gravity, 1, 1, accel_std * accel_std);
+    mat3x3_set(&ekf->R_gravity, 2, 2, accel_std * accel_std);
+    ekf->gravity_tolerance = tolerance;
     
-    // 공분산 행렬 초기화 (16x16)
-    ekf->P = matrix_create(EKF_STATE_DIM, EKF_STATE_DIM);
-    matrix_diagonal(&ekf->P, 1.0f); // 단위 행렬로 초기화
+    return true;
+}
+
+/**
+ * @brief EKF 영속도 갱신 노이즈 설정
+ */
+bool ekf_set_zupt_noise(EKF *ekf, float vel_std) {
+    if (ekf == NULL) {
+        return false;
+    }
     
-    // 프로세스 노이즈 공분산 초기화 (16x16)
-    ekf->Q = matrix_create(EKF_STATE_DIM, EKF_STATE_DIM);
-    matrix_diagonal(&ekf->Q, 0.01f); // 기본값으로 초기화
+    // 영속도 갱신 노이즈 공분산 (세 축 동일)
+    mat3x3_zero(&ekf->R_zupt);
+    mat3x3_set(&ekf->R_zupt, 0, 0, vel_std * vel_std);
+    mat3x3_set(&ekf->R_zupt, 1, 1, vel_std * vel_std);
+    mat3x3_set(&ekf->R_zupt, 2, 2, vel_std * vel_std);
     
-    // GPS 측정 노이즈 공분산 초기화 (6x6)
-    ekf->R_gps = matrix_create(6, 6);
-    float gps_std[6] = {5.0f, 5.0f, 10.0f, 0.5f, 0.5f, 1.0f}; // 위치 5m, 5m, 10m, 속도 0.5m/s
-    matrix_diagonal_vector(&ekf->R_gps, gps_std, 6);
+    return true;
+}
+
+/**
+ * @brief EKF 발사 레일 구속 시작/해제
+ */
+bool ekf_set_rail_constraint(EKF *ekf, bool enable, float rail_length, float vel_std) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const float args[3] = { enable ? 1.0f : 0.0f, rail_length, vel_std };
+        ekf_call_enter(ekf, EKF_CALL_SET_RAIL_CONSTRAINT, args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_rail_constraint(ekf, enable, rail_length, vel_std));
+    }
     
-    // 기압계 측정 노이즈 공분산 초기화 (1x1)
-    ekf->R_baro = matrix_create(1, 1);
-    matrix_set(&ekf->R_baro, 0, 0, 1.0f); // 1m 표준 편차
+    if (ekf == NULL) {
+        return false;
+    }
     
-    // 자력계 측정 노이즈 공분산 초기화 (3x3)
-    ekf->R_mag = matrix_create(3, 3);
-    matrix_diagonal(&ekf->R_mag, 0.1f); // 0.1uT 표준 편차
+    if (!enable) {
+        ekf->rail_active = false;
+        return true;
+    }
+    if (!ekf->initialized || !(rail_length > 0.0f)) {
+        return false;
+    }
     
-    // 중력 가속도 설정
-    ekf->gravity = 9.80665f; // m/s^2
+    float std = (vel_std > 0.0f) ? vel_std : EKF_RAIL_DEFAULT_VEL_STD;
+    ekf->R_rail.data[0][0] = std * std;
+    ekf->rail_length = rail_length;
+    ekf->rail_distance = 0.0f;
+    ekf->rail_speed_last = 0.0f;
+    ekf->rail_active = true;
     
-    // 지구 자기장 벡터 초기화 (NED 좌표계)
-    // 일단은 서울 지역(37.5°N, 127°E)의 지구 자기장 벡터를 사용함.
-    // 추후 ekf_mag_calibration.c의 ekf_calibrate_magnetic_field 함수를 사용하여 현장 측정으로 초기화하는 기능 구현할 예정.
-    ekf->earth_mag_ned = vector3f_create(0.29f, -0.05f, 0.42f); // 서울(37.5°N, 127°E) 기준 대략적인 값
+    return true;
+}
+
+/**
+ * @brief EKF 발사 레일 구속 중 여부
+ */
+bool ekf_is_rail_constrained(const EKF *ekf) {
+    return ekf != NULL && ekf->rail_active;
+}
+
+/**
+ * @brief EKF 측정 갱신 방식 설정
+ */
+bool ekf_set_update_mode(EKF *ekf, EKF_UpdateMode mode) {
+    if (ekf == NULL) {
+        return false;
+    }
     
-    // 초기화 완료
-    ekf->initialized = false;
+    if (mode != EKF_UPDATE_SEQUENTIAL && mode != EKF_UPDATE_BATCH) {
+        return false;
+    }
+    
+    ekf->update_mode = mode;
     
     return true;
 }
 
 /**
- * @brief EKF 초기 상태 설정
+ * @brief 공분산 갱신 방식 설정
  */
-bool ekf_set_initial_state(EKF *ekf, Vector3f pos, Vector3f vel, Quaternion q) {
+bool ekf_set_covariance_update(EKF *ekf, EKF_CovarianceUpdate mode) {
     if (ekf == NULL) {
         return false;
     }
     
-    // 위치 설정
-    matrix_set(&ekf->x, EKF_STATE_POS_X, 0, pos.x);
-    matrix_set(&ekf->x, EKF_STATE_POS_Y, 0, pos.y);
-    matrix_set(&ekf->x, EKF_STATE_POS_Z, 0, pos.z);
+    if (mode != EKF_COVARIANCE_JOSEPH && mode != EKF_COVARIANCE_STANDARD) {
+        return false;
+    }
     
-    // 속도 설정
-    matrix_set(&ekf->x, EKF_STATE_VEL_X, 0, vel.x);
-    matrix_set(&ekf->x, EKF_STATE_VEL_Y, 0, vel.y);
-    matrix_set(&ekf->x, EKF_STATE_VEL_Z, 0, vel.z);
+    ekf->covariance_update = mode;
     
-    // 자세 설정 (정규화된 사원수)
-    Quaternion qn = quaternion_normalize(q);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_W, 0, qn.w);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_X, 0, qn.x);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_Y, 0, qn.y);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_Z, 0, qn.z);
+    return true;
+}
+
+/**
+ * @brief 고려 상태 설정
+ */
+bool ekf_set_consider_states(EKF *ekf, uint32_t mask) {
+    if (ekf == NULL || (mask & ~EKF_STATE_MASK(0, EKF_STATE_DIM)) != 0) {
+        return false;
+    }
     
-    // 바이어스 초기화
-    matrix_set(&ekf->x, EKF_STATE_GYRO_BIAS_X, 0, 0.0f);
-    matrix_set(&ekf->x, EKF_STATE_GYRO_BIAS_Y, 0, 0.0f);
-    matrix_set(&ekf->x, EKF_STATE_GYRO_BIAS_Z, 0, 0.0f);
-    matrix_set(&ekf->x, EKF_STATE_ACC_BIAS_X, 0, 0.0f);
-    matrix_set(&ekf->x, EKF_STATE_ACC_BIAS_Y, 0, 0.0f);
-    matrix_set(&ekf->x, EKF_STATE_ACC_BIAS_Z, 0, 0.0f);
-    
-    // 공분산 행렬 초기화
-    float p_diag[EKF_STATE_DIM] = {
-        10.0f, 10.0f, 10.0f,     // 위치 불확실성 (m^2)
-        1.0f, 1.0f, 1.0f,        // 속도 불확실성 (m/s)^2
-        0.1f, 0.1f, 0.1f, 0.1f,  // 자세 불확실성
-        0.01f, 0.01f, 0.01f,     // 자이로 바이어스 불확실성 (rad/s)^2
-        0.1f, 0.1f, 0.1f         // 가속도 바이어스 불확실성 (m/s^2)^2
-    };
-    matrix_diagonal_vector(&ekf->P, p_diag, EKF_STATE_DIM);
+    ekf->consider_mask = mask;
     
-    ekf->initialized = true;
+    // 고려 상태 행이 0인 게인으로 바뀌므로 기록한 게인은 버림
+    ekf_clear_steady_gain(ekf);
     
     return true;
 }
 
 /**
- * @brief EKF 프로세스 노이즈 설정
+ * @brief 상태 블록별 분산 하한/상한 설정
  */
-bool ekf_set_process_noise(EKF *ekf, float pos_std, float vel_std, float att_std, 
-                          float gyro_bias_std, float acc_bias_std) {
+bool ekf_set_variance_bounds(EKF *ekf, uint32_t mask, float min_var, float max_var) {
+    if (ekf == NULL || (mask & ~EKF_STATE_MASK(0, EKF_STATE_DIM)) != 0 ||
+        !(min_var >= 0.0f) || !(max_var >= min_var) || !(max_var > 0.0f)) {
+        return false;
+    }
+    
+    bool any = false;
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        if ((mask >> i) & 1u) {
+            ekf->variance_min[i] = min_var;
+            ekf->variance_max[i] = max_var;
+        }
+        any = any || ekf->variance_min[i] > 0.0f || isfinite(ekf->variance_max[i]);
+    }
+    ekf->variance_bounds = any;
+    
+    return true;
+}
+
+/**
+ * @brief 공분산 필터 엔진 설정
+ */
+bool ekf_set_engine(EKF *ekf, EKF_Engine engine) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const uint8_t args = (uint8_t)engine;
+        ekf_call_enter(ekf, EKF_CALL_SET_ENGINE, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_engine(ekf, engine));
+    }
+    
     if (ekf == NULL) {
         return false;
     }
     
-    // 프로세스 노이즈 공분산 초기화
-    matrix_zero(&ekf->Q);
+    // 누적된 전이는 바뀌기 전 설정으로 반영
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
     
-    // 위치 프로세스 노이즈
-    matrix_set(&ekf->Q, EKF_STATE_POS_X, EKF_STATE_POS_X, pos_std * pos_std);
-    matrix_set(&ekf->Q, EKF_STATE_POS_Y, EKF_STATE_POS_Y, pos_std * pos_std);
-    matrix_set(&ekf->Q, EKF_STATE_POS_Z, EKF_STATE_POS_Z, pos_std * pos_std);
+    if (engine != EKF_ENGINE_COVARIANCE && engine != EKF_ENGINE_UD) {
+        return false;
+    }
     
-    // 속도 프로세스 노이즈
-    matrix_set(&ekf->Q, EKF_STATE_VEL_X, EKF_STATE_VEL_X, vel_std * vel_std);
-    matrix_set(&ekf->Q, EKF_STATE_VEL_Y, EKF_STATE_VEL_Y, vel_std * vel_std);
-    matrix_set(&ekf->Q, EKF_STATE_VEL_Z, EKF_STATE_VEL_Z, vel_std * vel_std);
+    ekf->engine = engine;
     
-    // 자세 프로세스 노이즈
-    matrix_set(&ekf->Q, EKF_STATE_QUAT_W, EKF_STATE_QUAT_W, att_std * att_std);
-    matrix_set(&ekf->Q, EKF_STATE_QUAT_X, EKF_STATE_QUAT_X, att_std * att_std);
-    matrix_set(&ekf->Q, EKF_STATE_QUAT_Y, EKF_STATE_QUAT_Y, att_std * att_std);
-    matrix_set(&ekf->Q, EKF_STATE_QUAT_Z, EKF_STATE_QUAT_Z, att_std * att_std);
+    return ekf_refactorize_covariance(ekf);
+}
+
+/**
+ * @brief 측정 혁신 게이트 설정
+ */
+bool ekf_set_innovation_gate(EKF *ekf, EKF_Sensor sensor, float threshold) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT) {
+        return false;
+    }
     
-    // 자이로 바이어스 프로세스 노이즈
-    matrix_set(&ekf->Q, EKF_STATE_GYRO_BIAS_X, EKF_STATE_GYRO_BIAS_X, gyro_bias_std * gyro_bias_std);
-    matrix_set(&ekf->Q, EKF_STATE_GYRO_BIAS_Y, EKF_STATE_GYRO_BIAS_Y, gyro_bias_std * gyro_bias_std);
-    matrix_set(&ekf->Q, EKF_STATE_GYRO_BIAS_Z, EKF_STATE_GYRO_BIAS_Z, gyro_bias_std * gyro_bias_std);
+    ekf->nis_gate[sensor] = threshold;
     
-    // 가속도 바이어스 프로세스 노이즈
-    matrix_set(&ekf->Q, EKF_STATE_ACC_BIAS_X, EKF_STATE_ACC_BIAS_X, acc_bias_std * acc_bias_std);
-    matrix_set(&ekf->Q, EKF_STATE_ACC_BIAS_Y, EKF_STATE_ACC_BIAS_Y, acc_bias_std * acc_bias_std);
-    matrix_set(&ekf->Q, EKF_STATE_ACC_BIAS_Z, EKF_STATE_ACC_BIAS_Z, acc_bias_std * acc_bias_std);
+    return true;
+}
+
+/**
+ * @brief 마지막 측정 갱신의 NIS 조회
+ */
+float ekf_get_innovation_nis(const EKF *ekf, EKF_Sensor sensor) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT) {
+        return 0.0f;
+    }
+    
+    return ekf->nis_last[sensor];
+}
+
+/**
+ * @brief 게이트 거부 횟수 조회
+ */
+uint32_t ekf_get_innovation_reject_count(const EKF *ekf, EKF_Sensor sensor) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT) {
+        return 0;
+    }
+    
+    return ekf->nis_reject_count[sensor];
+}
+
+/**
+ * @brief 게이트 연속 거부 복구 조건 설정
+ */
+bool ekf_set_innovation_gate_recovery(EKF *ekf, EKF_Sensor sensor, uint16_t max_rejects, float max_time_s) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT || !(max_time_s < 4000.0f)) {
+        return false;
+    }
+    
+    ekf->nis_recover_rejects[sensor] = max_rejects;
+    ekf->nis_recover_time_us[sensor] = (max_time_s > 0.0f) ? (uint32_t)(max_time_s * 1e6f) : 0;
+    ekf->nis_reject_streak[sensor] = 0;
     
     return true;
 }
 
 /**
- * @brief EKF GPS 측정 노이즈 설정
+ * @brief 연속 거부 뒤 강제 수용 횟수 조회
  */
-bool ekf_set_gps_noise(EKF *ekf, float pos_std, float vel_std) {
-    if (ekf == NULL) {
+uint32_t ekf_get_innovation_recover_count(const EKF *ekf, EKF_Sensor sensor) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT) {
+        return 0;
+    }
+    
+    return ekf->nis_recover_count[sensor];
+}
+
+/**
+ * @brief 현재 연속 거부 수 조회
+ */
+uint16_t ekf_get_innovation_reject_streak(const EKF *ekf, EKF_Sensor sensor) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT) {
+        return 0;
+    }
+    
+    return ekf->nis_reject_streak[sensor];
+}
+
+/**
+ * @brief 측정별 평균 NIS 조회
+ */
+float ekf_get_innovation_nis_mean(const EKF *ekf, EKF_Sensor sensor, uint32_t *count) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT) {
+        if (count != NULL) {
+            *count = 0;
+        }
+        return 0.0f;
+    }
+    
+    if (count != NULL) {
+        *count = ekf->nis_count[sensor];
+    }
+    
+    return (ekf->nis_count[sensor] > 0) ? ekf->nis_sum[sensor] / (float)ekf->nis_count[sensor] : 0.0f;
+}
+
+/**
+ * @brief 측정별 NIS 창 누적을 꺼내고 비움
+ */
+bool ekf_take_nis_window(EKF *ekf, EKF_Sensor sensor, EKF_NisWindow *out) {
+    if (ekf == NULL || out == NULL || sensor >= EKF_SENSOR_COUNT) {
         return false;
     }
     
-    // GPS 측정 노이즈 공분산 초기화
-    matrix_zero(&ekf->R_gps);
+    *out = ekf->nis_window[sensor];
+    memset(&ekf->nis_window[sensor], 0, sizeof(ekf->nis_window[sensor]));
     
-    // 위치 측정 노이즈
-    matrix_set(&ekf->R_gps, 0, 0, pos_std * pos_std);
-    matrix_set(&ekf->R_gps, 1, 1, pos_std * pos_std);
-    matrix_set(&ekf->R_gps, 2, 2, pos_std * pos_std);
+    return true;
+}
+
+/**
+ * @brief 적응형 측정 노이즈 설정
+ */
+bool ekf_set_adaptive_noise(EKF *ekf, bool enable, uint16_t window, float scale_min, float scale_max) {
+    if (ekf == NULL || window == 0 || !(scale_min > 0.0f) || !(scale_max >= scale_min)) {
+        return false;
+    }
     
-    // 속도 측정 노이즈
-    matrix_set(&ekf->R_gps, 3, 3, vel_std * vel_std);
-    matrix_set(&ekf->R_gps, 4, 4, vel_std * vel_std);
-    matrix_set(&ekf->R_gps, 5, 5, vel_std * vel_std);
+    ekf->adaptive_noise = enable;
+    ekf->adaptive_window = window;
+    ekf->adaptive_scale_min = scale_min;
+    ekf->adaptive_scale_max = scale_max;
+    ekf_clear_adaptive_noise(ekf);
     
     return true;
 }
 
 /**
- * @brief EKF 기압계 측정 노이즈 설정
+ * @brief 정상 상태 게인 모드 설정
  */
-bool ekf_set_baro_noise(EKF *ekf, float baro_std) {
-    if (ekf == NULL) {
+bool ekf_set_steady_gain(EKF *ekf, bool enable, uint32_t sensor_mask, float tolerance, uint16_t count) {
+    if (ekf == NULL || (sensor_mask >> EKF_SENSOR_COUNT) != 0) {
         return false;
     }
     
-    // 기압계 측정 노이즈 공분산 설정
-    matrix_set(&ekf->R_baro, 0, 0, baro_std * baro_std);
+    ekf->steady_gain = enable;
+    ekf->steady_gain_mask = sensor_mask;
+    ekf->steady_gain_tolerance = (tolerance > 0.0f) ? tolerance : EKF_STEADY_GAIN_DEFAULT_TOLERANCE;
+    ekf->steady_gain_count = (count > 0) ? count : EKF_STEADY_GAIN_DEFAULT_COUNT;
+    ekf_clear_steady_gain(ekf);
     
     return true;
 }
 
 /**
- * @brief EKF 자력계 측정 노이즈 설정
+ * @brief 정상 상태 게인 기록 초기화
  */
-bool ekf_set_mag_noise(EKF *ekf, float mag_std) {
+bool ekf_steady_gain_reset(EKF *ekf) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_STEADY_GAIN_RESET, NULL, 0, NULL, 0);
+        return ekf_call_exit(ekf, ekf_steady_gain_reset(ekf));
+    }
+    
     if (ekf == NULL) {
         return false;
     }
     
-    // 자력계 측정 노이즈 공분산 초기화
-    matrix_zero(&ekf->R_mag);
-    
-    // 자력계 측정 노이즈
-    matrix_set(&ekf->R_mag, 0, 0, mag_std * mag_std);
-    matrix_set(&ekf->R_mag, 1, 1, mag_std * mag_std);
-    matrix_set(&ekf->R_mag, 2, 2, mag_std * mag_std);
+    ekf_clear_steady_gain(ekf);
     
     return true;
 }
 
+/**
+ * @brief 게인 고정 여부
+ */
+bool ekf_is_steady_gain_frozen(const EKF *ekf) {
+    return ekf != NULL && ekf->steady_frozen;
+}
+
+/**
+ * @brief 현재 적용 중인 R 배율 조회
+ */
+float ekf_get_noise_scale(const EKF *ekf, EKF_Sensor sensor, uint8_t axis) {
+    if (ekf == NULL || sensor >= EKF_SENSOR_COUNT || axis >= EKF_ADAPTIVE_MAX_DIM || !ekf->adaptive_noise) {
+        return 1.0f;
+    }
+    
+    return ekf->adaptive[sensor].scale[axis];
+}
+
 /**
  * @brief EKF 지구 자기장 벡터 설정
  */
 bool ekf_set_earth_magnetic_field(EKF *ekf, Vector3f mag_ned) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_SET_EARTH_MAGNETIC_FIELD, &mag_ned, sizeof(mag_ned), NULL, 0);
+        return ekf_call_exit(ekf, ekf_set_earth_magnetic_field(ekf, mag_ned));
+    }
+    
     if (ekf == NULL) {
         return false;
     }
@@ -224,14 +1278,9 @@ Vector3f ekf_get_position(const EKF *ekf) {
         return pos;
     }
     
-    float x, y, z;
-    matrix_get(&ekf->x, EKF_STATE_POS_X, 0, &x);
-    matrix_get(&ekf->x, EKF_STATE_POS_Y, 0, &y);
-    matrix_get(&ekf->x, EKF_STATE_POS_Z, 0, &z);
-    
-    pos.x = x;
-    pos.y = y;
-    pos.z = z;
+#if EKF_CONFIG_POSITION
+    pos = ekf->s.pos;
+#endif
     
     return pos;
 }
@@ -246,16 +1295,7 @@ Vector3f ekf_get_velocity(const EKF *ekf) {
         return vel;
     }
     
-    float vx, vy, vz;
-    matrix_get(&ekf->x, EKF_STATE_VEL_X, 0, &vx);
-    matrix_get(&ekf->x, EKF_STATE_VEL_Y, 0, &vy);
-    matrix_get(&ekf->x, EKF_STATE_VEL_Z, 0, &vz);
-    
-    vel.x = vx;
-    vel.y = vy;
-    vel.z = vz;
-    
-    return vel;
+    return ekf->s.vel;
 }
 
 /**
@@ -268,19 +1308,23 @@ Quaternion ekf_get_attitude(const EKF *ekf) {
         return q;
     }
     
-    float w, x, y, z;
-    matrix_get(&ekf->x, EKF_STATE_QUAT_W, 0, &w);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_X, 0, &x);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Y, 0, &y);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Z, 0, &z);
-    
-    q.w = w;
-    q.x = x;
-    q.y = y;
-    q.z = z;
+    // 상태의 사원수는 매 적분/갱신 뒤 재정규화되어 있음
+    return ekf->s.quat;
+}
+
+/**
+ * @brief 현재 자세의 회전 행렬
+ */
+const float (*ekf_epoch_rotation(EKF *ekf))[3] {
+    EKF_EpochCache *ep = &ekf->epoch;
+    Quaternion q = ekf->s.quat;
+    if (!ep->valid || ep->q.w != q.w || ep->q.x != q.x || ep->q.y != q.y || ep->q.z != q.z) {
+        quaternion_to_rotation_matrix(q, ep->R);
+        ep->q = q;
+        ep->valid = true;
+    }
     
-    // 정규화 (수치 오차 방지)
-    return quaternion_normalize(q);
+    return (const float (*)[3])ep->R;
 }
 
 /**
@@ -297,6 +1341,20 @@ bool ekf_get_euler(const EKF *ekf, float *roll, float *pitch, float *yaw) {
     return true;
 }
 
+/**
+ * @brief EKF 상태에서 오일러 각 추출 (고속 근사)
+ */
+bool ekf_get_euler_fast(const EKF *ekf, float *roll, float *pitch, float *yaw) {
+    if (ekf == NULL || !ekf->initialized || roll == NULL || pitch == NULL || yaw == NULL) {
+        return false;
+    }
+    
+    Quaternion q = ekf_get_attitude(ekf);
+    quaternion_to_euler_fast(q, roll, pitch, yaw);
+    
+    return true;
+}
+
 /**
  * @brief EKF 상태에서 자이로 바이어스 추출
  */
@@ -307,16 +1365,7 @@ Vector3f ekf_get_gyro_bias(const EKF *ekf) {
         return bias;
     }
     
-    float bx, by, bz;
-    matrix_get(&ekf->x, EKF_STATE_GYRO_BIAS_X, 0, &bx);
-    matrix_get(&ekf->x, EKF_STATE_GYRO_BIAS_Y, 0, &by);
-    matrix_get(&ekf->x, EKF_STATE_GYRO_BIAS_Z, 0, &bz);
-    
-    bias.x = bx;
-    bias.y = by;
-    bias.z = bz;
-    
-    return bias;
+    return ekf->s.bg;
 }
 
 /**
@@ -329,18 +1378,144 @@ Vector3f ekf_get_accel_bias(const EKF *ekf) {
         return bias;
     }
     
-    float bx, by, bz;
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_X, 0, &bx);
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_Y, 0, &by);
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_Z, 0, &bz);
+#if EKF_CONFIG_ACCEL_BIAS
+    bias = ekf->s.ba;
+#endif
+    
+    return bias;
+}
+
+/**
+ * @brief EKF 상태에서 자력계 바이어스 추출
+ */
+Vector3f ekf_get_mag_bias(const EKF *ekf) {
+    Vector3f bias = vector3f_zero();
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return bias;
+    }
     
-    bias.x = bx;
-    bias.y = by;
-    bias.z = bz;
+#if EKF_CONFIG_MAG_BIAS
+    bias = ekf->s.bm;
+#endif
     
     return bias;
 }
 
+/**
+ * @brief 항법 해 스냅샷 추출
+ */
+bool ekf_get_nav_solution(const EKF *ekf, uint32_t timestamp_us, EKF_NavSolution *sol) {
+    if (ekf == NULL || sol == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+    const float *x = &ekf->x.data[0][0];
+    
+    sol->timestamp_us = timestamp_us;
+#if EKF_CONFIG_POSITION
+    sol->pos = vector3f_create(x[EKF_STATE_POS_X], x[EKF_STATE_POS_Y], x[EKF_STATE_POS_Z]);
+#else
+    sol->pos = vector3f_zero();
+#endif
+    sol->vel = vector3f_create(x[EKF_STATE_VEL_X], x[EKF_STATE_VEL_Y], x[EKF_STATE_VEL_Z]);
+    
+    sol->q = quaternion_create(x[EKF_STATE_QUAT_W], x[EKF_STATE_QUAT_X], x[EKF_STATE_QUAT_Y], x[EKF_STATE_QUAT_Z]);
+    
+    sol->gyro_bias = vector3f_create(x[EKF_STATE_GYRO_BIAS_X], x[EKF_STATE_GYRO_BIAS_Y], x[EKF_STATE_GYRO_BIAS_Z]);
+#if EKF_CONFIG_ACCEL_BIAS
+    sol->accel_bias = vector3f_create(x[EKF_STATE_ACC_BIAS_X], x[EKF_STATE_ACC_BIAS_Y], x[EKF_STATE_ACC_BIAS_Z]);
+#else
+    sol->accel_bias = vector3f_zero();
+#endif
+    
+    ekf_predict_apogee(ekf, &sol->apogee_time, &sol->apogee_alt);
+    
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        sol->p_diag[i] = ekf->P.data[EKF_SYM_FN(index)(i, i)];
+    }
+    
+    uint8_t k = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = i; j < 4; j++) {
+            sol->p_quat[k++] = ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_QUAT_W + i, EKF_STATE_QUAT_W + j)];
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 항법 오차 공분산
+ */
+bool ekf_get_nav_error_covariance(const EKF *ekf, float P[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM]) {
+    if (ekf == NULL || P == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+    const float *x = &ekf->x.data[0][0];
+    Quaternion q = { x[EKF_STATE_QUAT_W], x[EKF_STATE_QUAT_X], x[EKF_STATE_QUAT_Y], x[EKF_STATE_QUAT_Z] };
+    float Xi[4][3];
+    quaternion_error_jacobian(q, Xi);
+    
+    // 오차 성분별 상태 인덱스 (회전각 행은 사원수 4개를 2 Xi^T로 묶음)
+#if EKF_CONFIG_POSITION
+    const uint8_t linear = 6;
+    const uint8_t idx[6] = { EKF_STATE_VEL_X, EKF_STATE_VEL_Y, EKF_STATE_VEL_Z,
+                             EKF_STATE_POS_X, EKF_STATE_POS_Y, EKF_STATE_POS_Z };
+#else
+    const uint8_t linear = 3;
+    const uint8_t idx[3] = { EKF_STATE_VEL_X, EKF_STATE_VEL_Y, EKF_STATE_VEL_Z };
+#endif
+    
+    // Pqq Xi (4x3), Pqv (4 x linear)
+    float PX[4][3];
+    float Pql[4][6];
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t a = 0; a < 3; a++) {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < 4; k++) {
+                sum += ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_QUAT_W + i, EKF_STATE_QUAT_W + k)] * Xi[k][a];
+            }
+            PX[i][a] = sum;
+        }
+        for (uint8_t b = 0; b < linear; b++) {
+            Pql[i][b] = ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_QUAT_W + i, idx[b])];
+        }
+    }
+    
+    memset(P, 0, sizeof(float) * EKF_NAV_ERROR_DIM * EKF_NAV_ERROR_DIM);
+    for (uint8_t a = 0; a < 3; a++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            float sum = 0.0f;
+            for (uint8_t i = 0; i < 4; i++) {
+                sum += Xi[i][a] * PX[i][c];
+            }
+            P[a][c] = 4.0f * sum;
+        }
+        for (uint8_t b = 0; b < linear; b++) {
+            float sum = 0.0f;
+            for (uint8_t i = 0; i < 4; i++) {
+                sum += Xi[i][a] * Pql[i][b];
+            }
+            P[a][3 + b] = 2.0f * sum;
+            P[3 + b][a] = P[a][3 + b];
+        }
+    }
+    for (uint8_t b = 0; b < linear; b++) {
+        for (uint8_t c = 0; c < linear; c++) {
+            P[3 + b][3 + c] = ekf->P.data[EKF_SYM_FN(index)(idx[b], idx[c])];
+        }
+    }
+#if !EKF_CONFIG_POSITION
+    P[6][6] = EKF_NAV_ERROR_UNKNOWN_VAR;
+    P[7][7] = EKF_NAV_ERROR_UNKNOWN_VAR;
+    P[8][8] = EKF_NAV_ERROR_UNKNOWN_VAR;
+#endif
+    
+    return true;
+}
+
 /**
  * @brief EKF 상태 리셋
  */
@@ -350,20 +1525,22 @@ bool ekf_reset(EKF *ekf) {
     }
     
     // 상태 벡터 초기화
-    matrix_zero(&ekf->x);
+    EKF_VEC_FN(zero)(&ekf->x);
     
     // 사원수 부분은 단위 사원수로 초기화
-    matrix_set(&ekf->x, EKF_STATE_QUAT_W, 0, 1.0f);
-    
-    // 공분산 행렬 초기화
-    float p_diag[EKF_STATE_DIM] = {
-        100.0f, 100.0f, 100.0f,  // 위치 불확실성 (m^2)
-        10.0f, 10.0f, 10.0f,     // 속도 불확실성 (m/s)^2
-        1.0f, 1.0f, 1.0f, 1.0f,  // 자세 불확실성
-        0.01f, 0.01f, 0.01f,     // 자이로 바이어스 불확실성 (rad/s)^2
-        0.1f, 0.1f, 0.1f         // 가속도 바이어스 불확실성 (m/s^2)^2
-    };
-    matrix_diagonal_vector(&ekf->P, p_diag, EKF_STATE_DIM);
+    ekf->s.quat.w = 1.0f;
+    ekf->quat_norm_error = 0.0f;
+    
+    // 공분산 행렬 초기화 (상태 목록의 리셋 분산)
+    float p_diag[EKF_STATE_DIM] = { EKF_STATE_LIST(EKF_STATE_P_RESET) };
+    EKF_SYM_FN(diagonal_vector)(&ekf->P, p_diag);
+    ekf->lazy_dt = 0.0f;
+    ekf->bias_pending = 0;
+    memset(ekf->bias_coupling, 0, sizeof(ekf->bias_coupling));
+    ekf_refactorize_covariance(ekf);
+    
+    // 혁신 통계는 리셋 전 상태 기준이므로 초기화
+    ekf_clear_adaptive_noise(ekf);
     
     ekf->initialized = false;
     
@@ -388,15 +1565,30 @@ bool ekf_initialize_magnetic_field(EKF *ekf, Vector3f *mag_samples, Vector3f *ac
 }
 
 /**
- * @brief 기본 자기장 값으로 초기화 (현장 측정이 불가능한 경우)
+ * @brief 스트리밍 추정기 결과로 자기장 벡터 초기화
  */
-bool ekf_initialize_default_magnetic_field(EKF *ekf) {
+bool ekf_initialize_magnetic_field_streaming(EKF *ekf, const EKF_MagFieldEstimator *est) {
     if (ekf == NULL) {
         return false;
     }
     
-    // 서울(37.5°N, 127°E) 기준 대략적인 값
-    ekf->earth_mag_ned = vector3f_create(0.29f, -0.05f, 0.42f);
+    return ekf_mag_field_finalize(est, &ekf->earth_mag_ned);
+}
+
+/**
+ * @brief 위치의 지구 자기장 모델 값으로 자기장 벡터 초기화
+ */
+bool ekf_initialize_magnetic_field_from_location(EKF *ekf, float lat_deg, float lon_deg) {
+    if (ekf == NULL) {
+        return false;
+    }
     
-    return true;
+    return ekf_wmm_get_field_ned(lat_deg, lon_deg, &ekf->earth_mag_ned);
+}
+
+/**
+ * @brief 기본 자기장 값으로 초기화 (현장 측정이 불가능한 경우)
+ */
+bool ekf_initialize_default_magnetic_field(EKF *ekf) {
+    return ekf_initialize_magnetic_field_from_location(ekf, EKF_WMM_DEFAULT_LAT_DEG, EKF_WMM_DEFAULT_LON_DEG);
 }
@@ -0,0 +1,283 @@
+/**
+ * @file ekf_lanes.c
+ * @brief 다중 IMU 중복 필터 레인 구현
+ */
+
+#include "ekf/ekf_lanes.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief 레인 상태 유한성 검사 (상태 합 한 번으로 NaN/Inf 검출)
+ */
+static bool ekf_lanes_state_finite(const EKF *ekf) {
+    const float *x = &ekf->x.data[0][0];
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        sum += x[i];
+    }
+
+    return isfinite(sum);
+}
+
+/**
+ * @brief 보조 레인 대기 샘플 일괄 예측
+ */
+static bool ekf_lanes_flush(EKF_Lanes *lanes, uint8_t i) {
+    uint8_t n = lanes->pending_count[i];
+    if (n == 0) {
+        return true;
+    }
+
+    lanes->pending_count[i] = 0;
+
+    return ekf_predict_batch(lanes->lane[i], lanes->pending[i], n);
+}
+
+/**
+ * @brief 주 레인 선택 (발산 시 즉시, 점수 열화 시 이력 현상을 두고 절체)
+ */
+static void ekf_lanes_select(EKF_Lanes *lanes) {
+    uint8_t best = lanes->count;
+    for (uint8_t i = 0; i < lanes->count; i++) {
+        if (lanes->healthy[i] && (best == lanes->count || lanes->score[i] < lanes->score[best])) {
+            best = i;
+        }
+    }
+
+    // 사용 가능한 레인이 없으면 주 레인 유지
+    if (best == lanes->count || best == lanes->primary) {
+        return;
+    }
+
+    uint8_t p = lanes->primary;
+    bool switch_lane = !lanes->healthy[p] ||
+                       (lanes->score[p] >= EKF_LANES_SWITCH_MIN &&
+                        lanes->score[p] > EKF_LANES_SWITCH_RATIO * lanes->score[best]);
+    if (!switch_lane) {
+        return;
+    }
+
+    // 새 주 레인은 샘플마다 예측하므로 대기 샘플을 먼저 반영
+    if (!ekf_lanes_flush(lanes, best)) {
+        lanes->healthy[best] = false;
+        return;
+    }
+
+    lanes->primary = best;
+    lanes->switch_count++;
+}
+
+/**
+ * @brief 레인 제외 후 주 레인 재선택
+ */
+static void ekf_lanes_fail(EKF_Lanes *lanes, uint8_t i) {
+    lanes->healthy[i] = false;
+    lanes->pending_count[i] = 0;
+    ekf_lanes_select(lanes);
+}
+
+/**
+ * @brief 갱신 결과로 건전성 점수 반영
+ */
+static void ekf_lanes_score(EKF_Lanes *lanes, uint8_t i, EKF_Sensor sensor) {
+    const EKF *ekf = lanes->lane[i];
+
+    if (!ekf_lanes_state_finite(ekf)) {
+        ekf_lanes_fail(lanes, i);
+        return;
+    }
+
+    float gate = ekf->nis_gate[sensor];
+    if (gate <= 0.0f) {
+        // 게이트가 없으면 검정비를 정할 수 없음
+        return;
+    }
+
+    float nis = ekf->nis_last[sensor];
+    float r = (nis <= EKF_LANES_RATIO_CAP * gate) ? nis / gate : EKF_LANES_RATIO_CAP;  // NaN 포함
+    lanes->score[i] += EKF_LANES_SCORE_GAIN * (r - lanes->score[i]);
+}
+
+/**
+ * @brief 모든 레인의 대기 샘플 반영 (측정 시각 정렬)
+ */
+static void ekf_lanes_flush_all(EKF_Lanes *lanes) {
+    for (uint8_t i = 0; i < lanes->count; i++) {
+        if (lanes->healthy[i] && !ekf_lanes_flush(lanes, i)) {
+            ekf_lanes_fail(lanes, i);
+        }
+    }
+}
+
+/**
+ * @brief 레인 묶음 초기화
+ */
+bool ekf_lanes_init(EKF_Lanes *lanes, EKF *const *filters, uint8_t count, uint8_t secondary_batch) {
+    if (lanes == NULL || filters == NULL || count == 0 || count > EKF_LANES_MAX ||
+        secondary_batch == 0 || secondary_batch > EKF_LANES_BATCH_MAX) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (filters[i] == NULL || !filters[i]->initialized) {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        lanes->lane[i] = filters[i];
+        lanes->healthy[i] = true;
+        lanes->score[i] = 0.0f;
+        lanes->pending_count[i] = 0;
+    }
+    lanes->count = count;
+    lanes->primary = 0;
+    lanes->secondary_batch = secondary_batch;
+    lanes->switch_count = 0;
+
+    return true;
+}
+
+/**
+ * @brief 레인 하나에 IMU 샘플 예측
+ */
+bool ekf_lanes_predict(EKF_Lanes *lanes, uint8_t lane, Vector3f gyro, Vector3f accel, float dt) {
+    if (lanes == NULL || lane >= lanes->count || !lanes->healthy[lane]) {
+        return false;
+    }
+
+    bool ok;
+    if (lane == lanes->primary) {
+        ok = ekf_predict(lanes->lane[lane], gyro, accel, dt);
+    } else {
+        // 보조 레인: 모아서 공분산을 한 번에 전파
+        EKF_ImuSample *s = &lanes->pending[lane][lanes->pending_count[lane]++];
+        s->gyro = gyro;
+        s->accel = accel;
+        s->dt = dt;
+        ok = lanes->pending_count[lane] < lanes->secondary_batch || ekf_lanes_flush(lanes, lane);
+    }
+
+    if (!ok || !ekf_lanes_state_finite(lanes->lane[lane])) {
+        ekf_lanes_fail(lanes, lane);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 모든 레인에 GPS 측정 갱신
+ */
+bool ekf_lanes_update_gps(EKF_Lanes *lanes, Vector3f gps_pos, bool use_vel, Vector3f gps_vel) {
+    if (lanes == NULL) {
+        return false;
+    }
+
+    ekf_lanes_flush_all(lanes);
+
+    EKF_Sensor sensor = use_vel ? EKF_SENSOR_GPS_POS_VEL : EKF_SENSOR_GPS_POS;
+    bool ok = false;
+    for (uint8_t i = 0; i < lanes->count; i++) {
+        if (!lanes->healthy[i]) {
+            continue;
+        }
+        bool r = ekf_update_gps(lanes->lane[i], gps_pos, use_vel, gps_vel);
+        if (i == lanes->primary) {
+            ok = r;
+        }
+        ekf_lanes_score(lanes, i, sensor);
+    }
+
+    ekf_lanes_select(lanes);
+
+    return ok;
+}
+
+/**
+ * @brief 모든 레인에 기압계 측정 갱신
+ */
+bool ekf_lanes_update_baro(EKF_Lanes *lanes, float baro_alt) {
+    if (lanes == NULL) {
+        return false;
+    }
+
+    ekf_lanes_flush_all(lanes);
+
+    bool ok = false;
+    for (uint8_t i = 0; i < lanes->count; i++) {
+        if (!lanes->healthy[i]) {
+            continue;
+        }
+        bool r = ekf_update_baro(lanes->lane[i], baro_alt);
+        if (i == lanes->primary) {
+            ok = r;
+        }
+        ekf_lanes_score(lanes, i, EKF_SENSOR_BARO);
+    }
+
+    ekf_lanes_select(lanes);
+
+    return ok;
+}
+
+/**
+ * @brief 모든 레인에 자력계 측정 갱신
+ */
+bool ekf_lanes_update_mag(EKF_Lanes *lanes, Vector3f mag) {
+    if (lanes == NULL) {
+        return false;
+    }
+
+    ekf_lanes_flush_all(lanes);
+
+    bool ok = false;
+    for (uint8_t i = 0; i < lanes->count; i++) {
+        if (!lanes->healthy[i]) {
+            continue;
+        }
+        bool r = ekf_update_mag(lanes->lane[i], mag);
+        if (i == lanes->primary) {
+            ok = r;
+        }
+        ekf_lanes_score(lanes, i, EKF_SENSOR_MAG);
+    }
+
+    ekf_lanes_select(lanes);
+
+    return ok;
+}
+
+/**
+ * @brief 주 레인 필터
+ */
+EKF *ekf_lanes_primary(const EKF_Lanes *lanes) {
+    if (lanes == NULL) {
+        return NULL;
+    }
+
+    return lanes->lane[lanes->primary];
+}
+
+/**
+ * @brief 주 레인 인덱스
+ */
+uint8_t ekf_lanes_get_primary_index(const EKF_Lanes *lanes) {
+    if (lanes == NULL) {
+        return 0;
+    }
+
+    return lanes->primary;
+}
+
+/**
+ * @brief 레인 건전성 점수
+ */
+float ekf_lanes_get_score(const EKF_Lanes *lanes, uint8_t lane) {
+    if (lanes == NULL || lane >= lanes->count || !lanes->healthy[lane]) {
+        return -1.0f;
+    }
+
+    return lanes->score[lane];
+}
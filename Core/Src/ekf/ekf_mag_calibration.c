@@ -4,6 +4,7 @@
  */
 
 #include "ekf/ekf_mag_calibration.h"
+#include "ekf/ekf_wmm.h"
 #include <math.h>
 #include <string.h>
 
@@ -12,31 +13,138 @@
  */
 Vector3f ekf_calibrate_magnetic_field(Vector3f *mag_samples, Vector3f *accel_samples, int sample_count) {
     if (mag_samples == NULL || accel_samples == NULL || sample_count <= 0) {
-        // 기본값 반환
-        return vector3f_create(0.29f, -0.05f, 0.42f);
+        // 기본 발사 지점의 모델 값 반환
+        Vector3f mag_ned;
+        ekf_wmm_get_field_ned(EKF_WMM_DEFAULT_LAT_DEG, EKF_WMM_DEFAULT_LON_DEG, &mag_ned);
+        return mag_ned;
     }
     
     // 평균 자력계 및 가속도계 측정값 계산
-    Vector3f avg_mag = vector3f_zero();
-    Vector3f avg_accel = vector3f_zero();
-    
+    EKF_MagFieldEstimator est;
+    ekf_mag_field_init(&est);
     for (int i = 0; i < sample_count; i++) {
-        avg_mag = vector3f_add(avg_mag, mag_samples[i]);
-        avg_accel = vector3f_add(avg_accel, accel_samples[i]);
+        ekf_mag_field_add_sample(&est, mag_samples[i], accel_samples[i]);
+    }
+    
+    Vector3f mag_ned;
+    ekf_mag_field_finalize(&est, &mag_ned);
+    
+    return mag_ned;
+}
+
+/**
+ * @brief 벡터 하나의 Welford 누적 (mean, m2 갱신)
+ * 
+ * @param mean 평균
+ * @param m2 축별 편차 제곱합
+ * @param v 새 샘플
+ * @param inv_n 1 / (누적 후 샘플 수)
+ */
+static void ekf_mag_field_accumulate(Vector3f *mean, Vector3f *m2, Vector3f v, float inv_n) {
+    float dx = v.x - mean->x;
+    float dy = v.y - mean->y;
+    float dz = v.z - mean->z;
+    
+    mean->x += dx * inv_n;
+    mean->y += dy * inv_n;
+    mean->z += dz * inv_n;
+    
+    // m2 += (v - mean_old) * (v - mean_new)
+    m2->x += dx * (v.x - mean->x);
+    m2->y += dy * (v.y - mean->y);
+    m2->z += dz * (v.z - mean->z);
+}
+
+/**
+ * @brief 스트리밍 추정기 초기화
+ */
+bool ekf_mag_field_init(EKF_MagFieldEstimator *est) {
+    if (est == NULL) {
+        return false;
+    }
+    
+    est->count = 0;
+    est->mag_mean = vector3f_zero();
+    est->mag_m2 = vector3f_zero();
+    est->accel_mean = vector3f_zero();
+    est->accel_m2 = vector3f_zero();
+    
+    return true;
+}
+
+/**
+ * @brief 자력계/가속도계 샘플 한 쌍 누적
+ */
+bool ekf_mag_field_add_sample(EKF_MagFieldEstimator *est, Vector3f mag, Vector3f accel) {
+    if (est == NULL) {
+        return false;
+    }
+    
+    est->count++;
+    float inv_n = 1.0f / (float)est->count;
+    
+    ekf_mag_field_accumulate(&est->mag_mean, &est->mag_m2, mag, inv_n);
+    ekf_mag_field_accumulate(&est->accel_mean, &est->accel_m2, accel, inv_n);
+    
+    return true;
+}
+
+/**
+ * @brief 현재까지의 추정 품질 계산
+ */
+bool ekf_mag_field_get_quality(const EKF_MagFieldEstimator *est, EKF_MagFieldQuality *quality) {
+    if (est == NULL || quality == NULL || est->count < 2) {
+        return false;
     }
     
-    avg_mag = vector3f_scale(avg_mag, 1.0f / (float)sample_count);
-    avg_accel = vector3f_scale(avg_accel, 1.0f / (float)sample_count);
+    // 표본 분산 (n - 1로 나눔)
+    float inv_n1 = 1.0f / (float)(est->count - 1);
+    float mag_var = (est->mag_m2.x + est->mag_m2.y + est->mag_m2.z) * inv_n1;
+    float accel_var = (est->accel_m2.x + est->accel_m2.y + est->accel_m2.z) * inv_n1;
+    
+    quality->count = est->count;
+    quality->mag_std = sqrtf(mag_var);
+    quality->accel_std = sqrtf(accel_var);
+    
+    // 평균의 표준 오차 / 평균 크기 = 방향 오차 (소각 근사)
+    float sqrt_n = sqrtf((float)est->count);
+    float mag_norm = vector3f_magnitude(est->mag_mean);
+    float accel_norm = vector3f_magnitude(est->accel_mean);
+    float mag_dir = (mag_norm > 1e-6f) ? quality->mag_std / (sqrt_n * mag_norm) : INFINITY;
+    float accel_dir = (accel_norm > 1e-6f) ? quality->accel_std / (sqrt_n * accel_norm) : INFINITY;
+    quality->direction_stderr = (mag_dir > accel_dir) ? mag_dir : accel_dir;
+    
+    return true;
+}
+
+/**
+ * @brief 충분한 샘플이 모였는지 판정
+ */
+bool ekf_mag_field_is_ready(const EKF_MagFieldEstimator *est, uint32_t min_samples, float max_direction_stderr) {
+    EKF_MagFieldQuality quality;
+    if (!ekf_mag_field_get_quality(est, &quality)) {
+        return false;
+    }
+    
+    return quality.count >= min_samples && quality.direction_stderr <= max_direction_stderr;
+}
+
+/**
+ * @brief 누적된 평균으로 NED 좌표계 자기장 단위 벡터 계산
+ */
+bool ekf_mag_field_finalize(const EKF_MagFieldEstimator *est, Vector3f *mag_ned) {
+    if (est == NULL || mag_ned == NULL || est->count == 0) {
+        return false;
+    }
     
     // 가속도계로부터 본체->NED 좌표계 변환 행렬 계산
     float dcm[9];
-    ekf_compute_ned_transform(avg_accel, dcm);
+    ekf_compute_ned_transform(est->accel_mean, dcm);
     
-    // 자력계 데이터를 NED 좌표계로 변환
-    Vector3f mag_ned = ekf_convert_to_ned(avg_mag, dcm);
+    // 자력계 데이터를 NED 좌표계로 변환 후 정규화
+    *mag_ned = vector3f_normalize(ekf_convert_to_ned(est->mag_mean, dcm));
     
-    // 정규화
-    return vector3f_normalize(mag_ned);
+    return true;
 }
 
 /**
@@ -4,106 +4,566 @@
  */
 
 #include "ekf/ekf.h"
+#include "ekf/ekf_generated.h"
+#include "sys/profile.h"
+#include "sys/mem_section.h"
+#include <stddef.h>
+#include <string.h>
 #include <math.h>
 
+/**
+ * @brief 자세-자이로 바이어스 블록 자코비안 기록
+ * 
+ * 사원수 업데이트 식: q_dot = 0.5 * q ⊗ (ω - b_ω)
+ * 여기서 -0.5 * q ⊗ b_ω는 q_dot에 대한 자이로 바이어스의 편미분을 나타냄
+ * 블록 값은 생성 커널(ekf_gen_attitude_transition)로 계산한다.
+ * 
+ * @param F 자코비안 행렬 (희소 상태 전이 행렬, 초기화된 상태)
+ * @param q 적분 후 단위 자세 사원수
+ * @param dt 시간 간격 (초)
+ */
+MEM_RAMFUNC(ekf_add_attitude_jacobian)
+static void ekf_add_attitude_jacobian(MatrixSparseTransition *F, Quaternion q, float dt) {
+    const float qa[4] = { q.w, q.x, q.y, q.z };
+    float Fq[4][3];
+    ekf_gen_attitude_transition(qa, dt, Fq);
+    
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            matrix_sparse_transition_add(F, EKF_STATE_QUAT_W + i, EKF_STATE_GYRO_BIAS_X + j, Fq[i][j]);
+        }
+    }
+}
+
+#if EKF_CONFIG_GNSS_CLOCK
+/**
+ * @brief 수신기 시계 적분과 전이 행렬 기록 (바이어스 변화율 = 드리프트)
+ * 
+ * 시계는 기체 운동과 무관하게 흐르므로 모든 예측 경로에서 함께 전파한다.
+ * 
+ * @param x 상태 배열 (시계 바이어스 갱신)
+ * @param F 희소 상태 전이 행렬 (NULL이면 적분만)
+ * @param dt 시간 간격 (초)
+ */
+MEM_RAMFUNC(ekf_propagate_clock)
+static void ekf_propagate_clock(float *x, MatrixSparseTransition *F, float dt) {
+    x[EKF_STATE_CLK_BIAS] += x[EKF_STATE_CLK_DRIFT] * dt;
+    
+    if (F != NULL) {
+        matrix_sparse_transition_add(F, EKF_STATE_CLK_BIAS, EKF_STATE_CLK_DRIFT, dt);
+    }
+}
+#endif
+
 /**
  * @brief 자코비안 행렬 계산 (상태 전이 행렬)
  * 
+ * F = I + E 에서 0이 아닌 E 원소(위치-속도, 사원수-자이로 바이어스,
+ * 속도-가속도 바이어스, 시계 바이어스-드리프트 블록)만 희소 형태로 기록한다. 구성에서 제외된
+ * 상태 블록(ekf_config.h)의 원소는 기록하지 않는다.
+ * 사원수와 회전 행렬은 상태 적분에서 구한 값을 그대로 사용한다.
+ * 
+ * @param F 자코비안 행렬 (희소 상태 전이 행렬)
+ * @param q 적분 후 단위 자세 사원수
+ * @param R q의 회전 행렬 (몸체 -> NED)
+ * @param dt 시간 간격 (초)
+ */
+MEM_RAMFUNC(ekf_compute_jacobian)
+static void ekf_compute_jacobian(MatrixSparseTransition *F, Quaternion q, const float R[3][3], float dt) {
+    // 자코비안 행렬 초기화 (단위 행렬로)
+    matrix_sparse_transition_clear(F);
+    
+#if EKF_CONFIG_POSITION
+    // 위치-속도 관계 (위치 변화율 = 속도)
+    matrix_sparse_transition_add(F, EKF_STATE_POS_X, EKF_STATE_VEL_X, dt);
+    matrix_sparse_transition_add(F, EKF_STATE_POS_Y, EKF_STATE_VEL_Y, dt);
+    matrix_sparse_transition_add(F, EKF_STATE_POS_Z, EKF_STATE_VEL_Z, dt);
+#endif
+    
+    // 자이로 바이어스-자세 관계
+    ekf_add_attitude_jacobian(F, q, dt);
+    
+#if EKF_CONFIG_ACCEL_BIAS
+    // 가속도 바이어스가 속도에 미치는 영향 (-R * dt)
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            matrix_sparse_transition_add(F, EKF_STATE_VEL_X + i, EKF_STATE_ACC_BIAS_X + j, -R[i][j] * dt);
+        }
+    }
+#else
+    (void)R;
+#endif
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    // 시계 바이어스-드리프트 관계
+    matrix_sparse_transition_add(F, EKF_STATE_CLK_BIAS, EKF_STATE_CLK_DRIFT, dt);
+#endif
+}
+
+/**
+ * @brief 자세 적분 (지수 사상, 바이어스 보정)
+ * 
+ * @param x 상태 배열 (자세 원소 갱신)
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param dt 시간 간격 (초)
+ * @param norm_error 적분 후 노름 오차 한계 (출력)
+ * @return Quaternion 적분 후 단위 자세 사원수
+ */
+MEM_RAMFUNC(ekf_integrate_attitude)
+static Quaternion ekf_integrate_attitude(float *x, Vector3f gyro, float dt, float *norm_error) {
+    // 바이어스 보정된 자이로
+    Vector3f gyro_corrected = vector3f_create(
+        gyro.x - x[EKF_STATE_GYRO_BIAS_X],
+        gyro.y - x[EKF_STATE_GYRO_BIAS_Y],
+        gyro.z - x[EKF_STATE_GYRO_BIAS_Z]
+    );
+    
+    // 몸체 좌표계 회전 증분을 오른쪽에 곱함
+    Quaternion q = quaternion_create(x[EKF_STATE_QUAT_W], x[EKF_STATE_QUAT_X],
+                                     x[EKF_STATE_QUAT_Y], x[EKF_STATE_QUAT_Z]);
+    Quaternion dq = quaternion_from_rotation_vector(vector3f_scale(gyro_corrected, dt));
+    q = quaternion_multiply(q, dq);
+    
+    // 반올림 오차 보정: 1/|q| ~= (3 - |q|^2) / 2 (|q| ~= 1, 한계를 넘을 때만 전체 정규화)
+    q = quaternion_renormalize(q, norm_error);
+    
+    x[EKF_STATE_QUAT_W] = q.w;
+    x[EKF_STATE_QUAT_X] = q.x;
+    x[EKF_STATE_QUAT_Y] = q.y;
+    x[EKF_STATE_QUAT_Z] = q.z;
+    
+    return q;
+}
+
+/**
+ * @brief 명목 상태 적분 (자세, 속도, 위치)
+ * 
+ * 자세는 지수 사상으로 정확히 적분한다: q = q ⊗ exp((ω - b_ω) * dt / 2).
+ * 상태의 사원수는 항상 정규화되어 있으므로 적분 전 정규화는 생략하고,
+ * 적분 후 누적 반올림 오차만 1차 보정(sqrt 없음)으로 제거한다.
+ * 적분 후 자세의 회전 행렬을 한 번 구해 에포크 캐시(ekf->epoch)에 두고 가속도 변환,
+ * 자코비안, 같은 에포크의 측정 갱신이 함께 사용한다.
+ * 
  * @param ekf EKF 구조체 포인터
- * @param F 자코비안 행렬 (상태 전이 행렬)
+ * @param gyro 자이로 측정값 (rad/s)
+ * @param accel 가속도 측정값 (m/s^2)
  * @param dt 시간 간격 (초)
- * @return bool 계산 성공 여부
+ * @param q_out 적분 후 자세 사원수 (NULL 가능)
+ */
+MEM_RAMFUNC(ekf_integrate_state)
+static void ekf_integrate_state(EKF *ekf, Vector3f gyro, Vector3f accel, float dt, Quaternion *q_out) {
+    // 정보 형식 누적분은 누적 시각의 상태에 먼저 반영
+    if (ekf->info.open) {
+        ekf_info_apply(ekf);
+    }
+    
+    float *x = &ekf->x.data[0][0];
+    ekf->gyro_last = gyro;
+    ekf->gate_clock_us += (uint32_t)(dt * 1e6f + 0.5f);
+    
+    // 바이어스 보정된 가속도 계산
+#if EKF_CONFIG_ACCEL_BIAS
+    Vector3f accel_corrected = vector3f_create(
+        accel.x - x[EKF_STATE_ACC_BIAS_X],
+        accel.y - x[EKF_STATE_ACC_BIAS_Y],
+        accel.z - x[EKF_STATE_ACC_BIAS_Z]
+    );
+#else
+    Vector3f accel_corrected = accel;
+#endif
+    
+    // 1. 사원수 적분 (자세 원소는 여기서 갱신됨)
+    Quaternion q = ekf_integrate_attitude(x, gyro, dt, &ekf->quat_norm_error);
+    
+    // 2. 회전 행렬 (가속도 변환, 자코비안, 같은 에포크의 측정 갱신 공용)
+    float (*R)[3] = ekf->epoch.R;
+    quaternion_to_rotation_matrix(q, R);
+    ekf->epoch.q = q;
+    ekf->epoch.valid = true;
+    
+    // 3. 가속도를 NED 좌표계로 변환하고 중력 보정
+    float an = R[0][0] * accel_corrected.x + R[0][1] * accel_corrected.y + R[0][2] * accel_corrected.z;
+    float ae = R[1][0] * accel_corrected.x + R[1][1] * accel_corrected.y + R[1][2] * accel_corrected.z;
+    float ad = R[2][0] * accel_corrected.x + R[2][1] * accel_corrected.y + R[2][2] * accel_corrected.z
+             - ekf->gravity;
+    
+    // 4. 속도 적분
+    x[EKF_STATE_VEL_X] += an * dt;
+    x[EKF_STATE_VEL_Y] += ae * dt;
+    x[EKF_STATE_VEL_Z] += ad * dt;
+    
+#if EKF_CONFIG_POSITION
+    // 5. 위치 적분 (Kahan 보상 합산)
+    // 수 km에서 float 위치의 ulp는 mm 단위라 1 kHz 증분 v*dt의 하위 비트가 매번 잘린다.
+    // 잘린 양을 pos_comp에 두고 다음 증분에서 되돌리므로 누적 오차가 샘플 수에 비례해
+    // 커지지 않는다 (재결합 최적화가 이 식을 지우지 않도록 -ffast-math 없이 빌드).
+    for (uint8_t i = 0; i < 3; i++) {
+        float inc = x[EKF_STATE_VEL_X + i] * dt - ekf->pos_comp[i];
+        float sum = x[EKF_STATE_POS_X + i] + inc;
+        ekf->pos_comp[i] = (sum - x[EKF_STATE_POS_X + i]) - inc;
+        x[EKF_STATE_POS_X + i] = sum;
+    }
+#endif
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    // 6. 수신기 시계 적분
+    ekf_propagate_clock(x, NULL, dt);
+#endif
+    
+    if (q_out != NULL) {
+        *q_out = q;
+    }
+    
+    // 바이어스는 변경하지 않음 (측정 갱신 단계에서 조정)
+}
+
+/**
+ * @brief 구간 길이 dt의 이산 프로세스 노이즈 계산 (같은 dt이면 캐시 사용)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param dt 전이 구간 길이 (초)
+ * @return const EKF_DiscreteNoise* 이산 프로세스 노이즈
+ */
+MEM_RAMFUNC(ekf_discrete_noise)
+static const EKF_DiscreteNoise *ekf_discrete_noise(EKF *ekf, float dt) {
+    EKF_DiscreteNoise *qd = &ekf->Qd;
+    if (qd->dt == dt) {
+        return qd;
+    }
+    
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        qd->diag[i] = ekf->Q.data[EKF_SYM_FN(index)(i, i)] * dt;
+    }
+    // 가속도 포화/혼합 구간의 추가 속도 잡음
+    for (uint8_t i = 0; i < 3; i++) {
+        qd->diag[EKF_STATE_VEL_X + i] += ekf->vel_noise_inflation * dt;
+    }
+    
+    float dt2 = dt * dt;
+#if EKF_CONFIG_POSITION
+    // 위치 = 속도 적분: 속도 잡음이 위치 분산과 위치-속도 상관으로 들어감
+    for (uint8_t i = 0; i < 3; i++) {
+        float q_v = ekf->Q.data[EKF_SYM_FN(index)(EKF_STATE_VEL_X + i, EKF_STATE_VEL_X + i)] +
+                    ekf->vel_noise_inflation;
+        qd->diag[EKF_STATE_POS_X + i] += q_v * dt2 * dt * (1.0f / 3.0f);
+        qd->pos_vel[i] = q_v * dt2 * 0.5f;
+    }
+#endif
+#if EKF_CONFIG_GNSS_CLOCK
+    // 시계 바이어스 = 드리프트 적분
+    float q_d = ekf->Q.data[EKF_SYM_FN(index)(EKF_STATE_CLK_DRIFT, EKF_STATE_CLK_DRIFT)];
+    qd->diag[EKF_STATE_CLK_BIAS] += q_d * dt2 * dt * (1.0f / 3.0f);
+    qd->clk = q_d * dt2 * 0.5f;
+#endif
+#if EKF_CONFIG_MAG_BIAS
+    // 자력계 바이어스 추정이 꺼져 있으면 분산을 키우지 않음
+    if (!ekf->mag_bias_enabled) {
+        for (uint8_t i = 0; i < 3; i++) {
+            qd->diag[EKF_STATE_MAG_BIAS_X + i] = 0.0f;
+        }
+    }
+#endif
+    (void)dt2;
+    qd->dt = dt;
+    
+    return qd;
+}
+
+/**
+ * @brief 이산 프로세스 노이즈를 P의 해당 원소에만 더함
+ */
+MEM_RAMFUNC(ekf_add_discrete_noise)
+static void ekf_add_discrete_noise(EKF_StateCovariance *P, const EKF_DiscreteNoise *qd) {
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        P->data[EKF_SYM_FN(index)(i, i)] += qd->diag[i];
+    }
+#if EKF_CONFIG_POSITION
+    for (uint8_t i = 0; i < 3; i++) {
+        P->data[EKF_SYM_FN(index)(EKF_STATE_POS_X + i, EKF_STATE_VEL_X + i)] += qd->pos_vel[i];
+    }
+#endif
+#if EKF_CONFIG_GNSS_CLOCK
+    P->data[EKF_SYM_FN(index)(EKF_STATE_CLK_BIAS, EKF_STATE_CLK_DRIFT)] += qd->clk;
+#endif
+}
+
+/**
+ * @brief 공분산 전파 (P = F * P * F^T + Qd)
+ * 
+ * U-D 엔진에서는 Qd의 대각 원소만 사용하여 Thornton 전파 후 P를 복원한다.
+ * 큰 임시 행렬은 EKF 스크래치 영역에서 할당한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param F 희소 상태 전이 행렬
+ * @param dt 전이 구간 길이 (초, 0이면 노이즈 없이 전이만 적용)
+ * @return bool 전파 성공 여부 (스크래치 영역 부족 시 false, P 변경 없음)
  */
-static bool ekf_compute_jacobian(EKF *ekf, Matrix *F, float dt) {
-    if (ekf == NULL || F == NULL) {
+MEM_RAMFUNC(ekf_propagate_covariance)
+static bool ekf_propagate_covariance(EKF *ekf, const MatrixSparseTransition *F, float dt) {
+    static const float no_noise[EKF_STATE_DIM] = { 0.0f };
+    ScratchArena *scratch = ekf->scratch;
+    const EKF_DiscreteNoise *qd = (dt > 0.0f) ? ekf_discrete_noise(ekf, dt) : NULL;
+    
+    if (ekf->engine == EKF_ENGINE_UD) {
+        uint32_t mark = scratch_mark(scratch);
+        float *work = scratch_alloc(scratch, sizeof(float) * MATRIX_UD_PROPAGATE_WORK_SIZE(EKF_STATE_DIM));
+        if (work == NULL) {
+            return false;
+        }
+        
+        // Thornton 전파는 대각 잡음만 받으므로 교차 항 없이 대각 원소 사용
+        EKF_UD_FN(propagate_sparse)(&ekf->UD, F, (qd != NULL) ? qd->diag : no_noise, work);
+        EKF_UD_FN(to_sym)(&ekf->UD, &ekf->P);
+        
+        scratch_release(scratch, mark);
+        if (ekf->transition_observer != NULL) {
+            ekf->transition_observer(ekf->transition_context, F, dt);
+        }
+        return true;
+    }
+    
+#ifdef EKF_REFERENCE_COVARIANCE_PREDICT
+    // 참조 경로: 밀집 F로 전개하여 일반 전파
+    uint32_t mark = scratch_mark(scratch);
+    EKF_StateMatrix *F_dense = scratch_alloc(scratch, sizeof(EKF_StateMatrix));
+    EKF_StateCovariance *P_new = scratch_alloc(scratch, sizeof(EKF_StateCovariance));
+    if (F_dense == NULL || P_new == NULL) {
+        scratch_release(scratch, mark);
         return false;
     }
+    matrix_sparse_transition_to_dense(F, &F_dense->data[0][0], EKF_STATE_DIM);
+    
+    EKF_SYM_FN(propagate)(F_dense, &ekf->P, P_new);
+    ekf->P = *P_new;
+    scratch_release(scratch, mark);
+#else
+    // F의 비영 블록만 적용하여 제자리 전파
+    (void)scratch;
+    EKF_SYM_FN(propagate_sparse)(&ekf->P, F);
+#endif
+    
+    // 이산 프로세스 노이즈는 비영 원소만 더함
+    if (qd != NULL) {
+        ekf_add_discrete_noise(&ekf->P, qd);
+    }
     
-    // 자코비안 행렬 초기화 (단위 행렬로)
-    *F = matrix_identity(EKF_STATE_DIM);
+    // 상태별 분산 경계 (GNSS 없는 위치 분산 상한 등)
+    if (ekf->variance_bounds) {
+        ekf->variance_bound_count += EKF_SYM_FN(bound_diagonal)(&ekf->P, ekf->variance_min, ekf->variance_max);
+    }
     
-    // 위치-속도 관계 (위치 변화율 = 속도)
-    matrix_set(F, EKF_STATE_POS_X, EKF_STATE_VEL_X, dt);
-    matrix_set(F, EKF_STATE_POS_Y, EKF_STATE_VEL_Y, dt);
-    matrix_set(F, EKF_STATE_POS_Z, EKF_STATE_VEL_Z, dt);
-    
-    // 현재 자세 사원수 추출
-    float qw, qx, qy, qz;
-    matrix_get(&ekf->x, EKF_STATE_QUAT_W, 0, &qw);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_X, 0, &qx);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Y, 0, &qy);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Z, 0, &qz);
-    
-    // 현재 속도 추출
-    float vx, vy, vz;
-    matrix_get(&ekf->x, EKF_STATE_VEL_X, 0, &vx);
-    matrix_get(&ekf->x, EKF_STATE_VEL_Y, 0, &vy);
-    matrix_get(&ekf->x, EKF_STATE_VEL_Z, 0, &vz);
-    
-    // 현재 가속도 바이어스 추출
-    float bax, bay, baz;
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_X, 0, &bax);
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_Y, 0, &bay);
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_Z, 0, &baz);
-    
-    // 자세 사원수 정규화
-    float qnorm = sqrtf(qw*qw + qx*qx + qy*qy + qz*qz);
-    if (qnorm < 1e-6f) {
-        qw = 1.0f;
-        qx = qy = qz = 0.0f;
+    if (ekf->transition_observer != NULL) {
+        ekf->transition_observer(ekf->transition_context, F, dt);
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 누적 바이어스 결합을 P에 반영 (P = T * P * T^T, T = [[I, Bc], [0, I]])
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 성공 여부 (실패 시 누적분 유지)
+ */
+MEM_RAMFUNC(ekf_flush_bias_coupling)
+static bool ekf_flush_bias_coupling(EKF *ekf) {
+    if (ekf->bias_pending == 0) {
+        return true;
+    }
+    
+    MatrixSparseTransition T;
+    matrix_sparse_transition_clear(&T);
+    for (uint8_t i = 0; i < EKF_PARTITION_CORE_DIM; i++) {
+        for (uint8_t j = 0; j < EKF_PARTITION_BIAS_DIM; j++) {
+            float v = ekf->bias_coupling[i][j];
+            if (v != 0.0f && !matrix_sparse_transition_add(&T, i, EKF_STATE_GYRO_BIAS_X + j, v)) {
+                return false;
+            }
+        }
+    }
+    
+    if (!ekf_propagate_covariance(ekf, &T, 0.0f)) {
+        return false;
+    }
+    memset(ekf->bias_coupling, 0, sizeof(ekf->bias_coupling));
+    ekf->bias_pending = 0;
+    
+    return true;
+}
+
+/**
+ * @brief 분할 공분산 전파 (핵심 블록 전이는 즉시, 바이어스 결합은 누적)
+ * 
+ * Φ = [[I, B], [0, I]] * [[A, 0], [0, I]] 에서 A(바이어스가 아닌 열의 원소)와 노이즈는
+ * 곧바로 P에 적용하고, 이전 누적분을 A로 옮긴 뒤 B를 더한다 (Bc = A * Bc + B).
+ * P에는 반영 전 공분산 T^-1 P T^-T (T = [[I, Bc], [0, I]])가 들어 있으므로 노이즈도
+ * T^-1 Q T^-T로 더해야 한다. 그중 1차 교차 항 -Bc * Qb만 반영한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param F 희소 상태 전이 행렬 (바이어스 행은 단위 행)
+ * @param dt 전이 구간 길이 (초)
+ * @return bool 성공 여부
+ */
+MEM_RAMFUNC(ekf_propagate_partitioned)
+static bool ekf_propagate_partitioned(EKF *ekf, const MatrixSparseTransition *F, float dt) {
+    MatrixSparseTransition A;
+    matrix_sparse_transition_clear(&A);
+    for (uint8_t r = 0; r < F->count; r++) {
+        const MatrixSparseRow *e = &F->e[r];
+        for (uint8_t k = 0; k < e->count; k++) {
+            uint8_t col = e->index[k];
+            bool bias = col >= EKF_STATE_GYRO_BIAS_X && col < EKF_STATE_GYRO_BIAS_X + EKF_PARTITION_BIAS_DIM;
+            if (!bias) {
+                matrix_sparse_transition_add(&A, F->row[r], col, e->value[k]);
+            }
+        }
+    }
+    
+    if (!ekf_propagate_covariance(ekf, &A, dt)) {
+        return false;
+    }
+    
+    // Bc = A * Bc + B (A = I + E_A, E_A는 핵심 행/열에만 있음, 이전 값 기준)
+    float prev[EKF_PARTITION_CORE_DIM][EKF_PARTITION_BIAS_DIM];
+    memcpy(prev, ekf->bias_coupling, sizeof(prev));
+    for (uint8_t r = 0; r < F->count; r++) {
+        uint8_t row = F->row[r];
+        if (row >= EKF_PARTITION_CORE_DIM) {
+            continue;
+        }
+        const MatrixSparseRow *e = &F->e[r];
+        for (uint8_t k = 0; k < e->count; k++) {
+            uint8_t col = e->index[k];
+            if (col < EKF_PARTITION_CORE_DIM) {
+                for (uint8_t j = 0; j < EKF_PARTITION_BIAS_DIM; j++) {
+                    ekf->bias_coupling[row][j] += e->value[k] * prev[col][j];
+                }
+            } else if (col >= EKF_STATE_GYRO_BIAS_X && col < EKF_STATE_GYRO_BIAS_X + EKF_PARTITION_BIAS_DIM) {
+                ekf->bias_coupling[row][col - EKF_STATE_GYRO_BIAS_X] += e->value[k];
+            }
+        }
+    }
+    
+    // 노이즈는 T^-1 Q T^-T로 더해야 함: 교차 항 -Bc * Qb만 반영 (Bc Qb Bc^T는 2차 항으로 무시)
+    const EKF_DiscreteNoise *qd = ekf_discrete_noise(ekf, dt);
+    for (uint8_t i = 0; i < EKF_PARTITION_CORE_DIM; i++) {
+        for (uint8_t j = 0; j < EKF_PARTITION_BIAS_DIM; j++) {
+            uint8_t b = EKF_STATE_GYRO_BIAS_X + j;
+            ekf->P.data[EKF_SYM_FN(index)(i, b)] -= ekf->bias_coupling[i][j] * qd->diag[b];
+        }
+    }
+    
+    if (++ekf->bias_pending >= ekf->bias_decimation) {
+        return ekf_flush_bias_coupling(ekf);
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 공분산 전파 또는 지연 누적
+ * 
+ * 지연 전파 중이면 F를 누적 전이에 곱해 두고, 누적 구간이 최대 구간에 이르거나
+ * 희소 용량을 넘으면 그때 P에 반영한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param F 희소 상태 전이 행렬
+ * @param dt 전이 구간 길이 (초)
+ * @return bool 성공 여부
+ */
+MEM_RAMFUNC(ekf_propagate_or_defer)
+static bool ekf_propagate_or_defer(EKF *ekf, const MatrixSparseTransition *F, float dt) {
+    // 정상 상태 게인 고정 중에는 P를 쓰지 않으므로 전파 생략
+    if (ekf->steady_frozen) {
+        return true;
+    }
+    
+    if (!ekf->lazy_covariance) {
+        if (ekf->bias_decimation > 1 && ekf->engine != EKF_ENGINE_UD) {
+            return ekf_propagate_partitioned(ekf, F, dt);
+        }
+        return ekf_propagate_covariance(ekf, F, dt);
+    }
+    
+    // 분할 전파 누적분이 남아 있으면 먼저 반영 (두 누적이 섞이지 않도록)
+    if (!ekf_flush_bias_coupling(ekf)) {
+        return false;
+    }
+    
+    MatrixSparseTransition phi_next;
+    if (ekf->lazy_dt <= 0.0f) {
+        ekf->lazy_phi = *F;
+        ekf->lazy_dt = dt;
+    } else if (matrix_sparse_transition_compose(F, &ekf->lazy_phi, &phi_next)) {
+        ekf->lazy_phi = phi_next;
+        ekf->lazy_dt += dt;
     } else {
-        qw /= qnorm;
-        qx /= qnorm;
-        qy /= qnorm;
-        qz /= qnorm;
+        // 희소 용량 초과 시 지금까지 누적분을 반영하고 새로 누적
+        if (!ekf_flush_covariance(ekf)) {
+            return false;
+        }
+        ekf->lazy_phi = *F;
+        ekf->lazy_dt = dt;
     }
     
-    // 자세-속도 관계 (회전 행렬의 영향)
-    // 이 부분은 가속도가 자세에 따라 어떻게 변환되는지를 나타냄
-    // 사원수 업데이트 식: q_dot = 0.5 * q ⊗ (ω - b_ω)
-    // 여기서 -0.5 * q ⊗ b_ω는 q_dot에 대한 자세 바이어스의 편미분을 나타냄
+    if (ekf->lazy_dt >= ekf->lazy_max_dt) {
+        return ekf_flush_covariance(ekf);
+    }
     
-    // 자이로 바이어스-자세 관계
-    matrix_set(F, EKF_STATE_QUAT_W, EKF_STATE_GYRO_BIAS_X, -0.5f * qx * dt);
-    matrix_set(F, EKF_STATE_QUAT_W, EKF_STATE_GYRO_BIAS_Y, -0.5f * qy * dt);
-    matrix_set(F, EKF_STATE_QUAT_W, EKF_STATE_GYRO_BIAS_Z, -0.5f * qz * dt);
-    
-    matrix_set(F, EKF_STATE_QUAT_X, EKF_STATE_GYRO_BIAS_X, 0.5f * qw * dt);
-    matrix_set(F, EKF_STATE_QUAT_X, EKF_STATE_GYRO_BIAS_Y, -0.5f * qz * dt);
-    matrix_set(F, EKF_STATE_QUAT_X, EKF_STATE_GYRO_BIAS_Z, 0.5f * qy * dt);
-    
-    matrix_set(F, EKF_STATE_QUAT_Y, EKF_STATE_GYRO_BIAS_X, 0.5f * qz * dt);
-    matrix_set(F, EKF_STATE_QUAT_Y, EKF_STATE_GYRO_BIAS_Y, 0.5f * qw * dt);
-    matrix_set(F, EKF_STATE_QUAT_Y, EKF_STATE_GYRO_BIAS_Z, -0.5f * qx * dt);
-    
-    matrix_set(F, EKF_STATE_QUAT_Z, EKF_STATE_GYRO_BIAS_X, -0.5f * qy * dt);
-    matrix_set(F, EKF_STATE_QUAT_Z, EKF_STATE_GYRO_BIAS_Y, 0.5f * qx * dt);
-    matrix_set(F, EKF_STATE_QUAT_Z, EKF_STATE_GYRO_BIAS_Z, 0.5f * qw * dt);
-    
-    // 가속도 바이어스-속도 관계
-    // 회전 행렬 요소 계산 (사원수에서 회전 행렬로 변환)
-    float R11 = 1.0f - 2.0f * (qy*qy + qz*qz);
-    float R12 = 2.0f * (qx*qy - qw*qz);
-    float R13 = 2.0f * (qx*qz + qw*qy);
-    float R21 = 2.0f * (qx*qy + qw*qz);
-    float R22 = 1.0f - 2.0f * (qx*qx + qz*qz);
-    float R23 = 2.0f * (qy*qz - qw*qx);
-    float R31 = 2.0f * (qx*qz - qw*qy);
-    float R32 = 2.0f * (qy*qz + qw*qx);
-    float R33 = 1.0f - 2.0f * (qx*qx + qy*qy);
-    
-    // 가속도 바이어스가 속도에 미치는 영향
-    matrix_set(F, EKF_STATE_VEL_X, EKF_STATE_ACC_BIAS_X, -R11 * dt);
-    matrix_set(F, EKF_STATE_VEL_X, EKF_STATE_ACC_BIAS_Y, -R12 * dt);
-    matrix_set(F, EKF_STATE_VEL_X, EKF_STATE_ACC_BIAS_Z, -R13 * dt);
-    
-    matrix_set(F, EKF_STATE_VEL_Y, EKF_STATE_ACC_BIAS_X, -R21 * dt);
-    matrix_set(F, EKF_STATE_VEL_Y, EKF_STATE_ACC_BIAS_Y, -R22 * dt);
-    matrix_set(F, EKF_STATE_VEL_Y, EKF_STATE_ACC_BIAS_Z, -R23 * dt);
-    
-    matrix_set(F, EKF_STATE_VEL_Z, EKF_STATE_ACC_BIAS_X, -R31 * dt);
-    matrix_set(F, EKF_STATE_VEL_Z, EKF_STATE_ACC_BIAS_Y, -R32 * dt);
-    matrix_set(F, EKF_STATE_VEL_Z, EKF_STATE_ACC_BIAS_Z, -R33 * dt);
+    return true;
+}
+
+/**
+ * @brief 지연 전파 중인 누적 전이를 P에 반영
+ */
+bool ekf_flush_covariance(EKF *ekf) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_FLUSH_COVARIANCE, NULL, 0, NULL, 0);
+        return ekf_call_exit(ekf, ekf_flush_covariance(ekf));
+    }
+    
+    if (ekf == NULL || !ekf_flush_bias_coupling(ekf)) {
+        return false;
+    }
+    if (ekf->lazy_dt <= 0.0f) {
+        return true;
+    }
+    
+    if (!ekf_propagate_covariance(ekf, &ekf->lazy_phi, ekf->lazy_dt)) {
+        return false;
+    }
+    ekf->lazy_dt = 0.0f;
+    
+    return true;
+}
+
+/**
+ * @brief 공분산 지연 전파 설정
+ */
+bool ekf_set_lazy_covariance(EKF *ekf, bool enable, float max_dt) {
+    if (ekf == NULL) {
+        return false;
+    }
+    
+    if (!enable && !ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+    ekf->lazy_covariance = enable;
+    ekf->lazy_max_dt = (max_dt > 0.0f) ? max_dt : EKF_LAZY_DEFAULT_MAX_DT;
+    
+    return true;
+}
+
+/**
+ * @brief 분할 공분산 전파 설정
+ */
+bool ekf_set_bias_decimation(EKF *ekf, uint16_t decimation) {
+    if (ekf == NULL || !ekf_flush_bias_coupling(ekf)) {
+        return false;
+    }
+    
+    ekf->bias_decimation = decimation;
     
     return true;
 }
@@ -111,7 +571,14 @@ static bool ekf_compute_jacobian(EKF *ekf, Matrix *F, float dt) {
 /**
  * @brief EKF 예측 단계 (IMU 데이터 기반)
  */
+MEM_RAMFUNC(ekf_predict)
 bool ekf_predict(EKF *ekf, Vector3f gyro, Vector3f accel, float dt) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_ImuSample args = { gyro, accel, dt };
+        ekf_call_enter(ekf, EKF_CALL_PREDICT, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_predict(ekf, gyro, accel, dt));
+    }
+    
     if (ekf == NULL || dt <= 0.0f) {
         return false;
     }
@@ -121,124 +588,172 @@ bool ekf_predict(EKF *ekf, Vector3f gyro, Vector3f accel, float dt) {
         return false;
     }
     
-    // 현재 상태 추출
-    float px, py, pz;           // 위치
-    float vx, vy, vz;           // 속도
-    float qw, qx, qy, qz;       // 자세 사원수
-    float bgx, bgy, bgz;        // 자이로 바이어스
-    float bax, bay, baz;        // 가속도 바이어스
+    PROFILE_BEGIN(PROFILE_STAGE_PREDICT);
     
-    matrix_get(&ekf->x, EKF_STATE_POS_X, 0, &px);
-    matrix_get(&ekf->x, EKF_STATE_POS_Y, 0, &py);
-    matrix_get(&ekf->x, EKF_STATE_POS_Z, 0, &pz);
+    // 1. 상태 적분
+    Quaternion q;
+    ekf_integrate_state(ekf, gyro, accel, dt, &q);
     
-    matrix_get(&ekf->x, EKF_STATE_VEL_X, 0, &vx);
-    matrix_get(&ekf->x, EKF_STATE_VEL_Y, 0, &vy);
-    matrix_get(&ekf->x, EKF_STATE_VEL_Z, 0, &vz);
-    
-    matrix_get(&ekf->x, EKF_STATE_QUAT_W, 0, &qw);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_X, 0, &qx);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Y, 0, &qy);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Z, 0, &qz);
-    
-    matrix_get(&ekf->x, EKF_STATE_GYRO_BIAS_X, 0, &bgx);
-    matrix_get(&ekf->x, EKF_STATE_GYRO_BIAS_Y, 0, &bgy);
-    matrix_get(&ekf->x, EKF_STATE_GYRO_BIAS_Z, 0, &bgz);
-    
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_X, 0, &bax);
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_Y, 0, &bay);
-    matrix_get(&ekf->x, EKF_STATE_ACC_BIAS_Z, 0, &baz);
-    
-    // 사원수 정규화
-    Quaternion q = quaternion_create(qw, qx, qy, qz);
-    q = quaternion_normalize(q);
-    qw = q.w;
-    qx = q.x;
-    qy = q.y;
-    qz = q.z;
+    // 정상 상태 게인 고정 중에는 자코비안도 필요 없음
+    if (ekf->steady_frozen) {
+        PROFILE_END(PROFILE_STAGE_PREDICT);
+        return true;
+    }
     
-    // 바이어스 보정된 자이로 및 가속도 계산
-    Vector3f gyro_corrected = vector3f_create(
-        gyro.x - bgx,
-        gyro.y - bgy,
-        gyro.z - bgz
-    );
+    // 2. 자코비안 행렬 계산
+    PROFILE_BEGIN(PROFILE_STAGE_JACOBIAN);
+    MatrixSparseTransition F;
+    ekf_compute_jacobian(&F, q, ekf->epoch.R, dt);
+    PROFILE_END(PROFILE_STAGE_JACOBIAN);
     
-    Vector3f accel_corrected = vector3f_create(
-        accel.x - bax,
-        accel.y - bay,
-        accel.z - baz
-    );
+    // 3. 공분산 행렬 전파
+    PROFILE_BEGIN(PROFILE_STAGE_PROPAGATION);
+    if (!ekf_propagate_or_defer(ekf, &F, dt)) {
+        return false;
+    }
+    PROFILE_END(PROFILE_STAGE_PROPAGATION);
     
-    // 1. 사원수 적분 (자세 업데이트)
-    Quaternion q_dot = quaternion_derivative(q, gyro_corrected);
+    PROFILE_END(PROFILE_STAGE_PREDICT);
     
-    // 새로운 사원수 계산 (오일러 적분)
-    qw += q_dot.w * dt;
-    qx += q_dot.x * dt;
-    qy += q_dot.y * dt;
-    qz += q_dot.z * dt;
+    return true;
+}
+
+/**
+ * @brief EKF 상태 적분만 수행 (공분산 전파 없음)
+ */
+bool ekf_predict_state_only(EKF *ekf, Vector3f gyro, Vector3f accel, float dt) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_ImuSample args = { gyro, accel, dt };
+        ekf_call_enter(ekf, EKF_CALL_PREDICT_STATE_ONLY, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_predict_state_only(ekf, gyro, accel, dt));
+    }
     
-    // 사원수 정규화
-    q = quaternion_create(qw, qx, qy, qz);
-    q = quaternion_normalize(q);
-    qw = q.w;
-    qx = q.x;
-    qy = q.y;
-    qz = q.z;
+    if (ekf == NULL || dt <= 0.0f || !ekf->initialized) {
+        return false;
+    }
     
-    // 2. 중력 벡터 계산 (NED 좌표계)
-    Vector3f gravity_ned = vector3f_create(0.0f, 0.0f, ekf->gravity);
+    ekf_integrate_state(ekf, gyro, accel, dt, NULL);
     
-    // 3. 가속도를 NED 좌표계로 변환
-    Vector3f accel_ned = quaternion_rotate_vector(q, accel_corrected);
+    return true;
+}
+
+/**
+ * @brief EKF 자세 전용 예측 단계 (정지 상태용)
+ */
+bool ekf_predict_attitude(EKF *ekf, Vector3f gyro, float dt) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_ImuSample args = { gyro, vector3f_zero(), dt };
+        ekf_call_enter(ekf, EKF_CALL_PREDICT_ATTITUDE, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_predict_attitude(ekf, gyro, dt));
+    }
     
-    // 4. 중력 보정
-    accel_ned = vector3f_subtract(accel_ned, gravity_ned);
+    if (ekf == NULL || dt <= 0.0f || !ekf->initialized) {
+        return false;
+    }
     
-    // 5. 속도 적분
-    vx += accel_ned.x * dt;
-    vy += accel_ned.y * dt;
-    vz += accel_ned.z * dt;
+    if (ekf->info.open) {
+        ekf_info_apply(ekf);
+    }
     
-    // 6. 위치 적분
-    px += vx * dt;
-    py += vy * dt;
-    pz += vz * dt;
+    PROFILE_BEGIN(PROFILE_STAGE_PREDICT);
+    
+    // 1. 자세만 적분 (속도, 위치 유지)
+    ekf->gyro_last = gyro;
+    ekf->gate_clock_us += (uint32_t)(dt * 1e6f + 0.5f);
+    Quaternion q = ekf_integrate_attitude(&ekf->x.data[0][0], gyro, dt, &ekf->quat_norm_error);
+    
+    // 2. 자세-자이로 바이어스 블록만 있는 전이 행렬 (시계는 정지 중에도 흐름)
+    PROFILE_BEGIN(PROFILE_STAGE_JACOBIAN);
+    MatrixSparseTransition F;
+    matrix_sparse_transition_clear(&F);
+    ekf_add_attitude_jacobian(&F, q, dt);
+#if EKF_CONFIG_GNSS_CLOCK
+    ekf_propagate_clock(&ekf->x.data[0][0], &F, dt);
+#endif
+    PROFILE_END(PROFILE_STAGE_JACOBIAN);
+    
+    // 3. 공분산 행렬 전파
+    PROFILE_BEGIN(PROFILE_STAGE_PROPAGATION);
+    if (!ekf_propagate_or_defer(ekf, &F, dt)) {
+        return false;
+    }
+    PROFILE_END(PROFILE_STAGE_PROPAGATION);
     
-    // 7. 상태 벡터 업데이트
-    matrix_set(&ekf->x, EKF_STATE_POS_X, 0, px);
-    matrix_set(&ekf->x, EKF_STATE_POS_Y, 0, py);
-    matrix_set(&ekf->x, EKF_STATE_POS_Z, 0, pz);
+    PROFILE_END(PROFILE_STAGE_PREDICT);
     
-    matrix_set(&ekf->x, EKF_STATE_VEL_X, 0, vx);
-    matrix_set(&ekf->x, EKF_STATE_VEL_Y, 0, vy);
-    matrix_set(&ekf->x, EKF_STATE_VEL_Z, 0, vz);
+    return true;
+}
+
+/**
+ * @brief EKF 일괄 예측 단계 (IMU 샘플 n개, 공분산 전파 1회)
+ * 
+ * 각 샘플마다 상태를 적분하고 그 시점의 전이 행렬을
+ * Φ = F_k * Φ 로 누적한 뒤, 마지막에 P = Φ * P * Φ^T + Q * Σdt 로 한 번 전파한다.
+ * 프로세스 노이즈는 전체 구간 길이 하나로 이산화한다 (바이어스를 거친 구간 내 전이 무시).
+ */
+bool ekf_predict_batch(EKF *ekf, const EKF_ImuSample *samples, uint16_t n) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_PREDICT_BATCH, NULL, 0,
+                       samples, (samples != NULL) ? (uint16_t)(n * sizeof(*samples)) : 0u);
+        return ekf_call_exit(ekf, ekf_predict_batch(ekf, samples, n));
+    }
     
-    matrix_set(&ekf->x, EKF_STATE_QUAT_W, 0, qw);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_X, 0, qx);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_Y, 0, qy);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_Z, 0, qz);
+    if (ekf == NULL || samples == NULL || n == 0) {
+        return false;
+    }
     
-    // 바이어스는 변경하지 않음 (측정 갱신 단계에서 조정)
+    if (!ekf->initialized) {
+        // 초기화되지 않은 경우 예측 수행하지 않음
+        return false;
+    }
     
-    // 8. 자코비안 행렬 계산
-    Matrix F;
-    ekf_compute_jacobian(ekf, &F, dt);
+    for (uint16_t k = 0; k < n; k++) {
+        if (samples[k].dt <= 0.0f) {
+            return false;
+        }
+    }
     
-    // 9. 공분산 행렬 전파
-    // P = F * P * F^T + Q
-    Matrix F_transpose;
-    matrix_transpose(&F, &F_transpose);
+    PROFILE_BEGIN(PROFILE_STAGE_PREDICT);
+    
+    MatrixSparseTransition phi;
+    matrix_sparse_transition_clear(&phi);
+    float phi_dt = 0.0f;
+    
+    for (uint16_t k = 0; k < n; k++) {
+        const EKF_ImuSample *s = &samples[k];
+        
+        // 1. 상태 적분 (전체 IMU 속도)
+        Quaternion q;
+        ekf_integrate_state(ekf, s->gyro, s->accel, s->dt, &q);
+        
+        // 2. 전이 행렬 누적: Φ = F_k * Φ
+        PROFILE_BEGIN(PROFILE_STAGE_JACOBIAN);
+        MatrixSparseTransition F;
+        ekf_compute_jacobian(&F, q, ekf->epoch.R, s->dt);
+        
+        MatrixSparseTransition phi_next;
+        if (matrix_sparse_transition_compose(&F, &phi, &phi_next)) {
+            phi = phi_next;
+            phi_dt += s->dt;
+        } else {
+            // 희소 용량 초과 시 지금까지 누적분을 전파하고 새로 누적
+            if (!ekf_propagate_or_defer(ekf, &phi, phi_dt)) {
+                return false;
+            }
+            phi = F;
+            phi_dt = s->dt;
+        }
+        PROFILE_END(PROFILE_STAGE_JACOBIAN);
+    }
     
-    Matrix temp1, temp2;
-    matrix_multiply(&F, &ekf->P, &temp1);
-    matrix_multiply(&temp1, &F_transpose, &temp2);
+    // 3. 공분산 행렬 전파 (일괄 1회)
+    PROFILE_BEGIN(PROFILE_STAGE_PROPAGATION);
+    if (!ekf_propagate_or_defer(ekf, &phi, phi_dt)) {
+        return false;
+    }
+    PROFILE_END(PROFILE_STAGE_PROPAGATION);
     
-    // Q를 더함 (프로세스 노이즈)
-    Matrix scaled_Q;
-    matrix_scale(&ekf->Q, dt, &scaled_Q);
-    matrix_add(&temp2, &scaled_Q, &ekf->P);
+    PROFILE_END(PROFILE_STAGE_PREDICT);
     
     return true;
 }
@@ -0,0 +1,163 @@
+/**
+ * @file ekf_preintegration.c
+ * @brief 코닝/스컬링 보정 IMU 각도/속도 증분 사전 적분 구현
+ */
+
+#include "ekf/ekf_preintegration.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+
+/**
+ * @brief 누적기 초기화
+ */
+bool ekf_preint_reset(EKF_Preintegrator *preint) {
+    if (preint == NULL) {
+        return false;
+    }
+
+    preint->alpha = vector3f_zero();
+    preint->beta = vector3f_zero();
+    preint->last_dtheta = vector3f_zero();
+    preint->delta_vel = vector3f_zero();
+    preint->dt = 0.0f;
+    preint->count = 0;
+    preint->roll = 0.0f;
+
+    return true;
+}
+
+/**
+ * @brief 누적기 생성 (일반 모드, 바이어스 0)
+ */
+bool ekf_preint_init(EKF_Preintegrator *preint) {
+    if (preint == NULL) {
+        return false;
+    }
+
+    preint->gyro_bias = vector3f_zero();
+    preint->spin = false;
+
+    return ekf_preint_reset(preint);
+}
+
+/**
+ * @brief 스핀 모드 설정
+ */
+bool ekf_preint_set_spin(EKF_Preintegrator *preint, bool enable) {
+    if (preint == NULL || preint->count > 0) {
+        return false;
+    }
+
+    preint->spin = enable;
+
+    return true;
+}
+
+/**
+ * @brief 누적 전에 뺄 자이로 바이어스 설정
+ */
+bool ekf_preint_set_gyro_bias(EKF_Preintegrator *preint, Vector3f bias) {
+    if (preint == NULL || preint->count > 0) {
+        return false;
+    }
+
+    preint->gyro_bias = bias;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 1개 누적
+ */
+bool ekf_preint_add(EKF_Preintegrator *preint, Vector3f gyro, Vector3f accel, float dt) {
+    if (preint == NULL || dt <= 0.0f) {
+        return false;
+    }
+
+    gyro = vector3f_subtract(gyro, preint->gyro_bias);
+
+    if (preint->spin) {
+        // 스핀축 회전은 정확히 적분하고, 횡축 각속도와 비력은 샘플 중간 롤각으로 탈스핀
+        float droll = gyro.z * dt;
+        float s, c;
+        fast_sincosf(preint->roll + 0.5f * droll, &s, &c);
+        preint->roll += droll;
+
+        gyro = vector3f_create(c * gyro.x - s * gyro.y, s * gyro.x + c * gyro.y, 0.0f);
+        accel = vector3f_create(c * accel.x - s * accel.y, s * accel.x + c * accel.y, accel.z);
+    }
+
+    Vector3f dtheta = vector3f_scale(gyro, dt);
+    Vector3f dv = vector3f_scale(accel, dt);
+
+    // 코닝 보정: β += 1/2 (α + Δθ_prev / 6) × Δθ_k
+    Vector3f coning_ref = vector3f_add(preint->alpha, vector3f_scale(preint->last_dtheta, 1.0f / 6.0f));
+    preint->beta = vector3f_add(preint->beta, vector3f_scale(vector3f_cross(coning_ref, dtheta), 0.5f));
+
+    // 스컬링/회전 보정: 샘플 중간 시점 자세 (α + Δθ_k / 2)로 dv_k를 구간 시작 좌표계로 변환
+    Vector3f sculling_ref = vector3f_add(preint->alpha, vector3f_scale(dtheta, 0.5f));
+    preint->delta_vel = vector3f_add(preint->delta_vel,
+                                     vector3f_add(dv, vector3f_cross(sculling_ref, dv)));
+
+    preint->alpha = vector3f_add(preint->alpha, dtheta);
+    preint->last_dtheta = dtheta;
+    preint->dt += dt;
+    preint->count++;
+
+    return true;
+}
+
+/**
+ * @brief 보정된 각도/속도 증분 조회
+ */
+bool ekf_preint_get_delta(const EKF_Preintegrator *preint, Vector3f *delta_angle,
+                          Vector3f *delta_vel, float *dt) {
+    if (preint == NULL || delta_angle == NULL || delta_vel == NULL || dt == NULL) {
+        return false;
+    }
+
+    if (preint->count == 0) {
+        return false;
+    }
+
+    *delta_angle = vector3f_add(preint->alpha, preint->beta);
+    if (preint->spin) {
+        // dq = exp(Δθ_d + β) ⊗ Rz(φ)
+        float s, c;
+        fast_sincosf(0.5f * preint->roll, &s, &c);
+        Quaternion dq = quaternion_multiply(quaternion_from_rotation_vector(*delta_angle),
+                                            quaternion_create(c, 0.0f, 0.0f, s));
+        *delta_angle = quaternion_to_rotation_vector(dq);
+    }
+    *delta_vel = preint->delta_vel;
+    *dt = preint->dt;
+
+    return true;
+}
+
+/**
+ * @brief 누적 결과를 등가 IMU 샘플로 변환하고 누적기 초기화
+ */
+bool ekf_preint_extract(EKF_Preintegrator *preint, EKF_ImuSample *sample) {
+    if (preint == NULL || sample == NULL) {
+        return false;
+    }
+
+    Vector3f delta_angle, delta_vel;
+    float dt;
+    if (!ekf_preint_get_delta(preint, &delta_angle, &delta_vel, &dt)) {
+        return false;
+    }
+
+    float inv_dt = 1.0f / dt;
+
+    // 구간 시작 좌표계의 Δv를 구간 끝 좌표계로 변환
+    Quaternion dq = quaternion_from_rotation_vector(delta_angle);
+    Vector3f delta_vel_end = quaternion_rotate_vector_inverse(dq, delta_vel);
+
+    sample->gyro = vector3f_add(vector3f_scale(delta_angle, inv_dt), preint->gyro_bias);
+    sample->accel = vector3f_scale(delta_vel_end, inv_dt);
+    sample->dt = dt;
+
+    return ekf_preint_reset(preint);
+}
@@ -0,0 +1,638 @@
+/**
+ * @file ekf_q31.c
+ * @brief Q31 고정 소수점 자세/수직 채널 필터 구현
+ */
+
+#include "ekf/ekf_q31.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 상태 배치 (자세 블록 / 수직 블록 안의 인덱스)
+ */
+#define Q31_ATT_QUAT 0         /**< 사원수 w, x, y, z */
+#define Q31_ATT_BIAS 4         /**< 자이로 바이어스 x, y, z */
+#define Q31_VERT_POS 0         /**< 고도 */
+#define Q31_VERT_VEL 1         /**< 수직 속도 */
+
+/**
+ * @brief 정규화 증분 (Q31) -> 상태 raw 증분 이동 비트 수 (범위 지수 - 척도 지수)
+ */
+#define Q31_QUAT_SHIFT (EKF_Q31_QUAT_EXP - EKF_Q31_P_QUAT_EXP)
+#define Q31_BIAS_SHIFT (EKF_Q31_BIAS_EXP - EKF_Q31_P_BIAS_EXP)
+#define Q31_POS_SHIFT (EKF_Q31_POS_EXP - EKF_Q31_P_POS_EXP)
+#define Q31_VEL_SHIFT (EKF_Q31_VEL_EXP - EKF_Q31_P_VEL_EXP)
+
+/**
+ * @brief 비력 방향 혁신 척도 지수 (단위 벡터 차이 범위 ±2)
+ *
+ * 사원수 척도 1과 함께 쓰면 정규화 자코비안 원소가 사원수 성분 그대로(Q30)가 된다.
+ */
+#define Q31_GRAVITY_Y_EXP 1
+
+/**
+ * @brief 정규화 이득 형식 (Q24, |K| < 64)
+ */
+#define Q31_GAIN_FRAC 24
+#define Q31_GAIN_LIMIT ((int64_t)1 << 30)
+
+_Static_assert(Q31_QUAT_SHIFT >= 0 && Q31_BIAS_SHIFT >= 0 && Q31_POS_SHIFT > 0 && Q31_VEL_SHIFT > 0,
+               "state range must not be finer than covariance scale");
+_Static_assert(EKF_Q31_P_QUAT_EXP + 1 == Q31_GRAVITY_Y_EXP, "gravity Jacobian assumes q scale = y scale / 2");
+
+/**
+ * @brief 간격 (us) -> 초 (Q31, dt_us < 1e6)
+ */
+static int32_t ekf_q31_dt(uint32_t dt_us) {
+    return (int32_t)(((uint64_t)dt_us << 31) / 1000000u);
+}
+
+/**
+ * @brief 존재하지 않는 증분으로 음의 분산이 되지 않도록 대각 하한 적용
+ */
+static void ekf_q31_clamp_diagonal(int32_t *P, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+        if (P[i * n + i] < 1) {
+            P[i * n + i] = 1;
+        }
+    }
+}
+
+/**
+ * @brief 비력 크기 제곱 (EKF_Q31_ACCEL_EXP 제곱 단위)
+ */
+static uint64_t ekf_q31_accel_sq(const int32_t accel[3]) {
+    uint64_t sq = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        sq += (uint64_t)((int64_t)accel[i] * accel[i]);
+    }
+    return sq;
+}
+
+/**
+ * @brief 비력 크기가 중력 허용 범위 안인지
+ */
+static bool ekf_q31_near_gravity(const EKF_Q31 *f, uint64_t sq) {
+    return sq >= f->gravity_sq_min && sq <= f->gravity_sq_max;
+}
+
+/**
+ * @brief 공분산 초기화 (대각 초기 분산)
+ */
+static void ekf_q31_reset_covariance(EKF_Q31 *f) {
+    memset(f->P_att, 0, sizeof(f->P_att));
+    memset(f->P_vert, 0, sizeof(f->P_vert));
+    for (uint8_t i = 0; i < EKF_Q31_ATT_DIM; i++) {
+        f->P_att[i][i] = f->P0_att[i];
+    }
+    for (uint8_t i = 0; i < EKF_Q31_VERT_DIM; i++) {
+        f->P_vert[i][i] = f->P0_vert[i];
+    }
+    memset(f->q_residue, 0, sizeof(f->q_residue));
+    f->cov_dt_us = 0;
+}
+
+/**
+ * @brief 사원수 정규화 1차 보정: 1/|q| ~= (3 - |q|^2) / 2 (ekf_integrate_attitude와 같음)
+ */
+static void ekf_q31_normalize(int32_t q[4]) {
+    int64_t n = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        n += (int64_t)q[i] * q[i];
+    }
+    // k = 1.5 - 0.5 |q|^2 (Q30)
+    int32_t k = q31_saturate(((int64_t)3 << 29) - q31_round_shift(n, 31));
+    for (uint8_t i = 0; i < 4; i++) {
+        q[i] = q31_mul_shift(q[i], k, 30);
+    }
+}
+
+/**
+ * @brief 몸체 z축의 NED 성분 = 회전 행렬 셋째 행 (R20, R21, R22, Q31)
+ */
+static void ekf_q31_rotation_row_z(const int32_t q[4], int32_t r[3]) {
+    int64_t w = q[0], x = q[1], y = q[2], z = q[3];
+    r[0] = q31_saturate(q31_round_shift(x * z - w * y, 28));
+    r[1] = q31_saturate(q31_round_shift(y * z + w * x, 28));
+    r[2] = q31_saturate(q31_round_shift(w * w - x * x - y * y + z * z, 29));
+}
+
+/**
+ * @brief 자세 적분 (지수 사상, 바이어스 보정)
+ *
+ * exp(θ/2) ~= (1 - |θ|^2/8 + |θ|^4/384, θ/2 (1 - |θ|^2/24)), |θ| < 0.64 rad에서 오차 1e-6 미만.
+ */
+static void ekf_q31_integrate_attitude(EKF_Q31 *f, const int32_t gyro[3], int32_t dt) {
+    // 바이어스 보정된 자이로 (입력 형식) -> 회전 벡터 θ (Q31 rad)
+    int32_t theta[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        int32_t bias = q31_saturate(q31_round_shift(f->gyro_bias[i], EKF_Q31_GYRO_EXP - EKF_Q31_BIAS_EXP));
+        int32_t omega = q31_sub(gyro[i], bias);
+        theta[i] = q31_mul_shift(omega, dt, 31 - EKF_Q31_GYRO_EXP);
+    }
+    int32_t th2 = q31_saturate((int64_t)q31_mul(theta[0], theta[0]) + q31_mul(theta[1], theta[1]) +
+                               q31_mul(theta[2], theta[2]));
+    int32_t th4 = q31_mul(th2, th2);
+
+    // 회전 증분 (Q30)
+    int32_t dq[4];
+    dq[0] = q31_saturate(((int64_t)1 << 30) - (th2 >> 4) + (th4 >> 1) / 384);
+    for (uint8_t i = 0; i < 3; i++) {
+        int32_t half = theta[i] >> 2;
+        dq[1 + i] = q31_sub(half, q31_mul(half, th2) / 24);
+    }
+
+    // 몸체 좌표계 회전 증분을 오른쪽에 곱함 (quaternion_multiply와 같은 해밀턴 곱)
+    const int64_t w1 = f->q[0], x1 = f->q[1], y1 = f->q[2], z1 = f->q[3];
+    const int64_t w2 = dq[0], x2 = dq[1], y2 = dq[2], z2 = dq[3];
+    f->q[0] = q31_saturate(q31_round_shift(w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2, 30));
+    f->q[1] = q31_saturate(q31_round_shift(w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2, 30));
+    f->q[2] = q31_saturate(q31_round_shift(w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2, 30));
+    f->q[3] = q31_saturate(q31_round_shift(w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2, 30));
+
+    ekf_q31_normalize(f->q);
+}
+
+/**
+ * @brief 수직 채널 적분 (속도를 먼저 갱신하고 위치는 갱신된 속도로, ekf_integrate_state와 같음)
+ */
+static void ekf_q31_integrate_vertical(EKF_Q31 *f, const int32_t accel[3], int32_t dt) {
+    int32_t r[3];
+    ekf_q31_rotation_row_z(f->q, r);
+
+    int64_t az = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        az += q31_round_shift((int64_t)r[i] * accel[i], 31);
+    }
+    az -= f->gravity;
+
+    q31_accumulate(&f->vel_z, (int64_t)q31_saturate(az) * dt, 31 + EKF_Q31_VEL_EXP - EKF_Q31_ACCEL_EXP,
+                   &f->vel_residue);
+    q31_accumulate(&f->pos_z, (int64_t)f->vel_z * dt, 31 + EKF_Q31_POS_EXP - EKF_Q31_VEL_EXP,
+                   &f->pos_residue);
+}
+
+/**
+ * @brief 자세 블록 공분산 전파 P = F P F^T + Qd
+ *
+ * F = I + E, E는 사원수 행-자이로 바이어스 열 블록만 0이 아니다 (ekf_add_attitude_jacobian과 같은 식).
+ * 정규화 좌표에서 E' = E s_b / s_q 이다.
+ */
+static void ekf_q31_propagate_attitude(EKF_Q31 *f, int32_t dt) {
+    const int64_t w = f->q[0], x = f->q[1], y = f->q[2], z = f->q[3];
+    const uint8_t shift = (uint8_t)(31 - (EKF_Q31_P_BIAS_EXP - EKF_Q31_P_QUAT_EXP));
+    const int64_t table[4][3] = {
+        {  x,  y,  z },
+        { -w,  z, -y },
+        { -z, -w,  x },
+        {  y, -x, -w }
+    };
+    int32_t E[4][3];
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t k = 0; k < 3; k++) {
+            E[i][k] = q31_saturate(q31_round_shift(table[i][k] * dt, shift));
+        }
+    }
+
+    // A = F P (사원수 행만 바뀜)
+    int32_t A[EKF_Q31_ATT_DIM][EKF_Q31_ATT_DIM];
+    memcpy(A, f->P_att, sizeof(A));
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < EKF_Q31_ATT_DIM; j++) {
+            int64_t acc = f->P_att[i][j];
+            for (uint8_t k = 0; k < 3; k++) {
+                acc += q31_round_shift((int64_t)E[i][k] * f->P_att[Q31_ATT_BIAS + k][j], 31);
+            }
+            A[i][j] = q31_saturate(acc);
+        }
+    }
+
+    // P = A F^T (사원수 열만 바뀜), 상삼각을 계산해 하삼각으로 복사
+    for (uint8_t i = 0; i < EKF_Q31_ATT_DIM; i++) {
+        for (uint8_t j = i; j < EKF_Q31_ATT_DIM; j++) {
+            int64_t acc = A[i][j];
+            if (j < 4) {
+                for (uint8_t k = 0; k < 3; k++) {
+                    acc += q31_round_shift((int64_t)A[i][Q31_ATT_BIAS + k] * E[j][k], 31);
+                }
+            }
+            f->P_att[i][j] = q31_saturate(acc);
+            f->P_att[j][i] = f->P_att[i][j];
+        }
+    }
+
+    // Qd = Q dt (대각, 나머지 이월)
+    for (uint8_t i = 0; i < EKF_Q31_ATT_DIM; i++) {
+        q31_accumulate(&f->P_att[i][i], (int64_t)f->q_att[i] * dt, 31, &f->q_residue[i]);
+    }
+}
+
+/**
+ * @brief 수직 블록 공분산 전파 P = F P F^T + Qd
+ *
+ * F = [1 dt; 0 1], 정규화 좌표에서 e = dt s_v / s_h.
+ * 이산 노이즈는 ekf_discrete_noise와 같이 속도 잡음의 위치 기여(q_v dt^3/3, q_v dt^2/2)를 포함한다.
+ */
+static void ekf_q31_propagate_vertical(EKF_Q31 *f, int32_t dt) {
+    const uint8_t scale = (uint8_t)(EKF_Q31_P_POS_EXP - EKF_Q31_P_VEL_EXP);
+    int32_t e = dt >> scale;
+    int64_t p00 = f->P_vert[0][0];
+    int64_t p01 = f->P_vert[0][1];
+    int64_t p11 = f->P_vert[1][1];
+
+    int64_t e_p11 = q31_round_shift((int64_t)e * p11, 31);
+    int64_t n01 = p01 + e_p11;
+    int64_t n00 = p00 + 2 * q31_round_shift((int64_t)e * p01, 31) + q31_round_shift((int64_t)e * e_p11, 31);
+
+    // 속도 잡음의 위치/상관 기여 (위치 척도로 바꾸면 s_v^2 / s_h^2, s_v / s_h 배)
+    int32_t dt2 = q31_mul(dt, dt);
+    int32_t dt3 = q31_mul(dt2, dt);
+    int64_t q_v = f->q_vert[Q31_VERT_VEL];
+    n01 += q31_round_shift(q_v * dt2, (uint8_t)(31 + 1 + scale));
+
+    f->P_vert[0][0] = q31_saturate(n00);
+    f->P_vert[0][1] = q31_saturate(n01);
+    f->P_vert[1][0] = f->P_vert[0][1];
+
+    uint8_t ip = EKF_Q31_ATT_DIM + Q31_VERT_POS;
+    uint8_t iv = EKF_Q31_ATT_DIM + Q31_VERT_VEL;
+    q31_accumulate(&f->P_vert[0][0], (int64_t)f->q_vert[Q31_VERT_POS] * dt + (q_v * dt3) / (3 << (2 * scale)),
+                   31, &f->q_residue[ip]);
+    q31_accumulate(&f->P_vert[1][1], q_v * dt, 31, &f->q_residue[iv]);
+}
+
+/**
+ * @brief 누적 구간의 공분산 전파 반영
+ */
+static void ekf_q31_flush_covariance(EKF_Q31 *f) {
+    if (f->cov_dt_us == 0) {
+        return;
+    }
+
+    int32_t dt = ekf_q31_dt(f->cov_dt_us);
+    ekf_q31_propagate_attitude(f, dt);
+    ekf_q31_propagate_vertical(f, dt);
+    f->cov_dt_us = 0;
+}
+
+/**
+ * @brief 스칼라 측정의 P H^T와 혁신 분산 S = H P H^T + r (정규화 좌표)
+ *
+ * 포화로 P가 반정치를 조금 벗어나도 S가 r보다 작아지지 않게 한다.
+ *
+ * @param P 블록 공분산 (n x n, 정규화 Q31)
+ * @param n 블록 차원
+ * @param H 정규화 자코비안 (Q30)
+ * @param r 정규화 측정 분산 (Q31)
+ * @param pht P H^T (Q31, n개)
+ * @return int64_t S (Q31)
+ */
+static int64_t ekf_q31_innovation_variance(const int32_t *P, uint8_t n, const int32_t *H, int32_t r,
+                                           int32_t *pht) {
+    int64_t s = r;
+    for (uint8_t i = 0; i < n; i++) {
+        int64_t acc = 0;
+        for (uint8_t j = 0; j < n; j++) {
+            if (H[j] != 0) {
+                acc += q31_round_shift((int64_t)P[i * n + j] * H[j], 30);
+            }
+        }
+        pht[i] = q31_saturate(acc);
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        s += q31_round_shift((int64_t)H[i] * pht[i], 30);
+    }
+
+    return (s < r) ? r : s;
+}
+
+/**
+ * @brief 정규화 혁신 제곱 y^2 / S가 게이트를 넘는지
+ */
+static bool ekf_q31_gate_exceeded(int32_t y, int64_t s, int64_t gate_q8) {
+    return gate_q8 > 0 && ((((int64_t)y * y) >> 31) << 8) > s * gate_q8;
+}
+
+/**
+ * @brief 스칼라 측정 순차 갱신 (정규화 좌표, 한 블록)
+ *
+ * S = H P H^T + r, K = P H^T / S, dx += K y, P -= K (H P).
+ *
+ * @param P 블록 공분산 (n x n, 정규화 Q31)
+ * @param n 블록 차원
+ * @param H 정규화 자코비안 (Q30)
+ * @param y 정규화 혁신 (Q31, 이전 성분의 보정 반영 후)
+ * @param r 정규화 측정 분산 (Q31)
+ * @param gate_q8 혁신 게이트 (Q8, 0이면 사용 안 함)
+ * @param dx 정규화 상태 보정 누적 (Q31)
+ * @return bool 적용했으면 true (게이트 거부 시 false)
+ */
+static bool ekf_q31_scalar_update(int32_t *P, uint8_t n, const int32_t *H, int32_t y, int32_t r,
+                                  int64_t gate_q8, int32_t *dx) {
+    int32_t pht[EKF_Q31_ATT_DIM];
+    int64_t s = ekf_q31_innovation_variance(P, n, H, r, pht);
+    if (ekf_q31_gate_exceeded(y, s, gate_q8)) {
+        return false;
+    }
+
+    int64_t K[EKF_Q31_ATT_DIM];
+    for (uint8_t i = 0; i < n; i++) {
+        int64_t k = ((int64_t)pht[i] << Q31_GAIN_FRAC) / s;
+        K[i] = (k > Q31_GAIN_LIMIT) ? Q31_GAIN_LIMIT : (k < -Q31_GAIN_LIMIT) ? -Q31_GAIN_LIMIT : k;
+        dx[i] = q31_saturate((int64_t)dx[i] + q31_round_shift(K[i] * y, Q31_GAIN_FRAC));
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = i; j < n; j++) {
+            int64_t v = (int64_t)P[i * n + j] - q31_round_shift(K[i] * pht[j], Q31_GAIN_FRAC);
+            P[i * n + j] = q31_saturate(v);
+            P[j * n + i] = P[i * n + j];
+        }
+    }
+    ekf_q31_clamp_diagonal(P, n);
+
+    return true;
+}
+
+/**
+ * @brief 기본 설정
+ */
+void ekf_q31_default_config(EKF_Q31_Config *config) {
+    if (config == NULL) {
+        return;
+    }
+
+    // 초기 분산과 수직 채널 노이즈는 ekf_init/ekf_config.h 기본값과 같음
+    config->att_std = 0.01f;
+    config->gyro_bias_std = 0.001f;
+    config->pos_std = 0.1f;
+    config->vel_std = 0.1f;
+    config->p_att = 0.1f;
+    config->p_gyro_bias = 0.01f;
+    config->p_pos = 10.0f;
+    config->p_vel = 1.0f;
+    config->gravity_std = 0.05f;
+    config->gravity_gate = EKF_Q31_DEFAULT_GRAVITY_GATE;
+    config->gravity_settle_us = EKF_Q31_DEFAULT_GRAVITY_SETTLE_US;
+    config->gravity_max_climb = EKF_Q31_DEFAULT_GRAVITY_MAX_CLIMB;
+    config->baro_std = 1.0f;
+    config->nis_gate = EKF_Q31_DEFAULT_NIS_GATE;
+    config->gravity = 9.80665f;
+    config->cov_period_us = EKF_Q31_DEFAULT_COV_PERIOD_US;
+}
+
+/**
+ * @brief 필터 초기화
+ */
+bool ekf_q31_init(EKF_Q31 *f, const EKF_Q31_Config *config) {
+    if (f == NULL) {
+        return false;
+    }
+
+    EKF_Q31_Config c;
+    if (config != NULL) {
+        c = *config;
+    } else {
+        ekf_q31_default_config(&c);
+    }
+    if (!(c.gravity_std > 0.0f) || !(c.baro_std > 0.0f) || !(c.gravity_gate >= 0.0f) ||
+        !(c.gravity_gate < c.gravity) || c.cov_period_us >= 1000000u - EKF_Q31_MAX_DT_US) {
+        return false;
+    }
+
+    memset(f, 0, sizeof(*f));
+
+    // 정규화 분산 = 분산 / s^2 (척도 지수의 두 배를 범위 지수로 사용)
+    for (uint8_t i = 0; i < 4; i++) {
+        f->P0_att[Q31_ATT_QUAT + i] = q31_from_float(c.p_att, 2 * EKF_Q31_P_QUAT_EXP);
+        f->q_att[Q31_ATT_QUAT + i] = q31_from_float(c.att_std * c.att_std, 2 * EKF_Q31_P_QUAT_EXP);
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        f->P0_att[Q31_ATT_BIAS + i] = q31_from_float(c.p_gyro_bias, 2 * EKF_Q31_P_BIAS_EXP);
+        f->q_att[Q31_ATT_BIAS + i] = q31_from_float(c.gyro_bias_std * c.gyro_bias_std, 2 * EKF_Q31_P_BIAS_EXP);
+    }
+    f->P0_vert[Q31_VERT_POS] = q31_from_float(c.p_pos, 2 * EKF_Q31_P_POS_EXP);
+    f->P0_vert[Q31_VERT_VEL] = q31_from_float(c.p_vel, 2 * EKF_Q31_P_VEL_EXP);
+    f->q_vert[Q31_VERT_POS] = q31_from_float(c.pos_std * c.pos_std, 2 * EKF_Q31_P_POS_EXP);
+    f->q_vert[Q31_VERT_VEL] = q31_from_float(c.vel_std * c.vel_std, 2 * EKF_Q31_P_VEL_EXP);
+
+    f->r_gravity = q31_from_float(c.gravity_std * c.gravity_std, 2 * Q31_GRAVITY_Y_EXP);
+    f->r_baro = q31_from_float(c.baro_std * c.baro_std, 2 * EKF_Q31_P_POS_EXP);
+    if (f->r_gravity <= 0 || f->r_baro <= 0) {
+        return false;
+    }
+    f->gravity = q31_from_float(c.gravity, EKF_Q31_ACCEL_EXP);
+    int64_t g_min = q31_from_float(c.gravity - c.gravity_gate, EKF_Q31_ACCEL_EXP);
+    int64_t g_max = q31_from_float(c.gravity + c.gravity_gate, EKF_Q31_ACCEL_EXP);
+    f->gravity_sq_min = (uint64_t)(g_min * g_min);
+    f->gravity_sq_max = (uint64_t)(g_max * g_max);
+    f->gravity_settle_us = c.gravity_settle_us;
+    f->gravity_max_climb = q31_from_float(c.gravity_max_climb, EKF_Q31_VEL_EXP);
+    f->nis_gate_q8 = (c.nis_gate > 0.0f) ? (int64_t)(c.nis_gate * 256.0f + 0.5f) : 0;
+    f->cov_period_us = c.cov_period_us;
+
+    f->q[0] = (int32_t)1 << (31 - EKF_Q31_QUAT_EXP);
+    ekf_q31_reset_covariance(f);
+
+    return true;
+}
+
+/**
+ * @brief 초기 상태 설정
+ */
+bool ekf_q31_set_initial_state(EKF_Q31 *f, const int32_t q[4], int32_t pos_z, int32_t vel_z) {
+    if (f == NULL || q == NULL) {
+        return false;
+    }
+
+    memcpy(f->q, q, sizeof(f->q));
+    ekf_q31_normalize(f->q);
+    memset(f->gyro_bias, 0, sizeof(f->gyro_bias));
+    f->pos_z = pos_z;
+    f->vel_z = vel_z;
+    f->pos_residue = 0;
+    f->vel_residue = 0;
+    f->quiet_us = 0;
+    ekf_q31_reset_covariance(f);
+
+    return true;
+}
+
+/**
+ * @brief 예측
+ */
+bool ekf_q31_predict(EKF_Q31 *f, const int32_t gyro[3], const int32_t accel[3], uint32_t dt_us) {
+    if (f == NULL || gyro == NULL || accel == NULL) {
+        return false;
+    }
+
+    // 비력 크기 조건이 이어진 시간 (비력 방향 갱신 조건)
+    if (ekf_q31_near_gravity(f, ekf_q31_accel_sq(accel))) {
+        f->quiet_us = (f->quiet_us > UINT32_MAX - dt_us) ? UINT32_MAX : f->quiet_us + dt_us;
+    } else {
+        f->quiet_us = 0;
+    }
+
+    // 긴 간격은 회전 벡터가 범위를 넘지 않도록 나누어 적분
+    while (dt_us > 0) {
+        uint32_t step = (dt_us > EKF_Q31_MAX_DT_US) ? EKF_Q31_MAX_DT_US : dt_us;
+        int32_t dt = ekf_q31_dt(step);
+        ekf_q31_integrate_attitude(f, gyro, dt);
+        ekf_q31_integrate_vertical(f, accel, dt);
+        dt_us -= step;
+
+        f->cov_dt_us += step;
+        if (f->cov_dt_us >= f->cov_period_us) {
+            ekf_q31_flush_covariance(f);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 비력 방향 갱신
+ */
+bool ekf_q31_update_gravity(EKF_Q31 *f, const int32_t accel[3]) {
+    if (f == NULL || accel == NULL) {
+        return false;
+    }
+
+    uint64_t sq = ekf_q31_accel_sq(accel);
+    if (!ekf_q31_near_gravity(f, sq) || f->quiet_us < f->gravity_settle_us || f->vel_z > f->gravity_max_climb) {
+        f->stats.gravity_skips++;
+        return false;
+    }
+    int64_t norm = q31_isqrt64(sq);
+
+    ekf_q31_flush_covariance(f);
+
+    // 측정 단위 벡터와 예측 (몸체 좌표계 중력 반대 방향 = R^T e_z)
+    int32_t r[3];
+    ekf_q31_rotation_row_z(f->q, r);
+    const int32_t w = f->q[0], x = f->q[1], y = f->q[2], z = f->q[3];
+    const int32_t H[3][EKF_Q31_ATT_DIM] = {
+        { -y,  z, -w,  x, 0, 0, 0 },
+        {  x,  w,  z,  y, 0, 0, 0 },
+        {  w, -x, -y,  z, 0, 0, 0 }
+    };
+
+    // 세 성분을 한 측정으로 보고, 사전 공분산으로 한 성분이라도 게이트를 넘으면 전체 거부
+    // (비력이 중력이 아닌 경우 일부 성분만 받아들이면 자세가 잘못된 방향으로 끌려감)
+    int32_t innov[3];
+    int32_t pht[EKF_Q31_ATT_DIM];
+    for (uint8_t k = 0; k < 3; k++) {
+        int32_t u = q31_saturate(((int64_t)accel[k] << 31) / norm);
+        innov[k] = q31_saturate(q31_round_shift((int64_t)u - r[k], Q31_GRAVITY_Y_EXP));
+        int64_t s = ekf_q31_innovation_variance(&f->P_att[0][0], EKF_Q31_ATT_DIM, H[k], f->r_gravity, pht);
+        if (ekf_q31_gate_exceeded(innov[k], s, f->nis_gate_q8)) {
+            f->stats.gravity_rejects++;
+            return false;
+        }
+    }
+
+    int32_t dx[EKF_Q31_ATT_DIM] = { 0 };
+    for (uint8_t k = 0; k < 3; k++) {
+        // 앞 성분의 보정을 선형으로 반영
+        int64_t y_k = innov[k];
+        for (uint8_t j = 0; j < EKF_Q31_ATT_DIM; j++) {
+            y_k -= q31_round_shift((int64_t)H[k][j] * dx[j], 30);
+        }
+        ekf_q31_scalar_update(&f->P_att[0][0], EKF_Q31_ATT_DIM, H[k], q31_saturate(y_k), f->r_gravity, 0, dx);
+    }
+
+    for (uint8_t i = 0; i < 4; i++) {
+        f->q[i] = q31_saturate((int64_t)f->q[i] + q31_round_shift(dx[Q31_ATT_QUAT + i], Q31_QUAT_SHIFT));
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        int64_t d = dx[Q31_ATT_BIAS + i];
+        f->gyro_bias[i] = q31_saturate((int64_t)f->gyro_bias[i] +
+                                       (Q31_BIAS_SHIFT > 0 ? q31_round_shift(d, Q31_BIAS_SHIFT) : d));
+    }
+    ekf_q31_normalize(f->q);
+    f->stats.gravity_updates++;
+
+    return true;
+}
+
+/**
+ * @brief 기압 고도 갱신
+ */
+bool ekf_q31_update_baro(EKF_Q31 *f, int32_t alt) {
+    if (f == NULL) {
+        return false;
+    }
+
+    ekf_q31_flush_covariance(f);
+
+    static const int32_t H[EKF_Q31_VERT_DIM] = { (int32_t)1 << 30, 0 };
+    int32_t y = q31_saturate(((int64_t)alt - f->pos_z) * ((int64_t)1 << Q31_POS_SHIFT));
+    int32_t dx[EKF_Q31_VERT_DIM] = { 0 };
+    if (!ekf_q31_scalar_update(&f->P_vert[0][0], EKF_Q31_VERT_DIM, H, y, f->r_baro, f->nis_gate_q8, dx)) {
+        f->stats.baro_rejects++;
+        return false;
+    }
+
+    f->pos_z = q31_saturate((int64_t)f->pos_z + q31_round_shift(dx[Q31_VERT_POS], Q31_POS_SHIFT));
+    f->vel_z = q31_saturate((int64_t)f->vel_z + q31_round_shift(dx[Q31_VERT_VEL], Q31_VEL_SHIFT));
+    f->stats.baro_updates++;
+
+    return true;
+}
+
+/**
+ * @brief 자세 사원수 조회
+ */
+bool ekf_q31_get_attitude(const EKF_Q31 *f, int32_t q[4]) {
+    if (f == NULL || q == NULL) {
+        return false;
+    }
+
+    memcpy(q, f->q, sizeof(f->q));
+
+    return true;
+}
+
+/**
+ * @brief 수직 채널 조회
+ */
+bool ekf_q31_get_vertical(const EKF_Q31 *f, int32_t *pos_z, int32_t *vel_z) {
+    if (f == NULL) {
+        return false;
+    }
+
+    if (pos_z != NULL) {
+        *pos_z = f->pos_z;
+    }
+    if (vel_z != NULL) {
+        *vel_z = f->vel_z;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 분산 조회 (대기 중인 전파는 반영하지 않음)
+ */
+bool ekf_q31_get_variances(const EKF_Q31 *f, float var[EKF_Q31_ATT_DIM + EKF_Q31_VERT_DIM]) {
+    if (f == NULL || var == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 4; i++) {
+        var[Q31_ATT_QUAT + i] = q31_to_float(f->P_att[Q31_ATT_QUAT + i][Q31_ATT_QUAT + i], 2 * EKF_Q31_P_QUAT_EXP);
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        var[Q31_ATT_BIAS + i] = q31_to_float(f->P_att[Q31_ATT_BIAS + i][Q31_ATT_BIAS + i], 2 * EKF_Q31_P_BIAS_EXP);
+    }
+    var[EKF_Q31_ATT_DIM + Q31_VERT_POS] = q31_to_float(f->P_vert[Q31_VERT_POS][Q31_VERT_POS], 2 * EKF_Q31_P_POS_EXP);
+    var[EKF_Q31_ATT_DIM + Q31_VERT_VEL] = q31_to_float(f->P_vert[Q31_VERT_VEL][Q31_VERT_VEL], 2 * EKF_Q31_P_VEL_EXP);
+
+    return true;
+}
+
+/**
+ * @brief 갱신 통계 조회
+ */
+const EKF_Q31_Stats *ekf_q31_get_stats(const EKF_Q31 *f) {
+    return (f != NULL) ? &f->stats : NULL;
+}
@@ -4,35 +4,41 @@
  */
 
 #include "ekf/ekf.h"
+#include "ekf/ekf_generated.h"
+#include "sys/profile.h"
+#include "sys/mem_section.h"
+#include <stddef.h>
+#include <string.h>
 #include <math.h>
 
+#if EKF_CONFIG_POSITION
 /**
- * @brief GPS 측정 갱신을 위한 측정 자코비안 계산
+ * @brief GPS 측정 갱신을 위한 측정 자코비안 계산 (위치 + 속도)
+ * 
+ * H의 각 행은 (상태 인덱스, 값) 쌍으로 구성된 희소 행이다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param H 측정 자코비안 행렬 (6x16)
+ * @param H 측정 자코비안 희소 행 배열 (6행)
  * @return bool 계산 성공 여부
  */
-static bool ekf_compute_gps_jacobian(EKF *ekf, Matrix *H) {
+static bool ekf_compute_gps_jacobian(EKF *ekf, MatrixSparseRow H[6]) {
     if (ekf == NULL || H == NULL) {
         return false;
     }
     
-    // 측정 자코비안 초기화 (영행렬)
-    *H = matrix_create(6, EKF_STATE_DIM);
-    matrix_zero(H);
-    
     // GPS 위치 측정에 대한 자코비안
     // 위치 상태에 대한 직접적인 매핑
-    matrix_set(H, 0, EKF_STATE_POS_X, 1.0f);
-    matrix_set(H, 1, EKF_STATE_POS_Y, 1.0f);
-    matrix_set(H, 2, EKF_STATE_POS_Z, 1.0f);
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        matrix_sparse_row_add(&H[i], EKF_STATE_POS_X + i, 1.0f);
+    }
     
     // GPS 속도 측정에 대한 자코비안
     // 속도 상태에 대한 직접적인 매핑
-    matrix_set(H, 3, EKF_STATE_VEL_X, 1.0f);
-    matrix_set(H, 4, EKF_STATE_VEL_Y, 1.0f);
-    matrix_set(H, 5, EKF_STATE_VEL_Z, 1.0f);
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[3 + i]);
+        matrix_sparse_row_add(&H[3 + i], EKF_STATE_VEL_X + i, 1.0f);
+    }
     
     return true;
 }
@@ -41,303 +47,2494 @@ static bool ekf_compute_gps_jacobian(EKF *ekf, Matrix *H) {
  * @brief 기압계 측정 갱신을 위한 측정 자코비안 계산
  * 
  * @param ekf EKF 구조체 포인터
- * @param H 측정 자코비안 행렬 (1x16)
+ * @param H 측정 자코비안 희소 행 배열 (1행)
  * @return bool 계산 성공 여부
  */
-static bool ekf_compute_baro_jacobian(EKF *ekf, Matrix *H) {
+static bool ekf_compute_baro_jacobian(EKF *ekf, MatrixSparseRow H[1]) {
     if (ekf == NULL || H == NULL) {
         return false;
     }
     
-    // 측정 자코비안 초기화 (영행렬)
-    *H = matrix_create(1, EKF_STATE_DIM);
-    matrix_zero(H);
-    
     // 기압계 고도 측정은 Z 위치에만 영향
-    matrix_set(H, 0, EKF_STATE_POS_Z, 1.0f);
+    matrix_sparse_row_clear(&H[0]);
+    matrix_sparse_row_add(&H[0], EKF_STATE_POS_Z, 1.0f);
     
     return true;
 }
+#endif /* EKF_CONFIG_POSITION */
+
+#if EKF_CONFIG_GNSS_CLOCK
+/**
+ * @brief 위성 시선 방향 관측의 측정 자코비안 계산 (의사거리, 의사거리 변화율)
+ * 
+ * 위성 방향으로 움직이면 거리가 줄어들므로 위치(속도) 3개 열은 -los,
+ * 시계 바이어스(드리프트) 열은 1이다.
+ * 
+ * @param los 수신기 → 위성 단위 시선 벡터 (NED)
+ * @param first 위치 또는 속도 블록의 첫 상태 인덱스
+ * @param clock 시계 바이어스 또는 드리프트 상태 인덱스
+ * @param H 측정 자코비안 희소 행 배열 (1행)
+ */
+static void ekf_compute_line_of_sight_jacobian(Vector3f los, uint8_t first, uint8_t clock,
+                                               MatrixSparseRow H[1]) {
+    matrix_sparse_row_clear(&H[0]);
+    matrix_sparse_row_add(&H[0], first, -los.x);
+    matrix_sparse_row_add(&H[0], first + 1, -los.y);
+    matrix_sparse_row_add(&H[0], first + 2, -los.z);
+    matrix_sparse_row_add(&H[0], clock, 1.0f);
+}
+#endif /* EKF_CONFIG_GNSS_CLOCK */
 
 /**
- * @brief 자력계 측정 갱신을 위한 측정 자코비안 계산
+ * @brief 속도 측정 갱신을 위한 측정 자코비안 계산 (GPS 속도 전용, 영속도 갱신)
  * 
  * @param ekf EKF 구조체 포인터
- * @param H 측정 자코비안 행렬 (3x16)
+ * @param H 측정 자코비안 희소 행 배열 (3행)
  * @return bool 계산 성공 여부
  */
-static bool ekf_compute_mag_jacobian(EKF *ekf, Matrix *H) {
+static bool ekf_compute_velocity_jacobian(EKF *ekf, MatrixSparseRow H[3]) {
     if (ekf == NULL || H == NULL) {
         return false;
     }
     
-    // 측정 자코비안 초기화 (영행렬)
-    *H = matrix_create(3, EKF_STATE_DIM);
-    matrix_zero(H);
+    // 속도 상태에 대한 직접적인 매핑
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        matrix_sparse_row_add(&H[i], EKF_STATE_VEL_X + i, 1.0f);
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 영각속도 갱신을 위한 측정 자코비안 계산 (자이로 바이어스)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param H 측정 자코비안 희소 행 배열 (3행)
+ * @return bool 계산 성공 여부
+ */
+static bool ekf_compute_gyro_bias_jacobian(EKF *ekf, MatrixSparseRow H[3]) {
+    if (ekf == NULL || H == NULL) {
+        return false;
+    }
     
-    // 현재 자세 사원수 추출
-    float qw, qx, qy, qz;
-    matrix_get(&ekf->x, EKF_STATE_QUAT_W, 0, &qw);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_X, 0, &qx);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Y, 0, &qy);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Z, 0, &qz);
+    // 자이로 바이어스 상태에 대한 직접적인 매핑
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        matrix_sparse_row_add(&H[i], EKF_STATE_GYRO_BIAS_X + i, 1.0f);
+    }
     
-    // 지구 자기장 벡터
-    float mx = ekf->earth_mag_ned.x;
-    float my = ekf->earth_mag_ned.y;
-    float mz = ekf->earth_mag_ned.z;
+    return true;
+}
+
+/**
+ * @brief 자력계 측정 모델 (예측값과 측정 자코비안, 생성 커널)
+ * 
+ * h = R(q)^T m_earth (+ b_m), 각 행은 사원수 4개 열만 비영
+ * 자력계 바이어스 블록이 켜져 있으면 행마다 바이어스 열 하나(단위 원소)가 더해진다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param q 단위 자세 사원수
+ * @param H 측정 자코비안 희소 행 배열 (3행)
+ * @param pred 예측 측정 (몸체)
+ */
+static void ekf_compute_mag_model(const EKF *ekf, Quaternion q, MatrixSparseRow H[3], Vector3f *pred) {
+    const float qa[4] = { q.w, q.x, q.y, q.z };
+    const float m[3] = { ekf->earth_mag_ned.x, ekf->earth_mag_ned.y, ekf->earth_mag_ned.z };
+    float h[3];
+    float Hq[3][4];
+    ekf_gen_mag_observation(qa, m, h, Hq);
     
-    // 자력계 측정에 대한 자코비안 (자세 사원수에 대한 편미분)
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        for (uint8_t k = 0; k < 4; k++) {
+            matrix_sparse_row_add(&H[i], EKF_STATE_QUAT_W + k, Hq[i][k]);
+        }
+    }
+    *pred = vector3f_create(h[0], h[1], h[2]);
     
-    // 자세 사원수에 대한 자력계 측정의 자코비안 계산
-    // dh/dq = d(R(q) * m_earth)/dq
+#if EKF_CONFIG_MAG_BIAS
+    // 몸체 좌표계 자력계 바이어스 (꺼져 있으면 열을 넣지 않아 추정되지 않음)
+    *pred = vector3f_add(*pred, ekf->s.bm);
+    if (ekf->mag_bias_enabled) {
+        for (uint8_t i = 0; i < 3; i++) {
+            matrix_sparse_row_add(&H[i], EKF_STATE_MAG_BIAS_X + i, 1.0f);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief GPS 측정 예측과 자코비안에 안테나 레버 암 반영
+ * 
+ * 위치 p + R(q) l, 속도 v + R(q) (ω × l) 이 되도록 IMU 기준 예측값에 더하고,
+ * 각 행에 사원수 네 열을 추가한다 (행당 비영 원소 5개).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param H GPS 자코비안 (위치 0..2행, 속도 3..5행, 위치 블록 제외 구성은 속도 행만 사용)
+ * @param pred 예측 측정 (위치 3, 속도 3, IMU 기준 값에 더함)
+ */
+static void ekf_apply_gps_lever_arm(const EKF *ekf, MatrixSparseRow H[6], float pred[6]) {
+    Vector3f l = ekf->gps_lever_arm;
+    if (l.x == 0.0f && l.y == 0.0f && l.z == 0.0f) {
+        return;
+    }
     
-    // qw에 대한 편미분
-    matrix_set(H, 0, EKF_STATE_QUAT_W, 2.0f * (- qz*my + qy*mz));
-    matrix_set(H, 1, EKF_STATE_QUAT_W, 2.0f * (qz*mx - qx*mz));
-    matrix_set(H, 2, EKF_STATE_QUAT_W, 2.0f * (- qy*mx + qx*my));
+    Quaternion q = ekf->s.quat;
+    const float qa[4] = { q.w, q.x, q.y, q.z };
+    float h[3];
+    float Hq[3][4];
     
-    // qx에 대한 편미분
-    matrix_set(H, 0, EKF_STATE_QUAT_X, 2.0f * (qy*my + qz*mz));
-    matrix_set(H, 1, EKF_STATE_QUAT_X, 2.0f * (qy*mx - 2.0f*qx*my - qw*mz));
-    matrix_set(H, 2, EKF_STATE_QUAT_X, 2.0f * (qz*mx + qw*my - 2.0f*qx*mz));
+#if EKF_CONFIG_POSITION
+    // 위치: R(q) l
+    const float la[3] = { l.x, l.y, l.z };
+    ekf_gen_body_to_nav(qa, la, h, Hq);
+    for (uint8_t i = 0; i < 3; i++) {
+        pred[i] += h[i];
+        for (uint8_t k = 0; k < 4; k++) {
+            matrix_sparse_row_add(&H[i], EKF_STATE_QUAT_W + k, Hq[i][k]);
+        }
+    }
+#endif
     
-    // qy에 대한 편미분
-    matrix_set(H, 0, EKF_STATE_QUAT_Y, 2.0f * (- 2.0f*qy*mx + qx*my + qw*mz));
-    matrix_set(H, 1, EKF_STATE_QUAT_Y, 2.0f * (qx*mx + qz*mz));
-    matrix_set(H, 2, EKF_STATE_QUAT_Y, 2.0f * (- qw*mx + qz*my - 2.0f*qy*mz));
+    // 속도: R(q) (ω × l), ω는 바이어스 보정 각속도 (몸체)
+    Vector3f w = vector3f_subtract(ekf->gyro_last, ekf->s.bg);
+    Vector3f wl = vector3f_cross(w, l);
+    const float wla[3] = { wl.x, wl.y, wl.z };
+    ekf_gen_body_to_nav(qa, wla, h, Hq);
+    for (uint8_t i = 0; i < 3; i++) {
+        pred[3 + i] += h[i];
+        for (uint8_t k = 0; k < 4; k++) {
+            matrix_sparse_row_add(&H[3 + i], EKF_STATE_QUAT_W + k, Hq[i][k]);
+        }
+    }
+}
+
+/**
+ * @brief 상태 벡터의 사원수 부분 정규화
+ * 
+ * 갱신 증분은 작으므로 보통 1차 보정(sqrt 없음)으로 충분하고, 노름 오차가 한계를 넘을 때만
+ * 전체 정규화한다. 이후 측정 모델과 출력은 저장된 사원수를 그대로 쓴다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ */
+static void ekf_normalize_state_quaternion(EKF *ekf) {
+    ekf->s.quat = quaternion_renormalize(ekf->s.quat, &ekf->quat_norm_error);
+}
+
+/**
+ * @brief NIS 기록 및 혁신 게이트 판정
+ * 
+ * 임계값을 넘어도 연속 거부가 복구 조건(ekf_set_innovation_gate_recovery)에 닿았으면 한 번 수용한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param nis 정규화 혁신 제곱
+ * @return bool 측정 수용 여부 (임계값 초과 또는 NaN이면 false)
+ */
+static bool ekf_innovation_gate(EKF *ekf, EKF_Sensor sensor, float nis) {
+    EKF_NisWindow *w = &ekf->nis_window[sensor];
+    ekf->nis_last[sensor] = nis;
+    if (isfinite(nis)) {
+        ekf->nis_sum[sensor] += nis;
+        ekf->nis_count[sensor]++;
+        w->count++;
+        w->sum += nis;
+        w->sum_sq += nis * nis;
+        w->max = (nis > w->max) ? nis : w->max;
+    }
     
-    // qz에 대한 편미분
-    matrix_set(H, 0, EKF_STATE_QUAT_Z, 2.0f * (- 2.0f*qz*mx - qw*my + qx*mz));
-    matrix_set(H, 1, EKF_STATE_QUAT_Z, 2.0f * (qw*mx - 2.0f*qz*my + qy*mz));
-    matrix_set(H, 2, EKF_STATE_QUAT_Z, 2.0f * (qx*mx + qy*my));
+    float gate = ekf->nis_gate[sensor];
+    if (gate <= 0.0f || nis <= gate) {
+        ekf->nis_reject_streak[sensor] = 0;
+        return true;
+    }
     
-    return true;
+    // 연속 거부가 한계에 닿으면 유한한 측정 하나를 강제 수용 (P가 굳어 NIS가 내려오지 않는 경우)
+    uint16_t streak = ekf->nis_reject_streak[sensor];
+    if (streak > 0 && isfinite(nis)) {
+        uint16_t max_rejects = ekf->nis_recover_rejects[sensor];
+        uint32_t max_time_us = ekf->nis_recover_time_us[sensor];
+        uint32_t elapsed_us = ekf->gate_clock_us - ekf->nis_reject_start_us[sensor];
+        if ((max_rejects > 0 && streak >= max_rejects) || (max_time_us > 0 && elapsed_us >= max_time_us)) {
+            ekf->nis_reject_streak[sensor] = 0;
+            ekf->nis_recover_count[sensor]++;
+            return true;
+        }
+    }
+    
+    if (streak == 0) {
+        ekf->nis_reject_start_us[sensor] = ekf->gate_clock_us;
+    }
+    if (streak < UINT16_MAX) {
+        ekf->nis_reject_streak[sensor] = streak + 1;
+    }
+    ekf->nis_reject_count[sensor]++;
+    w->rejects++;
+    return false;
+}
+
+/**
+ * @brief 희소 행 h에 대한 이차 형식 h * P * h^T
+ * 
+ * @param P 공분산 행렬
+ * @param h 측정 자코비안 행 (희소)
+ * @return float h * P * h^T
+ */
+static float ekf_sparse_quadratic_form(const EKF_StateCovariance *P, const MatrixSparseRow *h) {
+    float sum = 0.0f;
+    for (uint8_t a = 0; a < h->count; a++) {
+        for (uint8_t b = 0; b < h->count; b++) {
+            sum += h->value[a] * h->value[b] * P->data[EKF_SYM_FN(index)(h->index[a], h->index[b])];
+        }
+    }
+    return sum;
 }
 
 /**
- * @brief 칼만 게인 계산
+ * @brief 혁신 통계 갱신 후 적응형 R 계산
+ * 
+ * 축별로 갱신 전 P의 예측 분산 h_k P h_k^T와 혁신 제곱 y_k^2의 지수 이동 평균을
+ * 갱신하고, 창 길이만큼 쌓이면 R_kk 추정값 / 공칭 R_kk 를 배율로 삼는다.
+ * 배율은 상관을 유지하도록 R_ij * sqrt(s_i * s_j) 로 적용한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param H 측정 자코비안 행렬
- * @param R 측정 노이즈 공분산 행렬
- * @param K 칼만 게인 (출력)
- * @return bool 계산 성공 여부
+ * @param sensor 측정 종류
+ * @param H 측정 자코비안 (희소 행 m개)
+ * @param R 공칭 측정 노이즈 (m x m, 행 우선)
+ * @param y 측정 잔차 (m)
+ * @param m 측정 차원 (EKF_ADAPTIVE_MAX_DIM 이하)
+ * @param R_out 적응형 측정 노이즈 (m x m, 행 우선)
  */
-static bool ekf_compute_kalman_gain(EKF *ekf, Matrix *H, Matrix *R, Matrix *K) {
-    if (ekf == NULL || H == NULL || R == NULL || K == NULL) {
-        return false;
+static void ekf_adaptive_noise_update(EKF *ekf, EKF_Sensor sensor, const MatrixSparseRow *H,
+                                      const float *R, const float *y, uint8_t m, float *R_out) {
+    EKF_AdaptiveNoise *a = &ekf->adaptive[sensor];
+    float alpha = 1.0f / (float)ekf->adaptive_window;
+    float root[EKF_ADAPTIVE_MAX_DIM];
+    
+    for (uint8_t k = 0; k < m; k++) {
+        float hph = ekf_sparse_quadratic_form(&ekf->P, &H[k]);
+        float y2 = y[k] * y[k];
+        if (a->count == 0) {
+            a->innovation_sq[k] = y2;
+            a->predicted_var[k] = hph;
+        } else {
+            a->innovation_sq[k] += alpha * (y2 - a->innovation_sq[k]);
+            a->predicted_var[k] += alpha * (hph - a->predicted_var[k]);
+        }
+        
+        float r_nom = R[k * m + k];
+        if (a->count + 1 >= ekf->adaptive_window && r_nom > 0.0f) {
+            float scale = (a->innovation_sq[k] - a->predicted_var[k]) / r_nom;
+            a->scale[k] = fminf(fmaxf(scale, ekf->adaptive_scale_min), ekf->adaptive_scale_max);
+        }
+        root[k] = sqrtf(a->scale[k]);
     }
+    a->count++;
     
-    // H * P * H^T + R 계산
-    Matrix H_transpose;
-    matrix_transpose(H, &H_transpose);
+    for (uint8_t i = 0; i < m; i++) {
+        for (uint8_t j = 0; j < m; j++) {
+            R_out[i * m + j] = R[i * m + j] * root[i] * root[j];
+        }
+    }
+}
+
+/**
+ * @brief 고려 상태의 게인 행을 0으로 설정 (Schmidt-Kalman)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param K 칼만 게인 (N x m, 행 우선)
+ * @param m 측정 차원
+ */
+static void ekf_consider_gain(const EKF *ekf, float *K, uint8_t m) {
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        if ((ekf->consider_mask >> i) & 1u) {
+            for (uint8_t l = 0; l < m; l++) {
+                K[i * m + l] = 0.0f;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 고려 상태가 있을 때의 표준 형식 공분산 갱신
+ * 
+ * 고려 상태의 게인 행이 0이면 P+ = P - K (PH^T)^T - PH^T K^T + K S K^T 는
+ * 두 상태가 모두 고려 상태인 원소는 그대로, 나머지는 갱신 상태 쪽 게인 행으로
+ * P_ij - K_i (PH^T)_j 가 된다. 압축 대칭 저장의 상삼각 원소만 계산한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param K 칼만 게인 (N x m, 행 우선, 고려 상태 행은 0)
+ * @param PHt P * H^T (N x m, 행 우선)
+ * @param m 측정 차원
+ */
+static void ekf_consider_subtract_product(EKF *ekf, const float *K, const float *PHt, uint8_t m) {
+    uint32_t mask = ekf->consider_mask;
+    uint16_t idx = 0;
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        bool ci = (mask >> i) & 1u;
+        for (uint8_t j = i; j < EKF_STATE_DIM; j++) {
+            bool cj = (mask >> j) & 1u;
+            if (ci && cj) {
+                idx++;
+                continue;
+            }
+            const float *k = ci ? &K[j * m] : &K[i * m];
+            const float *a = ci ? &PHt[i * m] : &PHt[j * m];
+            float sum = 0.0f;
+            for (uint8_t l = 0; l < m; l++) {
+                sum += k[l] * a[l];
+            }
+            ekf->P.data[idx++] -= sum;
+        }
+    }
+}
+
+/**
+ * @brief 공분산 갱신 뒤 상태별 분산 경계 적용 (ekf_set_variance_bounds)
+ * 
+ * @param ekf EKF 구조체 포인터
+ */
+static void ekf_bound_variances(EKF *ekf) {
+    if (ekf->variance_bounds) {
+        ekf->variance_bound_count += EKF_SYM_FN(bound_diagonal)(&ekf->P, ekf->variance_min, ekf->variance_max);
+    }
+}
+
+/**
+ * @brief 측정 차원 M에 대한 일괄 측정 갱신 함수 정의
+ * 
+ * ekf_batch_update_M(ekf, sensor, H, R, y):
+ * PH^T = P * H^T
+ * S = H * PH^T + R
+ * S = L D L^T 분해 (역행렬 없음)
+ * NIS = y^T * S^-1 * y 가 게이트를 넘으면 게인 계산 전에 종료
+ * K = PH^T * S^-1 (PH^T의 행마다 LDL^T 풀이)
+ * x = x + K * y
+ * P = P - K * (PH^T)^T (표준) 또는 Joseph 형식 (ekf->covariance_update)
+ * 
+ * H는 희소 행 배열이므로 PH^T는 P의 비영 열만 모아 계산하고,
+ * S = H * PH^T도 H의 비영 원소만 사용한다.
+ * P는 대칭 압축 저장이므로 HP = (PH^T)^T를 다시 계산하지 않으며,
+ * 공분산 갱신도 상삼각 원소만 계산되어 별도의 대칭화가 필요 없다.
+ * PH^T, K, S, LDL^T 인수는 스택 대신 EKF 스크래치 영역에서 할당한다.
+ */
+#define EKF_DEFINE_BATCH_UPDATE(M)                                              \
+MEM_RAMFUNC(ekf_batch_update_##M)                                              \
+static bool ekf_batch_update_##M(EKF *ekf, EKF_Sensor sensor,                  \
+                                 const MatrixSparseRow *H,                      \
+                                 const Mat##M##x##M *R,                         \
+                                 const Mat##M##x1 *y) {                         \
+    if (ekf == NULL || H == NULL || R == NULL || y == NULL) {                   \
+        return false;                                                           \
+    }                                                                           \
+                                                                                \
+    /* 임시 행렬은 스크래치 영역에서 할당 */                                    \
+    ScratchArena *scratch = ekf->scratch;                                       \
+    uint32_t mark = scratch_mark(scratch);                                      \
+    EKF_MAT_NXM(M) *PHt = scratch_alloc(scratch, sizeof(EKF_MAT_NXM(M)));       \
+    EKF_MAT_NXM(M) *K = scratch_alloc(scratch, sizeof(EKF_MAT_NXM(M)));         \
+    Mat##M##x##M *S = scratch_alloc(scratch, sizeof(Mat##M##x##M));             \
+    Mat##M##x##M *LD = scratch_alloc(scratch, sizeof(Mat##M##x##M));            \
+    if (PHt == NULL || K == NULL || S == NULL || LD == NULL) {                  \
+        scratch_release(scratch, mark);                                         \
+        return false;                                                           \
+    }                                                                           \
+                                                                                \
+    PROFILE_BEGIN(PROFILE_STAGE_GAIN);                                          \
+                                                                                \
+    /* PH^T 계산 (P의 비영 열만 참조) */                                        \
+    EKF_SYM_NXM_FN(multiply_sparse, M)(&ekf->P, H, PHt);                        \
+                                                                                \
+    /* S = H * PH^T + R */                                                      \
+    for (uint8_t i = 0; i < (M); i++) {                                         \
+        for (uint8_t j = 0; j < (M); j++) {                                     \
+            float sum = R->data[i][j];                                          \
+            for (uint8_t k = 0; k < H[i].count; k++) {                          \
+                sum += H[i].value[k] * PHt->data[H[i].index[k]][j];             \
+            }                                                                   \
+            S->data[i][j] = sum;                                                \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    /* S = L D L^T 분해 (S는 대칭 양정치, 역행렬 대신 풀이) */                  \
+    PROFILE_BEGIN(PROFILE_STAGE_INVERSE);                                       \
+    if (!mat##M##x##M##_ldlt(S, LD)) {                                          \
+        /* 분해 실패 (S가 양정치가 아님) */                                     \
+        scratch_release(scratch, mark);                                         \
+        return false;                                                           \
+    }                                                                           \
+    PROFILE_END(PROFILE_STAGE_INVERSE);                                         \
+                                                                                \
+    /* 혁신 게이트: NIS = y^T * S^-1 * y */                                     \
+    float z[M];                                                                 \
+    for (uint8_t i = 0; i < (M); i++) {                                         \
+        z[i] = y->data[i][0];                                                   \
+    }                                                                           \
+    mat##M##x##M##_ldlt_solve(LD, z);                                           \
+    float nis = 0.0f;                                                           \
+    for (uint8_t i = 0; i < (M); i++) {                                         \
+        nis += y->data[i][0] * z[i];                                            \
+    }                                                                           \
+    if (!ekf_innovation_gate(ekf, sensor, nis)) {                               \
+        scratch_release(scratch, mark);                                         \
+        return false;                                                           \
+    }                                                                           \
+                                                                                \
+    /* K = PH^T * S^-1: S가 대칭이므로 K의 행 i는 S k = (PH^T의 행 i)의 해 */   \
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {                               \
+        for (uint8_t j = 0; j < (M); j++) {                                     \
+            K->data[i][j] = PHt->data[i][j];                                    \
+        }                                                                       \
+        mat##M##x##M##_ldlt_solve(LD, K->data[i]);                              \
+    }                                                                           \
+    if (ekf->consider_mask != 0) {                                              \
+        ekf_consider_gain(ekf, &K->data[0][0], (M));                            \
+    }                                                                           \
+    PROFILE_END(PROFILE_STAGE_GAIN);                                            \
+                                                                                \
+    /* 상태 갱신: x = x + K * y (임시 dx 없이 누적) */                          \
+    PROFILE_BEGIN(PROFILE_STAGE_STATE_UPDATE);                                  \
+    EKF_MULTIPLY_ADD_NXM_MX1(M)(K, y, &ekf->x);                                 \
+                                                                                \
+    /* 사원수 정규화 */                                                         \
+    ekf_normalize_state_quaternion(ekf);                                        \
+    PROFILE_END(PROFILE_STAGE_STATE_UPDATE);                                    \
+                                                                                \
+    /* 공분산 갱신 */                                                           \
+    PROFILE_BEGIN(PROFILE_STAGE_COVARIANCE_UPDATE);                             \
+    if (ekf->covariance_update == EKF_COVARIANCE_JOSEPH) {                      \
+        /* P = (I - K*H) * P * (I - K*H)^T + K * R * K^T */                     \
+        EKF_SYM_NXM_FN(joseph_update, M)(&ekf->P, K, PHt, S);                   \
+    } else if (ekf->consider_mask != 0) {                                       \
+        /* 고려 상태끼리 블록을 제외한 P - K * (PH^T)^T */                      \
+        ekf_consider_subtract_product(ekf, &K->data[0][0],                      \
+                                      &PHt->data[0][0], (M));                   \
+    } else {                                                                    \
+        /* P = P - K * (PH^T)^T = (I - K * H) * P */                            \
+        EKF_SYM_NXM_FN(subtract_product, M)(&ekf->P, K, PHt);                   \
+    }                                                                           \
+    ekf_bound_variances(ekf);                                                   \
+    PROFILE_END(PROFILE_STAGE_COVARIANCE_UPDATE);                               \
+                                                                                \
+    scratch_release(scratch, mark);                                             \
+    return true;                                                                \
+}
+
+EKF_DEFINE_BATCH_UPDATE(3)
+EKF_DEFINE_BATCH_UPDATE(1)
+#if EKF_CONFIG_POSITION
+/* 측정 차원 6은 위치 상태를 쓰는 GPS 위치+속도 전용 */
+EKF_DEFINE_BATCH_UPDATE(6)
+#endif
+
+/**
+ * @brief 스칼라 관측 하나에 대한 측정 갱신
+ * 
+ * PH^T = P * h^T (N x 1)
+ * s = h * PH^T + r (스칼라)
+ * K = PH^T / s
+ * x = x + K * y
+ * P = P - K * (PH^T)^T (표준) 또는 Joseph 형식 (ekf->covariance_update)
+ * 
+ * 역행렬 대신 나눗셈 한 번으로 처리하며, h의 비영 원소만 참조한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param h 측정 자코비안 행 (희소)
+ * @param r 측정 노이즈 분산
+ * @param y 측정 잔차
+ * @return bool 갱신 성공 여부 (혁신 분산이 양수가 아니면 false)
+ */
+static bool ekf_scalar_update(EKF *ekf, const MatrixSparseRow *h, float r, float y) {
+    PROFILE_BEGIN(PROFILE_STAGE_GAIN);
     
-    Matrix temp1, temp2, S;
-    matrix_multiply(H, &ekf->P, &temp1);
-    matrix_multiply(&temp1, &H_transpose, &temp2);
-    matrix_add(&temp2, R, &S);
+    // PH^T 계산
+    EKF_StateVector PHt;
+    EKF_SYM_NXM_FN(multiply_sparse, 1)(&ekf->P, h, &PHt);
     
-    // S 역행렬 계산
-    Matrix S_inv;
-    if (!matrix_inverse(&S, &S_inv)) {
-        // 역행렬 계산 실패
+    // 혁신 분산 s = h * PH^T + r
+    float s = matrix_sparse_row_dot(h, &PHt.data[0][0]) + r;
+    if (!(s > 0.0f)) {
         return false;
     }
     
-    // K = P * H^T * S^-1
-    Matrix temp3;
-    matrix_multiply(&ekf->P, &H_transpose, &temp3);
-    matrix_multiply(&temp3, &S_inv, K);
+    // K = PH^T / s
+    EKF_StateVector K;
+    EKF_VEC_FN(scale)(&PHt, 1.0f / s, &K);
+    if (ekf->consider_mask != 0) {
+        ekf_consider_gain(ekf, &K.data[0][0], 1);
+    }
+    PROFILE_END(PROFILE_STAGE_GAIN);
+    
+    // 상태 갱신: x = x + K * y
+    PROFILE_BEGIN(PROFILE_STAGE_STATE_UPDATE);
+    EKF_VEC_FN(add_scaled)(&ekf->x, &K, y);
+    PROFILE_END(PROFILE_STAGE_STATE_UPDATE);
+    
+    // 공분산 갱신
+    PROFILE_BEGIN(PROFILE_STAGE_COVARIANCE_UPDATE);
+    if (ekf->covariance_update == EKF_COVARIANCE_JOSEPH) {
+        // P = (I - K*h) * P * (I - K*h)^T + K * r * K^T
+        Mat1x1 S;
+        S.data[0][0] = s;
+        EKF_SYM_NXM_FN(joseph_update, 1)(&ekf->P, &K, &PHt, &S);
+    } else if (ekf->consider_mask != 0) {
+        // 고려 상태끼리 블록을 제외한 P - K * (PH^T)^T
+        ekf_consider_subtract_product(ekf, &K.data[0][0], &PHt.data[0][0], 1);
+    } else {
+        // P = P - K * (PH^T)^T
+        EKF_SYM_NXM_FN(subtract_product, 1)(&ekf->P, &K, &PHt);
+    }
+    ekf_bound_variances(ekf);
+    PROFILE_END(PROFILE_STAGE_COVARIANCE_UPDATE);
     
     return true;
 }
 
 /**
- * @brief 상태 및 공분산 갱신
+ * @brief U-D 엔진의 스칼라 관측 갱신 (Bierman)
+ * 
+ * U, D와 칼만 게인을 한 번에 갱신하며 P는 건드리지 않는다.
+ * 관측 묶음 처리 후 호출자가 P를 복원한다.
  * 
  * @param ekf EKF 구조체 포인터
- * @param K 칼만 게인
- * @param y 측정 잔차 (측정값 - 예측값)
- * @param H 측정 자코비안 행렬
- * @return bool 갱신 성공 여부
+ * @param h 측정 자코비안 행 (희소)
+ * @param r 측정 노이즈 분산 (양수)
+ * @param y 측정 잔차
+ * @return bool 갱신 성공 여부 (r이 양수가 아니면 false)
  */
-static bool ekf_update_state_covariance(EKF *ekf, Matrix *K, Matrix *y, Matrix *H) {
-    if (ekf == NULL || K == NULL || y == NULL || H == NULL) {
+static bool ekf_ud_scalar_update(EKF *ekf, const MatrixSparseRow *h, float r, float y) {
+    PROFILE_BEGIN(PROFILE_STAGE_COVARIANCE_UPDATE);
+    EKF_StateVector K;
+    float s;
+    if (!EKF_UD_FN(scalar_update)(&ekf->UD, h, r, &K, &s)) {
         return false;
     }
+    PROFILE_END(PROFILE_STAGE_COVARIANCE_UPDATE);
     
     // 상태 갱신: x = x + K * y
-    Matrix dx;
-    matrix_multiply(K, y, &dx);
-    matrix_add(&ekf->x, &dx, &ekf->x);
-    
-    // 사원수 정규화
-    float qw, qx, qy, qz;
-    matrix_get(&ekf->x, EKF_STATE_QUAT_W, 0, &qw);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_X, 0, &qx);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Y, 0, &qy);
-    matrix_get(&ekf->x, EKF_STATE_QUAT_Z, 0, &qz);
-    
-    Quaternion q = quaternion_create(qw, qx, qy, qz);
-    q = quaternion_normalize(q);
-    
-    matrix_set(&ekf->x, EKF_STATE_QUAT_W, 0, q.w);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_X, 0, q.x);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_Y, 0, q.y);
-    matrix_set(&ekf->x, EKF_STATE_QUAT_Z, 0, q.z);
-    
-    // 공분산 갱신: P = (I - K * H) * P
-    Matrix I = matrix_identity(EKF_STATE_DIM);
-    Matrix KH, I_KH;
-    matrix_multiply(K, H, &KH);
-    matrix_subtract(&I, &KH, &I_KH);
-    
-    Matrix P_new;
-    matrix_multiply(&I_KH, &ekf->P, &P_new);
-    ekf->P = P_new;
-    
-    // 공분산 행렬의 대칭성 보장
-    Matrix P_transpose;
-    matrix_transpose(&ekf->P, &P_transpose);
-    matrix_add(&ekf->P, &P_transpose, &P_new);
-    matrix_scale(&P_new, 0.5f, &ekf->P);
+    PROFILE_BEGIN(PROFILE_STAGE_STATE_UPDATE);
+    EKF_VEC_FN(add_scaled)(&ekf->x, &K, y);
+    PROFILE_END(PROFILE_STAGE_STATE_UPDATE);
     
     return true;
 }
 
 /**
- * @brief GPS 측정 갱신
+ * @brief 순차 측정 갱신 (측정 차원 m은 실행 시 결정)
+ * 
+ * 먼저 갱신 전 P로 S의 대각 원소 S_kk = h_k * P * h_k^T + R_kk 를 구해
+ * NIS ≈ Σ y_k^2 / S_kk 로 게이트를 판정하고, 거부되면 갱신 없이 종료한다.
+ * H의 각 행을 R의 대각 원소와 함께 스칼라 관측으로 차례로 처리한다.
+ * 앞선 관측으로 상태가 x_prior에서 이동한 만큼 잔차를
+ * y_k - h_k * (x - x_prior) 로 보정하여, 선형화 지점이 같은
+ * 일괄 갱신과 동일한 결과를 얻는다. 사원수 정규화는 마지막에 한 번 수행한다.
+ * U-D 엔진에서는 각 관측을 Bierman 갱신으로 처리하고 마지막에 P를 복원한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param H 측정 자코비안 (희소 행 m개)
+ * @param R 측정 노이즈 (m x m, 행 우선, 대각만 사용)
+ * @param y 측정 잔차 (m)
+ * @param m 측정 차원
+ * @return bool 갱신 성공 여부
  */
-bool ekf_update_gps(EKF *ekf, Vector3f pos, Vector3f vel) {
-    if (ekf == NULL || !ekf->initialized) {
+MEM_RAMFUNC(ekf_sequential_update_rows)
+static bool ekf_sequential_update_rows(EKF *ekf, EKF_Sensor sensor, const MatrixSparseRow *H,
+                                       const float *R, const float *y, uint8_t m) {
+    if (ekf == NULL || H == NULL || R == NULL || y == NULL) {
         return false;
     }
     
-    // 1. 측정 자코비안 계산
-    Matrix H;
-    ekf_compute_gps_jacobian(ekf, &H);
+    // 혁신 게이트 (S 대각 근사)
+    float nis = 0.0f;
+    for (uint8_t k = 0; k < m; k++) {
+        float s_kk = ekf_sparse_quadratic_form(&ekf->P, &H[k]) + R[k * m + k];
+        if (!(s_kk > 0.0f)) {
+            return false;
+        }
+        nis += y[k] * y[k] / s_kk;
+    }
+    if (!ekf_innovation_gate(ekf, sensor, nis)) {
+        return false;
+    }
     
-    // 2. 예측된 측정값 계산
-    Vector3f pos_pred = ekf_get_position(ekf);
-    Vector3f vel_pred = ekf_get_velocity(ekf);
+    EKF_StateVector x_prior = ekf->x;
+    bool ok = true;
     
-    // 3. 측정 잔차 계산 (측정값 - 예측값)
-    Matrix z = matrix_create(6, 1);
-    Matrix z_pred = matrix_create(6, 1);
+    for (uint8_t k = 0; k < m; k++) {
+        const MatrixSparseRow *h = &H[k];
+        
+        // 앞선 스칼라 갱신에 의한 상태 변화만큼 잔차 보정
+        EKF_StateVector dx;
+        EKF_VEC_FN(subtract)(&ekf->x, &x_prior, &dx);
+        float y_k = y[k] - matrix_sparse_row_dot(h, &dx.data[0][0]);
+        
+        bool updated = (ekf->engine == EKF_ENGINE_UD)
+            ? ekf_ud_scalar_update(ekf, h, R[k * m + k], y_k)
+            : ekf_scalar_update(ekf, h, R[k * m + k], y_k);
+        if (!updated) {
+            ok = false;
+            break;
+        }
+    }
+    
+    // U-D 엔진: 읽기 전용 P 사본 복원
+    if (ekf->engine == EKF_ENGINE_UD) {
+        EKF_UD_FN(to_sym)(&ekf->UD, &ekf->P);
+    }
+    
+    // 사원수 정규화
+    ekf_normalize_state_quaternion(ekf);
     
-    // 측정값
-    matrix_set(&z, 0, 0, pos.x);
-    matrix_set(&z, 1, 0, pos.y);
-    matrix_set(&z, 2, 0, pos.z);
-    matrix_set(&z, 3, 0, vel.x);
-    matrix_set(&z, 4, 0, vel.y);
-    matrix_set(&z, 5, 0, vel.z);
+    return ok;
+}
+
+/**
+ * @brief 측정 차원 M에 대한 순차 측정 갱신 함수 정의
+ * 
+ * ekf_sequential_update_M(ekf, sensor, H, R, y): ekf_sequential_update_rows의 고정 크기 형식
+ */
+#define EKF_DEFINE_SEQUENTIAL_UPDATE(M)                                         \
+static bool ekf_sequential_update_##M(EKF *ekf, EKF_Sensor sensor,             \
+                                      const MatrixSparseRow *H,                 \
+                                      const Mat##M##x##M *R,                    \
+                                      const Mat##M##x1 *y) {                    \
+    if (R == NULL || y == NULL) {                                               \
+        return false;                                                           \
+    }                                                                           \
+    return ekf_sequential_update_rows(ekf, sensor, H, &R->data[0][0],           \
+                                      &y->data[0][0], (M));                     \
+}
+
+EKF_DEFINE_SEQUENTIAL_UPDATE(3)
+EKF_DEFINE_SEQUENTIAL_UPDATE(1)
+#if EKF_CONFIG_POSITION
+EKF_DEFINE_SEQUENTIAL_UPDATE(6)
+#endif
+
+/**
+ * @brief 고정 게인으로 측정 하나 처리 (게이트와 상태 갱신만)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param R 측정 노이즈 (m x m, 행 우선)
+ * @param y 측정 잔차 (m)
+ * @param m 측정 차원
+ * @param ok 갱신 결과 (처리했을 때만 기록)
+ * @return bool 고정 게인으로 처리했으면 true (false이면 전체 계산 필요)
+ */
+static bool ekf_steady_gain_apply(EKF *ekf, EKF_Sensor sensor, const float *R, const float *y,
+                                  uint8_t m, bool *ok) {
+    const EKF_SteadyGain *g = &ekf->steady[sensor];
     
-    // 예측값
-    matrix_set(&z_pred, 0, 0, pos_pred.x);
-    matrix_set(&z_pred, 1, 0, pos_pred.y);
-    matrix_set(&z_pred, 2, 0, pos_pred.z);
-    matrix_set(&z_pred, 3, 0, vel_pred.x);
-    matrix_set(&z_pred, 4, 0, vel_pred.y);
-    matrix_set(&z_pred, 5, 0, vel_pred.z);
+    // 고정 당시와 R이 다르면 게인이 맞지 않음
+    for (uint8_t k = 0; k < m; k++) {
+        if (R[k * m + k] != g->r_diag[k]) {
+            ekf_steady_gain_reset(ekf);
+            return false;
+        }
+    }
     
-    // 잔차
-    Matrix y;
-    matrix_subtract(&z, &z_pred, &y);
+    // NIS = y^T S^-1 y, 거부되면 전체 계산으로 복귀
+    float nis = 0.0f;
+    for (uint8_t i = 0; i < m; i++) {
+        for (uint8_t j = 0; j < m; j++) {
+            nis += y[i] * g->S_inv[i * m + j] * y[j];
+        }
+    }
+    if (!ekf_innovation_gate(ekf, sensor, nis)) {
+        ekf_steady_gain_reset(ekf);
+        *ok = false;
+        return true;
+    }
     
-    // 4. 칼만 게인 계산
-    Matrix K;
-    if (!ekf_compute_kalman_gain(ekf, &H, &ekf->R_gps, &K)) {
-        return false;
+    // x = x + K y
+    PROFILE_BEGIN(PROFILE_STAGE_STATE_UPDATE);
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        float sum = 0.0f;
+        for (uint8_t j = 0; j < m; j++) {
+            sum += g->K[i * m + j] * y[j];
+        }
+        ekf->x.data[i][0] += sum;
     }
+    ekf_normalize_state_quaternion(ekf);
+    PROFILE_END(PROFILE_STAGE_STATE_UPDATE);
     
-    // 5. 상태 및 공분산 갱신
-    return ekf_update_state_covariance(ekf, &K, &y, &H);
+    ekf->steady_updates++;
+    *ok = true;
+    return true;
 }
 
 /**
- * @brief 기압계 측정 갱신
+ * @brief 측정 차원 M에 대한 정상 상태 게인 처리 함수 정의
+ * 
+ * ekf_steady_gain_step_M(ekf, sensor, H, R, y, ok):
+ * 게인이 고정되어 있고 이 측정 종류가 수렴했으면 고정 게인으로 처리한다.
+ * 그 밖에는 고정을 풀고, 갱신 전 P로 K = PH^T S^-1 과 S^-1을 구해 직전 게인과
+ * 비교한 뒤 false를 돌려준다 (호출자가 전체 계산으로 갱신).
+ * 기록이 쌓이는 동안 PH^T와 S 분해를 한 번 더 계산하지만 고정되면 모두 생략된다.
  */
-bool ekf_update_baro(EKF *ekf, float altitude) {
-    if (ekf == NULL || !ekf->initialized) {
-        return false;
+#define EKF_DEFINE_STEADY_GAIN(M)                                               \
+static bool ekf_steady_gain_step_##M(EKF *ekf, EKF_Sensor sensor,              \
+                                     const MatrixSparseRow *H,                  \
+                                     const Mat##M##x##M *R,                     \
+                                     const Mat##M##x1 *y, bool *ok) {           \
+    uint32_t bit = 1u << sensor;                                                \
+    if ((ekf->steady_gain_mask & bit) == 0) {                                   \
+        /* 고정 대상이 아닌 측정: 전체 계산 */                                  \
+        if (ekf->steady_frozen) {                                               \
+            ekf_steady_gain_reset(ekf);                                         \
+        }                                                                       \
+        return false;                                                           \
+    }                                                                           \
+    if (ekf->steady_frozen) {                                                   \
+        if ((ekf->steady_converged & bit) != 0 &&                               \
+            ekf_steady_gain_apply(ekf, sensor, &R->data[0][0],                  \
+                                  &y->data[0][0], (M), ok)) {                   \
+            return true;                                                        \
+        }                                                                       \
+        ekf_steady_gain_reset(ekf);                                             \
+    }                                                                           \
+                                                                                \
+    ScratchArena *scratch = ekf->scratch;                                       \
+    uint32_t mark = scratch_mark(scratch);                                      \
+    EKF_MAT_NXM(M) *PHt = scratch_alloc(scratch, sizeof(EKF_MAT_NXM(M)));       \
+    Mat##M##x##M *S = scratch_alloc(scratch, sizeof(Mat##M##x##M));             \
+    Mat##M##x##M *LD = scratch_alloc(scratch, sizeof(Mat##M##x##M));            \
+    EKF_SteadyGain *g = &ekf->steady[sensor];                                   \
+    ekf->steady_used |= bit;                                                    \
+    if (PHt == NULL || S == NULL || LD == NULL) {                               \
+        scratch_release(scratch, mark);                                         \
+        g->stable = 0;                                                          \
+        ekf->steady_converged &= ~bit;                                          \
+        return false;                                                           \
+    }                                                                           \
+                                                                                \
+    /* S = H P H^T + R */                                                       \
+    EKF_SYM_NXM_FN(multiply_sparse, M)(&ekf->P, H, PHt);                        \
+    for (uint8_t i = 0; i < (M); i++) {                                         \
+        for (uint8_t j = 0; j < (M); j++) {                                     \
+            float sum = R->data[i][j];                                          \
+            for (uint8_t k = 0; k < H[i].count; k++) {                          \
+                sum += H[i].value[k] * PHt->data[H[i].index[k]][j];             \
+            }                                                                   \
+            S->data[i][j] = sum;                                                \
+        }                                                                       \
+    }                                                                           \
+    if (!mat##M##x##M##_ldlt(S, LD)) {                                          \
+        scratch_release(scratch, mark);                                         \
+        g->stable = 0;                                                          \
+        ekf->steady_converged &= ~bit;                                          \
+        return false;                                                           \
+    }                                                                           \
+                                                                                \
+    /* S^-1 (열마다 단위 벡터 풀이) */                                          \
+    for (uint8_t j = 0; j < (M); j++) {                                         \
+        float e[M];                                                             \
+        for (uint8_t i = 0; i < (M); i++) {                                     \
+            e[i] = (i == j) ? 1.0f : 0.0f;                                      \
+        }                                                                       \
+        mat##M##x##M##_ldlt_solve(LD, e);                                       \
+        for (uint8_t i = 0; i < (M); i++) {                                     \
+            g->S_inv[i * (M) + j] = e[i];                                       \
+        }                                                                       \
+        g->r_diag[j] = R->data[j][j];                                           \
+    }                                                                           \
+                                                                                \
+    /* K = PH^T S^-1: 행마다 풀고 직전 게인과의 최대 차이 누적 */               \
+    bool comparable = (g->dim == (M));                                          \
+    float k_max = 0.0f;                                                         \
+    float d_max = 0.0f;                                                         \
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {                               \
+        mat##M##x##M##_ldlt_solve(LD, PHt->data[i]);                            \
+        bool consider = (ekf->consider_mask >> i) & 1u;                         \
+        for (uint8_t j = 0; j < (M); j++) {                                     \
+            float k = consider ? 0.0f : PHt->data[i][j];                        \
+            float *prev = &g->K[i * (M) + j];                                   \
+            d_max = fmaxf(d_max, fabsf(k - *prev));                             \
+            k_max = fmaxf(k_max, fabsf(k));                                     \
+            *prev = k;                                                          \
+        }                                                                       \
+    }                                                                           \
+    g->dim = (M);                                                               \
+    scratch_release(scratch, mark);                                             \
+                                                                                \
+    if (comparable && k_max > 0.0f && d_max <= ekf->steady_gain_tolerance * k_max) { \
+        if (g->stable < UINT16_MAX) {                                           \
+            g->stable++;                                                        \
+        }                                                                       \
+    } else {                                                                    \
+        g->stable = 0;                                                          \
+    }                                                                           \
+    if (g->stable >= ekf->steady_gain_count) {                                  \
+        ekf->steady_converged |= bit;                                           \
+    } else {                                                                    \
+        ekf->steady_converged &= ~bit;                                          \
+    }                                                                           \
+    return false;                                                               \
+}
+
+EKF_DEFINE_STEADY_GAIN(3)
+EKF_DEFINE_STEADY_GAIN(1)
+#if EKF_CONFIG_POSITION
+/**
+ * @brief 측정 차원 6은 게인을 고정하지 않음 (고정 중이면 해제)
+ */
+static bool ekf_steady_gain_step_6(EKF *ekf, EKF_Sensor sensor, const MatrixSparseRow *H,
+                                   const Mat6x6 *R, const Mat6x1 *y, bool *ok) {
+    (void)sensor;
+    (void)H;
+    (void)R;
+    (void)y;
+    (void)ok;
+    if (ekf->steady_frozen) {
+        ekf_steady_gain_reset(ekf);
+    }
+    return false;
+}
+#endif
+
+/**
+ * @brief 재시작 이후 갱신된 모든 측정 종류의 게인이 수렴했으면 고정
+ * 
+ * 측정 갱신 직후 호출되므로 지연 전파/분할 전파 누적분은 이미 반영되어 있다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ */
+static void ekf_steady_gain_check(EKF *ekf) {
+    if (ekf->steady_used != 0 && (ekf->steady_used & ~ekf->steady_converged) == 0) {
+        ekf->steady_frozen = true;
+    }
+}
+
+/**
+ * @brief 정보 형식 누적분 풀이 (누적기는 열린 채로 비움)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @return bool 성공 여부 (I + Λ_TT P_TT 가 특이하면 false, 누적분은 버림)
+ */
+static bool ekf_info_solve(EKF *ekf) {
+    EKF_InfoAccumulator *info = &ekf->info;
+    uint8_t k = info->count;
+    if (k == 0) {
+        info->rows = 0;
+        return true;
     }
     
-    // 1. 측정 자코비안 계산
-    Matrix H;
-    ekf_compute_baro_jacobian(ekf, &H);
+    ScratchArena *scratch = ekf->scratch;
+    uint32_t mark = scratch_mark(scratch);
+    float *PT = scratch_alloc(scratch, sizeof(float) * EKF_STATE_DIM * k);
+    float *G = scratch_alloc(scratch, sizeof(float) * EKF_STATE_DIM * k);
+    float *B = scratch_alloc(scratch, sizeof(float) * k * k);
+    float *W = scratch_alloc(scratch, sizeof(float) * k * k);
+    bool ok = PT != NULL && G != NULL && B != NULL && W != NULL;
     
-    // 2. 예측된 측정값 계산
-    Vector3f pos_pred = ekf_get_position(ekf);
+    PROFILE_BEGIN(PROFILE_STAGE_GAIN);
+    if (ok) {
+        // P_:T 열 모음
+        for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+            for (uint8_t a = 0; a < k; a++) {
+                PT[i * k + a] = ekf->P.data[EKF_SYM_FN(index)(i, info->states[a])];
+            }
+        }
+        
+        // B = I + Λ_TT P_TT,  W = Λ_TT
+        for (uint8_t a = 0; a < k; a++) {
+            for (uint8_t b = 0; b < k; b++) {
+                float sum = (a == b) ? 1.0f : 0.0f;
+                for (uint8_t c = 0; c < k; c++) {
+                    sum += info->lambda[a][c] * PT[info->states[c] * k + b];
+                }
+                B[a * k + b] = sum;
+                W[a * k + b] = info->lambda[a][b];
+            }
+        }
+        
+        // B W = Λ 풀이 (부분 피벗 가우스 소거, k는 작음)
+        for (uint8_t c = 0; c < k && ok; c++) {
+            uint8_t pivot = c;
+            for (uint8_t r = c + 1; r < k; r++) {
+                if (fabsf(B[r * k + c]) > fabsf(B[pivot * k + c])) {
+                    pivot = r;
+                }
+            }
+            if (!(fabsf(B[pivot * k + c]) > 1.0e-12f)) {
+                ok = false;
+                break;
+            }
+            if (pivot != c) {
+                for (uint8_t j = 0; j < k; j++) {
+                    float t = B[c * k + j];
+                    B[c * k + j] = B[pivot * k + j];
+                    B[pivot * k + j] = t;
+                    t = W[c * k + j];
+                    W[c * k + j] = W[pivot * k + j];
+                    W[pivot * k + j] = t;
+                }
+            }
+            float inv = 1.0f / B[c * k + c];
+            for (uint8_t j = c; j < k; j++) {
+                B[c * k + j] *= inv;
+            }
+            for (uint8_t j = 0; j < k; j++) {
+                W[c * k + j] *= inv;
+            }
+            for (uint8_t r = 0; r < k; r++) {
+                float f = B[r * k + c];
+                if (r == c || f == 0.0f) {
+                    continue;
+                }
+                for (uint8_t j = c; j < k; j++) {
+                    B[r * k + j] -= f * B[c * k + j];
+                }
+                for (uint8_t j = 0; j < k; j++) {
+                    W[r * k + j] -= f * W[c * k + j];
+                }
+            }
+        }
+    }
     
-    // 3. 측정 잔차 계산 (측정값 - 예측값)
-    Matrix z = matrix_create(1, 1);
-    Matrix z_pred = matrix_create(1, 1);
+    if (ok) {
+        // W는 이론상 대칭 (반올림 오차 대칭화)
+        for (uint8_t a = 0; a < k; a++) {
+            for (uint8_t b = a + 1; b < k; b++) {
+                float w = 0.5f * (W[a * k + b] + W[b * k + a]);
+                W[a * k + b] = w;
+                W[b * k + a] = w;
+            }
+        }
+        
+        // G = P_:T W
+        for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+            for (uint8_t b = 0; b < k; b++) {
+                float sum = 0.0f;
+                for (uint8_t a = 0; a < k; a++) {
+                    sum += PT[i * k + a] * W[a * k + b];
+                }
+                G[i * k + b] = sum;
+            }
+        }
+    }
+    PROFILE_END(PROFILE_STAGE_GAIN);
+    
+    if (ok) {
+        // Δx = P_:T u,  u = η_T - W (P_TT η_T)
+        PROFILE_BEGIN(PROFILE_STAGE_STATE_UPDATE);
+        float v[EKF_INFO_MAX_STATES];
+        float u[EKF_INFO_MAX_STATES];
+        for (uint8_t a = 0; a < k; a++) {
+            float sum = 0.0f;
+            for (uint8_t b = 0; b < k; b++) {
+                sum += PT[info->states[a] * k + b] * info->eta[b];
+            }
+            v[a] = sum;
+        }
+        for (uint8_t a = 0; a < k; a++) {
+            float sum = info->eta[a];
+            for (uint8_t b = 0; b < k; b++) {
+                sum -= W[a * k + b] * v[b];
+            }
+            u[a] = sum;
+        }
+        for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+            float sum = 0.0f;
+            for (uint8_t a = 0; a < k; a++) {
+                sum += PT[i * k + a] * u[a];
+            }
+            ekf->x.data[i][0] += sum;
+        }
+        ekf_normalize_state_quaternion(ekf);
+        PROFILE_END(PROFILE_STAGE_STATE_UPDATE);
+        
+        // P = P - G P_T: (고려 상태가 없으므로 일반 형식)
+        PROFILE_BEGIN(PROFILE_STAGE_COVARIANCE_UPDATE);
+        ekf_consider_subtract_product(ekf, G, PT, k);
+        ekf_bound_variances(ekf);
+        PROFILE_END(PROFILE_STAGE_COVARIANCE_UPDATE);
+        
+        info->solves++;
+    }
     
-    // 측정값 (기압계 고도)
-    matrix_set(&z, 0, 0, altitude);
+    scratch_release(scratch, mark);
     
-    // 예측값 (Z 위치)
-    matrix_set(&z_pred, 0, 0, pos_pred.z);
+    info->count = 0;
+    info->rows = 0;
+    memset(info->lambda, 0, sizeof(info->lambda));
+    memset(info->eta, 0, sizeof(info->eta));
+    
+    return ok;
+}
+
+/**
+ * @brief 측정 하나를 정보 형식으로 누적
+ * 
+ * 누적기에 없는 상태가 남은 자리보다 많으면 지금까지의 누적분을 먼저 반영하고,
+ * 그만큼 움직인 상태로 잔차를 y_k - h_k * Δx 로 보정한다.
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param H 측정 자코비안 (희소 행 m개)
+ * @param R 측정 노이즈 (m x m, 행 우선, 대각만 사용)
+ * @param y 측정 잔차 (m)
+ * @param m 측정 차원
+ * @return bool 누적 여부 (게이트 거부, R 대각이 양수가 아니면 false)
+ */
+static bool ekf_info_accumulate(EKF *ekf, EKF_Sensor sensor, const MatrixSparseRow *H,
+                                const float *R, const float *y, uint8_t m) {
+    EKF_InfoAccumulator *info = &ekf->info;
+    float y_k[EKF_ADAPTIVE_MAX_DIM];
+    for (uint8_t k = 0; k < m; k++) {
+        if (!(R[k * m + k] > 0.0f)) {
+            return false;
+        }
+        y_k[k] = y[k];
+    }
     
-    // 잔차
-    Matrix y;
-    matrix_subtract(&z, &z_pred, &y);
+    // 새로 닿는 상태 수 (비트 마스크로 중복 제거)
+    uint32_t held = 0;
+    for (uint8_t s = 0; s < info->count; s++) {
+        held |= 1u << info->states[s];
+    }
+    uint32_t touched = 0;
+    for (uint8_t k = 0; k < m; k++) {
+        for (uint8_t a = 0; a < H[k].count; a++) {
+            touched |= 1u << H[k].index[a];
+        }
+    }
+    uint8_t added = 0;
+    for (uint32_t t = touched & ~held; t != 0; t &= t - 1u) {
+        added++;
+    }
+    if (info->count + added > EKF_INFO_MAX_STATES) {
+        EKF_StateVector x_before = ekf->x;
+        if (!ekf_info_solve(ekf)) {
+            return false;
+        }
+        EKF_StateVector dx;
+        EKF_VEC_FN(subtract)(&ekf->x, &x_before, &dx);
+        for (uint8_t k = 0; k < m; k++) {
+            y_k[k] -= matrix_sparse_row_dot(&H[k], &dx.data[0][0]);
+        }
+    }
     
-    // 4. 칼만 게인 계산
-    Matrix K;
-    if (!ekf_compute_kalman_gain(ekf, &H, &ekf->R_baro, &K)) {
+    // 혁신 게이트 (S 대각 근사, 묶음 시작 시각의 P)
+    float nis = 0.0f;
+    for (uint8_t k = 0; k < m; k++) {
+        float s_kk = ekf_sparse_quadratic_form(&ekf->P, &H[k]) + R[k * m + k];
+        if (!(s_kk > 0.0f)) {
+            return false;
+        }
+        nis += y_k[k] * y_k[k] / s_kk;
+    }
+    if (!ekf_innovation_gate(ekf, sensor, nis)) {
         return false;
     }
     
-    // 5. 상태 및 공분산 갱신
-    return ekf_update_state_covariance(ekf, &K, &y, &H);
+    // Λ += h^T r^-1 h,  η += h^T r^-1 y (닿은 상태 성분만)
+    for (uint8_t k = 0; k < m; k++) {
+        const MatrixSparseRow *h = &H[k];
+        float w = 1.0f / R[k * m + k];
+        uint8_t slot[MATRIX_SPARSE_ROW_MAX];
+        for (uint8_t a = 0; a < h->count; a++) {
+            uint8_t s = 0;
+            while (s < info->count && info->states[s] != h->index[a]) {
+                s++;
+            }
+            if (s == info->count) {
+                info->states[info->count++] = h->index[a];
+            }
+            slot[a] = s;
+        }
+        for (uint8_t a = 0; a < h->count; a++) {
+            float wa = w * h->value[a];
+            info->eta[slot[a]] += wa * y_k[k];
+            for (uint8_t b = 0; b < h->count; b++) {
+                info->lambda[slot[a]][slot[b]] += wa * h->value[b];
+            }
+        }
+        info->rows++;
+    }
+    
+    return true;
 }
 
 /**
- * @brief 자력계 측정 갱신
+ * @brief 정보 형식 묶음 갱신 시작
  */
-bool ekf_update_mag(EKF *ekf, Vector3f mag) {
-    if (ekf == NULL || !ekf->initialized) {
+bool ekf_info_begin(EKF *ekf) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_INFO_BEGIN, NULL, 0, NULL, 0);
+        return ekf_call_exit(ekf, ekf_info_begin(ekf));
+    }
+    
+    if (ekf == NULL || ekf->engine != EKF_ENGINE_COVARIANCE || ekf->consider_mask != 0) {
         return false;
     }
     
-    // 1. 측정 자코비안 계산
-    Matrix H;
-    ekf_compute_mag_jacobian(ekf, &H);
+    if (ekf->info.open) {
+        return true;
+    }
     
-    // 2. 예측된 측정값 계산
-    // 현재 자세 사원수 추출
-    Quaternion q = ekf_get_attitude(ekf);
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+    // 고정 게인 동안 멈춘 공분산으로는 누적분을 반영할 수 없음
+    if (ekf->steady_frozen) {
+        ekf_steady_gain_reset(ekf);
+    }
     
-    // 지구 자기장 벡터를 현재 자세로 회전
-    Vector3f mag_pred = quaternion_rotate_vector_inverse(q, ekf->earth_mag_ned);
+    ekf->info.count = 0;
+    ekf->info.rows = 0;
+    memset(ekf->info.lambda, 0, sizeof(ekf->info.lambda));
+    memset(ekf->info.eta, 0, sizeof(ekf->info.eta));
+    ekf->info.open = true;
     
-    // 3. 측정 잔차 계산 (측정값 - 예측값)
-    Matrix z = matrix_create(3, 1);
-    Matrix z_pred = matrix_create(3, 1);
+    return true;
+}
+
+/**
+ * @brief 정보 형식 누적분 반영 후 묶음 종료
+ */
+bool ekf_info_apply(EKF *ekf) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_INFO_APPLY, NULL, 0, NULL, 0);
+        return ekf_call_exit(ekf, ekf_info_apply(ekf));
+    }
     
-    // 측정값 (자력계)
-    matrix_set(&z, 0, 0, mag.x);
-    matrix_set(&z, 1, 0, mag.y);
-    matrix_set(&z, 2, 0, mag.z);
+    if (ekf == NULL) {
+        return false;
+    }
     
-    // 예측값
-    matrix_set(&z_pred, 0, 0, mag_pred.x);
-    matrix_set(&z_pred, 1, 0, mag_pred.y);
-    matrix_set(&z_pred, 2, 0, mag_pred.z);
+    if (!ekf->info.open) {
+        return true;
+    }
     
-    // 잔차
-    Matrix y;
-    matrix_subtract(&z, &z_pred, &y);
+    ekf->info.open = false;
     
-    // 4. 칼만 게인 계산
-    Matrix K;
-    if (!ekf_compute_kalman_gain(ekf, &H, &ekf->R_mag, &K)) {
+    return ekf_info_solve(ekf);
+}
+
+/**
+ * @brief 측정 차원 M에 대한 측정 갱신 함수 정의
+ * 
+ * ekf->update_mode에 따라 순차 또는 일괄 갱신을 수행한다.
+ * U-D 엔진은 스칼라 갱신만 지원하므로 항상 순차 갱신을 사용한다.
+ * 적응형 측정 노이즈가 활성화되어 있으면 혁신 통계로 조정한 R을 사용한다.
+ * 정보 형식 묶음 중(ekf_info_begin)에는 누적만 한다.
+ * 정상 상태 게인 모드에서는 고정 게인으로 처리하거나 게인 수렴을 기록한다.
+ */
+#define EKF_DEFINE_MEASUREMENT_UPDATE(M)                                        \
+MEM_RAMFUNC(ekf_measurement_update_##M)                                        \
+static bool ekf_measurement_update_##M(EKF *ekf, EKF_Sensor sensor,            \
+                                       const MatrixSparseRow *H,                \
+                                       const Mat##M##x##M *R,                   \
+                                       const Mat##M##x1 *y) {                   \
+    /* 지연 전파 중인 공분산을 먼저 반영 */                                     \
+    if (!ekf_flush_covariance(ekf)) {                                           \
+        return false;                                                           \
+    }                                                                           \
+                                                                                \
+    /* 정상 상태 게인 (적응형 R, 정보 형식 누적과는 함께 쓰지 않음) */          \
+    bool steady = ekf->steady_gain && !ekf->adaptive_noise && !ekf->info.open;  \
+    if (steady) {                                                               \
+        bool ok;                                                                \
+        if (ekf_steady_gain_step_##M(ekf, sensor, H, R, y, &ok)) {              \
+            return ok;                                                          \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    Mat##M##x##M R_adaptive;                                                    \
+    if (ekf->adaptive_noise) {                                                  \
+        ekf_adaptive_noise_update(ekf, sensor, H, &R->data[0][0],               \
+                                  &y->data[0][0], (M), &R_adaptive.data[0][0]); \
+        R = &R_adaptive;                                                        \
+    }                                                                           \
+                                                                                \
+    /* 정보 형식 묶음: 누적만 하고 ekf_info_apply에서 한 번에 반영 */             \
+    if (ekf->info.open) {                                                       \
+        return ekf_info_accumulate(ekf, sensor, H, &R->data[0][0],              \
+                                   &y->data[0][0], (M));                        \
+    }                                                                           \
+                                                                                \
+    bool ok = (ekf->update_mode == EKF_UPDATE_BATCH &&                          \
+               ekf->engine != EKF_ENGINE_UD)                                    \
+        ? ekf_batch_update_##M(ekf, sensor, H, R, y)                            \
+        : ekf_sequential_update_##M(ekf, sensor, H, R, y);                      \
+    if (steady) {                                                               \
+        /* 거부(실패)되면 기록을 지우고, 아니면 모두 수렴했는지 확인 */           \
+        if (ok) {                                                               \
+            ekf_steady_gain_check(ekf);                                         \
+        } else {                                                                \
+            ekf_steady_gain_reset(ekf);                                         \
+        }                                                                       \
+    }                                                                           \
+    return ok;                                                                  \
+}
+
+EKF_DEFINE_MEASUREMENT_UPDATE(3)
+EKF_DEFINE_MEASUREMENT_UPDATE(1)
+#if EKF_CONFIG_POSITION
+EKF_DEFINE_MEASUREMENT_UPDATE(6)
+#endif
+
+/**
+ * @brief 고정 크기 함수가 없는 측정 차원의 측정 갱신 (순차 갱신)
+ * 
+ * 적응형 측정 노이즈와 정보 형식 누적은 고정 크기 함수와 같이 적용하고,
+ * 정상 상태 게인은 적용하지 않는다 (고정 중이면 해제).
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param sensor 측정 종류
+ * @param H 측정 자코비안 (희소 행 m개)
+ * @param R 측정 노이즈 (m x m, 행 우선)
+ * @param y 측정 잔차 (m)
+ * @param m 측정 차원 (EKF_ADAPTIVE_MAX_DIM 이하)
+ * @return bool 갱신 성공 여부
+ */
+static bool ekf_measurement_update_rows(EKF *ekf, EKF_Sensor sensor, const MatrixSparseRow *H,
+                                        const float *R, const float *y, uint8_t m) {
+    if (!ekf_flush_covariance(ekf)) {
         return false;
     }
     
-    // 5. 상태 및 공분산 갱신
-    return ekf_update_state_covariance(ekf, &K, &y, &H);
+    if (ekf->steady_frozen) {
+        ekf_steady_gain_reset(ekf);
+    }
+    
+    float R_adaptive[EKF_ADAPTIVE_MAX_DIM * EKF_ADAPTIVE_MAX_DIM];
+    if (ekf->adaptive_noise) {
+        ekf_adaptive_noise_update(ekf, sensor, H, R, y, m, R_adaptive);
+        R = R_adaptive;
+    }
+    
+    if (ekf->info.open) {
+        return ekf_info_accumulate(ekf, sensor, H, R, y, m);
+    }
+    
+    return ekf_sequential_update_rows(ekf, sensor, H, R, y, m);
+}
+
+/**
+ * @brief 수신기 정확도가 보고됐는지 여부
+ */
+static bool ekf_gps_accuracy_reported(const EKF *ekf) {
+    return ekf->gps_acc.h > 0.0f || ekf->gps_acc.v > 0.0f || ekf->gps_acc.s > 0.0f;
+}
+
+/**
+ * @brief GNSS 성분 하나의 R 대각 (수신기 정확도 우선, 없으면 R_gps)
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param i 성분 (위치 0..2, 속도 3..5)
+ * @param var 분산
+ * @return bool 사용 여부 (정확도가 문턱을 넘으면 false)
+ */
+static bool ekf_gps_component_variance(EKF *ekf, uint8_t i, float *var) {
+    float acc = (i < 2) ? ekf->gps_acc.h : (i == 2) ? ekf->gps_acc.v : ekf->gps_acc.s;
+    if (!(acc > 0.0f)) {
+        *var = ekf->R_gps.data[i][i];
+        return true;
+    }
+    
+    float max = (i < 3) ? ekf->gps_acc_pos_max : ekf->gps_acc_vel_max;
+    if (max > 0.0f && acc > max) {
+        ekf->gps_acc_skip_count++;
+        return false;
+    }
+    
+    float min = (i < 3) ? EKF_GPS_ACC_MIN_POS_STD : EKF_GPS_ACC_MIN_VEL_STD;
+    float std = (acc > min) ? acc : min;
+    *var = std * std;
+    
+    return true;
+}
+
+/**
+ * @brief GPS 측정 갱신
+ */
+bool ekf_update_gps(EKF *ekf, Vector3f gps_pos, bool use_vel, Vector3f gps_vel) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_CallGps args = { gps_pos, gps_vel, use_vel ? 1u : 0u };
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_GPS, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_gps(ekf, gps_pos, use_vel, gps_vel));
+    }
+    
+    uint8_t components = EKF_GPS_USE_POS;
+    if (use_vel) {
+        components |= EKF_GPS_USE_VEL;
+    }
+    
+    return ekf_update_gps_partial(ekf, gps_pos, gps_vel, components);
+}
+
+/**
+ * @brief GPS 부분 측정 갱신
+ */
+bool ekf_update_gps_partial(EKF *ekf, Vector3f gps_pos, Vector3f gps_vel, uint8_t components) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_CallGps args = { gps_pos, gps_vel, components };
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_GPS_PARTIAL, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_gps_partial(ekf, gps_pos, gps_vel, components));
+    }
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+#if !EKF_CONFIG_POSITION
+    // 위치 상태가 없으므로 위치 측정은 반영할 수 없음
+    components &= (uint8_t)~EKF_GPS_USE_POS;
+#endif
+    
+    // 고른 성분 목록 (R_gps 인덱스: 위치 0..2, 속도 3..5)
+    uint8_t axes = (components & EKF_GPS_NO_VERTICAL) ? 2 : 3;
+    uint8_t comp[6];
+    uint8_t m = 0;
+    if (components & EKF_GPS_USE_POS) {
+        for (uint8_t i = 0; i < axes; i++) {
+            comp[m++] = i;
+        }
+    }
+    if (components & EKF_GPS_USE_VEL) {
+        for (uint8_t i = 0; i < axes; i++) {
+            comp[m++] = (uint8_t)(3 + i);
+        }
+    }
+    
+    // 수신기 정확도가 있으면 대각 R, 문턱을 넘는 성분은 행을 만들기 전에 뺌
+    bool reported = ekf_gps_accuracy_reported(ekf);
+    float var[6];
+    if (reported) {
+        uint8_t kept = 0;
+        for (uint8_t k = 0; k < m; k++) {
+            if (ekf_gps_component_variance(ekf, comp[k], &var[kept])) {
+                comp[kept++] = comp[k];
+            }
+        }
+        m = kept;
+    }
+    if (m == 0) {
+        return false;
+    }
+    
+    // 1. 측정 자코비안과 예측값 (전체 6행, 안테나 레버 암 포함)
+    MatrixSparseRow H_full[6];
+#if EKF_CONFIG_POSITION
+    ekf_compute_gps_jacobian(ekf, H_full);
+    Vector3f pos_pred = ekf->s.pos;
+#else
+    ekf_compute_velocity_jacobian(ekf, &H_full[3]);
+    Vector3f pos_pred = vector3f_zero();
+#endif
+    Vector3f vel_pred = ekf->s.vel;
+    float pred[6] = { pos_pred.x, pos_pred.y, pos_pred.z, vel_pred.x, vel_pred.y, vel_pred.z };
+    ekf_apply_gps_lever_arm(ekf, H_full, pred);
+    
+    // 2. 고른 행의 측정 잔차 (측정값 - 예측값)
+    const float meas[6] = { gps_pos.x, gps_pos.y, gps_pos.z, gps_vel.x, gps_vel.y, gps_vel.z };
+    MatrixSparseRow H[6];
+    float y[6];
+    for (uint8_t k = 0; k < m; k++) {
+        H[k] = H_full[comp[k]];
+        y[k] = meas[comp[k]] - pred[comp[k]];
+    }
+    
+    // 3. R_gps에서 고른 성분의 부분 행렬 (수신기 정확도가 있으면 대각)
+    float R[36];
+    for (uint8_t a = 0; a < m; a++) {
+        for (uint8_t b = 0; b < m; b++) {
+            if (reported) {
+                R[a * m + b] = (a == b) ? var[a] : 0.0f;
+            } else {
+                R[a * m + b] = ekf->R_gps.data[comp[a]][comp[b]];
+            }
+        }
+    }
+    
+    EKF_Sensor sensor = (comp[m - 1] >= 3) ? EKF_SENSOR_GPS_POS_VEL : EKF_SENSOR_GPS_POS;
+    
+    // 4. 칼만 게인 계산 및 상태/공분산 갱신
+    switch (m) {
+#if EKF_CONFIG_POSITION
+        case 6: {
+            Mat6x6 R6;
+            Mat6x1 y6;
+            for (uint8_t a = 0; a < 6; a++) {
+                for (uint8_t b = 0; b < 6; b++) {
+                    R6.data[a][b] = R[a * 6 + b];
+                }
+                y6.data[a][0] = y[a];
+            }
+            return ekf_measurement_update_6(ekf, sensor, H, &R6, &y6);
+        }
+#endif
+        case 3: {
+            Mat3x3 R3;
+            Mat3x1 y3;
+            for (uint8_t a = 0; a < 3; a++) {
+                for (uint8_t b = 0; b < 3; b++) {
+                    R3.data[a][b] = R[a * 3 + b];
+                }
+                y3.data[a][0] = y[a];
+            }
+            return ekf_measurement_update_3(ekf, sensor, H, &R3, &y3);
+        }
+        default:
+            return ekf_measurement_update_rows(ekf, sensor, H, R, y, m);
+    }
+}
+
+/**
+ * @brief 현재 속력에서의 기압계 R 배율 (천음속 오차 모델)
+ */
+float ekf_get_baro_noise_scale(const EKF *ekf) {
+    if (ekf == NULL) {
+        return 1.0f;
+    }
+    if (!(ekf->baro_sound_speed > 0.0f)) {
+        return ekf->baro_r_scale;
+    }
+    
+    Vector3f v = ekf_get_velocity(ekf);
+    float f = sqrtf(vector3f_dot(v, v)) / (ekf->baro_sound_speed * EKF_BARO_MACH_STEP);
+    if (!(f < (float)(EKF_BARO_MACH_COUNT - 1))) {
+        return ekf->baro_mach_scale[EKF_BARO_MACH_COUNT - 1] * ekf->baro_r_scale;
+    }
+    
+    // 선형 보간 (생략 구간 경계에서 오염된 측정이 보간으로 새지 않도록 이웃이 0이면 생략)
+    uint8_t i = (uint8_t)f;
+    float a = ekf->baro_mach_scale[i];
+    float b = ekf->baro_mach_scale[i + 1];
+    if (!(a > 0.0f) || !(b > 0.0f)) {
+        return 0.0f;
+    }
+    
+    return (a + (b - a) * (f - (float)i)) * ekf->baro_r_scale;
+}
+
+/**
+ * @brief 기압계 측정 갱신
+ */
+bool ekf_update_baro(EKF *ekf, float baro_alt) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_BARO, &baro_alt, sizeof(baro_alt), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_baro(ekf, baro_alt));
+    }
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+#if EKF_CONFIG_POSITION
+    // 0. 천음속 오차 모델 (생략 구간이면 갱신하지 않음)
+    float scale = ekf_get_baro_noise_scale(ekf);
+    if (!(scale > 0.0f)) {
+        ekf->baro_suppress_count++;
+        return false;
+    }
+    Mat1x1 R;
+    MATRIX_AT(&R, 0, 0) = ekf->R_baro.data[0][0] * scale;
+    
+    // 1. 측정 자코비안 계산
+    MatrixSparseRow H[1];
+    ekf_compute_baro_jacobian(ekf, H);
+    
+    // 2. 예측된 측정값 계산
+    Vector3f pos_pred = ekf->s.pos;
+    
+    // 3. 측정 잔차 계산 (기압계 고도 - 예측 Z 위치)
+    Mat1x1 y;
+    MATRIX_AT(&y, 0, 0) = baro_alt - pos_pred.z;
+    
+    // 4. 칼만 게인 계산 및 상태/공분산 갱신
+    return ekf_measurement_update_1(ekf, EKF_SENSOR_BARO, H, &R, &y);
+#else
+    (void)baro_alt;
+    
+    // 위치 상태가 없는 구성에서는 고도 측정을 반영할 수 없음
+    return false;
+#endif
+}
+
+/**
+ * @brief 동시 측정 묶음 갱신을 공유 패스로 처리할 수 있는지 여부
+ */
+bool ekf_can_coalesce(const EKF *ekf) {
+#if EKF_CONFIG_POSITION
+    return ekf != NULL && ekf->covariance_update == EKF_COVARIANCE_STANDARD &&
+           ekf->engine == EKF_ENGINE_COVARIANCE && ekf->consider_mask == 0 &&
+           !ekf->adaptive_noise && !ekf->steady_gain && !ekf->info.open;
+#else
+    (void)ekf;
+    return false;
+#endif
+}
+
+#if EKF_CONFIG_POSITION
+/**
+ * @brief 동시 측정 묶음의 공유 순차 패스
+ * 
+ * @param ekf EKF 구조체 포인터
+ * @param H 측정 자코비안 희소 행 (rows개)
+ * @param r R 대각 (rows개)
+ * @param y 측정 잔차 (rows개)
+ * @param active 행별 사용 여부 (게이트 판정 후 기록)
+ * @param sensor 행별 측정 종류
+ * @param rows 행 수 (EKF_COINCIDENT_MAX_ROWS 이하)
+ * @return bool 성공 여부 (혁신 분산이 양수가 아니면 false)
+ */
+static bool ekf_coincident_pass(EKF *ekf, const MatrixSparseRow *H, const float *r, const float *y,
+                                bool *active, const EKF_Sensor *sensor, uint8_t rows) {
+    ScratchArena *scratch = ekf->scratch;
+    uint32_t mark = scratch_mark(scratch);
+    float *PHt = scratch_alloc(scratch, sizeof(float) * EKF_STATE_DIM * rows);
+    float *K = scratch_alloc(scratch, sizeof(float) * EKF_STATE_DIM * rows);
+    if (PHt == NULL || K == NULL) {
+        scratch_release(scratch, mark);
+        return false;
+    }
+    
+    PROFILE_BEGIN(PROFILE_STAGE_GAIN);
+    
+    // PH^T 열을 모든 행에 대해 한 번만 모음
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        for (uint8_t k = 0; k < rows; k++) {
+            const MatrixSparseRow *h = &H[k];
+            float sum = 0.0f;
+            for (uint8_t a = 0; a < h->count; a++) {
+                sum += h->value[a] * ekf->P.data[EKF_SYM_FN(index)(i, h->index[a])];
+            }
+            PHt[i * rows + k] = sum;
+        }
+    }
+    
+    // 측정 종류별 혁신 게이트 (갱신 전 P의 S 대각 근사, 순차 갱신과 같음)
+    uint8_t k = 0;
+    while (k < rows) {
+        uint8_t end = k;
+        float nis = 0.0f;
+        while (end < rows && sensor[end] == sensor[k]) {
+            float s_kk = r[end];
+            for (uint8_t a = 0; a < H[end].count; a++) {
+                s_kk += H[end].value[a] * PHt[H[end].index[a] * rows + end];
+            }
+            nis += (s_kk > 0.0f) ? y[end] * y[end] / s_kk : INFINITY;
+            end++;
+        }
+        bool accept = ekf_innovation_gate(ekf, sensor[k], nis);
+        for (uint8_t j = k; j < end; j++) {
+            active[j] = accept;
+        }
+        k = end;
+    }
+    
+    // 순차 스칼라 갱신 (P 대신 뒤 행의 PH^T만 보정)
+    EKF_StateVector x_prior = ekf->x;
+    bool ok = true;
+    for (k = 0; k < rows; k++) {
+        if (!active[k]) {
+            for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+                K[i * rows + k] = 0.0f;
+            }
+            continue;
+        }
+        const MatrixSparseRow *h = &H[k];
+        
+        float s = r[k];
+        float y_k = y[k];
+        for (uint8_t a = 0; a < h->count; a++) {
+            uint8_t c = h->index[a];
+            s += h->value[a] * PHt[c * rows + k];
+            y_k -= h->value[a] * (ekf->x.data[c][0] - x_prior.data[c][0]);
+        }
+        if (!(s > 0.0f)) {
+            ok = false;
+            break;
+        }
+        
+        float inv_s = 1.0f / s;
+        for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+            K[i * rows + k] = PHt[i * rows + k] * inv_s;
+            ekf->x.data[i][0] += K[i * rows + k] * y_k;
+        }
+        
+        // P' = P - K_k (PH^T)_k^T 이므로 (PH^T)_j' = (PH^T)_j - K_k (h_j (PH^T)_k)
+        for (uint8_t j = k + 1; j < rows; j++) {
+            if (!active[j]) {
+                continue;
+            }
+            float c = 0.0f;
+            for (uint8_t a = 0; a < H[j].count; a++) {
+                c += H[j].value[a] * PHt[H[j].index[a] * rows + k];
+            }
+            for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+                PHt[i * rows + j] -= K[i * rows + k] * c;
+            }
+        }
+    }
+    PROFILE_END(PROFILE_STAGE_GAIN);
+    
+    if (ok) {
+        ekf_normalize_state_quaternion(ekf);
+        
+        // P = P - Σ K_k (PH^T)_k^T (한 번만 다시 씀, 고려 상태가 없으므로 일반 형식)
+        PROFILE_BEGIN(PROFILE_STAGE_COVARIANCE_UPDATE);
+        ekf_consider_subtract_product(ekf, K, PHt, rows);
+        ekf_bound_variances(ekf);
+        PROFILE_END(PROFILE_STAGE_COVARIANCE_UPDATE);
+    }
+    
+    scratch_release(scratch, mark);
+    return ok;
+}
+#endif /* EKF_CONFIG_POSITION */
+
+/**
+ * @brief 같은 시각의 GNSS/기압계 측정을 한 번의 갱신으로 융합
+ */
+bool ekf_update_coincident(EKF *ekf, EKF_CoincidentMeasurement *m) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_COINCIDENT, m, (m != NULL) ? (uint16_t)sizeof(*m) : 0u, NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_coincident(ekf, m));
+    }
+    
+    if (ekf == NULL || m == NULL) {
+        return false;
+    }
+    
+    m->gps_accepted = false;
+    m->baro_accepted = false;
+    if (!ekf->initialized) {
+        return false;
+    }
+    
+    if (!ekf_can_coalesce(ekf)) {
+        if (m->has_gps) {
+            m->gps_accepted = ekf_update_gps(ekf, m->gps_pos, m->gps_use_vel, m->gps_vel);
+        }
+        if (m->has_baro) {
+            m->baro_accepted = ekf_update_baro(ekf, m->baro_alt);
+        }
+        return m->gps_accepted || m->baro_accepted;
+    }
+    
+#if EKF_CONFIG_POSITION
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    
+    MatrixSparseRow H[EKF_COINCIDENT_MAX_ROWS];
+    float r[EKF_COINCIDENT_MAX_ROWS];
+    float y[EKF_COINCIDENT_MAX_ROWS];
+    bool active[EKF_COINCIDENT_MAX_ROWS];
+    EKF_Sensor sensor[EKF_COINCIDENT_MAX_ROWS];
+    uint8_t rows = 0;
+    
+    if (m->has_gps) {
+        const float meas[6] = { m->gps_pos.x, m->gps_pos.y, m->gps_pos.z,
+                                m->gps_vel.x, m->gps_vel.y, m->gps_vel.z };
+        float pred[6] = { ekf->s.pos.x, ekf->s.pos.y, ekf->s.pos.z,
+                          ekf->s.vel.x, ekf->s.vel.y, ekf->s.vel.z };
+        ekf_compute_gps_jacobian(ekf, H);
+        ekf_apply_gps_lever_arm(ekf, H, pred);
+        
+        EKF_Sensor gps = m->gps_use_vel ? EKF_SENSOR_GPS_POS_VEL : EKF_SENSOR_GPS_POS;
+        uint8_t count = m->gps_use_vel ? 6 : 3;
+        for (uint8_t i = 0; i < count; i++) {
+            // 문턱을 넘는 성분은 행을 만들지 않음 (H는 남은 행 자리로 당김)
+            if (!ekf_gps_component_variance(ekf, i, &r[rows])) {
+                continue;
+            }
+            H[rows] = H[i];
+            y[rows] = meas[i] - pred[i];
+            sensor[rows] = gps;
+            rows++;
+        }
+    }
+    uint8_t gps_rows = rows;
+    
+    uint8_t baro_row = rows;
+    if (m->has_baro) {
+        // 천음속 생략 구간이면 기압계 행을 넣지 않음
+        float scale = ekf_get_baro_noise_scale(ekf);
+        if (scale > 0.0f) {
+            ekf_compute_baro_jacobian(ekf, &H[rows]);
+            r[rows] = ekf->R_baro.data[0][0] * scale;
+            y[rows] = m->baro_alt - ekf->s.pos.z;
+            sensor[rows] = EKF_SENSOR_BARO;
+            rows++;
+        } else {
+            ekf->baro_suppress_count++;
+        }
+    }
+    
+    if (rows == 0 || !ekf_coincident_pass(ekf, H, r, y, active, sensor, rows)) {
+        return false;
+    }
+    
+    m->gps_accepted = gps_rows > 0 && active[0];
+    m->baro_accepted = rows > baro_row && active[baro_row];
+    
+    return m->gps_accepted || m->baro_accepted;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief GNSS 원시 관측 강결합 갱신 (의사거리/도플러)
+ * 
+ * 위성마다 1차원 측정 갱신을 호출하므로 예측값은 앞선 위성까지 반영된 상태로
+ * 다시 계산한다. 관측 모델이 선형화 점 p0 기준 선형식이라 순서와 무관하게
+ * 한 번에 처리한 결과와 같다.
+ */
+uint8_t ekf_update_gnss_raw(EKF *ekf, Vector3f ref_pos, const EKF_GnssObservation *obs, uint8_t count) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_GNSS_RAW, &ref_pos, sizeof(ref_pos),
+                       obs, (obs != NULL) ? (uint16_t)(count * sizeof(*obs)) : 0u);
+        uint8_t used = ekf_update_gnss_raw(ekf, ref_pos, obs, count);
+        ekf_call_exit(ekf, used > 0);
+        return used;
+    }
+    
+    if (ekf == NULL || !ekf->initialized || obs == NULL) {
+        return 0;
+    }
+    
+#if EKF_CONFIG_GNSS_CLOCK
+    uint8_t fused = 0;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        const EKF_GnssObservation *o = &obs[i];
+        MatrixSparseRow H[1];
+        Mat1x1 R;
+        Mat1x1 y;
+        
+        if (o->pseudorange_std > 0.0f) {
+            // 의사거리: 예측값 = -los · (p - p0) + 시계 바이어스
+            ekf_compute_line_of_sight_jacobian(o->los, EKF_STATE_POS_X, EKF_STATE_CLK_BIAS, H);
+            Vector3f pos_pred = ekf->s.pos;
+            float pred = -(o->los.x * (pos_pred.x - ref_pos.x) +
+                           o->los.y * (pos_pred.y - ref_pos.y) +
+                           o->los.z * (pos_pred.z - ref_pos.z)) +
+                         ekf->s.clk_bias;
+            
+            MATRIX_AT(&y, 0, 0) = o->pseudorange - pred;
+            MATRIX_AT(&R, 0, 0) = o->pseudorange_std * o->pseudorange_std;
+            if (ekf_measurement_update_1(ekf, EKF_SENSOR_PSEUDORANGE, H, &R, &y)) {
+                fused++;
+            }
+        }
+        
+        if (o->range_rate_std > 0.0f) {
+            // 의사거리 변화율: 예측값 = -los · v + 시계 드리프트
+            ekf_compute_line_of_sight_jacobian(o->los, EKF_STATE_VEL_X, EKF_STATE_CLK_DRIFT, H);
+            Vector3f vel_pred = ekf->s.vel;
+            float pred = -(o->los.x * vel_pred.x + o->los.y * vel_pred.y + o->los.z * vel_pred.z) +
+                         ekf->s.clk_drift;
+            
+            MATRIX_AT(&y, 0, 0) = o->range_rate - pred;
+            MATRIX_AT(&R, 0, 0) = o->range_rate_std * o->range_rate_std;
+            if (ekf_measurement_update_1(ekf, EKF_SENSOR_RANGE_RATE, H, &R, &y)) {
+                fused++;
+            }
+        }
+    }
+    
+    return fused;
+#else
+    (void)ref_pos;
+    (void)count;
+    
+    // 시계 상태가 없는 구성에서는 원시 관측을 반영할 수 없음
+    return 0;
+#endif
+}
+
+/**
+ * @brief 자력계 외란 사전 검사
+ * 
+ * sin(복각) = m·d / |m| (d = 몸체 좌표계 아래 방향 = R(q)^T e_z, R의 셋째 행)
+ * 복각 허용 폭은 기울기 표준 편차의 3배만큼 넓혀 정렬 전 자세로 측정을 모두 버리지 않게 한다.
+ */
+bool ekf_mag_check_disturbance(EKF *ekf, Vector3f mag) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_MAG_CHECK_DISTURBANCE, &mag, sizeof(mag), NULL, 0);
+        return ekf_call_exit(ekf, ekf_mag_check_disturbance(ekf, mag));
+    }
+    
+    if (ekf == NULL) {
+        return true;
+    }
+    
+    EKF_MagDisturbanceStats *st = &ekf->mag_disturbance;
+    st->checks++;
+#if EKF_CONFIG_MAG_BIAS
+    mag = vector3f_subtract(mag, ekf->s.bm);
+#endif
+    if (!(ekf->mag_magnitude_tolerance > 0.0f) && !(ekf->mag_inclination_tolerance > 0.0f)) {
+        return false;
+    }
+    
+    float ref = vector3f_magnitude(ekf->earth_mag_ned);
+    float norm = vector3f_magnitude(mag);
+    if (!(ref > 0.0f) || !(norm > 0.0f) || !isfinite(norm)) {
+        st->magnitude_rejects++;
+        return true;
+    }
+    
+    // 1. 크기
+    float ratio = norm / ref;
+    st->last_magnitude_ratio = ratio;
+    if (ekf->mag_magnitude_tolerance > 0.0f && fabsf(ratio - 1.0f) > ekf->mag_magnitude_tolerance) {
+        st->magnitude_rejects++;
+        return true;
+    }
+    
+    // 2. 복각 (현재 자세의 아래 방향 기준)
+    if (ekf->mag_inclination_tolerance > 0.0f) {
+        Quaternion q = ekf->s.quat;
+        float dx = 2.0f * (q.x * q.z - q.w * q.y);
+        float dy = 2.0f * (q.y * q.z + q.w * q.x);
+        float dz = q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z;
+        float dip = fast_asinf((mag.x * dx + mag.y * dy + mag.z * dz) / norm);
+        float dip_ref = fast_asinf(ekf->earth_mag_ned.z / ref);
+        st->last_inclination_error = dip - dip_ref;
+        
+        // 기울기를 아직 모르면(정렬 전) 그만큼 허용 폭을 넓힘: 3 x 2|dq_xy|
+        float tilt_var = ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_QUAT_X, EKF_STATE_QUAT_X)] +
+                         ekf->P.data[EKF_SYM_FN(index)(EKF_STATE_QUAT_Y, EKF_STATE_QUAT_Y)];
+        float tol = ekf->mag_inclination_tolerance + ((tilt_var > 0.0f) ? 6.0f * fast_sqrtf(tilt_var) : 0.0f);
+        if (fabsf(dip - dip_ref) > tol) {
+            st->inclination_rejects++;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief 자력계 외란 통계
+ */
+const EKF_MagDisturbanceStats *ekf_get_mag_disturbance_stats(const EKF *ekf) {
+    if (ekf == NULL) {
+        return NULL;
+    }
+    
+    return &ekf->mag_disturbance;
+}
+
+/**
+ * @brief 자력계 측정 갱신
+ */
+bool ekf_update_mag(EKF *ekf, Vector3f mag) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_MAG, &mag, sizeof(mag), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_mag(ekf, mag));
+    }
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+    // 0. 외란 사전 검사 (자코비안/게인 계산 전에 버림)
+    if (ekf_mag_check_disturbance(ekf, mag)) {
+        return false;
+    }
+    
+    // 1-2. 예측된 측정값과 측정 자코비안 (지구 자기장을 현재 자세로 회전)
+    MatrixSparseRow H[3];
+    Vector3f mag_pred;
+    ekf_compute_mag_model(ekf, ekf->s.quat, H, &mag_pred);
+    
+    // 3. 측정 잔차 계산 (측정값 - 예측값)
+    Mat3x1 y;
+    MATRIX_AT(&y, 0, 0) = mag.x - mag_pred.x;
+    MATRIX_AT(&y, 1, 0) = mag.y - mag_pred.y;
+    MATRIX_AT(&y, 2, 0) = mag.z - mag_pred.z;
+    
+    // 4. 칼만 게인 계산 및 상태/공분산 갱신 (사전 평균 배율 적용)
+    Mat3x3 R;
+    mat3x3_scale(&ekf->R_mag, ekf->mag_r_scale, &R);
+    return ekf_measurement_update_3(ekf, EKF_SENSOR_MAG, H, &R, &y);
+}
+
+/**
+ * @brief 자력계 방위각 전용 측정 갱신
+ * 
+ * 321 방위각: psi = atan2(2(qw qz + qx qy), qw^2 + qx^2 - qy^2 - qz^2)
+ * 312 방위각: psi = atan2(2(qw qz - qx qy), qw^2 - qx^2 + qy^2 - qz^2)
+ * 분모를 동차식으로 두어 psi(λq) = psi(q)이므로 자코비안이 단위 구면에 접하고,
+ * 갱신 후 사원수 정규화로 보정량이 줄지 않는다.
+ * 두 순서 모두 방위 회전이 NED 아래축에 대해 먼저 적용되므로, 방위 오차 d는
+ * NED로 돌린 측정 자기장의 수평 방향을 기준 방향에서 d만큼 돌린다.
+ * 따라서 잔차는 (기준 수평 방향 - 측정 수평 방향)이다.
+ */
+bool ekf_update_mag_heading(EKF *ekf, Vector3f mag) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_MAG_HEADING, &mag, sizeof(mag), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_mag_heading(ekf, mag));
+    }
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+    Quaternion q = ekf->s.quat;
+    const float (*R)[3] = ekf_epoch_rotation(ekf);
+#if EKF_CONFIG_MAG_BIAS
+    // 추정된 자력계 바이어스 제거 (방위 전용 갱신은 바이어스를 관측하지 않음)
+    mag = vector3f_subtract(mag, ekf->s.bm);
+#endif
+    
+    // 측정 자기장의 NED 수평 성분
+    float mn = R[0][0] * mag.x + R[0][1] * mag.y + R[0][2] * mag.z;
+    float me = R[1][0] * mag.x + R[1][1] * mag.y + R[1][2] * mag.z;
+    float horiz_sq = mn * mn + me * me;
+    float ref_sq = ekf->earth_mag_ned.x * ekf->earth_mag_ned.x + ekf->earth_mag_ned.y * ekf->earth_mag_ned.y;
+    float limit = EKF_MAG_HEADING_MIN_HORIZONTAL * EKF_MAG_HEADING_MIN_HORIZONTAL;
+    if (!(horiz_sq > limit * vector3f_magnitude_squared(mag)) || !(ref_sq > 0.0f)) {
+        return false;
+    }
+    
+    // 1. 측정 자코비안 (방위각의 사원수 편미분, 특이점에서 먼 오일러 순서 선택)
+    float a, b;
+    float da[4], db[4];
+    if (fabsf(R[2][0]) < fabsf(R[2][1])) {
+        // 321: 피치가 롤보다 작음
+        a = 2.0f * (q.w * q.z + q.x * q.y);
+        b = q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z;
+        da[0] = 2.0f * q.z; da[1] = 2.0f * q.y;  da[2] = 2.0f * q.x;  da[3] = 2.0f * q.w;
+        db[0] = 2.0f * q.w; db[1] = 2.0f * q.x;  db[2] = -2.0f * q.y; db[3] = -2.0f * q.z;
+    } else {
+        // 312: 롤이 피치보다 작음 (수직 자세)
+        a = 2.0f * (q.w * q.z - q.x * q.y);
+        b = q.w * q.w - q.x * q.x + q.y * q.y - q.z * q.z;
+        da[0] = 2.0f * q.z; da[1] = -2.0f * q.y; da[2] = -2.0f * q.x; da[3] = 2.0f * q.w;
+        db[0] = 2.0f * q.w; db[1] = -2.0f * q.x; db[2] = 2.0f * q.y;  db[3] = -2.0f * q.z;
+    }
+    float den = a * a + b * b;
+    if (!(den > 1e-6f)) {
+        return false;
+    }
+    MatrixSparseRow H[1];
+    matrix_sparse_row_clear(&H[0]);
+    for (uint8_t k = 0; k < 4; k++) {
+        matrix_sparse_row_add(&H[0], EKF_STATE_QUAT_W + k, (b * da[k] - a * db[k]) / den);
+    }
+    
+    // 2. 측정 잔차 (기준 수평 방향 - 측정 수평 방향, [-pi, pi])
+    float dpsi = fast_atan2f(ekf->earth_mag_ned.y, ekf->earth_mag_ned.x) - fast_atan2f(me, mn);
+    if (dpsi > (float)M_PI) {
+        dpsi -= 2.0f * (float)M_PI;
+    } else if (dpsi < -(float)M_PI) {
+        dpsi += 2.0f * (float)M_PI;
+    }
+    Mat1x1 y;
+    MATRIX_AT(&y, 0, 0) = dpsi;
+    
+    // 3. 칼만 게인 계산 및 상태/공분산 갱신 (스칼라)
+    return ekf_measurement_update_1(ekf, EKF_SENSOR_MAG_HEADING, H, &ekf->R_mag_heading, &y);
+}
+
+/**
+ * @brief 기선의 NED 벡터와 사원수 미분 (동차식 R(q), 단위 노름을 가정하지 않음)
+ * 
+ * @param q 자세 사원수 (몸체 -> NED)
+ * @param b 기선 (몸체 좌표계)
+ * @param ned R(q) b (북, 동, 아래)
+ * @param dq ned 각 성분의 (w, x, y, z) 편미분
+ */
+static void ekf_gnss_baseline_model(Quaternion q, Vector3f b, float ned[3], float dq[3][4]) {
+    const float w = q.w, x = q.x, y = q.y, z = q.z;
+    
+    ned[0] = (w * w + x * x - y * y - z * z) * b.x + 2.0f * (x * y - w * z) * b.y + 2.0f * (x * z + w * y) * b.z;
+    ned[1] = 2.0f * (x * y + w * z) * b.x + (w * w - x * x + y * y - z * z) * b.y + 2.0f * (y * z - w * x) * b.z;
+    ned[2] = 2.0f * (x * z - w * y) * b.x + 2.0f * (y * z + w * x) * b.y + (w * w - x * x - y * y + z * z) * b.z;
+    
+    dq[0][0] = 2.0f * (w * b.x - z * b.y + y * b.z);
+    dq[0][1] = 2.0f * (x * b.x + y * b.y + z * b.z);
+    dq[0][2] = 2.0f * (-y * b.x + x * b.y + w * b.z);
+    dq[0][3] = 2.0f * (-z * b.x - w * b.y + x * b.z);
+    dq[1][0] = 2.0f * (z * b.x + w * b.y - x * b.z);
+    dq[1][1] = 2.0f * (y * b.x - x * b.y - w * b.z);
+    dq[1][2] = dq[0][1];
+    dq[1][3] = 2.0f * (w * b.x - z * b.y + y * b.z);
+    dq[2][0] = 2.0f * (-y * b.x + x * b.y + w * b.z);
+    dq[2][1] = 2.0f * (z * b.x + w * b.y - x * b.z);
+    dq[2][2] = 2.0f * (-w * b.x + z * b.y - y * b.z);
+    dq[2][3] = dq[0][1];
+}
+
+/**
+ * @brief 이중 안테나 GNSS 기선 방위(와 앙각) 측정 갱신
+ * 
+ * 방위 psi = atan2(e, n), 앙각 theta = atan2(-d, h), h = sqrt(n^2 + e^2)
+ *   dpsi = (n de - e dn) / h^2
+ *   dtheta = (d (n dn + e de) / h - h dd) / (h^2 + d^2)
+ * n, e, d가 q의 2차 동차식이므로 psi(λq) = psi(q), theta(λq) = theta(q)이다.
+ */
+bool ekf_update_gnss_heading(EKF *ekf, const EKF_GnssHeading *m) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_GNSS_HEADING, m, (m != NULL) ? (uint16_t)sizeof(*m) : 0u, NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_gnss_heading(ekf, m));
+    }
+    
+    if (ekf == NULL || !ekf->initialized || m == NULL || !isfinite(m->heading)) {
+        return false;
+    }
+    
+    Vector3f b = ekf->gnss_baseline;
+    if (!(vector3f_magnitude_squared(b) > 0.0f)) {
+        return false;
+    }
+    float limit = EKF_GNSS_HEADING_MIN_HORIZONTAL * EKF_GNSS_HEADING_MIN_HORIZONTAL;
+    
+    // 1. 방위 (예측 기선이 거의 수직이면 방위가 정의되지 않음)
+    float ned[3];
+    float dq[3][4];
+    ekf_gnss_baseline_model(ekf->s.quat, b, ned, dq);
+    float h_sq = ned[0] * ned[0] + ned[1] * ned[1];
+    if (!(h_sq > limit * (h_sq + ned[2] * ned[2]))) {
+        return false;
+    }
+    
+    MatrixSparseRow H[1];
+    matrix_sparse_row_clear(&H[0]);
+    for (uint8_t k = 0; k < 4; k++) {
+        matrix_sparse_row_add(&H[0], EKF_STATE_QUAT_W + k, (ned[0] * dq[1][k] - ned[1] * dq[0][k]) / h_sq);
+    }
+    
+    float dpsi = m->heading - fast_atan2f(ned[1], ned[0]);
+    while (dpsi > (float)M_PI) {
+        dpsi -= 2.0f * (float)M_PI;
+    }
+    while (dpsi < -(float)M_PI) {
+        dpsi += 2.0f * (float)M_PI;
+    }
+    Mat1x1 y;
+    MATRIX_AT(&y, 0, 0) = dpsi;
+    
+    Mat1x1 R = ekf->R_gnss_heading;
+    if (m->heading_std > 0.0f) {
+        R.data[0][0] = m->heading_std * m->heading_std;
+    }
+    bool heading_ok = ekf_measurement_update_1(ekf, EKF_SENSOR_GNSS_HEADING, H, &R, &y);
+    if (!m->use_pitch || !isfinite(m->pitch)) {
+        return heading_ok;
+    }
+    
+    // 2. 앙각 (방위 갱신 뒤 자세로 다시 선형화)
+    ekf_gnss_baseline_model(ekf->s.quat, b, ned, dq);
+    h_sq = ned[0] * ned[0] + ned[1] * ned[1];
+    float r_sq = h_sq + ned[2] * ned[2];
+    if (!(h_sq > 0.0f) || !(r_sq > 0.0f)) {
+        return heading_ok;
+    }
+    float h = fast_sqrtf(h_sq);
+    
+    matrix_sparse_row_clear(&H[0]);
+    for (uint8_t k = 0; k < 4; k++) {
+        float dh = (ned[0] * dq[0][k] + ned[1] * dq[1][k]) / h;
+        matrix_sparse_row_add(&H[0], EKF_STATE_QUAT_W + k, (ned[2] * dh - h * dq[2][k]) / r_sq);
+    }
+    MATRIX_AT(&y, 0, 0) = m->pitch - fast_atan2f(-ned[2], h);
+    
+    R = ekf->R_gnss_pitch;
+    if (m->pitch_std > 0.0f) {
+        R.data[0][0] = m->pitch_std * m->pitch_std;
+    }
+    bool pitch_ok = ekf_measurement_update_1(ekf, EKF_SENSOR_GNSS_HEADING, H, &R, &y);
+    
+    return heading_ok || pitch_ok;
+}
+
+/**
+ * @brief 가속도계 중력 방향 측정 갱신
+ * 
+ * 정지 시 몸체 비력은 R(q)^T (0, 0, g)이다 (ekf_integrate_state에서 중력을 빼는 부호와 같음).
+ */
+bool ekf_update_gravity(EKF *ekf, Vector3f accel) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_GRAVITY, &accel, sizeof(accel), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_gravity(ekf, accel));
+    }
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+    // 0. 크기 검사 (운동 가속도가 섞이면 중력 방향이 아님)
+    if (!(fabsf(vector3f_magnitude(accel) - ekf->gravity) <= ekf->gravity_tolerance)) {
+        return false;
+    }
+    
+    // 1-2. 예측된 측정값과 측정 자코비안 (중력을 현재 자세로 회전, 자력계와 같은 커널)
+    Quaternion q = ekf->s.quat;
+    const float qa[4] = { q.w, q.x, q.y, q.z };
+    const float g[3] = { 0.0f, 0.0f, ekf->gravity };
+    float h[3];
+    float Hq[3][4];
+    ekf_gen_mag_observation(qa, g, h, Hq);
+#if EKF_CONFIG_ACCEL_BIAS
+    const float ba[3] = { ekf->s.ba.x, ekf->s.ba.y, ekf->s.ba.z };
+#endif
+    
+    MatrixSparseRow H[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        for (uint8_t k = 0; k < 4; k++) {
+            matrix_sparse_row_add(&H[i], EKF_STATE_QUAT_W + k, Hq[i][k]);
+        }
+#if EKF_CONFIG_ACCEL_BIAS
+        matrix_sparse_row_add(&H[i], EKF_STATE_ACC_BIAS_X + i, 1.0f);
+        h[i] += ba[i];
+#endif
+    }
+    
+    // 3. 측정 잔차 계산 (측정값 - 예측값)
+    Mat3x1 y;
+    MATRIX_AT(&y, 0, 0) = accel.x - h[0];
+    MATRIX_AT(&y, 1, 0) = accel.y - h[1];
+    MATRIX_AT(&y, 2, 0) = accel.z - h[2];
+    
+    // 4. 칼만 게인 계산 및 상태/공분산 갱신
+    return ekf_measurement_update_3(ekf, EKF_SENSOR_GRAVITY, H, &ekf->R_gravity, &y);
+}
+
+/**
+ * @brief 영속도 갱신 (ZUPT)
+ */
+bool ekf_update_zupt(EKF *ekf) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_ZUPT, NULL, 0, NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_zupt(ekf));
+    }
+    
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    
+    // 1. 측정 자코비안 계산 (속도 상태만)
+    MatrixSparseRow H[3];
+    ekf_compute_velocity_jacobian(ekf, H);
+    
+    // 2. 측정 잔차 계산 (0 - 예측 속도)
+    Vector3f vel_pred = ekf->s.vel;
+    Mat3x1 y;
+    MATRIX_AT(&y, 0, 0) = -vel_pred.x;
+    MATRIX_AT(&y, 1, 0) = -vel_pred.y;
+    MATRIX_AT(&y, 2, 0) = -vel_pred.z;
+    
+    // 3. 칼만 게인 계산 및 상태/공분산 갱신
+    return ekf_measurement_update_3(ekf, EKF_SENSOR_ZUPT, H, &ekf->R_zupt, &y);
+}
+
+/**
+ * @brief 발사 레일 구속 갱신
+ */
+bool ekf_update_rail(EKF *ekf, float dt) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_RAIL, &dt, sizeof(dt), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_rail(ekf, dt));
+    }
+    
+    if (ekf == NULL || !ekf->initialized || !ekf->rail_active || !(dt >= 0.0f)) {
+        return false;
+    }
+
+    const float (*R)[3] = ekf_epoch_rotation(ekf);
+
+    // 0. 레일 이동 거리 (기체 축 방향 속력 사다리꼴 적분)
+    Vector3f v = ekf->s.vel;
+    float axial = fabsf(R[0][2] * v.x + R[1][2] * v.y + R[2][2] * v.z);
+    ekf->rail_distance += 0.5f * (axial + ekf->rail_speed_last) * dt;
+    ekf->rail_speed_last = axial;
+    if (ekf->rail_distance >= ekf->rail_length) {
+        ekf->rail_active = false;
+        return false;
+    }
+
+    bool ok = true;
+    for (uint8_t i = 0; i < 2; i++) {
+        // 1. 측정 자코비안 (속도 상태만, R(q)의 i열)
+        MatrixSparseRow H[1];
+        matrix_sparse_row_clear(&H[0]);
+        matrix_sparse_row_add(&H[0], EKF_STATE_VEL_X, R[0][i]);
+        matrix_sparse_row_add(&H[0], EKF_STATE_VEL_Y, R[1][i]);
+        matrix_sparse_row_add(&H[0], EKF_STATE_VEL_Z, R[2][i]);
+
+        // 2. 측정 잔차 (0 - 몸체 횡방향 속도, 앞 축 갱신 후의 속도)
+        v = ekf->s.vel;
+        Mat1x1 y;
+        MATRIX_AT(&y, 0, 0) = -(R[0][i] * v.x + R[1][i] * v.y + R[2][i] * v.z);
+
+        // 3. 칼만 게인 계산 및 상태/공분산 갱신 (스칼라)
+        if (!ekf_measurement_update_1(ekf, EKF_SENSOR_RAIL, H, &ekf->R_rail, &y)) {
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief 영각속도 갱신 (ZARU)
+ */
+bool ekf_update_zero_rate(EKF *ekf, Vector3f gyro_mean, float rate_std) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_ImuSample args = { gyro_mean, vector3f_zero(), rate_std };
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_ZERO_RATE, &args, sizeof(args), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_zero_rate(ekf, gyro_mean, rate_std));
+    }
+    
+    if (ekf == NULL || !ekf->initialized || rate_std <= 0.0f) {
+        return false;
+    }
+    
+    // 1. 측정 자코비안 계산 (자이로 바이어스 상태만)
+    MatrixSparseRow H[3];
+    ekf_compute_gyro_bias_jacobian(ekf, H);
+    
+    // 2. 측정 잔차 계산 (평균 자이로 - 예측 바이어스)
+    Vector3f bias_pred = ekf->s.bg;
+    Mat3x1 y;
+    MATRIX_AT(&y, 0, 0) = gyro_mean.x - bias_pred.x;
+    MATRIX_AT(&y, 1, 0) = gyro_mean.y - bias_pred.y;
+    MATRIX_AT(&y, 2, 0) = gyro_mean.z - bias_pred.z;
+    
+    // 3. 측정 노이즈 (세 축 동일)
+    Mat3x3 R;
+    mat3x3_zero(&R);
+    MATRIX_AT(&R, 0, 0) = rate_std * rate_std;
+    MATRIX_AT(&R, 1, 1) = rate_std * rate_std;
+    MATRIX_AT(&R, 2, 2) = rate_std * rate_std;
+    
+    // 4. 칼만 게인 계산 및 상태/공분산 갱신
+    return ekf_measurement_update_3(ekf, EKF_SENSOR_ZARU, H, &R, &y);
+}
+
+/**
+ * @brief 항력 비력 갱신 (관성 비행)
+ */
+bool ekf_update_drag(EKF *ekf, Vector3f accel) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_DRAG, &accel, sizeof(accel), NULL, 0);
+        return ekf_call_exit(ekf, ekf_update_drag(ekf, accel));
+    }
+    
+#if EKF_CONFIG_DRAG
+    if (ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+
+    Vector3f v = ekf->s.vel;
+    float speed = sqrtf(vector3f_magnitude_squared(v));
+    if (!(speed > 0.0f)) {
+        return false;
+    }
+
+    const float (*R)[3] = ekf_epoch_rotation(ekf);
+    float k = ekf->s.drag;
+    const float vn[3] = { v.x, v.y, v.z };
+    const float ba[3] = { ekf->s.ba.x, ekf->s.ba.y, ekf->s.ba.z };
+    const float f[3] = { accel.x, accel.y, accel.z };
+
+    // 몸체 속도 v_b = R^T v
+    float vb[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        vb[i] = R[0][i] * vn[0] + R[1][i] * vn[1] + R[2][i] * vn[2];
+    }
+
+    // 1-3. 예측 h_i = -k |v| v_b,i + b_a,i 와 자코비안 (k, b_a, 속도; 자세는 제외)
+    //      dh_i/dv_j = -k (|v| R_ji + v_b,i v_j / |v|)
+    MatrixSparseRow H[3];
+    Mat3x1 y;
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        for (uint8_t j = 0; j < 3; j++) {
+            matrix_sparse_row_add(&H[i], EKF_STATE_VEL_X + j, -k * (speed * R[j][i] + vb[i] * vn[j] / speed));
+        }
+        matrix_sparse_row_add(&H[i], EKF_STATE_ACC_BIAS_X + i, 1.0f);
+        matrix_sparse_row_add(&H[i], EKF_STATE_DRAG_K, -speed * vb[i]);
+        MATRIX_AT(&y, i, 0) = f[i] - (-k * speed * vb[i] + ba[i]);
+    }
+
+    // 4. 칼만 게인 계산 및 상태/공분산 갱신
+    return ekf_measurement_update_3(ekf, EKF_SENSOR_DRAG, H, &ekf->R_drag, &y);
+#else
+    (void)ekf;
+    (void)accel;
+
+    // 항력 계수 상태가 없는 구성
+    return false;
+#endif
+}
+
+/**
+ * @brief 외부 항법 추정으로 공분산 교차(CI) 갱신
+ */
+bool ekf_update_nav_estimate(EKF *ekf, Quaternion q, Vector3f vel, Vector3f pos,
+                             const float P_ext[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM],
+                             uint8_t components, float omega) {
+    if (EKF_CALL_OBSERVED(ekf)) {
+        const EKF_CallNavEstimate args = { q, vel, pos, components, omega };
+        ekf_call_enter(ekf, EKF_CALL_UPDATE_NAV_ESTIMATE, &args, sizeof(args),
+                       P_ext, (P_ext != NULL) ? (uint16_t)sizeof(float[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM]) : 0u);
+        return ekf_call_exit(ekf, ekf_update_nav_estimate(ekf, q, vel, pos, P_ext, components, omega));
+    }
+    
+    if (ekf == NULL || P_ext == NULL || !ekf->initialized || !(omega > 0.0f) || omega > 1.0f) {
+        return false;
+    }
+    
+    components &= EKF_NAV_ERROR_ATT | EKF_NAV_ERROR_VEL | EKF_NAV_ERROR_POS;
+#if !EKF_CONFIG_POSITION
+    components &= (uint8_t)~EKF_NAV_ERROR_POS;
+#endif
+    if (components == 0 || ekf->info.open) {
+        return false;
+    }
+    if (omega >= 1.0f) {
+        // 외부 추정 가중치 0
+        return true;
+    }
+    
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+    if (ekf->steady_gain) {
+        ekf_steady_gain_reset(ekf);
+    }
+    
+    // 1. 측정 자코비안과 잔차 (쓰지 않는 성분은 H = 0, R = 1인 빈 행으로 채움)
+    const float *x = &ekf->x.data[0][0];
+    MatrixSparseRow H[EKF_NAV_ERROR_DIM];
+    float y[EKF_NAV_ERROR_DIM];
+    bool used[EKF_NAV_ERROR_DIM];
+    for (uint8_t k = 0; k < EKF_NAV_ERROR_DIM; k++) {
+        matrix_sparse_row_clear(&H[k]);
+        y[k] = 0.0f;
+        used[k] = false;
+    }
+    
+    if (components & EKF_NAV_ERROR_ATT) {
+        Quaternion qs = ekf->s.quat;
+        float Xi[4][3];
+        quaternion_error_jacobian(qs, Xi);
+        Vector3f theta = quaternion_to_rotation_vector(
+            quaternion_multiply(quaternion_conjugate(qs), quaternion_normalize(q)));
+        const float th[3] = { theta.x, theta.y, theta.z };
+        for (uint8_t a = 0; a < 3; a++) {
+            for (uint8_t i = 0; i < 4; i++) {
+                matrix_sparse_row_add(&H[a], (uint8_t)(EKF_STATE_QUAT_W + i), 2.0f * Xi[i][a]);
+            }
+            y[a] = th[a];
+            used[a] = true;
+        }
+    }
+    if (components & EKF_NAV_ERROR_VEL) {
+        const float v[3] = { vel.x, vel.y, vel.z };
+        for (uint8_t a = 0; a < 3; a++) {
+            matrix_sparse_row_add(&H[3 + a], (uint8_t)(EKF_STATE_VEL_X + a), 1.0f);
+            y[3 + a] = v[a] - x[EKF_STATE_VEL_X + a];
+            used[3 + a] = true;
+        }
+    }
+#if EKF_CONFIG_POSITION
+    if (components & EKF_NAV_ERROR_POS) {
+        const float p[3] = { pos.x, pos.y, pos.z };
+        for (uint8_t a = 0; a < 3; a++) {
+            matrix_sparse_row_add(&H[6 + a], (uint8_t)(EKF_STATE_POS_X + a), 1.0f);
+            y[6 + a] = p[a] - x[EKF_STATE_POS_X + a];
+            used[6 + a] = true;
+        }
+    }
+#else
+    (void)pos;
+#endif
+    
+    ScratchArena *scratch = ekf->scratch;
+    uint32_t mark = scratch_mark(scratch);
+    float (*PHt)[EKF_NAV_ERROR_DIM] = scratch_alloc(scratch, sizeof(float) * EKF_STATE_DIM * EKF_NAV_ERROR_DIM);
+    float (*K)[EKF_NAV_ERROR_DIM] = scratch_alloc(scratch, sizeof(float) * EKF_STATE_DIM * EKF_NAV_ERROR_DIM);
+    Mat9x9 *S = scratch_alloc(scratch, sizeof(Mat9x9));
+    Mat9x9 *LD = scratch_alloc(scratch, sizeof(Mat9x9));
+    if (PHt == NULL || K == NULL || S == NULL || LD == NULL) {
+        scratch_release(scratch, mark);
+        return false;
+    }
+    
+    // 2. 자기 추정 부풀리기 P = P / ω (모든 상태, 상관 유지)
+    float inv_omega = 1.0f / omega;
+    for (uint32_t k = 0; k < sizeof(ekf->P.data) / sizeof(ekf->P.data[0]); k++) {
+        ekf->P.data[k] *= inv_omega;
+    }
+    
+    // 3. PH^T, S = H PH^T + Pb / (1 - ω)
+    for (uint8_t r = 0; r < EKF_STATE_DIM; r++) {
+        for (uint8_t k = 0; k < EKF_NAV_ERROR_DIM; k++) {
+            float sum = 0.0f;
+            for (uint8_t j = 0; j < H[k].count; j++) {
+                sum += ekf->P.data[EKF_SYM_FN(index)(r, H[k].index[j])] * H[k].value[j];
+            }
+            PHt[r][k] = sum;
+        }
+    }
+    float inv_rest = 1.0f / (1.0f - omega);
+    for (uint8_t k = 0; k < EKF_NAV_ERROR_DIM; k++) {
+        for (uint8_t l = 0; l < EKF_NAV_ERROR_DIM; l++) {
+            float sum;
+            if (used[k] && used[l]) {
+                sum = P_ext[k][l] * inv_rest;
+            } else {
+                sum = (k == l) ? 1.0f : 0.0f;
+            }
+            for (uint8_t j = 0; j < H[k].count; j++) {
+                sum += H[k].value[j] * PHt[H[k].index[j]][l];
+            }
+            S->data[k][l] = sum;
+        }
+    }
+    
+    // 4. K = PH^T S^-1, 상태와 공분산 갱신 (S가 양정치가 아니면 부풀린 P만 되돌림)
+    bool ok = mat9x9_ldlt(S, LD);
+    if (!ok) {
+        for (uint32_t k = 0; k < sizeof(ekf->P.data) / sizeof(ekf->P.data[0]); k++) {
+            ekf->P.data[k] *= omega;
+        }
+    } else {
+        for (uint8_t r = 0; r < EKF_STATE_DIM; r++) {
+            for (uint8_t k = 0; k < EKF_NAV_ERROR_DIM; k++) {
+                K[r][k] = PHt[r][k];
+            }
+            mat9x9_ldlt_solve(LD, K[r]);
+        }
+        if (ekf->consider_mask != 0) {
+            ekf_consider_gain(ekf, &K[0][0], EKF_NAV_ERROR_DIM);
+        }
+        
+        for (uint8_t r = 0; r < EKF_STATE_DIM; r++) {
+            float dx = 0.0f;
+            for (uint8_t k = 0; k < EKF_NAV_ERROR_DIM; k++) {
+                dx += K[r][k] * y[k];
+            }
+            ekf->x.data[r][0] += dx;
+        }
+        ekf_normalize_state_quaternion(ekf);
+        
+        // 고려 상태가 없으면 P - K (PH^T)^T와 같음
+        ekf_consider_subtract_product(ekf, &K[0][0], &PHt[0][0], EKF_NAV_ERROR_DIM);
+        ekf_bound_variances(ekf);
+    }
+    
+    if (ekf->engine == EKF_ENGINE_UD) {
+        EKF_UD_FN(from_sym)(&ekf->P, &ekf->UD);
+    }
+    
+    scratch_release(scratch, mark);
+    return ok;
 }
@@ -0,0 +1,108 @@
+/**
+ * @file ekf_wmm.c
+ * @brief 지구 자기장 모델 격자 표 조회 구현
+ */
+
+#include "ekf/ekf_wmm.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief 도 -> 라디안
+ */
+#define EKF_WMM_DEG_TO_RAD (FAST_MATH_PI / 180.0f)
+
+/**
+ * @brief 편각 차이를 [-180, 180)도로 정리 (0.01도 단위, 셀 안 순환 보정용)
+ */
+static float ekf_wmm_wrap_decl(float diff) {
+    if (diff >= 18000.0f) {
+        return diff - 36000.0f;
+    }
+    if (diff < -18000.0f) {
+        return diff + 36000.0f;
+    }
+    return diff;
+}
+
+/**
+ * @brief 격자 셀 네 꼭짓점의 쌍선형 보간
+ */
+static float ekf_wmm_bilinear(const int16_t table[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT],
+                              int i, int j, float u, float v) {
+    float v00 = (float)table[i][j];
+    float v01 = (float)table[i][j + 1];
+    float v10 = (float)table[i + 1][j];
+    float v11 = (float)table[i + 1][j + 1];
+
+    return v00 + u * (v01 - v00) + v * (v10 - v00) + u * v * (v00 - v01 - v10 + v11);
+}
+
+/**
+ * @brief 위도/경도에서 자기장 요소 조회
+ */
+bool ekf_wmm_lookup(float lat_deg, float lon_deg, EKF_WmmField *field) {
+    if (field == NULL || !isfinite(lat_deg) || !isfinite(lon_deg)) {
+        return false;
+    }
+
+    // 위도 제한, 경도 [-180, 180) 순환
+    lat_deg = fminf(fmaxf(lat_deg, -90.0f), 90.0f);
+    lon_deg = fmodf(lon_deg + 180.0f, 360.0f);
+    if (lon_deg < 0.0f) {
+        lon_deg += 360.0f;
+    }
+
+    float fi = (lat_deg - (float)EKF_WMM_LAT_MIN_DEG) / (float)EKF_WMM_GRID_STEP_DEG;
+    float fj = lon_deg / (float)EKF_WMM_GRID_STEP_DEG;
+    int i = (int)fi;
+    int j = (int)fj;
+    if (i > EKF_WMM_LAT_COUNT - 2) {
+        i = EKF_WMM_LAT_COUNT - 2;
+    }
+    if (j > EKF_WMM_LON_COUNT - 2) {
+        j = EKF_WMM_LON_COUNT - 2;
+    }
+    float v = fi - (float)i;
+    float u = fj - (float)j;
+
+    // 편각은 셀 안에서 ±180도를 넘나들 수 있으므로 첫 꼭짓점 기준으로 펼쳐서 보간
+    float d00 = (float)ekf_wmm_declination[i][j];
+    float d01 = d00 + ekf_wmm_wrap_decl((float)ekf_wmm_declination[i][j + 1] - d00);
+    float d10 = d00 + ekf_wmm_wrap_decl((float)ekf_wmm_declination[i + 1][j] - d00);
+    float d11 = d00 + ekf_wmm_wrap_decl((float)ekf_wmm_declination[i + 1][j + 1] - d00);
+    float decl = d00 + u * (d01 - d00) + v * (d10 - d00) + u * v * (d00 - d01 - d10 + d11);
+
+    field->declination = ekf_wmm_wrap_decl(decl) * EKF_WMM_ANGLE_SCALE * EKF_WMM_DEG_TO_RAD;
+    field->inclination = ekf_wmm_bilinear(ekf_wmm_inclination, i, j, u, v) *
+                         EKF_WMM_ANGLE_SCALE * EKF_WMM_DEG_TO_RAD;
+    field->intensity = ekf_wmm_bilinear(ekf_wmm_intensity, i, j, u, v) * EKF_WMM_INTENSITY_SCALE;
+
+    return true;
+}
+
+/**
+ * @brief 위도/경도에서 NED 좌표계 지구 자기장 벡터 조회
+ */
+bool ekf_wmm_get_field_ned(float lat_deg, float lon_deg, Vector3f *mag_ned) {
+    if (mag_ned == NULL) {
+        return false;
+    }
+
+    EKF_WmmField field;
+    if (!ekf_wmm_lookup(lat_deg, lon_deg, &field)) {
+        return false;
+    }
+
+    float sin_d, cos_d, sin_i, cos_i;
+    fast_sincosf(field.declination, &sin_d, &cos_d);
+    fast_sincosf(field.inclination, &sin_i, &cos_i);
+
+    // nT -> G
+    float total = field.intensity * 1e-5f;
+    float horizontal = total * cos_i;
+    *mag_ned = vector3f_create(horizontal * cos_d, horizontal * sin_d, total * sin_i);
+
+    return true;
+}
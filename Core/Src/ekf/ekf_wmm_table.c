@@ -0,0 +1,804 @@
+/**
+ * @file ekf_wmm_table.c
+ * @brief 지구 자기장 격자 표 (Tools/wmm/wmm_grid.c 생성 파일, 직접 수정 금지)
+ *
+ * 모델: IGRF-13 2020.0 (n <= 6)
+ * 격자: 5도 간격, 위도 -90..90, 경도 -180..180
+ */
+
+#include "ekf/ekf_wmm.h"
+
+/**
+ * @brief declination (0.01도)
+ */
+const int16_t ekf_wmm_declination[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT] = {
+    /* -90 */ {  14698,  14197,  13696,  13195,  12694,  12193,  11693,  11192,  10692,  10192,   9692,   9192,
+                 8692,   8192,   7693,   7193,   6694,   6195,   5696,   5197,   4699,   4200,   3701,   3203,
+                 2704,   2206,   1707,   1209,    711,    212,   -286,   -784,  -1283,  -1781,  -2280,  -2778,
+                -3277,  -3776,  -4275,  -4774,  -5273,  -5772,  -6271,  -6771,  -7271,  -7770,  -8270,  -8770,
+                -9271,  -9771, -10272, -10772, -11273, -11774, -12275, -12776, -13277, -13779, -14280, -14781,
+               -15283, -15785, -16286, -16788, -17289, -17791,  17707,  17206,  16704,  16202,  15701,  15200,
+                14698 },
+    /* -85 */ {  13947,  13383,  12827,  12280,  11742,  11214,  10694,  10184,   9682,   9188,   8701,   8222,
+                 7749,   7283,   6822,   6366,   5914,   5467,   5023,   4582,   4145,   3709,   3276,   2844,
+                 2413,   1984,   1555,   1126,    697,    267,   -164,   -595,  -1028,  -1463,  -1901,  -2340,
+                -2783,  -3228,  -3677,  -4129,  -4586,  -5046,  -5511,  -5981,  -6456,  -6936,  -7421,  -7912,
+                -8410,  -8914,  -9424,  -9942, -10467, -10999, -11539, -12087, -12642, -13205, -13776, -14353,
+               -14937, -15526, -16121, -16719, -17319, -17921,  17478,  16878,  16281,  15688,  15101,  14520,
+                13947 },
+    /* -80 */ {  12779,  12160,  11569,  11005,  10467,   9951,   9456,   8980,   8519,   8072,   7637,   7213,
+                 6797,   6389,   5986,   5589,   5197,   4807,   4421,   4038,   3656,   3277,   2899,   2522,
+                 2146,   1771,   1395,   1020,    645,    268,   -110,   -490,   -873,  -1259,  -1649,  -2043,
+                -2441,  -2844,  -3253,  -3667,  -4087,  -4513,  -4945,  -5383,  -5828,  -6279,  -6738,  -7204,
+                -7679,  -8163,  -8657,  -9162,  -9680, -10212, -10760, -11326, -11911, -12518, -13148, -13802,
+               -14481, -15184, -15909, -16654, -17413,  17819,  17051,  16289,  15540,  14810,  14105,  13428,
+                12779 },
+    /* -75 */ {  11038,  10440,   9895,   9395,   8932,   8499,   8090,   7701,   7328,   6967,   6615,   6269,
+                 5928,   5591,   5255,   4920,   4584,   4249,   3913,   3576,   3239,   2901,   2564,   2227,
+                 1891,   1556,   1222,    888,    554,    220,   -116,   -454,   -795,  -1140,  -1491,  -1849,
+                -2213,  -2584,  -2963,  -3350,  -3744,  -4145,  -4553,  -4967,  -5386,  -5811,  -6242,  -6677,
+                -7119,  -7568,  -8025,  -8492,  -8971,  -9466,  -9979, -10517, -11085, -11690, -12340, -13046,
+               -13816, -14659, -15581, -16577, -17634,  17275,  16186,  15136,  14152,  13250,  12433,  11699,
+                11038 },
+    /* -70 */ {   8798,   8370,   7990,   7645,   7327,   7030,   6749,   6478,   6214,   5955,   5697,   5438,
+                 5176,   4911,   4639,   4361,   4077,   3786,   3490,   3187,   2881,   2571,   2259,   1948,
+                 1637,   1328,   1022,    719,    418,    119,   -179,   -479,   -782,  -1091,  -1408,  -1733,
+                -2070,  -2417,  -2776,  -3145,  -3523,  -3910,  -4303,  -4700,  -5101,  -5504,  -5908,  -6312,
+                -6716,  -7120,  -7526,  -7934,  -8347,  -8769,  -9203,  -9656, -10136, -10657, -11236, -11898,
+               -12684, -13650, -14870, -16413,  17738,  15782,  14007,  12567,  11446,  10571,   9869,   9290,
+                 8798 },
+    /* -65 */ {   6627,   6427,   6238,   6060,   5888,   5723,   5561,   5400,   5239,   5074,   4904,   4726,
+                 4538,   4338,   4125,   3899,   3658,   3403,   3136,   2857,   2568,   2273,   1972,   1671,
+                 1371,   1075,    784,    501,    226,    -43,   -307,   -571,   -836,  -1108,  -1391,  -1687,
+                -1998,  -2327,  -2671,  -3031,  -3402,  -3782,  -4167,  -4554,  -4941,  -5323,  -5700,  -6070,
+                -6430,  -6782,  -7124,  -7457,  -7780,  -8096,  -8406,  -8711,  -9017,  -9327,  -9652, -10008,
+               -10430, -11002, -12011, -15064,  12456,   9538,   8569,   8029,   7647,   7341,   7078,   6842,
+                 6627 },
+    /* -60 */ {   5000,   4944,   4879,   4808,   4734,   4657,   4580,   4499,   4415,   4324,   4225,   4115,
+                 3990,   3848,   3688,   3506,   3303,   3078,   2833,   2568,   2287,   1994,   1692,   1386,
+                 1082,    785,    497,    223,    -36,   -280,   -514,   -740,   -965,  -1197,  -1443,  -1707,
+                -1994,  -2305,  -2639,  -2992,  -3361,  -3738,  -4119,  -4497,  -4869,  -5229,  -5574,  -5903,
+                -6212,  -6501,  -6766,  -7006,  -7218,  -7398,  -7541,  -7639,  -7679,  -7641,  -7486,  -7142,
+                -6460,  -5125,  -2679,    425,   2644,   3832,   4453,   4785,   4957,   5036,   5057,   5040,
+                 5000 },
+    /* -55 */ {   3902,   3908,   3898,   3879,   3854,   3825,   3795,   3762,   3727,   3688,   3641,   3582,
+                 3509,   3416,   3300,   3159,   2988,   2789,   2560,   2303,   2023,   1722,   1407,   1085,
+                  764,    450,    152,   -125,   -378,   -606,   -812,  -1001,  -1183,  -1370,  -1571,  -1797,
+                -2054,  -2345,  -2667,  -3015,  -3380,  -3753,  -4126,  -4491,  -4840,  -5170,  -5475,  -5753,
+                -6000,  -6213,  -6388,  -6518,  -6598,  -6617,  -6562,  -6415,  -6149,  -5728,  -5109,  -4244,
+                -3115,  -1788,   -432,    768,   1720,   2428,   2938,   3296,   3544,   3709,   3813,   3874,
+                 3902 },
+    /* -50 */ {   3158,   3184,   3195,   3195,   3189,   3181,   3172,   3164,   3156,   3146,   3132,   3111,
+                 3076,   3022,   2944,   2836,   2695,   2517,   2301,   2049,   1763,   1448,   1112,    763,
+                  413,     72,   -250,   -543,   -801,  -1021,  -1205,  -1360,  -1497,  -1631,  -1779,  -1956,
+                -2173,  -2434,  -2735,  -3069,  -3423,  -3783,  -4138,  -4478,  -4794,  -5081,  -5334,  -5550,
+                -5724,  -5850,  -5922,  -5931,  -5866,  -5714,  -5459,  -5087,  -4585,  -3950,  -3195,  -2357,
+                -1487,   -643,    129,    805,   1376,   1846,   2223,   2519,   2745,   2911,   3029,   3109,
+                 3158 },
+    /* -45 */ {   2631,   2662,   2678,   2683,   2683,   2680,   2678,   2678,   2680,   2685,   2689,   2689,
+                 2680,   2655,   2606,   2526,   2410,   2251,   2046,   1795,   1501,   1168,    805,    424,
+                   38,   -338,   -690,  -1006,  -1276,  -1496,  -1665,  -1790,  -1883,  -1961,  -2048,  -2163,
+                -2322,  -2534,  -2796,  -3098,  -3423,  -3754,  -4076,  -4377,  -4648,  -4883,  -5076,  -5222,
+                -5317,  -5351,  -5317,  -5205,  -5003,  -4703,  -4300,  -3798,  -3215,  -2581,  -1930,  -1296,
+                 -701,   -156,    336,    776,   1165,   1505,   1795,   2037,   2233,   2385,   2498,   2578,
+                 2631 },
+    /* -40 */ {   2239,   2269,   2285,   2290,   2289,   2286,   2283,   2283,   2286,   2294,   2304,   2314,
+                 2319,   2312,   2284,   2225,   2128,   1984,   1788,   1538,   1234,    883,    494,     81,
+                 -340,   -749,  -1129,  -1465,  -1745,  -1964,  -2119,  -2216,  -2267,  -2290,  -2309,  -2349,
+                -2432,  -2570,  -2765,  -3007,  -3279,  -3562,  -3838,  -4092,  -4314,  -4496,  -4632,  -4714,
+                -4736,  -4690,  -4566,  -4357,  -4059,  -3673,  -3211,  -2696,  -2161,  -1635,  -1141,   -691,
+                 -285,     81,    415,    723,   1006,   1266,   1499,   1702,   1872,   2009,   2113,   2188,
+                 2239 },
+    /* -35 */ {   1936,   1964,   1978,   1981,   1978,   1972,   1966,   1962,   1961,   1965,   1974,   1985,
+                 1995,   1997,   1980,   1936,   1853,   1720,   1531,   1280,    969,    602,    191,   -248,
+                 -693,  -1123,  -1517,  -1858,  -2134,  -2338,  -2470,  -2534,  -2541,  -2508,  -2457,  -2414,
+                -2403,  -2444,  -2543,  -2699,  -2897,  -3118,  -3344,  -3555,  -3739,  -3885,  -3982,  -4022,
+                -3997,  -3900,  -3725,  -3469,  -3136,  -2739,  -2300,  -1848,  -1410,  -1007,   -649,   -333,
+                  -55,    198,    433,    658,    875,   1082,   1276,   1450,   1601,   1724,   1820,   1890,
+                 1936 },
+    /* -30 */ {   1696,   1721,   1732,   1734,   1729,   1720,   1711,   1702,   1695,   1693,   1696,   1704,
+                 1712,   1715,   1703,   1666,   1591,   1466,   1281,   1030,    713,    336,    -89,   -541,
+                 -996,  -1428,  -1815,  -2140,  -2390,  -2561,  -2654,  -2672,  -2628,  -2535,  -2416,  -2291,
+                -2187,  -2123,  -2116,  -2170,  -2282,  -2437,  -2616,  -2798,  -2965,  -3099,  -3187,  -3218,
+                -3184,  -3078,  -2897,  -2645,  -2333,  -1977,  -1603,  -1236,   -897,   -597,   -340,   -120,
+                   73,    249,    419,    589,    761,    933,   1099,   1253,   1389,   1502,   1590,   1654,
+                 1696 },
+    /* -25 */ {   1502,   1523,   1532,   1532,   1526,   1516,   1504,   1491,   1480,   1472,   1468,   1468,
+                 1471,   1471,   1459,   1424,   1352,   1230,   1047,    797,    477,     96,   -333,   -784,
+                -1232,  -1648,  -2009,  -2298,  -2504,  -2626,  -2666,  -2630,  -2531,  -2383,  -2205,  -2016,
+                -1837,  -1689,  -1591,  -1555,  -1585,  -1676,  -1812,  -1973,  -2134,  -2275,  -2377,  -2426,
+                -2411,  -2328,  -2175,  -1960,  -1696,  -1401,  -1099,   -811,   -553,   -332,   -148,      5,
+                  138,    262,    387,    519,    660,    808,    956,   1096,   1221,   1325,   1406,   1464,
+                 1502 },
+    /* -20 */ {   1345,   1362,   1369,   1367,   1361,   1350,   1337,   1323,   1308,   1294,   1284,   1278,
+                 1274,   1268,   1252,   1214,   1141,   1020,    838,    587,    268,   -112,   -535,   -974,
+                -1401,  -1786,  -2106,  -2346,  -2499,  -2565,  -2548,  -2460,  -2313,  -2123,  -1907,  -1680,
+                -1460,  -1264,  -1109,  -1011,   -979,  -1016,  -1112,  -1248,  -1403,  -1551,  -1671,  -1745,
+                -1760,  -1712,  -1600,  -1431,  -1220,   -985,   -746,   -523,   -327,   -164,    -34,     71,
+                  161,    249,    343,    449,    570,    702,    837,    968,   1085,   1183,   1258,   1311,
+                 1345 },
+    /* -15 */ {   1217,   1231,   1235,   1232,   1225,   1215,   1203,   1188,   1172,   1156,   1141,   1129,
+                 1118,   1105,   1083,   1040,    964,    840,    656,    405,     88,   -285,   -695,  -1114,
+                -1510,  -1855,  -2128,  -2315,  -2412,  -2423,  -2356,  -2225,  -2044,  -1830,  -1598,  -1359,
+                -1127,   -914,   -734,   -604,   -534,   -531,   -590,   -700,   -840,   -987,  -1117,  -1211,
+                -1254,  -1238,  -1165,  -1040,   -876,   -692,   -504,   -331,   -183,    -64,     27,     97,
+                  157,    218,    290,    379,    486,    608,    737,    862,    975,   1068,   1139,   1188,
+                 1217 },
+    /* -10 */ {   1114,   1125,   1126,   1123,   1116,   1107,   1097,   1084,   1068,   1051,   1034,   1017,
+                 1001,    982,    953,    903,    820,    690,    503,    251,    -62,   -427,   -820,  -1212,
+                -1573,  -1874,  -2097,  -2232,  -2277,  -2241,  -2134,  -1972,  -1772,  -1549,  -1316,  -1083,
+                 -857,   -647,   -465,   -323,   -233,   -203,   -234,   -318,   -440,   -578,   -709,   -814,
+                 -876,   -887,   -844,   -755,   -631,   -487,   -341,   -207,    -96,    -11,     49,     93,
+                  130,    172,    229,    307,    406,    522,    648,    771,    882,    974,   1042,   1088,
+                 1114 },
+    /*  -5 */ {   1031,   1040,   1040,   1036,   1030,   1023,   1016,   1006,    993,    978,    960,    941,
+                  920,    895,    857,    799,    707,    570,    377,    123,   -187,   -541,   -915,  -1278,
+                -1601,  -1858,  -2033,  -2120,  -2121,  -2046,  -1909,  -1729,  -1521,  -1300,  -1076,   -856,
+                 -645,   -448,   -274,   -132,    -34,     11,      0,    -62,   -165,   -290,   -417,   -526,
+                 -599,   -628,   -609,   -548,   -455,   -345,   -232,   -131,    -50,      8,     44,     67,
+                   86,    114,    160,    230,    325,    439,    564,    689,    801,    894,    962,   1006,
+                 1031 },
+    /*  +0 */ {    963,    972,    973,    969,    966,    962,    959,    954,    946,    933,    917,    897,
+                  872,    840,    794,    725,    623,    475,    275,     18,   -290,   -633,   -987,  -1321,
+                -1607,  -1821,  -1952,  -1997,  -1961,  -1856,  -1699,  -1507,  -1299,  -1085,   -875,   -671,
+                 -478,   -298,   -137,     -2,     96,    149,    153,    107,     22,    -90,   -209,   -316,
+                 -395,   -436,   -435,   -396,   -328,   -246,   -161,    -87,    -32,      2,     17,     22,
+                   27,     43,     80,    145,    238,    353,    480,    608,    725,    821,    892,    938,
+                  963 },
+    /*  +5 */ {    907,    920,    923,    923,    923,    924,    927,    927,    924,    917,    903,    882,
+                  854,    815,    759,    678,    563,    403,    192,    -70,   -377,   -709,  -1043,  -1348,
+                -1598,  -1774,  -1865,  -1874,  -1807,  -1679,  -1509,  -1313,  -1108,   -904,   -707,   -521,
+                 -346,   -183,    -36,     89,    183,    239,    251,    219,    148,     50,    -59,   -161,
+                 -241,   -289,   -301,   -280,   -234,   -175,   -115,    -66,    -34,    -22,    -26,    -38,
+                  -46,    -40,    -10,     51,    142,    258,    389,    523,    646,    749,    826,    878,
+                  907 },
+    /* +10 */ {    858,    879,    889,    895,    902,    910,    919,    927,    930,    927,    916,    895,
+                  863,    816,    749,    654,    523,    348,    125,   -144,   -451,   -774,  -1089,  -1366,
+                -1583,  -1723,  -1780,  -1757,  -1666,  -1522,  -1343,  -1146,   -946,   -752,   -569,   -398,
+                 -239,    -92,     40,    154,    242,    298,    315,    293,    235,    150,     52,    -43,
+                 -121,   -172,   -193,   -186,   -158,   -121,    -85,    -59,    -50,    -59,    -82,   -110,
+                 -132,   -136,   -112,    -56,     34,    151,    286,    426,    557,    670,    758,    820,
+                  858 },
+    /* +15 */ {    810,    845,    867,    885,    902,    919,    937,    953,    963,    965,    956,    934,
+                  897,    840,    760,    648,    500,    307,     70,   -209,   -517,   -832,  -1129,  -1381,
+                -1567,  -1675,  -1702,  -1654,  -1544,  -1387,  -1202,  -1006,   -811,   -625,   -454,   -296,
+                 -152,    -19,    100,    203,    284,    337,    358,    344,    297,    225,    140,     54,
+                  -19,    -71,    -99,   -104,    -93,    -76,    -62,    -60,    -75,   -105,   -147,   -192,
+                 -228,   -243,   -228,   -177,    -90,     27,    166,    312,    454,    579,    681,    758,
+                  810 },
+    /* +20 */ {    760,    814,    856,    890,    922,    952,    981,   1005,   1023,   1029,   1021,    997,
+                  952,    884,    788,    658,    489,    277,     22,   -269,   -579,   -888,  -1168,  -1397,
+                -1555,  -1635,  -1637,  -1568,  -1442,  -1277,  -1088,   -892,   -701,   -523,   -360,   -213,
+                  -81,     40,    148,    241,    315,    366,    389,    382,    347,    288,    216,    141,
+                   75,     24,     -8,    -24,    -29,    -32,    -42,    -64,   -103,   -157,   -220,   -283,
+                 -334,   -361,   -356,   -312,   -230,   -114,     27,    179,    331,    471,    591,    687,
+                  760 },
+    /* +25 */ {    702,    783,    849,    906,    958,   1005,   1047,   1082,   1106,   1116,   1109,   1081,
+                 1028,    946,    832,    681,    488,    252,    -23,   -327,   -643,   -947,  -1213,  -1420,
+                -1554,  -1609,  -1589,  -1503,  -1366,  -1193,  -1001,   -806,   -618,   -444,   -287,   -147,
+                  -23,     88,    187,    272,    341,    391,    417,    417,    393,    349,    291,    229,
+                  171,    124,     88,     62,     40,     16,    -18,    -67,   -132,   -212,   -298,   -381,
+                 -449,   -490,   -496,   -460,   -384,   -272,   -131,     26,    188,    344,    483,    603,
+                  702 },
+    /* +30 */ {    636,    747,    844,    929,   1005,   1073,   1131,   1178,   1211,   1225,   1217,   1183,
+                 1120,   1024,    889,    714,    494,    231,    -67,   -389,   -713,  -1014,  -1268,  -1457,
+                -1569,  -1604,  -1566,  -1466,  -1318,  -1139,   -945,   -748,   -561,   -389,   -234,    -98,
+                   21,    127,    220,    301,    367,    417,    447,    457,    446,    417,    376,    329,
+                  281,    238,    199,    162,    123,     75,     14,    -64,   -159,   -267,   -379,   -484,
+                 -571,   -627,   -645,   -620,   -551,   -443,   -303,   -142,     29,    199,    361,    507,
+                  636 },
+    /* +35 */ {    560,    706,    836,    953,   1058,   1149,   1227,   1288,   1330,   1349,   1341,   1302,
+                 1228,   1115,    958,    754,    504,    210,   -117,   -460,   -795,  -1096,  -1341,  -1514,
+                -1609,  -1625,  -1572,  -1460,  -1304,  -1120,   -922,   -724,   -534,   -360,   -205,    -68,
+                   52,    156,    248,    329,    396,    450,    489,    511,    516,    505,    482,    451,
+                  415,    376,    333,    284,    226,    152,     61,    -51,   -179,   -319,   -461,   -592,
+                 -699,   -772,   -803,   -787,   -726,   -623,   -485,   -321,   -141,     44,    227,    400,
+                  560 },
+    /* +40 */ {    479,    658,    823,    974,   1109,   1227,   1326,   1405,   1459,   1485,   1478,   1435,
+                 1350,   1218,   1036,    801,    514,    183,   -178,   -547,   -897,  -1202,  -1440,  -1601,
+                -1680,  -1682,  -1616,  -1494,  -1331,  -1142,   -940,   -737,   -543,   -363,   -202,    -59,
+                   66,    176,    273,    359,    435,    498,    550,    588,    613,    624,    622,    608,
+                  584,    549,    502,    439,    358,    255,    128,    -21,   -190,   -367,   -543,   -702,
+                 -832,   -923,   -966,   -960,   -905,   -806,   -668,   -501,   -313,   -114,     89,    289,
+                  479 },
+    /* +45 */ {    396,    606,    804,    987,   1153,   1299,   1423,   1521,   1590,   1626,   1624,   1578,
+                 1483,   1332,   1122,    851,    522,    145,   -258,   -660,  -1030,  -1342,  -1578,  -1728,
+                -1794,  -1783,  -1706,  -1576,  -1406,  -1212,  -1004,   -795,   -593,   -404,   -232,    -77,
+                   62,    185,    296,    396,    486,    568,    639,    700,    749,    784,    806,    811,
+                  800,    769,    717,    639,    532,    395,    227,     31,   -184,   -406,   -621,   -813,
+                 -968,  -1077,  -1133,  -1135,  -1084,   -986,   -847,   -676,   -479,   -267,    -45,    178,
+                  396 },
+    /* +50 */ {    316,    553,    780,    993,   1188,   1362,   1511,   1632,   1719,   1768,   1773,   1727,
+                 1623,   1454,   1213,    899,    518,     86,   -370,   -813,  -1210,  -1533,  -1767,  -1908,
+                -1962,  -1939,  -1852,  -1714,  -1537,  -1336,  -1122,   -904,   -690,   -487,   -298,   -124,
+                   36,    182,    316,    440,    556,    665,    765,    855,    933,    997,   1045,   1072,
+                 1074,   1049,    991,    897,    762,    585,    369,    119,   -152,   -428,   -690,   -921,
+                -1104,  -1232,  -1299,  -1307,  -1258,  -1159,  -1016,   -839,   -633,   -408,   -170,     73,
+                  316 },
+    /* +55 */ {    241,    501,    752,    991,   1212,   1413,   1587,   1731,   1839,   1904,   1920,   1877,
+                 1765,   1576,   1300,    935,    489,    -13,   -535,  -1030,  -1459,  -1794,  -2026,  -2157,
+                -2198,  -2162,  -2063,  -1914,  -1730,  -1520,  -1296,  -1066,   -837,   -615,   -402,   -201,
+                  -12,    166,    334,    494,    646,    791,    928,   1054,   1168,   1266,   1343,   1395,
+                 1416,   1399,   1340,   1230,   1067,    848,    576,    262,    -78,   -421,   -741,  -1018,
+                -1234,  -1382,  -1460,  -1471,  -1422,  -1319,  -1171,   -985,   -771,   -534,   -282,    -22,
+                  241 },
+    /* +60 */ {    175,    452,    723,    983,   1227,   1450,   1648,   1815,   1944,   2027,   2055,   2016,
+                 1898,   1685,   1366,    936,    407,   -187,   -791,  -1347,  -1808,  -2151,  -2375,  -2490,
+                -2512,  -2457,  -2342,  -2180,  -1983,  -1761,  -1523,  -1276,  -1027,   -781,   -539,   -304,
+                  -78,    141,    352,    556,    753,    942,   1123,   1292,   1447,   1584,   1697,   1779,
+                 1825,   1826,   1773,   1658,   1473,   1213,    882,    493,     69,   -358,   -752,  -1086,
+                -1343,  -1515,  -1605,  -1620,  -1568,  -1460,  -1305,  -1112,   -888,   -641,   -377,   -103,
+                  175 },
+    /* +65 */ {    120,    409,    694,    970,   1232,   1475,   1692,   1879,   2026,   2125,   2164,   2127,
+                 1996,   1751,   1372,    853,    211,   -502,  -1205,  -1820,  -2301,  -2636,  -2834,  -2918,
+                -2909,  -2826,  -2686,  -2502,  -2285,  -2044,  -1787,  -1518,  -1244,   -969,   -693,   -421,
+                 -153,    111,    369,    621,    867,   1105,   1334,   1550,   1751,   1931,   2086,   2209,
+                 2292,   2324,   2296,   2194,   2006,   1722,   1340,    872,    348,   -184,   -676,  -1089,
+                -1400,  -1606,  -1714,  -1736,  -1685,  -1573,  -1412,  -1212,   -980,   -725,   -453,   -169,
+                  120 },
+    /* +70 */ {     80,    376,    670,    955,   1228,   1483,   1714,   1913,   2072,   2179,   2218,   2169,
+                 2008,   1703,   1226,    568,   -238,  -1098,  -1894,  -2536,  -2992,  -3276,  -3416,  -3443,
+                -3383,  -3256,  -3078,  -2862,  -2616,  -2347,  -2063,  -1767,  -1464,  -1156,   -845,   -535,
+                 -225,     82,    385,    684,    977,   1263,   1539,   1803,   2051,   2280,   2484,   2657,
+                 2791,   2875,   2897,   2841,   2688,   2421,   2025,   1502,    881,    220,   -405,   -933,
+                -1332,  -1597,  -1741,  -1783,  -1742,  -1634,  -1473,  -1271,  -1037,   -779,   -502,   -215,
+                   80 },
+    /* +75 */ {     68,    362,    654,    939,   1212,   1467,   1698,   1894,   2045,   2135,   2144,   2040,
+                 1787,   1338,    655,   -252,  -1282,  -2263,  -3051,  -3599,  -3930,  -4089,  -4119,  -4053,
+                -3916,  -3726,  -3495,  -3234,  -2948,  -2645,  -2328,  -2000,  -1664,  -1324,   -980,   -634,
+                 -288,     57,    400,    740,   1074,   1402,   1722,   2031,   2327,   2605,   2863,   3095,
+                 3293,   3449,   3551,   3582,   3524,   3350,   3034,   2552,   1906,   1140,    347,   -367,
+                 -931,  -1323,  -1558,  -1662,  -1662,  -1582,  -1440,  -1252,  -1028,   -777,   -507,   -223,
+                   68 },
+    /* +80 */ {    132,    399,    666,    925,   1170,   1392,   1580,   1722,   1797,   1777,   1621,   1273,
+                  663,   -260,  -1446,  -2684,  -3720,  -4442,  -4876,  -5087,  -5141,  -5083,  -4944,  -4747,
+                -4506,  -4232,  -3933,  -3615,  -3280,  -2934,  -2578,  -2215,  -1846,  -1473,  -1097,   -720,
+                 -342,     35,    411,    785,   1155,   1520,   1879,   2231,   2572,   2902,   3217,   3514,
+                 3788,   4033,   4242,   4404,   4504,   4524,   4437,   4210,   3806,   3199,   2401,   1496,
+                  621,   -103,   -624,   -951,  -1117,  -1160,  -1111,   -992,   -823,   -616,   -383,   -131,
+                  132 },
+    /* +85 */ {    996,    997,    996,    959,    846,    597,    114,   -744,  -2116,  -3900,  -5586,  -6767,
+                -7446,  -7775,  -7881,  -7843,  -7708,  -7507,  -7257,  -6973,  -6661,  -6329,  -5981,  -5620,
+                -5248,  -4867,  -4479,  -4086,  -3687,  -3285,  -2880,  -2472,  -2062,  -1650,  -1238,   -826,
+                 -413,     -1,    410,    819,   1227,   1632,   2034,   2432,   2826,   3215,   3598,   3973,
+                 4339,   4695,   5038,   5366,   5675,   5962,   6221,   6445,   6623,   6745,   6791,   6741,
+                 6565,   6231,   5712,   5007,   4170,   3311,   2546,   1946,   1521,   1249,   1092,   1018,
+                  996 },
+    /* +90 */ {  17323,  17827, -17669, -17165, -16661, -16156, -15652, -15148, -14644, -14141, -13637, -13134,
+               -12631, -12128, -11626, -11124, -10622, -10120,  -9619,  -9118,  -8618,  -8118,  -7618,  -7119,
+                -6620,  -6121,  -5623,  -5125,  -4627,  -4129,  -3632,  -3135,  -2638,  -2142,  -1645,  -1149,
+                 -653,   -157,    339,    835,   1331,   1827,   2323,   2820,   3316,   3812,   4309,   4806,
+                 5303,   5800,   6297,   6795,   7293,   7791,   8290,   8789,   9288,   9788,  10288,  10788,
+                11289,  11790,  12292,  12794,  13296,  13798,  14301,  14804,  15307,  15811,  16315,  16819,
+                17323 }
+};
+
+/**
+ * @brief inclination (0.01도)
+ */
+const int16_t ekf_wmm_inclination[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT] = {
+    /* -90 */ {  -7243,  -7243,  -7242,  -7242,  -7241,  -7241,  -7241,  -7240,  -7239,  -7239,  -7238,  -7238,
+                -7237,  -7236,  -7236,  -7235,  -7235,  -7234,  -7233,  -7233,  -7232,  -7232,  -7231,  -7231,
+                -7231,  -7230,  -7230,  -7230,  -7229,  -7229,  -7229,  -7229,  -7229,  -7229,  -7229,  -7230,
+                -7230,  -7230,  -7230,  -7231,  -7231,  -7232,  -7232,  -7233,  -7233,  -7234,  -7234,  -7235,
+                -7235,  -7236,  -7237,  -7237,  -7238,  -7239,  -7239,  -7240,  -7240,  -7241,  -7241,  -7242,
+                -7242,  -7242,  -7243,  -7243,  -7243,  -7243,  -7243,  -7243,  -7243,  -7243,  -7243,  -7243,
+                -7243 },
+    /* -85 */ {  -7552,  -7535,  -7516,  -7495,  -7472,  -7448,  -7421,  -7394,  -7366,  -7337,  -7307,  -7277,
+                -7247,  -7217,  -7187,  -7158,  -7130,  -7102,  -7076,  -7051,  -7027,  -7005,  -6984,  -6965,
+                -6948,  -6933,  -6919,  -6908,  -6899,  -6892,  -6887,  -6884,  -6884,  -6885,  -6890,  -6896,
+                -6905,  -6916,  -6929,  -6944,  -6962,  -6981,  -7003,  -7027,  -7052,  -7079,  -7107,  -7137,
+                -7168,  -7199,  -7231,  -7264,  -7296,  -7328,  -7360,  -7390,  -7420,  -7447,  -7474,  -7498,
+                -7520,  -7539,  -7556,  -7569,  -7580,  -7588,  -7592,  -7593,  -7591,  -7586,  -7577,  -7566,
+                -7552 },
+    /* -80 */ {  -7826,  -7786,  -7743,  -7695,  -7645,  -7593,  -7539,  -7483,  -7426,  -7369,  -7311,  -7253,
+                -7196,  -7139,  -7084,  -7030,  -6978,  -6928,  -6880,  -6835,  -6793,  -6754,  -6718,  -6686,
+                -6656,  -6631,  -6609,  -6590,  -6575,  -6563,  -6554,  -6549,  -6548,  -6550,  -6555,  -6564,
+                -6577,  -6594,  -6616,  -6641,  -6671,  -6705,  -6743,  -6786,  -6833,  -6883,  -6938,  -6995,
+                -7056,  -7119,  -7183,  -7249,  -7316,  -7383,  -7450,  -7515,  -7578,  -7639,  -7696,  -7749,
+                -7797,  -7839,  -7875,  -7904,  -7925,  -7938,  -7944,  -7942,  -7932,  -7915,  -7891,  -7861,
+                -7826 },
+    /* -75 */ {  -8020,  -7952,  -7880,  -7806,  -7730,  -7652,  -7573,  -7493,  -7413,  -7332,  -7250,  -7170,
+                -7090,  -7011,  -6933,  -6858,  -6786,  -6717,  -6653,  -6592,  -6536,  -6485,  -6440,  -6400,
+                -6365,  -6336,  -6311,  -6291,  -6275,  -6263,  -6254,  -6249,  -6247,  -6248,  -6253,  -6262,
+                -6276,  -6294,  -6318,  -6348,  -6385,  -6428,  -6478,  -6536,  -6600,  -6671,  -6749,  -6832,
+                -6921,  -7014,  -7111,  -7210,  -7311,  -7413,  -7515,  -7616,  -7714,  -7810,  -7901,  -7987,
+                -8065,  -8134,  -8192,  -8237,  -8268,  -8283,  -8281,  -8265,  -8235,  -8193,  -8142,  -8084,
+                -8020 },
+    /* -70 */ {  -8086,  -7993,  -7899,  -7806,  -7712,  -7617,  -7522,  -7426,  -7330,  -7233,  -7135,  -7037,
+                -6940,  -6843,  -6747,  -6655,  -6565,  -6480,  -6400,  -6327,  -6261,  -6203,  -6153,  -6111,
+                -6078,  -6052,  -6033,  -6019,  -6010,  -6005,  -6003,  -6002,  -6003,  -6005,  -6009,  -6016,
+                -6026,  -6041,  -6062,  -6090,  -6128,  -6175,  -6232,  -6300,  -6378,  -6467,  -6565,  -6672,
+                -6787,  -6908,  -7034,  -7164,  -7296,  -7430,  -7565,  -7698,  -7830,  -7959,  -8084,  -8203,
+                -8316,  -8418,  -8505,  -8570,  -8606,  -8606,  -8572,  -8514,  -8440,  -8357,  -8269,  -8178,
+                -8086 },
+    /* -65 */ {  -8003,  -7899,  -7797,  -7696,  -7595,  -7495,  -7394,  -7291,  -7188,  -7082,  -6975,  -6866,
+                -6756,  -6645,  -6535,  -6427,  -6321,  -6221,  -6128,  -6044,  -5970,  -5908,  -5858,  -5822,
+                -5797,  -5784,  -5781,  -5785,  -5795,  -5807,  -5820,  -5831,  -5840,  -5847,  -5851,  -5854,
+                -5857,  -5864,  -5877,  -5897,  -5929,  -5973,  -6031,  -6104,  -6192,  -6294,  -6409,  -6536,
+                -6674,  -6819,  -6970,  -7126,  -7285,  -7445,  -7606,  -7765,  -7922,  -8076,  -8227,  -8374,
+                -8518,  -8657,  -8789,  -8902,  -8901,  -8793,  -8675,  -8557,  -8441,  -8328,  -8217,  -8109,
+                -8003 },
+    /* -60 */ {  -7804,  -7701,  -7599,  -7499,  -7400,  -7300,  -7200,  -7099,  -6995,  -6887,  -6777,  -6662,
+                -6544,  -6423,  -6301,  -6179,  -6060,  -5946,  -5840,  -5746,  -5666,  -5602,  -5557,  -5532,
+                -5525,  -5535,  -5560,  -5595,  -5637,  -5680,  -5721,  -5756,  -5783,  -5800,  -5808,  -5808,
+                -5804,  -5798,  -5796,  -5802,  -5820,  -5853,  -5904,  -5975,  -6065,  -6174,  -6300,  -6442,
+                -6596,  -6760,  -6931,  -7106,  -7284,  -7461,  -7637,  -7809,  -7977,  -8139,  -8294,  -8440,
+                -8574,  -8686,  -8755,  -8751,  -8682,  -8582,  -8471,  -8357,  -8243,  -8130,  -8019,  -7910,
+                -7804 },
+    /* -55 */ {  -7534,  -7434,  -7335,  -7239,  -7143,  -7048,  -6952,  -6855,  -6754,  -6649,  -6539,  -6423,
+                -6302,  -6175,  -6044,  -5911,  -5779,  -5651,  -5533,  -5430,  -5345,  -5283,  -5247,  -5239,
+                -5258,  -5303,  -5368,  -5448,  -5537,  -5626,  -5710,  -5782,  -5839,  -5877,  -5896,  -5899,
+                -5889,  -5870,  -5850,  -5834,  -5829,  -5841,  -5874,  -5931,  -6014,  -6120,  -6249,  -6396,
+                -6559,  -6733,  -6915,  -7101,  -7287,  -7470,  -7648,  -7817,  -7974,  -8118,  -8242,  -8343,
+                -8414,  -8447,  -8442,  -8402,  -8336,  -8252,  -8157,  -8056,  -7952,  -7846,  -7741,  -7636,
+                -7534 },
+    /* -50 */ {  -7216,  -7118,  -7022,  -6928,  -6836,  -6745,  -6653,  -6560,  -6464,  -6364,  -6258,  -6144,
+                -6023,  -5893,  -5756,  -5614,  -5471,  -5332,  -5202,  -5089,  -5000,  -4941,  -4918,  -4933,
+                -4986,  -5075,  -5193,  -5331,  -5479,  -5628,  -5767,  -5889,  -5987,  -6058,  -6100,  -6114,
+                -6105,  -6078,  -6039,  -5998,  -5964,  -5945,  -5949,  -5981,  -6042,  -6134,  -6253,  -6395,
+                -6556,  -6730,  -6912,  -7096,  -7278,  -7453,  -7616,  -7762,  -7888,  -7990,  -8064,  -8109,
+                -8126,  -8117,  -8086,  -8036,  -7971,  -7894,  -7808,  -7716,  -7619,  -7519,  -7417,  -7316,
+                -7216 },
+    /* -45 */ {  -6858,  -6760,  -6664,  -6571,  -6479,  -6390,  -6301,  -6212,  -6120,  -6025,  -5923,  -5813,
+                -5694,  -5564,  -5424,  -5276,  -5124,  -4974,  -4833,  -4711,  -4618,  -4564,  -4556,  -4599,
+                -4693,  -4833,  -5010,  -5213,  -5429,  -5643,  -5844,  -6022,  -6169,  -6282,  -6356,  -6393,
+                -6397,  -6370,  -6321,  -6259,  -6195,  -6141,  -6107,  -6102,  -6131,  -6195,  -6291,  -6416,
+                -6563,  -6725,  -6895,  -7066,  -7230,  -7382,  -7514,  -7622,  -7704,  -7757,  -7784,  -7788,
+                -7773,  -7743,  -7700,  -7647,  -7584,  -7513,  -7433,  -7346,  -7254,  -7157,  -7058,  -6958,
+                -6858 },
+    /* -40 */ {  -6456,  -6356,  -6258,  -6162,  -6070,  -5979,  -5890,  -5802,  -5712,  -5620,  -5523,  -5418,
+                -5302,  -5174,  -5033,  -4880,  -4720,  -4560,  -4408,  -4278,  -4181,  -4132,  -4141,  -4215,
+                -4353,  -4549,  -4791,  -5061,  -5343,  -5621,  -5881,  -6113,  -6309,  -6463,  -6574,  -6641,
+                -6665,  -6651,  -6604,  -6532,  -6447,  -6362,  -6290,  -6245,  -6233,  -6260,  -6324,  -6421,
+                -6543,  -6682,  -6829,  -6974,  -7110,  -7227,  -7320,  -7385,  -7422,  -7434,  -7425,  -7402,
+                -7368,  -7327,  -7280,  -7227,  -7168,  -7101,  -7027,  -6944,  -6854,  -6759,  -6659,  -6558,
+                -6456 },
+    /* -35 */ {  -6003,  -5898,  -5795,  -5695,  -5598,  -5504,  -5412,  -5321,  -5231,  -5140,  -5045,  -4943,
+                -4830,  -4703,  -4562,  -4406,  -4239,  -4069,  -3907,  -3767,  -3668,  -3625,  -3653,  -3760,
+                -3945,  -4199,  -4505,  -4840,  -5185,  -5520,  -5831,  -6108,  -6343,  -6534,  -6676,  -6771,
+                -6819,  -6823,  -6787,  -6717,  -6622,  -6517,  -6416,  -6333,  -6282,  -6268,  -6294,  -6356,
+                -6446,  -6555,  -6672,  -6787,  -6888,  -6968,  -7021,  -7048,  -7049,  -7030,  -6997,  -6956,
+                -6912,  -6866,  -6818,  -6768,  -6714,  -6652,  -6581,  -6501,  -6412,  -6315,  -6214,  -6109,
+                -6003 },
+    /* -30 */ {  -5486,  -5375,  -5265,  -5158,  -5054,  -4953,  -4856,  -4760,  -4667,  -4573,  -4477,  -4376,
+                -4264,  -4138,  -3996,  -3836,  -3662,  -3483,  -3310,  -3162,  -3060,  -3024,  -3073,  -3216,
+                -3451,  -3764,  -4132,  -4530,  -4931,  -5315,  -5667,  -5979,  -6243,  -6458,  -6623,  -6738,
+                -6804,  -6823,  -6797,  -6733,  -6637,  -6520,  -6398,  -6287,  -6201,  -6151,  -6141,  -6169,
+                -6227,  -6306,  -6394,  -6477,  -6547,  -6595,  -6617,  -6614,  -6589,  -6549,  -6500,  -6449,
+                -6399,  -6352,  -6306,  -6261,  -6211,  -6154,  -6086,  -6007,  -5916,  -5816,  -5710,  -5599,
+                -5486 },
+    /* -25 */ {  -4894,  -4773,  -4654,  -4539,  -4427,  -4318,  -4212,  -4109,  -4009,  -3910,  -3810,  -3706,
+                -3593,  -3466,  -3321,  -3157,  -2976,  -2787,  -2606,  -2452,  -2350,  -2324,  -2397,  -2577,
+                -2862,  -3233,  -3663,  -4118,  -4570,  -4995,  -5381,  -5716,  -5999,  -6228,  -6403,  -6527,
+                -6602,  -6627,  -6606,  -6543,  -6443,  -6318,  -6182,  -6049,  -5938,  -5860,  -5821,  -5822,
+                -5855,  -5910,  -5975,  -6035,  -6082,  -6106,  -6106,  -6083,  -6040,  -5986,  -5927,  -5870,
+                -5819,  -5774,  -5733,  -5694,  -5650,  -5597,  -5531,  -5451,  -5356,  -5250,  -5135,  -5015,
+                -4894 },
+    /* -20 */ {  -4213,  -4081,  -3953,  -3828,  -3706,  -3588,  -3473,  -3360,  -3251,  -3145,  -3039,  -2930,
+                -2813,  -2683,  -2534,  -2364,  -2178,  -1983,  -1796,  -1640,  -1543,  -1532,  -1630,  -1848,
+                -2181,  -2607,  -3092,  -3599,  -4095,  -4556,  -4966,  -5317,  -5609,  -5841,  -6018,  -6142,
+                -6215,  -6239,  -6215,  -6146,  -6038,  -5902,  -5751,  -5602,  -5472,  -5374,  -5316,  -5299,
+                -5317,  -5358,  -5409,  -5456,  -5489,  -5500,  -5486,  -5450,  -5396,  -5334,  -5270,  -5211,
+                -5161,  -5121,  -5088,  -5055,  -5018,  -4969,  -4904,  -4821,  -4720,  -4605,  -4479,  -4347,
+                -4213 },
+    /* -15 */ {  -3437,  -3292,  -3152,  -3018,  -2887,  -2760,  -2636,  -2515,  -2397,  -2282,  -2168,  -2053,
+                -1931,  -1796,  -1643,  -1470,  -1280,  -1083,   -898,   -747,   -661,   -669,   -794,  -1047,
+                -1421,  -1892,  -2423,  -2972,  -3504,  -3991,  -4418,  -4778,  -5071,  -5301,  -5472,  -5589,
+                -5655,  -5671,  -5638,  -5558,  -5439,  -5289,  -5122,  -4956,  -4810,  -4697,  -4627,  -4601,
+                -4612,  -4648,  -4695,  -4738,  -4765,  -4770,  -4749,  -4706,  -4647,  -4580,  -4515,  -4458,
+                -4413,  -4381,  -4357,  -4334,  -4305,  -4260,  -4196,  -4108,  -3999,  -3871,  -3731,  -3584,
+                -3437 },
+    /* -10 */ {  -2563,  -2406,  -2256,  -2113,  -1975,  -1842,  -1711,  -1583,  -1458,  -1336,  -1216,  -1095,
+                 -968,   -829,   -674,   -501,   -314,   -123,     53,    190,    258,    228,     79,   -200,
+                 -602,  -1102,  -1663,  -2240,  -2795,  -3299,  -3735,  -4096,  -4384,  -4606,  -4767,  -4874,
+                -4929,  -4933,  -4889,  -4797,  -4663,  -4497,  -4314,  -4131,  -3970,  -3845,  -3767,  -3736,
+                -3746,  -3784,  -3832,  -3877,  -3905,  -3909,  -3887,  -3841,  -3780,  -3713,  -3650,  -3599,
+                -3563,  -3542,  -3531,  -3520,  -3501,  -3462,  -3398,  -3305,  -3185,  -3044,  -2888,  -2725,
+                -2563 },
+    /*  -5 */ {  -1605,  -1437,  -1279,  -1131,   -991,   -855,   -723,   -592,   -464,   -339,   -215,    -91,
+                   39,    177,    330,    498,    676,    853,   1012,   1128,   1174,   1123,    955,    661,
+                  248,   -261,   -830,  -1415,  -1976,  -2482,  -2916,  -3271,  -3549,  -3758,  -3906,  -4000,
+                -4042,  -4034,  -3977,  -3872,  -3725,  -3544,  -3345,  -3148,  -2973,  -2838,  -2754,  -2721,
+                -2732,  -2773,  -2827,  -2876,  -2908,  -2915,  -2894,  -2850,  -2791,  -2728,  -2671,  -2629,
+                -2606,  -2600,  -2605,  -2609,  -2602,  -2571,  -2508,  -2412,  -2283,  -2128,  -1958,  -1780,
+                -1605 },
+    /*  +0 */ {   -590,   -417,   -256,   -109,     29,    161,    290,    417,    542,    666,    789,    913,
+                 1040,   1176,   1322,   1480,   1642,   1800,   1936,   2028,   2051,   1982,   1803,   1507,
+                 1100,    604,     52,   -517,  -1062,  -1554,  -1972,  -2311,  -2573,  -2765,  -2897,  -2975,
+                -3003,  -2983,  -2914,  -2798,  -2640,  -2449,  -2241,  -2035,  -1852,  -1710,  -1621,  -1586,
+                -1598,  -1641,  -1698,  -1752,  -1788,  -1798,  -1781,  -1742,  -1688,  -1632,  -1586,  -1557,
+                -1550,  -1563,  -1586,  -1608,  -1616,  -1595,  -1538,  -1441,  -1307,  -1143,   -962,   -774,
+                 -590 },
+    /*  +5 */ {    436,    608,    764,    906,   1036,   1159,   1279,   1398,   1516,   1634,   1752,   1871,
+                 1994,   2123,   2260,   2404,   2549,   2684,   2796,   2863,   2865,   2782,   2600,   2314,
+                 1929,   1465,    951,    422,    -85,   -543,   -931,  -1242,  -1479,  -1649,  -1760,  -1821,
+                -1834,  -1802,  -1725,  -1603,  -1441,  -1248,  -1040,   -834,   -652,   -510,   -420,   -383,
+                 -393,   -434,   -490,   -544,   -581,   -594,   -582,   -549,   -504,   -460,   -428,   -416,
+                 -427,   -459,   -502,   -543,   -567,   -560,   -512,   -420,   -287,   -123,     61,    251,
+                  436 },
+    /* +10 */ {   1423,   1586,   1733,   1865,   1984,   2095,   2203,   2310,   2418,   2528,   2639,   2752,
+                 2869,   2990,   3117,   3246,   3373,   3487,   3575,   3621,   3606,   3514,   3336,   3067,
+                 2716,   2298,   1838,   1367,    915,    509,    167,   -106,   -310,   -452,   -540,   -582,
+                 -581,   -540,   -458,   -337,   -180,      3,    200,    393,    564,    698,    785,    823,
+                  818,    783,    734,    686,    651,    638,    646,    671,    704,    734,    749,    744,
+                  714,    664,    603,    545,    504,    496,    530,    610,    732,    888,   1064,   1246,
+                 1423 },
+    /* +15 */ {   2329,   2479,   2612,   2731,   2838,   2937,   3034,   3131,   3229,   3330,   3434,   3542,
+                 3652,   3766,   3883,   3999,   4109,   4205,   4273,   4301,   4273,   4178,   4008,   3762,
+                 3449,   3083,   2686,   2282,   1897,   1554,   1265,   1039,    874,    763,    699,    676,
+                  689,    736,    817,    931,   1073,   1237,   1412,   1582,   1733,   1853,   1932,   1970,
+                 1971,   1946,   1907,   1869,   1841,   1829,   1834,   1851,   1872,   1886,   1886,   1863,
+                 1818,   1753,   1677,   1605,   1550,   1526,   1543,   1604,   1708,   1845,   2003,   2168,
+                 2329 },
+    /* +20 */ {   3132,   3263,   3382,   3488,   3584,   3674,   3762,   3851,   3942,   4037,   4136,   4239,
+                 4345,   4453,   4561,   4667,   4763,   4843,   4896,   4909,   4872,   4777,   4618,   4398,
+                 4125,   3812,   3478,   3143,   2827,   2547,   2316,   2138,   2011,   1931,   1890,   1883,
+                 1906,   1955,   2031,   2132,   2255,   2393,   2539,   2681,   2808,   2909,   2979,   3015,
+                 3021,   3007,   2981,   2954,   2934,   2926,   2929,   2938,   2948,   2949,   2934,   2897,
+                 2839,   2763,   2677,   2594,   2527,   2488,   2486,   2526,   2605,   2716,   2849,   2991,
+                 3132 },
+    /* +25 */ {   3826,   3938,   4042,   4137,   4225,   4309,   4391,   4476,   4564,   4656,   4753,   4853,
+                 4956,   5059,   5162,   5259,   5344,   5412,   5451,   5454,   5412,   5318,   5173,   4979,
+                 4744,   4481,   4206,   3934,   3681,   3461,   3282,   3148,   3056,   3003,   2981,   2987,
+                 3016,   3065,   3133,   3219,   3320,   3432,   3549,   3663,   3764,   3846,   3905,   3938,
+                 3950,   3945,   3931,   3916,   3905,   3901,   3903,   3907,   3907,   3896,   3869,   3822,
+                 3755,   3671,   3578,   3488,   3411,   3358,   3338,   3354,   3406,   3489,   3593,   3708,
+                 3826 },
+    /* +30 */ {   4422,   4516,   4606,   4692,   4774,   4855,   4936,   5019,   5107,   5199,   5296,   5395,
+                 5497,   5598,   5696,   5786,   5864,   5921,   5951,   5946,   5900,   5811,   5678,   5508,
+                 5309,   5090,   4866,   4650,   4452,   4283,   4148,   4050,   3986,   3954,   3947,   3961,
+                 3993,   4039,   4098,   4170,   4251,   4339,   4430,   4517,   4596,   4661,   4709,   4740,
+                 4755,   4759,   4756,   4752,   4749,   4750,   4752,   4752,   4745,   4726,   4690,   4635,
+                 4561,   4472,   4375,   4279,   4194,   4130,   4092,   4087,   4112,   4165,   4240,   4328,
+                 4422 },
+    /* +35 */ {   4941,   5017,   5095,   5173,   5251,   5330,   5412,   5497,   5587,   5681,   5779,   5880,
+                 5981,   6081,   6176,   6261,   6331,   6380,   6402,   6391,   6344,   6259,   6140,   5992,
+                 5823,   5643,   5462,   5291,   5137,   5009,   4909,   4839,   4797,   4779,   4782,   4801,
+                 4833,   4875,   4926,   4984,   5048,   5115,   5184,   5250,   5310,   5361,   5401,   5430,
+                 5449,   5460,   5467,   5472,   5477,   5483,   5486,   5485,   5474,   5448,   5406,   5345,
+                 5266,   5174,   5074,   4975,   4884,   4809,   4757,   4732,   4733,   4760,   4807,   4869,
+                 4941 },
+    /* +40 */ {   5405,   5465,   5532,   5602,   5677,   5755,   5838,   5925,   6017,   6114,   6214,   6316,
+                 6418,   6517,   6609,   6690,   6754,   6797,   6812,   6797,   6749,   6670,   6562,   6433,
+                 6290,   6142,   5996,   5860,   5742,   5644,   5570,   5521,   5493,   5485,   5493,   5514,
+                 5543,   5580,   5623,   5669,   5719,   5770,   5822,   5871,   5917,   5958,   5992,   6020,
+                 6043,   6061,   6077,   6091,   6104,   6115,   6121,   6119,   6106,   6077,   6031,   5966,
+                 5885,   5791,   5689,   5588,   5493,   5410,   5347,   5305,   5286,   5290,   5313,   5353,
+                 5405 },
+    /* +45 */ {   5834,   5881,   5937,   6000,   6070,   6147,   6230,   6319,   6412,   6511,   6612,   6715,
+                 6816,   6914,   7003,   7080,   7139,   7176,   7186,   7167,   7119,   7044,   6947,   6835,
+                 6713,   6590,   6471,   6363,   6270,   6195,   6140,   6103,   6085,   6082,   6091,   6110,
+                 6136,   6167,   6201,   6238,   6276,   6315,   6354,   6392,   6429,   6463,   6494,   6523,
+                 6550,   6575,   6600,   6622,   6643,   6660,   6670,   6670,   6656,   6626,   6578,   6511,
+                 6429,   6335,   6234,   6132,   6035,   5948,   5876,   5822,   5788,   5774,   5779,   5800,
+                 5834 },
+    /* +50 */ {   6246,   6280,   6326,   6382,   6447,   6520,   6601,   6689,   6782,   6879,   6980,   7081,
+                 7181,   7276,   7362,   7434,   7489,   7520,   7525,   7503,   7455,   7384,   7296,   7197,
+                 7092,   6989,   6891,   6803,   6728,   6669,   6625,   6596,   6582,   6580,   6588,   6603,
+                 6624,   6648,   6675,   6704,   6733,   6763,   6794,   6825,   6856,   6886,   6918,   6949,
+                 6981,   7013,   7046,   7077,   7106,   7129,   7144,   7147,   7135,   7106,   7058,   6992,
+                 6911,   6819,   6720,   6619,   6523,   6435,   6359,   6298,   6254,   6227,   6218,   6225,
+                 6246 },
+    /* +55 */ {   6649,   6674,   6711,   6759,   6817,   6884,   6960,   7043,   7133,   7226,   7323,   7421,
+                 7517,   7607,   7688,   7756,   7804,   7830,   7830,   7805,   7756,   7689,   7608,   7519,
+                 7428,   7339,   7257,   7183,   7121,   7071,   7034,   7009,   6995,   6991,   6994,   7005,
+                 7019,   7037,   7058,   7080,   7103,   7127,   7153,   7180,   7208,   7239,   7272,   7307,
+                 7344,   7383,   7424,   7463,   7499,   7530,   7551,   7559,   7550,   7524,   7478,   7416,
+                 7338,   7250,   7156,   7060,   6968,   6882,   6806,   6743,   6694,   6660,   6642,   6638,
+                 6649 },
+    /* +60 */ {   7049,   7066,   7094,   7134,   7184,   7244,   7312,   7388,   7470,   7556,   7646,   7737,
+                 7826,   7909,   7983,   8044,   8086,   8105,   8099,   8070,   8021,   7956,   7881,   7801,
+                 7720,   7643,   7571,   7508,   7453,   7409,   7375,   7350,   7334,   7327,   7326,   7330,
+                 7339,   7350,   7365,   7382,   7401,   7422,   7445,   7470,   7499,   7531,   7566,   7605,
+                 7648,   7693,   7740,   7786,   7830,   7867,   7895,   7909,   7906,   7885,   7845,   7788,
+                 7717,   7636,   7549,   7462,   7376,   7296,   7225,   7163,   7114,   7078,   7055,   7045,
+                 7049 },
+    /* +65 */ {   7446,   7456,   7477,   7509,   7550,   7600,   7659,   7724,   7795,   7871,   7951,   8030,
+                 8109,   8182,   8247,   8298,   8331,   8342,   8329,   8296,   8245,   8182,   8113,   8041,
+                 7969,   7901,   7839,   7782,   7733,   7692,   7659,   7634,   7616,   7604,   7598,   7597,
+                 7600,   7607,   7617,   7630,   7646,   7665,   7687,   7713,   7742,   7775,   7813,   7855,
+                 7900,   7949,   8000,   8051,   8100,   8144,   8178,   8200,   8205,   8192,   8160,   8111,
+                 8050,   7979,   7904,   7827,   7752,   7682,   7618,   7563,   7517,   7482,   7459,   7446,
+                 7446 },
+    /* +70 */ {   7835,   7841,   7856,   7880,   7912,   7952,   7999,   8052,   8110,   8172,   8237,   8303,
+                 8368,   8428,   8479,   8518,   8538,   8538,   8517,   8478,   8427,   8368,   8305,   8241,
+                 8179,   8120,   8065,   8015,   7971,   7934,   7902,   7876,   7856,   7842,   7832,   7827,
+                 7826,   7830,   7836,   7847,   7861,   7878,   7899,   7924,   7953,   7987,   8024,   8066,
+                 8111,   8160,   8211,   8263,   8314,   8362,   8402,   8431,   8446,   8444,   8424,   8388,
+                 8340,   8284,   8223,   8160,   8099,   8041,   7988,   7942,   7903,   7872,   7851,   7838,
+                 7835 },
+    /* +75 */ {   8213,   8216,   8226,   8243,   8266,   8295,   8329,   8368,   8411,   8458,   8506,   8555,
+                 8602,   8645,   8679,   8699,   8703,   8688,   8657,   8615,   8566,   8514,   8460,   8406,
+                 8355,   8306,   8260,   8218,   8181,   8148,   8120,   8096,   8076,   8061,   8050,   8043,
+                 8040,   8041,   8046,   8054,   8066,   8081,   8101,   8123,   8150,   8181,   8215,   8252,
+                 8293,   8337,   8384,   8431,   8479,   8525,   8568,   8603,   8628,   8640,   8636,   8618,
+                 8588,   8549,   8506,   8460,   8415,   8372,   8333,   8298,   8268,   8245,   8227,   8217,
+                 8213 },
+    /* +80 */ {   8573,   8575,   8581,   8591,   8605,   8623,   8645,   8670,   8697,   8726,   8756,   8784,
+                 8809,   8828,   8835,   8829,   8810,   8781,   8746,   8708,   8667,   8626,   8585,   8545,
+                 8507,   8471,   8437,   8406,   8378,   8352,   8330,   8310,   8294,   8282,   8272,   8266,
+                 8262,   8262,   8265,   8271,   8280,   8293,   8308,   8326,   8347,   8371,   8398,   8427,
+                 8459,   8493,   8529,   8566,   8604,   8643,   8680,   8715,   8746,   8770,   8786,   8792,
+                 8786,   8772,   8751,   8726,   8700,   8675,   8650,   8629,   8610,   8595,   8583,   8576,
+                 8573 },
+    /* +85 */ {   8908,   8910,   8913,   8918,   8924,   8932,   8940,   8948,   8953,   8954,   8947,   8935,
+                 8918,   8899,   8878,   8856,   8832,   8809,   8785,   8761,   8737,   8713,   8691,   8669,
+                 8647,   8627,   8609,   8591,   8575,   8560,   8547,   8536,   8527,   8519,   8513,   8509,
+                 8507,   8507,   8508,   8512,   8517,   8524,   8533,   8543,   8556,   8570,   8585,   8602,
+                 8620,   8639,   8659,   8681,   8702,   8725,   8748,   8770,   8793,   8815,   8837,   8857,
+                 8875,   8892,   8905,   8915,   8921,   8923,   8923,   8920,   8916,   8913,   8910,   8908,
+                 8908 },
+    /* +90 */ {   8788,   8788,   8788,   8787,   8787,   8787,   8787,   8787,   8786,   8786,   8786,   8785,
+                 8785,   8785,   8784,   8784,   8783,   8783,   8782,   8782,   8781,   8781,   8780,   8780,
+                 8779,   8779,   8778,   8778,   8778,   8777,   8777,   8777,   8776,   8776,   8776,   8776,
+                 8776,   8776,   8776,   8776,   8776,   8776,   8777,   8777,   8777,   8777,   8778,   8778,
+                 8779,   8779,   8779,   8780,   8780,   8781,   8781,   8782,   8782,   8783,   8783,   8784,
+                 8784,   8785,   8785,   8786,   8786,   8786,   8787,   8787,   8787,   8787,   8787,   8788,
+                 8788 }
+};
+
+/**
+ * @brief intensity (10 nT)
+ */
+const int16_t ekf_wmm_intensity[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT] = {
+    /* -90 */ {   5527,   5527,   5526,   5526,   5525,   5525,   5524,   5524,   5523,   5523,   5522,   5521,
+                 5521,   5520,   5519,   5519,   5518,   5517,   5517,   5516,   5516,   5515,   5515,   5514,
+                 5514,   5513,   5513,   5513,   5513,   5512,   5512,   5512,   5512,   5512,   5513,   5513,
+                 5513,   5513,   5514,   5514,   5514,   5515,   5515,   5516,   5517,   5517,   5518,   5518,
+                 5519,   5520,   5520,   5521,   5522,   5522,   5523,   5524,   5524,   5525,   5525,   5526,
+                 5526,   5526,   5527,   5527,   5527,   5527,   5528,   5528,   5528,   5527,   5527,   5527,
+                 5527 },
+    /* -85 */ {   5833,   5817,   5800,   5780,   5757,   5734,   5708,   5681,   5653,   5623,   5593,   5562,
+                 5531,   5499,   5467,   5436,   5404,   5374,   5344,   5316,   5288,   5262,   5238,   5215,
+                 5194,   5176,   5160,   5146,   5134,   5126,   5120,   5116,   5116,   5118,   5123,   5131,
+                 5142,   5156,   5172,   5191,   5213,   5237,   5262,   5290,   5320,   5351,   5383,   5417,
+                 5451,   5485,   5520,   5554,   5588,   5620,   5652,   5683,   5712,   5739,   5764,   5786,
+                 5807,   5824,   5839,   5852,   5861,   5867,   5871,   5872,   5869,   5864,   5856,   5846,
+                 5833 },
+    /* -80 */ {   6069,   6037,   6001,   5961,   5918,   5871,   5821,   5769,   5715,   5659,   5601,   5542,
+                 5482,   5422,   5361,   5301,   5242,   5184,   5127,   5072,   5020,   4970,   4923,   4879,
+                 4839,   4802,   4770,   4742,   4719,   4700,   4687,   4678,   4675,   4677,   4685,   4698,
+                 4717,   4742,   4772,   4808,   4849,   4896,   4947,   5002,   5062,   5125,   5191,   5259,
+                 5329,   5400,   5471,   5542,   5611,   5679,   5744,   5805,   5863,   5917,   5966,   6010,
+                 6049,   6082,   6110,   6131,   6147,   6156,   6160,   6158,   6151,   6138,   6120,   6097,
+                 6069 },
+    /* -75 */ {   6222,   6174,   6120,   6061,   5998,   5931,   5860,   5786,   5709,   5629,   5548,   5464,
+                 5380,   5294,   5209,   5123,   5039,   4956,   4876,   4797,   4723,   4651,   4584,   4522,
+                 4464,   4412,   4366,   4325,   4290,   4262,   4241,   4226,   4219,   4219,   4226,   4242,
+                 4266,   4299,   4340,   4390,   4448,   4515,   4590,   4672,   4761,   4856,   4956,   5061,
+                 5168,   5276,   5385,   5493,   5599,   5702,   5800,   5892,   5978,   6057,   6128,   6190,
+                 6244,   6289,   6325,   6352,   6370,   6378,   6379,   6371,   6355,   6332,   6302,   6265,
+                 6222 },
+    /* -70 */ {   6293,   6229,   6159,   6083,   6003,   5919,   5830,   5738,   5642,   5543,   5441,   5338,
+                 5232,   5125,   5018,   4911,   4805,   4701,   4599,   4501,   4407,   4318,   4234,   4156,
+                 4085,   4020,   3962,   3912,   3868,   3832,   3803,   3783,   3770,   3766,   3772,   3787,
+                 3813,   3850,   3899,   3959,   4032,   4116,   4212,   4320,   4437,   4564,   4698,   4839,
+                 4983,   5129,   5276,   5421,   5563,   5699,   5828,   5949,   6060,   6160,   6249,   6326,
+                 6391,   6443,   6483,   6511,   6527,   6531,   6524,   6508,   6481,   6446,   6402,   6351,
+                 6293 },
+    /* -65 */ {   6286,   6208,   6123,   6034,   5940,   5842,   5739,   5633,   5523,   5409,   5293,   5173,
+                 5051,   4927,   4802,   4676,   4552,   4430,   4310,   4195,   4086,   3982,   3885,   3796,
+                 3715,   3642,   3577,   3519,   3470,   3429,   3395,   3370,   3353,   3345,   3346,   3359,
+                 3383,   3421,   3473,   3540,   3624,   3723,   3838,   3969,   4113,   4270,   4437,   4613,
+                 4793,   4977,   5160,   5340,   5515,   5681,   5838,   5983,   6114,   6231,   6333,   6419,
+                 6490,   6544,   6583,   6608,   6618,   6614,   6598,   6570,   6531,   6482,   6424,   6359,
+                 6286 },
+    /* -60 */ {   6211,   6120,   6024,   5923,   5818,   5710,   5598,   5482,   5362,   5239,   5112,   4981,
+                 4846,   4710,   4571,   4431,   4292,   4155,   4022,   3893,   3771,   3657,   3551,   3455,
+                 3368,   3291,   3224,   3165,   3115,   3073,   3037,   3009,   2989,   2976,   2973,   2981,
+                 3002,   3037,   3089,   3160,   3250,   3361,   3492,   3643,   3812,   3997,   4195,   4403,
+                 4618,   4835,   5050,   5261,   5464,   5656,   5835,   5997,   6143,   6270,   6379,   6468,
+                 6539,   6591,   6626,   6643,   6645,   6631,   6603,   6562,   6510,   6447,   6376,   6297,
+                 6211 },
+    /* -55 */ {   6079,   5977,   5871,   5761,   5649,   5534,   5416,   5295,   5170,   5041,   4908,   4771,
+                 4629,   4484,   4336,   4186,   4036,   3888,   3744,   3606,   3475,   3354,   3243,   3144,
+                 3057,   2982,   2918,   2864,   2818,   2779,   2747,   2720,   2699,   2684,   2677,   2679,
+                 2694,   2724,   2773,   2843,   2936,   3055,   3198,   3366,   3555,   3764,   3989,   4226,
+                 4469,   4715,   4958,   5194,   5419,   5629,   5821,   5994,   6146,   6277,   6386,   6473,
+                 6539,   6585,   6611,   6619,   6610,   6585,   6545,   6492,   6427,   6351,   6267,   6176,
+                 6079 },
+    /* -50 */ {   5899,   5789,   5676,   5560,   5443,   5324,   5204,   5080,   4954,   4824,   4689,   4550,
+                 4406,   4257,   4104,   3949,   3793,   3638,   3487,   3343,   3207,   3083,   2971,   2874,
+                 2791,   2723,   2668,   2624,   2589,   2561,   2537,   2516,   2498,   2484,   2474,   2472,
+                 2480,   2504,   2547,   2613,   2705,   2826,   2976,   3154,   3359,   3586,   3832,   4091,
+                 4357,   4624,   4887,   5139,   5378,   5598,   5796,   5971,   6122,   6249,   6351,   6431,
+                 6488,   6524,   6540,   6538,   6518,   6482,   6431,   6366,   6289,   6203,   6108,   6006,
+                 5899 },
+    /* -45 */ {   5683,   5566,   5448,   5329,   5209,   5089,   4968,   4846,   4721,   4593,   4461,   4324,
+                 4181,   4033,   3881,   3725,   3567,   3410,   3257,   3110,   2973,   2850,   2742,   2650,
+                 2577,   2520,   2479,   2451,   2433,   2420,   2410,   2402,   2392,   2382,   2374,   2370,
+                 2374,   2391,   2426,   2485,   2571,   2689,   2839,   3020,   3232,   3469,   3727,   3999,
+                 4279,   4559,   4833,   5094,   5338,   5558,   5754,   5924,   6066,   6182,   6272,   6339,
+                 6384,   6409,   6414,   6401,   6371,   6326,   6265,   6191,   6106,   6010,   5907,   5797,
+                 5683 },
+    /* -40 */ {   5437,   5317,   5195,   5075,   4955,   4835,   4716,   4597,   4476,   4353,   4227,   4095,
+                 3959,   3816,   3669,   3517,   3362,   3207,   3056,   2912,   2778,   2659,   2558,   2476,
+                 2415,   2374,   2351,   2343,   2345,   2352,   2361,   2368,   2372,   2372,   2369,   2367,
+                 2370,   2382,   2411,   2460,   2537,   2645,   2786,   2963,   3171,   3409,   3669,   3945,
+                 4229,   4513,   4789,   5050,   5289,   5503,   5688,   5844,   5971,   6071,   6145,   6197,
+                 6228,   6240,   6234,   6212,   6175,   6122,   6054,   5974,   5882,   5780,   5671,   5556,
+                 5437 },
+    /* -35 */ {   5168,   5047,   4925,   4805,   4687,   4570,   4455,   4341,   4226,   4110,   3992,   3869,
+                 3742,   3609,   3470,   3327,   3180,   3033,   2888,   2751,   2624,   2513,   2421,   2351,
+                 2304,   2280,   2276,   2289,   2313,   2343,   2372,   2398,   2418,   2431,   2438,   2443,
+                 2448,   2459,   2482,   2522,   2586,   2680,   2807,   2969,   3165,   3392,   3645,   3915,
+                 4194,   4472,   4741,   4993,   5221,   5421,   5590,   5727,   5835,   5915,   5970,   6004,
+                 6020,   6020,   6005,   5976,   5932,   5875,   5804,   5720,   5624,   5519,   5407,   5289,
+                 5168 },
+    /* -30 */ {   4883,   4762,   4643,   4526,   4412,   4300,   4190,   4083,   3976,   3870,   3762,   3651,
+                 3536,   3415,   3290,   3159,   3024,   2889,   2755,   2628,   2512,   2411,   2330,   2272,
+                 2239,   2231,   2246,   2278,   2323,   2373,   2422,   2466,   2503,   2531,   2550,   2564,
+                 2576,   2589,   2609,   2641,   2693,   2770,   2877,   3018,   3194,   3402,   3638,   3892,
+                 4157,   4422,   4677,   4914,   5125,   5305,   5453,   5569,   5654,   5712,   5748,   5766,
+                 5768,   5756,   5733,   5698,   5651,   5591,   5519,   5434,   5338,   5232,   5120,   5002,
+                 4883 },
+    /* -25 */ {   4587,   4472,   4358,   4246,   4138,   4033,   3931,   3832,   3736,   3640,   3544,   3447,
+                 3346,   3242,   3132,   3017,   2899,   2779,   2661,   2548,   2445,   2356,   2286,   2238,
+                 2217,   2221,   2249,   2296,   2357,   2423,   2490,   2550,   2603,   2645,   2678,   2702,
+                 2722,   2739,   2758,   2785,   2825,   2884,   2970,   3086,   3237,   3420,   3631,   3863,
+                 4107,   4352,   4587,   4803,   4993,   5151,   5277,   5369,   5432,   5470,   5487,   5489,
+                 5478,   5458,   5428,   5390,   5341,   5281,   5209,   5125,   5031,   4927,   4817,   4703,
+                 4587 },
+    /* -20 */ {   4292,   4184,   4078,   3975,   3876,   3780,   3689,   3601,   3516,   3433,   3351,   3269,
+                 3185,   3098,   3006,   2911,   2811,   2710,   2610,   2514,   2425,   2348,   2288,   2248,
+                 2233,   2243,   2278,   2333,   2404,   2481,   2559,   2632,   2697,   2752,   2796,   2832,
+                 2859,   2882,   2902,   2924,   2954,   2997,   3062,   3153,   3276,   3431,   3614,   3819,
+                 4036,   4256,   4467,   4660,   4826,   4962,   5065,   5136,   5178,   5197,   5198,   5187,
+                 5166,   5138,   5104,   5063,   5014,   4955,   4885,   4804,   4713,   4614,   4509,   4401,
+                 4292 },
+    /* -15 */ {   4010,   3912,   3817,   3726,   3638,   3555,   3476,   3401,   3329,   3261,   3195,   3129,
+                 3063,   2995,   2924,   2849,   2771,   2691,   2610,   2531,   2457,   2391,   2338,   2301,
+                 2286,   2295,   2329,   2385,   2457,   2538,   2621,   2701,   2774,   2838,   2892,   2936,
+                 2971,   2998,   3020,   3039,   3061,   3092,   3138,   3207,   3303,   3429,   3583,   3758,
+                 3947,   4139,   4324,   4491,   4634,   4747,   4829,   4881,   4907,   4911,   4900,   4878,
+                 4849,   4816,   4778,   4736,   4686,   4628,   4561,   4484,   4398,   4305,   4208,   4109,
+                 4010 },
+    /* -10 */ {   3757,   3672,   3591,   3513,   3440,   3371,   3306,   3246,   3190,   3138,   3088,   3041,
+                 2994,   2946,   2895,   2842,   2786,   2728,   2667,   2605,   2544,   2487,   2437,   2399,
+                 2378,   2378,   2403,   2450,   2515,   2593,   2674,   2756,   2831,   2900,   2959,   3009,
+                 3049,   3081,   3105,   3123,   3140,   3161,   3194,   3245,   3319,   3420,   3546,   3692,
+                 3851,   4014,   4172,   4314,   4434,   4527,   4591,   4628,   4641,   4635,   4614,   4585,
+                 4551,   4513,   4472,   4427,   4377,   4319,   4255,   4182,   4103,   4018,   3931,   3843,
+                 3757 },
+    /*  -5 */ {   3549,   3480,   3414,   3352,   3294,   3241,   3192,   3148,   3109,   3074,   3043,   3014,
+                 2987,   2959,   2930,   2899,   2864,   2826,   2784,   2737,   2687,   2636,   2585,   2541,
+                 2509,   2496,   2504,   2535,   2586,   2652,   2725,   2801,   2874,   2942,   3003,   3056,
+                 3100,   3134,   3160,   3179,   3195,   3212,   3237,   3277,   3336,   3416,   3518,   3638,
+                 3769,   3904,   4035,   4153,   4251,   4327,   4377,   4403,   4407,   4395,   4369,   4335,
+                 4296,   4253,   4207,   4159,   4106,   4049,   3986,   3918,   3845,   3771,   3696,   3621,
+                 3549 },
+    /*  +0 */ {   3400,   3347,   3297,   3252,   3210,   3173,   3141,   3115,   3093,   3076,   3064,   3054,
+                 3046,   3039,   3030,   3020,   3005,   2985,   2959,   2925,   2883,   2834,   2780,   2727,
+                 2682,   2650,   2638,   2648,   2678,   2726,   2785,   2850,   2917,   2981,   3040,   3093,
+                 3138,   3175,   3204,   3226,   3244,   3262,   3287,   3322,   3372,   3439,   3523,   3621,
+                 3727,   3837,   3942,   4038,   4118,   4179,   4218,   4237,   4237,   4220,   4192,   4154,
+                 4109,   4061,   4009,   3954,   3897,   3836,   3774,   3709,   3644,   3579,   3517,   3457,
+                 3400 },
+    /*  +5 */ {   3318,   3280,   3247,   3217,   3191,   3170,   3155,   3146,   3142,   3143,   3149,   3159,
+                 3170,   3182,   3193,   3201,   3204,   3200,   3186,   3161,   3124,   3075,   3017,   2954,
+                 2894,   2844,   2809,   2796,   2803,   2830,   2871,   2922,   2978,   3035,   3091,   3142,
+                 3187,   3227,   3259,   3287,   3311,   3335,   3364,   3401,   3449,   3509,   3581,   3661,
+                 3748,   3835,   3920,   3997,   4061,   4111,   4143,   4158,   4155,   4137,   4106,   4064,
+                 4013,   3956,   3895,   3830,   3765,   3699,   3634,   3571,   3512,   3456,   3405,   3359,
+                 3318 },
+    /* +10 */ {   3301,   3278,   3258,   3243,   3233,   3228,   3229,   3236,   3250,   3269,   3293,   3321,
+                 3351,   3381,   3410,   3434,   3451,   3460,   3455,   3437,   3402,   3351,   3288,   3216,
+                 3142,   3074,   3020,   2984,   2970,   2975,   2999,   3035,   3080,   3129,   3179,   3228,
+                 3274,   3316,   3353,   3387,   3419,   3452,   3488,   3530,   3580,   3638,   3702,   3771,
+                 3843,   3914,   3983,   4046,   4099,   4141,   4169,   4182,   4179,   4160,   4125,   4077,
+                 4018,   3950,   3876,   3799,   3722,   3647,   3577,   3512,   3455,   3406,   3365,   3330,
+                 3301 },
+    /* +15 */ {   3345,   3332,   3325,   3323,   3326,   3336,   3353,   3377,   3407,   3444,   3486,   3532,
+                 3579,   3625,   3669,   3706,   3735,   3752,   3754,   3739,   3705,   3652,   3583,   3503,
+                 3419,   3337,   3267,   3213,   3180,   3168,   3175,   3198,   3233,   3275,   3322,   3369,
+                 3416,   3460,   3502,   3542,   3581,   3622,   3666,   3714,   3767,   3824,   3884,   3946,
+                 4009,   4070,   4129,   4184,   4231,   4270,   4296,   4309,   4306,   4285,   4247,   4192,
+                 4123,   4042,   3953,   3861,   3770,   3683,   3603,   3533,   3474,   3427,   3391,   3364,
+                 3345 },
+    /* +20 */ {   3439,   3434,   3437,   3446,   3463,   3487,   3518,   3558,   3605,   3658,   3717,   3778,
+                 3840,   3901,   3957,   4005,   4042,   4065,   4071,   4056,   4021,   3966,   3893,   3807,
+                 3715,   3624,   3542,   3476,   3429,   3404,   3399,   3412,   3439,   3476,   3519,   3566,
+                 3613,   3659,   3704,   3749,   3794,   3840,   3889,   3941,   3995,   4052,   4111,   4170,
+                 4228,   4286,   4342,   4394,   4441,   4479,   4507,   4521,   4518,   4496,   4454,   4392,
+                 4312,   4218,   4115,   4007,   3899,   3798,   3706,   3627,   3562,   3513,   3477,   3453,
+                 3439 },
+    /* +25 */ {   3578,   3577,   3587,   3606,   3634,   3671,   3716,   3770,   3832,   3901,   3974,   4049,
+                 4124,   4196,   4261,   4316,   4358,   4384,   4391,   4376,   4339,   4282,   4206,   4116,
+                 4020,   3924,   3836,   3762,   3706,   3672,   3659,   3664,   3686,   3719,   3759,   3804,
+                 3851,   3898,   3944,   3991,   4038,   4086,   4137,   4189,   4245,   4302,   4360,   4419,
+                 4478,   4537,   4594,   4649,   4699,   4742,   4774,   4790,   4789,   4766,   4720,   4652,
+                 4563,   4458,   4342,   4219,   4097,   3981,   3875,   3785,   3711,   3654,   3614,   3589,
+                 3578 },
+    /* +30 */ {   3755,   3757,   3771,   3797,   3835,   3882,   3940,   4007,   4082,   4163,   4248,   4333,
+                 4418,   4497,   4567,   4627,   4671,   4697,   4702,   4686,   4647,   4588,   4510,   4420,
+                 4322,   4225,   4134,   4056,   3996,   3956,   3937,   3937,   3953,   3981,   4018,   4060,
+                 4105,   4150,   4196,   4241,   4288,   4335,   4385,   4437,   4492,   4549,   4608,   4669,
+                 4732,   4796,   4859,   4921,   4978,   5027,   5064,   5085,   5085,   5063,   5016,   4944,
+                 4850,   4737,   4611,   4477,   4343,   4214,   4096,   3994,   3909,   3843,   3797,   3768,
+                 3755 },
+    /* +35 */ {   3968,   3969,   3986,   4017,   4061,   4118,   4185,   4261,   4345,   4435,   4527,   4620,
+                 4709,   4791,   4864,   4923,   4966,   4990,   4993,   4974,   4934,   4873,   4795,   4706,
+                 4609,   4513,   4422,   4344,   4281,   4238,   4214,   4208,   4218,   4241,   4272,   4309,
+                 4350,   4391,   4433,   4476,   4519,   4564,   4612,   4662,   4717,   4775,   4837,   4902,
+                 4971,   5042,   5113,   5183,   5248,   5305,   5348,   5374,   5379,   5359,   5313,   5242,
+                 5146,   5030,   4900,   4761,   4619,   4482,   4355,   4242,   4148,   4073,   4019,   3984,
+                 3968 },
+    /* +40 */ {   4214,   4213,   4229,   4262,   4310,   4371,   4443,   4524,   4613,   4707,   4802,   4896,
+                 4985,   5067,   5137,   5193,   5232,   5252,   5252,   5230,   5188,   5127,   5051,   4963,
+                 4870,   4776,   4688,   4610,   4547,   4500,   4471,   4459,   4462,   4477,   4501,   4531,
+                 4565,   4600,   4637,   4676,   4715,   4758,   4803,   4853,   4908,   4968,   5034,   5105,
+                 5180,   5259,   5338,   5416,   5489,   5553,   5603,   5634,   5644,   5629,   5587,   5519,
+                 5427,   5315,   5186,   5048,   4905,   4766,   4635,   4517,   4416,   4334,   4274,   4234,
+                 4214 },
+    /* +45 */ {   4485,   4481,   4495,   4527,   4574,   4635,   4707,   4788,   4876,   4968,   5061,   5151,
+                 5236,   5312,   5376,   5426,   5459,   5474,   5469,   5444,   5401,   5341,   5267,   5184,
+                 5095,   5006,   4921,   4845,   4781,   4732,   4698,   4679,   4673,   4678,   4693,   4714,
+                 4740,   4768,   4800,   4833,   4870,   4910,   4954,   5004,   5061,   5124,   5194,   5270,
+                 5351,   5436,   5523,   5607,   5686,   5755,   5810,   5847,   5862,   5853,   5818,   5758,
+                 5674,   5570,   5450,   5319,   5183,   5048,   4920,   4803,   4701,   4616,   4552,   4508,
+                 4485 },
+    /* +50 */ {   4770,   4763,   4774,   4802,   4845,   4901,   4968,   5043,   5125,   5209,   5293,   5375,
+                 5450,   5517,   5572,   5613,   5638,   5647,   5637,   5611,   5567,   5510,   5440,   5362,
+                 5279,   5195,   5115,   5042,   4978,   4926,   4887,   4861,   4846,   4842,   4847,   4858,
+                 4875,   4897,   4922,   4952,   4985,   5024,   5068,   5119,   5177,   5243,   5316,   5396,
+                 5482,   5570,   5660,   5748,   5829,   5901,   5959,   6000,   6020,   6018,   5992,   5943,
+                 5872,   5781,   5675,   5559,   5436,   5313,   5194,   5084,   4987,   4905,   4841,   4796,
+                 4770 },
+    /* +55 */ {   5055,   5045,   5052,   5074,   5109,   5157,   5214,   5278,   5348,   5420,   5491,   5559,
+                 5621,   5675,   5719,   5749,   5766,   5768,   5755,   5726,   5684,   5630,   5565,   5494,
+                 5418,   5341,   5267,   5198,   5136,   5083,   5040,   5008,   4986,   4973,   4968,   4971,
+                 4980,   4995,   5016,   5041,   5073,   5110,   5155,   5207,   5266,   5333,   5407,   5488,
+                 5574,   5662,   5751,   5837,   5918,   5989,   6047,   6090,   6115,   6119,   6103,   6067,
+                 6011,   5938,   5850,   5753,   5649,   5544,   5441,   5344,   5258,   5184,   5124,   5081,
+                 5055 },
+    /* +60 */ {   5321,   5309,   5312,   5326,   5353,   5389,   5433,   5483,   5537,   5592,   5647,   5699,
+                 5746,   5785,   5815,   5835,   5843,   5838,   5822,   5793,   5754,   5704,   5646,   5583,
+                 5516,   5447,   5380,   5317,   5259,   5207,   5163,   5128,   5101,   5082,   5071,   5067,
+                 5070,   5080,   5096,   5119,   5148,   5184,   5228,   5279,   5337,   5402,   5474,   5552,
+                 5633,   5716,   5800,   5880,   5955,   6022,   6077,   6120,   6147,   6157,   6151,   6127,
+                 6088,   6034,   5968,   5893,   5812,   5729,   5646,   5568,   5496,   5434,   5383,   5345,
+                 5321 },
+    /* +65 */ {   5549,   5538,   5536,   5544,   5560,   5584,   5613,   5647,   5684,   5722,   5759,   5793,
+                 5823,   5847,   5864,   5873,   5873,   5864,   5846,   5818,   5782,   5739,   5689,   5635,
+                 5578,   5520,   5463,   5407,   5355,   5308,   5267,   5232,   5204,   5183,   5168,   5161,
+                 5160,   5167,   5180,   5199,   5226,   5260,   5300,   5347,   5401,   5461,   5526,   5596,
+                 5668,   5741,   5814,   5884,   5950,   6008,   6058,   6097,   6125,   6140,   6142,   6131,
+                 6107,   6072,   6028,   5976,   5919,   5860,   5800,   5742,   5688,   5641,   5601,   5570,
+                 5549 },
+    /* +70 */ {   5724,   5714,   5710,   5711,   5719,   5731,   5746,   5765,   5785,   5806,   5826,   5844,
+                 5858,   5869,   5875,   5875,   5868,   5856,   5837,   5812,   5781,   5745,   5705,   5662,
+                 5616,   5570,   5524,   5479,   5437,   5398,   5362,   5332,   5307,   5287,   5273,   5265,
+                 5263,   5268,   5278,   5295,   5318,   5346,   5381,   5422,   5467,   5517,   5571,   5628,
+                 5687,   5747,   5805,   5862,   5915,   5962,   6004,   6038,   6064,   6081,   6088,   6087,
+                 6077,   6059,   6035,   6004,   5970,   5933,   5895,   5857,   5822,   5790,   5762,   5740,
+                 5724 },
+    /* +75 */ {   5833,   5825,   5820,   5818,   5819,   5822,   5827,   5833,   5840,   5846,   5852,   5857,
+                 5860,   5860,   5857,   5851,   5841,   5827,   5810,   5789,   5764,   5737,   5707,   5676,
+                 5643,   5609,   5576,   5544,   5513,   5484,   5459,   5436,   5417,   5402,   5391,   5385,
+                 5384,   5387,   5395,   5408,   5426,   5448,   5475,   5505,   5539,   5576,   5616,   5658,
+                 5701,   5744,   5786,   5827,   5865,   5901,   5932,   5959,   5980,   5997,   6008,   6013,
+                 6013,   6008,   5998,   5985,   5969,   5951,   5931,   5912,   5892,   5874,   5858,   5844,
+                 5833 },
+    /* +80 */ {   5874,   5868,   5864,   5860,   5857,   5855,   5853,   5852,   5850,   5848,   5846,   5842,
+                 5838,   5832,   5825,   5817,   5806,   5794,   5780,   5765,   5748,   5730,   5711,   5691,
+                 5671,   5650,   5630,   5611,   5593,   5576,   5560,   5547,   5536,   5527,   5521,   5518,
+                 5518,   5520,   5526,   5535,   5546,   5560,   5577,   5596,   5617,   5640,   5665,   5690,
+                 5716,   5742,   5768,   5793,   5817,   5839,   5860,   5878,   5894,   5907,   5917,   5925,
+                 5930,   5932,   5932,   5930,   5927,   5921,   5915,   5908,   5901,   5893,   5886,   5880,
+                 5874 },
+    /* +85 */ {   5848,   5846,   5843,   5840,   5837,   5834,   5831,   5827,   5823,   5819,   5815,   5810,
+                 5804,   5799,   5792,   5786,   5778,   5771,   5763,   5755,   5746,   5737,   5728,   5719,
+                 5711,   5702,   5694,   5686,   5679,   5672,   5666,   5661,   5657,   5654,   5652,   5651,
+                 5652,   5654,   5656,   5661,   5666,   5672,   5679,   5688,   5697,   5706,   5716,   5727,
+                 5738,   5749,   5760,   5771,   5782,   5792,   5802,   5811,   5819,   5827,   5833,   5839,
+                 5844,   5848,   5851,   5854,   5855,   5856,   5856,   5856,   5855,   5854,   5852,   5850,
+                 5848 },
+    /* +90 */ {   5771,   5771,   5771,   5770,   5770,   5770,   5770,   5770,   5770,   5770,   5770,   5769,
+                 5769,   5769,   5769,   5769,   5769,   5768,   5768,   5768,   5768,   5768,   5768,   5767,
+                 5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,
+                 5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5767,   5768,   5768,
+                 5768,   5768,   5768,   5768,   5769,   5769,   5769,   5769,   5769,   5770,   5770,   5770,
+                 5770,   5770,   5770,   5770,   5770,   5771,   5771,   5771,   5771,   5771,   5771,   5771,
+                 5771 }
+};
@@ -0,0 +1,264 @@
+/**
+ * @file eskf_init.c
+ * @brief 오차 상태 칼만 필터(Error-State Kalman Filter) 초기화 및 상태 접근 함수 구현
+ */
+
+#include "ekf/eskf.h"
+#include "ekf/ekf_wmm.h"
+#include <stddef.h>
+
+/**
+ * @brief 오차 공분산 초기화
+ *
+ * @param eskf ESKF 구조체 포인터
+ */
+static void eskf_reset_covariance(ESKF *eskf) {
+    float p_diag[ESKF_ERROR_DIM] = {
+        10.0f, 10.0f, 10.0f,     // 위치 불확실성 (m^2)
+        1.0f, 1.0f, 1.0f,        // 속도 불확실성 (m/s)^2
+        0.1f, 0.1f, 0.1f,        // 자세 불확실성 (rad^2)
+        0.01f, 0.01f, 0.01f,     // 자이로 바이어스 불확실성 (rad/s)^2
+        0.1f, 0.1f, 0.1f         // 가속도 바이어스 불확실성 (m/s^2)^2
+    };
+    matsym15_diagonal_vector(&eskf->P, p_diag);
+}
+
+/**
+ * @brief ESKF 초기화
+ */
+bool eskf_init(ESKF *eskf) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    // 명목 상태 초기화
+    eskf->pos = vector3f_zero();
+    eskf->vel = vector3f_zero();
+    eskf->q = quaternion_identity();
+    eskf->gyro_bias = vector3f_zero();
+    eskf->acc_bias = vector3f_zero();
+
+    // 오차 공분산 초기화 (15x15)
+    eskf_reset_covariance(eskf);
+
+    // 프로세스 노이즈 공분산 초기화 (15x15)
+    matsym15_zero(&eskf->Q);
+    for (uint8_t i = 0; i < ESKF_ERROR_DIM; i++) {
+        matsym15_set(&eskf->Q, i, i, 0.01f); // 기본값으로 초기화
+    }
+
+    // GPS 측정 노이즈 분산 초기화 (위치 5m, 5m, 10m, 속도 0.5m/s, 0.5m/s, 1m/s)
+    float gps_std[6] = {5.0f, 5.0f, 10.0f, 0.5f, 0.5f, 1.0f};
+    for (uint8_t i = 0; i < 6; i++) {
+        eskf->R_gps[i] = gps_std[i] * gps_std[i];
+    }
+
+    // 기압계 측정 노이즈 분산 초기화 (1m 표준 편차)
+    eskf->R_baro = 1.0f;
+
+    // 자력계 측정 노이즈 분산 초기화
+    for (uint8_t i = 0; i < 3; i++) {
+        eskf->R_mag[i] = 0.1f;
+    }
+
+    // 중력 가속도 설정
+    eskf->gravity = 9.80665f; // m/s^2
+
+    // 지구 자기장 벡터 초기화 (NED 좌표계, 기본 발사 지점의 모델 값)
+    ekf_wmm_get_field_ned(EKF_WMM_DEFAULT_LAT_DEG, EKF_WMM_DEFAULT_LON_DEG, &eskf->earth_mag_ned);
+
+    eskf->initialized = false;
+
+    return true;
+}
+
+/**
+ * @brief ESKF 초기 상태 설정
+ */
+bool eskf_set_initial_state(ESKF *eskf, Vector3f pos, Vector3f vel, Quaternion q) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    eskf->pos = pos;
+    eskf->vel = vel;
+    eskf->q = quaternion_normalize(q);
+
+    // 바이어스 초기화
+    eskf->gyro_bias = vector3f_zero();
+    eskf->acc_bias = vector3f_zero();
+
+    eskf_reset_covariance(eskf);
+
+    eskf->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief ESKF 프로세스 노이즈 설정
+ */
+bool eskf_set_process_noise(ESKF *eskf, float pos_std, float vel_std, float att_std,
+                            float gyro_bias_std, float acc_bias_std) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    float q_diag[ESKF_ERROR_DIM];
+    for (uint8_t i = 0; i < 3; i++) {
+        q_diag[ESKF_ERR_POS_X + i] = pos_std * pos_std;
+        q_diag[ESKF_ERR_VEL_X + i] = vel_std * vel_std;
+        q_diag[ESKF_ERR_ATT_X + i] = att_std * att_std;
+        q_diag[ESKF_ERR_GYRO_BIAS_X + i] = gyro_bias_std * gyro_bias_std;
+        q_diag[ESKF_ERR_ACC_BIAS_X + i] = acc_bias_std * acc_bias_std;
+    }
+    matsym15_diagonal_vector(&eskf->Q, q_diag);
+
+    return true;
+}
+
+/**
+ * @brief ESKF GPS 측정 노이즈 설정
+ */
+bool eskf_set_gps_noise(ESKF *eskf, float pos_std, float vel_std) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 3; i++) {
+        eskf->R_gps[i] = pos_std * pos_std;
+        eskf->R_gps[3 + i] = vel_std * vel_std;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ESKF 기압계 측정 노이즈 설정
+ */
+bool eskf_set_baro_noise(ESKF *eskf, float baro_std) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    eskf->R_baro = baro_std * baro_std;
+
+    return true;
+}
+
+/**
+ * @brief ESKF 자력계 측정 노이즈 설정
+ */
+bool eskf_set_mag_noise(ESKF *eskf, float mag_std) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 3; i++) {
+        eskf->R_mag[i] = mag_std * mag_std;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ESKF 지구 자기장 벡터 설정
+ */
+bool eskf_set_earth_magnetic_field(ESKF *eskf, Vector3f mag_ned) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    eskf->earth_mag_ned = mag_ned;
+
+    return true;
+}
+
+/**
+ * @brief ESKF 명목 상태에서 위치 추출
+ */
+Vector3f eskf_get_position(const ESKF *eskf) {
+    if (eskf == NULL || !eskf->initialized) {
+        return vector3f_zero();
+    }
+
+    return eskf->pos;
+}
+
+/**
+ * @brief ESKF 명목 상태에서 속도 추출
+ */
+Vector3f eskf_get_velocity(const ESKF *eskf) {
+    if (eskf == NULL || !eskf->initialized) {
+        return vector3f_zero();
+    }
+
+    return eskf->vel;
+}
+
+/**
+ * @brief ESKF 명목 상태에서 자세 추출
+ */
+Quaternion eskf_get_attitude(const ESKF *eskf) {
+    if (eskf == NULL || !eskf->initialized) {
+        return quaternion_identity();
+    }
+
+    return eskf->q;
+}
+
+/**
+ * @brief ESKF 명목 상태에서 오일러 각 추출
+ */
+bool eskf_get_euler(const ESKF *eskf, float *roll, float *pitch, float *yaw) {
+    if (eskf == NULL || !eskf->initialized || roll == NULL || pitch == NULL || yaw == NULL) {
+        return false;
+    }
+
+    quaternion_to_euler(eskf->q, roll, pitch, yaw);
+
+    return true;
+}
+
+/**
+ * @brief ESKF 명목 상태에서 자이로 바이어스 추출
+ */
+Vector3f eskf_get_gyro_bias(const ESKF *eskf) {
+    if (eskf == NULL || !eskf->initialized) {
+        return vector3f_zero();
+    }
+
+    return eskf->gyro_bias;
+}
+
+/**
+ * @brief ESKF 명목 상태에서 가속도 바이어스 추출
+ */
+Vector3f eskf_get_accel_bias(const ESKF *eskf) {
+    if (eskf == NULL || !eskf->initialized) {
+        return vector3f_zero();
+    }
+
+    return eskf->acc_bias;
+}
+
+/**
+ * @brief ESKF 상태 리셋
+ */
+bool eskf_reset(ESKF *eskf) {
+    if (eskf == NULL) {
+        return false;
+    }
+
+    eskf->pos = vector3f_zero();
+    eskf->vel = vector3f_zero();
+    eskf->q = quaternion_identity();
+    eskf->gyro_bias = vector3f_zero();
+    eskf->acc_bias = vector3f_zero();
+
+    eskf_reset_covariance(eskf);
+
+    eskf->initialized = false;
+
+    return true;
+}
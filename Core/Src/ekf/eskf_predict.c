@@ -0,0 +1,111 @@
+/**
+ * @file eskf_predict.c
+ * @brief 오차 상태 칼만 필터(Error-State Kalman Filter) 예측 단계 구현
+ */
+
+#include "ekf/eskf.h"
+#include <stddef.h>
+
+/**
+ * @brief 오차 상태 전이 행렬 계산
+ *
+ * 몸체 좌표계 자세 오차 δθ (q_true = q ⊗ exp(δθ)) 기준 1차 오차 동역학:
+ * δp' = δp + δv dt
+ * δv' = δv - R [a]x δθ dt - R δba dt
+ * δθ' = δθ - [ω]x δθ dt - δbg dt
+ * F = I + E 에서 E의 비영 원소만 희소 형태로 기록한다.
+ *
+ * @param q 명목 자세 사원수 (몸체 -> NED)
+ * @param omega 바이어스 보정된 각속도 (rad/s)
+ * @param accel 바이어스 보정된 가속도 (m/s^2, 몸체 좌표계)
+ * @param F 희소 오차 상태 전이 행렬
+ * @param dt 시간 간격 (초)
+ */
+static void eskf_compute_transition(Quaternion q, Vector3f omega, Vector3f accel,
+                                    MatrixSparseTransition *F, float dt) {
+    matrix_sparse_transition_clear(F);
+
+    // 회전 행렬 (몸체 -> NED)
+    float qw = q.w, qx = q.x, qy = q.y, qz = q.z;
+    float R[3][3] = {
+        {1.0f - 2.0f * (qy*qy + qz*qz), 2.0f * (qx*qy - qw*qz), 2.0f * (qx*qz + qw*qy)},
+        {2.0f * (qx*qy + qw*qz), 1.0f - 2.0f * (qx*qx + qz*qz), 2.0f * (qy*qz - qw*qx)},
+        {2.0f * (qx*qz - qw*qy), 2.0f * (qy*qz + qw*qx), 1.0f - 2.0f * (qx*qx + qy*qy)}
+    };
+
+    // 가속도 반대칭 행렬 [a]x
+    float A[3][3] = {
+        {0.0f, -accel.z, accel.y},
+        {accel.z, 0.0f, -accel.x},
+        {-accel.y, accel.x, 0.0f}
+    };
+
+    // 위치-속도 오차 관계
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_transition_add(F, ESKF_ERR_POS_X + i, ESKF_ERR_VEL_X + i, dt);
+    }
+
+    // 속도-자세 오차 (-R [a]x dt), 속도-가속도 바이어스 오차 (-R dt)
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            float ra = R[i][0] * A[0][j] + R[i][1] * A[1][j] + R[i][2] * A[2][j];
+            matrix_sparse_transition_add(F, ESKF_ERR_VEL_X + i, ESKF_ERR_ATT_X + j, -ra * dt);
+        }
+        for (uint8_t j = 0; j < 3; j++) {
+            matrix_sparse_transition_add(F, ESKF_ERR_VEL_X + i, ESKF_ERR_ACC_BIAS_X + j, -R[i][j] * dt);
+        }
+    }
+
+    // 자세-자세 오차 (-[ω]x dt, 대각 원소는 0)
+    matrix_sparse_transition_add(F, ESKF_ERR_ATT_X, ESKF_ERR_ATT_Y, omega.z * dt);
+    matrix_sparse_transition_add(F, ESKF_ERR_ATT_X, ESKF_ERR_ATT_Z, -omega.y * dt);
+    matrix_sparse_transition_add(F, ESKF_ERR_ATT_Y, ESKF_ERR_ATT_X, -omega.z * dt);
+    matrix_sparse_transition_add(F, ESKF_ERR_ATT_Y, ESKF_ERR_ATT_Z, omega.x * dt);
+    matrix_sparse_transition_add(F, ESKF_ERR_ATT_Z, ESKF_ERR_ATT_X, omega.y * dt);
+    matrix_sparse_transition_add(F, ESKF_ERR_ATT_Z, ESKF_ERR_ATT_Y, -omega.x * dt);
+
+    // 자세-자이로 바이어스 오차 (-I dt)
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_transition_add(F, ESKF_ERR_ATT_X + i, ESKF_ERR_GYRO_BIAS_X + i, -dt);
+    }
+}
+
+/**
+ * @brief ESKF 예측 단계 (IMU 데이터 기반)
+ */
+bool eskf_predict(ESKF *eskf, Vector3f gyro, Vector3f accel, float dt) {
+    if (eskf == NULL || dt <= 0.0f) {
+        return false;
+    }
+
+    if (!eskf->initialized) {
+        // 초기화되지 않은 경우 예측 수행하지 않음
+        return false;
+    }
+
+    // 바이어스 보정된 자이로 및 가속도 계산
+    Vector3f omega = vector3f_subtract(gyro, eskf->gyro_bias);
+    Vector3f accel_corrected = vector3f_subtract(accel, eskf->acc_bias);
+
+    // 1. 오차 상태 전이 행렬 (적분 전 명목 자세 기준)
+    MatrixSparseTransition F;
+    eskf_compute_transition(eskf->q, omega, accel_corrected, &F, dt);
+
+    // 2. 명목 자세 적분 (지수 사상, 단위 사원수끼리의 곱이므로 정규화 불필요)
+    Quaternion dq = quaternion_from_rotation_vector(vector3f_scale(omega, dt));
+    eskf->q = quaternion_multiply(eskf->q, dq);
+
+    // 3. 가속도를 NED 좌표계로 변환하고 중력 보정
+    Vector3f accel_ned = quaternion_rotate_vector(eskf->q, accel_corrected);
+    accel_ned.z -= eskf->gravity;
+
+    // 4. 속도 및 위치 적분
+    eskf->vel = vector3f_add(eskf->vel, vector3f_scale(accel_ned, dt));
+    eskf->pos = vector3f_add(eskf->pos, vector3f_scale(eskf->vel, dt));
+
+    // 5. 오차 공분산 전파: P = F * P * F^T + Q * dt
+    matsym15_propagate_sparse(&eskf->P, &F);
+    matsym15_add_scaled(&eskf->P, &eskf->Q, dt);
+
+    return true;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file eskf_update.c
+ * @brief 오차 상태 칼만 필터(Error-State Kalman Filter) 측정 갱신 단계 구현
+ */
+
+#include "ekf/eskf.h"
+#include <stddef.h>
+
+/**
+ * @brief 추정된 오차를 명목 상태에 주입하고 오차 상태 리셋
+ *
+ * p += δp, v += δv, q = q ⊗ exp(δθ), bg += δbg, ba += δba
+ * 주입 후 오차 평균은 0이 되며, 공분산은 리셋 자코비안
+ * G = I - [δθ/2]x (자세 블록)로 P = G * P * G^T 변환한다.
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param dx 추정된 오차 상태 (15x1)
+ */
+static void eskf_inject_error(ESKF *eskf, const Mat15x1 *dx) {
+    const float *d = &dx->data[0][0];
+
+    eskf->pos.x += d[ESKF_ERR_POS_X];
+    eskf->pos.y += d[ESKF_ERR_POS_Y];
+    eskf->pos.z += d[ESKF_ERR_POS_Z];
+
+    eskf->vel.x += d[ESKF_ERR_VEL_X];
+    eskf->vel.y += d[ESKF_ERR_VEL_Y];
+    eskf->vel.z += d[ESKF_ERR_VEL_Z];
+
+    Vector3f dtheta = vector3f_create(d[ESKF_ERR_ATT_X], d[ESKF_ERR_ATT_Y], d[ESKF_ERR_ATT_Z]);
+    eskf->q = quaternion_normalize(quaternion_multiply(eskf->q, quaternion_from_rotation_vector(dtheta)));
+
+    eskf->gyro_bias.x += d[ESKF_ERR_GYRO_BIAS_X];
+    eskf->gyro_bias.y += d[ESKF_ERR_GYRO_BIAS_Y];
+    eskf->gyro_bias.z += d[ESKF_ERR_GYRO_BIAS_Z];
+
+    eskf->acc_bias.x += d[ESKF_ERR_ACC_BIAS_X];
+    eskf->acc_bias.y += d[ESKF_ERR_ACC_BIAS_Y];
+    eskf->acc_bias.z += d[ESKF_ERR_ACC_BIAS_Z];
+
+    // 공분산 리셋: G = I + E, E = -[δθ/2]x (자세 블록)
+    float hx = 0.5f * dtheta.x;
+    float hy = 0.5f * dtheta.y;
+    float hz = 0.5f * dtheta.z;
+
+    MatrixSparseTransition G;
+    matrix_sparse_transition_clear(&G);
+    matrix_sparse_transition_add(&G, ESKF_ERR_ATT_X, ESKF_ERR_ATT_Y, hz);
+    matrix_sparse_transition_add(&G, ESKF_ERR_ATT_X, ESKF_ERR_ATT_Z, -hy);
+    matrix_sparse_transition_add(&G, ESKF_ERR_ATT_Y, ESKF_ERR_ATT_X, -hz);
+    matrix_sparse_transition_add(&G, ESKF_ERR_ATT_Y, ESKF_ERR_ATT_Z, hx);
+    matrix_sparse_transition_add(&G, ESKF_ERR_ATT_Z, ESKF_ERR_ATT_X, hy);
+    matrix_sparse_transition_add(&G, ESKF_ERR_ATT_Z, ESKF_ERR_ATT_Y, -hx);
+    matsym15_propagate_sparse(&eskf->P, &G);
+}
+
+/**
+ * @brief 오차 상태에 대한 순차 스칼라 측정 갱신
+ *
+ * 각 관측 k에 대해:
+ * y_k' = y_k - h_k * δx (앞선 관측으로 추정된 오차만큼 잔차 보정)
+ * s = h_k * P * h_k^T + r_k
+ * K = P * h_k^T / s
+ * δx = δx + K * y_k'
+ * P = P - K * (P * h_k^T)^T
+ * 모든 관측 처리 후 오차를 명목 상태에 한 번 주입한다.
+ *
+ * @param eskf ESKF 구조체 포인터
+ * @param H 측정 자코비안 희소 행 배열 (오차 상태 기준)
+ * @param R 측정 노이즈 분산 배열
+ * @param y 측정 잔차 배열 (측정값 - 명목 상태 예측값)
+ * @param m 측정 차원
+ * @return bool 갱신 성공 여부
+ */
+static bool eskf_sequential_update(ESKF *eskf, const MatrixSparseRow *H, const float *R,
+                                   const float *y, uint8_t m) {
+    Mat15x1 dx;
+    mat15x1_zero(&dx);
+    bool ok = true;
+
+    for (uint8_t k = 0; k < m; k++) {
+        const MatrixSparseRow *h = &H[k];
+
+        // PH^T 계산
+        Mat15x1 PHt;
+        matsym15_multiply_sparse_15x1(&eskf->P, h, &PHt);
+
+        // 혁신 분산 s = h * PH^T + r
+        float s = matrix_sparse_row_dot(h, &PHt.data[0][0]) + R[k];
+        if (!(s > 0.0f)) {
+            ok = false;
+            break;
+        }
+
+        // K = PH^T / s
+        Mat15x1 K;
+        mat15x1_scale(&PHt, 1.0f / s, &K);
+
+        // 오차 상태 갱신
+        float y_k = y[k] - matrix_sparse_row_dot(h, &dx.data[0][0]);
+        mat15x1_add_scaled(&dx, &K, y_k);
+
+        // 공분산 갱신: P = P - K * (PH^T)^T
+        matsym15_subtract_product_15x1(&eskf->P, &K, &PHt);
+    }
+
+    // 오차 주입 및 리셋
+    eskf_inject_error(eskf, &dx);
+
+    return ok;
+}
+
+/**
+ * @brief ESKF GPS 측정 갱신
+ */
+bool eskf_update_gps(ESKF *eskf, Vector3f gps_pos, bool use_vel, Vector3f gps_vel) {
+    if (eskf == NULL || !eskf->initialized) {
+        return false;
+    }
+
+    // 측정 자코비안 (위치/속도 오차에 대한 직접 매핑)
+    MatrixSparseRow H[6];
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+        matrix_sparse_row_add(&H[i], ESKF_ERR_POS_X + i, 1.0f);
+        matrix_sparse_row_clear(&H[3 + i]);
+        matrix_sparse_row_add(&H[3 + i], ESKF_ERR_VEL_X + i, 1.0f);
+    }
+
+    // 측정 잔차 (측정값 - 예측값)
+    float y[6] = {
+        gps_pos.x - eskf->pos.x,
+        gps_pos.y - eskf->pos.y,
+        gps_pos.z - eskf->pos.z,
+        gps_vel.x - eskf->vel.x,
+        gps_vel.y - eskf->vel.y,
+        gps_vel.z - eskf->vel.z
+    };
+
+    return eskf_sequential_update(eskf, H, eskf->R_gps, y, use_vel ? 6 : 3);
+}
+
+/**
+ * @brief ESKF 기압계 측정 갱신
+ */
+bool eskf_update_baro(ESKF *eskf, float baro_alt) {
+    if (eskf == NULL || !eskf->initialized) {
+        return false;
+    }
+
+    // 기압계 고도 측정은 Z 위치 오차에만 영향
+    MatrixSparseRow H[1];
+    matrix_sparse_row_clear(&H[0]);
+    matrix_sparse_row_add(&H[0], ESKF_ERR_POS_Z, 1.0f);
+
+    float y[1] = { baro_alt - eskf->pos.z };
+
+    return eskf_sequential_update(eskf, H, &eskf->R_baro, y, 1);
+}
+
+/**
+ * @brief ESKF 자력계 측정 갱신
+ *
+ * 예측값 m_b = R^T * m_ned 이고, 몸체 좌표계 자세 오차에 대해
+ * m_b(true) = (I - [δθ]x) m_b = m_b + [m_b]x δθ 이므로 H = [m_b]x 이다.
+ */
+bool eskf_update_mag(ESKF *eskf, Vector3f mag) {
+    if (eskf == NULL || !eskf->initialized) {
+        return false;
+    }
+
+    // 예측된 몸체 좌표계 자기장
+    Vector3f m = quaternion_rotate_vector_inverse(eskf->q, eskf->earth_mag_ned);
+
+    // 측정 자코비안 H = [m_b]x (자세 오차 열만 비영)
+    MatrixSparseRow H[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        matrix_sparse_row_clear(&H[i]);
+    }
+    matrix_sparse_row_add(&H[0], ESKF_ERR_ATT_Y, -m.z);
+    matrix_sparse_row_add(&H[0], ESKF_ERR_ATT_Z, m.y);
+    matrix_sparse_row_add(&H[1], ESKF_ERR_ATT_X, m.z);
+    matrix_sparse_row_add(&H[1], ESKF_ERR_ATT_Z, -m.x);
+    matrix_sparse_row_add(&H[2], ESKF_ERR_ATT_X, -m.y);
+    matrix_sparse_row_add(&H[2], ESKF_ERR_ATT_Y, m.x);
+
+    // 측정 잔차 (측정값 - 예측값)
+    float y[3] = {
+        mag.x - m.x,
+        mag.y - m.y,
+        mag.z - m.z
+    };
+
+    return eskf_sequential_update(eskf, H, eskf->R_mag, y, 3);
+}
@@ -0,0 +1,248 @@
+/**
+ * @file call_recorder.c
+ * @brief EKF 공개 호출 기록기 구현
+ */
+
+#include "log/call_recorder.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 레코드 한 개에 담는 인자/스냅샷 조각 크기 (바이트)
+ */
+#define CALL_RECORDER_CALL_CHUNK (FLASH_LOG_MAX_PAYLOAD - CALL_RECORDER_CALL_HEADER)
+#define CALL_RECORDER_SNAP_CHUNK (FLASH_LOG_MAX_PAYLOAD - CALL_RECORDER_SNAP_HEADER)
+
+_Static_assert(EKF_SNAPSHOT_SIZE < CALL_RECORDER_SNAP_LAYOUT, "EKF snapshot offset does not fit in uint16_t");
+_Static_assert(EKF_SNAPSHOT_SIZE + sizeof(EKF_DelayBuffer) < CALL_RECORDER_SNAP_LAYOUT,
+               "EKF snapshot with history does not fit in uint16_t offsets");
+_Static_assert(EKF_CALL_COUNT <= CALL_RECORDER_CONTINUED, "call id overlaps the continuation bit");
+
+/**
+ * @brief 리틀 엔디언 쓰기
+ */
+static void call_recorder_put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void call_recorder_put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief 레코드 쓰기 (통계 포함)
+ */
+static bool call_recorder_write(CallRecorder *rec, uint8_t type, const uint8_t *payload, uint16_t len) {
+    if (!flash_log_write(rec->log, type, payload, (uint8_t)len)) {
+        rec->stats.dropped++;
+        return false;
+    }
+    rec->stats.records++;
+    return true;
+}
+
+/**
+ * @brief 두 조각(head | tail)을 이은 바이트열에서 일부 복사
+ */
+static void call_recorder_copy(uint8_t *dst, const uint8_t *head, uint16_t head_len,
+                               const uint8_t *tail, uint32_t offset, uint32_t n) {
+    if (offset < head_len) {
+        uint32_t first = head_len - offset;
+        if (first > n) {
+            first = n;
+        }
+        memcpy(dst, head + offset, first);
+        dst += first;
+        offset += first;
+        n -= first;
+    }
+    if (n > 0) {
+        memcpy(dst, tail + (offset - head_len), n);
+    }
+}
+
+/**
+ * @brief 스냅샷 쓰기 (배치 레코드와 EKF 스냅샷 범위, 지연 이력 조각)
+ */
+static bool call_recorder_write_snapshot(CallRecorder *rec) {
+    uint8_t buf[FLASH_LOG_MAX_PAYLOAD];
+    const uint16_t ekf_size = (uint16_t)EKF_SNAPSHOT_SIZE;
+    const uint16_t history_size = (rec->history != NULL) ? (uint16_t)sizeof(EKF_DelayBuffer) : 0u;
+
+    call_recorder_put_u32(&buf[0], rec->index);
+    call_recorder_put_u16(&buf[4], CALL_RECORDER_SNAP_LAYOUT);
+    call_recorder_put_u16(&buf[6], ekf_size);
+    call_recorder_put_u16(&buf[8], history_size);
+    call_recorder_put_u32(&buf[10], ekf_snapshot_layout());
+    buf[14] = rec->ekf->initialized ? 1u : 0u;
+    if (!call_recorder_write(rec, FLASH_LOG_REC_EKF_SNAP, buf, 15u)) {
+        return false;
+    }
+
+    const uint8_t *ekf_bytes = (const uint8_t *)rec->ekf;
+    const uint8_t *history_bytes = (const uint8_t *)rec->history;
+    const uint32_t total = (uint32_t)ekf_size + history_size;
+    for (uint32_t offset = 0; offset < total; offset += CALL_RECORDER_SNAP_CHUNK) {
+        uint32_t n = total - offset;
+        if (n > CALL_RECORDER_SNAP_CHUNK) {
+            n = CALL_RECORDER_SNAP_CHUNK;
+        }
+        call_recorder_put_u32(&buf[0], rec->index);
+        call_recorder_put_u16(&buf[4], (uint16_t)offset);
+        call_recorder_copy(&buf[CALL_RECORDER_SNAP_HEADER], ekf_bytes, ekf_size, history_bytes, offset, n);
+        if (!call_recorder_write(rec, FLASH_LOG_REC_EKF_SNAP, buf, (uint16_t)(CALL_RECORDER_SNAP_HEADER + n))) {
+            return false;
+        }
+    }
+    rec->stats.snapshots++;
+    return true;
+}
+
+/**
+ * @brief 검사값 쓰기 (index번 호출 직전의 x, P CRC-32)
+ */
+static bool call_recorder_write_check(CallRecorder *rec) {
+    uint8_t buf[12];
+    call_recorder_put_u32(&buf[0], rec->index);
+    call_recorder_put_u32(&buf[4], hw_crc32(rec->crc, rec->ekf->x.data, sizeof(rec->ekf->x.data)));
+    call_recorder_put_u32(&buf[8], hw_crc32(rec->crc, rec->ekf->P.data, sizeof(rec->ekf->P.data)));
+    if (!call_recorder_write(rec, FLASH_LOG_REC_EKF_CHECK, buf, sizeof(buf))) {
+        return false;
+    }
+    rec->stats.checks++;
+    return true;
+}
+
+/**
+ * @brief EKF 공개 호출 관찰 콜백
+ */
+static void call_recorder_observe(void *context, EKF_CallId call, const void *head, uint16_t head_len,
+                                  const void *tail, uint16_t tail_len) {
+    CallRecorder *rec = (CallRecorder *)context;
+    if (rec == NULL || rec->ekf == NULL) {
+        return;
+    }
+
+    if (rec->resync || (call == EKF_CALL_SET_ENGINE && rec->config.snapshot_on_engine)) {
+        rec->resync = !call_recorder_write_snapshot(rec);
+        rec->since_check = 0;
+    }
+    if (rec->config.check_interval > 0 && rec->since_check >= rec->config.check_interval) {
+        if (call_recorder_write_check(rec)) {
+            rec->since_check = 0;
+        }
+    }
+
+    uint8_t buf[FLASH_LOG_MAX_PAYLOAD];
+    const uint32_t t_us = (rec->clock != NULL) ? rec->clock() : 0u;
+    const uint32_t total = (uint32_t)head_len + ((tail != NULL) ? tail_len : 0u);
+    bool ok = true;
+    uint32_t offset = 0;
+    do {
+        uint32_t n = total - offset;
+        if (n > CALL_RECORDER_CALL_CHUNK) {
+            n = CALL_RECORDER_CALL_CHUNK;
+        }
+        call_recorder_put_u32(&buf[0], rec->index);
+        call_recorder_put_u32(&buf[4], t_us);
+        buf[8] = (uint8_t)call | ((offset > 0) ? CALL_RECORDER_CONTINUED : 0u);
+        call_recorder_put_u16(&buf[9], (uint16_t)((offset > 0) ? offset : total));
+        call_recorder_copy(&buf[CALL_RECORDER_CALL_HEADER], (const uint8_t *)head, head_len,
+                           (const uint8_t *)tail, offset, n);
+        if (!call_recorder_write(rec, FLASH_LOG_REC_EKF_CALL, buf, (uint16_t)(CALL_RECORDER_CALL_HEADER + n))) {
+            ok = false;
+            break;
+        }
+        offset += n;
+    } while (offset < total);
+
+    if (!ok) {
+        // 재생기는 이 호출부터 다음 스냅샷까지 건너뜀
+        rec->stats.lost_calls++;
+        rec->resync = true;
+    }
+    if (total > rec->stats.max_args) {
+        rec->stats.max_args = total;
+    }
+    rec->index++;
+    rec->since_check++;
+    rec->stats.calls++;
+}
+
+bool call_recorder_default_config(CallRecorderConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+    config->check_interval = CALL_RECORDER_DEFAULT_CHECK_INTERVAL;
+    config->snapshot_on_engine = CALL_RECORDER_DEFAULT_SNAPSHOT_ON_ENGINE;
+    return true;
+}
+
+bool call_recorder_init(CallRecorder *rec, FlashLog *log, HwCrc *crc, CallRecorderClockFn clock,
+                        const CallRecorderConfig *config) {
+    if (rec == NULL || log == NULL) {
+        return false;
+    }
+    CallRecorderConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        call_recorder_default_config(&cfg);
+    }
+
+    memset(rec, 0, sizeof(CallRecorder));
+    rec->log = log;
+    rec->crc = crc;
+    rec->clock = clock;
+    rec->config = cfg;
+    rec->initialized = true;
+    return true;
+}
+
+bool call_recorder_start(CallRecorder *rec, EKF *ekf, EKF_DelayBuffer *history) {
+    if (rec == NULL || !rec->initialized || ekf == NULL) {
+        return false;
+    }
+    if (rec->ekf != NULL) {
+        call_recorder_stop(rec);
+    }
+    rec->ekf = ekf;
+    rec->history = history;
+    rec->index = 0;
+    rec->since_check = 0;
+    rec->resync = !call_recorder_write_snapshot(rec);
+    ekf_set_call_observer(ekf, call_recorder_observe, rec);
+    return !rec->resync;
+}
+
+bool call_recorder_stop(CallRecorder *rec) {
+    if (rec == NULL || !rec->initialized) {
+        return false;
+    }
+    if (rec->ekf != NULL) {
+        ekf_set_call_observer(rec->ekf, NULL, NULL);
+        rec->ekf = NULL;
+    }
+    rec->history = NULL;
+    return true;
+}
+
+bool call_recorder_snapshot(CallRecorder *rec) {
+    if (rec == NULL || !rec->initialized || rec->ekf == NULL) {
+        return false;
+    }
+    rec->resync = !call_recorder_write_snapshot(rec);
+    rec->since_check = 0;
+    return !rec->resync;
+}
+
+const CallRecorderStats *call_recorder_get_stats(const CallRecorder *rec) {
+    if (rec == NULL) {
+        return NULL;
+    }
+    return &rec->stats;
+}
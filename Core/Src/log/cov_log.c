@@ -0,0 +1,142 @@
+/**
+ * @file cov_log.c
+ * @brief 공분산 스냅샷 압축 기록 구현
+ */
+
+#include "log/cov_log.h"
+#include <stddef.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool cov_log_default_config(CovLogConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->period_us = COV_LOG_DEFAULT_PERIOD_US;
+
+    return true;
+}
+
+/**
+ * @brief 초기화
+ */
+bool cov_log_init(CovLog *cl, const CovLogConfig *config) {
+    if (cl == NULL) {
+        return false;
+    }
+
+    CovLogConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        cov_log_default_config(&cfg);
+    }
+
+    memset(cl, 0, sizeof(*cl));
+    cl->config = cfg;
+    cl->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 스냅샷 부호화
+ */
+uint8_t cov_log_encode(uint32_t timestamp_us, uint8_t n, const float *P, uint8_t *payload, uint8_t *invalid) {
+    if (P == NULL || payload == NULL || n == 0 || n > COV_LOG_MAX_DIM) {
+        return 0;
+    }
+
+    uint8_t *p = payload;
+    *p++ = (uint8_t)timestamp_us;
+    *p++ = (uint8_t)(timestamp_us >> 8);
+    *p++ = (uint8_t)(timestamp_us >> 16);
+    *p++ = (uint8_t)(timestamp_us >> 24);
+    *p++ = n;
+
+    // 1. 표준 편차 코드 (0.5 log2 P_ii), 상관 계수용 1/σ
+    float inv_std[COV_LOG_MAX_DIM];
+    uint8_t bad = 0;
+    uint16_t diag = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        float var = P[diag];
+        int16_t code = COV_LOG_STD_INVALID;
+        inv_std[i] = 0.0f;
+        if (var > 0.0f && var <= FLT_MAX) {
+            float c = 0.5f * COV_LOG_STD_SCALE * log2f(var);
+            c = (c > 32767.0f) ? 32767.0f : (c < -32767.0f) ? -32767.0f : c;
+            code = (int16_t)lrintf(c);
+            inv_std[i] = 1.0f / sqrtf(var);
+        } else {
+            bad++;
+        }
+        *p++ = (uint8_t)(uint16_t)code;
+        *p++ = (uint8_t)((uint16_t)code >> 8);
+        diag = (uint16_t)(diag + (n - i));
+    }
+
+    // 2. 상관 계수 (위 삼각, 행 순서)
+    uint16_t k = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        k++;
+        for (uint8_t j = (uint8_t)(i + 1u); j < n; j++, k++) {
+            float rho = P[k] * inv_std[i] * inv_std[j];
+            rho = (rho > 1.0f) ? 1.0f : (rho < -1.0f) ? -1.0f : rho;
+            // NaN은 위 비교를 모두 통과하므로 0으로
+            *p++ = (uint8_t)(int8_t)((rho == rho) ? lrintf(COV_LOG_CORR_SCALE * rho) : 0);
+        }
+    }
+
+    if (invalid != NULL) {
+        *invalid = bad;
+    }
+
+    return (uint8_t)(p - payload);
+}
+
+/**
+ * @brief 간격이 되었으면 EKF 공분산 스냅샷 기록
+ */
+bool cov_log_write(CovLog *cl, FlashLog *log, const EKF *ekf, uint32_t timestamp_us) {
+    if (cl == NULL || !cl->initialized || log == NULL || ekf == NULL || !ekf->initialized) {
+        return false;
+    }
+    if (cl->started && (int32_t)(timestamp_us - cl->next_us) < 0) {
+        return false;
+    }
+
+    uint8_t payload[COV_LOG_SIZE(EKF_STATE_DIM)];
+    uint8_t invalid = 0;
+    uint8_t len = cov_log_encode(timestamp_us, EKF_STATE_DIM, ekf->P.data, payload, &invalid);
+    if (len == 0) {
+        return false;
+    }
+    if (!flash_log_write(log, FLASH_LOG_REC_COV, payload, len)) {
+        cl->stats.dropped++;
+        return false;
+    }
+
+    // 밀린 간격은 따라잡지 않고 이번 기록 기준으로 다시 잡음
+    cl->next_us = timestamp_us + cl->config.period_us;
+    cl->started = true;
+    cl->stats.written++;
+    cl->stats.invalid_std += invalid;
+
+    return true;
+}
+
+/**
+ * @brief 통계
+ */
+const CovLogStats *cov_log_get_stats(const CovLog *cl) {
+    if (cl == NULL) {
+        return NULL;
+    }
+
+    return &cl->stats;
+}
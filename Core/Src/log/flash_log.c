@@ -0,0 +1,1518 @@
+/**
+ * @file flash_log.c
+ * @brief NOR 플래시 비행 기록기 구현
+ */
+
+#include "log/flash_log.h"
+#include "log/log_lz.h"
+#include "sys/trace.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 사전 지우기 단위 (섹터: 한 번에 수십 ms라 기록 중에도 버퍼가 밀리지 않음)
+ *
+ * QSPI_NOR_BLOCK_SIZE로 바꾸면 지우기 처리량은 약 4배가 되지만, 블록 지우기 동안
+ * (수백 ms) 기록이 멈추므로 발사대에서 기록을 시작하기 전에 끝내야 한다.
+ */
+#define FLASH_LOG_PRE_ERASE_SIZE QSPI_NOR_SECTOR_SIZE
+
+/**
+ * @brief SD 사전 지우기 단위 (카드 지우기는 영역 크기에 거의 무관하게 수십~수백 ms)
+ */
+#define FLASH_LOG_SD_PRE_ERASE_SIZE (1u << 20)
+
+/**
+ * @brief 기록 블록 하나의 SD 블록 수
+ */
+#define FLASH_LOG_SD_BLOCKS (FLASH_LOG_BUFFER_SIZE / SD_CARD_BLOCK_SIZE)
+
+/**
+ * @brief 색인 블록 버퍼 번호 (데이터 이중 버퍼 뒤)
+ */
+#define FLASH_LOG_INDEX_SLOT 2u
+
+/**
+ * @brief 색인 항목 없음 표시 (index_last_seq)
+ */
+#define FLASH_LOG_INDEX_NONE 0xFFFFFFFFu
+
+/**
+ * @brief 엔진 작업 시작 결과
+ */
+typedef enum {
+    FLASH_LOG_START_NONE = 0,  /**< 할 일 없음 */
+    FLASH_LOG_START_OK,        /**< 작업 시작 (완료 인터럽트가 이어받음) */
+    FLASH_LOG_START_FAILED     /**< 시작 실패 (다음 service에서 다시 시도) */
+} FlashLogStart;
+
+static void flash_log_kick(FlashLog *log);
+
+/**
+ * @brief 버퍼 상태 읽기/쓰기
+ */
+static uint8_t flash_log_state(const FlashLog *log, uint8_t i) {
+    return (uint8_t)atomic_load_explicit(&log->buffer_state[i], memory_order_acquire);
+}
+
+static void flash_log_set_state(FlashLog *log, uint8_t i, uint8_t state) {
+    atomic_store_explicit(&log->buffer_state[i], state, memory_order_release);
+}
+
+/**
+ * @brief 버퍼의 블록 헤더
+ */
+static FlashLogBlockHeader flash_log_buffer_header(const FlashLog *log, uint8_t i) {
+    FlashLogBlockHeader header;
+    memcpy(&header, log->buffer[i], sizeof(header));
+
+    return header;
+}
+
+/**
+ * @brief 압축 모드로 저장된 블록인지 (페이지 단위로 이어 붙임)
+ */
+static bool flash_log_is_packed(const FlashLogBlockHeader *header) {
+    return header->magic == FLASH_LOG_LZ_MAGIC || header->magic == FLASH_LOG_PACKED_MAGIC;
+}
+
+/**
+ * @brief 데이터 블록 헤더가 올바른지
+ */
+static bool flash_log_header_valid(const FlashLogBlockHeader *header) {
+    return (header->magic == FLASH_LOG_MAGIC || flash_log_is_packed(header)) &&
+           header->used >= sizeof(FlashLogBlockHeader) && header->used <= FLASH_LOG_BUFFER_SIZE;
+}
+
+/**
+ * @brief 블록이 저장소에서 차지하는 바이트 (압축 모드 블록은 페이지 올림, 그 밖은 섹터)
+ */
+static uint32_t flash_log_stored_size(const FlashLogBlockHeader *header) {
+    if (flash_log_is_packed(header)) {
+        return (header->used + QSPI_NOR_PAGE_SIZE - 1u) / QSPI_NOR_PAGE_SIZE * QSPI_NOR_PAGE_SIZE;
+    }
+
+    return FLASH_LOG_BUFFER_SIZE;
+}
+
+/**
+ * @brief 기록 대기 버퍼 찾기 (-1이면 없음)
+ */
+static int8_t flash_log_pending(const FlashLog *log) {
+    // 데이터 블록 먼저 (둘 다 차 있으면 순번이 앞선 쪽), 색인 블록은 그 다음
+    int8_t found = -1;
+    uint32_t found_seq = 0;
+    for (uint8_t i = 0; i < FLASH_LOG_INDEX_SLOT; i++) {
+        if (flash_log_state(log, i) == FLASH_LOG_BUFFER_FULL) {
+            uint32_t seq = flash_log_buffer_header(log, i).seq;
+            if (found < 0 || seq < found_seq) {
+                found = (int8_t)i;
+                found_seq = seq;
+            }
+        }
+    }
+    if (found < 0 && flash_log_state(log, FLASH_LOG_INDEX_SLOT) == FLASH_LOG_BUFFER_FULL) {
+        found = (int8_t)FLASH_LOG_INDEX_SLOT;
+    }
+
+    return found;
+}
+
+/**
+ * @brief 배경(사전/예비) 지우기를 시작할 때인지
+ */
+static bool flash_log_erase_due(const FlashLog *log) {
+    if (log->full || log->erase_suspended || log->erase_addr >= log->erase_target) {
+        return false;
+    }
+
+    // 부하 감시기가 있으면 융합 루프에 여유가 있을 때만 (마지막 사이클 기준)
+    return log->load == NULL || log->load->last_load <= log->erase_max_load;
+}
+
+/**
+ * @brief 데이터 블록이 이미 지워진 영역에 들어가는지 (지우기 없이 바로 기록 가능)
+ */
+static bool flash_log_fits_erased(const FlashLog *log, uint8_t i) {
+    if (i == FLASH_LOG_INDEX_SLOT) {
+        return false;
+    }
+    FlashLogBlockHeader header = flash_log_buffer_header(log, i);
+
+    return log->erase_addr >= log->write_addr + flash_log_stored_size(&header);
+}
+
+/**
+ * @brief 엔진이 할 일이 있는지
+ */
+static bool flash_log_has_work(const FlashLog *log) {
+    return flash_log_pending(log) >= 0 || log->erase_suspended || flash_log_erase_due(log);
+}
+
+/**
+ * @brief 사전 지우기 목표를 기록 위치 + bytes로 올림 (섹터 올림, 기록 영역 끝 제한, 줄이지 않음)
+ */
+static void flash_log_raise_erase_target(FlashLog *log, uint32_t bytes) {
+    uint32_t span = log->end_addr - log->write_addr;
+    if (bytes > span) {
+        bytes = span;
+    }
+    uint32_t target = (log->write_addr + bytes + FLASH_LOG_BUFFER_SIZE - 1u) / FLASH_LOG_BUFFER_SIZE * FLASH_LOG_BUFFER_SIZE;
+    if (target > log->end_addr) {
+        target = log->end_addr;
+    }
+    if (target > log->erase_target) {
+        log->erase_target = target;
+    }
+}
+
+/**
+ * @brief 기록 중인 블록의 저장 주소 (데이터 또는 색인 영역)
+ */
+static uint32_t flash_log_flush_addr(const FlashLog *log) {
+    return (log->flushing == (int8_t)FLASH_LOG_INDEX_SLOT) ? log->index_addr : log->write_addr;
+}
+
+/**
+ * @brief 기록 중인 블록의 페이지 쓰기 시작 (SD는 블록 전체를 다중 블록 쓰기로)
+ */
+static bool flash_log_program_page(FlashLog *log) {
+    log->op = FLASH_LOG_OP_PROGRAM_DATA;
+    uint32_t addr = flash_log_flush_addr(log);
+
+    if (log->backend == FLASH_LOG_BACKEND_SD) {
+        return sd_card_write_dma(log->sd, log->sd_first_lba + addr / SD_CARD_BLOCK_SIZE,
+                                 log->buffer[log->flushing], FLASH_LOG_SD_BLOCKS);
+    }
+
+    uint32_t offset = (uint32_t)log->page * QSPI_NOR_PAGE_SIZE;
+
+    return qspi_nor_program_page_dma(log->nor, addr + offset,
+                                     &log->buffer[log->flushing][offset], QSPI_NOR_PAGE_SIZE);
+}
+
+/**
+ * @brief 지우기 시작 (NOR는 완료 대기 인터럽트까지, SD는 service가 완료 확인)
+ */
+static bool flash_log_erase(FlashLog *log, uint32_t addr, uint32_t size) {
+    log->erase_pending = addr + size;
+    log->op = FLASH_LOG_OP_ERASE;
+
+    if (log->backend == FLASH_LOG_BACKEND_SD) {
+        return sd_card_erase_start(log->sd, log->sd_first_lba + addr / SD_CARD_BLOCK_SIZE,
+                                   size / SD_CARD_BLOCK_SIZE);
+    }
+
+    return qspi_nor_erase_start(log->nor, addr, size) && qspi_nor_wait_ready_it(log->nor);
+}
+
+/**
+ * @brief 기록할 블록의 페이지 수 (사용하지 않은 뒤쪽 페이지는 지워진 그대로 둠, SD는 1)
+ */
+static uint16_t flash_log_page_count(const FlashLog *log) {
+    if (log->backend == FLASH_LOG_BACKEND_SD) {
+        return 1;
+    }
+
+    FlashLogBlockHeader header = flash_log_buffer_header(log, (uint8_t)log->flushing);
+
+    return (uint16_t)((header.used + QSPI_NOR_PAGE_SIZE - 1u) / QSPI_NOR_PAGE_SIZE);
+}
+
+/**
+ * @brief 블록 CRC 저장
+ */
+static void flash_log_store_crc(FlashLog *log, uint32_t crc) {
+    memcpy(&log->buffer[log->flushing][offsetof(FlashLogBlockHeader, crc)], &crc, sizeof(crc));
+}
+
+/**
+ * @brief 블록 CRC 소프트웨어/CPU 계산
+ */
+static uint32_t flash_log_block_crc(FlashLog *log) {
+    return hw_crc32(log->crc, &log->buffer[log->flushing][FLASH_LOG_CRC_OFFSET],
+                    FLASH_LOG_BUFFER_SIZE - FLASH_LOG_CRC_OFFSET);
+}
+
+/**
+ * @brief CRC가 채워진 블록 기록 시작 (지워지지 않은 NOR 섹터가 걸치면 지우기부터)
+ *
+ * 색인 영역은 사전 지우기 대상이 아니므로 NOR에서는 색인 블록마다 섹터를 지운다.
+ * 압축 모드 블록은 섹터 경계에 걸칠 수 있으며, 지운 영역 끝(섹터 정렬)의 다음 섹터를 지운다.
+ */
+static bool flash_log_begin_write(FlashLog *log) {
+    if (log->backend == FLASH_LOG_BACKEND_NOR) {
+        if (log->flushing == (int8_t)FLASH_LOG_INDEX_SLOT) {
+            log->op = FLASH_LOG_OP_ERASE;
+            return qspi_nor_erase_start(log->nor, log->index_addr, QSPI_NOR_SECTOR_SIZE) &&
+                   qspi_nor_wait_ready_it(log->nor);
+        }
+        if (!flash_log_fits_erased(log, (uint8_t)log->flushing)) {
+            // 예비 영역이 바닥남: 블록 기록이 지우기를 기다림
+            log->erase_stalls++;
+            return flash_log_erase(log, log->erase_addr, QSPI_NOR_SECTOR_SIZE);
+        }
+    }
+
+    return flash_log_program_page(log);
+}
+
+/**
+ * @brief 블록 CRC DMA 계산 완료 (DMA 인터럽트)
+ */
+static void flash_log_crc_done(bool ok, uint32_t crc, void *context) {
+    FlashLog *log = (FlashLog *)context;
+    if (log->op != FLASH_LOG_OP_CRC) {
+        return;
+    }
+
+    flash_log_store_crc(log, ok ? crc : flash_log_block_crc(log));
+    if (!flash_log_begin_write(log)) {
+        flash_log_handle_error(log);
+    }
+}
+
+/**
+ * @brief 일시 중지한 배경 지우기 재개 (완료는 지우기 완료 인터럽트가 이어받음)
+ */
+static FlashLogStart flash_log_resume_erase(FlashLog *log) {
+    log->op = FLASH_LOG_OP_ERASE;
+    if (!qspi_nor_erase_resume(log->nor) || !qspi_nor_wait_ready_it(log->nor)) {
+        log->flash_errors++;
+        log->op = FLASH_LOG_OP_NONE;
+        return FLASH_LOG_START_FAILED;
+    }
+    log->erase_suspended = false;
+
+    return FLASH_LOG_START_OK;
+}
+
+/**
+ * @brief 다음 작업 시작 (엔진 소유권을 가진 문맥)
+ */
+static FlashLogStart flash_log_start_next(FlashLog *log) {
+    int8_t i = flash_log_pending(log);
+
+    // 일시 중지 중에는 지운 영역에 들어가는 데이터 블록만 쓰고, 그 밖에는 지우기부터 재개
+    // (색인 블록과 다음 섹터가 필요한 블록은 지우기 명령을 내야 함)
+    if (log->erase_suspended && (i < 0 || !flash_log_fits_erased(log, (uint8_t)i))) {
+        return flash_log_resume_erase(log);
+    }
+
+    if (i >= 0) {
+        FlashLogBlockHeader header = flash_log_buffer_header(log, (uint8_t)i);
+        if (i == (int8_t)FLASH_LOG_INDEX_SLOT) {
+            if (log->index_addr + FLASH_LOG_BUFFER_SIZE > log->index_end) {
+                // 색인 영역을 다 씀: 색인만 멈추고 기록은 계속
+                log->index_dropped++;
+                flash_log_set_state(log, (uint8_t)i, FLASH_LOG_BUFFER_FREE);
+                return FLASH_LOG_START_NONE;
+            }
+        } else if (log->write_addr + flash_log_stored_size(&header) > log->end_addr) {
+            // 기록 영역을 다 씀: 남은 블록은 버림
+            log->full = true;
+            flash_log_set_state(log, (uint8_t)i, FLASH_LOG_BUFFER_FREE);
+            return FLASH_LOG_START_NONE;
+        }
+
+        flash_log_set_state(log, (uint8_t)i, FLASH_LOG_BUFFER_FLUSHING);
+        log->flushing = i;
+        log->page = 0;
+        TRACE_BEGIN(TRACE_EVENT_LOG_FLUSH);
+
+        // 블록 CRC: DMA로 계산하고 완료 인터럽트에서 기록을 이어감 (압축 모드 블록은 압축 전에 계산됨)
+        if (!flash_log_is_packed(&header)) {
+            log->op = FLASH_LOG_OP_CRC;
+            if (hw_crc32_start_dma(log->crc, &log->buffer[i][FLASH_LOG_CRC_OFFSET],
+                                   FLASH_LOG_BUFFER_SIZE - FLASH_LOG_CRC_OFFSET, flash_log_crc_done, log)) {
+                return FLASH_LOG_START_OK;
+            }
+            flash_log_store_crc(log, flash_log_block_crc(log));
+        }
+
+        if (!flash_log_begin_write(log)) {
+            log->flash_errors++;
+            log->op = FLASH_LOG_OP_NONE;
+            log->flushing = -1;
+            flash_log_set_state(log, (uint8_t)i, FLASH_LOG_BUFFER_FULL);
+            return FLASH_LOG_START_FAILED;
+        }
+        return FLASH_LOG_START_OK;
+    }
+
+    if (flash_log_erase_due(log)) {
+        uint32_t size = (log->backend == FLASH_LOG_BACKEND_SD) ? FLASH_LOG_SD_PRE_ERASE_SIZE : FLASH_LOG_PRE_ERASE_SIZE;
+        if (size > log->erase_target - log->erase_addr) {
+            size = log->erase_target - log->erase_addr;
+        }
+        if (!flash_log_erase(log, log->erase_addr, size)) {
+            log->flash_errors++;
+            log->op = FLASH_LOG_OP_NONE;
+            return FLASH_LOG_START_FAILED;
+        }
+        return FLASH_LOG_START_OK;
+    }
+
+    return FLASH_LOG_START_NONE;
+}
+
+/**
+ * @brief 엔진 작업 종료 후 소유권 반납 및 다음 작업 확인
+ */
+static void flash_log_finish(FlashLog *log) {
+    log->op = FLASH_LOG_OP_NONE;
+    atomic_flag_clear_explicit(&log->engine_busy, memory_order_release);
+    flash_log_kick(log);
+}
+
+/**
+ * @brief 엔진이 유휴이면 다음 작업 시작 (어느 문맥에서나 호출 가능)
+ */
+static void flash_log_kick(FlashLog *log) {
+    while (!atomic_flag_test_and_set_explicit(&log->engine_busy, memory_order_acquire)) {
+        FlashLogStart r = flash_log_start_next(log);
+        if (r == FLASH_LOG_START_OK) {
+            return;
+        }
+        atomic_flag_clear_explicit(&log->engine_busy, memory_order_release);
+
+        // 반납 직전에 생긴 일은 다시 확인 (실패는 다음 service로 미룸)
+        if (r == FLASH_LOG_START_FAILED || !flash_log_has_work(log)) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 기록 상태 초기화 (저장소 공통, addr부터 새 세션, 앞에 blocks개 블록이 있음)
+ */
+static void flash_log_reset(FlashLog *log, uint32_t start_addr, uint32_t addr, uint32_t end_addr,
+                            bool found, uint16_t last_session, uint32_t blocks, bool packed) {
+    for (uint8_t i = 0; i < FLASH_LOG_BUFFER_COUNT; i++) {
+        atomic_init(&log->buffer_state[i], FLASH_LOG_BUFFER_FREE);
+    }
+    log->active = 0;
+    log->fill = sizeof(FlashLogBlockHeader);
+    log->block_seq = 0;
+    log->session = found ? (uint16_t)(last_session + 1u) : 0u;
+    log->dropped = 0;
+
+    atomic_flag_clear(&log->engine_busy);
+    log->op = FLASH_LOG_OP_NONE;
+    log->flushing = -1;
+    log->page = 0;
+    log->write_addr = addr;
+    // 압축 모드 기록은 섹터 중간에서 끝날 수 있으며, 그 섹터의 나머지는 지워진 채로 남아 있음
+    log->erase_addr = (addr + QSPI_NOR_SECTOR_SIZE - 1u) / QSPI_NOR_SECTOR_SIZE * QSPI_NOR_SECTOR_SIZE;
+    log->erase_pending = log->erase_addr;
+    log->erase_target = addr;
+    log->erase_reserve = 0;
+    log->load = NULL;
+    log->erase_max_load = FLASH_LOG_DEFAULT_ERASE_MAX_LOAD;
+    log->erase_suspended = false;
+    log->start_addr = start_addr;
+    log->end_addr = end_addr;
+    log->stored_blocks = blocks;
+    log->session_block = blocks;
+
+    log->packed = packed;
+    log->seek_block = 0;
+    log->seek_addr = start_addr;
+
+    log->index_start = 0;
+    log->index_end = 0;
+    log->index_addr = 0;
+    log->index_fill = sizeof(FlashLogBlockHeader);
+    log->index_seq = 0;
+    log->index_interval = 0;
+    log->index_last_seq = FLASH_LOG_INDEX_NONE;
+    log->index_queued = 0;
+    log->index_dropped = 0;
+
+    log->blocks_written = 0;
+    log->packed_blocks = 0;
+    log->pack_raw_bytes = 0;
+    log->pack_stored_bytes = 0;
+    log->erase_suspends = 0;
+    log->erase_stalls = 0;
+    log->flash_errors = 0;
+    log->full = (addr >= end_addr);
+    log->initialized = true;
+}
+
+/**
+ * @brief 기록기 초기화
+ */
+bool flash_log_init(FlashLog *log, QspiNor *nor, uint32_t start_addr, uint32_t end_addr) {
+    if (log == NULL || nor == NULL || !nor->initialized) {
+        return false;
+    }
+    if (end_addr == 0) {
+        end_addr = nor->size;
+    }
+    if ((start_addr % FLASH_LOG_BUFFER_SIZE) != 0 || (end_addr % FLASH_LOG_BUFFER_SIZE) != 0 ||
+        start_addr >= end_addr || end_addr > nor->size) {
+        return false;
+    }
+
+    log->backend = FLASH_LOG_BACKEND_NOR;
+    log->nor = nor;
+    log->sd = NULL;
+    log->sd_first_lba = 0;
+    log->crc = NULL;
+    log->pack = NULL;
+    log->filter = NULL;
+    log->filter_context = NULL;
+    log->initialized = false;
+
+    // 이전 기록의 끝 찾기 (블록은 헤더로 시작하고 순서대로 기록됨, 다음 블록은 섹터 또는 페이지 뒤)
+    uint32_t addr = start_addr;
+    uint32_t blocks = 0;
+    bool found = false;
+    bool packed = false;
+    uint16_t last_session = 0;
+    while (addr < end_addr) {
+        FlashLogBlockHeader header;
+        if (!qspi_nor_read(nor, addr, (uint8_t *)&header, sizeof(header))) {
+            return false;
+        }
+        if (!flash_log_header_valid(&header)) {
+            break;
+        }
+        found = true;
+        packed = packed || flash_log_is_packed(&header);
+        last_session = header.session;
+        addr += flash_log_stored_size(&header);
+        blocks++;
+    }
+
+    flash_log_reset(log, start_addr, addr, end_addr, found, last_session, blocks, packed);
+
+    return true;
+}
+
+/**
+ * @brief SD 카드 블록 헤더 읽기 (버퍼 0을 임시로 사용, 초기화 중에만)
+ */
+static bool flash_log_sd_header(FlashLog *log, uint32_t block, FlashLogBlockHeader *header) {
+    if (!sd_card_read(log->sd, log->sd_first_lba + block * FLASH_LOG_SD_BLOCKS, log->buffer[0], 1)) {
+        return false;
+    }
+    memcpy(header, log->buffer[0], sizeof(*header));
+
+    return true;
+}
+
+/**
+ * @brief SD 카드 기록기 초기화
+ */
+bool flash_log_init_sd(FlashLog *log, SdCard *sd, const SdFile *file) {
+    if (log == NULL || sd == NULL || !sd->initialized || file == NULL) {
+        return false;
+    }
+
+    uint32_t blocks = file->block_count / FLASH_LOG_SD_BLOCKS;
+    if (blocks == 0 || file->first_lba >= sd->block_count ||
+        file->block_count > sd->block_count - file->first_lba) {
+        return false;
+    }
+
+    log->backend = FLASH_LOG_BACKEND_SD;
+    log->nor = NULL;
+    log->sd = sd;
+    log->sd_first_lba = file->first_lba;
+    log->crc = NULL;
+    log->pack = NULL;
+    log->filter = NULL;
+    log->filter_context = NULL;
+    log->initialized = false;
+
+    // 이전 기록의 끝: 헤더가 있는 블록은 파일 앞쪽에 연속으로 모여 있음
+    uint32_t lo = 0;
+    uint32_t hi = blocks;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2u;
+        FlashLogBlockHeader header;
+        if (!flash_log_sd_header(log, mid, &header)) {
+            return false;
+        }
+        if (header.magic == FLASH_LOG_MAGIC) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+
+    bool found = (lo > 0);
+    uint16_t last_session = 0;
+    if (found) {
+        FlashLogBlockHeader header;
+        if (!flash_log_sd_header(log, lo - 1u, &header)) {
+            return false;
+        }
+        last_session = header.session;
+    }
+
+    flash_log_reset(log, 0, lo * FLASH_LOG_BUFFER_SIZE, blocks * FLASH_LOG_BUFFER_SIZE, found, last_session, lo, false);
+
+    return true;
+}
+
+/**
+ * @brief 블록 CRC 주변장치 설정
+ */
+bool flash_log_set_crc(FlashLog *log, HwCrc *crc) {
+    if (log == NULL || !log->initialized) {
+        return false;
+    }
+
+    log->crc = crc;
+
+    return true;
+}
+
+/**
+ * @brief 레코드 거르기 콜백 설정
+ */
+bool flash_log_set_filter(FlashLog *log, FlashLogFilterFn filter, void *context) {
+    if (log == NULL || !log->initialized) {
+        return false;
+    }
+
+    log->filter = filter;
+    log->filter_context = context;
+
+    return true;
+}
+
+/**
+ * @brief 블록 압축 설정
+ */
+bool flash_log_set_compression(FlashLog *log, FlashLogPackWork *work) {
+    if (log == NULL || !log->initialized || log->backend != FLASH_LOG_BACKEND_NOR || !flash_log_idle(log)) {
+        return false;
+    }
+
+    log->pack = work;
+
+    return true;
+}
+
+/**
+ * @brief 봉인된 블록 압축 (기록 태스크 문맥, 압축 전 블록의 CRC를 먼저 계산)
+ *
+ * 압축해 한 페이지 이상 줄어들 때만 압축 블록으로 바꾸고, 아니면 표식만 바꿔 원본을 그대로 둔다.
+ */
+static void flash_log_pack(FlashLog *log, uint8_t i) {
+    uint8_t *buf = log->buffer[i];
+    FlashLogBlockHeader header = flash_log_buffer_header(log, i);
+    header.crc = hw_crc32(log->crc, &buf[FLASH_LOG_CRC_OFFSET], FLASH_LOG_BUFFER_SIZE - FLASH_LOG_CRC_OFFSET);
+    log->pack_raw_bytes += header.used;
+
+    uint16_t raw_pages = (uint16_t)((header.used + QSPI_NOR_PAGE_SIZE - 1u) / QSPI_NOR_PAGE_SIZE);
+    uint16_t body = (uint16_t)(header.used - sizeof(header));
+    uint16_t packed_len = 0;
+    header.magic = FLASH_LOG_PACKED_MAGIC;
+    if (raw_pages > 1u &&
+        log_lz_compress(&buf[sizeof(header)], body, log->pack->out,
+                        (uint16_t)((raw_pages - 1u) * QSPI_NOR_PAGE_SIZE - sizeof(header)),
+                        log->pack->table, &packed_len)) {
+        memcpy(&buf[sizeof(header)], log->pack->out, packed_len);
+        memset(&buf[sizeof(header) + packed_len], 0xFF, body - packed_len);
+        header.magic = FLASH_LOG_LZ_MAGIC;
+        header.used = (uint16_t)(sizeof(header) + packed_len);
+        log->packed_blocks++;
+    }
+    memcpy(buf, &header, sizeof(header));
+    log->pack_stored_bytes += flash_log_stored_size(&header);
+
+    flash_log_set_state(log, i, FLASH_LOG_BUFFER_FULL);
+}
+
+/**
+ * @brief 사전 지우기 목표 설정
+ */
+bool flash_log_pre_erase(FlashLog *log, uint32_t bytes) {
+    if (log == NULL || !log->initialized) {
+        return false;
+    }
+
+    flash_log_raise_erase_target(log, bytes);
+
+    return true;
+}
+
+/**
+ * @brief 사전 지우기 완료 여부
+ */
+bool flash_log_pre_erase_done(const FlashLog *log) {
+    return log != NULL && log->initialized && log->erase_addr >= log->erase_target;
+}
+
+/**
+ * @brief 예비 지움 영역 설정
+ */
+bool flash_log_set_erase_reserve(FlashLog *log, uint32_t bytes) {
+    if (log == NULL || !log->initialized) {
+        return false;
+    }
+
+    log->erase_reserve = bytes;
+    flash_log_raise_erase_target(log, bytes);
+
+    return true;
+}
+
+/**
+ * @brief 배경 지우기 부하 조건 설정
+ */
+bool flash_log_set_erase_gate(FlashLog *log, const FusionMonitor *load, uint16_t max_load) {
+    if (log == NULL || !log->initialized) {
+        return false;
+    }
+
+    log->load = load;
+    log->erase_max_load = (max_load != 0) ? max_load : FLASH_LOG_DEFAULT_ERASE_MAX_LOAD;
+
+    return true;
+}
+
+/**
+ * @brief 활성 버퍼를 블록으로 마감하고 다른 버퍼로 교체
+ */
+static bool flash_log_seal(FlashLog *log) {
+    uint8_t next = (uint8_t)(log->active ^ 1u);
+    if (flash_log_state(log, next) != FLASH_LOG_BUFFER_FREE) {
+        return false;
+    }
+
+    uint8_t *buf = log->buffer[log->active];
+    FlashLogBlockHeader header = {
+        .magic = FLASH_LOG_MAGIC,
+        .crc = 0,
+        .seq = log->block_seq++,
+        .session = log->session,
+        .used = log->fill
+    };
+    memcpy(buf, &header, sizeof(header));
+    memset(&buf[log->fill], FLASH_LOG_END_TYPE, FLASH_LOG_BUFFER_SIZE - log->fill);
+
+    // 압축 모드이면 기록 태스크(flash_log_service)가 압축한 뒤 엔진에 넘김
+    flash_log_set_state(log, log->active, (log->pack != NULL) ? FLASH_LOG_BUFFER_SEALED : FLASH_LOG_BUFFER_FULL);
+    log->active = next;
+    log->fill = sizeof(FlashLogBlockHeader);
+
+    flash_log_kick(log);
+
+    return true;
+}
+
+/**
+ * @brief 채우던 색인 블록을 기록 대기로 넘김 (작성자 문맥)
+ */
+static bool flash_log_index_seal(FlashLog *log) {
+    if (flash_log_state(log, FLASH_LOG_INDEX_SLOT) != FLASH_LOG_BUFFER_FREE) {
+        return false;
+    }
+    if (log->index_fill == sizeof(FlashLogBlockHeader)) {
+        return true;
+    }
+
+    uint8_t *buf = log->buffer[FLASH_LOG_INDEX_SLOT];
+    FlashLogBlockHeader header = {
+        .magic = FLASH_LOG_INDEX_MAGIC,
+        .crc = 0,
+        .seq = log->index_seq++,
+        .session = log->session,
+        .used = log->index_fill
+    };
+    memcpy(buf, &header, sizeof(header));
+    memset(&buf[log->index_fill], 0xFF, FLASH_LOG_BUFFER_SIZE - log->index_fill);
+
+    flash_log_set_state(log, FLASH_LOG_INDEX_SLOT, FLASH_LOG_BUFFER_FULL);
+    log->index_fill = sizeof(FlashLogBlockHeader);
+
+    flash_log_kick(log);
+
+    return true;
+}
+
+/**
+ * @brief 색인 항목을 색인 블록에 복사 (버퍼가 비어 있을 때, 차면 봉인)
+ */
+static bool flash_log_index_put(FlashLog *log, const FlashLogIndexEntry *entry) {
+    if (log->index_fill + sizeof(*entry) > FLASH_LOG_BUFFER_SIZE &&
+        (!flash_log_index_seal(log) || flash_log_state(log, FLASH_LOG_INDEX_SLOT) != FLASH_LOG_BUFFER_FREE)) {
+        return false;
+    }
+
+    memcpy(&log->buffer[FLASH_LOG_INDEX_SLOT][log->index_fill], entry, sizeof(*entry));
+    log->index_fill = (uint16_t)(log->index_fill + sizeof(*entry));
+
+    return true;
+}
+
+/**
+ * @brief 대기 항목을 색인 블록으로 옮김 (색인 블록이 기록 중이면 그대로 둠)
+ */
+static void flash_log_index_drain(FlashLog *log) {
+    uint8_t n = 0;
+    while (n < log->index_queued && flash_log_state(log, FLASH_LOG_INDEX_SLOT) == FLASH_LOG_BUFFER_FREE &&
+           flash_log_index_put(log, &log->index_queue[n])) {
+        n++;
+    }
+    if (n > 0) {
+        log->index_queued = (uint8_t)(log->index_queued - n);
+        memmove(&log->index_queue[0], &log->index_queue[n], log->index_queued * sizeof(log->index_queue[0]));
+    }
+}
+
+/**
+ * @brief 색인 항목 추가 (채우는 데이터 블록을 가리킴)
+ */
+static bool flash_log_index_add(FlashLog *log, uint8_t kind, uint8_t arg, uint32_t timestamp_us, uint32_t value) {
+    if (log == NULL || !log->initialized || log->index_end == 0) {
+        return false;
+    }
+
+    FlashLogIndexEntry entry = {
+        .timestamp_us = timestamp_us,
+        .block = log->session_block + log->block_seq,
+        .value = value,
+        .session = log->session,
+        .kind = kind,
+        .arg = arg
+    };
+
+    // 색인 블록이 기록 중이면 대기열에 두고, 대기열도 차면 버림 (데이터 기록은 기다리지 않음)
+    flash_log_index_drain(log);
+    if (log->index_queued == 0 && flash_log_state(log, FLASH_LOG_INDEX_SLOT) == FLASH_LOG_BUFFER_FREE &&
+        flash_log_index_put(log, &entry)) {
+        return true;
+    }
+    if (log->index_queued < FLASH_LOG_INDEX_QUEUE) {
+        log->index_queue[log->index_queued++] = entry;
+        return true;
+    }
+    log->index_dropped++;
+
+    return false;
+}
+
+/**
+ * @brief 색인 영역 설정
+ */
+bool flash_log_set_index(FlashLog *log, uint32_t index_blocks, uint32_t interval_blocks) {
+    if (log == NULL || !log->initialized || log->index_end != 0 || index_blocks == 0 ||
+        log->op != FLASH_LOG_OP_NONE || log->erase_target != log->write_addr) {
+        return false;
+    }
+    if (interval_blocks == 0) {
+        interval_blocks = FLASH_LOG_DEFAULT_INDEX_INTERVAL;
+    }
+
+    // 색인 영역은 기록 영역 끝에서 떼어 냄 (이전 데이터 블록이 들어가 있으면 안 됨)
+    uint32_t blocks = (log->end_addr - log->start_addr) / FLASH_LOG_BUFFER_SIZE;
+    if (index_blocks >= blocks) {
+        return false;
+    }
+    uint32_t index_start = log->end_addr - index_blocks * FLASH_LOG_BUFFER_SIZE;
+    if (log->write_addr > index_start) {
+        return false;
+    }
+
+    // 이전 색인의 끝 찾기 (색인 블록도 순서대로 기록됨)
+    uint32_t addr = index_start;
+    while (addr < log->end_addr) {
+        FlashLogBlockHeader header;
+        bool ok;
+        if (log->backend == FLASH_LOG_BACKEND_SD) {
+            ok = flash_log_sd_header(log, addr / FLASH_LOG_BUFFER_SIZE, &header);
+        } else {
+            ok = qspi_nor_read(log->nor, addr, (uint8_t *)&header, sizeof(header));
+        }
+        if (!ok) {
+            return false;
+        }
+        if (header.magic != FLASH_LOG_INDEX_MAGIC) {
+            break;
+        }
+        addr += FLASH_LOG_BUFFER_SIZE;
+    }
+
+    log->index_start = index_start;
+    log->index_addr = addr;
+    log->index_end = log->end_addr;
+    log->index_interval = interval_blocks;
+    log->end_addr = index_start;
+    log->full = (log->write_addr >= log->end_addr);
+
+    return true;
+}
+
+/**
+ * @brief 주기 시각 색인
+ */
+bool flash_log_index_time(FlashLog *log, uint32_t timestamp_us) {
+    if (log == NULL || !log->initialized || log->index_end == 0) {
+        return false;
+    }
+    if (log->index_last_seq != FLASH_LOG_INDEX_NONE &&
+        log->block_seq - log->index_last_seq < log->index_interval) {
+        if (log->index_queued > 0) {
+            flash_log_index_drain(log);
+        }
+        return true;
+    }
+
+    if (!flash_log_index_add(log, FLASH_LOG_INDEX_TIME, 0, timestamp_us, 0)) {
+        return false;
+    }
+    log->index_last_seq = log->block_seq;
+
+    return true;
+}
+
+/**
+ * @brief 비행 이벤트 색인 (바로 기록 대기로 넘김)
+ */
+bool flash_log_index_event(FlashLog *log, const FlightEvent *event) {
+    if (event == NULL || !flash_log_index_add(log, FLASH_LOG_INDEX_EVENT, (uint8_t)event->type,
+                                              event->onset_us, event->timestamp_us)) {
+        return false;
+    }
+
+    flash_log_index_seal(log);
+
+    return true;
+}
+
+/**
+ * @brief 비행 단계 변경 색인
+ */
+bool flash_log_index_phase(FlashLog *log, FlightPhase phase, uint32_t timestamp_us) {
+    return flash_log_index_add(log, FLASH_LOG_INDEX_PHASE, (uint8_t)phase, timestamp_us, 0);
+}
+
+/**
+ * @brief 레코드 쓰기
+ */
+bool flash_log_write(FlashLog *log, uint8_t type, const void *payload, uint8_t len) {
+    if (log == NULL || !log->initialized || type == FLASH_LOG_END_TYPE || (payload == NULL && len > 0)) {
+        return false;
+    }
+    if (log->filter != NULL && !log->filter(log->filter_context, type, payload, len)) {
+        return true;
+    }
+    if (log->full) {
+        log->dropped++;
+        return false;
+    }
+
+    uint16_t need = (uint16_t)(FLASH_LOG_RECORD_HEADER + len);
+    if (log->fill + need > FLASH_LOG_BUFFER_SIZE && !flash_log_seal(log)) {
+        log->dropped++;
+        return false;
+    }
+
+    uint8_t *p = &log->buffer[log->active][log->fill];
+    p[0] = type;
+    p[1] = len;
+    if (len > 0) {
+        memcpy(&p[FLASH_LOG_RECORD_HEADER], payload, len);
+    }
+    log->fill = (uint16_t)(log->fill + need);
+
+    return true;
+}
+
+/**
+ * @brief 현재 블록에 레코드들이 들어가는지
+ */
+bool flash_log_fits(const FlashLog *log, uint16_t bytes) {
+    return log != NULL && (uint32_t)log->fill + bytes <= FLASH_LOG_BUFFER_SIZE;
+}
+
+/**
+ * @brief 채우는 블록의 순번
+ */
+uint32_t flash_log_block(const FlashLog *log) {
+    return (log != NULL) ? log->block_seq : 0;
+}
+
+/**
+ * @brief IMU 샘플 기록
+ */
+bool flash_log_imu(FlashLog *log, const ImuSample *sample) {
+    if (sample == NULL) {
+        return false;
+    }
+
+    FlashLogImuRecord rec = {
+        .timestamp_us = sample->timestamp_us,
+        .gyro = { sample->gyro.x, sample->gyro.y, sample->gyro.z },
+        .accel = { sample->accel.x, sample->accel.y, sample->accel.z }
+    };
+
+    return flash_log_write(log, FLASH_LOG_REC_IMU, &rec, sizeof(rec));
+}
+
+/**
+ * @brief 기압 기록
+ */
+bool flash_log_baro(FlashLog *log, uint32_t timestamp_us, float pressure_pa, float temp_c) {
+    FlashLogBaroRecord rec = {
+        .timestamp_us = timestamp_us,
+        .pressure_pa = pressure_pa,
+        .temp_c = temp_c
+    };
+
+    return flash_log_write(log, FLASH_LOG_REC_BARO, &rec, sizeof(rec));
+}
+
+/**
+ * @brief 자기장 기록
+ */
+bool flash_log_mag(FlashLog *log, uint32_t timestamp_us, Vector3f field) {
+    FlashLogMagRecord rec = {
+        .timestamp_us = timestamp_us,
+        .field = { field.x, field.y, field.z }
+    };
+
+    return flash_log_write(log, FLASH_LOG_REC_MAG, &rec, sizeof(rec));
+}
+
+/**
+ * @brief GNSS 해 기록
+ */
+bool flash_log_gnss(FlashLog *log, const UbxGnssFix *fix) {
+    if (fix == NULL) {
+        return false;
+    }
+
+    FlashLogGnssRecord rec = {
+        .timestamp_us = fix->timestamp_us,
+        .itow_ms = fix->itow_ms,
+        .lat_e7 = fix->lat_e7,
+        .lon_e7 = fix->lon_e7,
+        .height_mm = fix->height_mm,
+        .hmsl_mm = fix->hmsl_mm,
+        .vel_ned = { fix->vel_ned.x, fix->vel_ned.y, fix->vel_ned.z },
+        .h_acc = fix->h_acc,
+        .v_acc = fix->v_acc,
+        .s_acc = fix->s_acc,
+        .fix_type = fix->fix_type,
+        .num_sv = fix->num_sv,
+        .flags = (uint8_t)((fix->fix_ok ? 0x01u : 0u) | (fix->pulse_locked ? 0x02u : 0u)),
+        .reserved = 0
+    };
+
+    return flash_log_write(log, FLASH_LOG_REC_GNSS, &rec, sizeof(rec));
+}
+
+/**
+ * @brief 항법 해 기록
+ */
+bool flash_log_nav(FlashLog *log, const EKF_NavSolution *sol) {
+    if (sol == NULL) {
+        return false;
+    }
+
+    return flash_log_write(log, FLASH_LOG_REC_NAV, sol, (uint8_t)sizeof(*sol));
+}
+
+/**
+ * @brief 수렴/준비 상태 기록
+ */
+bool flash_log_ready(FlashLog *log, const ConvergenceMonitor *mon) {
+    if (mon == NULL) {
+        return false;
+    }
+
+    FlashLogReadyRecord rec = {
+        .timestamp_us = mon->last_us,
+        .ready_us = mon->stats.ready_us,
+        .converged = mon->converged_mask,
+        .ready = mon->ready ? 1u : 0u
+    };
+    for (uint8_t b = 0; b < CONVERGENCE_BLOCK_COUNT; b++) {
+        rec.converged_us[b] = mon->stats.block[b].converged_us;
+    }
+
+    return flash_log_write(log, FLASH_LOG_REC_READY, &rec, sizeof(rec));
+}
+
+/**
+ * @brief 채우던 버퍼를 기록 대기로 넘김
+ */
+bool flash_log_sync(FlashLog *log) {
+    if (log == NULL || !log->initialized) {
+        return false;
+    }
+
+    bool index_ok = true;
+    if (log->index_end != 0) {
+        flash_log_index_drain(log);
+        index_ok = flash_log_index_seal(log) && log->index_queued == 0;
+    }
+    if (log->fill == sizeof(FlashLogBlockHeader)) {
+        return index_ok;
+    }
+
+    return flash_log_seal(log) && index_ok;
+}
+
+/**
+ * @brief 배경 지우기 중에 데이터 블록이 차 있으면 지우기를 일시 중지하고 블록 기록 시작
+ */
+static void flash_log_preempt_erase(FlashLog *log) {
+    if (log->backend != FLASH_LOG_BACKEND_NOR || log->nor->suspend_cmd == 0 ||
+        log->op != FLASH_LOG_OP_ERASE || log->flushing >= 0) {
+        return;
+    }
+    int8_t i = flash_log_pending(log);
+    if (i < 0 || !flash_log_fits_erased(log, (uint8_t)i)) {
+        return;
+    }
+
+    // 지우기 완료 인터럽트와 겹치지 않게 QUADSPI 인터럽트만 막고 다시 확인
+    uint32_t enabled = NVIC_GetEnableIRQ(QUADSPI_IRQn);
+    HAL_NVIC_DisableIRQ(QUADSPI_IRQn);
+    if (log->op == FLASH_LOG_OP_ERASE && log->flushing < 0) {
+        if (qspi_nor_erase_suspend(log->nor)) {
+            log->op = FLASH_LOG_OP_NONE;
+            log->erase_suspended = true;
+            log->erase_suspends++;
+
+            // 엔진 소유권은 지우기에서 그대로 이어받음
+            if (flash_log_start_next(log) != FLASH_LOG_START_OK) {
+                atomic_flag_clear_explicit(&log->engine_busy, memory_order_release);
+            }
+        } else if (!qspi_nor_erase_resume(log->nor) || !qspi_nor_wait_ready_it(log->nor)) {
+            // 중지 실패: 늦게 멈췄을 수도 있으므로 재개 명령 뒤 완료 폴링을 다시 걸고, 안 되면 오류 처리
+            flash_log_handle_error(log);
+        } else {
+            log->flash_errors++;
+        }
+    }
+    if (enabled != 0u) {
+        HAL_NVIC_EnableIRQ(QUADSPI_IRQn);
+    }
+}
+
+/**
+ * @brief 기록 엔진 진행
+ */
+void flash_log_service(FlashLog *log) {
+    if (log == NULL || !log->initialized) {
+        return;
+    }
+    TRACE_BEGIN(TRACE_EVENT_LOG_SERVICE);
+
+    // 압축 대기 블록을 순번 순서로 압축 (둘 다 봉인돼 있으면 앞선 블록부터)
+    if (log->pack != NULL) {
+        for (uint8_t n = 0; n < FLASH_LOG_INDEX_SLOT; n++) {
+            int8_t next = -1;
+            for (uint8_t i = 0; i < FLASH_LOG_INDEX_SLOT; i++) {
+                if (flash_log_state(log, i) == FLASH_LOG_BUFFER_SEALED &&
+                    (next < 0 || flash_log_buffer_header(log, i).seq < flash_log_buffer_header(log, (uint8_t)next).seq)) {
+                    next = (int8_t)i;
+                }
+            }
+            if (next >= 0) {
+                flash_log_pack(log, (uint8_t)next);
+            }
+        }
+    }
+
+    flash_log_preempt_erase(log);
+
+    // SD 카드는 쓰기/지우기 완료 인터럽트가 없으므로 카드 상태로 완료를 확인
+    if (log->backend == FLASH_LOG_BACKEND_SD) {
+        FlashLogOp op = log->op;
+        if ((op == FLASH_LOG_OP_ERASE || op == FLASH_LOG_OP_PROGRAM_WAIT) && sd_card_ready(log->sd)) {
+            flash_log_handle_status_match(log);
+        }
+    }
+
+    flash_log_kick(log);
+    TRACE_END(TRACE_EVENT_LOG_SERVICE);
+}
+
+/**
+ * @brief 기록 엔진 유휴 여부
+ */
+bool flash_log_idle(const FlashLog *log) {
+    if (log == NULL || !log->initialized) {
+        return true;
+    }
+
+    if (log->op != FLASH_LOG_OP_NONE || log->erase_suspended) {
+        return false;
+    }
+    for (uint8_t i = 0; i < FLASH_LOG_BUFFER_COUNT; i++) {
+        if (flash_log_state(log, i) != FLASH_LOG_BUFFER_FREE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 저장된 블록 수
+ */
+uint32_t flash_log_block_count(const FlashLog *log) {
+    if (log == NULL || !log->initialized) {
+        return 0;
+    }
+
+    return log->stored_blocks;
+}
+
+/**
+ * @brief NOR 읽기 (메모리 매핑 중이면 매핑을 유지한 채 복사)
+ */
+static bool flash_log_nor_read(FlashLog *log, uint32_t addr, uint8_t *data, uint32_t len) {
+    if (log->nor->mapped) {
+        memcpy(data, (const uint8_t *)QSPI_NOR_MAP_BASE + addr, len);
+        return true;
+    }
+
+    return qspi_nor_read(log->nor, addr, data, len);
+}
+
+/**
+ * @brief 저장소의 블록 하나 읽기 (주소는 블록 정렬)
+ */
+static bool flash_log_read_at(FlashLog *log, uint32_t addr, uint8_t *data) {
+    if (log->backend == FLASH_LOG_BACKEND_SD) {
+        return sd_card_read(log->sd, log->sd_first_lba + addr / SD_CARD_BLOCK_SIZE, data, FLASH_LOG_SD_BLOCKS);
+    }
+
+    return flash_log_nor_read(log, addr, data, FLASH_LOG_BUFFER_SIZE);
+}
+
+/**
+ * @brief 저장소의 블록 하나 매핑 (NOR, 주소는 블록 정렬)
+ */
+static const uint8_t *flash_log_map_at(FlashLog *log, uint32_t addr) {
+    if (log->backend != FLASH_LOG_BACKEND_NOR) {
+        return NULL;
+    }
+
+    const uint8_t *base = qspi_nor_map(log->nor);
+
+    return (base != NULL) ? base + addr : NULL;
+}
+
+/**
+ * @brief 저장된 블록의 주소와 헤더 (압축 모드 블록이 있으면 마지막 위치부터 헤더를 따라감)
+ */
+static bool flash_log_locate(FlashLog *log, uint32_t block, uint32_t *addr, FlashLogBlockHeader *header) {
+    if (!log->packed) {
+        *addr = log->start_addr + block * FLASH_LOG_BUFFER_SIZE;
+        return log->backend == FLASH_LOG_BACKEND_SD || flash_log_nor_read(log, *addr, (uint8_t *)header, sizeof(*header));
+    }
+
+    if (block < log->seek_block) {
+        log->seek_block = 0;
+        log->seek_addr = log->start_addr;
+    }
+    for (;;) {
+        if (!flash_log_nor_read(log, log->seek_addr, (uint8_t *)header, sizeof(*header)) ||
+            !flash_log_header_valid(header)) {
+            return false;
+        }
+        if (log->seek_block == block) {
+            break;
+        }
+        log->seek_addr += flash_log_stored_size(header);
+        log->seek_block++;
+    }
+    *addr = log->seek_addr;
+
+    return true;
+}
+
+/**
+ * @brief 저장된 블록 하나 읽기
+ */
+bool flash_log_read_block(FlashLog *log, uint32_t block, uint8_t *data) {
+    if (log == NULL || data == NULL || block >= flash_log_block_count(log) || !flash_log_idle(log)) {
+        return false;
+    }
+
+    uint32_t addr;
+    FlashLogBlockHeader header;
+    if (!flash_log_locate(log, block, &addr, &header)) {
+        return false;
+    }
+    if (log->backend == FLASH_LOG_BACKEND_SD || !flash_log_is_packed(&header)) {
+        return flash_log_read_at(log, addr, data);
+    }
+
+    // 압축 블록은 매핑한 저장 내용에서 바로 풀어 냄
+    if (header.magic == FLASH_LOG_LZ_MAGIC) {
+        const uint8_t *stored = flash_log_map_at(log, addr);
+        return stored != NULL && flash_log_unpack_block(stored, data);
+    }
+
+    if (!flash_log_nor_read(log, addr, data, header.used)) {
+        return false;
+    }
+    memset(&data[header.used], FLASH_LOG_END_TYPE, FLASH_LOG_BUFFER_SIZE - header.used);
+    header.magic = FLASH_LOG_MAGIC;
+    memcpy(data, &header.magic, sizeof(header.magic));
+
+    return true;
+}
+
+/**
+ * @brief 압축 모드 블록을 원래 블록으로 풀기
+ */
+bool flash_log_unpack_block(const uint8_t *stored, uint8_t *data) {
+    if (stored == NULL || data == NULL) {
+        return false;
+    }
+
+    FlashLogBlockHeader header;
+    memcpy(&header, stored, sizeof(header));
+    if (!flash_log_header_valid(&header)) {
+        return false;
+    }
+
+    uint16_t body = (uint16_t)(header.used - sizeof(header));
+    if (header.magic == FLASH_LOG_LZ_MAGIC) {
+        if (!log_lz_decompress(&stored[sizeof(header)], body, &data[sizeof(header)],
+                               FLASH_LOG_BUFFER_SIZE - sizeof(header), &body)) {
+            return false;
+        }
+    } else {
+        memcpy(&data[sizeof(header)], &stored[sizeof(header)], body);
+    }
+    header.magic = FLASH_LOG_MAGIC;
+    header.used = (uint16_t)(sizeof(header) + body);
+    memcpy(data, &header, sizeof(header));
+    memset(&data[header.used], FLASH_LOG_END_TYPE, FLASH_LOG_BUFFER_SIZE - header.used);
+
+    return true;
+}
+
+/**
+ * @brief 저장된 블록 하나 매핑
+ */
+const uint8_t *flash_log_map_block(FlashLog *log, uint32_t block) {
+    if (log == NULL || block >= flash_log_block_count(log) || !flash_log_idle(log) ||
+        log->backend != FLASH_LOG_BACKEND_NOR) {
+        return NULL;
+    }
+
+    uint32_t addr;
+    FlashLogBlockHeader header;
+    if (!flash_log_locate(log, block, &addr, &header) || header.magic == FLASH_LOG_LZ_MAGIC) {
+        return NULL;
+    }
+
+    return flash_log_map_at(log, addr);
+}
+
+/**
+ * @brief 블록의 다음 레코드
+ */
+const uint8_t *flash_log_next_record(const uint8_t *block, uint16_t *offset, uint8_t *type, uint8_t *len) {
+    if (block == NULL || offset == NULL || type == NULL || len == NULL) {
+        return NULL;
+    }
+
+    FlashLogBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+    if (header.magic == FLASH_LOG_LZ_MAGIC) {
+        return NULL;
+    }
+    uint16_t used = (header.used <= FLASH_LOG_BUFFER_SIZE) ? header.used : (uint16_t)FLASH_LOG_BUFFER_SIZE;
+
+    uint16_t at = (*offset < sizeof(FlashLogBlockHeader)) ? (uint16_t)sizeof(FlashLogBlockHeader) : *offset;
+    if (at + FLASH_LOG_RECORD_HEADER > used || block[at] == FLASH_LOG_END_TYPE) {
+        return NULL;
+    }
+
+    // 길이가 사용 영역을 넘으면 손상된 블록으로 보고 끝냄
+    uint16_t next = (uint16_t)(at + FLASH_LOG_RECORD_HEADER + block[at + 1u]);
+    if (next > used) {
+        return NULL;
+    }
+    *type = block[at];
+    *len = block[at + 1u];
+    *offset = next;
+
+    return &block[at + FLASH_LOG_RECORD_HEADER];
+}
+
+/**
+ * @brief 저장된 색인 블록 수
+ */
+uint32_t flash_log_index_block_count(const FlashLog *log) {
+    if (log == NULL || !log->initialized || log->index_end == 0) {
+        return 0;
+    }
+
+    return (log->index_addr - log->index_start) / FLASH_LOG_BUFFER_SIZE;
+}
+
+/**
+ * @brief 저장된 색인 블록 하나 읽기
+ */
+bool flash_log_read_index_block(FlashLog *log, uint32_t block, uint8_t *data) {
+    if (log == NULL || data == NULL || block >= flash_log_index_block_count(log) || !flash_log_idle(log)) {
+        return false;
+    }
+
+    return flash_log_read_at(log, log->index_start + block * FLASH_LOG_BUFFER_SIZE, data);
+}
+
+/**
+ * @brief 저장된 색인 블록 하나 매핑
+ */
+const uint8_t *flash_log_map_index_block(FlashLog *log, uint32_t block) {
+    if (log == NULL || block >= flash_log_index_block_count(log) || !flash_log_idle(log)) {
+        return NULL;
+    }
+
+    return flash_log_map_at(log, log->index_start + block * FLASH_LOG_BUFFER_SIZE);
+}
+
+/**
+ * @brief 기록 세션 색인 만들기
+ */
+bool flash_log_build_index(FlashLog *log, uint8_t *scratch, FlashLogSession *sessions,
+                           uint8_t max_sessions, uint8_t *count) {
+    if (log == NULL || scratch == NULL || sessions == NULL || max_sessions == 0 || count == NULL ||
+        !flash_log_idle(log)) {
+        return false;
+    }
+
+    uint32_t blocks = flash_log_block_count(log);
+    uint32_t addr = log->start_addr;
+    uint8_t n = 0;
+    FlashLogBlockHeader header;
+    for (uint32_t block = 0; block < blocks; block++, addr += flash_log_stored_size(&header)) {
+        if (log->backend == FLASH_LOG_BACKEND_SD) {
+            if (!sd_card_read(log->sd, log->sd_first_lba + addr / SD_CARD_BLOCK_SIZE, scratch, 1)) {
+                return false;
+            }
+            memcpy(&header, scratch, sizeof(header));
+        } else if (!flash_log_nor_read(log, addr, (uint8_t *)&header, sizeof(header))) {
+            return false;
+        }
+        if (!flash_log_header_valid(&header)) {
+            break;
+        }
+
+        FlashLogSession *last = (n > 0) ? &sessions[n - 1u] : NULL;
+        if (last != NULL && last->session == header.session) {
+            last->block_count++;
+            last->last_seq = header.seq;
+            continue;
+        }
+
+        // 배열이 차면 가장 오래된 세션을 버림
+        if (n == max_sessions) {
+            memmove(&sessions[0], &sessions[1], (size_t)(n - 1u) * sizeof(sessions[0]));
+            n--;
+        }
+        sessions[n].session = header.session;
+        sessions[n].reserved = 0;
+        sessions[n].first_block = block;
+        sessions[n].block_count = 1;
+        sessions[n].last_seq = header.seq;
+        n++;
+    }
+    *count = n;
+
+    return true;
+}
+
+/**
+ * @brief 페이지 데이터 DMA 전송 완료 처리
+ */
+void flash_log_handle_tx_complete(FlashLog *log) {
+    if (log == NULL || log->op != FLASH_LOG_OP_PROGRAM_DATA) {
+        return;
+    }
+
+    log->op = FLASH_LOG_OP_PROGRAM_WAIT;
+    if (log->backend == FLASH_LOG_BACKEND_NOR && !qspi_nor_wait_ready_it(log->nor)) {
+        flash_log_handle_error(log);
+    }
+}
+
+/**
+ * @brief 쓰기/지우기 완료 처리
+ */
+void flash_log_handle_status_match(FlashLog *log) {
+    if (log == NULL) {
+        return;
+    }
+
+    if (log->op == FLASH_LOG_OP_ERASE) {
+        if (log->flushing != (int8_t)FLASH_LOG_INDEX_SLOT) {
+            log->erase_addr = log->erase_pending;
+        }
+    } else if (log->op == FLASH_LOG_OP_PROGRAM_WAIT) {
+        log->page++;
+    } else {
+        return;
+    }
+
+    if (log->flushing >= 0) {
+        if (log->page < flash_log_page_count(log)) {
+            if (!flash_log_program_page(log)) {
+                flash_log_handle_error(log);
+            }
+            return;
+        }
+
+        // 블록 기록 완료
+        uint8_t done = (uint8_t)log->flushing;
+        if (done == FLASH_LOG_INDEX_SLOT) {
+            log->index_addr += FLASH_LOG_BUFFER_SIZE;
+        } else {
+            FlashLogBlockHeader header = flash_log_buffer_header(log, done);
+            log->write_addr += flash_log_stored_size(&header);
+            log->packed = log->packed || flash_log_is_packed(&header);
+            log->stored_blocks++;
+            log->blocks_written++;
+            if (log->erase_reserve != 0) {
+                flash_log_raise_erase_target(log, log->erase_reserve);
+            }
+        }
+        log->flushing = -1;
+        flash_log_set_state(log, done, FLASH_LOG_BUFFER_FREE);
+        TRACE_END(TRACE_EVENT_LOG_FLUSH);
+    }
+
+    flash_log_finish(log);
+}
+
+/**
+ * @brief 전송 오류 처리
+ */
+void flash_log_handle_error(FlashLog *log) {
+    if (log == NULL || log->op == FLASH_LOG_OP_NONE) {
+        return;
+    }
+
+    log->flash_errors++;
+
+    // 블록은 처음부터 다시 기록 (이미 쓴 페이지에 같은 값을 다시 써도 NOR 내용은 그대로)
+    if (log->flushing >= 0) {
+        flash_log_set_state(log, (uint8_t)log->flushing, FLASH_LOG_BUFFER_FULL);
+        log->flushing = -1;
+    }
+    log->erase_pending = log->erase_addr;
+
+    // 다음 service에서 다시 시도 (인터럽트 안에서 실패를 반복하지 않음)
+    log->op = FLASH_LOG_OP_NONE;
+    atomic_flag_clear_explicit(&log->engine_busy, memory_order_release);
+}
@@ -0,0 +1,276 @@
+/**
+ * @file log_codec.c
+ * @brief 압축 기록 스트림 구현
+ */
+
+#include "log/log_codec.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 양자화 값 범위 (float로 정확히 표현되는 int32 한계 안쪽)
+ */
+#define LOG_CODEC_QUANT_LIMIT 2147483520.0f
+
+/**
+ * @brief 고정소수점 양자화 (범위 밖은 제한, NaN은 0)
+ */
+static int32_t log_codec_quantize(float v, float inv_scale) {
+    float r = v * inv_scale;
+    if (r != r) {
+        return 0;
+    }
+    if (r > LOG_CODEC_QUANT_LIMIT) {
+        r = LOG_CODEC_QUANT_LIMIT;
+    } else if (r < -LOG_CODEC_QUANT_LIMIT) {
+        r = -LOG_CODEC_QUANT_LIMIT;
+    }
+
+    return (int32_t)lrintf(r);
+}
+
+/**
+ * @brief 스트림 초기화
+ */
+bool log_stream_init(LogStream *stream, uint8_t id, const char *name, uint8_t field_count,
+                     const float *scale, uint16_t keyframe_interval) {
+    if (stream == NULL || name == NULL || scale == NULL || field_count == 0 ||
+        field_count > LOG_CODEC_MAX_FIELDS || keyframe_interval == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < field_count; i++) {
+        if (!(scale[i] > 0.0f)) {
+            return false;
+        }
+    }
+
+    memset(stream, 0, sizeof(*stream));
+    stream->id = id;
+    stream->field_count = field_count;
+    stream->keyframe_interval = keyframe_interval;
+    strncpy(stream->name, name, LOG_CODEC_NAME_SIZE);
+    for (uint8_t i = 0; i < field_count; i++) {
+        stream->scale[i] = scale[i];
+        stream->inv_scale[i] = 1.0f / scale[i];
+    }
+
+    return true;
+}
+
+/**
+ * @brief 스키마 레코드 페이로드 작성
+ */
+uint8_t log_stream_schema(const LogStream *stream, uint8_t *p) {
+    uint8_t n = 0;
+    p[n++] = stream->id;
+    p[n++] = stream->field_count;
+    p[n++] = (uint8_t)(stream->keyframe_interval & 0xFFu);
+    p[n++] = (uint8_t)(stream->keyframe_interval >> 8);
+    memcpy(&p[n], stream->name, LOG_CODEC_NAME_SIZE);
+    n += LOG_CODEC_NAME_SIZE;
+    memcpy(&p[n], stream->scale, 4u * stream->field_count);
+    n = (uint8_t)(n + 4u * stream->field_count);
+
+    return n;
+}
+
+/**
+ * @brief 키프레임 페이로드 작성
+ */
+static uint8_t log_codec_key(const LogStream *stream, uint32_t timestamp_us, const int32_t *q, uint8_t *rec) {
+    uint8_t len = 0;
+    rec[len++] = stream->id;
+    len += log_format_put_varint(&rec[len], timestamp_us);
+    for (uint8_t i = 0; i < stream->field_count; i++) {
+        len += log_format_put_varint(&rec[len], log_format_zigzag((uint32_t)q[i]));
+    }
+
+    return len;
+}
+
+/**
+ * @brief 차분 페이로드 작성
+ */
+static uint8_t log_codec_delta(const LogStream *stream, uint32_t timestamp_us, const int32_t *q, uint8_t *rec) {
+    uint8_t len = 0;
+    uint32_t dt = timestamp_us - stream->prev_t;
+    rec[len++] = stream->id;
+    len += log_format_put_varint(&rec[len], log_format_zigzag(dt - stream->prev_dt));
+    for (uint8_t i = 0; i < stream->field_count; i++) {
+        len += log_format_put_varint(&rec[len], log_format_zigzag((uint32_t)q[i] - (uint32_t)stream->prev[i]));
+    }
+
+    return len;
+}
+
+/**
+ * @brief 기록한 샘플을 차분 기준으로 반영
+ */
+static void log_codec_advance(LogStream *stream, uint32_t timestamp_us, const int32_t *q, bool key, uint8_t len) {
+    for (uint8_t i = 0; i < stream->field_count; i++) {
+        stream->prev[i] = q[i];
+    }
+    stream->prev_dt = key ? 0u : timestamp_us - stream->prev_t;
+    stream->prev_t = timestamp_us;
+    stream->since_key = key ? 1u : (uint16_t)(stream->since_key + 1u);
+    stream->samples++;
+    stream->bytes += len;
+}
+
+/**
+ * @brief 샘플 기록
+ */
+bool log_stream_write(FlashLog *log, LogStream *stream, uint32_t timestamp_us, const float *values) {
+    if (log == NULL || stream == NULL || values == NULL || stream->field_count == 0) {
+        return false;
+    }
+
+    int32_t q[LOG_CODEC_MAX_FIELDS];
+    for (uint8_t i = 0; i < stream->field_count; i++) {
+        q[i] = log_codec_quantize(values[i], stream->inv_scale[i]);
+    }
+
+    // 블록이 바뀌었거나 간격이 차면 키프레임
+    bool new_block = !stream->primed || stream->block != flash_log_block(log);
+    bool key = new_block || stream->since_key >= stream->keyframe_interval;
+
+    uint8_t rec[LOG_CODEC_MAX_RECORD];
+    uint8_t len = 0;
+    if (!key) {
+        len = log_codec_delta(stream, timestamp_us, q, rec);
+
+        // 차분이 다음 블록으로 넘어가면 그 블록에서 복원할 수 없으므로 키프레임으로 바꿈
+        if (!flash_log_fits(log, (uint16_t)(FLASH_LOG_RECORD_HEADER + len))) {
+            key = true;
+            new_block = true;
+        }
+    }
+
+    if (key) {
+        len = log_codec_key(stream, timestamp_us, q, rec);
+    }
+
+    if (new_block) {
+        // 스키마와 키프레임은 같은 블록에 있어야 함
+        uint8_t schema[LOG_CODEC_SCHEMA_SIZE(LOG_CODEC_MAX_FIELDS)];
+        uint8_t schema_len = log_stream_schema(stream, schema);
+        uint16_t need = (uint16_t)(2u * FLASH_LOG_RECORD_HEADER + schema_len + len);
+        if (!flash_log_fits(log, need) && !flash_log_sync(log)) {
+            log->dropped++;
+            return false;
+        }
+        if (!flash_log_write(log, FLASH_LOG_REC_SCHEMA, schema, schema_len)) {
+            return false;
+        }
+        stream->bytes += schema_len;
+        stream->block = flash_log_block(log);
+        stream->primed = true;
+    }
+
+    if (!flash_log_write(log, key ? FLASH_LOG_REC_KEY : FLASH_LOG_REC_DELTA, rec, len)) {
+        return false;
+    }
+
+    // 기록한 샘플만 차분 기준으로
+    log_codec_advance(stream, timestamp_us, q, key, len);
+
+    return true;
+}
+
+/**
+ * @brief RAM 버퍼용 샘플 인코딩
+ */
+uint8_t log_stream_encode(LogStream *stream, uint32_t timestamp_us, const float *values, bool key, uint8_t *rec) {
+    if (stream == NULL || values == NULL || rec == NULL || stream->field_count == 0) {
+        return 0;
+    }
+
+    int32_t q[LOG_CODEC_MAX_FIELDS];
+    for (uint8_t i = 0; i < stream->field_count; i++) {
+        q[i] = log_codec_quantize(values[i], stream->inv_scale[i]);
+    }
+
+    key = key || !stream->primed || stream->since_key >= stream->keyframe_interval;
+    uint8_t len;
+    if (key) {
+        len = log_codec_key(stream, timestamp_us, q, rec);
+    } else {
+        len = log_codec_delta(stream, timestamp_us, q, rec);
+    }
+    stream->primed = true;
+    log_codec_advance(stream, timestamp_us, q, key, len);
+
+    return len;
+}
+
+/**
+ * @brief IMU 스트림 초기화
+ */
+bool log_stream_init_imu(LogStream *stream, uint8_t id) {
+    static const float scale[6] = {
+        LOG_CODEC_SCALE_GYRO, LOG_CODEC_SCALE_GYRO, LOG_CODEC_SCALE_GYRO,
+        LOG_CODEC_SCALE_ACCEL, LOG_CODEC_SCALE_ACCEL, LOG_CODEC_SCALE_ACCEL
+    };
+
+    return log_stream_init(stream, id, "imu", 6, scale, LOG_CODEC_DEFAULT_KEYFRAME_INTERVAL);
+}
+
+/**
+ * @brief IMU 샘플 기록
+ */
+bool log_stream_write_imu(FlashLog *log, LogStream *stream, const ImuSample *sample) {
+    if (sample == NULL) {
+        return false;
+    }
+
+    const float v[6] = {
+        sample->gyro.x, sample->gyro.y, sample->gyro.z,
+        sample->accel.x, sample->accel.y, sample->accel.z
+    };
+
+    return log_stream_write(log, stream, sample->timestamp_us, v);
+}
+
+/**
+ * @brief 기압 스트림 초기화
+ */
+bool log_stream_init_baro(LogStream *stream, uint8_t id) {
+    static const float scale[2] = { LOG_CODEC_SCALE_PRESSURE, LOG_CODEC_SCALE_TEMP };
+
+    return log_stream_init(stream, id, "baro", 2, scale, LOG_CODEC_DEFAULT_KEYFRAME_INTERVAL);
+}
+
+/**
+ * @brief 항법 해 스트림 초기화
+ */
+bool log_stream_init_nav(LogStream *stream, uint8_t id) {
+    static const float scale[16] = {
+        LOG_CODEC_SCALE_POS, LOG_CODEC_SCALE_POS, LOG_CODEC_SCALE_POS,
+        LOG_CODEC_SCALE_VEL, LOG_CODEC_SCALE_VEL, LOG_CODEC_SCALE_VEL,
+        LOG_CODEC_SCALE_QUAT, LOG_CODEC_SCALE_QUAT, LOG_CODEC_SCALE_QUAT, LOG_CODEC_SCALE_QUAT,
+        LOG_CODEC_SCALE_GYRO_BIAS, LOG_CODEC_SCALE_GYRO_BIAS, LOG_CODEC_SCALE_GYRO_BIAS,
+        LOG_CODEC_SCALE_ACCEL_BIAS, LOG_CODEC_SCALE_ACCEL_BIAS, LOG_CODEC_SCALE_ACCEL_BIAS
+    };
+
+    return log_stream_init(stream, id, "nav", 16, scale, LOG_CODEC_DEFAULT_KEYFRAME_INTERVAL);
+}
+
+/**
+ * @brief 항법 해 기록
+ */
+bool log_stream_write_nav(FlashLog *log, LogStream *stream, const EKF_NavSolution *sol) {
+    if (sol == NULL) {
+        return false;
+    }
+
+    const float v[16] = {
+        sol->pos.x, sol->pos.y, sol->pos.z,
+        sol->vel.x, sol->vel.y, sol->vel.z,
+        sol->q.w, sol->q.x, sol->q.y, sol->q.z,
+        sol->gyro_bias.x, sol->gyro_bias.y, sol->gyro_bias.z,
+        sol->accel_bias.x, sol->accel_bias.y, sol->accel_bias.z
+    };
+
+    return log_stream_write(log, stream, sol->timestamp_us, v);
+}
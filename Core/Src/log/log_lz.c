@@ -0,0 +1,211 @@
+/**
+ * @file log_lz.c
+ * @brief 기록 블록 압축기 구현
+ */
+
+#include "log/log_lz.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief LZ4 블록 끝 규칙 (마지막 일치는 끝에서 12바이트 앞에서 시작, 마지막 5바이트는 리터럴)
+ */
+#define LOG_LZ_MF_LIMIT 12u
+#define LOG_LZ_LAST_LITERALS 5u
+
+/**
+ * @brief 일치가 없을 때 건너뛰는 폭이 1 늘어나는 실패 횟수 (2^n)
+ */
+#define LOG_LZ_SKIP_SHIFT 5u
+
+/**
+ * @brief 최대 거리 (16비트 거리 필드)
+ */
+#define LOG_LZ_MAX_DISTANCE 65535u
+
+/**
+ * @brief 토큰 길이 필드 최대값 (넘으면 255 단위 확장 바이트)
+ */
+#define LOG_LZ_RUN_MASK 15u
+
+static uint32_t log_lz_read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t log_lz_hash(uint32_t v) {
+    return (v * 2654435761u) >> (32u - LOG_LZ_HASH_BITS);
+}
+
+/**
+ * @brief 길이 확장 바이트 수
+ */
+static uint32_t log_lz_ext_size(uint32_t n) {
+    return (n >= LOG_LZ_RUN_MASK) ? 1u + (n - LOG_LZ_RUN_MASK) / 255u : 0u;
+}
+
+static uint8_t *log_lz_put_ext(uint8_t *op, uint32_t n) {
+    n -= LOG_LZ_RUN_MASK;
+    while (n >= 255u) {
+        *op++ = 255u;
+        n -= 255u;
+    }
+    *op++ = (uint8_t)n;
+
+    return op;
+}
+
+/**
+ * @brief 시퀀스 하나 쓰기 (match_len 0이면 마지막 리터럴만)
+ */
+static bool log_lz_emit(uint8_t **op, const uint8_t *end, const uint8_t *lit, uint32_t lit_len,
+                        uint32_t distance, uint32_t match_len) {
+    uint32_t m = (match_len > 0) ? match_len - LOG_LZ_MIN_MATCH : 0u;
+    uint32_t need = 1u + log_lz_ext_size(lit_len) + lit_len + ((match_len > 0) ? 2u + log_lz_ext_size(m) : 0u);
+    if (need > (uint32_t)(end - *op)) {
+        return false;
+    }
+
+    uint8_t *p = *op;
+    uint8_t *token = p++;
+    *token = (uint8_t)(((lit_len < LOG_LZ_RUN_MASK) ? lit_len : LOG_LZ_RUN_MASK) << 4);
+    if (lit_len >= LOG_LZ_RUN_MASK) {
+        p = log_lz_put_ext(p, lit_len);
+    }
+    memcpy(p, lit, lit_len);
+    p += lit_len;
+
+    if (match_len > 0) {
+        *p++ = (uint8_t)distance;
+        *p++ = (uint8_t)(distance >> 8);
+        *token |= (uint8_t)((m < LOG_LZ_RUN_MASK) ? m : LOG_LZ_RUN_MASK);
+        if (m >= LOG_LZ_RUN_MASK) {
+            p = log_lz_put_ext(p, m);
+        }
+    }
+    *op = p;
+
+    return true;
+}
+
+/**
+ * @brief 압축
+ */
+bool log_lz_compress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t capacity,
+                     uint16_t *table, uint16_t *out_len) {
+    if (src == NULL || dst == NULL || table == NULL || out_len == NULL) {
+        return false;
+    }
+
+    uint8_t *op = dst;
+    const uint8_t *end = dst + capacity;
+    uint32_t anchor = 0;
+
+    if (len > LOG_LZ_MF_LIMIT) {
+        // 빈 항목(0)은 위치 0을 가리키며, 후보는 항상 4바이트를 비교해 확인함
+        memset(table, 0, LOG_LZ_HASH_SIZE * sizeof(table[0]));
+
+        uint32_t match_limit = (uint32_t)len - LOG_LZ_MF_LIMIT;
+        uint32_t match_end = (uint32_t)len - LOG_LZ_LAST_LITERALS;
+        uint32_t ip = 0;
+        uint32_t misses = 0;
+        while (ip < match_limit) {
+            uint32_t v = log_lz_read32(&src[ip]);
+            uint32_t h = log_lz_hash(v);
+            uint32_t cand = table[h];
+            table[h] = (uint16_t)ip;
+
+            if (cand >= ip || ip - cand > LOG_LZ_MAX_DISTANCE || log_lz_read32(&src[cand]) != v) {
+                ip += 1u + (misses++ >> LOG_LZ_SKIP_SHIFT);
+                continue;
+            }
+
+            uint32_t n = LOG_LZ_MIN_MATCH;
+            while (ip + n < match_end && src[cand + n] == src[ip + n]) {
+                n++;
+            }
+            if (!log_lz_emit(&op, end, &src[anchor], ip - anchor, ip - cand, n)) {
+                return false;
+            }
+            ip += n;
+            anchor = ip;
+            misses = 0;
+        }
+    }
+
+    if (!log_lz_emit(&op, end, &src[anchor], (uint32_t)len - anchor, 0, 0)) {
+        return false;
+    }
+    *out_len = (uint16_t)(op - dst);
+
+    return true;
+}
+
+/**
+ * @brief 길이 확장 바이트 읽기
+ */
+static bool log_lz_get_ext(const uint8_t *src, uint32_t len, uint32_t *ip, uint32_t *n) {
+    uint8_t b;
+    do {
+        if (*ip >= len) {
+            return false;
+        }
+        b = src[(*ip)++];
+        *n += b;
+    } while (b == 255u);
+
+    return true;
+}
+
+/**
+ * @brief 복원
+ */
+bool log_lz_decompress(const uint8_t *src, uint16_t len, uint8_t *dst, uint16_t capacity, uint16_t *out_len) {
+    if (src == NULL || dst == NULL || out_len == NULL) {
+        return false;
+    }
+
+    uint32_t ip = 0;
+    uint32_t op = 0;
+    while (ip < len) {
+        uint8_t token = src[ip++];
+
+        uint32_t lit = token >> 4;
+        if (lit == LOG_LZ_RUN_MASK && !log_lz_get_ext(src, len, &ip, &lit)) {
+            return false;
+        }
+        if (lit > (uint32_t)len - ip || lit > (uint32_t)capacity - op) {
+            return false;
+        }
+        memcpy(&dst[op], &src[ip], lit);
+        ip += lit;
+        op += lit;
+        if (ip == len) {
+            break;
+        }
+
+        if (len - ip < 2u) {
+            return false;
+        }
+        uint32_t distance = src[ip] | ((uint32_t)src[ip + 1u] << 8);
+        ip += 2u;
+        uint32_t n = token & LOG_LZ_RUN_MASK;
+        if (n == LOG_LZ_RUN_MASK && !log_lz_get_ext(src, len, &ip, &n)) {
+            return false;
+        }
+        n += LOG_LZ_MIN_MATCH;
+        if (distance == 0 || distance > op || n > (uint32_t)capacity - op) {
+            return false;
+        }
+
+        // 겹치는 일치(거리 < 길이)는 앞에서부터 바이트 단위로 복사해야 반복이 됨
+        for (uint32_t k = 0; k < n; k++) {
+            dst[op + k] = dst[op + k - distance];
+        }
+        op += n;
+    }
+    *out_len = (uint16_t)op;
+
+    return true;
+}
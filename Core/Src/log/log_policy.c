@@ -0,0 +1,321 @@
+/**
+ * @file log_policy.c
+ * @brief 비행 단계별 기록 주기 정책 구현
+ */
+
+#include "log/log_policy.h"
+#include <string.h>
+
+_Static_assert((LOG_POLICY_RING_SIZE & (LOG_POLICY_RING_SIZE - 1u)) == 0, "LOG_POLICY_RING_SIZE must be a power of two");
+_Static_assert(FLIGHT_PHASE_DESCENT + 1 == LOG_POLICY_PHASE_COUNT, "LOG_POLICY_PHASE_COUNT does not match FlightPhase");
+_Static_assert(LOG_STREAM_COUNT <= 8, "stream masks are uint8_t");
+
+/**
+ * @brief 링 위치 마스크
+ */
+#define LOG_POLICY_RING_MASK (LOG_POLICY_RING_SIZE - 1u)
+
+/**
+ * @brief 레코드 앞 시각 필드 크기 (정책이 다루는 종류는 모두 timestamp_us로 시작)
+ */
+#define LOG_POLICY_TIMESTAMP_BYTES 4u
+
+/**
+ * @brief 순환 안전 시각 비교 (a가 b보다 앞이면 true)
+ */
+static bool log_policy_time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief 레코드 종류의 스트림 (정책이 다루지 않으면 LOG_STREAM_COUNT)
+ */
+static LogPolicyStream log_policy_stream(uint8_t type) {
+    switch (type) {
+        case FLASH_LOG_REC_IMU:
+            return LOG_STREAM_IMU;
+        case FLASH_LOG_REC_BARO:
+            return LOG_STREAM_BARO;
+        case FLASH_LOG_REC_MAG:
+            return LOG_STREAM_MAG;
+        case FLASH_LOG_REC_GNSS:
+            return LOG_STREAM_GNSS;
+        case FLASH_LOG_REC_NAV:
+            return LOG_STREAM_NAV;
+        case FLASH_LOG_REC_READY:
+            return LOG_STREAM_STATUS;
+        default:
+            return LOG_STREAM_COUNT;
+    }
+}
+
+/**
+ * @brief FNV-1a 해시 (변화 시 기록 판정)
+ */
+static uint32_t log_policy_hash(const uint8_t *p, uint32_t n) {
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < n; i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief 스트림 레코드를 지금 기록할지 판정 (기록하면 다음 기록 시각 갱신)
+ */
+static bool log_policy_due(LogPolicy *policy, LogPolicyStream stream, const uint8_t *payload, uint8_t len) {
+    const LogPolicyConfig *cfg = &policy->config;
+    uint8_t bit = (uint8_t)(1u << stream);
+    uint32_t t_us;
+    memcpy(&t_us, payload, sizeof(t_us));
+
+    bool started = (policy->started & bit) != 0;
+    policy->started |= bit;
+
+    bool on_change = (cfg->on_change & bit) != 0;
+    uint32_t hash = 0;
+    bool changed = false;
+    if (on_change) {
+        hash = log_policy_hash(payload + LOG_POLICY_TIMESTAMP_BYTES, len - LOG_POLICY_TIMESTAMP_BYTES);
+        changed = !started || hash != policy->last_hash[stream];
+        policy->last_hash[stream] = hash;
+    }
+
+    // 이벤트 뒤 구간은 모든 스트림 전체 주기
+    if (policy->post_active) {
+        if (log_policy_time_before(policy->post_end_us, t_us)) {
+            policy->post_active = false;
+        } else {
+            policy->next_us[stream] = t_us;
+            return true;
+        }
+    }
+
+    uint32_t period = cfg->period_us[flight_phase_get(policy->phase)][stream];
+    if (period == LOG_POLICY_OFF) {
+        return false;
+    }
+
+    if (on_change) {
+        if (!changed && started && log_policy_time_before(t_us, policy->next_us[stream])) {
+            return false;
+        }
+        policy->next_us[stream] = t_us + cfg->heartbeat_us;
+        return true;
+    }
+
+    if (period == 0) {
+        return true;
+    }
+    if (started && log_policy_time_before(t_us, policy->next_us[stream])) {
+        return false;
+    }
+
+    // 간격 격자를 유지해 샘플 지터로 주기가 늘어나지 않게 하고, 크게 밀렸으면 다시 맞춤
+    uint32_t next = started ? policy->next_us[stream] + period : t_us + period;
+    if (!log_policy_time_before(t_us, next)) {
+        next = t_us + period;
+    }
+    policy->next_us[stream] = next;
+
+    return true;
+}
+
+/**
+ * @brief 거른 레코드를 보관 링에 넣음 (가득 차면 가장 오래된 레코드부터 밀어 냄)
+ */
+static void log_policy_keep(LogPolicy *policy, uint8_t type, const uint8_t *payload, uint8_t len) {
+    uint32_t need = 2u + len;
+    if (len > FLASH_LOG_MAX_PAYLOAD - 1u) {
+        // 원래 종류 바이트가 붙으면 레코드 하나에 들어가지 않음
+        return;
+    }
+
+    while (policy->ring_tail - policy->ring_head + need > LOG_POLICY_RING_SIZE) {
+        uint8_t old_len = policy->ring[(policy->ring_head + 1u) & LOG_POLICY_RING_MASK];
+        policy->ring_head += 2u + old_len;
+        policy->stats.ring_evicted++;
+    }
+    if (log_policy_time_before(policy->drain_end, policy->ring_head)) {
+        policy->drain_end = policy->ring_head;
+    }
+
+    policy->ring[policy->ring_tail & LOG_POLICY_RING_MASK] = type;
+    policy->ring[(policy->ring_tail + 1u) & LOG_POLICY_RING_MASK] = len;
+    for (uint32_t i = 0; i < len; i++) {
+        policy->ring[(policy->ring_tail + 2u + i) & LOG_POLICY_RING_MASK] = payload[i];
+    }
+    policy->ring_tail += need;
+}
+
+/**
+ * @brief 보관분을 drain_bytes만큼 이벤트 전 레코드로 내보냄
+ */
+static void log_policy_drain(LogPolicy *policy) {
+    uint8_t rec[FLASH_LOG_MAX_PAYLOAD];
+    uint32_t budget = policy->config.drain_bytes;
+
+    while (budget > 0 && log_policy_time_before(policy->ring_head, policy->drain_end)) {
+        uint32_t head = policy->ring_head;
+        uint8_t len = policy->ring[(head + 1u) & LOG_POLICY_RING_MASK];
+        rec[0] = policy->ring[head & LOG_POLICY_RING_MASK];
+        for (uint32_t i = 0; i < len; i++) {
+            rec[1u + i] = policy->ring[(head + 2u + i) & LOG_POLICY_RING_MASK];
+        }
+
+        policy->draining = true;
+        bool ok = flash_log_write(policy->log, FLASH_LOG_REC_PRE_EVENT, rec, (uint8_t)(len + 1u));
+        policy->draining = false;
+        if (!ok) {
+            policy->stats.drain_failures++;
+            return;
+        }
+
+        uint32_t need = 2u + len;
+        policy->ring_head += need;
+        policy->stats.pre_event_written++;
+        budget = (budget > need) ? budget - need : 0;
+    }
+}
+
+/**
+ * @brief flash_log 레코드 거르기 콜백
+ */
+static bool log_policy_filter(void *context, uint8_t type, const void *payload, uint8_t len) {
+    LogPolicy *policy = (LogPolicy *)context;
+    if (policy->draining) {
+        // 보관분 내보내기 중 다시 들어온 이벤트 전 레코드
+        return true;
+    }
+
+    LogPolicyStream stream = log_policy_stream(type);
+    bool write = true;
+    if (stream != LOG_STREAM_COUNT && len >= LOG_POLICY_TIMESTAMP_BYTES) {
+        write = log_policy_due(policy, stream, (const uint8_t *)payload, len);
+        if (write) {
+            policy->stats.stream[stream].written++;
+        } else {
+            policy->stats.stream[stream].skipped++;
+            log_policy_keep(policy, type, (const uint8_t *)payload, len);
+        }
+    }
+
+    // 이 레코드보다 앞선 시각의 보관분을 먼저 씀
+    log_policy_drain(policy);
+
+    return write;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool log_policy_default_config(LogPolicyConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    memset(config, 0, sizeof(LogPolicyConfig));
+
+    // 추진/관성 비행은 모든 스트림 전체 주기 (0)
+    uint32_t *pad = config->period_us[FLIGHT_PHASE_PAD];
+    pad[LOG_STREAM_IMU] = 20000u;
+    pad[LOG_STREAM_BARO] = 100000u;
+    pad[LOG_STREAM_MAG] = 100000u;
+    pad[LOG_STREAM_GNSS] = 1000000u;
+    pad[LOG_STREAM_NAV] = 100000u;
+
+    uint32_t *descent = config->period_us[FLIGHT_PHASE_DESCENT];
+    descent[LOG_STREAM_IMU] = 10000u;
+    descent[LOG_STREAM_MAG] = 50000u;
+    descent[LOG_STREAM_NAV] = 100000u;
+
+    config->on_change = (uint8_t)(1u << LOG_STREAM_STATUS);
+    config->heartbeat_us = LOG_POLICY_DEFAULT_HEARTBEAT_US;
+    config->trigger_events = (uint8_t)((1u << FLIGHT_EVENT_LAUNCH) | (1u << FLIGHT_EVENT_APOGEE));
+    config->post_event_us = LOG_POLICY_DEFAULT_POST_EVENT_US;
+    config->drain_bytes = LOG_POLICY_DEFAULT_DRAIN_BYTES;
+
+    return true;
+}
+
+/**
+ * @brief 정책 초기화 및 기록기에 연결
+ */
+bool log_policy_init(LogPolicy *policy, FlashLog *log, const FlightPhaseMachine *phase,
+                     const LogPolicyConfig *config) {
+    if (policy == NULL || log == NULL) {
+        return false;
+    }
+
+    LogPolicyConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        log_policy_default_config(&cfg);
+    }
+
+    memset(policy, 0, sizeof(LogPolicy));
+    policy->log = log;
+    policy->phase = phase;
+    policy->config = cfg;
+    policy->initialized = true;
+
+    if (!flash_log_set_filter(log, log_policy_filter, policy)) {
+        policy->initialized = false;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 비행 이벤트 반영
+ */
+bool log_policy_event(LogPolicy *policy, const FlightEvent *event) {
+    if (policy == NULL || !policy->initialized || event == NULL ||
+        (policy->config.trigger_events & (1u << event->type)) == 0) {
+        return false;
+    }
+
+    return log_policy_trigger(policy, event->timestamp_us);
+}
+
+/**
+ * @brief 보관분 내보내기와 전체 주기 구간 시작
+ */
+bool log_policy_trigger(LogPolicy *policy, uint32_t timestamp_us) {
+    if (policy == NULL || !policy->initialized) {
+        return false;
+    }
+
+    policy->drain_end = policy->ring_tail;
+    policy->post_end_us = timestamp_us + policy->config.post_event_us;
+    policy->post_active = true;
+    policy->stats.triggers++;
+
+    return true;
+}
+
+/**
+ * @brief 남은 보관분 내보내기
+ */
+bool log_policy_service(LogPolicy *policy) {
+    if (policy == NULL || !policy->initialized) {
+        return false;
+    }
+
+    log_policy_drain(policy);
+
+    return log_policy_time_before(policy->ring_head, policy->drain_end);
+}
+
+/**
+ * @brief 통계
+ */
+const LogPolicyStats *log_policy_get_stats(const LogPolicy *policy) {
+    if (policy == NULL) {
+        return NULL;
+    }
+
+    return &policy->stats;
+}
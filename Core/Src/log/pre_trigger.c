@@ -0,0 +1,305 @@
+/**
+ * @file pre_trigger.c
+ * @brief 입력 단계 사전 트리거 버퍼 구현
+ */
+
+#include "log/pre_trigger.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 순환 안전 시각 비교 (a가 b보다 앞이면 true)
+ */
+static bool pre_trigger_time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief 스트림 조각 링 초기화
+ */
+static void pre_trigger_stream_init(PreTriggerStream *s, PreTriggerChunk *chunks, uint16_t chunk_count,
+                                    const char *name) {
+    s->chunks = chunks;
+    s->chunk_count = chunk_count;
+    s->newest = 0;
+    s->valid = 0;
+    atomic_init(&s->ack, 0);
+    // 키프레임은 조각 시작에만 (조각 하나는 간격보다 훨씬 적은 샘플)
+    s->codec.keyframe_interval = UINT16_MAX;
+    strncpy(s->codec.name, name, LOG_CODEC_NAME_SIZE);
+}
+
+/**
+ * @brief 샘플 하나 쌓기 (트리거됐으면 멈춘 것을 확인 표시)
+ */
+static void pre_trigger_push(PreTrigger *pt, PreTriggerStream *s, uint32_t timestamp_us, const float *values) {
+    if (atomic_load_explicit(&pt->triggered, memory_order_acquire)) {
+        atomic_store_explicit(&s->ack, atomic_load(&pt->seq), memory_order_release);
+        return;
+    }
+
+    uint16_t max_record = (uint16_t)(FLASH_LOG_RECORD_HEADER + 1u + 5u + 5u * s->codec.field_count);
+    PreTriggerChunk *c = &s->chunks[s->newest];
+    bool fresh = s->valid == 0 || c->used + max_record > PRE_TRIGGER_CHUNK_SIZE;
+    if (fresh) {
+        // 새 조각 (링이 찼으면 가장 오래된 조각을 덮어씀)
+        if (s->valid > 0) {
+            s->newest = (uint16_t)((s->newest + 1u) % s->chunk_count);
+        }
+        if (s->valid < s->chunk_count) {
+            s->valid++;
+        } else {
+            s->evicted++;
+        }
+        c = &s->chunks[s->newest];
+        c->used = 0;
+        c->first_us = timestamp_us;
+    }
+
+    uint8_t *p = &c->data[c->used];
+    uint8_t len = log_stream_encode(&s->codec, timestamp_us, values, fresh, &p[FLASH_LOG_RECORD_HEADER]);
+    if (len == 0) {
+        return;
+    }
+    p[0] = fresh ? FLASH_LOG_REC_KEY : FLASH_LOG_REC_DELTA;
+    p[1] = len;
+    c->used = (uint16_t)(c->used + FLASH_LOG_RECORD_HEADER + len);
+    c->last_us = timestamp_us;
+    s->samples++;
+}
+
+/**
+ * @brief 옮길 범위 정하기 (보관 구간보다 오래된 조각은 건너뜀)
+ */
+static void pre_trigger_commit_begin(PreTrigger *pt, PreTriggerStream *s) {
+    s->commit_next = (s->valid < s->chunk_count) ? 0u : (uint16_t)((s->newest + 1u) % s->chunk_count);
+    s->commit_left = s->valid;
+    s->commit_schema = false;
+
+    uint32_t from_us = pt->trigger_us - pt->config.window_us;
+    while (s->commit_left > 0 && pre_trigger_time_before(s->chunks[s->commit_next].last_us, from_us)) {
+        s->commit_next = (uint16_t)((s->commit_next + 1u) % s->chunk_count);
+        s->commit_left--;
+        pt->stats.chunks_skipped++;
+    }
+}
+
+/**
+ * @brief 조각 하나 기록 (스키마와 조각은 같은 블록에)
+ *
+ * @return bool 기록했으면 true (기록기가 밀려 있으면 false, 다음 호출에서 다시)
+ */
+static bool pre_trigger_write_chunk(PreTrigger *pt, PreTriggerStream *s, FlashLog *log) {
+    const PreTriggerChunk *c = &s->chunks[s->commit_next];
+    uint8_t schema[LOG_CODEC_SCHEMA_SIZE(LOG_CODEC_MAX_FIELDS)];
+    uint8_t schema_len = log_stream_schema(&s->codec, schema);
+    uint16_t schema_need = (uint16_t)(FLASH_LOG_RECORD_HEADER + schema_len);
+
+    bool need_schema = !s->commit_schema || s->commit_block != flash_log_block(log);
+    if (!flash_log_fits(log, (uint16_t)(c->used + (need_schema ? schema_need : 0u)))) {
+        // 조각이 블록 경계를 넘으면 차분을 복원할 수 없으므로 새 블록에서 시작
+        if (!flash_log_sync(log)) {
+            return false;
+        }
+        need_schema = true;
+    }
+
+    if (need_schema) {
+        if (!flash_log_write(log, FLASH_LOG_REC_SCHEMA, schema, schema_len)) {
+            return false;
+        }
+        pt->stats.bytes_written += schema_len;
+        s->commit_block = flash_log_block(log);
+        s->commit_schema = true;
+    }
+
+    uint16_t o = 0;
+    while (o + FLASH_LOG_RECORD_HEADER <= c->used) {
+        uint8_t len = c->data[o + 1u];
+        flash_log_write(log, c->data[o], &c->data[o + FLASH_LOG_RECORD_HEADER], len);
+        o = (uint16_t)(o + FLASH_LOG_RECORD_HEADER + len);
+    }
+    pt->stats.bytes_written += c->used;
+    pt->stats.chunks_written++;
+
+    s->commit_next = (uint16_t)((s->commit_next + 1u) % s->chunk_count);
+    s->commit_left--;
+
+    return true;
+}
+
+/**
+ * @brief 생산자가 이번 트리거에서 멈췄는지 (한 번도 쌓지 않은 생산자는 없는 것으로 봄)
+ */
+static bool pre_trigger_stopped(const PreTriggerStream *s, uint32_t seq) {
+    return s->samples == 0 || atomic_load_explicit(&s->ack, memory_order_acquire) == seq;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool pre_trigger_default_config(PreTriggerConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->window_us = PRE_TRIGGER_DEFAULT_WINDOW_US;
+    config->imu_id = PRE_TRIGGER_DEFAULT_IMU_ID;
+    config->baro_id = PRE_TRIGGER_DEFAULT_BARO_ID;
+    config->trigger_events = PRE_TRIGGER_DEFAULT_EVENTS;
+    config->service_chunks = PRE_TRIGGER_DEFAULT_SERVICE_CHUNKS;
+
+    return true;
+}
+
+/**
+ * @brief 버퍼 초기화
+ */
+bool pre_trigger_init(PreTrigger *pt, const PreTriggerConfig *config) {
+    if (pt == NULL) {
+        return false;
+    }
+
+    PreTriggerConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        pre_trigger_default_config(&cfg);
+    }
+    if (cfg.service_chunks == 0 || cfg.imu_id == cfg.baro_id) {
+        return false;
+    }
+
+    memset(pt, 0, sizeof(PreTrigger));
+    pt->config = cfg;
+    if (!log_stream_init_imu(&pt->imu.codec, cfg.imu_id) || !log_stream_init_baro(&pt->baro.codec, cfg.baro_id)) {
+        return false;
+    }
+    pre_trigger_stream_init(&pt->imu, pt->imu_chunks, PRE_TRIGGER_IMU_CHUNKS, "imu_pre");
+    pre_trigger_stream_init(&pt->baro, pt->baro_chunks, PRE_TRIGGER_BARO_CHUNKS, "baro_pre");
+    atomic_init(&pt->triggered, false);
+    atomic_init(&pt->seq, 0);
+    pt->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 쌓기
+ */
+void pre_trigger_push_imu(PreTrigger *pt, const ImuSample *sample) {
+    if (pt == NULL || !pt->initialized || sample == NULL) {
+        return;
+    }
+
+    const float v[6] = {
+        sample->gyro.x, sample->gyro.y, sample->gyro.z,
+        sample->accel.x, sample->accel.y, sample->accel.z
+    };
+    pre_trigger_push(pt, &pt->imu, sample->timestamp_us, v);
+}
+
+/**
+ * @brief ImuRing 생산자 탭
+ */
+void pre_trigger_imu_tap(const ImuSample *sample, void *context) {
+    pre_trigger_push_imu((PreTrigger *)context, sample);
+}
+
+/**
+ * @brief 기압 샘플 쌓기
+ */
+void pre_trigger_push_baro(PreTrigger *pt, uint32_t timestamp_us, float pressure_pa, float temp_c) {
+    if (pt == NULL || !pt->initialized) {
+        return;
+    }
+
+    const float v[2] = { pressure_pa, temp_c };
+    pre_trigger_push(pt, &pt->baro, timestamp_us, v);
+}
+
+/**
+ * @brief 트리거
+ */
+bool pre_trigger_fire(PreTrigger *pt, uint32_t timestamp_us) {
+    if (pt == NULL || !pt->initialized || atomic_exchange(&pt->triggered, true)) {
+        return false;
+    }
+
+    // 생산자는 순번이 오르기 전에 멈출 수 있으며, 다음 샘플에서 새 순번으로 다시 확인한다
+    pt->trigger_us = timestamp_us;
+    atomic_fetch_add(&pt->seq, 1u);
+    pt->stats.triggers++;
+
+    return true;
+}
+
+/**
+ * @brief 비행 이벤트 콜백
+ */
+void pre_trigger_event_callback(const FlightEvent *event, void *context) {
+    PreTrigger *pt = (PreTrigger *)context;
+    if (pt == NULL || event == NULL || (pt->config.trigger_events & (1u << event->type)) == 0) {
+        return;
+    }
+
+    pre_trigger_fire(pt, event->onset_us);
+}
+
+/**
+ * @brief 트리거된 보관분을 기록기로 옮김
+ */
+bool pre_trigger_service(PreTrigger *pt, FlashLog *log) {
+    if (pt == NULL || !pt->initialized || log == NULL ||
+        !atomic_load_explicit(&pt->triggered, memory_order_acquire)) {
+        return false;
+    }
+
+    if (!pt->committing) {
+        uint32_t seq = atomic_load(&pt->seq);
+        if (!pre_trigger_stopped(&pt->imu, seq) || !pre_trigger_stopped(&pt->baro, seq)) {
+            // 생산자가 다음 샘플에서 멈출 때까지 대기
+            return true;
+        }
+        pre_trigger_commit_begin(pt, &pt->imu);
+        pre_trigger_commit_begin(pt, &pt->baro);
+        pt->committing = true;
+    }
+
+    for (uint8_t n = 0; n < pt->config.service_chunks; n++) {
+        PreTriggerStream *s = (pt->imu.commit_left > 0) ? &pt->imu
+                            : (pt->baro.commit_left > 0) ? &pt->baro : NULL;
+        if (s == NULL) {
+            break;
+        }
+        if (!pre_trigger_write_chunk(pt, s, log)) {
+            pt->stats.retries++;
+            return true;
+        }
+    }
+    if (pt->imu.commit_left > 0 || pt->baro.commit_left > 0) {
+        return true;
+    }
+
+    // 다 옮김: 링을 비우고 생산자를 다시 시작
+    pt->imu.valid = 0;
+    pt->imu.newest = 0;
+    pt->baro.valid = 0;
+    pt->baro.newest = 0;
+    pt->committing = false;
+    pt->stats.commits++;
+    atomic_store_explicit(&pt->triggered, false, memory_order_release);
+
+    return false;
+}
+
+/**
+ * @brief 통계
+ */
+const PreTriggerStats *pre_trigger_get_stats(const PreTrigger *pt) {
+    if (pt == NULL) {
+        return NULL;
+    }
+
+    return &pt->stats;
+}
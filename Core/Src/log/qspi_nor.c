@@ -0,0 +1,309 @@
+/**
+ * @file qspi_nor.c
+ * @brief QUADSPI 직렬 NOR 플래시 드라이버 구현
+ */
+
+#include "log/qspi_nor.h"
+#include <stddef.h>
+
+/**
+ * @brief 자동 폴링 간격 (QUADSPI 클록 수)
+ */
+#define QSPI_NOR_POLL_INTERVAL 0x10
+
+/**
+ * @brief 단일 선 명령 기본 설정 (주소/데이터 없음)
+ */
+static QSPI_CommandTypeDef qspi_nor_command(uint8_t instruction) {
+    QSPI_CommandTypeDef cmd = {0};
+    cmd.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+    cmd.Instruction = instruction;
+    cmd.AddressMode = QSPI_ADDRESS_NONE;
+    cmd.AddressSize = QSPI_ADDRESS_24_BITS;
+    cmd.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+    cmd.DataMode = QSPI_DATA_NONE;
+    cmd.DummyCycles = 0;
+    cmd.DdrMode = QSPI_DDR_MODE_DISABLE;
+    cmd.DdrHoldHalfCycle = QSPI_DDR_HHC_ANALOG_DELAY;
+    cmd.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+
+    return cmd;
+}
+
+/**
+ * @brief WIP 해제 자동 폴링 설정
+ */
+static void qspi_nor_ready_polling(QSPI_CommandTypeDef *cmd, QSPI_AutoPollingTypeDef *cfg) {
+    *cmd = qspi_nor_command(QSPI_NOR_CMD_READ_STATUS);
+    cmd->DataMode = QSPI_DATA_1_LINE;
+
+    cfg->Match = 0;
+    cfg->Mask = QSPI_NOR_STATUS_WIP;
+    cfg->MatchMode = QSPI_MATCH_MODE_AND;
+    cfg->StatusBytesSize = 1;
+    cfg->Interval = QSPI_NOR_POLL_INTERVAL;
+    cfg->AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+}
+
+/**
+ * @brief 쓰기 허용 (블로킹, 명령만)
+ */
+static bool qspi_nor_write_enable(QspiNor *nor) {
+    QSPI_CommandTypeDef cmd = qspi_nor_command(QSPI_NOR_CMD_WRITE_ENABLE);
+
+    return HAL_QSPI_Command(nor->hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) == HAL_OK;
+}
+
+/**
+ * @brief 간접 명령 전에 메모리 매핑 해제
+ */
+static bool qspi_nor_indirect(QspiNor *nor) {
+    return !nor->mapped || qspi_nor_unmap(nor);
+}
+
+/**
+ * @brief 장치 확인 및 초기화
+ */
+bool qspi_nor_init(QspiNor *nor, QSPI_HandleTypeDef *hqspi) {
+    if (nor == NULL || hqspi == NULL) {
+        return false;
+    }
+
+    nor->hqspi = hqspi;
+    nor->mapped = false;
+    nor->initialized = false;
+
+    QSPI_CommandTypeDef cmd = qspi_nor_command(QSPI_NOR_CMD_READ_JEDEC_ID);
+    cmd.DataMode = QSPI_DATA_1_LINE;
+    cmd.NbData = sizeof(nor->jedec_id);
+    if (HAL_QSPI_Command(hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) != HAL_OK ||
+        HAL_QSPI_Receive(hqspi, nor->jedec_id, QSPI_NOR_TIMEOUT_MS) != HAL_OK) {
+        return false;
+    }
+
+    // 용량 코드 = log2(바이트), 응답 없음(0x00/0xFF)과 4바이트 주소 장치는 거부
+    uint8_t code = nor->jedec_id[2];
+    if (code < 16 || code > 24 || nor->jedec_id[0] == 0x00 || nor->jedec_id[0] == 0xFF) {
+        return false;
+    }
+    nor->size = 1u << code;
+
+    switch (nor->jedec_id[0]) {
+    case QSPI_NOR_MFR_WINBOND:
+    case QSPI_NOR_MFR_ISSI:
+        nor->suspend_cmd = QSPI_NOR_CMD_SUSPEND;
+        nor->resume_cmd = QSPI_NOR_CMD_RESUME;
+        break;
+    case QSPI_NOR_MFR_MACRONIX:
+        nor->suspend_cmd = QSPI_NOR_CMD_SUSPEND_MX;
+        nor->resume_cmd = QSPI_NOR_CMD_RESUME_MX;
+        break;
+    default:
+        nor->suspend_cmd = 0;
+        nor->resume_cmd = 0;
+        break;
+    }
+
+    if (!qspi_nor_wait_ready(nor, QSPI_NOR_ERASE_TIMEOUT_MS)) {
+        return false;
+    }
+
+    nor->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 읽기 (블로킹)
+ */
+bool qspi_nor_read(QspiNor *nor, uint32_t addr, uint8_t *data, uint32_t len) {
+    if (nor == NULL || data == NULL || !nor->initialized || len == 0 ||
+        addr >= nor->size || len > nor->size - addr) {
+        return false;
+    }
+
+    if (!qspi_nor_indirect(nor)) {
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd = qspi_nor_command(QSPI_NOR_CMD_FAST_READ);
+    cmd.AddressMode = QSPI_ADDRESS_1_LINE;
+    cmd.Address = addr;
+    cmd.DataMode = QSPI_DATA_1_LINE;
+    cmd.DummyCycles = 8;
+    cmd.NbData = len;
+    if (HAL_QSPI_Command(nor->hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) != HAL_OK) {
+        return false;
+    }
+
+    return HAL_QSPI_Receive(nor->hqspi, data, QSPI_NOR_TIMEOUT_MS + len / 1024u) == HAL_OK;
+}
+
+/**
+ * @brief 메모리 매핑 모드로 전환
+ */
+const uint8_t *qspi_nor_map(QspiNor *nor) {
+    if (nor == NULL || !nor->initialized) {
+        return NULL;
+    }
+    if (nor->mapped) {
+        return (const uint8_t *)QSPI_NOR_MAP_BASE;
+    }
+
+    // 간접 읽기와 같은 빠른 읽기 명령을 주소마다 자동으로 보냄
+    QSPI_CommandTypeDef cmd = qspi_nor_command(QSPI_NOR_CMD_FAST_READ);
+    cmd.AddressMode = QSPI_ADDRESS_1_LINE;
+    cmd.DataMode = QSPI_DATA_1_LINE;
+    cmd.DummyCycles = 8;
+
+    QSPI_MemoryMappedTypeDef cfg = {0};
+    cfg.TimeOutActivation = QSPI_TIMEOUT_COUNTER_ENABLE;
+    cfg.TimeOutPeriod = QSPI_NOR_MAP_TIMEOUT_CYCLES;
+    if (HAL_QSPI_MemoryMapped(nor->hqspi, &cmd, &cfg) != HAL_OK) {
+        return NULL;
+    }
+    nor->mapped = true;
+
+    return (const uint8_t *)QSPI_NOR_MAP_BASE;
+}
+
+/**
+ * @brief 간접 모드로 복귀
+ */
+bool qspi_nor_unmap(QspiNor *nor) {
+    if (nor == NULL || nor->hqspi == NULL) {
+        return false;
+    }
+    if (!nor->mapped) {
+        return true;
+    }
+
+    // 메모리 매핑은 중단 요청으로만 끝남
+    if (HAL_QSPI_Abort(nor->hqspi) != HAL_OK) {
+        return false;
+    }
+    nor->mapped = false;
+
+    return true;
+}
+
+/**
+ * @brief 페이지 쓰기 시작 (DMA)
+ */
+bool qspi_nor_program_page_dma(QspiNor *nor, uint32_t addr, const uint8_t *data, uint32_t len) {
+    if (nor == NULL || data == NULL || !nor->initialized || len == 0 || len > QSPI_NOR_PAGE_SIZE ||
+        (addr % QSPI_NOR_PAGE_SIZE) + len > QSPI_NOR_PAGE_SIZE || addr >= nor->size) {
+        return false;
+    }
+
+    if (!qspi_nor_indirect(nor) || !qspi_nor_write_enable(nor)) {
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd = qspi_nor_command(QSPI_NOR_CMD_PAGE_PROGRAM);
+    cmd.AddressMode = QSPI_ADDRESS_1_LINE;
+    cmd.Address = addr;
+    cmd.DataMode = QSPI_DATA_1_LINE;
+    cmd.NbData = len;
+    if (HAL_QSPI_Command(nor->hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) != HAL_OK) {
+        return false;
+    }
+
+    // HAL은 쓰기 버퍼를 const로 받지 않음 (DMA는 읽기만 함)
+    return HAL_QSPI_Transmit_DMA(nor->hqspi, (uint8_t *)data) == HAL_OK;
+}
+
+/**
+ * @brief 지우기 시작
+ */
+bool qspi_nor_erase_start(QspiNor *nor, uint32_t addr, uint32_t size) {
+    if (nor == NULL || !nor->initialized || addr >= nor->size ||
+        (size != QSPI_NOR_SECTOR_SIZE && size != QSPI_NOR_BLOCK_SIZE) || (addr % size) != 0) {
+        return false;
+    }
+
+    if (!qspi_nor_indirect(nor) || !qspi_nor_write_enable(nor)) {
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd = qspi_nor_command((size == QSPI_NOR_BLOCK_SIZE)
+                                               ? QSPI_NOR_CMD_BLOCK_ERASE : QSPI_NOR_CMD_SECTOR_ERASE);
+    cmd.AddressMode = QSPI_ADDRESS_1_LINE;
+    cmd.Address = addr;
+
+    return HAL_QSPI_Command(nor->hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) == HAL_OK;
+}
+
+/**
+ * @brief 진행 중인 지우기 일시 중지
+ */
+bool qspi_nor_erase_suspend(QspiNor *nor) {
+    if (nor == NULL || !nor->initialized || nor->suspend_cmd == 0) {
+        return false;
+    }
+
+    // 완료 대기 자동 폴링 중단 (중단 뒤에 늦게 온 일치 인터럽트가 남지 않게 함)
+    if (HAL_QSPI_Abort(nor->hqspi) != HAL_OK) {
+        return false;
+    }
+    __HAL_QSPI_DISABLE_IT(nor->hqspi, QSPI_IT_SM | QSPI_IT_TE);
+    __HAL_QSPI_CLEAR_FLAG(nor->hqspi, QSPI_FLAG_SM | QSPI_FLAG_TE);
+
+    QSPI_CommandTypeDef cmd = qspi_nor_command(nor->suspend_cmd);
+    if (HAL_QSPI_Command(nor->hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) != HAL_OK) {
+        return false;
+    }
+
+    return qspi_nor_wait_ready(nor, QSPI_NOR_SUSPEND_TIMEOUT_MS);
+}
+
+/**
+ * @brief 중지한 지우기 재개
+ */
+bool qspi_nor_erase_resume(QspiNor *nor) {
+    if (nor == NULL || !nor->initialized || nor->resume_cmd == 0) {
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd = qspi_nor_command(nor->resume_cmd);
+
+    return HAL_QSPI_Command(nor->hqspi, &cmd, QSPI_NOR_TIMEOUT_MS) == HAL_OK;
+}
+
+/**
+ * @brief 완료 대기 시작 (자동 폴링 인터럽트)
+ */
+bool qspi_nor_wait_ready_it(QspiNor *nor) {
+    if (nor == NULL || nor->hqspi == NULL) {
+        return false;
+    }
+
+    if (!qspi_nor_indirect(nor)) {
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd;
+    QSPI_AutoPollingTypeDef cfg;
+    qspi_nor_ready_polling(&cmd, &cfg);
+
+    return HAL_QSPI_AutoPolling_IT(nor->hqspi, &cmd, &cfg) == HAL_OK;
+}
+
+/**
+ * @brief 완료 대기 (블로킹)
+ */
+bool qspi_nor_wait_ready(QspiNor *nor, uint32_t timeout_ms) {
+    if (nor == NULL || nor->hqspi == NULL) {
+        return false;
+    }
+
+    if (!qspi_nor_indirect(nor)) {
+        return false;
+    }
+
+    QSPI_CommandTypeDef cmd;
+    QSPI_AutoPollingTypeDef cfg;
+    qspi_nor_ready_polling(&cmd, &cfg);
+
+    return HAL_QSPI_AutoPolling(nor->hqspi, &cmd, &cfg, timeout_ms) == HAL_OK;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file sd_card.c
+ * @brief SDMMC SD 카드 드라이버 구현
+ */
+
+#include "log/sd_card.h"
+
+#if BOARD_HAS_SD_CARD
+
+#include <stddef.h>
+
+/**
+ * @brief 장치 확인 및 초기화
+ */
+bool sd_card_init(SdCard *sd, SdCardHandle *hsd) {
+    if (sd == NULL || hsd == NULL) {
+        return false;
+    }
+
+    sd->hsd = hsd;
+    sd->block_count = 0;
+    sd->write_errors = 0;
+    sd->initialized = false;
+
+    HAL_SD_CardInfoTypeDef info;
+    if (HAL_SD_GetCardInfo(hsd, &info) != HAL_OK || info.LogBlockSize != SD_CARD_BLOCK_SIZE ||
+        info.LogBlockNbr == 0) {
+        return false;
+    }
+
+    // 진행 중이던 내부 기록이 끝나기를 기다림
+    uint32_t start = HAL_GetTick();
+    while (HAL_SD_GetCardState(hsd) != HAL_SD_CARD_TRANSFER) {
+        if (HAL_GetTick() - start > SD_CARD_TIMEOUT_MS) {
+            return false;
+        }
+    }
+
+    sd->block_count = info.LogBlockNbr;
+    sd->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 블록 읽기
+ */
+bool sd_card_read(SdCard *sd, uint32_t lba, uint8_t *data, uint32_t count) {
+    if (sd == NULL || !sd->initialized || data == NULL || count == 0 ||
+        lba >= sd->block_count || count > sd->block_count - lba) {
+        return false;
+    }
+
+    if (HAL_SD_ReadBlocks(sd->hsd, data, lba, count, SD_CARD_TIMEOUT_MS) != HAL_OK) {
+        return false;
+    }
+
+    uint32_t start = HAL_GetTick();
+    while (HAL_SD_GetCardState(sd->hsd) != HAL_SD_CARD_TRANSFER) {
+        if (HAL_GetTick() - start > SD_CARD_TIMEOUT_MS) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 다중 블록 DMA 쓰기 시작
+ */
+bool sd_card_write_dma(SdCard *sd, uint32_t lba, const uint8_t *data, uint32_t count) {
+    if (sd == NULL || !sd->initialized || data == NULL || count == 0 ||
+        lba >= sd->block_count || count > sd->block_count - lba || ((uintptr_t)data & 3u) != 0) {
+        return false;
+    }
+
+    if (HAL_SD_WriteBlocks_DMA(sd->hsd, (uint8_t *)(uintptr_t)data, lba, count) != HAL_OK) {
+        sd->write_errors++;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 지우기 시작
+ */
+bool sd_card_erase_start(SdCard *sd, uint32_t lba, uint32_t count) {
+    if (sd == NULL || !sd->initialized || count == 0 ||
+        lba >= sd->block_count || count > sd->block_count - lba) {
+        return false;
+    }
+
+    return HAL_SD_Erase(sd->hsd, lba, lba + count - 1u) == HAL_OK;
+}
+
+/**
+ * @brief 다음 명령을 받을 수 있는지
+ */
+bool sd_card_ready(SdCard *sd) {
+    if (sd == NULL || !sd->initialized) {
+        return false;
+    }
+    if (HAL_SD_GetState(sd->hsd) != HAL_SD_STATE_READY) {
+        return false;
+    }
+
+    return HAL_SD_GetCardState(sd->hsd) == HAL_SD_CARD_TRANSFER;
+}
+
+#endif /* BOARD_HAS_SD_CARD */
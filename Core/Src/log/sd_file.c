@@ -0,0 +1,204 @@
+/**
+ * @file sd_file.c
+ * @brief FAT32 연속 파일 찾기 구현
+ */
+
+#include "log/sd_file.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief FAT32 상수
+ */
+#define SD_FILE_FAT_MASK 0x0FFFFFFFu       /**< FAT32 항목 유효 비트 */
+#define SD_FILE_FAT_EOC 0x0FFFFFF8u        /**< 사슬 끝 이상 */
+#define SD_FILE_DIR_ENTRY_SIZE 32u
+#define SD_FILE_ATTR_LFN 0x0Fu
+#define SD_FILE_ATTR_SKIP 0x18u            /**< 볼륨 이름, 디렉터리 */
+
+/**
+ * @brief FAT32 볼륨 배치
+ */
+typedef struct {
+    SdCard *sd;
+    uint32_t fat_lba;          /**< 첫 FAT 시작 블록 */
+    uint32_t data_lba;         /**< 클러스터 2 시작 블록 */
+    uint32_t cluster_count;    /**< 데이터 클러스터 수 */
+    uint8_t sectors_per_cluster;
+    uint32_t cached_lba;       /**< sector에 들어 있는 블록 (UINT32_MAX면 없음) */
+    uint8_t sector[SD_CARD_BLOCK_SIZE] __attribute__((aligned(4)));
+} SdFileVolume;
+
+/**
+ * @brief 리틀 엔디언 읽기
+ */
+static uint16_t sd_file_rd16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t sd_file_rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 블록 읽기 (직전 블록 재사용)
+ */
+static bool sd_file_load(SdFileVolume *vol, uint32_t lba) {
+    if (vol->cached_lba == lba) {
+        return true;
+    }
+    vol->cached_lba = UINT32_MAX;
+    if (!sd_card_read(vol->sd, lba, vol->sector, 1)) {
+        return false;
+    }
+    vol->cached_lba = lba;
+
+    return true;
+}
+
+/**
+ * @brief FAT 항목 읽기
+ */
+static bool sd_file_fat_next(SdFileVolume *vol, uint32_t cluster, uint32_t *next) {
+    uint32_t offset = cluster * 4u;
+    if (!sd_file_load(vol, vol->fat_lba + offset / SD_CARD_BLOCK_SIZE)) {
+        return false;
+    }
+    *next = sd_file_rd32(&vol->sector[offset % SD_CARD_BLOCK_SIZE]) & SD_FILE_FAT_MASK;
+
+    return true;
+}
+
+/**
+ * @brief 클러스터 시작 블록
+ */
+static uint32_t sd_file_cluster_lba(const SdFileVolume *vol, uint32_t cluster) {
+    return vol->data_lba + (cluster - 2u) * vol->sectors_per_cluster;
+}
+
+/**
+ * @brief 볼륨 배치 읽기 (MBR이 있으면 첫 FAT32 분할, 없으면 블록 0이 BPB)
+ */
+static bool sd_file_mount(SdFileVolume *vol) {
+    if (!sd_file_load(vol, 0) || sd_file_rd16(&vol->sector[510]) != 0xAA55u) {
+        return false;
+    }
+
+    uint32_t volume_lba = 0;
+    bool is_bpb = (vol->sector[0] == 0xEBu || vol->sector[0] == 0xE9u) &&
+                  memcmp(&vol->sector[82], "FAT32", 5) == 0;
+    if (!is_bpb) {
+        bool found = false;
+        for (uint32_t i = 0; i < 4; i++) {
+            const uint8_t *part = &vol->sector[446 + 16 * i];
+            if (part[4] == 0x0Bu || part[4] == 0x0Cu) {
+                volume_lba = sd_file_rd32(&part[8]);
+                found = true;
+                break;
+            }
+        }
+        if (!found || !sd_file_load(vol, volume_lba) || sd_file_rd16(&vol->sector[510]) != 0xAA55u) {
+            return false;
+        }
+    }
+
+    const uint8_t *bpb = vol->sector;
+    uint16_t bytes_per_sector = sd_file_rd16(&bpb[11]);
+    uint8_t sectors_per_cluster = bpb[13];
+    uint16_t reserved = sd_file_rd16(&bpb[14]);
+    uint8_t fat_count = bpb[16];
+    uint32_t total_sectors = sd_file_rd32(&bpb[32]);
+    uint32_t fat_size = sd_file_rd32(&bpb[36]);
+    if (bytes_per_sector != SD_CARD_BLOCK_SIZE || sectors_per_cluster == 0 || fat_count == 0 ||
+        sd_file_rd16(&bpb[22]) != 0 || fat_size == 0) {
+        return false;
+    }
+
+    vol->sectors_per_cluster = sectors_per_cluster;
+    vol->fat_lba = volume_lba + reserved;
+    vol->data_lba = vol->fat_lba + (uint32_t)fat_count * fat_size;
+    uint32_t data_sectors = total_sectors - (vol->data_lba - volume_lba);
+    vol->cluster_count = data_sectors / sectors_per_cluster;
+
+    return true;
+}
+
+/**
+ * @brief 루트 디렉터리에서 연속 파일 찾기
+ */
+bool sd_file_find(SdCard *sd, const char *name, SdFile *file) {
+    if (sd == NULL || !sd->initialized || name == NULL || file == NULL) {
+        return false;
+    }
+
+    static SdFileVolume vol;
+    vol.sd = sd;
+    vol.cached_lba = UINT32_MAX;
+    if (!sd_file_mount(&vol)) {
+        return false;
+    }
+
+    // 루트 디렉터리 클러스터 번호는 BPB에 있음 (마운트 직후 sector = BPB)
+    uint32_t cluster = sd_file_rd32(&vol.sector[44]) & SD_FILE_FAT_MASK;
+    uint32_t first_cluster = 0;
+    uint32_t size = 0;
+    bool found = false;
+    bool end = false;
+
+    for (uint32_t hops = 0; !found && !end && cluster >= 2u && cluster < SD_FILE_FAT_EOC; hops++) {
+        if (hops > vol.cluster_count) {
+            return false;
+        }
+        uint32_t lba = sd_file_cluster_lba(&vol, cluster);
+        for (uint32_t s = 0; s < vol.sectors_per_cluster && !found && !end; s++) {
+            if (!sd_file_load(&vol, lba + s)) {
+                return false;
+            }
+            for (uint32_t o = 0; o < SD_CARD_BLOCK_SIZE; o += SD_FILE_DIR_ENTRY_SIZE) {
+                const uint8_t *e = &vol.sector[o];
+                if (e[0] == 0x00u) {
+                    end = true;
+                    break;
+                }
+                if (e[0] == 0xE5u || e[11] == SD_FILE_ATTR_LFN || (e[11] & SD_FILE_ATTR_SKIP) != 0) {
+                    continue;
+                }
+                if (memcmp(e, name, SD_FILE_NAME_SIZE) == 0) {
+                    first_cluster = ((uint32_t)sd_file_rd16(&e[20]) << 16) | sd_file_rd16(&e[26]);
+                    size = sd_file_rd32(&e[28]);
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found && !end && !sd_file_fat_next(&vol, cluster, &cluster)) {
+            return false;
+        }
+    }
+    if (!found || first_cluster < 2u || size < SD_CARD_BLOCK_SIZE) {
+        return false;
+    }
+
+    // 클러스터 사슬이 연속인지 확인 (FAT 블록은 순서대로 읽히므로 블록당 한 번만 읽음)
+    uint32_t cluster_bytes = (uint32_t)vol.sectors_per_cluster * SD_CARD_BLOCK_SIZE;
+    uint32_t clusters = (uint32_t)(((uint64_t)size + cluster_bytes - 1u) / cluster_bytes);
+    if (clusters > vol.cluster_count || first_cluster + clusters > vol.cluster_count + 2u) {
+        return false;
+    }
+    for (uint32_t i = 0; i < clusters; i++) {
+        uint32_t next;
+        if (!sd_file_fat_next(&vol, first_cluster + i, &next)) {
+            return false;
+        }
+        bool last = (i + 1u == clusters);
+        if (last ? (next < SD_FILE_FAT_EOC) : (next != first_cluster + i + 1u)) {
+            return false;
+        }
+    }
+
+    file->first_lba = sd_file_cluster_lba(&vol, first_cluster);
+    file->block_count = size / SD_CARD_BLOCK_SIZE;
+    file->size = size;
+
+    return true;
+}
@@ -0,0 +1,705 @@
+/**
+ * @file telemetry.c
+ * @brief 항법 해 텔레메트리 하향 링크 구현
+ */
+
+#include "log/telemetry.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 묶음 크기 (바이트, TelemetryGroup 순서)
+ */
+static const uint8_t telemetry_group_size[TELEMETRY_GROUP_COUNT] = TELEMETRY_GROUP_SIZES;
+
+_Static_assert(TELEMETRY_READY_BLOCKS == CONVERGENCE_BLOCK_COUNT, "READY group layout does not match the convergence blocks");
+
+_Static_assert(TELEMETRY_NAV_HEADER_SIZE + 4 + 12 + 6 + 4 <= TELEMETRY_NAV_PAYLOAD_SIZE,
+               "attitude, position, velocity and covariance must fit one frame");
+_Static_assert(TELEMETRY_GROUP_COUNT <= 16, "group mask does not fit in uint16_t");
+
+/**
+ * @brief 리틀 엔디언 쓰기
+ */
+static uint8_t *telemetry_put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *telemetry_put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 고정소수점 변환 (반올림, 범위 밖은 포화)
+ */
+static int16_t telemetry_q16(float v, float lsb) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > 32767.0f) {
+        return 32767;
+    }
+    if (q < -32767.0f) {
+        return -32767;
+    }
+    return (int16_t)lrintf(q);
+}
+
+/**
+ * @brief 0 이상 고정소수점 변환 (반올림, 범위 밖은 포화)
+ */
+static uint16_t telemetry_uq16(float v, float lsb) {
+    float q = v / lsb;
+    if (!(q > 0.0f)) {
+        return 0;
+    }
+    if (q > 65535.0f) {
+        return UINT16_MAX;
+    }
+    return (uint16_t)lrintf(q);
+}
+
+static int32_t telemetry_q32(float v, float lsb) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > 2.0e9f) {
+        return 2000000000;
+    }
+    if (q < -2.0e9f) {
+        return -2000000000;
+    }
+    return (int32_t)lrintf(q);
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool telemetry_default_config(TelemetryConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->frame_period_us = 50000u;
+    config->group[TELEMETRY_GROUP_ATTITUDE] = (TelemetryGroupConfig){ 20.0f, 0 };
+    config->group[TELEMETRY_GROUP_VELOCITY] = (TelemetryGroupConfig){ 20.0f, 1 };
+    config->group[TELEMETRY_GROUP_POSITION] = (TelemetryGroupConfig){ 10.0f, 2 };
+    config->group[TELEMETRY_GROUP_APOGEE] = (TelemetryGroupConfig){ 5.0f, 3 };
+    config->group[TELEMETRY_GROUP_COVARIANCE] = (TelemetryGroupConfig){ 2.0f, 4 };
+    config->group[TELEMETRY_GROUP_BIAS] = (TelemetryGroupConfig){ 1.0f, 5 };
+    config->group[TELEMETRY_GROUP_LOAD] = (TelemetryGroupConfig){ 1.0f, 6 };
+    config->group[TELEMETRY_GROUP_READY] = (TelemetryGroupConfig){ 0.5f, 7 };
+    config->group[TELEMETRY_GROUP_LANDING] = (TelemetryGroupConfig){ 1.0f, 8 };
+    config->group[TELEMETRY_GROUP_HIL] = (TelemetryGroupConfig){ 2.0f, 9 };
+    config->group[TELEMETRY_GROUP_VIBE] = (TelemetryGroupConfig){ 1.0f, 10 };
+    config->group[TELEMETRY_GROUP_NIS] = (TelemetryGroupConfig){ 1.0f, 11 };
+
+    return true;
+}
+
+/**
+ * @brief 텔레메트리 초기화
+ */
+bool telemetry_init(Telemetry *tm, UART_HandleTypeDef *huart, const NavPublisher *pub, HwCrc *crc,
+                    const TelemetryConfig *config) {
+    if (tm == NULL || huart == NULL || pub == NULL) {
+        return false;
+    }
+
+    memset(tm, 0, sizeof(*tm));
+    if (config != NULL) {
+        tm->config = *config;
+    } else {
+        telemetry_default_config(&tm->config);
+    }
+    if (tm->config.frame_period_us == 0) {
+        return false;
+    }
+
+    tm->huart = huart;
+    tm->pub = pub;
+    telemetry_frame_init(&tm->framer, crc);
+    atomic_flag_clear(&tm->tx_busy);
+
+    // 묶음 주기와 우선순위 순서 (같은 우선순위는 묶음 번호 순, 삽입 정렬)
+    for (uint8_t g = 0; g < TELEMETRY_GROUP_COUNT; g++) {
+        float rate = tm->config.group[g].rate_hz;
+        tm->period_us[g] = (rate > 0.0f) ? (uint32_t)(1e6f / rate) : 0u;
+        if (rate > 0.0f && tm->period_us[g] == 0) {
+            tm->period_us[g] = 1u;
+        }
+
+        uint8_t i = g;
+        while (i > 0 && tm->config.group[tm->order[i - 1]].priority > tm->config.group[g].priority) {
+            tm->order[i] = tm->order[i - 1];
+            i--;
+        }
+        tm->order[i] = g;
+    }
+
+    tm->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 융합 부하 감시기 설정
+ */
+bool telemetry_set_monitor(Telemetry *tm, const FusionMonitor *monitor) {
+    if (tm == NULL) {
+        return false;
+    }
+
+    tm->monitor = monitor;
+
+    return true;
+}
+
+/**
+ * @brief 수렴 감시기 설정
+ */
+bool telemetry_set_convergence(Telemetry *tm, const ConvergenceMonitor *convergence) {
+    if (tm == NULL) {
+        return false;
+    }
+
+    tm->convergence = convergence;
+
+    return true;
+}
+
+/**
+ * @brief 착지 예측기 설정
+ */
+bool telemetry_set_landing(Telemetry *tm, const LandingPredictor *landing) {
+    if (tm == NULL) {
+        return false;
+    }
+
+    tm->landing = landing;
+
+    return true;
+}
+
+/**
+ * @brief HIL 공급기 설정
+ */
+bool telemetry_set_hil(Telemetry *tm, const HilFeed *hil) {
+    if (tm == NULL) {
+        return false;
+    }
+
+    tm->hil = hil;
+
+    return true;
+}
+
+/**
+ * @brief IMU 진동 통계 설정
+ */
+bool telemetry_set_vibration(Telemetry *tm, const ImuVibration *vibration) {
+    if (tm == NULL) {
+        return false;
+    }
+
+    tm->vibration = vibration;
+
+    return true;
+}
+
+/**
+ * @brief 혁신 감시기 설정
+ */
+bool telemetry_set_innovation(Telemetry *tm, const InnovationMonitor *innovation) {
+    if (tm == NULL) {
+        return false;
+    }
+
+    tm->innovation = innovation;
+
+    return true;
+}
+
+/**
+ * @brief 사원수 smallest-three 부호화
+ */
+uint32_t telemetry_encode_quat(Quaternion q) {
+    float c[4] = { q.w, q.x, q.y, q.z };
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; i++) {
+        if (fabsf(c[i]) > fabsf(c[largest])) {
+            largest = i;
+        }
+    }
+    float sign = (c[largest] < 0.0f) ? -1.0f : 1.0f;
+
+    uint32_t code = largest << 30;
+    uint32_t shift = 20;
+    for (uint32_t i = 0; i < 4; i++) {
+        if (i == largest) {
+            continue;
+        }
+        float v = sign * c[i] / TELEMETRY_QUAT_RANGE;
+        if (v > 1.0f) {
+            v = 1.0f;
+        } else if (!(v > -1.0f)) {
+            v = -1.0f;
+        }
+        uint32_t field = (uint32_t)(lrintf(v * (float)TELEMETRY_QUAT_HALF) + TELEMETRY_QUAT_HALF);
+        code |= field << shift;
+        shift -= 10;
+    }
+
+    return code;
+}
+
+/**
+ * @brief 사원수 smallest-three 복호화
+ */
+Quaternion telemetry_decode_quat(uint32_t code) {
+    float c[4];
+    uint32_t largest = code >> 30;
+    uint32_t shift = 20;
+    float sum = 0.0f;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        if (i == largest) {
+            continue;
+        }
+        int32_t field = (int32_t)((code >> shift) & 0x3FFu) - TELEMETRY_QUAT_HALF;
+        c[i] = (float)field * (TELEMETRY_QUAT_RANGE / (float)TELEMETRY_QUAT_HALF);
+        sum += c[i] * c[i];
+        shift -= 10;
+    }
+    c[largest] = (sum < 1.0f) ? fast_sqrtf(1.0f - sum) : 0.0f;
+
+    Quaternion q = { c[0], c[1], c[2], c[3] };
+
+    return quaternion_normalize(q);
+}
+
+/**
+ * @brief 표준 편차 로그 눈금 부호화
+ */
+uint8_t telemetry_encode_std(float std, float base) {
+    if (!(std > base)) {
+        return 0;
+    }
+
+    float code = 16.0f * log2f(std / base);
+    if (!(code < 255.0f)) {
+        return 255;
+    }
+
+    return (uint8_t)lrintf(code);
+}
+
+/**
+ * @brief 표준 편차 로그 눈금 복호화
+ */
+float telemetry_decode_std(uint8_t code, float base) {
+    return base * exp2f((float)code * (1.0f / 16.0f));
+}
+
+/**
+ * @brief 공분산 요약 (수평/수직 위치, 속도, 자세 표준 편차)
+ */
+static uint8_t *telemetry_put_covariance(uint8_t *p, const EKF_NavSolution *sol) {
+    const float *d = sol->p_diag;
+
+#if EKF_CONFIG_POSITION
+    float pos_h = fast_sqrtf(d[EKF_STATE_POS_X] + d[EKF_STATE_POS_Y]);
+    float pos_v = fast_sqrtf(d[EKF_STATE_POS_Z]);
+#else
+    float pos_h = 0.0f;
+    float pos_v = 0.0f;
+#endif
+    float vel = fast_sqrtf(d[EKF_STATE_VEL_X] + d[EKF_STATE_VEL_Y] + d[EKF_STATE_VEL_Z]);
+
+    // 작은 각에서 회전각 오차 ~ 2|dq_xyz|
+    float att = 2.0f * fast_sqrtf(d[EKF_STATE_QUAT_X] + d[EKF_STATE_QUAT_Y] + d[EKF_STATE_QUAT_Z]);
+
+    p[0] = telemetry_encode_std(pos_h, TELEMETRY_STD_BASE_POS);
+    p[1] = telemetry_encode_std(pos_v, TELEMETRY_STD_BASE_POS);
+    p[2] = telemetry_encode_std(vel, TELEMETRY_STD_BASE_VEL);
+    p[3] = telemetry_encode_std(att, TELEMETRY_STD_BASE_ATT);
+
+    return p + 4;
+}
+
+/**
+ * @brief 0.1% 단위 부하율을 % u8로 (포화)
+ */
+static uint8_t telemetry_load_percent(uint16_t permille) {
+    uint32_t pct = ((uint32_t)permille + 5u) / 10u;
+    return (pct > 255u) ? 255u : (uint8_t)pct;
+}
+
+/**
+ * @brief 융합 부하 묶음 (감시기가 마지막으로 기록한 단계)
+ */
+static uint8_t *telemetry_put_load(uint8_t *p, const FusionMonitor *mon) {
+    FlightPhase phase = mon->phase;
+    const FusionMonitorPhaseStats *st = fusion_monitor_get_stats(mon, phase);
+    if (st == NULL) {
+        memset(p, 0, 8);
+        return p + 8;
+    }
+
+    *p++ = (uint8_t)phase;
+    *p++ = telemetry_load_percent(mon->last_load);
+    *p++ = telemetry_load_percent(st->peak_load);
+    p = telemetry_put16(p, (st->max_busy_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)st->max_busy_us);
+    *p++ = fusion_monitor_late_quantile_bin(mon, phase, 990u);
+
+    return telemetry_put16(p, (st->misses > UINT16_MAX) ? UINT16_MAX : (uint16_t)st->misses);
+}
+
+/**
+ * @brief 경과 시간을 0.1 s u16으로 (CONVERGENCE_NEVER는 0xFFFF, 그 밖은 0xFFFE 포화)
+ */
+static uint16_t telemetry_ready_time(uint32_t elapsed_us) {
+    if (elapsed_us == CONVERGENCE_NEVER) {
+        return UINT16_MAX;
+    }
+
+    uint32_t t = (elapsed_us + TELEMETRY_READY_TIME_LSB_US / 2u) / TELEMETRY_READY_TIME_LSB_US;
+    return (t >= UINT16_MAX) ? (uint16_t)(UINT16_MAX - 1u) : (uint16_t)t;
+}
+
+/**
+ * @brief 수렴/준비 묶음
+ */
+static uint8_t *telemetry_put_ready(uint8_t *p, const ConvergenceMonitor *mon) {
+    const ConvergenceMonitorStats *st = &mon->stats;
+
+    *p++ = (uint8_t)((mon->converged_mask & 0x7Fu) | (mon->ready ? 0x80u : 0u));
+    p = telemetry_put16(p, telemetry_ready_time(st->ready_us));
+    for (uint8_t b = 0; b < CONVERGENCE_BLOCK_COUNT; b++) {
+        p = telemetry_put16(p, telemetry_ready_time(st->block[b].converged_us));
+    }
+
+    return p;
+}
+
+/**
+ * @brief 착지 예측 묶음
+ */
+static uint8_t *telemetry_put_landing(uint8_t *p, const LandingPrediction *out) {
+    p = telemetry_put16(p, (uint16_t)telemetry_q16(out->land[0], TELEMETRY_LAND_POS_LSB));
+    p = telemetry_put16(p, (uint16_t)telemetry_q16(out->land[1], TELEMETRY_LAND_POS_LSB));
+
+    float t = out->time_to_ground / TELEMETRY_LAND_TIME_LSB;
+    p = telemetry_put16(p, (t > 65535.0f) ? 65535u : (t > 0.0f) ? (uint16_t)lrintf(t) : 0u);
+    p = telemetry_put16(p, (uint16_t)telemetry_q16(out->wind[0], TELEMETRY_VEL_LSB));
+    p = telemetry_put16(p, (uint16_t)telemetry_q16(out->wind[1], TELEMETRY_VEL_LSB));
+    *p++ = telemetry_encode_std(out->land_std, TELEMETRY_STD_BASE_LAND);
+
+    return p;
+}
+
+/**
+ * @brief u32 계수를 u16으로 포화
+ */
+static uint16_t telemetry_sat16(uint32_t v) {
+    return (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
+}
+
+/**
+ * @brief HIL 공급기 묶음
+ */
+static uint8_t *telemetry_put_hil(uint8_t *p, const HilFeed *hil) {
+    const HilFeedStats *st = &hil->stats;
+    uint32_t fill = hil_feed_pending(hil);
+
+    *p++ = (fill > UINT8_MAX) ? UINT8_MAX : (uint8_t)fill;
+    *p++ = (st->max_fill > UINT8_MAX) ? UINT8_MAX : (uint8_t)st->max_fill;
+    p = telemetry_put16(p, (uint16_t)st->frames);
+    p = telemetry_put16(p, telemetry_sat16(st->late));
+    p = telemetry_put16(p, telemetry_sat16(st->overflow + st->queue_drops));
+
+    return telemetry_put16(p, telemetry_sat16(st->crc_errors + st->bad_records + st->lost + st->uart_errors));
+}
+
+/**
+ * @brief 세 성분 중 최댓값
+ */
+static float telemetry_max3(Vector3f v) {
+    float m = (v.x > v.y) ? v.x : v.y;
+    return (m > v.z) ? m : v.z;
+}
+
+/**
+ * @brief IMU 진동 묶음
+ */
+static uint8_t *telemetry_put_vibe(uint8_t *p, const ImuVibration *vibration) {
+    ImuVibrationMetrics m;
+    imu_vibration_get_metrics(vibration, &m);
+
+    p = telemetry_put16(p, telemetry_uq16(m.accel_rms.x, TELEMETRY_VIBE_ACCEL_LSB));
+    p = telemetry_put16(p, telemetry_uq16(m.accel_rms.y, TELEMETRY_VIBE_ACCEL_LSB));
+    p = telemetry_put16(p, telemetry_uq16(m.accel_rms.z, TELEMETRY_VIBE_ACCEL_LSB));
+    p = telemetry_put16(p, telemetry_uq16(m.gyro_rms.x, TELEMETRY_VIBE_GYRO_LSB));
+    p = telemetry_put16(p, telemetry_uq16(m.gyro_rms.y, TELEMETRY_VIBE_GYRO_LSB));
+    p = telemetry_put16(p, telemetry_uq16(m.gyro_rms.z, TELEMETRY_VIBE_GYRO_LSB));
+    p = telemetry_put16(p, telemetry_uq16(telemetry_max3(m.accel_peak), TELEMETRY_PEAK_ACCEL_LSB));
+    p = telemetry_put16(p, telemetry_uq16(telemetry_max3(m.gyro_peak), TELEMETRY_PEAK_GYRO_LSB));
+
+    uint8_t axes = 0;
+    for (uint8_t k = 0; k < 3; k++) {
+        axes |= (m.gyro_clips[k] > 0) ? (uint8_t)(1u << k) : 0u;
+        axes |= (m.accel_clips[k] > 0) ? (uint8_t)(1u << (3u + k)) : 0u;
+    }
+    *p++ = axes;
+
+    return telemetry_put16(p, telemetry_sat16(m.clip_total));
+}
+
+/**
+ * @brief 혁신 NIS 묶음 (ratio가 가장 큰 두 측정)
+ */
+static uint8_t *telemetry_put_nis(uint8_t *p, const InnovationMonitor *innovation) {
+    InnovationMetrics m;
+    innovation_monitor_get_metrics(innovation, &m);
+
+    for (uint8_t k = 0; k < 2; k++) {
+        uint8_t s = m.worst[k];
+        if (s >= EKF_SENSOR_COUNT) {
+            memset(p, 0, 6);
+            p[0] = 0xFFu;
+            p += 6;
+            continue;
+        }
+        const InnovationSensorMetrics *sm = &m.sensor[s];
+        *p++ = s;
+        *p++ = (sm->count > UINT8_MAX) ? UINT8_MAX : (uint8_t)sm->count;
+        *p++ = (sm->rejects > UINT8_MAX) ? UINT8_MAX : (uint8_t)sm->rejects;
+        *p++ = telemetry_encode_std(sm->mean, TELEMETRY_STD_BASE_NIS);
+        *p++ = telemetry_encode_std(sm->std, TELEMETRY_STD_BASE_NIS);
+        *p++ = telemetry_encode_std(sm->max, TELEMETRY_STD_BASE_NIS);
+    }
+
+    return p;
+}
+
+/**
+ * @brief 묶음 하나 쓰기
+ */
+static uint8_t *telemetry_put_group(const Telemetry *tm, uint8_t *p, uint8_t group, const EKF_NavSolution *sol) {
+    switch (group) {
+    case TELEMETRY_GROUP_ATTITUDE:
+        return telemetry_put32(p, telemetry_encode_quat(sol->q));
+    case TELEMETRY_GROUP_POSITION:
+        p = telemetry_put32(p, (uint32_t)telemetry_q32(sol->pos.x, TELEMETRY_POS_LSB));
+        p = telemetry_put32(p, (uint32_t)telemetry_q32(sol->pos.y, TELEMETRY_POS_LSB));
+        return telemetry_put32(p, (uint32_t)telemetry_q32(sol->pos.z, TELEMETRY_POS_LSB));
+    case TELEMETRY_GROUP_VELOCITY:
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->vel.x, TELEMETRY_VEL_LSB));
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->vel.y, TELEMETRY_VEL_LSB));
+        return telemetry_put16(p, (uint16_t)telemetry_q16(sol->vel.z, TELEMETRY_VEL_LSB));
+    case TELEMETRY_GROUP_COVARIANCE:
+        return telemetry_put_covariance(p, sol);
+    case TELEMETRY_GROUP_APOGEE: {
+        float t = sol->apogee_time / TELEMETRY_APOGEE_TIME_LSB;
+        uint16_t tq = (t > 65535.0f) ? 65535u : (t > 0.0f) ? (uint16_t)lrintf(t) : 0u;
+        p = telemetry_put16(p, tq);
+        return telemetry_put32(p, (uint32_t)telemetry_q32(sol->apogee_alt, TELEMETRY_POS_LSB));
+    }
+    case TELEMETRY_GROUP_BIAS:
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->gyro_bias.x, TELEMETRY_GYRO_BIAS_LSB));
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->gyro_bias.y, TELEMETRY_GYRO_BIAS_LSB));
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->gyro_bias.z, TELEMETRY_GYRO_BIAS_LSB));
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->accel_bias.x, TELEMETRY_ACCEL_BIAS_LSB));
+        p = telemetry_put16(p, (uint16_t)telemetry_q16(sol->accel_bias.y, TELEMETRY_ACCEL_BIAS_LSB));
+        return telemetry_put16(p, (uint16_t)telemetry_q16(sol->accel_bias.z, TELEMETRY_ACCEL_BIAS_LSB));
+    case TELEMETRY_GROUP_LOAD:
+        return telemetry_put_load(p, tm->monitor);
+    case TELEMETRY_GROUP_READY:
+        return telemetry_put_ready(p, tm->convergence);
+    case TELEMETRY_GROUP_LANDING:
+        return telemetry_put_landing(p, &tm->landing->out);
+    case TELEMETRY_GROUP_HIL:
+        return telemetry_put_hil(p, tm->hil);
+    case TELEMETRY_GROUP_VIBE:
+        return telemetry_put_vibe(p, tm->vibration);
+    case TELEMETRY_GROUP_NIS:
+        return telemetry_put_nis(p, tm->innovation);
+    default:
+        return p;
+    }
+}
+
+/**
+ * @brief 묶음 출처가 있는지 (감시기 묶음은 감시기가 설정되어야 보냄)
+ */
+static bool telemetry_group_available(const Telemetry *tm, uint8_t group) {
+    switch (group) {
+    case TELEMETRY_GROUP_LOAD:
+        return tm->monitor != NULL;
+    case TELEMETRY_GROUP_READY:
+        return tm->convergence != NULL;
+    case TELEMETRY_GROUP_LANDING:
+        return tm->landing != NULL && tm->landing->out.valid;
+    case TELEMETRY_GROUP_HIL:
+        return tm->hil != NULL;
+    case TELEMETRY_GROUP_VIBE: {
+        ImuVibrationMetrics m;
+        return imu_vibration_get_metrics(tm->vibration, &m);
+    }
+    case TELEMETRY_GROUP_NIS: {
+        InnovationMetrics m;
+        return innovation_monitor_get_metrics(tm->innovation, &m);
+    }
+    default:
+        return true;
+    }
+}
+
+/**
+ * @brief 묶음 주기가 되었는지 (이번 프레임 칸 안에 주기가 끝나면 된 것으로 봄)
+ *
+ * 호출 시각이 흔들려도 프레임 주기와 같은 전송률의 묶음이 매 프레임 들어가도록
+ * 프레임 주기의 절반만큼 앞당겨 판단한다.
+ */
+static bool telemetry_group_due(const Telemetry *tm, uint8_t group, uint32_t now_us) {
+    if (tm->period_us[group] == 0 || !telemetry_group_available(tm, group)) {
+        return false;
+    }
+    if ((tm->sent_mask & (1u << group)) == 0) {
+        return true;
+    }
+
+    uint32_t elapsed = (uint32_t)(now_us - tm->last_us[group]) + tm->config.frame_period_us / 2u;
+
+    return elapsed >= tm->period_us[group];
+}
+
+/**
+ * @brief 항법 해 페이로드 만들기
+ */
+uint16_t telemetry_build_nav(Telemetry *tm, const EKF_NavSolution *sol, uint32_t now_us, uint8_t *payload) {
+    if (tm == NULL || !tm->initialized || sol == NULL || payload == NULL) {
+        return 0;
+    }
+
+    // 묶음 선택: 주기가 된 묶음을 먼저, 남는 자리는 앞당겨 채움 (둘 다 우선순위 순)
+    uint16_t mask = 0;
+    uint32_t room = TELEMETRY_NAV_PAYLOAD_SIZE - TELEMETRY_NAV_HEADER_SIZE;
+    for (uint8_t i = 0; i < TELEMETRY_GROUP_COUNT; i++) {
+        uint8_t g = tm->order[i];
+        if (!telemetry_group_due(tm, g, now_us)) {
+            continue;
+        }
+        if (telemetry_group_size[g] <= room) {
+            mask |= (uint16_t)(1u << g);
+            room -= telemetry_group_size[g];
+        } else {
+            tm->deferred++;
+        }
+    }
+    for (uint8_t i = 0; i < TELEMETRY_GROUP_COUNT; i++) {
+        uint8_t g = tm->order[i];
+        if (tm->period_us[g] != 0 && (mask & (1u << g)) == 0 && telemetry_group_size[g] <= room &&
+            telemetry_group_available(tm, g)) {
+            mask |= (uint16_t)(1u << g);
+            room -= telemetry_group_size[g];
+        }
+    }
+
+    // 페이로드는 묶음 번호 순서
+    uint8_t *p = telemetry_put32(payload, sol->timestamp_us);
+    p = telemetry_put16(p, mask);
+    for (uint8_t g = 0; g < TELEMETRY_GROUP_COUNT; g++) {
+        if ((mask & (1u << g)) == 0) {
+            continue;
+        }
+        p = telemetry_put_group(tm, p, g, sol);
+        tm->last_us[g] = now_us;
+        tm->group_count[g]++;
+    }
+    tm->sent_mask |= mask;
+    memset(p, 0, (size_t)(payload + TELEMETRY_NAV_PAYLOAD_SIZE - p));
+
+    return mask;
+}
+
+/**
+ * @brief 프레임 송신 시작
+ */
+bool telemetry_service(Telemetry *tm, uint32_t now_us) {
+    if (tm == NULL || !tm->initialized) {
+        return false;
+    }
+    if (tm->started && (uint32_t)(now_us - tm->last_frame_us) < tm->config.frame_period_us) {
+        return false;
+    }
+
+    EKF_NavSolution sol;
+    if (!nav_publisher_read(tm->pub, &sol, NULL)) {
+        return false;
+    }
+
+    if (atomic_flag_test_and_set_explicit(&tm->tx_busy, memory_order_acquire)) {
+        // 이전 프레임이 아직 나가는 중: 이번 주기는 건너뜀
+        tm->busy_skips++;
+        tm->last_frame_us = now_us;
+        return false;
+    }
+
+    // 주기 기준은 호출 시각이 조금 늦어도 밀리지 않도록 예정 시각으로 이어감
+    if (tm->started && (uint32_t)(now_us - tm->last_frame_us) < 2u * tm->config.frame_period_us) {
+        tm->last_frame_us += tm->config.frame_period_us;
+    } else {
+        tm->last_frame_us = now_us;
+    }
+    tm->started = true;
+
+    uint8_t payload[TELEMETRY_NAV_PAYLOAD_SIZE];
+    telemetry_build_nav(tm, &sol, now_us, payload);
+    uint16_t size = telemetry_frame_pack(&tm->framer, TELEMETRY_TYPE_NAV, payload, TELEMETRY_NAV_PAYLOAD_SIZE,
+                                         tm->tx_buffer, sizeof(tm->tx_buffer));
+
+    if (size == 0 || HAL_UART_Transmit_DMA(tm->huart, tm->tx_buffer, size) != HAL_OK) {
+        tm->uart_errors++;
+        atomic_flag_clear_explicit(&tm->tx_busy, memory_order_release);
+        return false;
+    }
+    tm->frames++;
+
+    return true;
+}
+
+/**
+ * @brief DMA 송신 완료 처리
+ */
+void telemetry_handle_tx_complete(Telemetry *tm) {
+    if (tm == NULL || !tm->initialized) {
+        return;
+    }
+
+    atomic_flag_clear_explicit(&tm->tx_busy, memory_order_release);
+}
+
+/**
+ * @brief UART 오류 처리
+ */
+void telemetry_handle_uart_error(Telemetry *tm) {
+    if (tm == NULL || !tm->initialized) {
+        return;
+    }
+
+    tm->uart_errors++;
+    HAL_UART_AbortTransmit(tm->huart);
+    atomic_flag_clear_explicit(&tm->tx_busy, memory_order_release);
+}
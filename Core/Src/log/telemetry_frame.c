@@ -0,0 +1,98 @@
+/**
+ * @file telemetry_frame.c
+ * @brief 텔레메트리 프레임 구현
+ */
+
+#include "log/telemetry_frame.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief CRC 범위 시작 (길이 필드)
+ */
+#define TELEMETRY_FRAME_CRC_OFFSET 2u
+
+/**
+ * @brief 프레임 조립기 초기화
+ */
+bool telemetry_frame_init(TelemetryFramer *framer, HwCrc *crc) {
+    if (framer == NULL) {
+        return false;
+    }
+
+    framer->crc = crc;
+    framer->seq = 0;
+    framer->frames = 0;
+
+    return true;
+}
+
+/**
+ * @brief 프레임 조립
+ */
+uint16_t telemetry_frame_pack(TelemetryFramer *framer, uint8_t type, const void *payload, uint8_t len,
+                              uint8_t *out, uint16_t out_size) {
+    uint16_t size = (uint16_t)(TELEMETRY_FRAME_HEADER + len + TELEMETRY_FRAME_TRAILER);
+    if (framer == NULL || out == NULL || (payload == NULL && len > 0) || out_size < size) {
+        return 0;
+    }
+
+    out[0] = TELEMETRY_FRAME_SYNC1;
+    out[1] = TELEMETRY_FRAME_SYNC2;
+    out[2] = len;
+    out[3] = type;
+    out[4] = (uint8_t)(framer->seq & 0xFFu);
+    out[5] = (uint8_t)(framer->seq >> 8);
+    if (len > 0) {
+        memcpy(&out[TELEMETRY_FRAME_HEADER], payload, len);
+    }
+
+    uint32_t crc = hw_crc32(framer->crc, &out[TELEMETRY_FRAME_CRC_OFFSET],
+                            (uint32_t)(TELEMETRY_FRAME_HEADER - TELEMETRY_FRAME_CRC_OFFSET) + len);
+    uint8_t *t = &out[TELEMETRY_FRAME_HEADER + len];
+    t[0] = (uint8_t)crc;
+    t[1] = (uint8_t)(crc >> 8);
+    t[2] = (uint8_t)(crc >> 16);
+    t[3] = (uint8_t)(crc >> 24);
+
+    framer->seq++;
+    framer->frames++;
+
+    return size;
+}
+
+/**
+ * @brief 수신 프레임 검사
+ */
+uint16_t telemetry_frame_check(HwCrc *crc, const uint8_t *frame, uint16_t size,
+                               uint8_t *type, uint16_t *seq, uint8_t *payload_len) {
+    if (frame == NULL || size < TELEMETRY_FRAME_HEADER + TELEMETRY_FRAME_TRAILER ||
+        frame[0] != TELEMETRY_FRAME_SYNC1 || frame[1] != TELEMETRY_FRAME_SYNC2) {
+        return 0;
+    }
+
+    uint8_t len = frame[2];
+    uint16_t total = (uint16_t)(TELEMETRY_FRAME_HEADER + len + TELEMETRY_FRAME_TRAILER);
+    if (size < total) {
+        return 0;
+    }
+
+    const uint8_t *t = &frame[TELEMETRY_FRAME_HEADER + len];
+    uint32_t expected = (uint32_t)t[0] | ((uint32_t)t[1] << 8) | ((uint32_t)t[2] << 16) | ((uint32_t)t[3] << 24);
+    if (hw_crc32(crc, &frame[TELEMETRY_FRAME_CRC_OFFSET],
+                 (uint32_t)(TELEMETRY_FRAME_HEADER - TELEMETRY_FRAME_CRC_OFFSET) + len) != expected) {
+        return 0;
+    }
+
+    if (type != NULL) {
+        *type = frame[3];
+    }
+    if (seq != NULL) {
+        *seq = (uint16_t)(frame[4] | (frame[5] << 8));
+    }
+    if (payload_len != NULL) {
+        *payload_len = len;
+    }
+
+    return total;
+}
@@ -0,0 +1,717 @@
+/**
+ * @file usb_download.c
+ * @brief 비행 후 기록 내려받기 구현 (CDC ACM 최소 장치)
+ */
+
+#include "sys/board_profile.h"
+
+#if BOARD_HAS_USB
+
+#include "log/usb_download.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 표준 요청 (USB 2.0 9.4)
+ */
+#define USB_REQ_GET_STATUS 0x00u
+#define USB_REQ_CLEAR_FEATURE 0x01u
+#define USB_REQ_SET_FEATURE 0x03u
+#define USB_REQ_SET_ADDRESS 0x05u
+#define USB_REQ_GET_DESCRIPTOR 0x06u
+#define USB_REQ_GET_CONFIGURATION 0x08u
+#define USB_REQ_SET_CONFIGURATION 0x09u
+#define USB_REQ_GET_INTERFACE 0x0Au
+#define USB_REQ_SET_INTERFACE 0x0Bu
+
+/**
+ * @brief CDC 클래스 요청 (PSTN 6.3)
+ */
+#define CDC_REQ_SET_LINE_CODING 0x20u
+#define CDC_REQ_GET_LINE_CODING 0x21u
+#define CDC_REQ_SET_CONTROL_LINE_STATE 0x22u
+#define CDC_REQ_SEND_BREAK 0x23u
+
+/**
+ * @brief 설명자 종류
+ */
+#define USB_DESC_DEVICE 0x01u
+#define USB_DESC_CONFIGURATION 0x02u
+#define USB_DESC_STRING 0x03u
+
+/**
+ * @brief bmRequestType 필드
+ */
+#define USB_REQ_TYPE_MASK 0x60u
+#define USB_REQ_TYPE_STANDARD 0x00u
+#define USB_REQ_TYPE_CLASS 0x20u
+#define USB_REQ_RECIPIENT_MASK 0x1Fu
+#define USB_REQ_RECIPIENT_ENDPOINT 0x02u
+
+/**
+ * @brief 기능/상태 값
+ */
+#define USB_FEATURE_ENDPOINT_HALT 0x00u
+
+/**
+ * @brief FIFO 배분 (32비트 워드, OTG_FS 합계 320 이하)
+ */
+#define USB_DOWNLOAD_RX_FIFO_WORDS 128u  /**< 공용 RX FIFO */
+#define USB_DOWNLOAD_TX0_FIFO_WORDS 32u  /**< EP0 IN (두 패킷) */
+#define USB_DOWNLOAD_TX1_FIFO_WORDS 128u /**< 데이터 IN (여덟 패킷, FIFO가 비기 전에 채움) */
+#define USB_DOWNLOAD_TX2_FIFO_WORDS 16u  /**< 알림 IN */
+
+/**
+ * @brief 장치 설명자
+ */
+static const uint8_t usb_download_device_desc[18] = {
+    18, USB_DESC_DEVICE,
+    0x00, 0x02,                                      // USB 2.0
+    0x02, 0x00, 0x00,                                // CDC (인터페이스에서 정의)
+    USB_DOWNLOAD_EP0_SIZE,
+    (uint8_t)USB_DOWNLOAD_VID, (uint8_t)(USB_DOWNLOAD_VID >> 8),
+    (uint8_t)USB_DOWNLOAD_PID, (uint8_t)(USB_DOWNLOAD_PID >> 8),
+    0x00, 0x01,                                      // 장치 버전 1.00
+    1, 2, 3,                                         // 제조사, 제품, 일련번호 문자열
+    1                                                // 설정 수
+};
+
+/**
+ * @brief 설정 설명자 (통신 인터페이스 + 데이터 인터페이스)
+ */
+static const uint8_t usb_download_config_desc[67] = {
+    9, USB_DESC_CONFIGURATION, 67, 0, 2, 1, 0, 0x80, 50,    // 버스 전원, 100 mA
+
+    // 인터페이스 0: CDC 통신 (ACM)
+    9, 0x04, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+    5, 0x24, 0x00, 0x10, 0x01,                              // 헤더 (CDC 1.10)
+    5, 0x24, 0x01, 0x00, 1,                                 // 호출 관리
+    4, 0x24, 0x02, 0x02,                                    // ACM (회선 설정/상태)
+    5, 0x24, 0x06, 0, 1,                                    // 공용체 (통신 0, 데이터 1)
+    7, 0x05, USB_DOWNLOAD_EP_NOTIFY, 0x03, USB_DOWNLOAD_NOTIFY_SIZE, 0, 16,
+
+    // 인터페이스 1: CDC 데이터
+    9, 0x04, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+    7, 0x05, USB_DOWNLOAD_EP_OUT, 0x02, USB_DOWNLOAD_BULK_SIZE, 0, 0,
+    7, 0x05, USB_DOWNLOAD_EP_IN, 0x02, USB_DOWNLOAD_BULK_SIZE, 0, 0
+};
+
+/**
+ * @brief 언어 문자열 설명자 (영어)
+ */
+static const uint8_t usb_download_lang_desc[4] = { 4, USB_DESC_STRING, 0x09, 0x04 };
+
+/**
+ * @brief 기본 회선 설정 (115200 8N1)
+ */
+static const uint8_t usb_download_default_line[7] = { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 };
+
+/**
+ * @brief 제어 데이터 IN 다음 패킷 송신
+ */
+static void usb_download_ep0_continue(UsbDownload *dl) {
+    uint16_t chunk = dl->ep0_remaining;
+    if (chunk > USB_DOWNLOAD_EP0_SIZE) {
+        chunk = USB_DOWNLOAD_EP0_SIZE;
+    }
+
+    HAL_PCD_EP_Transmit(dl->hpcd, 0x80u, (uint8_t *)dl->ep0_data, chunk);
+    dl->ep0_data += chunk;
+    dl->ep0_remaining -= chunk;
+}
+
+/**
+ * @brief 제어 데이터 IN 단계 시작 (요청 길이로 자름)
+ */
+static void usb_download_ep0_send(UsbDownload *dl, const uint8_t *data, uint16_t len, uint16_t requested) {
+    if (len > requested) {
+        len = requested;
+    }
+
+    // 요청보다 짧고 패킷 크기의 배수이면 ZLP로 끝을 알림
+    dl->ep0_zlp = (len < requested) && (len % USB_DOWNLOAD_EP0_SIZE) == 0;
+    dl->ep0_data = data;
+    dl->ep0_remaining = len;
+    dl->ep0_state = USB_DOWNLOAD_EP0_DATA_IN;
+    usb_download_ep0_continue(dl);
+}
+
+/**
+ * @brief 제어 상태 IN 단계 (ZLP)
+ */
+static void usb_download_ep0_status(UsbDownload *dl) {
+    dl->ep0_state = USB_DOWNLOAD_EP0_STATUS_IN;
+    HAL_PCD_EP_Transmit(dl->hpcd, 0x80u, NULL, 0);
+}
+
+/**
+ * @brief 처리하지 않는 요청 거부
+ */
+static void usb_download_ep0_stall(UsbDownload *dl) {
+    dl->stats.stalls++;
+    dl->ep0_state = USB_DOWNLOAD_EP0_IDLE;
+    HAL_PCD_EP_SetStall(dl->hpcd, 0x80u);
+    HAL_PCD_EP_SetStall(dl->hpcd, 0x00u);
+}
+
+/**
+ * @brief ASCII 문자열을 문자열 설명자(UTF-16LE)로 변환
+ */
+static uint16_t usb_download_string(uint8_t *out, const char *text) {
+    uint16_t len = 2;
+    while (*text != '\0' && len + 2u <= USB_DOWNLOAD_EP0_SIZE) {
+        out[len++] = (uint8_t)*text++;
+        out[len++] = 0;
+    }
+    out[0] = (uint8_t)len;
+    out[1] = USB_DESC_STRING;
+
+    return len;
+}
+
+/**
+ * @brief 일련번호 문자열 (장치 고유 ID 96비트, 16진수 24자)
+ */
+static uint16_t usb_download_serial(uint8_t *out) {
+    static const char hex[] = "0123456789ABCDEF";
+    const uint32_t *uid = (const uint32_t *)UID_BASE;
+    char text[25];
+
+    for (uint32_t w = 0; w < 3u; w++) {
+        uint32_t v = uid[w];
+        for (uint32_t i = 0; i < 8u; i++) {
+            text[w * 8u + i] = hex[(v >> (28u - 4u * i)) & 0xFu];
+        }
+    }
+    text[24] = '\0';
+
+    return usb_download_string(out, text);
+}
+
+/**
+ * @brief GET_DESCRIPTOR
+ */
+static void usb_download_get_descriptor(UsbDownload *dl, uint16_t value, uint16_t length) {
+    uint8_t type = (uint8_t)(value >> 8);
+    uint8_t index = (uint8_t)value;
+
+    if (type == USB_DESC_DEVICE) {
+        usb_download_ep0_send(dl, usb_download_device_desc, sizeof(usb_download_device_desc), length);
+    } else if (type == USB_DESC_CONFIGURATION) {
+        usb_download_ep0_send(dl, usb_download_config_desc, sizeof(usb_download_config_desc), length);
+    } else if (type == USB_DESC_STRING && index == 0) {
+        usb_download_ep0_send(dl, usb_download_lang_desc, sizeof(usb_download_lang_desc), length);
+    } else if (type == USB_DESC_STRING && index <= 3u) {
+        uint16_t len;
+        if (index == 1u) {
+            len = usb_download_string(dl->ep0_buffer, "HANARO");
+        } else if (index == 2u) {
+            len = usb_download_string(dl->ep0_buffer, "Polaris Log Download");
+        } else {
+            len = usb_download_serial(dl->ep0_buffer);
+        }
+        usb_download_ep0_send(dl, dl->ep0_buffer, len, length);
+    } else {
+        // 장치 한정자 등 (전속 전용 장치)
+        usb_download_ep0_stall(dl);
+    }
+}
+
+/**
+ * @brief SET_CONFIGURATION
+ */
+static bool usb_download_set_configuration(UsbDownload *dl, uint8_t value) {
+    if (value > 1u) {
+        return false;
+    }
+
+    atomic_store(&dl->reset_pending, true);
+    if (dl->configuration != 0) {
+        dl->configured = false;
+        HAL_PCD_EP_Close(dl->hpcd, USB_DOWNLOAD_EP_IN);
+        HAL_PCD_EP_Close(dl->hpcd, USB_DOWNLOAD_EP_OUT);
+        HAL_PCD_EP_Close(dl->hpcd, USB_DOWNLOAD_EP_NOTIFY);
+    }
+    dl->configuration = value;
+    if (value == 0) {
+        return true;
+    }
+
+    HAL_PCD_EP_Open(dl->hpcd, USB_DOWNLOAD_EP_IN, USB_DOWNLOAD_BULK_SIZE, EP_TYPE_BULK);
+    HAL_PCD_EP_Open(dl->hpcd, USB_DOWNLOAD_EP_OUT, USB_DOWNLOAD_BULK_SIZE, EP_TYPE_BULK);
+    HAL_PCD_EP_Open(dl->hpcd, USB_DOWNLOAD_EP_NOTIFY, USB_DOWNLOAD_NOTIFY_SIZE, EP_TYPE_INTR);
+
+    // 새로 연 끝점이므로 이전 명령은 버리고 명령 대기
+    atomic_store(&dl->rx_pending, false);
+    HAL_PCD_EP_Receive(dl->hpcd, USB_DOWNLOAD_EP_OUT, dl->rx_buffer, sizeof(dl->rx_buffer));
+    dl->configured = true;
+
+    return true;
+}
+
+/**
+ * @brief 표준 요청
+ */
+static void usb_download_standard_request(UsbDownload *dl, uint8_t type, uint8_t request,
+                                          uint16_t value, uint16_t index, uint16_t length) {
+    uint8_t recipient = type & USB_REQ_RECIPIENT_MASK;
+
+    switch (request) {
+    case USB_REQ_GET_STATUS:
+        dl->ep0_buffer[0] = 0;
+        dl->ep0_buffer[1] = 0;
+        usb_download_ep0_send(dl, dl->ep0_buffer, 2, length);
+        break;
+    case USB_REQ_CLEAR_FEATURE:
+    case USB_REQ_SET_FEATURE:
+        if (recipient != USB_REQ_RECIPIENT_ENDPOINT || value != USB_FEATURE_ENDPOINT_HALT) {
+            usb_download_ep0_stall(dl);
+            break;
+        }
+        if (request == USB_REQ_SET_FEATURE) {
+            HAL_PCD_EP_SetStall(dl->hpcd, (uint8_t)index);
+        } else {
+            HAL_PCD_EP_ClrStall(dl->hpcd, (uint8_t)index);
+        }
+        usb_download_ep0_status(dl);
+        break;
+    case USB_REQ_SET_ADDRESS:
+        // OTG 코어는 상태 단계 전에 주소를 설정함
+        HAL_PCD_SetAddress(dl->hpcd, (uint8_t)(value & 0x7Fu));
+        usb_download_ep0_status(dl);
+        break;
+    case USB_REQ_GET_DESCRIPTOR:
+        usb_download_get_descriptor(dl, value, length);
+        break;
+    case USB_REQ_GET_CONFIGURATION:
+        dl->ep0_buffer[0] = dl->configuration;
+        usb_download_ep0_send(dl, dl->ep0_buffer, 1, length);
+        break;
+    case USB_REQ_SET_CONFIGURATION:
+        if (usb_download_set_configuration(dl, (uint8_t)value)) {
+            usb_download_ep0_status(dl);
+        } else {
+            usb_download_ep0_stall(dl);
+        }
+        break;
+    case USB_REQ_GET_INTERFACE:
+        dl->ep0_buffer[0] = 0;
+        usb_download_ep0_send(dl, dl->ep0_buffer, 1, length);
+        break;
+    case USB_REQ_SET_INTERFACE:
+        usb_download_ep0_status(dl);
+        break;
+    default:
+        usb_download_ep0_stall(dl);
+        break;
+    }
+}
+
+/**
+ * @brief CDC 클래스 요청
+ */
+static void usb_download_class_request(UsbDownload *dl, uint8_t request, uint16_t value, uint16_t length) {
+    switch (request) {
+    case CDC_REQ_SET_LINE_CODING:
+        if (length != sizeof(dl->line_coding)) {
+            usb_download_ep0_stall(dl);
+            break;
+        }
+        dl->ep0_request = request;
+        dl->ep0_state = USB_DOWNLOAD_EP0_DATA_OUT;
+        HAL_PCD_EP_Receive(dl->hpcd, 0x00u, dl->ep0_buffer, length);
+        break;
+    case CDC_REQ_GET_LINE_CODING:
+        usb_download_ep0_send(dl, dl->line_coding, sizeof(dl->line_coding), length);
+        break;
+    case CDC_REQ_SET_CONTROL_LINE_STATE:
+        dl->dtr = (value & 0x0001u) != 0;
+        usb_download_ep0_status(dl);
+        break;
+    case CDC_REQ_SEND_BREAK:
+        usb_download_ep0_status(dl);
+        break;
+    default:
+        usb_download_ep0_stall(dl);
+        break;
+    }
+}
+
+/**
+ * @brief 대기 중인 프레임 전송 시작 (주 루프 또는 IN 완료 인터럽트)
+ */
+static void usb_download_kick(UsbDownload *dl) {
+    if (atomic_flag_test_and_set(&dl->tx_busy)) {
+        return;
+    }
+
+    uint8_t i = dl->send_next;
+    if (!dl->configured || atomic_load(&dl->frame_state[i]) != USB_DOWNLOAD_BUFFER_READY) {
+        atomic_flag_clear(&dl->tx_busy);
+        return;
+    }
+
+    UsbDownloadFrame *frame = &dl->frame[i];
+    uint32_t len = sizeof(frame->header) + frame->header.length;
+    atomic_store(&dl->frame_state[i], USB_DOWNLOAD_BUFFER_SENDING);
+    if (HAL_PCD_EP_Transmit(dl->hpcd, USB_DOWNLOAD_EP_IN, (uint8_t *)frame, len) != HAL_OK) {
+        // 끝점이 닫힌 경우 (리셋 직후 등): 프레임을 버리고 호스트의 재요청에 맡김
+        atomic_store(&dl->frame_state[i], USB_DOWNLOAD_BUFFER_FREE);
+        dl->send_next = (uint8_t)(i ^ 1u);
+        atomic_flag_clear(&dl->tx_busy);
+        return;
+    }
+    dl->stats.frames++;
+    dl->stats.bytes += len;
+}
+
+/**
+ * @brief 채울 프레임 버퍼 (없으면 NULL)
+ */
+static UsbDownloadFrame *usb_download_free_frame(UsbDownload *dl) {
+    if (atomic_load(&dl->frame_state[dl->fill_next]) != USB_DOWNLOAD_BUFFER_FREE) {
+        return NULL;
+    }
+
+    return &dl->frame[dl->fill_next];
+}
+
+/**
+ * @brief 채운 프레임을 전송 대기로 넘김
+ */
+static void usb_download_queue(UsbDownload *dl, uint8_t type, uint8_t status, uint16_t length,
+                               uint32_t block, uint32_t remaining) {
+    UsbDownloadFrame *frame = &dl->frame[dl->fill_next];
+    frame->header.magic = USB_DOWNLOAD_FRAME_MAGIC;
+    frame->header.type = type;
+    frame->header.status = status;
+    frame->header.length = length;
+    frame->header.block = block;
+    frame->header.remaining = remaining;
+
+    atomic_store(&dl->frame_state[dl->fill_next], USB_DOWNLOAD_BUFFER_READY);
+    dl->fill_next ^= 1u;
+    usb_download_kick(dl);
+}
+
+/**
+ * @brief 요청 끝 프레임 예약
+ */
+static void usb_download_finish(UsbDownload *dl, uint8_t status) {
+    dl->streaming = false;
+    dl->done_pending = true;
+    dl->done_status = status;
+}
+
+/**
+ * @brief 명령 처리 (프레임 버퍼 하나가 비어 있을 때)
+ */
+static void usb_download_command(UsbDownload *dl, const UsbDownloadCommand *cmd) {
+    FlashLog *log = dl->log;
+    uint32_t blocks = flash_log_block_count(log);
+    UsbDownloadFrame *frame = &dl->frame[dl->fill_next];
+
+    switch (cmd->type) {
+    case USB_DOWNLOAD_CMD_INFO: {
+        UsbDownloadInfo info;
+        memset(&info, 0, sizeof(info));
+        info.block_count = blocks;
+        info.block_size = FLASH_LOG_BUFFER_SIZE;
+        info.capacity = (log->end_addr - log->start_addr) / FLASH_LOG_BUFFER_SIZE;
+        info.session = log->session;
+        info.backend = (uint8_t)log->backend;
+        info.index_blocks = flash_log_index_block_count(log);
+        memcpy(frame->data, &info, sizeof(info));
+        usb_download_queue(dl, USB_DOWNLOAD_FRAME_INFO, USB_DOWNLOAD_STATUS_OK, sizeof(info), 0, 0);
+        break;
+    }
+    case USB_DOWNLOAD_CMD_INDEX: {
+        // 프레임 페이로드를 SD 헤더 읽기 임시 버퍼로 쓰고 색인은 나중에 복사
+        uint8_t count = 0;
+        bool ok = flash_log_build_index(log, frame->data, dl->index, USB_DOWNLOAD_MAX_SESSIONS, &count);
+        if (!ok) {
+            dl->stats.read_errors++;
+            count = 0;
+        }
+        uint16_t len = (uint16_t)(count * sizeof(dl->index[0]));
+        memcpy(frame->data, dl->index, len);
+        usb_download_queue(dl, USB_DOWNLOAD_FRAME_INDEX, ok ? USB_DOWNLOAD_STATUS_OK : USB_DOWNLOAD_STATUS_READ_ERROR,
+                           len, 0, 0);
+        break;
+    }
+    case USB_DOWNLOAD_CMD_READ:
+    case USB_DOWNLOAD_CMD_READ_MARKS:
+        // 진행 중인 읽기는 새 범위로 바뀜 (호스트 이어받기)
+        dl->marks = (cmd->type == USB_DOWNLOAD_CMD_READ_MARKS);
+        if (dl->marks) {
+            blocks = flash_log_index_block_count(log);
+        }
+        dl->next_block = cmd->arg0;
+        if (cmd->arg0 >= blocks) {
+            usb_download_finish(dl, USB_DOWNLOAD_STATUS_RANGE);
+            break;
+        }
+        dl->end_block = (cmd->arg1 == 0 || cmd->arg1 > blocks - cmd->arg0) ? blocks : cmd->arg0 + cmd->arg1;
+        dl->streaming = true;
+        dl->done_pending = false;
+        break;
+    case USB_DOWNLOAD_CMD_ABORT:
+        usb_download_finish(dl, USB_DOWNLOAD_STATUS_ABORTED);
+        break;
+    default:
+        dl->stats.bad_commands++;
+        usb_download_finish(dl, USB_DOWNLOAD_STATUS_BAD_COMMAND);
+        break;
+    }
+}
+
+/**
+ * @brief 버스 리셋 뒤 전송 상태 정리 (주 루프)
+ */
+static void usb_download_flush(UsbDownload *dl) {
+    atomic_store(&dl->frame_state[0], USB_DOWNLOAD_BUFFER_FREE);
+    atomic_store(&dl->frame_state[1], USB_DOWNLOAD_BUFFER_FREE);
+    dl->fill_next = 0;
+    dl->send_next = 0;
+    atomic_flag_clear(&dl->tx_busy);
+    dl->streaming = false;
+    dl->done_pending = false;
+}
+
+/**
+ * @brief 초기화
+ */
+bool usb_download_init(UsbDownload *dl, PCD_HandleTypeDef *hpcd, FlashLog *log) {
+    if (dl == NULL || hpcd == NULL || log == NULL || !log->initialized) {
+        return false;
+    }
+
+    memset(dl, 0, sizeof(*dl));
+    dl->hpcd = hpcd;
+    dl->log = log;
+    memcpy(dl->line_coding, usb_download_default_line, sizeof(dl->line_coding));
+    atomic_init(&dl->frame_state[0], USB_DOWNLOAD_BUFFER_FREE);
+    atomic_init(&dl->frame_state[1], USB_DOWNLOAD_BUFFER_FREE);
+    atomic_init(&dl->rx_pending, false);
+    atomic_init(&dl->reset_pending, false);
+    atomic_flag_clear(&dl->tx_busy);
+
+    if (HAL_PCDEx_SetRxFiFo(hpcd, USB_DOWNLOAD_RX_FIFO_WORDS) != HAL_OK ||
+        HAL_PCDEx_SetTxFiFo(hpcd, 0, USB_DOWNLOAD_TX0_FIFO_WORDS) != HAL_OK ||
+        HAL_PCDEx_SetTxFiFo(hpcd, 1, USB_DOWNLOAD_TX1_FIFO_WORDS) != HAL_OK ||
+        HAL_PCDEx_SetTxFiFo(hpcd, 2, USB_DOWNLOAD_TX2_FIFO_WORDS) != HAL_OK) {
+        return false;
+    }
+
+    dl->initialized = true;
+    if (HAL_PCD_Start(hpcd) != HAL_OK) {
+        dl->initialized = false;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 정지
+ */
+bool usb_download_stop(UsbDownload *dl) {
+    if (dl == NULL || !dl->initialized) {
+        return false;
+    }
+
+    dl->configured = false;
+    dl->initialized = false;
+
+    return HAL_PCD_Stop(dl->hpcd) == HAL_OK;
+}
+
+/**
+ * @brief 명령 처리와 다음 블록 읽기
+ */
+void usb_download_service(UsbDownload *dl) {
+    if (dl == NULL || !dl->initialized) {
+        return;
+    }
+
+    // 버스 리셋/설정 변경 뒤에는 끊긴 전송을 버림 (호스트가 요청을 다시 보냄)
+    if (atomic_exchange(&dl->reset_pending, false)) {
+        usb_download_flush(dl);
+    }
+    if (!dl->configured) {
+        return;
+    }
+
+    // 명령 (응답 프레임 자리가 있을 때만 꺼내고, 그동안 OUT은 NAK)
+    if (atomic_load(&dl->rx_pending) && usb_download_free_frame(dl) != NULL) {
+        UsbDownloadCommand cmd;
+        uint16_t len = dl->rx_length;
+        memcpy(&cmd, dl->rx_buffer, sizeof(cmd));
+        atomic_store(&dl->rx_pending, false);
+        HAL_PCD_EP_Receive(dl->hpcd, USB_DOWNLOAD_EP_OUT, dl->rx_buffer, sizeof(dl->rx_buffer));
+
+        dl->stats.commands++;
+        if (len < sizeof(cmd)) {
+            dl->stats.bad_commands++;
+            usb_download_finish(dl, USB_DOWNLOAD_STATUS_BAD_COMMAND);
+        } else {
+            usb_download_command(dl, &cmd);
+        }
+    }
+
+    // 블록 (한 버퍼를 보내는 동안 다른 버퍼를 채움)
+    while (dl->streaming && dl->next_block < dl->end_block && usb_download_free_frame(dl) != NULL) {
+        if (!flash_log_idle(dl->log)) {
+            return;
+        }
+        UsbDownloadFrame *frame = &dl->frame[dl->fill_next];
+        bool ok = dl->marks ? flash_log_read_index_block(dl->log, dl->next_block, frame->data)
+                            : flash_log_read_block(dl->log, dl->next_block, frame->data);
+        if (!ok) {
+            dl->stats.read_errors++;
+            usb_download_finish(dl, USB_DOWNLOAD_STATUS_READ_ERROR);
+            break;
+        }
+        uint32_t block = dl->next_block++;
+        dl->stats.blocks++;
+        usb_download_queue(dl, dl->marks ? USB_DOWNLOAD_FRAME_MARKS : USB_DOWNLOAD_FRAME_DATA,
+                           USB_DOWNLOAD_STATUS_OK, FLASH_LOG_BUFFER_SIZE, block, dl->end_block - dl->next_block);
+    }
+    if (dl->streaming && dl->next_block >= dl->end_block) {
+        usb_download_finish(dl, USB_DOWNLOAD_STATUS_OK);
+    }
+
+    if (dl->done_pending && usb_download_free_frame(dl) != NULL) {
+        dl->done_pending = false;
+        usb_download_queue(dl, USB_DOWNLOAD_FRAME_DONE, dl->done_status, 0, dl->next_block, 0);
+    }
+}
+
+/**
+ * @brief 호스트 연결 여부
+ */
+bool usb_download_connected(const UsbDownload *dl) {
+    return dl != NULL && dl->initialized && dl->configured && dl->dtr;
+}
+
+/**
+ * @brief 설정 패킷 처리
+ */
+void usb_download_handle_setup(UsbDownload *dl) {
+    if (dl == NULL || !dl->initialized) {
+        return;
+    }
+
+    const uint8_t *setup = (const uint8_t *)dl->hpcd->Setup;
+    uint8_t type = setup[0];
+    uint8_t request = setup[1];
+    uint16_t value = (uint16_t)(setup[2] | (setup[3] << 8));
+    uint16_t index = (uint16_t)(setup[4] | (setup[5] << 8));
+    uint16_t length = (uint16_t)(setup[6] | (setup[7] << 8));
+
+    dl->ep0_state = USB_DOWNLOAD_EP0_IDLE;
+    switch (type & USB_REQ_TYPE_MASK) {
+    case USB_REQ_TYPE_STANDARD:
+        usb_download_standard_request(dl, type, request, value, index, length);
+        break;
+    case USB_REQ_TYPE_CLASS:
+        usb_download_class_request(dl, request, value, length);
+        break;
+    default:
+        usb_download_ep0_stall(dl);
+        break;
+    }
+}
+
+/**
+ * @brief OUT 전송 완료 처리
+ */
+void usb_download_handle_data_out(UsbDownload *dl, uint8_t epnum) {
+    if (dl == NULL || !dl->initialized) {
+        return;
+    }
+
+    if (epnum == 0) {
+        if (dl->ep0_state == USB_DOWNLOAD_EP0_DATA_OUT) {
+            if (dl->ep0_request == CDC_REQ_SET_LINE_CODING) {
+                memcpy(dl->line_coding, dl->ep0_buffer, sizeof(dl->line_coding));
+            }
+            usb_download_ep0_status(dl);
+        } else {
+            dl->ep0_state = USB_DOWNLOAD_EP0_IDLE;
+        }
+        return;
+    }
+
+    if (epnum == (USB_DOWNLOAD_EP_OUT & 0x0Fu)) {
+        // 주 루프가 꺼낼 때까지 다시 받지 않음 (호스트에는 NAK)
+        dl->rx_length = (uint16_t)HAL_PCD_EP_GetRxCount(dl->hpcd, USB_DOWNLOAD_EP_OUT);
+        atomic_store(&dl->rx_pending, true);
+    }
+}
+
+/**
+ * @brief IN 전송 완료 처리
+ */
+void usb_download_handle_data_in(UsbDownload *dl, uint8_t epnum) {
+    if (dl == NULL || !dl->initialized) {
+        return;
+    }
+
+    if (epnum == 0) {
+        if (dl->ep0_state != USB_DOWNLOAD_EP0_DATA_IN) {
+            dl->ep0_state = USB_DOWNLOAD_EP0_IDLE;
+        } else if (dl->ep0_remaining > 0) {
+            usb_download_ep0_continue(dl);
+        } else if (dl->ep0_zlp) {
+            dl->ep0_zlp = false;
+            HAL_PCD_EP_Transmit(dl->hpcd, 0x80u, NULL, 0);
+        } else {
+            dl->ep0_state = USB_DOWNLOAD_EP0_STATUS_OUT;
+            HAL_PCD_EP_Receive(dl->hpcd, 0x00u, NULL, 0);
+        }
+        return;
+    }
+
+    if (epnum == (USB_DOWNLOAD_EP_IN & 0x0Fu)) {
+        uint8_t i = dl->send_next;
+        if (atomic_load(&dl->frame_state[i]) == USB_DOWNLOAD_BUFFER_SENDING) {
+            atomic_store(&dl->frame_state[i], USB_DOWNLOAD_BUFFER_FREE);
+            dl->send_next = (uint8_t)(i ^ 1u);
+        }
+        atomic_flag_clear(&dl->tx_busy);
+        usb_download_kick(dl);
+    }
+}
+
+/**
+ * @brief 버스 리셋 처리
+ */
+void usb_download_handle_reset(UsbDownload *dl) {
+    if (dl == NULL || !dl->initialized) {
+        return;
+    }
+
+    // 끝점은 HAL이 닫음. 전송 상태는 주 루프가 정리 (usb_download_flush)
+    dl->stats.resets++;
+    atomic_store(&dl->reset_pending, true);
+    dl->configured = false;
+    dl->configuration = 0;
+    dl->dtr = false;
+    dl->ep0_state = USB_DOWNLOAD_EP0_IDLE;
+    HAL_PCD_EP_Open(dl->hpcd, 0x00u, USB_DOWNLOAD_EP0_SIZE, EP_TYPE_CTRL);
+    HAL_PCD_EP_Open(dl->hpcd, 0x80u, USB_DOWNLOAD_EP0_SIZE, EP_TYPE_CTRL);
+}
+
+/**
+ * @brief 통계
+ */
+const UsbDownloadStats *usb_download_get_stats(const UsbDownload *dl) {
+    if (dl == NULL) {
+        return NULL;
+    }
+
+    return &dl->stats;
+}
+
+#endif /* BOARD_HAS_USB */
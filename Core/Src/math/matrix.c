@@ -4,6 +4,7 @@
  */
 
 #include "math/matrix.h"
+#include "sys/mem_section.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -24,13 +25,24 @@ Matrix matrix_create(uint8_t rows, uint8_t cols) {
     // 모든 요소를 0으로 초기화
     for (uint8_t i = 0; i < rows; i++) {
         for (uint8_t j = 0; j < cols; j++) {
-            m.data[i][j] = 0.0f;
+            MATRIX_ELEM(&m, i, j) = 0.0f;
         }
     }
     
     return m;
 }
 
+/**
+ * @brief 결과 행렬 크기 설정 (원소는 초기화하지 않음)
+ *
+ * 모든 원소를 곧바로 덮어쓰는 연산에서 matrix_create의 0 채우기와
+ * 구조체 값 복사를 피하기 위해 사용한다.
+ */
+static void matrix_set_size(Matrix *m, uint8_t rows, uint8_t cols) {
+    m->rows = rows;
+    m->cols = cols;
+}
+
 /**
  * @brief 단위 행렬 생성
  */
@@ -39,7 +51,7 @@ Matrix matrix_identity(uint8_t size) {
     
     // 대각 요소를 1로 설정
     for (uint8_t i = 0; i < size; i++) {
-        m.data[i][i] = 1.0f;
+        MATRIX_ELEM(&m, i, i) = 1.0f;
     }
     
     return m;
@@ -53,7 +65,7 @@ bool matrix_set(Matrix *m, uint8_t row, uint8_t col, float value) {
         return false;
     }
     
-    m->data[row][col] = value;
+    MATRIX_ELEM(m, row, col) = value;
     return true;
 }
 
@@ -65,7 +77,7 @@ bool matrix_get(const Matrix *m, uint8_t row, uint8_t col, float *value) {
         return false;
     }
     
-    *value = m->data[row][col];
+    *value = MATRIX_ELEM(m, row, col);
     return true;
 }
 
@@ -77,11 +89,11 @@ bool matrix_add(const Matrix *a, const Matrix *b, Matrix *result) {
         return false;
     }
     
-    *result = matrix_create(a->rows, a->cols);
+    matrix_set_size(result, a->rows, a->cols);
     
     for (uint8_t i = 0; i < a->rows; i++) {
         for (uint8_t j = 0; j < a->cols; j++) {
-            result->data[i][j] = a->data[i][j] + b->data[i][j];
+            MATRIX_ELEM(result, i, j) = MATRIX_ELEM(a, i, j) + MATRIX_ELEM(b, i, j);
         }
     }
     
@@ -96,11 +108,11 @@ bool matrix_subtract(const Matrix *a, const Matrix *b, Matrix *result) {
         return false;
     }
     
-    *result = matrix_create(a->rows, a->cols);
+    matrix_set_size(result, a->rows, a->cols);
     
     for (uint8_t i = 0; i < a->rows; i++) {
         for (uint8_t j = 0; j < a->cols; j++) {
-            result->data[i][j] = a->data[i][j] - b->data[i][j];
+            MATRIX_ELEM(result, i, j) = MATRIX_ELEM(a, i, j) - MATRIX_ELEM(b, i, j);
         }
     }
     
@@ -110,20 +122,20 @@ bool matrix_subtract(const Matrix *a, const Matrix *b, Matrix *result) {
 /**
  * @brief 행렬 곱셈
  */
-bool matrix_multiply(const Matrix *a, const Matrix *b, Matrix *result) {
+MEM_RAMFUNC(matrix_multiply) bool matrix_multiply(const Matrix *a, const Matrix *b, Matrix *result) {
     if (a->cols != b->rows) {
         return false;
     }
     
-    *result = matrix_create(a->rows, b->cols);
+    matrix_set_size(result, a->rows, b->cols);
     
     for (uint8_t i = 0; i < a->rows; i++) {
         for (uint8_t j = 0; j < b->cols; j++) {
             float sum = 0.0f;
             for (uint8_t k = 0; k < a->cols; k++) {
-                sum += a->data[i][k] * b->data[k][j];
+                sum += MATRIX_ELEM(a, i, k) * MATRIX_ELEM(b, k, j);
             }
-            result->data[i][j] = sum;
+            MATRIX_ELEM(result, i, j) = sum;
         }
     }
     
@@ -134,11 +146,11 @@ bool matrix_multiply(const Matrix *a, const Matrix *b, Matrix *result) {
  * @brief 행렬 스칼라 곱
  */
 bool matrix_scale(const Matrix *m, float scalar, Matrix *result) {
-    *result = matrix_create(m->rows, m->cols);
+    matrix_set_size(result, m->rows, m->cols);
     
     for (uint8_t i = 0; i < m->rows; i++) {
         for (uint8_t j = 0; j < m->cols; j++) {
-            result->data[i][j] = m->data[i][j] * scalar;
+            MATRIX_ELEM(result, i, j) = MATRIX_ELEM(m, i, j) * scalar;
         }
     }
     
@@ -149,11 +161,11 @@ bool matrix_scale(const Matrix *m, float scalar, Matrix *result) {
  * @brief 행렬 전치
  */
 bool matrix_transpose(const Matrix *m, Matrix *result) {
-    *result = matrix_create(m->cols, m->rows);
+    matrix_set_size(result, m->cols, m->rows);
     
     for (uint8_t i = 0; i < m->rows; i++) {
         for (uint8_t j = 0; j < m->cols; j++) {
-            result->data[j][i] = m->data[i][j];
+            MATRIX_ELEM(result, j, i) = MATRIX_ELEM(m, i, j);
         }
     }
     
@@ -161,40 +173,107 @@ bool matrix_transpose(const Matrix *m, Matrix *result) {
 }
 
 /**
- * @brief 행렬 역행렬 계산 (가우스-조던 소거법 사용)
+ * @brief 전치 행렬과의 곱셈 (result = a * b^T)
  */
-bool matrix_inverse(const Matrix *m, Matrix *result) {
-    // 정방행렬 확인
-    if (m->rows != m->cols) {
+bool matrix_multiply_transpose(const Matrix *a, const Matrix *b, Matrix *result) {
+    if (a->cols != b->cols) {
         return false;
     }
     
-    uint8_t n = m->rows;
+    matrix_set_size(result, a->rows, b->rows);
     
-    // 증강 행렬 생성 [A|I]
-    Matrix augmented = matrix_create(n, 2 * n);
+    for (uint8_t i = 0; i < a->rows; i++) {
+        for (uint8_t j = 0; j < b->rows; j++) {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < a->cols; k++) {
+                sum += MATRIX_ELEM(a, i, k) * MATRIX_ELEM(b, j, k);
+            }
+            MATRIX_ELEM(result, i, j) = sum;
+        }
+    }
     
-    // 원본 행렬 복사
-    for (uint8_t i = 0; i < n; i++) {
-        for (uint8_t j = 0; j < n; j++) {
-            augmented.data[i][j] = m->data[i][j];
+    return true;
+}
+
+/**
+ * @brief 곱셈 누적 (result = result + a * b)
+ */
+bool matrix_multiply_accumulate(const Matrix *a, const Matrix *b, Matrix *result) {
+    if (a->cols != b->rows || result->rows != a->rows || result->cols != b->cols) {
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < a->rows; i++) {
+        for (uint8_t j = 0; j < b->cols; j++) {
+            float sum = MATRIX_ELEM(result, i, j);
+            for (uint8_t k = 0; k < a->cols; k++) {
+                sum += MATRIX_ELEM(a, i, k) * MATRIX_ELEM(b, k, j);
+            }
+            MATRIX_ELEM(result, i, j) = sum;
         }
     }
     
-    // 단위 행렬 추가
-    for (uint8_t i = 0; i < n; i++) {
-        augmented.data[i][i + n] = 1.0f;
+    return true;
+}
+
+/**
+ * @brief 제자리 행렬 덧셈 (m = m + b)
+ */
+bool matrix_add_in_place(Matrix *m, const Matrix *b) {
+    if (m->rows != b->rows || m->cols != b->cols) {
+        return false;
     }
     
-    // 가우스-조던 소거법
+    for (uint8_t i = 0; i < m->rows; i++) {
+        for (uint8_t j = 0; j < m->cols; j++) {
+            MATRIX_ELEM(m, i, j) += MATRIX_ELEM(b, i, j);
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 제자리 스칼라 곱 (m = m * scalar)
+ */
+bool matrix_scale_in_place(Matrix *m, float scalar) {
+    for (uint8_t i = 0; i < m->rows; i++) {
+        for (uint8_t j = 0; j < m->cols; j++) {
+            MATRIX_ELEM(m, i, j) *= scalar;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief 행렬 역행렬 계산 (가우스-조던 소거법 사용)
+ *
+ * 증강 행렬 [A|I] 대신 제자리 소거를 쓴다: 피벗 열을 단위 열로 바꾼 자리에 역행렬 열을
+ * 적고, 행 교환은 끝에서 역순 열 교환으로 되돌린다. 활성 크기 연속 저장에서 N x 2N 증강
+ * 행렬은 N > 11이면 저장 공간을 넘으므로, 이 방식으로 N = MATRIX_MAX_SIZE까지 처리한다.
+ */
+MEM_RAMFUNC(matrix_inverse) bool matrix_inverse(const Matrix *m, Matrix *result) {
+    // 정방행렬 확인
+    if (m->rows != m->cols) {
+        return false;
+    }
+    
+    uint8_t n = m->rows;
+    uint8_t swap[MATRIX_MAX_SIZE];
+    
+    // 실패 시 result를 건드리지 않도록 작업 복사본에서 소거
+    Matrix a;
+    matrix_copy(m, &a);
+    
     for (uint8_t i = 0; i < n; i++) {
         // 피벗 찾기
         uint8_t pivot = i;
-        float max_val = fabsf(augmented.data[i][i]);
+        float max_val = fabsf(MATRIX_ELEM(&a, i, i));
         
         for (uint8_t j = i + 1; j < n; j++) {
-            if (fabsf(augmented.data[j][i]) > max_val) {
-                max_val = fabsf(augmented.data[j][i]);
+            if (fabsf(MATRIX_ELEM(&a, j, i)) > max_val) {
+                max_val = fabsf(MATRIX_ELEM(&a, j, i));
                 pivot = j;
             }
         }
@@ -205,39 +284,47 @@ bool matrix_inverse(const Matrix *m, Matrix *result) {
         }
         
         // 행 교환
+        swap[i] = pivot;
         if (pivot != i) {
-            for (uint8_t j = 0; j < 2 * n; j++) {
-                float temp = augmented.data[i][j];
-                augmented.data[i][j] = augmented.data[pivot][j];
-                augmented.data[pivot][j] = temp;
+            for (uint8_t j = 0; j < n; j++) {
+                float temp = MATRIX_ELEM(&a, i, j);
+                MATRIX_ELEM(&a, i, j) = MATRIX_ELEM(&a, pivot, j);
+                MATRIX_ELEM(&a, pivot, j) = temp;
             }
         }
         
-        // 피벗 행 정규화
-        float pivot_val = augmented.data[i][i];
-        for (uint8_t j = 0; j < 2 * n; j++) {
-            augmented.data[i][j] /= pivot_val;
+        // 피벗 행 정규화 (피벗 자리는 단위 열의 1 / pivot)
+        float inv_pivot = 1.0f / MATRIX_ELEM(&a, i, i);
+        MATRIX_ELEM(&a, i, i) = 1.0f;
+        for (uint8_t j = 0; j < n; j++) {
+            MATRIX_ELEM(&a, i, j) *= inv_pivot;
         }
         
         // 다른 행 소거
         for (uint8_t j = 0; j < n; j++) {
             if (j != i) {
-                float factor = augmented.data[j][i];
-                for (uint8_t k = 0; k < 2 * n; k++) {
-                    augmented.data[j][k] -= factor * augmented.data[i][k];
+                float factor = MATRIX_ELEM(&a, j, i);
+                MATRIX_ELEM(&a, j, i) = 0.0f;
+                for (uint8_t k = 0; k < n; k++) {
+                    MATRIX_ELEM(&a, j, k) -= factor * MATRIX_ELEM(&a, i, k);
                 }
             }
         }
     }
     
-    // 결과 행렬 추출
-    *result = matrix_create(n, n);
-    for (uint8_t i = 0; i < n; i++) {
-        for (uint8_t j = 0; j < n; j++) {
-            result->data[i][j] = augmented.data[i][j + n];
+    // 행 교환을 역순 열 교환으로 되돌림
+    for (uint8_t i = n; i-- > 0;) {
+        if (swap[i] != i) {
+            for (uint8_t j = 0; j < n; j++) {
+                float temp = MATRIX_ELEM(&a, j, i);
+                MATRIX_ELEM(&a, j, i) = MATRIX_ELEM(&a, j, swap[i]);
+                MATRIX_ELEM(&a, j, swap[i]) = temp;
+            }
         }
     }
     
+    matrix_copy(&a, result);
+    
     return true;
 }
 
@@ -250,7 +337,7 @@ bool matrix_copy(const Matrix *src, Matrix *dst) {
     
     for (uint8_t i = 0; i < src->rows; i++) {
         for (uint8_t j = 0; j < src->cols; j++) {
-            dst->data[i][j] = src->data[i][j];
+            MATRIX_ELEM(dst, i, j) = MATRIX_ELEM(src, i, j);
         }
     }
     
@@ -266,7 +353,7 @@ bool matrix_set_row(Matrix *m, uint8_t row, const float *vec, uint8_t vec_size)
     }
     
     for (uint8_t j = 0; j < vec_size; j++) {
-        m->data[row][j] = vec[j];
+        MATRIX_ELEM(m, row, j) = vec[j];
     }
     
     return true;
@@ -281,7 +368,7 @@ bool matrix_set_column(Matrix *m, uint8_t col, const float *vec, uint8_t vec_siz
     }
     
     for (uint8_t i = 0; i < vec_size; i++) {
-        m->data[i][col] = vec[i];
+        MATRIX_ELEM(m, i, col) = vec[i];
     }
     
     return true;
@@ -296,7 +383,7 @@ bool matrix_get_row(const Matrix *m, uint8_t row, float *vec, uint8_t vec_size)
     }
     
     for (uint8_t j = 0; j < vec_size; j++) {
-        vec[j] = m->data[row][j];
+        vec[j] = MATRIX_ELEM(m, row, j);
     }
     
     return true;
@@ -311,7 +398,7 @@ bool matrix_get_column(const Matrix *m, uint8_t col, float *vec, uint8_t vec_siz
     }
     
     for (uint8_t i = 0; i < vec_size; i++) {
-        vec[i] = m->data[i][col];
+        vec[i] = MATRIX_ELEM(m, i, col);
     }
     
     return true;
@@ -323,7 +410,7 @@ bool matrix_get_column(const Matrix *m, uint8_t col, float *vec, uint8_t vec_siz
 bool matrix_zero(Matrix *m) {
     for (uint8_t i = 0; i < m->rows; i++) {
         for (uint8_t j = 0; j < m->cols; j++) {
-            m->data[i][j] = 0.0f;
+            MATRIX_ELEM(m, i, j) = 0.0f;
         }
     }
     
@@ -339,7 +426,7 @@ bool matrix_diagonal(Matrix *m, float value) {
     uint8_t min_dim = (m->rows < m->cols) ? m->rows : m->cols;
     
     for (uint8_t i = 0; i < min_dim; i++) {
-        m->data[i][i] = value;
+        MATRIX_ELEM(m, i, i) = value;
     }
     
     return true;
@@ -359,7 +446,7 @@ bool matrix_diagonal_vector(Matrix *m, const float *values, uint8_t size) {
     if (size < min_dim) min_dim = size;
     
     for (uint8_t i = 0; i < min_dim; i++) {
-        m->data[i][i] = values[i];
+        MATRIX_ELEM(m, i, i) = values[i];
     }
     
     return true;
@@ -374,7 +461,7 @@ void matrix_print(const Matrix *m, const char *name) {
     for (uint8_t i = 0; i < m->rows; i++) {
         printf("  ");
         for (uint8_t j = 0; j < m->cols; j++) {
-            printf("%8.4f ", m->data[i][j]);
+            printf("%8.4f ", MATRIX_ELEM(m, i, j));
         }
         printf("\n");
     }
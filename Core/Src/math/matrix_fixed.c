@@ -0,0 +1,419 @@
+/**
+ * @file matrix_fixed.c
+ * @brief 고정 크기 행렬 연산 구현
+ *
+ * 모든 루프 경계가 컴파일 타임 상수이므로 컴파일러가 언롤링 및
+ * 레지스터 할당을 차원별로 최적화할 수 있다.
+ *
+ * MATRIX_USE_CMSIS_DSP 정의 시 덧셈/뺄셈/스케일/전치/곱셈 커널은
+ * CMSIS-DSP 함수로 처리되고, 미정의 시 아래의 이식성 있는 루프를 사용한다.
+ */
+
+#include "math/matrix_fixed.h"
+#include "sys/mem_section.h"
+#include <stddef.h>
+#include <math.h>
+
+#ifdef MATRIX_USE_CMSIS_DSP
+#include "arm_math.h"
+
+/**
+ * @brief CMSIS-DSP 행렬 인스턴스 선언 (고정 크기 행렬은 행 우선 연속 저장)
+ */
+#define MATRIX_FIXED_CMSIS_INSTANCE(NAME, R, C, M)                          \
+    arm_matrix_instance_f32 NAME;                                           \
+    arm_mat_init_f32(&NAME, (R), (C), (float32_t *)&(M)->data[0][0])
+
+#define MATRIX_FIXED_KERNEL_ADD(R, C, A, B, RES)                            \
+    arm_add_f32((float32_t *)&(A)->data[0][0], (float32_t *)&(B)->data[0][0], \
+                &(RES)->data[0][0], (R) * (C))
+
+#define MATRIX_FIXED_KERNEL_SUBTRACT(R, C, A, B, RES)                       \
+    arm_sub_f32((float32_t *)&(A)->data[0][0], (float32_t *)&(B)->data[0][0], \
+                &(RES)->data[0][0], (R) * (C))
+
+#define MATRIX_FIXED_KERNEL_SCALE(R, C, M, S, RES)                          \
+    arm_scale_f32((float32_t *)&(M)->data[0][0], (S), &(RES)->data[0][0], (R) * (C))
+
+#define MATRIX_FIXED_KERNEL_TRANSPOSE(R, C, M, RES)                         \
+    do {                                                                    \
+        MATRIX_FIXED_CMSIS_INSTANCE(src_, R, C, M);                         \
+        MATRIX_FIXED_CMSIS_INSTANCE(dst_, C, R, RES);                       \
+        (void)arm_mat_trans_f32(&src_, &dst_);                              \
+    } while (0)
+
+#define MATRIX_FIXED_KERNEL_MULTIPLY(R, K, C, A, B, RES)                    \
+    do {                                                                    \
+        MATRIX_FIXED_CMSIS_INSTANCE(a_, R, K, A);                           \
+        MATRIX_FIXED_CMSIS_INSTANCE(b_, K, C, B);                           \
+        MATRIX_FIXED_CMSIS_INSTANCE(r_, R, C, RES);                         \
+        (void)arm_mat_mult_f32(&a_, &b_, &r_);                              \
+    } while (0)
+
+#else /* 이식성 있는 기본 구현 */
+
+/**
+ * @brief 원소 단위 커널 (R x C 원소를 정렬된 연속 배열로 한 줄에 돎, LDRD/VLDM 전송)
+ */
+#define MATRIX_FIXED_KERNEL_ELEMENTWISE(R, C, RES, EXPR)                    \
+    do {                                                                    \
+        float *r_ = MATRIX_ASSUME_ALIGNED(&(RES)->data[0][0]);              \
+        for (uint16_t k = 0; k < (uint16_t)((R) * (C)); k++) {              \
+            r_[k] = (EXPR);                                                 \
+        }                                                                   \
+    } while (0)
+
+#define MATRIX_FIXED_KERNEL_ADD(R, C, A, B, RES)                            \
+    do {                                                                    \
+        const float *a_ = MATRIX_ASSUME_ALIGNED(&(A)->data[0][0]);          \
+        const float *b_ = MATRIX_ASSUME_ALIGNED(&(B)->data[0][0]);          \
+        MATRIX_FIXED_KERNEL_ELEMENTWISE(R, C, RES, a_[k] + b_[k]);          \
+    } while (0)
+
+#define MATRIX_FIXED_KERNEL_SUBTRACT(R, C, A, B, RES)                       \
+    do {                                                                    \
+        const float *a_ = MATRIX_ASSUME_ALIGNED(&(A)->data[0][0]);          \
+        const float *b_ = MATRIX_ASSUME_ALIGNED(&(B)->data[0][0]);          \
+        MATRIX_FIXED_KERNEL_ELEMENTWISE(R, C, RES, a_[k] - b_[k]);          \
+    } while (0)
+
+#define MATRIX_FIXED_KERNEL_SCALE(R, C, M, S, RES)                          \
+    do {                                                                    \
+        const float *m_ = MATRIX_ASSUME_ALIGNED(&(M)->data[0][0]);          \
+        MATRIX_FIXED_KERNEL_ELEMENTWISE(R, C, RES, m_[k] * (S));            \
+    } while (0)
+
+#define MATRIX_FIXED_KERNEL_TRANSPOSE(R, C, M, RES)                         \
+    for (uint8_t i = 0; i < (R); i++) {                                     \
+        for (uint8_t j = 0; j < (C); j++) {                                 \
+            (RES)->data[j][i] = (M)->data[i][j];                            \
+        }                                                                   \
+    }
+
+#define MATRIX_FIXED_KERNEL_MULTIPLY(R, K, C, A, B, RES)                    \
+    for (uint8_t i = 0; i < (R); i++) {                                     \
+        for (uint8_t j = 0; j < (C); j++) {                                 \
+            float sum = 0.0f;                                               \
+            for (uint8_t k = 0; k < (K); k++) {                             \
+                sum += (A)->data[i][k] * (B)->data[k][j];                   \
+            }                                                               \
+            (RES)->data[i][j] = sum;                                        \
+        }                                                                   \
+    }
+
+#endif /* MATRIX_USE_CMSIS_DSP */
+
+/**
+ * @brief 원소 단위 연산 정의
+ */
+#define MATRIX_FIXED_DEFINE_OPS(T, P, R, C)                                 \
+    void P##_zero(T *m) {                                                   \
+        float *m_ = MATRIX_ASSUME_ALIGNED(&m->data[0][0]);                  \
+        for (uint16_t k = 0; k < (uint16_t)((R) * (C)); k++) {              \
+            m_[k] = 0.0f;                                                   \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    bool P##_set(T *m, uint8_t row, uint8_t col, float value) {             \
+        if (row >= (R) || col >= (C)) {                                     \
+            return false;                                                   \
+        }                                                                   \
+        m->data[row][col] = value;                                          \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    bool P##_get(const T *m, uint8_t row, uint8_t col, float *value) {      \
+        if (row >= (R) || col >= (C) || value == NULL) {                    \
+            return false;                                                   \
+        }                                                                   \
+        *value = m->data[row][col];                                         \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    void P##_add(const T *a, const T *b, T *result) {                       \
+        MATRIX_FIXED_KERNEL_ADD(R, C, a, b, result);                        \
+    }                                                                       \
+                                                                            \
+    void P##_subtract(const T *a, const T *b, T *result) {                  \
+        MATRIX_FIXED_KERNEL_SUBTRACT(R, C, a, b, result);                   \
+    }                                                                       \
+                                                                            \
+    void P##_scale(const T *m, float scalar, T *result) {                   \
+        MATRIX_FIXED_KERNEL_SCALE(R, C, m, scalar, result);                 \
+    }                                                                       \
+                                                                            \
+    void P##_add_scaled(T *m, const T *b, float scalar) {                   \
+        const float *b_ = MATRIX_ASSUME_ALIGNED(&b->data[0][0]);            \
+        MATRIX_FIXED_KERNEL_ELEMENTWISE(R, C, m, r_[k] + scalar * b_[k]);      \
+    }
+
+/**
+ * @brief 정방 행렬 연산 정의
+ *
+ * 역행렬은 가우스-조던 소거법(부분 피벗팅)을 사용하며,
+ * 증강 행렬도 N x 2N 크기로만 잡는다.
+ */
+#define MATRIX_FIXED_DEFINE_SQUARE_OPS(T, P, N)                             \
+    void P##_identity(T *m) {                                               \
+        for (uint8_t i = 0; i < (N); i++) {                                 \
+            for (uint8_t j = 0; j < (N); j++) {                             \
+                m->data[i][j] = (i == j) ? 1.0f : 0.0f;                     \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    void P##_diagonal_vector(T *m, const float *values) {                   \
+        for (uint8_t i = 0; i < (N); i++) {                                 \
+            for (uint8_t j = 0; j < (N); j++) {                             \
+                m->data[i][j] = (i == j) ? values[i] : 0.0f;                \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    bool P##_inverse(const T *m, T *result) {                               \
+        float augmented[N][2 * (N)];                                        \
+                                                                            \
+        for (uint8_t i = 0; i < (N); i++) {                                 \
+            for (uint8_t j = 0; j < (N); j++) {                             \
+                augmented[i][j] = m->data[i][j];                            \
+                augmented[i][j + (N)] = (i == j) ? 1.0f : 0.0f;             \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        for (uint8_t i = 0; i < (N); i++) {                                 \
+            uint8_t pivot = i;                                              \
+            float max_val = fabsf(augmented[i][i]);                         \
+                                                                            \
+            for (uint8_t j = i + 1; j < (N); j++) {                         \
+                if (fabsf(augmented[j][i]) > max_val) {                     \
+                    max_val = fabsf(augmented[j][i]);                       \
+                    pivot = j;                                              \
+                }                                                           \
+            }                                                               \
+                                                                            \
+            if (max_val < 1e-6f) {                                          \
+                return false;                                               \
+            }                                                               \
+                                                                            \
+            if (pivot != i) {                                               \
+                for (uint8_t j = 0; j < 2 * (N); j++) {                     \
+                    float temp = augmented[i][j];                           \
+                    augmented[i][j] = augmented[pivot][j];                  \
+                    augmented[pivot][j] = temp;                             \
+                }                                                           \
+            }                                                               \
+                                                                            \
+            float inv_pivot = 1.0f / augmented[i][i];                       \
+            for (uint8_t j = 0; j < 2 * (N); j++) {                         \
+                augmented[i][j] *= inv_pivot;                               \
+            }                                                               \
+                                                                            \
+            for (uint8_t j = 0; j < (N); j++) {                             \
+                if (j != i) {                                               \
+                    float factor = augmented[j][i];                         \
+                    for (uint8_t k = 0; k < 2 * (N); k++) {                 \
+                        augmented[j][k] -= factor * augmented[i][k];        \
+                    }                                                       \
+                }                                                           \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        for (uint8_t i = 0; i < (N); i++) {                                 \
+            for (uint8_t j = 0; j < (N); j++) {                             \
+                result->data[i][j] = augmented[i][j + (N)];                 \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return true;                                                        \
+    }
+
+/**
+ * @brief LDL^T 분해와 풀이 정의
+ *
+ * 열 j마다 d_j = m_jj - Σ L_jk^2 d_k, L_ij = (m_ij - Σ L_ik L_jk d_k) / d_j (k < j).
+ * 풀이는 전진 대입(L), 대각 곱(1/D), 후진 대입(L^T) 순서이다.
+ * N이 상수이므로 루프는 컴파일러가 펼친다.
+ */
+#define MATRIX_FIXED_DEFINE_LDLT(T, P, N)                                   \
+    bool P##_ldlt(const T *m, T *ld) {                                      \
+        float d[N];                                                         \
+                                                                            \
+        for (uint8_t j = 0; j < (N); j++) {                                 \
+            float dj = m->data[j][j];                                       \
+            for (uint8_t k = 0; k < j; k++) {                               \
+                dj -= ld->data[j][k] * ld->data[j][k] * d[k];               \
+            }                                                               \
+            if (!(dj > 0.0f)) {                                             \
+                return false;                                               \
+            }                                                               \
+            d[j] = dj;                                                      \
+            float inv = 1.0f / dj;                                          \
+            ld->data[j][j] = inv;                                           \
+                                                                            \
+            for (uint8_t i = j + 1; i < (N); i++) {                         \
+                float sum = m->data[i][j];                                  \
+                for (uint8_t k = 0; k < j; k++) {                           \
+                    sum -= ld->data[i][k] * ld->data[j][k] * d[k];          \
+                }                                                           \
+                ld->data[i][j] = sum * inv;                                 \
+            }                                                               \
+        }                                                                   \
+                                                                            \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    void P##_ldlt_solve(const T *ld, float *b) {                            \
+        for (uint8_t i = 1; i < (N); i++) {                                 \
+            for (uint8_t k = 0; k < i; k++) {                               \
+                b[i] -= ld->data[i][k] * b[k];                              \
+            }                                                               \
+        }                                                                   \
+        for (uint8_t i = 0; i < (N); i++) {                                 \
+            b[i] *= ld->data[i][i];                                         \
+        }                                                                   \
+        for (uint8_t i = (N) - 1; i-- > 0;) {                               \
+            for (uint8_t k = i + 1; k < (N); k++) {                         \
+                b[i] -= ld->data[k][i] * b[k];                              \
+            }                                                               \
+        }                                                                   \
+    }
+
+/**
+ * @brief 전치 정의 (R x C -> C x R)
+ */
+#define MATRIX_FIXED_DEFINE_TRANSPOSE(FN, TA, TR, R, C)                     \
+    void FN(const TA *m, TR *result) {                                      \
+        MATRIX_FIXED_KERNEL_TRANSPOSE(R, C, m, result);                     \
+    }
+
+/**
+ * @brief 곱셈 정의 ((R x K) * (K x C) -> R x C)
+ */
+#define MATRIX_FIXED_DEFINE_MULTIPLY(FN, TA, TB, TR, R, K, C)               \
+    MEM_RAMFUNC(FN) void FN(const TA *a, const TB *b, TR *result) {         \
+        MATRIX_FIXED_KERNEL_MULTIPLY(R, K, C, a, b, result);                \
+    }
+
+/**
+ * @brief 곱셈 누적 정의 (result = result + a * b)
+ */
+#define MATRIX_FIXED_DEFINE_MULTIPLY_ADD(FN, TA, TB, TR, R, K, C)           \
+    MEM_RAMFUNC(FN) void FN(const TA *a, const TB *b, TR *result) {         \
+        for (uint8_t i = 0; i < (R); i++) {                                 \
+            for (uint8_t j = 0; j < (C); j++) {                             \
+                float sum = result->data[i][j];                             \
+                for (uint8_t k = 0; k < (K); k++) {                         \
+                    sum += a->data[i][k] * b->data[k][j];                   \
+                }                                                           \
+                result->data[i][j] = sum;                                   \
+            }                                                               \
+        }                                                                   \
+    }
+
+/**
+ * @brief 전치 곱셈 정의 (result = a * b^T, a: R x K, b: C x K)
+ *
+ * 두 입력 모두 행 방향으로 연속 접근한다.
+ */
+#define MATRIX_FIXED_DEFINE_MULTIPLY_TRANSPOSE(FN, TA, TB, TR, R, K, C)     \
+    MEM_RAMFUNC(FN) void FN(const TA *a, const TB *b, TR *result) {         \
+        for (uint8_t i = 0; i < (R); i++) {                                 \
+            for (uint8_t j = 0; j < (C); j++) {                             \
+                float sum = 0.0f;                                           \
+                for (uint8_t k = 0; k < (K); k++) {                         \
+                    sum += a->data[i][k] * b->data[j][k];                   \
+                }                                                           \
+                result->data[i][j] = sum;                                   \
+            }                                                               \
+        }                                                                   \
+    }
+
+/**
+ * @brief 상태 차원 N 필터용 행렬 묶음 정의 (MATRIX_FIXED_DECLARE_FILTER_SET 참고)
+ */
+#define MATRIX_FIXED_DEFINE_FILTER_SET(N)                                                                       \
+    MATRIX_FIXED_DEFINE_OPS(Mat##N##x##N, mat##N##x##N, N, N)                                                   \
+    MATRIX_FIXED_DEFINE_OPS(Mat##N##x6, mat##N##x6, N, 6)                                                       \
+    MATRIX_FIXED_DEFINE_OPS(Mat##N##x3, mat##N##x3, N, 3)                                                       \
+    MATRIX_FIXED_DEFINE_OPS(Mat##N##x1, mat##N##x1, N, 1)                                                       \
+    MATRIX_FIXED_DEFINE_SQUARE_OPS(Mat##N##x##N, mat##N##x##N, N)                                               \
+    MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_##N##x6_6x6, Mat##N##x6, Mat6x6, Mat##N##x6, N, 6, 6)             \
+    MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_##N##x3_3x3, Mat##N##x3, Mat3x3, Mat##N##x3, N, 3, 3)             \
+    MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_##N##x1_1x1, Mat##N##x1, Mat1x1, Mat##N##x1, N, 1, 1)             \
+    MATRIX_FIXED_DEFINE_MULTIPLY_ADD(mat_multiply_add_##N##x6_6x1, Mat##N##x6, Mat6x1, Mat##N##x1, N, 6, 1)     \
+    MATRIX_FIXED_DEFINE_MULTIPLY_ADD(mat_multiply_add_##N##x3_3x1, Mat##N##x3, Mat3x1, Mat##N##x1, N, 3, 1)     \
+    MATRIX_FIXED_DEFINE_MULTIPLY_ADD(mat_multiply_add_##N##x1_1x1, Mat##N##x1, Mat1x1, Mat##N##x1, N, 1, 1)
+
+/* 원소 단위 연산 */
+MATRIX_FIXED_DEFINE_OPS(Mat16x16, mat16x16, 16, 16)
+MATRIX_FIXED_DEFINE_OPS(Mat16x6, mat16x6, 16, 6)
+MATRIX_FIXED_DEFINE_OPS(Mat16x3, mat16x3, 16, 3)
+MATRIX_FIXED_DEFINE_OPS(Mat16x1, mat16x1, 16, 1)
+MATRIX_FIXED_DEFINE_OPS(Mat6x16, mat6x16, 6, 16)
+MATRIX_FIXED_DEFINE_OPS(Mat3x16, mat3x16, 3, 16)
+MATRIX_FIXED_DEFINE_OPS(Mat1x16, mat1x16, 1, 16)
+MATRIX_FIXED_DEFINE_OPS(Mat15x15, mat15x15, 15, 15)
+MATRIX_FIXED_DEFINE_OPS(Mat15x1, mat15x1, 15, 1)
+MATRIX_FIXED_DEFINE_OPS(Mat6x6, mat6x6, 6, 6)
+MATRIX_FIXED_DEFINE_OPS(Mat6x1, mat6x1, 6, 1)
+MATRIX_FIXED_DEFINE_OPS(Mat3x3, mat3x3, 3, 3)
+MATRIX_FIXED_DEFINE_OPS(Mat3x1, mat3x1, 3, 1)
+MATRIX_FIXED_DEFINE_OPS(Mat1x1, mat1x1, 1, 1)
+
+/* 정방 행렬 연산 */
+MATRIX_FIXED_DEFINE_SQUARE_OPS(Mat16x16, mat16x16, 16)
+MATRIX_FIXED_DEFINE_SQUARE_OPS(Mat15x15, mat15x15, 15)
+MATRIX_FIXED_DEFINE_SQUARE_OPS(Mat6x6, mat6x6, 6)
+MATRIX_FIXED_DEFINE_SQUARE_OPS(Mat3x3, mat3x3, 3)
+MATRIX_FIXED_DEFINE_SQUARE_OPS(Mat1x1, mat1x1, 1)
+
+/* LDL^T 분해/풀이: 측정 차원 */
+MATRIX_FIXED_DEFINE_LDLT(Mat9x9, mat9x9, 9)
+MATRIX_FIXED_DEFINE_LDLT(Mat6x6, mat6x6, 6)
+MATRIX_FIXED_DEFINE_LDLT(Mat3x3, mat3x3, 3)
+MATRIX_FIXED_DEFINE_LDLT(Mat1x1, mat1x1, 1)
+
+/* 전치 */
+MATRIX_FIXED_DEFINE_TRANSPOSE(mat16x16_transpose, Mat16x16, Mat16x16, 16, 16)
+MATRIX_FIXED_DEFINE_TRANSPOSE(mat6x16_transpose, Mat6x16, Mat16x6, 6, 16)
+MATRIX_FIXED_DEFINE_TRANSPOSE(mat3x16_transpose, Mat3x16, Mat16x3, 3, 16)
+MATRIX_FIXED_DEFINE_TRANSPOSE(mat1x16_transpose, Mat1x16, Mat16x1, 1, 16)
+
+/* 곱셈: 공분산 전파 */
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x16_16x16, Mat16x16, Mat16x16, Mat16x16, 16, 16, 16)
+
+/* 곱셈: 측정 갱신 */
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_6x16_16x16, Mat6x16, Mat16x16, Mat6x16, 6, 16, 16)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_6x16_16x6, Mat6x16, Mat16x6, Mat6x6, 6, 16, 6)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x16_16x6, Mat16x16, Mat16x6, Mat16x6, 16, 16, 6)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x6_6x6, Mat16x6, Mat6x6, Mat16x6, 16, 6, 6)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x6_6x1, Mat16x6, Mat6x1, Mat16x1, 16, 6, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x6_6x16, Mat16x6, Mat6x16, Mat16x16, 16, 6, 16)
+
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_3x16_16x16, Mat3x16, Mat16x16, Mat3x16, 3, 16, 16)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_3x16_16x3, Mat3x16, Mat16x3, Mat3x3, 3, 16, 3)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x16_16x3, Mat16x16, Mat16x3, Mat16x3, 16, 16, 3)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x3_3x3, Mat16x3, Mat3x3, Mat16x3, 16, 3, 3)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x3_3x1, Mat16x3, Mat3x1, Mat16x1, 16, 3, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x3_3x16, Mat16x3, Mat3x16, Mat16x16, 16, 3, 16)
+
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_1x16_16x16, Mat1x16, Mat16x16, Mat1x16, 1, 16, 16)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_1x16_16x1, Mat1x16, Mat16x1, Mat1x1, 1, 16, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x16_16x1, Mat16x16, Mat16x1, Mat16x1, 16, 16, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x1_1x1, Mat16x1, Mat1x1, Mat16x1, 16, 1, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY(mat_multiply_16x1_1x16, Mat16x1, Mat1x16, Mat16x16, 16, 1, 16)
+
+/* 곱셈 누적: 상태 갱신 */
+MATRIX_FIXED_DEFINE_MULTIPLY_ADD(mat_multiply_add_16x6_6x1, Mat16x6, Mat6x1, Mat16x1, 16, 6, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY_ADD(mat_multiply_add_16x3_3x1, Mat16x3, Mat3x1, Mat16x1, 16, 3, 1)
+MATRIX_FIXED_DEFINE_MULTIPLY_ADD(mat_multiply_add_16x1_1x1, Mat16x1, Mat1x1, Mat16x1, 16, 1, 1)
+
+/* 전치 곱셈: 공분산 전파 */
+MATRIX_FIXED_DEFINE_MULTIPLY_TRANSPOSE(mat_multiply_transpose_16x16_16x16, Mat16x16, Mat16x16, Mat16x16, 16, 16, 16)
+
+/* 수신기 시계 상태 포함 / 축소 상태 필터용 (사용하지 않는 차원은 --gc-sections로 제거됨) */
+MATRIX_FIXED_DEFINE_FILTER_SET(18)
+MATRIX_FIXED_DEFINE_FILTER_SET(19)
+MATRIX_FIXED_DEFINE_FILTER_SET(17)
+MATRIX_FIXED_DEFINE_FILTER_SET(13)
+MATRIX_FIXED_DEFINE_FILTER_SET(10)
@@ -0,0 +1,197 @@
+/**
+ * @file matrix_sparse.c
+ * @brief 희소 행 및 희소 상태 전이 표현 구현
+ */
+
+#include "math/matrix_sparse.h"
+#include <stddef.h>
+
+/**
+ * @brief 희소 행 초기화 (영 행)
+ */
+void matrix_sparse_row_clear(MatrixSparseRow *row) {
+    if (row == NULL) {
+        return;
+    }
+
+    row->count = 0;
+}
+
+/**
+ * @brief 희소 행에 비영 원소 추가
+ */
+bool matrix_sparse_row_add(MatrixSparseRow *row, uint8_t col, float value) {
+    if (row == NULL || row->count >= MATRIX_SPARSE_ROW_MAX) {
+        return false;
+    }
+
+    row->index[row->count] = col;
+    row->value[row->count] = value;
+    row->count++;
+
+    return true;
+}
+
+/**
+ * @brief 밀집 행에서 희소 행 생성
+ */
+bool matrix_sparse_row_from_dense(const float *dense, uint8_t n, MatrixSparseRow *row) {
+    if (dense == NULL || row == NULL) {
+        return false;
+    }
+
+    row->count = 0;
+    for (uint8_t j = 0; j < n; j++) {
+        if (dense[j] == 0.0f) {
+            continue;
+        }
+        if (!matrix_sparse_row_add(row, j, dense[j])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 희소 행과 밀집 벡터의 내적
+ */
+float matrix_sparse_row_dot(const MatrixSparseRow *row, const float *v) {
+    if (row == NULL || v == NULL) {
+        return 0.0f;
+    }
+
+    float sum = 0.0f;
+    for (uint8_t k = 0; k < row->count; k++) {
+        sum += row->value[k] * v[row->index[k]];
+    }
+
+    return sum;
+}
+
+/**
+ * @brief 희소 전이 행렬 초기화 (F = I)
+ */
+void matrix_sparse_transition_clear(MatrixSparseTransition *t) {
+    if (t == NULL) {
+        return;
+    }
+
+    t->count = 0;
+}
+
+/**
+ * @brief 희소 전이 행렬에 E 원소 추가
+ */
+bool matrix_sparse_transition_add(MatrixSparseTransition *t, uint8_t row, uint8_t col, float value) {
+    if (t == NULL) {
+        return false;
+    }
+
+    // 기존 행 검색
+    uint8_t slot = 0;
+    while (slot < t->count && t->row[slot] != row) {
+        slot++;
+    }
+
+    // 새 행 추가
+    if (slot == t->count) {
+        if (t->count >= MATRIX_SPARSE_TRANSITION_MAX_ROWS) {
+            return false;
+        }
+        t->row[slot] = row;
+        t->e[slot].count = 0;
+        t->count++;
+    }
+
+    return matrix_sparse_row_add(&t->e[slot], col, value);
+}
+
+/**
+ * @brief 희소 전이 행렬의 E(row, col)에 값을 더함 (없으면 원소 추가)
+ */
+static bool matrix_sparse_transition_accumulate(MatrixSparseTransition *t, uint8_t row, uint8_t col,
+                                                float value) {
+    for (uint8_t s = 0; s < t->count; s++) {
+        if (t->row[s] != row) {
+            continue;
+        }
+
+        MatrixSparseRow *e = &t->e[s];
+        for (uint8_t k = 0; k < e->count; k++) {
+            if (e->index[k] == col) {
+                e->value[k] += value;
+                return true;
+            }
+        }
+        return matrix_sparse_row_add(e, col, value);
+    }
+
+    return matrix_sparse_transition_add(t, row, col, value);
+}
+
+/**
+ * @brief 두 희소 전이 행렬의 곱 (I + E_r) = (I + E_a) * (I + E_b)
+ */
+bool matrix_sparse_transition_compose(const MatrixSparseTransition *a, const MatrixSparseTransition *b,
+                                      MatrixSparseTransition *result) {
+    if (a == NULL || b == NULL || result == NULL || result == a || result == b) {
+        return false;
+    }
+
+    *result = *b;
+
+    for (uint8_t sa = 0; sa < a->count; sa++) {
+        uint8_t row = a->row[sa];
+        const MatrixSparseRow *ea = &a->e[sa];
+
+        for (uint8_t ka = 0; ka < ea->count; ka++) {
+            uint8_t mid = ea->index[ka];
+            float v = ea->value[ka];
+
+            // E_a 항
+            if (!matrix_sparse_transition_accumulate(result, row, mid, v)) {
+                return false;
+            }
+
+            // E_a * E_b 항 (E_b의 mid 행이 있을 때만)
+            for (uint8_t sb = 0; sb < b->count; sb++) {
+                if (b->row[sb] != mid) {
+                    continue;
+                }
+                const MatrixSparseRow *eb = &b->e[sb];
+                for (uint8_t kb = 0; kb < eb->count; kb++) {
+                    if (!matrix_sparse_transition_accumulate(result, row, eb->index[kb],
+                                                             v * eb->value[kb])) {
+                        return false;
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 희소 전이 행렬을 밀집 배열로 전개 (F = I + E)
+ */
+void matrix_sparse_transition_to_dense(const MatrixSparseTransition *t, float *dense, uint8_t n) {
+    if (t == NULL || dense == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            dense[i * n + j] = (i == j) ? 1.0f : 0.0f;
+        }
+    }
+
+    for (uint8_t s = 0; s < t->count; s++) {
+        const MatrixSparseRow *e = &t->e[s];
+        for (uint8_t k = 0; k < e->count; k++) {
+            dense[t->row[s] * n + e->index[k]] += e->value[k];
+        }
+    }
+}
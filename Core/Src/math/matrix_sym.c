@@ -0,0 +1,345 @@
+/**
+ * @file matrix_sym.c
+ * @brief 대칭 행렬 상삼각 압축 저장 연산 구현
+ */
+
+#include "math/matrix_sym.h"
+#include "sys/mem_section.h"
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @brief 압축 대칭 행렬 기본 연산 정의
+ *
+ * P##_row(m, row, out)는 압축 저장된 한 행 전체를 밀집 배열로 전개하는
+ * 내부 함수이며, 곱셈/전파 커널의 내부 루프를 연속 메모리 접근으로 만든다.
+ */
+#define MATRIX_SYM_DEFINE_OPS(T, P, TD, N)                                   \
+    static void P##_row(const T *m, uint8_t row, float *out) {               \
+        for (uint8_t col = 0; col < row; col++) {                            \
+            out[col] = m->data[P##_index(col, row)];                         \
+        }                                                                    \
+        const float *src = &m->data[P##_index(row, row)];                    \
+        for (uint8_t col = row; col < (N); col++) {                          \
+            out[col] = *src++;                                               \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    void P##_zero(T *m) {                                                    \
+        for (uint16_t k = 0; k < MATRIX_SYM_SIZE(N); k++) {                  \
+            m->data[k] = 0.0f;                                               \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    void P##_identity(T *m) {                                                \
+        P##_zero(m);                                                         \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            m->data[P##_index(i, i)] = 1.0f;                                 \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    void P##_diagonal_vector(T *m, const float *values) {                    \
+        P##_zero(m);                                                         \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            m->data[P##_index(i, i)] = values[i];                            \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    bool P##_set(T *m, uint8_t row, uint8_t col, float value) {              \
+        if (row >= (N) || col >= (N)) {                                      \
+            return false;                                                    \
+        }                                                                    \
+        m->data[P##_index(row, col)] = value;                                \
+        return true;                                                         \
+    }                                                                        \
+                                                                             \
+    bool P##_get(const T *m, uint8_t row, uint8_t col, float *value) {       \
+        if (row >= (N) || col >= (N) || value == NULL) {                     \
+            return false;                                                    \
+        }                                                                    \
+        *value = m->data[P##_index(row, col)];                               \
+        return true;                                                         \
+    }                                                                        \
+                                                                             \
+    void P##_from_dense(const TD *src, T *dst) {                             \
+        uint16_t k = 0;                                                      \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            for (uint8_t j = i; j < (N); j++) {                              \
+                dst->data[k++] = src->data[i][j];                            \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    void P##_to_dense(const T *src, TD *dst) {                               \
+        uint16_t k = 0;                                                      \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            for (uint8_t j = i; j < (N); j++) {                              \
+                dst->data[i][j] = src->data[k];                              \
+                dst->data[j][i] = src->data[k];                              \
+                k++;                                                         \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    void P##_add_scaled(T *m, const T *b, float scalar) {                    \
+        for (uint16_t k = 0; k < MATRIX_SYM_SIZE(N); k++) {                  \
+            m->data[k] += scalar * b->data[k];                               \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    void P##_propagate(const TD *F, const T *m, T *result) {                 \
+        float row[N];                                                        \
+        float t[N];                                                          \
+        uint16_t k = 0;                                                      \
+                                                                             \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            /* t = F(i,:) * m (F의 0 원소는 건너뜀) */                       \
+            for (uint8_t l = 0; l < (N); l++) {                              \
+                t[l] = 0.0f;                                                 \
+            }                                                                \
+            for (uint8_t r = 0; r < (N); r++) {                              \
+                float f = F->data[i][r];                                     \
+                if (f == 0.0f) {                                             \
+                    continue;                                                \
+                }                                                            \
+                P##_row(m, r, row);                                          \
+                for (uint8_t l = 0; l < (N); l++) {                          \
+                    t[l] += f * row[l];                                      \
+                }                                                            \
+            }                                                                \
+                                                                             \
+            /* result(i, j) = t * F(j,:)^T, j >= i */                        \
+            for (uint8_t j = i; j < (N); j++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t l = 0; l < (N); l++) {                          \
+                    sum += t[l] * F->data[j][l];                             \
+                }                                                            \
+                result->data[k++] = sum;                                     \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    uint8_t P##_bound_diagonal(T *m, const float *lo, const float *hi) {     \
+        uint8_t bounded = 0;                                                 \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            uint16_t kii = P##_index(i, i);                                  \
+            float d = m->data[kii];                                          \
+            if (d < lo[i]) {                                                 \
+                m->data[kii] = lo[i];                                        \
+                bounded++;                                                   \
+            } else if (d > hi[i]) {                                          \
+                /* 행/열 i를 같은 비율로 줄여 상관 계수 유지 */              \
+                float s = sqrtf(hi[i] / d);                                  \
+                for (uint8_t j = 0; j < (N); j++) {                          \
+                    m->data[P##_index(i, j)] *= s;                           \
+                }                                                            \
+                m->data[kii] = hi[i];                                        \
+                bounded++;                                                   \
+            }                                                                \
+        }                                                                    \
+        return bounded;                                                      \
+    }
+
+/**
+ * @brief 대칭 행렬과 밀집 행렬의 곱 정의 (result = S * B, B: N x M)
+ */
+#define MATRIX_SYM_DEFINE_MULTIPLY(FN, T, P, TB, N, M)                       \
+    MEM_RAMFUNC(FN) void FN(const T *s, const TB *b, TB *result) {           \
+        float row[N];                                                        \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            P##_row(s, i, row);                                              \
+            for (uint8_t j = 0; j < (M); j++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t k = 0; k < (N); k++) {                          \
+                    sum += row[k] * b->data[k][j];                           \
+                }                                                            \
+                result->data[i][j] = sum;                                    \
+            }                                                                \
+        }                                                                    \
+    }
+
+/**
+ * @brief 대칭 행렬과 희소 행 묶음 전치의 곱 정의 (result = S * H^T)
+ */
+#define MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(FN, T, P, TB, N, M)                \
+    MEM_RAMFUNC(FN) void FN(const T *s, const MatrixSparseRow *h, TB *result) { \
+        for (uint8_t j = 0; j < (M); j++) {                                  \
+            const MatrixSparseRow *hj = &h[j];                               \
+            if (hj->count == 1 && hj->value[0] == 1.0f) {                    \
+                /* 단위 선택 행: S의 열 복사 */                              \
+                uint8_t c = hj->index[0];                                    \
+                for (uint8_t i = 0; i < (N); i++) {                          \
+                    result->data[i][j] = s->data[P##_index(i, c)];           \
+                }                                                            \
+                continue;                                                    \
+            }                                                                \
+            for (uint8_t i = 0; i < (N); i++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t k = 0; k < hj->count; k++) {                    \
+                    uint16_t idx = P##_index(i, hj->index[k]);               \
+                    sum += hj->value[k] * s->data[idx];                      \
+                }                                                            \
+                result->data[i][j] = sum;                                    \
+            }                                                                \
+        }                                                                    \
+    }
+
+/**
+ * @brief 대칭 저계수 차감 정의 (m = m - A * B^T, 상삼각만)
+ */
+#define MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(FN, T, TA, N, M)                  \
+    MEM_RAMFUNC(FN) void FN(T *m, const TA *a, const TA *b) {                \
+        uint16_t k = 0;                                                      \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            for (uint8_t j = i; j < (N); j++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t l = 0; l < (M); l++) {                          \
+                    sum += a->data[i][l] * b->data[j][l];                    \
+                }                                                            \
+                m->data[k++] -= sum;                                         \
+            }                                                                \
+        }                                                                    \
+    }
+
+/**
+ * @brief Joseph 형식 공분산 갱신 정의
+ *
+ * KC = K * C 를 먼저 구한 뒤 상삼각 원소마다
+ * m(i, j) += sum_l (-K(i,l)*A(j,l) - A(i,l)*K(j,l) + KC(i,l)*K(j,l))
+ */
+#define MATRIX_SYM_DEFINE_JOSEPH_UPDATE(FN, T, TA, TC, N, M)                 \
+    MEM_RAMFUNC(FN) void FN(T *m, const TA *k, const TA *a, const TC *c) {   \
+        float KC[N][M];                                                      \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            for (uint8_t l = 0; l < (M); l++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t n = 0; n < (M); n++) {                          \
+                    sum += k->data[i][n] * c->data[n][l];                    \
+                }                                                            \
+                KC[i][l] = sum;                                              \
+            }                                                                \
+        }                                                                    \
+                                                                             \
+        uint16_t idx = 0;                                                    \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            for (uint8_t j = i; j < (N); j++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t l = 0; l < (M); l++) {                          \
+                    sum += (KC[i][l] - a->data[i][l]) * k->data[j][l]        \
+                         - k->data[i][l] * a->data[j][l];                    \
+                }                                                            \
+                m->data[idx++] += sum;                                       \
+            }                                                                \
+        }                                                                    \
+    }
+
+/**
+ * @brief 희소 전이 행렬을 이용한 제자리 공분산 전파 정의
+ *
+ * W[s][i] = sum_c E(r_s, c) * m(i, c)   (r_s: s번째 비영 행)
+ * m'(i, j) = m(i, j) + W[slot(j)][i] + W[slot(i)][j]
+ *          + sum_c E(i, c) * W[slot(j)][c]
+ */
+#define MATRIX_SYM_DEFINE_PROPAGATE_SPARSE(FN, T, P, N)                      \
+    MEM_RAMFUNC(FN) void FN(T *m, const MatrixSparseTransition *E) {         \
+        float W[MATRIX_SPARSE_TRANSITION_MAX_ROWS][N];                       \
+        uint8_t slot[N];                                                     \
+                                                                             \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            slot[i] = 0xFF;                                                  \
+        }                                                                    \
+                                                                             \
+        /* W = m * E^T (비영 행만) */                                        \
+        for (uint8_t s = 0; s < E->count; s++) {                             \
+            const MatrixSparseRow *e = &E->e[s];                             \
+            slot[E->row[s]] = s;                                             \
+            for (uint8_t i = 0; i < (N); i++) {                              \
+                float sum = 0.0f;                                            \
+                for (uint8_t k = 0; k < e->count; k++) {                     \
+                    sum += e->value[k] * m->data[P##_index(i, e->index[k])]; \
+                }                                                            \
+                W[s][i] = sum;                                               \
+            }                                                                \
+        }                                                                    \
+                                                                             \
+        /* 상삼각 원소 갱신 (E가 영인 행끼리의 블록은 변하지 않음) */        \
+        uint16_t k = 0;                                                      \
+        for (uint8_t i = 0; i < (N); i++) {                                  \
+            uint8_t si = slot[i];                                            \
+            for (uint8_t j = i; j < (N); j++, k++) {                         \
+                uint8_t sj = slot[j];                                        \
+                if (si == 0xFF && sj == 0xFF) {                              \
+                    continue;                                                \
+                }                                                            \
+                float sum = m->data[k];                                      \
+                if (sj != 0xFF) {                                            \
+                    sum += W[sj][i];                                         \
+                }                                                            \
+                if (si != 0xFF) {                                            \
+                    const MatrixSparseRow *e = &E->e[si];                    \
+                    sum += W[si][j];                                         \
+                    if (sj != 0xFF) {                                        \
+                        for (uint8_t c = 0; c < e->count; c++) {             \
+                            sum += e->value[c] * W[sj][e->index[c]];         \
+                        }                                                    \
+                    }                                                        \
+                }                                                            \
+                m->data[k] = sum;                                            \
+            }                                                                \
+        }                                                                    \
+    }
+
+/**
+ * @brief 상태 차원 N 필터용 압축 대칭 행렬 묶음 정의 (MATRIX_SYM_DECLARE_FILTER_SET 참고)
+ */
+#define MATRIX_SYM_DEFINE_FILTER_SET(N)                                                                          \
+    MATRIX_SYM_DEFINE_OPS(MatSym##N, matsym##N, Mat##N##x##N, N)                                                 \
+    MATRIX_SYM_DEFINE_PROPAGATE_SPARSE(matsym##N##_propagate_sparse, MatSym##N, matsym##N, N)                    \
+    MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym##N##_multiply_sparse_##N##x6, MatSym##N, matsym##N, Mat##N##x6, N, 6) \
+    MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym##N##_multiply_sparse_##N##x3, MatSym##N, matsym##N, Mat##N##x3, N, 3) \
+    MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym##N##_multiply_sparse_##N##x1, MatSym##N, matsym##N, Mat##N##x1, N, 1) \
+    MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym##N##_subtract_product_##N##x6, MatSym##N, Mat##N##x6, N, 6)        \
+    MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym##N##_subtract_product_##N##x3, MatSym##N, Mat##N##x3, N, 3)        \
+    MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym##N##_subtract_product_##N##x1, MatSym##N, Mat##N##x1, N, 1)        \
+    MATRIX_SYM_DEFINE_JOSEPH_UPDATE(matsym##N##_joseph_update_##N##x6, MatSym##N, Mat##N##x6, Mat6x6, N, 6)      \
+    MATRIX_SYM_DEFINE_JOSEPH_UPDATE(matsym##N##_joseph_update_##N##x3, MatSym##N, Mat##N##x3, Mat3x3, N, 3)      \
+    MATRIX_SYM_DEFINE_JOSEPH_UPDATE(matsym##N##_joseph_update_##N##x1, MatSym##N, Mat##N##x1, Mat1x1, N, 1)
+
+/* 기본 연산 */
+MATRIX_SYM_DEFINE_OPS(MatSym16, matsym16, Mat16x16, 16)
+
+/* 희소 전이 공분산 전파 */
+MATRIX_SYM_DEFINE_PROPAGATE_SPARSE(matsym16_propagate_sparse, MatSym16, matsym16, 16)
+
+/* 측정 갱신용 곱셈 */
+MATRIX_SYM_DEFINE_MULTIPLY(matsym16_multiply_16x6, MatSym16, matsym16, Mat16x6, 16, 6)
+MATRIX_SYM_DEFINE_MULTIPLY(matsym16_multiply_16x3, MatSym16, matsym16, Mat16x3, 16, 3)
+MATRIX_SYM_DEFINE_MULTIPLY(matsym16_multiply_16x1, MatSym16, matsym16, Mat16x1, 16, 1)
+
+/* 측정 갱신용 희소 H 곱셈 */
+MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym16_multiply_sparse_16x6, MatSym16, matsym16, Mat16x6, 16, 6)
+MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym16_multiply_sparse_16x3, MatSym16, matsym16, Mat16x3, 16, 3)
+MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym16_multiply_sparse_16x1, MatSym16, matsym16, Mat16x1, 16, 1)
+
+/* 측정 갱신용 대칭 차감 */
+MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym16_subtract_product_16x6, MatSym16, Mat16x6, 16, 6)
+MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym16_subtract_product_16x3, MatSym16, Mat16x3, 16, 3)
+MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym16_subtract_product_16x1, MatSym16, Mat16x1, 16, 1)
+
+/* 측정 갱신용 Joseph 형식 공분산 갱신 */
+MATRIX_SYM_DEFINE_JOSEPH_UPDATE(matsym16_joseph_update_16x6, MatSym16, Mat16x6, Mat6x6, 16, 6)
+MATRIX_SYM_DEFINE_JOSEPH_UPDATE(matsym16_joseph_update_16x3, MatSym16, Mat16x3, Mat3x3, 16, 3)
+MATRIX_SYM_DEFINE_JOSEPH_UPDATE(matsym16_joseph_update_16x1, MatSym16, Mat16x1, Mat1x1, 16, 1)
+
+/* 오차 상태 필터용 15차원 연산 */
+MATRIX_SYM_DEFINE_OPS(MatSym15, matsym15, Mat15x15, 15)
+MATRIX_SYM_DEFINE_PROPAGATE_SPARSE(matsym15_propagate_sparse, MatSym15, matsym15, 15)
+MATRIX_SYM_DEFINE_MULTIPLY_SPARSE(matsym15_multiply_sparse_15x1, MatSym15, matsym15, Mat15x1, 15, 1)
+MATRIX_SYM_DEFINE_SUBTRACT_PRODUCT(matsym15_subtract_product_15x1, MatSym15, Mat15x1, 15, 1)
+
+/* 수신기 시계 상태 포함 / 축소 상태 필터용 (사용하지 않는 차원은 --gc-sections로 제거됨) */
+MATRIX_SYM_DEFINE_FILTER_SET(18)
+MATRIX_SYM_DEFINE_FILTER_SET(19)
+MATRIX_SYM_DEFINE_FILTER_SET(17)
+MATRIX_SYM_DEFINE_FILTER_SET(13)
+MATRIX_SYM_DEFINE_FILTER_SET(10)
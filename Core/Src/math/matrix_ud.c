@@ -0,0 +1,209 @@
+/**
+ * @file matrix_ud.c
+ * @brief 공분산의 U-D 분해 표현 및 Bierman/Thornton 연산 구현
+ */
+
+#include "math/matrix_ud.h"
+#include "sys/mem_section.h"
+
+/**
+ * @brief U-D 분해 연산 정의
+ *
+ * 원소 접근은 압축 대칭 행렬의 인덱스 함수(SP##_index)를 그대로 사용한다.
+ * U(i, j) (i < j)와 D(i)만 저장되며, U의 대각 1은 각 연산에서 직접 처리한다.
+ *
+ * @param T U-D 분해 타입
+ * @param P 함수 접두사
+ * @param SP 같은 차원의 압축 대칭 행렬 함수 접두사
+ * @param TS 압축 대칭 행렬 타입
+ * @param TV N x 1 벡터 타입
+ * @param N 행렬 차원
+ */
+#define MATRIX_UD_DEFINE_OPS(T, P, SP, TS, TV, N)                                   \
+    /* U(i, j) 조회 (i <= j, 대각은 1) */                                          \
+    static inline float P##_u(const T *ud, uint8_t i, uint8_t j) {                  \
+        return (i == j) ? 1.0f : ud->data[SP##_index(i, j)];                        \
+    }                                                                               \
+                                                                                    \
+    bool P##_from_sym(const TS *p, T *ud) {                                         \
+        bool ok = true;                                                             \
+                                                                                    \
+        /* 마지막 열부터: D_j = P_jj - Σ_{k>j} D_k U_jk^2 */                       \
+        for (int8_t j = (N) - 1; j >= 0; j--) {                                     \
+            float d = p->data[SP##_index(j, j)];                                    \
+            for (uint8_t k = j + 1; k < (N); k++) {                                 \
+                float u_jk = ud->data[SP##_index(j, k)];                            \
+                d -= ud->data[SP##_index(k, k)] * u_jk * u_jk;                      \
+            }                                                                       \
+            if (!(d > 0.0f)) {                                                      \
+                ok = false;                                                         \
+                d = 0.0f;                                                           \
+            }                                                                       \
+            ud->data[SP##_index(j, j)] = d;                                         \
+                                                                                    \
+            /* U_ij = (P_ij - Σ_{k>j} D_k U_ik U_jk) / D_j */                      \
+            for (uint8_t i = 0; i < (uint8_t)j; i++) {                              \
+                float u = 0.0f;                                                     \
+                if (d > 0.0f) {                                                     \
+                    float sum = p->data[SP##_index(i, j)];                          \
+                    for (uint8_t k = j + 1; k < (N); k++) {                         \
+                        sum -= ud->data[SP##_index(k, k)] *                         \
+                               ud->data[SP##_index(i, k)] *                         \
+                               ud->data[SP##_index(j, k)];                          \
+                    }                                                               \
+                    u = sum / d;                                                    \
+                }                                                                   \
+                ud->data[SP##_index(i, j)] = u;                                     \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        return ok;                                                                  \
+    }                                                                               \
+                                                                                    \
+    void P##_to_sym(const T *ud, TS *p) {                                           \
+        /* P_ij = Σ_{k>=j} U_ik D_k U_jk (i <= j) */                               \
+        uint16_t idx = 0;                                                           \
+        for (uint8_t i = 0; i < (N); i++) {                                         \
+            for (uint8_t j = i; j < (N); j++, idx++) {                              \
+                float sum = 0.0f;                                                   \
+                for (uint8_t k = j; k < (N); k++) {                                 \
+                    sum += P##_u(ud, i, k) * ud->data[SP##_index(k, k)] *           \
+                           P##_u(ud, j, k);                                         \
+                }                                                                   \
+                p->data[idx] = sum;                                                 \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    /* f = U^T * h^T (h의 비영 원소 a에 대해 f_j += h_a U_aj, j >= a) */           \
+    MEM_RAMFUNC(P##_transpose_row)                                                  \
+    static void P##_transpose_row(const T *ud, const MatrixSparseRow *h, float *f) { \
+        for (uint8_t j = 0; j < (N); j++) {                                         \
+            f[j] = 0.0f;                                                            \
+        }                                                                           \
+        for (uint8_t c = 0; c < h->count; c++) {                                    \
+            uint8_t a = h->index[c];                                                \
+            float v = h->value[c];                                                  \
+            f[a] += v;                                                              \
+            for (uint8_t j = a + 1; j < (N); j++) {                                 \
+                f[j] += v * ud->data[SP##_index(a, j)];                             \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    float P##_quadratic_form(const T *ud, const MatrixSparseRow *h) {               \
+        float f[N];                                                                 \
+        P##_transpose_row(ud, h, f);                                                \
+                                                                                    \
+        float sum = 0.0f;                                                           \
+        for (uint8_t j = 0; j < (N); j++) {                                         \
+            sum += ud->data[SP##_index(j, j)] * f[j] * f[j];                        \
+        }                                                                           \
+        return sum;                                                                 \
+    }                                                                               \
+                                                                                    \
+    MEM_RAMFUNC(P##_scalar_update)                                                  \
+    bool P##_scalar_update(T *ud, const MatrixSparseRow *h, float r, TV *k, float *s) { \
+        if (!(r > 0.0f)) {                                                          \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        float f[N];                                                                 \
+        float v[N];                                                                 \
+        float b[N];                                                                 \
+        P##_transpose_row(ud, h, f);                                                \
+        for (uint8_t j = 0; j < (N); j++) {                                         \
+            v[j] = ud->data[SP##_index(j, j)] * f[j];                               \
+        }                                                                           \
+                                                                                    \
+        /* 열 j마다 누적 혁신 분산 alpha로 D_j, U_ij 갱신 */                       \
+        float alpha = r;                                                            \
+        for (uint8_t j = 0; j < (N); j++) {                                         \
+            float beta = alpha;                                                     \
+            alpha += f[j] * v[j];                                                   \
+            float lambda = -f[j] / beta;                                            \
+            ud->data[SP##_index(j, j)] *= beta / alpha;                             \
+            for (uint8_t i = 0; i < j; i++) {                                       \
+                uint16_t ij = SP##_index(i, j);                                     \
+                float u = ud->data[ij];                                             \
+                ud->data[ij] = u + b[i] * lambda;                                   \
+                b[i] += u * v[j];                                                   \
+            }                                                                       \
+            b[j] = v[j];                                                            \
+        }                                                                           \
+                                                                                    \
+        /* K = b / (h P h^T + r) */                                                 \
+        float inv_alpha = 1.0f / alpha;                                             \
+        for (uint8_t j = 0; j < (N); j++) {                                         \
+            k->data[j][0] = b[j] * inv_alpha;                                       \
+        }                                                                           \
+        *s = alpha;                                                                 \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    MEM_RAMFUNC(P##_propagate_sparse)                                               \
+    void P##_propagate_sparse(T *ud, const MatrixSparseTransition *E, const float *q, \
+                              float *work) {                                        \
+        /* W = [(I + E) * U | I], 가중치 [D | q] */                                \
+        float (*W)[2 * (N)] = (float (*)[2 * (N)])work;                             \
+        float *w = work + (N) * 2 * (N);                                            \
+        float *c = w + 2 * (N);                                                     \
+                                                                                    \
+        for (uint8_t i = 0; i < (N); i++) {                                         \
+            for (uint8_t j = 0; j < 2 * (N); j++) {                                 \
+                W[i][j] = 0.0f;                                                     \
+            }                                                                       \
+            for (uint8_t j = i; j < (N); j++) {                                     \
+                W[i][j] = P##_u(ud, i, j);                                          \
+            }                                                                       \
+            W[i][(N) + i] = 1.0f;                                                   \
+            w[i] = ud->data[SP##_index(i, i)];                                      \
+            w[(N) + i] = q[i];                                                      \
+        }                                                                           \
+        for (uint8_t s = 0; s < E->count; s++) {                                    \
+            const MatrixSparseRow *e = &E->e[s];                                    \
+            uint8_t r = E->row[s];                                                  \
+            for (uint8_t c_i = 0; c_i < e->count; c_i++) {                          \
+                uint8_t a = e->index[c_i];                                          \
+                for (uint8_t j = a; j < (N); j++) {                                 \
+                    W[r][j] += e->value[c_i] * P##_u(ud, a, j);                     \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        /* 아래 행부터 가중 직교화: D'_k = |W_k|_w^2, U'_ik = <W_i, W_k>_w / D'_k */ \
+        for (int8_t k = (N) - 1; k >= 0; k--) {                                     \
+            float d = 0.0f;                                                         \
+            for (uint8_t j = 0; j < 2 * (N); j++) {                                 \
+                c[j] = w[j] * W[k][j];                                              \
+                d += W[k][j] * c[j];                                                \
+            }                                                                       \
+            ud->data[SP##_index(k, k)] = d;                                         \
+                                                                                    \
+            for (uint8_t i = 0; i < (uint8_t)k; i++) {                              \
+                float u = 0.0f;                                                     \
+                if (d > 0.0f) {                                                     \
+                    float sum = 0.0f;                                               \
+                    for (uint8_t j = 0; j < 2 * (N); j++) {                         \
+                        sum += W[i][j] * c[j];                                      \
+                    }                                                               \
+                    u = sum / d;                                                    \
+                    for (uint8_t j = 0; j < 2 * (N); j++) {                         \
+                        W[i][j] -= u * W[k][j];                                     \
+                    }                                                               \
+                }                                                                   \
+                ud->data[SP##_index(i, k)] = u;                                     \
+            }                                                                       \
+        }                                                                           \
+    }
+
+/* U-D 분해 연산 */
+MATRIX_UD_DEFINE_OPS(MatUD16, matud16, matsym16, MatSym16, Mat16x1, 16)
+
+/* 수신기 시계/자력계 바이어스/항력 계수 상태 포함, 축소 상태 필터용 */
+MATRIX_UD_DEFINE_OPS(MatUD18, matud18, matsym18, MatSym18, Mat18x1, 18)
+MATRIX_UD_DEFINE_OPS(MatUD19, matud19, matsym19, MatSym19, Mat19x1, 19)
+MATRIX_UD_DEFINE_OPS(MatUD17, matud17, matsym17, MatSym17, Mat17x1, 17)
+MATRIX_UD_DEFINE_OPS(MatUD13, matud13, matsym13, MatSym13, Mat13x1, 13)
+MATRIX_UD_DEFINE_OPS(MatUD10, matud10, matsym10, MatSym10, Mat10x1, 10)
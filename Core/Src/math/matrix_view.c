@@ -0,0 +1,249 @@
+/**
+ * @file matrix_view.c
+ * @brief 행렬 블록 보기 및 블록 커널 구현
+ */
+
+#include "math/matrix_view.h"
+#include "sys/mem_section.h"
+#include <stddef.h>
+
+/**
+ * @brief 다음 행으로 (행 r에서 r + 1)
+ */
+#define MATRIX_VIEW_NEXT(v, r) ((uint16_t)((v)->stride - (uint16_t)(r) * (v)->step))
+
+/**
+ * @brief 행 r의 시작 오프셋
+ */
+static uint32_t matrix_view_offset(uint16_t stride, uint8_t step, uint8_t r) {
+    return (uint32_t)r * stride - (uint32_t)step * r * (r - 1u) / 2u;
+}
+
+/**
+ * @brief 압축 대칭 행렬의 대각 밖 상삼각 블록 보기 (공통)
+ */
+static bool matrix_view_sym_locate(uint8_t n, uint8_t r0, uint8_t c0, uint8_t rows, uint8_t cols,
+                                   uint16_t *offset, uint16_t *stride) {
+    if (rows == 0 || cols == 0 || (uint16_t)c0 + cols > n || (uint16_t)r0 + rows > c0) {
+        return false;
+    }
+    *offset = (uint16_t)(r0 * (2u * n - r0 + 1u) / 2u + (c0 - r0));
+    *stride = (uint16_t)(n - r0 - 1u);
+    return true;
+}
+
+/**
+ * @brief 압축 대칭 행렬의 대각 밖 상삼각 블록 보기
+ */
+bool matrix_view_sym_block(float *packed, uint8_t n, uint8_t r0, uint8_t c0, uint8_t rows, uint8_t cols,
+                           MatrixView *view) {
+    uint16_t offset;
+    uint16_t stride;
+    if (packed == NULL || view == NULL || !matrix_view_sym_locate(n, r0, c0, rows, cols, &offset, &stride)) {
+        return false;
+    }
+
+    view->data = packed + offset;
+    view->stride = stride;
+    view->step = 1;
+    view->rows = rows;
+    view->cols = cols;
+
+    return true;
+}
+
+/**
+ * @brief 압축 대칭 행렬의 대각 밖 상삼각 블록 읽기 전용 보기
+ */
+bool matrix_const_view_sym_block(const float *packed, uint8_t n, uint8_t r0, uint8_t c0, uint8_t rows,
+                                 uint8_t cols, MatrixConstView *view) {
+    uint16_t offset;
+    uint16_t stride;
+    if (packed == NULL || view == NULL || !matrix_view_sym_locate(n, r0, c0, rows, cols, &offset, &stride)) {
+        return false;
+    }
+
+    view->data = packed + offset;
+    view->stride = stride;
+    view->step = 1;
+    view->rows = rows;
+    view->cols = cols;
+
+    return true;
+}
+
+/**
+ * @brief 보기 안의 부분 블록 보기
+ */
+bool matrix_view_sub(const MatrixView *v, uint8_t r0, uint8_t c0, uint8_t rows, uint8_t cols, MatrixView *sub) {
+    if (v == NULL || sub == NULL || (uint16_t)r0 + rows > v->rows || (uint16_t)c0 + cols > v->cols) {
+        return false;
+    }
+
+    sub->data = v->data + matrix_view_offset(v->stride, v->step, r0) + c0;
+    sub->stride = (uint16_t)(v->stride - (uint16_t)r0 * v->step);
+    sub->step = v->step;
+    sub->rows = rows;
+    sub->cols = cols;
+
+    return true;
+}
+
+/**
+ * @brief 블록 0으로 채우기
+ */
+bool matrix_view_zero(const MatrixView *c) {
+    if (c == NULL) {
+        return false;
+    }
+
+    float *row = c->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        for (uint8_t j = 0; j < c->cols; j++) {
+            row[j] = 0.0f;
+        }
+        row += MATRIX_VIEW_NEXT(c, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 복사
+ */
+bool matrix_view_copy(const MatrixView *c, const MatrixConstView *a) {
+    if (c == NULL || a == NULL || c->rows != a->rows || c->cols != a->cols) {
+        return false;
+    }
+
+    float *dst = c->data;
+    const float *src = a->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        for (uint8_t j = 0; j < c->cols; j++) {
+            dst[j] = src[j];
+        }
+        dst += MATRIX_VIEW_NEXT(c, i);
+        src += MATRIX_VIEW_NEXT(a, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 스케일
+ */
+bool matrix_view_scale(const MatrixView *c, float s) {
+    if (c == NULL) {
+        return false;
+    }
+
+    float *row = c->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        for (uint8_t j = 0; j < c->cols; j++) {
+            row[j] *= s;
+        }
+        row += MATRIX_VIEW_NEXT(c, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 스케일 누적
+ */
+bool matrix_view_add_scaled(const MatrixView *c, const MatrixConstView *a, float alpha) {
+    if (c == NULL || a == NULL || c->rows != a->rows || c->cols != a->cols) {
+        return false;
+    }
+
+    float *dst = c->data;
+    const float *src = a->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        for (uint8_t j = 0; j < c->cols; j++) {
+            dst[j] += alpha * src[j];
+        }
+        dst += MATRIX_VIEW_NEXT(c, i);
+        src += MATRIX_VIEW_NEXT(a, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 전치 누적 (c의 행마다 a의 열을 행 포인터로 따라 읽음)
+ */
+bool matrix_view_transpose_add(const MatrixView *c, const MatrixConstView *a, float alpha) {
+    if (c == NULL || a == NULL || c->rows != a->cols || c->cols != a->rows) {
+        return false;
+    }
+
+    float *dst = c->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        const float *src = a->data;
+        for (uint8_t j = 0; j < c->cols; j++) {
+            dst[j] += alpha * src[i];
+            src += MATRIX_VIEW_NEXT(a, j);
+        }
+        dst += MATRIX_VIEW_NEXT(c, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 곱셈 누적 (i-k-j 순서: b와 c의 행을 연속으로 읽고 씀)
+ */
+MEM_RAMFUNC(matrix_view_multiply_add)
+bool matrix_view_multiply_add(const MatrixView *c, const MatrixConstView *a, const MatrixConstView *b, float alpha) {
+    if (c == NULL || a == NULL || b == NULL || a->cols != b->rows || c->rows != a->rows || c->cols != b->cols) {
+        return false;
+    }
+
+    float *dst = c->data;
+    const float *arow = a->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        const float *brow = b->data;
+        for (uint8_t k = 0; k < a->cols; k++) {
+            float s = alpha * arow[k];
+            if (s != 0.0f) {
+                for (uint8_t j = 0; j < c->cols; j++) {
+                    dst[j] += s * brow[j];
+                }
+            }
+            brow += MATRIX_VIEW_NEXT(b, k);
+        }
+        dst += MATRIX_VIEW_NEXT(c, i);
+        arow += MATRIX_VIEW_NEXT(a, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 전치 곱셈 누적 (c_ij += alpha a의 i행 . b의 j행)
+ */
+MEM_RAMFUNC(matrix_view_multiply_transpose_add)
+bool matrix_view_multiply_transpose_add(const MatrixView *c, const MatrixConstView *a, const MatrixConstView *b,
+                                        float alpha) {
+    if (c == NULL || a == NULL || b == NULL || a->cols != b->cols || c->rows != a->rows || c->cols != b->rows) {
+        return false;
+    }
+
+    float *dst = c->data;
+    const float *arow = a->data;
+    for (uint8_t i = 0; i < c->rows; i++) {
+        const float *brow = b->data;
+        for (uint8_t j = 0; j < c->cols; j++) {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < a->cols; k++) {
+                sum += arow[k] * brow[k];
+            }
+            dst[j] += alpha * sum;
+            brow += MATRIX_VIEW_NEXT(b, j);
+        }
+        dst += MATRIX_VIEW_NEXT(c, i);
+        arow += MATRIX_VIEW_NEXT(a, i);
+    }
+
+    return true;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file rotation_batch.c
+ * @brief 센서 묶음 일괄 회전 구현
+ */
+
+#include "math/rotation_batch.h"
+#include "sys/mem_section.h"
+#include <stddef.h>
+
+/**
+ * @brief 묶음 인자 확인
+ */
+static bool rotation_batch_valid(const Vector3fSoAConst *in, const Vector3fSoA *out) {
+    return in != NULL && out != NULL && in->x != NULL && in->y != NULL && in->z != NULL && out->x != NULL &&
+           out->y != NULL && out->z != NULL;
+}
+
+/**
+ * @brief 고정 DCM으로 묶음 회전
+ */
+MEM_RAMFUNC(rotation_batch_apply)
+bool rotation_batch_apply(const float R[3][3], const Vector3fSoAConst *in, const Vector3fSoA *out, uint16_t n) {
+    if (R == NULL || !rotation_batch_valid(in, out)) {
+        return false;
+    }
+
+    const float r00 = R[0][0], r01 = R[0][1], r02 = R[0][2];
+    const float r10 = R[1][0], r11 = R[1][1], r12 = R[1][2];
+    const float r20 = R[2][0], r21 = R[2][1], r22 = R[2][2];
+    for (uint16_t k = 0; k < n; k++) {
+        float x = in->x[k];
+        float y = in->y[k];
+        float z = in->z[k];
+        out->x[k] = r00 * x + r01 * y + r02 * z;
+        out->y[k] = r10 * x + r11 * y + r12 * z;
+        out->z[k] = r20 * x + r21 * y + r22 * z;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 사원수 하나로 묶음 회전
+ */
+bool rotation_batch_rotate(Quaternion q, const Vector3fSoAConst *in, const Vector3fSoA *out, uint16_t n) {
+    float R[3][3];
+    quaternion_to_rotation_matrix(q, R);
+
+    return rotation_batch_apply(R, in, out, n);
+}
+
+/**
+ * @brief 보간 사원수 (nlerp, q1은 q0와 같은 반구로 맞춘 값)
+ */
+static Quaternion rotation_batch_nlerp(Quaternion q0, Quaternion q1, float t) {
+    Quaternion q = {
+        q0.w + t * (q1.w - q0.w),
+        q0.x + t * (q1.x - q0.x),
+        q0.y + t * (q1.y - q0.y),
+        q0.z + t * (q1.z - q0.z),
+    };
+    return quaternion_normalize_fast(q);
+}
+
+/**
+ * @brief 묶음 양 끝 자세 사이를 보간하며 회전
+ *
+ * 구간 s의 양 끝 DCM Ra, Rb 사이를 샘플마다 step = (Rb - Ra) S / (n - 1)씩 더해 간다.
+ */
+MEM_RAMFUNC(rotation_batch_rotate_interp)
+bool rotation_batch_rotate_interp(Quaternion q0, Quaternion q1, const Vector3fSoAConst *in, const Vector3fSoA *out,
+                                  uint16_t n) {
+    if (!rotation_batch_valid(in, out)) {
+        return false;
+    }
+    if (n <= 1) {
+        return rotation_batch_rotate(q0, in, out, n);
+    }
+
+    float dot = q0.w * q1.w + q0.x * q1.x + q0.y * q1.y + q0.z * q1.z;
+    if (dot < 0.0f) {
+        q1.w = -q1.w;
+        q1.x = -q1.x;
+        q1.y = -q1.y;
+        q1.z = -q1.z;
+        dot = -dot;
+    }
+
+    // 회전각 θ = 2 asin(sqrt(1 - dot^2)) ~ 2 sqrt(1 - dot^2) (구간 수를 정하는 데만 씀)
+    float s2 = 1.0f - dot * dot;
+    float theta = (s2 > 0.0f) ? 2.0f * fast_sqrtf(s2) : 0.0f;
+    uint16_t segments = (uint16_t)(theta * (1.0f / ROTATION_BATCH_INTERP_MAX_ANGLE)) + 1u;
+    if (segments > n - 1u) {
+        segments = n - 1u;
+    }
+
+    const float scale = (float)segments / (float)(n - 1u);
+    float Ra[3][3];
+    float Rb[3][3];
+    quaternion_to_rotation_matrix(q0, Ra);
+    uint16_t k = 0;
+    for (uint16_t s = 0; s < segments; s++) {
+        Quaternion qb = (s + 1u == segments) ? quaternion_normalize_fast(q1)
+                                             : rotation_batch_nlerp(q0, q1, (float)(s + 1u) / (float)segments);
+        quaternion_to_rotation_matrix(qb, Rb);
+
+        // 이 구간의 샘플: k / (n - 1) * S < s + 1 (마지막 구간은 끝 샘플 포함)
+        uint16_t end = (s + 1u == segments) ? n : (uint16_t)(((uint32_t)(s + 1u) * (n - 1u) + segments - 1u) / segments);
+        float u = (float)k * scale - (float)s;
+        float R[3][3];
+        float step[3][3];
+        for (uint8_t i = 0; i < 3; i++) {
+            for (uint8_t j = 0; j < 3; j++) {
+                float d = Rb[i][j] - Ra[i][j];
+                R[i][j] = Ra[i][j] + u * d;
+                step[i][j] = d * scale;
+            }
+        }
+
+        for (; k < end; k++) {
+            float x = in->x[k];
+            float y = in->y[k];
+            float z = in->z[k];
+            out->x[k] = R[0][0] * x + R[0][1] * y + R[0][2] * z;
+            out->y[k] = R[1][0] * x + R[1][1] * y + R[1][2] * z;
+            out->z[k] = R[2][0] * x + R[2][1] * y + R[2][2] * z;
+            for (uint8_t i = 0; i < 3; i++) {
+                for (uint8_t j = 0; j < 3; j++) {
+                    R[i][j] += step[i][j];
+                }
+            }
+        }
+
+        for (uint8_t i = 0; i < 3; i++) {
+            for (uint8_t j = 0; j < 3; j++) {
+                Ra[i][j] = Rb[i][j];
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 고정 DCM으로 묶음의 아래 성분만 계산
+ */
+bool rotation_batch_down(const float R[3][3], const Vector3fSoAConst *in, float *down, uint16_t n) {
+    if (R == NULL || in == NULL || in->x == NULL || in->y == NULL || in->z == NULL || down == NULL) {
+        return false;
+    }
+
+    const float r20 = R[2][0], r21 = R[2][1], r22 = R[2][2];
+    for (uint16_t k = 0; k < n; k++) {
+        down[k] = r20 * in->x[k] + r21 * in->y[k] + r22 * in->z[k];
+    }
+
+    return true;
+}
+
+/**
+ * @brief 고정 DCM으로 Vector3f 배열 회전
+ */
+bool rotation_batch_apply_aos(const float R[3][3], const Vector3f *in, Vector3f *out, uint16_t n) {
+    if (R == NULL || in == NULL || out == NULL) {
+        return false;
+    }
+
+    const float r00 = R[0][0], r01 = R[0][1], r02 = R[0][2];
+    const float r10 = R[1][0], r11 = R[1][1], r12 = R[1][2];
+    const float r20 = R[2][0], r21 = R[2][1], r22 = R[2][2];
+    for (uint16_t k = 0; k < n; k++) {
+        Vector3f v = in[k];
+        out[k].x = r00 * v.x + r01 * v.y + r02 * v.z;
+        out[k].y = r10 * v.x + r11 * v.y + r12 * v.z;
+        out[k].z = r20 * v.x + r21 * v.y + r22 * v.z;
+    }
+
+    return true;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file attitude_fast.c
+ * @brief 제어 주기 자세 출력용 상보 필터 구현
+ */
+
+#include "nav/attitude_fast.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 이력에 현재 자세 기록
+ */
+static void attitude_fast_record(AttitudeFast *af, uint32_t timestamp_us) {
+    AttitudeFastSample *s = &af->history[af->head];
+    s->timestamp_us = timestamp_us;
+    s->q = af->q;
+    s->applied = af->applied;
+
+    af->head = (uint16_t)((af->head + 1u) % ATTITUDE_FAST_HISTORY);
+    if (af->count < ATTITUDE_FAST_HISTORY) {
+        af->count++;
+    }
+}
+
+/**
+ * @brief 주어진 시각 이전의 가장 최근 이력 (없으면 가장 오래된 이력)
+ */
+static const AttitudeFastSample *attitude_fast_lookup(AttitudeFast *af, uint32_t timestamp_us) {
+    const AttitudeFastSample *s = NULL;
+    for (uint16_t i = 1; i <= af->count; i++) {
+        s = &af->history[(af->head + ATTITUDE_FAST_HISTORY - i) % ATTITUDE_FAST_HISTORY];
+        if ((int32_t)(timestamp_us - s->timestamp_us) >= 0) {
+            return s;
+        }
+    }
+
+    af->stats.stale++;
+    return s;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool attitude_fast_default_config(AttitudeFastConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->kp = ATTITUDE_FAST_DEFAULT_KP;
+    config->ki = ATTITUDE_FAST_DEFAULT_KI;
+    config->snap_angle = ATTITUDE_FAST_DEFAULT_SNAP_ANGLE;
+
+    return true;
+}
+
+/**
+ * @brief 필터 초기화
+ */
+bool attitude_fast_init(AttitudeFast *af, const AttitudeFastConfig *config) {
+    if (af == NULL) {
+        return false;
+    }
+
+    AttitudeFastConfig c;
+    if (config != NULL) {
+        c = *config;
+    } else {
+        attitude_fast_default_config(&c);
+    }
+    if (!(c.kp >= 0.0f) || !(c.ki >= 0.0f) || !(c.snap_angle > 0.0f)) {
+        return false;
+    }
+
+    memset(af, 0, sizeof(*af));
+    af->config = c;
+    af->q = quaternion_identity();
+
+    return true;
+}
+
+/**
+ * @brief 되먹임 이득 설정
+ */
+bool attitude_fast_set_gains(AttitudeFast *af, float kp, float ki) {
+    if (af == NULL || !(kp >= 0.0f) || !(ki >= 0.0f)) {
+        return false;
+    }
+
+    af->config.kp = kp;
+    af->config.ki = ki;
+    if (ki == 0.0f) {
+        af->bias_integral = vector3f_zero();
+    }
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 하나 적분
+ */
+bool attitude_fast_step(AttitudeFast *af, uint32_t timestamp_us, Vector3f gyro) {
+    if (af == NULL) {
+        return false;
+    }
+
+    uint32_t dt_us = timestamp_us - af->last_us;
+    bool started = af->started;
+    af->started = true;
+    af->last_us = timestamp_us;
+    if (!started || dt_us == 0 || dt_us > ATTITUDE_FAST_MAX_DT_US) {
+        if (started) {
+            af->stats.gaps++;
+        }
+        attitude_fast_record(af, timestamp_us);
+        return false;
+    }
+
+    float dt = (float)dt_us * 1e-6f;
+    af->rate = vector3f_add(vector3f_subtract(gyro, af->gyro_bias), af->bias_integral);
+    Vector3f omega = af->rate;
+
+    if (af->ready) {
+        // 남은 오차의 kp x dt 비율을 이번 샘플에 적용 (기준 좌표계 -> 몸체)
+        float frac = af->config.kp * dt;
+        if (frac > 1.0f) {
+            frac = 1.0f;
+        }
+        Vector3f step = vector3f_scale(af->error, frac);
+        af->error = vector3f_subtract(af->error, step);
+        af->applied = vector3f_add(af->applied, step);
+        omega = vector3f_add(omega, vector3f_scale(quaternion_rotate_vector_inverse(af->q, step), 1.0f / dt));
+
+        if (af->config.ki > 0.0f) {
+            Vector3f e_body = quaternion_rotate_vector_inverse(af->q, af->error);
+            af->bias_integral = vector3f_add(af->bias_integral, vector3f_scale(e_body, af->config.ki * dt));
+        }
+    }
+
+    Quaternion q_dot = quaternion_derivative(af->q, omega);
+    af->q.w += q_dot.w * dt;
+    af->q.x += q_dot.x * dt;
+    af->q.y += q_dot.y * dt;
+    af->q.z += q_dot.z * dt;
+    af->q = quaternion_normalize_fast(af->q);
+
+    attitude_fast_record(af, timestamp_us);
+    af->stats.steps++;
+
+    return true;
+}
+
+/**
+ * @brief EKF 항법 해 반영
+ */
+bool attitude_fast_inject(AttitudeFast *af, const EKF_NavSolution *sol) {
+    if (af == NULL || sol == NULL || !af->started) {
+        return false;
+    }
+
+    af->gyro_bias = sol->gyro_bias;
+
+    // 해 시각의 자세와 비교한 기준 좌표계 오차 (q_ekf = dq x q_hist)
+    const AttitudeFastSample *h = attitude_fast_lookup(af, sol->timestamp_us);
+    Quaternion dq = quaternion_multiply(sol->q, quaternion_conjugate(h->q));
+    float sign = (dq.w < 0.0f) ? -2.0f : 2.0f;
+    Vector3f e = vector3f_create(sign * dq.x, sign * dq.y, sign * dq.z);
+
+    // 해 시각 이후 이미 적용한 보정은 뺌
+    e = vector3f_subtract(e, vector3f_subtract(af->applied, h->applied));
+    float angle = vector3f_magnitude(e);
+    af->stats.last_error = angle;
+    af->stats.injections++;
+
+    if (!af->ready || angle > af->config.snap_angle) {
+        // 지연 이후 적분은 유지한 채 즉시 맞추고, 이력도 같은 회전으로 옮김
+        Quaternion snap = quaternion_from_rotation_vector(e);
+        af->q = quaternion_normalize(quaternion_multiply(snap, af->q));
+        for (uint16_t i = 0; i < af->count; i++) {
+            af->history[i].q = quaternion_multiply(snap, af->history[i].q);
+        }
+        af->error = vector3f_zero();
+        af->ready = true;
+        af->stats.snaps++;
+        return true;
+    }
+
+    af->error = e;
+
+    return true;
+}
+
+/**
+ * @brief 게시 버퍼에 새 해가 있으면 반영
+ */
+bool attitude_fast_sync(AttitudeFast *af, const NavPublisher *pub) {
+    if (af == NULL || pub == NULL) {
+        return false;
+    }
+
+    uint32_t seq = (uint32_t)atomic_load_explicit(&pub->seq, memory_order_acquire);
+    if (seq == 0 || seq == af->last_seq) {
+        return false;
+    }
+
+    EKF_NavSolution sol;
+    if (!nav_publisher_read(pub, &sol, &seq)) {
+        return false;
+    }
+    af->last_seq = seq;
+
+    return attitude_fast_inject(af, &sol);
+}
+
+/**
+ * @brief 현재 자세
+ */
+bool attitude_fast_get_attitude(const AttitudeFast *af, Quaternion *q) {
+    if (af == NULL || q == NULL) {
+        return false;
+    }
+
+    *q = af->q;
+
+    return af->ready;
+}
+
+/**
+ * @brief 마지막 샘플의 바이어스 보정 각속도
+ */
+Vector3f attitude_fast_get_rate(const AttitudeFast *af) {
+    return (af != NULL) ? af->rate : vector3f_zero();
+}
+
+/**
+ * @brief 통계 조회
+ */
+const AttitudeFastStats *attitude_fast_get_stats(const AttitudeFast *af) {
+    return (af != NULL) ? &af->stats : NULL;
+}
@@ -0,0 +1,438 @@
+/**
+ * @file can_publisher.c
+ * @brief 항법 해 CAN 게시 구현
+ */
+
+#include "sys/board_profile.h"
+
+#if BOARD_HAS_CAN
+
+#include "nav/can_publisher.h"
+#include "math/fast_math.h"
+#include "sys/timebase.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#define CAN_PUBLISHER_QUEUE_MASK (CAN_PUBLISHER_QUEUE_SIZE - 1)
+
+/**
+ * @brief 시각 동기 SYNC 진행 상태
+ */
+#define CAN_PUBLISHER_SYNC_IDLE 0u       /**< 보낼 SYNC 없음 */
+#define CAN_PUBLISHER_SYNC_QUEUED 1u     /**< 대기열에 있음 */
+#define CAN_PUBLISHER_SYNC_IN_FLIGHT 2u  /**< 메일박스에 있음 (sync_mailbox) */
+#define CAN_PUBLISHER_SYNC_STAMPED 3u    /**< 송신 완료 시각 기록됨 (FOLLOW_UP 대기) */
+
+/**
+ * @brief 기본 시각 동기 전송률 (Hz)
+ */
+#define CAN_PUBLISHER_DEFAULT_SYNC_RATE_HZ 1.0f
+
+/**
+ * @brief 고정소수점 눈금
+ */
+#define CAN_PUBLISHER_QUAT_LSB (1.0f / 32767.0f)
+#define CAN_PUBLISHER_POS_LSB 0.01f          /**< m */
+#define CAN_PUBLISHER_VEL_LSB 0.05f          /**< m/s */
+#define CAN_PUBLISHER_TIME_LSB 0.01f         /**< s */
+
+/**
+ * @brief 고정소수점 변환 (반올림, 범위 밖은 포화, NaN은 0)
+ */
+static int16_t can_publisher_q16(float v, float lsb) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > 32767.0f) {
+        return 32767;
+    }
+    if (q < -32767.0f) {
+        return -32767;
+    }
+    return (int16_t)lrintf(q);
+}
+
+static uint16_t can_publisher_u16(float v, float lsb) {
+    float q = v / lsb;
+    if (!(q > 0.0f)) {
+        return 0;
+    }
+    if (q > 65535.0f) {
+        return 65535u;
+    }
+    return (uint16_t)lrintf(q);
+}
+
+static int32_t can_publisher_q32(float v, float lsb) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > 2.0e9f) {
+        return 2000000000;
+    }
+    if (q < -2.0e9f) {
+        return -2000000000;
+    }
+    return (int32_t)lrintf(q);
+}
+
+/**
+ * @brief 리틀 엔디언 쓰기
+ */
+static uint8_t *can_publisher_put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *can_publisher_put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool can_publisher_default_config(CanPublisherConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->base_id = CAN_PUBLISHER_DEFAULT_BASE_ID;
+    config->rate_hz[CAN_NAV_MSG_ATTITUDE] = 50.0f;
+    config->rate_hz[CAN_NAV_MSG_ALTITUDE] = 50.0f;
+    config->rate_hz[CAN_NAV_MSG_APOGEE] = 10.0f;
+    config->rate_hz[CAN_NAV_MSG_VELOCITY] = 20.0f;
+    config->rate_hz[CAN_NAV_MSG_POSITION] = 5.0f;
+    config->rate_hz[CAN_NAV_MSG_EPOCH] = 50.0f;
+    config->sync_id = CAN_TIME_SYNC_DEFAULT_SYNC_ID;
+    config->sync_rate_hz = CAN_PUBLISHER_DEFAULT_SYNC_RATE_HZ;
+
+    return true;
+}
+
+/**
+ * @brief 게시기 초기화
+ */
+bool can_publisher_init(CanPublisher *cp, CAN_HandleTypeDef *hcan, const NavPublisher *pub,
+                        const FlightPhaseMachine *phase, const CanPublisherConfig *config) {
+    if (cp == NULL || hcan == NULL || pub == NULL) {
+        return false;
+    }
+
+    memset(cp, 0, sizeof(*cp));
+    if (config != NULL) {
+        cp->config = *config;
+    } else {
+        can_publisher_default_config(&cp->config);
+    }
+    if ((uint32_t)cp->config.base_id + CAN_NAV_MSG_COUNT > 0x800u) {
+        return false;
+    }
+    if (cp->config.sync_rate_hz > 0.0f && (uint32_t)cp->config.sync_id + 2u > 0x800u) {
+        return false;
+    }
+
+    cp->hcan = hcan;
+    cp->pub = pub;
+    cp->phase = phase;
+    for (uint32_t i = 0; i < CAN_NAV_MSG_COUNT; i++) {
+        float rate = cp->config.rate_hz[i];
+        cp->period_us[i] = (rate > 0.0f) ? (uint32_t)(1e6f / rate) : 0u;
+        if (rate > 0.0f && cp->period_us[i] == 0) {
+            cp->period_us[i] = 1u;
+        }
+    }
+    if (cp->config.sync_rate_hz > 0.0f) {
+        cp->sync_period_us = (uint32_t)(1e6f / cp->config.sync_rate_hz);
+        if (cp->sync_period_us == 0) {
+            cp->sync_period_us = 1u;
+        }
+    }
+    atomic_init(&cp->head, 0);
+    atomic_init(&cp->tail, 0);
+    atomic_init(&cp->sync_state, CAN_PUBLISHER_SYNC_IDLE);
+    atomic_flag_clear(&cp->feeding);
+
+    if (HAL_CAN_ActivateNotification(hcan, CAN_IT_TX_MAILBOX_EMPTY | CAN_IT_ERROR) != HAL_OK) {
+        return false;
+    }
+    if (HAL_CAN_GetState(hcan) == HAL_CAN_STATE_READY && HAL_CAN_Start(hcan) != HAL_OK) {
+        return false;
+    }
+
+    cp->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 메시지 데이터 채우기
+ */
+uint8_t can_publisher_pack(CanNavMessage msg, const EKF_NavSolution *sol, FlightPhase phase, uint8_t counter,
+                           uint8_t data[8]) {
+    if (sol == NULL || data == NULL) {
+        return 0;
+    }
+
+    uint8_t *p = data;
+    switch (msg) {
+    case CAN_NAV_MSG_ATTITUDE:
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->q.w, CAN_PUBLISHER_QUAT_LSB));
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->q.x, CAN_PUBLISHER_QUAT_LSB));
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->q.y, CAN_PUBLISHER_QUAT_LSB));
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->q.z, CAN_PUBLISHER_QUAT_LSB));
+        break;
+    case CAN_NAV_MSG_ALTITUDE:
+        p = can_publisher_put32(p, (uint32_t)can_publisher_q32(sol->pos.z, CAN_PUBLISHER_POS_LSB));
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->vel.z, CAN_PUBLISHER_VEL_LSB));
+        *p++ = (uint8_t)phase;
+        *p++ = counter;
+        break;
+    case CAN_NAV_MSG_APOGEE: {
+#if EKF_CONFIG_POSITION
+        float alt_std = fast_sqrtf(sol->p_diag[EKF_STATE_POS_Z]);
+#else
+        float alt_std = 0.0f;
+#endif
+        p = can_publisher_put16(p, can_publisher_u16(sol->apogee_time, CAN_PUBLISHER_TIME_LSB));
+        p = can_publisher_put32(p, (uint32_t)can_publisher_q32(sol->apogee_alt, CAN_PUBLISHER_POS_LSB));
+        p = can_publisher_put16(p, can_publisher_u16(alt_std, CAN_PUBLISHER_POS_LSB));
+        break;
+    }
+    case CAN_NAV_MSG_VELOCITY:
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->vel.x, CAN_PUBLISHER_VEL_LSB));
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->vel.y, CAN_PUBLISHER_VEL_LSB));
+        p = can_publisher_put16(p, (uint16_t)can_publisher_q16(sol->vel.z, CAN_PUBLISHER_VEL_LSB));
+        break;
+    case CAN_NAV_MSG_POSITION:
+        p = can_publisher_put32(p, (uint32_t)can_publisher_q32(sol->pos.x, CAN_PUBLISHER_POS_LSB));
+        p = can_publisher_put32(p, (uint32_t)can_publisher_q32(sol->pos.y, CAN_PUBLISHER_POS_LSB));
+        break;
+    case CAN_NAV_MSG_EPOCH:
+        p = can_publisher_put32(p, sol->timestamp_us);
+        *p++ = counter;
+        break;
+    default:
+        return 0;
+    }
+
+    return (uint8_t)(p - data);
+}
+
+/**
+ * @brief 대기열에서 빈 메일박스로 옮기기 (어느 문맥에서나 호출 가능)
+ */
+static void can_publisher_feed(CanPublisher *cp) {
+    while (!atomic_flag_test_and_set_explicit(&cp->feeding, memory_order_acquire)) {
+        uint_fast32_t tail = atomic_load_explicit(&cp->tail, memory_order_relaxed);
+        while (tail != atomic_load_explicit(&cp->head, memory_order_acquire) &&
+               HAL_CAN_GetTxMailboxesFreeLevel(cp->hcan) > 0) {
+            const CanPublisherFrame *f = &cp->queue[tail & CAN_PUBLISHER_QUEUE_MASK];
+            CAN_TxHeaderTypeDef header = {
+                .StdId = f->id,
+                .ExtId = 0,
+                .IDE = CAN_ID_STD,
+                .RTR = CAN_RTR_DATA,
+                .DLC = f->dlc,
+                .TransmitGlobalTime = DISABLE
+            };
+            uint32_t mailbox;
+            if (HAL_CAN_AddTxMessage(cp->hcan, &header, f->data, &mailbox) != HAL_OK) {
+                break;
+            }
+            if (f->id == cp->config.sync_id && cp->sync_period_us != 0 &&
+                atomic_load_explicit(&cp->sync_state, memory_order_relaxed) == CAN_PUBLISHER_SYNC_QUEUED) {
+                cp->sync_mailbox = mailbox;
+                atomic_store_explicit(&cp->sync_state, CAN_PUBLISHER_SYNC_IN_FLIGHT, memory_order_release);
+            }
+            cp->sent++;
+            tail++;
+            atomic_store_explicit(&cp->tail, tail, memory_order_release);
+        }
+        atomic_flag_clear_explicit(&cp->feeding, memory_order_release);
+
+        // 반납 직전에 메일박스가 비었거나 프레임이 들어왔으면 다시 확인
+        if (atomic_load_explicit(&cp->tail, memory_order_relaxed) ==
+                atomic_load_explicit(&cp->head, memory_order_acquire) ||
+            HAL_CAN_GetTxMailboxesFreeLevel(cp->hcan) == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 대기열에 프레임 하나 넣기 (틱 전용, 차면 버리고 셈)
+ */
+static CanPublisherFrame *can_publisher_reserve(CanPublisher *cp, uint_fast32_t head) {
+    uint_fast32_t tail = atomic_load_explicit(&cp->tail, memory_order_acquire);
+    if (head - tail >= CAN_PUBLISHER_QUEUE_SIZE) {
+        cp->queue_drops++;
+        return NULL;
+    }
+
+    return &cp->queue[head & CAN_PUBLISHER_QUEUE_MASK];
+}
+
+/**
+ * @brief 시각 동기 프레임 넣기 (FOLLOW_UP 먼저, 그다음 주기가 된 SYNC)
+ */
+static uint32_t can_publisher_queue_sync(CanPublisher *cp, uint32_t now_us, uint_fast32_t *head) {
+    uint32_t queued = 0;
+    uint_fast32_t state = atomic_load_explicit(&cp->sync_state, memory_order_acquire);
+
+    if (state == CAN_PUBLISHER_SYNC_STAMPED) {
+        CanPublisherFrame *f = can_publisher_reserve(cp, *head);
+        if (f != NULL) {
+            f->id = (uint16_t)(cp->config.sync_id + 1u);
+            f->dlc = can_time_sync_pack_follow_up(cp->sync_seq, cp->sync_tx_us, f->data);
+            (*head)++;
+            atomic_store_explicit(&cp->head, *head, memory_order_release);
+            cp->sync_sent++;
+            queued++;
+        } else {
+            cp->sync_lost++;
+        }
+        state = CAN_PUBLISHER_SYNC_IDLE;
+        atomic_store_explicit(&cp->sync_state, state, memory_order_relaxed);
+    }
+
+    if ((int32_t)(now_us - cp->sync_next_us) < 0) {
+        return queued;
+    }
+    cp->sync_next_us += cp->sync_period_us;
+    if ((int32_t)(now_us - cp->sync_next_us) >= 0) {
+        cp->sync_next_us = now_us + cp->sync_period_us;
+    }
+
+    // 한 주기 안에 송신 시각을 못 잡았으면 (버스 오프, 인터럽트 경합) 버리고 새로 보냄
+    if (state != CAN_PUBLISHER_SYNC_IDLE) {
+        cp->sync_lost++;
+        atomic_store_explicit(&cp->sync_state, CAN_PUBLISHER_SYNC_IDLE, memory_order_relaxed);
+    }
+
+    CanPublisherFrame *f = can_publisher_reserve(cp, *head);
+    if (f == NULL) {
+        return queued;
+    }
+    cp->sync_seq++;
+    f->id = cp->config.sync_id;
+    f->dlc = can_time_sync_pack_sync(cp->sync_seq, f->data);
+    atomic_store_explicit(&cp->sync_state, CAN_PUBLISHER_SYNC_QUEUED, memory_order_relaxed);
+    (*head)++;
+    atomic_store_explicit(&cp->head, *head, memory_order_release);
+
+    return queued + 1u;
+}
+
+/**
+ * @brief 게시 틱
+ */
+uint32_t can_publisher_tick(CanPublisher *cp, uint32_t now_us) {
+    if (cp == NULL || !cp->initialized) {
+        return 0;
+    }
+
+    if (!cp->started) {
+        for (uint32_t i = 0; i < CAN_NAV_MSG_COUNT; i++) {
+            cp->next_us[i] = now_us;
+        }
+        cp->sync_next_us = now_us;
+        cp->started = true;
+    }
+
+    // 시각 동기를 항법 메시지보다 먼저 (해 읽기 실패와 무관)
+    uint32_t queued = 0;
+    uint_fast32_t head = atomic_load_explicit(&cp->head, memory_order_relaxed);
+    if (cp->sync_period_us != 0) {
+        queued = can_publisher_queue_sync(cp, now_us, &head);
+    }
+
+    // 주기가 된 메시지 고르기
+    uint32_t due = 0;
+    for (uint32_t i = 0; i < CAN_NAV_MSG_COUNT; i++) {
+        if (cp->period_us[i] != 0 && (int32_t)(now_us - cp->next_us[i]) >= 0) {
+            due |= 1u << i;
+            cp->next_us[i] += cp->period_us[i];
+            // 한 주기 넘게 밀렸으면(틱 누락 등) 현재 시각부터 다시 시작
+            if ((int32_t)(now_us - cp->next_us[i]) >= 0) {
+                cp->next_us[i] = now_us + cp->period_us[i];
+            }
+        }
+    }
+    if (due == 0) {
+        can_publisher_feed(cp);
+        return queued;
+    }
+
+    EKF_NavSolution sol;
+    if (!nav_publisher_read(cp->pub, &sol, NULL)) {
+        cp->nav_misses++;
+        can_publisher_feed(cp);
+        return queued;
+    }
+    FlightPhase phase = flight_phase_get(cp->phase);
+
+    // 낮은 번호(높은 버스 우선순위)부터 대기열에 넣음 (ALTITUDE와 EPOCH는 같은 순번)
+    for (uint32_t i = 0; i < CAN_NAV_MSG_COUNT; i++) {
+        if ((due & (1u << i)) == 0) {
+            continue;
+        }
+        CanPublisherFrame *f = can_publisher_reserve(cp, head);
+        if (f == NULL) {
+            continue;
+        }
+
+        f->id = (uint16_t)(cp->config.base_id + i);
+        f->dlc = can_publisher_pack((CanNavMessage)i, &sol, phase, cp->counter, f->data);
+        head++;
+        atomic_store_explicit(&cp->head, head, memory_order_release);
+        queued++;
+    }
+    if (due & (1u << CAN_NAV_MSG_ALTITUDE)) {
+        cp->counter++;
+    }
+
+    can_publisher_feed(cp);
+
+    return queued;
+}
+
+/**
+ * @brief 메일박스 송신 완료/중단 처리
+ */
+void can_publisher_handle_tx_complete(CanPublisher *cp) {
+    if (cp == NULL || !cp->initialized) {
+        return;
+    }
+
+    // SYNC 메일박스가 비었으면 송신 완료 시각 기록 (채우기 전에 확인해야 같은 메일박스를 다시 쓰지 않음)
+    if (atomic_load_explicit(&cp->sync_state, memory_order_acquire) == CAN_PUBLISHER_SYNC_IN_FLIGHT &&
+        HAL_CAN_IsTxMessagePending(cp->hcan, cp->sync_mailbox) == 0) {
+        cp->sync_tx_us = timebase_now_us();
+        atomic_store_explicit(&cp->sync_state, CAN_PUBLISHER_SYNC_STAMPED, memory_order_release);
+    }
+
+    can_publisher_feed(cp);
+}
+
+/**
+ * @brief CAN 오류 처리
+ */
+void can_publisher_handle_error(CanPublisher *cp) {
+    if (cp == NULL || !cp->initialized) {
+        return;
+    }
+
+    // 자동 재전송/버스 오프 복구는 CAN 셀이 하므로(AutoBusOff 권장) 세고 이어서 채움
+    cp->bus_errors++;
+    can_publisher_feed(cp);
+}
+
+#endif /* BOARD_HAS_CAN */
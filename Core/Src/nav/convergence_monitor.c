@@ -0,0 +1,221 @@
+/**
+ * @file convergence_monitor.c
+ * @brief 필터 수렴 시각 감시 구현
+ */
+
+#include "nav/convergence_monitor.h"
+#include "math/fast_math.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool convergence_monitor_default_config(ConvergenceMonitorConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->threshold[CONVERGENCE_BLOCK_ATTITUDE] = CONVERGENCE_DEFAULT_ATTITUDE_STD;
+    config->threshold[CONVERGENCE_BLOCK_VELOCITY] = CONVERGENCE_DEFAULT_VELOCITY_STD;
+    config->threshold[CONVERGENCE_BLOCK_POSITION] = CONVERGENCE_DEFAULT_POSITION_STD;
+    config->threshold[CONVERGENCE_BLOCK_GYRO_BIAS] = CONVERGENCE_DEFAULT_GYRO_BIAS_STD;
+    config->threshold[CONVERGENCE_BLOCK_ACCEL_BIAS] = CONVERGENCE_DEFAULT_ACCEL_BIAS_STD;
+    config->hold_us = CONVERGENCE_DEFAULT_HOLD_US;
+    config->release_ratio = CONVERGENCE_DEFAULT_RELEASE_RATIO;
+    config->required = CONVERGENCE_DEFAULT_REQUIRED;
+
+    return true;
+}
+
+/**
+ * @brief 감시기 초기화
+ */
+bool convergence_monitor_init(ConvergenceMonitor *mon, const ConvergenceMonitorConfig *config, uint32_t start_us) {
+    if (mon == NULL) {
+        return false;
+    }
+
+    ConvergenceMonitorConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        convergence_monitor_default_config(&cfg);
+    }
+    for (uint8_t b = 0; b < CONVERGENCE_BLOCK_COUNT; b++) {
+        if (!(cfg.threshold[b] > 0.0f)) {
+            return false;
+        }
+    }
+    if (!(cfg.release_ratio >= 1.0f) || cfg.required == 0 || (cfg.required & ~CONVERGENCE_AVAILABLE_MASK) != 0) {
+        return false;
+    }
+
+    memset(mon, 0, sizeof(*mon));
+    mon->config = cfg;
+    mon->start_us = start_us;
+    mon->last_us = start_us;
+    for (uint8_t b = 0; b < CONVERGENCE_BLOCK_COUNT; b++) {
+        mon->stats.block[b].converged_us = CONVERGENCE_NEVER;
+    }
+    mon->stats.ready_us = CONVERGENCE_NEVER;
+    mon->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 세 축 분산 최댓값의 표준 편차
+ */
+static float convergence_axis_std(const float *p_diag, uint8_t first) {
+    float v = p_diag[first];
+    for (uint8_t i = 1; i < 3; i++) {
+        if (p_diag[first + i] > v) {
+            v = p_diag[first + i];
+        }
+    }
+
+    return (v > 0.0f) ? fast_sqrtf(v) : v;
+}
+
+/**
+ * @brief 블록 표준 편차 (빌드에 없는 블록은 NaN, 문턱 비교가 항상 거짓)
+ */
+static float convergence_block_std(const float *d, uint8_t block) {
+    switch (block) {
+    case CONVERGENCE_BLOCK_ATTITUDE: {
+        // 작은 각에서 회전각 오차 ~ 2|dq_xyz|
+        float v = d[EKF_STATE_QUAT_X] + d[EKF_STATE_QUAT_Y] + d[EKF_STATE_QUAT_Z];
+        return (v > 0.0f) ? 2.0f * fast_sqrtf(v) : v;
+    }
+    case CONVERGENCE_BLOCK_VELOCITY:
+        return convergence_axis_std(d, EKF_STATE_VEL_X);
+#if EKF_CONFIG_POSITION
+    case CONVERGENCE_BLOCK_POSITION:
+        return convergence_axis_std(d, EKF_STATE_POS_X);
+#endif
+    case CONVERGENCE_BLOCK_GYRO_BIAS:
+        return convergence_axis_std(d, EKF_STATE_GYRO_BIAS_X);
+#if EKF_CONFIG_ACCEL_BIAS
+    case CONVERGENCE_BLOCK_ACCEL_BIAS:
+        return convergence_axis_std(d, EKF_STATE_ACC_BIAS_X);
+#endif
+    default:
+        return NAN;
+    }
+}
+
+/**
+ * @brief 공분산 대각으로 한 단계 갱신
+ */
+uint8_t convergence_monitor_update(ConvergenceMonitor *mon, const float *p_diag, uint32_t timestamp_us) {
+    if (mon == NULL || !mon->initialized || p_diag == NULL) {
+        return 0;
+    }
+
+    const ConvergenceMonitorConfig *cfg = &mon->config;
+    ConvergenceMonitorStats *st = &mon->stats;
+    uint32_t elapsed_us = timestamp_us - mon->start_us;
+    uint8_t changed = 0;
+
+    for (uint8_t b = 0; b < CONVERGENCE_BLOCK_COUNT; b++) {
+        uint8_t bit = (uint8_t)CONVERGENCE_BIT(b);
+        float std = convergence_block_std(p_diag, b);
+        st->block[b].std = std;
+
+        if (mon->converged_mask & bit) {
+            // 수렴 블록은 문턱 x release_ratio를 넘거나 값이 깨지면 미수렴 (NaN도 포함)
+            if (!(std <= cfg->threshold[b] * cfg->release_ratio)) {
+                mon->converged_mask &= (uint8_t)~bit;
+                mon->below_mask &= (uint8_t)~bit;
+                st->block[b].losses++;
+                changed |= bit;
+            }
+            continue;
+        }
+
+        if (!(std < cfg->threshold[b])) {
+            mon->below_mask &= (uint8_t)~bit;
+            continue;
+        }
+        if ((mon->below_mask & bit) == 0) {
+            mon->below_mask |= bit;
+            mon->below_since_us[b] = timestamp_us;
+        }
+        if ((uint32_t)(timestamp_us - mon->below_since_us[b]) >= cfg->hold_us) {
+            mon->converged_mask |= bit;
+            changed |= bit;
+            if (st->block[b].converged_us == CONVERGENCE_NEVER) {
+                st->block[b].converged_us = elapsed_us;
+            }
+        }
+    }
+
+    bool ready = (mon->converged_mask & cfg->required) == cfg->required;
+    if (ready && !mon->ready && st->ready_us == CONVERGENCE_NEVER) {
+        st->ready_us = elapsed_us;
+    } else if (!ready && mon->ready) {
+        st->ready_losses++;
+    }
+    mon->ready = ready;
+    mon->last_us = timestamp_us;
+    st->updates++;
+    if (changed != 0) {
+        st->events++;
+    }
+
+    return changed;
+}
+
+/**
+ * @brief 항법 해로 갱신
+ */
+uint8_t convergence_monitor_update_solution(ConvergenceMonitor *mon, const EKF_NavSolution *sol) {
+    if (sol == NULL) {
+        return 0;
+    }
+
+    return convergence_monitor_update(mon, sol->p_diag, sol->timestamp_us);
+}
+
+/**
+ * @brief 필터 공분산으로 바로 갱신
+ */
+uint8_t convergence_monitor_update_ekf(ConvergenceMonitor *mon, const EKF *ekf, uint32_t timestamp_us) {
+    if (ekf == NULL || !ekf->initialized) {
+        return 0;
+    }
+
+    float p_diag[EKF_STATE_DIM];
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        p_diag[i] = ekf->P.data[EKF_SYM_FN(index)(i, i)];
+    }
+
+    return convergence_monitor_update(mon, p_diag, timestamp_us);
+}
+
+/**
+ * @brief 수렴한 블록
+ */
+uint8_t convergence_monitor_converged(const ConvergenceMonitor *mon) {
+    return (mon != NULL) ? mon->converged_mask : 0;
+}
+
+/**
+ * @brief 준비 상태
+ */
+bool convergence_monitor_is_ready(const ConvergenceMonitor *mon) {
+    return mon != NULL && mon->ready;
+}
+
+/**
+ * @brief 통계
+ */
+const ConvergenceMonitorStats *convergence_monitor_get_stats(const ConvergenceMonitor *mon) {
+    if (mon == NULL) {
+        return NULL;
+    }
+
+    return &mon->stats;
+}
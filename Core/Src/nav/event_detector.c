@@ -0,0 +1,319 @@
+/**
+ * @file event_detector.c
+ * @brief 원시 IMU/기압계 입력 비행 이벤트 검출 구현
+ */
+
+#include "nav/event_detector.h"
+#include <stddef.h>
+
+/**
+ * @brief 이벤트 비트
+ */
+static uint32_t event_detector_bit(FlightEventType type) {
+    return 1u << (uint32_t)type;
+}
+
+/**
+ * @brief 이벤트 기록 후 발생 비트 설정, 콜백 호출
+ */
+static void event_detector_emit(EventDetector *det, FlightEventType type,
+                                uint32_t timestamp_us, uint32_t onset_us) {
+    FlightEvent *ev = &det->events[type];
+    ev->type = type;
+    ev->timestamp_us = timestamp_us;
+    ev->onset_us = onset_us;
+
+    // 이벤트 기록이 비트보다 먼저 보이도록 release
+    atomic_fetch_or_explicit(&det->fired, event_detector_bit(type), memory_order_release);
+
+    if (det->callback != NULL) {
+        det->callback(ev, det->callback_context);
+    }
+}
+
+/**
+ * @brief 기본 판정 조건
+ */
+bool event_detector_default_config(EventDetectorConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->launch_accel = EVENT_DETECTOR_DEFAULT_LAUNCH_ACCEL;
+    config->burnout_accel = EVENT_DETECTOR_DEFAULT_BURNOUT_ACCEL;
+    config->burnout_min_us = EVENT_DETECTOR_DEFAULT_BURNOUT_MIN_US;
+    config->apogee_descent = EVENT_DETECTOR_DEFAULT_APOGEE_DESCENT;
+    config->apogee_confirm = EVENT_DETECTOR_DEFAULT_APOGEE_CONFIRM;
+    config->apogee_lockout_us = EVENT_DETECTOR_DEFAULT_APOGEE_LOCKOUT_US;
+
+    return true;
+}
+
+/**
+ * @brief 검출기 초기화
+ */
+bool event_detector_init(EventDetector *det, const EventDetectorConfig *config,
+                         FlightEventFn callback, void *context) {
+    if (det == NULL) {
+        return false;
+    }
+
+    if (config != NULL) {
+        if (config->apogee_confirm == 0) {
+            return false;
+        }
+        det->config = *config;
+    } else {
+        event_detector_default_config(&det->config);
+    }
+
+    det->callback = callback;
+    det->callback_context = context;
+
+    for (uint8_t i = 0; i < EVENT_DETECTOR_ACCEL_WINDOW; i++) {
+        det->accel_sq[i] = 0.0f;
+    }
+    det->accel_sq_sum = 0.0f;
+    det->accel_index = 0;
+    det->accel_count = 0;
+    det->accel_above = false;
+    det->accel_run_us = 0;
+
+    det->baro_index = 0;
+    det->baro_count = 0;
+    det->baro_velocity = 0.0f;
+    det->baro_peak_alt = 0.0f;
+    det->baro_peak_us = 0;
+    det->descent_count = 0;
+
+    atomic_init(&det->fired, 0);
+    det->consumed = 0;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 판정 (발사, 연소 종료)
+ */
+void event_detector_push_imu(EventDetector *det, uint32_t timestamp_us, Vector3f accel) {
+    if (det == NULL) {
+        return;
+    }
+
+    uint32_t fired = atomic_load_explicit(&det->fired, memory_order_relaxed);
+    bool launched = (fired & event_detector_bit(FLIGHT_EVENT_LAUNCH)) != 0;
+    if ((fired & (event_detector_bit(FLIGHT_EVENT_BURNOUT) | event_detector_bit(FLIGHT_EVENT_APOGEE))) != 0) {
+        // 연소 종료(또는 정점) 이후 IMU 판정 없음
+        return;
+    }
+
+    // 창 갱신 (한 바퀴마다 합을 다시 계산해 누적 반올림 오차 제거)
+    float a2 = vector3f_magnitude_squared(accel);
+    det->accel_sq_sum += a2 - det->accel_sq[det->accel_index];
+    det->accel_sq[det->accel_index] = a2;
+    det->accel_index = (uint8_t)((det->accel_index + 1) & (EVENT_DETECTOR_ACCEL_WINDOW - 1));
+    if (det->accel_index == 0) {
+        float sum = 0.0f;
+        for (uint8_t i = 0; i < EVENT_DETECTOR_ACCEL_WINDOW; i++) {
+            sum += det->accel_sq[i];
+        }
+        det->accel_sq_sum = sum;
+    }
+    if (det->accel_count < EVENT_DETECTOR_ACCEL_WINDOW) {
+        det->accel_count++;
+    }
+
+    // 발사 전: 임계값 이상 구간, 발사 후: 연소 종료 임계값 미만 구간의 시작 시각을 추적
+    float th = launched ? det->config.burnout_accel : det->config.launch_accel;
+    bool above = launched ? (a2 < th * th) : (a2 >= th * th);
+    if (above && !det->accel_above) {
+        det->accel_run_us = timestamp_us;
+    }
+    det->accel_above = above;
+
+    if (det->accel_count < EVENT_DETECTOR_ACCEL_WINDOW) {
+        return;
+    }
+
+    // 창 RMS 판정 (제곱 평균과 임계값 제곱 비교, sqrt 없음)
+    float mean_sq = det->accel_sq_sum * (1.0f / (float)EVENT_DETECTOR_ACCEL_WINDOW);
+
+    if (!launched) {
+        if (mean_sq >= th * th) {
+            event_detector_emit(det, FLIGHT_EVENT_LAUNCH, timestamp_us,
+                                det->accel_above ? det->accel_run_us : timestamp_us);
+            // 연소 종료 구간 추적을 새로 시작
+            det->accel_above = false;
+        }
+        return;
+    }
+
+    uint32_t since_launch = timestamp_us - det->events[FLIGHT_EVENT_LAUNCH].onset_us;
+    if (since_launch >= det->config.burnout_min_us && mean_sq < th * th) {
+        event_detector_emit(det, FLIGHT_EVENT_BURNOUT, timestamp_us,
+                            det->accel_above ? det->accel_run_us : timestamp_us);
+    }
+}
+
+/**
+ * @brief ImuRing 생산자 탭
+ */
+void event_detector_imu_tap(const ImuSample *sample, void *context) {
+    if (sample == NULL) {
+        return;
+    }
+
+    event_detector_push_imu((EventDetector *)context, sample->timestamp_us, sample->accel);
+}
+
+/**
+ * @brief 기압계 샘플 판정 (정점)
+ */
+void event_detector_push_baro(EventDetector *det, uint32_t timestamp_us, float baro_alt) {
+    if (det == NULL) {
+        return;
+    }
+
+    det->baro_t[det->baro_index] = timestamp_us;
+    det->baro_alt[det->baro_index] = baro_alt;
+    det->baro_index = (uint8_t)((det->baro_index + 1) & (EVENT_DETECTOR_BARO_WINDOW - 1));
+    if (det->baro_count < EVENT_DETECTOR_BARO_WINDOW) {
+        det->baro_count++;
+    }
+
+    if (det->baro_count < EVENT_DETECTOR_BARO_WINDOW) {
+        return;
+    }
+
+    // 최소 제곱 직선 (시각은 최신 샘플 기준 초 단위로 두어 float 정밀도 유지)
+    float t_sum = 0.0f;
+    float h_sum = 0.0f;
+    float t_rel[EVENT_DETECTOR_BARO_WINDOW];
+    for (uint8_t i = 0; i < EVENT_DETECTOR_BARO_WINDOW; i++) {
+        t_rel[i] = (float)(int32_t)(det->baro_t[i] - timestamp_us) * 1e-6f;
+        t_sum += t_rel[i];
+        h_sum += det->baro_alt[i];
+    }
+    const float n_inv = 1.0f / (float)EVENT_DETECTOR_BARO_WINDOW;
+    float t_mean = t_sum * n_inv;
+    float h_mean = h_sum * n_inv;
+
+    float stt = 0.0f;
+    float sth = 0.0f;
+    for (uint8_t i = 0; i < EVENT_DETECTOR_BARO_WINDOW; i++) {
+        float dt = t_rel[i] - t_mean;
+        stt += dt * dt;
+        sth += dt * (det->baro_alt[i] - h_mean);
+    }
+    if (stt <= 0.0f) {
+        return;
+    }
+
+    float v = sth / stt;
+    float h_fit = h_mean - v * t_mean;
+    det->baro_velocity = v;
+
+    uint32_t fired = atomic_load_explicit(&det->fired, memory_order_acquire);
+    if ((fired & event_detector_bit(FLIGHT_EVENT_LAUNCH)) == 0 ||
+        (fired & event_detector_bit(FLIGHT_EVENT_APOGEE)) != 0) {
+        det->baro_peak_alt = h_fit;
+        det->baro_peak_us = timestamp_us;
+        det->descent_count = 0;
+        return;
+    }
+
+    // 발사 후 최고 적합 고도를 정점 발생 시각 추정에 사용
+    if (h_fit > det->baro_peak_alt) {
+        det->baro_peak_alt = h_fit;
+        det->baro_peak_us = timestamp_us;
+    }
+
+    uint32_t since_launch = timestamp_us - det->events[FLIGHT_EVENT_LAUNCH].onset_us;
+    if (since_launch < det->config.apogee_lockout_us) {
+        det->descent_count = 0;
+        return;
+    }
+
+    if (v <= -det->config.apogee_descent) {
+        det->descent_count++;
+    } else {
+        det->descent_count = 0;
+    }
+
+    if (det->descent_count >= det->config.apogee_confirm) {
+        event_detector_emit(det, FLIGHT_EVENT_APOGEE, timestamp_us, det->baro_peak_us);
+    }
+}
+
+/**
+ * @brief 기압계 수직 속도 조회
+ */
+bool event_detector_get_baro_velocity(const EventDetector *det, float *vel_up) {
+    if (det == NULL || vel_up == NULL || det->baro_count < EVENT_DETECTOR_BARO_WINDOW) {
+        return false;
+    }
+
+    *vel_up = det->baro_velocity;
+
+    return true;
+}
+
+/**
+ * @brief 정점 시각 예측
+ */
+bool event_detector_predict_apogee(const EventDetector *det, uint32_t *apogee_us) {
+    if (det == NULL || apogee_us == NULL || det->baro_count < EVENT_DETECTOR_BARO_WINDOW ||
+        det->baro_velocity <= 0.0f) {
+        return false;
+    }
+
+    // 최신 샘플 시각 + v / 감속도
+    uint8_t last = (uint8_t)((det->baro_index - 1) & (EVENT_DETECTOR_BARO_WINDOW - 1));
+    float t_go = det->baro_velocity / EVENT_DETECTOR_PREDICT_DECEL;
+    *apogee_us = det->baro_t[last] + (uint32_t)(t_go * 1e6f);
+
+    return true;
+}
+
+/**
+ * @brief 다음 이벤트 꺼내기
+ */
+bool event_detector_poll(EventDetector *det, uint32_t until_us, FlightEvent *event) {
+    if (det == NULL || event == NULL) {
+        return false;
+    }
+
+    uint32_t pending = (uint32_t)atomic_load_explicit(&det->fired, memory_order_acquire) & ~det->consumed;
+
+    // 종류 순서가 발생 순서 (연소 종료를 놓친 경우 정점만 전달될 수 있음)
+    for (uint8_t i = 0; i < FLIGHT_EVENT_COUNT; i++) {
+        uint32_t bit = event_detector_bit((FlightEventType)i);
+        if ((pending & bit) == 0) {
+            continue;
+        }
+
+        const FlightEvent *ev = &det->events[i];
+        if ((int32_t)(ev->timestamp_us - until_us) > 0) {
+            return false;
+        }
+
+        *event = *ev;
+        det->consumed |= bit;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 이벤트 발생 여부
+ */
+bool event_detector_has_fired(const EventDetector *det, FlightEventType type) {
+    if (det == NULL || type >= FLIGHT_EVENT_COUNT) {
+        return false;
+    }
+
+    uint32_t fired = (uint32_t)atomic_load_explicit(&det->fired, memory_order_acquire);
+
+    return (fired & event_detector_bit(type)) != 0;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file event_tagger.c
+ * @brief 사건 시각 보간기 구현
+ */
+
+#include "nav/event_tagger.h"
+#include <stddef.h>
+#include <string.h>
+
+#define EVENT_TAGGER_MASK (EVENT_TAGGER_HISTORY - 1u)
+
+/**
+ * @brief 기본 설정
+ */
+bool event_tagger_default_config(EventTaggerConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->max_extrapolate_us = EVENT_TAGGER_DEFAULT_MAX_EXTRAPOLATE_US;
+    config->max_span_us = EVENT_TAGGER_DEFAULT_MAX_SPAN_US;
+
+    return true;
+}
+
+/**
+ * @brief 초기화
+ */
+bool event_tagger_init(EventTagger *et, const EventTaggerConfig *config) {
+    if (et == NULL) {
+        return false;
+    }
+
+    EventTaggerConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        event_tagger_default_config(&cfg);
+    }
+    if (cfg.max_span_us == 0) {
+        return false;
+    }
+
+    memset(et, 0, sizeof(*et));
+    et->config = cfg;
+    atomic_init(&et->head, 0);
+    et->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 출력 하나 기록
+ */
+bool event_tagger_push(EventTagger *et, const EKF_NavSolution *sol) {
+    if (et == NULL || !et->initialized || sol == NULL) {
+        return false;
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&et->head, memory_order_relaxed);
+    if (head > 0 && (int32_t)(sol->timestamp_us - et->last_us) <= 0) {
+        // 이진 탐색은 시각이 단조 증가해야 함
+        et->stats.out_of_order++;
+        return false;
+    }
+
+    EventTaggerSample *s = &et->ring[head & EVENT_TAGGER_MASK];
+    s->timestamp_us = sol->timestamp_us;
+    s->pos = sol->pos;
+    s->vel = sol->vel;
+    s->q = sol->q;
+    et->last_us = sol->timestamp_us;
+
+    // 슬롯 쓰기가 기록 수 증가보다 먼저 보이도록 release
+    atomic_store_explicit(&et->head, head + 1, memory_order_release);
+    et->stats.pushes++;
+
+    return true;
+}
+
+/**
+ * @brief 두 샘플 사이 (u = 0..1) 또는 뒤 (u > 1) 상태
+ */
+static void event_tagger_blend(const EventTaggerSample *s0, const EventTaggerSample *s1, float u, uint8_t method,
+                               EventTaggerResult *out) {
+    float h = (float)(s1->timestamp_us - s0->timestamp_us) * 1e-6f;
+
+    out->q = quaternion_slerp(s0->q, s1->q, u);
+
+    if (u > 1.0f) {
+        // 같은 가속으로 속도 외삽, 위치는 사다리꼴 적분
+        float dt = (u - 1.0f) * h;
+        Vector3f accel = vector3f_scale(vector3f_subtract(s1->vel, s0->vel), 1.0f / h);
+        out->vel = vector3f_add(s1->vel, vector3f_scale(accel, dt));
+        out->pos = vector3f_add(s1->pos, vector3f_scale(vector3f_add(s1->vel, out->vel), 0.5f * dt));
+    } else if (method == EVENT_TAGGER_CUBIC) {
+        // 3차 에르미트 기저와 그 도함수
+        float u2 = u * u;
+        float u3 = u2 * u;
+        float h00 = 2.0f * u3 - 3.0f * u2 + 1.0f;
+        float h10 = u3 - 2.0f * u2 + u;
+        float h01 = 3.0f * u2 - 2.0f * u3;
+        float h11 = u3 - u2;
+        float d00 = (6.0f * u2 - 6.0f * u) / h;
+        float d10 = 3.0f * u2 - 4.0f * u + 1.0f;
+        float d11 = 3.0f * u2 - 2.0f * u;
+
+        out->pos = vector3f_add(vector3f_add(vector3f_scale(s0->pos, h00), vector3f_scale(s0->vel, h10 * h)),
+                                vector3f_add(vector3f_scale(s1->pos, h01), vector3f_scale(s1->vel, h11 * h)));
+        out->vel = vector3f_add(vector3f_add(vector3f_scale(vector3f_subtract(s0->pos, s1->pos), d00),
+                                             vector3f_scale(s0->vel, d10)),
+                                vector3f_scale(s1->vel, d11));
+    } else {
+        out->pos = vector3f_add(s0->pos, vector3f_scale(vector3f_subtract(s1->pos, s0->pos), u));
+        out->vel = vector3f_add(s0->vel, vector3f_scale(vector3f_subtract(s1->vel, s0->vel), u));
+    }
+}
+
+/**
+ * @brief 사건 시각의 상태 보간
+ */
+bool event_tagger_query(const EventTagger *et, uint32_t timestamp_us, uint8_t method, EventTaggerResult *out) {
+    if (out == NULL) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    out->timestamp_us = timestamp_us;
+    out->status = EVENT_TAGGER_EMPTY;
+    if (et == NULL || !et->initialized) {
+        return false;
+    }
+
+    for (uint8_t attempt = 0; attempt < EVENT_TAGGER_MAX_RETRIES; attempt++) {
+        uint_fast32_t head = atomic_load_explicit(&et->head, memory_order_acquire);
+        if (head < 2) {
+            out->status = EVENT_TAGGER_EMPTY;
+            return false;
+        }
+
+        // 작성 중인 다음 슬롯과 겹치지 않도록 한 칸 남김
+        uint_fast32_t n = (head < EVENT_TAGGER_HISTORY - 1u) ? head : EVENT_TAGGER_HISTORY - 1u;
+        uint_fast32_t oldest = head - n;
+        uint_fast32_t lo = head - 2;
+        uint_fast32_t hi = head - 1;
+        uint8_t status;
+
+        if ((int32_t)(timestamp_us - et->ring[hi & EVENT_TAGGER_MASK].timestamp_us) >= 0) {
+            status = EVENT_TAGGER_EXTRAPOLATED;
+        } else if ((int32_t)(timestamp_us - et->ring[oldest & EVENT_TAGGER_MASK].timestamp_us) < 0) {
+            status = EVENT_TAGGER_TOO_OLD;
+        } else {
+            // ring[lo] <= t < ring[hi]
+            status = EVENT_TAGGER_OK;
+            lo = oldest;
+            while (hi - lo > 1) {
+                uint_fast32_t mid = lo + (hi - lo) / 2;
+                if ((int32_t)(timestamp_us - et->ring[mid & EVENT_TAGGER_MASK].timestamp_us) >= 0) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+        }
+
+        EventTaggerSample s0;
+        EventTaggerSample s1;
+        memcpy(&s0, &et->ring[lo & EVENT_TAGGER_MASK], sizeof(s0));
+        memcpy(&s1, &et->ring[hi & EVENT_TAGGER_MASK], sizeof(s1));
+
+        // 탐색과 복사가 두 번째 기록 수 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(&et->head, memory_order_relaxed);
+        uint_fast32_t first = (status == EVENT_TAGGER_EXTRAPOLATED) ? lo : oldest;
+        if (after - first >= EVENT_TAGGER_HISTORY) {
+            continue;
+        }
+
+        out->status = status;
+        if (status == EVENT_TAGGER_TOO_OLD) {
+            return false;
+        }
+
+        uint32_t span = s1.timestamp_us - s0.timestamp_us;
+        out->span_us = span;
+        if (span == 0 || span > et->config.max_span_us) {
+            out->status = EVENT_TAGGER_GAP;
+            return false;
+        }
+
+        uint32_t offset = timestamp_us - s0.timestamp_us;
+        if (status == EVENT_TAGGER_EXTRAPOLATED) {
+            if (offset - span > et->config.max_extrapolate_us) {
+                out->status = EVENT_TAGGER_PENDING;
+                return false;
+            }
+            if (offset == span) {
+                // 마지막 샘플 시각과 같으면 보간과 같음
+                out->status = EVENT_TAGGER_OK;
+            }
+        }
+
+        event_tagger_blend(&s0, &s1, (float)offset / (float)span, method, out);
+
+        return true;
+    }
+
+    out->status = EVENT_TAGGER_BUSY;
+    return false;
+}
+
+/**
+ * @brief 통계
+ */
+const EventTaggerStats *event_tagger_get_stats(const EventTagger *et) {
+    if (et == NULL) {
+        return NULL;
+    }
+
+    return &et->stats;
+}
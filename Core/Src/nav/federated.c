@@ -0,0 +1,740 @@
+/**
+ * @file federated.c
+ * @brief 보드 간 연합 항법 구현
+ */
+
+#include "nav/federated.h"
+#include "math/matrix_fixed.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 평균 고정소수점 눈금
+ */
+#define FEDERATED_QUAT_LSB (1.0f / 32767.0f)
+#define FEDERATED_VEL_LSB 0.02f          /**< m/s */
+#define FEDERATED_POS_LSB 0.01f          /**< m */
+
+/**
+ * @brief 공분산 코드 눈금
+ */
+#define FEDERATED_SIGMA_STEPS 8.0f        /**< 표준 편차 코드 옥타브당 칸 수 */
+#define FEDERATED_LAMBDA_STEPS 64.0f      /**< λ 코드 한 칸 = 1/64 */
+#define FEDERATED_SCALE_OFFSET 128        /**< U 눈금 코드 0점 */
+
+/**
+ * @brief 평균 양자화 오차 분산 (반 칸, 회전각은 사원수 4성분 x 2)
+ */
+#define FEDERATED_ATT_QUANT_VAR 3.7e-9f   /**< rad^2 */
+#define FEDERATED_VEL_QUANT_VAR 1.0e-4f   /**< (m/s)^2 */
+#define FEDERATED_POS_QUANT_VAR 2.5e-5f   /**< m^2 */
+
+/**
+ * @brief 성분별 표준 편차 코드 기준값 (회전각, 속도, 위치)
+ */
+static const float federated_sigma_base[3] = { 1.0e-5f, 1.0e-4f, 1.0e-3f };
+
+/**
+ * @brief 전송 형식 위치
+ */
+#define FEDERATED_OFS_TIME 0
+#define FEDERATED_OFS_FLAGS 4
+#define FEDERATED_OFS_QUAT 5
+#define FEDERATED_OFS_VEL 13
+#define FEDERATED_OFS_POS 19
+#define FEDERATED_OFS_SIGMA 31
+#define FEDERATED_OFS_LAMBDA 40
+#define FEDERATED_OFS_SCALE 41
+#define FEDERATED_OFS_U 43
+
+/**
+ * @brief 리틀 엔디언 읽기/쓰기
+ */
+static void federated_put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void federated_put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t federated_get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t federated_get32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 고정소수점 변환 (반올림, 범위 밖은 포화)
+ */
+static int32_t federated_quantize(float v, float lsb, int32_t limit) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > (float)limit) {
+        return limit;
+    }
+    if (q < -(float)limit) {
+        return -limit;
+    }
+    return (int32_t)lrintf(q);
+}
+
+/**
+ * @brief 로그 코드 올림 변환 (값 = base x 2^(c / steps), 0..255로 제한)
+ */
+static uint8_t federated_log_code(float v, float base, float steps) {
+    if (!(v > base)) {
+        return 0;
+    }
+    float c = ceilf(steps * fp_log2f(v / base));
+    return (c >= 255.0f) ? 255u : (uint8_t)c;
+}
+
+static float federated_log_value(uint8_t c, float base, float steps) {
+    return base * fp_exp2f((float)c / steps);
+}
+
+/**
+ * @brief 대칭 행렬 고유 분해 (순환 야코비 회전, A는 대각화되어 고유값이 대각에 남음)
+ */
+static void federated_jacobi(float A[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM],
+                             float V[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM]) {
+    const uint8_t n = EKF_NAV_ERROR_DIM;
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            V[i][j] = (i == j) ? 1.0f : 0.0f;
+        }
+    }
+
+    for (uint8_t sweep = 0; sweep < FEDERATED_JACOBI_SWEEPS; sweep++) {
+        float off = 0.0f;
+        for (uint8_t p = 0; p < n; p++) {
+            for (uint8_t q = p + 1; q < n; q++) {
+                off += A[p][q] * A[p][q];
+            }
+        }
+        // M의 대각은 1 이하이므로 절대 문턱으로 충분
+        if (off < 1.0e-12f) {
+            break;
+        }
+
+        for (uint8_t p = 0; p < n; p++) {
+            for (uint8_t q = p + 1; q < n; q++) {
+                float apq = A[p][q];
+                if (fabsf(apq) < 1.0e-9f) {
+                    continue;
+                }
+                float theta = (A[q][q] - A[p][p]) / (2.0f * apq);
+                float t = 1.0f / (fabsf(theta) + sqrtf(theta * theta + 1.0f));
+                if (theta < 0.0f) {
+                    t = -t;
+                }
+                float c = 1.0f / sqrtf(t * t + 1.0f);
+                float s = t * c;
+
+                for (uint8_t k = 0; k < n; k++) {
+                    float akp = A[k][p];
+                    float akq = A[k][q];
+                    A[k][p] = c * akp - s * akq;
+                    A[k][q] = s * akp + c * akq;
+                }
+                for (uint8_t k = 0; k < n; k++) {
+                    float apk = A[p][k];
+                    float aqk = A[q][k];
+                    A[p][k] = c * apk - s * aqk;
+                    A[q][k] = s * apk + c * aqk;
+                }
+                for (uint8_t k = 0; k < n; k++) {
+                    float vkp = V[k][p];
+                    float vkq = V[k][q];
+                    V[k][p] = c * vkp - s * vkq;
+                    V[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool federated_default_config(FederatedConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->base_id = FEDERATED_DEFAULT_BASE_ID;
+    config->node_id = 0;
+    config->check_gate = FEDERATED_DEFAULT_CHECK_GATE;
+    config->disagree_count = FEDERATED_DEFAULT_DISAGREE_COUNT;
+    config->max_age_us = FEDERATED_DEFAULT_MAX_AGE_US;
+    config->timeout_us = FEDERATED_DEFAULT_TIMEOUT_US;
+    config->omega_min = FEDERATED_DEFAULT_OMEGA_MIN;
+
+    return true;
+}
+
+/**
+ * @brief 노드 초기화
+ */
+bool federated_init(FederatedNode *node, const FederatedConfig *config) {
+    if (node == NULL) {
+        return false;
+    }
+
+    FederatedConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        federated_default_config(&cfg);
+    }
+    if ((uint32_t)cfg.base_id + 16u > 0x800u || cfg.node_id > 15u || !(cfg.check_gate > 0.0f) ||
+        cfg.disagree_count == 0 || cfg.max_age_us == 0 || cfg.timeout_us == 0 ||
+        !(cfg.omega_min > 0.0f) || !(cfg.omega_min < 1.0f)) {
+        return false;
+    }
+
+    memset(node, 0, sizeof(*node));
+    node->config = cfg;
+
+    return true;
+}
+
+/**
+ * @brief EKF에서 요약 만들기
+ */
+bool federated_estimate_from_ekf(const EKF *ekf, uint32_t timestamp_us, FederatedEstimate *est) {
+    if (ekf == NULL || est == NULL || !ekf_get_nav_error_covariance(ekf, est->P)) {
+        return false;
+    }
+
+    est->timestamp_us = timestamp_us;
+    est->components = EKF_NAV_ERROR_ATT | EKF_NAV_ERROR_VEL;
+#if EKF_CONFIG_POSITION
+    est->components |= EKF_NAV_ERROR_POS;
+#endif
+    est->q = ekf_get_attitude(ekf);
+    est->vel = ekf_get_velocity(ekf);
+    est->pos = ekf_get_position(ekf);
+
+    return true;
+}
+
+/**
+ * @brief 요약 양자화
+ */
+bool federated_encode(const FederatedEstimate *est, uint8_t buf[FEDERATED_WIRE_SIZE]) {
+    if (est == NULL || buf == NULL) {
+        return false;
+    }
+
+    const uint8_t n = EKF_NAV_ERROR_DIM;
+    memset(buf, 0, FEDERATED_WIRE_SIZE);
+
+    // 평균
+    federated_put32(&buf[FEDERATED_OFS_TIME], est->timestamp_us);
+    buf[FEDERATED_OFS_FLAGS] = est->components & (EKF_NAV_ERROR_ATT | EKF_NAV_ERROR_VEL | EKF_NAV_ERROR_POS);
+    Quaternion q = quaternion_normalize(est->q);
+    if (q.w < 0.0f) {
+        q = quaternion_create(-q.w, -q.x, -q.y, -q.z);
+    }
+    const float qv[4] = { q.w, q.x, q.y, q.z };
+    for (uint8_t i = 0; i < 4; i++) {
+        federated_put16(&buf[FEDERATED_OFS_QUAT + 2 * i],
+                        (uint16_t)federated_quantize(qv[i], FEDERATED_QUAT_LSB, 32767));
+    }
+    const float v[3] = { est->vel.x, est->vel.y, est->vel.z };
+    const float p[3] = { est->pos.x, est->pos.y, est->pos.z };
+    for (uint8_t i = 0; i < 3; i++) {
+        federated_put16(&buf[FEDERATED_OFS_VEL + 2 * i],
+                        (uint16_t)federated_quantize(v[i], FEDERATED_VEL_LSB, 32767));
+        federated_put32(&buf[FEDERATED_OFS_POS + 4 * i],
+                        (uint32_t)federated_quantize(p[i], FEDERATED_POS_LSB, 2000000000));
+    }
+
+    // 표준 편차 (올림) -> 정규화 M = S^-1 P S^-1 (대각 1 이하)
+    float s[EKF_NAV_ERROR_DIM];
+    for (uint8_t i = 0; i < n; i++) {
+        float var = est->P[i][i];
+        if (!(var > 0.0f) || !isfinite(var)) {
+            return false;
+        }
+        float base = federated_sigma_base[i / 3];
+        uint8_t c = federated_log_code(sqrtf(var), base, FEDERATED_SIGMA_STEPS);
+        buf[FEDERATED_OFS_SIGMA + i] = c;
+        s[i] = federated_log_value(c, base, FEDERATED_SIGMA_STEPS);
+    }
+    float M[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM];
+    float V[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM];
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            M[i][j] = 0.5f * (est->P[i][j] + est->P[j][i]) / (s[i] * s[j]);
+        }
+    }
+    federated_jacobi(M, V);
+
+    // 상위 FEDERATED_RANK개 고유값과 그다음 값 λ
+    uint8_t top[FEDERATED_RANK];
+    uint16_t taken = 0;
+    for (uint8_t r = 0; r < FEDERATED_RANK; r++) {
+        uint8_t best = 0;
+        float best_val = -INFINITY;
+        for (uint8_t i = 0; i < n; i++) {
+            if (!(taken & (1u << i)) && M[i][i] > best_val) {
+                best = i;
+                best_val = M[i][i];
+            }
+        }
+        top[r] = best;
+        taken |= (uint16_t)(1u << best);
+    }
+    float lambda = 0.0f;
+    for (uint8_t i = 0; i < n; i++) {
+        if (!(taken & (1u << i)) && M[i][i] > lambda) {
+            lambda = M[i][i];
+        }
+    }
+
+    // U = V sqrt(Λ - λ), 열마다 8비트 눈금 (올림)
+    float err = 0.0f;
+    for (uint8_t r = 0; r < FEDERATED_RANK; r++) {
+        float root = sqrtf(fmaxf(M[top[r]][top[r]] - lambda, 0.0f));
+        float umax = 0.0f;
+        for (uint8_t i = 0; i < n; i++) {
+            umax = fmaxf(umax, fabsf(V[i][top[r]]) * root);
+        }
+        int32_t code = (umax > 0.0f)
+            ? (int32_t)ceilf(FEDERATED_SIGMA_STEPS * fp_log2f(umax / 127.0f)) + FEDERATED_SCALE_OFFSET
+            : 0;
+        code = (code < 0) ? 0 : (code > 255) ? 255 : code;
+        buf[FEDERATED_OFS_SCALE + r] = (uint8_t)code;
+        float step = fp_exp2f((float)(code - FEDERATED_SCALE_OFFSET) / FEDERATED_SIGMA_STEPS);
+        for (uint8_t i = 0; i < n; i++) {
+            float u = V[i][top[r]] * root;
+            int32_t k = federated_quantize(u, step, 127);
+            buf[FEDERATED_OFS_U + i * FEDERATED_RANK + r] = (uint8_t)(int8_t)k;
+            float e = u - (float)k * step;
+            err += e * e;
+        }
+    }
+
+    // 양자화 오차 |E|_F^2 를 λ에 더해 올림
+    lambda += (1.0f + 1.0f / FEDERATED_LOW_RANK_MARGIN) * err;
+    float lc = ceilf(lambda * FEDERATED_LAMBDA_STEPS);
+    buf[FEDERATED_OFS_LAMBDA] = (lc < 1.0f) ? 1u : (lc >= 255.0f) ? 255u : (uint8_t)lc;
+
+    return true;
+}
+
+/**
+ * @brief 요약 복원
+ */
+bool federated_decode(const uint8_t buf[FEDERATED_WIRE_SIZE], FederatedEstimate *est) {
+    if (buf == NULL || est == NULL) {
+        return false;
+    }
+
+    const uint8_t n = EKF_NAV_ERROR_DIM;
+    est->timestamp_us = federated_get32(&buf[FEDERATED_OFS_TIME]);
+    est->components = buf[FEDERATED_OFS_FLAGS] & (EKF_NAV_ERROR_ATT | EKF_NAV_ERROR_VEL | EKF_NAV_ERROR_POS);
+
+    float qv[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        qv[i] = (float)(int16_t)federated_get16(&buf[FEDERATED_OFS_QUAT + 2 * i]) * FEDERATED_QUAT_LSB;
+    }
+    est->q = quaternion_normalize(quaternion_create(qv[0], qv[1], qv[2], qv[3]));
+    float v[3];
+    float p[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        v[i] = (float)(int16_t)federated_get16(&buf[FEDERATED_OFS_VEL + 2 * i]) * FEDERATED_VEL_LSB;
+        p[i] = (float)(int32_t)federated_get32(&buf[FEDERATED_OFS_POS + 4 * i]) * FEDERATED_POS_LSB;
+    }
+    est->vel = vector3f_create(v[0], v[1], v[2]);
+    est->pos = vector3f_create(p[0], p[1], p[2]);
+
+    // P = S (λ I + (1 + ε) U U^T) S + 평균 양자화 분산
+    float s[EKF_NAV_ERROR_DIM];
+    for (uint8_t i = 0; i < n; i++) {
+        s[i] = federated_log_value(buf[FEDERATED_OFS_SIGMA + i], federated_sigma_base[i / 3], FEDERATED_SIGMA_STEPS);
+    }
+    float lambda = (float)buf[FEDERATED_OFS_LAMBDA] / FEDERATED_LAMBDA_STEPS;
+    float U[EKF_NAV_ERROR_DIM][FEDERATED_RANK];
+    for (uint8_t r = 0; r < FEDERATED_RANK; r++) {
+        float step = fp_exp2f((float)((int32_t)buf[FEDERATED_OFS_SCALE + r] - FEDERATED_SCALE_OFFSET) /
+                           FEDERATED_SIGMA_STEPS);
+        for (uint8_t i = 0; i < n; i++) {
+            U[i][r] = (float)(int8_t)buf[FEDERATED_OFS_U + i * FEDERATED_RANK + r] * step;
+        }
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            float m = (i == j) ? lambda : 0.0f;
+            float uu = 0.0f;
+            for (uint8_t r = 0; r < FEDERATED_RANK; r++) {
+                uu += U[i][r] * U[j][r];
+            }
+            m += (1.0f + FEDERATED_LOW_RANK_MARGIN) * uu;
+            est->P[i][j] = s[i] * m * s[j];
+        }
+    }
+    static const float quant_var[3] = { FEDERATED_ATT_QUANT_VAR, FEDERATED_VEL_QUANT_VAR, FEDERATED_POS_QUANT_VAR };
+    for (uint8_t i = 0; i < n; i++) {
+        est->P[i][i] += quant_var[i / 3];
+    }
+
+    return true;
+}
+
+/**
+ * @brief 자기 요약 프레임 만들기
+ */
+uint8_t federated_build_frames(FederatedNode *node, const EKF *ekf, uint32_t timestamp_us,
+                               FederatedFrame frames[FEDERATED_FRAME_COUNT]) {
+    if (node == NULL || frames == NULL) {
+        return 0;
+    }
+
+    FederatedEstimate est;
+    uint8_t buf[FEDERATED_WIRE_SIZE];
+    if (!federated_estimate_from_ekf(ekf, timestamp_us, &est) || !federated_encode(&est, buf)) {
+        return 0;
+    }
+
+    uint8_t seq = node->tx_seq & 0x0Fu;
+    node->tx_seq = (uint8_t)((seq + 1u) & 0x0Fu);
+    for (uint8_t part = 0; part < FEDERATED_FRAME_COUNT; part++) {
+        FederatedFrame *f = &frames[part];
+        f->id = (uint16_t)(node->config.base_id + node->config.node_id);
+        f->dlc = 8;
+        f->data[0] = (uint8_t)((seq << 4) | part);
+        memcpy(&f->data[1], &buf[part * FEDERATED_FRAME_PAYLOAD], FEDERATED_FRAME_PAYLOAD);
+    }
+    node->stats.sent++;
+
+    return FEDERATED_FRAME_COUNT;
+}
+
+/**
+ * @brief 수신 프레임 처리
+ */
+bool federated_handle_frame(FederatedNode *node, uint16_t id, const uint8_t *data, uint8_t dlc) {
+    if (node == NULL || data == NULL || dlc < 8) {
+        return false;
+    }
+
+    const FederatedConfig *cfg = &node->config;
+    if (id < cfg->base_id || id >= cfg->base_id + 16u || id == cfg->base_id + cfg->node_id) {
+        return false;
+    }
+
+    uint8_t seq = data[0] >> 4;
+    uint8_t part = data[0] & 0x0Fu;
+    if (part >= FEDERATED_FRAME_COUNT) {
+        return false;
+    }
+
+    // 새 요약의 첫 조각: 이전 조립이 덜 끝났으면 버림
+    if (node->rx_mask != 0 && (id != node->rx_id || seq != node->rx_seq)) {
+        node->stats.incomplete++;
+        node->rx_mask = 0;
+    }
+    node->rx_id = id;
+    node->rx_seq = seq;
+    node->rx_mask |= (uint16_t)(1u << part);
+    memcpy(&node->rx_buf[part * FEDERATED_FRAME_PAYLOAD], &data[1], FEDERATED_FRAME_PAYLOAD);
+
+    if (node->rx_mask != (uint16_t)((1u << FEDERATED_FRAME_COUNT) - 1u)) {
+        return false;
+    }
+    node->rx_mask = 0;
+
+    if (!federated_decode(node->rx_buf, &node->remote)) {
+        return false;
+    }
+    node->has_remote = true;
+    node->stats.received++;
+
+    return true;
+}
+
+/**
+ * @brief 원격 요약을 현재 시각으로 (위치만 속도로 옮김, 오래되면 false)
+ */
+static bool federated_remote_now(FederatedNode *node, uint32_t now_us, Vector3f *pos) {
+    if (!node->has_remote) {
+        return false;
+    }
+
+    int32_t age = (int32_t)(now_us - node->remote.timestamp_us);
+    if (age < -(int32_t)node->config.max_age_us || age > (int32_t)node->config.max_age_us) {
+        node->stats.stale++;
+        return false;
+    }
+
+    float dt = (float)age * 1.0e-6f;
+    *pos = vector3f_create(node->remote.pos.x + node->remote.vel.x * dt,
+                           node->remote.pos.y + node->remote.vel.y * dt,
+                           node->remote.pos.z + node->remote.vel.z * dt);
+
+    return true;
+}
+
+/**
+ * @brief 두 추정의 공통 성분 (쓰지 않는 성분은 단위 행/열로 채운 9x9 행렬 용)
+ */
+static bool federated_used(uint8_t components, uint8_t i) {
+    static const uint8_t bit[3] = { EKF_NAV_ERROR_ATT, EKF_NAV_ERROR_VEL, EKF_NAV_ERROR_POS };
+    return (components & bit[i / 3]) != 0;
+}
+
+/**
+ * @brief 공통 성분 공분산을 9x9로 (쓰지 않는 성분은 단위)
+ */
+static void federated_restrict(const float P[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM], uint8_t components,
+                               Mat9x9 *out) {
+    for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+        for (uint8_t j = 0; j < EKF_NAV_ERROR_DIM; j++) {
+            if (federated_used(components, i) && federated_used(components, j)) {
+                out->data[i][j] = P[i][j];
+            } else {
+                out->data[i][j] = (i == j) ? 1.0f : 0.0f;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 역행렬 (LDL^T 풀이, 양정치가 아니면 false)
+ */
+static bool federated_inverse(const Mat9x9 *P, Mat9x9 *inv) {
+    Mat9x9 LD;
+    if (!mat9x9_ldlt(P, &LD)) {
+        return false;
+    }
+
+    for (uint8_t j = 0; j < EKF_NAV_ERROR_DIM; j++) {
+        float col[EKF_NAV_ERROR_DIM];
+        for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+            col[i] = (i == j) ? 1.0f : 0.0f;
+        }
+        mat9x9_ldlt_solve(&LD, col);
+        for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+            inv->data[i][j] = col[i];
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief log det(ω A + (1 - ω) B) (양정치가 아니면 -INFINITY)
+ */
+static float federated_log_det(const Mat9x9 *A, const Mat9x9 *B, float omega) {
+    Mat9x9 C;
+    Mat9x9 LD;
+    for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+        for (uint8_t j = 0; j < EKF_NAV_ERROR_DIM; j++) {
+            C.data[i][j] = omega * A->data[i][j] + (1.0f - omega) * B->data[i][j];
+        }
+    }
+    if (!mat9x9_ldlt(&C, &LD)) {
+        return -INFINITY;
+    }
+
+    // LD 대각은 1/D
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+        sum -= fp_logf(LD.data[i][i]);
+    }
+    return sum;
+}
+
+/**
+ * @brief 교차 검사 본체 (차이와 공통 성분도 돌려줌)
+ */
+static bool federated_check(FederatedNode *node, const EKF *ekf, uint32_t now_us,
+                            float Pa[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM], uint8_t *components,
+                            Vector3f *remote_pos, float *nis) {
+    if (node == NULL || ekf == NULL || !ekf_get_nav_error_covariance(ekf, Pa) ||
+        !federated_remote_now(node, now_us, remote_pos)) {
+        return false;
+    }
+
+    uint8_t comps = node->remote.components & (EKF_NAV_ERROR_ATT | EKF_NAV_ERROR_VEL);
+#if EKF_CONFIG_POSITION
+    comps |= node->remote.components & EKF_NAV_ERROR_POS;
+#endif
+    if (comps == 0) {
+        return false;
+    }
+
+    // 차이 y (자기 자세 기준 몸체 좌표계 회전각, 속도, 위치)
+    Quaternion qa = ekf_get_attitude(ekf);
+    Vector3f theta = quaternion_to_rotation_vector(quaternion_multiply(quaternion_conjugate(qa), node->remote.q));
+    Vector3f va = ekf_get_velocity(ekf);
+    Vector3f pa = ekf_get_position(ekf);
+    float y[EKF_NAV_ERROR_DIM] = {
+        theta.x, theta.y, theta.z,
+        node->remote.vel.x - va.x, node->remote.vel.y - va.y, node->remote.vel.z - va.z,
+        remote_pos->x - pa.x, remote_pos->y - pa.y, remote_pos->z - pa.z
+    };
+
+    Mat9x9 S;
+    Mat9x9 LD;
+    for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+        for (uint8_t j = 0; j < EKF_NAV_ERROR_DIM; j++) {
+            S.data[i][j] = Pa[i][j] + node->remote.P[i][j];
+        }
+    }
+    federated_restrict(S.data, comps, &S);
+    for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+        if (!federated_used(comps, i)) {
+            y[i] = 0.0f;
+        }
+    }
+    if (!mat9x9_ldlt(&S, &LD)) {
+        return false;
+    }
+    float z[EKF_NAV_ERROR_DIM];
+    memcpy(z, y, sizeof(z));
+    mat9x9_ldlt_solve(&LD, z);
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < EKF_NAV_ERROR_DIM; i++) {
+        sum += y[i] * z[i];
+    }
+
+    node->stats.checks++;
+    node->stats.last_nis = sum;
+    if (!(sum <= node->config.check_gate)) {
+        node->stats.gate_fails++;
+        if (node->disagree_run < UINT16_MAX) {
+            node->disagree_run++;
+        }
+        if (node->disagree_run >= node->config.disagree_count) {
+            node->disagree = true;
+        }
+    } else {
+        node->disagree_run = 0;
+        node->disagree = false;
+    }
+
+    *components = comps;
+    *nis = sum;
+
+    return true;
+}
+
+/**
+ * @brief 교차 검사
+ */
+bool federated_cross_check(FederatedNode *node, const EKF *ekf, uint32_t now_us, float *nis) {
+    float Pa[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM];
+    uint8_t comps;
+    Vector3f pos;
+    float value;
+    if (!federated_check(node, ekf, now_us, Pa, &comps, &pos, &value)) {
+        return false;
+    }
+
+    if (nis != NULL) {
+        *nis = value;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 교차 검사 후 CI 융합
+ */
+bool federated_fuse(FederatedNode *node, EKF *ekf, uint32_t now_us) {
+    float Pa[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM];
+    uint8_t comps;
+    Vector3f pos;
+    float nis;
+    if (!federated_check(node, ekf, now_us, Pa, &comps, &pos, &nis) || node->disagree) {
+        return false;
+    }
+
+    // 정보 행렬 A = Pa^-1, B = Pb^-1 (공통 성분만)
+    Mat9x9 Ma;
+    Mat9x9 Mb;
+    Mat9x9 A;
+    Mat9x9 B;
+    federated_restrict(Pa, comps, &Ma);
+    federated_restrict(node->remote.P, comps, &Mb);
+    if (!federated_inverse(&Ma, &A) || !federated_inverse(&Mb, &B)) {
+        return false;
+    }
+
+    // ω: det(P_ci) 최소 = log det(ω A + (1 - ω) B) 최대 (오목 함수, 황금 분할)
+    const float g = 0.6180340f;
+    float lo = node->config.omega_min;
+    float hi = 1.0f;
+    float w1 = hi - g * (hi - lo);
+    float w2 = lo + g * (hi - lo);
+    float f1 = federated_log_det(&A, &B, w1);
+    float f2 = federated_log_det(&A, &B, w2);
+    for (uint8_t it = 0; it < FEDERATED_OMEGA_ITERATIONS; it++) {
+        if (f1 < f2) {
+            lo = w1;
+            w1 = w2;
+            f1 = f2;
+            w2 = lo + g * (hi - lo);
+            f2 = federated_log_det(&A, &B, w2);
+        } else {
+            hi = w2;
+            w2 = w1;
+            f2 = f1;
+            w1 = hi - g * (hi - lo);
+            f1 = federated_log_det(&A, &B, w1);
+        }
+    }
+    float omega = 0.5f * (lo + hi);
+    node->stats.last_omega = omega;
+
+    if (!ekf_update_nav_estimate(ekf, node->remote.q, node->remote.vel, pos, node->remote.P, comps, omega)) {
+        return false;
+    }
+    node->stats.fusions++;
+
+    return true;
+}
+
+/**
+ * @brief 원격 노드 동작 여부
+ */
+bool federated_remote_alive(const FederatedNode *node, uint32_t now_us) {
+    if (node == NULL || !node->has_remote) {
+        return false;
+    }
+
+    return (uint32_t)(now_us - node->remote.timestamp_us) <= node->config.timeout_us;
+}
+
+/**
+ * @brief 불일치 판정 여부
+ */
+bool federated_is_disagreeing(const FederatedNode *node) {
+    return node != NULL && node->disagree;
+}
+
+/**
+ * @brief 통계 조회
+ */
+const FederatedStats *federated_get_stats(const FederatedNode *node) {
+    if (node == NULL) {
+        return NULL;
+    }
+
+    return &node->stats;
+}
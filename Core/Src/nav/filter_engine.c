@@ -0,0 +1,345 @@
+/**
+ * @file filter_engine.c
+ * @brief 필터 엔진 함수 테이블 구현
+ */
+
+#include "nav/filter_engine.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ---------------------------------------------------------------------------
+ * EKF 계열 (공분산 엔진, 갱신 방식만 다름)
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief EKF 초기화 공통 (엔진과 갱신 방식 지정)
+ */
+static bool filter_engine_ekf_setup(EKF *ekf, const FilterEngineConfig *config, EKF_Engine engine,
+                                    EKF_UpdateMode mode) {
+    if (!ekf_init(ekf) || !ekf_set_update_mode(ekf, mode)) {
+        return false;
+    }
+    if (config->pos_std > 0.0f &&
+        !ekf_set_process_noise(ekf, config->pos_std, config->vel_std, config->att_std,
+                               config->gyro_bias_std, config->accel_bias_std)) {
+        return false;
+    }
+    if (config->gps_pos_std > 0.0f && !ekf_set_gps_noise(ekf, config->gps_pos_std, config->gps_vel_std)) {
+        return false;
+    }
+    if (config->baro_std > 0.0f && !ekf_set_baro_noise(ekf, config->baro_std)) {
+        return false;
+    }
+    if (config->mag_std > 0.0f && !ekf_set_mag_noise(ekf, config->mag_std)) {
+        return false;
+    }
+
+    // 초기 P가 정해진 뒤 분해하도록 엔진은 마지막에 설정
+    return ekf_set_initial_state(ekf, config->pos, config->vel, config->q) && ekf_set_engine(ekf, engine);
+}
+
+static bool filter_engine_ekf_init(FilterEngineState *state, const FilterEngineConfig *config) {
+    return filter_engine_ekf_setup(&state->ekf, config, EKF_ENGINE_COVARIANCE, EKF_UPDATE_SEQUENTIAL);
+}
+
+static bool filter_engine_ekf_batch_init(FilterEngineState *state, const FilterEngineConfig *config) {
+    return filter_engine_ekf_setup(&state->ekf, config, EKF_ENGINE_COVARIANCE, EKF_UPDATE_BATCH);
+}
+
+static bool filter_engine_ekf_ud_init(FilterEngineState *state, const FilterEngineConfig *config) {
+    return filter_engine_ekf_setup(&state->ekf, config, EKF_ENGINE_UD, EKF_UPDATE_SEQUENTIAL);
+}
+
+static bool filter_engine_ekf_predict(FilterEngineState *state, Vector3f gyro, Vector3f accel, float dt) {
+    return ekf_predict(&state->ekf, gyro, accel, dt);
+}
+
+static bool filter_engine_ekf_predict_batch(FilterEngineState *state, const EKF_ImuSample *samples, uint16_t n) {
+    return ekf_predict_batch(&state->ekf, samples, n);
+}
+
+static bool filter_engine_ekf_update(FilterEngineState *state, const FilterEngineMeasurement *m) {
+    switch (m->sensor) {
+    case EKF_SENSOR_GPS_POS:
+        return ekf_update_gps(&state->ekf, m->value, false, vector3f_zero());
+    case EKF_SENSOR_GPS_POS_VEL:
+        return ekf_update_gps(&state->ekf, m->value, true, m->vel);
+    case EKF_SENSOR_BARO:
+        return ekf_update_baro(&state->ekf, m->scalar);
+    case EKF_SENSOR_MAG:
+        return ekf_update_mag(&state->ekf, m->value);
+    default:
+        return false;
+    }
+}
+
+static bool filter_engine_ekf_get_solution(const FilterEngineState *state, uint32_t timestamp_us,
+                                           EKF_NavSolution *sol) {
+    return ekf_get_nav_solution(&state->ekf, timestamp_us, sol);
+}
+
+/* ---------------------------------------------------------------------------
+ * 오차 상태 필터
+ * ------------------------------------------------------------------------- */
+
+static bool filter_engine_eskf_init(FilterEngineState *state, const FilterEngineConfig *config) {
+    ESKF *eskf = &state->eskf;
+    if (!eskf_init(eskf)) {
+        return false;
+    }
+    if (config->pos_std > 0.0f &&
+        !eskf_set_process_noise(eskf, config->pos_std, config->vel_std, config->att_std,
+                                config->gyro_bias_std, config->accel_bias_std)) {
+        return false;
+    }
+    if (config->gps_pos_std > 0.0f && !eskf_set_gps_noise(eskf, config->gps_pos_std, config->gps_vel_std)) {
+        return false;
+    }
+    if (config->baro_std > 0.0f && !eskf_set_baro_noise(eskf, config->baro_std)) {
+        return false;
+    }
+    if (config->mag_std > 0.0f && !eskf_set_mag_noise(eskf, config->mag_std)) {
+        return false;
+    }
+
+    return eskf_set_initial_state(eskf, config->pos, config->vel, config->q);
+}
+
+static bool filter_engine_eskf_predict(FilterEngineState *state, Vector3f gyro, Vector3f accel, float dt) {
+    return eskf_predict(&state->eskf, gyro, accel, dt);
+}
+
+/**
+ * @brief ESKF 묶음 예측 (묶음 경로가 없으므로 샘플마다, ekf_predict_batch와 같은 dt 검사)
+ */
+static bool filter_engine_eskf_predict_batch(FilterEngineState *state, const EKF_ImuSample *samples, uint16_t n) {
+    for (uint16_t k = 0; k < n; k++) {
+        if (!(samples[k].dt > 0.0f)) {
+            return false;
+        }
+    }
+    for (uint16_t k = 0; k < n; k++) {
+        if (!eskf_predict(&state->eskf, samples[k].gyro, samples[k].accel, samples[k].dt)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool filter_engine_eskf_update(FilterEngineState *state, const FilterEngineMeasurement *m) {
+    switch (m->sensor) {
+    case EKF_SENSOR_GPS_POS:
+        return eskf_update_gps(&state->eskf, m->value, false, vector3f_zero());
+    case EKF_SENSOR_GPS_POS_VEL:
+        return eskf_update_gps(&state->eskf, m->value, true, m->vel);
+    case EKF_SENSOR_BARO:
+        return eskf_update_baro(&state->eskf, m->scalar);
+    case EKF_SENSOR_MAG:
+        return eskf_update_mag(&state->eskf, m->value);
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief ESKF 오차 상태 분산을 EKF 상태 순서로 옮긴 항법 해
+ */
+static bool filter_engine_eskf_get_solution(const FilterEngineState *state, uint32_t timestamp_us,
+                                            EKF_NavSolution *sol) {
+    const ESKF *eskf = &state->eskf;
+    if (!eskf->initialized) {
+        return false;
+    }
+
+    memset(sol, 0, sizeof(*sol));
+    sol->timestamp_us = timestamp_us;
+#if EKF_CONFIG_POSITION
+    sol->pos = eskf->pos;
+#endif
+    sol->vel = eskf->vel;
+    sol->q = eskf->q;
+    sol->gyro_bias = eskf->gyro_bias;
+#if EKF_CONFIG_ACCEL_BIAS
+    sol->accel_bias = eskf->acc_bias;
+#endif
+
+    const float *P = eskf->P.data;
+    for (uint8_t i = 0; i < 3; i++) {
+#if EKF_CONFIG_POSITION
+        sol->p_diag[EKF_STATE_POS_X + i] = P[matsym15_index(ESKF_ERR_POS_X + i, ESKF_ERR_POS_X + i)];
+#endif
+        sol->p_diag[EKF_STATE_VEL_X + i] = P[matsym15_index(ESKF_ERR_VEL_X + i, ESKF_ERR_VEL_X + i)];
+        // δq ≈ (1, δθ/2)
+        sol->p_diag[EKF_STATE_QUAT_X + i] = 0.25f * P[matsym15_index(ESKF_ERR_ATT_X + i, ESKF_ERR_ATT_X + i)];
+        sol->p_diag[EKF_STATE_GYRO_BIAS_X + i] =
+            P[matsym15_index(ESKF_ERR_GYRO_BIAS_X + i, ESKF_ERR_GYRO_BIAS_X + i)];
+#if EKF_CONFIG_ACCEL_BIAS
+        sol->p_diag[EKF_STATE_ACC_BIAS_X + i] = P[matsym15_index(ESKF_ERR_ACC_BIAS_X + i, ESKF_ERR_ACC_BIAS_X + i)];
+#endif
+    }
+
+    // 사원수 블록 = Xi (Pθ / 4) Xi^T (δq = Xi δθ / 2, nav_frames에서 그대로 되돌아감)
+    float Xi[4][3];
+    float XP[4][3];
+    quaternion_error_jacobian(eskf->q, Xi);
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < 3; k++) {
+                sum += Xi[i][k] * P[matsym15_index(ESKF_ERR_ATT_X + k, ESKF_ERR_ATT_X + j)];
+            }
+            XP[i][j] = 0.25f * sum;
+        }
+    }
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = i; j < 4; j++) {
+            sol->p_quat[n++] = XP[i][0] * Xi[j][0] + XP[i][1] * Xi[j][1] + XP[i][2] * Xi[j][2];
+        }
+    }
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * 함수 테이블
+ * ------------------------------------------------------------------------- */
+
+static const FilterEngineOps filter_engine_table[FILTER_ENGINE_COUNT] = {
+    [FILTER_ENGINE_EKF] = {
+        "ekf_seq", filter_engine_ekf_init, filter_engine_ekf_predict, filter_engine_ekf_predict_batch,
+        filter_engine_ekf_update, filter_engine_ekf_get_solution
+    },
+    [FILTER_ENGINE_EKF_BATCH] = {
+        "ekf_batch", filter_engine_ekf_batch_init, filter_engine_ekf_predict, filter_engine_ekf_predict_batch,
+        filter_engine_ekf_update, filter_engine_ekf_get_solution
+    },
+    [FILTER_ENGINE_EKF_UD] = {
+        "ekf_ud", filter_engine_ekf_ud_init, filter_engine_ekf_predict, filter_engine_ekf_predict_batch,
+        filter_engine_ekf_update, filter_engine_ekf_get_solution
+    },
+    [FILTER_ENGINE_ESKF] = {
+        "eskf", filter_engine_eskf_init, filter_engine_eskf_predict, filter_engine_eskf_predict_batch,
+        filter_engine_eskf_update, filter_engine_eskf_get_solution
+    },
+};
+
+/**
+ * @brief 기본 설정
+ */
+bool filter_engine_default_config(FilterEngineConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->pos = vector3f_zero();
+    config->vel = vector3f_zero();
+    config->q = quaternion_identity();
+
+    return true;
+}
+
+/**
+ * @brief 엔진 함수 테이블
+ */
+const FilterEngineOps *filter_engine_get_ops(FilterEngineId id) {
+    if ((unsigned)id >= FILTER_ENGINE_COUNT) {
+        return NULL;
+    }
+
+    return &filter_engine_table[id];
+}
+
+/**
+ * @brief 엔진 선택과 초기화
+ */
+bool filter_engine_select(FilterEngine *engine, FilterEngineId id, const FilterEngineConfig *config) {
+    if (engine == NULL) {
+        return false;
+    }
+
+    engine->ops = NULL;
+    const FilterEngineOps *ops = filter_engine_get_ops(id);
+    if (ops == NULL) {
+        return false;
+    }
+
+    FilterEngineConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        filter_engine_default_config(&cfg);
+    }
+    if (!ops->init(&engine->state, &cfg)) {
+        return false;
+    }
+
+    engine->id = id;
+    engine->ops = ops;
+
+    return true;
+}
+
+/**
+ * @brief 빌드 기본 엔진으로 초기화
+ */
+bool filter_engine_init(FilterEngine *engine, const FilterEngineConfig *config) {
+    return filter_engine_select(engine, FILTER_ENGINE_DEFAULT, config);
+}
+
+/**
+ * @brief IMU 예측
+ */
+bool filter_engine_predict(FilterEngine *engine, Vector3f gyro, Vector3f accel, float dt) {
+    if (engine == NULL || engine->ops == NULL) {
+        return false;
+    }
+
+    return engine->ops->predict(&engine->state, gyro, accel, dt);
+}
+
+/**
+ * @brief 묶음 예측
+ */
+bool filter_engine_predict_batch(FilterEngine *engine, const EKF_ImuSample *samples, uint16_t n) {
+    if (engine == NULL || engine->ops == NULL || samples == NULL) {
+        return false;
+    }
+
+    return engine->ops->predict_batch(&engine->state, samples, n);
+}
+
+/**
+ * @brief 측정 갱신
+ */
+bool filter_engine_update(FilterEngine *engine, const FilterEngineMeasurement *m) {
+    if (engine == NULL || engine->ops == NULL || m == NULL) {
+        return false;
+    }
+
+    return engine->ops->update(&engine->state, m);
+}
+
+/**
+ * @brief 항법 해
+ */
+bool filter_engine_get_solution(const FilterEngine *engine, uint32_t timestamp_us, EKF_NavSolution *sol) {
+    if (engine == NULL || engine->ops == NULL || sol == NULL) {
+        return false;
+    }
+
+    return engine->ops->get_solution(&engine->state, timestamp_us, sol);
+}
+
+/**
+ * @brief 엔진 이름
+ */
+const char *filter_engine_name(const FilterEngine *engine) {
+    if (engine == NULL || engine->ops == NULL) {
+        return "none";
+    }
+
+    return engine->ops->name;
+}
@@ -0,0 +1,290 @@
+/**
+ * @file filter_health.c
+ * @brief EKF 수치 건전성 감시 구현
+ */
+
+#include "nav/filter_health.h"
+#include "math/fast_math.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 상태별 리셋 분산 (상태 목록 X-매크로, 분산 경계의 기준)
+ */
+#define FILTER_HEALTH_P_RESET(name, p_init, p_reset) p_reset,
+static const float filter_health_reset_var[EKF_STATE_DIM] = { EKF_STATE_LIST(FILTER_HEALTH_P_RESET) };
+
+/**
+ * @brief 기본 설정
+ */
+bool filter_health_default_config(FilterHealthConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->rows_per_step = FILTER_HEALTH_DEFAULT_ROWS_PER_STEP;
+    config->min_scale = FILTER_HEALTH_DEFAULT_MIN_SCALE;
+    config->max_scale = FILTER_HEALTH_DEFAULT_MAX_SCALE;
+    config->max_correlation = FILTER_HEALTH_DEFAULT_MAX_CORRELATION;
+    config->quat_norm_tol = FILTER_HEALTH_DEFAULT_QUAT_NORM_TOL;
+    config->max_repairs = FILTER_HEALTH_DEFAULT_MAX_REPAIRS;
+
+    return true;
+}
+
+/**
+ * @brief 감시기 초기화
+ */
+bool filter_health_init(FilterHealth *health, EKF *ekf, const FilterHealthConfig *config) {
+    if (health == NULL || ekf == NULL) {
+        return false;
+    }
+
+    FilterHealthConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        filter_health_default_config(&cfg);
+    }
+    if (cfg.rows_per_step == 0 || cfg.rows_per_step > EKF_STATE_DIM || !(cfg.min_scale > 0.0f) ||
+        !(cfg.max_scale >= 1.0f) || !(cfg.max_correlation > 0.0f) || !(cfg.max_correlation <= 1.0f) ||
+        !(cfg.quat_norm_tol > 0.0f)) {
+        return false;
+    }
+
+    memset(health, 0, sizeof(*health));
+    health->ekf = ekf;
+    health->config = cfg;
+
+    return true;
+}
+
+/**
+ * @brief 스냅숏 복구 콜백 설정
+ */
+bool filter_health_set_fallback(FilterHealth *health, FilterHealthRestoreFn restore, void *context) {
+    if (health == NULL) {
+        return false;
+    }
+
+    health->restore = restore;
+    health->restore_context = context;
+
+    return true;
+}
+
+/**
+ * @brief 빠른 검사: x와 P 대각 합의 유한성
+ */
+static bool filter_health_sentinel(const EKF *ekf) {
+    const float *x = &ekf->x.data[0][0];
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < EKF_STATE_DIM; i++) {
+        sum += x[i] + ekf->P.data[EKF_SYM_FN(index)(i, i)];
+    }
+
+    return isfinite(sum);
+}
+
+/**
+ * @brief 행 점검 결과
+ */
+typedef enum {
+    FILTER_HEALTH_ROW_OK = 0,  /**< 이상 없음 */
+    FILTER_HEALTH_ROW_REPAIR,  /**< 국소 수리 필요 (apply이면 수리함) */
+    FILTER_HEALTH_ROW_FATAL    /**< 수리 불가 */
+} FilterHealthRow;
+
+/**
+ * @brief 행 하나 점검과 국소 수리
+ *
+ * apply가 false이면 읽기만 하므로 지연 전파 중인 P를 반영하지 않고 점검할 수 있다.
+ *
+ * @param health 감시기
+ * @param i 상태 행
+ * @param apply 수리 적용 여부
+ * @return FilterHealthRow 점검 결과
+ */
+static FilterHealthRow filter_health_check_row(FilterHealth *health, uint8_t i, bool apply) {
+    EKF *ekf = health->ekf;
+    float *x = &ekf->x.data[0][0];
+    float *P = ekf->P.data;
+    const FilterHealthConfig *cfg = &health->config;
+    FilterHealthStats *st = &health->stats;
+
+    if (!isfinite(x[i])) {
+        return FILTER_HEALTH_ROW_FATAL;
+    }
+
+    bool repair = false;
+
+    // 사원수 노름 (행 W에서 네 원소를 함께 확인)
+    if (i == EKF_STATE_QUAT_W) {
+        float n2 = x[EKF_STATE_QUAT_W] * x[EKF_STATE_QUAT_W] + x[EKF_STATE_QUAT_X] * x[EKF_STATE_QUAT_X] +
+                   x[EKF_STATE_QUAT_Y] * x[EKF_STATE_QUAT_Y] + x[EKF_STATE_QUAT_Z] * x[EKF_STATE_QUAT_Z];
+        if (!isfinite(n2) || !(n2 > 0.0f)) {
+            return FILTER_HEALTH_ROW_FATAL;
+        }
+        if (fabsf(n2 - 1.0f) > cfg->quat_norm_tol) {
+            repair = true;
+            if (apply) {
+                float k = 1.0f / fast_sqrtf(n2);
+                for (uint8_t j = 0; j < 4; j++) {
+                    x[EKF_STATE_QUAT_W + j] *= k;
+                }
+                st->quat_repairs++;
+            }
+        }
+    }
+
+    // 대각 (분산)
+    const float reset_var = filter_health_reset_var[i];
+    const float lo = cfg->min_scale * reset_var;
+    const float hi = cfg->max_scale * reset_var;
+    const uint16_t kii = EKF_SYM_FN(index)(i, i);
+    float d = P[kii];
+    float row_scale = 1.0f;
+
+    if (!isfinite(d) || !(d > 0.0f)) {
+        // 정보가 없으므로 리셋 분산으로 되돌리고 상관 제거
+        if (apply) {
+            P[kii] = reset_var;
+            for (uint8_t j = 0; j < EKF_STATE_DIM; j++) {
+                if (j != i) {
+                    P[EKF_SYM_FN(index)(i, j)] = 0.0f;
+                }
+            }
+            st->variance_repairs++;
+        }
+        return FILTER_HEALTH_ROW_REPAIR;
+    }
+    if (d < lo) {
+        repair = true;
+        d = lo;
+    } else if (d > hi) {
+        // 상관 계수를 유지하도록 행도 sqrt(hi/d)배
+        repair = true;
+        row_scale = fast_sqrtf(hi / d);
+        d = hi;
+    }
+    if (repair && apply && d != P[kii]) {
+        P[kii] = d;
+        st->variance_repairs++;
+    }
+
+    // 비대각 (공분산): 유한성과 Cauchy-Schwarz 경계
+    for (uint8_t j = 0; j < EKF_STATE_DIM; j++) {
+        if (j == i) {
+            continue;
+        }
+
+        uint16_t kij = EKF_SYM_FN(index)(i, j);
+        float p = P[kij] * row_scale;
+        float djj = P[EKF_SYM_FN(index)(j, j)];
+        float bound = (isfinite(djj) && djj > 0.0f) ? cfg->max_correlation * fast_sqrtf(d * djj) : 0.0f;
+        bool fix = !isfinite(p) || fabsf(p) > bound;
+
+        if (fix) {
+            repair = true;
+            p = isfinite(p) ? ((p > 0.0f) ? bound : -bound) : 0.0f;
+            if (apply) {
+                st->covariance_repairs++;
+            }
+        }
+        if (apply) {
+            P[kij] = p;
+        }
+    }
+
+    return repair ? FILTER_HEALTH_ROW_REPAIR : FILTER_HEALTH_ROW_OK;
+}
+
+/**
+ * @brief 스냅숏 복구, 실패하면 ekf_reset
+ */
+static FilterHealthAction filter_health_fallback(FilterHealth *health, uint32_t now_us) {
+    EKF *ekf = health->ekf;
+    health->cursor = 0;
+    health->sweep_repairs = 0;
+
+    if (health->restore != NULL && health->restore(ekf, now_us, health->restore_context)) {
+        health->stats.restores++;
+        return FILTER_HEALTH_RESTORED;
+    }
+
+    ekf_reset(ekf);
+    health->stats.resets++;
+
+    return FILTER_HEALTH_RESET;
+}
+
+/**
+ * @brief 점검 한 단계
+ */
+FilterHealthAction filter_health_step(FilterHealth *health, uint32_t now_us) {
+    if (health == NULL || !health->ekf->initialized) {
+        return FILTER_HEALTH_OK;
+    }
+
+    EKF *ekf = health->ekf;
+    health->stats.steps++;
+
+    uint8_t rows = health->config.rows_per_step;
+    if (!filter_health_sentinel(ekf)) {
+        health->stats.sentinel_trips++;
+        rows = EKF_STATE_DIM;
+    }
+
+    bool repaired = false;
+    for (uint8_t r = 0; r < rows; r++) {
+        uint8_t i = health->cursor;
+        FilterHealthRow row = filter_health_check_row(health, i, false);
+
+        if (row == FILTER_HEALTH_ROW_REPAIR) {
+            // 지연 전파분을 먼저 반영한 P로 다시 점검하며 수리
+            if (!ekf_flush_covariance(ekf)) {
+                return filter_health_fallback(health, now_us);
+            }
+            row = filter_health_check_row(health, i, true);
+            if (row == FILTER_HEALTH_ROW_REPAIR) {
+                health->stats.last_row = i;
+                repaired = true;
+                if (++health->sweep_repairs > health->config.max_repairs) {
+                    return filter_health_fallback(health, now_us);
+                }
+            }
+        }
+        if (row == FILTER_HEALTH_ROW_FATAL) {
+            return filter_health_fallback(health, now_us);
+        }
+
+        if (++health->cursor >= EKF_STATE_DIM) {
+            health->cursor = 0;
+            health->sweep_repairs = 0;
+            health->stats.sweeps++;
+        }
+    }
+
+    if (!repaired) {
+        return FILTER_HEALTH_OK;
+    }
+
+    // 수리한 P 반영 (U-D 엔진이면 다시 분해, 분해 실패는 수리 실패)
+    if (!ekf_set_engine(ekf, ekf->engine)) {
+        return filter_health_fallback(health, now_us);
+    }
+
+    return FILTER_HEALTH_REPAIRED;
+}
+
+/**
+ * @brief 통계
+ */
+const FilterHealthStats *filter_health_get_stats(const FilterHealth *health) {
+    if (health == NULL) {
+        return NULL;
+    }
+
+    return &health->stats;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file fixed_lag.c
+ * @brief 위치/속도 블록 고정 지연 평활기 구현
+ */
+
+#include "nav/fixed_lag.h"
+#include "math/fast_math.h"
+#include "math/matrix_fixed.h"
+#include <stddef.h>
+#include <string.h>
+
+#define N FIXED_LAG_DIM
+
+/**
+ * @brief 블록 차원에 맞는 LDL^T 분해
+ */
+#if EKF_CONFIG_POSITION
+typedef Mat6x6 FixedLagMatrix;
+#define fixed_lag_ldlt mat6x6_ldlt
+#define fixed_lag_ldlt_solve mat6x6_ldlt_solve
+#else
+typedef Mat3x3 FixedLagMatrix;
+#define fixed_lag_ldlt mat3x3_ldlt
+#define fixed_lag_ldlt_solve mat3x3_ldlt_solve
+#endif
+
+/**
+ * @brief 기본 설정
+ */
+bool fixed_lag_default_config(FixedLagConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->window = FIXED_LAG_DEFAULT_WINDOW;
+    config->interval_us = FIXED_LAG_DEFAULT_INTERVAL_US;
+
+    return true;
+}
+
+/**
+ * @brief 평활기 초기화
+ */
+bool fixed_lag_init(FixedLagSmoother *lag, const FixedLagConfig *config) {
+    if (lag == NULL) {
+        return false;
+    }
+
+    FixedLagConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        fixed_lag_default_config(&cfg);
+    }
+    if (cfg.window == 0 || cfg.window > FIXED_LAG_MAX_WINDOW) {
+        return false;
+    }
+
+    memset(lag, 0, sizeof(*lag));
+    lag->config = cfg;
+    lag->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 창 비우기
+ */
+bool fixed_lag_reset(FixedLagSmoother *lag) {
+    if (lag == NULL || !lag->initialized) {
+        return false;
+    }
+
+    if (lag->count > 0) {
+        lag->stats.resets++;
+    }
+    lag->head = 0;
+    lag->count = 0;
+    lag->pending = false;
+
+    return true;
+}
+
+/**
+ * @brief 필터의 위치/속도 블록 읽기
+ */
+static void fixed_lag_read(const EKF *ekf, float x[N], float P[N][N]) {
+    const float *s = ekf_get_state_data(ekf);
+    for (uint8_t i = 0; i < N; i++) {
+        x[i] = s[i];
+        for (uint8_t j = i; j < N; j++) {
+            P[i][j] = P[j][i] = ekf->P.data[EKF_SYM_FN(index)(i, j)];
+        }
+    }
+}
+
+/**
+ * @brief 보조 측정 갱신 직전
+ */
+bool fixed_lag_begin(FixedLagSmoother *lag, const EKF *ekf, uint32_t t_us) {
+    if (lag == NULL || ekf == NULL || !lag->initialized) {
+        return false;
+    }
+
+    fixed_lag_read(ekf, lag->x_prior, lag->P_prior);
+
+#if EKF_CONFIG_POSITION
+    // C_i <- C_i Phi^T, Phi = [I dt I; 0 I]: 위치 열에 속도 열 x dt를 더함
+    float dt = (float)(int32_t)(t_us - lag->t_us) * 1e-6f;
+    if (dt > 0.0f) {
+        for (uint8_t k = 0; k < lag->count; k++) {
+            FixedLagSlot *slot = &lag->slot[(lag->head + k) % lag->config.window];
+            for (uint8_t r = 0; r < N; r++) {
+                for (uint8_t c = 0; c < 3; c++) {
+                    slot->C[r][c] += slot->C[r][c + 3] * dt;
+                }
+            }
+        }
+    }
+#endif
+    lag->t_us = t_us;
+    lag->pending = true;
+
+    return true;
+}
+
+/**
+ * @brief 슬롯 하나를 갱신 앞뒤 차이로 갱신
+ *
+ * @param slot 슬롯
+ * @param ld 갱신 전 공분산 P-의 LDL^T 분해
+ * @param dx 상태 변화 x+ - x-
+ * @param dP 공분산 감소 P- - P+
+ * @param P_post 갱신 후 공분산 P+
+ */
+static void fixed_lag_update_slot(FixedLagSlot *slot, const FixedLagMatrix *ld, const float dx[N],
+                                  const float dP[N][N], const float P_post[N][N]) {
+    // G = C (P-)^-1: P-가 대칭이므로 G의 각 행은 P- g = C의 행 풀이
+    float G[N][N];
+    for (uint8_t r = 0; r < N; r++) {
+        memcpy(G[r], slot->C[r], sizeof(G[r]));
+        fixed_lag_ldlt_solve(ld, G[r]);
+    }
+
+    float GdP[N][N];
+    for (uint8_t r = 0; r < N; r++) {
+        float sum = 0.0f;
+        for (uint8_t k = 0; k < N; k++) {
+            sum += G[r][k] * dx[k];
+        }
+        slot->x[r] += sum;
+
+        for (uint8_t c = 0; c < N; c++) {
+            float gd = 0.0f;
+            float gp = 0.0f;
+            for (uint8_t k = 0; k < N; k++) {
+                gd += G[r][k] * dP[k][c];
+                gp += G[r][k] * P_post[k][c];
+            }
+            GdP[r][c] = gd;
+            slot->C[r][c] = gp;
+        }
+    }
+
+    // P_i -= G dP G^T (대칭으로 유지)
+    for (uint8_t r = 0; r < N; r++) {
+        for (uint8_t c = r; c < N; c++) {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < N; k++) {
+                sum += GdP[r][k] * G[c][k];
+            }
+            slot->P[r][c] -= sum;
+            slot->P[c][r] = slot->P[r][c];
+        }
+    }
+}
+
+/**
+ * @brief 새 슬롯 넣기 (창이 차면 가장 오래된 슬롯을 뺌)
+ */
+static void fixed_lag_push(FixedLagSmoother *lag, const float x[N], const float P[N][N]) {
+    uint8_t window = lag->config.window;
+    if (lag->count == window) {
+        lag->head = (uint8_t)((lag->head + 1u) % window);
+        lag->count--;
+        lag->stats.retired++;
+    }
+
+    FixedLagSlot *slot = &lag->slot[(lag->head + lag->count) % window];
+    slot->t_us = lag->t_us;
+    memcpy(slot->x, x, sizeof(slot->x));
+    memcpy(slot->P, P, sizeof(slot->P));
+    memcpy(slot->C, P, sizeof(slot->C));
+    for (uint8_t i = 0; i < N; i++) {
+        slot->filter_var[i] = P[i][i];
+    }
+    lag->count++;
+    lag->last_slot_us = lag->t_us;
+    lag->stats.slots++;
+}
+
+/**
+ * @brief 보조 측정 갱신 직후
+ */
+bool fixed_lag_end(FixedLagSmoother *lag, const EKF *ekf) {
+    if (lag == NULL || ekf == NULL || !lag->pending) {
+        return false;
+    }
+    lag->pending = false;
+
+    float x[N];
+    float P[N][N];
+    fixed_lag_read(ekf, x, P);
+    if (memcmp(P, lag->P_prior, sizeof(P)) == 0) {
+        // 위치/속도에 닿은 갱신 없음 (모두 거부 또는 다른 블록만 갱신)
+        return true;
+    }
+
+    if (lag->count > 0) {
+        FixedLagMatrix prior;
+        FixedLagMatrix ld;
+        memcpy(prior.data, lag->P_prior, sizeof(prior.data));
+        if (!fixed_lag_ldlt(&prior, &ld)) {
+            lag->stats.failures++;
+            fixed_lag_reset(lag);
+        } else {
+            float dx[N];
+            float dP[N][N];
+            for (uint8_t i = 0; i < N; i++) {
+                dx[i] = x[i] - lag->x_prior[i];
+                for (uint8_t j = 0; j < N; j++) {
+                    dP[i][j] = lag->P_prior[i][j] - P[i][j];
+                }
+            }
+            for (uint8_t k = 0; k < lag->count; k++) {
+                fixed_lag_update_slot(&lag->slot[(lag->head + k) % lag->config.window], &ld, dx, dP, P);
+            }
+        }
+    }
+    lag->stats.updates++;
+
+    if (lag->count == 0 || (uint32_t)(lag->t_us - lag->last_slot_us) >= lag->config.interval_us) {
+        fixed_lag_push(lag, x, P);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 슬롯을 추정으로 옮김
+ */
+static void fixed_lag_fill(const FixedLagSmoother *lag, const FixedLagSlot *slot, FixedLagEstimate *est) {
+    est->t_us = slot->t_us;
+    est->lag_us = lag->t_us - slot->t_us;
+    for (uint8_t i = 0; i < N; i++) {
+        est->x[i] = slot->x[i];
+        est->std[i] = (slot->P[i][i] > 0.0f) ? fast_sqrtf(slot->P[i][i]) : 0.0f;
+        est->filter_std[i] = (slot->filter_var[i] > 0.0f) ? fast_sqrtf(slot->filter_var[i]) : 0.0f;
+    }
+}
+
+/**
+ * @brief 주어진 시각에 가장 가까운 슬롯의 평활 추정
+ */
+bool fixed_lag_get(const FixedLagSmoother *lag, uint32_t t_us, FixedLagEstimate *est) {
+    if (lag == NULL || est == NULL || lag->count == 0) {
+        return false;
+    }
+
+    const FixedLagSlot *oldest = &lag->slot[lag->head];
+    int32_t before = (int32_t)(oldest->t_us - t_us);
+    if (before > 0 && (uint32_t)before > lag->config.interval_us) {
+        // 이미 창에서 빠진 시각
+        return false;
+    }
+
+    const FixedLagSlot *best = oldest;
+    uint32_t best_gap = UINT32_MAX;
+    for (uint8_t k = 0; k < lag->count; k++) {
+        const FixedLagSlot *slot = &lag->slot[(lag->head + k) % lag->config.window];
+        int32_t d = (int32_t)(slot->t_us - t_us);
+        uint32_t gap = (d < 0) ? (uint32_t)(-d) : (uint32_t)d;
+        if (gap < best_gap) {
+            best_gap = gap;
+            best = slot;
+        }
+    }
+    fixed_lag_fill(lag, best, est);
+
+    return true;
+}
+
+/**
+ * @brief 가장 오래된 슬롯의 평활 추정
+ */
+bool fixed_lag_get_oldest(const FixedLagSmoother *lag, FixedLagEstimate *est) {
+    if (lag == NULL || est == NULL || lag->count == 0) {
+        return false;
+    }
+
+    fixed_lag_fill(lag, &lag->slot[lag->head], est);
+
+    return true;
+}
+
+/**
+ * @brief 통계
+ */
+const FixedLagStats *fixed_lag_get_stats(const FixedLagSmoother *lag) {
+    if (lag == NULL) {
+        return NULL;
+    }
+
+    return &lag->stats;
+}
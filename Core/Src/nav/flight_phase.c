@@ -0,0 +1,189 @@
+/**
+ * @file flight_phase.c
+ * @brief 비행 단계 상태 기계 구현
+ */
+
+#include "nav/flight_phase.h"
+#include <stddef.h>
+
+/**
+ * @brief 단계 전이
+ */
+static void flight_phase_enter(FlightPhaseMachine *fp, FlightPhase phase, uint32_t timestamp_us) {
+    fp->phase = phase;
+    fp->phase_start_us = timestamp_us;
+    fp->pending = false;
+}
+
+/**
+ * @brief 유지 시간 조건 판정
+ *
+ * @return bool 조건이 hold_us 이상 연속으로 충족되었으면 true
+ */
+static bool flight_phase_hold(FlightPhaseMachine *fp, bool condition, uint32_t timestamp_us, uint32_t hold_us) {
+    if (!condition) {
+        fp->pending = false;
+        return false;
+    }
+
+    if (!fp->pending) {
+        fp->pending = true;
+        fp->pending_start_us = timestamp_us;
+    }
+
+    return (uint32_t)(timestamp_us - fp->pending_start_us) >= hold_us;
+}
+
+/**
+ * @brief 기본 전이 조건
+ */
+bool flight_phase_default_config(FlightPhaseConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->launch_accel = FLIGHT_PHASE_DEFAULT_LAUNCH_ACCEL;
+    config->launch_hold_us = FLIGHT_PHASE_DEFAULT_LAUNCH_HOLD_US;
+    config->burnout_accel = FLIGHT_PHASE_DEFAULT_BURNOUT_ACCEL;
+    config->burnout_hold_us = FLIGHT_PHASE_DEFAULT_BURNOUT_HOLD_US;
+    config->apogee_descent = FLIGHT_PHASE_DEFAULT_APOGEE_DESCENT;
+    config->pad_decimation = FLIGHT_PHASE_DEFAULT_PAD_DECIMATION;
+
+    return true;
+}
+
+/**
+ * @brief 상태 기계 초기화
+ */
+bool flight_phase_init(FlightPhaseMachine *fp, const FlightPhaseConfig *config) {
+    if (fp == NULL) {
+        return false;
+    }
+
+    if (config != NULL) {
+        if (config->pad_decimation == 0) {
+            return false;
+        }
+        fp->config = *config;
+    } else {
+        flight_phase_default_config(&fp->config);
+    }
+
+    flight_phase_enter(fp, FLIGHT_PHASE_PAD, 0);
+    fp->pending_start_us = 0;
+    fp->launch_us = 0;
+    fp->burnout_us = 0;
+    fp->apogee_us = 0;
+
+    return true;
+}
+
+/**
+ * @brief 원시 IMU 샘플로 발사/연소 종료 판정
+ */
+bool flight_phase_update_imu(FlightPhaseMachine *fp, uint32_t timestamp_us, Vector3f accel) {
+    if (fp == NULL) {
+        return false;
+    }
+
+    // 제곱 크기로 비교 (sqrt 없음)
+    float a2 = vector3f_magnitude_squared(accel);
+
+    switch (fp->phase) {
+        case FLIGHT_PHASE_PAD: {
+            float th = fp->config.launch_accel;
+            if (flight_phase_hold(fp, a2 >= th * th, timestamp_us, fp->config.launch_hold_us)) {
+                fp->launch_us = fp->pending_start_us;
+                flight_phase_enter(fp, FLIGHT_PHASE_BOOST, timestamp_us);
+                return true;
+            }
+            return false;
+        }
+
+        case FLIGHT_PHASE_BOOST: {
+            float th = fp->config.burnout_accel;
+            if (flight_phase_hold(fp, a2 < th * th, timestamp_us, fp->config.burnout_hold_us)) {
+                fp->burnout_us = fp->pending_start_us;
+                flight_phase_enter(fp, FLIGHT_PHASE_COAST, timestamp_us);
+                return true;
+            }
+            return false;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 항법 해로 정점 판정
+ */
+bool flight_phase_update_nav(FlightPhaseMachine *fp, uint32_t timestamp_us, float vel_up) {
+    if (fp == NULL || fp->phase != FLIGHT_PHASE_COAST) {
+        return false;
+    }
+
+    if (vel_up <= -fp->config.apogee_descent) {
+        fp->apogee_us = timestamp_us;
+        flight_phase_enter(fp, FLIGHT_PHASE_DESCENT, timestamp_us);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 외부 검출 이벤트로 전이
+ */
+bool flight_phase_apply_event(FlightPhaseMachine *fp, const FlightEvent *event) {
+    if (fp == NULL || event == NULL) {
+        return false;
+    }
+
+    switch (event->type) {
+        case FLIGHT_EVENT_LAUNCH:
+            if (fp->phase != FLIGHT_PHASE_PAD) {
+                return false;
+            }
+            fp->launch_us = event->onset_us;
+            flight_phase_enter(fp, FLIGHT_PHASE_BOOST, event->timestamp_us);
+            return true;
+
+        case FLIGHT_EVENT_BURNOUT:
+            if (fp->phase != FLIGHT_PHASE_BOOST) {
+                return false;
+            }
+            fp->burnout_us = event->onset_us;
+            flight_phase_enter(fp, FLIGHT_PHASE_COAST, event->timestamp_us);
+            return true;
+
+        case FLIGHT_EVENT_APOGEE:
+            if (fp->phase != FLIGHT_PHASE_BOOST && fp->phase != FLIGHT_PHASE_COAST) {
+                return false;
+            }
+            fp->apogee_us = event->onset_us;
+            flight_phase_enter(fp, FLIGHT_PHASE_DESCENT, event->timestamp_us);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 현재 단계 조회
+ */
+FlightPhase flight_phase_get(const FlightPhaseMachine *fp) {
+    if (fp == NULL) {
+        return FLIGHT_PHASE_PAD;
+    }
+
+    return fp->phase;
+}
+
+/**
+ * @brief 발사 조건 충족 중 여부
+ */
+bool flight_phase_launch_pending(const FlightPhaseMachine *fp) {
+    return fp != NULL && fp->phase == FLIGHT_PHASE_PAD && fp->pending;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file fusion_monitor.c
+ * @brief 융합 루프 CPU 부하와 IMU 샘플 처리 지연 감시 구현
+ */
+
+#include "nav/fusion_monitor.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 단계 이름 (FlightPhase 순서와 일치)
+ */
+static const char *const fusion_monitor_phase_names[FUSION_MONITOR_PHASE_COUNT] = {
+    "pad",
+    "boost",
+    "coast",
+    "descent"
+};
+
+/**
+ * @brief 지연이 속한 히스토그램 칸
+ */
+static uint8_t fusion_monitor_bin(uint32_t late_us) {
+    uint32_t q = late_us / FUSION_MONITOR_LATE_BASE_US;
+    if (q == 0) {
+        return 0;
+    }
+
+    // q의 최상위 비트 위치 + 1 (q = 1 -> 칸 1)
+    uint32_t bin = 32u - (uint32_t)__builtin_clz(q);
+
+    return (bin < FUSION_MONITOR_LATE_BINS) ? (uint8_t)bin : (uint8_t)(FUSION_MONITOR_LATE_BINS - 1u);
+}
+
+/**
+ * @brief 처리 시간 / 기준 시간 (0.1% 단위, 포화)
+ */
+static uint16_t fusion_monitor_ratio(uint64_t busy_us, uint64_t budget_us) {
+    if (budget_us == 0) {
+        return 0;
+    }
+
+    uint64_t load = (busy_us * 1000u + budget_us / 2u) / budget_us;
+
+    return (load > UINT16_MAX) ? UINT16_MAX : (uint16_t)load;
+}
+
+/**
+ * @brief 감시기 초기화
+ */
+bool fusion_monitor_init(FusionMonitor *mon, uint32_t imu_period_us, uint32_t deadline_us) {
+    if (mon == NULL || imu_period_us == 0) {
+        return false;
+    }
+
+    mon->imu_period_us = imu_period_us;
+    mon->deadline_us = (deadline_us != 0) ? deadline_us : imu_period_us * FUSION_MONITOR_DEFAULT_DEADLINE_PERIODS;
+    fusion_monitor_reset(mon);
+
+    return true;
+}
+
+/**
+ * @brief 통계 초기화
+ */
+void fusion_monitor_reset(FusionMonitor *mon) {
+    if (mon == NULL) {
+        return;
+    }
+
+    mon->phase = FLIGHT_PHASE_PAD;
+    mon->last_load = 0;
+    memset(mon->stats, 0, sizeof(mon->stats));
+}
+
+/**
+ * @brief IMU 샘플 하나의 처리 지연 기록
+ */
+void fusion_monitor_record_sample(FusionMonitor *mon, FlightPhase phase, uint32_t late_us) {
+    if (mon == NULL || (uint32_t)phase >= FUSION_MONITOR_PHASE_COUNT) {
+        return;
+    }
+
+    // 샘플 시각이 시간 콜백보다 앞서 보이면(다른 시간축의 흔들림) 지연 0으로 봄
+    if ((int32_t)late_us < 0) {
+        late_us = 0;
+    }
+
+    FusionMonitorPhaseStats *st = &mon->stats[phase];
+    st->late_hist[fusion_monitor_bin(late_us)]++;
+    if (late_us > st->max_late_us) {
+        st->max_late_us = late_us;
+    }
+    if (late_us > mon->deadline_us) {
+        st->misses++;
+    }
+    mon->phase = phase;
+}
+
+/**
+ * @brief 사이클 처리 시간 기록
+ */
+void fusion_monitor_record_cycle(FusionMonitor *mon, FlightPhase phase, uint32_t busy_us, uint32_t samples) {
+    if (mon == NULL || (uint32_t)phase >= FUSION_MONITOR_PHASE_COUNT || samples == 0) {
+        return;
+    }
+
+    FusionMonitorPhaseStats *st = &mon->stats[phase];
+    uint16_t load = fusion_monitor_ratio(busy_us, (uint64_t)samples * mon->imu_period_us);
+
+    st->cycles++;
+    st->samples += samples;
+    st->busy_us += busy_us;
+    if (busy_us > st->max_busy_us) {
+        st->max_busy_us = busy_us;
+    }
+    if (load > st->peak_load) {
+        st->peak_load = load;
+    }
+    if (load > 1000u) {
+        st->overloads++;
+    }
+    mon->last_load = load;
+    mon->phase = phase;
+}
+
+/**
+ * @brief 단계별 통계 조회
+ */
+const FusionMonitorPhaseStats *fusion_monitor_get_stats(const FusionMonitor *mon, FlightPhase phase) {
+    if (mon == NULL || (uint32_t)phase >= FUSION_MONITOR_PHASE_COUNT) {
+        return NULL;
+    }
+
+    return &mon->stats[phase];
+}
+
+/**
+ * @brief 단계 평균 부하율
+ */
+uint16_t fusion_monitor_mean_load(const FusionMonitor *mon, FlightPhase phase) {
+    const FusionMonitorPhaseStats *st = fusion_monitor_get_stats(mon, phase);
+    if (st == NULL) {
+        return 0;
+    }
+
+    return fusion_monitor_ratio(st->busy_us, (uint64_t)st->samples * mon->imu_period_us);
+}
+
+/**
+ * @brief 지연 분위수가 속한 히스토그램 칸
+ */
+uint8_t fusion_monitor_late_quantile_bin(const FusionMonitor *mon, FlightPhase phase, uint16_t permille) {
+    const FusionMonitorPhaseStats *st = fusion_monitor_get_stats(mon, phase);
+    if (st == NULL) {
+        return 0;
+    }
+
+    uint64_t total = 0;
+    for (uint8_t k = 0; k < FUSION_MONITOR_LATE_BINS; k++) {
+        total += st->late_hist[k];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // 누적 개수가 total x permille / 1000 이상이 되는 첫 칸
+    uint64_t target = (total * (permille > 1000u ? 1000u : permille) + 999u) / 1000u;
+    uint64_t sum = 0;
+    for (uint8_t k = 0; k < FUSION_MONITOR_LATE_BINS; k++) {
+        sum += st->late_hist[k];
+        if (sum >= target && sum > 0) {
+            return k;
+        }
+    }
+
+    return (uint8_t)(FUSION_MONITOR_LATE_BINS - 1u);
+}
+
+/**
+ * @brief 히스토그램 칸의 상한
+ */
+uint32_t fusion_monitor_bin_upper_us(uint8_t bin) {
+    if (bin >= FUSION_MONITOR_LATE_BINS - 1u) {
+        return UINT32_MAX;
+    }
+
+    return FUSION_MONITOR_LATE_BASE_US << bin;
+}
+
+/**
+ * @brief 단계별 부하/지연 통계를 한 줄씩 출력
+ */
+void fusion_monitor_report(const FusionMonitor *mon, ProfileWriteFn write) {
+    if (mon == NULL || write == NULL) {
+        return;
+    }
+
+    char line[128];
+    for (uint8_t i = 0; i < FUSION_MONITOR_PHASE_COUNT; i++) {
+        const FusionMonitorPhaseStats *st = &mon->stats[i];
+        if (st->cycles == 0) {
+            continue;
+        }
+
+        uint16_t mean = fusion_monitor_mean_load(mon, (FlightPhase)i);
+        uint32_t p99 = fusion_monitor_bin_upper_us(fusion_monitor_late_quantile_bin(mon, (FlightPhase)i, 990u));
+        snprintf(line, sizeof(line),
+                 "load %-8s cycles=%lu samples=%lu mean=%u.%u%% peak=%u.%u%% over=%lu busy_max=%lu us\r\n",
+                 fusion_monitor_phase_names[i], (unsigned long)st->cycles, (unsigned long)st->samples,
+                 (unsigned)(mean / 10u), (unsigned)(mean % 10u), (unsigned)(st->peak_load / 10u),
+                 (unsigned)(st->peak_load % 10u), (unsigned long)st->overloads, (unsigned long)st->max_busy_us);
+        write(line);
+
+        if (p99 == UINT32_MAX) {
+            snprintf(line, sizeof(line), "late %-8s misses=%lu max=%lu us p99>=%lu us\r\n",
+                     fusion_monitor_phase_names[i], (unsigned long)st->misses, (unsigned long)st->max_late_us,
+                     (unsigned long)fusion_monitor_bin_upper_us(FUSION_MONITOR_LATE_BINS - 2u));
+        } else {
+            snprintf(line, sizeof(line), "late %-8s misses=%lu max=%lu us p99<%lu us\r\n",
+                     fusion_monitor_phase_names[i], (unsigned long)st->misses, (unsigned long)st->max_late_us,
+                     (unsigned long)p99);
+        }
+        write(line);
+
+        // 히스토그램 (칸 상한 순)
+        int n = snprintf(line, sizeof(line), "hist %-8s", fusion_monitor_phase_names[i]);
+        for (uint8_t k = 0; k < FUSION_MONITOR_LATE_BINS && n > 0 && (size_t)n < sizeof(line); k++) {
+            n += snprintf(line + n, sizeof(line) - (size_t)n, " %lu", (unsigned long)st->late_hist[k]);
+        }
+        if (n > 0 && (size_t)n < sizeof(line) - 2u) {
+            line[n++] = '\r';
+            line[n++] = '\n';
+            line[n] = '\0';
+        }
+        write(line);
+    }
+    snprintf(line, sizeof(line), "load period=%lu us deadline=%lu us last=%u.%u%%\r\n",
+             (unsigned long)mon->imu_period_us, (unsigned long)mon->deadline_us,
+             (unsigned)(mon->last_load / 10u), (unsigned)(mon->last_load % 10u));
+    write(line);
+}
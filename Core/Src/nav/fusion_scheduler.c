@@ -0,0 +1,1242 @@
+/**
+ * @file fusion_scheduler.c
+ * @brief 이벤트 기반 다중 속도 센서 융합 스케줄러 구현
+ */
+
+#include "nav/fusion_scheduler.h"
+#include "sys/trace.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 타임스탬프 순환에 안전한 비교 (a가 b보다 나중이면 true)
+ */
+static bool fusion_time_after(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+/**
+ * @brief 측정을 시각 순으로 대기열에 삽입
+ */
+static bool fusion_queue_insert(FusionScheduler *sched, const FusionMeasurement *m) {
+    if (sched->queue_count >= FUSION_QUEUE_SIZE) {
+        sched->stats.dropped++;
+        return false;
+    }
+
+    // 뒤에서부터 자리 찾기 (대부분 시각 순으로 도착하므로 짧음)
+    uint8_t pos = sched->queue_count;
+    while (pos > 0 && fusion_time_after(sched->queue[pos - 1].timestamp_us, m->timestamp_us)) {
+        sched->queue[pos] = sched->queue[pos - 1];
+        pos--;
+    }
+
+    sched->queue[pos] = *m;
+    sched->queue_count++;
+
+    return true;
+}
+
+/**
+ * @brief 대기열에서 i번째 측정 제거
+ */
+static void fusion_queue_remove(FusionScheduler *sched, uint8_t i) {
+    memmove(&sched->queue[i], &sched->queue[i + 1],
+            (size_t)(sched->queue_count - i - 1) * sizeof(FusionMeasurement));
+    sched->queue_count--;
+}
+
+/**
+ * @brief 사이클 예산 초과 여부
+ */
+static bool fusion_over_budget(const FusionScheduler *sched, uint32_t start_us) {
+    return (uint32_t)(sched->clock() - start_us) > sched->budget_us;
+}
+
+/**
+ * @brief 처리 시간 측정으로 비용 추정 갱신 (지수 평균)
+ */
+static void fusion_learn_cost(float *cost_us, uint32_t elapsed_us) {
+    *cost_us += FUSION_COST_ALPHA * ((float)elapsed_us - *cost_us);
+}
+
+/**
+ * @brief i번째 측정을 지금 처리할 예산이 있는지 확인
+ *
+ * 남은 예산이 이 갱신 비용 + 남은 IMU 샘플 예측 비용(지금 샘플 포함) + 뒤에 이미 도달한
+ * 더 높은 우선순위 측정 비용 이상이어야 한다.
+ */
+static bool fusion_budget_allows(const FusionScheduler *sched, uint8_t i, uint32_t filter_us, uint32_t start_us) {
+    const FusionUpdateBudget *u = &sched->update[sched->queue[i].type];
+    if (u->priority == FUSION_PRIORITY_ALWAYS) {
+        return true;
+    }
+
+    float need = u->cost_us + (float)(imu_ring_count(sched->imu) + 1u) * sched->predict_cost_us;
+    for (uint8_t j = i + 1; j < sched->queue_count; j++) {
+        const FusionMeasurement *n = &sched->queue[j];
+        if (fusion_time_after(n->timestamp_us, filter_us)) {
+            break;
+        }
+        if (sched->update[n->type].priority > u->priority) {
+            need += sched->update[n->type].cost_us;
+        }
+    }
+
+    uint32_t elapsed_us = sched->clock() - start_us;
+    return (float)elapsed_us + need <= (float)sched->budget_us;
+}
+
+/**
+ * @brief 감시기 기록용 현재 비행 단계 (상태 기계가 없으면 발사대 단계)
+ */
+static FlightPhase fusion_current_phase(const FusionScheduler *sched) {
+    return (sched->phase != NULL) ? flight_phase_get(sched->phase) : FLIGHT_PHASE_PAD;
+}
+
+/**
+ * @brief 비행 단계가 바뀌었으면 EKF 정상 상태 게인 기록 초기화 (전체 계산 재개)
+ */
+static void fusion_track_phase(FusionScheduler *sched) {
+    FlightPhase phase = fusion_current_phase(sched);
+    if (phase != sched->last_phase) {
+        sched->last_phase = phase;
+        ekf_steady_gain_reset(sched->ekf);
+    }
+}
+
+/**
+ * @brief 발사대 단계(감소 주기) 여부
+ */
+static bool fusion_on_pad(const FusionScheduler *sched) {
+    return sched->phase != NULL && flight_phase_get(sched->phase) == FLIGHT_PHASE_PAD;
+}
+
+/**
+ * @brief 보조 측정 하나를 측정 시각에 융합
+ */
+static bool fusion_apply(FusionScheduler *sched, const FusionMeasurement *m) {
+    if (m->type == FUSION_MEAS_BARO) {
+        ekf_set_baro_noise_scale(sched->ekf, m->data.baro.noise_scale);
+    } else if (m->type == FUSION_MEAS_MAG) {
+        ekf_set_mag_noise_scale(sched->ekf, m->data.mag.noise_scale);
+    } else if (m->type == FUSION_MEAS_GPS) {
+        ekf_set_gps_accuracy(sched->ekf, &m->data.gps.acc);
+    }
+
+    if (fusion_on_pad(sched)) {
+        // 정지 상태: 상태 이력 없이 현재 상태에 갱신
+        switch (m->type) {
+            case FUSION_MEAS_GPS:
+                return ekf_update_gps_partial(sched->ekf, m->data.gps.pos, m->data.gps.vel,
+                                              m->data.gps.components);
+            case FUSION_MEAS_BARO:
+                return ekf_update_baro(sched->ekf, m->data.baro.alt);
+            case FUSION_MEAS_MAG:
+                return ekf_update_mag(sched->ekf, m->data.mag.field);
+            case FUSION_MEAS_HEADING:
+                return ekf_update_gnss_heading(sched->ekf, &m->data.heading);
+            default:
+                return false;
+        }
+    }
+
+    switch (m->type) {
+        case FUSION_MEAS_GPS:
+            return ekf_delay_update_gps_partial(sched->ekf, sched->history, m->timestamp_us,
+                                                m->data.gps.pos, m->data.gps.vel,
+                                                m->data.gps.components);
+        case FUSION_MEAS_BARO:
+            return ekf_delay_update_baro(sched->ekf, sched->history, m->timestamp_us, m->data.baro.alt);
+        case FUSION_MEAS_MAG:
+            return ekf_delay_update_mag(sched->ekf, sched->history, m->timestamp_us, m->data.mag.field);
+        case FUSION_MEAS_HEADING:
+            return ekf_delay_update_gnss_heading(sched->ekf, sched->history, m->timestamp_us, &m->data.heading);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 대기열의 GNSS와 기압계 측정 둘을 한 번에 융합
+ *
+ * @param sched 스케줄러 포인터
+ * @param first 앞선 측정 (GNSS 또는 기압계)
+ * @param second 뒤의 측정 (다른 종류)
+ */
+static void fusion_apply_coincident(FusionScheduler *sched, const FusionMeasurement *first,
+                                    const FusionMeasurement *second) {
+    const FusionMeasurement *gps = (first->type == FUSION_MEAS_GPS) ? first : second;
+    const FusionMeasurement *baro = (first->type == FUSION_MEAS_BARO) ? first : second;
+
+    EKF_CoincidentMeasurement c;
+    memset(&c, 0, sizeof(c));
+    c.has_gps = true;
+    c.gps_pos = gps->data.gps.pos;
+    c.gps_use_vel = (gps->data.gps.components & EKF_GPS_USE_VEL) != 0;
+    c.gps_vel = gps->data.gps.vel;
+    c.has_baro = true;
+    c.baro_alt = baro->data.baro.alt;
+    ekf_set_baro_noise_scale(sched->ekf, baro->data.baro.noise_scale);
+    ekf_set_gps_accuracy(sched->ekf, &gps->data.gps.acc);
+
+    if (fusion_on_pad(sched)) {
+        ekf_update_coincident(sched->ekf, &c);
+    } else {
+        ekf_delay_update_coincident(sched->ekf, sched->history, first->timestamp_us, &c);
+    }
+
+    sched->stats.updates += (uint32_t)c.gps_accepted + (uint32_t)c.baro_accepted;
+    sched->stats.update_failures += (uint32_t)!c.gps_accepted + (uint32_t)!c.baro_accepted;
+}
+
+/**
+ * @brief 다음 측정과 묶을 수 있는지 확인 (GNSS와 기압계, 시각 차가 창 이내)
+ */
+static bool fusion_can_coalesce(const FusionScheduler *sched, uint8_t i, uint32_t filter_us) {
+    if (i + 1 >= sched->queue_count || !ekf_can_coalesce(sched->ekf)) {
+        return false;
+    }
+
+    const FusionMeasurement *a = &sched->queue[i];
+    const FusionMeasurement *b = &sched->queue[i + 1];
+    bool pair = (a->type == FUSION_MEAS_GPS && b->type == FUSION_MEAS_BARO) ||
+                (a->type == FUSION_MEAS_BARO && b->type == FUSION_MEAS_GPS);
+    if (!pair) {
+        return false;
+    }
+
+    // 묶음 갱신은 3축 위치(와 속도)만 지원
+    const FusionMeasurement *gps = (a->type == FUSION_MEAS_GPS) ? a : b;
+    uint8_t components = gps->data.gps.components;
+    if ((components & (EKF_GPS_USE_POS | EKF_GPS_NO_VERTICAL)) != EKF_GPS_USE_POS) {
+        return false;
+    }
+
+    return !fusion_time_after(b->timestamp_us, filter_us) &&
+           (uint32_t)(b->timestamp_us - a->timestamp_us) <= FUSION_COALESCE_WINDOW_US;
+}
+
+/**
+ * @brief 적응 예측 주기 누적분 예측 (필터 시각을 마지막 IMU 시각으로 맞춤)
+ */
+static void fusion_predict_rate_flush(FusionScheduler *sched) {
+    EKF_ImuSample imu;
+    uint32_t timestamp_us;
+    if (predict_rate_flush(sched->predict_rate, sched->ekf, &imu, &timestamp_us) &&
+        ekf_delay_predict(sched->ekf, sched->history, &imu, timestamp_us)) {
+        sched->stats.predicts++;
+    }
+}
+
+/**
+ * @brief 따라잡기 누적분 예측 (필터 시각을 마지막 IMU 시각으로 맞춤)
+ */
+static void fusion_catch_up_flush(FusionScheduler *sched) {
+    if (sched->catch_up.count == 0) {
+        return;
+    }
+
+    EKF_ImuSample imu;
+    if (ekf_preint_extract(&sched->catch_up, &imu) &&
+        ekf_delay_predict(sched->ekf, sched->history, &imu, sched->catch_up_last_us)) {
+        sched->stats.predicts++;
+    }
+    ekf_preint_set_gyro_bias(&sched->catch_up, ekf_get_gyro_bias(sched->ekf));
+}
+
+/**
+ * @brief 갱신한 측정의 NIS를 적응 예측 주기 제어기에 알림
+ */
+static void fusion_predict_rate_note(FusionScheduler *sched, const FusionMeasurement *m) {
+    if (sched->predict_rate == NULL) {
+        return;
+    }
+
+    switch (m->type) {
+        case FUSION_MEAS_GPS:
+            if (m->data.gps.components & EKF_GPS_USE_VEL) {
+                predict_rate_note_innovation(sched->predict_rate,
+                                             ekf_get_innovation_nis(sched->ekf, EKF_SENSOR_GPS_POS_VEL), 6);
+            } else {
+                predict_rate_note_innovation(sched->predict_rate,
+                                             ekf_get_innovation_nis(sched->ekf, EKF_SENSOR_GPS_POS), 3);
+            }
+            break;
+        case FUSION_MEAS_BARO:
+            predict_rate_note_innovation(sched->predict_rate,
+                                         ekf_get_innovation_nis(sched->ekf, EKF_SENSOR_BARO), 1);
+            break;
+        case FUSION_MEAS_MAG:
+            predict_rate_note_innovation(sched->predict_rate,
+                                         ekf_get_innovation_nis(sched->ekf, EKF_SENSOR_MAG), 3);
+            break;
+        case FUSION_MEAS_HEADING:
+            predict_rate_note_innovation(sched->predict_rate,
+                                         ekf_get_innovation_nis(sched->ekf, EKF_SENSOR_GNSS_HEADING), 1);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 필터 시각까지 도달한 보조 측정 처리
+ *
+ * @param sched 스케줄러 포인터
+ * @param filter_us 필터 시각 (마지막 예측 시각, us)
+ * @param start_us 사이클 시작 시각 (us)
+ */
+static void fusion_process_due(FusionScheduler *sched, uint32_t filter_us, uint32_t start_us) {
+    // 발사대 단계: 도달한 측정을 정보 형식으로 누적해 한 번에 반영
+    bool info = sched->info_batch && sched->queue_count > 0 &&
+                !fusion_time_after(sched->queue[0].timestamp_us, filter_us) &&
+                fusion_on_pad(sched) && ekf_info_begin(sched->ekf);
+
+    // 적응 예측 주기: 도달한 측정이 있으면 누적분을 먼저 예측
+    if (sched->predict_rate != NULL && predict_rate_pending(sched->predict_rate) > 0 &&
+        sched->queue_count > 0 && !fusion_time_after(sched->queue[0].timestamp_us, filter_us)) {
+        fusion_predict_rate_flush(sched);
+    }
+
+    // 따라잡기: 도달한 측정이 있으면 누적분을 먼저 예측
+    if (sched->catch_up.count > 0 && sched->queue_count > 0 &&
+        !fusion_time_after(sched->queue[0].timestamp_us, filter_us)) {
+        fusion_catch_up_flush(sched);
+    }
+
+    // 고정 지연 평활: 비행 중 도달한 측정이 있으면 갱신 전 위치/속도 기록
+    bool smooth = false;
+    if (sched->smoother != NULL) {
+        if (fusion_on_pad(sched)) {
+            fixed_lag_reset(sched->smoother);
+        } else if (sched->queue_count > 0 && !fusion_time_after(sched->queue[0].timestamp_us, filter_us)) {
+            smooth = fixed_lag_begin(sched->smoother, sched->ekf, filter_us);
+        }
+    }
+
+    uint8_t i = 0;
+    while (i < sched->queue_count) {
+        const FusionMeasurement *m = &sched->queue[i];
+
+        // 대기열은 시각 순이므로 이후 측정은 모두 미래
+        if (fusion_time_after(m->timestamp_us, filter_us)) {
+            break;
+        }
+
+        if (!fusion_budget_allows(sched, i, filter_us, start_us)) {
+            FusionUpdateBudget *u = &sched->update[m->type];
+            if (u->max_age_us != 0 && (uint32_t)(filter_us - m->timestamp_us) > u->max_age_us) {
+                // 너무 오래된 측정은 버림
+                fusion_queue_remove(sched, i);
+                u->dropped++;
+                sched->stats.dropped++;
+            } else {
+                // 다음 사이클로 미룸
+                i++;
+            }
+            continue;
+        }
+
+        // 수직 채널 필터는 기압 측정을 모두 받음 (EKF 천음속 생략/게이트와 무관)
+        if (m->type == FUSION_MEAS_BARO && sched->vertical != NULL) {
+            vertical_filter_update_baro(sched->vertical, m->data.baro.alt);
+        }
+
+        if (fusion_can_coalesce(sched, i, filter_us)) {
+            const FusionMeasurement *next = &sched->queue[i + 1];
+            if (next->type == FUSION_MEAS_BARO && sched->vertical != NULL) {
+                vertical_filter_update_baro(sched->vertical, next->data.baro.alt);
+            }
+
+            // 묶음 비용은 GNSS 갱신 비용으로 학습 (묶음 갱신이 GNSS 단독보다 크게 비싸지 않음)
+            uint32_t t0 = sched->clock();
+            if (sched->latency != NULL) {
+                latency_monitor_record(sched->latency, (LatencySource)(LATENCY_SOURCE_GPS + m->type), m->timestamp_us, t0);
+                latency_monitor_record(sched->latency, (LatencySource)(LATENCY_SOURCE_GPS + next->type), next->timestamp_us, t0);
+            }
+            TRACE_BEGIN(TRACE_EVENT_UPDATE_COINCIDENT);
+            fusion_apply_coincident(sched, m, next);
+            TRACE_END(TRACE_EVENT_UPDATE_COINCIDENT);
+            fusion_learn_cost(&sched->update[FUSION_MEAS_GPS].cost_us, sched->clock() - t0);
+            fusion_predict_rate_note(sched, m);
+            fusion_predict_rate_note(sched, next);
+            fusion_queue_remove(sched, i + 1);
+            fusion_queue_remove(sched, i);
+            continue;
+        }
+
+        uint32_t t0 = sched->clock();
+        if (sched->latency != NULL) {
+            latency_monitor_record(sched->latency, (LatencySource)(LATENCY_SOURCE_GPS + m->type), m->timestamp_us, t0);
+        }
+        TRACE_BEGIN(TRACE_EVENT_UPDATE_GPS + m->type);
+        if (fusion_apply(sched, m)) {
+            sched->stats.updates++;
+            fusion_predict_rate_note(sched, m);
+        } else {
+            sched->stats.update_failures++;
+        }
+        TRACE_END(TRACE_EVENT_UPDATE_GPS + m->type);
+        fusion_learn_cost(&sched->update[m->type].cost_us, sched->clock() - t0);
+        fusion_queue_remove(sched, i);
+    }
+
+    if (info && !ekf_info_apply(sched->ekf)) {
+        sched->stats.update_failures++;
+    }
+    if (smooth) {
+        fixed_lag_end(sched->smoother, sched->ekf);
+    }
+}
+
+/**
+ * @brief 발사대 단계 누적분으로 감소 주기 예측 (정지 판정 시 영속도 갱신)
+ */
+static void fusion_pad_flush(FusionScheduler *sched) {
+    if (sched->pad_count == 0) {
+        return;
+    }
+
+    float inv_dt = 1.0f / sched->pad_dt;
+    Vector3f gyro = vector3f_scale(sched->pad_gyro_dt, inv_dt);
+
+    if (sched->static_detector == NULL) {
+        if (ekf_predict_attitude(sched->ekf, gyro, sched->pad_dt)) {
+            sched->stats.predicts++;
+        }
+    } else {
+        // 가속도 잔차로 생기는 속도/위치 드리프트를 영속도 갱신이 잡도록 전체 예측
+        Vector3f accel = vector3f_scale(sched->pad_accel_dt, inv_dt);
+        if (ekf_predict(sched->ekf, gyro, accel, sched->pad_dt)) {
+            sched->stats.predicts++;
+        }
+
+        if (static_detector_is_static(sched->static_detector) &&
+            !flight_phase_launch_pending(sched->phase)) {
+            if (ekf_update_zupt(sched->ekf)) {
+                sched->stats.updates++;
+            } else {
+                sched->stats.update_failures++;
+            }
+        }
+    }
+
+    sched->pad_gyro_dt = vector3f_zero();
+    sched->pad_accel_dt = vector3f_zero();
+    sched->pad_dt = 0.0f;
+    sched->pad_count = 0;
+}
+
+/**
+ * @brief 정지 창이 끝날 때 평균 자이로로 바이어스 갱신
+ */
+static void fusion_pad_zero_rate(FusionScheduler *sched) {
+    const StaticDetector *det = sched->static_detector;
+    if (!static_detector_is_static(det) || flight_phase_launch_pending(sched->phase)) {
+        return;
+    }
+
+    // 창 평균의 축별 표준 편차 (분산은 세 축 합)
+    float var = det->gyro_var / (3.0f * (float)det->window);
+    float std = sqrtf(var > FUSION_ZARU_MIN_VAR ? var : FUSION_ZARU_MIN_VAR);
+    Vector3f gyro_mean;
+    static_detector_get_gyro_mean(det, &gyro_mean);
+
+    if (ekf_update_zero_rate(sched->ekf, gyro_mean, std)) {
+        sched->stats.updates++;
+    } else {
+        sched->stats.update_failures++;
+    }
+}
+
+/**
+ * @brief 발사대 단계 샘플 누적 (분주비마다 자세 전용 예측)
+ */
+static void fusion_pad_accumulate(FusionScheduler *sched, const EKF_ImuSample *imu) {
+    sched->pad_gyro_dt = vector3f_add(sched->pad_gyro_dt, vector3f_scale(imu->gyro, imu->dt));
+    sched->pad_accel_dt = vector3f_add(sched->pad_accel_dt, vector3f_scale(imu->accel, imu->dt));
+    sched->pad_dt += imu->dt;
+    sched->pad_count++;
+
+    if (sched->pad_count >= sched->phase->config.pad_decimation) {
+        fusion_pad_flush(sched);
+    }
+}
+
+/**
+ * @brief 전체 주기 예측 (상태 이력 기록)
+ */
+static void fusion_predict_full(FusionScheduler *sched, const EKF_ImuSample *imu, uint32_t timestamp_us) {
+    if (sched->predict_rate != NULL) {
+        // 사전 적분은 샘플마다, 공분산 전파는 제어기가 정한 간격마다
+        EKF_ImuSample out;
+        if (predict_rate_add(sched->predict_rate, imu, timestamp_us, sched->ekf, &out) &&
+            ekf_delay_predict(sched->ekf, sched->history, &out, timestamp_us)) {
+            sched->stats.predicts++;
+        }
+        return;
+    }
+
+    if (sched->catching_up) {
+        // 적체 구간은 사전 적분으로 묶어 예측 횟수를 줄임
+        if (ekf_preint_add(&sched->catch_up, imu->gyro, imu->accel, imu->dt)) {
+            sched->catch_up_last_us = timestamp_us;
+            sched->stats.catch_up_samples++;
+            if (sched->catch_up.count >= FUSION_CATCH_UP_MAX_SAMPLES) {
+                fusion_catch_up_flush(sched);
+            }
+        }
+        return;
+    }
+
+    if (ekf_delay_predict(sched->ekf, sched->history, imu, timestamp_us)) {
+        sched->stats.predicts++;
+    }
+}
+
+/**
+ * @brief IMU 샘플 하나 처리 (비행 단계에 따라 예측 방식 선택)
+ */
+static void fusion_step_imu(FusionScheduler *sched, const EKF_ImuSample *imu, uint32_t timestamp_us) {
+    if (sched->phase == NULL) {
+        fusion_predict_full(sched, imu, timestamp_us);
+        return;
+    }
+
+    FlightPhase before = flight_phase_get(sched->phase);
+
+    if (sched->events != NULL) {
+        // 입력 단계에서 이미 검출된 이벤트를 샘플 시각 순서에 맞춰 반영
+        FlightEvent ev;
+        while (event_detector_poll(sched->events, timestamp_us, &ev)) {
+            flight_phase_apply_event(sched->phase, &ev);
+        }
+    } else {
+        flight_phase_update_imu(sched->phase, timestamp_us, imu->accel);
+    }
+
+    if (flight_phase_get(sched->phase) == FLIGHT_PHASE_PAD) {
+        // 정지 판정은 보류 여부와 관계없이 도착 순으로 누적
+        if (static_detector_add_sample(sched->static_detector, imu->accel, imu->gyro)) {
+            fusion_pad_zero_rate(sched);
+        }
+
+        if (flight_phase_launch_pending(sched->phase)) {
+            // 발사 확정 전까지 보류 (넘치면 자세 전용 예측)
+            if (sched->launch_pending_count < FUSION_LAUNCH_PENDING_SIZE) {
+                FusionPendingImu *p = &sched->launch_pending[sched->launch_pending_count++];
+                p->timestamp_us = timestamp_us;
+                p->imu = *imu;
+                return;
+            }
+        } else {
+            // 오검출: 보류 샘플은 정지 구간으로 처리
+            for (uint8_t i = 0; i < sched->launch_pending_count; i++) {
+                fusion_pad_accumulate(sched, &sched->launch_pending[i].imu);
+            }
+            sched->launch_pending_count = 0;
+        }
+        fusion_pad_accumulate(sched, imu);
+        return;
+    }
+
+    if (before == FLIGHT_PHASE_PAD) {
+        // 발사 확정: 정지 구간 마무리 후 보류 샘플을 전체 예측으로 처리
+        fusion_pad_flush(sched);
+        ekf_delay_clear(sched->ekf, sched->history);
+        for (uint8_t i = 0; i < sched->launch_pending_count; i++) {
+            fusion_predict_full(sched, &sched->launch_pending[i].imu, sched->launch_pending[i].timestamp_us);
+        }
+        sched->launch_pending_count = 0;
+    }
+
+    fusion_predict_full(sched, imu, timestamp_us);
+
+    // 관성 비행 중 비력은 항력뿐이므로 정점 예측용 항력 계수를 추정
+    if (flight_phase_get(sched->phase) == FLIGHT_PHASE_COAST) {
+        ekf_estimate_drag(sched->ekf, imu->accel);
+    }
+}
+
+/**
+ * @brief 스케줄러 초기화
+ */
+bool fusion_scheduler_init(FusionScheduler *sched, EKF *ekf, EKF_DelayBuffer *history,
+                           ImuRing *imu, FusionClockFn clock, uint32_t budget_us) {
+    if (sched == NULL || ekf == NULL || history == NULL || imu == NULL || clock == NULL) {
+        return false;
+    }
+
+    sched->ekf = ekf;
+    sched->history = history;
+    sched->imu = imu;
+    sched->publisher = NULL;
+    sched->mag_cal = NULL;
+    sched->mag_average = NULL;
+    sched->phase = NULL;
+    sched->static_detector = NULL;
+    sched->events = NULL;
+    sched->monitor = NULL;
+    sched->latency = NULL;
+    sched->accel_blend = NULL;
+    sched->vibration = NULL;
+    sched->spectrum = NULL;
+    sched->lever_arm = NULL;
+    sched->health = NULL;
+    sched->convergence = NULL;
+    sched->vertical = NULL;
+    sched->predict_rate = NULL;
+    sched->smoother = NULL;
+    sched->info_batch = false;
+    sched->clock = clock;
+    sched->budget_us = budget_us;
+    sched->queue_count = 0;
+    memset(sched->update, 0, sizeof(sched->update));
+    sched->update[FUSION_MEAS_GPS].priority = FUSION_DEFAULT_GPS_PRIORITY;
+    sched->update[FUSION_MEAS_GPS].cost_us = FUSION_DEFAULT_GPS_COST_US;
+    sched->update[FUSION_MEAS_BARO].priority = FUSION_DEFAULT_BARO_PRIORITY;
+    sched->update[FUSION_MEAS_BARO].max_age_us = FUSION_DEFAULT_BARO_MAX_AGE_US;
+    sched->update[FUSION_MEAS_BARO].cost_us = FUSION_DEFAULT_BARO_COST_US;
+    sched->update[FUSION_MEAS_MAG].priority = FUSION_DEFAULT_MAG_PRIORITY;
+    sched->update[FUSION_MEAS_MAG].max_age_us = FUSION_MAG_MAX_AGE_US;
+    sched->update[FUSION_MEAS_MAG].cost_us = FUSION_DEFAULT_MAG_COST_US;
+    sched->update[FUSION_MEAS_HEADING].priority = FUSION_DEFAULT_HEADING_PRIORITY;
+    sched->update[FUSION_MEAS_HEADING].max_age_us = FUSION_HEADING_MAX_AGE_US;
+    sched->update[FUSION_MEAS_HEADING].cost_us = FUSION_DEFAULT_HEADING_COST_US;
+    sched->predict_cost_us = FUSION_DEFAULT_PREDICT_COST_US;
+    sched->last_imu_us = 0;
+    sched->has_imu = false;
+    sched->last_phase = FLIGHT_PHASE_PAD;
+    sched->pad_gyro_dt = vector3f_zero();
+    sched->pad_accel_dt = vector3f_zero();
+    sched->pad_dt = 0.0f;
+    sched->pad_count = 0;
+    sched->launch_pending_count = 0;
+    sched->catch_up_threshold = 0;
+    sched->catching_up = false;
+    ekf_preint_init(&sched->catch_up);
+    sched->catch_up_last_us = 0;
+    memset(&sched->stats, 0, sizeof(sched->stats));
+
+    return ekf_delay_init(history);
+}
+
+/**
+ * @brief 항법 해 게시 버퍼 설정
+ */
+bool fusion_scheduler_set_publisher(FusionScheduler *sched, NavPublisher *publisher) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->publisher = publisher;
+
+    return true;
+}
+
+/**
+ * @brief 자력계 경철/연철 보정 추정기 설정
+ */
+bool fusion_scheduler_set_mag_calibration(FusionScheduler *sched, MagIronCal *mag_cal) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->mag_cal = mag_cal;
+
+    return true;
+}
+
+/**
+ * @brief 자력계 사전 평균 설정
+ */
+bool fusion_scheduler_set_mag_average(FusionScheduler *sched, MagAverage *mag_average) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->mag_average = mag_average;
+    if (mag_average != NULL) {
+        mag_average_reset(mag_average);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 비행 단계 상태 기계 설정
+ */
+bool fusion_scheduler_set_flight_phase(FusionScheduler *sched, FlightPhaseMachine *phase) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->phase = phase;
+
+    return true;
+}
+
+/**
+ * @brief 발사대 정지 판정기 설정
+ */
+bool fusion_scheduler_set_static_detector(FusionScheduler *sched, StaticDetector *detector) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->static_detector = detector;
+
+    return true;
+}
+
+/**
+ * @brief 비행 이벤트 검출기 설정
+ */
+bool fusion_scheduler_set_event_detector(FusionScheduler *sched, EventDetector *events) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->events = events;
+
+    return true;
+}
+
+/**
+ * @brief 부하/지연 감시기 설정
+ */
+bool fusion_scheduler_set_monitor(FusionScheduler *sched, FusionMonitor *monitor) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->monitor = monitor;
+
+    return true;
+}
+
+/**
+ * @brief 센서별 소비 지연 감시기 설정
+ */
+bool fusion_scheduler_set_latency_monitor(FusionScheduler *sched, LatencyMonitor *latency) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->latency = latency;
+
+    return true;
+}
+
+/**
+ * @brief 고중력 가속도계 혼합기 설정
+ */
+bool fusion_scheduler_set_accel_blend(FusionScheduler *sched, AccelBlend *blend) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->accel_blend = blend;
+    if (blend == NULL) {
+        return ekf_set_velocity_noise_inflation(sched->ekf, 0.0f);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 입력 단계 진동 통계 설정
+ */
+bool fusion_scheduler_set_vibration(FusionScheduler *sched, const ImuVibration *vibration) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->vibration = vibration;
+    if (vibration == NULL && sched->accel_blend == NULL) {
+        return ekf_set_velocity_noise_inflation(sched->ekf, 0.0f);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 자이로 스펙트럼 분석기 설정
+ */
+bool fusion_scheduler_set_gyro_spectrum(FusionScheduler *sched, GyroSpectrum *spectrum) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->spectrum = spectrum;
+
+    return true;
+}
+
+/**
+ * @brief 장착 위치 보정 설정
+ */
+bool fusion_scheduler_set_lever_arm(FusionScheduler *sched, ImuLeverArm *lever_arm) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->lever_arm = lever_arm;
+    if (lever_arm != NULL) {
+        return imu_lever_arm_set_gyro_bias(lever_arm, ekf_get_gyro_bias(sched->ekf));
+    }
+
+    return true;
+}
+
+/**
+ * @brief 수치 건전성 감시기 설정
+ */
+bool fusion_scheduler_set_health_monitor(FusionScheduler *sched, FilterHealth *health) {
+    if (sched == NULL || (health != NULL && health->ekf != sched->ekf)) {
+        return false;
+    }
+
+    sched->health = health;
+
+    return true;
+}
+
+/**
+ * @brief 수렴 감시기 설정
+ */
+bool fusion_scheduler_set_convergence_monitor(FusionScheduler *sched, ConvergenceMonitor *convergence) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->convergence = convergence;
+
+    return true;
+}
+
+/**
+ * @brief 수직 채널 필터 설정
+ */
+bool fusion_scheduler_set_vertical_filter(FusionScheduler *sched, VerticalFilter *vertical) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->vertical = vertical;
+
+    return true;
+}
+
+/**
+ * @brief 적응 예측 주기 제어기 설정
+ */
+bool fusion_scheduler_set_predict_rate(FusionScheduler *sched, PredictRate *predict_rate) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    if (sched->predict_rate != NULL && sched->predict_rate != predict_rate) {
+        fusion_predict_rate_flush(sched);
+    }
+    if (predict_rate != NULL) {
+        ekf_preint_set_gyro_bias(&predict_rate->preint, ekf_get_gyro_bias(sched->ekf));
+    }
+    sched->predict_rate = predict_rate;
+
+    return true;
+}
+
+/**
+ * @brief 과부하 따라잡기 설정
+ */
+bool fusion_scheduler_set_catch_up(FusionScheduler *sched, uint32_t threshold) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->catch_up_threshold = threshold;
+
+    return true;
+}
+
+/**
+ * @brief 발사대 단계 정보 형식 묶음 갱신 설정
+ */
+bool fusion_scheduler_set_information_batch(FusionScheduler *sched, bool enable) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->info_batch = enable;
+
+    return true;
+}
+
+/**
+ * @brief GNSS 측정 추가
+ */
+bool fusion_scheduler_push_gps(FusionScheduler *sched, uint32_t timestamp_us,
+                               Vector3f pos, bool use_vel, Vector3f vel) {
+    uint8_t components = EKF_GPS_USE_POS;
+    if (use_vel) {
+        components |= EKF_GPS_USE_VEL;
+    }
+
+    return fusion_scheduler_push_gps_partial(sched, timestamp_us, pos, vel, components);
+}
+
+/**
+ * @brief GNSS 부분 측정 추가
+ */
+bool fusion_scheduler_push_gps_partial(FusionScheduler *sched, uint32_t timestamp_us,
+                                       Vector3f pos, Vector3f vel, uint8_t components) {
+    return fusion_scheduler_push_gps_accuracy(sched, timestamp_us, pos, vel, components, NULL);
+}
+
+/**
+ * @brief 수신기 보고 정확도가 붙은 GNSS 측정 추가
+ */
+bool fusion_scheduler_push_gps_accuracy(FusionScheduler *sched, uint32_t timestamp_us, Vector3f pos,
+                                        Vector3f vel, uint8_t components, const EKF_GpsAccuracy *acc) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    FusionMeasurement m;
+    m.timestamp_us = timestamp_us;
+    m.type = FUSION_MEAS_GPS;
+    m.data.gps.pos = pos;
+    m.data.gps.vel = vel;
+    if (acc != NULL) {
+        m.data.gps.acc = *acc;
+    } else {
+        memset(&m.data.gps.acc, 0, sizeof(m.data.gps.acc));
+    }
+    m.data.gps.components = components;
+
+    return fusion_queue_insert(sched, &m);
+}
+
+/**
+ * @brief 기압계 측정 추가
+ */
+bool fusion_scheduler_push_baro(FusionScheduler *sched, uint32_t timestamp_us, float baro_alt) {
+    return fusion_scheduler_push_baro_scaled(sched, timestamp_us, baro_alt, 1.0f);
+}
+
+/**
+ * @brief R 배율이 붙은 기압계 측정 추가
+ */
+bool fusion_scheduler_push_baro_scaled(FusionScheduler *sched, uint32_t timestamp_us, float baro_alt,
+                                       float noise_scale) {
+    if (sched == NULL || !(noise_scale > 0.0f)) {
+        return false;
+    }
+
+    FusionMeasurement m;
+    m.timestamp_us = timestamp_us;
+    m.type = FUSION_MEAS_BARO;
+    m.data.baro.alt = baro_alt;
+    m.data.baro.noise_scale = noise_scale;
+
+    return fusion_queue_insert(sched, &m);
+}
+
+/**
+ * @brief 자력계 측정 추가
+ */
+bool fusion_scheduler_push_mag(FusionScheduler *sched, uint32_t timestamp_us, Vector3f mag) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    FusionMeasurement m;
+    m.timestamp_us = timestamp_us;
+    m.type = FUSION_MEAS_MAG;
+
+    if (sched->mag_cal != NULL) {
+        // 원시 측정을 누적하고, 측정 시점의 보정값을 적용해 정규화
+        mag_iron_cal_add_sample(sched->mag_cal, mag);
+        mag = vector3f_normalize(mag_iron_cal_apply(sched->mag_cal, mag));
+    }
+    m.data.mag.field = mag;
+    m.data.mag.noise_scale = 1.0f;
+
+    if (sched->mag_average != NULL) {
+        // 평균이 나올 때만 측정 하나 (샘플은 받았으므로 성공)
+        Quaternion q = ekf_get_attitude(sched->ekf);
+        MagAverageOutput avg;
+        if (!mag_average_push(sched->mag_average, timestamp_us, mag, &q, &avg)) {
+            return true;
+        }
+        m.timestamp_us = avg.timestamp_us;
+        m.data.mag.field = avg.mag;
+        m.data.mag.noise_scale = avg.noise_scale;
+    }
+
+    return fusion_queue_insert(sched, &m);
+}
+
+/**
+ * @brief 이중 안테나 GNSS 기선 방위 측정 추가
+ */
+bool fusion_scheduler_push_gnss_heading(FusionScheduler *sched, uint32_t timestamp_us, const EKF_GnssHeading *m) {
+    if (sched == NULL || m == NULL) {
+        return false;
+    }
+
+    FusionMeasurement meas;
+    meas.timestamp_us = timestamp_us;
+    meas.type = FUSION_MEAS_HEADING;
+    meas.data.heading = *m;
+
+    return fusion_queue_insert(sched, &meas);
+}
+
+/**
+ * @brief 고정 지연 평활기 설정
+ */
+bool fusion_scheduler_set_fixed_lag(FusionScheduler *sched, FixedLagSmoother *smoother) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    sched->smoother = smoother;
+
+    return true;
+}
+
+/**
+ * @brief 측정 종류별 갱신 정책 설정
+ */
+bool fusion_scheduler_set_update_policy(FusionScheduler *sched, FusionMeasType type,
+                                        uint8_t priority, uint32_t max_age_us) {
+    if (sched == NULL || (unsigned)type >= FUSION_MEAS_TYPE_COUNT) {
+        return false;
+    }
+
+    sched->update[type].priority = priority;
+    sched->update[type].max_age_us = max_age_us;
+
+    return true;
+}
+
+/**
+ * @brief 측정 종류별 정책과 비용 추정 조회
+ */
+const FusionUpdateBudget *fusion_scheduler_get_update_budget(const FusionScheduler *sched, FusionMeasType type) {
+    if (sched == NULL || (unsigned)type >= FUSION_MEAS_TYPE_COUNT) {
+        return NULL;
+    }
+
+    return &sched->update[type];
+}
+
+/**
+ * @brief MPSC 측정 대기열 비우기
+ */
+uint32_t fusion_scheduler_drain_queue(FusionScheduler *sched, MeasQueue *queue, BaroAltitude *baro) {
+    if (sched == NULL || queue == NULL) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    MeasMessage msg;
+    while (meas_queue_pop(queue, &msg)) {
+        count++;
+        switch (msg.type) {
+        case MEAS_TYPE_IMU: {
+            ImuSample s = { msg.timestamp_us, msg.data.imu.gyro, msg.data.imu.accel };
+            imu_ring_push(sched->imu, &s);
+            break;
+        }
+        case MEAS_TYPE_BARO: {
+            float alt;
+            if (baro != NULL) {
+                if (!baro_altitude_update(baro, msg.data.baro.pressure_pa, msg.data.baro.temperature_c, &alt)) {
+                    // 지상 기준 수집 중
+                    break;
+                }
+            } else {
+                alt = baro_altitude_isa(msg.data.baro.pressure_pa);
+            }
+            fusion_scheduler_push_baro(sched, msg.timestamp_us, alt);
+            break;
+        }
+        case MEAS_TYPE_MAG:
+            fusion_scheduler_push_mag(sched, msg.timestamp_us, msg.data.mag);
+            break;
+        case MEAS_TYPE_GNSS: {
+            const EKF_GpsAccuracy acc = { msg.data.gnss.h_acc_cm * 0.01f, msg.data.gnss.v_acc_cm * 0.01f,
+                                          msg.data.gnss.s_acc_cms * 0.01f };
+            fusion_scheduler_push_gps_accuracy(sched, msg.timestamp_us, msg.data.gnss.pos, msg.data.gnss.vel,
+                                               msg.data.gnss.components, &acc);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief 융합 사이클 1회 실행
+ */
+bool fusion_scheduler_run(FusionScheduler *sched) {
+    if (sched == NULL || !sched->ekf->initialized) {
+        return false;
+    }
+
+    TRACE_BEGIN(TRACE_EVENT_CYCLE);
+    uint32_t start_us = sched->clock();
+    uint32_t predicts_before = sched->stats.predicts;
+    uint32_t samples = 0;
+
+    // 적체가 문턱을 넘으면 이번 사이클 비행 중 샘플을 묶어 예측
+    sched->catching_up = sched->catch_up_threshold > 0 && sched->predict_rate == NULL &&
+                         imu_ring_count(sched->imu) > sched->catch_up_threshold;
+    if (sched->catching_up) {
+        sched->stats.catch_up_cycles++;
+        ekf_preint_set_gyro_bias(&sched->catch_up, ekf_get_gyro_bias(sched->ekf));
+    }
+
+    // 진동 분산은 창 단위로 바뀌므로 사이클마다 한 번 읽고 첫 샘플 간격으로 고정
+    float vibration_var = (sched->vibration != NULL) ? imu_vibration_accel_var(sched->vibration) : 0.0f;
+    float vibration_q = -1.0f;
+
+    ImuSample s;
+    while (imu_ring_pop(sched->imu, &s)) {
+        samples++;
+        if (!sched->has_imu) {
+            // 첫 샘플은 시각 기준으로만 사용
+            sched->last_imu_us = s.timestamp_us;
+            sched->has_imu = true;
+            continue;
+        }
+
+        // 이 샘플 구간 시작 이전의 측정 먼저 갱신
+        fusion_process_due(sched, sched->last_imu_us, start_us);
+
+        float dt = (float)(int32_t)(s.timestamp_us - sched->last_imu_us) * 1e-6f;
+        if (dt > 0.0f && dt <= FUSION_IMU_MAX_DT) {
+            if (vibration_q < 0.0f) {
+                vibration_q = vibration_var * dt;
+            }
+            if (sched->accel_blend != NULL) {
+                // 포화 축은 고중력 샘플로 혼합하고, 혼합/포화 동안 속도 잡음을 키움
+                float accel_var;
+                accel_blend_apply(sched->accel_blend, s.timestamp_us, &s.accel, &accel_var);
+                ekf_set_velocity_noise_inflation(sched->ekf, accel_var * dt + vibration_q);
+            } else if (sched->vibration != NULL) {
+                ekf_set_velocity_noise_inflation(sched->ekf, vibration_q);
+            }
+            EKF_ImuSample imu = { s.gyro, s.accel, dt };
+            uint32_t t0 = sched->clock();
+            if (sched->latency != NULL) {
+                latency_monitor_record(sched->latency, LATENCY_SOURCE_IMU, s.timestamp_us, t0);
+            }
+            TRACE_BEGIN(TRACE_EVENT_PREDICT);
+            fusion_step_imu(sched, &imu, s.timestamp_us);
+            TRACE_END(TRACE_EVENT_PREDICT);
+            if (!sched->catching_up) {
+                // 누적만 한 샘플의 처리 시간은 예측 비용이 아님
+                fusion_learn_cost(&sched->predict_cost_us, sched->clock() - t0);
+            }
+            fusion_track_phase(sched);
+            if (sched->vertical != NULL) {
+                vertical_filter_predict(sched->vertical, ekf_get_attitude(sched->ekf), s.accel, dt);
+            }
+        }
+        sched->last_imu_us = s.timestamp_us;
+
+        if (sched->monitor != NULL) {
+            fusion_monitor_record_sample(sched->monitor, fusion_current_phase(sched),
+                                         sched->clock() - s.timestamp_us);
+        }
+    }
+
+    // 남은 따라잡기 누적분으로 필터 시각을 마지막 IMU 시각까지 맞춤
+    fusion_catch_up_flush(sched);
+    sched->catching_up = false;
+
+    if (sched->has_imu) {
+        fusion_process_due(sched, sched->last_imu_us, start_us);
+
+        // 예산 부족으로 남은 측정 수를 지연 횟수로 기록
+        for (uint8_t i = 0; i < sched->queue_count; i++) {
+            if (fusion_time_after(sched->queue[i].timestamp_us, sched->last_imu_us)) {
+                break;
+            }
+            sched->update[sched->queue[i].type].deferred++;
+            sched->stats.deferred++;
+        }
+    }
+
+    // 자력계 보정 해 추출은 예산이 남을 때만 한 단계 진행
+    if (sched->mag_cal != NULL && !fusion_over_budget(sched, start_us)) {
+        mag_iron_cal_step(sched->mag_cal);
+    }
+
+    // 스펙트럼 분석도 예산이 남을 때만 한 단계 진행
+    if (sched->spectrum != NULL && !fusion_over_budget(sched, start_us)) {
+        gyro_spectrum_step(sched->spectrum);
+    }
+
+    // 수치 건전성은 게시 전에 점검 (ekf_reset까지 갔으면 게시와 정점 판정 생략)
+    bool predicted = sched->stats.predicts != predicts_before;
+    if (predicted && sched->health != NULL &&
+        filter_health_step(sched->health, sched->last_imu_us) == FILTER_HEALTH_RESET) {
+        predicted = false;
+        fixed_lag_reset(sched->smoother);
+    }
+
+    // 이번 사이클에 예측이 있었으면 항법 해 게시 및 정점 판정
+    if (predicted) {
+        if (sched->lever_arm != NULL) {
+            imu_lever_arm_set_gyro_bias(sched->lever_arm, ekf_get_gyro_bias(sched->ekf));
+        }
+        if (sched->publisher != NULL) {
+            nav_publisher_write_ekf(sched->publisher, sched->ekf, sched->last_imu_us);
+        }
+        if (sched->convergence != NULL) {
+            convergence_monitor_update_ekf(sched->convergence, sched->ekf, sched->last_imu_us);
+        }
+        if (sched->phase != NULL) {
+            float vel_up = vertical_filter_is_ready(sched->vertical)
+                         ? vertical_filter_get_velocity(sched->vertical)
+                         : ekf_get_velocity(sched->ekf).z;
+            flight_phase_update_nav(sched->phase, sched->last_imu_us, vel_up);
+            fusion_track_phase(sched);
+        }
+    }
+
+    uint32_t elapsed_us = sched->clock() - start_us;
+    if (elapsed_us > sched->budget_us) {
+        sched->stats.overruns++;
+    }
+    if (elapsed_us > sched->stats.max_cycle_us) {
+        sched->stats.max_cycle_us = elapsed_us;
+    }
+    if (sched->monitor != NULL) {
+        fusion_monitor_record_cycle(sched->monitor, fusion_current_phase(sched), elapsed_us, samples);
+    }
+    TRACE_END(TRACE_EVENT_CYCLE);
+
+    return true;
+}
+
+/**
+ * @brief 통계 조회
+ */
+const FusionStats *fusion_scheduler_get_stats(const FusionScheduler *sched) {
+    if (sched == NULL) {
+        return NULL;
+    }
+
+    return &sched->stats;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file geodetic.c
+ * @brief 측지 좌표 ↔ 지역 NED 변환 구현
+ */
+
+#include "nav/geodetic.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief WGS-84 타원체
+ */
+#define GEODETIC_WGS84_A 6378137.0                 /**< 장반경 (m) */
+#define GEODETIC_WGS84_E2 6.69437999014e-3         /**< 이심률 제곱 */
+
+/**
+ * @brief 지구 자전 각속도 (rad/s)와 빛의 속도 (m/s)
+ */
+#define GEODETIC_EARTH_RATE 7.2921151467e-5
+#define GEODETIC_SPEED_OF_LIGHT 299792458.0
+
+/**
+ * @brief 1e-7 deg → rad
+ */
+#define GEODETIC_E7_TO_RAD (3.14159265358979323846 / 180.0 * 1e-7)
+
+/**
+ * @brief 경도 한 바퀴 (1e-7 deg)
+ */
+#define GEODETIC_LON_TURN_E7 3600000000LL
+
+/**
+ * @brief 경도 차 (1e-7 deg, [-180, 180) 으로 순환)
+ */
+static int32_t geodetic_lon_delta(int32_t lon_e7, int32_t ref_e7) {
+    int64_t d = (int64_t)lon_e7 - (int64_t)ref_e7;
+    if (d >= GEODETIC_LON_TURN_E7 / 2) {
+        d -= GEODETIC_LON_TURN_E7;
+    } else if (d < -GEODETIC_LON_TURN_E7 / 2) {
+        d += GEODETIC_LON_TURN_E7;
+    }
+
+    return (int32_t)d;
+}
+
+/**
+ * @brief 측지 좌표 → ECEF (배정밀도)
+ */
+static void geodetic_to_ecef(double sin_lat, double cos_lat, double sin_lon, double cos_lon,
+                             double h, double ecef[3]) {
+    double n = GEODETIC_WGS84_A / sqrt(1.0 - GEODETIC_WGS84_E2 * sin_lat * sin_lat);
+
+    ecef[0] = (n + h) * cos_lat * cos_lon;
+    ecef[1] = (n + h) * cos_lat * sin_lon;
+    ecef[2] = (n * (1.0 - GEODETIC_WGS84_E2) + h) * sin_lat;
+}
+
+/**
+ * @brief ECEF → NED 회전 행렬 (행: N, E, D)
+ */
+static void geodetic_ned_rotation(double sin_lat, double cos_lat, double sin_lon, double cos_lon,
+                                  double r[3][3]) {
+    r[0][0] = -sin_lat * cos_lon;
+    r[0][1] = -sin_lat * sin_lon;
+    r[0][2] = cos_lat;
+    r[1][0] = -sin_lon;
+    r[1][1] = cos_lon;
+    r[1][2] = 0.0;
+    r[2][0] = -cos_lat * cos_lon;
+    r[2][1] = -cos_lat * sin_lon;
+    r[2][2] = -sin_lat;
+}
+
+/**
+ * @brief 원점 설정
+ */
+bool geodetic_init(GeodeticFrame *frame, int32_t lat_e7, int32_t lon_e7, int32_t height_mm,
+                   float recenter_radius) {
+    if (frame == NULL || lat_e7 > 900000000 || lat_e7 < -900000000 || !(recenter_radius > 0.0f)) {
+        return false;
+    }
+
+    double lat = (double)lat_e7 * GEODETIC_E7_TO_RAD;
+    double lon = (double)lon_e7 * GEODETIC_E7_TO_RAD;
+    frame->sin_lat0 = sin(lat);
+    frame->cos_lat0 = cos(lat);
+    frame->sin_lon0 = sin(lon);
+    frame->cos_lon0 = cos(lon);
+    geodetic_to_ecef(frame->sin_lat0, frame->cos_lat0, frame->sin_lon0, frame->cos_lon0,
+                     (double)height_mm * 1e-3, frame->ecef0);
+
+    frame->recenter_radius = recenter_radius;
+    frame->initialized = true;
+
+    if (!geodetic_recenter(frame, lat_e7, lon_e7, height_mm)) {
+        frame->initialized = false;
+        return false;
+    }
+    frame->recenter_count = 0;
+
+    return true;
+}
+
+/**
+ * @brief 선형화 점 재설정 (배정밀도 정확 변환)
+ */
+bool geodetic_recenter(GeodeticFrame *frame, int32_t lat_e7, int32_t lon_e7, int32_t height_mm) {
+    if (frame == NULL || !frame->initialized || lat_e7 > 900000000 || lat_e7 < -900000000) {
+        return false;
+    }
+
+    double lat = (double)lat_e7 * GEODETIC_E7_TO_RAD;
+    double lon = (double)lon_e7 * GEODETIC_E7_TO_RAD;
+    double h = (double)height_mm * 1e-3;
+    double sin_lat = sin(lat);
+    double cos_lat = cos(lat);
+    double sin_lon = sin(lon);
+    double cos_lon = cos(lon);
+
+    // 선형화 점의 원점 NED 좌표
+    double ecef[3];
+    geodetic_to_ecef(sin_lat, cos_lat, sin_lon, cos_lon, h, ecef);
+    double r0[3][3];
+    geodetic_ned_rotation(frame->sin_lat0, frame->cos_lat0, frame->sin_lon0, frame->cos_lon0, r0);
+    double d[3] = { ecef[0] - frame->ecef0[0], ecef[1] - frame->ecef0[1], ecef[2] - frame->ecef0[2] };
+    frame->offset = vector3f_create((float)(r0[0][0] * d[0] + r0[0][1] * d[1] + r0[0][2] * d[2]),
+                                    (float)(r0[1][0] * d[0] + r0[1][1] * d[1] + r0[1][2] * d[2]),
+                                    (float)(r0[2][0] * d[0] + r0[2][1] * d[1] + r0[2][2] * d[2]));
+
+    // 선형화 점 NED → 원점 NED = R0 * Rp^T
+    double rp[3][3];
+    geodetic_ned_rotation(sin_lat, cos_lat, sin_lon, cos_lon, rp);
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            frame->rot[i][j] = (float)(r0[i][0] * rp[j][0] + r0[i][1] * rp[j][1] + r0[i][2] * rp[j][2]);
+        }
+    }
+
+    // 곡률 반경 (고도 포함)
+    double w = 1.0 - GEODETIC_WGS84_E2 * sin_lat * sin_lat;
+    double n = GEODETIC_WGS84_A / sqrt(w) + h;
+    double m = GEODETIC_WGS84_A * (1.0 - GEODETIC_WGS84_E2) / (w * sqrt(w)) + h;
+    double tan_lat = sin_lat / cos_lat;
+
+    frame->k_north = (float)(m * GEODETIC_E7_TO_RAD);
+    frame->k_east = (float)(n * cos_lat * GEODETIC_E7_TO_RAD);
+    frame->k_east_lat = (float)(tan_lat * GEODETIC_E7_TO_RAD);
+    frame->inv_m = (float)(1.0 / m);
+    frame->inv_n = (float)(1.0 / n);
+    frame->c_north = (float)(tan_lat / (2.0 * n));
+
+    frame->lat_e7 = lat_e7;
+    frame->lon_e7 = lon_e7;
+    frame->height_mm = height_mm;
+    frame->recenter_count++;
+
+    return true;
+}
+
+/**
+ * @brief 측지 좌표 → 원점 NED
+ *
+ * 선형화 점 기준 2차 근사:
+ *   n = M dlat (1 + dh / M) + e^2 tan(lat) / (2 N)
+ *   e = N cos(lat) dlon (1 + dh / N - tan(lat) dlat)
+ *   d = -dh + n^2 / (2 M) + e^2 / (2 N)
+ */
+bool geodetic_to_ned(GeodeticFrame *frame, int32_t lat_e7, int32_t lon_e7, int32_t height_mm,
+                     Vector3f *ned) {
+    if (frame == NULL || ned == NULL || !frame->initialized) {
+        return false;
+    }
+
+    // 정수 차는 선형화 점 근처에서 float로 정확히 표현됨
+    float dlat = (float)(lat_e7 - frame->lat_e7);
+    float dlon = (float)geodetic_lon_delta(lon_e7, frame->lon_e7);
+    float dh = (float)(height_mm - frame->height_mm) * 1e-3f;
+
+    float e = frame->k_east * dlon * (1.0f + dh * frame->inv_n - frame->k_east_lat * dlat);
+    float n = frame->k_north * dlat * (1.0f + dh * frame->inv_m) + frame->c_north * e * e;
+
+    if (n * n + e * e > frame->recenter_radius * frame->recenter_radius) {
+        if (!geodetic_recenter(frame, lat_e7, lon_e7, height_mm)) {
+            return false;
+        }
+        *ned = frame->offset;
+        return true;
+    }
+
+    float d = -dh + 0.5f * (n * n * frame->inv_m + e * e * frame->inv_n);
+
+    const float (*r)[3] = frame->rot;
+    *ned = vector3f_create(frame->offset.x + r[0][0] * n + r[0][1] * e + r[0][2] * d,
+                           frame->offset.y + r[1][0] * n + r[1][1] * e + r[1][2] * d,
+                           frame->offset.z + r[2][0] * n + r[2][1] * e + r[2][2] * d);
+
+    return true;
+}
+
+/**
+ * @brief 원점 NED → ECEF
+ */
+bool geodetic_ned_to_ecef(const GeodeticFrame *frame, Vector3f ned, double ecef[3]) {
+    if (frame == NULL || ecef == NULL || !frame->initialized) {
+        return false;
+    }
+
+    // ECEF = 원점 ECEF + R0^T * NED
+    double r0[3][3];
+    geodetic_ned_rotation(frame->sin_lat0, frame->cos_lat0, frame->sin_lon0, frame->cos_lon0, r0);
+    for (uint8_t i = 0; i < 3; i++) {
+        ecef[i] = frame->ecef0[i] + r0[0][i] * ned.x + r0[1][i] * ned.y + r0[2][i] * ned.z;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ECEF → 측지 좌표
+ *
+ * Bowring:
+ *   θ = atan2(z a, p b)
+ *   lat = atan2(z + e'^2 b sin^3 θ, p - e^2 a cos^3 θ)
+ *   h = p cos(lat) + z sin(lat) - a sqrt(1 - e^2 sin^2 lat)   (극 근처에서도 안정)
+ */
+bool geodetic_ecef_to_lla(const double ecef[3], int32_t *lat_e7, int32_t *lon_e7, int32_t *height_mm) {
+    if (ecef == NULL || lat_e7 == NULL || lon_e7 == NULL || height_mm == NULL) {
+        return false;
+    }
+
+    const double b = GEODETIC_WGS84_A * sqrt(1.0 - GEODETIC_WGS84_E2);
+    const double ep2 = GEODETIC_WGS84_E2 / (1.0 - GEODETIC_WGS84_E2);
+    double p = sqrt(ecef[0] * ecef[0] + ecef[1] * ecef[1]);
+    double theta = atan2(ecef[2] * GEODETIC_WGS84_A, p * b);
+    double st = sin(theta);
+    double ct = cos(theta);
+    double lat = atan2(ecef[2] + ep2 * b * st * st * st, p - GEODETIC_WGS84_E2 * GEODETIC_WGS84_A * ct * ct * ct);
+    double lon = atan2(ecef[1], ecef[0]);
+    double sin_lat = sin(lat);
+    double h = p * cos(lat) + ecef[2] * sin_lat -
+               GEODETIC_WGS84_A * sqrt(1.0 - GEODETIC_WGS84_E2 * sin_lat * sin_lat);
+
+    *lat_e7 = (int32_t)lround(lat / GEODETIC_E7_TO_RAD);
+    *lon_e7 = (int32_t)lround(lon / GEODETIC_E7_TO_RAD);
+    *height_mm = (int32_t)lround(h * 1e3);
+
+    return true;
+}
+
+/**
+ * @brief 원점 NED → 측지 좌표
+ */
+bool geodetic_from_ned(const GeodeticFrame *frame, Vector3f ned, int32_t *lat_e7, int32_t *lon_e7,
+                       int32_t *height_mm) {
+    double ecef[3];
+    if (!geodetic_ned_to_ecef(frame, ned, ecef)) {
+        return false;
+    }
+
+    return geodetic_ecef_to_lla(ecef, lat_e7, lon_e7, height_mm);
+}
+
+/**
+ * @brief 원점 NED 점 → 위성 기하 거리와 시선 벡터
+ */
+bool geodetic_line_of_sight(const GeodeticFrame *frame, Vector3f ref_ned, const double sat_ecef[3],
+                            const double sat_vel_ecef[3], Vector3f *los, double *range, float *sat_rate) {
+    if (frame == NULL || sat_ecef == NULL || los == NULL || range == NULL || !frame->initialized) {
+        return false;
+    }
+
+    // 수신기 ECEF = 원점 ECEF + R0^T * NED
+    double r0[3][3];
+    geodetic_ned_rotation(frame->sin_lat0, frame->cos_lat0, frame->sin_lon0, frame->cos_lon0, r0);
+    double ned[3] = { ref_ned.x, ref_ned.y, ref_ned.z };
+    double rx[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        rx[i] = frame->ecef0[i] + r0[0][i] * ned[0] + r0[1][i] * ned[1] + r0[2][i] * ned[2];
+    }
+
+    double d[3] = { sat_ecef[0] - rx[0], sat_ecef[1] - rx[1], sat_ecef[2] - rx[2] };
+    double dist = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    if (!(dist > 0.0)) {
+        return false;
+    }
+
+    // 전파 시간 동안 수신기 좌표계가 회전한 만큼 (Sagnac)
+    *range = dist + GEODETIC_EARTH_RATE / GEODETIC_SPEED_OF_LIGHT *
+                    (sat_ecef[0] * rx[1] - sat_ecef[1] * rx[0]);
+
+    double u[3] = { d[0] / dist, d[1] / dist, d[2] / dist };
+    *los = vector3f_create((float)(r0[0][0] * u[0] + r0[0][1] * u[1] + r0[0][2] * u[2]),
+                           (float)(r0[1][0] * u[0] + r0[1][1] * u[1] + r0[1][2] * u[2]),
+                           (float)(r0[2][0] * u[0] + r0[2][1] * u[1] + r0[2][2] * u[2]));
+
+    if (sat_rate != NULL) {
+        *sat_rate = (sat_vel_ecef != NULL)
+            ? (float)(u[0] * sat_vel_ecef[0] + u[1] * sat_vel_ecef[1] + u[2] * sat_vel_ecef[2])
+            : 0.0f;
+    }
+
+    return true;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file innovation_monitor.c
+ * @brief 측정별 NIS 창 통계 구현
+ */
+
+#include "nav/innovation_monitor.h"
+#include "math/float16.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 측정 차원 (EKF_Sensor 순서)
+ */
+static const uint8_t innovation_monitor_dof[EKF_SENSOR_COUNT] = { 3, 6, 1, 3, 3, 3, 1, 1, 1, 3, 1, 3, 1 };
+
+/**
+ * @brief 기본 설정
+ */
+bool innovation_monitor_default_config(InnovationMonitorConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->window_us = INNOVATION_MONITOR_DEFAULT_WINDOW_US;
+
+    return true;
+}
+
+/**
+ * @brief 초기화
+ */
+bool innovation_monitor_init(InnovationMonitor *im, const InnovationMonitorConfig *config) {
+    if (im == NULL) {
+        return false;
+    }
+
+    InnovationMonitorConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        innovation_monitor_default_config(&cfg);
+    }
+    if (cfg.window_us == 0) {
+        return false;
+    }
+
+    memset(im, 0, sizeof(*im));
+    im->config = cfg;
+    atomic_init(&im->active, 0);
+    im->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 창 누적 하나를 통계로
+ */
+static void innovation_monitor_reduce(const EKF_NisWindow *w, uint8_t dof, InnovationSensorMetrics *out) {
+    memset(out, 0, sizeof(*out));
+    out->count = w->count;
+    out->rejects = w->rejects;
+    if (w->count == 0) {
+        return;
+    }
+
+    float inv = 1.0f / (float)w->count;
+    float mean = w->sum * inv;
+    // E[x^2] - E[x]^2, 반올림으로 음수가 되면 0
+    float var = w->sum_sq * inv - mean * mean;
+
+    out->mean = mean;
+    out->std = (var > 0.0f) ? sqrtf(var) : 0.0f;
+    out->max = w->max;
+    out->ratio = mean / (float)dof;
+}
+
+/**
+ * @brief 창이 끝났으면 통계 게시
+ */
+bool innovation_monitor_update(InnovationMonitor *im, EKF *ekf, uint32_t now_us) {
+    if (im == NULL || !im->initialized || ekf == NULL) {
+        return false;
+    }
+
+    EKF_NisWindow w;
+    if (!im->started) {
+        for (uint8_t s = 0; s < EKF_SENSOR_COUNT; s++) {
+            ekf_take_nis_window(ekf, (EKF_Sensor)s, &w);
+        }
+        im->window_start_us = now_us;
+        im->started = true;
+        return false;
+    }
+
+    uint32_t elapsed = now_us - im->window_start_us;
+    if (elapsed < im->config.window_us) {
+        return false;
+    }
+
+    // 읽는 쪽이 보지 않는 버퍼에 쓰고 번호를 바꿈
+    unsigned int next = atomic_load_explicit(&im->active, memory_order_relaxed) ^ 1u;
+    InnovationMetrics *m = &im->metrics[next];
+    m->window_end_us = now_us;
+    m->window_us = elapsed;
+    m->active = 0;
+    m->worst[0] = EKF_SENSOR_COUNT;
+    m->worst[1] = EKF_SENSOR_COUNT;
+
+    for (uint8_t s = 0; s < EKF_SENSOR_COUNT; s++) {
+        ekf_take_nis_window(ekf, (EKF_Sensor)s, &w);
+        InnovationSensorMetrics *sm = &m->sensor[s];
+        innovation_monitor_reduce(&w, innovation_monitor_dof[s], sm);
+        if (sm->count == 0 && sm->rejects == 0) {
+            continue;
+        }
+        m->active |= (uint16_t)(1u << s);
+        if (sm->count == 0) {
+            continue;
+        }
+
+        // ratio 내림차순 두 개
+        if (m->worst[0] == EKF_SENSOR_COUNT || sm->ratio > m->sensor[m->worst[0]].ratio) {
+            m->worst[1] = m->worst[0];
+            m->worst[0] = s;
+        } else if (m->worst[1] == EKF_SENSOR_COUNT || sm->ratio > m->sensor[m->worst[1]].ratio) {
+            m->worst[1] = s;
+        }
+    }
+
+    atomic_store_explicit(&im->active, next, memory_order_release);
+    im->window_start_us = now_us;
+    im->stats.windows++;
+
+    return true;
+}
+
+/**
+ * @brief 마지막 창 통계
+ */
+bool innovation_monitor_get_metrics(const InnovationMonitor *im, InnovationMetrics *out) {
+    if (im == NULL || out == NULL || !im->initialized) {
+        return false;
+    }
+
+    *out = im->metrics[atomic_load_explicit(&im->active, memory_order_acquire)];
+
+    return out->window_us > 0;
+}
+
+/**
+ * @brief 마지막 창의 평균 NIS / 측정 차원
+ */
+float innovation_monitor_ratio(const InnovationMonitor *im, EKF_Sensor sensor) {
+    if (im == NULL || !im->initialized || sensor >= EKF_SENSOR_COUNT) {
+        return 0.0f;
+    }
+
+    const InnovationMetrics *m = &im->metrics[atomic_load_explicit(&im->active, memory_order_acquire)];
+
+    return m->sensor[sensor].ratio;
+}
+
+/**
+ * @brief 리틀 엔디언 쓰기
+ */
+static uint8_t *innovation_monitor_put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+/**
+ * @brief u32 계수를 u16으로 포화
+ */
+static uint16_t innovation_monitor_sat16(uint32_t v) {
+    return (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
+}
+
+/**
+ * @brief 창 통계 부호화
+ */
+uint8_t innovation_monitor_encode(const InnovationMetrics *m, uint8_t *payload) {
+    if (m == NULL || payload == NULL) {
+        return 0;
+    }
+
+    uint8_t *p = payload;
+    *p++ = (uint8_t)m->window_end_us;
+    *p++ = (uint8_t)(m->window_end_us >> 8);
+    *p++ = (uint8_t)(m->window_end_us >> 16);
+    *p++ = (uint8_t)(m->window_end_us >> 24);
+    uint8_t *n = p++;
+    *n = 0;
+
+    for (uint8_t s = 0; s < EKF_SENSOR_COUNT; s++) {
+        if ((m->active & (1u << s)) == 0) {
+            continue;
+        }
+        const InnovationSensorMetrics *sm = &m->sensor[s];
+        *p++ = s;
+        p = innovation_monitor_put16(p, innovation_monitor_sat16(sm->count));
+        p = innovation_monitor_put16(p, innovation_monitor_sat16(sm->rejects));
+        p = innovation_monitor_put16(p, float16_from_float(sm->mean));
+        p = innovation_monitor_put16(p, float16_from_float(sm->std));
+        p = innovation_monitor_put16(p, float16_from_float(sm->max));
+        (*n)++;
+    }
+
+    return (uint8_t)(p - payload);
+}
+
+/**
+ * @brief 마지막 창 통계 기록
+ */
+bool innovation_monitor_log(InnovationMonitor *im, FlashLog *log) {
+    if (im == NULL || !im->initialized || log == NULL) {
+        return false;
+    }
+
+    InnovationMetrics m;
+    if (!innovation_monitor_get_metrics(im, &m)) {
+        return false;
+    }
+
+    uint8_t payload[INNOVATION_MONITOR_LOG_SIZE(EKF_SENSOR_COUNT)];
+    uint8_t len = innovation_monitor_encode(&m, payload);
+    if (len == 0) {
+        return false;
+    }
+    if (!flash_log_write(log, FLASH_LOG_REC_NIS, payload, len)) {
+        im->stats.log_dropped++;
+        return false;
+    }
+
+    im->stats.logged++;
+
+    return true;
+}
+
+/**
+ * @brief 통계
+ */
+const InnovationMonitorStats *innovation_monitor_get_stats(const InnovationMonitor *im) {
+    if (im == NULL) {
+        return NULL;
+    }
+
+    return &im->stats;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file landing_predictor.c
+ * @brief 하강 중 바람 추정과 착지 지점 예측 구현
+ */
+
+#include "nav/landing_predictor.h"
+#include "math/fast_math.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool landing_predictor_default_config(LandingPredictorConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->rate_hz = LANDING_DEFAULT_RATE_HZ;
+    config->ground_alt = LANDING_DEFAULT_GROUND_ALT;
+    config->scale_height = LANDING_DEFAULT_SCALE_HEIGHT;
+    config->wind_walk = LANDING_DEFAULT_WIND_WALK;
+    config->gust_std = LANDING_DEFAULT_GUST_STD;
+    config->init_wind_std = LANDING_DEFAULT_INIT_WIND_STD;
+    config->descent_tau = LANDING_DEFAULT_DESCENT_TAU;
+    config->drift_tau = LANDING_DEFAULT_DRIFT_TAU;
+    config->min_descent = LANDING_DEFAULT_MIN_DESCENT;
+
+    return true;
+}
+
+/**
+ * @brief 예측기 초기화
+ */
+bool landing_predictor_init(LandingPredictor *lp, const LandingPredictorConfig *config) {
+    if (lp == NULL) {
+        return false;
+    }
+
+    LandingPredictorConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        landing_predictor_default_config(&cfg);
+    }
+    if (!(cfg.rate_hz > 0.0f) || !(cfg.scale_height > 0.0f) || !isfinite(cfg.ground_alt) ||
+        !(cfg.wind_walk >= 0.0f) || !(cfg.gust_std >= 0.0f) || !(cfg.init_wind_std > 0.0f) ||
+        !(cfg.descent_tau >= 0.0f) || !(cfg.drift_tau >= 0.0f) || !(cfg.min_descent > 0.0f)) {
+        return false;
+    }
+
+    memset(lp, 0, sizeof(*lp));
+    lp->config = cfg;
+    lp->period_us = (uint32_t)(1e6f / cfg.rate_hz);
+    lp->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 지상 고도 설정
+ */
+bool landing_predictor_set_ground(LandingPredictor *lp, float ground_alt) {
+    if (lp == NULL || !lp->initialized || !isfinite(ground_alt)) {
+        return false;
+    }
+
+    lp->config.ground_alt = ground_alt;
+
+    return true;
+}
+
+/**
+ * @brief 항법 해로 갱신
+ */
+bool landing_predictor_update(LandingPredictor *lp, const EKF_NavSolution *sol, FlightPhase phase) {
+    if (lp == NULL || !lp->initialized || sol == NULL) {
+        return false;
+    }
+
+    LandingPrediction *out = &lp->out;
+    if (phase != FLIGHT_PHASE_DESCENT) {
+        lp->active = false;
+        out->valid = false;
+        return false;
+    }
+
+    const LandingPredictorConfig *cfg = &lp->config;
+    const float v[2] = { sol->vel.x, sol->vel.y };
+    const float gust_var = cfg->gust_std * cfg->gust_std;
+    const float r[2] = { sol->p_diag[EKF_STATE_VEL_X] + gust_var, sol->p_diag[EKF_STATE_VEL_Y] + gust_var };
+
+    // 지상 위 높이와 밀도 보정 exp(-(h - h_g) / 2H): 하강률 표본을 지상 값으로 환산
+    float height = sol->pos.z - cfg->ground_alt;
+    if (!(height > 0.0f)) {
+        height = 0.0f;
+    }
+    float decay = fp_expf(-height / (2.0f * cfg->scale_height));
+    float descent = -sol->vel.z * decay;
+
+    if (!lp->active) {
+        for (uint8_t i = 0; i < 2; i++) {
+            out->wind[i] = v[i];
+            out->wind_var[i] = cfg->init_wind_std * cfg->init_wind_std;
+        }
+        out->descent_rate = (descent > 0.0f) ? descent : 0.0f;
+        lp->last_us = sol->timestamp_us;
+        lp->active = true;
+        lp->stats.descents++;
+    } else {
+        uint32_t elapsed = sol->timestamp_us - lp->last_us;
+        if (elapsed < lp->period_us) {
+            lp->stats.skipped++;
+            return false;
+        }
+        lp->last_us = sol->timestamp_us;
+        float dt = (float)elapsed * 1e-6f;
+
+        // 축별 무작위 보행 예측 + 수평 속도 스칼라 갱신
+        float q = cfg->wind_walk * cfg->wind_walk * dt;
+        for (uint8_t i = 0; i < 2; i++) {
+            float p = out->wind_var[i] + q;
+            float k = p / (p + r[i]);
+            out->wind[i] += k * (v[i] - out->wind[i]);
+            out->wind_var[i] = (1.0f - k) * p;
+        }
+
+        float alpha = dt / (cfg->descent_tau + dt);
+        out->descent_rate += alpha * (descent - out->descent_rate);
+    }
+    lp->stats.updates++;
+    out->timestamp_us = sol->timestamp_us;
+
+    if (!(out->descent_rate >= cfg->min_descent)) {
+        lp->stats.slow++;
+        out->valid = false;
+        return false;
+    }
+
+    // 지상까지 하강 적분: T = (2H / v_g)(1 - exp(-(h - h_g) / 2H))
+    float t = 2.0f * cfg->scale_height * (1.0f - decay) / out->descent_rate;
+    float drift = (cfg->drift_tau > 0.0f) ? cfg->drift_tau * (1.0f - fp_expf(-t / cfg->drift_tau)) : 0.0f;
+    const float p[2] = { sol->pos.x, sol->pos.y };
+    for (uint8_t i = 0; i < 2; i++) {
+        out->land[i] = p[i] + out->wind[i] * t + (v[i] - out->wind[i]) * drift;
+    }
+
+    float var = (out->wind_var[0] + out->wind_var[1]) * t * t;
+#if EKF_CONFIG_POSITION
+    var += sol->p_diag[EKF_STATE_POS_X] + sol->p_diag[EKF_STATE_POS_Y];
+#endif
+    out->time_to_ground = t;
+    out->land_std = fast_sqrtf(var);
+    out->valid = true;
+
+    return true;
+}
+
+/**
+ * @brief 최근 예측 결과
+ */
+const LandingPrediction *landing_predictor_get(const LandingPredictor *lp) {
+    if (lp == NULL) {
+        return NULL;
+    }
+
+    return &lp->out;
+}
+
+/**
+ * @brief 통계
+ */
+const LandingPredictorStats *landing_predictor_get_stats(const LandingPredictor *lp) {
+    if (lp == NULL) {
+        return NULL;
+    }
+
+    return &lp->stats;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file latency_monitor.c
+ * @brief 센서 데이터 준비 에지부터 융합 소비까지의 지연 감시 구현
+ */
+
+#include "nav/latency_monitor.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 측정원 이름 (LatencySource 순서와 일치)
+ */
+static const char *const latency_monitor_source_names[LATENCY_SOURCE_COUNT] = {
+    "imu",
+    "gps",
+    "baro",
+    "mag",
+    "hdg"
+};
+
+/**
+ * @brief 지연이 속한 히스토그램 칸
+ */
+static uint8_t latency_monitor_bin(uint32_t latency_us) {
+    uint32_t q = latency_us / LATENCY_MONITOR_BASE_US;
+    if (q == 0) {
+        return 0;
+    }
+
+    // q의 최상위 비트 위치 + 1 (q = 1 -> 칸 1)
+    uint32_t bin = 32u - (uint32_t)__builtin_clz(q);
+
+    return (bin < LATENCY_MONITOR_BINS) ? (uint8_t)bin : (uint8_t)(LATENCY_MONITOR_BINS - 1u);
+}
+
+/**
+ * @brief 감시기 초기화
+ */
+bool latency_monitor_init(LatencyMonitor *mon) {
+    if (mon == NULL) {
+        return false;
+    }
+
+    latency_monitor_reset(mon);
+
+    return true;
+}
+
+/**
+ * @brief 통계 초기화
+ */
+void latency_monitor_reset(LatencyMonitor *mon) {
+    if (mon == NULL) {
+        return;
+    }
+
+    memset(mon->source, 0, sizeof(mon->source));
+}
+
+/**
+ * @brief 샘플 하나의 지연 기록
+ */
+void latency_monitor_record(LatencyMonitor *mon, LatencySource source, uint32_t timestamp_us, uint32_t now_us) {
+    if (mon == NULL || (uint32_t)source >= LATENCY_SOURCE_COUNT) {
+        return;
+    }
+
+    LatencyStats *st = &mon->source[source];
+    uint32_t latency_us = now_us - timestamp_us;
+    if ((int32_t)latency_us < 0) {
+        // 버스트 앞 샘플의 역산 시각 오차 등으로 측정 시각이 앞서 보이면 0으로 봄
+        latency_us = 0;
+        st->early++;
+    }
+
+    st->samples++;
+    st->total_us += latency_us;
+    st->last_us = latency_us;
+    st->hist[latency_monitor_bin(latency_us)]++;
+    if (latency_us > st->max_us) {
+        st->max_us = latency_us;
+        st->max_timestamp_us = timestamp_us;
+    }
+}
+
+/**
+ * @brief 측정원별 통계 조회
+ */
+const LatencyStats *latency_monitor_get_stats(const LatencyMonitor *mon, LatencySource source) {
+    if (mon == NULL || (uint32_t)source >= LATENCY_SOURCE_COUNT) {
+        return NULL;
+    }
+
+    return &mon->source[source];
+}
+
+/**
+ * @brief 지연 분위수가 속한 히스토그램 칸
+ */
+uint8_t latency_monitor_quantile_bin(const LatencyMonitor *mon, LatencySource source, uint16_t permille) {
+    const LatencyStats *st = latency_monitor_get_stats(mon, source);
+    if (st == NULL || st->samples == 0) {
+        return 0;
+    }
+
+    // 누적 개수가 samples x permille / 1000 이상이 되는 첫 칸
+    uint64_t target = ((uint64_t)st->samples * (permille > 1000u ? 1000u : permille) + 999u) / 1000u;
+    uint64_t sum = 0;
+    for (uint8_t k = 0; k < LATENCY_MONITOR_BINS; k++) {
+        sum += st->hist[k];
+        if (sum >= target && sum > 0) {
+            return k;
+        }
+    }
+
+    return (uint8_t)(LATENCY_MONITOR_BINS - 1u);
+}
+
+/**
+ * @brief 히스토그램 칸의 상한
+ */
+uint32_t latency_monitor_bin_upper_us(uint8_t bin) {
+    if (bin >= LATENCY_MONITOR_BINS - 1u) {
+        return UINT32_MAX;
+    }
+
+    return LATENCY_MONITOR_BASE_US << bin;
+}
+
+/**
+ * @brief 측정원별 지연 통계를 한 줄씩 출력
+ */
+void latency_monitor_report(const LatencyMonitor *mon, ProfileWriteFn write) {
+    if (mon == NULL || write == NULL) {
+        return;
+    }
+
+    char line[200];
+    for (uint8_t i = 0; i < LATENCY_SOURCE_COUNT; i++) {
+        const LatencyStats *st = &mon->source[i];
+        if (st->samples == 0) {
+            continue;
+        }
+
+        uint32_t mean = (uint32_t)(st->total_us / st->samples);
+        uint32_t p99 = latency_monitor_bin_upper_us(latency_monitor_quantile_bin(mon, (LatencySource)i, 990u));
+        if (p99 == UINT32_MAX) {
+            snprintf(line, sizeof(line), "latency %-4s n=%lu mean=%lu max=%lu us at %lu p99>=%lu us early=%lu\r\n",
+                     latency_monitor_source_names[i], (unsigned long)st->samples, (unsigned long)mean,
+                     (unsigned long)st->max_us, (unsigned long)st->max_timestamp_us,
+                     (unsigned long)latency_monitor_bin_upper_us(LATENCY_MONITOR_BINS - 2u),
+                     (unsigned long)st->early);
+        } else {
+            snprintf(line, sizeof(line), "latency %-4s n=%lu mean=%lu max=%lu us at %lu p99<%lu us early=%lu\r\n",
+                     latency_monitor_source_names[i], (unsigned long)st->samples, (unsigned long)mean,
+                     (unsigned long)st->max_us, (unsigned long)st->max_timestamp_us, (unsigned long)p99,
+                     (unsigned long)st->early);
+        }
+        write(line);
+
+        // 히스토그램 (칸 상한 순)
+        int n = snprintf(line, sizeof(line), "lathist %-4s", latency_monitor_source_names[i]);
+        for (uint8_t k = 0; k < LATENCY_MONITOR_BINS && n > 0 && (size_t)n < sizeof(line); k++) {
+            n += snprintf(line + n, sizeof(line) - (size_t)n, " %lu", (unsigned long)st->hist[k]);
+        }
+        if (n > 0 && (size_t)n < sizeof(line) - 2u) {
+            line[n++] = '\r';
+            line[n++] = '\n';
+            line[n] = '\0';
+        }
+        write(line);
+    }
+}
@@ -0,0 +1,264 @@
+/**
+ * @file nav_frames.c
+ * @brief 항법 해의 다중 좌표 표현 지연 계산 구현
+ */
+
+#include "nav/nav_frames.h"
+#include "math/quaternion.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+
+/**
+ * @brief 캐시 초기화
+ */
+bool nav_frames_init(NavFrames *frames, const GeodeticFrame *geo) {
+    if (frames == NULL) {
+        return false;
+    }
+
+    frames->seq = 0;
+    frames->valid = 0;
+    frames->geo = geo;
+    frames->compute_count = 0;
+
+    return true;
+}
+
+/**
+ * @brief 최신 게시 스냅샷으로 갱신
+ */
+bool nav_frames_update(NavFrames *frames, const NavPublisher *pub) {
+    if (frames == NULL || pub == NULL) {
+        return false;
+    }
+
+    // 시퀀스만 먼저 보고 같으면 복사하지 않음
+    uint32_t seq = nav_publisher_seq(pub);
+    if (seq != 0 && seq != frames->seq) {
+        uint32_t read_seq;
+        if (nav_publisher_read(pub, &frames->sol, &read_seq)) {
+            frames->seq = read_seq;
+            frames->valid = 0;
+        } else {
+            // 복사가 깨졌을 수 있으므로 이전 스냅샷도 버림
+            frames->seq = 0;
+            frames->valid = 0;
+        }
+    }
+
+    return frames->seq != 0;
+}
+
+/**
+ * @brief 스냅샷 직접 설정
+ */
+bool nav_frames_set(NavFrames *frames, const EKF_NavSolution *sol, uint32_t seq) {
+    if (frames == NULL || sol == NULL || seq == 0) {
+        return false;
+    }
+
+    if (seq != frames->seq) {
+        frames->sol = *sol;
+        frames->seq = seq;
+        frames->valid = 0;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 오일러 각
+ */
+bool nav_frames_get_euler(NavFrames *frames, float *roll, float *pitch, float *yaw) {
+    if (frames == NULL || roll == NULL || pitch == NULL || yaw == NULL || frames->seq == 0) {
+        return false;
+    }
+
+    if ((frames->valid & NAV_FRAMES_EULER) == 0) {
+        quaternion_to_euler_fast(frames->sol.q, &frames->roll, &frames->pitch, &frames->yaw);
+        frames->valid |= NAV_FRAMES_EULER;
+        frames->compute_count++;
+    }
+
+    *roll = frames->roll;
+    *pitch = frames->pitch;
+    *yaw = frames->yaw;
+
+    return true;
+}
+
+/**
+ * @brief 몸체 -> NED 회전 행렬
+ */
+const float (*nav_frames_get_dcm(NavFrames *frames))[3] {
+    if (frames == NULL || frames->seq == 0) {
+        return NULL;
+    }
+
+    if ((frames->valid & NAV_FRAMES_DCM) == 0) {
+        quaternion_to_rotation_matrix(frames->sol.q, frames->dcm);
+        frames->valid |= NAV_FRAMES_DCM;
+        frames->compute_count++;
+    }
+
+    return (const float (*)[3])frames->dcm;
+}
+
+/**
+ * @brief ECEF 위치
+ */
+bool nav_frames_get_ecef(NavFrames *frames, double ecef[3]) {
+    if (frames == NULL || ecef == NULL || frames->seq == 0 || frames->geo == NULL) {
+        return false;
+    }
+
+    if ((frames->valid & NAV_FRAMES_ECEF) == 0) {
+        if (!geodetic_ned_to_ecef(frames->geo, frames->sol.pos, frames->ecef)) {
+            return false;
+        }
+        frames->valid |= NAV_FRAMES_ECEF;
+        frames->compute_count++;
+    }
+
+    ecef[0] = frames->ecef[0];
+    ecef[1] = frames->ecef[1];
+    ecef[2] = frames->ecef[2];
+
+    return true;
+}
+
+/**
+ * @brief 측지 좌표 (ECEF 캐시를 거쳐 계산)
+ */
+bool nav_frames_get_lla(NavFrames *frames, int32_t *lat_e7, int32_t *lon_e7, int32_t *height_mm) {
+    if (frames == NULL || lat_e7 == NULL || lon_e7 == NULL || height_mm == NULL) {
+        return false;
+    }
+
+    if ((frames->valid & NAV_FRAMES_LLA) == 0) {
+        double ecef[3];
+        if (!nav_frames_get_ecef(frames, ecef) ||
+            !geodetic_ecef_to_lla(ecef, &frames->lat_e7, &frames->lon_e7, &frames->height_mm)) {
+            return false;
+        }
+        frames->valid |= NAV_FRAMES_LLA;
+        frames->compute_count++;
+    }
+
+    *lat_e7 = frames->lat_e7;
+    *lon_e7 = frames->lon_e7;
+    *height_mm = frames->height_mm;
+
+    return true;
+}
+
+/**
+ * @brief 음수 분산을 0으로 잘라 표준 편차로
+ */
+static float nav_frames_std(float var) {
+    return (var > 0.0f) ? fast_sqrtf(var) : 0.0f;
+}
+
+/**
+ * @brief 자세 불확도
+ *
+ * Pθ = G Pq G^T, G = 2 Xi^T. 오일러 자코비안 (몸체 각 오차 → 롤, 피치, 요)은
+ *   [1  sinφ tanθ  cosφ tanθ]
+ *   [0  cosφ       -sinφ    ]
+ *   [0  sinφ/cosθ  cosφ/cosθ]
+ * 이고 R21 = cosθ sinφ, R22 = cosθ cosφ, R20 = -sinθ 이므로 삼각함수 없이 DCM으로 만든다.
+ */
+const NavAttitudeSigma *nav_frames_get_attitude_sigma(NavFrames *frames) {
+    if (frames == NULL || frames->seq == 0) {
+        return NULL;
+    }
+    if ((frames->valid & NAV_FRAMES_ATT_SIGMA) != 0) {
+        return &frames->att_sigma;
+    }
+
+    const float (*R)[3] = nav_frames_get_dcm(frames);
+    NavAttitudeSigma *a = &frames->att_sigma;
+
+    // 압축 4x4 → 밀집
+    float Pq[4][4];
+    uint8_t k = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = i; j < 4; j++) {
+            Pq[i][j] = frames->sol.p_quat[k];
+            Pq[j][i] = frames->sol.p_quat[k];
+            k++;
+        }
+    }
+
+    float Xi[4][3];
+    quaternion_error_jacobian(frames->sol.q, Xi);
+    float PX[4][3];
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            PX[i][j] = Pq[i][0] * Xi[0][j] + Pq[i][1] * Xi[1][j] + Pq[i][2] * Xi[2][j] + Pq[i][3] * Xi[3][j];
+        }
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = i; j < 3; j++) {
+            float sum = Xi[0][i] * PX[0][j] + Xi[1][i] * PX[1][j] + Xi[2][i] * PX[2][j] + Xi[3][i] * PX[3][j];
+            a->cov[i][j] = 4.0f * sum;
+            a->cov[j][i] = 4.0f * sum;
+        }
+    }
+
+    // NED 좌표계: 방위 분산 = r2 Pθ r2^T (r2 = R의 D행), 기울기 분산 = trace - 방위 분산
+    const float (*C)[3] = (const float (*)[3])a->cov;
+    float heading_var = 0.0f;
+    for (uint8_t i = 0; i < 3; i++) {
+        heading_var += R[2][i] * (C[i][0] * R[2][0] + C[i][1] * R[2][1] + C[i][2] * R[2][2]);
+    }
+    float trace = C[0][0] + C[1][1] + C[2][2];
+    a->heading_std = nav_frames_std(heading_var);
+    a->tilt_std = nav_frames_std(trace - heading_var);
+
+    // 오일러 각
+    float cos2 = R[2][1] * R[2][1] + R[2][2] * R[2][2];
+    float cos_pitch = fast_sqrtf(cos2);
+    a->euler_valid = cos_pitch >= NAV_FRAMES_GIMBAL_COS_MIN;
+    if (a->euler_valid) {
+        float inv = 1.0f / cos2;
+        float sin_pitch = -R[2][0];
+        float j0[3] = { 1.0f, R[2][1] * sin_pitch * inv, R[2][2] * sin_pitch * inv };
+        float j2[3] = { 0.0f, R[2][1] * inv, R[2][2] * inv };
+        float roll_var = 0.0f;
+        float yaw_var = 0.0f;
+        for (uint8_t i = 0; i < 3; i++) {
+            float c0 = C[i][0] * j0[0] + C[i][1] * j0[1] + C[i][2] * j0[2];
+            float c2 = C[i][0] * j2[0] + C[i][1] * j2[1] + C[i][2] * j2[2];
+            roll_var += j0[i] * c0;
+            yaw_var += j2[i] * c2;
+        }
+        a->roll_std = nav_frames_std(roll_var);
+        a->yaw_std = nav_frames_std(yaw_var);
+    } else {
+        a->roll_std = 0.0f;
+        a->yaw_std = 0.0f;
+    }
+
+    // 피치 행 [0, cosφ, -sinφ] = [0, R22, -R21] / cosθ (짐벌 근처에서도 cos2로 나누지 않음)
+    float j1[3];
+    if (cos_pitch > 0.0f) {
+        j1[0] = 0.0f;
+        j1[1] = R[2][2] / cos_pitch;
+        j1[2] = -R[2][1] / cos_pitch;
+    } else {
+        j1[0] = 0.0f;
+        j1[1] = 1.0f;
+        j1[2] = 0.0f;
+    }
+    float pitch_var = 0.0f;
+    for (uint8_t i = 0; i < 3; i++) {
+        pitch_var += j1[i] * (C[i][0] * j1[0] + C[i][1] * j1[1] + C[i][2] * j1[2]);
+    }
+    a->pitch_std = nav_frames_std(pitch_var);
+
+    frames->valid |= NAV_FRAMES_ATT_SIGMA;
+    frames->compute_count++;
+
+    return a;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file nav_publisher.c
+ * @brief 시퀀스 카운터 기반 이중 버퍼 항법 해 게시 구현
+ */
+
+#include "nav/nav_publisher.h"
+#include <stddef.h>
+
+/**
+ * @brief 다음 게시에 사용할 (현재 게시되지 않은) 버퍼
+ */
+static EKF_NavSolution *nav_publisher_back(NavPublisher *pub, uint_fast32_t *next) {
+    *next = atomic_load_explicit(&pub->seq, memory_order_relaxed) + 1;
+    return &pub->buffer[*next & 1u];
+}
+
+/**
+ * @brief 채운 버퍼 게시
+ */
+static void nav_publisher_commit(NavPublisher *pub, uint_fast32_t next) {
+    // 버퍼 쓰기가 시퀀스 증가보다 먼저 보이도록 release
+    atomic_store_explicit(&pub->seq, next, memory_order_release);
+}
+
+/**
+ * @brief 게시 버퍼 초기화
+ */
+bool nav_publisher_init(NavPublisher *pub) {
+    if (pub == NULL) {
+        return false;
+    }
+
+    atomic_init(&pub->seq, 0);
+
+    return true;
+}
+
+/**
+ * @brief 스냅샷 게시
+ */
+bool nav_publisher_write(NavPublisher *pub, const EKF_NavSolution *sol) {
+    if (pub == NULL || sol == NULL) {
+        return false;
+    }
+
+    uint_fast32_t next;
+    *nav_publisher_back(pub, &next) = *sol;
+    nav_publisher_commit(pub, next);
+
+    return true;
+}
+
+/**
+ * @brief EKF의 현재 항법 해를 스냅샷으로 게시
+ */
+bool nav_publisher_write_ekf(NavPublisher *pub, const EKF *ekf, uint32_t timestamp_us) {
+    if (pub == NULL || ekf == NULL) {
+        return false;
+    }
+
+    uint_fast32_t next;
+    if (!ekf_get_nav_solution(ekf, timestamp_us, nav_publisher_back(pub, &next))) {
+        return false;
+    }
+    nav_publisher_commit(pub, next);
+
+    return true;
+}
+
+/**
+ * @brief 최신 스냅샷 읽기
+ */
+bool nav_publisher_read(const NavPublisher *pub, EKF_NavSolution *sol, uint32_t *seq) {
+    if (pub == NULL || sol == NULL) {
+        return false;
+    }
+
+    for (uint8_t attempt = 0; attempt < NAV_PUBLISHER_MAX_RETRIES; attempt++) {
+        uint_fast32_t before = atomic_load_explicit(&pub->seq, memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        *sol = pub->buffer[before & 1u];
+
+        // 복사가 두 번째 시퀀스 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(&pub->seq, memory_order_relaxed);
+
+        // 한 번 게시는 반대쪽 버퍼에 쓰므로 복사본에 영향 없음
+        if (after - before < 2) {
+            if (seq != NULL) {
+                *seq = (uint32_t)before;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 최신 게시 시퀀스
+ */
+uint32_t nav_publisher_seq(const NavPublisher *pub) {
+    if (pub == NULL) {
+        return 0;
+    }
+
+    return (uint32_t)atomic_load_explicit(&pub->seq, memory_order_acquire);
+}
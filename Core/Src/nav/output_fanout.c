@@ -0,0 +1,340 @@
+/**
+ * @file output_fanout.c
+ * @brief 다중 주기 출력 배포 구현
+ */
+
+#include "nav/output_fanout.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 배포기 초기화
+ */
+bool output_fanout_init(OutputFanout *fan) {
+    if (fan == NULL) {
+        return false;
+    }
+
+    memset(fan, 0, sizeof(*fan));
+    for (uint8_t i = 0; i < OUTPUT_FANOUT_MAX_SUBSCRIBERS; i++) {
+        atomic_init(&fan->sub[i].seq, 0);
+    }
+    fan->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 구독자 추가
+ */
+bool output_fanout_subscribe(OutputFanout *fan, const OutputFanoutSubscriberConfig *config, uint8_t *id) {
+    if (fan == NULL || !fan->initialized || config == NULL || id == NULL ||
+        fan->count >= OUTPUT_FANOUT_MAX_SUBSCRIBERS) {
+        return false;
+    }
+    if (config->rate_hz == 0 || config->rate_hz > OUTPUT_FANOUT_MAX_RATE_HZ ||
+        config->format >= OUTPUT_FANOUT_FORMAT_COUNT) {
+        return false;
+    }
+
+    OutputFanoutSubscriber *s = &fan->sub[fan->count];
+    s->config = *config;
+    s->period_us = 1000000u / config->rate_hz;
+    s->started = false;
+    s->n = 0;
+    atomic_store_explicit(&s->seq, 0, memory_order_relaxed);
+
+    *id = fan->count++;
+
+    return true;
+}
+
+/**
+ * @brief 고정소수점 변환 (반올림, 범위 밖은 포화, NaN은 0)
+ */
+static int16_t output_fanout_q16(float v, float lsb) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > 32767.0f) {
+        return 32767;
+    }
+    if (q < -32767.0f) {
+        return -32767;
+    }
+    return (int16_t)lrintf(q);
+}
+
+static int32_t output_fanout_q32(float v, float lsb) {
+    float q = v / lsb;
+    if (!isfinite(q)) {
+        return 0;
+    }
+    if (q > 2.0e9f) {
+        return 2000000000;
+    }
+    if (q < -2.0e9f) {
+        return -2000000000;
+    }
+    return (int32_t)lrintf(q);
+}
+
+/**
+ * @brief 항법 해를 형식으로 변환
+ */
+static void output_fanout_convert(uint8_t format, const EKF_NavSolution *sol, OutputFanoutMessage *msg) {
+    switch (format) {
+    case OUTPUT_FANOUT_FORMAT_STATE: {
+        OutputFanoutState *st = &msg->state;
+        st->timestamp_us = sol->timestamp_us;
+        st->pos[0] = sol->pos.x;
+        st->pos[1] = sol->pos.y;
+        st->pos[2] = sol->pos.z;
+        st->vel[0] = sol->vel.x;
+        st->vel[1] = sol->vel.y;
+        st->vel[2] = sol->vel.z;
+        st->q[0] = sol->q.w;
+        st->q[1] = sol->q.x;
+        st->q[2] = sol->q.y;
+        st->q[3] = sol->q.z;
+        quaternion_to_euler(sol->q, &st->euler[0], &st->euler[1], &st->euler[2]);
+        break;
+    }
+    case OUTPUT_FANOUT_FORMAT_PACKED: {
+        OutputFanoutPacked *pk = &msg->packed;
+        pk->timestamp_us = sol->timestamp_us;
+        pk->pos[0] = output_fanout_q32(sol->pos.x, OUTPUT_FANOUT_POS_LSB);
+        pk->pos[1] = output_fanout_q32(sol->pos.y, OUTPUT_FANOUT_POS_LSB);
+        pk->pos[2] = output_fanout_q32(sol->pos.z, OUTPUT_FANOUT_POS_LSB);
+        pk->vel[0] = output_fanout_q16(sol->vel.x, OUTPUT_FANOUT_VEL_LSB);
+        pk->vel[1] = output_fanout_q16(sol->vel.y, OUTPUT_FANOUT_VEL_LSB);
+        pk->vel[2] = output_fanout_q16(sol->vel.z, OUTPUT_FANOUT_VEL_LSB);
+        pk->q[0] = output_fanout_q16(sol->q.w, OUTPUT_FANOUT_QUAT_LSB);
+        pk->q[1] = output_fanout_q16(sol->q.x, OUTPUT_FANOUT_QUAT_LSB);
+        pk->q[2] = output_fanout_q16(sol->q.y, OUTPUT_FANOUT_QUAT_LSB);
+        pk->q[3] = output_fanout_q16(sol->q.z, OUTPUT_FANOUT_QUAT_LSB);
+        pk->seq = 0;
+        break;
+    }
+    default:
+        msg->nav = *sol;
+        break;
+    }
+}
+
+/**
+ * @brief 이번 입력의 형식별 변환 결과 (처음 쓰일 때만 변환)
+ */
+static const OutputFanoutMessage *output_fanout_cached(OutputFanout *fan, uint8_t format, const EKF_NavSolution *sol) {
+    if (fan->cache_epoch[format] != fan->epoch) {
+        output_fanout_convert(format, sol, &fan->cache[format]);
+        fan->cache_epoch[format] = fan->epoch;
+        fan->stats.conversions[format]++;
+    }
+
+    return &fan->cache[format];
+}
+
+/**
+ * @brief 앤티에일리어싱 창에 입력 누적
+ */
+static void output_fanout_accumulate(OutputFanoutSubscriber *s, const EKF_NavSolution *sol) {
+    float w = sol->q.w;
+    float x = sol->q.x;
+    float y = sol->q.y;
+    float z = sol->q.z;
+
+    if (s->n == 0) {
+        s->pos_sum = vector3f_zero();
+        s->vel_sum = vector3f_zero();
+        memset(s->q_sum, 0, sizeof(s->q_sum));
+        s->first_us = sol->timestamp_us;
+        s->offset_sum_us = 0;
+    } else if (s->q_sum[0] * w + s->q_sum[1] * x + s->q_sum[2] * y + s->q_sum[3] * z < 0.0f) {
+        // q와 -q는 같은 자세: 합 쪽으로 부호를 맞춤
+        w = -w;
+        x = -x;
+        y = -y;
+        z = -z;
+    }
+
+    s->pos_sum = vector3f_add(s->pos_sum, sol->pos);
+    s->vel_sum = vector3f_add(s->vel_sum, sol->vel);
+    s->q_sum[0] += w;
+    s->q_sum[1] += x;
+    s->q_sum[2] += y;
+    s->q_sum[3] += z;
+    s->offset_sum_us += sol->timestamp_us - s->first_us;
+    if (s->n < UINT16_MAX) {
+        s->n++;
+    }
+}
+
+/**
+ * @brief 앤티에일리어싱 창 평균 (나머지 필드는 마지막 입력)
+ */
+static void output_fanout_average(OutputFanoutSubscriber *s, const EKF_NavSolution *sol, EKF_NavSolution *avg) {
+    float inv = 1.0f / (float)s->n;
+
+    *avg = *sol;
+    avg->timestamp_us = s->first_us + (uint32_t)(s->offset_sum_us / s->n);
+    avg->pos = vector3f_scale(s->pos_sum, inv);
+    avg->vel = vector3f_scale(s->vel_sum, inv);
+    avg->q = quaternion_normalize(quaternion_create(s->q_sum[0], s->q_sum[1], s->q_sum[2], s->q_sum[3]));
+    s->n = 0;
+}
+
+/**
+ * @brief 구독자 우편함에 게시
+ */
+static void output_fanout_post(OutputFanout *fan, OutputFanoutSubscriber *s, uint8_t id,
+                               const OutputFanoutMessage *msg) {
+    uint_fast32_t next = atomic_load_explicit(&s->seq, memory_order_relaxed) + 1;
+    OutputFanoutMessage *box = &s->box[next & 1u];
+
+    memcpy(box, msg, output_fanout_format_size(s->config.format));
+    if (s->config.format == OUTPUT_FANOUT_FORMAT_PACKED) {
+        box->packed.seq = (uint16_t)next;
+    }
+
+    // 메시지 쓰기가 순번 증가보다 먼저 보이도록 release
+    atomic_store_explicit(&s->seq, next, memory_order_release);
+    fan->stats.posts++;
+
+    if (s->config.notify != NULL) {
+        s->config.notify(s->config.context, id, (uint32_t)next);
+    }
+}
+
+/**
+ * @brief 출력 하나 입력
+ */
+uint8_t output_fanout_feed(OutputFanout *fan, const EKF_NavSolution *sol) {
+    if (fan == NULL || !fan->initialized || sol == NULL) {
+        return 0;
+    }
+
+    uint32_t t = sol->timestamp_us;
+    if (fan->has_input) {
+        fan->last_dt_us = t - fan->last_us;
+    }
+    fan->last_us = t;
+    fan->has_input = true;
+    fan->epoch++;
+    if (fan->epoch == 0) {
+        // 0은 변환 결과 없음 표시
+        memset(fan->cache_epoch, 0, sizeof(fan->cache_epoch));
+        fan->epoch = 1;
+    }
+    fan->stats.feeds++;
+
+    uint8_t posted = 0;
+    for (uint8_t i = 0; i < fan->count; i++) {
+        OutputFanoutSubscriber *s = &fan->sub[i];
+        if (s->config.anti_alias) {
+            output_fanout_accumulate(s, sol);
+        }
+
+        // 입력 간격의 절반 여유로, 흔들림이 있어도 주기마다 한 번
+        if (!s->started) {
+            s->next_us = t;
+            s->started = true;
+        }
+        if ((int32_t)(t + fan->last_dt_us / 2u - s->next_us) < 0) {
+            continue;
+        }
+        s->next_us += s->period_us;
+        if ((int32_t)(t - s->next_us) >= 0) {
+            s->next_us = t + s->period_us;
+            fan->stats.resyncs++;
+        }
+
+        if (s->config.anti_alias) {
+            EKF_NavSolution avg;
+            OutputFanoutMessage msg;
+            output_fanout_average(s, sol, &avg);
+            output_fanout_convert(s->config.format, &avg, &msg);
+            fan->stats.conversions[s->config.format]++;
+            output_fanout_post(fan, s, i, &msg);
+        } else {
+            output_fanout_post(fan, s, i, output_fanout_cached(fan, s->config.format, sol));
+        }
+        posted++;
+    }
+
+    return posted;
+}
+
+/**
+ * @brief 구독자의 최신 메시지 읽기
+ */
+bool output_fanout_read(const OutputFanout *fan, uint8_t id, void *out, uint32_t *seq) {
+    if (fan == NULL || out == NULL || id >= fan->count) {
+        return false;
+    }
+
+    const OutputFanoutSubscriber *s = &fan->sub[id];
+    uint16_t size = output_fanout_format_size(s->config.format);
+
+    for (uint8_t attempt = 0; attempt < OUTPUT_FANOUT_MAX_RETRIES; attempt++) {
+        uint_fast32_t before = atomic_load_explicit(&s->seq, memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        memcpy(out, &s->box[before & 1u], size);
+
+        // 복사가 두 번째 순번 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(&s->seq, memory_order_relaxed);
+
+        if (after - before < 2) {
+            if (seq != NULL) {
+                *seq = (uint32_t)before;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 구독자의 최신 게시 순번
+ */
+uint32_t output_fanout_seq(const OutputFanout *fan, uint8_t id) {
+    if (fan == NULL || id >= fan->count) {
+        return 0;
+    }
+
+    return (uint32_t)atomic_load_explicit(&fan->sub[id].seq, memory_order_acquire);
+}
+
+/**
+ * @brief 형식별 메시지 크기
+ */
+uint16_t output_fanout_format_size(uint8_t format) {
+    switch (format) {
+    case OUTPUT_FANOUT_FORMAT_NAV:
+        return (uint16_t)sizeof(EKF_NavSolution);
+    case OUTPUT_FANOUT_FORMAT_STATE:
+        return (uint16_t)sizeof(OutputFanoutState);
+    case OUTPUT_FANOUT_FORMAT_PACKED:
+        return (uint16_t)sizeof(OutputFanoutPacked);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief 통계
+ */
+const OutputFanoutStats *output_fanout_get_stats(const OutputFanout *fan) {
+    if (fan == NULL) {
+        return NULL;
+    }
+
+    return &fan->stats;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file output_predictor.c
+ * @brief 저지연 출력 예측기 구현
+ */
+
+#include "nav/output_predictor.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 이력에 현재 출력 기록
+ */
+static void output_predictor_record(OutputPredictor *op, uint32_t timestamp_us) {
+    OutputPredictorSample *s = &op->history[op->head];
+    s->timestamp_us = timestamp_us;
+    s->pos = op->pos;
+    s->vel = op->vel;
+    s->pos_applied = op->pos_applied;
+    s->vel_applied = op->vel_applied;
+
+    op->head = (uint16_t)((op->head + 1u) % ATTITUDE_FAST_HISTORY);
+    if (op->count < ATTITUDE_FAST_HISTORY) {
+        op->count++;
+    }
+}
+
+/**
+ * @brief 주어진 시각 이전의 가장 최근 이력 (없으면 가장 오래된 이력)
+ */
+static const OutputPredictorSample *output_predictor_lookup(OutputPredictor *op, uint32_t timestamp_us) {
+    const OutputPredictorSample *s = NULL;
+    for (uint16_t i = 1; i <= op->count; i++) {
+        s = &op->history[(op->head + ATTITUDE_FAST_HISTORY - i) % ATTITUDE_FAST_HISTORY];
+        if ((int32_t)(timestamp_us - s->timestamp_us) >= 0) {
+            return s;
+        }
+    }
+
+    op->stats.stale++;
+    return s;
+}
+
+/**
+ * @brief 남은 오차의 frac 비율을 상태에 적용
+ */
+static void output_predictor_correct(Vector3f *state, Vector3f *error, Vector3f *applied, float frac) {
+    Vector3f step = vector3f_scale(*error, frac);
+    *state = vector3f_add(*state, step);
+    *error = vector3f_subtract(*error, step);
+    *applied = vector3f_add(*applied, step);
+}
+
+/**
+ * @brief 현재 출력을 항법 해로 채움
+ */
+static void output_predictor_fill(const OutputPredictor *op, EKF_NavSolution *sol) {
+    *sol = op->latest;
+    sol->timestamp_us = op->last_us;
+    sol->pos = op->pos;
+    sol->vel = op->vel;
+    sol->q = op->attitude.q;
+    sol->gyro_bias = op->attitude.gyro_bias;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool output_predictor_default_config(OutputPredictorConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    attitude_fast_default_config(&config->attitude);
+    config->vel_gain = OUTPUT_PREDICTOR_DEFAULT_VEL_GAIN;
+    config->pos_gain = OUTPUT_PREDICTOR_DEFAULT_POS_GAIN;
+    config->gravity = OUTPUT_PREDICTOR_DEFAULT_GRAVITY;
+    config->publish_decimation = 1;
+
+    return true;
+}
+
+/**
+ * @brief 출력 예측기 초기화
+ */
+bool output_predictor_init(OutputPredictor *op, const OutputPredictorConfig *config) {
+    if (op == NULL) {
+        return false;
+    }
+
+    OutputPredictorConfig c;
+    if (config != NULL) {
+        c = *config;
+    } else {
+        output_predictor_default_config(&c);
+    }
+    if (!(c.vel_gain >= 0.0f) || !(c.pos_gain >= 0.0f) || !(c.gravity > 0.0f) || c.publish_decimation == 0) {
+        return false;
+    }
+
+    memset(op, 0, sizeof(*op));
+    if (!attitude_fast_init(&op->attitude, &c.attitude)) {
+        return false;
+    }
+    op->config = c;
+
+    return true;
+}
+
+/**
+ * @brief 출력 게시 버퍼 설정
+ */
+bool output_predictor_set_publisher(OutputPredictor *op, NavPublisher *publisher) {
+    if (op == NULL) {
+        return false;
+    }
+
+    op->publisher = publisher;
+    op->publish_count = 0;
+
+    return true;
+}
+
+/**
+ * @brief 다중 주기 배포기 설정
+ */
+bool output_predictor_set_fanout(OutputPredictor *op, OutputFanout *fanout) {
+    if (op == NULL) {
+        return false;
+    }
+
+    op->fanout = fanout;
+
+    return true;
+}
+
+/**
+ * @brief 사건 시각 보간기 설정
+ */
+bool output_predictor_set_tagger(OutputPredictor *op, EventTagger *tagger) {
+    if (op == NULL) {
+        return false;
+    }
+
+    op->tagger = tagger;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 하나 전파
+ */
+bool output_predictor_step(OutputPredictor *op, uint32_t timestamp_us, Vector3f gyro, Vector3f accel) {
+    if (op == NULL) {
+        return false;
+    }
+
+    uint32_t dt_us = timestamp_us - op->last_us;
+    op->last_us = timestamp_us;
+    if (!attitude_fast_step(&op->attitude, timestamp_us, gyro)) {
+        output_predictor_record(op, timestamp_us);
+        return false;
+    }
+    float dt = (float)dt_us * 1e-6f;
+
+    // ekf_integrate_state와 같은 순서: 적분 후 자세로 비력 회전, 속도 -> 위치
+    float R[3][3];
+    quaternion_to_rotation_matrix(op->attitude.q, R);
+    Vector3f f = vector3f_subtract(accel, op->accel_bias);
+    float an = R[0][0] * f.x + R[0][1] * f.y + R[0][2] * f.z;
+    float ae = R[1][0] * f.x + R[1][1] * f.y + R[1][2] * f.z;
+    float ad = R[2][0] * f.x + R[2][1] * f.y + R[2][2] * f.z - op->config.gravity;
+
+    op->vel.x += an * dt;
+    op->vel.y += ae * dt;
+    op->vel.z += ad * dt;
+    op->pos = vector3f_add(op->pos, vector3f_scale(op->vel, dt));
+
+    if (op->ready) {
+        float frac_v = op->config.vel_gain * dt;
+        float frac_p = op->config.pos_gain * dt;
+        output_predictor_correct(&op->vel, &op->vel_error, &op->vel_applied, (frac_v < 1.0f) ? frac_v : 1.0f);
+        output_predictor_correct(&op->pos, &op->pos_error, &op->pos_applied, (frac_p < 1.0f) ? frac_p : 1.0f);
+    }
+
+    output_predictor_record(op, timestamp_us);
+    op->stats.steps++;
+
+    bool publish = op->publisher != NULL && op->ready && ++op->publish_count >= op->config.publish_decimation;
+    if (publish || ((op->fanout != NULL || op->tagger != NULL) && op->ready)) {
+        EKF_NavSolution out;
+        output_predictor_fill(op, &out);
+        if (publish) {
+            if (nav_publisher_write(op->publisher, &out)) {
+                op->stats.publishes++;
+            }
+            op->publish_count = 0;
+        }
+        if (op->fanout != NULL) {
+            output_fanout_feed(op->fanout, &out);
+        }
+        if (op->tagger != NULL) {
+            event_tagger_push(op->tagger, &out);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief EKF 항법 해 반영
+ */
+bool output_predictor_inject(OutputPredictor *op, const EKF_NavSolution *sol) {
+    if (op == NULL || sol == NULL || !attitude_fast_inject(&op->attitude, sol)) {
+        return false;
+    }
+
+    op->latest = *sol;
+    op->accel_bias = sol->accel_bias;
+
+    // 해 시각의 출력과 비교 (이후 적용한 보정 차감, 지연 구간의 속도 오차 누적 가산)
+    const OutputPredictorSample *h = output_predictor_lookup(op, sol->timestamp_us);
+    Vector3f ev = vector3f_subtract(vector3f_subtract(sol->vel, h->vel),
+                                    vector3f_subtract(op->vel_applied, h->vel_applied));
+    Vector3f ep = vector3f_subtract(vector3f_subtract(sol->pos, h->pos),
+                                    vector3f_subtract(op->pos_applied, h->pos_applied));
+    float latency = (float)(op->last_us - h->timestamp_us) * 1e-6f;
+    ep = vector3f_add(ep, vector3f_scale(ev, latency));
+
+    op->stats.last_pos_error = vector3f_magnitude(ep);
+    op->stats.last_vel_error = vector3f_magnitude(ev);
+    op->stats.injections++;
+
+    if (!op->ready) {
+        // 첫 해: 곧바로 반영하고 이력도 같은 만큼 옮김
+        op->pos = vector3f_add(op->pos, ep);
+        op->vel = vector3f_add(op->vel, ev);
+        for (uint16_t i = 0; i < op->count; i++) {
+            op->history[i].pos = vector3f_add(op->history[i].pos, ep);
+            op->history[i].vel = vector3f_add(op->history[i].vel, ev);
+        }
+        op->pos_error = vector3f_zero();
+        op->vel_error = vector3f_zero();
+        op->ready = true;
+        return true;
+    }
+
+    op->pos_error = ep;
+    op->vel_error = ev;
+
+    return true;
+}
+
+/**
+ * @brief 입력 게시 버퍼에 새 해가 있으면 반영
+ */
+bool output_predictor_sync(OutputPredictor *op, const NavPublisher *source) {
+    if (op == NULL || source == NULL || source == op->publisher) {
+        return false;
+    }
+
+    uint32_t seq = (uint32_t)atomic_load_explicit(&source->seq, memory_order_acquire);
+    if (seq == 0 || seq == op->last_seq) {
+        return false;
+    }
+
+    EKF_NavSolution sol;
+    if (!nav_publisher_read(source, &sol, &seq)) {
+        return false;
+    }
+    op->last_seq = seq;
+
+    return output_predictor_inject(op, &sol);
+}
+
+/**
+ * @brief 현재 출력
+ */
+bool output_predictor_get_solution(const OutputPredictor *op, EKF_NavSolution *sol) {
+    if (op == NULL || sol == NULL) {
+        return false;
+    }
+
+    output_predictor_fill(op, sol);
+
+    return op->ready;
+}
+
+/**
+ * @brief 통계 조회
+ */
+const OutputPredictorStats *output_predictor_get_stats(const OutputPredictor *op) {
+    return (op != NULL) ? &op->stats : NULL;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file predict_rate.c
+ * @brief 적응 예측 주기 구현
+ */
+
+#include "nav/predict_rate.h"
+#include "math/fast_math.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool predict_rate_default_config(PredictRateConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->min_samples = PREDICT_RATE_DEFAULT_MIN_SAMPLES;
+    config->max_samples = PREDICT_RATE_DEFAULT_MAX_SAMPLES;
+    config->max_dt = PREDICT_RATE_DEFAULT_MAX_DT;
+    config->rate_ref = PREDICT_RATE_DEFAULT_RATE_REF;
+    config->jerk_ref = PREDICT_RATE_DEFAULT_JERK_REF;
+    config->nis_ref = PREDICT_RATE_DEFAULT_NIS_REF;
+    config->nis_decay_s = PREDICT_RATE_DEFAULT_NIS_DECAY_S;
+    config->jerk_alpha = PREDICT_RATE_DEFAULT_JERK_ALPHA;
+
+    return true;
+}
+
+/**
+ * @brief 제어기 초기화
+ */
+bool predict_rate_init(PredictRate *rate, const PredictRateConfig *config) {
+    if (rate == NULL) {
+        return false;
+    }
+
+    PredictRateConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        predict_rate_default_config(&cfg);
+    }
+    if (cfg.min_samples == 0 || cfg.max_samples < cfg.min_samples || !(cfg.max_dt > 0.0f) ||
+        !(cfg.rate_ref > 0.0f) || !(cfg.jerk_ref > 0.0f) || !(cfg.nis_ref > 0.0f) ||
+        !(cfg.nis_decay_s > 0.0f) || !(cfg.jerk_alpha > 0.0f) || cfg.jerk_alpha > 1.0f) {
+        return false;
+    }
+
+    memset(rate, 0, sizeof(*rate));
+    rate->config = cfg;
+    ekf_preint_init(&rate->preint);
+    rate->stats.target = cfg.max_samples;
+    rate->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 최근 측정 갱신의 혁신 크기 반영
+ */
+bool predict_rate_note_innovation(PredictRate *rate, float nis, uint8_t dof) {
+    if (rate == NULL || !rate->initialized || dof == 0 || !(nis >= 0.0f)) {
+        return false;
+    }
+
+    float v = nis / (float)dof;
+    if (v > rate->nis_activity) {
+        rate->nis_activity = v;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 활동도에서 목표 간격 계산
+ */
+static uint16_t predict_rate_target(const PredictRateConfig *cfg, float activity) {
+    float ratio = (float)cfg->max_samples / (float)cfg->min_samples;
+    float n = (float)cfg->max_samples / (1.0f + activity * (ratio - 1.0f));
+    uint16_t target = (uint16_t)(n + 0.5f);
+
+    if (target < cfg->min_samples) {
+        target = cfg->min_samples;
+    } else if (target > cfg->max_samples) {
+        target = cfg->max_samples;
+    }
+
+    return target;
+}
+
+/**
+ * @brief 누적분을 등가 샘플로 꺼내고 다음 구간 바이어스 설정
+ */
+static bool predict_rate_extract(PredictRate *rate, const EKF *ekf, EKF_ImuSample *out) {
+    uint16_t count = rate->preint.count;
+    if (!ekf_preint_extract(&rate->preint, out)) {
+        return false;
+    }
+
+    rate->stats.predicts++;
+    if (count == 1) {
+        rate->stats.full_rate++;
+    }
+    if (ekf != NULL) {
+        ekf_preint_set_gyro_bias(&rate->preint, ekf_get_gyro_bias(ekf));
+    }
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 누적
+ */
+bool predict_rate_add(PredictRate *rate, const EKF_ImuSample *imu, uint32_t timestamp_us,
+                      const EKF *ekf, EKF_ImuSample *out) {
+    if (rate == NULL || !rate->initialized || imu == NULL || out == NULL || !(imu->dt > 0.0f)) {
+        return false;
+    }
+
+    const PredictRateConfig *cfg = &rate->config;
+    if (!ekf_preint_add(&rate->preint, imu->gyro, imu->accel, imu->dt)) {
+        return false;
+    }
+    rate->last_us = timestamp_us;
+    rate->stats.samples++;
+
+    // 저크 (가속도 차분의 저역 통과)
+    if (rate->has_accel) {
+        float j = vector3f_magnitude(vector3f_subtract(imu->accel, rate->last_accel)) / imu->dt;
+        rate->jerk += cfg->jerk_alpha * (j - rate->jerk);
+    }
+    rate->last_accel = imu->accel;
+    rate->has_accel = true;
+
+    // 혁신 활동도 감소
+    rate->nis_activity *= fp_expf(-imu->dt / cfg->nis_decay_s);
+
+    Vector3f w = vector3f_subtract(imu->gyro, rate->preint.gyro_bias);
+    float a = vector3f_magnitude(w) / cfg->rate_ref;
+    float aj = rate->jerk / cfg->jerk_ref;
+    float an = rate->nis_activity / cfg->nis_ref;
+    if (aj > a) {
+        a = aj;
+    }
+    if (an > a) {
+        a = an;
+    }
+    if (!(a <= 1.0f)) {
+        // NaN도 전 주기
+        a = 1.0f;
+    }
+    rate->stats.activity = a;
+    rate->stats.target = predict_rate_target(cfg, a);
+
+    if (rate->preint.count < rate->stats.target && rate->preint.dt < cfg->max_dt) {
+        return false;
+    }
+
+    return predict_rate_extract(rate, ekf, out);
+}
+
+/**
+ * @brief 누적분 강제 추출
+ */
+bool predict_rate_flush(PredictRate *rate, const EKF *ekf, EKF_ImuSample *out, uint32_t *timestamp_us) {
+    if (rate == NULL || !rate->initialized || out == NULL || rate->preint.count == 0) {
+        return false;
+    }
+
+    if (!predict_rate_extract(rate, ekf, out)) {
+        return false;
+    }
+    rate->stats.flushes++;
+    if (timestamp_us != NULL) {
+        *timestamp_us = rate->last_us;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 누적 중인 샘플 수
+ */
+uint16_t predict_rate_pending(const PredictRate *rate) {
+    return (rate != NULL) ? rate->preint.count : 0;
+}
+
+/**
+ * @brief 통계
+ */
+const PredictRateStats *predict_rate_get_stats(const PredictRate *rate) {
+    if (rate == NULL) {
+        return NULL;
+    }
+
+    return &rate->stats;
+}
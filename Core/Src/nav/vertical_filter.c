@@ -0,0 +1,205 @@
+/**
+ * @file vertical_filter.c
+ * @brief 분리된 고속 수직 채널 필터 구현
+ */
+
+#include "nav/vertical_filter.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool vertical_filter_default_config(VerticalFilterConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->accel_std = VERTICAL_FILTER_DEFAULT_ACCEL_STD;
+    config->bias_walk = VERTICAL_FILTER_DEFAULT_BIAS_WALK;
+    config->baro_std = VERTICAL_FILTER_DEFAULT_BARO_STD;
+    config->nis_gate = VERTICAL_FILTER_DEFAULT_NIS_GATE;
+    config->init_vel_std = VERTICAL_FILTER_DEFAULT_INIT_VEL_STD;
+    config->init_bias_std = VERTICAL_FILTER_DEFAULT_INIT_BIAS_STD;
+    config->gravity = VERTICAL_FILTER_DEFAULT_GRAVITY;
+
+    return true;
+}
+
+/**
+ * @brief 필터 초기화
+ */
+bool vertical_filter_init(VerticalFilter *vf, const VerticalFilterConfig *config) {
+    if (vf == NULL) {
+        return false;
+    }
+
+    VerticalFilterConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        vertical_filter_default_config(&cfg);
+    }
+    if (!(cfg.accel_std > 0.0f) || !(cfg.bias_walk >= 0.0f) || !(cfg.baro_std > 0.0f) ||
+        !(cfg.nis_gate >= 0.0f) || !(cfg.init_vel_std > 0.0f) || !(cfg.init_bias_std >= 0.0f) ||
+        !(cfg.gravity > 0.0f)) {
+        return false;
+    }
+
+    memset(vf, 0, sizeof(*vf));
+    vf->config = cfg;
+    vf->r_baro = cfg.baro_std * cfg.baro_std;
+
+    return true;
+}
+
+/**
+ * @brief 상태 재설정
+ */
+bool vertical_filter_reset(VerticalFilter *vf, float alt, float vel) {
+    if (vf == NULL) {
+        return false;
+    }
+
+    vf->alt = alt;
+    vf->vel = vel;
+    vf->bias = 0.0f;
+    vf->accel = 0.0f;
+    memset(vf->P, 0, sizeof(vf->P));
+    vf->P[0][0] = vf->r_baro;
+    vf->P[1][1] = vf->config.init_vel_std * vf->config.init_vel_std;
+    vf->P[2][2] = vf->config.init_bias_std * vf->config.init_bias_std;
+    vf->ready = true;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 하나로 예측
+ */
+bool vertical_filter_predict(VerticalFilter *vf, Quaternion q, Vector3f accel, float dt) {
+    if (vf == NULL || !vf->ready || !(dt > 0.0f) || dt > VERTICAL_FILTER_MAX_DT) {
+        return false;
+    }
+
+    // 회전 행렬 셋째 행 (quaternion_to_rotation_matrix의 R[2])
+    float r20 = 2.0f * (q.x * q.z - q.w * q.y);
+    float r21 = 2.0f * (q.y * q.z + q.w * q.x);
+    float r22 = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+    float a = r20 * accel.x + r21 * accel.y + r22 * accel.z - vf->config.gravity - vf->bias;
+
+    float half_dt2 = 0.5f * dt * dt;
+    vf->alt += vf->vel * dt + a * half_dt2;
+    vf->vel += a * dt;
+    vf->accel = a;
+
+    // P = F P F^T (F = [1 dt -dt^2/2; 0 1 -dt; 0 0 1])
+    float p00 = vf->P[0][0], p01 = vf->P[0][1], p02 = vf->P[0][2];
+    float p11 = vf->P[1][1], p12 = vf->P[1][2], p22 = vf->P[2][2];
+
+    float a0 = p00 + dt * p01 - half_dt2 * p02;
+    float a1 = p01 + dt * p11 - half_dt2 * p12;
+    float a2 = p02 + dt * p12 - half_dt2 * p22;
+    float b1 = p11 - dt * p12;
+    float b2 = p12 - dt * p22;
+
+    // Q: 가속도 백색 잡음 σ_a^2 [dt^3/3 dt^2/2; dt^2/2 dt], 바이어스 σ_b^2 dt
+    float qa = vf->config.accel_std * vf->config.accel_std * dt;
+    float qb = vf->config.bias_walk * vf->config.bias_walk * dt;
+
+    vf->P[0][0] = a0 + dt * a1 - half_dt2 * a2 + qa * dt * dt * (1.0f / 3.0f);
+    vf->P[0][1] = a1 - dt * a2 + qa * 0.5f * dt;
+    vf->P[0][2] = a2;
+    vf->P[1][1] = b1 - dt * b2 + qa;
+    vf->P[1][2] = b2;
+    vf->P[2][2] = p22 + qb;
+    vf->P[1][0] = vf->P[0][1];
+    vf->P[2][0] = vf->P[0][2];
+    vf->P[2][1] = vf->P[1][2];
+
+    vf->stats.predicts++;
+
+    return true;
+}
+
+/**
+ * @brief 기압 고도 측정 갱신
+ */
+bool vertical_filter_update_baro(VerticalFilter *vf, float baro_alt) {
+    if (vf == NULL) {
+        return false;
+    }
+
+    if (!vf->ready) {
+        vertical_filter_reset(vf, baro_alt, 0.0f);
+        vf->stats.baro_updates++;
+        return true;
+    }
+
+    // H = [1 0 0]: S = P00 + R, K = P[:,0] / S
+    float y = baro_alt - vf->alt;
+    float s = vf->P[0][0] + vf->r_baro;
+    float nis = y * y / s;
+    vf->stats.last_nis = nis;
+    if (vf->config.nis_gate > 0.0f && nis > vf->config.nis_gate) {
+        vf->stats.baro_rejects++;
+        return false;
+    }
+
+    float inv_s = 1.0f / s;
+    float k0 = vf->P[0][0] * inv_s;
+    float k1 = vf->P[0][1] * inv_s;
+    float k2 = vf->P[0][2] * inv_s;
+
+    vf->alt += k0 * y;
+    vf->vel += k1 * y;
+    vf->bias += k2 * y;
+
+    // P = P - K H P (대칭 원소만 계산)
+    float p00 = vf->P[0][0], p01 = vf->P[0][1], p02 = vf->P[0][2];
+    vf->P[0][0] -= k0 * p00;
+    vf->P[0][1] -= k0 * p01;
+    vf->P[0][2] -= k0 * p02;
+    vf->P[1][1] -= k1 * p01;
+    vf->P[1][2] -= k1 * p02;
+    vf->P[2][2] -= k2 * p02;
+    vf->P[1][0] = vf->P[0][1];
+    vf->P[2][0] = vf->P[0][2];
+    vf->P[2][1] = vf->P[1][2];
+
+    vf->stats.baro_updates++;
+
+    return true;
+}
+
+/**
+ * @brief 고도
+ */
+float vertical_filter_get_altitude(const VerticalFilter *vf) {
+    return (vf != NULL) ? vf->alt : 0.0f;
+}
+
+/**
+ * @brief 수직 속도
+ */
+float vertical_filter_get_velocity(const VerticalFilter *vf) {
+    return (vf != NULL) ? vf->vel : 0.0f;
+}
+
+/**
+ * @brief 준비 여부
+ */
+bool vertical_filter_is_ready(const VerticalFilter *vf) {
+    return vf != NULL && vf->ready;
+}
+
+/**
+ * @brief 통계
+ */
+const VerticalFilterStats *vertical_filter_get_stats(const VerticalFilter *vf) {
+    if (vf == NULL) {
+        return NULL;
+    }
+
+    return &vf->stats;
+}
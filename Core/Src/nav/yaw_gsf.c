@@ -0,0 +1,274 @@
+/**
+ * @file yaw_gsf.c
+ * @brief 가우스 합 방위 가설 뱅크 구현
+ */
+
+#include "nav/yaw_gsf.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 각도를 [-π, π]로 감기
+ */
+static float yaw_gsf_wrap(float angle) {
+    while (angle > FAST_MATH_PI) {
+        angle -= 2.0f * FAST_MATH_PI;
+    }
+    while (angle < -FAST_MATH_PI) {
+        angle += 2.0f * FAST_MATH_PI;
+    }
+    return angle;
+}
+
+/**
+ * @brief 균등 가중치
+ */
+static void yaw_gsf_reset_weights(YawGsf *gsf) {
+    for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+        gsf->weight[i] = 1.0f / (float)YAW_GSF_MODELS;
+    }
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool yaw_gsf_default_config(YawGsfConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->accel_std = YAW_GSF_DEFAULT_ACCEL_STD;
+    config->yaw_rate_std = YAW_GSF_DEFAULT_YAW_RATE_STD;
+    config->vel_std_min = YAW_GSF_DEFAULT_VEL_STD_MIN;
+    config->yaw_var_max = YAW_GSF_DEFAULT_YAW_VAR_MAX;
+
+    return true;
+}
+
+/**
+ * @brief 추정기 초기화
+ */
+bool yaw_gsf_init(YawGsf *gsf, const YawGsfConfig *config) {
+    if (gsf == NULL) {
+        return false;
+    }
+
+    memset(gsf, 0, sizeof(*gsf));
+    if (config != NULL) {
+        gsf->config = *config;
+    } else {
+        yaw_gsf_default_config(&gsf->config);
+    }
+    gsf->q = quaternion_identity();
+    yaw_gsf_reset_weights(gsf);
+
+    return true;
+}
+
+/**
+ * @brief 가설 시작
+ */
+bool yaw_gsf_start(YawGsf *gsf, Quaternion q, Vector3f vel, float vel_std) {
+    if (gsf == NULL || !(vel_std > 0.0f)) {
+        return false;
+    }
+
+    gsf->q = quaternion_normalize(q);
+
+    float vel_var = vel_std * vel_std;
+    float yaw_std = FAST_MATH_PI / (float)YAW_GSF_MODELS;
+    for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+        gsf->vn[i] = vel.x;
+        gsf->ve[i] = vel.y;
+        gsf->yaw[i] = yaw_gsf_wrap(2.0f * FAST_MATH_PI * (float)i / (float)YAW_GSF_MODELS);
+        fast_sincosf(gsf->yaw[i], &gsf->sin_yaw[i], &gsf->cos_yaw[i]);
+        gsf->p00[i] = vel_var;
+        gsf->p01[i] = 0.0f;
+        gsf->p02[i] = 0.0f;
+        gsf->p11[i] = vel_var;
+        gsf->p12[i] = 0.0f;
+        gsf->p22[i] = yaw_std * yaw_std;
+    }
+    yaw_gsf_reset_weights(gsf);
+    gsf->started = true;
+
+    return true;
+}
+
+/**
+ * @brief IMU 증분 반영
+ *
+ * 가설 i의 속도 증분 수평 성분은 u_i = Rz(δ_i) h, h = (R dv)의 NE 성분이다.
+ * ∂u_i/∂δ = (-u_E, u_N)이므로 F = [1 0 -u_E; 0 1 u_N; 0 0 1]이고,
+ * F P F^T를 대칭 6성분으로 전개해 더한다.
+ */
+bool yaw_gsf_predict(YawGsf *gsf, Vector3f delta_angle, Vector3f delta_velocity, float dt) {
+    if (gsf == NULL || !gsf->started || !(dt > 0.0f)) {
+        return false;
+    }
+
+    // 구간 시작 자세로 속도 증분 회전 (수평 성분만)
+    float R[3][3];
+    quaternion_to_rotation_matrix(gsf->q, R);
+    float hn = R[0][0] * delta_velocity.x + R[0][1] * delta_velocity.y + R[0][2] * delta_velocity.z;
+    float he = R[1][0] * delta_velocity.x + R[1][1] * delta_velocity.y + R[1][2] * delta_velocity.z;
+    if (!isfinite(hn) || !isfinite(he)) {
+        return false;
+    }
+    gsf->q = quaternion_normalize_fast(quaternion_multiply(gsf->q, quaternion_from_rotation_vector(delta_angle)));
+
+    float qv = gsf->config.accel_std * dt;
+    qv *= qv;
+    float qy = gsf->config.yaw_rate_std * dt;
+    qy *= qy;
+
+    for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+        float un = gsf->cos_yaw[i] * hn - gsf->sin_yaw[i] * he;
+        float ue = gsf->sin_yaw[i] * hn + gsf->cos_yaw[i] * he;
+        gsf->vn[i] += un;
+        gsf->ve[i] += ue;
+
+        float a = -ue;
+        float b = un;
+        float p02 = gsf->p02[i];
+        float p12 = gsf->p12[i];
+        float p22 = gsf->p22[i];
+        gsf->p00[i] += 2.0f * a * p02 + a * a * p22 + qv;
+        gsf->p01[i] += a * p12 + b * p02 + a * b * p22;
+        gsf->p02[i] = p02 + a * p22;
+        gsf->p11[i] += 2.0f * b * p12 + b * b * p22 + qv;
+        gsf->p12[i] = p12 + b * p22;
+        gsf->p22[i] = p22 + qy;
+    }
+    gsf->stats.predicts++;
+
+    return true;
+}
+
+/**
+ * @brief GNSS 수평 속도로 가설 갱신과 가중치 갱신
+ *
+ * H = [I2 0]이므로 S = P_vv + r I, K = P[:, v] S^-1 이다. 가중치에는 정규 우도
+ * exp(-NIS/2) / sqrt(det S)를 곱한다 (2π 상수는 정규화에서 약분).
+ */
+bool yaw_gsf_update_velocity(YawGsf *gsf, Vector3f vel, float vel_std) {
+    if (gsf == NULL || !gsf->started || !(vel_std >= 0.0f) || !isfinite(vel.x) || !isfinite(vel.y)) {
+        return false;
+    }
+
+    float std = fmaxf(vel_std, gsf->config.vel_std_min);
+    float r = std * std;
+
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+        float p00 = gsf->p00[i];
+        float p01 = gsf->p01[i];
+        float p02 = gsf->p02[i];
+        float p11 = gsf->p11[i];
+        float p12 = gsf->p12[i];
+
+        float s00 = p00 + r;
+        float s11 = p11 + r;
+        float det = s00 * s11 - p01 * p01;
+        float inv_det = 1.0f / det;
+        float i00 = s11 * inv_det;
+        float i01 = -p01 * inv_det;
+        float i11 = s00 * inv_det;
+
+        float yn = vel.x - gsf->vn[i];
+        float ye = vel.y - gsf->ve[i];
+        float nis = yn * (i00 * yn + i01 * ye) + ye * (i01 * yn + i11 * ye);
+
+        // 이득 (행: vn, ve, δ)
+        float k00 = p00 * i00 + p01 * i01;
+        float k01 = p00 * i01 + p01 * i11;
+        float k10 = p01 * i00 + p11 * i01;
+        float k11 = p01 * i01 + p11 * i11;
+        float k20 = p02 * i00 + p12 * i01;
+        float k21 = p02 * i01 + p12 * i11;
+
+        gsf->vn[i] += k00 * yn + k01 * ye;
+        gsf->ve[i] += k10 * yn + k11 * ye;
+        gsf->yaw[i] = yaw_gsf_wrap(gsf->yaw[i] + k20 * yn + k21 * ye);
+
+        gsf->p00[i] = fmaxf(p00 - (k00 * p00 + k01 * p01), YAW_GSF_VAR_MIN);
+        gsf->p01[i] = p01 - (k00 * p01 + k01 * p11);
+        gsf->p02[i] = p02 - (k00 * p02 + k01 * p12);
+        gsf->p11[i] = fmaxf(p11 - (k10 * p01 + k11 * p11), YAW_GSF_VAR_MIN);
+        gsf->p12[i] = p12 - (k10 * p02 + k11 * p12);
+        gsf->p22[i] = fmaxf(gsf->p22[i] - (k20 * p02 + k21 * p12), YAW_GSF_VAR_MIN);
+
+        fast_sincosf(gsf->yaw[i], &gsf->sin_yaw[i], &gsf->cos_yaw[i]);
+
+        float likelihood = (det > 0.0f) ? fp_expf(-0.5f * nis) * sqrtf(inv_det) : 0.0f;
+        gsf->weight[i] *= likelihood;
+        sum += gsf->weight[i];
+    }
+
+    // 정규화 (모두 0이면 균등), 하한 적용 후 다시 정규화
+    if (!(sum > 0.0f) || !isfinite(sum)) {
+        yaw_gsf_reset_weights(gsf);
+        gsf->stats.weight_resets++;
+    } else {
+        float floored = 0.0f;
+        for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+            gsf->weight[i] = fmaxf(gsf->weight[i] / sum, YAW_GSF_WEIGHT_MIN);
+            floored += gsf->weight[i];
+        }
+        for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+            gsf->weight[i] /= floored;
+        }
+    }
+    gsf->stats.updates++;
+
+    return true;
+}
+
+/**
+ * @brief 가중 평균 방위로 보정한 공유 자세
+ *
+ * 원형 평균 δ̄ = atan2(Σ w sin δ, Σ w cos δ), 분산 = Σ w (P_δδ + (δ - δ̄)^2).
+ */
+bool yaw_gsf_get_attitude(const YawGsf *gsf, Quaternion *q, float *yaw_var) {
+    if (gsf == NULL || !gsf->started) {
+        return false;
+    }
+
+    float s = 0.0f;
+    float c = 0.0f;
+    for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+        s += gsf->weight[i] * gsf->sin_yaw[i];
+        c += gsf->weight[i] * gsf->cos_yaw[i];
+    }
+    float mean = fp_atan2f(s, c);
+
+    float var = 0.0f;
+    for (uint8_t i = 0; i < YAW_GSF_MODELS; i++) {
+        float d = yaw_gsf_wrap(gsf->yaw[i] - mean);
+        var += gsf->weight[i] * (gsf->p22[i] + d * d);
+    }
+
+    if (q != NULL) {
+        float sh, ch;
+        fast_sincosf(0.5f * mean, &sh, &ch);
+        *q = quaternion_normalize(quaternion_multiply(quaternion_create(ch, 0.0f, 0.0f, sh), gsf->q));
+    }
+    if (yaw_var != NULL) {
+        *yaw_var = var;
+    }
+
+    return var < gsf->config.yaw_var_max;
+}
+
+/**
+ * @brief 통계 조회
+ */
+const YawGsfStats *yaw_gsf_get_stats(const YawGsf *gsf) {
+    if (gsf == NULL) {
+        return NULL;
+    }
+
+    return &gsf->stats;
+}
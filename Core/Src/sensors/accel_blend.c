@@ -0,0 +1,167 @@
+/**
+ * @file accel_blend.c
+ * @brief 주 가속도계 포화 검출과 고중력 가속도계 혼합 구현
+ */
+
+#include "sensors/accel_blend.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 순환 안전 시각 비교 (a가 b보다 뒤이면 true)
+ */
+static bool accel_blend_time_after(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) > 0;
+}
+
+/**
+ * @brief 주 샘플 시각의 고중력 가속도 (앞뒤 보간, 없으면 유효 시간 내 최신값)
+ */
+static bool accel_blend_high_g_at(AccelBlend *blend, uint32_t timestamp_us, Vector3f *accel) {
+    // prev <= t < next가 되도록 (또는 링이 빌 때까지) 전진
+    while (!blend->has_next || !accel_blend_time_after(blend->next.timestamp_us, timestamp_us)) {
+        ImuSample s;
+        if (!imu_ring_pop(blend->high_g, &s)) {
+            break;
+        }
+        if (blend->has_next) {
+            blend->prev = blend->next;
+            blend->has_prev = true;
+        }
+        blend->next = s;
+        blend->has_next = true;
+    }
+
+    if (!blend->has_next) {
+        return false;
+    }
+
+    if (accel_blend_time_after(blend->next.timestamp_us, timestamp_us)) {
+        if (blend->has_prev && !accel_blend_time_after(blend->prev.timestamp_us, timestamp_us)) {
+            float span = (float)(blend->next.timestamp_us - blend->prev.timestamp_us);
+            float u = (float)(timestamp_us - blend->prev.timestamp_us) / span;
+            *accel = vector3f_add(blend->prev.accel,
+                                  vector3f_scale(vector3f_subtract(blend->next.accel, blend->prev.accel), u));
+            return true;
+        }
+
+        // 주 샘플보다 뒤의 샘플만 있음
+        if (blend->next.timestamp_us - timestamp_us > blend->config.timeout_us) {
+            return false;
+        }
+    } else if (timestamp_us - blend->next.timestamp_us > blend->config.timeout_us) {
+        // 뒤 샘플이 아직 없고 최신 샘플이 오래됨
+        return false;
+    }
+
+    *accel = blend->next.accel;
+
+    return true;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool accel_blend_default_config(AccelBlendConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->range = ACCEL_BLEND_DEFAULT_RANGE;
+    config->blend_start = ACCEL_BLEND_DEFAULT_START;
+    config->blend_end = ACCEL_BLEND_DEFAULT_END;
+    config->high_g_noise_std = ACCEL_BLEND_DEFAULT_HIGH_G_NOISE_STD;
+    config->clip_noise_std = ACCEL_BLEND_DEFAULT_CLIP_NOISE_STD;
+    config->timeout_us = ACCEL_BLEND_DEFAULT_TIMEOUT_US;
+
+    return true;
+}
+
+/**
+ * @brief 혼합기 초기화
+ */
+bool accel_blend_init(AccelBlend *blend, ImuRing *high_g, const AccelBlendConfig *config) {
+    if (blend == NULL || high_g == NULL) {
+        return false;
+    }
+
+    AccelBlendConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        accel_blend_default_config(&cfg);
+    }
+    if (!(cfg.range > 0.0f) || !(cfg.blend_start >= 0.0f) || !(cfg.blend_end > cfg.blend_start) ||
+        cfg.blend_end > 1.0f || !(cfg.high_g_noise_std >= 0.0f) || !(cfg.clip_noise_std >= 0.0f)) {
+        return false;
+    }
+
+    memset(blend, 0, sizeof(*blend));
+    blend->config = cfg;
+    blend->high_g = high_g;
+
+    return true;
+}
+
+/**
+ * @brief 주 가속도 한 축의 혼합 가중치 (0..1)
+ */
+static float accel_blend_weight(const AccelBlendConfig *cfg, float a) {
+    float w = (fabsf(a) - cfg->blend_start * cfg->range) / ((cfg->blend_end - cfg->blend_start) * cfg->range);
+    return fminf(fmaxf(w, 0.0f), 1.0f);
+}
+
+/**
+ * @brief 주 가속도 샘플 하나 혼합
+ */
+bool accel_blend_apply(AccelBlend *blend, uint32_t timestamp_us, Vector3f *accel, float *accel_var) {
+    if (blend == NULL || accel == NULL || accel_var == NULL) {
+        return false;
+    }
+
+    const AccelBlendConfig *cfg = &blend->config;
+    blend->stats.samples++;
+    *accel_var = 0.0f;
+
+    // 혼합하지 않는 동안에도 링을 비워 혼합 시작 시 최신 샘플을 쓰게 함
+    Vector3f high_g;
+    bool has_high_g = accel_blend_high_g_at(blend, timestamp_us, &high_g);
+
+    float wx = accel_blend_weight(cfg, accel->x);
+    float wy = accel_blend_weight(cfg, accel->y);
+    float wz = accel_blend_weight(cfg, accel->z);
+    float w_max = fmaxf(wx, fmaxf(wy, wz));
+    if (w_max == 0.0f) {
+        return false;
+    }
+
+    if (!has_high_g) {
+        // 보정할 샘플 없음: 포화된 축이 있으면 필터에만 알림
+        if (w_max >= 1.0f) {
+            blend->stats.clipped++;
+            *accel_var = cfg->clip_noise_std * cfg->clip_noise_std;
+            return true;
+        }
+        return false;
+    }
+
+    accel->x += wx * (high_g.x - accel->x);
+    accel->y += wy * (high_g.y - accel->y);
+    accel->z += wz * (high_g.z - accel->z);
+    blend->stats.blended++;
+    *accel_var = w_max * w_max * cfg->high_g_noise_std * cfg->high_g_noise_std;
+
+    return true;
+}
+
+/**
+ * @brief 혼합 통계
+ */
+const AccelBlendStats *accel_blend_get_stats(const AccelBlend *blend) {
+    if (blend == NULL) {
+        return NULL;
+    }
+
+    return &blend->stats;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file baro_altitude.c
+ * @brief 기압 → 고도 변환 구현
+ */
+
+#include "sensors/baro_altitude.h"
+#include "sys/mem_section.h"
+#include "math/fp_mode.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief float 지수 바이어스와 가수 비트 수
+ */
+#define BARO_FLOAT_EXP_BIAS 127u
+#define BARO_FLOAT_MANT_BITS 23u
+
+/**
+ * @brief 구간 내 위치 비트 수 (가수에서 구간 번호를 뺀 나머지)
+ */
+#define BARO_ISA_FRAC_BITS (BARO_FLOAT_MANT_BITS - BARO_ISA_SUBDIV_BITS)
+
+/**
+ * @brief 표 첫 구간의 (지수, 가수 상위 비트) 번호
+ */
+#define BARO_ISA_INDEX_BASE ((BARO_FLOAT_EXP_BIAS + BARO_ISA_OCTAVE_MIN) << BARO_ISA_SUBDIV_BITS)
+
+/**
+ * @brief ISA 대류권 (지상 기준 온도 편차 계산용)
+ */
+#define BARO_ISA_T0 288.15f            /**< 해수면 온도 (K) */
+#define BARO_ISA_LAPSE 0.0065f         /**< 기온 감률 (K/m) */
+#define BARO_ISA_T_TROPOPAUSE 216.65f  /**< 대류권계면 온도 (K) */
+#define BARO_KELVIN 273.15f
+
+/**
+ * @brief ISA 온도 (K, 대류권계면 위는 일정)
+ */
+static float baro_isa_temperature(float alt) {
+    return fmaxf(BARO_ISA_T0 - BARO_ISA_LAPSE * alt, BARO_ISA_T_TROPOPAUSE);
+}
+
+/**
+ * @brief ISA 기압 고도 (표 조회)
+ */
+MEM_RAMFUNC(baro_altitude_isa) float baro_altitude_isa(float pressure_pa) {
+    if (!(pressure_pa >= BARO_ISA_PRESSURE_MIN)) {
+        pressure_pa = BARO_ISA_PRESSURE_MIN;
+    }
+    if (pressure_pa >= BARO_ISA_PRESSURE_MAX) {
+        // 마지막 구간 끝 (t = 1)
+        const float *c = baro_isa_table[BARO_ISA_SEGMENTS - 1];
+        return c[0] + c[1] + c[2] + c[3];
+    }
+
+    // 지수 + 가수 상위 비트 = 구간 번호, 나머지 가수 = 구간 내 위치
+    uint32_t bits;
+    memcpy(&bits, &pressure_pa, sizeof(bits));
+    uint32_t k = (bits >> BARO_ISA_FRAC_BITS) - BARO_ISA_INDEX_BASE;
+    float t = (float)(bits & ((1u << BARO_ISA_FRAC_BITS) - 1u)) * (1.0f / (float)(1u << BARO_ISA_FRAC_BITS));
+
+    const float *c = baro_isa_table[k];
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+/**
+ * @brief 지상 기준 확정 (ISA 고도, 센서 온도)
+ */
+static void baro_altitude_fix_ground(BaroAltitude *baro, float ground_alt, float ground_temp) {
+    baro->ground_alt = ground_alt;
+    baro->ground_temp = ground_temp;
+    baro->temp_offset = ground_temp + BARO_KELVIN - baro_isa_temperature(ground_alt);
+    baro->ground_valid = true;
+}
+
+/**
+ * @brief 변환기 초기화
+ */
+bool baro_altitude_init(BaroAltitude *baro, uint16_t ground_samples, float temp_coeff) {
+    if (baro == NULL || ground_samples == 0) {
+        return false;
+    }
+
+    baro->ground_samples = ground_samples;
+    baro->temp_coeff = temp_coeff;
+
+    return baro_altitude_capture_ground(baro);
+}
+
+/**
+ * @brief 지상 기준 캡처 다시 시작
+ */
+bool baro_altitude_capture_ground(BaroAltitude *baro) {
+    if (baro == NULL) {
+        return false;
+    }
+
+    baro->count = 0;
+    baro->alt_ref = 0.0f;
+    baro->alt_sum = 0.0f;
+    baro->temp_sum = 0.0f;
+    baro->ground_alt = 0.0f;
+    baro->ground_temp = 0.0f;
+    baro->temp_offset = 0.0f;
+    baro->ground_valid = false;
+
+    return true;
+}
+
+/**
+ * @brief 지상 기준 직접 설정
+ */
+bool baro_altitude_set_ground(BaroAltitude *baro, float pressure_pa, float temp_c) {
+    if (baro == NULL || !(pressure_pa > 0.0f)) {
+        return false;
+    }
+
+    baro->count = 0;
+    baro_altitude_fix_ground(baro, baro_altitude_isa(pressure_pa), temp_c);
+
+    return true;
+}
+
+/**
+ * @brief 기압 샘플 처리
+ */
+bool baro_altitude_update(BaroAltitude *baro, float pressure_pa, float temp_c, float *alt) {
+    if (baro == NULL || alt == NULL || !(pressure_pa > 0.0f)) {
+        return false;
+    }
+
+    if (!baro->ground_valid) {
+        // 지상 기준 캡처 (첫 샘플 기준 편차를 누적하여 float 정밀도 유지)
+        float h = baro_altitude_isa(pressure_pa);
+        if (baro->count == 0) {
+            baro->alt_ref = h;
+        }
+        baro->alt_sum += h - baro->alt_ref;
+        baro->temp_sum += temp_c;
+        baro->count++;
+
+        if (baro->count >= baro->ground_samples) {
+            float n = (float)baro->count;
+            baro_altitude_fix_ground(baro, baro->alt_ref + baro->alt_sum / n, baro->temp_sum / n);
+        }
+        return false;
+    }
+
+    // 센서 온도 계수 보정 (캡처 온도 기준)
+    float p = pressure_pa - baro->temp_coeff * (temp_c - baro->ground_temp);
+    float h = baro_altitude_isa(p);
+
+    // 대기 온도 편차 보정: dz = dh_ISA * (T_ISA + ΔT) / T_ISA, 구간 중간 고도 온도 사용
+    float t_mid = baro_isa_temperature(0.5f * (h + baro->ground_alt));
+    *alt = (h - baro->ground_alt) * (1.0f + baro->temp_offset / t_mid);
+
+    return true;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file baro_dual.c
+ * @brief 이중 기압계 사전 융합 구현
+ */
+
+#include "sensors/baro_dual.h"
+#include "math/fp_mode.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool baro_dual_default_config(BaroDualConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->std_a = BARO_DUAL_DEFAULT_STD_A;
+    config->std_b = BARO_DUAL_DEFAULT_STD_B;
+    config->ref_std = BARO_DUAL_DEFAULT_REF_STD;
+    config->gate = BARO_DUAL_DEFAULT_GATE;
+    config->bias_alpha = BARO_DUAL_DEFAULT_BIAS_ALPHA;
+    config->fail_epochs = BARO_DUAL_DEFAULT_FAIL_EPOCHS;
+    config->recover_epochs = BARO_DUAL_DEFAULT_RECOVER_EPOCHS;
+
+    return true;
+}
+
+/**
+ * @brief 사전 융합 초기화
+ */
+bool baro_dual_init(BaroDual *dual, const BaroDualConfig *config) {
+    if (dual == NULL) {
+        return false;
+    }
+
+    BaroDualConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        baro_dual_default_config(&cfg);
+    }
+    if (!(cfg.std_a > 0.0f) || !(cfg.std_b > 0.0f) || !(cfg.ref_std > 0.0f) || !(cfg.gate > 0.0f) ||
+        !(cfg.bias_alpha > 0.0f) || cfg.bias_alpha > 1.0f || cfg.fail_epochs == 0 || cfg.recover_epochs == 0) {
+        return false;
+    }
+
+    memset(dual, 0, sizeof(*dual));
+    dual->config = cfg;
+
+    return true;
+}
+
+/**
+ * @brief 출력 채우기
+ */
+static bool baro_dual_output(const BaroDual *dual, BaroDualOutput *out, BaroDualSource source, float alt,
+                             float var) {
+    out->alt = alt;
+    out->var = var;
+    out->noise_scale = var / (dual->config.ref_std * dual->config.ref_std);
+    out->source = source;
+
+    return true;
+}
+
+/**
+ * @brief 한 센서만 쓰는 출력 (B는 편차를 빼 A 기준으로)
+ */
+static bool baro_dual_output_single(BaroDual *dual, BaroDualOutput *out, BaroDualSensor sensor, float alt,
+                                    float extra_var) {
+    const BaroDualConfig *cfg = &dual->config;
+    dual->stats.single++;
+
+    if (sensor == BARO_DUAL_A) {
+        return baro_dual_output(dual, out, BARO_DUAL_SOURCE_A, alt, cfg->std_a * cfg->std_a + extra_var);
+    }
+
+    return baro_dual_output(dual, out, BARO_DUAL_SOURCE_B, dual->bias_valid ? alt - dual->bias : alt,
+                            cfg->std_b * cfg->std_b + extra_var);
+}
+
+/**
+ * @brief 기압 주기 하나 융합
+ */
+bool baro_dual_update(BaroDual *dual, float alt_a, float alt_b, float predicted_alt, BaroDualOutput *out) {
+    if (dual == NULL || out == NULL) {
+        return false;
+    }
+
+    const BaroDualConfig *cfg = &dual->config;
+    dual->stats.epochs++;
+    out->residual = 0.0f;
+    out->source = BARO_DUAL_SOURCE_NONE;
+
+    bool has_a = isfinite(alt_a);
+    bool has_b = isfinite(alt_b);
+    if (!has_a && !has_b) {
+        return false;
+    }
+
+    // 한 센서만 측정: 편차 추정과 발산 판정은 그대로 둠
+    if (!has_a || !has_b) {
+        BaroDualSensor s = has_a ? BARO_DUAL_A : BARO_DUAL_B;
+        if (dual->failed[s]) {
+            return false;
+        }
+        return baro_dual_output_single(dual, out, s, has_a ? alt_a : alt_b, 0.0f);
+    }
+
+    float d = alt_b - alt_a;
+    if (!dual->bias_valid) {
+        dual->bias = d;
+        dual->bias_valid = true;
+    }
+    float r = d - dual->bias;
+    bool consistent = fabsf(r) <= cfg->gate;
+    out->residual = r;
+
+    // 배제 중: 일치가 이어지면 복귀, 그 전에는 남은 센서만
+    if (dual->failed[BARO_DUAL_A] || dual->failed[BARO_DUAL_B]) {
+        BaroDualSensor good = dual->failed[BARO_DUAL_A] ? BARO_DUAL_B : BARO_DUAL_A;
+        if (consistent) {
+            if (++dual->recover_count >= cfg->recover_epochs) {
+                dual->failed[BARO_DUAL_A] = false;
+                dual->failed[BARO_DUAL_B] = false;
+                dual->recover_count = 0;
+                dual->fail_count = 0;
+                dual->stats.recoveries++;
+                // 아래 일관 경로로
+            } else {
+                return baro_dual_output_single(dual, out, good, (good == BARO_DUAL_A) ? alt_a : alt_b, 0.0f);
+            }
+        } else {
+            dual->recover_count = 0;
+            return baro_dual_output_single(dual, out, good, (good == BARO_DUAL_A) ? alt_a : alt_b, 0.0f);
+        }
+    }
+
+    if (!consistent) {
+        dual->stats.inconsistent++;
+        if (++dual->fail_count < cfg->fail_epochs) {
+            // 확정 전: 기준 센서만, 벌어진 만큼 분산 증가
+            return baro_dual_output_single(dual, out, BARO_DUAL_A, alt_a, r * r);
+        }
+
+        // 발산 확정: 예측 고도에서 더 먼 쪽 배제 (예측이 없으면 B)
+        BaroDualSensor bad = BARO_DUAL_B;
+        if (isfinite(predicted_alt) && fabsf(alt_a - predicted_alt) > fabsf(alt_b - dual->bias - predicted_alt)) {
+            bad = BARO_DUAL_A;
+        }
+        dual->failed[bad] = true;
+        dual->fail_count = 0;
+        dual->recover_count = 0;
+        dual->stats.divergences++;
+
+        BaroDualSensor good = (bad == BARO_DUAL_A) ? BARO_DUAL_B : BARO_DUAL_A;
+        return baro_dual_output_single(dual, out, good, (good == BARO_DUAL_A) ? alt_a : alt_b, 0.0f);
+    }
+
+    dual->fail_count = 0;
+
+    // 분산 가중 평균 (B를 A 기준으로 옮김)
+    float va = cfg->std_a * cfg->std_a;
+    float vb = cfg->std_b * cfg->std_b;
+    float wa = vb / (va + vb);
+    float wb = 1.0f - wa;
+    float alt = wa * alt_a + wb * (alt_b - dual->bias);
+    float var = va * wa + wa * wb * r * r;
+
+    dual->bias += cfg->bias_alpha * r;
+    dual->stats.fused++;
+
+    return baro_dual_output(dual, out, BARO_DUAL_SOURCE_BOTH, alt, var);
+}
+
+/**
+ * @brief 센서 배제 여부
+ */
+bool baro_dual_is_failed(const BaroDual *dual, BaroDualSensor sensor) {
+    if (dual == NULL || (unsigned)sensor >= BARO_DUAL_COUNT) {
+        return false;
+    }
+
+    return dual->failed[sensor];
+}
+
+/**
+ * @brief 사전 융합 통계
+ */
+const BaroDualStats *baro_dual_get_stats(const BaroDual *dual) {
+    if (dual == NULL) {
+        return NULL;
+    }
+
+    return &dual->stats;
+}
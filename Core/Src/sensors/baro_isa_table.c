@@ -0,0 +1,141 @@
+/**
+ * @file baro_isa_table.c
+ * @brief ISA 기압-고도 구간 다항식 표 (Tools/baro/isa_table.c 생성 파일, 직접 수정 금지)
+ *
+ * 모델: ISA 0..47 km (기하 고도), 3차 Hermite
+ * 구간: 기압 2^9..2^17 Pa, 옥타브당 16구간
+ */
+
+#include "sensors/baro_altitude.h"
+#include "sys/mem_section.h"
+
+MEM_RAMDATA(baro_isa_table) const float baro_isa_table[BARO_ISA_SEGMENTS][4] = {
+    /*    512 Pa */ { 3.58112266e+04f, -4.41734985e+02f, 1.49377699e+01f, -5.91724098e-01f },
+    /*    544 Pa */ { 3.53838359e+04f, -4.13634613e+02f, 1.31673212e+01f, -4.93450701e-01f },
+    /*    576 Pa */ { 3.49828750e+04f, -3.88780334e+02f, 1.16905003e+01f, -4.15679455e-01f },
+    /*    608 Pa */ { 3.46053711e+04f, -3.66646362e+02f, 1.04461422e+01f, -3.53346109e-01f },
+    /*    640 Pa */ { 3.42488164e+04f, -3.46814117e+02f, 9.38816833e+00f, -3.02813649e-01f },
+    /*    672 Pa */ { 3.39110898e+04f, -3.28946228e+02f, 8.48133755e+00f, -2.61424750e-01f },
+    /*    704 Pa */ { 3.35903633e+04f, -3.12767822e+02f, 7.69833422e+00f, -2.27207661e-01f },
+    /*    736 Pa */ { 3.32850664e+04f, -2.98052765e+02f, 7.01772451e+00f, -1.98678657e-01f },
+    /*    768 Pa */ { 3.29938320e+04f, -2.84613373e+02f, 6.42250443e+00f, -1.74706921e-01f },
+    /*    800 Pa */ { 3.27154668e+04f, -2.72292480e+02f, 5.89904690e+00f, -1.54420465e-01f },
+    /*    832 Pa */ { 3.24489180e+04f, -2.60957642e+02f, 5.43632841e+00f, -1.37139723e-01f },
+    /*    864 Pa */ { 3.21932598e+04f, -2.50496414e+02f, 4.89097929e+00f, -1.67051017e-01f },
+    /*    896 Pa */ { 3.19474883e+04f, -2.41215607e+02f, 4.43986464e+00f, -1.01865172e-01f },
+    /*    928 Pa */ { 3.17106094e+04f, -2.32641464e+02f, 4.13455057e+00f, -9.17512402e-02f },
+    /*    960 Pa */ { 3.14820117e+04f, -2.24647629e+02f, 3.85953379e+00f, -8.29302371e-02f },
+    /*    992 Pa */ { 3.12611406e+04f, -2.17177338e+02f, 3.61094403e+00f, -7.52022639e-02f },
+    /*   1024 Pa */ { 3.10474980e+04f, -4.20362122e+02f, 1.35238724e+01f, -5.22912204e-01f },
+    /*   1088 Pa */ { 3.06401367e+04f, -3.94883118e+02f, 1.19591913e+01f, -4.37429607e-01f },
+    /*   1152 Pa */ { 3.02567754e+04f, -3.72277039e+02f, 1.06499434e+01f, -3.69574666e-01f },
+    /*   1216 Pa */ { 2.98947793e+04f, -3.52085876e+02f, 9.54353428e+00f, -3.15032601e-01f },
+    /*   1280 Pa */ { 2.95519219e+04f, -3.33943878e+02f, 8.60022449e+00f, -2.70695686e-01f },
+    /*   1344 Pa */ { 2.92263066e+04f, -3.17555542e+02f, 7.78953552e+00f, -2.34287009e-01f },
+    /*   1408 Pa */ { 2.89163066e+04f, -3.02679321e+02f, 7.08778048e+00f, -2.04112753e-01f },
+    /*   1472 Pa */ { 2.86205117e+04f, -2.89116089e+02f, 6.47632647e+00f, -1.78895071e-01f },
+    /*   1536 Pa */ { 2.83376934e+04f, -2.76700134e+02f, 5.94035482e+00f, -1.57657772e-01f },
+    /*   1600 Pa */ { 2.80667754e+04f, -2.65292389e+02f, 5.46796227e+00f, -1.39646426e-01f },
+    /*   1664 Pa */ { 2.78068105e+04f, -2.54775406e+02f, 5.04949999e+00f, -1.24271750e-01f },
+    /*   1728 Pa */ { 2.75569609e+04f, -2.45049225e+02f, 4.67707920e+00f, -1.11068964e-01f },
+    /*   1792 Pa */ { 2.73164785e+04f, -2.36028275e+02f, 4.34420061e+00f, -9.96681750e-02f },
+    /*   1856 Pa */ { 2.70846934e+04f, -2.27638870e+02f, 4.04547119e+00f, -8.97725150e-02f },
+    /*   1920 Pa */ { 2.68610117e+04f, -2.19817245e+02f, 3.77638555e+00f, -8.11418816e-02f },
+    /*   1984 Pa */ { 2.66448887e+04f, -2.12507904e+02f, 3.53315663e+00f, -7.35806599e-02f },
+    /*   2048 Pa */ { 2.64358398e+04f, -4.11324677e+02f, 1.32325583e+01f, -5.11637628e-01f },
+    /*   2176 Pa */ { 2.60372363e+04f, -3.86394470e+02f, 1.17016144e+01f, -4.27999288e-01f },
+    /*   2304 Pa */ { 2.56621152e+04f, -3.64275238e+02f, 1.04205914e+01f, -3.61608118e-01f },
+    /*   2432 Pa */ { 2.53079004e+04f, -3.44518890e+02f, 9.33803177e+00f, -3.08242500e-01f },
+    /*   2560 Pa */ { 2.49724102e+04f, -3.26767548e+02f, 8.41505337e+00f, -2.64861792e-01f },
+    /*   2688 Pa */ { 2.46537930e+04f, -3.10732025e+02f, 7.62183619e+00f, -2.29238287e-01f },
+    /*   2816 Pa */ { 2.43504531e+04f, -2.96176056e+02f, 6.93520355e+00f, -1.99714661e-01f },
+    /*   2944 Pa */ { 2.40610137e+04f, -2.82904785e+02f, 6.33692455e+00f, -1.75040707e-01f },
+    /*   3072 Pa */ { 2.37842715e+04f, -2.70756073e+02f, 5.81250095e+00f, -1.54261261e-01f },
+    /*   3200 Pa */ { 2.35191719e+04f, -2.59593842e+02f, 5.35028553e+00f, -1.36638194e-01f },
+    /*   3328 Pa */ { 2.32647930e+04f, -2.49303192e+02f, 4.94083738e+00f, -1.21594928e-01f },
+    /*   3456 Pa */ { 2.30203086e+04f, -2.39786301e+02f, 4.57643843e+00f, -1.08676717e-01f },
+    /*   3584 Pa */ { 2.27849902e+04f, -2.30959457e+02f, 4.25072956e+00f, -9.75216404e-02f },
+    /*   3712 Pa */ { 2.25581836e+04f, -2.22750565e+02f, 3.95843387e+00f, -8.78392383e-02f },
+    /*   3840 Pa */ { 2.23393047e+04f, -2.15097214e+02f, 3.69514322e+00f, -7.93945789e-02f },
+    /*   3968 Pa */ { 2.21278223e+04f, -2.07945114e+02f, 3.45715189e+00f, -7.19962865e-02f },
+    /*   4096 Pa */ { 2.19232617e+04f, -4.02493591e+02f, 1.29479208e+01f, -5.00621796e-01f },
+    /*   4352 Pa */ { 2.15332168e+04f, -3.78099609e+02f, 1.14499378e+01f, -4.18785363e-01f },
+    /*   4608 Pa */ { 2.11661484e+04f, -3.56456085e+02f, 1.01964922e+01f, -3.53824347e-01f },
+    /*   4864 Pa */ { 2.08195352e+04f, -3.37124573e+02f, 9.13723564e+00f, -3.01608145e-01f },
+    /*   5120 Pa */ { 2.04912461e+04f, -3.19754944e+02f, 8.23412323e+00f, -2.59161711e-01f },
+    /*   5376 Pa */ { 2.01794648e+04f, -3.04064178e+02f, 7.47385311e+00f, -3.14932942e-01f },
+    /*   5632 Pa */ { 1.98825605e+04f, -2.90061279e+02f, 6.59913111e+00f, -1.87406629e-01f },
+    /*   5888 Pa */ { 1.95989102e+04f, -2.77425232e+02f, 6.03770971e+00f, -1.64463535e-01f },
+    /*   6144 Pa */ { 1.93273594e+04f, -2.65843201e+02f, 5.54496431e+00f, -1.45117491e-01f },
+    /*   6400 Pa */ { 1.90669160e+04f, -2.55188629e+02f, 5.11013794e+00f, -1.28690332e-01f },
+    /*   6656 Pa */ { 1.88167070e+04f, -2.45354416e+02f, 4.72449923e+00f, -1.14651710e-01f },
+    /*   6912 Pa */ { 1.85759629e+04f, -2.36249374e+02f, 4.38090181e+00f, -1.02582805e-01f },
+    /*   7168 Pa */ { 1.83439922e+04f, -2.27795319e+02f, 4.07345200e+00f, -9.21499431e-02f },
+    /*   7424 Pa */ { 1.81201777e+04f, -2.19924866e+02f, 3.79725218e+00f, -8.30850527e-02f },
+    /*   7680 Pa */ { 1.79039668e+04f, -2.12579620e+02f, 3.54820824e+00f, -7.51710683e-02f },
+    /*   7936 Pa */ { 1.76948613e+04f, -2.05708710e+02f, 3.32287431e+00f, -6.82310015e-02f },
+    /*   8192 Pa */ { 1.74924062e+04f, -3.98535309e+02f, 1.24569969e+01f, -4.75082427e-01f },
+    /*   8704 Pa */ { 1.71058535e+04f, -3.75046570e+02f, 1.10353746e+01f, -3.98109198e-01f },
+    /*   9216 Pa */ { 1.67414434e+04f, -3.54170135e+02f, 9.84376907e+00f, -3.36905420e-01f },
+    /*   9728 Pa */ { 1.63967812e+04f, -3.35493317e+02f, 8.83512974e+00f, -2.87630826e-01f },
+    /*  10240 Pa */ { 1.60698350e+04f, -3.18685944e+02f, 7.97384262e+00f, -2.47514978e-01f },
+    /*  10752 Pa */ { 1.57588760e+04f, -3.03480804e+02f, 7.23255539e+00f, -2.14525059e-01f },
+    /*  11264 Pa */ { 1.54624131e+04f, -2.89659271e+02f, 6.58997631e+00f, -1.87146530e-01f },
+    /*  11776 Pa */ { 1.51791562e+04f, -2.77040771e+02f, 6.02933455e+00f, -1.64235279e-01f },
+    /*  12288 Pa */ { 1.49079805e+04f, -2.65474792e+02f, 5.53727293e+00f, -1.44916102e-01f },
+    /*  12800 Pa */ { 1.46478984e+04f, -2.54835007e+02f, 5.10304976e+00f, -1.28511757e-01f },
+    /*  13312 Pa */ { 1.43980381e+04f, -2.45014450e+02f, 4.71794605e+00f, -1.14492603e-01f },
+    /*  13824 Pa */ { 1.41576270e+04f, -2.35922028e+02f, 4.37482595e+00f, -1.02440454e-01f },
+    /*  14336 Pa */ { 1.39259775e+04f, -2.27479706e+02f, 4.06780243e+00f, -9.20220762e-02f },
+    /*  14848 Pa */ { 1.37024736e+04f, -2.19620163e+02f, 3.79198599e+00f, -8.29697698e-02f },
+    /*  15360 Pa */ { 1.34865625e+04f, -2.12285095e+02f, 3.54328752e+00f, -7.50667751e-02f },
+    /*  15872 Pa */ { 1.32777451e+04f, -2.05423721e+02f, 3.31826615e+00f, -6.81363344e-02f },
+    /*  16384 Pa */ { 1.30755713e+04f, -3.97983215e+02f, 1.24397221e+01f, -4.74423289e-01f },
+    /*  17408 Pa */ { 1.26895537e+04f, -3.74527039e+02f, 1.10200720e+01f, -3.97556901e-01f },
+    /*  18432 Pa */ { 1.23256494e+04f, -3.53679565e+02f, 9.83012009e+00f, -3.36438060e-01f },
+    /*  19456 Pa */ { 1.19814629e+04f, -3.35028625e+02f, 8.82287979e+00f, -2.87231833e-01f },
+    /*  20480 Pa */ { 1.16549707e+04f, -3.18244568e+02f, 7.96278763e+00f, -2.47171655e-01f },
+    /*  21504 Pa */ { 1.13444414e+04f, -3.03060516e+02f, 7.22252846e+00f, -2.14227512e-01f },
+    /*  22528 Pa */ { 1.10483887e+04f, -2.89258118e+02f, 5.79573107e+00f, -3.65209311e-01f },
+    /*  23552 Pa */ { 1.07645615e+04f, -2.78762299e+02f, 4.91555262e+00f, -1.21615909e-01f },
+    /*  24576 Pa */ { 1.04905928e+04f, -2.69296051e+02f, 4.55113220e+00f, -1.08167566e-01f },
+    /*  25600 Pa */ { 1.02257402e+04f, -2.60518280e+02f, 4.22698021e+00f, -9.66587365e-02f },
+    /*  26624 Pa */ { 9.96935254e+03f, -2.52354294e+02f, 3.93729472e+00f, -8.67492333e-02f },
+    /*  27648 Pa */ { 9.72084863e+03f, -2.44739944e+02f, 3.67728925e+00f, -7.81683847e-02f },
+    /*  28672 Pa */ { 9.47970801e+03f, -2.37619873e+02f, 3.44298744e+00f, -7.06989840e-02f },
+    /*  29696 Pa */ { 9.24545996e+03f, -2.30945999e+02f, 3.23106217e+00f, -6.41652867e-02f },
+    /*  30720 Pa */ { 9.01768066e+03f, -2.24676376e+02f, 3.03871226e+00f, -5.84240369e-02f },
+    /*  31744 Pa */ { 8.79598438e+03f, -2.18774216e+02f, 2.86356473e+00f, -5.33576682e-02f },
+    /*  32768 Pa */ { 8.58002051e+03f, -4.26414337e+02f, 1.08023272e+01f, -3.74801248e-01f },
+    /*  34816 Pa */ { 8.16403418e+03f, -4.05934082e+02f, 9.68048859e+00f, -3.17625403e-01f },
+    /*  36864 Pa */ { 7.76746289e+03f, -3.87525970e+02f, 8.72955894e+00f, -2.71662444e-01f },
+    /*  38912 Pa */ { 7.38839453e+03f, -3.70881836e+02f, 7.91607189e+00f, -2.34272972e-01f },
+    /*  40960 Pa */ { 7.02519482e+03f, -3.55752502e+02f, 7.21442509e+00f, -2.03532755e-01f },
+    /*  43008 Pa */ { 6.67645312e+03f, -3.41934265e+02f, 6.60475302e+00f, -1.78015918e-01f },
+    /*  45056 Pa */ { 6.34094531e+03f, -3.29258820e+02f, 6.07144594e+00f, -1.56650022e-01f },
+    /*  47104 Pa */ { 6.01760156e+03f, -3.17585876e+02f, 5.60209370e+00f, -1.38617694e-01f },
+    /*  49152 Pa */ { 5.70547900e+03f, -3.06797516e+02f, 5.18672752e+00f, -1.23288289e-01f },
+    /*  51200 Pa */ { 5.40374512e+03f, -2.96793945e+02f, 4.81726265e+00f, -1.10169768e-01f },
+    /*  53248 Pa */ { 5.11165820e+03f, -2.87489929e+02f, 4.48708439e+00f, -9.88743454e-02f },
+    /*  55296 Pa */ { 4.82855664e+03f, -2.78812378e+02f, 4.19073772e+00f, -8.90934765e-02f },
+    /*  57344 Pa */ { 4.55384570e+03f, -2.70698181e+02f, 3.92368913e+00f, -8.05795416e-02f },
+    /*  59392 Pa */ { 4.28699072e+03f, -2.63092529e+02f, 3.68214607e+00f, -7.31322095e-02f },
+    /*  61440 Pa */ { 4.02750708e+03f, -2.55947647e+02f, 3.46291590e+00f, -6.65881932e-02f },
+    /*  63488 Pa */ { 3.77495581e+03f, -2.49221573e+02f, 3.26329327e+00f, -6.08134419e-02f },
+    /*  65536 Pa */ { 3.52893677e+03f, -4.85754883e+02f, 1.23101454e+01f, -4.27168936e-01f },
+    /*  69632 Pa */ { 3.05506494e+03f, -4.62416077e+02f, 1.10315619e+01f, -3.61999929e-01f },
+    /*  73728 Pa */ { 2.60331836e+03f, -4.41438965e+02f, 9.94778061e+00f, -3.09611976e-01f },
+    /*  77824 Pa */ { 2.17151758e+03f, -4.22472229e+02f, 9.02065563e+00f, -2.66996413e-01f },
+    /*  81920 Pa */ { 1.75779895e+03f, -4.05231903e+02f, 8.22100163e+00f, -2.31959894e-01f },
+    /*  86016 Pa */ { 1.36055603e+03f, -3.89485779e+02f, 7.52617788e+00f, -2.02877030e-01f },
+    /*  90112 Pa */ { 9.78393555e+02f, -3.75042053e+02f, 6.91839075e+00f, -1.78525463e-01f },
+    /*  94208 Pa */ { 6.10091370e+02f, -3.61740845e+02f, 6.38349581e+00f, -1.57973498e-01f },
+    /*  98304 Pa */ { 2.54576050e+02f, -3.49447784e+02f, 5.91013050e+00f, -1.40502259e-01f },
+    /* 102400 Pa */ { -8.91021118e+01f, -3.38049042e+02f, 5.48907948e+00f, -1.25550956e-01f },
+    /* 106496 Pa */ { -4.21787628e+02f, -3.27447540e+02f, 5.11280394e+00f, -1.12677552e-01f },
+    /* 110592 Pa */ { -7.44235046e+02f, -3.17559967e+02f, 4.77508640e+00f, -1.01530381e-01f },
+    /* 114688 Pa */ { -1.05712146e+03f, -3.08314362e+02f, 4.47075939e+00f, -9.18271989e-02f },
+    /* 118784 Pa */ { -1.36105688e+03f, -2.99648346e+02f, 4.19550085e+00f, -8.33396763e-02f },
+    /* 122880 Pa */ { -1.65659302e+03f, -2.91507355e+02f, 3.94567132e+00f, -7.58816749e-02f },
+    /* 126976 Pa */ { -1.94423059e+03f, -2.83843658e+02f, 3.71818829e+00f, -6.93004429e-02f }
+};
@@ -0,0 +1,83 @@
+/**
+ * @file baro_ring.c
+ * @brief 기압 샘플용 무잠금 SPSC 링 버퍼 구현
+ */
+
+#include "sensors/baro_ring.h"
+#include <stddef.h>
+
+/**
+ * @brief 링 버퍼 초기화
+ */
+bool baro_ring_init(BaroRing *ring) {
+    if (ring == NULL) {
+        return false;
+    }
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->dropped = 0;
+
+    return true;
+}
+
+/**
+ * @brief 샘플 추가 (생산자 전용)
+ */
+bool baro_ring_push(BaroRing *ring, const BaroSample *sample) {
+    if (ring == NULL || sample == NULL) {
+        return false;
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if ((uint32_t)(head - tail) >= BARO_RING_SIZE) {
+        ring->dropped++;
+        return false;
+    }
+
+    ring->buffer[head & (BARO_RING_SIZE - 1)] = *sample;
+
+    // 샘플 기록이 head 갱신보다 먼저 보이도록 release
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief 가장 오래된 샘플 꺼내기 (소비자 전용)
+ */
+bool baro_ring_pop(BaroRing *ring, BaroSample *sample) {
+    if (ring == NULL || sample == NULL) {
+        return false;
+    }
+
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+
+    *sample = ring->buffer[tail & (BARO_RING_SIZE - 1)];
+
+    // 샘플 읽기가 끝난 뒤 슬롯을 생산자에게 반환
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief 저장된 샘플 수
+ */
+uint32_t baro_ring_count(const BaroRing *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    return (uint32_t)(head - tail);
+}
@@ -0,0 +1,388 @@
+/**
+ * @file dma_poll.c
+ * @brief 타이머 구동 SPI DMA 폴링 체인 구현
+ */
+
+#include "sensors/dma_poll.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 읽기 재시도 횟수 (게시가 두 번 겹치면 다시 복사)
+ */
+#define DMA_POLL_MAX_RETRIES 4u
+
+/**
+ * @brief APB2 타이머 클럭 (TIM1/TIM8/TIM15)
+ */
+static uint32_t dma_poll_timer_clock(void) {
+    uint32_t pclk2 = HAL_RCC_GetPCLK2Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE2) == RCC_CFGR_PPRE2_DIV1) ? pclk2 : 2u * pclk2;
+}
+
+/**
+ * @brief SPI 한 바이트 전송 시간 (ns)
+ */
+static uint32_t dma_poll_byte_ns(const SPI_HandleTypeDef *hspi) {
+    uint32_t pclk = (hspi->Instance == SPI1) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+    uint32_t div = 2u << ((hspi->Instance->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    return (uint32_t)((8ull * div * 1000000000ull + pclk - 1u) / pclk);
+}
+
+/**
+ * @brief ns -> 타이머 틱 (올림)
+ */
+static uint32_t dma_poll_ticks(uint32_t ns, uint32_t clk) {
+    return (uint32_t)(((uint64_t)ns * clk + 999999999ull) / 1000000000ull);
+}
+
+/**
+ * @brief 채널 비교 레지스터 주소
+ */
+static volatile uint32_t *dma_poll_ccr(TIM_TypeDef *tim, uint32_t channel) {
+    return &tim->CCR1 + (channel >> 2);
+}
+
+/**
+ * @brief 모든 칩 선택 해제 값 (BSRR 설정 비트)
+ */
+static uint32_t dma_poll_release_mask(const DmaPoll *poll) {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < poll->read_count; i++) {
+        mask |= poll->reads[i].cs_pin;
+    }
+
+    return mask;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool dma_poll_default_config(DmaPollConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->slot_ns = DMA_POLL_DEFAULT_SLOT_NS;
+    config->cs_setup_ns = DMA_POLL_DEFAULT_CS_SETUP_NS;
+
+    return true;
+}
+
+/**
+ * @brief 체인 초기화
+ */
+bool dma_poll_init(DmaPoll *poll, const DmaPollHw *hw, DmaPollClockFn clock, const DmaPollConfig *config) {
+    if (poll == NULL || hw == NULL || clock == NULL || hw->hspi == NULL || hw->htim == NULL ||
+        hw->cs_dma == NULL || hw->tx_dma == NULL || hw->cs_port == NULL || hw->hspi->hdmarx == NULL) {
+        return false;
+    }
+    if (!IS_TIM_REPETITION_COUNTER_INSTANCE(hw->htim->Instance) || hw->cs_channel == hw->tx_channel ||
+        hw->cs_channel > TIM_CHANNEL_4 || hw->tx_channel > TIM_CHANNEL_4) {
+        return false;
+    }
+
+    DmaPollConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        dma_poll_default_config(&cfg);
+    }
+    if (cfg.slot_ns == 0 || cfg.cs_setup_ns >= cfg.slot_ns) {
+        return false;
+    }
+
+    memset(poll, 0, sizeof(*poll));
+    poll->hw = *hw;
+    poll->config = cfg;
+    poll->clock = clock;
+    atomic_init(&poll->seq, 0);
+    poll->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 준비 콜백 설정
+ */
+bool dma_poll_set_ready_callback(DmaPoll *poll, DmaPollReadyFn ready, void *context) {
+    if (poll == NULL || !poll->initialized || poll->running) {
+        return false;
+    }
+
+    poll->ready = ready;
+    poll->ready_context = context;
+
+    return true;
+}
+
+/**
+ * @brief 레지스터 블록 읽기 추가
+ */
+bool dma_poll_add_read(DmaPoll *poll, uint16_t cs_pin, uint8_t command, uint8_t length) {
+    if (poll == NULL || !poll->initialized || poll->running || cs_pin == 0 || length == 0 ||
+        poll->read_count >= DMA_POLL_MAX_READS) {
+        return false;
+    }
+    // 명령 + 데이터 + 간격
+    if (poll->slot_count + length + 2u > DMA_POLL_MAX_SLOTS ||
+        poll->payload_size + length > DMA_POLL_MAX_PAYLOAD) {
+        return false;
+    }
+
+    DmaPollRead *r = &poll->reads[poll->read_count++];
+    r->cs_pin = cs_pin;
+    r->command = command;
+    r->length = length;
+    r->offset = (uint8_t)poll->payload_size;
+
+    poll->tx_table[poll->slot_count++] = command;
+    for (uint8_t i = 0; i < length; i++) {
+        poll->payload_slot[poll->payload_size++] = poll->slot_count;
+        poll->tx_table[poll->slot_count++] = DMA_POLL_DUMMY_BYTE;
+    }
+    poll->tx_table[poll->slot_count++] = DMA_POLL_DUMMY_BYTE;
+
+    return true;
+}
+
+/**
+ * @brief 읽기의 묶음 데이터 안 위치
+ */
+int16_t dma_poll_payload_offset(const DmaPoll *poll, uint8_t index) {
+    if (poll == NULL || index >= poll->read_count) {
+        return -1;
+    }
+
+    return (int16_t)poll->reads[index].offset;
+}
+
+/**
+ * @brief 칩 선택 표 작성 (핀 목록이 정해진 뒤)
+ */
+static void dma_poll_build_cs_table(DmaPoll *poll) {
+    uint32_t release = dma_poll_release_mask(poll);
+    uint16_t slot = 0;
+
+    for (uint8_t i = 0; i < poll->read_count; i++) {
+        const DmaPollRead *r = &poll->reads[i];
+        // 이 센서만 선택 (BSRR 상위 16비트 = 리셋)
+        uint32_t select = ((uint32_t)r->cs_pin << 16) | (release & ~(uint32_t)r->cs_pin);
+        for (uint16_t k = 0; k < (uint16_t)r->length + 1u; k++) {
+            poll->cs_table[slot++] = select;
+        }
+        poll->cs_table[slot++] = release;
+    }
+}
+
+/**
+ * @brief 하드웨어 설정 후 체인 무장
+ */
+static bool dma_poll_arm(DmaPoll *poll) {
+    const DmaPollHw *hw = &poll->hw;
+    SPI_TypeDef *spi = hw->hspi->Instance;
+    TIM_TypeDef *tim = hw->htim->Instance;
+
+    // 모든 칩 선택 해제 후 수신 FIFO와 넘침 플래그 비우기
+    hw->cs_port->BSRR = dma_poll_release_mask(poll);
+    __HAL_SPI_ENABLE(hw->hspi);
+    while (spi->SR & SPI_SR_RXNE) {
+        (void)*(volatile uint8_t *)&spi->DR;
+    }
+    __HAL_SPI_CLEAR_OVRFLAG(hw->hspi);
+
+    // 전송 완료/오류 인터럽트만 (반 전송 인터럽트는 쓰지 않음)
+    hw->hspi->hdmarx->XferHalfCpltCallback = NULL;
+    uint32_t dr = (uint32_t)(uintptr_t)&spi->DR;
+    if (HAL_DMA_Start_IT(hw->hspi->hdmarx, dr, (uint32_t)(uintptr_t)poll->rx_table, poll->slot_count) != HAL_OK) {
+        return false;
+    }
+    if (HAL_DMA_Start(hw->cs_dma, (uint32_t)(uintptr_t)poll->cs_table, (uint32_t)(uintptr_t)&hw->cs_port->BSRR,
+                      poll->slot_count) != HAL_OK) {
+        HAL_DMA_Abort(hw->hspi->hdmarx);
+        return false;
+    }
+    if (HAL_DMA_Start(hw->tx_dma, (uint32_t)(uintptr_t)poll->tx_table, dr, poll->slot_count) != HAL_OK) {
+        HAL_DMA_Abort(hw->cs_dma);
+        HAL_DMA_Abort(hw->hspi->hdmarx);
+        return false;
+    }
+    SET_BIT(spi->CR2, SPI_CR2_RXDMAEN);
+
+    // 슬롯 타이머: 트리거로 시작, 슬롯 수만큼 돌고 정지 (단발 + 반복 카운터)
+    tim->CR1 &= ~TIM_CR1_CEN;
+    tim->ARR = poll->slot_ticks - 1u;
+    *dma_poll_ccr(tim, hw->cs_channel) = 1u;
+    *dma_poll_ccr(tim, hw->tx_channel) = poll->tx_ticks;
+    tim->RCR = poll->slot_count - 1u;
+    tim->CR1 |= TIM_CR1_OPM | TIM_CR1_URS;
+    tim->EGR = TIM_EGR_UG;
+    tim->SR = 0;
+    tim->DIER |= (TIM_DIER_CC1DE << (hw->cs_channel >> 2)) | (TIM_DIER_CC1DE << (hw->tx_channel >> 2));
+    tim->SMCR = (tim->SMCR & ~(TIM_SMCR_SMS | TIM_SMCR_TS)) | hw->trigger | TIM_SLAVEMODE_TRIGGER;
+
+    return true;
+}
+
+/**
+ * @brief 하드웨어 해제
+ */
+static void dma_poll_disarm(DmaPoll *poll) {
+    const DmaPollHw *hw = &poll->hw;
+    TIM_TypeDef *tim = hw->htim->Instance;
+
+    tim->SMCR &= ~TIM_SMCR_SMS;
+    tim->CR1 &= ~TIM_CR1_CEN;
+    tim->DIER &= ~((TIM_DIER_CC1DE << (hw->cs_channel >> 2)) | (TIM_DIER_CC1DE << (hw->tx_channel >> 2)));
+
+    HAL_DMA_Abort(hw->tx_dma);
+    HAL_DMA_Abort(hw->cs_dma);
+    HAL_DMA_Abort(hw->hspi->hdmarx);
+    CLEAR_BIT(hw->hspi->Instance->CR2, SPI_CR2_RXDMAEN);
+    hw->cs_port->BSRR = dma_poll_release_mask(poll);
+}
+
+/**
+ * @brief 체인 시작
+ */
+bool dma_poll_start(DmaPoll *poll) {
+    if (poll == NULL || !poll->initialized || poll->running || poll->read_count == 0) {
+        return false;
+    }
+    if (poll->hw.cs_dma->Init.Mode != DMA_CIRCULAR || poll->hw.tx_dma->Init.Mode != DMA_CIRCULAR ||
+        poll->hw.hspi->hdmarx->Init.Mode != DMA_CIRCULAR) {
+        return false;
+    }
+
+    // 송신 시점 이후 한 바이트가 슬롯 안에 끝나야 다음 칩 선택 변경이 바이트를 자르지 않음
+    uint32_t clk = dma_poll_timer_clock();
+    poll->slot_ticks = dma_poll_ticks(poll->config.slot_ns, clk);
+    poll->tx_ticks = 1u + dma_poll_ticks(poll->config.cs_setup_ns, clk);
+    uint32_t byte_ticks = dma_poll_ticks(dma_poll_byte_ns(poll->hw.hspi), clk);
+    if (poll->slot_ticks > 0x10000u || poll->tx_ticks + byte_ticks >= poll->slot_ticks) {
+        return false;
+    }
+    poll->chain_us = (uint32_t)(((uint64_t)poll->slot_ticks * poll->slot_count * 1000000ull) / clk);
+
+    dma_poll_build_cs_table(poll);
+    if (!dma_poll_arm(poll)) {
+        dma_poll_disarm(poll);
+        return false;
+    }
+    poll->running = true;
+
+    return true;
+}
+
+/**
+ * @brief 체인 정지
+ */
+void dma_poll_stop(DmaPoll *poll) {
+    if (poll == NULL || !poll->initialized || !poll->running) {
+        return;
+    }
+
+    poll->running = false;
+    dma_poll_disarm(poll);
+}
+
+/**
+ * @brief 수신 표의 데이터 바이트를 게시
+ */
+static void dma_poll_publish(DmaPoll *poll, uint32_t timestamp_us) {
+    uint_fast32_t next = atomic_load_explicit(&poll->seq, memory_order_relaxed) + 1;
+    DmaPollSet *set = &poll->buffer[next & 1u];
+
+    set->timestamp_us = timestamp_us;
+    set->seq = (uint32_t)next;
+    for (uint16_t i = 0; i < poll->payload_size; i++) {
+        set->data[i] = poll->rx_table[poll->payload_slot[i]];
+    }
+
+    // 버퍼 쓰기가 시퀀스 증가보다 먼저 보이도록 release
+    atomic_store_explicit(&poll->seq, next, memory_order_release);
+    poll->stats.sets++;
+}
+
+/**
+ * @brief 수신 DMA 채널 인터럽트 처리
+ */
+void dma_poll_handle_irq(DmaPoll *poll) {
+    if (poll == NULL || !poll->initialized) {
+        return;
+    }
+
+    DMA_HandleTypeDef *rx = poll->hw.hspi->hdmarx;
+
+    if (__HAL_DMA_GET_FLAG(rx, __HAL_DMA_GET_TE_FLAG_INDEX(rx)) != 0u) {
+        __HAL_DMA_CLEAR_FLAG(rx, __HAL_DMA_GET_GI_FLAG_INDEX(rx));
+        poll->stats.dma_errors++;
+        // 오류가 난 채널은 HW가 끔: 다시 무장
+        if (poll->running) {
+            dma_poll_disarm(poll);
+            poll->running = dma_poll_arm(poll);
+        }
+        return;
+    }
+
+    if (__HAL_DMA_GET_FLAG(rx, __HAL_DMA_GET_TC_FLAG_INDEX(rx)) == 0u) {
+        return;
+    }
+    __HAL_DMA_CLEAR_FLAG(rx, __HAL_DMA_GET_TC_FLAG_INDEX(rx));
+    uint32_t now = poll->clock();
+
+    if (__HAL_SPI_GET_FLAG(poll->hw.hspi, SPI_FLAG_OVR)) {
+        // 바이트를 잃어 슬롯 정렬이 어긋났을 수 있음: 이번 묶음을 버리고 다시 시작
+        poll->stats.resyncs++;
+        if (poll->running) {
+            dma_poll_disarm(poll);
+            poll->running = dma_poll_arm(poll);
+        }
+        return;
+    }
+
+    dma_poll_publish(poll, now - poll->chain_us);
+    if (poll->ready != NULL) {
+        poll->ready(poll->ready_context);
+    }
+}
+
+/**
+ * @brief 마지막 묶음 읽기
+ */
+bool dma_poll_read(const DmaPoll *poll, DmaPollSet *set) {
+    if (poll == NULL || set == NULL) {
+        return false;
+    }
+
+    for (uint8_t attempt = 0; attempt < DMA_POLL_MAX_RETRIES; attempt++) {
+        uint_fast32_t before = atomic_load_explicit(&poll->seq, memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        *set = poll->buffer[before & 1u];
+
+        // 복사가 두 번째 시퀀스 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(&poll->seq, memory_order_relaxed);
+
+        // 한 번 게시는 반대쪽 버퍼에 쓰므로 복사본에 영향 없음
+        if (after - before < 2) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 통계
+ */
+const DmaPollStats *dma_poll_get_stats(const DmaPoll *poll) {
+    if (poll == NULL) {
+        return NULL;
+    }
+
+    return &poll->stats;
+}
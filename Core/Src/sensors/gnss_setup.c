@@ -0,0 +1,453 @@
+/**
+ * @file gnss_setup.c
+ * @brief u-blox 수신기 부팅 설정 구현
+ */
+
+#include "sensors/gnss_setup.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief UBX 프레임 상수
+ */
+#define GNSS_SETUP_SYNC1        0xB5u
+#define GNSS_SETUP_SYNC2        0x62u
+#define GNSS_SETUP_CLASS_ACK    0x05u
+#define GNSS_SETUP_ID_ACK_NAK   0x00u
+#define GNSS_SETUP_ID_ACK_ACK   0x01u
+#define GNSS_SETUP_CLASS_CFG    0x06u
+#define GNSS_SETUP_ID_VALSET    0x8Au
+#define GNSS_SETUP_ID_VALGET    0x8Bu
+
+/**
+ * @brief ACK 프레임 길이 (동기 2 + 헤더 4 + 페이로드 2 + 체크섬 2)
+ */
+#define GNSS_SETUP_ACK_LENGTH 10u
+
+/**
+ * @brief VALSET 한 번에 보내는 최대 키 수와 프레임 크기
+ */
+#define GNSS_SETUP_MAX_ITEMS 16u
+#define GNSS_SETUP_FRAME_MAX (8u + 4u + GNSS_SETUP_MAX_ITEMS * 8u)
+
+/**
+ * @brief VALSET/VALGET 층
+ */
+#define GNSS_SETUP_LAYER_RAM 0x01u     /**< VALSET 층 비트 (RAM) */
+#define GNSS_SETUP_VALGET_RAM 0x00u    /**< VALGET 층 번호 (RAM) */
+
+/**
+ * @brief 설정 키 (u-blox 9/10 세대 인터페이스 설명서)
+ */
+#define GNSS_KEY_UART1_BAUDRATE     0x40520001u /**< CFG-UART1-BAUDRATE (U4) */
+#define GNSS_KEY_UART1INPROT_NMEA   0x10730002u /**< CFG-UART1INPROT-NMEA (L) */
+#define GNSS_KEY_UART1OUTPROT_UBX   0x10740001u /**< CFG-UART1OUTPROT-UBX (L) */
+#define GNSS_KEY_UART1OUTPROT_NMEA  0x10740002u /**< CFG-UART1OUTPROT-NMEA (L) */
+#define GNSS_KEY_MSGOUT_NAV_PVT     0x20910007u /**< CFG-MSGOUT-UBX_NAV_PVT_UART1 (U1) */
+#define GNSS_KEY_MSGOUT_NAV_SAT     0x20910016u /**< CFG-MSGOUT-UBX_NAV_SAT_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_STATUS  0x2091001Bu /**< CFG-MSGOUT-UBX_NAV_STATUS_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_POSLLH  0x2091002Au /**< CFG-MSGOUT-UBX_NAV_POSLLH_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_DOP     0x20910039u /**< CFG-MSGOUT-UBX_NAV_DOP_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_VELNED  0x20910043u /**< CFG-MSGOUT-UBX_NAV_VELNED_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_TIMEUTC 0x2091005Cu /**< CFG-MSGOUT-UBX_NAV_TIMEUTC_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_CLOCK   0x20910066u /**< CFG-MSGOUT-UBX_NAV_CLOCK_UART1 */
+#define GNSS_KEY_MSGOUT_NAV_RELPOSNED 0x2091008Eu /**< CFG-MSGOUT-UBX_NAV_RELPOSNED_UART1 */
+#define GNSS_KEY_MSGOUT_RXM_SFRBX   0x20910232u /**< CFG-MSGOUT-UBX_RXM_SFRBX_UART1 */
+#define GNSS_KEY_MSGOUT_RXM_RAWX    0x209102A5u /**< CFG-MSGOUT-UBX_RXM_RAWX_UART1 */
+#define GNSS_KEY_RATE_MEAS          0x30210001u /**< CFG-RATE-MEAS (U2, ms) */
+#define GNSS_KEY_RATE_NAV           0x30210002u /**< CFG-RATE-NAV (U2, 측정 수당 해 1개) */
+#define GNSS_KEY_NAVSPG_DYNMODEL    0x20110021u /**< CFG-NAVSPG-DYNMODEL (E1) */
+
+/**
+ * @brief 측정 주기 후보 (ms, 빠른 순)
+ */
+static const uint16_t gnss_setup_periods[GNSS_SETUP_RATE_STEPS] = { 25u, 40u, 50u, 100u, 200u };
+
+/**
+ * @brief 목표 보율에서 응답이 없을 때 시도할 보율 (공장 기본 보율 다음)
+ */
+static const uint32_t gnss_setup_bauds[] = { 9600u, 38400u, 115200u, 230400u, 460800u, 921600u };
+
+/**
+ * @brief 키-값 한 쌍
+ */
+typedef struct {
+    uint32_t key;
+    uint32_t value;
+} GnssSetupItem;
+
+/**
+ * @brief 응답
+ */
+typedef enum {
+    GNSS_SETUP_REPLY_ACK = 0,
+    GNSS_SETUP_REPLY_NAK,
+    GNSS_SETUP_REPLY_TIMEOUT
+} GnssSetupReply;
+
+/**
+ * @brief 키의 값 크기 (바이트, 키 비트 28~30)
+ */
+static uint8_t gnss_setup_value_size(uint32_t key) {
+    switch ((key >> 28) & 0x7u) {
+    case 1u:
+    case 2u:
+        return 1u;
+    case 3u:
+        return 2u;
+    case 4u:
+        return 4u;
+    default:
+        return 0u;
+    }
+}
+
+/**
+ * @brief 리틀 엔디언 쓰기
+ */
+static void gnss_setup_put(uint8_t *p, uint32_t v, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        p[i] = (uint8_t)(v >> (8u * i));
+    }
+}
+
+/**
+ * @brief UBX 체크섬 (클래스부터 페이로드 끝까지)
+ */
+static void gnss_setup_checksum(const uint8_t *p, uint16_t len, uint8_t *ck_a, uint8_t *ck_b) {
+    uint8_t a = 0;
+    uint8_t b = 0;
+    for (uint16_t i = 0; i < len; i++) {
+        a = (uint8_t)(a + p[i]);
+        b = (uint8_t)(b + a);
+    }
+    *ck_a = a;
+    *ck_b = b;
+}
+
+/**
+ * @brief 프레임 송신 (블로킹)
+ */
+static bool gnss_setup_send(GnssSetup *setup, uint8_t cls, uint8_t id, const uint8_t *payload, uint16_t len) {
+    uint8_t frame[GNSS_SETUP_FRAME_MAX];
+    if (len + 8u > sizeof(frame)) {
+        return false;
+    }
+
+    frame[0] = GNSS_SETUP_SYNC1;
+    frame[1] = GNSS_SETUP_SYNC2;
+    frame[2] = cls;
+    frame[3] = id;
+    gnss_setup_put(&frame[4], len, 2u);
+    if (len > 0u) {
+        memcpy(&frame[6], payload, len);
+    }
+    gnss_setup_checksum(&frame[2], (uint16_t)(len + 4u), &frame[6 + len], &frame[7 + len]);
+
+    return HAL_UART_Transmit(setup->huart, frame, (uint16_t)(len + 8u), setup->config.ack_timeout_ms) == HAL_OK;
+}
+
+/**
+ * @brief cls/id에 대한 ACK-ACK 또는 ACK-NAK 대기
+ *
+ * 받은 바이트를 마지막 10바이트 창으로 밀며 ACK 프레임을 찾는다. 사이에 들어오는 NMEA와
+ * 다른 UBX 메시지는 버린다.
+ */
+static GnssSetupReply gnss_setup_wait_ack(GnssSetup *setup, uint8_t cls, uint8_t id) {
+    uint8_t window[GNSS_SETUP_ACK_LENGTH];
+    uint8_t filled = 0;
+    uint32_t start = HAL_GetTick();
+
+    while (HAL_GetTick() - start < setup->config.ack_timeout_ms) {
+        uint8_t byte;
+        // 송신 중 넘친 수신은 버리고 계속 받음
+        __HAL_UART_CLEAR_OREFLAG(setup->huart);
+        if (HAL_UART_Receive(setup->huart, &byte, 1u, 1u) != HAL_OK) {
+            continue;
+        }
+
+        if (filled < GNSS_SETUP_ACK_LENGTH) {
+            window[filled++] = byte;
+        } else {
+            memmove(window, &window[1], GNSS_SETUP_ACK_LENGTH - 1u);
+            window[GNSS_SETUP_ACK_LENGTH - 1u] = byte;
+        }
+        if (filled < GNSS_SETUP_ACK_LENGTH || window[0] != GNSS_SETUP_SYNC1 || window[1] != GNSS_SETUP_SYNC2 ||
+            window[2] != GNSS_SETUP_CLASS_ACK || window[4] != 2u || window[5] != 0u ||
+            window[6] != cls || window[7] != id) {
+            continue;
+        }
+        uint8_t ck_a, ck_b;
+        gnss_setup_checksum(&window[2], 6u, &ck_a, &ck_b);
+        if (ck_a != window[8] || ck_b != window[9]) {
+            continue;
+        }
+        if (window[3] == GNSS_SETUP_ID_ACK_ACK) {
+            setup->stats.acks++;
+            return GNSS_SETUP_REPLY_ACK;
+        }
+        if (window[3] == GNSS_SETUP_ID_ACK_NAK) {
+            setup->stats.naks++;
+            return GNSS_SETUP_REPLY_NAK;
+        }
+    }
+
+    setup->stats.timeouts++;
+    return GNSS_SETUP_REPLY_TIMEOUT;
+}
+
+/**
+ * @brief 송신 후 ACK 대기 (응답이 없으면 attempts번까지)
+ */
+static GnssSetupReply gnss_setup_transact(GnssSetup *setup, uint8_t id, const uint8_t *payload, uint16_t len,
+                                          uint8_t attempts) {
+    for (uint8_t attempt = 0; attempt < attempts; attempt++) {
+        if (!gnss_setup_send(setup, GNSS_SETUP_CLASS_CFG, id, payload, len)) {
+            continue;
+        }
+        GnssSetupReply reply = gnss_setup_wait_ack(setup, GNSS_SETUP_CLASS_CFG, id);
+        if (reply != GNSS_SETUP_REPLY_TIMEOUT) {
+            return reply;
+        }
+    }
+    return GNSS_SETUP_REPLY_TIMEOUT;
+}
+
+/**
+ * @brief CFG-VALSET 페이로드 구성 (RAM 층)
+ *
+ * @return uint16_t 페이로드 길이 (키 크기를 알 수 없으면 0)
+ */
+static uint16_t gnss_setup_valset_payload(uint8_t *payload, const GnssSetupItem *items, uint8_t count) {
+    payload[0] = 0u;                    // 버전
+    payload[1] = GNSS_SETUP_LAYER_RAM;
+    payload[2] = 0u;
+    payload[3] = 0u;
+    uint16_t len = 4u;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t size = gnss_setup_value_size(items[i].key);
+        if (size == 0u) {
+            return 0u;
+        }
+        gnss_setup_put(&payload[len], items[i].key, 4u);
+        gnss_setup_put(&payload[len + 4u], items[i].value, size);
+        len = (uint16_t)(len + 4u + size);
+    }
+    return len;
+}
+
+/**
+ * @brief CFG-VALSET 송신 후 ACK 대기
+ */
+static GnssSetupReply gnss_setup_valset(GnssSetup *setup, const GnssSetupItem *items, uint8_t count) {
+    uint8_t payload[4u + GNSS_SETUP_MAX_ITEMS * 8u];
+    if (count > GNSS_SETUP_MAX_ITEMS) {
+        return GNSS_SETUP_REPLY_NAK;
+    }
+    uint16_t len = gnss_setup_valset_payload(payload, items, count);
+    if (len == 0u) {
+        return GNSS_SETUP_REPLY_NAK;
+    }
+    return gnss_setup_transact(setup, GNSS_SETUP_ID_VALSET, payload, len, (uint8_t)(setup->config.retries + 1u));
+}
+
+/**
+ * @brief 현재 호스트 보율에서 수신기 응답 확인 (보율 키 CFG-VALGET의 ACK)
+ */
+static bool gnss_setup_probe(GnssSetup *setup) {
+    uint8_t payload[8];
+    payload[0] = 0u;                    // 버전
+    payload[1] = GNSS_SETUP_VALGET_RAM;
+    gnss_setup_put(&payload[2], 0u, 2u); // 위치
+    gnss_setup_put(&payload[4], GNSS_KEY_UART1_BAUDRATE, 4u);
+    return gnss_setup_transact(setup, GNSS_SETUP_ID_VALGET, payload, sizeof(payload), 2u) == GNSS_SETUP_REPLY_ACK;
+}
+
+/**
+ * @brief 호스트 UART 보율 변경
+ */
+static bool gnss_setup_host_baud(GnssSetup *setup, uint32_t baud) {
+    if (setup->huart->Init.BaudRate == baud) {
+        return true;
+    }
+    setup->huart->Init.BaudRate = baud;
+    return HAL_UART_Init(setup->huart) == HAL_OK;
+}
+
+/**
+ * @brief 수신기 보율을 목표 보율로 맞춤
+ */
+static bool gnss_setup_baud(GnssSetup *setup) {
+    const uint32_t target = setup->config.baud_rate;
+    if (gnss_setup_host_baud(setup, target) && gnss_setup_probe(setup)) {
+        setup->stats.baud_rate = target;
+        return true;
+    }
+
+    const size_t count = sizeof(gnss_setup_bauds) / sizeof(gnss_setup_bauds[0]);
+    for (size_t i = 0; i <= count; i++) {
+        uint32_t baud = (i == 0u) ? setup->config.factory_baud : gnss_setup_bauds[i - 1u];
+        if (baud == target || (i > 0u && baud == setup->config.factory_baud)) {
+            continue;
+        }
+        if (!gnss_setup_host_baud(setup, baud)) {
+            continue;
+        }
+
+        // 수신기는 ACK 전에 보율을 바꾸므로 ACK는 기다리지 않음
+        uint8_t payload[12];
+        GnssSetupItem item = { GNSS_KEY_UART1_BAUDRATE, target };
+        uint16_t len = gnss_setup_valset_payload(payload, &item, 1u);
+        gnss_setup_send(setup, GNSS_SETUP_CLASS_CFG, GNSS_SETUP_ID_VALSET, payload, len);
+        HAL_Delay(setup->config.baud_settle_ms);
+
+        if (gnss_setup_host_baud(setup, target)) {
+            HAL_Delay(setup->config.baud_settle_ms);
+            if (gnss_setup_probe(setup)) {
+                setup->stats.baud_switches++;
+                setup->stats.baud_rate = target;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief UART1 출력을 UBX NAV-PVT(+원시 관측, 상대 위치)만으로 줄임
+ */
+static bool gnss_setup_messages(GnssSetup *setup) {
+    const uint32_t raw = setup->config.raw_measurements ? 1u : 0u;
+    const uint32_t relpos = setup->config.relative_position ? 1u : 0u;
+    const GnssSetupItem items[] = {
+        { GNSS_KEY_UART1OUTPROT_NMEA, 0u },
+        { GNSS_KEY_UART1INPROT_NMEA, 0u },
+        { GNSS_KEY_UART1OUTPROT_UBX, 1u },
+        { GNSS_KEY_MSGOUT_NAV_PVT, 1u },
+        { GNSS_KEY_MSGOUT_NAV_SAT, 0u },
+        { GNSS_KEY_MSGOUT_NAV_STATUS, 0u },
+        { GNSS_KEY_MSGOUT_NAV_POSLLH, 0u },
+        { GNSS_KEY_MSGOUT_NAV_DOP, 0u },
+        { GNSS_KEY_MSGOUT_NAV_VELNED, 0u },
+        { GNSS_KEY_MSGOUT_NAV_TIMEUTC, 0u },
+        { GNSS_KEY_MSGOUT_NAV_CLOCK, raw },
+        { GNSS_KEY_MSGOUT_NAV_RELPOSNED, relpos },
+        { GNSS_KEY_MSGOUT_RXM_SFRBX, raw },
+        { GNSS_KEY_MSGOUT_RXM_RAWX, raw },
+    };
+    if (gnss_setup_valset(setup, items, (uint8_t)(sizeof(items) / sizeof(items[0]))) != GNSS_SETUP_REPLY_ACK) {
+        return false;
+    }
+    setup->stats.raw_enabled = setup->config.raw_measurements;
+    return true;
+}
+
+/**
+ * @brief 받아들여지는 가장 빠른 측정 주기 적용
+ */
+static bool gnss_setup_rate(GnssSetup *setup) {
+    for (uint32_t i = 0; i < GNSS_SETUP_RATE_STEPS; i++) {
+        uint16_t period = gnss_setup_periods[i];
+        if (period < setup->config.min_period_ms) {
+            continue;
+        }
+        const GnssSetupItem items[] = {
+            { GNSS_KEY_RATE_MEAS, period },
+            { GNSS_KEY_RATE_NAV, 1u },
+        };
+        GnssSetupReply reply = gnss_setup_valset(setup, items, 2u);
+        if (reply == GNSS_SETUP_REPLY_ACK) {
+            setup->stats.period_ms = period;
+            return true;
+        }
+        if (reply == GNSS_SETUP_REPLY_TIMEOUT) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 동적 모델 적용
+ */
+static bool gnss_setup_dyn_model(GnssSetup *setup) {
+    const GnssSetupItem item = { GNSS_KEY_NAVSPG_DYNMODEL, setup->config.dyn_model };
+    return gnss_setup_valset(setup, &item, 1u) == GNSS_SETUP_REPLY_ACK;
+}
+
+bool gnss_setup_default_config(GnssSetupConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+    config->baud_rate = GNSS_SETUP_DEFAULT_BAUD_RATE;
+    config->factory_baud = GNSS_SETUP_DEFAULT_FACTORY_BAUD;
+    config->min_period_ms = GNSS_SETUP_DEFAULT_MIN_PERIOD_MS;
+    config->dyn_model = GNSS_SETUP_DEFAULT_DYN_MODEL;
+    config->raw_measurements = GNSS_SETUP_DEFAULT_RAW;
+    config->relative_position = GNSS_SETUP_DEFAULT_RELPOS;
+    config->ack_timeout_ms = GNSS_SETUP_DEFAULT_ACK_TIMEOUT_MS;
+    config->retries = GNSS_SETUP_DEFAULT_RETRIES;
+    config->baud_settle_ms = GNSS_SETUP_DEFAULT_BAUD_SETTLE_MS;
+    return true;
+}
+
+bool gnss_setup_init(GnssSetup *setup, UART_HandleTypeDef *huart, const GnssSetupConfig *config) {
+    if (setup == NULL || huart == NULL) {
+        return false;
+    }
+    GnssSetupConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        gnss_setup_default_config(&cfg);
+    }
+    if (cfg.baud_rate == 0u || cfg.ack_timeout_ms == 0u) {
+        return false;
+    }
+
+    memset(setup, 0, sizeof(GnssSetup));
+    setup->huart = huart;
+    setup->config = cfg;
+    setup->initialized = true;
+    return true;
+}
+
+bool gnss_setup_run(GnssSetup *setup) {
+    if (setup == NULL || !setup->initialized) {
+        return false;
+    }
+
+    memset(&setup->stats, 0, sizeof(GnssSetupStats));
+    setup->configured = false;
+
+    // 보율을 먼저 맞춰야 나머지 단계의 ACK를 받을 수 있음
+    if (!gnss_setup_baud(setup)) {
+        setup->stats.failed_step = GNSS_SETUP_STEP_BAUD;
+        return false;
+    }
+
+    bool ok = true;
+    if (!gnss_setup_messages(setup)) {
+        setup->stats.failed_step = GNSS_SETUP_STEP_MESSAGES;
+        ok = false;
+    }
+    if (!gnss_setup_rate(setup) && ok) {
+        setup->stats.failed_step = GNSS_SETUP_STEP_RATE;
+        ok = false;
+    }
+    if (!gnss_setup_dyn_model(setup) && ok) {
+        setup->stats.failed_step = GNSS_SETUP_STEP_DYN_MODEL;
+        ok = false;
+    }
+
+    setup->configured = ok;
+    return ok;
+}
+
+const GnssSetupStats *gnss_setup_get_stats(const GnssSetup *setup) {
+    if (setup == NULL) {
+        return NULL;
+    }
+    return &setup->stats;
+}
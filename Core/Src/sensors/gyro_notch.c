@@ -0,0 +1,111 @@
+/**
+ * @file gyro_notch.c
+ * @brief 재조정 가능한 자이로 노치 필터 묶음 구현
+ */
+
+#include "sensors/gyro_notch.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 노치 필터 초기화
+ */
+bool gyro_notch_init(GyroNotch *notch, float sample_rate_hz, float q) {
+    if (notch == NULL || !(sample_rate_hz > 0.0f) || !(q > 0.0f)) {
+        return false;
+    }
+
+    memset(notch, 0, sizeof(*notch));
+    notch->sample_rate_hz = sample_rate_hz;
+    notch->q = q;
+    atomic_init(&notch->active, 0);
+
+    return true;
+}
+
+/**
+ * @brief 중심 주파수 설정 (태스크 문맥)
+ */
+bool gyro_notch_set_frequencies(GyroNotch *notch, const float *center_hz, uint8_t count) {
+    if (notch == NULL || (center_hz == NULL && count > 0) || count > GYRO_NOTCH_MAX) {
+        return false;
+    }
+
+    // 인터럽트가 쓰지 않는 쪽에 계산
+    unsigned int next = atomic_load_explicit(&notch->active, memory_order_relaxed) ^ 1u;
+    GyroNotchSet *set = &notch->sets[next];
+    float nyquist = 0.5f * notch->sample_rate_hz;
+
+    set->count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!(center_hz[i] > 0.0f) || center_hz[i] >= nyquist) {
+            continue;
+        }
+
+        float s, c;
+        fast_sincosf(2.0f * FAST_MATH_PI * center_hz[i] / notch->sample_rate_hz, &s, &c);
+        float alpha = s / (2.0f * notch->q);
+        float inv_a0 = 1.0f / (1.0f + alpha);
+
+        GyroNotchCoeffs *k = &set->notch[set->count];
+        k->b0 = inv_a0;
+        k->b1 = -2.0f * c * inv_a0;
+        k->b2 = inv_a0;
+        k->a1 = k->b1;
+        k->a2 = (1.0f - alpha) * inv_a0;
+        set->center_hz[set->count] = center_hz[i];
+        set->count++;
+    }
+
+    // 계수 기록이 번호 교체보다 먼저 보이도록 release
+    atomic_store_explicit(&notch->active, next, memory_order_release);
+    notch->retunes++;
+
+    return true;
+}
+
+/**
+ * @brief 노치 하나, 축 하나 (직접형 II 전치)
+ */
+static float gyro_notch_step(const GyroNotchCoeffs *k, float *z, float x) {
+    float y = k->b0 * x + z[0];
+    z[0] = k->b1 * x - k->a1 * y + z[1];
+    z[1] = k->b2 * x - k->a2 * y;
+    return y;
+}
+
+/**
+ * @brief 샘플 하나 필터링 (인터럽트 문맥)
+ */
+void gyro_notch_apply(GyroNotch *notch, Vector3f *gyro) {
+    if (notch == NULL || gyro == NULL) {
+        return;
+    }
+
+    const GyroNotchSet *set = &notch->sets[atomic_load_explicit(&notch->active, memory_order_acquire)];
+    for (uint8_t i = 0; i < set->count; i++) {
+        const GyroNotchCoeffs *k = &set->notch[i];
+        gyro->x = gyro_notch_step(k, notch->state[i][0], gyro->x);
+        gyro->y = gyro_notch_step(k, notch->state[i][1], gyro->y);
+        gyro->z = gyro_notch_step(k, notch->state[i][2], gyro->z);
+    }
+}
+
+/**
+ * @brief 현재 적용 중인 노치 수와 중심 주파수
+ */
+uint8_t gyro_notch_get_frequencies(const GyroNotch *notch, float *center_hz) {
+    if (notch == NULL) {
+        return 0;
+    }
+
+    const GyroNotchSet *set = &notch->sets[atomic_load_explicit(&notch->active, memory_order_acquire)];
+    if (center_hz != NULL) {
+        for (uint8_t i = 0; i < set->count; i++) {
+            center_hz[i] = set->center_hz[i];
+        }
+    }
+
+    return set->count;
+}
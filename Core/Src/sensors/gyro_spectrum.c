@@ -0,0 +1,407 @@
+/**
+ * @file gyro_spectrum.c
+ * @brief 자이로 스펙트럼 분석과 공진 봉우리 추적 구현
+ */
+
+#include "sensors/gyro_spectrum.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief N/2점 FFT의 나비 단계 수 (log2(N/2))
+ */
+static uint8_t gyro_spectrum_stages(void) {
+    uint8_t stages = 0;
+    for (uint32_t n = GYRO_SPECTRUM_HALF; n > 1u; n >>= 1) {
+        stages++;
+    }
+    return stages;
+}
+
+/**
+ * @brief 비트 역순 인덱스
+ */
+static uint16_t gyro_spectrum_reverse(uint16_t i, uint8_t bits) {
+    uint16_t r = 0;
+    for (uint8_t b = 0; b < bits; b++) {
+        r = (uint16_t)((r << 1) | ((i >> b) & 1u));
+    }
+    return r;
+}
+
+/**
+ * @brief 축 하나 적재 (평균 제거, 창, 짝/홀 묶음, 비트 역순)
+ */
+static void gyro_spectrum_load(GyroSpectrum *spec) {
+    const float *x = spec->input[spec->ready_buf][spec->axis];
+    uint8_t bits = gyro_spectrum_stages();
+
+    float mean = 0.0f;
+    for (uint16_t n = 0; n < GYRO_SPECTRUM_FFT_SIZE; n++) {
+        mean += x[n];
+    }
+    mean *= 1.0f / (float)GYRO_SPECTRUM_FFT_SIZE;
+
+    for (uint16_t n = 0; n < GYRO_SPECTRUM_HALF; n++) {
+        uint16_t r = gyro_spectrum_reverse(n, bits);
+        spec->re[r] = (x[2u * n] - mean) * spec->window[2u * n];
+        spec->im[r] = (x[2u * n + 1u] - mean) * spec->window[2u * n + 1u];
+    }
+}
+
+/**
+ * @brief 기수 2 나비 단계 하나 (W_{N/2}^k = W_N^{2k})
+ */
+static void gyro_spectrum_butterfly(GyroSpectrum *spec) {
+    uint16_t half = (uint16_t)(1u << spec->stage);
+    uint16_t size = (uint16_t)(half << 1);
+    uint16_t tw_step = (uint16_t)(GYRO_SPECTRUM_FFT_SIZE / size);
+
+    for (uint16_t start = 0; start < GYRO_SPECTRUM_HALF; start = (uint16_t)(start + size)) {
+        for (uint16_t j = 0; j < half; j++) {
+            float wr = spec->twiddle_cos[j * tw_step];
+            float wi = -spec->twiddle_sin[j * tw_step];
+            uint16_t a = (uint16_t)(start + j);
+            uint16_t b = (uint16_t)(a + half);
+
+            float tr = wr * spec->re[b] - wi * spec->im[b];
+            float ti = wr * spec->im[b] + wi * spec->re[b];
+            spec->re[b] = spec->re[a] - tr;
+            spec->im[b] = spec->im[a] - ti;
+            spec->re[a] += tr;
+            spec->im[a] += ti;
+        }
+    }
+}
+
+/**
+ * @brief N/2점 복소 결과를 N점 실수 스펙트럼으로 분리하고 전력 누적
+ *
+ * X[k] = E[k] + W_N^k O[k],  E = (Z[k] + Z*[M-k]) / 2,  O = (Z[k] - Z*[M-k]) / 2j
+ */
+static void gyro_spectrum_split(GyroSpectrum *spec) {
+    for (uint16_t k = 1; k < GYRO_SPECTRUM_HALF; k++) {
+        uint16_t m = (uint16_t)(GYRO_SPECTRUM_HALF - k);
+        float er = 0.5f * (spec->re[k] + spec->re[m]);
+        float ei = 0.5f * (spec->im[k] - spec->im[m]);
+        float or_ = 0.5f * (spec->im[k] + spec->im[m]);
+        float oi = -0.5f * (spec->re[k] - spec->re[m]);
+
+        float wr = spec->twiddle_cos[k];
+        float wi = -spec->twiddle_sin[k];
+        float xr = er + wr * or_ - wi * oi;
+        float xi = ei + wr * oi + wi * or_;
+        spec->power[k] += xr * xr + xi * xi;
+    }
+}
+
+/**
+ * @brief 대역 전력의 중앙값 (잡음 바닥, 봉우리 자체의 영향을 받지 않음)
+ */
+static float gyro_spectrum_median(const float *power, int32_t n) {
+    float v[GYRO_SPECTRUM_HALF];
+    for (int32_t i = 0; i < n; i++) {
+        v[i] = power[i];
+    }
+
+    // 선택 알고리즘 (Hoare 분할)
+    int32_t lo = 0;
+    int32_t hi = n - 1;
+    int32_t mid = n / 2;
+    while (lo < hi) {
+        float pivot = v[(lo + hi) / 2];
+        int32_t i = lo;
+        int32_t j = hi;
+        while (i <= j) {
+            while (v[i] < pivot) {
+                i++;
+            }
+            while (v[j] > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                float t = v[i];
+                v[i] = v[j];
+                v[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (mid <= j) {
+            hi = j;
+        } else if (mid >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+
+    return v[mid];
+}
+
+/**
+ * @brief 봉우리 탐색, 추적값 저역 통과, 노치 재조정
+ */
+static void gyro_spectrum_peaks(GyroSpectrum *spec) {
+    const GyroSpectrumConfig *cfg = &spec->config;
+    float bin_hz = spec->sample_rate_hz / (float)GYRO_SPECTRUM_FFT_SIZE;
+
+    int32_t k_min = (int32_t)(cfg->min_hz / bin_hz);
+    int32_t k_max = (int32_t)(cfg->max_hz / bin_hz);
+    if (k_min < 1) {
+        k_min = 1;
+    }
+    if (k_max > GYRO_SPECTRUM_HALF - 2) {
+        k_max = GYRO_SPECTRUM_HALF - 2;
+    }
+
+    float found_hz[GYRO_NOTCH_MAX];
+    float found_power[GYRO_NOTCH_MAX];
+    uint8_t found = 0;
+
+    if (k_max > k_min) {
+        float threshold = cfg->snr * gyro_spectrum_median(&spec->power[k_min], k_max - k_min + 1);
+
+        // 극대값 중 큰 순서로 peaks개 (삽입 정렬)
+        for (int32_t k = k_min; k <= k_max; k++) {
+            float p = spec->power[k];
+            if (!(p > threshold) || p <= spec->power[k - 1] || p < spec->power[k + 1]) {
+                continue;
+            }
+
+            // 포물선 보간 (빈 단위 오프셋 -0.5..0.5)
+            float l = spec->power[k - 1];
+            float r = spec->power[k + 1];
+            float denom = l - 2.0f * p + r;
+            float delta = (denom < 0.0f) ? 0.5f * (l - r) / denom : 0.0f;
+            float hz = ((float)k + delta) * bin_hz;
+
+            uint8_t pos = found;
+            while (pos > 0 && found_power[pos - 1] < p) {
+                if (pos < cfg->peaks) {
+                    found_power[pos] = found_power[pos - 1];
+                    found_hz[pos] = found_hz[pos - 1];
+                }
+                pos--;
+            }
+            if (pos < cfg->peaks) {
+                found_power[pos] = p;
+                found_hz[pos] = hz;
+                if (found < cfg->peaks) {
+                    found++;
+                }
+            }
+        }
+    }
+
+    if (found == 0) {
+        if (spec->peak_count > 0 && ++spec->misses >= cfg->hold) {
+            spec->peak_count = 0;
+            spec->misses = 0;
+            gyro_notch_set_frequencies(spec->notch, NULL, 0);
+        }
+        return;
+    }
+    spec->misses = 0;
+
+    // 주파수 오름차순 정렬
+    for (uint8_t i = 1; i < found; i++) {
+        float hz = found_hz[i];
+        uint8_t j = i;
+        while (j > 0 && found_hz[j - 1] > hz) {
+            found_hz[j] = found_hz[j - 1];
+            j--;
+        }
+        found_hz[j] = hz;
+    }
+
+    // 개수가 같으면 순서대로 짝지어 저역 통과, 다르면 새 봉우리로 교체
+    if (found == spec->peak_count) {
+        for (uint8_t i = 0; i < found; i++) {
+            spec->peak_hz[i] += cfg->smoothing * (found_hz[i] - spec->peak_hz[i]);
+        }
+    } else {
+        for (uint8_t i = 0; i < found; i++) {
+            spec->peak_hz[i] = found_hz[i];
+        }
+        spec->peak_count = found;
+    }
+
+    if (spec->notch != NULL) {
+        gyro_notch_set_frequencies(spec->notch, spec->peak_hz, spec->peak_count);
+    }
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool gyro_spectrum_default_config(GyroSpectrumConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->min_hz = GYRO_SPECTRUM_DEFAULT_MIN_HZ;
+    config->max_hz = GYRO_SPECTRUM_DEFAULT_MAX_HZ;
+    config->peaks = GYRO_SPECTRUM_DEFAULT_PEAKS;
+    config->snr = GYRO_SPECTRUM_DEFAULT_SNR;
+    config->smoothing = GYRO_SPECTRUM_DEFAULT_SMOOTHING;
+    config->hold = GYRO_SPECTRUM_DEFAULT_HOLD;
+
+    return true;
+}
+
+/**
+ * @brief 분석기 초기화
+ */
+bool gyro_spectrum_init(GyroSpectrum *spec, float sample_rate_hz, GyroNotch *notch,
+                        const GyroSpectrumConfig *config) {
+    if (spec == NULL || !(sample_rate_hz > 0.0f)) {
+        return false;
+    }
+
+    GyroSpectrumConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        gyro_spectrum_default_config(&cfg);
+    }
+    if (!(cfg.min_hz >= 0.0f) || !(cfg.max_hz > cfg.min_hz) || cfg.peaks < 1 || cfg.peaks > GYRO_NOTCH_MAX ||
+        !(cfg.snr >= 1.0f) || !(cfg.smoothing > 0.0f) || cfg.smoothing > 1.0f) {
+        return false;
+    }
+
+    memset(spec, 0, sizeof(*spec));
+    spec->config = cfg;
+    spec->sample_rate_hz = sample_rate_hz;
+    spec->notch = notch;
+    atomic_init(&spec->ready, false);
+
+    for (uint16_t n = 0; n < GYRO_SPECTRUM_FFT_SIZE; n++) {
+        float s, c;
+        fast_sincosf(2.0f * FAST_MATH_PI * (float)n / (float)GYRO_SPECTRUM_FFT_SIZE, &s, &c);
+        spec->window[n] = 0.5f - 0.5f * c;
+        if (n < GYRO_SPECTRUM_HALF) {
+            spec->twiddle_cos[n] = c;
+            spec->twiddle_sin[n] = s;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 자이로 샘플 하나 추가 (생산자 전용)
+ */
+void gyro_spectrum_push(GyroSpectrum *spec, Vector3f gyro) {
+    if (spec == NULL) {
+        return;
+    }
+
+    uint16_t pos = spec->write_pos;
+    spec->input[spec->write_buf][0][pos] = gyro.x;
+    spec->input[spec->write_buf][1][pos] = gyro.y;
+    spec->input[spec->write_buf][2][pos] = gyro.z;
+
+    if (++pos < GYRO_SPECTRUM_FFT_SIZE) {
+        spec->write_pos = pos;
+        return;
+    }
+    spec->write_pos = 0;
+
+    if (atomic_load_explicit(&spec->ready, memory_order_acquire)) {
+        // 분석기가 아직 이전 버퍼를 쓰는 중: 이 버퍼를 다시 채움
+        spec->stats.overruns++;
+        return;
+    }
+
+    // 버퍼 기록이 ready보다 먼저 보이도록 release
+    spec->ready_buf = spec->write_buf;
+    spec->write_buf ^= 1u;
+    atomic_store_explicit(&spec->ready, true, memory_order_release);
+}
+
+/**
+ * @brief 분석 한 단계 진행 (소비자 전용)
+ */
+bool gyro_spectrum_step(GyroSpectrum *spec) {
+    if (spec == NULL) {
+        return false;
+    }
+
+    switch (spec->phase) {
+    case GYRO_SPECTRUM_WAIT:
+        if (!atomic_load_explicit(&spec->ready, memory_order_acquire)) {
+            return false;
+        }
+        memset(spec->power, 0, sizeof(spec->power));
+        spec->axis = 0;
+        spec->phase = GYRO_SPECTRUM_LOAD;
+        return false;
+
+    case GYRO_SPECTRUM_LOAD:
+        gyro_spectrum_load(spec);
+        if (spec->axis == 2) {
+            // 마지막 축을 옮겼으므로 입력 버퍼 반환
+            atomic_store_explicit(&spec->ready, false, memory_order_release);
+        }
+        spec->stage = 0;
+        spec->phase = GYRO_SPECTRUM_STAGE;
+        break;
+
+    case GYRO_SPECTRUM_STAGE:
+        gyro_spectrum_butterfly(spec);
+        if (++spec->stage >= gyro_spectrum_stages()) {
+            spec->phase = GYRO_SPECTRUM_SPLIT;
+        }
+        break;
+
+    case GYRO_SPECTRUM_SPLIT:
+        gyro_spectrum_split(spec);
+        if (++spec->axis < 3) {
+            spec->phase = GYRO_SPECTRUM_LOAD;
+        } else {
+            spec->phase = GYRO_SPECTRUM_PEAKS;
+        }
+        break;
+
+    case GYRO_SPECTRUM_PEAKS:
+        gyro_spectrum_peaks(spec);
+        spec->stats.analyses++;
+        spec->stats.steps++;
+        spec->phase = GYRO_SPECTRUM_WAIT;
+        return true;
+    }
+
+    spec->stats.steps++;
+
+    return false;
+}
+
+/**
+ * @brief 추적 중인 봉우리
+ */
+uint8_t gyro_spectrum_get_peaks(const GyroSpectrum *spec, float *peak_hz) {
+    if (spec == NULL) {
+        return 0;
+    }
+
+    if (peak_hz != NULL) {
+        for (uint8_t i = 0; i < spec->peak_count; i++) {
+            peak_hz[i] = spec->peak_hz[i];
+        }
+    }
+
+    return spec->peak_count;
+}
+
+/**
+ * @brief 분석 통계
+ */
+const GyroSpectrumStats *gyro_spectrum_get_stats(const GyroSpectrum *spec) {
+    if (spec == NULL) {
+        return NULL;
+    }
+
+    return &spec->stats;
+}
@@ -0,0 +1,386 @@
+/**
+ * @file hil_feed.c
+ * @brief HIL 센서 공급기 구현
+ */
+
+#include "sensors/hil_feed.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool hil_feed_default_config(HilFeedConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->lead_us = HIL_FEED_DEFAULT_LEAD_US;
+    config->late_us = HIL_FEED_DEFAULT_LATE_US;
+    config->resync_us = HIL_FEED_DEFAULT_RESYNC_US;
+
+    return true;
+}
+
+/**
+ * @brief 공급기 초기화 및 DMA 수신 시작
+ */
+bool hil_feed_init(HilFeed *hil, UART_HandleTypeDef *huart, MeasQueue *queue, HwCrc *crc,
+                   const HilFeedConfig *config) {
+    if (hil == NULL || huart == NULL || queue == NULL) {
+        return false;
+    }
+
+    HilFeedConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        hil_feed_default_config(&cfg);
+    }
+    if (cfg.resync_us == 0) {
+        return false;
+    }
+
+    memset(hil, 0, sizeof(*hil));
+    hil->huart = huart;
+    hil->queue = queue;
+    hil->crc = crc;
+    hil->config = cfg;
+    atomic_init(&hil->head, 0);
+    atomic_init(&hil->tail, 0);
+    atomic_init(&hil->fix_seq, 0);
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(huart, hil->dma_buffer, HIL_FEED_DMA_SIZE) != HAL_OK) {
+        return false;
+    }
+
+    hil->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 레코드 종류별 크기 (0이면 받지 않는 종류)
+ */
+static uint8_t hil_feed_record_size(uint8_t type) {
+    switch (type) {
+    case FLASH_LOG_REC_IMU:
+        return (uint8_t)sizeof(FlashLogImuRecord);
+    case FLASH_LOG_REC_BARO:
+        return (uint8_t)sizeof(FlashLogBaroRecord);
+    case FLASH_LOG_REC_MAG:
+        return (uint8_t)sizeof(FlashLogMagRecord);
+    case FLASH_LOG_REC_GNSS:
+        return (uint8_t)sizeof(FlashLogGnssRecord);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief 검사한 레코드 프레임을 중계 링에 넣음
+ */
+static bool hil_feed_accept(HilFeed *hil, uint16_t seq, const uint8_t *payload, uint8_t len, uint32_t now_us) {
+    if (hil->has_seq) {
+        hil->stats.lost += (uint16_t)(seq - hil->last_seq - 1u);
+    }
+    hil->has_seq = true;
+    hil->last_seq = seq;
+    hil->stats.frames++;
+
+    uint8_t type = (len > 0) ? payload[0] : 0u;
+    uint8_t size = hil_feed_record_size(type);
+    if (size == 0 || len != (uint8_t)(size + 1u)) {
+        hil->stats.bad_records++;
+        return false;
+    }
+
+    // 모든 레코드는 측정 시각(u32)으로 시작
+    uint32_t rec_us;
+    memcpy(&rec_us, &payload[1], sizeof(rec_us));
+
+    // 시각 차이는 처음과 호스트 재시작(IMU 시각이 크게 뜀) 때만 잡음
+    int32_t jump = (int32_t)(rec_us - hil->last_rec_us);
+    bool restart = type == FLASH_LOG_REC_IMU &&
+                   (jump > (int32_t)hil->config.resync_us || jump < -(int32_t)hil->config.resync_us);
+    if (!hil->anchored || restart) {
+        if (hil->anchored) {
+            hil->stats.resyncs++;
+        }
+        hil->offset_us = now_us + hil->config.lead_us - rec_us;
+        hil->last_rec_us = rec_us;
+        hil->anchored = true;
+    }
+
+    uint32_t due = rec_us + hil->offset_us;
+    if (type == FLASH_LOG_REC_IMU) {
+        hil->last_rec_us = rec_us;
+        if ((int32_t)(now_us - due) > (int32_t)hil->config.late_us) {
+            hil->stats.late++;
+        }
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&hil->head, memory_order_relaxed);
+    uint_fast32_t tail = atomic_load_explicit(&hil->tail, memory_order_acquire);
+    uint32_t fill = (uint32_t)(head - tail);
+    if (fill >= HIL_FEED_STAGE_SIZE) {
+        hil->stats.overflow++;
+        return false;
+    }
+
+    HilFeedItem *item = &hil->stage[head & (HIL_FEED_STAGE_SIZE - 1u)];
+    item->due_us = due;
+    item->type = type;
+    memcpy(&item->rec, &payload[1], size);
+
+    atomic_store_explicit(&hil->head, head + 1u, memory_order_release);
+    if (fill + 1u > hil->stats.max_fill) {
+        hil->stats.max_fill = fill + 1u;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 수신 바이트 하나로 프레임 조립
+ */
+static bool hil_feed_byte(HilFeed *hil, uint8_t byte, uint32_t now_us) {
+    uint16_t n = hil->frame_len;
+
+    if (n == 0) {
+        if (byte == TELEMETRY_FRAME_SYNC1) {
+            hil->frame[hil->frame_len++] = byte;
+        }
+        return false;
+    }
+    if (n == 1) {
+        if (byte == TELEMETRY_FRAME_SYNC2) {
+            hil->frame[hil->frame_len++] = byte;
+        } else {
+            hil->frame_len = (byte == TELEMETRY_FRAME_SYNC1) ? 1u : 0u;
+        }
+        return false;
+    }
+
+    hil->frame[hil->frame_len++] = byte;
+    if (n == 2 && (uint32_t)TELEMETRY_FRAME_HEADER + byte + TELEMETRY_FRAME_TRAILER > HIL_FEED_FRAME_MAX) {
+        // 레코드 프레임보다 긴 길이: 다음 동기 바이트부터 다시 찾음
+        hil->stats.crc_errors++;
+        hil->frame_len = 0;
+        return false;
+    }
+    if (hil->frame_len < 3u ||
+        hil->frame_len < (uint16_t)(TELEMETRY_FRAME_HEADER + hil->frame[2] + TELEMETRY_FRAME_TRAILER)) {
+        return false;
+    }
+
+    uint16_t size = hil->frame_len;
+    hil->frame_len = 0;
+
+    uint8_t type;
+    uint16_t seq;
+    uint8_t len;
+    if (telemetry_frame_check(hil->crc, hil->frame, size, &type, &seq, &len) == 0) {
+        hil->stats.crc_errors++;
+        return false;
+    }
+    if (type != HIL_FEED_TYPE_RECORD) {
+        return false;
+    }
+
+    return hil_feed_accept(hil, seq, &hil->frame[TELEMETRY_FRAME_HEADER], len, now_us);
+}
+
+/**
+ * @brief UART 수신 이벤트 처리
+ */
+uint32_t hil_feed_handle_rx_event(HilFeed *hil, uint16_t position, uint32_t now_us) {
+    if (hil == NULL || !hil->initialized || position > HIL_FEED_DMA_SIZE) {
+        return 0;
+    }
+
+    // 완료 이벤트는 position == 크기 (버퍼 처음으로 돌아감)
+    uint16_t end = (position == HIL_FEED_DMA_SIZE) ? 0u : position;
+    uint16_t i = hil->read_index;
+    uint32_t staged = 0;
+
+    while (i != end) {
+        if (hil_feed_byte(hil, hil->dma_buffer[i], now_us)) {
+            staged++;
+        }
+        i = (uint16_t)((i + 1u == HIL_FEED_DMA_SIZE) ? 0u : i + 1u);
+    }
+    hil->read_index = end;
+
+    return staged;
+}
+
+/**
+ * @brief UART 오류 처리
+ */
+void hil_feed_handle_uart_error(HilFeed *hil) {
+    if (hil == NULL || !hil->initialized) {
+        return;
+    }
+
+    hil->stats.uart_errors++;
+
+    HAL_UART_AbortReceive(hil->huart);
+    hil->read_index = 0;
+    hil->frame_len = 0;
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(hil->huart, hil->dma_buffer, HIL_FEED_DMA_SIZE) != HAL_OK) {
+        hil->initialized = false;
+    }
+}
+
+/**
+ * @brief GNSS 레코드를 해로 게시
+ */
+static void hil_feed_publish_fix(HilFeed *hil, const FlashLogGnssRecord *rec, uint32_t due_us) {
+    uint_fast32_t next = atomic_load_explicit(&hil->fix_seq, memory_order_relaxed) + 1;
+    UbxGnssFix *fix = &hil->fix[next & 1u];
+
+    fix->timestamp_us = due_us;
+    fix->itow_ms = rec->itow_ms;
+    fix->lat_e7 = rec->lat_e7;
+    fix->lon_e7 = rec->lon_e7;
+    fix->height_mm = rec->height_mm;
+    fix->hmsl_mm = rec->hmsl_mm;
+    fix->vel_ned = vector3f_create(rec->vel_ned[0], rec->vel_ned[1], rec->vel_ned[2]);
+    fix->h_acc = rec->h_acc;
+    fix->v_acc = rec->v_acc;
+    fix->s_acc = rec->s_acc;
+    fix->fix_type = rec->fix_type;
+    fix->num_sv = rec->num_sv;
+    fix->fix_ok = (rec->flags & 0x01u) != 0;
+    fix->pulse_locked = (rec->flags & 0x02u) != 0;
+
+    // 해 기록이 시퀀스보다 먼저 보이도록 release
+    atomic_store_explicit(&hil->fix_seq, next, memory_order_release);
+}
+
+/**
+ * @brief 레코드 하나 내보내기
+ */
+static bool hil_feed_release(HilFeed *hil, const HilFeedItem *item) {
+    uint32_t t = item->due_us;
+
+    switch (item->type) {
+    case FLASH_LOG_REC_IMU: {
+        const FlashLogImuRecord *r = &item->rec.imu;
+        if (!meas_queue_push_imu(hil->queue, t, vector3f_create(r->gyro[0], r->gyro[1], r->gyro[2]),
+                                 vector3f_create(r->accel[0], r->accel[1], r->accel[2]))) {
+            hil->stats.queue_drops++;
+            return false;
+        }
+        hil->stats.released[MEAS_TYPE_IMU]++;
+        return true;
+    }
+    case FLASH_LOG_REC_BARO:
+        if (!meas_queue_push_baro(hil->queue, t, item->rec.baro.pressure_pa, item->rec.baro.temp_c)) {
+            hil->stats.queue_drops++;
+            return false;
+        }
+        hil->stats.released[MEAS_TYPE_BARO]++;
+        return false;
+    case FLASH_LOG_REC_MAG: {
+        const FlashLogMagRecord *r = &item->rec.mag;
+        if (!meas_queue_push_mag(hil->queue, t, vector3f_create(r->field[0], r->field[1], r->field[2]))) {
+            hil->stats.queue_drops++;
+            return false;
+        }
+        hil->stats.released[MEAS_TYPE_MAG]++;
+        return false;
+    }
+    case FLASH_LOG_REC_GNSS:
+        hil_feed_publish_fix(hil, &item->rec.gnss, t);
+        hil->stats.released[MEAS_TYPE_GNSS]++;
+        return false;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief 배출 시각이 된 레코드를 수집 대기열로 내보냄
+ */
+uint32_t hil_feed_service(HilFeed *hil, uint32_t now_us) {
+    if (hil == NULL || !hil->initialized) {
+        return 0;
+    }
+
+    uint_fast32_t tail = atomic_load_explicit(&hil->tail, memory_order_relaxed);
+    uint_fast32_t head = atomic_load_explicit(&hil->head, memory_order_acquire);
+    uint32_t imu = 0;
+
+    while (tail != head) {
+        const HilFeedItem *item = &hil->stage[tail & (HIL_FEED_STAGE_SIZE - 1u)];
+        if ((int32_t)(now_us - item->due_us) < 0) {
+            break;
+        }
+        if (hil_feed_release(hil, item)) {
+            imu++;
+        }
+        tail++;
+    }
+    atomic_store_explicit(&hil->tail, tail, memory_order_release);
+
+    return imu;
+}
+
+/**
+ * @brief 최신 GNSS 해 읽기
+ */
+bool hil_feed_read_fix(const HilFeed *hil, UbxGnssFix *fix, uint32_t *seq) {
+    if (hil == NULL || fix == NULL) {
+        return false;
+    }
+
+    for (uint8_t attempt = 0; attempt < HIL_FEED_MAX_RETRIES; attempt++) {
+        uint_fast32_t before = atomic_load_explicit(&hil->fix_seq, memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        *fix = hil->fix[before & 1u];
+
+        // 복사가 두 번째 시퀀스 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(&hil->fix_seq, memory_order_relaxed);
+
+        if (after - before < 2) {
+            if (seq != NULL) {
+                *seq = (uint32_t)before;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 중계 링 사용량
+ */
+uint32_t hil_feed_pending(const HilFeed *hil) {
+    if (hil == NULL) {
+        return 0;
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&hil->head, memory_order_acquire);
+    uint_fast32_t tail = atomic_load_explicit(&hil->tail, memory_order_relaxed);
+
+    return (uint32_t)(head - tail);
+}
+
+/**
+ * @brief 통계
+ */
+const HilFeedStats *hil_feed_get_stats(const HilFeed *hil) {
+    if (hil == NULL) {
+        return NULL;
+    }
+
+    return &hil->stats;
+}
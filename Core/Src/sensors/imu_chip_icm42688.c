@@ -0,0 +1,162 @@
+/**
+ * @file imu_chip_icm42688.c
+ * @brief ICM-42688-P 칩 모듈 구현 (레지스터 설정)
+ */
+
+#include "sensors/imu_driver.h"
+
+#if IMU_DRIVER_CHIP == IMU_CHIP_ICM42688
+
+#include <stddef.h>
+
+/**
+ * @brief 레지스터 주소 (뱅크 0)
+ */
+#define ICM42688_REG_DEVICE_CONFIG  0x11
+#define ICM42688_REG_INT_CONFIG     0x14
+#define ICM42688_REG_FIFO_CONFIG    0x16
+#define ICM42688_REG_FIFO_COUNTH    0x2E
+#define ICM42688_REG_PWR_MGMT0      0x4E
+#define ICM42688_REG_GYRO_CONFIG0   0x4F
+#define ICM42688_REG_ACCEL_CONFIG0  0x50
+#define ICM42688_REG_FIFO_CONFIG1   0x5F
+#define ICM42688_REG_FIFO_CONFIG2   0x60
+#define ICM42688_REG_FIFO_CONFIG3   0x61
+#define ICM42688_REG_INT_CONFIG1    0x64
+#define ICM42688_REG_INT_SOURCE0    0x65
+#define ICM42688_REG_WHO_AM_I       0x75
+
+#define ICM42688_WHO_AM_I_VALUE     0x47
+
+/**
+ * @brief FIFO 워터마크 최대값 (바이트, 12비트)
+ */
+#define ICM42688_FIFO_WATERMARK_MAX 0x0FFFu
+
+/**
+ * @brief ODR 설정 코드
+ */
+static const struct {
+    uint16_t hz;
+    uint8_t code;
+} icm42688_odr[] = {
+    { 8000, 0x03 }, { 4000, 0x04 }, { 2000, 0x05 }, { 1000, 0x06 }, { 500, 0x0F },
+    { 200, 0x07 }, { 100, 0x08 }, { 50, 0x09 }, { 25, 0x0A },
+};
+
+/**
+ * @brief 자이로 범위 설정 (FS_SEL, LSB/dps)
+ */
+static const struct {
+    uint16_t dps;
+    uint8_t fs_sel;
+    float lsb_per_dps;
+} icm42688_gyro_range[] = {
+    { 2000, 0, 16.4f }, { 1000, 1, 32.8f }, { 500, 2, 65.5f }, { 250, 3, 131.0f }, { 125, 4, 262.0f },
+};
+
+/**
+ * @brief 가속도 범위 설정 (FS_SEL, LSB/g)
+ */
+static const struct {
+    uint8_t g;
+    uint8_t fs_sel;
+    float lsb_per_g;
+} icm42688_accel_range[] = {
+    { 16, 0, 2048.0f }, { 8, 1, 4096.0f }, { 4, 2, 8192.0f }, { 2, 3, 16384.0f },
+};
+
+/**
+ * @brief 소프트 리셋과 WHO_AM_I 확인
+ */
+bool imu_chip_probe(const ImuBus *bus) {
+    // 소프트 리셋 (1ms 대기)
+    if (!imu_bus_write_reg(bus, ICM42688_REG_DEVICE_CONFIG, 0x01)) {
+        return false;
+    }
+    HAL_Delay(2);
+
+    uint8_t who_am_i = 0;
+    return imu_bus_read_regs(bus, ICM42688_REG_WHO_AM_I | ICM42688_SPI_READ, &who_am_i, 1) &&
+           who_am_i == ICM42688_WHO_AM_I_VALUE;
+}
+
+/**
+ * @brief 측정/FIFO/인터럽트 설정
+ */
+bool imu_chip_configure(const ImuBus *bus, const ImuDriverConfig *config, ImuChipScale *scale) {
+    int8_t odr = -1;
+    for (uint8_t i = 0; i < sizeof(icm42688_odr) / sizeof(icm42688_odr[0]); i++) {
+        if (icm42688_odr[i].hz == config->odr_hz) {
+            odr = (int8_t)i;
+        }
+    }
+    int8_t gyro = -1;
+    for (uint8_t i = 0; i < sizeof(icm42688_gyro_range) / sizeof(icm42688_gyro_range[0]); i++) {
+        if (icm42688_gyro_range[i].dps == config->gyro_range_dps) {
+            gyro = (int8_t)i;
+        }
+    }
+    int8_t accel = -1;
+    for (uint8_t i = 0; i < sizeof(icm42688_accel_range) / sizeof(icm42688_accel_range[0]); i++) {
+        if (icm42688_accel_range[i].g == config->accel_range_g) {
+            accel = (int8_t)i;
+        }
+    }
+    if (odr < 0 || gyro < 0 || accel < 0 || config->fifo_watermark == 0 ||
+        config->fifo_watermark > IMU_CHIP_MAX_FRAMES) {
+        return false;
+    }
+
+    // 워터마크 (바이트 단위, 12비트)
+    uint16_t watermark = (uint16_t)(config->fifo_watermark * IMU_CHIP_FRAME_SIZE);
+    if (watermark > ICM42688_FIFO_WATERMARK_MAX) {
+        return false;
+    }
+
+    uint8_t odr_code = icm42688_odr[odr].code;
+    const uint8_t regs[][2] = {
+        { ICM42688_REG_GYRO_CONFIG0, (uint8_t)((icm42688_gyro_range[gyro].fs_sel << 5) | odr_code) },
+        { ICM42688_REG_ACCEL_CONFIG0, (uint8_t)((icm42688_accel_range[accel].fs_sel << 5) | odr_code) },
+        { ICM42688_REG_INT_CONFIG, 0x03 },              // INT1 푸시풀, 액티브 하이, 펄스
+        { ICM42688_REG_INT_CONFIG1, 0x00 },             // INT_ASYNC_RESET 해제
+        { ICM42688_REG_FIFO_CONFIG, 0x40 },             // Stream-to-FIFO 모드
+        { ICM42688_REG_FIFO_CONFIG1, 0x27 },            // 가속도+자이로+온도, 워터마크 이상이면 매 ODR 인터럽트
+        { ICM42688_REG_FIFO_CONFIG2, (uint8_t)(watermark & 0xFF) },
+        { ICM42688_REG_FIFO_CONFIG3, (uint8_t)((watermark >> 8) & 0x0F) },
+        { ICM42688_REG_INT_SOURCE0, 0x04 },             // FIFO 워터마크 -> INT1
+        { ICM42688_REG_PWR_MGMT0, 0x0F }                // 가속도/자이로 저잡음 모드
+    };
+
+    for (uint8_t i = 0; i < sizeof(regs) / sizeof(regs[0]); i++) {
+        if (!imu_bus_write_reg(bus, regs[i][0], regs[i][1])) {
+            return false;
+        }
+    }
+
+    // 자이로 기동 시간 대기
+    HAL_Delay(50);
+
+    scale->gyro = 3.14159265358979f / 180.0f / icm42688_gyro_range[gyro].lsb_per_dps;
+    scale->accel = 9.80665f / icm42688_accel_range[accel].lsb_per_g;
+
+    return true;
+}
+
+/**
+ * @brief FIFO에 쌓인 프레임 수
+ */
+bool imu_chip_read_fifo_frames(const ImuBus *bus, uint16_t *frames) {
+    // FIFO 바이트 수 (빅엔디안)
+    uint8_t count_raw[2];
+    if (!imu_bus_read_regs(bus, ICM42688_REG_FIFO_COUNTH | ICM42688_SPI_READ, count_raw, 2)) {
+        return false;
+    }
+
+    uint16_t count = (uint16_t)(((uint16_t)count_raw[0] << 8) | count_raw[1]);
+    *frames = count / IMU_CHIP_FRAME_SIZE;
+
+    return true;
+}
+
+#endif /* IMU_DRIVER_CHIP == IMU_CHIP_ICM42688 */
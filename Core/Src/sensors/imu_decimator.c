@@ -0,0 +1,176 @@
+/**
+ * @file imu_decimator.c
+ * @brief 다상 FIR 데시메이션 구현
+ */
+
+#include "sensors/imu_decimator.h"
+#include "math/fast_math.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#define IMU_DECIMATOR_PI 3.14159265358979f
+
+/**
+ * @brief 창 sinc 저역 통과 계수 설계 (Blackman 창, DC 이득 1)
+ *
+ * @param coeffs 결과 계수
+ * @param taps 필터 길이
+ * @param fc 차단 주파수 (입력 샘플링 주파수 대비, 0..0.5)
+ */
+static void imu_decimator_design(float *coeffs, uint8_t taps, float fc) {
+    float center = 0.5f * (float)(taps - 1);
+    float sum = 0.0f;
+
+    for (uint8_t k = 0; k < taps; k++) {
+        float t = (float)k - center;
+        float sinc = (t == 0.0f) ? 2.0f * fc : fp_sinf(2.0f * IMU_DECIMATOR_PI * fc * t) / (IMU_DECIMATOR_PI * t);
+        float window = 1.0f;
+        if (taps > 1) {
+            float u = 2.0f * IMU_DECIMATOR_PI * (float)k / (float)(taps - 1);
+            window = 0.42f - 0.5f * fp_cosf(u) + 0.08f * fp_cosf(2.0f * u);
+        }
+        coeffs[k] = sinc * window;
+        sum += coeffs[k];
+    }
+
+    // 바이어스가 그대로 통과하도록 DC 이득을 1로 맞춤
+    for (uint8_t k = 0; k < taps; k++) {
+        coeffs[k] /= sum;
+    }
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool imu_decimator_default_config(ImuDecimatorConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->factor = IMU_DECIMATOR_DEFAULT_FACTOR;
+    config->taps = IMU_DECIMATOR_DEFAULT_TAPS;
+    config->cutoff = IMU_DECIMATOR_DEFAULT_CUTOFF;
+
+    return true;
+}
+
+/**
+ * @brief 데시메이터 초기화
+ */
+bool imu_decimator_init(ImuDecimator *dec, const ImuDecimatorConfig *config) {
+    if (dec == NULL) {
+        return false;
+    }
+
+    ImuDecimatorConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        imu_decimator_default_config(&cfg);
+    }
+    if (cfg.factor < 1 || cfg.factor > IMU_DECIMATOR_MAX_FACTOR || cfg.taps < cfg.factor ||
+        cfg.taps > IMU_DECIMATOR_MAX_TAPS || !(cfg.cutoff > 0.0f) || cfg.cutoff > 1.0f) {
+        return false;
+    }
+
+    memset(dec, 0, sizeof(*dec));
+    dec->config = cfg;
+
+    // 출력 나이퀴스트 = 입력 샘플링 주파수 / (2 factor)
+    imu_decimator_design(dec->coeffs, cfg.taps, cfg.cutoff * 0.5f / (float)cfg.factor);
+
+    return true;
+}
+
+/**
+ * @brief 이력 초기화와 입력 주기 설정
+ */
+bool imu_decimator_reset(ImuDecimator *dec, uint32_t input_period_us) {
+    if (dec == NULL || input_period_us == 0) {
+        return false;
+    }
+
+    memset(dec->history, 0, sizeof(dec->history));
+    dec->pos = 0;
+    dec->phase = 0;
+    dec->filled = 0;
+
+    // 선형 위상 FIR 군지연 (taps - 1) / 2 샘플
+    dec->group_delay_us = (uint32_t)(dec->config.taps - 1) * input_period_us / 2u;
+
+    return true;
+}
+
+/**
+ * @brief 입력 샘플 하나 추가
+ */
+bool imu_decimator_push(ImuDecimator *dec, const ImuSample *in, ImuSample *out) {
+    if (dec == NULL || in == NULL || out == NULL) {
+        return false;
+    }
+
+    uint8_t taps = dec->config.taps;
+    const float x[IMU_DECIMATOR_CHANNELS] = {
+        in->gyro.x, in->gyro.y, in->gyro.z, in->accel.x, in->accel.y, in->accel.z
+    };
+
+    // 두 번 기록하여 history[c][pos .. pos + taps - 1]이 항상 시간 순 창이 되게 함
+    for (uint8_t c = 0; c < IMU_DECIMATOR_CHANNELS; c++) {
+        dec->history[c][dec->pos] = x[c];
+        dec->history[c][dec->pos + taps] = x[c];
+    }
+    dec->pos = (uint8_t)(dec->pos + 1 == taps ? 0 : dec->pos + 1);
+    if (dec->filled < taps) {
+        dec->filled++;
+    }
+    dec->stats.inputs++;
+
+    if (++dec->phase < dec->config.factor) {
+        return false;
+    }
+    dec->phase = 0;
+    if (dec->filled < taps) {
+        return false;
+    }
+
+    // 출력 시각에만 합성곱 (계수가 대칭이므로 창 순서 그대로 곱함)
+    float y[IMU_DECIMATOR_CHANNELS];
+    for (uint8_t c = 0; c < IMU_DECIMATOR_CHANNELS; c++) {
+        const float *window = &dec->history[c][dec->pos];
+        float acc = 0.0f;
+        for (uint8_t k = 0; k < taps; k++) {
+            acc += dec->coeffs[k] * window[k];
+        }
+        y[c] = acc;
+    }
+
+    out->timestamp_us = in->timestamp_us - dec->group_delay_us;
+    out->gyro = vector3f_create(y[0], y[1], y[2]);
+    out->accel = vector3f_create(y[3], y[4], y[5]);
+    dec->stats.outputs++;
+
+    return true;
+}
+
+/**
+ * @brief 군지연 (us)
+ */
+uint32_t imu_decimator_get_group_delay_us(const ImuDecimator *dec) {
+    if (dec == NULL) {
+        return 0;
+    }
+
+    return dec->group_delay_us;
+}
+
+/**
+ * @brief 데시메이션 통계
+ */
+const ImuDecimatorStats *imu_decimator_get_stats(const ImuDecimator *dec) {
+    if (dec == NULL) {
+        return NULL;
+    }
+
+    return &dec->stats;
+}
@@ -0,0 +1,419 @@
+/**
+ * @file imu_driver.c
+ * @brief 공통 IMU FIFO 버스트 드라이버 구현 (SPI + DMA)
+ */
+
+#include "sensors/imu_driver.h"
+#include "sys/trace.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 차단형 SPI 제한 시간 (ms)
+ */
+#define IMU_BUS_TIMEOUT_MS 10
+
+/**
+ * @brief 몸체 축별 (센서 축, 부호)
+ */
+static const uint8_t imu_driver_body_axis[3] = { IMU_DRIVER_BODY_X_AXIS, IMU_DRIVER_BODY_Y_AXIS, IMU_DRIVER_BODY_Z_AXIS };
+static const float imu_driver_body_sign[3] = { IMU_DRIVER_BODY_X_SIGN, IMU_DRIVER_BODY_Y_SIGN, IMU_DRIVER_BODY_Z_SIGN };
+
+static void imu_bus_select(const ImuBus *bus) {
+    HAL_GPIO_WritePin(bus->cs_port, bus->cs_pin, GPIO_PIN_RESET);
+}
+
+static void imu_bus_deselect(const ImuBus *bus) {
+    HAL_GPIO_WritePin(bus->cs_port, bus->cs_pin, GPIO_PIN_SET);
+}
+
+/**
+ * @brief 레지스터 쓰기 (차단형)
+ */
+bool imu_bus_write_reg(const ImuBus *bus, uint8_t reg, uint8_t value) {
+    uint8_t tx[2] = { reg, value };
+
+    imu_bus_select(bus);
+    HAL_StatusTypeDef status = HAL_SPI_Transmit(bus->hspi, tx, 2, IMU_BUS_TIMEOUT_MS);
+    imu_bus_deselect(bus);
+
+    return status == HAL_OK;
+}
+
+/**
+ * @brief 연속 레지스터 읽기 (차단형)
+ */
+bool imu_bus_read_regs(const ImuBus *bus, uint8_t reg, uint8_t *data, uint8_t len) {
+    uint8_t tx[4] = { reg, 0, 0, 0 };
+    uint8_t rx[4];
+
+    if (len == 0 || len > 3) {
+        return false;
+    }
+
+    imu_bus_select(bus);
+    HAL_StatusTypeDef status = HAL_SPI_TransmitReceive(bus->hspi, tx, rx, (uint16_t)(len + 1),
+                                                       IMU_BUS_TIMEOUT_MS);
+    imu_bus_deselect(bus);
+
+    if (status != HAL_OK) {
+        return false;
+    }
+
+    memcpy(data, &rx[1], len);
+    return true;
+}
+
+/**
+ * @brief 벡터 성분 (0=X 1=Y 2=Z)
+ */
+static float imu_driver_component(Vector3f v, uint8_t axis) {
+    return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+/**
+ * @brief 보정 행렬에 보드 방향과 LSB 스케일을 접음 (F = R_board M s)
+ */
+static void imu_driver_fold_transform(float F[3][3], const float M[3][3], float scale) {
+    for (uint8_t i = 0; i < 3; i++) {
+        const float *row = M[imu_driver_body_axis[i]];
+        for (uint8_t j = 0; j < 3; j++) {
+            F[i][j] = imu_driver_body_sign[i] * scale * row[j];
+        }
+    }
+}
+
+/**
+ * @brief 보정 오프셋을 몸체 좌표계로 (R_board M b(T))
+ */
+static Vector3f imu_driver_fold_offset(Vector3f offset) {
+    return vector3f_create(imu_driver_body_sign[0] * imu_driver_component(offset, imu_driver_body_axis[0]),
+                           imu_driver_body_sign[1] * imu_driver_component(offset, imu_driver_body_axis[1]),
+                           imu_driver_body_sign[2] * imu_driver_component(offset, imu_driver_body_axis[2]));
+}
+
+/**
+ * @brief 원시 정수 벡터 변환 (F raw - o)
+ */
+static Vector3f imu_driver_transform(const float F[3][3], const int16_t raw[3], Vector3f offset) {
+    float x = (float)raw[0];
+    float y = (float)raw[1];
+    float z = (float)raw[2];
+    return vector3f_create(F[0][0] * x + F[0][1] * y + F[0][2] * z - offset.x,
+                           F[1][0] * x + F[1][1] * y + F[1][2] * z - offset.y,
+                           F[2][0] * x + F[2][1] * y + F[2][2] * z - offset.z);
+}
+
+/**
+ * @brief 현재 스케일과 보정으로 변환 상수 다시 계산
+ */
+static void imu_driver_rebuild(ImuDriver *imu) {
+    for (uint8_t i = 0; i < 3; i++) {
+        imu->body_scale_gyro[i] = imu_driver_body_sign[i] * imu->scale.gyro;
+        imu->body_scale_accel[i] = imu_driver_body_sign[i] * imu->scale.accel;
+    }
+
+    if (imu->cal != NULL) {
+        imu_driver_fold_transform(imu->gyro_transform, imu->cal->coeffs->gyro.M, imu->scale.gyro);
+        imu_driver_fold_transform(imu->accel_transform, imu->cal->coeffs->accel.M, imu->scale.accel);
+        imu->gyro_offset = imu_driver_fold_offset(imu->cal->gyro_offset);
+        imu->accel_offset = imu_driver_fold_offset(imu->cal->accel_offset);
+    }
+}
+
+/**
+ * @brief 칩 기본 설정
+ */
+bool imu_driver_default_config(ImuDriverConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->odr_hz = IMU_CHIP_DEFAULT_ODR_HZ;
+    config->gyro_range_dps = IMU_CHIP_DEFAULT_GYRO_RANGE_DPS;
+    config->accel_range_g = IMU_CHIP_DEFAULT_ACCEL_RANGE_G;
+    config->fifo_watermark = IMU_CHIP_DEFAULT_FIFO_WATERMARK;
+
+    return true;
+}
+
+/**
+ * @brief 센서 확인, 측정/FIFO 설정
+ */
+bool imu_driver_init(ImuDriver *imu, const ImuBus *bus, ImuRing *ring, const ImuDriverConfig *config) {
+    if (imu == NULL || bus == NULL || bus->hspi == NULL || bus->cs_port == NULL || ring == NULL) {
+        return false;
+    }
+
+    memset(imu, 0, sizeof(*imu));
+    imu->bus = *bus;
+    imu->ring = ring;
+    imu->dma_state = IMU_DRIVER_DMA_IDLE;
+
+    // DMA 송신 버퍼: 첫 바이트는 FIFO 데이터 읽기 명령, 나머지는 더미
+    imu->tx_buffer[0] = imu_chip_fifo_read_command();
+
+    imu_bus_deselect(&imu->bus);
+
+    if (!imu_chip_probe(&imu->bus)) {
+        return false;
+    }
+
+    ImuDriverConfig defaults;
+    if (config == NULL) {
+        imu_driver_default_config(&defaults);
+        config = &defaults;
+    }
+    if (!imu_driver_configure(imu, config)) {
+        return false;
+    }
+
+    imu->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 측정 설정 변경
+ */
+bool imu_driver_configure(ImuDriver *imu, const ImuDriverConfig *config) {
+    if (imu == NULL || config == NULL || config->odr_hz == 0 || imu->dma_state != IMU_DRIVER_DMA_IDLE) {
+        return false;
+    }
+
+    ImuChipScale scale;
+    if (!imu_chip_configure(&imu->bus, config, &scale)) {
+        return false;
+    }
+
+    imu->config = *config;
+    imu->scale = scale;
+    imu->period_us = 1000000u / config->odr_hz;
+    imu_driver_rebuild(imu);
+
+    // ODR이 바뀌면 이력과 군지연도 새 주기로
+    if (imu->decimator != NULL) {
+        imu_decimator_reset(imu->decimator, imu->period_us);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 온도/스케일 보정 설정
+ */
+bool imu_driver_set_calibration(ImuDriver *imu, ImuThermalCal *cal) {
+    if (imu == NULL || imu->dma_state != IMU_DRIVER_DMA_IDLE || (cal != NULL && cal->coeffs == NULL)) {
+        return false;
+    }
+
+    imu->cal = cal;
+    imu_driver_rebuild(imu);
+
+    return true;
+}
+
+/**
+ * @brief 데시메이션 단계 설정
+ */
+bool imu_driver_set_decimator(ImuDriver *imu, ImuDecimator *decimator) {
+    if (imu == NULL || imu->dma_state != IMU_DRIVER_DMA_IDLE) {
+        return false;
+    }
+    if (decimator != NULL && !imu_decimator_reset(decimator, imu->period_us)) {
+        return false;
+    }
+
+    imu->decimator = decimator;
+
+    return true;
+}
+
+/**
+ * @brief 동적 노치 단계 설정
+ */
+bool imu_driver_set_dynamic_notch(ImuDriver *imu, GyroSpectrum *spectrum, GyroNotch *notch) {
+    if (imu == NULL || imu->dma_state != IMU_DRIVER_DMA_IDLE) {
+        return false;
+    }
+
+    imu->spectrum = spectrum;
+    imu->notch = notch;
+
+    return true;
+}
+
+/**
+ * @brief 장착 위치 보정 설정
+ */
+bool imu_driver_set_lever_arm(ImuDriver *imu, ImuLeverArm *lever_arm) {
+    if (imu == NULL || imu->dma_state != IMU_DRIVER_DMA_IDLE) {
+        return false;
+    }
+
+    imu->lever_arm = lever_arm;
+
+    return true;
+}
+
+/**
+ * @brief 진동/포화 통계 설정
+ */
+bool imu_driver_set_vibration(ImuDriver *imu, ImuVibration *vibration) {
+    if (imu == NULL || imu->dma_state != IMU_DRIVER_DMA_IDLE) {
+        return false;
+    }
+
+    imu->vibration = vibration;
+
+    return true;
+}
+
+/**
+ * @brief FIFO 버스트 DMA 시작
+ */
+bool imu_driver_start_dma_burst(ImuDriver *imu, uint32_t timestamp_us) {
+    if (imu == NULL || !imu->initialized) {
+        return false;
+    }
+
+    if (imu->dma_state != IMU_DRIVER_DMA_IDLE) {
+        // 이전 버스트 진행 중 (남은 샘플은 다음 인터럽트에서 읽음)
+        imu->overrun_count++;
+        return false;
+    }
+
+    uint16_t frames;
+    if (!imu_chip_read_fifo_frames(&imu->bus, &frames) || frames == 0) {
+        return false;
+    }
+    if (frames > IMU_CHIP_MAX_FRAMES) {
+        frames = IMU_CHIP_MAX_FRAMES;
+    }
+
+    imu->burst_frames = frames;
+    imu->burst_timestamp_us = timestamp_us;
+    imu->dma_state = IMU_DRIVER_DMA_BUSY;
+
+    imu_bus_select(&imu->bus);
+    if (HAL_SPI_TransmitReceive_DMA(imu->bus.hspi, imu->tx_buffer, imu->rx_buffer,
+                                    (uint16_t)(1 + frames * IMU_CHIP_FRAME_SIZE)) != HAL_OK) {
+        imu_bus_deselect(&imu->bus);
+        imu->dma_state = IMU_DRIVER_DMA_IDLE;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief SPI DMA 완료 처리 (프레임 변환, 보정 후 링 버퍼에 추가)
+ *
+ * 버스트의 마지막 샘플을 인터럽트 시각으로 보고,
+ * 앞선 샘플은 ODR 주기만큼씩 거슬러 타임스탬프를 부여한다.
+ */
+bool imu_driver_handle_dma_complete(ImuDriver *imu) {
+    if (imu == NULL || imu->dma_state != IMU_DRIVER_DMA_BUSY) {
+        return false;
+    }
+
+    imu_bus_deselect(&imu->bus);
+    TRACE_BEGIN(TRACE_EVENT_IMU_ISR);
+
+    uint16_t frames = imu->burst_frames;
+    uint16_t out_count = 0;
+    for (uint16_t k = 0; k < frames; k++) {
+        ImuRawFrame raw;
+        if (!imu_chip_decode_fifo_frame(&imu->rx_buffer[1 + k * IMU_CHIP_FRAME_SIZE], &raw)) {
+            imu->invalid_count++;
+            continue;
+        }
+
+        // 온도 저역 통과
+        if (imu->has_temperature) {
+            imu->temperature_c += IMU_DRIVER_TEMP_FILTER_ALPHA * (raw.temperature_c - imu->temperature_c);
+        } else {
+            imu->temperature_c = raw.temperature_c;
+            imu->has_temperature = true;
+        }
+
+        ImuSample sample;
+        sample.timestamp_us = imu->burst_timestamp_us - (uint32_t)(frames - 1 - k) * imu->period_us;
+        if (imu->cal == NULL) {
+            // 축 재배치는 컴파일 시간 상수, 부호는 스케일에 접힘 (축별 곱셈 하나)
+            sample.accel = vector3f_create(raw.accel[IMU_DRIVER_BODY_X_AXIS] * imu->body_scale_accel[0],
+                                           raw.accel[IMU_DRIVER_BODY_Y_AXIS] * imu->body_scale_accel[1],
+                                           raw.accel[IMU_DRIVER_BODY_Z_AXIS] * imu->body_scale_accel[2]);
+            sample.gyro = vector3f_create(raw.gyro[IMU_DRIVER_BODY_X_AXIS] * imu->body_scale_gyro[0],
+                                          raw.gyro[IMU_DRIVER_BODY_Y_AXIS] * imu->body_scale_gyro[1],
+                                          raw.gyro[IMU_DRIVER_BODY_Z_AXIS] * imu->body_scale_gyro[2]);
+        } else {
+            // 온도가 바뀐 경우에만 오프셋 재계산
+            if (imu_thermal_cal_set_temperature(imu->cal, imu->temperature_c)) {
+                imu->gyro_offset = imu_driver_fold_offset(imu->cal->gyro_offset);
+                imu->accel_offset = imu_driver_fold_offset(imu->cal->accel_offset);
+            }
+            sample.accel = imu_driver_transform(imu->accel_transform, raw.accel, imu->accel_offset);
+            sample.gyro = imu_driver_transform(imu->gyro_transform, raw.gyro, imu->gyro_offset);
+        }
+
+        // 진동/포화는 데시메이션 전 전체 ODR로 (포화는 몸체 축 순서의 원시 값으로 판정)
+        if (imu->vibration != NULL) {
+            const int16_t clip_raw[IMU_VIBRATION_CHANNELS] = {
+                raw.gyro[IMU_DRIVER_BODY_X_AXIS], raw.gyro[IMU_DRIVER_BODY_Y_AXIS], raw.gyro[IMU_DRIVER_BODY_Z_AXIS],
+                raw.accel[IMU_DRIVER_BODY_X_AXIS], raw.accel[IMU_DRIVER_BODY_Y_AXIS], raw.accel[IMU_DRIVER_BODY_Z_AXIS]
+            };
+            imu_vibration_push(imu->vibration, &sample, clip_raw);
+        }
+
+        // 데시메이션 중이면 factor개마다 하나만 링에 넣음 (시각은 군지연 보정)
+        if (imu->decimator != NULL && !imu_decimator_push(imu->decimator, &sample, &sample)) {
+            continue;
+        }
+
+        // 분석기는 노치 전 자이로를 받아야 봉우리를 계속 볼 수 있음
+        if (imu->spectrum != NULL) {
+            gyro_spectrum_push(imu->spectrum, sample.gyro);
+        }
+        if (imu->notch != NULL) {
+            gyro_notch_apply(imu->notch, &sample.gyro);
+        }
+
+        if (imu->lever_arm != NULL) {
+            imu->burst_out[out_count++] = sample;
+            continue;
+        }
+
+        // 가득 찬 경우 링 버퍼가 dropped를 기록
+        imu_ring_push(imu->ring, &sample);
+    }
+
+    // 장착 위치 보정은 버스트 단위로 모아서 계산
+    if (out_count > 0) {
+        imu_lever_arm_apply(imu->lever_arm, imu->burst_out, out_count);
+        for (uint16_t k = 0; k < out_count; k++) {
+            imu_ring_push(imu->ring, &imu->burst_out[k]);
+        }
+    }
+
+    if (imu->vibration != NULL) {
+        imu_vibration_end_burst(imu->vibration, imu->burst_timestamp_us);
+    }
+
+    imu->dma_state = IMU_DRIVER_DMA_IDLE;
+    TRACE_END(TRACE_EVENT_IMU_ISR);
+
+    return true;
+}
+
+/**
+ * @brief SPI DMA 오류 처리 (버스트 폐기)
+ */
+void imu_driver_handle_dma_error(ImuDriver *imu) {
+    if (imu == NULL) {
+        return;
+    }
+
+    imu_bus_deselect(&imu->bus);
+    imu->dma_state = IMU_DRIVER_DMA_IDLE;
+}
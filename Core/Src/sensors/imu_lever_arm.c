@@ -0,0 +1,161 @@
+/**
+ * @file imu_lever_arm.c
+ * @brief 무게 중심 밖 IMU 장착에 따른 구심/접선 가속도 보정 구현
+ */
+
+#include "sensors/imu_lever_arm.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool imu_lever_arm_default_config(ImuLeverArmConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->offset = vector3f_zero();
+    config->alpha_cutoff_hz = IMU_LEVER_ARM_DEFAULT_ALPHA_CUTOFF_HZ;
+    config->max_gap_us = IMU_LEVER_ARM_DEFAULT_MAX_GAP_US;
+
+    return true;
+}
+
+/**
+ * @brief 보정 초기화
+ */
+bool imu_lever_arm_init(ImuLeverArm *arm, const ImuLeverArmConfig *config) {
+    if (arm == NULL) {
+        return false;
+    }
+
+    ImuLeverArmConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        imu_lever_arm_default_config(&cfg);
+    }
+    if (!(cfg.alpha_cutoff_hz >= 0.0f) || cfg.max_gap_us == 0) {
+        return false;
+    }
+
+    memset(arm, 0, sizeof(*arm));
+    arm->config = cfg;
+    atomic_init(&arm->active, 0);
+
+    return true;
+}
+
+/**
+ * @brief 자이로 바이어스 게시 (태스크 문맥)
+ */
+bool imu_lever_arm_set_gyro_bias(ImuLeverArm *arm, Vector3f bias) {
+    if (arm == NULL) {
+        return false;
+    }
+
+    // 인터럽트가 쓰지 않는 쪽에 기록한 뒤 번호 교체 (기록이 먼저 보이도록 release)
+    unsigned int next = atomic_load_explicit(&arm->active, memory_order_relaxed) ^ 1u;
+    arm->bias[next] = bias;
+    atomic_store_explicit(&arm->active, next, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief 블록 하나 보정 (count <= IMU_LEVER_ARM_BLOCK)
+ */
+static void imu_lever_arm_apply_block(ImuLeverArm *arm, ImuSample *samples, uint16_t count, Vector3f bias) {
+    float wx[IMU_LEVER_ARM_BLOCK], wy[IMU_LEVER_ARM_BLOCK], wz[IMU_LEVER_ARM_BLOCK];
+    float dx[IMU_LEVER_ARM_BLOCK], dy[IMU_LEVER_ARM_BLOCK], dz[IMU_LEVER_ARM_BLOCK];
+    float gain[IMU_LEVER_ARM_BLOCK];
+    const float tau = (arm->config.alpha_cutoff_hz > 0.0f)
+                    ? 1.0f / (2.0f * FAST_MATH_PI * arm->config.alpha_cutoff_hz) : 0.0f;
+
+    // 1. 바이어스 보정 각속도와 차분 (샘플 사이 의존 없음)
+    for (uint16_t k = 0; k < count; k++) {
+        wx[k] = samples[k].gyro.x - bias.x;
+        wy[k] = samples[k].gyro.y - bias.y;
+        wz[k] = samples[k].gyro.z - bias.z;
+    }
+    for (uint16_t k = 0; k < count; k++) {
+        uint32_t prev_us = (k > 0) ? samples[k - 1].timestamp_us : arm->last_us;
+        float px = (k > 0) ? wx[k - 1] : arm->last_omega.x;
+        float py = (k > 0) ? wy[k - 1] : arm->last_omega.y;
+        float pz = (k > 0) ? wz[k - 1] : arm->last_omega.z;
+        uint32_t gap_us = samples[k].timestamp_us - prev_us;
+        bool valid = (k > 0 || arm->has_last) && gap_us > 0 && gap_us <= arm->config.max_gap_us;
+
+        // 이득 음수는 다시 시작 표시, 차단 주파수 0이면 이득 0 (각가속도 항 없음)
+        float dt = (float)gap_us * 1e-6f;
+        float inv_dt = valid ? 1.0f / dt : 0.0f;
+        dx[k] = (wx[k] - px) * inv_dt;
+        dy[k] = (wy[k] - py) * inv_dt;
+        dz[k] = (wz[k] - pz) * inv_dt;
+        gain[k] = valid ? ((tau > 0.0f) ? dt / (dt + tau) : 0.0f) : -1.0f;
+    }
+
+    // 2. 각가속도 1차 저역 통과 (순차)
+    Vector3f alpha = arm->alpha;
+    for (uint16_t k = 0; k < count; k++) {
+        if (gain[k] < 0.0f) {
+            // 간격 초과 또는 첫 샘플: 다시 시작
+            alpha = vector3f_zero();
+            if (k > 0 || arm->has_last) {
+                arm->stats.restarts++;
+            }
+        } else {
+            alpha.x += gain[k] * (dx[k] - alpha.x);
+            alpha.y += gain[k] * (dy[k] - alpha.y);
+            alpha.z += gain[k] * (dz[k] - alpha.z);
+        }
+        dx[k] = alpha.x;
+        dy[k] = alpha.y;
+        dz[k] = alpha.z;
+    }
+    arm->alpha = alpha;
+
+    // 3. f_cg = f_imu - α × r - ω × (ω × r) (샘플 사이 의존 없음)
+    const float rx = arm->config.offset.x, ry = arm->config.offset.y, rz = arm->config.offset.z;
+    float cx = 0.0f, cy = 0.0f, cz = 0.0f;
+    for (uint16_t k = 0; k < count; k++) {
+        // ω × r
+        float ux = wy[k] * rz - wz[k] * ry;
+        float uy = wz[k] * rx - wx[k] * rz;
+        float uz = wx[k] * ry - wy[k] * rx;
+        // α × r + ω × (ω × r)
+        cx = (dy[k] * rz - dz[k] * ry) + (wy[k] * uz - wz[k] * uy);
+        cy = (dz[k] * rx - dx[k] * rz) + (wz[k] * ux - wx[k] * uz);
+        cz = (dx[k] * ry - dy[k] * rx) + (wx[k] * uy - wy[k] * ux);
+        samples[k].accel.x -= cx;
+        samples[k].accel.y -= cy;
+        samples[k].accel.z -= cz;
+    }
+
+    arm->last_omega = vector3f_create(wx[count - 1], wy[count - 1], wz[count - 1]);
+    arm->last_us = samples[count - 1].timestamp_us;
+    arm->has_last = true;
+    arm->stats.samples += count;
+    arm->stats.last_correction = fast_sqrtf(cx * cx + cy * cy + cz * cz);
+}
+
+/**
+ * @brief 버스트 샘플의 가속도 보정 (인터럽트 문맥)
+ */
+void imu_lever_arm_apply(ImuLeverArm *arm, ImuSample *samples, uint16_t count) {
+    if (arm == NULL || samples == NULL || count == 0) {
+        return;
+    }
+
+    Vector3f bias = arm->bias[atomic_load_explicit(&arm->active, memory_order_acquire)];
+
+    for (uint16_t start = 0; start < count; start += IMU_LEVER_ARM_BLOCK) {
+        uint16_t n = count - start;
+        if (n > IMU_LEVER_ARM_BLOCK) {
+            n = IMU_LEVER_ARM_BLOCK;
+        }
+        imu_lever_arm_apply_block(arm, &samples[start], n, bias);
+    }
+}
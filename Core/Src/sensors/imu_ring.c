@@ -0,0 +1,104 @@
+/**
+ * @file imu_ring.c
+ * @brief IMU 샘플용 무잠금 SPSC 링 버퍼 구현
+ */
+
+#include "sensors/imu_ring.h"
+#include <stddef.h>
+
+/**
+ * @brief 링 버퍼 초기화
+ */
+bool imu_ring_init(ImuRing *ring) {
+    if (ring == NULL) {
+        return false;
+    }
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->dropped = 0;
+    ring->tap = NULL;
+    ring->tap_context = NULL;
+
+    return true;
+}
+
+/**
+ * @brief 생산자 탭 설정
+ */
+bool imu_ring_set_tap(ImuRing *ring, ImuRingTapFn tap, void *context) {
+    if (ring == NULL) {
+        return false;
+    }
+
+    ring->tap = tap;
+    ring->tap_context = context;
+
+    return true;
+}
+
+/**
+ * @brief 샘플 추가 (생산자 전용)
+ */
+bool imu_ring_push(ImuRing *ring, const ImuSample *sample) {
+    if (ring == NULL || sample == NULL) {
+        return false;
+    }
+
+    // 탭은 소비자 상태와 무관하게 모든 샘플을 받음
+    if (ring->tap != NULL) {
+        ring->tap(sample, ring->tap_context);
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if ((uint32_t)(head - tail) >= IMU_RING_SIZE) {
+        ring->dropped++;
+        return false;
+    }
+
+    ring->buffer[head & (IMU_RING_SIZE - 1)] = *sample;
+
+    // 샘플 기록이 head 갱신보다 먼저 보이도록 release
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief 가장 오래된 샘플 꺼내기 (소비자 전용)
+ */
+bool imu_ring_pop(ImuRing *ring, ImuSample *sample) {
+    if (ring == NULL || sample == NULL) {
+        return false;
+    }
+
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+
+    *sample = ring->buffer[tail & (IMU_RING_SIZE - 1)];
+
+    // 샘플 읽기가 끝난 뒤 슬롯을 생산자에게 반환
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief 저장된 샘플 수
+ */
+uint32_t imu_ring_count(const ImuRing *ring) {
+    if (ring == NULL) {
+        return 0;
+    }
+
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    return (uint32_t)(head - tail);
+}
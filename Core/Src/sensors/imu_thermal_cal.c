@@ -0,0 +1,145 @@
+/**
+ * @file imu_thermal_cal.c
+ * @brief IMU 온도 보상과 스케일/비정렬 보정 구현
+ */
+
+#include "sensors/imu_thermal_cal.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief 축별 바이어스 다항식 (Horner)
+ */
+static Vector3f imu_thermal_cal_bias(const ImuThermalAxisCoeffs *c, float dt) {
+    float b[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        float v = c->bias[i][IMU_THERMAL_CAL_TERMS - 1];
+        for (int8_t k = IMU_THERMAL_CAL_TERMS - 2; k >= 0; k--) {
+            v = v * dt + c->bias[i][k];
+        }
+        b[i] = v;
+    }
+    return vector3f_create(b[0], b[1], b[2]);
+}
+
+/**
+ * @brief M v
+ */
+static Vector3f imu_thermal_cal_transform(const float M[3][3], Vector3f v) {
+    return vector3f_create(M[0][0] * v.x + M[0][1] * v.y + M[0][2] * v.z,
+                           M[1][0] * v.x + M[1][1] * v.y + M[1][2] * v.z,
+                           M[2][0] * v.x + M[2][1] * v.y + M[2][2] * v.z);
+}
+
+/**
+ * @brief 계수 하나의 유한성
+ */
+static bool imu_thermal_cal_axis_valid(const ImuThermalAxisCoeffs *c) {
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            if (!isfinite(c->M[i][j])) {
+                return false;
+            }
+        }
+        for (uint8_t k = 0; k < IMU_THERMAL_CAL_TERMS; k++) {
+            if (!isfinite(c->bias[i][k])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 제한한 온도로 오프셋 계산
+ */
+static void imu_thermal_cal_recompute(ImuThermalCal *cal, float temperature) {
+    const ImuThermalCoeffs *c = cal->coeffs;
+    float dt = temperature - c->t_ref;
+    cal->temperature = temperature;
+    cal->gyro_offset = imu_thermal_cal_transform(c->gyro.M, imu_thermal_cal_bias(&c->gyro, dt));
+    cal->accel_offset = imu_thermal_cal_transform(c->accel.M, imu_thermal_cal_bias(&c->accel, dt));
+    cal->recomputes++;
+}
+
+/**
+ * @brief 보정 계수 검사
+ */
+bool imu_thermal_cal_validate(const ImuThermalCoeffs *coeffs) {
+    if (coeffs == NULL || !isfinite(coeffs->t_ref) || !(coeffs->t_min <= coeffs->t_max) ||
+        !(coeffs->t_ref >= coeffs->t_min) || !(coeffs->t_ref <= coeffs->t_max)) {
+        return false;
+    }
+
+    return imu_thermal_cal_axis_valid(&coeffs->gyro) && imu_thermal_cal_axis_valid(&coeffs->accel);
+}
+
+/**
+ * @brief 보정 상태 초기화
+ */
+bool imu_thermal_cal_init(ImuThermalCal *cal, const ImuThermalCoeffs *coeffs) {
+    if (cal == NULL || !imu_thermal_cal_validate(coeffs)) {
+        return false;
+    }
+
+    cal->coeffs = coeffs;
+    cal->has_temperature = false;
+    cal->recomputes = 0;
+    imu_thermal_cal_recompute(cal, coeffs->t_ref);
+
+    return true;
+}
+
+/**
+ * @brief 센서 온도 반영
+ */
+bool imu_thermal_cal_set_temperature(ImuThermalCal *cal, float temperature_c) {
+    if (cal == NULL || cal->coeffs == NULL || !isfinite(temperature_c)) {
+        return false;
+    }
+
+    float t = fminf(fmaxf(temperature_c, cal->coeffs->t_min), cal->coeffs->t_max);
+    if (cal->has_temperature && fabsf(t - cal->temperature) < IMU_THERMAL_CAL_UPDATE_STEP) {
+        return false;
+    }
+
+    cal->has_temperature = true;
+    imu_thermal_cal_recompute(cal, t);
+
+    return true;
+}
+
+/**
+ * @brief 샘플 하나 보정
+ */
+void imu_thermal_cal_apply(const ImuThermalCal *cal, Vector3f *gyro, Vector3f *accel) {
+    if (cal == NULL || cal->coeffs == NULL) {
+        return;
+    }
+
+    if (gyro != NULL) {
+        *gyro = vector3f_subtract(imu_thermal_cal_transform(cal->coeffs->gyro.M, *gyro), cal->gyro_offset);
+    }
+    if (accel != NULL) {
+        *accel = vector3f_subtract(imu_thermal_cal_transform(cal->coeffs->accel.M, *accel), cal->accel_offset);
+    }
+}
+
+/**
+ * @brief 현재 온도의 보정 전 바이어스
+ */
+bool imu_thermal_cal_get_bias(const ImuThermalCal *cal, Vector3f *gyro_bias, Vector3f *accel_bias) {
+    if (cal == NULL || cal->coeffs == NULL) {
+        return false;
+    }
+
+    float dt = cal->temperature - cal->coeffs->t_ref;
+    if (gyro_bias != NULL) {
+        *gyro_bias = imu_thermal_cal_bias(&cal->coeffs->gyro, dt);
+    }
+    if (accel_bias != NULL) {
+        *accel_bias = imu_thermal_cal_bias(&cal->coeffs->accel, dt);
+    }
+
+    return true;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file imu_vibration.c
+ * @brief 입력 단계 IMU 진동/포화 통계 구현
+ */
+
+#include "sensors/imu_vibration.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool imu_vibration_default_config(ImuVibrationConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->window_us = IMU_VIBRATION_DEFAULT_WINDOW_US;
+    config->mean_alpha = IMU_VIBRATION_DEFAULT_MEAN_ALPHA;
+    config->clip_fraction = IMU_VIBRATION_DEFAULT_CLIP_FRACTION;
+    config->accel_floor_std = IMU_VIBRATION_DEFAULT_ACCEL_FLOOR_STD;
+    config->q_gain = IMU_VIBRATION_DEFAULT_Q_GAIN;
+    config->clip_noise_std = IMU_VIBRATION_DEFAULT_CLIP_NOISE_STD;
+
+    return true;
+}
+
+/**
+ * @brief 초기화
+ */
+bool imu_vibration_init(ImuVibration *vib, const ImuVibrationConfig *config) {
+    if (vib == NULL) {
+        return false;
+    }
+
+    ImuVibrationConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        imu_vibration_default_config(&cfg);
+    }
+    if (cfg.window_us == 0 || !(cfg.mean_alpha > 0.0f && cfg.mean_alpha <= 1.0f) ||
+        !(cfg.clip_fraction > 0.0f && cfg.clip_fraction <= 1.0f) || !(cfg.accel_floor_std >= 0.0f) ||
+        !(cfg.q_gain >= 0.0f) || !(cfg.clip_noise_std >= 0.0f)) {
+        return false;
+    }
+
+    memset(vib, 0, sizeof(*vib));
+    vib->config = cfg;
+    vib->clip_lsb = (int16_t)(cfg.clip_fraction * 32767.0f);
+    atomic_init(&vib->active, 0);
+    vib->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 버스트 끝 처리, 창이 끝났으면 통계 게시
+ */
+void imu_vibration_end_burst(ImuVibration *vib, uint32_t timestamp_us) {
+    if (vib == NULL || !vib->initialized) {
+        return;
+    }
+
+    if (!vib->window_open) {
+        vib->window_start_us = timestamp_us;
+        vib->window_open = true;
+        return;
+    }
+    if (timestamp_us - vib->window_start_us < vib->config.window_us || vib->samples == 0) {
+        return;
+    }
+
+    // 태스크가 읽지 않는 쪽에 기록한 뒤 번호 교체 (기록이 먼저 보이도록 release)
+    unsigned int next = atomic_load_explicit(&vib->active, memory_order_relaxed) ^ 1u;
+    ImuVibrationMetrics *m = &vib->metrics[next];
+    float inv = 1.0f / (float)vib->samples;
+    float rms[IMU_VIBRATION_CHANNELS];
+    for (uint8_t c = 0; c < IMU_VIBRATION_CHANNELS; c++) {
+        rms[c] = sqrtf(vib->sumsq[c] * inv);
+        vib->clip_total += vib->clips[c];
+    }
+
+    m->window_end_us = timestamp_us;
+    m->samples = vib->samples;
+    m->gyro_rms = vector3f_create(rms[0], rms[1], rms[2]);
+    m->accel_rms = vector3f_create(rms[3], rms[4], rms[5]);
+    m->gyro_peak = vector3f_create(vib->peak[0], vib->peak[1], vib->peak[2]);
+    m->accel_peak = vector3f_create(vib->peak[3], vib->peak[4], vib->peak[5]);
+    for (uint8_t k = 0; k < 3; k++) {
+        m->gyro_clips[k] = vib->clips[k];
+        m->accel_clips[k] = vib->clips[3 + k];
+    }
+    m->clip_total = vib->clip_total;
+    atomic_store_explicit(&vib->active, next, memory_order_release);
+    vib->windows++;
+
+    // 평균은 창을 넘어 이어 감
+    memset(vib->sumsq, 0, sizeof(vib->sumsq));
+    memset(vib->peak, 0, sizeof(vib->peak));
+    memset(vib->clips, 0, sizeof(vib->clips));
+    vib->samples = 0;
+    vib->window_start_us = timestamp_us;
+}
+
+/**
+ * @brief 마지막 창 통계
+ */
+bool imu_vibration_get_metrics(const ImuVibration *vib, ImuVibrationMetrics *out) {
+    if (vib == NULL || out == NULL || !vib->initialized) {
+        return false;
+    }
+
+    *out = vib->metrics[atomic_load_explicit(&vib->active, memory_order_acquire)];
+
+    return out->samples > 0;
+}
+
+/**
+ * @brief 속도 프로세스 노이즈에 더할 가속도 분산
+ */
+float imu_vibration_accel_var(const ImuVibration *vib) {
+    ImuVibrationMetrics m;
+    if (!imu_vibration_get_metrics(vib, &m)) {
+        return 0.0f;
+    }
+
+    const ImuVibrationConfig *cfg = &vib->config;
+    float var = (m.accel_rms.x * m.accel_rms.x + m.accel_rms.y * m.accel_rms.y +
+                 m.accel_rms.z * m.accel_rms.z) * (1.0f / 3.0f);
+    float excess = var - cfg->accel_floor_std * cfg->accel_floor_std;
+    float q = (excess > 0.0f) ? cfg->q_gain * excess : 0.0f;
+
+    if (m.accel_clips[0] + m.accel_clips[1] + m.accel_clips[2] > 0) {
+        q += cfg->clip_noise_std * cfg->clip_noise_std;
+    }
+
+    return q;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file mag_average.c
+ * @brief 자력계 샘플 사전 평균 구현
+ */
+
+#include "sensors/mag_average.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 기본 설정
+ */
+bool mag_average_default_config(MagAverageConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->count = MAG_AVERAGE_DEFAULT_COUNT;
+    config->rotate = true;
+    config->max_span_us = MAG_AVERAGE_DEFAULT_MAX_SPAN_US;
+    config->r_scale_min = MAG_AVERAGE_DEFAULT_R_SCALE_MIN;
+
+    return true;
+}
+
+/**
+ * @brief 초기화
+ */
+bool mag_average_init(MagAverage *ma, const MagAverageConfig *config) {
+    if (ma == NULL) {
+        return false;
+    }
+
+    MagAverageConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        mag_average_default_config(&cfg);
+    }
+    if (cfg.count < 1 || cfg.count > MAG_AVERAGE_MAX_COUNT || cfg.max_span_us == 0 ||
+        !(cfg.r_scale_min >= 0.0f) || cfg.r_scale_min > 1.0f) {
+        return false;
+    }
+
+    memset(ma, 0, sizeof(*ma));
+    ma->config = cfg;
+    ma->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 모은 샘플 버림
+ */
+void mag_average_reset(MagAverage *ma) {
+    if (ma == NULL) {
+        return;
+    }
+
+    ma->sum = vector3f_zero();
+    ma->n = 0;
+}
+
+/**
+ * @brief 샘플 하나 추가
+ */
+bool mag_average_push(MagAverage *ma, uint32_t timestamp_us, Vector3f mag, const Quaternion *q_nb,
+                      MagAverageOutput *out) {
+    if (ma == NULL || !ma->initialized || out == NULL) {
+        return false;
+    }
+
+    const MagAverageConfig *cfg = &ma->config;
+    ma->stats.inputs++;
+    if (!isfinite(mag.x) || !isfinite(mag.y) || !isfinite(mag.z) || (cfg->rotate && q_nb == NULL)) {
+        ma->stats.rejected++;
+        return false;
+    }
+
+    // 끊긴 뒤의 샘플과 섞지 않음 (역행 시각 포함)
+    if (ma->n > 0 && (uint32_t)(timestamp_us - ma->first_us) > cfg->max_span_us) {
+        mag_average_reset(ma);
+        ma->stats.restarts++;
+    }
+    if (ma->n == 0) {
+        ma->first_us = timestamp_us;
+    }
+
+    if (cfg->rotate) {
+        ma->sum = vector3f_add(ma->sum, quaternion_rotate_vector(*q_nb, mag));
+        ma->last_q = *q_nb;
+    } else {
+        ma->sum = vector3f_add(ma->sum, mag);
+    }
+    ma->last_us = timestamp_us;
+    ma->n++;
+    if (ma->n < cfg->count) {
+        return false;
+    }
+
+    // 평균과 R 배율 (독립 잡음이면 분산 1 / n)
+    float inv = 1.0f / (float)ma->n;
+    Vector3f avg = vector3f_scale(ma->sum, inv);
+    if (cfg->rotate) {
+        out->mag = quaternion_rotate_vector_inverse(ma->last_q, avg);
+        out->timestamp_us = ma->last_us;
+    } else {
+        out->mag = avg;
+        out->timestamp_us = ma->first_us + (ma->last_us - ma->first_us) / 2u;
+    }
+    out->noise_scale = (inv > cfg->r_scale_min) ? inv : cfg->r_scale_min;
+    out->count = ma->n;
+
+    mag_average_reset(ma);
+    ma->stats.outputs++;
+
+    return true;
+}
+
+/**
+ * @brief 통계
+ */
+const MagAverageStats *mag_average_get_stats(const MagAverage *ma) {
+    if (ma == NULL) {
+        return NULL;
+    }
+
+    return &ma->stats;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file mag_iron_cal.c
+ * @brief 비행 중 자력계 경철/연철 온라인 보정 구현
+ */
+
+#include "sensors/mag_iron_cal.h"
+#include "math/fast_math.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 잔차 지수 이동 평균 계수
+ */
+#define MAG_IRON_CAL_RESIDUAL_ALPHA 0.01f
+
+/**
+ * @brief 특이 행렬 판정 임계값
+ */
+#define MAG_IRON_CAL_EPSILON 1e-9f
+
+/**
+ * @brief 3x3 단위 행렬 설정
+ */
+static void mag_iron_cal_identity3(float m[3][3]) {
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            m[i][j] = (i == j) ? 1.0f : 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief RLS 상태를 단위 구 (보정 없음) 가정으로 초기화
+ */
+static void mag_iron_cal_reset_fit(MagIronCal *cal) {
+    memset(cal->theta, 0, sizeof(cal->theta));
+    cal->theta[0] = 1.0f;
+    cal->theta[1] = 1.0f;
+    cal->theta[2] = 1.0f;
+
+    memset(cal->P, 0, sizeof(cal->P));
+    for (int i = 0; i < MAG_IRON_CAL_PARAMS; i++) {
+        cal->P[i][i] = MAG_IRON_CAL_P0;
+    }
+}
+
+/**
+ * @brief 추정기 초기화
+ */
+bool mag_iron_cal_init(MagIronCal *cal, float field_strength) {
+    if (cal == NULL || !(field_strength > 0.0f)) {
+        return false;
+    }
+
+    memset(cal, 0, sizeof(*cal));
+    cal->field_strength = field_strength;
+    mag_iron_cal_reset_fit(cal);
+
+    // 원점에서 최소 거리 이상 떨어진 첫 샘플은 항상 채택되도록 원점으로 둔다
+    cal->last_accepted = vector3f_zero();
+    cal->stage = MAG_IRON_CAL_STAGE_IDLE;
+
+    cal->correction.hard_iron = vector3f_zero();
+    mag_iron_cal_identity3(cal->correction.soft_iron);
+    cal->valid = false;
+
+    return true;
+}
+
+/**
+ * @brief 원시 자력계 샘플 누적
+ */
+bool mag_iron_cal_add_sample(MagIronCal *cal, Vector3f mag) {
+    if (cal == NULL) {
+        return false;
+    }
+
+    float inv_field = 1.0f / cal->field_strength;
+    float x = mag.x * inv_field;
+    float y = mag.y * inv_field;
+    float z = mag.z * inv_field;
+
+    Vector3f m = vector3f_create(x, y, z);
+    Vector3f d = vector3f_subtract(m, cal->last_accepted);
+    if (vector3f_magnitude_squared(d) < MAG_IRON_CAL_MIN_SEPARATION * MAG_IRON_CAL_MIN_SEPARATION) {
+        cal->rejected++;
+        return false;
+    }
+    cal->last_accepted = m;
+
+    const float phi[MAG_IRON_CAL_PARAMS] = {
+        x * x, y * y, z * z,
+        2.0f * y * z, 2.0f * x * z, 2.0f * x * y,
+        2.0f * x, 2.0f * y, 2.0f * z
+    };
+
+    // Pφ (P 대칭), 예측 오차 e = 1 - φ^T θ
+    float Pphi[MAG_IRON_CAL_PARAMS];
+    float denom = MAG_IRON_CAL_FORGETTING;
+    float e = 1.0f;
+    for (int i = 0; i < MAG_IRON_CAL_PARAMS; i++) {
+        float sum = 0.0f;
+        for (int j = 0; j < MAG_IRON_CAL_PARAMS; j++) {
+            sum += cal->P[i][j] * phi[j];
+        }
+        Pphi[i] = sum;
+        denom += phi[i] * sum;
+        e -= phi[i] * cal->theta[i];
+    }
+
+    // θ += k e, P = (P - k (Pφ)^T) / λ, k = Pφ / (λ + φ^T P φ)
+    float inv_denom = 1.0f / denom;
+    float inv_lambda = 1.0f / MAG_IRON_CAL_FORGETTING;
+    float trace = 0.0f;
+    for (int i = 0; i < MAG_IRON_CAL_PARAMS; i++) {
+        float k = Pphi[i] * inv_denom;
+        cal->theta[i] += k * e;
+
+        // 상삼각만 계산 후 대칭 복사 (수치 대칭 유지)
+        for (int j = i; j < MAG_IRON_CAL_PARAMS; j++) {
+            float p = (cal->P[i][j] - k * Pphi[j]) * inv_lambda;
+            cal->P[i][j] = p;
+            cal->P[j][i] = p;
+        }
+        trace += cal->P[i][i];
+    }
+
+    // 공분산 windup 제한
+    if (trace > MAG_IRON_CAL_P_TRACE_MAX) {
+        float scale = MAG_IRON_CAL_P_TRACE_MAX / trace;
+        for (int i = 0; i < MAG_IRON_CAL_PARAMS; i++) {
+            for (int j = 0; j < MAG_IRON_CAL_PARAMS; j++) {
+                cal->P[i][j] *= scale;
+            }
+        }
+    }
+
+    cal->residual += MAG_IRON_CAL_RESIDUAL_ALPHA * (fabsf(e) - cal->residual);
+    cal->accepted++;
+
+    return true;
+}
+
+/**
+ * @brief 계수에서 중심과 정규화 타원체 행렬 계산
+ *
+ * 곡면 m^T M m + 2 v^T m = 1 의 중심은 c = -M^-1 v 이고,
+ * (m - c)^T M (m - c) = 1 + c^T M c 이므로 A = M / (1 + c^T M c) 이다.
+ *
+ * @return bool 중심 계산 성공 여부 (M 특이 또는 비양정치이면 false)
+ */
+static bool mag_iron_cal_stage_center(MagIronCal *cal) {
+    const float *t = cal->theta;
+    float M[3][3] = {
+        { t[0], t[5], t[4] },
+        { t[5], t[1], t[3] },
+        { t[4], t[3], t[2] }
+    };
+    Vector3f v = vector3f_create(t[6], t[7], t[8]);
+
+    // 여인수 전개로 역행렬 (M 대칭)
+    float c00 = M[1][1] * M[2][2] - M[1][2] * M[2][1];
+    float c01 = M[1][2] * M[2][0] - M[1][0] * M[2][2];
+    float c02 = M[1][0] * M[2][1] - M[1][1] * M[2][0];
+    float det = M[0][0] * c00 + M[0][1] * c01 + M[0][2] * c02;
+    if (!(det > MAG_IRON_CAL_EPSILON)) {
+        return false;
+    }
+
+    float c11 = M[0][0] * M[2][2] - M[0][2] * M[2][0];
+    float c12 = M[0][1] * M[2][0] - M[0][0] * M[2][1];
+    float c22 = M[0][0] * M[1][1] - M[0][1] * M[1][0];
+
+    float inv_det = 1.0f / det;
+    Vector3f center = vector3f_create(-(c00 * v.x + c01 * v.y + c02 * v.z) * inv_det,
+                                      -(c01 * v.x + c11 * v.y + c12 * v.z) * inv_det,
+                                      -(c02 * v.x + c12 * v.y + c22 * v.z) * inv_det);
+
+    // c^T M c = -c^T v
+    float s = 1.0f - vector3f_dot(center, v);
+    if (!(s > MAG_IRON_CAL_EPSILON)) {
+        return false;
+    }
+
+    float inv_s = 1.0f / s;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            cal->A[i][j] = M[i][j] * inv_s;
+        }
+    }
+    mag_iron_cal_identity3(cal->V);
+    cal->center = center;
+
+    return true;
+}
+
+/**
+ * @brief 대칭 3x3 행렬의 (p, q) 비대각 성분을 0으로 만드는 Jacobi 회전
+ */
+static void mag_iron_cal_jacobi_rotate(float A[3][3], float V[3][3], int p, int q) {
+    float apq = A[p][q];
+    if (fabsf(apq) < MAG_IRON_CAL_EPSILON) {
+        return;
+    }
+
+    float theta = (A[q][q] - A[p][p]) / (2.0f * apq);
+    float t = 1.0f / (fabsf(theta) + fast_sqrtf(theta * theta + 1.0f));
+    if (theta < 0.0f) {
+        t = -t;
+    }
+    float c = fast_inv_sqrtf(t * t + 1.0f);
+    float s = t * c;
+
+    // A = J^T A J, V = V J
+    for (int k = 0; k < 3; k++) {
+        float akp = A[k][p];
+        float akq = A[k][q];
+        A[k][p] = c * akp - s * akq;
+        A[k][q] = s * akp + c * akq;
+    }
+    for (int k = 0; k < 3; k++) {
+        float apk = A[p][k];
+        float aqk = A[q][k];
+        A[p][k] = c * apk - s * aqk;
+        A[q][k] = s * apk + c * aqk;
+    }
+    for (int k = 0; k < 3; k++) {
+        float vkp = V[k][p];
+        float vkq = V[k][q];
+        V[k][p] = c * vkp - s * vkq;
+        V[k][q] = s * vkp + c * vkq;
+    }
+}
+
+/**
+ * @brief 고유값 검증 후 W = V sqrt(Λ) V^T 게시
+ *
+ * @return bool 게시 여부
+ */
+static bool mag_iron_cal_stage_publish(MagIronCal *cal) {
+    float root[3];
+    float root_min = INFINITY;
+    float root_max = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        if (!(cal->A[i][i] > MAG_IRON_CAL_EPSILON)) {
+            return false;
+        }
+        root[i] = fast_sqrtf(cal->A[i][i]);
+        root_min = fminf(root_min, root[i]);
+        root_max = fmaxf(root_max, root[i]);
+    }
+
+    if (root_max > MAG_IRON_CAL_MAX_AXIS_RATIO * root_min) {
+        return false;
+    }
+    if (vector3f_magnitude_squared(cal->center) > MAG_IRON_CAL_MAX_OFFSET * MAG_IRON_CAL_MAX_OFFSET) {
+        return false;
+    }
+
+    MagIronCorrection correction;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            correction.soft_iron[i][j] = cal->V[i][0] * root[0] * cal->V[j][0] +
+                                         cal->V[i][1] * root[1] * cal->V[j][1] +
+                                         cal->V[i][2] * root[2] * cal->V[j][2];
+        }
+    }
+    correction.hard_iron = vector3f_scale(cal->center, cal->field_strength);
+
+    cal->correction = correction;
+    cal->valid = true;
+
+    return true;
+}
+
+/**
+ * @brief 해 추출 한 단계 진행
+ */
+bool mag_iron_cal_step(MagIronCal *cal) {
+    if (cal == NULL) {
+        return false;
+    }
+
+    switch (cal->stage) {
+        case MAG_IRON_CAL_STAGE_IDLE:
+            // 충분한 샘플이 있고 마지막 추출 이후 새 샘플이 있을 때만 시작
+            if (cal->accepted >= MAG_IRON_CAL_MIN_SAMPLES && cal->accepted != cal->solved_at) {
+                cal->solved_at = cal->accepted;
+                cal->stage = MAG_IRON_CAL_STAGE_CENTER;
+            }
+            return false;
+
+        case MAG_IRON_CAL_STAGE_CENTER:
+            if (mag_iron_cal_stage_center(cal)) {
+                cal->sweep = 0;
+                cal->stage = MAG_IRON_CAL_STAGE_EIGEN;
+            } else {
+                cal->invalid++;
+                cal->stage = MAG_IRON_CAL_STAGE_IDLE;
+            }
+            return false;
+
+        case MAG_IRON_CAL_STAGE_EIGEN:
+            // 순환 Jacobi 1회 반복 (비대각 3개)
+            mag_iron_cal_jacobi_rotate(cal->A, cal->V, 0, 1);
+            mag_iron_cal_jacobi_rotate(cal->A, cal->V, 0, 2);
+            mag_iron_cal_jacobi_rotate(cal->A, cal->V, 1, 2);
+            if (++cal->sweep >= MAG_IRON_CAL_JACOBI_SWEEPS) {
+                cal->stage = MAG_IRON_CAL_STAGE_PUBLISH;
+            }
+            return false;
+
+        case MAG_IRON_CAL_STAGE_PUBLISH:
+        default:
+            cal->stage = MAG_IRON_CAL_STAGE_IDLE;
+            if (mag_iron_cal_stage_publish(cal)) {
+                cal->solutions++;
+                return true;
+            }
+            cal->invalid++;
+            return false;
+    }
+}
+
+/**
+ * @brief 현재 보정값 적용
+ */
+Vector3f mag_iron_cal_apply(const MagIronCal *cal, Vector3f mag) {
+    if (cal == NULL || !cal->valid) {
+        return mag;
+    }
+
+    const float (*W)[3] = cal->correction.soft_iron;
+    Vector3f d = vector3f_subtract(mag, cal->correction.hard_iron);
+
+    return vector3f_create(W[0][0] * d.x + W[0][1] * d.y + W[0][2] * d.z,
+                           W[1][0] * d.x + W[1][1] * d.y + W[1][2] * d.z,
+                           W[2][0] * d.x + W[2][1] * d.y + W[2][2] * d.z);
+}
+
+/**
+ * @brief 게시된 보정값 조회
+ */
+bool mag_iron_cal_get_correction(const MagIronCal *cal, MagIronCorrection *correction) {
+    if (cal == NULL || correction == NULL || !cal->valid) {
+        return false;
+    }
+
+    *correction = cal->correction;
+
+    return true;
+}
+
+/**
+ * @brief 보정값 직접 설정
+ */
+bool mag_iron_cal_set_correction(MagIronCal *cal, const MagIronCorrection *correction) {
+    if (cal == NULL || correction == NULL) {
+        return false;
+    }
+
+    cal->correction = *correction;
+    cal->valid = true;
+
+    return true;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file meas_queue.c
+ * @brief 무잠금 MPSC 측정 대기열 구현
+ */
+
+#include "sensors/meas_queue.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 대기열 초기화
+ */
+bool meas_queue_init(MeasQueue *queue) {
+    if (queue == NULL) {
+        return false;
+    }
+
+    uint16_t base = 0;
+    for (uint8_t t = 0; t < MEAS_TYPE_COUNT; t++) {
+        MeasQueueRing *r = &queue->ring[t];
+        uint16_t size = (t == MEAS_TYPE_IMU) ? MEAS_QUEUE_SIZE : MEAS_QUEUE_AUX_SIZE;
+        r->base = base;
+        r->mask = (uint16_t)(size - 1u);
+        for (uint32_t i = 0; i < size; i++) {
+            atomic_init(&queue->slot[base + i].seq, i);
+            queue->slot[base + i].ticket = 0;
+            memset(&queue->slot[base + i].msg, 0, sizeof(queue->slot[base + i].msg));
+        }
+        atomic_init(&r->enqueue_pos, 0);
+        atomic_init(&r->dequeue_pos, 0);
+        base = (uint16_t)(base + size);
+
+        queue->policy[t] = MEAS_QUEUE_DROP_OLDEST;
+        atomic_init(&queue->counters[t].pushed, 0);
+        atomic_init(&queue->counters[t].overflow, 0);
+        atomic_init(&queue->counters[t].evicted, 0);
+    }
+    atomic_init(&queue->ticket, 0);
+    atomic_init(&queue->popped, 0);
+    atomic_init(&queue->contended, 0);
+
+    return true;
+}
+
+/**
+ * @brief 종류별 가득 참 정책 설정
+ */
+bool meas_queue_set_policy(MeasQueue *queue, MeasType type, MeasQueuePolicy policy) {
+    if (queue == NULL || (unsigned)type >= MEAS_TYPE_COUNT ||
+        (policy != MEAS_QUEUE_DROP_OLDEST && policy != MEAS_QUEUE_DROP_NEWEST)) {
+        return false;
+    }
+
+    queue->policy[type] = (uint8_t)policy;
+
+    return true;
+}
+
+/**
+ * @brief 링 위치의 슬롯
+ */
+static MeasQueueSlot *meas_queue_slot(MeasQueue *queue, const MeasQueueRing *r, uint_fast32_t pos) {
+    return &queue->slot[r->base + (pos & r->mask)];
+}
+
+/**
+ * @brief 링 맨 앞 슬롯 차지 후 복사 (소비자와 밀어내는 생산자 공용)
+ *
+ * @param queue 대기열
+ * @param r 링
+ * @param msg 꺼낸 메시지 저장 위치
+ * @return bool 성공 여부 (비었거나 맨 앞 슬롯이 아직 채워지지 않았으면 false)
+ */
+static bool meas_queue_take(MeasQueue *queue, MeasQueueRing *r, MeasMessage *msg) {
+    uint_fast32_t pos = atomic_load_explicit(&r->dequeue_pos, memory_order_relaxed);
+
+    for (uint32_t attempt = 0; attempt < MEAS_QUEUE_MAX_RETRIES; attempt++) {
+        MeasQueueSlot *slot = meas_queue_slot(queue, r, pos);
+        uint_fast32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(uint32_t)(seq - (pos + 1));
+
+        if (diff < 0) {
+            // 비어 있거나 생산자가 채우는 중
+            return false;
+        }
+        if (diff > 0) {
+            // 다른 문맥이 먼저 꺼냄
+            pos = atomic_load_explicit(&r->dequeue_pos, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&r->dequeue_pos, &pos, pos + 1,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            *msg = slot->msg;
+
+            // 복사가 끝난 뒤 슬롯을 한 바퀴 뒤의 생산자에게 반환
+            atomic_store_explicit(&slot->seq, pos + (uint_fast32_t)r->mask + 1u, memory_order_release);
+            return true;
+        }
+        // 실패 시 pos는 현재 값으로 갱신됨
+        atomic_fetch_add_explicit(&queue->contended, 1, memory_order_relaxed);
+    }
+
+    return false;
+}
+
+/**
+ * @brief 링 빈 슬롯 차지 후 기록
+ *
+ * @param queue 대기열
+ * @param r 링
+ * @param msg 메시지
+ * @return bool 성공 여부 (가득 찼으면 false)
+ */
+static bool meas_queue_put(MeasQueue *queue, MeasQueueRing *r, const MeasMessage *msg) {
+    uint_fast32_t pos = atomic_load_explicit(&r->enqueue_pos, memory_order_relaxed);
+
+    for (uint32_t attempt = 0; attempt < MEAS_QUEUE_MAX_RETRIES; attempt++) {
+        MeasQueueSlot *slot = meas_queue_slot(queue, r, pos);
+        uint_fast32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(uint32_t)(seq - pos);
+
+        if (diff < 0) {
+            // 한 바퀴 전 메시지가 아직 남아 있음 (가득 참)
+            return false;
+        }
+        if (diff > 0) {
+            // 다른 생산자가 먼저 차지함
+            pos = atomic_load_explicit(&r->enqueue_pos, memory_order_relaxed);
+            atomic_fetch_add_explicit(&queue->contended, 1, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&r->enqueue_pos, &pos, pos + 1,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            // 자리를 차지한 순서가 아니라 번호를 받은 순서가 도착 순서
+            slot->ticket = (uint32_t)atomic_fetch_add_explicit(&queue->ticket, 1, memory_order_relaxed);
+            slot->msg = *msg;
+
+            // 메시지 기록이 seq 갱신보다 먼저 보이도록 release
+            atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+            return true;
+        }
+        atomic_fetch_add_explicit(&queue->contended, 1, memory_order_relaxed);
+    }
+
+    return false;
+}
+
+/**
+ * @brief 링 맨 앞 메시지의 도착 번호 (꺼내지 않음)
+ *
+ * @param queue 대기열
+ * @param r 링
+ * @param ticket 도착 번호 저장 위치
+ * @return int 1이면 읽을 메시지 있음, 0이면 빔, -1이면 생산자가 채우는 중이거나 경합 한도 초과
+ */
+static int meas_queue_peek(MeasQueue *queue, const MeasQueueRing *r, uint32_t *ticket) {
+    for (uint32_t attempt = 0; attempt < MEAS_QUEUE_MAX_RETRIES; attempt++) {
+        uint_fast32_t pos = atomic_load_explicit(&r->dequeue_pos, memory_order_relaxed);
+        MeasQueueSlot *slot = meas_queue_slot(queue, r, pos);
+        uint_fast32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(uint32_t)(seq - (pos + 1));
+
+        if (diff < 0) {
+            uint_fast32_t head = atomic_load_explicit(&r->enqueue_pos, memory_order_relaxed);
+            return (head == pos) ? 0 : -1;
+        }
+        if (diff == 0) {
+            *ticket = slot->ticket;
+
+            // 밀어내는 생산자가 번호를 읽는 사이 슬롯을 다시 채우지 않았는지 확인
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq) {
+                return 1;
+            }
+        }
+        // 다른 문맥이 먼저 꺼냄
+    }
+
+    return -1;
+}
+
+/**
+ * @brief 메시지 추가
+ */
+bool meas_queue_push(MeasQueue *queue, const MeasMessage *msg) {
+    if (queue == NULL || msg == NULL || msg->type >= MEAS_TYPE_COUNT) {
+        return false;
+    }
+
+    MeasQueueRing *r = &queue->ring[msg->type];
+    MeasQueueCounters *c = &queue->counters[msg->type];
+    if (meas_queue_put(queue, r, msg)) {
+        atomic_fetch_add_explicit(&c->pushed, 1, memory_order_relaxed);
+        return true;
+    }
+
+    if (queue->policy[msg->type] == MEAS_QUEUE_DROP_OLDEST) {
+        // 같은 종류 링의 가장 오래된 메시지를 밀어내고 한 번 더 시도
+        MeasMessage old;
+        if (meas_queue_take(queue, r, &old)) {
+            atomic_fetch_add_explicit(&c->evicted, 1, memory_order_relaxed);
+            if (meas_queue_put(queue, r, msg)) {
+                atomic_fetch_add_explicit(&c->pushed, 1, memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    atomic_fetch_add_explicit(&c->overflow, 1, memory_order_relaxed);
+
+    return false;
+}
+
+/**
+ * @brief IMU 샘플 추가
+ */
+bool meas_queue_push_imu(MeasQueue *queue, uint32_t timestamp_us, Vector3f gyro, Vector3f accel) {
+    MeasMessage msg;
+    msg.timestamp_us = timestamp_us;
+    msg.type = MEAS_TYPE_IMU;
+    msg.data.imu.gyro = gyro;
+    msg.data.imu.accel = accel;
+
+    return meas_queue_push(queue, &msg);
+}
+
+/**
+ * @brief 기압 샘플 추가
+ */
+bool meas_queue_push_baro(MeasQueue *queue, uint32_t timestamp_us, float pressure_pa, float temperature_c) {
+    MeasMessage msg;
+    msg.timestamp_us = timestamp_us;
+    msg.type = MEAS_TYPE_BARO;
+    msg.data.baro.pressure_pa = pressure_pa;
+    msg.data.baro.temperature_c = temperature_c;
+
+    return meas_queue_push(queue, &msg);
+}
+
+/**
+ * @brief 자력계 측정 추가
+ */
+bool meas_queue_push_mag(MeasQueue *queue, uint32_t timestamp_us, Vector3f mag) {
+    MeasMessage msg;
+    msg.timestamp_us = timestamp_us;
+    msg.type = MEAS_TYPE_MAG;
+    msg.data.mag = mag;
+
+    return meas_queue_push(queue, &msg);
+}
+
+/**
+ * @brief GNSS 측정 추가
+ */
+bool meas_queue_push_gnss(MeasQueue *queue, uint32_t timestamp_us, Vector3f pos, Vector3f vel,
+                          uint8_t components) {
+    return meas_queue_push_gnss_accuracy(queue, timestamp_us, pos, vel, components, 0.0f, 0.0f, 0.0f);
+}
+
+/**
+ * @brief 정확도 m -> cm (u16 포화, 음수/NaN은 보고 없음)
+ */
+static uint16_t meas_queue_acc_cm(float acc) {
+    if (!(acc > 0.0f)) {
+        return 0;
+    }
+    float cm = acc * 100.0f + 0.5f;
+    if (cm >= (float)UINT16_MAX) {
+        return UINT16_MAX;
+    }
+    // 0.005 m 미만도 보고는 있었으므로 1 cm로
+    return (cm < 1.0f) ? 1u : (uint16_t)cm;
+}
+
+/**
+ * @brief 수신기 보고 정확도가 붙은 GNSS 측정 추가
+ */
+bool meas_queue_push_gnss_accuracy(MeasQueue *queue, uint32_t timestamp_us, Vector3f pos, Vector3f vel,
+                                   uint8_t components, float h_acc, float v_acc, float s_acc) {
+    MeasMessage msg;
+    msg.timestamp_us = timestamp_us;
+    msg.type = MEAS_TYPE_GNSS;
+    msg.data.gnss.pos = pos;
+    msg.data.gnss.vel = vel;
+    msg.data.gnss.h_acc_cm = meas_queue_acc_cm(h_acc);
+    msg.data.gnss.v_acc_cm = meas_queue_acc_cm(v_acc);
+    msg.data.gnss.s_acc_cms = meas_queue_acc_cm(s_acc);
+    msg.data.gnss.components = components;
+
+    return meas_queue_push(queue, &msg);
+}
+
+/**
+ * @brief 가장 먼저 도착한 메시지 꺼내기 (소비자 전용)
+ */
+bool meas_queue_pop(MeasQueue *queue, MeasMessage *msg) {
+    if (queue == NULL || msg == NULL) {
+        return false;
+    }
+
+    // 링 머리 중 도착 번호가 가장 작은 것 (채우는 중인 머리가 있으면 순서를 지키려 기다림)
+    MeasQueueRing *best = NULL;
+    uint32_t best_ticket = 0;
+    for (uint8_t t = 0; t < MEAS_TYPE_COUNT; t++) {
+        uint32_t ticket;
+        int ready = meas_queue_peek(queue, &queue->ring[t], &ticket);
+        if (ready < 0) {
+            return false;
+        }
+        if (ready > 0 && (best == NULL || (int32_t)(ticket - best_ticket) < 0)) {
+            best = &queue->ring[t];
+            best_ticket = ticket;
+        }
+    }
+
+    // 그 사이 같은 종류 생산자가 머리를 밀어냈으면 같은 링의 다음 메시지를 꺼냄
+    if (best == NULL || !meas_queue_take(queue, best, msg)) {
+        return false;
+    }
+    atomic_fetch_add_explicit(&queue->popped, 1, memory_order_relaxed);
+
+    return true;
+}
+
+/**
+ * @brief 저장된 메시지 수
+ */
+uint32_t meas_queue_count(const MeasQueue *queue) {
+    if (queue == NULL) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t t = 0; t < MEAS_TYPE_COUNT; t++) {
+        const MeasQueueRing *r = &queue->ring[t];
+        uint_fast32_t tail = atomic_load_explicit(&r->dequeue_pos, memory_order_acquire);
+        uint_fast32_t head = atomic_load_explicit(&r->enqueue_pos, memory_order_acquire);
+        uint32_t count = (uint32_t)(head - tail);
+        uint32_t size = (uint32_t)r->mask + 1u;
+
+        total += (count > size) ? size : count;
+    }
+
+    return total;
+}
+
+/**
+ * @brief 통계 스냅숏
+ */
+bool meas_queue_get_stats(const MeasQueue *queue, MeasQueueStats *stats) {
+    if (queue == NULL || stats == NULL) {
+        return false;
+    }
+
+    for (uint8_t t = 0; t < MEAS_TYPE_COUNT; t++) {
+        const MeasQueueCounters *c = &queue->counters[t];
+        stats->type[t].pushed = (uint32_t)atomic_load_explicit(&c->pushed, memory_order_relaxed);
+        stats->type[t].overflow = (uint32_t)atomic_load_explicit(&c->overflow, memory_order_relaxed);
+        stats->type[t].evicted = (uint32_t)atomic_load_explicit(&c->evicted, memory_order_relaxed);
+    }
+    stats->popped = (uint32_t)atomic_load_explicit(&queue->popped, memory_order_relaxed);
+    stats->contended = (uint32_t)atomic_load_explicit(&queue->contended, memory_order_relaxed);
+
+    return true;
+}
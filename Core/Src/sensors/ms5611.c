@@ -0,0 +1,483 @@
+/**
+ * @file ms5611.c
+ * @brief MS5611 기압계 비차단 변환 드라이버 구현 (SPI + DMA, 단발 타이머)
+ */
+
+#include "sensors/ms5611.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 명령
+ */
+#define MS5611_CMD_RESET     0x1E
+#define MS5611_CMD_CONVERT_D1 0x40
+#define MS5611_CMD_CONVERT_D2 0x50
+#define MS5611_CMD_ADC_READ  0x00
+#define MS5611_CMD_PROM_READ 0xA0
+
+/**
+ * @brief 리셋 후 PROM 재적재 시간 (ms)
+ */
+#define MS5611_RESET_DELAY_MS 3
+
+/**
+ * @brief 차단형 SPI 제한 시간 (ms)
+ */
+#define MS5611_BUS_TIMEOUT_MS 10
+
+/**
+ * @brief 타이머 분해능 (Hz)과 최대 대기 (us, 16비트 자동 재적재)
+ */
+#define MS5611_TIMER_TICK_HZ 1000000u
+#define MS5611_TIMER_MAX_US  0x10000u
+
+/**
+ * @brief OSR별 최대 변환 시간 (us, 데이터시트)
+ */
+static const uint16_t ms5611_conversion_us[] = { 600, 1170, 2280, 4540, 9040 };
+
+static void ms5611_select(const Ms5611Bus *bus) {
+    HAL_GPIO_WritePin(bus->cs_port, bus->cs_pin, GPIO_PIN_RESET);
+}
+
+static void ms5611_deselect(const Ms5611Bus *bus) {
+    HAL_GPIO_WritePin(bus->cs_port, bus->cs_pin, GPIO_PIN_SET);
+}
+
+/**
+ * @brief OSR별 변환 대기 시간 (최대 변환 시간 + 여유)
+ */
+static uint32_t ms5611_conversion_delay_us(Ms5611Osr osr) {
+    return ms5611_conversion_us[osr] + MS5611_CONVERSION_MARGIN_US;
+}
+
+/**
+ * @brief PROM CRC4 (AN520, 마지막 워드의 하위 4비트가 CRC)
+ */
+static uint8_t ms5611_crc4(const uint16_t prom[8]) {
+    uint16_t rem = 0;
+
+    for (uint8_t cnt = 0; cnt < 16; cnt++) {
+        // CRC 계산에서는 CRC 자리(마지막 워드 하위 바이트)를 0으로 본다
+        uint16_t word = (cnt >> 1) == 7 ? (uint16_t)(prom[7] & 0xFF00u) : prom[cnt >> 1];
+        rem ^= (cnt & 1) ? (uint16_t)(word & 0xFFu) : (uint16_t)(word >> 8);
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            rem = (rem & 0x8000u) ? (uint16_t)((rem << 1) ^ 0x3000u) : (uint16_t)(rem << 1);
+        }
+    }
+
+    return (uint8_t)((rem >> 12) & 0x0F);
+}
+
+/**
+ * @brief 리셋과 PROM 읽기 (차단형)
+ */
+static bool ms5611_read_prom(const Ms5611Bus *bus, uint16_t prom[8]) {
+    uint8_t cmd = MS5611_CMD_RESET;
+    ms5611_select(bus);
+    HAL_StatusTypeDef status = HAL_SPI_Transmit(bus->hspi, &cmd, 1, MS5611_BUS_TIMEOUT_MS);
+    HAL_Delay(MS5611_RESET_DELAY_MS);
+    ms5611_deselect(bus);
+    if (status != HAL_OK) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 8; i++) {
+        uint8_t tx[3] = { (uint8_t)(MS5611_CMD_PROM_READ + 2u * i), 0, 0 };
+        uint8_t rx[3] = { 0 };
+        ms5611_select(bus);
+        status = HAL_SPI_TransmitReceive(bus->hspi, tx, rx, 3, MS5611_BUS_TIMEOUT_MS);
+        ms5611_deselect(bus);
+        if (status != HAL_OK) {
+            return false;
+        }
+        prom[i] = (uint16_t)(((uint16_t)rx[1] << 8) | rx[2]);
+    }
+
+    // 버스가 끊기면 모두 0 또는 0xFFFF로 읽히며, 모두 0이면 CRC도 맞으므로 따로 거른다
+    for (uint8_t i = 1; i <= 6; i++) {
+        if (prom[i] == 0 || prom[i] == 0xFFFFu) {
+            return false;
+        }
+    }
+
+    return ms5611_crc4(prom) == (prom[7] & 0x0F);
+}
+
+/**
+ * @brief APB1 타이머 클럭 기준 1 MHz 분주비
+ */
+static bool ms5611_timer_prescaler(uint32_t *psc) {
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    uint32_t clk = ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) ? pclk1 : 2u * pclk1;
+    if (clk < MS5611_TIMER_TICK_HZ || clk % MS5611_TIMER_TICK_HZ != 0) {
+        return false;
+    }
+
+    uint32_t div = clk / MS5611_TIMER_TICK_HZ;
+    if (div > 0x10000u) {
+        return false;
+    }
+    *psc = div - 1u;
+
+    return true;
+}
+
+/**
+ * @brief 단발 타이머 시작 (delay_us 뒤 갱신 인터럽트 한 번)
+ */
+static void ms5611_timer_start(const Ms5611 *baro, uint32_t delay_us) {
+    TIM_TypeDef *tim = baro->htim->Instance;
+
+    if (delay_us < 1u) {
+        delay_us = 1u;
+    } else if (delay_us > MS5611_TIMER_MAX_US) {
+        delay_us = MS5611_TIMER_MAX_US;
+    }
+
+    tim->ARR = delay_us - 1u;
+    tim->CNT = 0;
+    tim->SR = ~(uint32_t)TIM_SR_UIF;
+    tim->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief DMA 전송 시작 (칩 선택은 완료 처리에서 해제)
+ */
+static bool ms5611_transfer(Ms5611 *baro, uint16_t len, Ms5611State next) {
+    baro->state = next;
+    ms5611_select(&baro->bus);
+
+    if (HAL_SPI_TransmitReceive_DMA(baro->bus.hspi, baro->tx_buffer, baro->rx_buffer, len) != HAL_OK) {
+        ms5611_deselect(&baro->bus);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 현재 주기를 버리고 한 주기 뒤 온도부터 다시 시작
+ */
+static void ms5611_abort_cycle(Ms5611 *baro) {
+    baro->has_temperature = false;
+
+    if (!baro->running) {
+        baro->state = MS5611_STATE_IDLE;
+        return;
+    }
+
+    baro->state = MS5611_STATE_WAIT;
+    ms5611_timer_start(baro, baro->config.period_us != 0 ? baro->config.period_us
+                                                          : ms5611_conversion_delay_us(baro->config.pressure_osr));
+}
+
+/**
+ * @brief 주기 시작 (필요하면 온도 변환부터)
+ */
+static void ms5611_begin_cycle(Ms5611 *baro) {
+    baro->cycle_start_us = baro->clock();
+
+    bool temperature = !baro->has_temperature ||
+                       baro->cycles_since_temperature >= baro->config.temperature_interval;
+    baro->tx_buffer[0] = temperature
+        ? (uint8_t)(MS5611_CMD_CONVERT_D2 + 2u * (uint8_t)baro->config.temperature_osr)
+        : (uint8_t)(MS5611_CMD_CONVERT_D1 + 2u * (uint8_t)baro->config.pressure_osr);
+
+    if (!ms5611_transfer(baro, 1, temperature ? MS5611_STATE_CMD_D2 : MS5611_STATE_CMD_D1)) {
+        baro->stats.dma_errors++;
+        ms5611_abort_cycle(baro);
+    }
+}
+
+/**
+ * @brief 주기 종료 (다음 주기까지 대기 또는 바로 시작)
+ */
+static void ms5611_end_cycle(Ms5611 *baro) {
+    if (!baro->running) {
+        baro->state = MS5611_STATE_IDLE;
+        return;
+    }
+
+    uint32_t elapsed = baro->clock() - baro->cycle_start_us;
+    if (baro->config.period_us > elapsed) {
+        baro->state = MS5611_STATE_WAIT;
+        ms5611_timer_start(baro, baro->config.period_us - elapsed);
+        return;
+    }
+
+    if (baro->config.period_us != 0) {
+        baro->stats.overruns++;
+    }
+    ms5611_begin_cycle(baro);
+}
+
+/**
+ * @brief 설정 검사
+ */
+static bool ms5611_config_valid(const Ms5611Config *config) {
+    return (uint32_t)config->pressure_osr <= (uint32_t)MS5611_OSR_4096 &&
+           (uint32_t)config->temperature_osr <= (uint32_t)MS5611_OSR_4096 &&
+           config->temperature_interval >= 1 && config->period_us <= MS5611_TIMER_MAX_US;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool ms5611_default_config(Ms5611Config *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->pressure_osr = MS5611_DEFAULT_PRESSURE_OSR;
+    config->temperature_osr = MS5611_DEFAULT_TEMPERATURE_OSR;
+    config->temperature_interval = MS5611_DEFAULT_TEMPERATURE_INTERVAL;
+    config->period_us = MS5611_DEFAULT_PERIOD_US;
+
+    return true;
+}
+
+/**
+ * @brief 센서 리셋, PROM 읽기와 CRC 확인, 타이머 설정
+ */
+bool ms5611_init(Ms5611 *baro, const Ms5611Bus *bus, TIM_HandleTypeDef *htim, BaroRing *ring,
+                 Ms5611ClockFn clock, const Ms5611Config *config) {
+    if (baro == NULL || bus == NULL || bus->hspi == NULL || bus->cs_port == NULL || htim == NULL ||
+        ring == NULL || clock == NULL) {
+        return false;
+    }
+    if (htim->Instance != TIM6 && htim->Instance != TIM7) {
+        return false;
+    }
+
+    Ms5611Config cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        ms5611_default_config(&cfg);
+    }
+    if (!ms5611_config_valid(&cfg)) {
+        return false;
+    }
+
+    uint32_t psc;
+    if (!ms5611_timer_prescaler(&psc)) {
+        return false;
+    }
+
+    memset(baro, 0, sizeof(*baro));
+    baro->bus = *bus;
+    baro->htim = htim;
+    baro->ring = ring;
+    baro->clock = clock;
+    baro->config = cfg;
+    baro->state = MS5611_STATE_IDLE;
+
+    ms5611_deselect(&baro->bus);
+    if (!ms5611_read_prom(&baro->bus, baro->prom)) {
+        return false;
+    }
+
+    // 단발 모드, 분주비 적재 (UG로 인터럽트가 나지 않도록 URS)
+    TIM_TypeDef *tim = htim->Instance;
+    tim->CR1 = TIM_CR1_OPM | TIM_CR1_URS;
+    tim->PSC = psc;
+    tim->ARR = 0xFFFFu;
+    tim->EGR = TIM_EGR_UG;
+    tim->SR = ~(uint32_t)TIM_SR_UIF;
+    tim->DIER |= TIM_DIER_UIE;
+    htim->Init.Prescaler = psc;
+
+    baro->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 연속 변환 시작
+ */
+bool ms5611_start(Ms5611 *baro) {
+    if (baro == NULL || !baro->initialized || baro->state != MS5611_STATE_IDLE) {
+        return false;
+    }
+
+    baro->running = true;
+    baro->has_temperature = false;
+    ms5611_begin_cycle(baro);
+
+    return true;
+}
+
+/**
+ * @brief 연속 변환 정지 요청
+ */
+void ms5611_stop(Ms5611 *baro) {
+    if (baro == NULL) {
+        return;
+    }
+
+    baro->running = false;
+}
+
+/**
+ * @brief 타이머 만료 처리
+ */
+void ms5611_handle_timer(Ms5611 *baro, TIM_HandleTypeDef *htim) {
+    if (baro == NULL || !baro->initialized || htim != baro->htim) {
+        return;
+    }
+
+    switch (baro->state) {
+    case MS5611_STATE_CONV_D2:
+    case MS5611_STATE_CONV_D1:
+        memset(baro->tx_buffer, MS5611_CMD_ADC_READ, sizeof(baro->tx_buffer));
+        if (!ms5611_transfer(baro, 4, baro->state == MS5611_STATE_CONV_D2 ? MS5611_STATE_READ_D2
+                                                                          : MS5611_STATE_READ_D1)) {
+            baro->stats.dma_errors++;
+            ms5611_abort_cycle(baro);
+        }
+        break;
+
+    case MS5611_STATE_WAIT:
+        if (baro->running) {
+            ms5611_begin_cycle(baro);
+        } else {
+            baro->state = MS5611_STATE_IDLE;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief SPI DMA 완료 처리
+ */
+void ms5611_handle_dma_complete(Ms5611 *baro, SPI_HandleTypeDef *hspi) {
+    if (baro == NULL || !baro->initialized || hspi != baro->bus.hspi) {
+        return;
+    }
+
+    ms5611_deselect(&baro->bus);
+    uint32_t raw = ((uint32_t)baro->rx_buffer[1] << 16) | ((uint32_t)baro->rx_buffer[2] << 8) | baro->rx_buffer[3];
+
+    switch (baro->state) {
+    case MS5611_STATE_CMD_D2:
+        baro->state = MS5611_STATE_CONV_D2;
+        ms5611_timer_start(baro, ms5611_conversion_delay_us(baro->config.temperature_osr));
+        break;
+
+    case MS5611_STATE_CMD_D1:
+        baro->d1_start_us = baro->clock();
+        baro->state = MS5611_STATE_CONV_D1;
+        ms5611_timer_start(baro, ms5611_conversion_delay_us(baro->config.pressure_osr));
+        break;
+
+    case MS5611_STATE_READ_D2:
+        if (raw == 0) {
+            baro->stats.invalid_reads++;
+            ms5611_abort_cycle(baro);
+            break;
+        }
+        baro->d2 = raw;
+        baro->has_temperature = true;
+        baro->cycles_since_temperature = 0;
+        baro->stats.temperature_updates++;
+
+        baro->tx_buffer[0] = (uint8_t)(MS5611_CMD_CONVERT_D1 + 2u * (uint8_t)baro->config.pressure_osr);
+        if (!ms5611_transfer(baro, 1, MS5611_STATE_CMD_D1)) {
+            baro->stats.dma_errors++;
+            ms5611_abort_cycle(baro);
+        }
+        break;
+
+    case MS5611_STATE_READ_D1: {
+        if (raw == 0) {
+            baro->stats.invalid_reads++;
+            ms5611_abort_cycle(baro);
+            break;
+        }
+
+        BaroSample sample;
+        sample.timestamp_us = baro->d1_start_us + ms5611_conversion_us[baro->config.pressure_osr] / 2u;
+        if (ms5611_compensate(baro->prom, raw, baro->d2, &sample.pressure_pa, &sample.temperature_c) &&
+            baro_ring_push(baro->ring, &sample)) {
+            baro->stats.samples++;
+        }
+        if (baro->cycles_since_temperature < UINT16_MAX) {
+            baro->cycles_since_temperature++;
+        }
+
+        ms5611_end_cycle(baro);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief SPI DMA 오류 처리
+ */
+void ms5611_handle_dma_error(Ms5611 *baro, SPI_HandleTypeDef *hspi) {
+    if (baro == NULL || !baro->initialized || hspi != baro->bus.hspi) {
+        return;
+    }
+
+    ms5611_deselect(&baro->bus);
+    baro->stats.dma_errors++;
+    ms5611_abort_cycle(baro);
+}
+
+/**
+ * @brief 원시값 보상 (데이터시트 1차 + 2차 보상)
+ */
+bool ms5611_compensate(const uint16_t prom[8], uint32_t d1, uint32_t d2, float *pressure_pa, float *temperature_c) {
+    if (prom == NULL || pressure_pa == NULL || temperature_c == NULL || d1 > 0xFFFFFFu || d2 > 0xFFFFFFu) {
+        return false;
+    }
+
+    // 1차 보상 (TEMP는 0.01°C, P는 0.01 mbar = 1 Pa)
+    int64_t dt = (int64_t)d2 - ((int64_t)prom[5] << 8);
+    int64_t temp = 2000 + dt * prom[6] / (INT64_C(1) << 23);
+    int64_t off = ((int64_t)prom[2] << 16) + (int64_t)prom[4] * dt / (INT64_C(1) << 7);
+    int64_t sens = ((int64_t)prom[1] << 15) + (int64_t)prom[3] * dt / (INT64_C(1) << 8);
+
+    // 2차 보상 (20°C 미만, -15°C 미만 추가)
+    if (temp < 2000) {
+        int64_t t2 = dt * dt / (INT64_C(1) << 31);
+        int64_t low = (temp - 2000) * (temp - 2000);
+        int64_t off2 = 5 * low / 2;
+        int64_t sens2 = 5 * low / 4;
+        if (temp < -1500) {
+            int64_t very_low = (temp + 1500) * (temp + 1500);
+            off2 += 7 * very_low;
+            sens2 += 11 * very_low / 2;
+        }
+        temp -= t2;
+        off -= off2;
+        sens -= sens2;
+    }
+
+    int64_t p = ((int64_t)d1 * sens / (INT64_C(1) << 21) - off) / (INT64_C(1) << 15);
+
+    *pressure_pa = (float)p;
+    *temperature_c = (float)temp * 0.01f;
+
+    return true;
+}
+
+/**
+ * @brief 드라이버 통계
+ */
+const Ms5611Stats *ms5611_get_stats(const Ms5611 *baro) {
+    if (baro == NULL) {
+        return NULL;
+    }
+
+    return &baro->stats;
+}
@@ -0,0 +1,475 @@
+/**
+ * @file pil_replay.c
+ * @brief PIL 재생기 구현
+ */
+
+#include "sensors/pil_replay.h"
+#include "sys/timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 재생 시계 출처 (pil_replay_start가 설정)
+ */
+static PilReplay *pil_replay_clock;
+
+/**
+ * @brief 기본 설정
+ */
+bool pil_replay_default_config(PilReplayConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->speed = PIL_REPLAY_DEFAULT_SPEED;
+    config->lead_us = PIL_REPLAY_DEFAULT_LEAD_US;
+    config->late_us = PIL_REPLAY_DEFAULT_LATE_US;
+    config->resync_us = PIL_REPLAY_DEFAULT_RESYNC_US;
+    config->report_us = PIL_REPLAY_DEFAULT_REPORT_US;
+
+    return true;
+}
+
+/**
+ * @brief 재생기 초기화
+ */
+bool pil_replay_init(PilReplay *pil, FlashLog *log, MeasQueue *queue, const FlashLogSession *session,
+                     const PilReplayConfig *config) {
+    if (pil == NULL || log == NULL || queue == NULL || session == NULL) {
+        return false;
+    }
+
+    PilReplayConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        pil_replay_default_config(&cfg);
+    }
+    if (cfg.speed < 1 || cfg.speed > PIL_REPLAY_MAX_SPEED || cfg.resync_us == 0 || cfg.report_us == 0) {
+        return false;
+    }
+    if (session->block_count == 0 || session->first_block > flash_log_block_count(log) ||
+        session->block_count > flash_log_block_count(log) - session->first_block) {
+        return false;
+    }
+
+    memset(pil, 0, sizeof(*pil));
+    pil->log = log;
+    pil->queue = queue;
+    pil->config = cfg;
+    pil->session = session->session;
+    pil->first_block = session->first_block;
+    pil->block_count = session->block_count;
+    atomic_init(&pil->head, 0);
+    atomic_init(&pil->tail, 0);
+    atomic_init(&pil->next_block, 0);
+    atomic_init(&pil->offset_us, 0);
+    atomic_init(&pil->running, false);
+    atomic_init(&pil->finished, false);
+    atomic_init(&pil->fix_seq, 0);
+    pil->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 블록 하나를 버퍼로 (원본 블록은 매핑에서 복사, 압축 모드 블록은 풀어 읽음)
+ */
+static bool pil_replay_load(PilReplay *pil, uint32_t block, uint8_t *data) {
+    const uint8_t *mapped = flash_log_map_block(pil->log, block);
+    FlashLogBlockHeader header;
+
+    if (mapped != NULL) {
+        memcpy(&header, mapped, sizeof(header));
+        if (header.magic == FLASH_LOG_MAGIC) {
+            memcpy(data, mapped, FLASH_LOG_BUFFER_SIZE);
+            return true;
+        }
+    }
+    if (!flash_log_read_block(pil->log, block, data)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    return header.magic == FLASH_LOG_MAGIC;
+}
+
+/**
+ * @brief 빈 블록 버퍼 채우기
+ */
+uint32_t pil_replay_fill(PilReplay *pil) {
+    if (pil == NULL || !pil->initialized) {
+        return 0;
+    }
+
+    uint32_t filled = 0;
+    uint_fast32_t head = atomic_load_explicit(&pil->head, memory_order_relaxed);
+    uint_fast32_t next = atomic_load_explicit(&pil->next_block, memory_order_relaxed);
+
+    while (next < pil->block_count &&
+           head - atomic_load_explicit(&pil->tail, memory_order_acquire) < PIL_REPLAY_BLOCKS) {
+        if (!flash_log_idle(pil->log)) {
+            pil->stats.busy++;
+            break;
+        }
+
+        uint8_t *data = pil->block[head & (PIL_REPLAY_BLOCKS - 1u)];
+        bool ok = pil_replay_load(pil, pil->first_block + (uint32_t)next, data);
+        FlashLogBlockHeader header;
+        memcpy(&header, data, sizeof(header));
+        next++;
+        if (!ok || header.session != pil->session) {
+            pil->stats.bad_blocks++;
+            atomic_store_explicit(&pil->next_block, next, memory_order_release);
+            continue;
+        }
+
+        // 블록 내용이 head보다, head가 next_block보다 먼저 보이도록 release
+        pil->stats.blocks++;
+        filled++;
+        head++;
+        atomic_store_explicit(&pil->head, head, memory_order_release);
+        atomic_store_explicit(&pil->next_block, next, memory_order_release);
+    }
+
+    return filled;
+}
+
+/**
+ * @brief 레코드 종류별 크기 (0이면 재생하지 않는 종류)
+ */
+static uint8_t pil_replay_record_size(uint8_t type) {
+    switch (type) {
+    case FLASH_LOG_REC_IMU:
+        return (uint8_t)sizeof(FlashLogImuRecord);
+    case FLASH_LOG_REC_BARO:
+        return (uint8_t)sizeof(FlashLogBaroRecord);
+    case FLASH_LOG_REC_MAG:
+        return (uint8_t)sizeof(FlashLogMagRecord);
+    case FLASH_LOG_REC_GNSS:
+        return (uint8_t)sizeof(FlashLogGnssRecord);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief 재생 시각 (로컬 시각 x speed + 차이, 모듈로 2^32)
+ */
+static uint32_t pil_replay_virtual(const PilReplay *pil, uint32_t now_us) {
+    return now_us * pil->config.speed + (uint32_t)atomic_load_explicit(&pil->offset_us, memory_order_relaxed);
+}
+
+/**
+ * @brief 다음 재생 레코드를 pending으로 (없으면 false)
+ */
+static bool pil_replay_next(PilReplay *pil, uint32_t now_us) {
+    for (;;) {
+        // next_block을 먼저 읽음 (채우기는 head 다음에 next_block을 씀)
+        bool read_all = atomic_load_explicit(&pil->next_block, memory_order_acquire) >= pil->block_count;
+        uint_fast32_t tail = atomic_load_explicit(&pil->tail, memory_order_relaxed);
+        uint_fast32_t head = atomic_load_explicit(&pil->head, memory_order_acquire);
+        if (tail == head) {
+            if (read_all) {
+                atomic_store_explicit(&pil->finished, true, memory_order_release);
+            } else if (!pil->starved) {
+                pil->stats.underruns++;
+                pil->starved = true;
+            }
+            return false;
+        }
+
+        const uint8_t *data = pil->block[tail & (PIL_REPLAY_BLOCKS - 1u)];
+        uint8_t type;
+        uint8_t len;
+        const uint8_t *payload = flash_log_next_record(data, &pil->offset, &type, &len);
+        if (payload == NULL) {
+            pil->offset = 0;
+            atomic_store_explicit(&pil->tail, tail + 1u, memory_order_release);
+            continue;
+        }
+
+        uint8_t size = pil_replay_record_size(type);
+        if (size == 0 || len != size) {
+            pil->stats.skipped++;
+            continue;
+        }
+
+        // 모든 레코드는 측정 시각(u32)으로 시작
+        uint32_t rec_us;
+        memcpy(&rec_us, payload, sizeof(rec_us));
+        if (type == FLASH_LOG_REC_IMU) {
+            int32_t jump = (int32_t)(rec_us - pil->last_imu_us);
+            if (atomic_load_explicit(&pil->running, memory_order_relaxed) &&
+                (jump > (int32_t)pil->config.resync_us || jump < -(int32_t)pil->config.resync_us)) {
+                atomic_store_explicit(&pil->offset_us, rec_us - now_us * pil->config.speed,
+                                      memory_order_relaxed);
+                pil->stats.resyncs++;
+            }
+            pil->last_imu_us = rec_us;
+        }
+
+        pil->pending = payload;
+        pil->pending_type = type;
+        pil->pending_us = rec_us;
+        pil->starved = false;
+
+        return true;
+    }
+}
+
+/**
+ * @brief 재생 시작
+ */
+bool pil_replay_start(PilReplay *pil, uint32_t now_us) {
+    if (pil == NULL || !pil->initialized || atomic_load_explicit(&pil->running, memory_order_relaxed) ||
+        !pil_replay_next(pil, now_us)) {
+        return false;
+    }
+
+    // 첫 레코드가 now_us + lead_us에 나오도록
+    pil->last_imu_us = pil->pending_us;
+    atomic_store_explicit(&pil->offset_us, pil->pending_us - (now_us + pil->config.lead_us) * pil->config.speed,
+                          memory_order_relaxed);
+    pil->report_last_us = pil_replay_virtual(pil, now_us);
+    pil_replay_clock = pil;
+    atomic_store_explicit(&pil->running, true, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief 재생 시계
+ */
+uint32_t pil_replay_now_us(void) {
+    uint32_t now = timebase_now_us();
+    const PilReplay *pil = pil_replay_clock;
+
+    if (pil == NULL || !atomic_load_explicit(&pil->running, memory_order_acquire)) {
+        return now;
+    }
+
+    return pil_replay_virtual(pil, now);
+}
+
+/**
+ * @brief GNSS 레코드를 해로 게시
+ */
+static void pil_replay_publish_fix(PilReplay *pil, const FlashLogGnssRecord *rec) {
+    uint_fast32_t next = atomic_load_explicit(&pil->fix_seq, memory_order_relaxed) + 1;
+    UbxGnssFix *fix = &pil->fix[next & 1u];
+
+    fix->timestamp_us = rec->timestamp_us;
+    fix->itow_ms = rec->itow_ms;
+    fix->lat_e7 = rec->lat_e7;
+    fix->lon_e7 = rec->lon_e7;
+    fix->height_mm = rec->height_mm;
+    fix->hmsl_mm = rec->hmsl_mm;
+    fix->vel_ned = vector3f_create(rec->vel_ned[0], rec->vel_ned[1], rec->vel_ned[2]);
+    fix->h_acc = rec->h_acc;
+    fix->v_acc = rec->v_acc;
+    fix->s_acc = rec->s_acc;
+    fix->fix_type = rec->fix_type;
+    fix->num_sv = rec->num_sv;
+    fix->fix_ok = (rec->flags & 0x01u) != 0;
+    fix->pulse_locked = (rec->flags & 0x02u) != 0;
+
+    // 해 기록이 시퀀스보다 먼저 보이도록 release
+    atomic_store_explicit(&pil->fix_seq, next, memory_order_release);
+}
+
+/**
+ * @brief pending 레코드 내보내기 (IMU를 내보냈으면 true)
+ */
+static bool pil_replay_release(PilReplay *pil) {
+    const uint8_t *p = pil->pending;
+
+    switch (pil->pending_type) {
+    case FLASH_LOG_REC_IMU: {
+        FlashLogImuRecord r;
+        memcpy(&r, p, sizeof(r));
+        if (!meas_queue_push_imu(pil->queue, r.timestamp_us, vector3f_create(r.gyro[0], r.gyro[1], r.gyro[2]),
+                                 vector3f_create(r.accel[0], r.accel[1], r.accel[2]))) {
+            pil->stats.queue_drops++;
+            return false;
+        }
+        pil->stats.released[MEAS_TYPE_IMU]++;
+        return true;
+    }
+    case FLASH_LOG_REC_BARO: {
+        FlashLogBaroRecord r;
+        memcpy(&r, p, sizeof(r));
+        if (!meas_queue_push_baro(pil->queue, r.timestamp_us, r.pressure_pa, r.temp_c)) {
+            pil->stats.queue_drops++;
+            return false;
+        }
+        pil->stats.released[MEAS_TYPE_BARO]++;
+        return false;
+    }
+    case FLASH_LOG_REC_MAG: {
+        FlashLogMagRecord r;
+        memcpy(&r, p, sizeof(r));
+        if (!meas_queue_push_mag(pil->queue, r.timestamp_us, vector3f_create(r.field[0], r.field[1], r.field[2]))) {
+            pil->stats.queue_drops++;
+            return false;
+        }
+        pil->stats.released[MEAS_TYPE_MAG]++;
+        return false;
+    }
+    case FLASH_LOG_REC_GNSS: {
+        FlashLogGnssRecord r;
+        memcpy(&r, p, sizeof(r));
+        pil_replay_publish_fix(pil, &r);
+        pil->stats.released[MEAS_TYPE_GNSS]++;
+        return false;
+    }
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief 배출 시각이 된 레코드를 수집 대기열로 내보냄
+ */
+uint32_t pil_replay_service(PilReplay *pil, uint32_t now_us) {
+    if (pil == NULL || !pil->initialized || !atomic_load_explicit(&pil->running, memory_order_acquire)) {
+        return 0;
+    }
+
+    uint32_t imu = 0;
+    for (;;) {
+        if (pil->pending == NULL && !pil_replay_next(pil, now_us)) {
+            break;
+        }
+
+        int32_t late = (int32_t)(pil_replay_virtual(pil, now_us) - pil->pending_us);
+        if (late < 0) {
+            break;
+        }
+        if ((uint32_t)late > pil->config.late_us) {
+            pil->stats.late++;
+        }
+        if (pil_replay_release(pil)) {
+            imu++;
+        }
+        pil->pending = NULL;
+    }
+
+    return imu;
+}
+
+/**
+ * @brief 최신 GNSS 해 읽기
+ */
+bool pil_replay_read_fix(const PilReplay *pil, UbxGnssFix *fix, uint32_t *seq) {
+    if (pil == NULL || fix == NULL) {
+        return false;
+    }
+
+    for (uint8_t attempt = 0; attempt < PIL_REPLAY_MAX_RETRIES; attempt++) {
+        uint_fast32_t before = atomic_load_explicit(&pil->fix_seq, memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        *fix = pil->fix[before & 1u];
+
+        // 복사가 두 번째 시퀀스 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(&pil->fix_seq, memory_order_relaxed);
+
+        if (after - before < 2) {
+            if (seq != NULL) {
+                *seq = (uint32_t)before;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 재생 상태를 주기마다 기록
+ */
+bool pil_replay_log(PilReplay *pil, FlashLog *log, const FusionMonitor *monitor) {
+    if (pil == NULL || !pil->initialized || log == NULL ||
+        !atomic_load_explicit(&pil->running, memory_order_acquire)) {
+        return false;
+    }
+
+    uint32_t now = pil_replay_virtual(pil, timebase_now_us());
+    bool finished = atomic_load_explicit(&pil->finished, memory_order_acquire);
+    if (finished) {
+        if (pil->reported_finish) {
+            return false;
+        }
+    } else if (now - pil->report_last_us < pil->config.report_us) {
+        return false;
+    }
+
+    // 서비스 문맥 카운터는 잠금 없이 읽음 (한 주기 정도 어긋날 수 있음)
+    PilReplayRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.timestamp_us = now;
+    rec.block = (uint32_t)atomic_load_explicit(&pil->next_block, memory_order_relaxed);
+    for (uint8_t i = 0; i < MEAS_TYPE_COUNT; i++) {
+        rec.released += pil->stats.released[i];
+    }
+    rec.late = pil->stats.late;
+    rec.queue_drops = pil->stats.queue_drops;
+    rec.underruns = pil->stats.underruns;
+    rec.speed = pil->config.speed;
+    rec.flags = finished ? PIL_REPLAY_FLAG_FINISHED : 0u;
+    if (monitor != NULL) {
+        rec.load = monitor->last_load;
+        for (uint8_t phase = 0; phase < FUSION_MONITOR_PHASE_COUNT; phase++) {
+            const FusionMonitorPhaseStats *s = &monitor->stats[phase];
+            rec.cycles += s->cycles;
+            rec.samples += s->samples;
+            rec.misses += s->misses;
+            rec.overloads += s->overloads;
+            if (s->max_busy_us > rec.max_busy_us) {
+                rec.max_busy_us = s->max_busy_us;
+            }
+            if (s->max_late_us > rec.max_late_us) {
+                rec.max_late_us = s->max_late_us;
+            }
+            if (s->peak_load > rec.peak_load) {
+                rec.peak_load = s->peak_load;
+            }
+        }
+    }
+
+    pil->report_last_us = now;
+    if (!flash_log_write(log, FLASH_LOG_REC_PIL, &rec, (uint8_t)sizeof(rec))) {
+        pil->stats.report_drops++;
+        return false;
+    }
+    pil->reported_finish = finished;
+    pil->stats.reports++;
+
+    return true;
+}
+
+/**
+ * @brief 세션을 끝까지 재생했는지
+ */
+bool pil_replay_finished(const PilReplay *pil) {
+    if (pil == NULL) {
+        return false;
+    }
+
+    return atomic_load_explicit(&pil->finished, memory_order_acquire);
+}
+
+/**
+ * @brief 통계
+ */
+const PilReplayStats *pil_replay_get_stats(const PilReplay *pil) {
+    if (pil == NULL) {
+        return NULL;
+    }
+
+    return &pil->stats;
+}
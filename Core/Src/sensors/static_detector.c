@@ -0,0 +1,129 @@
+/**
+ * @file static_detector.c
+ * @brief 가속도계/자이로 분산 기반 정지 판정 구현
+ */
+
+#include "sensors/static_detector.h"
+#include <stddef.h>
+
+/**
+ * @brief 창 누적값 초기화
+ */
+static void static_detector_clear_window(StaticDetector *det) {
+    det->count = 0;
+    det->accel_sum = vector3f_zero();
+    det->gyro_sum = vector3f_zero();
+    det->accel_sq_sum = 0.0f;
+    det->gyro_sq_sum = 0.0f;
+}
+
+/**
+ * @brief 기준 대비 편차 합에서 분산(공분산 대각합) 계산
+ */
+static float static_detector_variance(Vector3f sum, float sq_sum, float n) {
+    float var = (sq_sum - vector3f_magnitude_squared(sum) / n) / (n - 1.0f);
+    return var > 0.0f ? var : 0.0f;
+}
+
+/**
+ * @brief 정지 판정기 초기화
+ */
+bool static_detector_init(StaticDetector *det, uint16_t window, float accel_var_max, float gyro_var_max) {
+    if (det == NULL || window < 2 || accel_var_max <= 0.0f || gyro_var_max <= 0.0f) {
+        return false;
+    }
+
+    det->window = window;
+    det->accel_var_max = accel_var_max;
+    det->gyro_var_max = gyro_var_max;
+
+    return static_detector_reset(det);
+}
+
+/**
+ * @brief 판정 상태 초기화
+ */
+bool static_detector_reset(StaticDetector *det) {
+    if (det == NULL) {
+        return false;
+    }
+
+    static_detector_clear_window(det);
+    det->accel_ref = vector3f_zero();
+    det->gyro_ref = vector3f_zero();
+    det->accel_mean = vector3f_zero();
+    det->gyro_mean = vector3f_zero();
+    det->accel_var = 0.0f;
+    det->gyro_var = 0.0f;
+    det->has_window = false;
+    det->is_static = false;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 추가
+ */
+bool static_detector_add_sample(StaticDetector *det, Vector3f accel, Vector3f gyro) {
+    if (det == NULL) {
+        return false;
+    }
+
+    // 정지 중 큰 가속도 변화는 창 끝을 기다리지 않고 즉시 해제
+    if (det->is_static) {
+        float d2 = vector3f_magnitude_squared(vector3f_subtract(accel, det->accel_mean));
+        if (d2 > STATIC_DETECTOR_SAMPLE_GATE * det->accel_var_max) {
+            det->is_static = false;
+        }
+    }
+
+    if (det->count == 0) {
+        det->accel_ref = accel;
+        det->gyro_ref = gyro;
+    }
+
+    Vector3f da = vector3f_subtract(accel, det->accel_ref);
+    Vector3f dg = vector3f_subtract(gyro, det->gyro_ref);
+    det->accel_sum = vector3f_add(det->accel_sum, da);
+    det->gyro_sum = vector3f_add(det->gyro_sum, dg);
+    det->accel_sq_sum += vector3f_magnitude_squared(da);
+    det->gyro_sq_sum += vector3f_magnitude_squared(dg);
+    det->count++;
+
+    if (det->count < det->window) {
+        return false;
+    }
+
+    // 창 완료: 평균/분산 계산 후 판정
+    float n = (float)det->count;
+    det->accel_mean = vector3f_add(det->accel_ref, vector3f_scale(det->accel_sum, 1.0f / n));
+    det->gyro_mean = vector3f_add(det->gyro_ref, vector3f_scale(det->gyro_sum, 1.0f / n));
+    det->accel_var = static_detector_variance(det->accel_sum, det->accel_sq_sum, n);
+    det->gyro_var = static_detector_variance(det->gyro_sum, det->gyro_sq_sum, n);
+    det->is_static = det->accel_var <= det->accel_var_max && det->gyro_var <= det->gyro_var_max;
+    det->has_window = true;
+
+    static_detector_clear_window(det);
+
+    return true;
+}
+
+/**
+ * @brief 정지 여부 조회
+ */
+bool static_detector_is_static(const StaticDetector *det) {
+    return det != NULL && det->is_static;
+}
+
+/**
+ * @brief 마지막 창의 평균 각속도 조회
+ */
+bool static_detector_get_gyro_mean(const StaticDetector *det, Vector3f *gyro_mean) {
+    if (det == NULL || gyro_mean == NULL || !det->has_window) {
+        return false;
+    }
+
+    *gyro_mean = det->gyro_mean;
+
+    return true;
+}
@@ -0,0 +1,498 @@
+/**
+ * @file ubx_gnss.c
+ * @brief u-blox UBX NAV-PVT/NAV-RELPOSNED 수신 드라이버 구현 (UART 순환 DMA + IDLE 라인 이벤트)
+ */
+
+#include "sensors/ubx_gnss.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief UBX 프레임 상수
+ */
+#define UBX_SYNC1          0xB5
+#define UBX_SYNC2          0x62
+#define UBX_CLASS_NAV      0x01
+#define UBX_ID_NAV_PVT     0x07
+#define UBX_ID_NAV_RELPOSNED 0x3C
+
+/**
+ * @brief NAV-PVT 페이로드 오프셋
+ */
+#define UBX_PVT_ITOW       0
+#define UBX_PVT_FIX_TYPE   20
+#define UBX_PVT_FLAGS      21
+#define UBX_PVT_NUM_SV     23
+#define UBX_PVT_LON        24
+#define UBX_PVT_LAT        28
+#define UBX_PVT_HEIGHT     32
+#define UBX_PVT_HMSL       36
+#define UBX_PVT_H_ACC      40
+#define UBX_PVT_V_ACC      44
+#define UBX_PVT_VEL_N      48
+#define UBX_PVT_VEL_E      52
+#define UBX_PVT_VEL_D      56
+#define UBX_PVT_S_ACC      68
+
+#define UBX_PVT_FLAGS_FIX_OK 0x01
+
+/**
+ * @brief NAV-RELPOSNED 페이로드 오프셋 (버전 1)
+ */
+#define UBX_RELPOS_VERSION     0
+#define UBX_RELPOS_ITOW        4
+#define UBX_RELPOS_N           8
+#define UBX_RELPOS_E           12
+#define UBX_RELPOS_D           16
+#define UBX_RELPOS_LENGTH      20
+#define UBX_RELPOS_HEADING     24
+#define UBX_RELPOS_HP_N        32
+#define UBX_RELPOS_HP_E        33
+#define UBX_RELPOS_HP_D        34
+#define UBX_RELPOS_HP_LENGTH   35
+#define UBX_RELPOS_ACC_N       36
+#define UBX_RELPOS_ACC_E       40
+#define UBX_RELPOS_ACC_D       44
+#define UBX_RELPOS_ACC_HEADING 52
+#define UBX_RELPOS_FLAGS       60
+
+#define UBX_RELPOS_VERSION_1         0x01
+#define UBX_RELPOS_FLAGS_VALID       0x0004u
+#define UBX_RELPOS_FLAGS_CARR_SHIFT  3
+#define UBX_RELPOS_FLAGS_CARR_MASK   0x0018u
+#define UBX_RELPOS_FLAGS_HEADING     0x0100u
+
+/**
+ * @brief 1e-5 deg -> rad
+ */
+#define UBX_DEG_E5_TO_RAD (3.14159265358979f / 180.0f * 1e-5f)
+
+#define UBX_GNSS_INDEX_MASK (UBX_GNSS_DMA_SIZE - 1u)
+
+/**
+ * @brief 순환 버퍼 인덱스 전진
+ */
+static uint16_t ubx_gnss_wrap(uint32_t index) {
+    return (uint16_t)(index & UBX_GNSS_INDEX_MASK);
+}
+
+/**
+ * @brief 페이로드 바이트 (DMA 버퍼에서 직접, 순환 경계 포함)
+ */
+static uint8_t ubx_gnss_u8(const UbxGnss *gnss, uint16_t offset) {
+    return gnss->dma_buffer[ubx_gnss_wrap((uint32_t)gnss->payload_start + offset)];
+}
+
+/**
+ * @brief 리틀엔디안 32비트 부호 없는 값
+ */
+static uint32_t ubx_gnss_u32(const UbxGnss *gnss, uint16_t offset) {
+    return (uint32_t)ubx_gnss_u8(gnss, offset) |
+           ((uint32_t)ubx_gnss_u8(gnss, (uint16_t)(offset + 1)) << 8) |
+           ((uint32_t)ubx_gnss_u8(gnss, (uint16_t)(offset + 2)) << 16) |
+           ((uint32_t)ubx_gnss_u8(gnss, (uint16_t)(offset + 3)) << 24);
+}
+
+/**
+ * @brief 리틀엔디안 32비트 부호 있는 값
+ */
+static int32_t ubx_gnss_i32(const UbxGnss *gnss, uint16_t offset) {
+    return (int32_t)ubx_gnss_u32(gnss, offset);
+}
+
+/**
+ * @brief 상대 위치 성분 (cm 정수 + 0.1 mm 고정밀 부분 -> m)
+ */
+static float ubx_gnss_relpos_m(const UbxGnss *gnss, uint16_t cm_offset, uint16_t hp_offset) {
+    return (float)ubx_gnss_i32(gnss, cm_offset) * 1e-2f + (float)(int8_t)ubx_gnss_u8(gnss, hp_offset) * 1e-4f;
+}
+
+/**
+ * @brief 파서 초기화 (다음 동기 바이트부터)
+ */
+static void ubx_gnss_reset_parser(UbxGnss *gnss) {
+    gnss->state = UBX_PARSE_SYNC1;
+    gnss->length = 0;
+    gnss->remaining = 0;
+    gnss->ck_a = 0;
+    gnss->ck_b = 0;
+}
+
+/**
+ * @brief 측정 시각 부여
+ *
+ * 항법 시점은 iTOW의 초 미만 부분만큼 정수 초 경계(시간 펄스) 뒤에 있다.
+ * 마지막 펄스가 이미 다음 초의 것이면 한 초 앞으로 당긴다.
+ */
+static void ubx_gnss_stamp(const UbxGnss *gnss, uint32_t itow_ms, uint32_t arrival_us,
+                           uint32_t *timestamp_us, bool *pulse_locked) {
+    uint32_t count = gnss->pulse_count;
+    uint32_t pulse_us = gnss->pulse_us;
+
+    if (count == 0 || (arrival_us - pulse_us) >= UBX_GNSS_PULSE_MAX_AGE_US) {
+        *timestamp_us = arrival_us;
+        *pulse_locked = false;
+        return;
+    }
+
+    uint32_t stamp = pulse_us + (itow_ms % 1000u) * 1000u;
+    if ((int32_t)(arrival_us - stamp) < 0) {
+        stamp -= 1000000u;
+    }
+
+    *timestamp_us = stamp;
+    *pulse_locked = true;
+}
+
+/**
+ * @brief 검증된 NAV-PVT 변환 후 게시
+ */
+static void ubx_gnss_publish_pvt(UbxGnss *gnss, uint32_t arrival_us) {
+    uint_fast32_t next = atomic_load_explicit(&gnss->seq, memory_order_relaxed) + 1;
+    UbxGnssFix *fix = &gnss->fix[next & 1u];
+
+    fix->itow_ms = ubx_gnss_u32(gnss, UBX_PVT_ITOW);
+    fix->fix_type = ubx_gnss_u8(gnss, UBX_PVT_FIX_TYPE);
+    fix->fix_ok = (ubx_gnss_u8(gnss, UBX_PVT_FLAGS) & UBX_PVT_FLAGS_FIX_OK) != 0;
+    fix->num_sv = ubx_gnss_u8(gnss, UBX_PVT_NUM_SV);
+    fix->lon_e7 = ubx_gnss_i32(gnss, UBX_PVT_LON);
+    fix->lat_e7 = ubx_gnss_i32(gnss, UBX_PVT_LAT);
+    fix->height_mm = ubx_gnss_i32(gnss, UBX_PVT_HEIGHT);
+    fix->hmsl_mm = ubx_gnss_i32(gnss, UBX_PVT_HMSL);
+    fix->h_acc = (float)ubx_gnss_u32(gnss, UBX_PVT_H_ACC) * 1e-3f;
+    fix->v_acc = (float)ubx_gnss_u32(gnss, UBX_PVT_V_ACC) * 1e-3f;
+    fix->vel_ned = vector3f_create((float)ubx_gnss_i32(gnss, UBX_PVT_VEL_N) * 1e-3f,
+                                   (float)ubx_gnss_i32(gnss, UBX_PVT_VEL_E) * 1e-3f,
+                                   (float)ubx_gnss_i32(gnss, UBX_PVT_VEL_D) * 1e-3f);
+    fix->s_acc = (float)ubx_gnss_u32(gnss, UBX_PVT_S_ACC) * 1e-3f;
+    ubx_gnss_stamp(gnss, fix->itow_ms, arrival_us, &fix->timestamp_us, &fix->pulse_locked);
+
+    // 해 기록이 시퀀스보다 먼저 보이도록 release
+    atomic_store_explicit(&gnss->seq, next, memory_order_release);
+    gnss->fix_count++;
+}
+
+/**
+ * @brief 검증된 NAV-RELPOSNED 변환 후 게시
+ *
+ * @return bool 게시 여부 (버전 1이 아니면 false)
+ */
+static bool ubx_gnss_publish_relpos(UbxGnss *gnss, uint32_t arrival_us) {
+    if (ubx_gnss_u8(gnss, UBX_RELPOS_VERSION) != UBX_RELPOS_VERSION_1) {
+        return false;
+    }
+
+    uint_fast32_t next = atomic_load_explicit(&gnss->relpos_seq, memory_order_relaxed) + 1;
+    UbxGnssRelPos *rp = &gnss->relpos[next & 1u];
+    uint32_t flags = ubx_gnss_u32(gnss, UBX_RELPOS_FLAGS);
+
+    rp->itow_ms = ubx_gnss_u32(gnss, UBX_RELPOS_ITOW);
+    rp->rel_pos_ned = vector3f_create(ubx_gnss_relpos_m(gnss, UBX_RELPOS_N, UBX_RELPOS_HP_N),
+                                      ubx_gnss_relpos_m(gnss, UBX_RELPOS_E, UBX_RELPOS_HP_E),
+                                      ubx_gnss_relpos_m(gnss, UBX_RELPOS_D, UBX_RELPOS_HP_D));
+    rp->acc_ned = vector3f_create((float)ubx_gnss_u32(gnss, UBX_RELPOS_ACC_N) * 1e-4f,
+                                  (float)ubx_gnss_u32(gnss, UBX_RELPOS_ACC_E) * 1e-4f,
+                                  (float)ubx_gnss_u32(gnss, UBX_RELPOS_ACC_D) * 1e-4f);
+    rp->length = ubx_gnss_relpos_m(gnss, UBX_RELPOS_LENGTH, UBX_RELPOS_HP_LENGTH);
+    rp->heading = (float)ubx_gnss_i32(gnss, UBX_RELPOS_HEADING) * UBX_DEG_E5_TO_RAD;
+    rp->heading_acc = (float)ubx_gnss_u32(gnss, UBX_RELPOS_ACC_HEADING) * UBX_DEG_E5_TO_RAD;
+
+    // 앙각은 수신기가 주지 않으므로 상대 위치로 구함 (수평 길이 0이면 0)
+    float horiz = sqrtf(rp->rel_pos_ned.x * rp->rel_pos_ned.x + rp->rel_pos_ned.y * rp->rel_pos_ned.y);
+    rp->pitch = atan2f(-rp->rel_pos_ned.z, horiz);
+    rp->pitch_acc = (horiz > 0.0f) ? rp->acc_ned.z / horiz : 0.0f;
+
+    rp->carr_soln = (uint8_t)((flags & UBX_RELPOS_FLAGS_CARR_MASK) >> UBX_RELPOS_FLAGS_CARR_SHIFT);
+    rp->rel_pos_valid = (flags & UBX_RELPOS_FLAGS_VALID) != 0;
+    rp->heading_valid = (flags & UBX_RELPOS_FLAGS_HEADING) != 0;
+    ubx_gnss_stamp(gnss, rp->itow_ms, arrival_us, &rp->timestamp_us, &rp->pulse_locked);
+
+    atomic_store_explicit(&gnss->relpos_seq, next, memory_order_release);
+    gnss->relpos_count++;
+
+    return true;
+}
+
+/**
+ * @brief 헤더/체크섬 바이트 하나 처리
+ *
+ * @return bool NAV-PVT를 게시했으면 true (NAV-RELPOSNED는 false)
+ */
+static bool ubx_gnss_parse_byte(UbxGnss *gnss, uint8_t byte, uint16_t next_index, uint32_t arrival_us) {
+    switch (gnss->state) {
+    case UBX_PARSE_SYNC1:
+        if (byte == UBX_SYNC1) {
+            gnss->state = UBX_PARSE_SYNC2;
+        }
+        break;
+
+    case UBX_PARSE_SYNC2:
+        if (byte == UBX_SYNC2) {
+            gnss->ck_a = 0;
+            gnss->ck_b = 0;
+            gnss->state = UBX_PARSE_CLASS;
+        } else if (byte != UBX_SYNC1) {
+            gnss->state = UBX_PARSE_SYNC1;
+        }
+        break;
+
+    case UBX_PARSE_CLASS:
+    case UBX_PARSE_ID:
+    case UBX_PARSE_LENGTH1:
+        gnss->ck_a = (uint8_t)(gnss->ck_a + byte);
+        gnss->ck_b = (uint8_t)(gnss->ck_b + gnss->ck_a);
+        if (gnss->state == UBX_PARSE_CLASS) {
+            gnss->msg_class = byte;
+            gnss->state = UBX_PARSE_ID;
+        } else if (gnss->state == UBX_PARSE_ID) {
+            gnss->msg_id = byte;
+            gnss->state = UBX_PARSE_LENGTH1;
+        } else {
+            gnss->length = byte;
+            gnss->state = UBX_PARSE_LENGTH2;
+        }
+        break;
+
+    case UBX_PARSE_LENGTH2:
+        gnss->ck_a = (uint8_t)(gnss->ck_a + byte);
+        gnss->ck_b = (uint8_t)(gnss->ck_b + gnss->ck_a);
+        gnss->length = (uint16_t)(gnss->length | ((uint16_t)byte << 8));
+
+        if (gnss->msg_class == UBX_CLASS_NAV && gnss->msg_id == UBX_ID_NAV_PVT) {
+            if (gnss->length != UBX_NAV_PVT_LENGTH) {
+                gnss->length_errors++;
+                ubx_gnss_reset_parser(gnss);
+                break;
+            }
+            gnss->payload_start = next_index;
+            gnss->remaining = gnss->length;
+            gnss->state = UBX_PARSE_PAYLOAD;
+        } else if (gnss->msg_class == UBX_CLASS_NAV && gnss->msg_id == UBX_ID_NAV_RELPOSNED &&
+                   gnss->length == UBX_NAV_RELPOSNED_LENGTH) {
+            // 버전 0(40바이트, 8세대)은 아래에서 건너뜀
+            gnss->payload_start = next_index;
+            gnss->remaining = gnss->length;
+            gnss->state = UBX_PARSE_PAYLOAD;
+        } else if (gnss->length > UBX_GNSS_MAX_PAYLOAD) {
+            gnss->length_errors++;
+            ubx_gnss_reset_parser(gnss);
+        } else {
+            // 페이로드와 체크섬 2바이트를 건너뜀
+            gnss->remaining = (uint16_t)(gnss->length + 2u);
+            gnss->state = UBX_PARSE_SKIP;
+        }
+        break;
+
+    case UBX_PARSE_CK_A:
+        if (byte == gnss->ck_a) {
+            gnss->state = UBX_PARSE_CK_B;
+        } else {
+            gnss->checksum_errors++;
+            ubx_gnss_reset_parser(gnss);
+        }
+        break;
+
+    case UBX_PARSE_CK_B: {
+        bool pvt = false;
+        if (byte != gnss->ck_b) {
+            gnss->checksum_errors++;
+        } else if (gnss->msg_id == UBX_ID_NAV_PVT) {
+            ubx_gnss_publish_pvt(gnss, arrival_us);
+            pvt = true;
+        } else {
+            ubx_gnss_publish_relpos(gnss, arrival_us);
+        }
+        ubx_gnss_reset_parser(gnss);
+        return pvt;
+    }
+
+    default:
+        ubx_gnss_reset_parser(gnss);
+        break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 드라이버 초기화 및 순환 DMA 수신 시작
+ */
+bool ubx_gnss_init(UbxGnss *gnss, UART_HandleTypeDef *huart) {
+    if (gnss == NULL || huart == NULL) {
+        return false;
+    }
+
+    gnss->huart = huart;
+    gnss->read_index = 0;
+    ubx_gnss_reset_parser(gnss);
+    gnss->msg_class = 0;
+    gnss->msg_id = 0;
+    gnss->payload_start = 0;
+
+    gnss->pulse_us = 0;
+    gnss->pulse_count = 0;
+    atomic_init(&gnss->seq, 0);
+    atomic_init(&gnss->relpos_seq, 0);
+
+    gnss->fix_count = 0;
+    gnss->relpos_count = 0;
+    gnss->checksum_errors = 0;
+    gnss->length_errors = 0;
+    gnss->uart_errors = 0;
+    gnss->initialized = false;
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(huart, gnss->dma_buffer, UBX_GNSS_DMA_SIZE) != HAL_OK) {
+        return false;
+    }
+
+    gnss->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief UART 수신 이벤트 처리
+ *
+ * 읽기 위치부터 쓰기 위치까지를 연속 구간 단위로 처리한다. 페이로드 구간은
+ * 체크섬만 누적하거나(NAV-PVT) 통째로 건너뛰고, 헤더/체크섬만 바이트 단위로 본다.
+ */
+uint32_t ubx_gnss_handle_rx_event(UbxGnss *gnss, uint16_t position, uint32_t timestamp_us) {
+    if (gnss == NULL || !gnss->initialized || position > UBX_GNSS_DMA_SIZE) {
+        return 0;
+    }
+
+    // 완료 이벤트는 position == 크기 (버퍼 처음으로 돌아감)
+    uint16_t end = ubx_gnss_wrap(position);
+    uint16_t i = gnss->read_index;
+    uint32_t published = 0;
+
+    while (i != end) {
+        uint16_t run = (end > i) ? (uint16_t)(end - i) : (uint16_t)(UBX_GNSS_DMA_SIZE - i);
+
+        if (gnss->state == UBX_PARSE_PAYLOAD || gnss->state == UBX_PARSE_SKIP) {
+            uint16_t n = (run < gnss->remaining) ? run : gnss->remaining;
+
+            if (gnss->state == UBX_PARSE_PAYLOAD) {
+                uint8_t a = gnss->ck_a;
+                uint8_t b = gnss->ck_b;
+                const uint8_t *p = &gnss->dma_buffer[i];
+                for (uint16_t k = 0; k < n; k++) {
+                    a = (uint8_t)(a + p[k]);
+                    b = (uint8_t)(b + a);
+                }
+                gnss->ck_a = a;
+                gnss->ck_b = b;
+            }
+
+            i = ubx_gnss_wrap((uint32_t)i + n);
+            gnss->remaining = (uint16_t)(gnss->remaining - n);
+            if (gnss->remaining == 0) {
+                if (gnss->state == UBX_PARSE_PAYLOAD) {
+                    gnss->state = UBX_PARSE_CK_A;
+                } else {
+                    ubx_gnss_reset_parser(gnss);
+                }
+            }
+            continue;
+        }
+
+        uint8_t byte = gnss->dma_buffer[i];
+        i = ubx_gnss_wrap((uint32_t)i + 1u);
+        if (ubx_gnss_parse_byte(gnss, byte, i, timestamp_us)) {
+            published++;
+        }
+    }
+
+    gnss->read_index = end;
+
+    return published;
+}
+
+/**
+ * @brief UART 오류 처리 (파서 초기화 후 수신 재시작)
+ */
+void ubx_gnss_handle_uart_error(UbxGnss *gnss) {
+    if (gnss == NULL || !gnss->initialized) {
+        return;
+    }
+
+    gnss->uart_errors++;
+
+    HAL_UART_AbortReceive(gnss->huart);
+    gnss->read_index = 0;
+    ubx_gnss_reset_parser(gnss);
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(gnss->huart, gnss->dma_buffer, UBX_GNSS_DMA_SIZE) != HAL_OK) {
+        gnss->initialized = false;
+    }
+}
+
+/**
+ * @brief 시간 펄스 인터럽트 처리
+ */
+void ubx_gnss_handle_timepulse(UbxGnss *gnss, uint32_t timestamp_us) {
+    if (gnss == NULL) {
+        return;
+    }
+
+    gnss->pulse_us = timestamp_us;
+    gnss->pulse_count++;
+}
+
+/**
+ * @brief 이중 버퍼 하나를 시퀀스로 확인하며 복사
+ *
+ * @param seq_var 게시 시퀀스
+ * @param slots 두 버퍼 (연속 배열)
+ * @param size 버퍼 하나의 크기 (바이트)
+ * @param out 복사할 곳
+ * @param seq 읽은 시퀀스 (NULL 가능)
+ * @return bool 성공 여부
+ */
+static bool ubx_gnss_read_buffered(const atomic_uint_fast32_t *seq_var, const void *slots, size_t size,
+                                   void *out, uint32_t *seq) {
+    for (uint8_t attempt = 0; attempt < UBX_GNSS_MAX_RETRIES; attempt++) {
+        uint_fast32_t before = atomic_load_explicit(seq_var, memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        memcpy(out, (const uint8_t *)slots + (before & 1u) * size, size);
+
+        // 복사가 두 번째 시퀀스 읽기보다 먼저 끝나도록 보장
+        atomic_thread_fence(memory_order_acquire);
+        uint_fast32_t after = atomic_load_explicit(seq_var, memory_order_relaxed);
+
+        if (after - before < 2) {
+            if (seq != NULL) {
+                *seq = (uint32_t)before;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 최신 해 읽기
+ */
+bool ubx_gnss_read_fix(const UbxGnss *gnss, UbxGnssFix *fix, uint32_t *seq) {
+    if (gnss == NULL || fix == NULL) {
+        return false;
+    }
+
+    return ubx_gnss_read_buffered(&gnss->seq, gnss->fix, sizeof(gnss->fix[0]), fix, seq);
+}
+
+/**
+ * @brief 최신 상대 위치 읽기
+ */
+bool ubx_gnss_read_relpos(const UbxGnss *gnss, UbxGnssRelPos *relpos, uint32_t *seq) {
+    if (gnss == NULL || relpos == NULL) {
+        return false;
+    }
+
+    return ubx_gnss_read_buffered(&gnss->relpos_seq, gnss->relpos, sizeof(gnss->relpos[0]), relpos, seq);
+}
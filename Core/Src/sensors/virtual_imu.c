@@ -0,0 +1,360 @@
+/**
+ * @file virtual_imu.c
+ * @brief 다중 IMU 가상 IMU 합성 구현
+ */
+
+#include "sensors/virtual_imu.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief IMU 한 개의 출력 시각 상태
+ */
+typedef enum {
+    VIRTUAL_IMU_SAMPLE_READY = 0,   /**< 출력 시각 값 있음 */
+    VIRTUAL_IMU_SAMPLE_MISSING = 1, /**< 끊김 또는 보간 불가 (제외) */
+    VIRTUAL_IMU_SAMPLE_WAIT = 2     /**< 다음 샘플 대기 */
+} VirtualImuSampleState;
+
+/**
+ * @brief 시각 a가 b보다 앞인지 (32비트 랩어라운드 고려)
+ */
+static bool virtual_imu_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief 입력 링에서 다음 샘플 하나 미리 꺼내기
+ */
+static void virtual_imu_refill(VirtualImuSource *src) {
+    if (!src->has_next) {
+        src->has_next = imu_ring_pop(src->ring, &src->next);
+    }
+}
+
+/**
+ * @brief 출력 시각까지 지난 샘플 넘기기 (prev.t <= t < next.t)
+ */
+static void virtual_imu_advance(VirtualImuSource *src, uint32_t t) {
+    virtual_imu_refill(src);
+    while (src->has_next && !virtual_imu_before(t, src->next.timestamp_us)) {
+        src->prev = src->next;
+        src->has_prev = true;
+        src->has_next = false;
+        virtual_imu_refill(src);
+    }
+}
+
+/**
+ * @brief 끊기지 않은 IMU인지 (마지막 샘플이 timeout_us 이내)
+ */
+static bool virtual_imu_alive(const VirtualImu *vimu, const VirtualImuSource *src, uint32_t now_us) {
+    return src->has_prev && (now_us - src->prev.timestamp_us) < vimu->config.timeout_us;
+}
+
+/**
+ * @brief 출력 시각 t의 IMU 값 (앞뒤 샘플 선형 보간)
+ */
+static VirtualImuSampleState virtual_imu_sample_at(const VirtualImu *vimu, const VirtualImuSource *src,
+                                                   uint32_t t, uint32_t now_us,
+                                                   Vector3f *gyro, Vector3f *accel) {
+    if (src->has_prev && src->prev.timestamp_us == t) {
+        *gyro = src->prev.gyro;
+        *accel = src->prev.accel;
+        return VIRTUAL_IMU_SAMPLE_READY;
+    }
+
+    if (!src->has_next) {
+        return virtual_imu_alive(vimu, src, now_us) ? VIRTUAL_IMU_SAMPLE_WAIT : VIRTUAL_IMU_SAMPLE_MISSING;
+    }
+
+    uint32_t span = src->next.timestamp_us - src->prev.timestamp_us;
+    if (!src->has_prev || span > vimu->config.timeout_us) {
+        // 출력 시각 이후에 시작했거나 샘플 공백이 너무 김
+        return VIRTUAL_IMU_SAMPLE_MISSING;
+    }
+
+    float w = (float)(t - src->prev.timestamp_us) / (float)span;
+    *gyro = vector3f_add(src->prev.gyro, vector3f_scale(vector3f_subtract(src->next.gyro, src->prev.gyro), w));
+    *accel = vector3f_add(src->prev.accel, vector3f_scale(vector3f_subtract(src->next.accel, src->prev.accel), w));
+
+    return VIRTUAL_IMU_SAMPLE_READY;
+}
+
+/**
+ * @brief 세 값의 중앙값
+ */
+static float virtual_imu_median3(float a, float b, float c) {
+    float lo = fminf(a, b);
+    float hi = fmaxf(a, b);
+
+    return fmaxf(lo, fminf(hi, c));
+}
+
+/**
+ * @brief 축별 중앙값 (2개이면 평균)
+ */
+static Vector3f virtual_imu_center(const Vector3f *v, uint8_t n) {
+    if (n == 1) {
+        return v[0];
+    }
+    if (n == 2) {
+        return vector3f_scale(vector3f_add(v[0], v[1]), 0.5f);
+    }
+
+    return vector3f_create(virtual_imu_median3(v[0].x, v[1].x, v[2].x),
+                           virtual_imu_median3(v[0].y, v[1].y, v[2].y),
+                           virtual_imu_median3(v[0].z, v[1].z, v[2].z));
+}
+
+/**
+ * @brief 축별 최대 편차
+ */
+static float virtual_imu_deviation(Vector3f a, Vector3f b) {
+    Vector3f d = vector3f_subtract(a, b);
+
+    return fmaxf(fabsf(d.x), fmaxf(fabsf(d.y), fabsf(d.z)));
+}
+
+/**
+ * @brief 출력 시각 하나 합성 후 출력 링에 추가
+ *
+ * @return bool 출력 여부
+ */
+static bool virtual_imu_fuse(VirtualImu *vimu, uint32_t t, const Vector3f *gyro_in,
+                             const Vector3f *accel_in, const uint8_t *index_in, uint8_t n_in) {
+    Vector3f gyro[VIRTUAL_IMU_MAX_SOURCES];
+    Vector3f accel[VIRTUAL_IMU_MAX_SOURCES];
+    uint8_t index[VIRTUAL_IMU_MAX_SOURCES];
+    uint8_t n = 0;
+
+    // 유한하지 않은 샘플 제외
+    for (uint8_t i = 0; i < n_in; i++) {
+        float sum = gyro_in[i].x + gyro_in[i].y + gyro_in[i].z +
+                    accel_in[i].x + accel_in[i].y + accel_in[i].z;
+        if (!isfinite(sum)) {
+            vimu->source[index_in[i]].rejected++;
+            continue;
+        }
+        gyro[n] = gyro_in[i];
+        accel[n] = accel_in[i];
+        index[n] = index_in[i];
+        n++;
+    }
+
+    if (n == 0) {
+        vimu->dropped++;
+        return false;
+    }
+
+    Vector3f gyro_c = virtual_imu_center(gyro, n);
+    Vector3f accel_c = virtual_imu_center(accel, n);
+
+    // 허용 편차 대비 비율 (1 이하면 채택)
+    float ratio[VIRTUAL_IMU_MAX_SOURCES];
+    bool accept[VIRTUAL_IMU_MAX_SOURCES];
+    uint8_t accepted = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        ratio[i] = fmaxf(virtual_imu_deviation(gyro[i], gyro_c) / vimu->config.gyro_tol,
+                         virtual_imu_deviation(accel[i], accel_c) / vimu->config.accel_tol);
+        accept[i] = ratio[i] <= 1.0f;
+        if (accept[i]) {
+            accepted++;
+        }
+    }
+
+    if (accepted == 0) {
+        // 2개가 어긋나면 직전 출력, 3개가 모두 어긋나면 중앙값에 가장 가까운 IMU 하나
+        if (n == 2) {
+            if (!vimu->has_last) {
+                vimu->source[index[0]].rejected++;
+                vimu->source[index[1]].rejected++;
+                vimu->dropped++;
+                return false;
+            }
+            for (uint8_t i = 0; i < n; i++) {
+                ratio[i] = fmaxf(virtual_imu_deviation(gyro[i], vimu->last.gyro) / vimu->config.gyro_tol,
+                                 virtual_imu_deviation(accel[i], vimu->last.accel) / vimu->config.accel_tol);
+            }
+        }
+        uint8_t best = 0;
+        for (uint8_t i = 1; i < n; i++) {
+            if (ratio[i] < ratio[best]) {
+                best = i;
+            }
+        }
+        accept[best] = true;
+        accepted = 1;
+    }
+
+    Vector3f gyro_sum = vector3f_zero();
+    Vector3f accel_sum = vector3f_zero();
+    for (uint8_t i = 0; i < n; i++) {
+        if (accept[i]) {
+            gyro_sum = vector3f_add(gyro_sum, gyro[i]);
+            accel_sum = vector3f_add(accel_sum, accel[i]);
+            vimu->source[index[i]].used++;
+        } else {
+            vimu->source[index[i]].rejected++;
+        }
+    }
+
+    float inv = 1.0f / (float)accepted;
+    ImuSample out;
+    out.timestamp_us = t;
+    out.gyro = vector3f_scale(gyro_sum, inv);
+    out.accel = vector3f_scale(accel_sum, inv);
+
+    vimu->last = out;
+    vimu->has_last = true;
+    vimu->last_used = accepted;
+
+    // 가득 찬 경우 출력 링이 dropped를 기록
+    imu_ring_push(vimu->out, &out);
+    vimu->emitted++;
+
+    return true;
+}
+
+/**
+ * @brief 기본 합성 조건
+ */
+bool virtual_imu_default_config(VirtualImuConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->interleave = false;
+    config->gyro_tol = VIRTUAL_IMU_DEFAULT_GYRO_TOL;
+    config->accel_tol = VIRTUAL_IMU_DEFAULT_ACCEL_TOL;
+    config->timeout_us = VIRTUAL_IMU_DEFAULT_TIMEOUT_US;
+
+    return true;
+}
+
+/**
+ * @brief 가상 IMU 초기화
+ */
+bool virtual_imu_init(VirtualImu *vimu, ImuRing *const *sources, uint8_t count,
+                      ImuRing *out, const VirtualImuConfig *config) {
+    if (vimu == NULL || sources == NULL || out == NULL || count == 0 || count > VIRTUAL_IMU_MAX_SOURCES) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (sources[i] == NULL || sources[i] == out) {
+            return false;
+        }
+    }
+
+    if (config != NULL) {
+        if (!(config->gyro_tol > 0.0f) || !(config->accel_tol > 0.0f)) {
+            return false;
+        }
+        vimu->config = *config;
+    } else {
+        virtual_imu_default_config(&vimu->config);
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        VirtualImuSource *src = &vimu->source[i];
+        src->ring = sources[i];
+        src->has_prev = false;
+        src->has_next = false;
+        src->used = 0;
+        src->rejected = 0;
+        src->missing = 0;
+    }
+    vimu->count = count;
+    vimu->out = out;
+
+    vimu->has_last = false;
+    vimu->last_used = 0;
+    vimu->emitted = 0;
+    vimu->dropped = 0;
+
+    return true;
+}
+
+/**
+ * @brief 입력 링을 꺼내 합성 샘플을 출력 링에 추가
+ */
+uint32_t virtual_imu_process(VirtualImu *vimu, uint32_t now_us) {
+    if (vimu == NULL) {
+        return 0;
+    }
+
+    uint32_t emitted = 0;
+
+    for (;;) {
+        // 출력 시각을 정할 IMU 선택
+        uint8_t k = vimu->count;
+        for (uint8_t i = 0; i < vimu->count; i++) {
+            VirtualImuSource *src = &vimu->source[i];
+            virtual_imu_refill(src);
+
+            if (vimu->config.interleave) {
+                if (src->has_next && (k == vimu->count ||
+                    virtual_imu_before(src->next.timestamp_us, vimu->source[k].next.timestamp_us))) {
+                    k = i;
+                }
+            } else if (src->has_next) {
+                k = i;
+                break;
+            } else if (virtual_imu_alive(vimu, src, now_us)) {
+                // 우선 기준 IMU의 다음 샘플 대기
+                return emitted;
+            }
+        }
+
+        if (k == vimu->count) {
+            return emitted;
+        }
+
+        VirtualImuSource *ref = &vimu->source[k];
+        uint32_t t = ref->next.timestamp_us;
+
+        // 출력 시각은 증가만 함 (끊겼다 돌아온 IMU의 지난 샘플 등은 버림)
+        if (vimu->has_last && !virtual_imu_before(vimu->last.timestamp_us, t)) {
+            ref->prev = ref->next;
+            ref->has_prev = true;
+            ref->has_next = false;
+            continue;
+        }
+
+        // 다른 IMU를 출력 시각에 맞춤
+        Vector3f gyro[VIRTUAL_IMU_MAX_SOURCES];
+        Vector3f accel[VIRTUAL_IMU_MAX_SOURCES];
+        uint8_t index[VIRTUAL_IMU_MAX_SOURCES];
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < vimu->count; i++) {
+            if (i == k) {
+                continue;
+            }
+            VirtualImuSource *src = &vimu->source[i];
+            virtual_imu_advance(src, t);
+
+            VirtualImuSampleState state = virtual_imu_sample_at(vimu, src, t, now_us, &gyro[n], &accel[n]);
+            if (state == VIRTUAL_IMU_SAMPLE_WAIT) {
+                return emitted;
+            }
+            if (state == VIRTUAL_IMU_SAMPLE_READY) {
+                index[n++] = i;
+            } else {
+                src->missing++;
+            }
+        }
+
+        // 출력 시각 IMU 샘플 소비
+        gyro[n] = ref->next.gyro;
+        accel[n] = ref->next.accel;
+        index[n++] = k;
+        ref->prev = ref->next;
+        ref->has_prev = true;
+        ref->has_next = false;
+
+        if (virtual_imu_fuse(vimu, t, gyro, accel, index, n)) {
+            emitted++;
+        }
+    }
+}
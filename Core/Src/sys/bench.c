@@ -0,0 +1,495 @@
+/**
+ * @file bench.c
+ * @brief 보드 사이클 벤치마크 구현
+ */
+
+#include "sys/bench.h"
+
+#ifdef BENCH_ENABLE
+
+#include "stm32l4xx_hal.h"
+#include "sys/mem_section.h"
+#include "sys/memstat.h"
+#include "math/matrix_fixed.h"
+#include "math/quaternion.h"
+#include "math/rotation_batch.h"
+#include "ekf/ekf.h"
+#include "ekf/ekf_golden.h"
+#include "math/fp_mode.h"
+#include "nav/filter_engine.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 합성 입력 풀 크기 (입력이 반복되며 순환)
+ */
+#define BENCH_POOL_SIZE 32
+
+/**
+ * @brief 필터를 다시 초기화하는 반복 간격 (초기화 시간은 측정에서 제외)
+ */
+#define BENCH_BLOCK_SIZE 200
+
+/**
+ * @brief 커널별 스택 깊이를 재는 창 크기 (바이트, 이보다 깊으면 창 크기 근처 값으로 포화)
+ */
+#define BENCH_STACK_WINDOW 4096u
+
+/**
+ * @brief 난수 생성기 고정 시드 (호스트 벤치마크와 같음)
+ */
+#define BENCH_SEED 0x12345678u
+
+/**
+ * @brief 플래시 대기 상태 1단계당 최대 HCLK (전압 범위 1, RM0351 표 12)
+ */
+#define BENCH_FLASH_HZ_PER_WS 16000000u
+
+/**
+ * @brief 측정 대상 벤치마크
+ */
+typedef struct {
+    const char *name;                   /**< 벤치마크 이름 (공백 없음) */
+    uint32_t iterations;                /**< 기본 반복 횟수 */
+    void (*setup)(void);                /**< 블록 시작 전 상태 초기화 (NULL 가능) */
+    void (*run)(uint32_t i);            /**< 연산 1회 수행 */
+} Benchmark;
+
+/**
+ * @brief 최적화로 연산이 제거되지 않도록 결과를 누적하는 변수
+ */
+static volatile float bench_sink;
+
+static uint32_t bench_rng_state;
+
+/**
+ * @brief DWT 두 번 읽기의 사이클 (측정 오버헤드)
+ */
+static uint32_t bench_overhead;
+
+static bool bench_ready;
+
+static Mat16x16 bench_mat_a;
+static Mat16x16 bench_mat_b;
+static Mat16x16 bench_mat_result;
+
+static Quaternion bench_quat[BENCH_POOL_SIZE];
+static Vector3f bench_gyro[BENCH_POOL_SIZE];
+static Vector3f bench_accel[BENCH_POOL_SIZE];
+static Vector3f bench_gps_pos[BENCH_POOL_SIZE];
+static Vector3f bench_gps_vel[BENCH_POOL_SIZE];
+static Vector3f bench_mag[BENCH_POOL_SIZE];
+static float bench_baro[BENCH_POOL_SIZE];
+static float bench_soa_in[3][BENCH_POOL_SIZE];
+static float bench_soa_out[3][BENCH_POOL_SIZE];
+
+static EKF bench_ekf;
+static EKF_DelayBuffer bench_history;
+static FilterEngine bench_engine;
+
+/**
+ * @brief xorshift32 난수 (-0.5 ~ 0.5)
+ */
+static float bench_random(void) {
+    uint32_t x = bench_rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench_rng_state = x;
+    return (float)(x >> 8) / 16777216.0f - 0.5f;
+}
+
+/**
+ * @brief 고정 시드로 모든 합성 입력 생성
+ */
+static void bench_generate_inputs(void) {
+    bench_rng_state = BENCH_SEED;
+    for (uint8_t i = 0; i < 16; i++) {
+        for (uint8_t j = 0; j < 16; j++) {
+            mat16x16_set(&bench_mat_a, i, j, bench_random());
+            mat16x16_set(&bench_mat_b, i, j, bench_random());
+        }
+    }
+
+    for (uint32_t n = 0; n < BENCH_POOL_SIZE; n++) {
+        bench_quat[n] = quaternion_from_euler(bench_random(), bench_random(), 6.0f * bench_random());
+        bench_gyro[n] = vector3f_create(0.1f * bench_random(), 0.1f * bench_random(), 0.1f * bench_random());
+        bench_accel[n] = vector3f_create(0.5f * bench_random(), 0.5f * bench_random(),
+                                         9.80665f + 0.5f * bench_random());
+        bench_gps_pos[n] = vector3f_create(2.0f * bench_random(), 2.0f * bench_random(), 2.0f * bench_random());
+        bench_gps_vel[n] = vector3f_create(0.2f * bench_random(), 0.2f * bench_random(), 0.2f * bench_random());
+        bench_mag[n] = vector3f_create(0.29f + 0.05f * bench_random(), -0.05f + 0.05f * bench_random(),
+                                       0.42f + 0.05f * bench_random());
+        bench_baro[n] = bench_random();
+        bench_soa_in[0][n] = bench_accel[n].x;
+        bench_soa_in[1][n] = bench_accel[n].y;
+        bench_soa_in[2][n] = bench_accel[n].z;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 벤치마크 본체
+ * ------------------------------------------------------------------------- */
+
+static void bench_matrix_multiply(uint32_t i) {
+    (void)i;
+    mat_multiply_16x16_16x16(&bench_mat_a, &bench_mat_b, &bench_mat_result);
+    bench_sink += bench_mat_result.data[0][0];
+}
+
+static void bench_matrix_add_scaled(uint32_t i) {
+    (void)i;
+    mat16x16_add_scaled(&bench_mat_result, &bench_mat_b, 1e-3f);
+    bench_sink += bench_mat_result.data[0][0];
+}
+
+static void bench_matrix_copy(uint32_t i) {
+    (void)i;
+    bench_mat_result = bench_mat_a;
+    bench_sink += bench_mat_result.data[15][15];
+}
+
+static void bench_quaternion_rotate_vector(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    Vector3f v = quaternion_rotate_vector(bench_quat[n], bench_accel[n]);
+    bench_sink += v.x;
+}
+
+/**
+ * @brief 묶음 회전 (BENCH_POOL_SIZE개 벡터, 벡터당 사이클은 결과 / BENCH_POOL_SIZE)
+ */
+static void bench_rotation_batch(uint32_t i) {
+    const Vector3fSoAConst in = { bench_soa_in[0], bench_soa_in[1], bench_soa_in[2] };
+    const Vector3fSoA out = { bench_soa_out[0], bench_soa_out[1], bench_soa_out[2] };
+    rotation_batch_rotate(bench_quat[i % BENCH_POOL_SIZE], &in, &out, BENCH_POOL_SIZE);
+    bench_sink += bench_soa_out[2][0];
+}
+
+static void bench_rotation_batch_interp(uint32_t i) {
+    const Vector3fSoAConst in = { bench_soa_in[0], bench_soa_in[1], bench_soa_in[2] };
+    const Vector3fSoA out = { bench_soa_out[0], bench_soa_out[1], bench_soa_out[2] };
+    uint32_t n = i % BENCH_POOL_SIZE;
+    rotation_batch_rotate_interp(bench_quat[n], bench_quat[(n + 1u) % BENCH_POOL_SIZE], &in, &out, BENCH_POOL_SIZE);
+    bench_sink += bench_soa_out[2][0];
+}
+
+/**
+ * @brief 블록마다 같은 초기 상태에서 필터 시작 (공분산 엔진, 순차 갱신)
+ */
+static void bench_ekf_setup(void) {
+    ekf_init(&bench_ekf);
+    ekf_set_initial_state(&bench_ekf, vector3f_zero(), vector3f_zero(), bench_quat[0]);
+    ekf_set_process_noise(&bench_ekf, 0.01f, 0.1f, 0.01f, 0.001f, 0.01f);
+}
+
+static void bench_ekf_setup_ud(void) {
+    bench_ekf_setup();
+    ekf_set_engine(&bench_ekf, EKF_ENGINE_UD);
+}
+
+static void bench_ekf_setup_batch(void) {
+    bench_ekf_setup();
+    ekf_set_update_mode(&bench_ekf, EKF_UPDATE_BATCH);
+}
+
+static void bench_ekf_predict(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_predict(&bench_ekf, bench_gyro[n], bench_accel[n], 0.01f);
+}
+
+static void bench_ekf_update_gps_vel(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_gps(&bench_ekf, bench_gps_pos[n], true, bench_gps_vel[n]);
+}
+
+static void bench_ekf_update_baro(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_baro(&bench_ekf, bench_baro[n]);
+}
+
+static void bench_ekf_update_mag(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_mag(&bench_ekf, bench_mag[n]);
+}
+
+/**
+ * @brief 100 Hz 필터 한 주기 (예측, 기압, 자력계, 10주기마다 GNSS)
+ */
+static void bench_ekf_cycle(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_predict(&bench_ekf, bench_gyro[n], bench_accel[n], 0.01f);
+    ekf_update_baro(&bench_ekf, bench_baro[n]);
+    ekf_update_mag(&bench_ekf, bench_mag[n]);
+    if ((i % 10u) == 0u) {
+        ekf_update_gps(&bench_ekf, bench_gps_pos[n], true, bench_gps_vel[n]);
+    }
+}
+
+/**
+ * @brief 엔진 함수 테이블을 거친 블록 시작 (bench_ekf_setup과 같은 초기 상태와 노이즈)
+ */
+static void bench_engine_setup(FilterEngineId id) {
+    FilterEngineConfig config;
+    filter_engine_default_config(&config);
+    config.q = bench_quat[0];
+    config.pos_std = 0.01f;
+    config.vel_std = 0.1f;
+    config.att_std = 0.01f;
+    config.gyro_bias_std = 0.001f;
+    config.accel_bias_std = 0.01f;
+    filter_engine_select(&bench_engine, id, &config);
+}
+
+static void bench_engine_setup_ekf(void) {
+    bench_engine_setup(FILTER_ENGINE_EKF);
+}
+
+static void bench_engine_setup_ekf_batch(void) {
+    bench_engine_setup(FILTER_ENGINE_EKF_BATCH);
+}
+
+static void bench_engine_setup_ekf_ud(void) {
+    bench_engine_setup(FILTER_ENGINE_EKF_UD);
+}
+
+static void bench_engine_setup_eskf(void) {
+    bench_engine_setup(FILTER_ENGINE_ESKF);
+}
+
+/**
+ * @brief 엔진 함수 테이블을 거친 100 Hz 한 주기 (bench_ekf_cycle과 같은 입력)
+ */
+static void bench_engine_cycle(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    FilterEngineMeasurement m = { .sensor = EKF_SENSOR_BARO, .scalar = bench_baro[n] };
+    filter_engine_predict(&bench_engine, bench_gyro[n], bench_accel[n], 0.01f);
+    filter_engine_update(&bench_engine, &m);
+    m.sensor = EKF_SENSOR_MAG;
+    m.value = bench_mag[n];
+    filter_engine_update(&bench_engine, &m);
+    if ((i % 10u) == 0u) {
+        m.sensor = EKF_SENSOR_GPS_POS_VEL;
+        m.value = bench_gps_pos[n];
+        m.vel = bench_gps_vel[n];
+        filter_engine_update(&bench_engine, &m);
+    }
+}
+
+static const Benchmark bench_table[] = {
+    {"mat_multiply_16x16",          200,    NULL,                   bench_matrix_multiply},
+    {"mat_add_scaled_16x16",        2000,   NULL,                   bench_matrix_add_scaled},
+    {"mat_copy_16x16",              2000,   NULL,                   bench_matrix_copy},
+    {"quaternion_rotate_vector",    2000,   NULL,                   bench_quaternion_rotate_vector},
+    {"rotation_batch_32",           500,    NULL,                   bench_rotation_batch},
+    {"rotation_batch_interp_32",    500,    NULL,                   bench_rotation_batch_interp},
+    {"ekf_predict_cov",             1000,   bench_ekf_setup,        bench_ekf_predict},
+    {"ekf_predict_ud",              1000,   bench_ekf_setup_ud,     bench_ekf_predict},
+    {"ekf_update_gps_seq",          1000,   bench_ekf_setup,        bench_ekf_update_gps_vel},
+    {"ekf_update_gps_batch",        1000,   bench_ekf_setup_batch,  bench_ekf_update_gps_vel},
+    {"ekf_update_baro",             1000,   bench_ekf_setup,        bench_ekf_update_baro},
+    {"ekf_update_mag",              1000,   bench_ekf_setup,        bench_ekf_update_mag},
+    {"ekf_cycle_100hz",             1000,   bench_ekf_setup,        bench_ekf_cycle},
+    {"engine_ekf_seq_cycle",        1000,   bench_engine_setup_ekf,       bench_engine_cycle},
+    {"engine_ekf_batch_cycle",      1000,   bench_engine_setup_ekf_batch, bench_engine_cycle},
+    {"engine_ekf_ud_cycle",         1000,   bench_engine_setup_ekf_ud,    bench_engine_cycle},
+    {"engine_eskf_cycle",           1000,   bench_engine_setup_eskf,      bench_engine_cycle},
+};
+
+/**
+ * @brief 벤치마크 1개 실행 후 결과 출력
+ *
+ * @param b 벤치마크
+ * @param write 출력 콜백
+ */
+static void bench_execute(const Benchmark *b, ProfileWriteFn write) {
+    uint32_t iterations = b->iterations * BENCH_ITERATION_SCALE;
+    uint32_t min_cycles = UINT32_MAX;
+    uint32_t max_cycles = 0;
+    uint64_t total_cycles = 0;
+    uint64_t total_squares = 0;
+    MemStackWindow window;
+    bool window_open = false;
+    uint32_t stack_max = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if ((i % BENCH_BLOCK_SIZE) == 0u) {
+            // 설정 함수의 스택은 제외하고 블록마다 다시 칠함
+            if (window_open) {
+                uint32_t used = memstat_window_used(&window);
+                stack_max = (used > stack_max) ? used : stack_max;
+            }
+            if (b->setup != NULL) {
+                b->setup();
+            }
+            window_open = memstat_window_begin(&window, BENCH_STACK_WINDOW);
+        }
+
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t start = DWT->CYCCNT;
+        b->run(i);
+        uint32_t cycles = DWT->CYCCNT - start;
+        __set_PRIMASK(primask);
+
+        cycles = (cycles > bench_overhead) ? cycles - bench_overhead : 0u;
+        total_cycles += cycles;
+        total_squares += (uint64_t)cycles * cycles;
+        if (cycles < min_cycles) {
+            min_cycles = cycles;
+        }
+        if (cycles > max_cycles) {
+            max_cycles = cycles;
+        }
+    }
+
+    if (window_open) {
+        uint32_t used = memstat_window_used(&window);
+        stack_max = (used > stack_max) ? used : stack_max;
+    }
+
+    char line[112];
+    uint32_t mean = iterations ? (uint32_t)(total_cycles / iterations) : 0u;
+    float stddev = 0.0f;
+    if (iterations > 1u) {
+        double m = (double)total_cycles / iterations;
+        double var = ((double)total_squares - m * (double)total_cycles) / (iterations - 1u);
+        stddev = (var > 0.0) ? sqrtf((float)var) : 0.0f;
+    }
+    snprintf(line, sizeof(line), "BENCH,%s,%lu,%lu,%lu,%lu,%lu,%lu\r\n", b->name, (unsigned long)iterations,
+             (unsigned long)(iterations ? min_cycles : 0u), (unsigned long)max_cycles, (unsigned long)mean,
+             (unsigned long)(stddev + 0.5f), (unsigned long)stack_max);
+    write(line);
+}
+
+/**
+ * @brief 표준 재생(ekf/ekf_golden.h) 지문과 마지막 상태 출력
+ *
+ * 마지막 상태와 공분산 대각은 float 비트 패턴(16진수)으로 찍어 호스트가 그대로 복원한다.
+ *
+ * @param write 출력 콜백
+ */
+static void bench_golden(ProfileWriteFn write) {
+    static EKF_GoldenResult result;
+    char line[320];
+
+    if (!ekf_golden_run(&bench_ekf, &bench_history, &result)) {
+        write("BENCH,golden,failed\r\n");
+        return;
+    }
+
+    int n = snprintf(line, sizeof(line), "BENCH,golden,%s,%08lx,%lu,%lu", FP_MODE_NAME,
+                     (unsigned long)result.digest, (unsigned long)result.calls, (unsigned long)result.rejected);
+    for (uint32_t i = 0; i < EKF_GOLDEN_SEGMENTS; i++) {
+        n += snprintf(&line[n], sizeof(line) - (size_t)n, ",%08lx", (unsigned long)result.segment[i]);
+    }
+    snprintf(&line[n], sizeof(line) - (size_t)n, "\r\n");
+    write(line);
+
+    const float *rows[2] = { result.x, result.p_diag };
+    const char *names[2] = { "golden_x", "golden_p" };
+    for (uint32_t r = 0; r < 2u; r++) {
+        n = snprintf(line, sizeof(line), "BENCH,%s", names[r]);
+        for (uint32_t i = 0; i < EKF_STATE_DIM; i++) {
+            uint32_t bits;
+            memcpy(&bits, &rows[r][i], sizeof(bits));
+            n += snprintf(&line[n], sizeof(line) - (size_t)n, ",%08lx", (unsigned long)bits);
+        }
+        snprintf(&line[n], sizeof(line) - (size_t)n, "\r\n");
+        write(line);
+    }
+}
+
+/**
+ * @brief 컴파일러와 빌드 플래그 출력 (비교 도구가 같은 빌드 조건끼리 비교)
+ *
+ * @param write 출력 콜백
+ */
+static void bench_write_build(ProfileWriteFn write) {
+    char line[256];
+    snprintf(line, sizeof(line), "BENCH,build,%s,%s,%s\r\n", __VERSION__, FP_MODE_NAME, BENCH_BUILD_FLAGS);
+    write(line);
+}
+
+/**
+ * @brief 비행 설정과 같은 플래시 가속 설정 적용
+ */
+bool bench_prepare(void) {
+    bench_ready = false;
+
+    // 캐시는 꺼진 상태에서만 비울 수 있음
+    __HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+    __HAL_FLASH_DATA_CACHE_DISABLE();
+    __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+    __HAL_FLASH_DATA_CACHE_RESET();
+#if (INSTRUCTION_CACHE_ENABLE != 0U)
+    __HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+#endif
+#if (DATA_CACHE_ENABLE != 0U)
+    __HAL_FLASH_DATA_CACHE_ENABLE();
+#endif
+#if (PREFETCH_ENABLE != 0U)
+    __HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+#else
+    __HAL_FLASH_PREFETCH_BUFFER_DISABLE();
+#endif
+
+    // 대기 상태가 HCLK에 비해 부족하면 측정값이 비행과 다름 (또는 동작 불안정)
+    uint32_t hclk = HAL_RCC_GetHCLKFreq();
+    uint32_t required = (hclk > 0u) ? (hclk - 1u) / BENCH_FLASH_HZ_PER_WS : 0u;
+    if (__HAL_FLASH_GET_LATENCY() < required) {
+        return false;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // 빈 측정의 최소 사이클을 오버헤드로 사용
+    bench_overhead = UINT32_MAX;
+    for (uint8_t i = 0; i < 16; i++) {
+        uint32_t start = DWT->CYCCNT;
+        uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < bench_overhead) {
+            bench_overhead = cycles;
+        }
+    }
+
+    bench_ready = true;
+    return true;
+}
+
+/**
+ * @brief 전체 벤치마크 실행 후 결과를 한 줄씩 출력
+ */
+bool bench_run(ProfileWriteFn write) {
+    if (write == NULL || (!bench_ready && !bench_prepare())) {
+        return false;
+    }
+
+    bench_generate_inputs();
+
+    char line[128];
+    uint32_t acr = FLASH->ACR;
+    snprintf(line, sizeof(line), "BENCH,begin,%s,%lu,%lu,%u,%u,%u,%lu,%lu\r\n", BENCH_BUILD_ID,
+             (unsigned long)HAL_RCC_GetHCLKFreq(), (unsigned long)(acr & FLASH_ACR_LATENCY),
+             (acr & FLASH_ACR_ICEN) ? 1u : 0u, (acr & FLASH_ACR_DCEN) ? 1u : 0u,
+             (acr & FLASH_ACR_PRFTEN) ? 1u : 0u, (unsigned long)bench_overhead,
+             (unsigned long)mem_section_ramfunc_size());
+    write(line);
+    bench_write_build(write);
+
+    const size_t count = sizeof(bench_table) / sizeof(bench_table[0]);
+    for (size_t i = 0; i < count; i++) {
+        bench_execute(&bench_table[i], write);
+    }
+    bench_golden(write);
+
+    snprintf(line, sizeof(line), "BENCH,end,%u\r\n", (unsigned)count);
+    write(line);
+
+    return true;
+}
+
+#endif /* BENCH_ENABLE */
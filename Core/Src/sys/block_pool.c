@@ -0,0 +1,205 @@
+/**
+ * @file block_pool.c
+ * @brief 고정 크기 블록 메모리 풀 구현
+ */
+
+#include "sys/block_pool.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 자유 목록 끝 표시
+ */
+#define BLOCK_POOL_NIL 0xFFFFu
+
+/**
+ * @brief 블록 번호 -> 블록 주소
+ */
+static inline uint8_t *block_pool_block(const BlockPoolClass *c, uint32_t index) {
+    return c->base + index * c->block_size;
+}
+
+/**
+ * @brief 빈 블록에 적힌 다음 블록 번호
+ */
+static inline uint32_t block_pool_next(const BlockPoolClass *c, uint32_t index) {
+    uint32_t next;
+    memcpy(&next, block_pool_block(c, index), sizeof(next));
+
+    return next;
+}
+
+/**
+ * @brief 풀 초기화
+ */
+bool block_pool_init(BlockPool *pool) {
+    if (pool == NULL) {
+        return false;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+
+    return true;
+}
+
+/**
+ * @brief 크기 등급 등록
+ */
+bool block_pool_add_class(BlockPool *pool, void *storage, uint32_t block_size, uint32_t count) {
+    if (pool == NULL || storage == NULL || pool->class_count >= BLOCK_POOL_MAX_CLASSES ||
+        ((uintptr_t)storage % BLOCK_POOL_ALIGN) != 0 || block_size == 0 ||
+        count == 0 || count > BLOCK_POOL_MAX_BLOCKS) {
+        return false;
+    }
+
+    block_size = BLOCK_POOL_BLOCK_SIZE(block_size);
+    if (pool->class_count > 0 && block_size <= pool->cls[pool->class_count - 1].block_size) {
+        // 오름차순이어야 가장 작은 맞는 등급을 앞에서부터 찾을 수 있음
+        return false;
+    }
+
+    BlockPoolClass *c = &pool->cls[pool->class_count];
+    c->base = (uint8_t *)storage;
+    c->block_size = block_size;
+    c->count = (uint16_t)count;
+
+    // 모든 블록을 번호 순으로 자유 목록에 연결
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t next = (i + 1 < count) ? i + 1 : BLOCK_POOL_NIL;
+        memcpy(block_pool_block(c, i), &next, sizeof(next));
+    }
+    atomic_init(&c->head, 0u);
+    atomic_init(&c->in_use, 0u);
+    atomic_init(&c->high_water, 0u);
+    atomic_init(&c->allocs, 0u);
+    atomic_init(&c->failures, 0u);
+    atomic_init(&c->fallbacks, 0u);
+    pool->class_count++;
+
+    return true;
+}
+
+/**
+ * @brief 등급 자유 목록에서 블록 하나 꺼내기
+ *
+ * @param c 등급
+ * @return void* 블록 (비었으면 NULL)
+ */
+static void *block_pool_pop(BlockPoolClass *c) {
+    uint_fast32_t head = atomic_load_explicit(&c->head, memory_order_acquire);
+
+    for (;;) {
+        uint32_t index = (uint32_t)head & 0xFFFFu;
+        if (index == BLOCK_POOL_NIL) {
+            return NULL;
+        }
+
+        // 그 사이 다른 문맥이 꺼내 썼다면 next는 쓰레기지만 태그가 바뀌어 교환이 실패함
+        uint32_t next = block_pool_next(c, index) & 0xFFFFu;
+        uint_fast32_t tag = ((uint32_t)head >> 16) + 1u;
+        uint_fast32_t desired = ((tag & 0xFFFFu) << 16) | next;
+        if (atomic_compare_exchange_weak_explicit(&c->head, &head, desired,
+                                                  memory_order_acquire, memory_order_acquire)) {
+            uint_fast32_t used = atomic_fetch_add_explicit(&c->in_use, 1, memory_order_relaxed) + 1;
+            uint_fast32_t high = atomic_load_explicit(&c->high_water, memory_order_relaxed);
+            while (used > high &&
+                   !atomic_compare_exchange_weak_explicit(&c->high_water, &high, used,
+                                                          memory_order_relaxed, memory_order_relaxed)) {
+            }
+            atomic_fetch_add_explicit(&c->allocs, 1, memory_order_relaxed);
+            return block_pool_block(c, index);
+        }
+    }
+}
+
+/**
+ * @brief 블록 할당
+ */
+void *block_pool_alloc(BlockPool *pool, uint32_t size) {
+    if (pool == NULL || size == 0) {
+        return NULL;
+    }
+
+    BlockPoolClass *first = NULL;
+    for (uint8_t i = 0; i < pool->class_count; i++) {
+        BlockPoolClass *c = &pool->cls[i];
+        if (c->block_size < size) {
+            continue;
+        }
+        if (first == NULL) {
+            first = c;
+        }
+
+        void *block = block_pool_pop(c);
+        if (block != NULL) {
+            if (c != first) {
+                atomic_fetch_add_explicit(&first->fallbacks, 1, memory_order_relaxed);
+            }
+            return block;
+        }
+    }
+
+    if (first != NULL) {
+        atomic_fetch_add_explicit(&first->failures, 1, memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 블록 해제
+ */
+bool block_pool_free(BlockPool *pool, void *block) {
+    if (pool == NULL || block == NULL) {
+        return false;
+    }
+
+    uint8_t *p = (uint8_t *)block;
+    for (uint8_t i = 0; i < pool->class_count; i++) {
+        BlockPoolClass *c = &pool->cls[i];
+        if (p < c->base || p >= c->base + (uint32_t)c->count * c->block_size) {
+            continue;
+        }
+
+        uint32_t offset = (uint32_t)(p - c->base);
+        if ((offset % c->block_size) != 0) {
+            return false;
+        }
+        uint32_t index = offset / c->block_size;
+
+        uint_fast32_t head = atomic_load_explicit(&c->head, memory_order_relaxed);
+        uint_fast32_t desired;
+        do {
+            uint32_t next = (uint32_t)head & 0xFFFFu;
+            memcpy(p, &next, sizeof(next));
+            uint_fast32_t tag = ((uint32_t)head >> 16) + 1u;
+            desired = ((tag & 0xFFFFu) << 16) | index;
+        } while (!atomic_compare_exchange_weak_explicit(&c->head, &head, desired,
+                                                        memory_order_release, memory_order_relaxed));
+        atomic_fetch_sub_explicit(&c->in_use, 1, memory_order_relaxed);
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 등급별 통계 스냅숏
+ */
+bool block_pool_get_stats(const BlockPool *pool, uint8_t index, BlockPoolClassStats *stats) {
+    if (pool == NULL || stats == NULL || index >= pool->class_count) {
+        return false;
+    }
+
+    const BlockPoolClass *c = &pool->cls[index];
+    stats->block_size = c->block_size;
+    stats->count = c->count;
+    stats->in_use = (uint32_t)atomic_load_explicit(&c->in_use, memory_order_relaxed);
+    stats->high_water = (uint32_t)atomic_load_explicit(&c->high_water, memory_order_relaxed);
+    stats->allocs = (uint32_t)atomic_load_explicit(&c->allocs, memory_order_relaxed);
+    stats->failures = (uint32_t)atomic_load_explicit(&c->failures, memory_order_relaxed);
+    stats->fallbacks = (uint32_t)atomic_load_explicit(&c->fallbacks, memory_order_relaxed);
+
+    return true;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file boot_stages.c
+ * @brief 단계별 부팅 구현
+ */
+
+#include "sys/boot_stages.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 초기화
+ */
+bool boot_stages_init(BootStages *bs, const BootStage *stages, uint8_t count, BootClockFn clock) {
+    if (bs == NULL || stages == NULL || count == 0 || count > BOOT_STAGES_MAX || clock == NULL) {
+        return false;
+    }
+
+    uint8_t core_count = 0;
+    while (core_count < count && stages[core_count].ctx == BOOT_CTX_CORE) {
+        core_count++;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (stages[i].fn == NULL || (i >= core_count && stages[i].ctx == BOOT_CTX_CORE) ||
+            stages[i].ctx > BOOT_CTX_FUSION) {
+            return false;
+        }
+    }
+
+    memset(bs, 0, sizeof(*bs));
+    bs->stages = stages;
+    bs->count = count;
+    bs->core_count = core_count;
+    bs->clock = clock;
+    atomic_init(&bs->next, 0u);
+    bs->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 단계 하나 실행과 결과 기록
+ */
+static bool boot_stages_run_one(BootStages *bs, uint8_t index) {
+    const BootStage *stage = &bs->stages[index];
+    BootStageResult *result = &bs->stats.result[index];
+
+    result->start_us = bs->clock();
+    result->ok = stage->fn(stage->context);
+    result->duration_us = bs->clock() - result->start_us;
+    result->done = true;
+
+    return result->ok;
+}
+
+/**
+ * @brief 핵심 단계 실행
+ */
+bool boot_stages_run_core(BootStages *bs) {
+    if (bs == NULL || !bs->initialized || bs->core_done) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < bs->core_count; i++) {
+        if (!boot_stages_run_one(bs, i)) {
+            return false;
+        }
+    }
+
+    bs->core_done = true;
+    bs->stats.core_done_us = bs->clock();
+    atomic_store(&bs->next, bs->core_count);
+    if (bs->core_count == bs->count) {
+        bs->stats.all_done_us = bs->stats.core_done_us;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 차례가 된 나중 단계가 ctx 문맥이면 실행
+ *
+ * 차례가 된 단계의 문맥 하나만 next를 올리므로 두 문맥이 같은 단계를 돌리지 않는다.
+ */
+static bool boot_stages_service(BootStages *bs, BootContext ctx) {
+    if (bs == NULL || !bs->initialized || !bs->core_done) {
+        return false;
+    }
+
+    unsigned next = atomic_load(&bs->next);
+    if (next >= bs->count || bs->stages[next].ctx != ctx) {
+        return false;
+    }
+
+    if (!boot_stages_run_one(bs, (uint8_t)next)) {
+        bs->stats.failed++;
+    }
+    if (next + 1u == bs->count) {
+        bs->stats.all_done_us = bs->clock();
+    }
+    atomic_store(&bs->next, next + 1u);
+
+    return true;
+}
+
+/**
+ * @brief 나중 단계 실행 (가장 낮은 우선순위 문맥)
+ */
+bool boot_stages_service_idle(BootStages *bs) {
+    return boot_stages_service(bs, BOOT_CTX_IDLE);
+}
+
+/**
+ * @brief 나중 단계 실행 (융합 사이클 뒤 콜백)
+ */
+bool boot_stages_service_fusion(BootStages *bs) {
+    return boot_stages_service(bs, BOOT_CTX_FUSION);
+}
+
+/**
+ * @brief 예측 알림
+ */
+void boot_stages_mark_predict(BootStages *bs) {
+    if (bs == NULL || !bs->initialized || bs->predicted) {
+        return;
+    }
+
+    bs->stats.first_predict_us = bs->clock();
+    bs->predicted = true;
+}
+
+/**
+ * @brief 모든 단계를 마쳤는지
+ */
+bool boot_stages_done(const BootStages *bs) {
+    if (bs == NULL || !bs->initialized || !bs->core_done) {
+        return false;
+    }
+
+    return atomic_load(&bs->next) >= bs->count;
+}
+
+/**
+ * @brief 통계
+ */
+const BootStagesStats *boot_stages_get_stats(const BootStages *bs) {
+    if (bs == NULL) {
+        return NULL;
+    }
+
+    return &bs->stats;
+}
@@ -0,0 +1,359 @@
+/**
+ * @file boot_tune.c
+ * @brief 부팅 시 필터 커널 자체 측정과 주기 자동 선택 구현
+ */
+
+#include "sys/boot_tune.h"
+#include "stm32l4xx_hal.h"
+#include "ekf/ekf_preintegration.h"
+#include "math/quaternion.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 측정 문맥 (커널이 공유하는 측정용 인스턴스)
+ */
+typedef struct {
+    EKF *ekf;                  /**< 측정용 필터 */
+    ImuDecimator *dec;         /**< 측정용 데시메이터 */
+    ImuDecimatorConfig dec_config; /**< 측정 중인 데시메이터 설정 */
+    EKF_Preintegrator preint;  /**< 측정용 사전 적분기 */
+    uint32_t input_period_us;  /**< 데시메이터 입력 주기 (us) */
+    float dt;                  /**< IMU 적분 간격 (초) */
+} BootTuneContext;
+
+/**
+ * @brief 커널 준비 (측정 시간에서 제외)
+ */
+typedef void (*BootTuneSetupFn)(BootTuneContext *ctx);
+
+/**
+ * @brief 커널 호출 하나
+ */
+typedef void (*BootTuneRunFn)(BootTuneContext *ctx, uint32_t i);
+
+/**
+ * @brief 합성 IMU 샘플 (호출 번호로 조금씩 바뀜)
+ */
+static Vector3f boot_tune_gyro(uint32_t i) {
+    return vector3f_create(0.01f * (float)(i % 7u), -0.02f, 0.005f * (float)(i % 5u));
+}
+
+static Vector3f boot_tune_accel(uint32_t i) {
+    return vector3f_create(0.1f, -0.05f * (float)(i % 3u), 9.80665f);
+}
+
+static void boot_tune_setup_ekf(BootTuneContext *ctx) {
+    ekf_init(ctx->ekf);
+    ekf_set_initial_state(ctx->ekf, vector3f_zero(), vector3f_zero(), quaternion_identity());
+    ekf_set_process_noise(ctx->ekf, 0.01f, 0.1f, 0.01f, 0.001f, 0.01f);
+}
+
+static void boot_tune_setup_preint(BootTuneContext *ctx) {
+    ekf_preint_init(&ctx->preint);
+}
+
+/**
+ * @brief 데시메이터 준비 (이력을 채워 매 출력이 합성곱을 포함하게 함)
+ */
+static void boot_tune_setup_decimator(BootTuneContext *ctx) {
+    imu_decimator_init(ctx->dec, &ctx->dec_config);
+    imu_decimator_reset(ctx->dec, ctx->input_period_us);
+
+    ImuSample in;
+    ImuSample out;
+    for (uint32_t n = 0; n < ctx->dec_config.taps; n++) {
+        in.timestamp_us = n * ctx->input_period_us;
+        in.gyro = boot_tune_gyro(n);
+        in.accel = boot_tune_accel(n);
+        imu_decimator_push(ctx->dec, &in, &out);
+    }
+}
+
+static void boot_tune_run_preint(BootTuneContext *ctx, uint32_t i) {
+    ekf_preint_add(&ctx->preint, boot_tune_gyro(i), boot_tune_accel(i), ctx->dt);
+}
+
+static void boot_tune_run_predict(BootTuneContext *ctx, uint32_t i) {
+    ekf_predict(ctx->ekf, boot_tune_gyro(i), boot_tune_accel(i), ctx->dt);
+}
+
+static void boot_tune_run_gps(BootTuneContext *ctx, uint32_t i) {
+    ekf_update_gps(ctx->ekf, vector3f_create(0.5f * (float)(i % 3u), -0.2f, 0.1f), true,
+                   vector3f_create(0.05f, 0.02f * (float)(i % 4u), -0.01f));
+}
+
+static void boot_tune_run_baro(BootTuneContext *ctx, uint32_t i) {
+    ekf_update_baro(ctx->ekf, 0.1f * (float)(i % 4u));
+}
+
+static void boot_tune_run_mag(BootTuneContext *ctx, uint32_t i) {
+    ekf_update_mag(ctx->ekf, vector3f_create(0.29f, -0.05f + 0.01f * (float)(i % 3u), 0.42f));
+}
+
+/**
+ * @brief 출력 하나 나올 때까지 factor개 입력
+ */
+static void boot_tune_run_decimator(BootTuneContext *ctx, uint32_t i) {
+    ImuSample in;
+    ImuSample out;
+    for (uint8_t n = 0; n < ctx->dec_config.factor; n++) {
+        in.timestamp_us = (i * ctx->dec_config.factor + n) * ctx->input_period_us;
+        in.gyro = boot_tune_gyro(i + n);
+        in.accel = boot_tune_accel(i + n);
+        imu_decimator_push(ctx->dec, &in, &out);
+    }
+}
+
+/**
+ * @brief 커널 하나를 budget_cycles 동안 돌린 호출당 평균 사이클
+ */
+static uint32_t boot_tune_measure(BootTuneContext *ctx, BootTuneSetupFn setup, BootTuneRunFn run,
+                                  uint32_t budget_cycles) {
+    uint64_t total = 0;
+    uint32_t calls = 0;
+
+    while (total < budget_cycles || calls == 0) {
+        if ((calls % BOOT_TUNE_BLOCK_SIZE) == 0u) {
+            // 상태가 발산하거나 누적 횟수가 넘치지 않게 블록마다 다시 시작
+            setup(ctx);
+        }
+        uint32_t start = DWT->CYCCNT;
+        run(ctx, calls);
+        total += DWT->CYCCNT - start;
+        calls++;
+    }
+
+    return (uint32_t)(total / calls);
+}
+
+/**
+ * @brief 한 IMU 주기 후보의 예상 부하 (사이클/초, 예측 간격 n)
+ */
+static float boot_tune_load(const BootTune *tune, uint32_t imu_hz, uint16_t n) {
+    const BootTuneConfig *cfg = &tune->config;
+    const BootTuneResult *r = &tune->result;
+
+    float cycles = (float)cfg->gps_hz * (float)r->gps_cycles + (float)cfg->baro_hz * (float)r->baro_cycles +
+                   (float)cfg->mag_hz * (float)r->mag_cycles;
+    cycles += (float)imu_hz * ((float)r->decimate_cycles + (float)r->preint_cycles);
+    cycles += (float)imu_hz / (float)n * (float)r->predict_cycles;
+
+    return cycles * cfg->margin;
+}
+
+/**
+ * @brief 한 IMU 주기 후보에서 예산에 맞는 가장 짧은 예측 간격 (맞지 않으면 0)
+ */
+static uint16_t boot_tune_samples(const BootTune *tune, uint32_t imu_hz, uint16_t max_samples, float budget) {
+    for (uint16_t n = 1; n <= max_samples; n++) {
+        if (boot_tune_load(tune, imu_hz, n) <= budget) {
+            return n;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool boot_tune_default_config(BootTuneConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->cpu_budget = BOOT_TUNE_DEFAULT_CPU_BUDGET;
+    config->margin = BOOT_TUNE_DEFAULT_MARGIN;
+    config->odr_hz = BOOT_TUNE_DEFAULT_ODR_HZ;
+    config->max_imu_hz = BOOT_TUNE_DEFAULT_MAX_IMU_HZ;
+    config->min_imu_hz = BOOT_TUNE_DEFAULT_MIN_IMU_HZ;
+    config->min_cov_hz = BOOT_TUNE_DEFAULT_MIN_COV_HZ;
+    config->gps_hz = BOOT_TUNE_DEFAULT_GPS_HZ;
+    config->baro_hz = BOOT_TUNE_DEFAULT_BARO_HZ;
+    config->mag_hz = BOOT_TUNE_DEFAULT_MAG_HZ;
+    config->measure_ms = BOOT_TUNE_DEFAULT_MEASURE_MS;
+
+    return imu_decimator_default_config(&config->decimator);
+}
+
+/**
+ * @brief 초기화
+ */
+bool boot_tune_init(BootTune *tune, const BootTuneConfig *config) {
+    if (tune == NULL) {
+        return false;
+    }
+
+    BootTuneConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        boot_tune_default_config(&cfg);
+    }
+    if (!(cfg.cpu_budget > 0.0f && cfg.cpu_budget <= 1.0f) || !(cfg.margin >= 1.0f) || cfg.odr_hz == 0 ||
+        cfg.min_imu_hz == 0 || cfg.min_imu_hz > cfg.max_imu_hz || cfg.min_cov_hz == 0 ||
+        cfg.min_cov_hz > cfg.min_imu_hz || cfg.measure_ms == 0) {
+        return false;
+    }
+
+    memset(tune, 0, sizeof(BootTune));
+    tune->config = cfg;
+    tune->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 커널 측정과 주기 선택
+ */
+bool boot_tune_run(BootTune *tune, EKF *ekf, ImuDecimator *dec) {
+    if (tune == NULL || !tune->initialized || ekf == NULL || dec == NULL) {
+        return false;
+    }
+
+    const BootTuneConfig *cfg = &tune->config;
+    BootTuneResult *r = &tune->result;
+    memset(r, 0, sizeof(BootTuneResult));
+    tune->done = false;
+
+    // 첫 후보 (가장 높은 IMU 주기)와 마지막 후보
+    uint32_t first = (cfg->odr_hz + cfg->max_imu_hz - 1u) / cfg->max_imu_hz;
+    uint32_t last = cfg->odr_hz / cfg->min_imu_hz;
+    first = (first < 1u) ? 1u : first;
+    last = (last > IMU_DECIMATOR_MAX_FACTOR) ? IMU_DECIMATOR_MAX_FACTOR : last;
+    if (first > last) {
+        return false;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    uint32_t t0 = HAL_GetTick();
+
+    r->hclk_hz = HAL_RCC_GetHCLKFreq();
+    uint32_t per_ms = r->hclk_hz / 1000u;
+    uint32_t kernel_cycles = per_ms * cfg->measure_ms;
+    // 데시메이션은 후보마다 재므로 짧게
+    uint32_t decimate_budget = kernel_cycles / 4u;
+
+    BootTuneContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.ekf = ekf;
+    ctx.dec = dec;
+    ctx.input_period_us = 1000000u / cfg->odr_hz;
+    ctx.dt = (float)first / (float)cfg->odr_hz;
+
+    r->preint_cycles = boot_tune_measure(&ctx, boot_tune_setup_preint, boot_tune_run_preint, kernel_cycles);
+    r->predict_cycles = boot_tune_measure(&ctx, boot_tune_setup_ekf, boot_tune_run_predict, kernel_cycles);
+    r->gps_cycles = boot_tune_measure(&ctx, boot_tune_setup_ekf, boot_tune_run_gps, kernel_cycles);
+    r->baro_cycles = boot_tune_measure(&ctx, boot_tune_setup_ekf, boot_tune_run_baro, kernel_cycles);
+    r->mag_cycles = boot_tune_measure(&ctx, boot_tune_setup_ekf, boot_tune_run_mag, kernel_cycles);
+
+    float budget = cfg->cpu_budget * (float)r->hclk_hz;
+    for (uint32_t factor = first; factor <= last; factor++) {
+        uint32_t imu_hz = cfg->odr_hz / factor;
+        uint32_t max_samples = imu_hz / cfg->min_cov_hz;
+        max_samples = (max_samples < 1u) ? 1u : (max_samples > UINT16_MAX) ? UINT16_MAX : max_samples;
+
+        ctx.dec_config = cfg->decimator;
+        ctx.dec_config.factor = (uint8_t)factor;
+        if (ctx.dec_config.taps < factor) {
+            ctx.dec_config.taps = (uint8_t)factor;
+        }
+        r->decimate_cycles = boot_tune_measure(&ctx, boot_tune_setup_decimator, boot_tune_run_decimator,
+                                               decimate_budget);
+
+        uint16_t n = boot_tune_samples(tune, imu_hz, (uint16_t)max_samples, budget);
+        r->factor = (uint8_t)factor;
+        r->imu_hz = imu_hz;
+        r->max_samples = (uint16_t)max_samples;
+        if (n > 0) {
+            r->predict_samples = n;
+            r->fits = true;
+            break;
+        }
+
+        // 맞지 않으면 다음 후보, 마지막 후보면 가장 긴 간격으로 남김
+        r->predict_samples = (uint16_t)max_samples;
+    }
+
+    r->cov_hz = (float)r->imu_hz / (float)r->predict_samples;
+    r->load = boot_tune_load(tune, r->imu_hz, r->predict_samples) / (float)r->hclk_hz;
+    r->elapsed_ms = HAL_GetTick() - t0;
+    tune->done = true;
+
+    return true;
+}
+
+/**
+ * @brief 선택한 데시메이션 비율 반영
+ */
+bool boot_tune_apply_decimator(const BootTune *tune, ImuDecimatorConfig *config) {
+    if (tune == NULL || !tune->done || config == NULL) {
+        return false;
+    }
+
+    config->factor = tune->result.factor;
+    if (config->taps < config->factor) {
+        config->taps = config->factor;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 선택한 예측 간격 반영
+ */
+bool boot_tune_apply_predict_rate(const BootTune *tune, PredictRateConfig *config) {
+    if (tune == NULL || !tune->done || config == NULL) {
+        return false;
+    }
+
+    const BootTuneResult *r = &tune->result;
+    config->min_samples = r->predict_samples;
+    config->max_samples = (r->max_samples > r->predict_samples) ? r->max_samples : r->predict_samples;
+    // 기본 설정과 같이 최대 간격의 두 배 (샘플 누락 여유)
+    config->max_dt = 2.0f * (float)config->max_samples / (float)r->imu_hz;
+
+    return true;
+}
+
+/**
+ * @brief 측정 비용을 스케줄러의 비용 추정 초기값으로 반영
+ */
+bool boot_tune_apply_scheduler(const BootTune *tune, FusionScheduler *sched) {
+    if (tune == NULL || !tune->done || sched == NULL) {
+        return false;
+    }
+
+    const BootTuneResult *r = &tune->result;
+    float us_per_cycle = tune->config.margin * 1000000.0f / (float)r->hclk_hz;
+
+    // 적응 예측 주기가 붙어 있으면 샘플당 평균 (적분 + 예측 간격으로 나눈 예측)
+    float predict = (float)r->predict_cycles;
+    if (sched->predict_rate != NULL) {
+        predict = (float)r->preint_cycles + predict / (float)r->predict_samples;
+    }
+    sched->predict_cost_us = predict * us_per_cycle;
+    sched->update[FUSION_MEAS_BARO].cost_us = (float)r->baro_cycles * us_per_cycle;
+    sched->update[FUSION_MEAS_MAG].cost_us = (float)r->mag_cycles * us_per_cycle;
+
+    // GNSS 비용에는 지연 되감기가 더해지므로 측정값이 더 클 때만 올림
+    float gps = (float)r->gps_cycles * us_per_cycle;
+    if (gps > sched->update[FUSION_MEAS_GPS].cost_us) {
+        sched->update[FUSION_MEAS_GPS].cost_us = gps;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 결과
+ */
+const BootTuneResult *boot_tune_get_result(const BootTune *tune) {
+    if (tune == NULL || !tune->done) {
+        return NULL;
+    }
+
+    return &tune->result;
+}
@@ -0,0 +1,343 @@
+/**
+ * @file cal_store.c
+ * @brief 내장 플래시 보정값 저장소 구현
+ */
+
+#include "sys/cal_store.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+_Static_assert(sizeof(CalStoreRecord) % 8u == 0u, "record must be a whole number of double words");
+
+/**
+ * @brief CRC가 덮는 길이 (crc 필드 앞까지)
+ */
+#define CAL_STORE_CRC_LEN ((uint32_t)offsetof(CalStoreRecord, crc))
+
+/**
+ * @brief 페이지당 레코드 칸 수
+ */
+#define CAL_STORE_SLOTS_PER_PAGE (FLASH_PAGE_SIZE / sizeof(CalStoreRecord))
+
+/**
+ * @brief 칸이 지워진 상태인지 (모든 워드가 0xFFFFFFFF)
+ */
+static bool cal_store_erased(uint32_t addr) {
+    const uint32_t *w = (const uint32_t *)(uintptr_t)addr;
+    for (uint32_t i = 0; i < sizeof(CalStoreRecord) / 4u; i++) {
+        if (w[i] != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 레코드 검증 (식별값, 버전, 크기, CRC)
+ */
+static bool cal_store_valid(const CalStoreRecord *r, HwCrc *crc) {
+    return r->magic == CAL_STORE_MAGIC && r->version == CAL_STORE_VERSION &&
+           r->size == sizeof(CalStoreRecord) && r->crc == hw_crc32(crc, r, CAL_STORE_CRC_LEN);
+}
+
+/**
+ * @brief 페이지 번호의 시작 주소
+ */
+static uint32_t cal_store_page_addr(const CalStore *store, uint32_t page) {
+    return store->config.base + page * FLASH_PAGE_SIZE;
+}
+
+/**
+ * @brief 주소 다음 칸 (페이지 끝이면 다음 페이지 시작, 영역 끝이면 첫 페이지)
+ */
+static uint32_t cal_store_advance(const CalStore *store, uint32_t addr) {
+    uint32_t offset = addr - store->config.base;
+    uint32_t page = offset / FLASH_PAGE_SIZE;
+    uint32_t slot = (offset % FLASH_PAGE_SIZE) / sizeof(CalStoreRecord) + 1u;
+
+    if (slot >= CAL_STORE_SLOTS_PER_PAGE) {
+        return cal_store_page_addr(store, (page + 1u) % store->config.pages);
+    }
+
+    return cal_store_page_addr(store, page) + slot * sizeof(CalStoreRecord);
+}
+
+/**
+ * @brief 페이지 지우기 (뱅크 바꿈 없음 가정)
+ */
+static bool cal_store_erase_page(uint32_t addr) {
+    uint32_t offset = addr - FLASH_BASE;
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_PAGES,
+        .Banks = (offset < FLASH_BANK_SIZE) ? FLASH_BANK_1 : FLASH_BANK_2,
+        .Page = (offset % FLASH_BANK_SIZE) / FLASH_PAGE_SIZE,
+        .NbPages = 1
+    };
+    uint32_t page_error = 0;
+
+    return HAL_FLASHEx_Erase(&erase, &page_error) == HAL_OK;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool cal_store_default_config(CalStoreConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->base = CAL_STORE_DEFAULT_BASE;
+    config->pages = CAL_STORE_DEFAULT_PAGES;
+    config->gyro_turn_on_std = CAL_STORE_DEFAULT_GYRO_TURN_ON_STD;
+    config->accel_turn_on_std = CAL_STORE_DEFAULT_ACCEL_TURN_ON_STD;
+
+    return true;
+}
+
+/**
+ * @brief 저장소 초기화
+ */
+bool cal_store_init(CalStore *store, HwCrc *crc, const CalStoreConfig *config) {
+    if (store == NULL) {
+        return false;
+    }
+
+    CalStoreConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        cal_store_default_config(&cfg);
+    }
+    if (cfg.pages < 2u || (cfg.base % FLASH_PAGE_SIZE) != 0u || cfg.base < FLASH_BASE ||
+        !(cfg.gyro_turn_on_std >= 0.0f) || !(cfg.accel_turn_on_std >= 0.0f)) {
+        return false;
+    }
+
+    memset(store, 0, sizeof(*store));
+    store->config = cfg;
+    store->crc = crc;
+
+    // 최신 레코드와 그 페이지에서 마지막으로 쓰인 칸
+    uint32_t last_used = 0;
+    for (uint32_t page = 0; page < cfg.pages; page++) {
+        uint32_t page_last = 0;
+        bool page_used = false;
+        for (uint32_t slot = 0; slot < CAL_STORE_SLOTS_PER_PAGE; slot++) {
+            uint32_t addr = cal_store_page_addr(store, page) + slot * sizeof(CalStoreRecord);
+            if (cal_store_erased(addr)) {
+                continue;
+            }
+            page_used = true;
+            page_last = addr;
+
+            const CalStoreRecord *r = (const CalStoreRecord *)(uintptr_t)addr;
+            if (!cal_store_valid(r, crc)) {
+                store->stats.corrupt++;
+                continue;
+            }
+            store->stats.records++;
+            if (store->latest == NULL || r->sequence > store->sequence) {
+                store->latest = r;
+                store->sequence = r->sequence;
+            }
+        }
+        if (page_used && store->latest != NULL &&
+            (uint32_t)(uintptr_t)store->latest >= cal_store_page_addr(store, page) &&
+            (uint32_t)(uintptr_t)store->latest < cal_store_page_addr(store, page + 1u)) {
+            last_used = page_last;
+        }
+    }
+
+    // 최신 레코드 페이지의 마지막 쓰인 칸 다음 (레코드가 없으면 첫 페이지를 지우고 시작)
+    store->next = (store->latest != NULL) ? cal_store_advance(store, last_used) : cfg.base;
+    store->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 최신 유효 레코드
+ */
+const CalStoreRecord *cal_store_latest(const CalStore *store) {
+    if (store == NULL || !store->initialized) {
+        return NULL;
+    }
+
+    return store->latest;
+}
+
+/**
+ * @brief 필터와 자력계 보정에서 레코드 채우기
+ */
+bool cal_store_capture(CalStoreRecord *record, EKF *ekf, const MagIronCal *mag_cal) {
+    if (record == NULL || ekf == NULL || !ekf->initialized || !ekf_flush_covariance(ekf)) {
+        return false;
+    }
+
+    memset(record, 0, sizeof(*record));
+    const float *x = &ekf->x.data[0][0];
+    const float *P = ekf->P.data;
+
+    record->gyro_bias = vector3f_create(x[EKF_STATE_GYRO_BIAS_X], x[EKF_STATE_GYRO_BIAS_Y], x[EKF_STATE_GYRO_BIAS_Z]);
+    record->gyro_bias_var = vector3f_create(P[EKF_SYM_FN(index)(EKF_STATE_GYRO_BIAS_X, EKF_STATE_GYRO_BIAS_X)],
+                                            P[EKF_SYM_FN(index)(EKF_STATE_GYRO_BIAS_Y, EKF_STATE_GYRO_BIAS_Y)],
+                                            P[EKF_SYM_FN(index)(EKF_STATE_GYRO_BIAS_Z, EKF_STATE_GYRO_BIAS_Z)]);
+    record->flags = CAL_STORE_HAS_GYRO_BIAS | CAL_STORE_HAS_EARTH_MAG;
+#if EKF_CONFIG_ACCEL_BIAS
+    record->accel_bias = vector3f_create(x[EKF_STATE_ACC_BIAS_X], x[EKF_STATE_ACC_BIAS_Y], x[EKF_STATE_ACC_BIAS_Z]);
+    record->accel_bias_var = vector3f_create(P[EKF_SYM_FN(index)(EKF_STATE_ACC_BIAS_X, EKF_STATE_ACC_BIAS_X)],
+                                             P[EKF_SYM_FN(index)(EKF_STATE_ACC_BIAS_Y, EKF_STATE_ACC_BIAS_Y)],
+                                             P[EKF_SYM_FN(index)(EKF_STATE_ACC_BIAS_Z, EKF_STATE_ACC_BIAS_Z)]);
+    record->flags |= CAL_STORE_HAS_ACCEL_BIAS;
+#endif
+    record->earth_mag_ned = ekf->earth_mag_ned;
+
+    if (mag_cal != NULL && mag_iron_cal_get_correction(mag_cal, &record->mag)) {
+        record->flags |= CAL_STORE_HAS_MAG_IRON;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 레코드 기록
+ */
+bool cal_store_save(CalStore *store, const CalStoreRecord *record) {
+    if (store == NULL || !store->initialized || record == NULL) {
+        return false;
+    }
+
+    CalStoreRecord r = *record;
+    r.magic = CAL_STORE_MAGIC;
+    r.version = CAL_STORE_VERSION;
+    r.size = sizeof(CalStoreRecord);
+    r.sequence = store->sequence + 1u;
+    r.crc = hw_crc32(store->crc, &r, CAL_STORE_CRC_LEN);
+
+    // 페이지 시작이 아니면서 지워지지 않은 칸(손상 칸)은 건너뜀
+    uint32_t addr = store->next;
+    while ((addr - store->config.base) % FLASH_PAGE_SIZE != 0u && !cal_store_erased(addr)) {
+        addr = cal_store_advance(store, addr);
+    }
+
+    bool ok = HAL_FLASH_Unlock() == HAL_OK;
+    if (ok) {
+        __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+
+        // 새 페이지에 들어서면 가장 오래된 기록이 있는 그 페이지를 먼저 지움
+        if ((addr - store->config.base) % FLASH_PAGE_SIZE == 0u) {
+            ok = cal_store_erase_page(addr);
+            if (ok) {
+                store->stats.erases++;
+            }
+        }
+
+        const uint8_t *src = (const uint8_t *)&r;
+        for (uint32_t k = 0; ok && k < sizeof(r); k += 8u) {
+            uint64_t dw;
+            memcpy(&dw, &src[k], sizeof(dw));
+            ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, addr + k, dw) == HAL_OK;
+        }
+        HAL_FLASH_Lock();
+    }
+
+    // 다음 칸은 성공 여부와 관계없이 넘김 (실패한 칸은 다시 쓸 수 없음)
+    store->next = cal_store_advance(store, addr);
+
+    const CalStoreRecord *written = (const CalStoreRecord *)(uintptr_t)addr;
+    if (!ok || memcmp(written, &r, sizeof(r)) != 0) {
+        store->stats.errors++;
+        return false;
+    }
+
+    store->latest = written;
+    store->sequence = r.sequence;
+    store->stats.writes++;
+
+    return true;
+}
+
+/**
+ * @brief 바이어스 블록 시드 (상태, 대각 분산, 교차 공분산 0)
+ */
+static void cal_store_seed_block(EKF *ekf, uint8_t first, Vector3f value, Vector3f var, float turn_on_std) {
+    float *x = &ekf->x.data[0][0];
+    const float v[3] = { value.x, value.y, value.z };
+    const float p[3] = { var.x, var.y, var.z };
+
+    for (uint8_t i = 0; i < 3; i++) {
+        uint8_t s = (uint8_t)(first + i);
+        x[s] = v[i];
+        for (uint8_t j = 0; j < EKF_STATE_DIM; j++) {
+            ekf->P.data[EKF_SYM_FN(index)(s, j)] = 0.0f;
+        }
+        ekf->P.data[EKF_SYM_FN(index)(s, s)] = p[i] + turn_on_std * turn_on_std;
+    }
+}
+
+/**
+ * @brief 세 성분이 모두 유한한지 (분산이면 0 이상인지도)
+ */
+static bool cal_store_vector_ok(Vector3f v, bool variance) {
+    if (!isfinite(v.x) || !isfinite(v.y) || !isfinite(v.z)) {
+        return false;
+    }
+
+    return !variance || (v.x >= 0.0f && v.y >= 0.0f && v.z >= 0.0f);
+}
+
+/**
+ * @brief 레코드로 필터 시드
+ */
+bool cal_store_apply(const CalStore *store, const CalStoreRecord *record, EKF *ekf, MagIronCal *mag_cal) {
+    if (store == NULL || record == NULL || ekf == NULL) {
+        return false;
+    }
+
+    const uint32_t flags = record->flags;
+    if (((flags & CAL_STORE_HAS_GYRO_BIAS) &&
+         (!cal_store_vector_ok(record->gyro_bias, false) || !cal_store_vector_ok(record->gyro_bias_var, true))) ||
+        ((flags & CAL_STORE_HAS_ACCEL_BIAS) &&
+         (!cal_store_vector_ok(record->accel_bias, false) || !cal_store_vector_ok(record->accel_bias_var, true))) ||
+        ((flags & CAL_STORE_HAS_EARTH_MAG) && !cal_store_vector_ok(record->earth_mag_ned, false))) {
+        return false;
+    }
+
+    if (!ekf_flush_covariance(ekf)) {
+        return false;
+    }
+
+    if (flags & CAL_STORE_HAS_GYRO_BIAS) {
+        cal_store_seed_block(ekf, EKF_STATE_GYRO_BIAS_X, record->gyro_bias, record->gyro_bias_var,
+                             store->config.gyro_turn_on_std);
+    }
+#if EKF_CONFIG_ACCEL_BIAS
+    if (flags & CAL_STORE_HAS_ACCEL_BIAS) {
+        cal_store_seed_block(ekf, EKF_STATE_ACC_BIAS_X, record->accel_bias, record->accel_bias_var,
+                             store->config.accel_turn_on_std);
+    }
+#endif
+    if (flags & CAL_STORE_HAS_EARTH_MAG) {
+        ekf->earth_mag_ned = record->earth_mag_ned;
+    }
+    if (mag_cal != NULL && (flags & CAL_STORE_HAS_MAG_IRON)) {
+        mag_iron_cal_set_correction(mag_cal, &record->mag);
+    }
+
+    // U-D 엔진이면 바뀐 P로 다시 분해
+    return ekf_set_engine(ekf, ekf->engine);
+}
+
+/**
+ * @brief 통계
+ */
+const CalStoreStats *cal_store_get_stats(const CalStore *store) {
+    if (store == NULL) {
+        return NULL;
+    }
+
+    return &store->stats;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file can_time_sync.c
+ * @brief CAN 보드 간 시각 동기 구현
+ */
+
+#include "sys/can_time_sync.h"
+#include "math/fp_mode.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 측정을 기준점으로 필터 시작
+ */
+static void can_time_sync_start(CanTimeSync *sync, uint32_t local_us, uint32_t master_us) {
+    float r = sync->config.meas_std_us * sync->config.meas_std_us;
+    sync->anchor_local_us = local_us;
+    sync->anchor_master_us = master_us;
+    sync->offset_us = 0.0f;
+    sync->drift_ppm = 0.0f;
+    sync->P[0][0] = r;
+    sync->P[0][1] = 0.0f;
+    sync->P[1][0] = 0.0f;
+    sync->P[1][1] = sync->config.drift_std_ppm * sync->config.drift_std_ppm;
+    sync->consecutive_rejects = 0;
+    sync->initialized = true;
+    sync->stats.updates++;
+}
+
+/**
+ * @brief 송신/수신 시각 쌍 반영
+ *
+ * 기준점에서 주 시각으로 t초 뒤 측정은 z = (L - L_a) - (M - M_a) (us)이고,
+ * 상태 전이는 offset += drift x t, Q = q [t^3/3 t^2/2; t^2/2 t] (q = drift_rw^2)이다.
+ * 갱신 후 기준점을 이 측정으로 옮기고 offset에서 z를 빼 작은 값으로 유지한다.
+ */
+static bool can_time_sync_process(CanTimeSync *sync, uint32_t local_us, uint32_t master_us) {
+    if (!sync->initialized) {
+        can_time_sync_start(sync, local_us, master_us);
+        return true;
+    }
+
+    int32_t dm = (int32_t)(master_us - sync->anchor_master_us);
+    if (dm <= 0 || (uint32_t)dm > sync->config.max_gap_us) {
+        can_time_sync_start(sync, local_us, master_us);
+        sync->stats.restarts++;
+        return true;
+    }
+
+    float t = (float)dm * 1.0e-6f;
+    float z = (float)((int32_t)(local_us - sync->anchor_local_us) - dm);
+
+    // 예측
+    float q = sync->config.drift_rw * sync->config.drift_rw;
+    float p00 = sync->P[0][0] + 2.0f * t * sync->P[0][1] + t * t * sync->P[1][1] + q * t * t * t / 3.0f;
+    float p01 = sync->P[0][1] + t * sync->P[1][1] + 0.5f * q * t * t;
+    float p11 = sync->P[1][1] + q * t;
+    float offset = sync->offset_us + sync->drift_ppm * t;
+
+    float y = z - offset;
+    float s = p00 + sync->config.meas_std_us * sync->config.meas_std_us;
+    sync->stats.last_residual_us = y;
+    if (y * y > sync->config.gate_sigma * sync->config.gate_sigma * s) {
+        sync->stats.rejects++;
+        if (++sync->consecutive_rejects >= CAN_TIME_SYNC_MAX_REJECTS) {
+            // 주 보드 재시작 등: 다음 측정부터 다시
+            sync->initialized = false;
+            sync->stats.restarts++;
+        }
+        return false;
+    }
+
+    // 갱신 (H = [1 0])
+    float k0 = p00 / s;
+    float k1 = p01 / s;
+    sync->offset_us = offset + k0 * y - z;
+    sync->drift_ppm += k1 * y;
+    sync->P[0][0] = p00 - k0 * p00;
+    sync->P[0][1] = p01 - k0 * p01;
+    sync->P[1][0] = sync->P[0][1];
+    sync->P[1][1] = p11 - k1 * p01;
+
+    sync->anchor_local_us = local_us;
+    sync->anchor_master_us = master_us;
+    sync->consecutive_rejects = 0;
+    sync->stats.updates++;
+
+    return true;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool can_time_sync_default_config(CanTimeSyncConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->sync_id = CAN_TIME_SYNC_DEFAULT_SYNC_ID;
+    config->meas_std_us = CAN_TIME_SYNC_DEFAULT_MEAS_STD_US;
+    config->drift_std_ppm = CAN_TIME_SYNC_DEFAULT_DRIFT_STD_PPM;
+    config->drift_rw = CAN_TIME_SYNC_DEFAULT_DRIFT_RW;
+    config->gate_sigma = CAN_TIME_SYNC_DEFAULT_GATE_SIGMA;
+    config->lock_std_us = CAN_TIME_SYNC_DEFAULT_LOCK_STD_US;
+    config->latency_us = CAN_TIME_SYNC_DEFAULT_LATENCY_US;
+    config->max_gap_us = CAN_TIME_SYNC_DEFAULT_MAX_GAP_US;
+
+    return true;
+}
+
+/**
+ * @brief 수신 노드 동기 초기화
+ */
+bool can_time_sync_init(CanTimeSync *sync, const CanTimeSyncConfig *config) {
+    if (sync == NULL) {
+        return false;
+    }
+
+    CanTimeSyncConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        can_time_sync_default_config(&cfg);
+    }
+    if ((uint32_t)cfg.sync_id + 2u > 0x800u || !(cfg.meas_std_us > 0.0f) || !(cfg.drift_std_ppm > 0.0f) ||
+        !(cfg.drift_rw >= 0.0f) || !(cfg.gate_sigma > 0.0f) || !(cfg.lock_std_us > 0.0f) ||
+        !isfinite(cfg.latency_us) || cfg.max_gap_us == 0 || cfg.max_gap_us > 0x7FFFFFFFu) {
+        return false;
+    }
+
+    memset(sync, 0, sizeof(*sync));
+    sync->config = cfg;
+
+    return true;
+}
+
+/**
+ * @brief SYNC 데이터 채우기
+ */
+uint8_t can_time_sync_pack_sync(uint8_t seq, uint8_t data[8]) {
+    if (data == NULL) {
+        return 0;
+    }
+
+    data[0] = seq;
+
+    return CAN_TIME_SYNC_SYNC_DLC;
+}
+
+/**
+ * @brief FOLLOW_UP 데이터 채우기
+ */
+uint8_t can_time_sync_pack_follow_up(uint8_t seq, uint32_t tx_us, uint8_t data[8]) {
+    if (data == NULL) {
+        return 0;
+    }
+
+    data[0] = seq;
+    data[1] = (uint8_t)tx_us;
+    data[2] = (uint8_t)(tx_us >> 8);
+    data[3] = (uint8_t)(tx_us >> 16);
+    data[4] = (uint8_t)(tx_us >> 24);
+
+    return CAN_TIME_SYNC_FOLLOW_UP_DLC;
+}
+
+/**
+ * @brief 수신 프레임 처리
+ */
+bool can_time_sync_handle_frame(CanTimeSync *sync, uint16_t id, const uint8_t *data, uint8_t dlc,
+                                uint32_t rx_us) {
+    if (sync == NULL || data == NULL) {
+        return false;
+    }
+
+    if (id == sync->config.sync_id && dlc >= CAN_TIME_SYNC_SYNC_DLC) {
+        sync->sync_seq = data[0];
+        sync->sync_rx_us = rx_us;
+        sync->has_sync = true;
+        sync->stats.syncs++;
+        return false;
+    }
+
+    if (id != (uint16_t)(sync->config.sync_id + 1u) || dlc < CAN_TIME_SYNC_FOLLOW_UP_DLC) {
+        return false;
+    }
+
+    sync->stats.follow_ups++;
+    if (!sync->has_sync || data[0] != sync->sync_seq) {
+        sync->stats.unmatched++;
+        return false;
+    }
+    sync->has_sync = false;
+
+    uint32_t tx_us = (uint32_t)data[1] | ((uint32_t)data[2] << 8) | ((uint32_t)data[3] << 16) |
+                     ((uint32_t)data[4] << 24);
+    uint32_t local_us = sync->sync_rx_us - (uint32_t)(int32_t)lroundf(sync->config.latency_us);
+
+    return can_time_sync_process(sync, local_us, tx_us);
+}
+
+/**
+ * @brief 고정 여부
+ */
+bool can_time_sync_is_locked(const CanTimeSync *sync) {
+    if (sync == NULL || !sync->initialized) {
+        return false;
+    }
+
+    float var = sync->P[0][0] + 2.0f * sync->P[0][1] + sync->P[1][1];
+    return var <= sync->config.lock_std_us * sync->config.lock_std_us;
+}
+
+/**
+ * @brief 주 시각 -> 로컬 시각
+ */
+bool can_time_sync_master_to_local(const CanTimeSync *sync, uint32_t master_us, uint32_t *local_us) {
+    if (local_us == NULL || !can_time_sync_is_locked(sync)) {
+        return false;
+    }
+
+    int32_t dm = (int32_t)(master_us - sync->anchor_master_us);
+    float corr = sync->offset_us + sync->drift_ppm * ((float)dm * 1.0e-6f);
+    *local_us = sync->anchor_local_us + (uint32_t)dm + (uint32_t)(int32_t)lroundf(corr);
+
+    return true;
+}
+
+/**
+ * @brief 로컬 시각 -> 주 시각
+ */
+bool can_time_sync_local_to_master(const CanTimeSync *sync, uint32_t local_us, uint32_t *master_us) {
+    if (master_us == NULL || !can_time_sync_is_locked(sync)) {
+        return false;
+    }
+
+    // 주파수 오차 보정은 1차 (drift^2 항은 35분에서도 1 ns 미만)
+    int32_t dl = (int32_t)(local_us - sync->anchor_local_us);
+    float corr = sync->offset_us + sync->drift_ppm * ((float)dl * 1.0e-6f);
+    *master_us = sync->anchor_master_us + (uint32_t)dl - (uint32_t)(int32_t)lroundf(corr);
+
+    return true;
+}
+
+/**
+ * @brief 통계 조회
+ */
+const CanTimeSyncStats *can_time_sync_get_stats(const CanTimeSync *sync) {
+    if (sync == NULL) {
+        return NULL;
+    }
+
+    return &sync->stats;
+}
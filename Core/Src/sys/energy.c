@@ -0,0 +1,334 @@
+/**
+ * @file energy.c
+ * @brief 전류 감지 ADC 기반 트레이스 구간별 에너지 측정 구현
+ */
+
+#include "sys/board_profile.h"
+
+#if BOARD_HAS_CURRENT_SENSE
+
+#include "sys/energy.h"
+
+#ifdef ENERGY_ENABLE
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+_Static_assert(ENERGY_RING_SIZE % 2u == 0u, "ADC ring must split into two halves");
+
+/**
+ * @brief 이벤트 이름 (TraceEvent 순서, Tools/trace/trace_decode.c와 같음)
+ */
+static const char *const energy_event_names[TRACE_EVENT_COUNT] = {
+    "imu_isr",
+    "cycle",
+    "predict",
+    "update_gps",
+    "update_baro",
+    "update_mag",
+    "update_coincident",
+    "log_service",
+    "log_flush"
+};
+
+/**
+ * @brief 이벤트별 누적
+ */
+typedef struct {
+    int64_t start_sum;         /**< 시작 시점 누적 합 */
+    uint32_t start_index;      /**< 시작 시점 표본 번호 */
+    bool open;                 /**< 구간 진행 중 */
+    bool spoiled;              /**< 진행 중 링이 덮임 */
+    uint32_t count;            /**< 끝난 구간 수 */
+    uint32_t overruns;         /**< 버린 구간 수 */
+    uint32_t samples;          /**< 구간 표본 수 합 */
+    int64_t sum;               /**< 구간 부호 합 (offset 뺀 값) */
+    int64_t max;               /**< 구간 하나의 최대 부호 합 */
+} EnergySlot;
+
+/**
+ * @brief 측정 상태
+ */
+static struct {
+    ADC_HandleTypeDef *hadc;   /**< ADC 핸들 */
+    EnergyConfig config;       /**< 설정 */
+    float uj_per_lsb;          /**< 부호 합 하나당 에너지 (uJ) */
+    uint16_t ring[ENERGY_RING_SIZE]; /**< ADC DMA 링 */
+    volatile int64_t cum_sum;  /**< cum_index 앞까지 더한 부호 합 */
+    volatile uint32_t cum_index; /**< 누적 합에 들어간 표본 수 (반쪽 링 단위) */
+    int64_t reset_sum;         /**< 초기화 시점 누적 합 */
+    uint32_t reset_index;      /**< 초기화 시점 표본 수 */
+    uint32_t overruns;         /**< 반쪽 링이 더해지기 전에 덮인 횟수 */
+    EnergySlot slot[TRACE_EVENT_COUNT]; /**< 이벤트별 누적 */
+    bool initialized;          /**< 초기화 여부 */
+} energy;
+
+/**
+ * @brief 기본 설정
+ */
+bool energy_default_config(EnergyConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->sample_hz = ENERGY_DEFAULT_SAMPLE_HZ;
+    config->ua_per_lsb = ENERGY_DEFAULT_UA_PER_LSB;
+    config->offset_code = ENERGY_DEFAULT_OFFSET_CODE;
+    config->supply_v = ENERGY_DEFAULT_SUPPLY_V;
+
+    return true;
+}
+
+/**
+ * @brief 측정 시작
+ */
+bool energy_init(ADC_HandleTypeDef *hadc, TIM_HandleTypeDef *htim, const EnergyConfig *config) {
+    if (hadc == NULL || hadc->DMA_Handle == NULL || htim == NULL) {
+        return false;
+    }
+
+    EnergyConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        energy_default_config(&cfg);
+    }
+    if (!(cfg.sample_hz > 0.0f) || !(cfg.ua_per_lsb > 0.0f) || !(cfg.supply_v > 0.0f)) {
+        return false;
+    }
+
+    energy.initialized = false;
+    memset(&energy, 0, sizeof(energy));
+    energy.hadc = hadc;
+    energy.config = cfg;
+    energy.uj_per_lsb = cfg.ua_per_lsb * cfg.supply_v / cfg.sample_hz;
+
+    if (HAL_ADCEx_Calibration_Start(hadc, ADC_SINGLE_ENDED) != HAL_OK ||
+        HAL_ADC_Start_DMA(hadc, (uint32_t *)energy.ring, ENERGY_RING_SIZE) != HAL_OK) {
+        return false;
+    }
+    if (HAL_TIM_Base_Start(htim) != HAL_OK) {
+        HAL_ADC_Stop_DMA(hadc);
+        return false;
+    }
+    energy.initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 지금 DMA가 쓰고 있는 링 위치 (0..ENERGY_RING_SIZE-1)
+ */
+static uint32_t energy_ring_pos(void) {
+    uint32_t pos = ENERGY_RING_SIZE - __HAL_DMA_GET_COUNTER(energy.hadc->DMA_Handle);
+
+    return (pos >= ENERGY_RING_SIZE) ? 0u : pos;
+}
+
+/**
+ * @brief 링 구간 부호 합
+ */
+static int64_t energy_ring_sum(uint32_t index, uint32_t n) {
+    int32_t sum = 0;
+    int32_t offset = (int32_t)energy.config.offset_code;
+
+    for (uint32_t k = 0; k < n; k++) {
+        sum += (int32_t)energy.ring[(index + k) % ENERGY_RING_SIZE] - offset;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief 지금까지의 누적 합과 표본 수 (누적 합 + 아직 더하지 않은 링 구간)
+ */
+static void energy_now(int64_t *sum, uint32_t *index) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    int64_t s = energy.cum_sum;
+    uint32_t base = energy.cum_index;
+    uint32_t pos = energy_ring_pos();
+    __set_PRIMASK(primask);
+
+    // 반 완료 인터럽트가 반쪽 링 시간 안에 처리되므로 base 뒤로 링 한 바퀴 안에 있음
+    uint32_t ahead = (pos + ENERGY_RING_SIZE - base % ENERGY_RING_SIZE) % ENERGY_RING_SIZE;
+
+    *sum = s + energy_ring_sum(base, ahead);
+    *index = base + ahead;
+}
+
+/**
+ * @brief 끝난 반쪽 링을 누적 합에 더함 (DMA 반/완료 인터럽트)
+ */
+static void energy_fold(void) {
+    uint32_t base = energy.cum_index;
+    uint32_t half = base % ENERGY_RING_SIZE;
+    int64_t part = energy_ring_sum(base, ENERGY_RING_SIZE / 2u);
+
+    // DMA가 벌써 더할 반쪽으로 돌아왔으면 일부가 덮임: 진행 중인 구간은 버림
+    uint32_t pos = energy_ring_pos();
+    if (pos >= half && pos < half + ENERGY_RING_SIZE / 2u) {
+        energy.overruns++;
+        for (uint8_t i = 0; i < TRACE_EVENT_COUNT; i++) {
+            if (energy.slot[i].open) {
+                energy.slot[i].spoiled = true;
+            }
+        }
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    energy.cum_sum += part;
+    energy.cum_index = base + ENERGY_RING_SIZE / 2u;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ADC DMA 반 완료 처리
+ */
+void energy_handle_adc_half(ADC_HandleTypeDef *hadc) {
+    if (!energy.initialized || hadc != energy.hadc) {
+        return;
+    }
+
+    energy_fold();
+}
+
+/**
+ * @brief ADC DMA 완료 처리
+ */
+void energy_handle_adc_complete(ADC_HandleTypeDef *hadc) {
+    if (!energy.initialized || hadc != energy.hadc) {
+        return;
+    }
+
+    energy_fold();
+}
+
+/**
+ * @brief 트레이스 표시
+ */
+void energy_mark(uint32_t code) {
+    uint32_t event = code >> 1;
+    if (!energy.initialized || event >= TRACE_EVENT_COUNT) {
+        return;
+    }
+
+    int64_t sum;
+    uint32_t index;
+    energy_now(&sum, &index);
+
+    EnergySlot *sl = &energy.slot[event];
+    if ((code & 1u) == 0) {
+        sl->start_sum = sum;
+        sl->start_index = index;
+        sl->spoiled = false;
+        sl->open = true;
+        return;
+    }
+    if (!sl->open) {
+        return;
+    }
+    sl->open = false;
+    if (sl->spoiled) {
+        sl->overruns++;
+        return;
+    }
+
+    int64_t d = sum - sl->start_sum;
+    sl->count++;
+    sl->samples += index - sl->start_index;
+    sl->sum += d;
+    if (d > sl->max) {
+        sl->max = d;
+    }
+}
+
+/**
+ * @brief 이벤트별 누적 초기화
+ */
+void energy_reset(void) {
+    if (!energy.initialized) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(energy.slot, 0, sizeof(energy.slot));
+    energy.reset_sum = energy.cum_sum;
+    energy.reset_index = energy.cum_index;
+    energy.overruns = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 이벤트 측정 결과
+ */
+bool energy_get(TraceEvent event, EnergyEventStats *stats) {
+    if (stats == NULL || !energy.initialized || (uint32_t)event >= TRACE_EVENT_COUNT) {
+        return false;
+    }
+
+    const EnergySlot *sl = &energy.slot[event];
+    float total_uj = (float)sl->sum * energy.uj_per_lsb;
+
+    stats->count = sl->count;
+    stats->overruns = sl->overruns;
+    stats->mean_uj = (sl->count > 0) ? total_uj / (float)sl->count : 0.0f;
+    stats->max_uj = (float)sl->max * energy.uj_per_lsb;
+    stats->mean_ma = (sl->samples > 0) ? (float)sl->sum / (float)sl->samples * energy.config.ua_per_lsb * 1e-3f
+                                       : 0.0f;
+    stats->total_mj = total_uj * 1e-3f;
+
+    return true;
+}
+
+/**
+ * @brief 전체 평균 전류
+ */
+float energy_mean_current_ma(void) {
+    if (!energy.initialized) {
+        return 0.0f;
+    }
+
+    int64_t sum;
+    uint32_t index;
+    energy_now(&sum, &index);
+    uint32_t n = index - energy.reset_index;
+    if (n == 0) {
+        return 0.0f;
+    }
+
+    return (float)(sum - energy.reset_sum) / (float)n * energy.config.ua_per_lsb * 1e-3f;
+}
+
+/**
+ * @brief 이벤트별 결과를 한 줄씩 출력
+ */
+void energy_report(EnergyWriteFn write) {
+    if (write == NULL || !energy.initialized) {
+        return;
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "ENERGY,total,%lu,%.2f\r\n", (unsigned long)energy.overruns,
+             (double)energy_mean_current_ma());
+    write(line);
+
+    for (uint8_t i = 0; i < TRACE_EVENT_COUNT; i++) {
+        EnergyEventStats st;
+        if (!energy_get((TraceEvent)i, &st) || st.count == 0) {
+            continue;
+        }
+
+        snprintf(line, sizeof(line), "ENERGY,%s,%lu,%.2f,%.2f,%.2f,%.3f\r\n", energy_event_names[i],
+                 (unsigned long)st.count, (double)st.mean_uj, (double)st.max_uj, (double)st.mean_ma,
+                 (double)st.total_mj);
+        write(line);
+    }
+}
+
+#endif /* ENERGY_ENABLE */
+
+#endif /* BOARD_HAS_CURRENT_SENSE */
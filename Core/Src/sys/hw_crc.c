@@ -0,0 +1,150 @@
+/**
+ * @file hw_crc.c
+ * @brief CRC 주변장치를 이용한 CRC-32 구현
+ */
+
+#include "sys/hw_crc.h"
+#include <stddef.h>
+
+/**
+ * @brief 4비트 단위 소프트웨어 CRC 표 (반사 다항식 0xEDB88320)
+ */
+static const uint32_t hw_crc_nibble_table[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+/**
+ * @brief DMA 완료 처리 (DMA 인터럽트)
+ */
+static void hw_crc_dma_complete(DMA_HandleTypeDef *hdma) {
+    HwCrc *crc = (HwCrc *)hdma->Parent;
+    uint32_t value = crc->hcrc->Instance->DR ^ HW_CRC_INIT;
+    HwCrcDoneFn done = crc->done;
+    void *context = crc->done_context;
+
+    atomic_flag_clear_explicit(&crc->busy, memory_order_release);
+    if (done != NULL) {
+        done(true, value, context);
+    }
+}
+
+/**
+ * @brief DMA 오류 처리 (DMA 인터럽트)
+ */
+static void hw_crc_dma_error(DMA_HandleTypeDef *hdma) {
+    HwCrc *crc = (HwCrc *)hdma->Parent;
+    HwCrcDoneFn done = crc->done;
+    void *context = crc->done_context;
+
+    atomic_flag_clear_explicit(&crc->busy, memory_order_release);
+    if (done != NULL) {
+        done(false, 0, context);
+    }
+}
+
+/**
+ * @brief CRC-32 주변장치 초기화
+ */
+bool hw_crc_init(HwCrc *crc, CRC_HandleTypeDef *hcrc, DMA_HandleTypeDef *hdma) {
+    if (crc == NULL || hcrc == NULL) {
+        return false;
+    }
+
+    crc->hcrc = hcrc;
+    crc->hdma = hdma;
+    atomic_flag_clear(&crc->busy);
+    crc->done = NULL;
+    crc->done_context = NULL;
+    crc->sw_fallbacks = 0;
+    crc->initialized = false;
+
+    hcrc->Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+    hcrc->Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+    hcrc->Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_BYTE;
+    hcrc->Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_ENABLE;
+    hcrc->InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+    if (HAL_CRC_Init(hcrc) != HAL_OK) {
+        return false;
+    }
+
+    if (hdma != NULL) {
+        hdma->Parent = crc;
+        hdma->XferCpltCallback = hw_crc_dma_complete;
+        hdma->XferErrorCallback = hw_crc_dma_error;
+    }
+
+    crc->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 소프트웨어 CRC-32
+ */
+uint32_t hw_crc32_sw(const void *data, uint32_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t c = HW_CRC_INIT;
+
+    for (uint32_t i = 0; i < len; i++) {
+        c ^= p[i];
+        c = (c >> 4) ^ hw_crc_nibble_table[c & 0x0Fu];
+        c = (c >> 4) ^ hw_crc_nibble_table[c & 0x0Fu];
+    }
+
+    return c ^ HW_CRC_INIT;
+}
+
+/**
+ * @brief 바이트열 CRC-32
+ */
+uint32_t hw_crc32(HwCrc *crc, const void *data, uint32_t len) {
+    if (data == NULL || len == 0) {
+        return 0;
+    }
+    if (crc == NULL || !crc->initialized ||
+        atomic_flag_test_and_set_explicit(&crc->busy, memory_order_acquire)) {
+        if (crc != NULL) {
+            crc->sw_fallbacks++;
+        }
+        return hw_crc32_sw(data, len);
+    }
+
+    // HAL_CRC_Calculate는 바이트 형식이면 uint32_t 포인터를 바이트열로 읽음 (정렬 불필요)
+    HAL_CRCEx_Input_Data_Reverse(crc->hcrc, CRC_INPUTDATA_INVERSION_BYTE);
+    uint32_t value = HAL_CRC_Calculate(crc->hcrc, (uint32_t *)(uintptr_t)data, len) ^ HW_CRC_INIT;
+
+    atomic_flag_clear_explicit(&crc->busy, memory_order_release);
+
+    return value;
+}
+
+/**
+ * @brief DMA CRC-32 계산 시작
+ */
+bool hw_crc32_start_dma(HwCrc *crc, const void *data, uint32_t len, HwCrcDoneFn done, void *context) {
+    if (crc == NULL || !crc->initialized || crc->hdma == NULL || data == NULL || len == 0 ||
+        (len & 3u) != 0 || ((uintptr_t)data & 3u) != 0) {
+        return false;
+    }
+    if (atomic_flag_test_and_set_explicit(&crc->busy, memory_order_acquire)) {
+        return false;
+    }
+
+    crc->done = done;
+    crc->done_context = context;
+
+    // 리틀 엔디언 워드 입력: 워드 단위 반사 = 바이트 순서대로 LSB 먼저
+    HAL_CRCEx_Input_Data_Reverse(crc->hcrc, CRC_INPUTDATA_INVERSION_WORD);
+    __HAL_CRC_DR_RESET(crc->hcrc);
+
+    if (HAL_DMA_Start_IT(crc->hdma, (uint32_t)(uintptr_t)data, (uint32_t)(uintptr_t)&crc->hcrc->Instance->DR,
+                         len / 4u) != HAL_OK) {
+        atomic_flag_clear_explicit(&crc->busy, memory_order_release);
+        return false;
+    }
+
+    return true;
+}
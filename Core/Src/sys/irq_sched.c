@@ -0,0 +1,163 @@
+/**
+ * @file irq_sched.c
+ * @brief 우선순위 실행-완료 이벤트 스케줄러 구현
+ */
+
+#include "sys/irq_sched.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 단계 벡터를 대기 상태로 만듦
+ */
+static inline void irq_sched_pend(IRQn_Type irq) {
+    if (irq == PendSV_IRQn) {
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    } else {
+        NVIC_SetPendingIRQ(irq);
+    }
+}
+
+/**
+ * @brief 스케줄러 초기화
+ */
+bool irq_sched_init(IrqSched *sched) {
+    if (sched == NULL) {
+        return false;
+    }
+
+    memset(sched, 0, sizeof(*sched));
+    for (uint8_t i = 0; i < IRQ_SCHED_MAX_LEVELS; i++) {
+        atomic_init(&sched->level[i].pending, 0u);
+    }
+    for (uint8_t i = 0; i < IRQ_SCHED_MAX_EVENTS; i++) {
+        atomic_init(&sched->event[i].posts, 0u);
+        atomic_init(&sched->event[i].coalesced, 0u);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 우선순위 단계 추가
+ */
+bool irq_sched_add_level(IrqSched *sched, IRQn_Type irq, uint32_t preempt_priority) {
+    if (sched == NULL || sched->level_count >= IRQ_SCHED_MAX_LEVELS ||
+        preempt_priority >= (1u << __NVIC_PRIO_BITS) || (irq < 0 && irq != PendSV_IRQn)) {
+        return false;
+    }
+    if (sched->level_count > 0) {
+        // 앞 단계(높은 우선순위)보다 숫자가 커야 중첩 순서가 맞음
+        IRQn_Type prev = sched->level[sched->level_count - 1].irq;
+        if (preempt_priority <= NVIC_GetPriority(prev)) {
+            return false;
+        }
+    }
+
+    IrqSchedLevel *lv = &sched->level[sched->level_count];
+    lv->irq = irq;
+    atomic_store_explicit(&lv->pending, 0u, memory_order_relaxed);
+    lv->event_count = 0;
+    lv->dispatches = 0;
+
+    HAL_NVIC_SetPriority(irq, preempt_priority, 0);
+    if (irq >= 0) {
+        HAL_NVIC_ClearPendingIRQ(irq);
+        HAL_NVIC_EnableIRQ(irq);
+    }
+    sched->level_count++;
+
+    return true;
+}
+
+/**
+ * @brief 이벤트 처리기 등록
+ */
+IrqSchedEvent irq_sched_register(IrqSched *sched, uint8_t level, IrqSchedHandlerFn handler, void *context) {
+    if (sched == NULL || handler == NULL || level >= sched->level_count ||
+        sched->event_count >= IRQ_SCHED_MAX_EVENTS) {
+        return IRQ_SCHED_INVALID_EVENT;
+    }
+
+    IrqSchedLevel *lv = &sched->level[level];
+    if (lv->event_count >= 32u) {
+        return IRQ_SCHED_INVALID_EVENT;
+    }
+
+    IrqSchedEvent id = sched->event_count;
+    IrqSchedEventSlot *ev = &sched->event[id];
+    ev->handler = handler;
+    ev->context = context;
+    ev->level = level;
+    ev->bit = lv->event_count;
+    ev->runs = 0;
+    lv->events[lv->event_count++] = id;
+    sched->event_count++;
+
+    return id;
+}
+
+/**
+ * @brief 이벤트 게시
+ */
+bool irq_sched_post(IrqSched *sched, IrqSchedEvent event) {
+    if (sched == NULL || event >= sched->event_count) {
+        return false;
+    }
+
+    IrqSchedEventSlot *ev = &sched->event[event];
+    IrqSchedLevel *lv = &sched->level[ev->level];
+    uint_fast32_t bit = 1u << ev->bit;
+
+    atomic_fetch_add_explicit(&ev->posts, 1, memory_order_relaxed);
+    uint_fast32_t prev = atomic_fetch_or_explicit(&lv->pending, bit, memory_order_release);
+    if (prev & bit) {
+        // 아직 실행 전: 한 번만 실행됨
+        atomic_fetch_add_explicit(&ev->coalesced, 1, memory_order_relaxed);
+        return true;
+    }
+    irq_sched_pend(lv->irq);
+
+    return true;
+}
+
+/**
+ * @brief 단계 벡터 처리기 본체
+ */
+void irq_sched_dispatch(IrqSched *sched, uint8_t level) {
+    if (sched == NULL || level >= sched->level_count) {
+        return;
+    }
+
+    IrqSchedLevel *lv = &sched->level[level];
+    lv->dispatches++;
+
+    // 실행 중 다시 게시된 이벤트도 이 진입에서 처리 (그때 다시 대기된 벡터는 빈 진입으로 끝남)
+    uint_fast32_t pending;
+    while ((pending = atomic_exchange_explicit(&lv->pending, 0u, memory_order_acquire)) != 0u) {
+        for (uint8_t b = 0; b < lv->event_count; b++) {
+            if ((pending & (1u << b)) == 0u) {
+                continue;
+            }
+            IrqSchedEventSlot *ev = &sched->event[lv->events[b]];
+            ev->handler(ev->context);
+            ev->runs++;
+        }
+    }
+}
+
+/**
+ * @brief 이벤트 통계
+ */
+bool irq_sched_get_stats(const IrqSched *sched, IrqSchedEvent event, IrqSchedEventStats *stats) {
+    if (sched == NULL || stats == NULL || event >= sched->event_count) {
+        return false;
+    }
+
+    const IrqSchedEventSlot *ev = &sched->event[event];
+    stats->posts = (uint32_t)atomic_load_explicit(&ev->posts, memory_order_relaxed);
+    stats->runs = ev->runs;
+    stats->coalesced = (uint32_t)atomic_load_explicit(&ev->coalesced, memory_order_relaxed);
+
+    return true;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file mem_section.c
+ * @brief RAM 실행 함수/상수 영역 복사 구현
+ */
+
+#include "sys/mem_section.h"
+#include "stm32l4xx.h"
+#include <string.h>
+
+#ifdef MEM_RAMFUNC_ENABLE
+
+/* 링커 스크립트 심볼 */
+extern uint8_t _siramfunc;
+extern uint8_t _sramfunc;
+extern uint8_t _eramfunc;
+
+/**
+ * @brief RAM 함수/상수 영역을 플래시 적재 주소에서 SRAM2로 복사
+ */
+void mem_section_init(void) {
+    memcpy(&_sramfunc, &_siramfunc, (size_t)(&_eramfunc - &_sramfunc));
+
+    // 복사한 코드가 명령 버스에 보이도록 파이프라인과 쓰기 버퍼 정리
+    __DSB();
+    __ISB();
+}
+
+/**
+ * @brief SRAM2에 복사한 RAM 함수/상수 영역 크기
+ */
+uint32_t mem_section_ramfunc_size(void) {
+    return (uint32_t)(&_eramfunc - &_sramfunc);
+}
+
+#else /* MEM_RAMFUNC_ENABLE */
+
+void mem_section_init(void) {
+}
+
+uint32_t mem_section_ramfunc_size(void) {
+    return 0;
+}
+
+#endif /* MEM_RAMFUNC_ENABLE */
@@ -0,0 +1,148 @@
+/**
+ * @file memstat.c
+ * @brief MSP 스택 최대 사용량 및 힙 사용량 측정 구현
+ */
+
+#include "sys/memstat.h"
+#include "sys/mem_section.h"
+#include "stm32l4xx.h"
+#include <stddef.h>
+#include <stdio.h>
+
+/* 링커 스크립트 심볼 */
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint32_t _Min_Stack_Size;
+#ifdef MEM_SECTIONS_ENABLE
+extern uint8_t _sstack;
+#endif
+
+/* sysmem.c */
+void *_sbrk(ptrdiff_t incr);
+
+/**
+ * @brief 칠한 영역 상한 (NULL이면 칠하기 전)
+ */
+static uint32_t *memstat_paint_top = NULL;
+
+/**
+ * @brief 스택 영역 하한
+ */
+static uint32_t *memstat_stack_bottom(void) {
+#ifdef MEM_SECTIONS_ENABLE
+    uint8_t *bottom = &_sstack;
+#else
+    // 스택과 힙이 같은 RAM을 공유: 현재 힙 끝 위쪽이 스택이 내려올 수 있는 영역
+    uint8_t *bottom = (uint8_t *)_sbrk(0);
+#endif
+    return (uint32_t *)(((uintptr_t)bottom + 3u) & ~(uintptr_t)3u);
+}
+
+/**
+ * @brief 스택 영역 칠하기
+ */
+void memstat_init(void) {
+    uint32_t *bottom = memstat_stack_bottom();
+    uint32_t *top = (uint32_t *)(uintptr_t)((__get_MSP() - MEMSTAT_STACK_GUARD) & ~(uint32_t)3u);
+
+    for (volatile uint32_t *p = bottom; p < top; p++) {
+        *p = MEMSTAT_STACK_PATTERN;
+    }
+
+    memstat_paint_top = top;
+}
+
+/**
+ * @brief 현재까지의 메모리 사용량 계산
+ */
+bool memstat_get(MemStats *stats) {
+    if (stats == NULL || memstat_paint_top == NULL) {
+        return false;
+    }
+
+    uint32_t estack = (uint32_t)(uintptr_t)&_estack;
+    uint32_t *bottom = memstat_stack_bottom();
+
+    // 아래쪽부터 패턴이 지워진 첫 워드 검색 (힙이 자란 부분은 제외)
+    const volatile uint32_t *p = bottom;
+    while (p < memstat_paint_top && *p == MEMSTAT_STACK_PATTERN) {
+        p++;
+    }
+
+    stats->stack_size = estack - (uint32_t)(uintptr_t)bottom;
+    stats->stack_used = estack - (uint32_t)(uintptr_t)p;
+    stats->heap_used = (uint32_t)((uint8_t *)_sbrk(0) - &_end);
+    stats->min_stack_reserve = (uint32_t)(uintptr_t)&_Min_Stack_Size;
+
+    return true;
+}
+
+/**
+ * @brief 메모리 사용량을 한 줄씩 출력
+ */
+void memstat_report(ProfileWriteFn write) {
+    if (write == NULL) {
+        return;
+    }
+
+    MemStats stats;
+    if (!memstat_get(&stats)) {
+        return;
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "%-18s used=%lu size=%lu reserve=%lu\r\n", "stack",
+             (unsigned long)stats.stack_used, (unsigned long)stats.stack_size,
+             (unsigned long)stats.min_stack_reserve);
+    write(line);
+    snprintf(line, sizeof(line), "%-18s used=%lu\r\n", "heap", (unsigned long)stats.heap_used);
+    write(line);
+}
+
+/**
+ * @brief 구간 스택 측정 시작
+ */
+bool memstat_window_begin(MemStackWindow *window, uint32_t size) {
+    if (window == NULL) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t sp = __get_MSP();
+    uint32_t *bottom = memstat_stack_bottom();
+    uint32_t *top = (uint32_t *)(uintptr_t)((sp - MEMSTAT_STACK_GUARD) & ~(uint32_t)3u);
+    if (top <= bottom) {
+        __set_PRIMASK(primask);
+        return false;
+    }
+    if ((uintptr_t)top - (uintptr_t)bottom > size) {
+        bottom = (uint32_t *)(uintptr_t)(((uintptr_t)top - size) & ~(uintptr_t)3u);
+    }
+    for (volatile uint32_t *p = bottom; p < top; p++) {
+        *p = MEMSTAT_STACK_PATTERN;
+    }
+
+    __set_PRIMASK(primask);
+
+    window->bottom = bottom;
+    window->top = top;
+    window->sp = sp;
+    return true;
+}
+
+/**
+ * @brief 구간 시작 뒤 최대 스택 깊이
+ */
+uint32_t memstat_window_used(const MemStackWindow *window) {
+    if (window == NULL || window->top == NULL) {
+        return 0;
+    }
+
+    const volatile uint32_t *p = window->bottom;
+    while (p < window->top && *p == MEMSTAT_STACK_PATTERN) {
+        p++;
+    }
+    return window->sp - (uint32_t)(uintptr_t)p;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file pad_hold.c
+ * @brief 발사대 장시간 대기용 Stop 2 저전력 모드 구현
+ */
+
+#include "sys/board_profile.h"
+
+#if BOARD_HAS_PAD_HOLD
+
+#include "sys/pad_hold.h"
+#include "sys/timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief LPTIM 레지스터 갱신 대기 한계 (반복 수, LSE 몇 주기)
+ */
+#define PAD_HOLD_LPTIM_SYNC_SPINS 20000u
+
+/**
+ * @brief LPTIM 카운터 읽기 (비동기 클럭이므로 같은 값이 두 번 나올 때까지)
+ */
+static uint16_t pad_hold_lptim_count(const PadHold *hold) {
+    LPTIM_TypeDef *lp = hold->hlptim->Instance;
+    uint32_t a;
+    uint32_t b;
+    do {
+        a = lp->CNT;
+        b = lp->CNT;
+    } while (a != b);
+
+    return (uint16_t)a;
+}
+
+/**
+ * @brief LPTIM 플래그가 설정될 때까지 대기 (한계 반복 수 안)
+ */
+static bool pad_hold_lptim_wait(const PadHold *hold, uint32_t flag) {
+    LPTIM_TypeDef *lp = hold->hlptim->Instance;
+    for (uint32_t i = 0; i < PAD_HOLD_LPTIM_SYNC_SPINS; i++) {
+        if (lp->ISR & flag) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 발사대 단계이고 발사 대기 중이 아닌지
+ */
+static bool pad_hold_on_pad(const PadHold *hold) {
+    return flight_phase_get(hold->phase) == FLIGHT_PHASE_PAD && !flight_phase_launch_pending(hold->phase);
+}
+
+/**
+ * @brief Stop 2 진입 전 깨우기 원천 설정
+ */
+static bool pad_hold_prepare(void *context) {
+    PadHold *hold = (PadHold *)context;
+    LPTIM_TypeDef *lp = hold->hlptim->Instance;
+
+    // 직전 비교 레지스터 쓰기가 끝나야 다시 쓸 수 있음
+    if ((lp->ISR & LPTIM_ISR_CMPOK) == 0 && !pad_hold_lptim_wait(hold, LPTIM_ISR_CMPOK)) {
+        return false;
+    }
+
+    hold->sleep_start_us = timebase_now_us64();
+    hold->sleep_start = pad_hold_lptim_count(hold);
+    uint32_t ticks = (hold->config.max_sleep_ms * PAD_HOLD_LPTIM_HZ) / 1000u;
+    lp->ICR = LPTIM_ICR_CMPOKCF | LPTIM_ICR_CMPMCF;
+    lp->CMP = (uint16_t)(hold->sleep_start + ticks);
+
+    return true;
+}
+
+/**
+ * @brief Stop 2에서 깬 뒤 시간축 보정 (클럭 복구 뒤, 인터럽트 막힌 상태)
+ */
+static void pad_hold_resume(void *context) {
+    PadHold *hold = (PadHold *)context;
+
+    // 수면 시간 = LPTIM 틱 x 10^6 / 32768 = 틱 x 15625 / 512
+    uint16_t ticks = (uint16_t)(pad_hold_lptim_count(hold) - hold->sleep_start);
+    uint32_t total = (uint32_t)ticks * 15625u + hold->frac;
+    uint64_t slept_us = total >> 9;
+    hold->frac = total & 511u;
+
+    // 진입 전/복구 중에 timebase가 센 시간은 빼고 모자란 만큼만 더함
+    uint64_t target_us = hold->sleep_start_us + slept_us;
+    uint64_t now_us = timebase_now_us64();
+    if (target_us > now_us) {
+        timebase_skip(target_us - now_us);
+    }
+
+    hold->stats.stops++;
+    hold->stats.slept_us += slept_us;
+    if (hold->hlptim->Instance->ISR & LPTIM_ISR_CMPM) {
+        hold->stats.lptim_wakeups++;
+    }
+    if (hold->gnss != NULL && __HAL_UART_GET_FLAG(hold->gnss, UART_FLAG_WUF)) {
+        // 프레임 나머지는 DMA가 받도록 잠시 WFI만 사용 (WUF는 UART 인터럽트가 지움)
+        hold->stats.gnss_wakeups++;
+        hold->gnss_hold = true;
+        hold->gnss_until_us = (uint32_t)timebase_now_us64() + hold->config.gnss_hold_ms * 1000u;
+    }
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool pad_hold_default_config(PadHoldConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->max_sleep_ms = PAD_HOLD_DEFAULT_MAX_SLEEP_MS;
+    config->gnss_hold_ms = PAD_HOLD_DEFAULT_GNSS_HOLD_MS;
+
+    return true;
+}
+
+/**
+ * @brief 초기화
+ */
+bool pad_hold_init(PadHold *hold, PowerManager *pm, LPTIM_HandleTypeDef *hlptim,
+                   UART_HandleTypeDef *gnss, const FlightPhaseMachine *phase, const PadHoldConfig *config) {
+    if (hold == NULL || pm == NULL || hlptim == NULL || phase == NULL) {
+        return false;
+    }
+
+    PadHoldConfig cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        pad_hold_default_config(&cfg);
+    }
+    if (cfg.max_sleep_ms == 0 || cfg.max_sleep_ms > PAD_HOLD_MAX_SLEEP_LIMIT_MS) {
+        return false;
+    }
+
+    memset(hold, 0, sizeof(*hold));
+    hold->pm = pm;
+    hold->hlptim = hlptim;
+    hold->gnss = gnss;
+    hold->phase = phase;
+    hold->config = cfg;
+
+    // 비교 일치 인터럽트는 LPTIM이 꺼진 상태에서만 설정 가능
+    LPTIM_TypeDef *lp = hlptim->Instance;
+    lp->CR = 0;
+    lp->IER = LPTIM_IER_CMPMIE;
+    lp->CR = LPTIM_CR_ENABLE;
+    lp->ARR = 0xFFFFu;
+    if (!pad_hold_lptim_wait(hold, LPTIM_ISR_ARROK)) {
+        lp->CR = 0;
+        return false;
+    }
+    lp->ICR = LPTIM_ICR_ARROKCF;
+    lp->CMP = 0;
+    lp->CR |= LPTIM_CR_CNTSTRT;
+    if (lp == LPTIM1) {
+        __HAL_LPTIM_LPTIM1_EXTI_ENABLE_IT();
+    } else {
+        __HAL_LPTIM_LPTIM2_EXTI_ENABLE_IT();
+    }
+
+    if (gnss != NULL) {
+        UART_WakeUpTypeDef wake;
+        memset(&wake, 0, sizeof(wake));
+        wake.WakeUpEvent = UART_WAKEUP_ON_STARTBIT;
+        if (HAL_UARTEx_StopModeWakeUpSourceConfig(gnss, wake) != HAL_OK ||
+            HAL_UARTEx_EnableStopMode(gnss) != HAL_OK) {
+            return false;
+        }
+        __HAL_UART_ENABLE_IT(gnss, UART_IT_WUF);
+    }
+
+    hold->initialized = true;
+
+    return true;
+}
+
+/**
+ * @brief 유휴 처리
+ */
+bool pad_hold_idle(PadHold *hold) {
+    if (hold == NULL || !hold->initialized) {
+        return false;
+    }
+
+    if (!pad_hold_on_pad(hold)) {
+        hold->stats.idles++;
+        return power_idle(hold->pm);
+    }
+    if (hold->gnss_hold) {
+        if ((int32_t)(timebase_now_us() - hold->gnss_until_us) < 0) {
+            hold->stats.idles++;
+            return power_idle(hold->pm);
+        }
+        hold->gnss_hold = false;
+    }
+
+    PowerStopHooks hooks = { pad_hold_prepare, pad_hold_resume, hold };
+    return power_stop(hold->pm, &hooks);
+}
+
+/**
+ * @brief LPTIM 인터럽트 처리
+ */
+void pad_hold_handle_lptim(PadHold *hold) {
+    if (hold == NULL || !hold->initialized) {
+        return;
+    }
+
+    // 깨우기만 하면 되므로 플래그만 지움 (수는 pad_hold_resume이 셈)
+    hold->hlptim->Instance->ICR = LPTIM_ICR_CMPMCF;
+}
+
+/**
+ * @brief 통계
+ */
+const PadHoldStats *pad_hold_get_stats(const PadHold *hold) {
+    if (hold == NULL) {
+        return NULL;
+    }
+
+    return &hold->stats;
+}
+
+#endif /* BOARD_HAS_PAD_HOLD */
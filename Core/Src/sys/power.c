@@ -0,0 +1,314 @@
+/**
+ * @file power.c
+ * @brief 비행 단계별 클럭/전압 범위 전환과 WFI 절전 구현
+ */
+
+#include "sys/power.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 단계 이름 (FlightPhase 순서와 일치)
+ */
+static const char *const power_phase_names[POWER_PHASE_COUNT] = {
+    "pad",
+    "boost",
+    "coast",
+    "descent"
+};
+
+/**
+ * @brief 마지막 계측 이후 시간을 현재 단계의 활동 또는 수면으로 누적
+ */
+static void power_account(PowerManager *pm, uint32_t now, bool asleep) {
+    uint32_t elapsed = now - pm->mark_us;
+    PowerPhaseStats *st = &pm->stats[pm->phase];
+    if (asleep) {
+        st->sleep_us += elapsed;
+    } else {
+        st->active_us += elapsed;
+        pm->window_active_us += elapsed;
+    }
+    pm->mark_us = now;
+}
+
+/**
+ * @brief 비율 측정 구간 다시 시작
+ */
+static void power_window_reset(PowerManager *pm, uint32_t now) {
+    pm->window_start_us = now;
+    pm->window_active_us = 0;
+}
+
+/**
+ * @brief 클럭 설정 전환 (RM0351 순서: 올릴 때 전압 먼저, 내릴 때 전압 나중)
+ */
+static bool power_apply_level(PowerManager *pm, PowerLevel level) {
+    PowerClockConfig *c = &pm->config.level[level];
+
+    if (level > pm->level) {
+        if (HAL_PWREx_ControlVoltageScaling(c->voltage_scale) != HAL_OK ||
+            HAL_RCC_OscConfig(&c->osc) != HAL_OK ||
+            HAL_RCC_ClockConfig(&c->clk, c->flash_latency) != HAL_OK) {
+            pm->clock_failures++;
+            return false;
+        }
+    } else {
+        // 새 시스템 클럭 발진기를 먼저 켜고, 전환 뒤에 PLL 등을 끔
+        RCC_OscInitTypeDef start = c->osc;
+        start.PLL.PLLState = RCC_PLL_NONE;
+        if (HAL_RCC_OscConfig(&start) != HAL_OK ||
+            HAL_RCC_ClockConfig(&c->clk, c->flash_latency) != HAL_OK ||
+            HAL_RCC_OscConfig(&c->osc) != HAL_OK ||
+            HAL_PWREx_ControlVoltageScaling(c->voltage_scale) != HAL_OK) {
+            pm->clock_failures++;
+            return false;
+        }
+    }
+
+    pm->level = level;
+    pm->level_changes++;
+    if (pm->config.clock_changed != NULL) {
+        pm->config.clock_changed(HAL_RCC_GetHCLKFreq(), pm->config.context);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 저전력 단계의 처리 시간 비율 확인 (한계 초과 시 이번 비행 단계 동안 전체 단계 고정)
+ */
+static void power_check_duty(PowerManager *pm, uint32_t now) {
+    uint32_t window = now - pm->window_start_us;
+    if (window < pm->config.duty_window_us) {
+        return;
+    }
+    if (pm->level == POWER_LEVEL_LOW && pm->config.duty_limit > 0.0f &&
+        (float)pm->window_active_us > pm->config.duty_limit * (float)window) {
+        pm->boosted = true;
+        pm->stats[pm->phase].guard_trips++;
+    }
+    power_window_reset(pm, now);
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool power_default_config(PowerConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    memset(config, 0, sizeof(*config));
+
+    // 저전력: HSI16 직접 사용, PLL 끔, 전압 범위 2 (16 MHz는 2 대기 상태)
+    PowerClockConfig *low = &config->level[POWER_LEVEL_LOW];
+    low->osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+    low->osc.HSIState = RCC_HSI_ON;
+    low->osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    low->osc.PLL.PLLState = RCC_PLL_OFF;
+    low->clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    low->clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+    low->clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    low->clk.APB1CLKDivider = RCC_HCLK_DIV1;
+    low->clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    low->flash_latency = FLASH_LATENCY_2;
+    low->voltage_scale = PWR_REGULATOR_VOLTAGE_SCALE2;
+
+    config->level[POWER_LEVEL_FULL].voltage_scale = PWR_REGULATOR_VOLTAGE_SCALE1;
+
+    config->phase_level[FLIGHT_PHASE_PAD] = POWER_LEVEL_LOW;
+    config->phase_level[FLIGHT_PHASE_BOOST] = POWER_LEVEL_FULL;
+    config->phase_level[FLIGHT_PHASE_COAST] = POWER_LEVEL_FULL;
+    config->phase_level[FLIGHT_PHASE_DESCENT] = POWER_LEVEL_FULL;
+    config->duty_limit = POWER_DEFAULT_DUTY_LIMIT;
+    config->duty_window_us = POWER_DEFAULT_DUTY_WINDOW_US;
+
+    return true;
+}
+
+/**
+ * @brief 전력 관리자 초기화
+ */
+bool power_init(PowerManager *pm, const PowerConfig *config) {
+    if (pm == NULL || config == NULL || config->now_us == NULL || config->duty_window_us == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < POWER_LEVEL_COUNT; i++) {
+        if (config->level[i].clk.ClockType == 0) {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < POWER_PHASE_COUNT; i++) {
+        if (config->phase_level[i] >= POWER_LEVEL_COUNT) {
+            return false;
+        }
+    }
+
+    // 전압 범위 설정에 PWR 클럭 필요
+    __HAL_RCC_PWR_CLK_ENABLE();
+
+    memset(pm, 0, sizeof(*pm));
+    pm->config = *config;
+    pm->level = POWER_LEVEL_FULL;
+    pm->phase = FLIGHT_PHASE_PAD;
+    pm->mark_us = config->now_us();
+    power_window_reset(pm, pm->mark_us);
+
+    return true;
+}
+
+/**
+ * @brief 비행 단계 반영
+ */
+bool power_update(PowerManager *pm, const FlightPhaseMachine *fp) {
+    if (pm == NULL || fp == NULL) {
+        return false;
+    }
+
+    uint32_t now = pm->config.now_us();
+    power_account(pm, now, false);
+
+    FlightPhase phase = flight_phase_get(fp);
+    if (phase != pm->phase) {
+        pm->phase = phase;
+        pm->boosted = false;
+        power_window_reset(pm, now);
+    } else {
+        power_check_duty(pm, now);
+    }
+
+    PowerLevel level = pm->config.phase_level[phase];
+    if (pm->boosted || flight_phase_launch_pending(fp)) {
+        level = POWER_LEVEL_FULL;
+    }
+    if (level == pm->level) {
+        return true;
+    }
+
+    bool ok = power_apply_level(pm, level);
+    // 전환 시간은 새 단계의 활동으로 계산 (다음 구간 비율에 포함)
+    power_account(pm, pm->config.now_us(), false);
+    return ok;
+}
+
+/**
+ * @brief 처리할 일이 없으면 다음 인터럽트까지 WFI 대기
+ */
+bool power_idle(PowerManager *pm) {
+    if (pm == NULL) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (pm->config.has_work != NULL && pm->config.has_work(pm->config.context)) {
+        __set_PRIMASK(primask);
+        return false;
+    }
+
+    power_account(pm, pm->config.now_us(), false);
+    __DSB();
+    __WFI();
+    // 깨운 인터럽트는 PRIMASK를 되돌린 뒤 처리되므로 그 전에 수면 시간을 닫음
+    power_account(pm, pm->config.now_us(), true);
+    pm->stats[pm->phase].wakeups++;
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/**
+ * @brief Stop 2에서 깬 뒤 현재 단계 클럭 다시 적용 (전압 범위는 Stop 2에서 유지됨)
+ */
+static void power_restore_level(PowerManager *pm) {
+    PowerClockConfig *c = &pm->config.level[pm->level];
+
+    if (HAL_RCC_OscConfig(&c->osc) != HAL_OK ||
+        HAL_RCC_ClockConfig(&c->clk, c->flash_latency) != HAL_OK) {
+        pm->clock_failures++;
+    }
+    if (pm->config.clock_changed != NULL) {
+        pm->config.clock_changed(HAL_RCC_GetHCLKFreq(), pm->config.context);
+    }
+}
+
+/**
+ * @brief 처리할 일이 없으면 다음 깨우기 원천까지 Stop 2 대기
+ */
+bool power_stop(PowerManager *pm, const PowerStopHooks *hooks) {
+    if (pm == NULL || hooks == NULL || hooks->resume == NULL) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if ((pm->config.has_work != NULL && pm->config.has_work(pm->config.context)) ||
+        (hooks->prepare != NULL && !hooks->prepare(hooks->context))) {
+        __set_PRIMASK(primask);
+        return false;
+    }
+
+    power_account(pm, pm->config.now_us(), false);
+    HAL_SuspendTick();
+    HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+    power_restore_level(pm);
+    hooks->resume(hooks->context);
+    HAL_ResumeTick();
+    power_account(pm, pm->config.now_us(), true);
+    pm->stats[pm->phase].wakeups++;
+    pm->stats[pm->phase].stops++;
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/**
+ * @brief 현재 전력 단계
+ */
+PowerLevel power_get_level(const PowerManager *pm) {
+    return (pm != NULL) ? pm->level : POWER_LEVEL_FULL;
+}
+
+/**
+ * @brief 단계별 통계 조회
+ */
+const PowerPhaseStats *power_get_stats(const PowerManager *pm, FlightPhase phase) {
+    if (pm == NULL || (uint32_t)phase >= POWER_PHASE_COUNT) {
+        return NULL;
+    }
+
+    return &pm->stats[phase];
+}
+
+/**
+ * @brief 단계별 활동 비율을 한 줄씩 출력
+ */
+void power_report(const PowerManager *pm, ProfileWriteFn write) {
+    if (pm == NULL || write == NULL) {
+        return;
+    }
+
+    char line[128];
+    for (uint8_t i = 0; i < POWER_PHASE_COUNT; i++) {
+        const PowerPhaseStats *st = &pm->stats[i];
+        uint64_t total = st->active_us + st->sleep_us;
+        if (total == 0) {
+            continue;
+        }
+
+        // 활동 비율 (0.1% 단위)
+        uint32_t duty = (uint32_t)((st->active_us * 1000u + total / 2u) / total);
+        snprintf(line, sizeof(line), "power %-8s active=%lu ms sleep=%lu ms duty=%lu.%lu%% wakeups=%lu stops=%lu guard=%lu\r\n",
+                 power_phase_names[i], (unsigned long)(st->active_us / 1000u),
+                 (unsigned long)(st->sleep_us / 1000u), (unsigned long)(duty / 10u),
+                 (unsigned long)(duty % 10u), (unsigned long)st->wakeups, (unsigned long)st->stops,
+                 (unsigned long)st->guard_trips);
+        write(line);
+    }
+    snprintf(line, sizeof(line), "power level=%s changes=%lu failures=%lu\r\n",
+             (pm->level == POWER_LEVEL_FULL) ? "full" : "low", (unsigned long)pm->level_changes,
+             (unsigned long)pm->clock_failures);
+    write(line);
+}
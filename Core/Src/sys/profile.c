@@ -0,0 +1,109 @@
+/**
+ * @file profile.c
+ * @brief DWT 사이클 카운터 기반 단계별 실행 시간 측정 구현
+ */
+
+#include "sys/profile.h"
+
+#ifdef PROFILE_ENABLE
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief 단계 이름 (ProfileStage 순서와 일치)
+ */
+static const char *const profile_stage_names[PROFILE_STAGE_COUNT] = {
+    "predict",
+    "jacobian",
+    "propagation",
+    "gain",
+    "inverse",
+    "state_update",
+    "covariance_update"
+};
+
+/**
+ * @brief 단계별 측정 테이블
+ */
+static ProfileEntry profile_table[PROFILE_STAGE_COUNT];
+
+/**
+ * @brief DWT 사이클 카운터 활성화 및 측정 테이블 초기화
+ */
+void profile_init(void) {
+    // 트레이스 활성화 후 사이클 카운터 시작
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    profile_reset();
+}
+
+/**
+ * @brief 측정 테이블 초기화
+ */
+void profile_reset(void) {
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        profile_table[i].name = profile_stage_names[i];
+        profile_table[i].count = 0;
+        profile_table[i].min_cycles = UINT32_MAX;
+        profile_table[i].max_cycles = 0;
+        profile_table[i].total_cycles = 0;
+    }
+}
+
+/**
+ * @brief 단계 측정값 기록
+ */
+void profile_record(ProfileStage stage, uint32_t cycles) {
+    if (stage >= PROFILE_STAGE_COUNT) {
+        return;
+    }
+
+    ProfileEntry *e = &profile_table[stage];
+    e->count++;
+    e->total_cycles += cycles;
+    if (cycles < e->min_cycles) {
+        e->min_cycles = cycles;
+    }
+    if (cycles > e->max_cycles) {
+        e->max_cycles = cycles;
+    }
+}
+
+/**
+ * @brief 단계 측정 결과 조회
+ */
+const ProfileEntry *profile_get(ProfileStage stage) {
+    if (stage >= PROFILE_STAGE_COUNT) {
+        return NULL;
+    }
+
+    return &profile_table[stage];
+}
+
+/**
+ * @brief 전체 측정 결과를 한 줄씩 출력
+ */
+void profile_report(ProfileWriteFn write) {
+    if (write == NULL) {
+        return;
+    }
+
+    char line[96];
+    for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        const ProfileEntry *e = &profile_table[i];
+        if (e->count == 0) {
+            continue;
+        }
+
+        uint32_t mean = (uint32_t)(e->total_cycles / e->count);
+        snprintf(line, sizeof(line), "%-18s n=%lu min=%lu max=%lu mean=%lu\r\n",
+                 e->name, (unsigned long)e->count, (unsigned long)e->min_cycles,
+                 (unsigned long)e->max_cycles, (unsigned long)mean);
+        write(line);
+    }
+}
+
+#endif /* PROFILE_ENABLE */
@@ -0,0 +1,168 @@
+/**
+ * @file rtos_tasks.c
+ * @brief FreeRTOS 통합 계층 구현
+ */
+
+#include "sys/rtos_tasks.h"
+
+#ifdef RTOS_ENABLE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+
+/**
+ * @brief 정적 태스크 저장소
+ */
+static StaticTask_t rtos_fusion_tcb;
+static StaticTask_t rtos_log_tcb;
+static StaticTask_t rtos_telemetry_tcb;
+static StackType_t rtos_fusion_stack[RTOS_FUSION_STACK_WORDS];
+static StackType_t rtos_log_stack[RTOS_LOG_STACK_WORDS];
+static StackType_t rtos_telemetry_stack[RTOS_TELEMETRY_STACK_WORDS];
+
+/**
+ * @brief 태스크 상태 (태스크마다 자기 카운터만 씀)
+ */
+static struct {
+    RtosTasksConfig config;
+    TaskHandle_t fusion;
+    TaskHandle_t log;
+    TaskHandle_t telemetry;
+    volatile uint32_t fusion_cycles;
+    volatile uint32_t fusion_timeouts;
+    volatile uint32_t log_services;
+    volatile uint32_t telemetry_services;
+    bool started;
+} rtos;
+
+/**
+ * @brief 융합 태스크 (IMU 알림마다 한 사이클)
+ */
+static void rtos_fusion_task(void *arg) {
+    (void)arg;
+    const RtosTasksConfig *cfg = &rtos.config;
+
+    for (;;) {
+        // 알림 값을 모두 소비 (여러 버스트가 쌓였어도 한 사이클에 링을 비움)
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RTOS_FUSION_TIMEOUT_MS)) == 0) {
+            rtos.fusion_timeouts++;
+        }
+
+        if (cfg->queue != NULL) {
+            fusion_scheduler_drain_queue(cfg->sched, cfg->queue, cfg->baro);
+        }
+        fusion_scheduler_run(cfg->sched);
+        rtos.fusion_cycles++;
+
+        if (cfg->post_cycle != NULL) {
+            cfg->post_cycle(cfg->post_cycle_context);
+        }
+        if (rtos.log != NULL) {
+            xTaskNotifyGive(rtos.log);
+        }
+    }
+}
+
+/**
+ * @brief 기록 태스크 (알림 또는 주기마다 기록 엔진 진행)
+ */
+static void rtos_log_task(void *arg) {
+    (void)arg;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RTOS_LOG_PERIOD_MS));
+        flash_log_service(rtos.config.log);
+        rtos.log_services++;
+    }
+}
+
+/**
+ * @brief 텔레메트리 태스크 (고정 주기)
+ */
+static void rtos_telemetry_task(void *arg) {
+    (void)arg;
+    TickType_t wake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(RTOS_TELEMETRY_PERIOD_MS));
+        telemetry_service(rtos.config.telemetry, rtos.config.clock());
+        rtos.telemetry_services++;
+    }
+}
+
+/**
+ * @brief 태스크 생성
+ */
+bool rtos_tasks_start(const RtosTasksConfig *config) {
+    if (rtos.started || config == NULL || config->sched == NULL || config->clock == NULL) {
+        return false;
+    }
+
+    rtos.config = *config;
+    rtos.fusion_cycles = 0;
+    rtos.fusion_timeouts = 0;
+    rtos.log_services = 0;
+    rtos.telemetry_services = 0;
+
+    // 낮은 우선순위 태스크를 먼저 만들어 융합 태스크가 첫 사이클에서 기록 태스크 핸들을 보게 함
+    rtos.log = NULL;
+    if (config->log != NULL) {
+        rtos.log = xTaskCreateStatic(rtos_log_task, "log", RTOS_LOG_STACK_WORDS, NULL,
+                                     RTOS_LOG_PRIORITY, rtos_log_stack, &rtos_log_tcb);
+    }
+    rtos.telemetry = NULL;
+    if (config->telemetry != NULL) {
+        rtos.telemetry = xTaskCreateStatic(rtos_telemetry_task, "tlm", RTOS_TELEMETRY_STACK_WORDS, NULL,
+                                           RTOS_TELEMETRY_PRIORITY, rtos_telemetry_stack, &rtos_telemetry_tcb);
+    }
+    rtos.fusion = xTaskCreateStatic(rtos_fusion_task, "fusion", RTOS_FUSION_STACK_WORDS, NULL,
+                                    RTOS_FUSION_PRIORITY, rtos_fusion_stack, &rtos_fusion_tcb);
+    rtos.started = true;
+
+    return true;
+}
+
+/**
+ * @brief IMU 샘플 도착 알림 (인터럽트 문맥)
+ */
+void rtos_tasks_notify_imu_from_isr(void) {
+    if (!rtos.started) {
+        return;
+    }
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(rtos.fusion, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 기록 태스크 깨우기
+ */
+void rtos_tasks_notify_log(void) {
+    if (rtos.started && rtos.log != NULL) {
+        xTaskNotifyGive(rtos.log);
+    }
+}
+
+/**
+ * @brief 태스크 통계
+ */
+bool rtos_tasks_get_stats(RtosTaskStats *stats) {
+    if (stats == NULL || !rtos.started) {
+        return false;
+    }
+
+    stats->fusion_cycles = rtos.fusion_cycles;
+    stats->fusion_timeouts = rtos.fusion_timeouts;
+    stats->log_services = rtos.log_services;
+    stats->telemetry_services = rtos.telemetry_services;
+    stats->fusion_stack_free = (uint32_t)uxTaskGetStackHighWaterMark(rtos.fusion);
+    stats->log_stack_free = (rtos.log != NULL) ? (uint32_t)uxTaskGetStackHighWaterMark(rtos.log) : 0u;
+    stats->telemetry_stack_free = (rtos.telemetry != NULL)
+                                ? (uint32_t)uxTaskGetStackHighWaterMark(rtos.telemetry) : 0u;
+
+    return true;
+}
+
+#endif /* RTOS_ENABLE */
@@ -0,0 +1,72 @@
+/**
+ * @file scratch.c
+ * @brief 정적 스크래치 메모리 영역 구현
+ */
+
+#include "sys/scratch.h"
+#include <stddef.h>
+
+/**
+ * @brief 스크래치 영역 초기화
+ */
+bool scratch_init(ScratchArena *arena, void *buffer, uint32_t size) {
+    if (arena == NULL || buffer == NULL) {
+        return false;
+    }
+
+    if (((uintptr_t)buffer & (SCRATCH_ALIGN - 1u)) != 0) {
+        return false;
+    }
+
+    arena->base = (uint8_t *)buffer;
+    arena->size = size;
+    arena->used = 0;
+    arena->high_water = 0;
+    arena->failures = 0;
+
+    return true;
+}
+
+/**
+ * @brief 작업 메모리 할당
+ */
+void *scratch_alloc(ScratchArena *arena, uint32_t size) {
+    if (arena == NULL || arena->base == NULL) {
+        return NULL;
+    }
+
+    uint32_t offset = (arena->used + SCRATCH_ALIGN - 1u) & ~(SCRATCH_ALIGN - 1u);
+    if (offset > arena->size || size > arena->size - offset) {
+        arena->failures++;
+        return NULL;
+    }
+
+    arena->used = offset + size;
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+    }
+
+    return arena->base + offset;
+}
+
+/**
+ * @brief 현재 사용 위치 기록
+ */
+uint32_t scratch_mark(const ScratchArena *arena) {
+    if (arena == NULL) {
+        return 0;
+    }
+
+    return arena->used;
+}
+
+/**
+ * @brief 기록한 위치 이후의 할당을 모두 해제
+ */
+void scratch_release(ScratchArena *arena, uint32_t mark) {
+    if (arena == NULL || mark > arena->used) {
+        return;
+    }
+
+    arena->used = mark;
+}
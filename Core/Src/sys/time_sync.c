@@ -0,0 +1,310 @@
+/**
+ * @file time_sync.c
+ * @brief GNSS 시간 펄스 기반 시각 동기 구현
+ */
+
+#include "sys/time_sync.h"
+#include "math/fp_mode.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 한 주 (초)
+ */
+#define TIME_SYNC_WEEK_S 604800u
+
+/**
+ * @brief 펄스 읽기 최대 재시도 횟수
+ */
+#define TIME_SYNC_MAX_RETRIES 4
+
+/**
+ * @brief 마지막 펄스 읽기 (인터럽트와 경합 시 재시도)
+ */
+static bool time_sync_read_pulse(const TimeSync *sync, uint64_t *local_us, uint32_t *count) {
+    for (uint8_t i = 0; i < TIME_SYNC_MAX_RETRIES; i++) {
+        uint32_t before = sync->pulse_count;
+        uint64_t value = sync->pulse_local_us;
+        if (sync->pulse_count == before) {
+            *local_us = value;
+            *count = before;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 주 시각 차이 (초, 반 주 이내로 감음)
+ */
+static int32_t time_sync_wrap_seconds(uint32_t a_s, uint32_t b_s) {
+    int32_t d = (int32_t)a_s - (int32_t)b_s;
+    if (d > (int32_t)(TIME_SYNC_WEEK_S / 2u)) {
+        d -= (int32_t)TIME_SYNC_WEEK_S;
+    } else if (d < -(int32_t)(TIME_SYNC_WEEK_S / 2u)) {
+        d += (int32_t)TIME_SYNC_WEEK_S;
+    }
+    return d;
+}
+
+/**
+ * @brief 펄스를 기준점으로 필터 시작
+ */
+static void time_sync_start(TimeSync *sync, uint64_t local_us, uint32_t tow_s) {
+    float r = sync->config.pulse_std_us * sync->config.pulse_std_us;
+    sync->anchor_local_us = local_us;
+    sync->anchor_tow_s = tow_s;
+    sync->offset_us = 0.0f;
+    sync->drift_ppm = 0.0f;
+    sync->P[0][0] = r;
+    sync->P[0][1] = 0.0f;
+    sync->P[1][0] = 0.0f;
+    sync->P[1][1] = sync->config.drift_std_ppm * sync->config.drift_std_ppm;
+    sync->consecutive_rejects = 0;
+    sync->initialized = true;
+    sync->stats.updates++;
+}
+
+/**
+ * @brief 펄스의 정수 초 라벨
+ *
+ * 고정 중이면 필터 예측으로, 아니면 NAV-PVT 힌트로 정한다. 힌트 규칙은
+ * ubx_gnss의 측정 시각 부여와 같다 (펄스 + iTOW 초 미만 부분이 수신보다 늦으면
+ * 그 펄스는 다음 초).
+ */
+static bool time_sync_label(const TimeSync *sync, uint64_t local_us, uint32_t *tow_s) {
+    if (sync->initialized) {
+        float dl = (float)(int64_t)(local_us - sync->anchor_local_us);
+        float n = (dl - sync->offset_us) / (1.0e6f + sync->drift_ppm);
+        int32_t k = (int32_t)lroundf(n);
+        if (k <= 0 || (uint32_t)k > TIME_SYNC_MAX_GAP_S) {
+            return false;
+        }
+        *tow_s = (sync->anchor_tow_s + (uint32_t)k) % TIME_SYNC_WEEK_S;
+        return true;
+    }
+
+    if (!sync->has_hint) {
+        return false;
+    }
+
+    uint32_t pulse = (uint32_t)local_us;
+    int32_t age = (int32_t)(sync->hint_arrival_us - pulse);
+    if (age <= -1000000 || age >= 1000000) {
+        return false;
+    }
+
+    uint32_t s = sync->hint_itow_ms / 1000u;
+    uint32_t stamp = pulse + (sync->hint_itow_ms % 1000u) * 1000u;
+    if ((int32_t)(sync->hint_arrival_us - stamp) < 0) {
+        s++;
+    }
+    *tow_s = s % TIME_SYNC_WEEK_S;
+
+    return true;
+}
+
+/**
+ * @brief 라벨이 붙은 펄스 반영
+ *
+ * 기준점에서 n초 뒤 펄스의 측정은 z = (L - L_a) - n x 1e6 (us)이고,
+ * 상태 전이는 offset += drift x n, Q = q [n^3/3 n^2/2; n^2/2 n] (q = drift_rw^2)이다.
+ * 갱신 후 기준점을 이 펄스로 옮기고 offset에서 z를 빼 작은 값으로 유지한다.
+ */
+static bool time_sync_process(TimeSync *sync, uint64_t local_us, uint32_t tow_s) {
+    if (!sync->initialized) {
+        time_sync_start(sync, local_us, tow_s);
+        return true;
+    }
+
+    int32_t n = time_sync_wrap_seconds(tow_s, sync->anchor_tow_s);
+    if (n <= 0 || (uint32_t)n > TIME_SYNC_MAX_GAP_S) {
+        time_sync_start(sync, local_us, tow_s);
+        sync->stats.relocks++;
+        return true;
+    }
+
+    float nf = (float)n;
+    float z = (float)((int64_t)(local_us - sync->anchor_local_us) - (int64_t)n * 1000000);
+
+    // 예측
+    float q = sync->config.drift_rw * sync->config.drift_rw;
+    float p00 = sync->P[0][0] + 2.0f * nf * sync->P[0][1] + nf * nf * sync->P[1][1] + q * nf * nf * nf / 3.0f;
+    float p01 = sync->P[0][1] + nf * sync->P[1][1] + 0.5f * q * nf * nf;
+    float p11 = sync->P[1][1] + q * nf;
+    float offset = sync->offset_us + sync->drift_ppm * nf;
+
+    float y = z - offset;
+    float s = p00 + sync->config.pulse_std_us * sync->config.pulse_std_us;
+    sync->stats.last_residual_us = y;
+    if (y * y > sync->config.gate_sigma * sync->config.gate_sigma * s) {
+        sync->stats.rejects++;
+        if (++sync->consecutive_rejects >= TIME_SYNC_MAX_REJECTS) {
+            // 다음 펄스는 NAV-PVT 힌트로 다시 라벨
+            sync->initialized = false;
+            sync->stats.relocks++;
+        }
+        return false;
+    }
+
+    // 갱신 (H = [1 0])
+    float k0 = p00 / s;
+    float k1 = p01 / s;
+    sync->offset_us = offset + k0 * y - z;
+    sync->drift_ppm += k1 * y;
+    sync->P[0][0] = p00 - k0 * p00;
+    sync->P[0][1] = p01 - k0 * p01;
+    sync->P[1][0] = sync->P[0][1];
+    sync->P[1][1] = p11 - k1 * p01;
+
+    sync->anchor_local_us = local_us;
+    sync->anchor_tow_s = tow_s;
+    sync->consecutive_rejects = 0;
+    sync->stats.updates++;
+
+    return true;
+}
+
+/**
+ * @brief 기본 설정
+ */
+bool time_sync_default_config(TimeSyncConfig *config) {
+    if (config == NULL) {
+        return false;
+    }
+
+    config->pulse_std_us = TIME_SYNC_DEFAULT_PULSE_STD_US;
+    config->drift_std_ppm = TIME_SYNC_DEFAULT_DRIFT_STD_PPM;
+    config->drift_rw = TIME_SYNC_DEFAULT_DRIFT_RW;
+    config->gate_sigma = TIME_SYNC_DEFAULT_GATE_SIGMA;
+    config->lock_std_us = TIME_SYNC_DEFAULT_LOCK_STD_US;
+
+    return true;
+}
+
+/**
+ * @brief 동기 초기화
+ */
+bool time_sync_init(TimeSync *sync, const TimeSyncConfig *config) {
+    if (sync == NULL) {
+        return false;
+    }
+
+    memset(sync, 0, sizeof(*sync));
+    if (config != NULL) {
+        sync->config = *config;
+    } else {
+        time_sync_default_config(&sync->config);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 시간 펄스 캡처 처리
+ */
+void time_sync_handle_pulse(TimeSync *sync, uint64_t timestamp_us) {
+    if (sync == NULL) {
+        return;
+    }
+
+    sync->pulse_local_us = timestamp_us;
+    sync->pulse_count++;
+    sync->stats.pulses++;
+}
+
+/**
+ * @brief NAV-PVT 수신 처리
+ */
+bool time_sync_handle_fix(TimeSync *sync, uint32_t itow_ms, uint32_t arrival_us) {
+    if (sync == NULL) {
+        return false;
+    }
+
+    sync->hint_itow_ms = itow_ms;
+    sync->hint_arrival_us = arrival_us;
+    sync->has_hint = true;
+
+    uint64_t local_us;
+    uint32_t count;
+    if (!time_sync_read_pulse(sync, &local_us, &count) || count == sync->processed_count) {
+        return false;
+    }
+    sync->processed_count = count;
+
+    uint32_t tow_s;
+    if (!time_sync_label(sync, local_us, &tow_s)) {
+        return false;
+    }
+
+    return time_sync_process(sync, local_us, tow_s);
+}
+
+/**
+ * @brief 고정 여부 (기준점 1초 뒤 예측 편차의 표준 편차로 판정)
+ */
+bool time_sync_is_locked(const TimeSync *sync) {
+    if (sync == NULL || !sync->initialized) {
+        return false;
+    }
+
+    float var = sync->P[0][0] + 2.0f * sync->P[0][1] + sync->P[1][1];
+    return var <= sync->config.lock_std_us * sync->config.lock_std_us;
+}
+
+/**
+ * @brief GNSS 주 시각 -> 로컬 시각
+ */
+bool time_sync_gnss_to_local(const TimeSync *sync, uint32_t itow_ms, uint32_t *local_us) {
+    if (local_us == NULL || !time_sync_is_locked(sync)) {
+        return false;
+    }
+
+    int32_t dms = (int32_t)itow_ms - (int32_t)(sync->anchor_tow_s * 1000u);
+    if (dms > TIME_SYNC_HALF_WEEK_MS) {
+        dms -= 2 * TIME_SYNC_HALF_WEEK_MS;
+    } else if (dms < -TIME_SYNC_HALF_WEEK_MS) {
+        dms += 2 * TIME_SYNC_HALF_WEEK_MS;
+    }
+
+    float corr = sync->offset_us + sync->drift_ppm * ((float)dms * 1.0e-3f);
+    int64_t local = (int64_t)sync->anchor_local_us + (int64_t)dms * 1000 + (int64_t)lroundf(corr);
+    *local_us = (uint32_t)local;
+
+    return true;
+}
+
+/**
+ * @brief 로컬 시각 -> GNSS 주 시각
+ */
+bool time_sync_local_to_gnss(const TimeSync *sync, uint32_t local_us, uint64_t *tow_us) {
+    if (tow_us == NULL || !time_sync_is_locked(sync)) {
+        return false;
+    }
+
+    // 주파수 오차 보정은 1차 (drift^2 항은 35분에서도 1 ns 미만)
+    int32_t dl = (int32_t)(local_us - (uint32_t)sync->anchor_local_us);
+    float corr = sync->offset_us + sync->drift_ppm * ((float)dl * 1.0e-6f);
+    int64_t week_us = (int64_t)TIME_SYNC_WEEK_S * 1000000;
+    int64_t tow = (int64_t)sync->anchor_tow_s * 1000000 + dl - (int64_t)lroundf(corr);
+    tow %= week_us;
+    if (tow < 0) {
+        tow += week_us;
+    }
+    *tow_us = (uint64_t)tow;
+
+    return true;
+}
+
+/**
+ * @brief 통계 조회
+ */
+const TimeSyncStats *time_sync_get_stats(const TimeSync *sync) {
+    if (sync == NULL) {
+        return NULL;
+    }
+
+    return &sync->stats;
+}
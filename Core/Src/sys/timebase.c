@@ -0,0 +1,247 @@
+/**
+ * @file timebase.c
+ * @brief 32비트 타이머 기반 64비트 마이크로초 시간축과 입력 캡처 구현
+ */
+
+#include "sys/timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 시간축 상태 (타이머 하나를 시스템 전체가 공유)
+ */
+static struct {
+    TIM_HandleTypeDef *htim;                   /**< 타이머 핸들 (NULL이면 초기화 전) */
+    volatile uint32_t high;                    /**< 기준값 이후 넘침 수 (상위 32비트) */
+    uint64_t base_us;                          /**< 마지막 분주비 재설정 시각 (us) */
+    TimebaseCaptureFn callback[TIMEBASE_CAPTURE_CHANNELS];
+    void *context[TIMEBASE_CAPTURE_CHANNELS];
+    TimebaseStats stats;
+} timebase;
+
+/**
+ * @brief APB1 타이머 클럭 (APB1 분주가 1이 아니면 PCLK1 x 2)
+ */
+static uint32_t timebase_timer_clock(void) {
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) ? pclk1 : 2u * pclk1;
+}
+
+/**
+ * @brief 현재 타이머 클럭에서 1 MHz가 되는 분주비
+ */
+static bool timebase_prescaler(uint32_t *psc) {
+    uint32_t clk = timebase_timer_clock();
+    if (clk < TIMEBASE_TICK_HZ || clk % TIMEBASE_TICK_HZ != 0) {
+        return false;
+    }
+
+    uint32_t div = clk / TIMEBASE_TICK_HZ;
+    if (div > 0x10000u) {
+        return false;
+    }
+    *psc = div - 1u;
+
+    return true;
+}
+
+/**
+ * @brief 카운터 값 하나를 64비트로 확장 (인터럽트가 막힌 상태에서 호출)
+ *
+ * 넘침 인터럽트가 아직 처리되지 않았으면(UIF 대기) 카운터 앞쪽 절반의 값은
+ * 넘침 이후의 값이므로 상위 32비트를 하나 더한다.
+ */
+static uint64_t timebase_extend(uint32_t count) {
+    uint32_t high = timebase.high;
+    if ((timebase.htim->Instance->SR & TIM_SR_UIF) != 0 && count < 0x80000000u) {
+        high++;
+    }
+
+    return timebase.base_us + ((uint64_t)high << 32) + count;
+}
+
+/**
+ * @brief 카운터를 0부터 분주비를 적용해 다시 시작 (넘침 인터럽트 없이)
+ */
+static void timebase_restart(TIM_TypeDef *tim, uint32_t psc) {
+    tim->PSC = psc;
+    tim->ARR = 0xFFFFFFFFu;
+    tim->CR1 |= TIM_CR1_URS;
+    tim->EGR = TIM_EGR_UG;
+    tim->SR = ~(uint32_t)TIM_SR_UIF;
+}
+
+/**
+ * @brief 시간축 초기화 및 시작
+ */
+bool timebase_init(TIM_HandleTypeDef *htim) {
+    if (htim == NULL || !IS_TIM_32B_COUNTER_INSTANCE(htim->Instance)) {
+        return false;
+    }
+
+    uint32_t psc;
+    if (!timebase_prescaler(&psc)) {
+        return false;
+    }
+
+    memset(&timebase, 0, sizeof(timebase));
+    htim->Init.Prescaler = psc;
+    htim->Init.Period = 0xFFFFFFFFu;
+    timebase_restart(htim->Instance, psc);
+    timebase.htim = htim;
+
+    if (HAL_TIM_Base_Start_IT(htim) != HAL_OK) {
+        timebase.htim = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 입력 캡처 채널 시작
+ */
+bool timebase_attach_capture(uint32_t channel, TimebaseCaptureFn callback, void *context) {
+    uint32_t idx = channel / 4u;
+    if (timebase.htim == NULL || channel % 4u != 0 || idx >= TIMEBASE_CAPTURE_CHANNELS) {
+        return false;
+    }
+
+    if (callback == NULL) {
+        HAL_TIM_IC_Stop_IT(timebase.htim, channel);
+        timebase.callback[idx] = NULL;
+        return true;
+    }
+
+    timebase.context[idx] = context;
+    timebase.callback[idx] = callback;
+
+    return HAL_TIM_IC_Start_IT(timebase.htim, channel) == HAL_OK;
+}
+
+/**
+ * @brief 현재 시각 (64비트 us)
+ */
+uint64_t timebase_now_us64(void) {
+    if (timebase.htim == NULL) {
+        return 0;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint64_t now = timebase_extend(timebase.htim->Instance->CNT);
+    __set_PRIMASK(primask);
+
+    return now;
+}
+
+/**
+ * @brief 현재 시각 하위 32비트
+ */
+uint32_t timebase_now_us(void) {
+    return (uint32_t)timebase_now_us64();
+}
+
+/**
+ * @brief 시스템 클럭 전환 후 분주비 재설정
+ */
+bool timebase_retune(void) {
+    uint32_t psc;
+    if (timebase.htim == NULL || !timebase_prescaler(&psc)) {
+        return false;
+    }
+
+    TIM_TypeDef *tim = timebase.htim->Instance;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    timebase.base_us = timebase_extend(tim->CNT);
+    timebase.high = 0;
+    timebase_restart(tim, psc);
+    __set_PRIMASK(primask);
+
+    timebase.htim->Init.Prescaler = psc;
+    timebase.stats.retunes++;
+
+    return true;
+}
+
+/**
+ * @brief 타이머가 멈춰 있던 시간 반영
+ */
+bool timebase_skip(uint64_t elapsed_us) {
+    if (timebase.htim == NULL) {
+        return false;
+    }
+
+    uint32_t psc;
+    bool ok = timebase_prescaler(&psc);
+    TIM_TypeDef *tim = timebase.htim->Instance;
+    if (!ok) {
+        psc = tim->PSC;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    timebase.base_us = timebase_extend(tim->CNT) + elapsed_us;
+    timebase.high = 0;
+    timebase_restart(tim, psc);
+    __set_PRIMASK(primask);
+
+    timebase.htim->Init.Prescaler = psc;
+
+    return ok;
+}
+
+/**
+ * @brief 갱신(넘침) 인터럽트 처리
+ */
+void timebase_handle_period_elapsed(TIM_HandleTypeDef *htim) {
+    if (htim == NULL || htim != timebase.htim) {
+        return;
+    }
+
+    // HAL이 UIF를 지운 뒤 호출하므로 여기서 넘침을 반영
+    timebase.high++;
+    timebase.stats.overflows++;
+}
+
+/**
+ * @brief 입력 캡처 인터럽트 처리
+ */
+void timebase_handle_capture(TIM_HandleTypeDef *htim) {
+    if (htim == NULL || htim != timebase.htim) {
+        return;
+    }
+
+    uint32_t idx;
+    switch (htim->Channel) {
+    case HAL_TIM_ACTIVE_CHANNEL_1: idx = 0; break;
+    case HAL_TIM_ACTIVE_CHANNEL_2: idx = 1; break;
+    case HAL_TIM_ACTIVE_CHANNEL_3: idx = 2; break;
+    case HAL_TIM_ACTIVE_CHANNEL_4: idx = 3; break;
+    default: return;
+    }
+
+    // HAL은 CCxIF만 지우므로 덮어쓰기(에지 손실) 플래그는 여기서 확인
+    uint32_t of_flag = (uint32_t)TIM_SR_CC1OF << idx;
+    if ((htim->Instance->SR & of_flag) != 0) {
+        htim->Instance->SR = ~of_flag;
+        timebase.stats.overcaptures[idx]++;
+    }
+
+    // HAL은 캡처 콜백을 넘침보다 먼저 처리하므로 대기 중인 UIF를 고려해 확장
+    uint32_t ccr = HAL_TIM_ReadCapturedValue(htim, idx * 4u);
+    uint64_t stamp = timebase_extend(ccr);
+    timebase.stats.captures[idx]++;
+
+    if (timebase.callback[idx] != NULL) {
+        timebase.callback[idx](stamp, timebase.context[idx]);
+    }
+}
+
+/**
+ * @brief 통계 조회
+ */
+const TimebaseStats *timebase_get_stats(void) {
+    return &timebase.stats;
+}
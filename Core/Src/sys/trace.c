@@ -0,0 +1,112 @@
+/**
+ * @file trace.c
+ * @brief ITM/SWO 이벤트 트레이스 구현
+ */
+
+#include "sys/trace.h"
+
+#ifdef TRACE_ENABLE
+
+#include "sys/mem_section.h"
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief 덤프 한 줄의 워드 수
+ */
+#define TRACE_DUMP_WORDS_PER_LINE 8u
+
+/**
+ * @brief 트레이스 링 (리셋 유지 영역, 멈춘 링은 리셋 뒤에도 덤프 가능)
+ */
+MEM_SECTION_RETAIN TraceRing trace_ring;
+
+/**
+ * @brief ITM 포트가 켜져 있는지 (trace_init에서 확인)
+ */
+bool trace_itm;
+
+/**
+ * @brief 링 비우고 기록 시작
+ */
+static void trace_reset(void) {
+    trace_ring.head = 0;
+    trace_ring.itm_dropped = 0;
+    trace_ring.magic = TRACE_RING_MAGIC;
+}
+
+/**
+ * @brief DWT 사이클 카운터 활성화, ITM 포트 확인, 링 초기화
+ */
+void trace_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // SWO 설정(TPIU, ITM 활성화, 포트 허용)은 디버거가 하므로 여기서는 확인만 함
+    trace_itm = (ITM->TCR & ITM_TCR_ITMENA_Msk) != 0 && (ITM->TER & (1u << TRACE_ITM_PORT)) != 0;
+
+    if (trace_ring.magic != TRACE_FROZEN_MAGIC) {
+        trace_reset();
+    }
+}
+
+/**
+ * @brief 링 기록 멈춤
+ */
+void trace_freeze(void) {
+    if (trace_ring.magic == TRACE_RING_MAGIC) {
+        trace_ring.magic = TRACE_FROZEN_MAGIC;
+    }
+}
+
+/**
+ * @brief 링이 멈춰 있는지
+ */
+bool trace_frozen(void) {
+    return trace_ring.magic == TRACE_FROZEN_MAGIC;
+}
+
+/**
+ * @brief 멈춘 링을 비우고 기록 재개
+ */
+void trace_release(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    trace_reset();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 링 내용을 오래된 것부터 출력
+ */
+void trace_dump(TraceWriteFn write) {
+    if (write == NULL || (trace_ring.magic != TRACE_RING_MAGIC && trace_ring.magic != TRACE_FROZEN_MAGIC)) {
+        return;
+    }
+
+    // 기록 중이면 덤프하는 동안 덮어쓰이지 않게 멈췄다가 원래 상태로 되돌림
+    uint32_t magic = trace_ring.magic;
+    trace_ring.magic = TRACE_FROZEN_MAGIC;
+
+    uint32_t head = trace_ring.head;
+    uint32_t count = (head < TRACE_RING_SIZE) ? head : TRACE_RING_SIZE;
+
+    char line[16 + TRACE_DUMP_WORDS_PER_LINE * 9u];
+    snprintf(line, sizeof(line), "trace n=%lu drop=%lu\r\n",
+             (unsigned long)count, (unsigned long)trace_ring.itm_dropped);
+    write(line);
+
+    for (uint32_t i = 0; i < count; i += TRACE_DUMP_WORDS_PER_LINE) {
+        int n = snprintf(line, sizeof(line), "T");
+        for (uint32_t k = i; k < count && k < i + TRACE_DUMP_WORDS_PER_LINE; k++) {
+            uint32_t word = trace_ring.words[(head - count + k) & (TRACE_RING_SIZE - 1u)];
+            n += snprintf(&line[n], sizeof(line) - (size_t)n, " %08lx", (unsigned long)word);
+        }
+        snprintf(&line[n], sizeof(line) - (size_t)n, "\r\n");
+        write(line);
+    }
+
+    trace_ring.magic = magic;
+}
+
+#endif /* TRACE_ENABLE */
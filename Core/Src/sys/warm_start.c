@@ -0,0 +1,150 @@
+/**
+ * @file warm_start.c
+ * @brief 필터 스냅숏 저장과 재시작 복구 구현
+ */
+
+#include "sys/warm_start.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief CRC가 덮는 길이 (crc 필드 앞까지)
+ */
+#define WARM_START_CRC_LEN ((uint32_t)offsetof(WarmStartSnapshot, crc))
+
+/**
+ * @brief 슬롯 검증 (식별값, 버전, 크기, CRC)
+ */
+static bool warm_start_valid(const WarmStartSnapshot *s, HwCrc *crc) {
+    return s->magic == WARM_START_MAGIC && s->version == WARM_START_VERSION &&
+           s->size == sizeof(WarmStartSnapshot) && s->crc == hw_crc32(crc, s, WARM_START_CRC_LEN);
+}
+
+/**
+ * @brief 스냅숏 저장
+ */
+bool warm_start_save(WarmStartStore *store, HwCrc *crc, EKF *ekf, uint32_t timestamp_us,
+                     const MagIronCal *mag_cal, uint8_t phase) {
+    if (store == NULL || ekf == NULL || !ekf->initialized || !ekf_flush_covariance(ekf)) {
+        return false;
+    }
+
+    // 유효한 슬롯 중 최신 순번 다음으로, 그 반대쪽 슬롯에 기록
+    uint32_t sequence = 0;
+    uint8_t target = 0;
+    for (uint8_t i = 0; i < WARM_START_SLOTS; i++) {
+        const WarmStartSnapshot *s = &store->slot[i];
+        if (warm_start_valid(s, crc) && s->sequence >= sequence) {
+            sequence = s->sequence;
+            target = (uint8_t)((i + 1u) % WARM_START_SLOTS);
+        }
+    }
+
+    WarmStartSnapshot *s = &store->slot[target];
+    s->magic = 0; // 기록 도중 리셋되면 이 슬롯은 무효
+    s->version = WARM_START_VERSION;
+    s->size = sizeof(WarmStartSnapshot);
+    s->sequence = sequence + 1u;
+    s->timestamp_us = timestamp_us;
+
+    memcpy(s->x, &ekf->x.data[0][0], sizeof(s->x));
+    memcpy(s->P, ekf->P.data, sizeof(s->P));
+    s->earth_mag_ned = ekf->earth_mag_ned;
+    s->drag_k = ekf->drag_k;
+
+    s->mag_valid = (mag_cal != NULL && mag_iron_cal_get_correction(mag_cal, &s->mag)) ? 1u : 0u;
+    if (!s->mag_valid) {
+        memset(&s->mag, 0, sizeof(s->mag));
+    }
+    s->phase = phase;
+    s->reserved = 0;
+
+    s->magic = WARM_START_MAGIC;
+    s->crc = hw_crc32(crc, s, WARM_START_CRC_LEN);
+
+    return true;
+}
+
+/**
+ * @brief 가장 최근의 유효한 스냅숏 검색
+ */
+const WarmStartSnapshot *warm_start_find(const WarmStartStore *store, HwCrc *crc) {
+    if (store == NULL) {
+        return NULL;
+    }
+
+    const WarmStartSnapshot *best = NULL;
+    for (uint8_t i = 0; i < WARM_START_SLOTS; i++) {
+        const WarmStartSnapshot *s = &store->slot[i];
+        if (warm_start_valid(s, crc) && (best == NULL || s->sequence > best->sequence)) {
+            best = s;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief 스냅숏으로 필터 복구
+ */
+bool warm_start_restore(EKF *ekf, const WarmStartSnapshot *snap, float gap_s, MagIronCal *mag_cal) {
+    if (ekf == NULL || snap == NULL || !(gap_s >= 0.0f)) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < EKF_STATE_DIM; i++) {
+        if (!isfinite(snap->x[i])) {
+            return false;
+        }
+    }
+    for (uint16_t i = 0; i < EKF_STATE_DIM; i++) {
+        if (!(snap->P[EKF_SYM_FN(index)(i, i)] > 0.0f)) {
+            return false;
+        }
+    }
+
+    float *x = &ekf->x.data[0][0];
+    memcpy(x, snap->x, sizeof(snap->x));
+    memcpy(ekf->P.data, snap->P, sizeof(snap->P));
+    ekf->earth_mag_ned = snap->earth_mag_ned;
+    ekf->drag_k = snap->drag_k;
+    ekf->lazy_dt = 0.0f;
+    ekf->bias_pending = 0;
+    memset(ekf->bias_coupling, 0, sizeof(ekf->bias_coupling));
+
+    // 리셋 동안의 운동은 알 수 없으므로 위치만 속도로 외삽하고 불확실성을 키움
+#if EKF_CONFIG_POSITION
+    x[EKF_STATE_POS_X] += x[EKF_STATE_VEL_X] * gap_s;
+    x[EKF_STATE_POS_Y] += x[EKF_STATE_VEL_Y] * gap_s;
+    x[EKF_STATE_POS_Z] += x[EKF_STATE_VEL_Z] * gap_s;
+#endif
+    for (uint16_t i = 0; i < EKF_STATE_DIM; i++) {
+        uint16_t k = EKF_SYM_FN(index)(i, i);
+        ekf->P.data[k] += ekf->Q.data[k] * gap_s;
+    }
+
+    if (mag_cal != NULL && snap->mag_valid) {
+        mag_iron_cal_set_correction(mag_cal, &snap->mag);
+    }
+
+    ekf->initialized = true;
+
+    // U-D 엔진이면 복구한 P로 다시 분해
+    return ekf_set_engine(ekf, ekf->engine);
+}
+
+/**
+ * @brief 저장소 무효화
+ */
+bool warm_start_invalidate(WarmStartStore *store) {
+    if (store == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < WARM_START_SLOTS; i++) {
+        store->slot[i].magic = 0;
+    }
+
+    return true;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file isa_table.c
+ * @brief ISA 기압-고도 구간 다항식 표 생성 프로그램 (호스트용)
+ *
+ * 표준 대기(ISA, 0..47 km 네 층)의 기압 → 지구 퍼텐셜 고도 역함수를 배정밀도로
+ * 계산하고 기하 고도로 바꾼 뒤, 구간 양 끝의 고도와 기울기로 3차 Hermite 계수를
+ * 만들어 Core/Src/sensors/baro_isa_table.c 를 표준 출력으로 생성한다.
+ * 구간 배치는 sensors/baro_altitude.h 를 그대로 사용한다.
+ * 생성 후 표준 오류로 구간 중간점들의 최대 오차를 출력한다.
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o isa_table Tools/baro/isa_table.c -lm
+ *   ./isa_table > Core/Src/sensors/baro_isa_table.c
+ */
+
+#include "sensors/baro_altitude.h"
+#include <stdio.h>
+#include <math.h>
+
+/**
+ * @brief ISA 상수
+ */
+#define ISA_R 287.05287               /**< 건조 공기 기체 상수 (J/(kg K)) */
+#define ISA_G0 9.80665                /**< 표준 중력 (m/s^2) */
+#define ISA_P0 101325.0               /**< 해수면 기압 (Pa) */
+#define ISA_EARTH_RADIUS 6356766.0    /**< 지구 퍼텐셜 고도 변환 반지름 (m) */
+
+/**
+ * @brief 대기층 (기저 지구 퍼텐셜 고도 m, 기저 온도 K, 기온 감률 K/m)
+ */
+static const double isa_layers[][3] = {
+    {     0.0, 288.15, -0.0065 },
+    { 11000.0, 216.65,  0.0    },
+    { 20000.0, 216.65,  0.001  },
+    { 32000.0, 228.65,  0.0028 }
+};
+
+#define ISA_LAYER_COUNT (int)(sizeof(isa_layers) / sizeof(isa_layers[0]))
+
+/**
+ * @brief 층 기저 기압 (Pa)
+ */
+static double isa_base_pressure[ISA_LAYER_COUNT];
+
+/**
+ * @brief 층 기저 기압 계산
+ */
+static void isa_init(void) {
+    isa_base_pressure[0] = ISA_P0;
+    for (int i = 1; i < ISA_LAYER_COUNT; i++) {
+        double dh = isa_layers[i][0] - isa_layers[i - 1][0];
+        double tb = isa_layers[i - 1][1];
+        double l = isa_layers[i - 1][2];
+        double pb = isa_base_pressure[i - 1];
+        isa_base_pressure[i] = (l == 0.0)
+            ? pb * exp(-ISA_G0 * dh / (ISA_R * tb))
+            : pb * pow((tb + l * dh) / tb, -ISA_G0 / (ISA_R * l));
+    }
+}
+
+/**
+ * @brief 기압 → 기하 고도와 기울기 dz/dp
+ */
+static void isa_altitude(double p, double *z, double *dz_dp) {
+    int i = 0;
+    while (i + 1 < ISA_LAYER_COUNT && p < isa_base_pressure[i + 1]) {
+        i++;
+    }
+    double hb = isa_layers[i][0];
+    double tb = isa_layers[i][1];
+    double l = isa_layers[i][2];
+    double pb = isa_base_pressure[i];
+
+    // 지구 퍼텐셜 고도와 그 고도의 온도
+    double h = (l == 0.0)
+        ? hb - ISA_R * tb / ISA_G0 * log(p / pb)
+        : hb + tb / l * (pow(p / pb, -ISA_R * l / ISA_G0) - 1.0);
+    double t = tb + l * (h - hb);
+    double dh_dp = -ISA_R * t / (ISA_G0 * p);
+
+    // 기하 고도 z = r h / (r - h)
+    double r = ISA_EARTH_RADIUS;
+    *z = r * h / (r - h);
+    *dz_dp = r * r / ((r - h) * (r - h)) * dh_dp;
+}
+
+/**
+ * @brief 구간 k의 기압 범위
+ */
+static void isa_segment(int k, double *p_a, double *p_b) {
+    int octave = BARO_ISA_OCTAVE_MIN + (k >> BARO_ISA_SUBDIV_BITS);
+    int sub = k & ((1 << BARO_ISA_SUBDIV_BITS) - 1);
+    double base = ldexp(1.0, octave);
+    double step = base / (1 << BARO_ISA_SUBDIV_BITS);
+    *p_a = base + sub * step;
+    *p_b = *p_a + step;
+}
+
+int main(void) {
+    isa_init();
+
+    static double coeff[BARO_ISA_SEGMENTS][4];
+    for (int k = 0; k < BARO_ISA_SEGMENTS; k++) {
+        double p_a, p_b;
+        isa_segment(k, &p_a, &p_b);
+        double w = p_b - p_a;
+        double z_a, d_a, z_b, d_b;
+        isa_altitude(p_a, &z_a, &d_a);
+        isa_altitude(p_b, &z_b, &d_b);
+
+        // Hermite: h(0) = z_a, h(1) = z_b, h'(0) = w d_a, h'(1) = w d_b
+        coeff[k][0] = z_a;
+        coeff[k][1] = w * d_a;
+        coeff[k][2] = 3.0 * (z_b - z_a) - 2.0 * w * d_a - w * d_b;
+        coeff[k][3] = 2.0 * (z_a - z_b) + w * d_a + w * d_b;
+    }
+
+    printf("/**\n");
+    printf(" * @file baro_isa_table.c\n");
+    printf(" * @brief ISA 기압-고도 구간 다항식 표 (Tools/baro/isa_table.c 생성 파일, 직접 수정 금지)\n");
+    printf(" *\n");
+    printf(" * 모델: ISA 0..47 km (기하 고도), 3차 Hermite\n");
+    printf(" * 구간: 기압 2^%d..2^%d Pa, 옥타브당 %d구간\n", BARO_ISA_OCTAVE_MIN,
+           BARO_ISA_OCTAVE_MIN + BARO_ISA_OCTAVES, 1 << BARO_ISA_SUBDIV_BITS);
+    printf(" */\n\n");
+    printf("#include \"sensors/baro_altitude.h\"\n");
+    printf("#include \"sys/mem_section.h\"\n\n");
+    printf("MEM_RAMDATA(baro_isa_table) const float baro_isa_table[BARO_ISA_SEGMENTS][4] = {\n");
+    for (int k = 0; k < BARO_ISA_SEGMENTS; k++) {
+        double p_a, p_b;
+        isa_segment(k, &p_a, &p_b);
+        printf("    /* %6.0f Pa */ { %.8ef, %.8ef, %.8ef, %.8ef }%s\n", p_a,
+               (float)coeff[k][0], (float)coeff[k][1], (float)coeff[k][2], (float)coeff[k][3],
+               (k + 1 < BARO_ISA_SEGMENTS) ? "," : "");
+    }
+    printf("};\n");
+
+    // 구간 내부 점에서 단정밀도 계수로 계산한 오차
+    double err = 0.0;
+    for (int k = 0; k < BARO_ISA_SEGMENTS; k++) {
+        double p_a, p_b;
+        isa_segment(k, &p_a, &p_b);
+        for (int j = 1; j < 8; j++) {
+            float t = (float)j / 8.0f;
+            const float c[4] = { (float)coeff[k][0], (float)coeff[k][1], (float)coeff[k][2], (float)coeff[k][3] };
+            float h = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+            double z, dz;
+            isa_altitude(p_a + t * (p_b - p_a), &z, &dz);
+            err = fmax(err, fabs(h - z));
+        }
+    }
+    fprintf(stderr, "표 최대 오차: %.4f m\n", err);
+
+    return 0;
+}
@@ -0,0 +1,369 @@
+/**
+ * @file bench_compare.c
+ * @brief 벤치마크 기준 기록과 새 결과 비교 (성능/스택 저하 보고)
+ *
+ * 보드 벤치마크(sys/bench.h)의 UART 캡처나 호스트 벤치마크(ekf_bench -c) 출력에서
+ * "BENCH," 줄을 읽어 기준 기록 파일의 실행과 커널별로 비교한다. 기준 기록 파일은 여러
+ * 실행(BENCH,begin ~ BENCH,end)을 이어 붙인 텍스트이며, 새 실행과 같은 종류(호스트/보드),
+ * 컴파일러, 부동소수점 모드, 빌드 플래그를 가진 마지막 실행을 기준으로 고른다 (-r로 빌드
+ * ID 지정 가능). 같은 빌드 조건이 없으면 같은 종류의 마지막 실행과 비교하고 경고한다.
+ *
+ * 커널별 판단:
+ * - 느려짐: 평균이 -p 퍼센트보다 많이 늘었고 Welch t 값이 -z보다 큼 (표본 수는 보드는
+ *   반복 횟수, 호스트는 측정 블록 수). 양쪽 표준편차가 0이면 비율만으로 판단한다.
+ * - 스택 증가: 커널 스택 깊이(보드만)가 -s 바이트보다 많이 늘어남
+ * - 기준에 없는 커널은 new, 새 결과에 없는 커널은 missing으로 표시만 한다.
+ *
+ * 출력: 커널별 기준/새 평균, 변화율, t 값, 스택 변화와 판정 (표준 출력)
+ * 종료 코드: 0 저하 없음, 1 저하 있음, 2 입력 오류
+ * -u를 주면 저하가 없을 때 새 실행을 기준 기록 파일 끝에 덧붙인다.
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -o bench_compare Tools/bench/bench_compare.c -lm
+ *
+ * 실행:
+ *   ./bench_compare [-p percent] [-z t] [-s bytes] [-r build_id] [-u] baseline.txt new.txt
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+/**
+ * @brief 한도
+ */
+#define COMPARE_MAX_RUNS 256     /**< 기준 기록 파일의 최대 실행 수 */
+#define COMPARE_MAX_KERNELS 48   /**< 실행당 최대 커널 수 */
+#define COMPARE_NAME_MAX 48      /**< 커널 이름 최대 길이 */
+#define COMPARE_FIELD_MAX 160    /**< 빌드 정보 필드 최대 길이 */
+#define COMPARE_LINE_MAX 512     /**< 입력 줄 최대 길이 */
+
+/**
+ * @brief 기본 판단 기준
+ */
+#define COMPARE_DEFAULT_PERCENT 5.0  /**< 느려짐 판단 변화율 (%) */
+#define COMPARE_DEFAULT_T 3.0        /**< 느려짐 판단 t 값 */
+#define COMPARE_DEFAULT_STACK 0u     /**< 스택 증가 허용 (바이트) */
+
+/**
+ * @brief 커널 측정 결과
+ */
+typedef struct {
+    char name[COMPARE_NAME_MAX];
+    uint32_t iterations;        /**< 반복 횟수 */
+    double min;                 /**< 최소 */
+    double max;                 /**< 최대 */
+    double mean;                /**< 평균 (사이클 또는 ns) */
+    double stddev;              /**< 표준편차 */
+    uint32_t stack;             /**< 스택 깊이 (바이트, 0이면 측정 안 함) */
+} CompareKernel;
+
+/**
+ * @brief 실행 한 번
+ */
+typedef struct {
+    char id[COMPARE_FIELD_MAX];         /**< 빌드 ID */
+    char compiler[COMPARE_FIELD_MAX];   /**< 컴파일러 버전 */
+    char mode[COMPARE_FIELD_MAX];       /**< 부동소수점 모드 */
+    char flags[COMPARE_FIELD_MAX];      /**< 빌드 플래그 */
+    bool host;                          /**< 호스트 실행 */
+    uint32_t block;                     /**< 호스트 측정 블록 크기 */
+    uint32_t count;                     /**< 커널 수 */
+    CompareKernel kernel[COMPARE_MAX_KERNELS];
+} CompareRun;
+
+static CompareRun compare_runs[COMPARE_MAX_RUNS];
+static CompareRun compare_new;
+
+/**
+ * @brief 문자열 필드 복사 (잘림 허용, 줄 끝 문자 제거)
+ */
+static void compare_copy(char *dst, const char *src, size_t size) {
+    snprintf(dst, size, "%s", (src != NULL) ? src : "");
+    dst[strcspn(dst, "\r\n")] = '\0';
+}
+
+/**
+ * @brief BENCH 줄 하나 처리 (p는 "BENCH," 뒤)
+ *
+ * @return int 1 실행이 끝남, 0 계속
+ */
+static int compare_parse_line(char *p, CompareRun *run, bool *open) {
+    p[strcspn(p, "\r\n")] = '\0';
+
+    if (strncmp(p, "begin,", 6) == 0) {
+        memset(run, 0, sizeof(CompareRun));
+        char *id = strtok(p + 6, ",");
+        char *kind = strtok(NULL, ",");
+        char *block = strtok(NULL, ",");
+        compare_copy(run->id, id, sizeof(run->id));
+        run->host = (kind != NULL && strcmp(kind, "host") == 0);
+        run->block = (run->host && block != NULL) ? (uint32_t)strtoul(block, NULL, 10) : 0u;
+        *open = true;
+        return 0;
+    }
+    if (!*open) {
+        return 0;
+    }
+    if (strncmp(p, "build,", 6) == 0) {
+        // 플래그는 쉼표를 포함할 수 있으므로 줄 끝까지
+        char *compiler = p + 6;
+        char *mode = strchr(compiler, ',');
+        char *flags = (mode != NULL) ? strchr(mode + 1, ',') : NULL;
+        if (mode != NULL) {
+            *mode++ = '\0';
+        }
+        if (flags != NULL) {
+            *flags++ = '\0';
+        }
+        compare_copy(run->compiler, compiler, sizeof(run->compiler));
+        compare_copy(run->mode, mode, sizeof(run->mode));
+        compare_copy(run->flags, flags, sizeof(run->flags));
+        return 0;
+    }
+    if (strncmp(p, "end,", 4) == 0 || strcmp(p, "end") == 0) {
+        *open = false;
+        return 1;
+    }
+    if (strncmp(p, "golden", 6) == 0) {
+        return 0;
+    }
+
+    char *comma = strchr(p, ',');
+    if (comma == NULL || run->count >= COMPARE_MAX_KERNELS) {
+        return 0;
+    }
+    *comma = '\0';
+    CompareKernel *k = &run->kernel[run->count];
+    double v[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    int n = sscanf(comma + 1, "%lf,%lf,%lf,%lf,%lf,%lf", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]);
+    if (n < 4) {
+        return 0;
+    }
+    compare_copy(k->name, p, sizeof(k->name));
+    k->iterations = (uint32_t)v[0];
+    k->min = v[1];
+    k->max = v[2];
+    k->mean = v[3];
+    k->stddev = (n >= 5) ? v[4] : 0.0;
+    k->stack = (n >= 6) ? (uint32_t)v[5] : 0u;
+    run->count++;
+    return 0;
+}
+
+/**
+ * @brief 파일에서 실행 읽기 (BENCH 줄 앞의 잡음과 다른 줄은 무시)
+ *
+ * @return int 읽은 완전한 실행 수 (-1 파일 오류)
+ */
+static int compare_read(const char *path, CompareRun *runs, int max_runs) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    char line[COMPARE_LINE_MAX];
+    int count = 0;
+    bool open = false;
+    while (fgets(line, sizeof(line), f) != NULL && count < max_runs) {
+        char *p = strstr(line, "BENCH,");
+        if (p != NULL && compare_parse_line(p + 6, &runs[count], &open) == 1) {
+            count++;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+/**
+ * @brief 같은 빌드 조건인지
+ */
+static bool compare_same_build(const CompareRun *a, const CompareRun *b) {
+    return a->host == b->host && strcmp(a->compiler, b->compiler) == 0 && strcmp(a->mode, b->mode) == 0 &&
+           strcmp(a->flags, b->flags) == 0;
+}
+
+/**
+ * @brief 기준 실행 선택
+ */
+static const CompareRun *compare_select(const CompareRun *runs, int count, const CompareRun *run,
+                                        const char *id) {
+    for (int i = count - 1; i >= 0; i--) {
+        if (id != NULL ? strcmp(runs[i].id, id) == 0 : compare_same_build(&runs[i], run)) {
+            return &runs[i];
+        }
+    }
+    if (id != NULL) {
+        return NULL;
+    }
+    for (int i = count - 1; i >= 0; i--) {
+        if (runs[i].host == run->host) {
+            fprintf(stderr, "경고: 같은 빌드 조건의 기준이 없어 %s와 비교 (컴파일러/모드/플래그 다름)\n",
+                    runs[i].id);
+            return &runs[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 커널 표본 수 (보드는 반복마다, 호스트는 블록마다 한 표본)
+ */
+static double compare_samples(const CompareRun *run, const CompareKernel *k) {
+    if (run->host && run->block > 0u) {
+        return (double)((k->iterations + run->block - 1u) / run->block);
+    }
+    return (double)k->iterations;
+}
+
+/**
+ * @brief 이름으로 커널 찾기
+ */
+static const CompareKernel *compare_find(const CompareRun *run, const char *name) {
+    for (uint32_t i = 0; i < run->count; i++) {
+        if (strcmp(run->kernel[i].name, name) == 0) {
+            return &run->kernel[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 새 실행을 기준 기록 파일 끝에 덧붙임
+ */
+static bool compare_append(const char *path, const CompareRun *run) {
+    FILE *f = fopen(path, "a");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+    if (run->host) {
+        fprintf(f, "BENCH,begin,%s,host,%u\n", run->id, run->block);
+    } else {
+        fprintf(f, "BENCH,begin,%s\n", run->id);
+    }
+    fprintf(f, "BENCH,build,%s,%s,%s\n", run->compiler, run->mode, run->flags);
+    for (uint32_t i = 0; i < run->count; i++) {
+        const CompareKernel *k = &run->kernel[i];
+        fprintf(f, "BENCH,%s,%u,%.1f,%.1f,%.1f,%.1f,%u\n", k->name, k->iterations, k->min, k->max, k->mean,
+                k->stddev, k->stack);
+    }
+    fprintf(f, "BENCH,end,%u\n", run->count);
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    double percent = COMPARE_DEFAULT_PERCENT;
+    double t_limit = COMPARE_DEFAULT_T;
+    uint32_t stack_limit = COMPARE_DEFAULT_STACK;
+    const char *id = NULL;
+    bool update = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "p:z:s:r:u")) != -1) {
+        switch (opt) {
+            case 'p': percent = atof(optarg); break;
+            case 'z': t_limit = atof(optarg); break;
+            case 's': stack_limit = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'r': id = optarg; break;
+            case 'u': update = true; break;
+            default:
+                fprintf(stderr, "사용법: %s [-p percent] [-z t] [-s bytes] [-r build_id] [-u] baseline.txt new.txt\n",
+                        argv[0]);
+                return 2;
+        }
+    }
+    if (argc - optind != 2) {
+        fprintf(stderr, "사용법: %s [-p percent] [-z t] [-s bytes] [-r build_id] [-u] baseline.txt new.txt\n",
+                argv[0]);
+        return 2;
+    }
+
+    int news = compare_read(argv[optind + 1], &compare_new, 1);
+    if (news <= 0) {
+        fprintf(stderr, "%s: 완전한 실행(BENCH,begin ~ BENCH,end)이 없음\n", argv[optind + 1]);
+        return 2;
+    }
+
+    // 기준 기록 파일이 아직 없으면 -u로 첫 기준을 만든다
+    FILE *probe = fopen(argv[optind], "r");
+    int count = 0;
+    if (probe != NULL) {
+        fclose(probe);
+        count = compare_read(argv[optind], compare_runs, COMPARE_MAX_RUNS);
+        if (count < 0) {
+            return 2;
+        }
+    }
+    const CompareRun *base = compare_select(compare_runs, count, &compare_new, id);
+    if (base == NULL) {
+        if (update && id == NULL) {
+            printf("기준 없음: %s를 첫 기준으로 기록\n", compare_new.id);
+            return compare_append(argv[optind], &compare_new) ? 0 : 2;
+        }
+        fprintf(stderr, "%s: 비교할 기준 실행이 없음\n", argv[optind]);
+        return 2;
+    }
+
+    const char *unit = compare_new.host ? "ns" : "cyc";
+    printf("기준 %s (%s, %s) -> 새 %s (%s, %s)\n", base->id, base->compiler, base->mode, compare_new.id,
+           compare_new.compiler, compare_new.mode);
+    printf("%-28s %12s %12s %8s %8s %13s  %s\n", "kernel", "base", "new", "change", "t", "stack", "result");
+
+    uint32_t slower = 0;
+    uint32_t stack_grew = 0;
+    for (uint32_t i = 0; i < compare_new.count; i++) {
+        const CompareKernel *k = &compare_new.kernel[i];
+        const CompareKernel *b = compare_find(base, k->name);
+        if (b == NULL) {
+            printf("%-28s %12s %9.1f%3s %8s %8s %13s  new\n", k->name, "-", k->mean, unit, "-", "-", "-");
+            continue;
+        }
+
+        double change = (b->mean > 0.0) ? 100.0 * (k->mean - b->mean) / b->mean : 0.0;
+        double se = sqrt(k->stddev * k->stddev / compare_samples(&compare_new, k) +
+                         b->stddev * b->stddev / compare_samples(base, b));
+        double t = (se > 0.0) ? (k->mean - b->mean) / se : ((k->mean != b->mean) ? INFINITY : 0.0);
+
+        const char *result = "ok";
+        if (change > percent && t > t_limit) {
+            result = "SLOWER";
+            slower++;
+        } else if (change < -percent && t < -t_limit) {
+            result = "faster";
+        }
+
+        char stack[24] = "-";
+        bool grew = false;
+        if (k->stack > 0u && b->stack > 0u) {
+            snprintf(stack, sizeof(stack), "%u->%u", b->stack, k->stack);
+            grew = k->stack > b->stack + stack_limit;
+        }
+        if (grew) {
+            stack_grew++;
+        }
+        printf("%-28s %9.1f%3s %9.1f%3s %+7.1f%% %8.1f %13s  %s%s\n", k->name, b->mean, unit, k->mean, unit,
+               change, t, stack, result, grew ? " STACK" : "");
+    }
+    for (uint32_t i = 0; i < base->count; i++) {
+        if (compare_find(&compare_new, base->kernel[i].name) == NULL) {
+            printf("%-28s %9.1f%3s %12s %8s %8s %13s  missing\n", base->kernel[i].name, base->kernel[i].mean, unit,
+                   "-", "-", "-", "-");
+        }
+    }
+
+    printf("느려진 커널 %u개, 스택 증가 %u개 (기준: +%.1f%%, t > %.1f, 스택 +%u B)\n", slower, stack_grew,
+           percent, t_limit, stack_limit);
+    if (slower > 0u || stack_grew > 0u) {
+        return 1;
+    }
+    if (update && !compare_append(argv[optind], &compare_new)) {
+        return 2;
+    }
+    return 0;
+}
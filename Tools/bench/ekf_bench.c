@@ -0,0 +1,318 @@
+/**
+ * @file ekf_bench.c
+ * @brief 호스트용 수학/EKF 라이브러리 성능 측정 프로그램
+ *
+ * Core/Src/math 와 Core/Src/ekf 의 소스를 수정 없이 링크하여
+ * 고정 시드 합성 입력에 대한 연산당 시간(ns/op)과 처리량(ops/s)을 출력한다.
+ * 펌웨어 반영 전 성능 저하를 확인하는 용도이다.
+ *
+ * -c를 주면 보드 벤치마크(sys/bench.h)와 같은 "BENCH," CSV 줄로 출력한다. 최소/최대/평균/
+ * 표준편차는 측정 블록별 ns/op이며 스택 열은 0(측정 안 함)이다. 시작 줄은
+ * BENCH,begin,<빌드 ID>,host,<블록 크기>이다. 결과는
+ * Tools/bench/bench_compare.c로 기준 기록과 비교한다.
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o ekf_bench Tools/bench/ekf_bench.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c -lm
+ *   (기록용: -DBENCH_BUILD_ID=\"$(git rev-parse --short HEAD)\" -DBENCH_BUILD_FLAGS=\"-O2\" 추가)
+ *
+ * 실행:
+ *   ./ekf_bench [-c] [반복 횟수 배율]
+ */
+
+#include "math/matrix.h"
+#include "math/quaternion.h"
+#include "ekf/ekf.h"
+#include "math/fp_mode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief 결과에 함께 찍을 빌드 ID와 빌드 플래그 (보드 벤치마크와 같은 매크로)
+ */
+#ifndef BENCH_BUILD_ID
+#define BENCH_BUILD_ID "unknown"
+#endif
+#ifndef BENCH_BUILD_FLAGS
+#define BENCH_BUILD_FLAGS "unknown"
+#endif
+
+/**
+ * @brief 합성 입력 풀 크기 (입력이 반복되며 순환)
+ */
+#define BENCH_POOL_SIZE 64
+
+/**
+ * @brief 측정 블록 크기 (블록마다 설정 함수로 상태를 초기화하며, 설정 시간은 제외)
+ */
+#define BENCH_BLOCK_SIZE 1000
+
+/**
+ * @brief 난수 생성기 고정 시드
+ */
+#define BENCH_SEED 0x12345678u
+
+/**
+ * @brief 측정 대상 벤치마크
+ */
+typedef struct {
+    const char *name;                   /**< 벤치마크 이름 */
+    uint32_t iterations;                /**< 기본 반복 횟수 */
+    void (*setup)(void);                /**< 블록 시작 전 상태 초기화 (NULL 가능) */
+    void (*run)(uint32_t i);            /**< 연산 1회 수행 */
+} Benchmark;
+
+/**
+ * @brief 최적화로 연산이 제거되지 않도록 결과를 누적하는 변수
+ */
+static volatile float bench_sink;
+
+static uint32_t bench_rng_state = BENCH_SEED;
+
+/**
+ * @brief xorshift32 난수 (-0.5 ~ 0.5)
+ */
+static float bench_random(void) {
+    uint32_t x = bench_rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench_rng_state = x;
+    return (float)(x >> 8) / 16777216.0f - 0.5f;
+}
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* ---------------------------------------------------------------------------
+ * 합성 입력
+ * ------------------------------------------------------------------------- */
+
+static Matrix bench_mat_a[BENCH_POOL_SIZE / 8];
+static Matrix bench_mat_b[BENCH_POOL_SIZE / 8];
+static Matrix bench_mat_spd[BENCH_POOL_SIZE / 8];
+static Matrix bench_mat_result;
+
+static Quaternion bench_quat[BENCH_POOL_SIZE];
+static Vector3f bench_gyro[BENCH_POOL_SIZE];
+static Vector3f bench_accel[BENCH_POOL_SIZE];
+static Vector3f bench_gps_pos[BENCH_POOL_SIZE];
+static Vector3f bench_gps_vel[BENCH_POOL_SIZE];
+static Vector3f bench_mag[BENCH_POOL_SIZE];
+static float bench_baro[BENCH_POOL_SIZE];
+
+static EKF bench_ekf;
+
+/**
+ * @brief 고정 시드로 모든 합성 입력 생성
+ */
+static void bench_generate_inputs(void) {
+    for (uint8_t n = 0; n < BENCH_POOL_SIZE / 8; n++) {
+        bench_mat_a[n] = matrix_create(16, 16);
+        bench_mat_b[n] = matrix_create(16, 16);
+        for (uint8_t i = 0; i < 16; i++) {
+            for (uint8_t j = 0; j < 16; j++) {
+                matrix_set(&bench_mat_a[n], i, j, bench_random());
+                matrix_set(&bench_mat_b[n], i, j, bench_random());
+            }
+        }
+
+        // 역행렬 입력: 대각 우세 6x6 (GPS 혁신 공분산 크기)
+        bench_mat_spd[n] = matrix_create(6, 6);
+        for (uint8_t i = 0; i < 6; i++) {
+            for (uint8_t j = 0; j <= i; j++) {
+                float v = 0.1f * bench_random();
+                matrix_set(&bench_mat_spd[n], i, j, v);
+                matrix_set(&bench_mat_spd[n], j, i, v);
+            }
+            matrix_set(&bench_mat_spd[n], i, i, 2.0f + bench_random());
+        }
+    }
+
+    for (uint32_t n = 0; n < BENCH_POOL_SIZE; n++) {
+        bench_quat[n] = quaternion_from_euler(bench_random(), bench_random(), 6.0f * bench_random());
+        bench_gyro[n] = vector3f_create(0.1f * bench_random(), 0.1f * bench_random(), 0.1f * bench_random());
+        bench_accel[n] = vector3f_create(0.5f * bench_random(), 0.5f * bench_random(),
+                                         9.80665f + 0.5f * bench_random());
+        bench_gps_pos[n] = vector3f_create(2.0f * bench_random(), 2.0f * bench_random(), 2.0f * bench_random());
+        bench_gps_vel[n] = vector3f_create(0.2f * bench_random(), 0.2f * bench_random(), 0.2f * bench_random());
+        bench_mag[n] = vector3f_create(0.29f + 0.05f * bench_random(), -0.05f + 0.05f * bench_random(),
+                                       0.42f + 0.05f * bench_random());
+        bench_baro[n] = bench_random();
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 벤치마크 본체
+ * ------------------------------------------------------------------------- */
+
+static void bench_matrix_multiply(uint32_t i) {
+    uint32_t n = i % (BENCH_POOL_SIZE / 8);
+    matrix_multiply(&bench_mat_a[n], &bench_mat_b[n], &bench_mat_result);
+    bench_sink += bench_mat_result.data[0];
+}
+
+static void bench_matrix_inverse(uint32_t i) {
+    uint32_t n = i % (BENCH_POOL_SIZE / 8);
+    matrix_inverse(&bench_mat_spd[n], &bench_mat_result);
+    bench_sink += bench_mat_result.data[0];
+}
+
+static void bench_quaternion_rotate_vector(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    Vector3f v = quaternion_rotate_vector(bench_quat[n], bench_accel[n]);
+    bench_sink += v.x;
+}
+
+/**
+ * @brief 매 블록마다 동일한 초기 상태에서 필터 시작 (P 발산 방지)
+ */
+static void bench_ekf_setup(void) {
+    ekf_init(&bench_ekf);
+    ekf_set_initial_state(&bench_ekf, vector3f_zero(), vector3f_zero(), bench_quat[0]);
+    ekf_set_process_noise(&bench_ekf, 0.01f, 0.1f, 0.01f, 0.001f, 0.01f);
+}
+
+static void bench_ekf_predict(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_predict(&bench_ekf, bench_gyro[n], bench_accel[n], 0.01f);
+}
+
+static void bench_ekf_update_gps(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_gps(&bench_ekf, bench_gps_pos[n], false, bench_gps_vel[n]);
+}
+
+static void bench_ekf_update_gps_vel(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_gps(&bench_ekf, bench_gps_pos[n], true, bench_gps_vel[n]);
+}
+
+static void bench_ekf_update_baro(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_baro(&bench_ekf, bench_baro[n]);
+}
+
+static void bench_ekf_update_mag(uint32_t i) {
+    uint32_t n = i % BENCH_POOL_SIZE;
+    ekf_update_mag(&bench_ekf, bench_mag[n]);
+}
+
+static const Benchmark bench_table[] = {
+    {"matrix_multiply 16x16",       20000,  NULL,               bench_matrix_multiply},
+    {"matrix_inverse 6x6",          50000,  NULL,               bench_matrix_inverse},
+    {"quaternion_rotate_vector",    2000000, NULL,              bench_quaternion_rotate_vector},
+    {"ekf_predict",                 100000, bench_ekf_setup,    bench_ekf_predict},
+    {"ekf_update_gps (pos)",        100000, bench_ekf_setup,    bench_ekf_update_gps},
+    {"ekf_update_gps (pos+vel)",    100000, bench_ekf_setup,    bench_ekf_update_gps_vel},
+    {"ekf_update_baro",             200000, bench_ekf_setup,    bench_ekf_update_baro},
+    {"ekf_update_mag",              100000, bench_ekf_setup,    bench_ekf_update_mag},
+};
+
+/**
+ * @brief 벤치마크 1개 실행 후 결과 출력
+ *
+ * 설정 함수 호출 시간은 측정에서 제외한다.
+ *
+ * @param b 벤치마크
+ * @param scale 반복 횟수 배율
+ * @param csv BENCH CSV 줄로 출력
+ */
+static void bench_execute(const Benchmark *b, double scale, bool csv) {
+    uint32_t iterations = (uint32_t)(b->iterations * scale);
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    uint64_t elapsed = 0;
+    uint32_t done = 0;
+    uint32_t blocks = 0;
+    double block_min = 0.0;
+    double block_max = 0.0;
+    double block_sum_sq = 0.0;
+    double block_sum = 0.0;
+    while (done < iterations) {
+        uint32_t block = iterations - done;
+        if (block > BENCH_BLOCK_SIZE) {
+            block = BENCH_BLOCK_SIZE;
+        }
+
+        if (b->setup != NULL) {
+            b->setup();
+        }
+
+        uint64_t start = bench_now_ns();
+        for (uint32_t i = 0; i < block; i++) {
+            b->run(done + i);
+        }
+        uint64_t block_ns = bench_now_ns() - start;
+        elapsed += block_ns;
+        done += block;
+
+        double per_op = (double)block_ns / (double)block;
+        if (blocks == 0 || per_op < block_min) {
+            block_min = per_op;
+        }
+        if (blocks == 0 || per_op > block_max) {
+            block_max = per_op;
+        }
+        block_sum += per_op;
+        block_sum_sq += per_op * per_op;
+        blocks++;
+    }
+
+    double ns_per_op = (double)elapsed / (double)iterations;
+    if (csv) {
+        double var = (blocks > 1) ? (block_sum_sq - block_sum * block_sum / blocks) / (blocks - 1) : 0.0;
+        printf("BENCH,%s,%lu,%.1f,%.1f,%.1f,%.1f,0\n", b->name, (unsigned long)iterations, block_min, block_max,
+               ns_per_op, (var > 0.0) ? sqrt(var) : 0.0);
+        return;
+    }
+    double ops_per_s = ns_per_op > 0.0 ? 1.0e9 / ns_per_op : 0.0;
+    printf("%-28s %10lu %12.1f %14.0f\n", b->name, (unsigned long)iterations, ns_per_op, ops_per_s);
+}
+
+int main(int argc, char **argv) {
+    double scale = 1.0;
+    bool csv = false;
+    int arg = 1;
+    if (arg < argc && strcmp(argv[arg], "-c") == 0) {
+        csv = true;
+        arg++;
+    }
+    if (arg < argc) {
+        scale = atof(argv[arg]);
+        if (scale <= 0.0) {
+            fprintf(stderr, "usage: %s [-c] [iteration scale > 0]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    bench_generate_inputs();
+
+    const size_t count = sizeof(bench_table) / sizeof(bench_table[0]);
+    if (csv) {
+        printf("BENCH,begin,%s,host,%u\n", BENCH_BUILD_ID, (unsigned)BENCH_BLOCK_SIZE);
+        printf("BENCH,build,%s,%s,%s\n", __VERSION__, FP_MODE_NAME, BENCH_BUILD_FLAGS);
+    } else {
+        printf("%-28s %10s %12s %14s\n", "benchmark", "iters", "ns/op", "ops/s");
+    }
+    for (size_t i = 0; i < count; i++) {
+        bench_execute(&bench_table[i], scale, csv);
+    }
+    if (csv) {
+        printf("BENCH,end,%u\n", (unsigned)count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file golden_check.c
+ * @brief 표준 재생(ekf/ekf_golden.h) 호스트/보드 비트 일치 확인 프로그램
+ *
+ * Core/Src/ekf의 표준 재생을 호스트에서 돌려 보드 벤치마크 빌드의 "BENCH,golden" 줄과
+ * 비교한다. 캡처 파일이 없으면 호스트 결과만 같은 형식으로 출력한다 (최적화 전후 비교용).
+ * 보드와 비교할 때는 양쪽을 같은 FP_DETERMINISTIC 설정(math/fp_mode.h)으로 빌드해야 하며,
+ * 호스트는 FMA 없는 기본 x86-64 대상(-march=native, -mfma 금지)으로 빌드한다.
+ *
+ * 출력:
+ * - 표준 출력: 호스트 결과 (BENCH,golden / golden_x / golden_p 줄)
+ * - 표준 오류: 모드, 전체 지문 일치 여부, 처음 다른 구간, 마지막 상태의 최대 절대/상대 차
+ *
+ * 종료 코드: 0 지문 일치 또는 마지막 상태가 허용 오차(-t, 상대 오차) 안, 1 불일치, 2 입력 오류.
+ * -t가 없으면 비트 일치(지문 일치)만 통과한다.
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -DFP_DETERMINISTIC -ICore/Inc -o golden_check Tools/bench/golden_check.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c -lm
+ *
+ * 실행:
+ *   ./golden_check [-t tolerance] [uart_capture.txt]
+ */
+
+#include "ekf/ekf_golden.h"
+#include "math/fp_mode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+/**
+ * @brief 캡처 줄 최대 길이
+ */
+#define GOLDEN_LINE_MAX 512
+
+/**
+ * @brief 보드 캡처에서 읽은 결과
+ */
+typedef struct {
+    char mode[32];                      /**< 부동소수점 모드 이름 */
+    EKF_GoldenResult result;            /**< 지문과 마지막 상태 */
+    bool have_summary;                  /**< BENCH,golden 줄을 읽었는지 */
+    bool have_x;                        /**< BENCH,golden_x 줄을 읽었는지 */
+    bool have_p;                        /**< BENCH,golden_p 줄을 읽었는지 */
+} GoldenCapture;
+
+static EKF golden_ekf;
+static EKF_DelayBuffer golden_history;
+
+/**
+ * @brief 결과를 보드 벤치마크와 같은 형식으로 출력
+ */
+static void golden_print(const EKF_GoldenResult *r) {
+    printf("BENCH,golden,%s,%08x,%u,%u", FP_MODE_NAME, r->digest, r->calls, r->rejected);
+    for (uint32_t i = 0; i < EKF_GOLDEN_SEGMENTS; i++) {
+        printf(",%08x", r->segment[i]);
+    }
+    printf("\n");
+
+    const float *rows[2] = { r->x, r->p_diag };
+    const char *names[2] = { "golden_x", "golden_p" };
+    for (uint32_t k = 0; k < 2u; k++) {
+        printf("BENCH,%s", names[k]);
+        for (uint32_t i = 0; i < EKF_STATE_DIM; i++) {
+            uint32_t bits;
+            memcpy(&bits, &rows[k][i], sizeof(bits));
+            printf(",%08x", bits);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief 쉼표로 구분한 정수 n개 읽기 (s가 NULL이면 앞 strtok에 이어서)
+ *
+ * @return bool n개를 모두 읽었는지
+ */
+static bool golden_parse_u32(char *s, uint32_t *out, uint32_t n, int base) {
+    for (uint32_t i = 0; i < n; i++) {
+        char *tok = strtok(s, ",\r\n");
+        s = NULL;
+        if (tok == NULL) {
+            return false;
+        }
+        char *end;
+        out[i] = (uint32_t)strtoul(tok, &end, base);
+        if (end == tok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief float 배열을 비트 패턴으로 읽기
+ */
+static bool golden_parse_floats(char *s, float *out) {
+    uint32_t bits[EKF_STATE_DIM];
+    if (!golden_parse_u32(s, bits, EKF_STATE_DIM, 16)) {
+        return false;
+    }
+    memcpy(out, bits, sizeof(bits));
+    return true;
+}
+
+/**
+ * @brief UART 캡처에서 BENCH,golden 줄 읽기 (다른 줄과 줄 앞 잡음은 무시)
+ */
+static bool golden_read_capture(const char *path, GoldenCapture *cap) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+
+    char line[GOLDEN_LINE_MAX];
+    memset(cap, 0, sizeof(GoldenCapture));
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *p = strstr(line, "BENCH,golden");
+        if (p == NULL) {
+            continue;
+        }
+        p += strlen("BENCH,golden");
+        if (strncmp(p, "_x,", 3) == 0) {
+            cap->have_x = golden_parse_floats(p + 3, cap->result.x);
+        } else if (strncmp(p, "_p,", 3) == 0) {
+            cap->have_p = golden_parse_floats(p + 3, cap->result.p_diag);
+        } else if (p[0] == ',') {
+            char *mode = strtok(p + 1, ",\r\n");
+            if (mode == NULL || strcmp(mode, "failed") == 0) {
+                continue;
+            }
+            snprintf(cap->mode, sizeof(cap->mode), "%s", mode);
+            uint32_t head[3];
+            // 전체 지문은 16진수, 호출 수와 거부 수는 10진수
+            cap->have_summary = golden_parse_u32(NULL, head, 1u, 16) &&
+                                golden_parse_u32(NULL, &head[1], 2u, 10) &&
+                                golden_parse_u32(NULL, cap->result.segment, EKF_GOLDEN_SEGMENTS, 16);
+            cap->result.digest = head[0];
+            cap->result.calls = head[1];
+            cap->result.rejected = head[2];
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    float tolerance = -1.0f;
+    int opt;
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        if (opt == 't') {
+            tolerance = strtof(optarg, NULL);
+        } else {
+            fprintf(stderr, "사용법: %s [-t tolerance] [uart_capture.txt]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    EKF_GoldenResult host;
+    if (!ekf_golden_run(&golden_ekf, &golden_history, &host)) {
+        fprintf(stderr, "표준 재생 실패\n");
+        return 2;
+    }
+    golden_print(&host);
+
+    if (optind >= argc) {
+        return 0;
+    }
+
+    GoldenCapture cap;
+    if (!golden_read_capture(argv[optind], &cap)) {
+        return 2;
+    }
+    if (!cap.have_summary) {
+        fprintf(stderr, "캡처에 BENCH,golden 줄이 없음\n");
+        return 2;
+    }
+
+    fprintf(stderr, "모드: 호스트 %s, 보드 %s\n", FP_MODE_NAME, cap.mode);
+    if (strcmp(cap.mode, FP_MODE_NAME) != 0) {
+        fprintf(stderr, "경고: 모드가 달라 비트 일치를 기대할 수 없음\n");
+    }
+    if (cap.result.calls != host.calls || cap.result.rejected != host.rejected) {
+        fprintf(stderr, "호출 수: 호스트 %u/%u, 보드 %u/%u (거부 포함)\n", host.calls, host.rejected,
+                cap.result.calls, cap.result.rejected);
+    }
+
+    if (cap.result.digest == host.digest) {
+        fprintf(stderr, "지문 일치 %08x\n", host.digest);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < EKF_GOLDEN_SEGMENTS; i++) {
+        if (cap.result.segment[i] != host.segment[i]) {
+            fprintf(stderr, "지문 불일치: 처음 다른 구간 %u (IMU 샘플 %u~%u)\n", i,
+                    i * EKF_GOLDEN_SEGMENT_STEPS, (i + 1u) * EKF_GOLDEN_SEGMENT_STEPS - 1u);
+            break;
+        }
+    }
+
+    if (!cap.have_x || !cap.have_p) {
+        fprintf(stderr, "캡처에 마지막 상태 줄이 없어 허용 오차를 확인할 수 없음\n");
+        return 1;
+    }
+
+    // 상대 오차는 상태/공분산 크기가 0에 가까울 때 절대 오차로 바꿈 (분모 최소 1)
+    float max_abs = 0.0f;
+    float max_rel = 0.0f;
+    uint32_t worst = 0;
+    for (uint32_t k = 0; k < 2u; k++) {
+        const float *a = (k == 0u) ? host.x : host.p_diag;
+        const float *b = (k == 0u) ? cap.result.x : cap.result.p_diag;
+        for (uint32_t i = 0; i < EKF_STATE_DIM; i++) {
+            float diff = fabsf(a[i] - b[i]);
+            float scale = fmaxf(fabsf(a[i]), 1.0f);
+            if (diff > max_abs) {
+                max_abs = diff;
+            }
+            if (!(diff / scale <= max_rel)) {
+                max_rel = diff / scale;
+                worst = k * EKF_STATE_DIM + i;
+            }
+        }
+    }
+    fprintf(stderr, "마지막 상태 최대 차: 절대 %.3e, 상대 %.3e (%s[%u])\n", (double)max_abs,
+            (double)max_rel, (worst < EKF_STATE_DIM) ? "x" : "p_diag", worst % EKF_STATE_DIM);
+    if (tolerance < 0.0f) {
+        return 1;
+    }
+    fprintf(stderr, "허용 오차 %.3e %s\n", (double)tolerance, (max_rel <= tolerance) ? "안" : "초과");
+
+    return (max_rel <= tolerance) ? 0 : 1;
+}
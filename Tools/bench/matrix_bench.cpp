@@ -0,0 +1,114 @@
+/**
+ * @file matrix_bench.cpp
+ * @brief C++ 식 템플릿 행렬(math/matrix.hpp)과 C 커널 비교 (호스트용)
+ *
+ * 필터 차원의 공분산 전파 P' = F P F^T + Q를 C 커널(matsymN_propagate + add_scaled)과
+ * EKF.P 압축 저장 공간 위의 식 템플릿(math::sym(...) = F * P * F.transpose() + Q)으로
+ * 각각 계산해 최대 차이와 연산당 시간(ns/op)을 출력한다. 커널을 C++로 옮길 때 결과와
+ * 성능이 같은지 확인하는 용도이다.
+ *
+ * 빌드 (저장소 루트에서, C 커널은 C로 비운 build/matrix_bench에 따로 컴파일):
+ *   rm -rf build/matrix_bench && mkdir -p build/matrix_bench && \
+ *   for f in $(find Core/Src/math -name '*.c'); do \
+ *       gcc -std=gnu11 -O2 -ICore/Inc -c "$f" -o build/matrix_bench/$(basename "$f" .c).o; done && \
+ *   g++ -std=c++17 -O2 -ICore/Inc -o matrix_bench Tools/bench/matrix_bench.cpp build/matrix_bench/*.o -lm
+ *
+ * 실행:
+ *   ./matrix_bench [반복 횟수]
+ */
+
+#include "math/matrix.hpp"
+extern "C" {
+#include "ekf/ekf_config.h"
+#include "math/matrix_fixed.h"
+#include "math/matrix_sym.h"
+}
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+/**
+ * @brief 기본 반복 횟수
+ */
+#define MATRIX_BENCH_ITERATIONS 20000u
+
+static volatile float bench_sink;
+
+static uint32_t bench_rng_state = 0x12345678u;
+
+/**
+ * @brief xorshift32 난수 (-0.5 ~ 0.5)
+ */
+static float bench_random(void) {
+    uint32_t x = bench_rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench_rng_state = x;
+    return (float)(x >> 8) / 16777216.0f - 0.5f;
+}
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    const uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : MATRIX_BENCH_ITERATIONS;
+    constexpr std::size_t n = EKF_STATE_DIM;
+
+    // F = I + dt A (전파 행렬과 비슷한 크기), P = 양정치 대칭, Q = 대각
+    EKF_STATE_MATRIX F;
+    EKF_STATE_SYM P;
+    EKF_STATE_SYM Q;
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = 0; j < n; j++) {
+            F.data[i][j] = ((i == j) ? 1.0f : 0.0f) + 0.01f * bench_random();
+        }
+    }
+    EKF_SYM_FN(identity)(&P);
+    EKF_SYM_FN(zero)(&Q);
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = i; j < n; j++) {
+            P.data[EKF_SYM_FN(index)(i, j)] += (i == j) ? 1.0f : 0.1f * bench_random();
+        }
+        Q.data[EKF_SYM_FN(index)(i, i)] = 1e-4f;
+    }
+
+    EKF_STATE_SYM c_out;
+    EKF_STATE_SYM cpp_out;
+    uint64_t start = bench_now_ns();
+    for (uint32_t k = 0; k < iterations; k++) {
+        EKF_SYM_FN(propagate)(&F, &P, &c_out);
+        EKF_SYM_FN(add_scaled)(&c_out, &Q, 1.0f);
+        bench_sink = c_out.data[k % MATRIX_SYM_SIZE(n)];
+    }
+    const double c_ns = (double)(bench_now_ns() - start) / iterations;
+
+    const auto f = math::ref(F);
+    const auto p = math::sym(static_cast<const EKF_STATE_SYM &>(P));
+    const auto q = math::sym(static_cast<const EKF_STATE_SYM &>(Q));
+    auto out = math::sym(cpp_out);
+    start = bench_now_ns();
+    for (uint32_t k = 0; k < iterations; k++) {
+        out = f * p * f.transpose() + q;
+        bench_sink = cpp_out.data[k % MATRIX_SYM_SIZE(n)];
+    }
+    const double cpp_ns = (double)(bench_now_ns() - start) / iterations;
+
+    float max_diff = 0.0f;
+    for (std::size_t i = 0; i < MATRIX_SYM_SIZE(n); i++) {
+        max_diff = std::fmax(max_diff, std::fabs(c_out.data[i] - cpp_out.data[i]));
+    }
+    printf("N = %zu, 반복 %u회\n", n, iterations);
+    printf("  C 커널 (propagate + add_scaled) : %10.1f ns/op\n", c_ns);
+    printf("  식 템플릿 (F P F^T + Q)         : %10.1f ns/op\n", cpp_ns);
+    printf("  최대 차이                       : %10.3g\n", (double)max_diff);
+
+    return (max_diff < 1e-4f) ? 0 : 1;
+}
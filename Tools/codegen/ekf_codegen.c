@@ -0,0 +1,570 @@
+/**
+ * @file ekf_codegen.c
+ * @brief EKF 모델식 기호 미분 및 공통 부분식 제거 코드 생성 프로그램 (호스트용)
+ *
+ * 상태 전이와 측정 모델을 다항식으로 정의하고, 기호 미분으로 자코비안을 구한 뒤
+ * 출력 전체에서 반복되는 두 인수 곱을 임시 변수로 뽑아(CSE) 예측값과 자코비안을
+ * 한 번에 계산하는 함수를 Core/Src/ekf/ekf_generated.c 로 표준 출력에 생성한다.
+ * 선언은 ekf/ekf_generated.h 에 있으며, 모델을 바꾸거나 상태를 추가하면 아래 모델
+ * 정의 함수만 고치고 다시 생성한다.
+ *
+ * 모델:
+ * - 자력계: h = R(q)^T m (단위 사원수 회전 행렬), H = dh/dq
+ * - 자세 전이: q' = q + dt * 0.5 * q ⊗ (ω - b), F = dq'/db
+ * - 몸체 벡터 회전: h = R(q) v (GNSS 안테나 레버 암), H = dh/dq
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -o ekf_codegen Tools/codegen/ekf_codegen.c -lm
+ *   ./ekf_codegen > Core/Src/ekf/ekf_generated.c
+ * 생성 후 표준 오류로 모델별 곱셈 수(CSE 전/후)를 출력한다.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 크기 제한
+ */
+#define CG_MAX_VARS 48    /**< 입력 변수 + 임시 변수 */
+#define CG_MAX_TERMS 64   /**< 다항식 하나의 항 수 */
+#define CG_MAX_OUTPUTS 32 /**< 모델 하나의 출력 수 */
+
+/**
+ * @brief 단항식 항 (계수 x Π var^e)
+ */
+typedef struct {
+    double c;
+    uint8_t e[CG_MAX_VARS];
+} CgTerm;
+
+/**
+ * @brief 다항식
+ */
+typedef struct {
+    int n;
+    CgTerm t[CG_MAX_TERMS];
+} CgPoly;
+
+/**
+ * @brief 변수 표 (입력 변수 다음에 임시 변수)
+ */
+static char cg_names[CG_MAX_VARS][16];
+static int cg_var_count;
+static int cg_temp_a[CG_MAX_VARS];
+static int cg_temp_b[CG_MAX_VARS];
+static int cg_input_count;
+
+static int cg_var(const char *name) {
+    snprintf(cg_names[cg_var_count], sizeof(cg_names[0]), "%s", name);
+    return cg_var_count++;
+}
+
+static void cg_reset(void) {
+    cg_var_count = 0;
+    cg_input_count = 0;
+}
+
+/* ---------------- 다항식 연산 ---------------- */
+
+static int cg_degree(const CgTerm *t) {
+    int d = 0;
+    for (int i = 0; i < CG_MAX_VARS; i++) {
+        d += t->e[i];
+    }
+    return d;
+}
+
+/**
+ * @brief 정렬 기준 (차수 내림차순, 앞 변수의 지수 내림차순)
+ */
+static int cg_compare(const CgTerm *a, const CgTerm *b) {
+    int da = cg_degree(a), db = cg_degree(b);
+    if (da != db) {
+        return db - da;
+    }
+    for (int i = 0; i < CG_MAX_VARS; i++) {
+        if (a->e[i] != b->e[i]) {
+            return (int)b->e[i] - (int)a->e[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 같은 단항식 합치기, 0 항 제거, 정렬
+ */
+static void cg_normalize(CgPoly *p) {
+    for (int i = 1; i < p->n; i++) {
+        CgTerm t = p->t[i];
+        int j = i - 1;
+        while (j >= 0 && cg_compare(&p->t[j], &t) > 0) {
+            p->t[j + 1] = p->t[j];
+            j--;
+        }
+        p->t[j + 1] = t;
+    }
+
+    int n = 0;
+    for (int i = 0; i < p->n; i++) {
+        if (n > 0 && cg_compare(&p->t[n - 1], &p->t[i]) == 0) {
+            p->t[n - 1].c += p->t[i].c;
+        } else {
+            p->t[n++] = p->t[i];
+        }
+    }
+
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        if (fabs(p->t[i].c) > 1e-12) {
+            p->t[m++] = p->t[i];
+        }
+    }
+    p->n = m;
+}
+
+static CgPoly cg_const(double c) {
+    CgPoly p;
+    memset(&p, 0, sizeof(p));
+    p.n = 1;
+    p.t[0].c = c;
+    cg_normalize(&p);
+    return p;
+}
+
+static CgPoly cg_sym(int v) {
+    CgPoly p = cg_const(1.0);
+    p.t[0].e[v] = 1;
+    return p;
+}
+
+static CgPoly cg_add(CgPoly a, CgPoly b) {
+    for (int i = 0; i < b.n; i++) {
+        a.t[a.n++] = b.t[i];
+    }
+    cg_normalize(&a);
+    return a;
+}
+
+static CgPoly cg_scale(CgPoly a, double s) {
+    for (int i = 0; i < a.n; i++) {
+        a.t[i].c *= s;
+    }
+    cg_normalize(&a);
+    return a;
+}
+
+static CgPoly cg_sub(CgPoly a, CgPoly b) {
+    return cg_add(a, cg_scale(b, -1.0));
+}
+
+static CgPoly cg_mul(CgPoly a, CgPoly b) {
+    CgPoly r;
+    memset(&r, 0, sizeof(r));
+    for (int i = 0; i < a.n; i++) {
+        for (int j = 0; j < b.n; j++) {
+            CgTerm *t = &r.t[r.n++];
+            t->c = a.t[i].c * b.t[j].c;
+            for (int k = 0; k < CG_MAX_VARS; k++) {
+                t->e[k] = (uint8_t)(a.t[i].e[k] + b.t[j].e[k]);
+            }
+        }
+    }
+    cg_normalize(&r);
+    return r;
+}
+
+static CgPoly cg_diff(CgPoly a, int v) {
+    CgPoly r;
+    memset(&r, 0, sizeof(r));
+    for (int i = 0; i < a.n; i++) {
+        if (a.t[i].e[v] == 0) {
+            continue;
+        }
+        CgTerm t = a.t[i];
+        t.c *= t.e[v];
+        t.e[v]--;
+        r.t[r.n++] = t;
+    }
+    cg_normalize(&r);
+    return r;
+}
+
+/* ---------------- 사원수 기호 연산 ---------------- */
+
+typedef struct {
+    CgPoly w, x, y, z;
+} CgQuat;
+
+static CgQuat cg_quat_multiply(CgQuat a, CgQuat b) {
+    CgQuat r;
+    r.w = cg_sub(cg_sub(cg_sub(cg_mul(a.w, b.w), cg_mul(a.x, b.x)), cg_mul(a.y, b.y)), cg_mul(a.z, b.z));
+    r.x = cg_sub(cg_add(cg_add(cg_mul(a.w, b.x), cg_mul(a.x, b.w)), cg_mul(a.y, b.z)), cg_mul(a.z, b.y));
+    r.y = cg_add(cg_add(cg_sub(cg_mul(a.w, b.y), cg_mul(a.x, b.z)), cg_mul(a.y, b.w)), cg_mul(a.z, b.x));
+    r.z = cg_add(cg_sub(cg_add(cg_mul(a.w, b.z), cg_mul(a.x, b.y)), cg_mul(a.y, b.x)), cg_mul(a.z, b.w));
+    return r;
+}
+
+/**
+ * @brief 단위 사원수 회전 행렬 (몸체 -> NED, quaternion_to_rotation_matrix와 같은 형태)
+ */
+static void cg_rotation_matrix(const CgQuat *q, CgPoly R[3][3]) {
+    CgPoly one = cg_const(1.0);
+    CgPoly xx = cg_mul(q->x, q->x), yy = cg_mul(q->y, q->y), zz = cg_mul(q->z, q->z);
+    CgPoly xy = cg_mul(q->x, q->y), xz = cg_mul(q->x, q->z), yz = cg_mul(q->y, q->z);
+    CgPoly wx = cg_mul(q->w, q->x), wy = cg_mul(q->w, q->y), wz = cg_mul(q->w, q->z);
+
+    R[0][0] = cg_sub(one, cg_scale(cg_add(yy, zz), 2.0));
+    R[0][1] = cg_scale(cg_sub(xy, wz), 2.0);
+    R[0][2] = cg_scale(cg_add(xz, wy), 2.0);
+    R[1][0] = cg_scale(cg_add(xy, wz), 2.0);
+    R[1][1] = cg_sub(one, cg_scale(cg_add(xx, zz), 2.0));
+    R[1][2] = cg_scale(cg_sub(yz, wx), 2.0);
+    R[2][0] = cg_scale(cg_sub(xz, wy), 2.0);
+    R[2][1] = cg_scale(cg_add(yz, wx), 2.0);
+    R[2][2] = cg_sub(one, cg_scale(cg_add(xx, yy), 2.0));
+}
+
+/* ---------------- 공통 부분식 제거 ---------------- */
+
+static int cg_has_pair(const CgTerm *t, int a, int b) {
+    return (a == b) ? (t->e[a] >= 2) : (t->e[a] >= 1 && t->e[b] >= 1);
+}
+
+/**
+ * @brief 항의 곱셈 수 (계수 1이 아니면 계수 곱 포함)
+ */
+static int cg_count_multiplies(CgPoly *const *out, int count) {
+    int n = 0;
+    for (int k = 0; k < count; k++) {
+        for (int i = 0; i < out[k]->n; i++) {
+            int d = cg_degree(&out[k]->t[i]);
+            n += (d > 0 ? d - 1 : 0) + (fabs(out[k]->t[i].c) != 1.0 ? 1 : 0);
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief 출력 전체에서 가장 자주 나오는 두 인수 곱을 임시 변수로 치환 (두 번 이상일 때)
+ */
+static void cg_eliminate(CgPoly *const *out, int count) {
+    for (;;) {
+        int best_a = -1, best_b = -1, best_n = 1;
+        for (int a = 0; a < cg_var_count; a++) {
+            for (int b = a; b < cg_var_count; b++) {
+                int n = 0;
+                for (int k = 0; k < count; k++) {
+                    for (int i = 0; i < out[k]->n; i++) {
+                        n += cg_has_pair(&out[k]->t[i], a, b);
+                    }
+                }
+                if (n > best_n) {
+                    best_n = n;
+                    best_a = a;
+                    best_b = b;
+                }
+            }
+        }
+        if (best_a < 0 || cg_var_count >= CG_MAX_VARS) {
+            return;
+        }
+
+        char name[16];
+        snprintf(name, sizeof(name), "t%d", cg_var_count - cg_input_count);
+        int t = cg_var(name);
+        cg_temp_a[t] = best_a;
+        cg_temp_b[t] = best_b;
+
+        for (int k = 0; k < count; k++) {
+            for (int i = 0; i < out[k]->n; i++) {
+                CgTerm *term = &out[k]->t[i];
+                while (cg_has_pair(term, best_a, best_b)) {
+                    term->e[best_a]--;
+                    term->e[best_b]--;
+                    term->e[t]++;
+                }
+            }
+            cg_normalize(out[k]);
+        }
+    }
+}
+
+/* ---------------- 출력 ---------------- */
+
+static void cg_print_float(double c) {
+    if (c == floor(c)) {
+        printf("%.1ff", c);
+    } else {
+        printf("%.9gf", c);
+    }
+}
+
+static void cg_print_monomial(const CgTerm *t) {
+    int first = 1;
+    for (int v = 0; v < cg_var_count; v++) {
+        for (int e = 0; e < t->e[v]; e++) {
+            printf("%s%s", first ? "" : " * ", cg_names[v]);
+            first = 0;
+        }
+    }
+}
+
+/**
+ * @brief 공통 2의 거듭제곱 계수가 있으면 묶어서 출력
+ */
+static void cg_print_poly(const CgPoly *p) {
+    if (p->n == 0) {
+        printf("0.0f");
+        return;
+    }
+
+    double g = fabs(p->t[0].c);
+    for (int i = 1; i < p->n; i++) {
+        g = fmin(g, fabs(p->t[i].c));
+    }
+    int e;
+    if (frexp(g, &e) != 0.5) {
+        g = 1.0;
+    }
+    for (int i = 0; i < p->n; i++) {
+        double k = p->t[i].c / g;
+        if (k != floor(k)) {
+            g = 1.0;
+            break;
+        }
+    }
+
+    // 양수 항을 앞에 (음수 항만 있으면 그대로)
+    int first = 0;
+    while (first < p->n && p->t[first].c < 0.0) {
+        first++;
+    }
+    if (first == p->n) {
+        first = 0;
+    }
+
+    int group = (g != 1.0);
+    if (group && p->n == 1 && p->t[0].c < 0.0) {
+        printf("-");
+    }
+    if (group) {
+        cg_print_float(g);
+        printf(p->n > 1 ? " * (" : " * ");
+    }
+    for (int n = 0; n < p->n; n++) {
+        const CgTerm *t = &p->t[(first + n) % p->n];
+        double k = t->c / g;
+        int deg = cg_degree(t);
+        if (n == 0) {
+            if (k < 0.0 && !(group && p->n == 1)) {
+                printf("-");
+            }
+        } else {
+            printf(k < 0.0 ? " - " : " + ");
+        }
+        double a = fabs(k);
+        if (deg == 0) {
+            cg_print_float(a);
+            continue;
+        }
+        if (a != 1.0) {
+            cg_print_float(a);
+            printf(" * ");
+        }
+        cg_print_monomial(t);
+    }
+    if (group && p->n > 1) {
+        printf(")");
+    }
+}
+
+static void cg_print_temps(void) {
+    for (int t = cg_input_count; t < cg_var_count; t++) {
+        printf("    const float %s = %s * %s;\n", cg_names[t], cg_names[cg_temp_a[t]], cg_names[cg_temp_b[t]]);
+    }
+}
+
+/**
+ * @brief 모델 출력 (CSE 후 임시 변수, 출력 배정)
+ */
+static void cg_emit(const char *label, CgPoly *const *out, char names[][24], int count) {
+    int before = cg_count_multiplies(out, count);
+    cg_eliminate(out, count);
+    int after = cg_count_multiplies(out, count) + (cg_var_count - cg_input_count);
+    fprintf(stderr, "%s: %d -> %d multiplies (%d temps)\n", label, before, after, cg_var_count - cg_input_count);
+
+    cg_print_temps();
+    if (cg_var_count > cg_input_count) {
+        printf("\n");
+    }
+    for (int k = 0; k < count; k++) {
+        printf("    %s = ", names[k]);
+        cg_print_poly(out[k]);
+        printf(";\n");
+    }
+}
+
+/* ---------------- 모델 정의 ---------------- */
+
+/**
+ * @brief 자력계 측정 모델: h = R(q)^T m, H = dh/dq (q 순서 w, x, y, z)
+ */
+static void cg_model_mag(void) {
+    cg_reset();
+    int qv[4] = { cg_var("qw"), cg_var("qx"), cg_var("qy"), cg_var("qz") };
+    int mv[3] = { cg_var("mx"), cg_var("my"), cg_var("mz") };
+    cg_input_count = cg_var_count;
+
+    CgQuat q = { cg_sym(qv[0]), cg_sym(qv[1]), cg_sym(qv[2]), cg_sym(qv[3]) };
+    CgPoly R[3][3];
+    cg_rotation_matrix(&q, R);
+
+    static CgPoly h[3], H[3][4];
+    static CgPoly *out[CG_MAX_OUTPUTS];
+    static char names[CG_MAX_OUTPUTS][24];
+    int count = 0;
+    for (int i = 0; i < 3; i++) {
+        h[i] = cg_const(0.0);
+        for (int j = 0; j < 3; j++) {
+            h[i] = cg_add(h[i], cg_mul(R[j][i], cg_sym(mv[j])));
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int k = 0; k < 4; k++) {
+            H[i][k] = cg_diff(h[i], qv[k]);
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        out[count] = &h[i];
+        snprintf(names[count++], sizeof(names[0]), "h[%d]", i);
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int k = 0; k < 4; k++) {
+            out[count] = &H[i][k];
+            snprintf(names[count++], sizeof(names[0]), "H[%d][%d]", i, k);
+        }
+    }
+
+    printf("/**\n");
+    printf(" * @brief 자력계 측정 모델 h = R(q)^T m 과 자코비안 H = dh/dq\n");
+    printf(" */\n");
+    printf("MEM_RAMFUNC(ekf_gen_mag_observation)\n");
+    printf("void ekf_gen_mag_observation(const float q[4], const float m[3], float h[3], float H[3][4]) {\n");
+    printf("    const float qw = q[0], qx = q[1], qy = q[2], qz = q[3];\n");
+    printf("    const float mx = m[0], my = m[1], mz = m[2];\n\n");
+    cg_emit("mag", out, names, count);
+    printf("}\n\n");
+}
+
+/**
+ * @brief 자세 전이 모델: q' = q + dt * 0.5 * q ⊗ (0, ω - b), F = dq'/db
+ */
+static void cg_model_attitude(void) {
+    cg_reset();
+    int qv[4] = { cg_var("qw"), cg_var("qx"), cg_var("qy"), cg_var("qz") };
+    int wv[3] = { cg_var("wx"), cg_var("wy"), cg_var("wz") };
+    int bv[3] = { cg_var("bx"), cg_var("by"), cg_var("bz") };
+    int dt = cg_var("dt");
+    cg_input_count = cg_var_count;
+
+    CgQuat q = { cg_sym(qv[0]), cg_sym(qv[1]), cg_sym(qv[2]), cg_sym(qv[3]) };
+    CgQuat w = { cg_const(0.0),
+                 cg_sub(cg_sym(wv[0]), cg_sym(bv[0])),
+                 cg_sub(cg_sym(wv[1]), cg_sym(bv[1])),
+                 cg_sub(cg_sym(wv[2]), cg_sym(bv[2])) };
+    CgQuat qd = cg_quat_multiply(q, w);
+    CgPoly step = cg_scale(cg_sym(dt), 0.5);
+    CgPoly qn[4] = {
+        cg_add(q.w, cg_mul(step, qd.w)), cg_add(q.x, cg_mul(step, qd.x)),
+        cg_add(q.y, cg_mul(step, qd.y)), cg_add(q.z, cg_mul(step, qd.z))
+    };
+
+    static CgPoly F[4][3];
+    static CgPoly *out[CG_MAX_OUTPUTS];
+    static char names[CG_MAX_OUTPUTS][24];
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            F[i][j] = cg_diff(qn[i], bv[j]);
+            out[count] = &F[i][j];
+            snprintf(names[count++], sizeof(names[0]), "F[%d][%d]", i, j);
+        }
+    }
+
+    printf("/**\n");
+    printf(" * @brief 자세 전이의 자이로 바이어스 블록 F = dq'/db (q' = q + dt * 0.5 * q ⊗ (ω - b))\n");
+    printf(" */\n");
+    printf("MEM_RAMFUNC(ekf_gen_attitude_transition)\n");
+    printf("void ekf_gen_attitude_transition(const float q[4], float dt, float F[4][3]) {\n");
+    printf("    const float qw = q[0], qx = q[1], qy = q[2], qz = q[3];\n\n");
+    cg_emit("attitude", out, names, count);
+    printf("}\n");
+}
+
+/**
+ * @brief 몸체 벡터 회전 모델: h = R(q) v, H = dh/dq (q 순서 w, x, y, z)
+ */
+static void cg_model_body_to_nav(void) {
+    cg_reset();
+    int qv[4] = { cg_var("qw"), cg_var("qx"), cg_var("qy"), cg_var("qz") };
+    int vv[3] = { cg_var("vx"), cg_var("vy"), cg_var("vz") };
+    cg_input_count = cg_var_count;
+
+    CgQuat q = { cg_sym(qv[0]), cg_sym(qv[1]), cg_sym(qv[2]), cg_sym(qv[3]) };
+    CgPoly R[3][3];
+    cg_rotation_matrix(&q, R);
+
+    static CgPoly h[3], H[3][4];
+    static CgPoly *out[CG_MAX_OUTPUTS];
+    static char names[CG_MAX_OUTPUTS][24];
+    int count = 0;
+    for (int i = 0; i < 3; i++) {
+        h[i] = cg_const(0.0);
+        for (int j = 0; j < 3; j++) {
+            h[i] = cg_add(h[i], cg_mul(R[i][j], cg_sym(vv[j])));
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int k = 0; k < 4; k++) {
+            H[i][k] = cg_diff(h[i], qv[k]);
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        out[count] = &h[i];
+        snprintf(names[count++], sizeof(names[0]), "h[%d]", i);
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int k = 0; k < 4; k++) {
+            out[count] = &H[i][k];
+            snprintf(names[count++], sizeof(names[0]), "H[%d][%d]", i, k);
+        }
+    }
+
+    printf("\n/**\n");
+    printf(" * @brief 몸체 벡터 회전 h = R(q) v 와 자코비안 H = dh/dq\n");
+    printf(" */\n");
+    printf("MEM_RAMFUNC(ekf_gen_body_to_nav)\n");
+    printf("void ekf_gen_body_to_nav(const float q[4], const float v[3], float h[3], float H[3][4]) {\n");
+    printf("    const float qw = q[0], qx = q[1], qy = q[2], qz = q[3];\n");
+    printf("    const float vx = v[0], vy = v[1], vz = v[2];\n\n");
+    cg_emit("body_to_nav", out, names, count);
+    printf("}\n");
+}
+
+int main(void) {
+    printf("/**\n");
+    printf(" * @file ekf_generated.c\n");
+    printf(" * @brief EKF 모델 커널 (Tools/codegen/ekf_codegen.c 생성 파일, 직접 수정 금지)\n");
+    printf(" */\n\n");
+    printf("#include \"ekf/ekf_generated.h\"\n");
+    printf("#include \"sys/mem_section.h\"\n");
+    printf("#include \"math/fp_mode.h\"\n\n");
+
+    cg_model_mag();
+    cg_model_attitude();
+    cg_model_body_to_nav();
+
+    return 0;
+}
@@ -0,0 +1,643 @@
+/**
+ * @file ground_decode.c
+ * @brief 지상국 복원 라이브러리 구현
+ */
+
+#include "ground_decode.h"
+#include "log/log_lz.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief 묶음 크기 (telemetry_group_size, 묶음 번호 순)
+ */
+static const uint8_t ground_nav_group_size[TELEMETRY_GROUP_COUNT] = TELEMETRY_GROUP_SIZES;
+
+/**
+ * @brief CRC 표 (slicing-by-8)
+ */
+static uint32_t ground_crc_table[8][256];
+static bool ground_crc_ready;
+
+/**
+ * @brief 리틀 엔디언 읽기
+ */
+static inline uint16_t ground_rd16(const uint8_t *p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static inline uint32_t ground_rd32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static void ground_crc_init(void) {
+    for (uint32_t i = 0; i < 256u; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1u)));
+        }
+        ground_crc_table[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256u; i++) {
+        for (uint32_t t = 1; t < 8u; t++) {
+            uint32_t prev = ground_crc_table[t - 1u][i];
+            ground_crc_table[t][i] = (prev >> 8) ^ ground_crc_table[0][prev & 0xFFu];
+        }
+    }
+    ground_crc_ready = true;
+}
+
+/**
+ * @brief CRC-32 (8바이트 단위 표 방식)
+ */
+uint32_t ground_crc32(const uint8_t *data, size_t len) {
+    if (!ground_crc_ready) {
+        ground_crc_init();
+    }
+
+    uint32_t c = 0xFFFFFFFFu;
+    while (len >= 8u) {
+        uint32_t lo = ground_rd32(data) ^ c;
+        uint32_t hi = ground_rd32(data + 4);
+        c = ground_crc_table[7][lo & 0xFFu] ^ ground_crc_table[6][(lo >> 8) & 0xFFu] ^
+            ground_crc_table[5][(lo >> 16) & 0xFFu] ^ ground_crc_table[4][lo >> 24] ^
+            ground_crc_table[3][hi & 0xFFu] ^ ground_crc_table[2][(hi >> 8) & 0xFFu] ^
+            ground_crc_table[1][(hi >> 16) & 0xFFu] ^ ground_crc_table[0][hi >> 24];
+        data += 8;
+        len -= 8u;
+    }
+    while (len-- > 0) {
+        c = (c >> 8) ^ ground_crc_table[0][(c ^ *data++) & 0xFFu];
+    }
+
+    return c ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief 블록 헤더 읽기
+ */
+static void ground_read_header(const uint8_t *p, GroundBlockHeader *h) {
+    h->magic = ground_rd32(p);
+    h->crc = ground_rd32(p + 4);
+    h->seq = ground_rd32(p + 8);
+    h->session = ground_rd16(p + 12);
+    h->used = ground_rd16(p + 14);
+}
+
+/**
+ * @brief 기록 이미지 걷기 시작
+ */
+bool ground_log_open(GroundLog *log, const uint8_t *image, size_t size) {
+    if (log == NULL || (image == NULL && size > 0)) {
+        return false;
+    }
+
+    memset(log, 0, offsetof(GroundLog, scratch));
+    log->image = image;
+    log->size = size;
+    if (!ground_crc_ready) {
+        ground_crc_init();
+    }
+
+    return true;
+}
+
+/**
+ * @brief 압축 모드 블록을 작업 버퍼에 원래 블록으로 풀기 (flash_log_unpack_block과 같음)
+ */
+static bool ground_log_unpack(GroundLog *log, const uint8_t *stored, uint16_t used) {
+    uint8_t *block = log->scratch;
+    uint16_t body = (uint16_t)(used - FLASH_LOG_BLOCK_HEADER_SIZE);
+
+    memcpy(block, stored, FLASH_LOG_BLOCK_HEADER_SIZE);
+    if (ground_rd32(stored) == FLASH_LOG_LZ_MAGIC) {
+        uint16_t n;
+        if (!log_lz_decompress(&stored[FLASH_LOG_BLOCK_HEADER_SIZE], body, &block[FLASH_LOG_BLOCK_HEADER_SIZE],
+                               (uint16_t)(FLASH_LOG_BLOCK_SIZE - FLASH_LOG_BLOCK_HEADER_SIZE), &n)) {
+            return false;
+        }
+        body = n;
+    } else {
+        memcpy(&block[FLASH_LOG_BLOCK_HEADER_SIZE], &stored[FLASH_LOG_BLOCK_HEADER_SIZE], body);
+    }
+    memset(&block[FLASH_LOG_BLOCK_HEADER_SIZE + body], FLASH_LOG_END_TYPE,
+           FLASH_LOG_BLOCK_SIZE - FLASH_LOG_BLOCK_HEADER_SIZE - body);
+
+    uint32_t magic = FLASH_LOG_MAGIC;
+    uint16_t total = (uint16_t)(FLASH_LOG_BLOCK_HEADER_SIZE + body);
+    memcpy(block, &magic, sizeof(magic));
+    memcpy(&block[14], &total, sizeof(total));
+
+    return true;
+}
+
+/**
+ * @brief 다음 유효 블록
+ */
+bool ground_log_next(GroundLog *log, GroundBlock *block) {
+    if (log == NULL || block == NULL) {
+        return false;
+    }
+
+    while (log->pos + FLASH_LOG_BLOCK_HEADER_SIZE <= log->size) {
+        const uint8_t *raw = &log->image[log->pos];
+        uint32_t magic = ground_rd32(raw);
+        uint16_t used = ground_rd16(raw + 14);
+        bool sane = used >= FLASH_LOG_BLOCK_HEADER_SIZE && used <= FLASH_LOG_BLOCK_SIZE;
+        size_t at = log->pos;
+        const uint8_t *data;
+        bool packed = false;
+
+        if ((magic == FLASH_LOG_LZ_MAGIC || magic == FLASH_LOG_PACKED_MAGIC) && sane && at + used <= log->size) {
+            log->pos += (used + FLASH_LOG_PAGE_SIZE - 1u) / FLASH_LOG_PAGE_SIZE * FLASH_LOG_PAGE_SIZE;
+            if (!ground_log_unpack(log, raw, used)) {
+                log->stats.crc_errors++;
+                continue;
+            }
+            data = log->scratch;
+            packed = true;
+        } else if (at + FLASH_LOG_BLOCK_SIZE <= log->size) {
+            // 표식이 없는 곳(지워진 영역 등)은 페이지 단위로 넘기고 섹터마다 한 번 셈
+            if ((magic != FLASH_LOG_MAGIC && magic != FLASH_LOG_INDEX_MAGIC) || !sane) {
+                if (at % FLASH_LOG_BLOCK_SIZE == 0) {
+                    log->stats.skipped_sectors++;
+                }
+                log->pos += FLASH_LOG_PAGE_SIZE;
+                continue;
+            }
+            data = raw;
+            log->pos += FLASH_LOG_BLOCK_SIZE;
+        } else {
+            break;
+        }
+
+        if (ground_crc32(&data[FLASH_LOG_CRC_OFFSET], FLASH_LOG_BLOCK_SIZE - FLASH_LOG_CRC_OFFSET) != ground_rd32(data + 4)) {
+            log->stats.crc_errors++;
+            continue;
+        }
+
+        ground_read_header(data, &block->header);
+        block->data = data;
+        block->offset = at;
+        block->packed = packed;
+        block->index = block->header.magic == FLASH_LOG_INDEX_MAGIC;
+        if (block->index) {
+            log->stats.index_blocks++;
+            return true;
+        }
+
+        const GroundBlockHeader *h = &block->header;
+        if (log->has_prev && h->session == log->prev_session && h->seq > log->prev_seq + 1u) {
+            log->stats.lost_blocks += h->seq - log->prev_seq - 1u;
+        }
+        log->has_prev = true;
+        log->prev_session = h->session;
+        log->prev_seq = h->seq;
+        log->stats.blocks++;
+        if (packed) {
+            log->stats.packed_blocks++;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 블록 안 다음 레코드
+ */
+bool ground_block_next_record(const GroundBlock *block, uint32_t *offset, GroundRecord *record) {
+    if (block == NULL || offset == NULL || record == NULL || block->index) {
+        return false;
+    }
+
+    uint32_t o = *offset;
+    uint32_t used = block->header.used;
+    if (o + 2u > used || block->data[o] == FLASH_LOG_END_TYPE) {
+        return false;
+    }
+
+    uint8_t len = block->data[o + 1u];
+    if (o + 2u + len > used) {
+        return false;
+    }
+
+    record->type = block->data[o];
+    record->len = len;
+    record->payload = &block->data[o + 2u];
+    *offset = o + 2u + len;
+
+    return true;
+}
+
+/**
+ * @brief 이벤트 전 보관 레코드의 원래 레코드 보기
+ */
+bool ground_record_pre_event(const GroundRecord *record, GroundRecord *inner) {
+    if (record == NULL || inner == NULL || record->type != FLASH_LOG_REC_PRE_EVENT || record->len < 1u) {
+        return false;
+    }
+
+    inner->type = record->payload[0];
+    inner->len = (uint8_t)(record->len - 1u);
+    inner->payload = &record->payload[1];
+
+    return true;
+}
+
+/**
+ * @brief 색인 블록의 항목 읽기
+ */
+bool ground_index_entry(const GroundBlock *block, uint32_t i, GroundIndexEntry *entry) {
+    if (block == NULL || entry == NULL || !block->index) {
+        return false;
+    }
+
+    uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE + i * FLASH_LOG_INDEX_ENTRY_SIZE;
+    if (o + FLASH_LOG_INDEX_ENTRY_SIZE > block->header.used) {
+        return false;
+    }
+
+    const uint8_t *p = &block->data[o];
+    entry->timestamp_us = ground_rd32(p);
+    entry->block = ground_rd32(p + 4);
+    entry->value = ground_rd32(p + 8);
+    entry->session = ground_rd16(p + 12);
+    entry->kind = p[14];
+    entry->arg = p[15];
+
+    return true;
+}
+
+/**
+ * @brief 복원기 초기화
+ */
+void ground_streams_init(GroundStreams *streams) {
+    if (streams == NULL) {
+        return;
+    }
+
+    memset(streams, 0, sizeof(*streams));
+}
+
+/**
+ * @brief 새 블록 시작
+ */
+void ground_streams_begin_block(GroundStreams *streams) {
+    if (streams == NULL) {
+        return;
+    }
+
+    // 스트림 표(수십 KB)를 블록마다 지우는 대신 세대를 올려 이전 스키마를 무효화
+    if (++streams->generation == 0) {
+        for (uint32_t i = 0; i < GROUND_STREAM_COUNT; i++) {
+            streams->stream[i].generation = 0;
+        }
+        streams->generation = 1;
+    }
+}
+
+/**
+ * @brief 가변 길이 정수 읽기 (끝을 넘으면 false)
+ */
+static inline bool ground_varint(const uint8_t **p, const uint8_t *end, uint32_t *v) {
+    uint32_t r = 0;
+    for (int shift = 0; shift < 35 && *p < end; shift += 7) {
+        uint8_t b = *(*p)++;
+        r |= (uint32_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            *v = r;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static inline uint32_t ground_unzigzag(uint32_t v) {
+    return (v >> 1) ^ (uint32_t)(-(int32_t)(v & 1u));
+}
+
+/**
+ * @brief 압축 스트림 레코드 하나 복원
+ */
+bool ground_stream_decode(GroundStreams *streams, const GroundRecord *record, GroundSample *sample) {
+    if (streams == NULL || record == NULL || record->len < 1) {
+        return false;
+    }
+
+    const uint8_t *p = record->payload;
+    const uint8_t *end = p + record->len;
+    GroundStream *s = &streams->stream[p[0]];
+    uint8_t len = record->len;
+    p++;
+
+    if (record->type == FLASH_LOG_REC_SCHEMA) {
+        if (len < 12u || p[0] == 0 || p[0] > LOG_CODEC_MAX_FIELDS || len < 12u + 4u * p[0]) {
+            streams->errors++;
+            return false;
+        }
+        s->id = record->payload[0];
+        s->field_count = p[0];
+        memcpy(s->name, &p[3], LOG_CODEC_NAME_SIZE);
+        s->name[LOG_CODEC_NAME_SIZE] = '\0';
+        memcpy(s->scale, &p[3 + LOG_CODEC_NAME_SIZE], 4u * s->field_count);
+        s->generation = streams->generation;
+        s->primed = false;
+        return false;
+    }
+    if (record->type != FLASH_LOG_REC_KEY && record->type != FLASH_LOG_REC_DELTA) {
+        return false;
+    }
+    if (s->generation != streams->generation || (record->type == FLASH_LOG_REC_DELTA && !s->primed)) {
+        streams->errors++;
+        return false;
+    }
+
+    bool key = record->type == FLASH_LOG_REC_KEY;
+    uint32_t v;
+    if (!ground_varint(&p, end, &v)) {
+        streams->errors++;
+        return false;
+    }
+    if (key) {
+        s->t_us = v;
+        s->dt_us = 0;
+    } else {
+        s->dt_us += ground_unzigzag(v);
+        s->t_us += s->dt_us;
+    }
+    for (uint8_t i = 0; i < s->field_count; i++) {
+        if (!ground_varint(&p, end, &v)) {
+            s->primed = false;
+            streams->errors++;
+            return false;
+        }
+        s->q[i] = (int32_t)(key ? ground_unzigzag(v) : (uint32_t)s->q[i] + ground_unzigzag(v));
+    }
+    s->primed = true;
+
+    if (sample != NULL) {
+        sample->stream = s;
+        sample->t_us = s->t_us;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 원시 레코드 해석
+ *
+ * 펌웨어 구조체는 4바이트 정렬 필드만 있어 채움이 없으므로 그대로 복사한다.
+ * GNSS 레코드는 뒤에 예약 바이트를 붙여 쓰는 기록기(sim_model 등, 56바이트)가 있어 앞부분만 읽는다.
+ */
+static bool ground_record_copy(const GroundRecord *record, uint8_t type, void *out, size_t size, bool prefix) {
+    if (record == NULL || out == NULL || record->type != type || record->len < size ||
+        (!prefix && record->len != size)) {
+        return false;
+    }
+
+    memcpy(out, record->payload, size);
+
+    return true;
+}
+
+bool ground_record_imu(const GroundRecord *record, GroundImu *out) {
+    return ground_record_copy(record, FLASH_LOG_REC_IMU, out, sizeof(*out), false);
+}
+
+bool ground_record_baro(const GroundRecord *record, GroundBaro *out) {
+    return ground_record_copy(record, FLASH_LOG_REC_BARO, out, sizeof(*out), false);
+}
+
+bool ground_record_mag(const GroundRecord *record, GroundMag *out) {
+    return ground_record_copy(record, FLASH_LOG_REC_MAG, out, sizeof(*out), false);
+}
+
+bool ground_record_gnss(const GroundRecord *record, GroundGnss *out) {
+    return ground_record_copy(record, FLASH_LOG_REC_GNSS, out, sizeof(*out), true);
+}
+
+/**
+ * @brief 프레임 수신 초기화
+ */
+void ground_frame_init(GroundFrameParser *parser) {
+    if (parser == NULL) {
+        return;
+    }
+
+    memset(parser, 0, sizeof(*parser));
+    if (!ground_crc_ready) {
+        ground_crc_init();
+    }
+}
+
+/**
+ * @brief 수신 버퍼에서 다음 프레임 찾기
+ */
+bool ground_frame_next(GroundFrameParser *parser, const uint8_t *buf, size_t len, size_t *consumed,
+                       GroundFrame *frame) {
+    if (parser == NULL || buf == NULL || consumed == NULL || frame == NULL) {
+        return false;
+    }
+
+    size_t i = 0;
+    while (i + 1u < len) {
+        const uint8_t *s = memchr(&buf[i], TELEMETRY_FRAME_SYNC1, len - i - 1u);
+        if (s == NULL) {
+            // 마지막 바이트는 다음 수신분과 이어 동기가 될 수 있어 남김
+            i = len - 1u;
+            break;
+        }
+        i = (size_t)(s - buf);
+        if (buf[i + 1u] != TELEMETRY_FRAME_SYNC2) {
+            i++;
+            continue;
+        }
+        if (len - i < TELEMETRY_FRAME_HEADER) {
+            break;
+        }
+
+        uint8_t plen = buf[i + 2u];
+        size_t total = TELEMETRY_FRAME_HEADER + plen + TELEMETRY_FRAME_TRAILER;
+        if (len - i < total) {
+            break;
+        }
+
+        // CRC는 길이 바이트부터 페이로드 끝까지
+        if (ground_crc32(&buf[i + 2u], TELEMETRY_FRAME_HEADER - 2u + plen) !=
+            ground_rd32(&buf[i + TELEMETRY_FRAME_HEADER + plen])) {
+            // 동기 바이트가 데이터 안에 우연히 있었거나 깨진 프레임: 한 바이트 다음부터 다시 찾음
+            parser->crc_errors++;
+            i++;
+            continue;
+        }
+
+        frame->len = plen;
+        frame->type = buf[i + 3u];
+        frame->seq = ground_rd16(&buf[i + 4u]);
+        frame->payload = &buf[i + TELEMETRY_FRAME_HEADER];
+
+        if (parser->has_seq) {
+            parser->lost += (uint16_t)(frame->seq - parser->last_seq - 1u);
+        }
+        parser->has_seq = true;
+        parser->last_seq = frame->seq;
+        parser->frames++;
+        parser->resync_bytes += i;
+        *consumed = i + total;
+
+        return true;
+    }
+
+    parser->resync_bytes += i;
+    *consumed = i;
+
+    return false;
+}
+
+/**
+ * @brief 사원수 smallest-three 복호화 (telemetry_decode_quat과 같음)
+ */
+static void ground_decode_quat(uint32_t code, double q[4]) {
+    uint32_t largest = code >> 30;
+    uint32_t shift = 20;
+    double sum = 0.0;
+
+    for (uint32_t i = 0; i < 4u; i++) {
+        if (i == largest) {
+            continue;
+        }
+        int32_t field = (int32_t)((code >> shift) & 0x3FFu) - TELEMETRY_QUAT_HALF;
+        q[i] = (double)field * (TELEMETRY_QUAT_RANGE / TELEMETRY_QUAT_HALF);
+        sum += q[i] * q[i];
+        shift -= 10u;
+    }
+    q[largest] = (sum < 1.0) ? sqrt(1.0 - sum) : 0.0;
+
+    double n = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (uint32_t i = 0; i < 4u; i++) {
+        q[i] /= n;
+    }
+}
+
+static double ground_decode_std(uint8_t code, double base) {
+    return base * exp2((double)code / 16.0);
+}
+
+/**
+ * @brief 항법 해 프레임 풀기
+ */
+bool ground_nav_decode(const GroundFrame *frame, GroundNav *nav) {
+    if (frame == NULL || nav == NULL || frame->type != TELEMETRY_TYPE_NAV || frame->len < TELEMETRY_NAV_HEADER_SIZE) {
+        return false;
+    }
+
+    const uint8_t *p = frame->payload;
+    const uint8_t *end = p + frame->len;
+    memset(nav, 0, sizeof(*nav));
+    nav->t_us = ground_rd32(p);
+    nav->mask = ground_rd16(p + 4);
+    p += TELEMETRY_NAV_HEADER_SIZE;
+
+    for (uint8_t g = 0; g < TELEMETRY_GROUP_COUNT; g++) {
+        if ((nav->mask & (1u << g)) == 0) {
+            continue;
+        }
+        if ((size_t)(end - p) < ground_nav_group_size[g]) {
+            return false;
+        }
+
+        switch (g) {
+        case TELEMETRY_GROUP_ATTITUDE:
+            ground_decode_quat(ground_rd32(p), nav->q);
+            break;
+        case TELEMETRY_GROUP_POSITION:
+            for (int k = 0; k < 3; k++) {
+                nav->pos[k] = (int32_t)ground_rd32(p + 4 * k) * TELEMETRY_POS_LSB;
+            }
+            break;
+        case TELEMETRY_GROUP_VELOCITY:
+            for (int k = 0; k < 3; k++) {
+                nav->vel[k] = (int16_t)ground_rd16(p + 2 * k) * TELEMETRY_VEL_LSB;
+            }
+            break;
+        case TELEMETRY_GROUP_COVARIANCE:
+            nav->std_pos_h = ground_decode_std(p[0], TELEMETRY_STD_BASE_POS);
+            nav->std_pos_v = ground_decode_std(p[1], TELEMETRY_STD_BASE_POS);
+            nav->std_vel = ground_decode_std(p[2], TELEMETRY_STD_BASE_VEL);
+            nav->std_att = ground_decode_std(p[3], TELEMETRY_STD_BASE_ATT);
+            break;
+        case TELEMETRY_GROUP_APOGEE:
+            nav->apogee_time = ground_rd16(p) * TELEMETRY_APOGEE_TIME_LSB;
+            nav->apogee_alt = (int32_t)ground_rd32(p + 2) * TELEMETRY_POS_LSB;
+            break;
+        case TELEMETRY_GROUP_BIAS:
+            for (int k = 0; k < 3; k++) {
+                nav->gyro_bias[k] = (int16_t)ground_rd16(p + 2 * k) * TELEMETRY_GYRO_BIAS_LSB;
+                nav->accel_bias[k] = (int16_t)ground_rd16(p + 6 + 2 * k) * TELEMETRY_ACCEL_BIAS_LSB;
+            }
+            break;
+        case TELEMETRY_GROUP_LOAD:
+            nav->load_phase = p[0];
+            nav->load_last_pct = p[1];
+            nav->load_peak_pct = p[2];
+            nav->load_busy_max_us = ground_rd16(p + 3);
+            nav->load_late_bin = p[5];
+            nav->load_misses = ground_rd16(p + 6);
+            break;
+        case TELEMETRY_GROUP_READY:
+            nav->ready_mask = p[0];
+            nav->ready_time = ground_rd16(p + 1);
+            for (int k = 0; k < (int)TELEMETRY_READY_BLOCKS; k++) {
+                nav->ready_block[k] = ground_rd16(p + 3 + 2 * k);
+            }
+            break;
+        case TELEMETRY_GROUP_LANDING:
+            nav->land[0] = (int16_t)ground_rd16(p) * TELEMETRY_LAND_POS_LSB;
+            nav->land[1] = (int16_t)ground_rd16(p + 2) * TELEMETRY_LAND_POS_LSB;
+            nav->land_time = ground_rd16(p + 4) * TELEMETRY_LAND_TIME_LSB;
+            nav->wind[0] = (int16_t)ground_rd16(p + 6) * TELEMETRY_VEL_LSB;
+            nav->wind[1] = (int16_t)ground_rd16(p + 8) * TELEMETRY_VEL_LSB;
+            nav->land_std = ground_decode_std(p[10], TELEMETRY_STD_BASE_LAND);
+            break;
+        case TELEMETRY_GROUP_HIL:
+            nav->hil_fill = p[0];
+            nav->hil_max_fill = p[1];
+            nav->hil_frames = ground_rd16(p + 2);
+            nav->hil_late = ground_rd16(p + 4);
+            nav->hil_dropped = ground_rd16(p + 6);
+            nav->hil_errors = ground_rd16(p + 8);
+            break;
+        case TELEMETRY_GROUP_VIBE:
+            for (int k = 0; k < 3; k++) {
+                nav->vibe_accel_rms[k] = ground_rd16(p + 2 * k) * TELEMETRY_VIBE_ACCEL_LSB;
+                nav->vibe_gyro_rms[k] = ground_rd16(p + 6 + 2 * k) * TELEMETRY_VIBE_GYRO_LSB;
+            }
+            nav->vibe_accel_peak = ground_rd16(p + 12) * TELEMETRY_PEAK_ACCEL_LSB;
+            nav->vibe_gyro_peak = ground_rd16(p + 14) * TELEMETRY_PEAK_GYRO_LSB;
+            nav->vibe_clip_axes = p[16];
+            nav->vibe_clip_total = ground_rd16(p + 17);
+            break;
+        case TELEMETRY_GROUP_NIS:
+            for (int k = 0; k < 2; k++) {
+                const uint8_t *e = p + 6 * k;
+                nav->nis_sensor[k] = e[0];
+                nav->nis_count[k] = e[1];
+                nav->nis_rejects[k] = e[2];
+                nav->nis_mean[k] = ground_decode_std(e[3], TELEMETRY_STD_BASE_NIS);
+                nav->nis_std[k] = ground_decode_std(e[4], TELEMETRY_STD_BASE_NIS);
+                nav->nis_max[k] = ground_decode_std(e[5], TELEMETRY_STD_BASE_NIS);
+            }
+            break;
+        default:
+            break;
+        }
+        p += ground_nav_group_size[g];
+    }
+
+    return true;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file ground_decode.h
+ * @brief 지상국 복원 라이브러리 (호스트용, 비행 기록 블록/레코드와 텔레메트리 프레임을 제자리에서 해석)
+ *
+ * 입력 버퍼(mmap한 기록 이미지, 소켓/시리얼 수신 버퍼)를 복사하지 않고 해석해,
+ * 포인터와 고정 크기 구조체로 된 보기(view)를 돌려준다. 필드마다 할당하지 않으며
+ * 모든 상태는 호출자가 가진 구조체 안에 있다.
+ *
+ * 비행 기록 (Core/Inc/log/flash_log.h, log_codec.h):
+ * - ground_log_next가 기록 이미지를 헤더를 따라 블록 단위로 걷는다. 원본 블록은 이미지 안을
+ *   그대로 가리키고, 압축 모드 블록(PLGZ/PLGP)만 GroundLog의 작업 버퍼 하나로 푼다
+ *   (펌웨어와 같은 복원기 Core/Src/log/log_lz.c를 함께 빌드한다).
+ * - 블록 CRC는 8바이트 단위 표 방식(slicing-by-8)으로 검사한다.
+ * - ground_block_next_record가 레코드 {종류, 길이, 페이로드 포인터}를 기록 순서대로 돌려준다.
+ *   이벤트 전 보관 레코드(FLASH_LOG_REC_PRE_EVENT, log/log_policy.h)는 이벤트 뒤에 기록되어
+ *   시각이 앞서므로 그대로 돌려주고, ground_record_pre_event로 원래 레코드 보기를 꺼낸다.
+ *   공분산(COV), NIS, PIL 레코드도 보기로만 돌려준다 (형식은 log/cov_log.h,
+ *   nav/innovation_monitor.h, sensors/pil_replay.h, 복원 예는 Tools/log/log_decode.c).
+ * - 압축 스트림은 펌웨어 부호기가 블록마다 쓰는 스키마 레코드를 그대로 읽어 복원하므로
+ *   스키마 표를 따로 두지 않는다 (ground_stream_decode, 값 = q x scale).
+ *
+ * 텔레메트리 (Core/Inc/log/telemetry_frame.h, telemetry.h):
+ * - ground_frame_next가 수신 버퍼에서 동기 바이트를 찾아 CRC가 맞는 프레임 보기를 돌려주고,
+ *   버려도 되는 바이트 수를 알려 준다. 끝에 걸친 미완성 프레임은 남겨 두므로 호출자는
+ *   소비한 만큼만 버퍼를 앞으로 당긴 뒤 다음 수신분을 붙인다.
+ * - ground_nav_decode가 항법 해 프레임(TELEMETRY_TYPE_NAV)의 묶음을 물리 단위로 푼다.
+ *
+ * 형식 상수와 레코드 구조체는 펌웨어와 같은 HAL 없는 헤더(log/log_format.h, log/telemetry_format.h)를
+ * 그대로 쓴다 (리틀 엔디언 호스트 가정).
+ */
+
+#ifndef GROUND_DECODE_H
+#define GROUND_DECODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "log/log_format.h"
+#include "log/telemetry_format.h"
+
+/**
+ * @brief 압축 스트림 슬롯 수 (스트림 번호 1바이트)
+ */
+#define GROUND_STREAM_COUNT 256u
+
+/**
+ * @brief CRC-32 (zlib 호환, 펌웨어 hw_crc32와 같음, 8바이트 단위 표 방식)
+ *
+ * 표는 첫 호출에서 만든다 (여러 스레드에서 쓰려면 먼저 한 번 호출).
+ *
+ * @param data 데이터
+ * @param len 길이 (바이트)
+ * @return uint32_t CRC
+ */
+uint32_t ground_crc32(const uint8_t *data, size_t len);
+
+/**
+ * @brief 블록 헤더
+ */
+typedef struct {
+    uint32_t magic;            /**< 원래 블록 표식 (압축 블록은 풀어 낸 뒤 FLASH_LOG_MAGIC) */
+    uint32_t crc;              /**< 블록 CRC */
+    uint32_t seq;              /**< 세션 안 블록 순번 */
+    uint16_t session;          /**< 기록 세션 */
+    uint16_t used;             /**< 헤더 포함 사용 바이트 (풀어 낸 블록 기준) */
+} GroundBlockHeader;
+
+/**
+ * @brief 블록 보기
+ */
+typedef struct {
+    GroundBlockHeader header;  /**< 헤더 */
+    const uint8_t *data;       /**< 4 KB 블록 (이미지 안 또는 GroundLog 작업 버퍼, 다음 호출까지 유효) */
+    size_t offset;             /**< 이미지 안 저장 위치 (바이트) */
+    bool index;                /**< 기록 색인 블록 (레코드 대신 16바이트 항목) */
+    bool packed;               /**< 압축 모드로 저장된 블록 */
+} GroundBlock;
+
+/**
+ * @brief 기록 이미지 통계
+ */
+typedef struct {
+    uint32_t blocks;           /**< CRC가 맞은 데이터 블록 수 */
+    uint32_t index_blocks;     /**< CRC가 맞은 색인 블록 수 */
+    uint32_t packed_blocks;    /**< 그중 압축 모드 블록 수 */
+    uint32_t crc_errors;       /**< CRC 불일치 또는 압축 데이터가 깨진 블록 수 */
+    uint32_t lost_blocks;      /**< 세션 안에서 빠진 블록 순번 수 */
+    uint32_t skipped_sectors;  /**< 표식이 없어 건너뛴 4 KB 구간 수 (지워진 영역 등) */
+} GroundLogStats;
+
+/**
+ * @brief 기록 이미지 걷기 상태
+ */
+typedef struct {
+    const uint8_t *image;      /**< 이미지 (mmap 등, 호출자 소유) */
+    size_t size;               /**< 이미지 크기 */
+    size_t pos;                /**< 다음 블록 위치 */
+    bool has_prev;             /**< 앞 블록이 있는지 (순번 연속 확인) */
+    uint16_t prev_session;
+    uint32_t prev_seq;
+    GroundLogStats stats;      /**< 통계 */
+    uint8_t scratch[FLASH_LOG_BLOCK_SIZE]; /**< 압축 블록 작업 버퍼 */
+} GroundLog;
+
+/**
+ * @brief 레코드 보기
+ */
+typedef struct {
+    uint8_t type;              /**< 레코드 종류 */
+    uint8_t len;               /**< 페이로드 길이 */
+    const uint8_t *payload;    /**< 페이로드 (블록 안) */
+} GroundRecord;
+
+/**
+ * @brief 기록 이미지 걷기 시작
+ *
+ * @param log 상태
+ * @param image 이미지 (기록 영역 시작부터, NOR 덤프/SD 기록 파일/USB로 받은 블록열)
+ * @param size 이미지 크기 (바이트)
+ * @return bool 성공 여부
+ */
+bool ground_log_open(GroundLog *log, const uint8_t *image, size_t size);
+
+/**
+ * @brief 다음 유효 블록 (CRC가 맞지 않는 블록은 세고 건너뜀)
+ *
+ * @param log 상태
+ * @param block 블록 보기
+ * @return bool 블록이 있으면 true, 이미지 끝이면 false
+ */
+bool ground_log_next(GroundLog *log, GroundBlock *block);
+
+/**
+ * @brief 블록 안 다음 레코드
+ *
+ * @param block 데이터 블록
+ * @param offset 읽을 위치 (처음은 FLASH_LOG_BLOCK_HEADER_SIZE, 다음 레코드로 갱신됨)
+ * @param record 레코드 보기
+ * @return bool 레코드가 있으면 true
+ */
+bool ground_block_next_record(const GroundBlock *block, uint32_t *offset, GroundRecord *record);
+
+/**
+ * @brief 이벤트 전 보관 레코드의 원래 레코드 보기 (원래 종류 u8 | 원래 페이로드)
+ *
+ * 꺼낸 보기는 ground_record_imu 등과 ground_stream_decode에 그대로 넘길 수 있다. 시각이 기록
+ * 순서보다 앞서므로 순서대로 처리하는 쪽(평활기, HIL 공급)은 따로 모아 시각순으로 넣어야 한다.
+ *
+ * @param record FLASH_LOG_REC_PRE_EVENT 레코드
+ * @param inner 원래 레코드 보기 (페이로드는 같은 블록 안)
+ * @return bool 이벤트 전 보관 레코드이고 원래 종류가 있으면 true
+ */
+bool ground_record_pre_event(const GroundRecord *record, GroundRecord *inner);
+
+/**
+ * @brief 기록 색인 항목 (FlashLogIndexEntry)
+ */
+typedef struct {
+    uint32_t timestamp_us;     /**< 시각 (us) */
+    uint32_t block;            /**< 가리키는 데이터 블록 (기록 영역 시작 기준) */
+    uint32_t value;            /**< 종류별 값 */
+    uint16_t session;          /**< 세션 */
+    uint8_t kind;              /**< 항목 종류 (1 시각, 2 이벤트, 3 단계) */
+    uint8_t arg;               /**< 종류별 인자 */
+} GroundIndexEntry;
+
+/**
+ * @brief 색인 블록의 항목 읽기
+ *
+ * @param block 색인 블록
+ * @param i 항목 번호
+ * @param entry 항목
+ * @return bool 항목이 있으면 true
+ */
+bool ground_index_entry(const GroundBlock *block, uint32_t i, GroundIndexEntry *entry);
+
+/**
+ * @brief 압축 스트림 상태 (블록마다 스키마부터 다시 채움)
+ */
+typedef struct {
+    uint32_t generation;       /**< 스키마를 읽은 블록 세대 (GroundStreams.generation과 같아야 유효) */
+    bool primed;               /**< 이 블록에서 키프레임을 읽었는지 */
+    uint8_t id;                /**< 스트림 번호 */
+    uint8_t field_count;       /**< 필드 수 */
+    char name[LOG_CODEC_NAME_SIZE + 1]; /**< 이름 (NUL 종료) */
+    float scale[LOG_CODEC_MAX_FIELDS];  /**< 양자화 간격 */
+    int32_t q[LOG_CODEC_MAX_FIELDS];    /**< 현재 양자화 값 */
+    uint32_t t_us;             /**< 현재 시각 (us) */
+    uint32_t dt_us;            /**< 현재 간격 (us) */
+} GroundStream;
+
+/**
+ * @brief 압축 스트림 복원기
+ */
+typedef struct {
+    uint32_t generation;       /**< 블록 세대 (블록마다 1 증가, 스트림 표를 지우지 않고 무효화) */
+    uint32_t errors;           /**< 잘린 레코드 또는 스키마 없는 레코드 수 */
+    GroundStream stream[GROUND_STREAM_COUNT];
+} GroundStreams;
+
+/**
+ * @brief 복원한 샘플 보기
+ */
+typedef struct {
+    const GroundStream *stream; /**< 스트림 (이름, 필드 수, 눈금, 값) */
+    uint32_t t_us;             /**< 샘플 시각 (us) */
+} GroundSample;
+
+/**
+ * @brief 복원기 초기화
+ *
+ * @param streams 복원기
+ */
+void ground_streams_init(GroundStreams *streams);
+
+/**
+ * @brief 새 블록 시작 (블록 레코드를 읽기 전에 호출)
+ *
+ * @param streams 복원기
+ */
+void ground_streams_begin_block(GroundStreams *streams);
+
+/**
+ * @brief 압축 스트림 레코드 하나 복원
+ *
+ * @param streams 복원기
+ * @param record SCHEMA, KEY, DELTA 레코드
+ * @param sample 복원한 샘플 (KEY, DELTA)
+ * @return bool 샘플이 나왔으면 true (스키마 레코드와 오류는 false)
+ */
+bool ground_stream_decode(GroundStreams *streams, const GroundRecord *record, GroundSample *sample);
+
+/**
+ * @brief 샘플 필드 값 (q x scale)
+ *
+ * @param sample 샘플
+ * @param i 필드 번호
+ * @return double 값
+ */
+static inline double ground_sample_value(const GroundSample *sample, uint8_t i) {
+    return (double)sample->stream->q[i] * (double)sample->stream->scale[i];
+}
+
+/**
+ * @brief 원시 센서 레코드 (log/log_format.h 구조체 그대로)
+ */
+typedef FlashLogImuRecord GroundImu;
+typedef FlashLogBaroRecord GroundBaro;
+typedef FlashLogMagRecord GroundMag;
+typedef FlashLogGnssRecord GroundGnss;
+
+/**
+ * @brief 원시 레코드 해석 (종류와 길이가 맞을 때만, GNSS는 길이가 더 길어도 앞부분을 읽음)
+ *
+ * @param record 레코드
+ * @param out 출력
+ * @return bool 성공 여부
+ */
+bool ground_record_imu(const GroundRecord *record, GroundImu *out);
+bool ground_record_baro(const GroundRecord *record, GroundBaro *out);
+bool ground_record_mag(const GroundRecord *record, GroundMag *out);
+bool ground_record_gnss(const GroundRecord *record, GroundGnss *out);
+
+/**
+ * @brief 텔레메트리 프레임 보기
+ */
+typedef struct {
+    uint8_t type;              /**< 프레임 종류 */
+    uint8_t len;               /**< 페이로드 길이 */
+    uint16_t seq;              /**< 프레임 순번 */
+    const uint8_t *payload;    /**< 페이로드 (수신 버퍼 안, 버퍼를 당기기 전까지 유효) */
+} GroundFrame;
+
+/**
+ * @brief 프레임 수신 상태와 통계
+ */
+typedef struct {
+    bool has_seq;              /**< 앞 프레임 순번이 있는지 */
+    uint16_t last_seq;         /**< 앞 프레임 순번 */
+    uint32_t frames;           /**< CRC가 맞은 프레임 수 */
+    uint32_t crc_errors;       /**< CRC 불일치 수 */
+    uint32_t lost;             /**< 순번 차로 센 잃은 프레임 수 */
+    uint64_t resync_bytes;     /**< 동기를 찾느라 버린 바이트 수 */
+} GroundFrameParser;
+
+/**
+ * @brief 프레임 수신 초기화
+ *
+ * @param parser 상태
+ */
+void ground_frame_init(GroundFrameParser *parser);
+
+/**
+ * @brief 수신 버퍼에서 다음 프레임 찾기
+ *
+ * @param parser 상태
+ * @param buf 수신 버퍼
+ * @param len 버퍼 길이
+ * @param consumed 버려도 되는 앞부분 바이트 수 (프레임을 찾았으면 그 프레임 끝까지)
+ * @param frame 프레임 보기
+ * @return bool 프레임을 찾았으면 true (false이면 나머지는 미완성 프레임일 수 있음)
+ */
+bool ground_frame_next(GroundFrameParser *parser, const uint8_t *buf, size_t len, size_t *consumed,
+                       GroundFrame *frame);
+
+/**
+ * @brief 항법 해 프레임 내용 (mask에 없는 묶음은 0)
+ */
+typedef struct {
+    uint32_t t_us;             /**< 해 시각 (us) */
+    uint16_t mask;             /**< 들어 있는 묶음 (TELEMETRY_GROUP_* 비트) */
+    double q[4];               /**< 자세 사원수 (w, x, y, z) */
+    double pos[3];             /**< 위치 (m) */
+    double vel[3];             /**< 속도 (m/s) */
+    double std_pos_h;          /**< 수평 위치 표준 편차 (m) */
+    double std_pos_v;          /**< 수직 위치 표준 편차 (m) */
+    double std_vel;            /**< 속도 표준 편차 (m/s) */
+    double std_att;            /**< 자세 표준 편차 (rad) */
+    double apogee_time;        /**< 정점까지 시간 (s) */
+    double apogee_alt;         /**< 예측 정점 고도 (m) */
+    double gyro_bias[3];       /**< 자이로 바이어스 (rad/s) */
+    double accel_bias[3];      /**< 가속도 바이어스 (m/s^2) */
+    uint8_t load_phase;        /**< 부하: 비행 단계 */
+    uint8_t load_last_pct;     /**< 부하: 마지막 사이클 (%) */
+    uint8_t load_peak_pct;     /**< 부하: 최대 사이클 (%) */
+    uint16_t load_busy_max_us; /**< 부하: 최대 사이클 처리 시간 (us) */
+    uint8_t load_late_bin;     /**< 부하: 지연 99% 분위 칸 */
+    uint16_t load_misses;      /**< 부하: 마감 초과 샘플 수 */
+    uint8_t ready_mask;        /**< 준비: 수렴 블록 (bit7 = 준비) */
+    uint16_t ready_time;       /**< 준비: 첫 준비까지 (0.1 s, 0xFFFF = 아직) */
+    uint16_t ready_block[TELEMETRY_READY_BLOCKS]; /**< 준비: 블록별 첫 수렴까지 (0.1 s) */
+    double land[2];            /**< 착지: 예측 착지 지점 xy (m) */
+    double land_time;          /**< 착지: 착지까지 시간 (s) */
+    double wind[2];            /**< 착지: 바람 xy (m/s) */
+    double land_std;           /**< 착지: 착지 지점 수평 표준 편차 (m) */
+    uint8_t hil_fill;          /**< HIL: 중계 링 사용량 */
+    uint8_t hil_max_fill;      /**< HIL: 중계 링 최대 사용량 */
+    uint16_t hil_frames;       /**< HIL: 받은 프레임 수 (순환) */
+    uint16_t hil_late;         /**< HIL: 늦은 IMU 레코드 수 */
+    uint16_t hil_dropped;      /**< HIL: 버린 레코드 수 */
+    uint16_t hil_errors;       /**< HIL: 오류 수 */
+    double vibe_accel_rms[3];  /**< 진동: 가속도 진동 RMS (m/s^2) */
+    double vibe_gyro_rms[3];   /**< 진동: 자이로 진동 RMS (rad/s) */
+    double vibe_accel_peak;    /**< 진동: 가속도 |값| 최대 (m/s^2) */
+    double vibe_gyro_peak;     /**< 진동: 자이로 |값| 최대 (rad/s) */
+    uint8_t vibe_clip_axes;    /**< 진동: 창에서 포화된 축 (bit0..2 자이로, bit3..5 가속도) */
+    uint16_t vibe_clip_total;  /**< 진동: 누적 포화 (포화) */
+    uint8_t nis_sensor[2];     /**< NIS: 측정 종류 (EKF_Sensor, 0xFF = 없음) */
+    uint8_t nis_count[2];      /**< NIS: 창의 NIS 수 (포화) */
+    uint8_t nis_rejects[2];    /**< NIS: 창의 게이트 거부 수 (포화) */
+    double nis_mean[2];        /**< NIS: 평균 */
+    double nis_std[2];         /**< NIS: 표준 편차 */
+    double nis_max[2];         /**< NIS: 최댓값 */
+} GroundNav;
+
+/**
+ * @brief 항법 해 프레임 풀기
+ *
+ * @param frame TELEMETRY_TYPE_NAV 프레임
+ * @param nav 출력
+ * @return bool 성공 여부 (종류가 다르거나 묶음이 페이로드를 넘으면 false)
+ */
+bool ground_nav_decode(const GroundFrame *frame, GroundNav *nav);
+
+#endif /* GROUND_DECODE_H */
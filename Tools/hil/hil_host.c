@@ -0,0 +1,340 @@
+/**
+ * @file hil_host.c
+ * @brief HIL(hardware-in-the-loop) 호스트 프로그램 (호스트용, POSIX)
+ *
+ * 기록 이미지(flight_sim 합성 기록 또는 log_fetch로 내려받은 비행 기록)의 원시 센서 레코드
+ * (IMU/기압/자기장/GNSS)를 HIL 빌드 보드(Core/Inc/sensors/hil_feed.h)로 실시간 보낸다.
+ * 레코드는 기록 순서(도착 순서) 그대로 보내며, IMU 레코드 시각에 맞춰 속도를 맞춘다.
+ * 보내는 동안 같은 포트로 돌아오는 텔레메트리를 받아 항법 해와 LOAD/HIL 묶음을 CSV로 표준 출력에
+ * 쓴다. 압축 스트림(SCHEMA/KEY/DELTA) 기록은 보낼 수 없다 (기록 설정에서 원시 레코드로 남길 것).
+ *
+ * 프레임 형식은 telemetry_frame과 같다 (종류 HIL_TYPE_RECORD, 페이로드 = 레코드 종류 u8 + 레코드).
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -ITools/ground -o hil_host Tools/hil/hil_host.c Tools/ground/ground_decode.c \
+ *       Core/Src/log/log_lz.c -lm
+ *   ./flight_sim > sim.bin
+ *   ./hil_host [-b 921600] [-x 배속] /dev/ttyUSB0 sim.bin > hil.csv
+ */
+
+#include "ground_decode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+
+/**
+ * @brief 프로토콜 (hil_feed.h)
+ */
+#define HIL_TYPE_RECORD 0x10u
+
+/**
+ * @brief 수신 버퍼 크기
+ */
+#define RX_BUFFER_SIZE 65536u
+
+/**
+ * @brief 단조 증가 시계 (us)
+ */
+static int64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief 보율 상수
+ */
+static speed_t baud_constant(long baud) {
+    switch (baud) {
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 921600:
+        return B921600;
+    case 1000000:
+        return B1000000;
+    case 2000000:
+        return B2000000;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief 직렬 포트 열기 (원시 모드)
+ */
+static int port_open(const char *path, long baud) {
+    speed_t speed = baud_constant(baud);
+    if (speed == 0) {
+        fprintf(stderr, "지원하지 않는 보율: %ld\n", baud);
+        return -1;
+    }
+
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    tcflush(fd, TCIOFLUSH);
+
+    return fd;
+}
+
+/**
+ * @brief 모두 쓰기
+ */
+static bool port_write(int fd, const uint8_t *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return false;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 하향 링크 수신 상태
+ */
+typedef struct {
+    uint8_t buf[RX_BUFFER_SIZE];
+    size_t fill;
+    GroundFrameParser parser;
+    uint32_t other;
+} Downlink;
+
+/**
+ * @brief 받은 바이트를 프레임으로 끊어 CSV로 씀
+ */
+static void downlink_poll(int fd, Downlink *dl) {
+    ssize_t n = read(fd, &dl->buf[dl->fill], sizeof(dl->buf) - dl->fill);
+    if (n <= 0) {
+        return;
+    }
+    dl->fill += (size_t)n;
+
+    size_t start = 0;
+    size_t used;
+    GroundFrame frame;
+    while (ground_frame_next(&dl->parser, &dl->buf[start], dl->fill - start, &used, &frame)) {
+        start += used;
+        GroundNav nav;
+        if (!ground_nav_decode(&frame, &nav)) {
+            dl->other++;
+            continue;
+        }
+        printf("%u,%u,0x%03x,%.5f,%.5f,%.5f,%.5f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+               frame.seq, nav.t_us, nav.mask, nav.q[0], nav.q[1], nav.q[2], nav.q[3], nav.pos[0], nav.pos[1],
+               nav.pos[2], nav.vel[0], nav.vel[1], nav.vel[2], nav.load_phase, nav.load_peak_pct,
+               nav.load_busy_max_us, nav.load_misses, nav.hil_fill, nav.hil_max_fill, nav.hil_frames,
+               nav.hil_late, nav.hil_dropped, nav.hil_errors, (unsigned)((nav.mask >> TELEMETRY_GROUP_HIL) & 1u));
+    }
+    start += used;
+    memmove(dl->buf, &dl->buf[start], dl->fill - start);
+    dl->fill -= start;
+}
+
+/**
+ * @brief 한계 시각까지 하향 링크를 받으며 기다림
+ */
+static void wait_until(int fd, Downlink *dl, int64_t deadline) {
+    for (;;) {
+        int64_t left = deadline - now_us();
+        if (left <= 0) {
+            return;
+        }
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(fd, &set);
+        struct timeval tv = { (time_t)(left / 1000000), (suseconds_t)(left % 1000000) };
+        int r = select(fd + 1, &set, NULL, NULL, &tv);
+        if (r < 0 && errno != EINTR) {
+            return;
+        }
+        if (r > 0) {
+            downlink_poll(fd, dl);
+        }
+    }
+}
+
+/**
+ * @brief 레코드 하나를 프레임으로 보냄
+ */
+static bool send_record(int fd, uint16_t seq, const GroundRecord *rec) {
+    uint8_t frame[TELEMETRY_FRAME_MAX_SIZE];
+    uint8_t len = (uint8_t)(rec->len + 1u);
+
+    frame[0] = TELEMETRY_FRAME_SYNC1;
+    frame[1] = TELEMETRY_FRAME_SYNC2;
+    frame[2] = len;
+    frame[3] = HIL_TYPE_RECORD;
+    frame[4] = (uint8_t)seq;
+    frame[5] = (uint8_t)(seq >> 8);
+    frame[TELEMETRY_FRAME_HEADER] = rec->type;
+    memcpy(&frame[TELEMETRY_FRAME_HEADER + 1], rec->payload, rec->len);
+
+    // CRC 범위는 길이 필드부터 페이로드 끝까지
+    uint32_t crc = ground_crc32(&frame[2], (size_t)(TELEMETRY_FRAME_HEADER - 2u) + len);
+    uint8_t *t = &frame[TELEMETRY_FRAME_HEADER + len];
+    t[0] = (uint8_t)crc;
+    t[1] = (uint8_t)(crc >> 8);
+    t[2] = (uint8_t)(crc >> 16);
+    t[3] = (uint8_t)(crc >> 24);
+
+    return port_write(fd, frame, (size_t)(TELEMETRY_FRAME_HEADER + len + TELEMETRY_FRAME_TRAILER));
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "사용법: %s [-b 보율] [-x 배속] 직렬장치 기록이미지\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    long baud = 921600;
+    double speed = 1.0;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:x:")) != -1) {
+        switch (opt) {
+        case 'b':
+            baud = strtol(optarg, NULL, 10);
+            break;
+        case 'x':
+            speed = strtod(optarg, NULL);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc - optind != 2 || !(speed > 0.0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int log_fd = open(argv[optind + 1], O_RDONLY);
+    if (log_fd < 0) {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+    struct stat st;
+    if (fstat(log_fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "%s: 빈 이미지\n", argv[optind + 1]);
+        close(log_fd);
+        return 1;
+    }
+    size_t size = (size_t)st.st_size;
+    const uint8_t *image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, log_fd, 0);
+    if (image == MAP_FAILED) {
+        perror("mmap");
+        close(log_fd);
+        return 1;
+    }
+
+    int fd = port_open(argv[optind], baud);
+    if (fd < 0) {
+        munmap((void *)image, size);
+        close(log_fd);
+        return 1;
+    }
+
+    static GroundLog log;
+    static Downlink dl;
+    ground_log_open(&log, image, size);
+    ground_frame_init(&dl.parser);
+
+    printf("seq,t_us,mask,qw,qx,qy,qz,px,py,pz,vx,vy,vz,load_phase,load_peak_pct,load_busy_max_us,load_misses,"
+           "hil_fill,hil_max_fill,hil_frames,hil_late,hil_dropped,hil_errors,hil_valid\n");
+
+    uint16_t seq = 0;
+    uint64_t sent[FLASH_LOG_REC_GNSS + 1] = { 0 };
+    uint64_t skipped = 0;
+    bool started = false;
+    uint32_t t0_rec = 0;
+    int64_t t0_host = 0;
+    int64_t lag_max = 0;
+
+    GroundBlock block;
+    while (ground_log_next(&log, &block)) {
+        if (block.index) {
+            continue;
+        }
+
+        uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE;
+        GroundRecord rec;
+        while (ground_block_next_record(&block, &o, &rec)) {
+            if (rec.type < FLASH_LOG_REC_IMU || rec.type > FLASH_LOG_REC_GNSS || rec.len < 4u) {
+                skipped++;
+                continue;
+            }
+
+            // IMU 레코드 시각에 맞춰 보냄 (다른 레코드는 기록 순서대로 바로 뒤따름)
+            if (rec.type == FLASH_LOG_REC_IMU) {
+                uint32_t t_rec = (uint32_t)rec.payload[0] | (uint32_t)rec.payload[1] << 8 |
+                                 (uint32_t)rec.payload[2] << 16 | (uint32_t)rec.payload[3] << 24;
+                if (!started) {
+                    t0_rec = t_rec;
+                    t0_host = now_us();
+                    started = true;
+                }
+                int64_t due = t0_host + (int64_t)((double)(uint32_t)(t_rec - t0_rec) / speed);
+                int64_t lag = now_us() - due;
+                if (lag > lag_max) {
+                    lag_max = lag;
+                }
+                wait_until(fd, &dl, due);
+            }
+
+            if (!send_record(fd, seq++, &rec)) {
+                perror("write");
+                munmap((void *)image, size);
+                close(log_fd);
+                close(fd);
+                return 1;
+            }
+            sent[rec.type]++;
+        }
+    }
+
+    // 마지막 레코드가 처리될 때까지 하향 링크를 조금 더 받음
+    wait_until(fd, &dl, now_us() + 1000000);
+    fflush(stdout);
+
+    fprintf(stderr, "보낸 레코드 IMU %llu, 기압 %llu, 자기장 %llu, GNSS %llu, 건너뛴 레코드 %llu, 최대 송신 지연 %lld us\n",
+            (unsigned long long)sent[FLASH_LOG_REC_IMU], (unsigned long long)sent[FLASH_LOG_REC_BARO],
+            (unsigned long long)sent[FLASH_LOG_REC_MAG], (unsigned long long)sent[FLASH_LOG_REC_GNSS],
+            (unsigned long long)skipped, (long long)lag_max);
+    fprintf(stderr, "받은 프레임 %u개 (항법 외 %u), CRC 불일치 %u, 잃은 프레임 %u\n", dl.parser.frames, dl.other,
+            dl.parser.crc_errors, dl.parser.lost);
+
+    munmap((void *)image, size);
+    close(log_fd);
+    close(fd);
+
+    return 0;
+}
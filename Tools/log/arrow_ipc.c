@@ -0,0 +1,462 @@
+/**
+ * @file arrow_ipc.c
+ * @brief Apache Arrow IPC 파일 작성기 구현
+ *
+ * flatbuffers는 앞에서 뒤로 만든다: 부모 테이블을 먼저 쓰고 자식 오프셋 자리는 비워 두었다가
+ * 자식을 뒤에 쓴 다음 채운다 (uoffset은 항상 뒤쪽을 가리켜야 함). vtable은 테이블 바로 앞에
+ * 두고 테이블 시작은 8바이트 정렬, 필드는 크기 순으로 놓아 절대 위치 정렬을 지킨다.
+ * 스키마 정의는 Arrow 저장소의 format/Schema.fbs, Message.fbs, File.fbs 이다.
+ */
+
+#include "arrow_ipc.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Arrow 상수
+ */
+#define ARROW_METADATA_V5 4        /**< MetadataVersion.V5 */
+#define ARROW_HEADER_SCHEMA 1      /**< MessageHeader.Schema */
+#define ARROW_HEADER_RECORD_BATCH 3 /**< MessageHeader.RecordBatch */
+#define ARROW_TYPE_INT 2           /**< Type.Int */
+#define ARROW_TYPE_FLOAT 3         /**< Type.FloatingPoint */
+#define ARROW_PRECISION_SINGLE 1   /**< Precision.SINGLE */
+#define ARROW_PRECISION_DOUBLE 2   /**< Precision.DOUBLE */
+#define ARROW_CONTINUATION 0xFFFFFFFFu /**< 메시지 앞 계속 표식 */
+
+/**
+ * @brief flatbuffers 버퍼
+ */
+typedef struct {
+    uint8_t *d;
+    size_t len;
+    size_t cap;
+    bool failed;
+} Fb;
+
+/**
+ * @brief 테이블 필드 (size 0이면 없음)
+ */
+typedef struct {
+    uint8_t size;
+    uint64_t value;
+} FbSlot;
+
+static void fb_reserve(Fb *b, size_t n) {
+    if (b->len + n <= b->cap) {
+        return;
+    }
+    size_t cap = (b->cap == 0) ? 1024u : b->cap;
+    while (cap < b->len + n) {
+        cap *= 2u;
+    }
+    uint8_t *d = realloc(b->d, cap);
+    if (d == NULL) {
+        b->failed = true;
+        return;
+    }
+    b->d = d;
+    b->cap = cap;
+}
+
+static size_t fb_zero(Fb *b, size_t n) {
+    fb_reserve(b, n);
+    if (b->failed) {
+        return b->len;
+    }
+    size_t at = b->len;
+    memset(&b->d[at], 0, n);
+    b->len += n;
+    return at;
+}
+
+static void fb_pad(Fb *b, size_t align) {
+    fb_zero(b, (align - b->len % align) % align);
+}
+
+static void fb_put(Fb *b, size_t at, uint64_t v, uint8_t size) {
+    if (b->failed) {
+        return;
+    }
+    for (uint8_t i = 0; i < size; i++) {
+        b->d[at + i] = (uint8_t)(v >> (8u * i));
+    }
+}
+
+/**
+ * @brief 오프셋 채우기 (at의 uoffset이 target을 가리킴)
+ */
+static void fb_link(Fb *b, size_t at, size_t target) {
+    fb_put(b, at, (uint64_t)(target - at), 4);
+}
+
+/**
+ * @brief 테이블 쓰기 (vtable + 테이블), 필드 위치를 pos에 돌려줌
+ *
+ * @return size_t 테이블 위치
+ */
+static size_t fb_table(Fb *b, const FbSlot *slot, uint8_t n, size_t *pos) {
+    // 테이블 안 배치: soffset 뒤에 큰 필드부터
+    uint16_t off[16] = { 0 };
+    uint16_t cur = 4;
+    for (uint8_t s = 8; s >= 1; s /= 2) {
+        for (uint8_t i = 0; i < n; i++) {
+            if (slot[i].size == s) {
+                cur = (uint16_t)((cur + s - 1u) / s * s);
+                off[i] = cur;
+                cur = (uint16_t)(cur + s);
+            }
+        }
+    }
+    uint16_t inline_size = (uint16_t)((cur + 3u) / 4u * 4u);
+
+    // vtable은 테이블 바로 앞 (테이블이 8바이트 정렬이 되도록 앞을 채움)
+    size_t vt_size = 4u + 2u * n;
+    fb_pad(b, 2);
+    fb_zero(b, (8u - (b->len + vt_size) % 8u) % 8u);
+    size_t vt = fb_zero(b, vt_size);
+    fb_put(b, vt, vt_size, 2);
+    fb_put(b, vt + 2u, inline_size, 2);
+    for (uint8_t i = 0; i < n; i++) {
+        fb_put(b, vt + 4u + 2u * i, off[i], 2);
+    }
+
+    size_t table = fb_zero(b, inline_size);
+    fb_put(b, table, (uint64_t)(table - vt), 4);
+    for (uint8_t i = 0; i < n; i++) {
+        if (slot[i].size > 0) {
+            fb_put(b, table + off[i], slot[i].value, slot[i].size);
+        }
+        if (pos != NULL) {
+            pos[i] = table + off[i];
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief 벡터 쓰기 (원소는 0으로 채워 둠)
+ *
+ * @return size_t 벡터 위치 (길이 필드, 원소는 +4부터)
+ */
+static size_t fb_vector(Fb *b, uint32_t count, size_t elem_size, size_t align) {
+    if (align < 4u) {
+        align = 4u;
+    }
+    fb_zero(b, (align - (b->len + 4u) % align) % align);
+    size_t at = fb_zero(b, 4u + count * elem_size);
+    fb_put(b, at, count, 4);
+
+    return at;
+}
+
+/**
+ * @brief 문자열 쓰기
+ *
+ * @return size_t 문자열 위치 (길이 필드)
+ */
+static size_t fb_string(Fb *b, const char *s) {
+    size_t n = strlen(s);
+    fb_pad(b, 4);
+    size_t at = fb_zero(b, 4u + n + 1u);
+    fb_put(b, at, n, 4);
+    if (!b->failed) {
+        memcpy(&b->d[at + 4u], s, n);
+    }
+
+    return at;
+}
+
+/**
+ * @brief Schema 테이블과 하위 객체 쓰기
+ */
+static size_t fb_schema(Fb *b, const ArrowWriter *w) {
+    // Schema { endianness, fields }
+    const FbSlot schema[2] = { { 2, 0 }, { 4, 0 } };
+    size_t spos[2];
+    size_t table = fb_table(b, schema, 2, spos);
+
+    size_t fields = fb_vector(b, w->columns, 4, 4);
+    fb_link(b, spos[1], fields);
+
+    for (uint32_t c = 0; c < w->columns; c++) {
+        // Field { name, nullable, type_type, type, dictionary, children }
+        bool is_int = w->type[c] == ARROW_UINT32;
+        const FbSlot field[6] = {
+            { 4, 0 }, { 1, 0 }, { 1, is_int ? ARROW_TYPE_INT : ARROW_TYPE_FLOAT }, { 4, 0 }, { 0, 0 }, { 4, 0 }
+        };
+        size_t fpos[6];
+        size_t ft = fb_table(b, field, 6, fpos);
+        fb_link(b, fields + 4u + 4u * c, ft);
+
+        fb_link(b, fpos[0], fb_string(b, w->name[c]));
+        if (is_int) {
+            // Int { bitWidth, is_signed }
+            const FbSlot t[2] = { { 4, 32 }, { 1, 0 } };
+            fb_link(b, fpos[3], fb_table(b, t, 2, NULL));
+        } else {
+            // FloatingPoint { precision }
+            const FbSlot t[1] = {
+                { 2, (w->type[c] == ARROW_FLOAT32) ? ARROW_PRECISION_SINGLE : ARROW_PRECISION_DOUBLE }
+            };
+            fb_link(b, fpos[3], fb_table(b, t, 1, NULL));
+        }
+        fb_link(b, fpos[5], fb_vector(b, 0, 4, 4));
+    }
+
+    return table;
+}
+
+/**
+ * @brief 원시 쓰기
+ */
+static void arrow_write(ArrowWriter *w, const void *p, size_t n) {
+    if (n > 0 && fwrite(p, 1, n, w->f) != n) {
+        w->failed = true;
+    }
+    w->offset += (int64_t)n;
+}
+
+static void arrow_write_zero(ArrowWriter *w, size_t n) {
+    static const uint8_t zero[8] = { 0 };
+    while (n > 0) {
+        size_t k = (n < sizeof(zero)) ? n : sizeof(zero);
+        arrow_write(w, zero, k);
+        n -= k;
+    }
+}
+
+/**
+ * @brief 메시지 쓰기 (계속 표식, 메타데이터 길이, 메타데이터, 본문)
+ *
+ * @return int32_t 접두사 포함 메타데이터 길이
+ */
+static int32_t arrow_write_message(ArrowWriter *w, Fb *b) {
+    fb_pad(b, 8);
+    uint8_t prefix[8];
+    uint32_t len = (uint32_t)b->len;
+    for (uint8_t i = 0; i < 4; i++) {
+        prefix[i] = (uint8_t)(ARROW_CONTINUATION >> (8u * i));
+        prefix[4 + i] = (uint8_t)(len >> (8u * i));
+    }
+    arrow_write(w, prefix, sizeof(prefix));
+    arrow_write(w, b->d, b->len);
+
+    return (int32_t)(sizeof(prefix) + b->len);
+}
+
+static size_t arrow_type_size(ArrowType type) {
+    return (type == ARROW_FLOAT64) ? 8u : 4u;
+}
+
+/**
+ * @brief 모은 행을 레코드 배치로 기록
+ */
+static void arrow_flush(ArrowWriter *w) {
+    if (w->rows == 0) {
+        return;
+    }
+
+    // 본문: 열마다 값 버퍼 (8바이트 정렬, 유효성 버퍼 없음)
+    int64_t body = 0;
+    int64_t value_offset[ARROW_MAX_COLUMNS];
+    for (uint32_t c = 0; c < w->columns; c++) {
+        value_offset[c] = body;
+        body += (int64_t)((w->rows * arrow_type_size(w->type[c]) + 7u) / 8u * 8u);
+    }
+
+    // Message { version, header_type, header, bodyLength }
+    Fb b = { 0 };
+    size_t root = fb_zero(&b, 4);
+    const FbSlot msg[4] = { { 2, ARROW_METADATA_V5 }, { 1, ARROW_HEADER_RECORD_BATCH }, { 4, 0 }, { 8, (uint64_t)body } };
+    size_t mpos[4];
+    fb_link(&b, root, fb_table(&b, msg, 4, mpos));
+
+    // RecordBatch { length, nodes, buffers }
+    const FbSlot rb[3] = { { 8, w->rows }, { 4, 0 }, { 4, 0 } };
+    size_t rpos[3];
+    fb_link(&b, mpos[2], fb_table(&b, rb, 3, rpos));
+
+    size_t nodes = fb_vector(&b, w->columns, 16, 8);
+    fb_link(&b, rpos[1], nodes);
+    for (uint32_t c = 0; c < w->columns; c++) {
+        // FieldNode { length, null_count }
+        fb_put(&b, nodes + 4u + 16u * c, w->rows, 8);
+    }
+    size_t buffers = fb_vector(&b, 2u * w->columns, 16, 8);
+    fb_link(&b, rpos[2], buffers);
+    for (uint32_t c = 0; c < w->columns; c++) {
+        // Buffer { offset, length }: 유효성 (비어 있음), 값
+        size_t at = buffers + 4u + 32u * c;
+        fb_put(&b, at, (uint64_t)value_offset[c], 8);
+        fb_put(&b, at + 16u, (uint64_t)value_offset[c], 8);
+        fb_put(&b, at + 24u, w->rows * arrow_type_size(w->type[c]), 8);
+    }
+
+    if (b.failed) {
+        w->failed = true;
+        free(b.d);
+        return;
+    }
+
+    ArrowBlock block = { .offset = w->offset };
+    block.meta_length = arrow_write_message(w, &b);
+    block.body_length = body;
+    free(b.d);
+    for (uint32_t c = 0; c < w->columns; c++) {
+        size_t n = w->rows * arrow_type_size(w->type[c]);
+        arrow_write(w, w->data[c], n);
+        arrow_write_zero(w, (8u - n % 8u) % 8u);
+    }
+
+    if (w->block_count == w->block_capacity) {
+        uint32_t cap = (w->block_capacity == 0) ? 16u : 2u * w->block_capacity;
+        ArrowBlock *blocks = realloc(w->blocks, cap * sizeof(ArrowBlock));
+        if (blocks == NULL) {
+            w->failed = true;
+            return;
+        }
+        w->blocks = blocks;
+        w->block_capacity = cap;
+    }
+    w->blocks[w->block_count++] = block;
+    w->total_rows += w->rows;
+    w->rows = 0;
+}
+
+/**
+ * @brief 파일 열기와 스키마 기록
+ */
+bool arrow_open(ArrowWriter *w, const char *path, uint32_t columns, const char *const *names,
+                const ArrowType *types, uint32_t batch_rows) {
+    if (w == NULL || path == NULL || names == NULL || types == NULL ||
+        columns == 0 || columns > ARROW_MAX_COLUMNS) {
+        return false;
+    }
+
+    memset(w, 0, sizeof(*w));
+    w->columns = columns;
+    w->batch_rows = (batch_rows > 0) ? batch_rows : ARROW_DEFAULT_BATCH_ROWS;
+    for (uint32_t c = 0; c < columns; c++) {
+        w->name[c] = strdup(names[c]);
+        w->type[c] = types[c];
+        w->data[c] = malloc(w->batch_rows * arrow_type_size(types[c]));
+        if (w->name[c] == NULL || w->data[c] == NULL) {
+            w->failed = true;
+        }
+    }
+    if (!w->failed) {
+        w->f = fopen(path, "wb");
+    }
+    if (w->f == NULL) {
+        arrow_close(w);
+        return false;
+    }
+
+    // 파일 표식 (6바이트 + 2바이트 채움) 뒤 스키마 메시지
+    arrow_write(w, "ARROW1\0\0", 8);
+    Fb b = { 0 };
+    size_t root = fb_zero(&b, 4);
+    const FbSlot msg[4] = { { 2, ARROW_METADATA_V5 }, { 1, ARROW_HEADER_SCHEMA }, { 4, 0 }, { 8, 0 } };
+    size_t mpos[4];
+    fb_link(&b, root, fb_table(&b, msg, 4, mpos));
+    fb_link(&b, mpos[2], fb_schema(&b, w));
+    if (b.failed) {
+        w->failed = true;
+    } else {
+        arrow_write_message(w, &b);
+    }
+    free(b.d);
+
+    return !w->failed;
+}
+
+/**
+ * @brief 행 하나 추가
+ */
+bool arrow_append(ArrowWriter *w, const double *values) {
+    if (w == NULL || w->f == NULL || values == NULL) {
+        return false;
+    }
+
+    for (uint32_t c = 0; c < w->columns; c++) {
+        uint8_t *p = &w->data[c][w->rows * arrow_type_size(w->type[c])];
+        if (w->type[c] == ARROW_UINT32) {
+            uint32_t v = (uint32_t)values[c];
+            memcpy(p, &v, sizeof(v));
+        } else if (w->type[c] == ARROW_FLOAT32) {
+            float v = (float)values[c];
+            memcpy(p, &v, sizeof(v));
+        } else {
+            memcpy(p, &values[c], sizeof(double));
+        }
+    }
+    if (++w->rows == w->batch_rows) {
+        arrow_flush(w);
+    }
+
+    return !w->failed;
+}
+
+/**
+ * @brief 남은 배치와 꼬리말 기록 후 닫기
+ */
+bool arrow_close(ArrowWriter *w) {
+    if (w == NULL) {
+        return false;
+    }
+
+    if (w->f != NULL) {
+        arrow_flush(w);
+
+        // 스트림 끝 표식 (계속 표식 + 길이 0)
+        const uint8_t eos[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+        arrow_write(w, eos, sizeof(eos));
+
+        // Footer { version, schema, dictionaries, recordBatches }
+        Fb b = { 0 };
+        size_t root = fb_zero(&b, 4);
+        const FbSlot footer[4] = { { 2, ARROW_METADATA_V5 }, { 4, 0 }, { 0, 0 }, { 4, 0 } };
+        size_t fpos[4];
+        fb_link(&b, root, fb_table(&b, footer, 4, fpos));
+        fb_link(&b, fpos[1], fb_schema(&b, w));
+        size_t blocks = fb_vector(&b, w->block_count, 24, 8);
+        fb_link(&b, fpos[3], blocks);
+        for (uint32_t i = 0; i < w->block_count; i++) {
+            // Block { offset: long, metaDataLength: int, (채움), bodyLength: long }
+            size_t at = blocks + 4u + 24u * i;
+            fb_put(&b, at, (uint64_t)w->blocks[i].offset, 8);
+            fb_put(&b, at + 8u, (uint32_t)w->blocks[i].meta_length, 4);
+            fb_put(&b, at + 16u, (uint64_t)w->blocks[i].body_length, 8);
+        }
+        if (b.failed) {
+            w->failed = true;
+        } else {
+            uint8_t tail[10];
+            for (uint8_t i = 0; i < 4; i++) {
+                tail[i] = (uint8_t)(b.len >> (8u * i));
+            }
+            memcpy(&tail[4], "ARROW1", 6);
+            arrow_write(w, b.d, b.len);
+            arrow_write(w, tail, sizeof(tail));
+        }
+        free(b.d);
+
+        if (fclose(w->f) != 0) {
+            w->failed = true;
+        }
+        w->f = NULL;
+    }
+
+    for (uint32_t c = 0; c < w->columns; c++) {
+        free(w->name[c]);
+        free(w->data[c]);
+        w->name[c] = NULL;
+        w->data[c] = NULL;
+    }
+    free(w->blocks);
+    w->blocks = NULL;
+
+    return !w->failed;
+}
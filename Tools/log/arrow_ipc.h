@@ -0,0 +1,98 @@
+/**
+ * @file arrow_ipc.h
+ * @brief Apache Arrow IPC 파일 작성기 (호스트용, 외부 라이브러리 없음)
+ *
+ * 고정 열(부호 없는 32비트 정수, float32, float64)로 된 표 하나를 Arrow IPC 파일 형식
+ * (ARROW1 표식, 스키마 메시지, 레코드 배치 메시지, 꼬리말)으로 쓴다. 행은 batch_rows개씩
+ * 열별 버퍼에 모았다가 레코드 배치 하나로 내보내므로 메모리는 배치 크기만큼만 쓴다.
+ * 값 버퍼는 8바이트 정렬, null 없음(유효성 버퍼 길이 0), 압축 없음이며 메타데이터는
+ * flatbuffers 형식(MetadataVersion V5)을 직접 만든다. pyarrow.ipc.open_file, Arrow.jl,
+ * polars.read_ipc 등으로 복사 없이 메모리 사상해 읽을 수 있다.
+ */
+
+#ifndef ARROW_IPC_H
+#define ARROW_IPC_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 최대 열 수
+ */
+#define ARROW_MAX_COLUMNS 256u
+
+/**
+ * @brief 기본 배치 크기 (행)
+ */
+#define ARROW_DEFAULT_BATCH_ROWS 65536u
+
+/**
+ * @brief 열 자료형
+ */
+typedef enum {
+    ARROW_UINT32 = 0,   /**< 부호 없는 32비트 정수 */
+    ARROW_FLOAT32,      /**< 단정밀도 */
+    ARROW_FLOAT64       /**< 배정밀도 */
+} ArrowType;
+
+/**
+ * @brief 파일에 쓴 레코드 배치 위치 (꼬리말 Block)
+ */
+typedef struct {
+    int64_t offset;            /**< 메시지 시작 (파일 기준) */
+    int32_t meta_length;       /**< 접두사 포함 메타데이터 길이 */
+    int64_t body_length;       /**< 본문 길이 */
+} ArrowBlock;
+
+/**
+ * @brief 작성기
+ */
+typedef struct {
+    FILE *f;                   /**< 출력 파일 */
+    uint32_t columns;          /**< 열 수 */
+    char *name[ARROW_MAX_COLUMNS]; /**< 열 이름 */
+    ArrowType type[ARROW_MAX_COLUMNS]; /**< 열 자료형 */
+    uint8_t *data[ARROW_MAX_COLUMNS]; /**< 열별 배치 버퍼 */
+    uint32_t batch_rows;       /**< 배치 크기 (행) */
+    uint32_t rows;             /**< 현재 배치 행 수 */
+    uint64_t total_rows;       /**< 쓴 전체 행 수 */
+    int64_t offset;            /**< 현재 파일 위치 */
+    ArrowBlock *blocks;        /**< 쓴 배치 목록 */
+    uint32_t block_count;      /**< 배치 수 */
+    uint32_t block_capacity;   /**< 목록 용량 */
+    bool failed;               /**< 쓰기 오류 */
+} ArrowWriter;
+
+/**
+ * @brief 파일 열기와 스키마 기록
+ *
+ * @param w 작성기
+ * @param path 파일 경로
+ * @param columns 열 수 (1..ARROW_MAX_COLUMNS)
+ * @param names 열 이름
+ * @param types 열 자료형
+ * @param batch_rows 배치 크기 (행, 0이면 ARROW_DEFAULT_BATCH_ROWS)
+ * @return bool 성공 여부
+ */
+bool arrow_open(ArrowWriter *w, const char *path, uint32_t columns, const char *const *names,
+                const ArrowType *types, uint32_t batch_rows);
+
+/**
+ * @brief 행 하나 추가 (배치가 차면 기록)
+ *
+ * @param w 작성기
+ * @param values 열 값 (columns개, 열 자료형으로 변환)
+ * @return bool 성공 여부
+ */
+bool arrow_append(ArrowWriter *w, const double *values);
+
+/**
+ * @brief 남은 배치와 꼬리말 기록 후 닫기
+ *
+ * @param w 작성기
+ * @return bool 성공 여부 (쓰기 오류가 한 번이라도 있었으면 false)
+ */
+bool arrow_close(ArrowWriter *w);
+
+#endif /* ARROW_IPC_H */
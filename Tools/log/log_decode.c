@@ -0,0 +1,711 @@
+/**
+ * @file log_decode.c
+ * @brief 비행 기록 복원 프로그램 (호스트용)
+ *
+ * NOR 플래시 덤프(기록 영역 시작부터의 바이너리 이미지) 또는 SD 카드의 기록 파일
+ * (POLARIS.LOG, log/sd_file.h)을 4 KB 블록 단위로 읽어
+ * 레코드를 CSV로 표준 출력에 쓴다. 블록 형식은 Core/Inc/log/flash_log.h,
+ * 압축 스트림 형식은 Core/Inc/log/log_codec.h 를 따른다 (리틀 엔디언).
+ * 형식 상수, 레코드 구조체, CRC/가변 길이 정수 도우미는 펌웨어와 같은 HAL 없는 헤더
+ * Core/Inc/log/log_format.h를 쓴다.
+ *
+ * 출력 행: 세션,블록,이름,시각(us),값...
+ * - 압축 스트림: 스키마 이름과 복원 값
+ * - 원시 IMU/기압/자기장 레코드: imu_raw, baro_raw, mag_raw
+ * - 그 밖의 원시 레코드: rec<종류>와 길이
+ * - 이벤트 전 보관 레코드(log/log_policy.h): 원래 종류 이름 앞에 pre_ (pre_imu_raw 등, 원래 시각)
+ * - 공분산 스냅샷(log/cov_log.h): cov, 표준 편차 n개(무효는 nan), 위 삼각 상관 계수 n(n-1)/2개
+ * - NIS 창 통계(nav/innovation_monitor.h): 측정마다 nis 행, 측정 번호(EKF_Sensor), NIS 수, 거부 수,
+ *   평균, 표준 편차, 최댓값
+ * - PIL 재생 상태(sensors/pil_replay.h): pil, 다음 블록, 내보낸 레코드 수, 융합 사이클/샘플/마감 초과/과부하 수,
+ *   최대 처리 시간, 최대 샘플 지연, 늦은 배출/대기열 거부/읽기 부족 수, 부하율/최대 부하율(0.1%), 배속, 플래그
+ * - 기록 색인 블록(NOR 덤프 끝의 색인 영역): mark_time, mark_event, mark_phase 와 인자, 값
+ *   (블록 열은 가리키는 데이터 블록 번호, 기록 영역 시작 기준)
+ * 압축 모드로 기록한 NOR 덤프의 블록(PLGZ 압축, PLGP 원본)은 페이지 단위로 이어 붙어 있으므로
+ * 헤더의 used를 따라가며 원래 블록으로 풀어 같은 방식으로 복원한다 (USB로 내려받은 이미지는
+ * 이미 풀린 4 KB 블록이다).
+ * 블록이 빠지거나 깨져도 각 블록은 독립적으로 복원된다. 블록 CRC가 맞지 않는 블록은
+ * 건너뛰고, 세션 안에서 빠진 블록 순번과 함께 표준 오류로 알린다.
+ *
+ * -a <디렉터리>를 주면 압축 스트림, 원시 IMU/기압/자기장(pre_ 포함), 공분산 스냅샷, NIS, PIL 행을 CSV 대신
+ * 이름별 Apache Arrow IPC 파일(<디렉터리>/<이름>.arrow, arrow_ipc.h)로 쓴다. 열은 session, block,
+ * t_us(u32) 뒤에 필드마다 하나이며, 압축 스트림 값과 PIL 계수는 float64(양자화 값 x 간격), 원시 레코드,
+ * 공분산, NIS는 float32이다. 필드 이름은 알려진 스트림(imu, baro, nav, mag, nis, pil)은 log_codec.c(pil은
+ * PilReplayRecord)의 필드 순서를 따르고
+ * 나머지는 f0, f1, ... 이다. 그 밖의 행(rec<종류>, 색인)은 그대로 CSV로 표준 출력에 쓴다.
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o log_decode Tools/log/log_decode.c Tools/log/arrow_ipc.c -lm
+ *   ./log_decode flash.bin > flight.csv
+ *   ./log_decode -a flight_arrow flash.bin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+#include "arrow_ipc.h"
+#include "log/log_format.h"
+
+/**
+ * @brief 스트림 복원 상태 (블록마다 스키마부터 다시 채움)
+ */
+typedef struct {
+    bool valid;                     /**< 이 블록에서 스키마를 읽었는지 */
+    bool primed;                    /**< 이 블록에서 키프레임을 읽었는지 */
+    uint8_t field_count;
+    char name[LOG_CODEC_NAME_SIZE + 1];
+    float scale[LOG_CODEC_MAX_FIELDS];
+    int32_t q[LOG_CODEC_MAX_FIELDS];
+    uint32_t t;
+    uint32_t dt;
+} Stream;
+
+static Stream streams[256];
+
+/**
+ * @brief Arrow 출력 표 (행 이름별)
+ */
+#define ARROW_TABLES_MAX 64
+#define ARROW_KEY_COLUMNS 3          /**< session, block, t_us */
+
+typedef struct {
+    char name[32];
+    uint32_t fields;
+    ArrowWriter w;
+    bool mismatch_reported;
+} ArrowTable;
+
+static const char *arrow_dir = NULL;
+static ArrowTable arrow_tables[ARROW_TABLES_MAX];
+static uint32_t arrow_table_count = 0;
+
+/**
+ * @brief 알려진 스트림의 필드 이름 (log_codec.c 필드 순서)
+ */
+static const char *const IMU_FIELDS[] = { "gyro_x", "gyro_y", "gyro_z", "accel_x", "accel_y", "accel_z" };
+static const char *const BARO_FIELDS[] = { "pressure_pa", "temp_c" };
+static const char *const MAG_FIELDS[] = { "mag_x", "mag_y", "mag_z" };
+static const char *const NIS_FIELDS[] = { "sensor", "count", "rejects", "mean", "std", "max" };
+static const char *const PIL_FIELDS[] = {
+    "block", "released", "cycles", "samples", "misses", "overloads", "max_busy_us", "max_late_us",
+    "late", "queue_drops", "underruns", "load", "peak_load", "speed", "flags"
+};
+static const char *const NAV_FIELDS[] = {
+    "pos_x", "pos_y", "pos_z", "vel_x", "vel_y", "vel_z", "q_w", "q_x", "q_y", "q_z",
+    "gyro_bias_x", "gyro_bias_y", "gyro_bias_z", "accel_bias_x", "accel_bias_y", "accel_bias_z"
+};
+
+static const char *const *known_fields(const char *name, uint32_t n) {
+    if (strncmp(name, "pre_", 4) == 0) {
+        name += 4;
+    }
+    if (strncmp(name, "imu", 3) == 0 && n == 6) {
+        return IMU_FIELDS;
+    }
+    if (strncmp(name, "baro", 4) == 0 && n == 2) {
+        return BARO_FIELDS;
+    }
+    if (strncmp(name, "mag", 3) == 0 && n == 3) {
+        return MAG_FIELDS;
+    }
+    if (strcmp(name, "nav") == 0 && n == 16) {
+        return NAV_FIELDS;
+    }
+    if (strcmp(name, "nis") == 0 && n == 6) {
+        return NIS_FIELDS;
+    }
+    if (strcmp(name, "pil") == 0 && n == 15) {
+        return PIL_FIELDS;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Arrow 표 찾기 (처음이면 파일을 열고 스키마 기록)
+ *
+ * cov는 std_i(n개)와 rho_i_j(위 삼각), 그 밖은 알려진 이름 또는 f<i>이다.
+ */
+static ArrowTable *arrow_table(const char *name, uint32_t n, ArrowType type) {
+    for (uint32_t i = 0; i < arrow_table_count; i++) {
+        ArrowTable *t = &arrow_tables[i];
+        if (strcmp(t->name, name) != 0) {
+            continue;
+        }
+        if (t->fields != n) {
+            if (!t->mismatch_reported) {
+                fprintf(stderr, "%s: 필드 수가 %u에서 %u로 바뀜, 다른 행은 건너뜀\n", name, t->fields, n);
+                t->mismatch_reported = true;
+            }
+            return NULL;
+        }
+        return t;
+    }
+    if (arrow_table_count == ARROW_TABLES_MAX || n + ARROW_KEY_COLUMNS > ARROW_MAX_COLUMNS ||
+        strlen(name) >= sizeof(arrow_tables[0].name)) {
+        return NULL;
+    }
+
+    ArrowTable *t = &arrow_tables[arrow_table_count];
+    memset(t, 0, sizeof(*t));
+    strcpy(t->name, name);
+    t->fields = n;
+
+    static char labels[ARROW_MAX_COLUMNS][24];
+    const char *names[ARROW_MAX_COLUMNS] = { "session", "block", "t_us" };
+    ArrowType types[ARROW_MAX_COLUMNS] = { ARROW_UINT32, ARROW_UINT32, ARROW_UINT32 };
+    const char *const *known = known_fields(name, n);
+    uint32_t cov_n = 0;
+    if (strcmp(name, "cov") == 0) {
+        while (cov_n + cov_n * (cov_n - 1u) / 2u < n) {
+            cov_n++;
+        }
+    }
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        char *label = labels[ARROW_KEY_COLUMNS + i];
+        if (known != NULL) {
+            snprintf(label, sizeof(labels[0]), "%s", known[i]);
+        } else if (cov_n > 0 && i < cov_n) {
+            snprintf(label, sizeof(labels[0]), "std_%u", i);
+        } else if (cov_n > 0) {
+            // 위 삼각 행 순서의 k번째 (r, c)
+            uint32_t r = 0;
+            uint32_t row_start = 0;
+            while (k >= row_start + (cov_n - r - 1u)) {
+                row_start += cov_n - r - 1u;
+                r++;
+            }
+            snprintf(label, sizeof(labels[0]), "rho_%u_%u", r, r + 1u + (k - row_start));
+            k++;
+        } else {
+            snprintf(label, sizeof(labels[0]), "f%u", i);
+        }
+        names[ARROW_KEY_COLUMNS + i] = label;
+        types[ARROW_KEY_COLUMNS + i] = type;
+    }
+
+    // 파일 이름에는 영문자, 숫자, _만
+    char path[1024];
+    char file[sizeof(t->name)];
+    for (uint32_t i = 0; i <= strlen(name); i++) {
+        char ch = name[i];
+        bool ok = ch == '\0' || ch == '_' || (ch >= '0' && ch <= '9') ||
+                  (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+        file[i] = ok ? ch : '_';
+    }
+    snprintf(path, sizeof(path), "%s/%s.arrow", arrow_dir, file);
+    if (!arrow_open(&t->w, path, n + ARROW_KEY_COLUMNS, names, types, 0)) {
+        fprintf(stderr, "%s: 열 수 없음\n", path);
+        return NULL;
+    }
+    arrow_table_count++;
+
+    return t;
+}
+
+/**
+ * @brief Arrow 행 추가
+ */
+static void arrow_row(const char *name, uint32_t session, uint32_t seq, uint32_t t_us,
+                      const double *v, uint32_t n, ArrowType type) {
+    ArrowTable *t = arrow_table(name, n, type);
+    if (t == NULL) {
+        return;
+    }
+
+    double row[ARROW_MAX_COLUMNS];
+    row[0] = session;
+    row[1] = seq;
+    row[2] = t_us;
+    memcpy(&row[ARROW_KEY_COLUMNS], v, n * sizeof(double));
+    arrow_append(&t->w, row);
+}
+
+/**
+ * @brief 리틀 엔디언 읽기
+ */
+static uint32_t rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static float rdf(const uint8_t *p) {
+    uint32_t v = rd32(p);
+    float f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief 압축 스트림 레코드 복원
+ */
+static void decode_stream(uint32_t session, uint32_t seq, uint8_t type, const uint8_t *p, uint8_t len) {
+    const uint8_t *end = p + len;
+    if (len < 1) {
+        return;
+    }
+    Stream *s = &streams[p[0]];
+    p++;
+
+    if (type == FLASH_LOG_REC_SCHEMA) {
+        if (len < 12 || p[0] == 0 || p[0] > LOG_CODEC_MAX_FIELDS || len < 12 + 4 * p[0]) {
+            return;
+        }
+        s->field_count = p[0];
+        memcpy(s->name, &p[3], LOG_CODEC_NAME_SIZE);
+        s->name[LOG_CODEC_NAME_SIZE] = '\0';
+        for (int i = 0; i < s->field_count; i++) {
+            s->scale[i] = rdf(&p[3 + LOG_CODEC_NAME_SIZE + 4 * i]);
+        }
+        s->valid = true;
+        s->primed = false;
+        return;
+    }
+
+    if (!s->valid || (type == FLASH_LOG_REC_DELTA && !s->primed)) {
+        return;
+    }
+
+    uint32_t v;
+    if (!log_format_get_varint(&p, end, &v)) {
+        return;
+    }
+    if (type == FLASH_LOG_REC_KEY) {
+        s->t = v;
+        s->dt = 0;
+    } else {
+        s->dt += log_format_unzigzag(v);
+        s->t += s->dt;
+    }
+    for (int i = 0; i < s->field_count; i++) {
+        if (!log_format_get_varint(&p, end, &v)) {
+            s->primed = false;
+            return;
+        }
+        s->q[i] = (int32_t)((type == FLASH_LOG_REC_KEY) ? log_format_unzigzag(v)
+                                                         : (uint32_t)s->q[i] + log_format_unzigzag(v));
+    }
+    s->primed = true;
+
+    if (arrow_dir != NULL) {
+        double v[LOG_CODEC_MAX_FIELDS];
+        for (int i = 0; i < s->field_count; i++) {
+            v[i] = (double)s->q[i] * (double)s->scale[i];
+        }
+        arrow_row(s->name, session, seq, s->t, v, s->field_count, ARROW_FLOAT64);
+        return;
+    }
+    printf("%u,%u,%s,%u", session, seq, s->name, s->t);
+    for (int i = 0; i < s->field_count; i++) {
+        printf(",%.10g", (double)s->q[i] * (double)s->scale[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief 공분산 스냅샷 출력 (cov_log.h)
+ */
+static void decode_cov(uint32_t session, uint32_t seq, const uint8_t *p, uint8_t len) {
+    if (len < 5) {
+        return;
+    }
+    uint32_t n = p[4];
+    if (n == 0 || len != 5u + 2u * n + n * (n - 1u) / 2u) {
+        printf("%u,%u,rec%u,%u\n", session, seq, FLASH_LOG_REC_COV, len);
+        return;
+    }
+
+    const uint8_t *c = &p[5];
+    if (arrow_dir != NULL) {
+        static double v[255];
+        uint32_t m = 0;
+        for (uint32_t i = 0; i < n; i++, m++) {
+            int16_t code = (int16_t)(c[2 * i] | (c[2 * i + 1] << 8));
+            v[m] = (code == INT16_MIN) ? (double)NAN : exp2((double)code / 256.0);
+        }
+        for (uint32_t k = 0; k < n * (n - 1u) / 2u; k++, m++) {
+            v[m] = (double)(int8_t)c[2 * n + k] / 127.0;
+        }
+        arrow_row("cov", session, seq, rd32(p), v, m, ARROW_FLOAT32);
+        return;
+    }
+    printf("%u,%u,cov,%u", session, seq, rd32(p));
+    for (uint32_t i = 0; i < n; i++, c += 2) {
+        int16_t code = (int16_t)(c[0] | (c[1] << 8));
+        // 코드 = round(256 log2 σ), INT16_MIN은 무효
+        printf(",%.6g", (code == INT16_MIN) ? (double)NAN : exp2((double)code / 256.0));
+    }
+    for (uint32_t k = 0; k < n * (n - 1u) / 2u; k++) {
+        printf(",%.4f", (double)(int8_t)c[k] / 127.0);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief IEEE binary16 -> double (math/float16.h)
+ */
+static double half_to_double(uint16_t h) {
+    int e = (h >> 10) & 0x1F;
+    int m = h & 0x3FF;
+    double v;
+    if (e == 0x1F) {
+        v = (m != 0) ? (double)NAN : (double)INFINITY;
+    } else if (e == 0) {
+        v = ldexp((double)m, -24);
+    } else {
+        v = ldexp((double)(m + 1024), e - 25);
+    }
+    return (h & 0x8000u) ? -v : v;
+}
+
+/**
+ * @brief NIS 창 통계 출력 (innovation_monitor.h, 측정마다 한 행)
+ */
+static void decode_nis(uint32_t session, uint32_t seq, const uint8_t *p, uint8_t len) {
+    if (len < 5 || len != 5u + 11u * p[4]) {
+        printf("%u,%u,rec%u,%u\n", session, seq, FLASH_LOG_REC_NIS, len);
+        return;
+    }
+
+    uint32_t t_us = rd32(p);
+    const uint8_t *e = &p[5];
+    for (uint32_t i = 0; i < p[4]; i++, e += 11) {
+        double v[6] = {
+            e[0],
+            (double)(e[1] | (e[2] << 8)),
+            (double)(e[3] | (e[4] << 8)),
+            half_to_double((uint16_t)(e[5] | (e[6] << 8))),
+            half_to_double((uint16_t)(e[7] | (e[8] << 8))),
+            half_to_double((uint16_t)(e[9] | (e[10] << 8)))
+        };
+        if (arrow_dir != NULL) {
+            arrow_row("nis", session, seq, t_us, v, 6, ARROW_FLOAT32);
+            continue;
+        }
+        printf("%u,%u,nis,%u,%.0f,%.0f,%.0f,%.5g,%.5g,%.5g\n", session, seq, t_us, v[0], v[1], v[2], v[3], v[4], v[5]);
+    }
+}
+
+/**
+ * @brief PIL 재생 상태 출력 (sensors/pil_replay.h, PilReplayRecord)
+ */
+static void decode_pil(uint32_t session, uint32_t seq, const uint8_t *p, uint8_t len) {
+    if (len != 56) {
+        printf("%u,%u,rec%u,%u\n", session, seq, FLASH_LOG_REC_PIL, len);
+        return;
+    }
+
+    double v[15];
+    for (uint32_t i = 0; i < 11; i++) {
+        v[i] = (double)rd32(&p[4 + 4 * i]);
+    }
+    v[11] = (double)(p[48] | (p[49] << 8));
+    v[12] = (double)(p[50] | (p[51] << 8));
+    v[13] = p[52];
+    v[14] = p[53];
+    if (arrow_dir != NULL) {
+        arrow_row("pil", session, seq, rd32(p), v, 15, ARROW_FLOAT64);
+        return;
+    }
+    printf("%u,%u,pil,%u", session, seq, rd32(p));
+    for (uint32_t i = 0; i < 15; i++) {
+        printf(",%.0f", v[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief 원시 레코드 출력
+ */
+static void decode_raw(uint32_t session, uint32_t seq, uint8_t type, const uint8_t *p, uint8_t len) {
+    const char *prefix = "";
+    if (type == FLASH_LOG_REC_PRE_EVENT && len >= 1) {
+        // 원래 종류 | 원래 페이로드
+        prefix = "pre_";
+        type = p[0];
+        p++;
+        len--;
+    }
+
+    const char *name = NULL;
+    int n = 0;
+    if (type == FLASH_LOG_REC_IMU && len == sizeof(FlashLogImuRecord)) {
+        name = "imu_raw";
+        n = 6;
+    } else if (type == FLASH_LOG_REC_BARO && len == sizeof(FlashLogBaroRecord)) {
+        name = "baro_raw";
+        n = 2;
+    } else if (type == FLASH_LOG_REC_MAG && len == sizeof(FlashLogMagRecord)) {
+        name = "mag_raw";
+        n = 3;
+    }
+
+    if (name == NULL) {
+        printf("%u,%u,%srec%u,%u\n", session, seq, prefix, type, len);
+        return;
+    }
+    if (arrow_dir != NULL) {
+        char full[32];
+        double v[6];
+        snprintf(full, sizeof(full), "%s%s", prefix, name);
+        for (int i = 0; i < n; i++) {
+            v[i] = (double)rdf(&p[4 + 4 * i]);
+        }
+        arrow_row(full, session, seq, rd32(p), v, (uint32_t)n, ARROW_FLOAT32);
+        return;
+    }
+    printf("%u,%u,%s%s,%u", session, seq, prefix, name, rd32(p));
+    for (int i = 0; i < n; i++) {
+        printf(",%.9g", (double)rdf(&p[4 + 4 * i]));
+    }
+    printf("\n");
+}
+
+/**
+ * @brief 기록 색인 블록 출력 (FlashLogIndexEntry)
+ */
+static void decode_index(const uint8_t *block, uint32_t used) {
+    static const char *const names[] = { "mark", "mark_time", "mark_event", "mark_phase" };
+    for (uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE; o + FLASH_LOG_INDEX_ENTRY_SIZE <= used;
+         o += FLASH_LOG_INDEX_ENTRY_SIZE) {
+        const uint8_t *p = &block[o];
+        uint8_t kind = p[14];
+        printf("%u,%u,%s,%u,%u,%u\n", p[12] | ((uint32_t)p[13] << 8), rd32(p + 4),
+               names[kind < 4 ? kind : 0], rd32(p), p[15], rd32(p + 8));
+    }
+}
+
+/**
+ * @brief LZ4 블록 복원 (log_lz.c와 같은 형식, 출력 길이 또는 -1)
+ */
+static int32_t lz_decompress(const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t capacity) {
+    uint32_t ip = 0;
+    uint32_t op = 0;
+    while (ip < len) {
+        uint8_t token = src[ip++];
+        uint32_t lit = token >> 4;
+        if (lit == 15u) {
+            uint8_t b;
+            do {
+                if (ip >= len) {
+                    return -1;
+                }
+                b = src[ip++];
+                lit += b;
+            } while (b == 255u);
+        }
+        if (lit > len - ip || lit > capacity - op) {
+            return -1;
+        }
+        memcpy(&dst[op], &src[ip], lit);
+        ip += lit;
+        op += lit;
+        if (ip == len) {
+            break;
+        }
+
+        if (len - ip < 2u) {
+            return -1;
+        }
+        uint32_t distance = src[ip] | ((uint32_t)src[ip + 1u] << 8);
+        ip += 2u;
+        uint32_t n = token & 15u;
+        if (n == 15u) {
+            uint8_t b;
+            do {
+                if (ip >= len) {
+                    return -1;
+                }
+                b = src[ip++];
+                n += b;
+            } while (b == 255u);
+        }
+        n += 4u;
+        if (distance == 0 || distance > op || n > capacity - op) {
+            return -1;
+        }
+        for (uint32_t k = 0; k < n; k++) {
+            dst[op + k] = dst[op + k - distance];
+        }
+        op += n;
+    }
+
+    return (int32_t)op;
+}
+
+/**
+ * @brief 압축 모드 블록을 원래 블록으로 풀기 (flash_log_unpack_block과 같음)
+ */
+static bool unpack_block(const uint8_t *stored, uint32_t used, uint8_t *block) {
+    uint32_t body = used - FLASH_LOG_BLOCK_HEADER_SIZE;
+    memset(block, FLASH_LOG_END_TYPE, FLASH_LOG_BLOCK_SIZE);
+    memcpy(block, stored, FLASH_LOG_BLOCK_HEADER_SIZE);
+    if (rd32(stored) == FLASH_LOG_LZ_MAGIC) {
+        int32_t n = lz_decompress(&stored[FLASH_LOG_BLOCK_HEADER_SIZE], body, &block[FLASH_LOG_BLOCK_HEADER_SIZE],
+                                  FLASH_LOG_BLOCK_SIZE - FLASH_LOG_BLOCK_HEADER_SIZE);
+        if (n < 0) {
+            return false;
+        }
+        body = (uint32_t)n;
+    } else {
+        memcpy(&block[FLASH_LOG_BLOCK_HEADER_SIZE], &stored[FLASH_LOG_BLOCK_HEADER_SIZE], body);
+    }
+    uint32_t magic = FLASH_LOG_MAGIC;
+    memcpy(block, &magic, sizeof(magic));
+    block[FLASH_LOG_HEADER_USED] = (uint8_t)(FLASH_LOG_BLOCK_HEADER_SIZE + body);
+    block[FLASH_LOG_HEADER_USED + 1] = (uint8_t)((FLASH_LOG_BLOCK_HEADER_SIZE + body) >> 8);
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int arg = 1;
+    if (argc >= 3 && strcmp(argv[1], "-a") == 0) {
+        arrow_dir = argv[2];
+        arg = 3;
+        mkdir(arrow_dir, 0777);
+    }
+    if (argc <= arg) {
+        fprintf(stderr, "사용법: %s [-a arrow_dir] flash.bin\n", argv[0]);
+        return 1;
+    }
+    FILE *f = fopen(argv[arg], "rb");
+    if (f == NULL) {
+        perror(argv[arg]);
+        return 1;
+    }
+
+    // 압축 모드 블록은 크기가 제각각이므로 이미지 전체를 읽어 헤더를 따라감
+    size_t size = 0;
+    size_t capacity = 1u << 20;
+    uint8_t *image = malloc(capacity);
+    size_t got;
+    while (image != NULL && (got = fread(&image[size], 1, capacity - size, f)) > 0) {
+        size += got;
+        if (size == capacity) {
+            capacity *= 2u;
+            image = realloc(image, capacity);
+        }
+    }
+    fclose(f);
+    if (image == NULL) {
+        fprintf(stderr, "메모리 부족\n");
+        return 1;
+    }
+
+    static uint8_t block[FLASH_LOG_BLOCK_SIZE];
+    uint32_t blocks = 0;
+    uint32_t skipped = 0;
+    uint32_t bad_crc = 0;
+    uint32_t lost = 0;
+    uint32_t marks = 0;
+    uint32_t index = 0;
+    bool have_prev = false;
+    uint32_t prev_session = 0;
+    uint32_t prev_seq = 0;
+    size_t off = 0;
+    while (off + FLASH_LOG_BLOCK_HEADER_SIZE <= size) {
+        const uint8_t *raw = &image[off];
+        uint32_t used = raw[FLASH_LOG_HEADER_USED] | ((uint32_t)raw[FLASH_LOG_HEADER_USED + 1] << 8);
+        bool sane = used >= FLASH_LOG_BLOCK_HEADER_SIZE && used <= FLASH_LOG_BLOCK_SIZE;
+        if ((rd32(raw) == FLASH_LOG_LZ_MAGIC || rd32(raw) == FLASH_LOG_PACKED_MAGIC) && sane && off + used <= size) {
+            off += (used + FLASH_LOG_PAGE_SIZE - 1u) / FLASH_LOG_PAGE_SIZE * FLASH_LOG_PAGE_SIZE;
+            if (!unpack_block(raw, used, block)) {
+                fprintf(stderr, "블록 %u: 압축 데이터 깨짐\n", index++);
+                bad_crc++;
+                continue;
+            }
+            used = block[FLASH_LOG_HEADER_USED] | ((uint32_t)block[FLASH_LOG_HEADER_USED + 1] << 8);
+        } else if (off + FLASH_LOG_BLOCK_SIZE <= size) {
+            // 표식이 없는 곳(지워진 영역 등)은 페이지 단위로 넘기고 섹터마다 한 번 셈
+            if (rd32(raw) != FLASH_LOG_MAGIC && rd32(raw) != FLASH_LOG_INDEX_MAGIC) {
+                if (off % FLASH_LOG_BLOCK_SIZE == 0) {
+                    skipped++;
+                }
+                off += FLASH_LOG_PAGE_SIZE;
+                continue;
+            }
+            memcpy(block, raw, FLASH_LOG_BLOCK_SIZE);
+            off += FLASH_LOG_BLOCK_SIZE;
+        } else {
+            break;
+        }
+        uint32_t at = index++;
+        if (rd32(block) == FLASH_LOG_INDEX_MAGIC && sane &&
+            log_format_crc32(&block[FLASH_LOG_CRC_OFFSET], FLASH_LOG_BLOCK_SIZE - FLASH_LOG_CRC_OFFSET) ==
+                rd32(&block[FLASH_LOG_HEADER_CRC])) {
+            decode_index(block, used);
+            marks++;
+            continue;
+        }
+        if (rd32(block) != FLASH_LOG_MAGIC || used < FLASH_LOG_BLOCK_HEADER_SIZE || used > FLASH_LOG_BLOCK_SIZE) {
+            skipped++;
+            continue;
+        }
+        if (log_format_crc32(&block[FLASH_LOG_CRC_OFFSET], FLASH_LOG_BLOCK_SIZE - FLASH_LOG_CRC_OFFSET) !=
+            rd32(&block[FLASH_LOG_HEADER_CRC])) {
+            fprintf(stderr, "블록 %u: CRC 불일치\n", at);
+            bad_crc++;
+            continue;
+        }
+        uint32_t seq = rd32(&block[FLASH_LOG_HEADER_SEQ]);
+        uint32_t session = block[FLASH_LOG_HEADER_SESSION] | ((uint32_t)block[FLASH_LOG_HEADER_SESSION + 1] << 8);
+        if (have_prev && session == prev_session && seq != prev_seq + 1u) {
+            if (seq > prev_seq) {
+                fprintf(stderr, "세션 %u: 블록 %u..%u 없음\n", session, prev_seq + 1u, seq - 1u);
+                lost += seq - prev_seq - 1u;
+            } else {
+                fprintf(stderr, "세션 %u: 블록 순번 역행 %u -> %u\n", session, prev_seq, seq);
+            }
+        }
+        have_prev = true;
+        prev_session = session;
+        prev_seq = seq;
+        blocks++;
+
+        // 블록마다 스트림 상태를 새로 시작 (스키마와 키프레임이 블록 안에 있음)
+        memset(streams, 0, sizeof(streams));
+
+        uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE;
+        while (o + 2 <= used && block[o] != FLASH_LOG_END_TYPE) {
+            uint8_t type = block[o];
+            uint8_t len = block[o + 1];
+            if (o + 2 + len > used) {
+                break;
+            }
+            const uint8_t *p = &block[o + 2];
+            if (type == FLASH_LOG_REC_SCHEMA || type == FLASH_LOG_REC_KEY || type == FLASH_LOG_REC_DELTA) {
+                decode_stream(session, seq, type, p, len);
+            } else if (type == FLASH_LOG_REC_COV) {
+                decode_cov(session, seq, p, len);
+            } else if (type == FLASH_LOG_REC_NIS) {
+                decode_nis(session, seq, p, len);
+            } else if (type == FLASH_LOG_REC_PIL) {
+                decode_pil(session, seq, p, len);
+            } else {
+                decode_raw(session, seq, type, p, len);
+            }
+            o += 2u + len;
+        }
+    }
+    free(image);
+
+    int rc = 0;
+    for (uint32_t i = 0; i < arrow_table_count; i++) {
+        ArrowTable *t = &arrow_tables[i];
+        uint64_t rows = t->w.total_rows + t->w.rows;
+        if (!arrow_close(&t->w)) {
+            fprintf(stderr, "%s: 쓰기 오류\n", t->name);
+            rc = 1;
+        }
+        fprintf(stderr, "%s: %llu행\n", t->name, (unsigned long long)rows);
+    }
+
+    fprintf(stderr, "블록 %u개 복원, %u개 건너뜀, CRC 불일치 %u개, 빠진 블록 %u개, 색인 블록 %u개\n",
+            blocks, skipped, bad_crc, lost, marks);
+
+    return rc;
+}
@@ -0,0 +1,598 @@
+/**
+ * @file log_fetch.c
+ * @brief 비행 기록 USB 내려받기 프로그램 (호스트용, POSIX)
+ *
+ * 기록 내려받기 장치(Core/Inc/log/usb_download.h)의 가상 직렬 포트로 저장 정보와 세션 색인을
+ * 읽고, 블록을 받아 Tools/log/log_decode.c가 읽는 이미지(기록 영역 시작부터의 4 KB 블록)로
+ * 저장한다. 출력 파일이 이미 있으면 파일 크기 다음 블록부터 이어받는다. 받는 중 응답이
+ * 끊기면 받은 다음 블록부터 READ를 다시 보낸다. -w를 주면 장치의 기록 색인(시각/이벤트 항목,
+ * flash_log_set_index)으로 구간을 블록 범위로 바꾸어 그 범위만 받는다.
+ *
+ * 프로토콜 상수는 펌웨어 헤더가 HAL에 의존하므로 여기에 다시 적는다 (리틀 엔디언). 블록/색인 형식은
+ * Core/Inc/log/log_format.h를 쓴다.
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o log_fetch Tools/log/log_fetch.c
+ *   ./log_fetch -l /dev/ttyACM0                  세션 색인 출력
+ *   ./log_fetch [-s 세션] /dev/ttyACM0 flash.bin  전체 (또는 한 세션) 내려받기
+ *   ./log_fetch -w launch-1:burnout+1 /dev/ttyACM0 boost.bin  마지막(또는 -s) 세션의 구간만
+ *   ./log_decode flash.bin > flight.csv
+ * 한 세션이나 구간만 받으면 이미지는 그 범위의 첫 블록부터 시작한다.
+ *
+ * 구간 끝점: launch, burnout, apogee(이벤트 추정 발생 시각), start, end, 또는 세션 첫 색인 시각부터의
+ * 초. 이벤트 뒤에 +초/-초를 붙일 수 있다. 구간은 색인 간격(기본 8블록, 약 0.7 s) 단위로 넓어진다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "log/log_format.h"
+
+/**
+ * @brief 프로토콜 (usb_download.h)
+ */
+#define FRAME_MAGIC 0x46444C50u
+#define FRAME_HEADER_SIZE 16u
+#define MAX_SESSIONS 32u
+
+#define CMD_INFO 1u
+#define CMD_INDEX 2u
+#define CMD_READ 3u
+#define CMD_ABORT 4u
+
+#define FRAME_INFO 1u
+#define FRAME_INDEX 2u
+#define FRAME_DATA 3u
+#define FRAME_DONE 4u
+#define FRAME_MARKS 5u
+
+#define CMD_READ_MARKS 5u
+
+#define MAX_MARKS 65536u
+
+#define STATUS_OK 0u
+
+/**
+ * @brief 응답 대기 한계 (ms)와 재시도 횟수
+ */
+#define TIMEOUT_MS 2000
+#define INDEX_TIMEOUT_MS 20000
+#define MAX_RETRIES 5
+
+/**
+ * @brief 받은 프레임
+ */
+typedef struct {
+    uint8_t type;
+    uint8_t status;
+    uint16_t length;
+    uint32_t block;
+    uint32_t remaining;
+    uint8_t data[FLASH_LOG_BLOCK_SIZE];
+} Frame;
+
+/**
+ * @brief 세션 색인 항목 (FlashLogSession)
+ */
+typedef struct {
+    uint32_t session;
+    uint32_t first_block;
+    uint32_t block_count;
+    uint32_t last_seq;
+} Session;
+
+/**
+ * @brief 색인 항목 (FlashLogIndexEntry)
+ */
+typedef struct {
+    uint32_t timestamp_us;
+    uint32_t block;
+    uint32_t value;
+    uint32_t session;
+    uint8_t kind;
+    uint8_t arg;
+} Mark;
+
+static const char *const event_names[] = { "launch", "burnout", "apogee" };
+
+static uint32_t rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t rd16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void wr32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief 단조 증가 시계 (ms)
+ */
+static long long now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief 직렬 포트 열기 (원시 모드)
+ */
+static int port_open(const char *path) {
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    tcflush(fd, TCIOFLUSH);
+
+    return fd;
+}
+
+/**
+ * @brief len 바이트 읽기 (한계 시각까지)
+ */
+static bool port_read(int fd, uint8_t *buf, size_t len, long long deadline) {
+    size_t got = 0;
+    while (got < len) {
+        long long left = deadline - now_ms();
+        if (left <= 0) {
+            return false;
+        }
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(fd, &set);
+        struct timeval tv = { (time_t)(left / 1000), (suseconds_t)((left % 1000) * 1000) };
+        int r = select(fd + 1, &set, NULL, NULL, &tv);
+        if (r < 0 && errno != EINTR) {
+            return false;
+        }
+        if (r <= 0) {
+            continue;
+        }
+        ssize_t n = read(fd, buf + got, len - got);
+        if (n < 0 && errno != EINTR && errno != EAGAIN) {
+            return false;
+        }
+        if (n > 0) {
+            got += (size_t)n;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 명령 보내기
+ */
+static bool send_command(int fd, uint8_t type, uint32_t arg0, uint32_t arg1) {
+    uint8_t cmd[12] = { type, 0, 0, 0 };
+    wr32(&cmd[4], arg0);
+    wr32(&cmd[8], arg1);
+
+    return write(fd, cmd, sizeof(cmd)) == (ssize_t)sizeof(cmd);
+}
+
+/**
+ * @brief 프레임 하나 받기 (magic으로 경계 찾기)
+ */
+static bool read_frame(int fd, Frame *frame, int timeout_ms) {
+    long long deadline = now_ms() + timeout_ms;
+    uint8_t h[FRAME_HEADER_SIZE];
+
+    if (!port_read(fd, h, 4, deadline)) {
+        return false;
+    }
+    while (rd32(h) != FRAME_MAGIC) {
+        memmove(h, h + 1, 3);
+        if (!port_read(fd, h + 3, 1, deadline)) {
+            return false;
+        }
+    }
+    if (!port_read(fd, h + 4, FRAME_HEADER_SIZE - 4, deadline)) {
+        return false;
+    }
+
+    frame->type = h[4];
+    frame->status = h[5];
+    frame->length = rd16(&h[6]);
+    frame->block = rd32(&h[8]);
+    frame->remaining = rd32(&h[12]);
+    if (frame->length > FLASH_LOG_BLOCK_SIZE) {
+        return false;
+    }
+
+    return port_read(fd, frame->data, frame->length, deadline);
+}
+
+/**
+ * @brief 원하는 종류의 프레임이 올 때까지 받기 (이전 요청의 남은 프레임은 버림)
+ */
+static bool expect_frame(int fd, Frame *frame, uint8_t type, int timeout_ms) {
+    for (int i = 0; i < 4; i++) {
+        if (!read_frame(fd, frame, timeout_ms)) {
+            return false;
+        }
+        if (frame->type == type) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 세션 색인 받기
+ */
+static int fetch_index(int fd, Session *sessions, Frame *frame) {
+    if (!send_command(fd, CMD_INDEX, 0, 0) || !expect_frame(fd, frame, FRAME_INDEX, INDEX_TIMEOUT_MS)) {
+        fprintf(stderr, "색인 응답 없음\n");
+        return -1;
+    }
+    if (frame->status != STATUS_OK) {
+        fprintf(stderr, "색인 읽기 실패 (상태 %u)\n", frame->status);
+        return -1;
+    }
+
+    int n = frame->length / 16;
+    if (n > (int)MAX_SESSIONS) {
+        n = MAX_SESSIONS;
+    }
+    for (int i = 0; i < n; i++) {
+        const uint8_t *p = &frame->data[i * 16];
+        sessions[i].session = rd16(p);
+        sessions[i].first_block = rd32(p + 4);
+        sessions[i].block_count = rd32(p + 8);
+        sessions[i].last_seq = rd32(p + 12);
+    }
+
+    return n;
+}
+
+/**
+ * @brief 색인 블록 전체 받기 (session 항목만)
+ */
+static int fetch_marks(int fd, uint32_t index_blocks, uint32_t session, Mark *marks, Frame *frame) {
+    int n = 0;
+    uint32_t next = 0;
+    int retries = 0;
+
+    tcflush(fd, TCIFLUSH);
+    if (!send_command(fd, CMD_READ_MARKS, 0, 0)) {
+        return -1;
+    }
+    while (next < index_blocks) {
+        if (!read_frame(fd, frame, TIMEOUT_MS)) {
+            if (++retries > MAX_RETRIES) {
+                return -1;
+            }
+            send_command(fd, CMD_READ_MARKS, next, 0);
+            continue;
+        }
+        if (frame->type == FRAME_DONE) {
+            if (next < index_blocks && ++retries > MAX_RETRIES) {
+                return -1;
+            }
+            continue;
+        }
+        if (frame->type != FRAME_MARKS || frame->block != next || frame->length != FLASH_LOG_BLOCK_SIZE) {
+            continue;
+        }
+        next++;
+
+        uint32_t used = rd16(&frame->data[FLASH_LOG_HEADER_USED]);
+        if (rd32(frame->data) != FLASH_LOG_INDEX_MAGIC || used > FLASH_LOG_BLOCK_SIZE) {
+            continue;
+        }
+        for (uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE; o + FLASH_LOG_INDEX_ENTRY_SIZE <= used && n < (int)MAX_MARKS;
+             o += FLASH_LOG_INDEX_ENTRY_SIZE) {
+            const uint8_t *p = &frame->data[o];
+            if (rd16(p + 12) != session) {
+                continue;
+            }
+            marks[n].timestamp_us = rd32(p);
+            marks[n].block = rd32(p + 4);
+            marks[n].value = rd32(p + 8);
+            marks[n].session = rd16(p + 12);
+            marks[n].kind = p[14];
+            marks[n].arg = p[15];
+            n++;
+        }
+    }
+    // 마지막 DONE
+    read_frame(fd, frame, TIMEOUT_MS);
+
+    return n;
+}
+
+/**
+ * @brief 구간 끝점을 시각으로 (세션 첫 시각 기준 상대 us, 실패하면 false)
+ */
+static bool resolve_point(const char *text, const Mark *marks, int n, uint32_t t0, int64_t *rel_us) {
+    char name[16];
+    size_t len = strcspn(text, "+-");
+    if (len == 0 || len >= sizeof(name)) {
+        return false;
+    }
+    memcpy(name, text, len);
+    name[len] = '\0';
+    double offset = (text[len] != '\0') ? strtod(&text[len], NULL) : 0.0;
+
+    char *endp;
+    double seconds = strtod(name, &endp);
+    if (*endp == '\0') {
+        *rel_us = (int64_t)((seconds + offset) * 1e6);
+        return true;
+    }
+    if (strcmp(name, "start") == 0) {
+        *rel_us = (int64_t)(offset * 1e6);
+        return true;
+    }
+    if (strcmp(name, "end") == 0) {
+        *rel_us = INT64_MAX / 2;
+        return true;
+    }
+    for (uint8_t e = 0; e < sizeof(event_names) / sizeof(event_names[0]); e++) {
+        if (strcmp(name, event_names[e]) != 0) {
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            if (marks[i].kind == FLASH_LOG_INDEX_EVENT && marks[i].arg == e) {
+                *rel_us = (int32_t)(marks[i].timestamp_us - t0) + (int64_t)(offset * 1e6);
+                return true;
+            }
+        }
+        fprintf(stderr, "색인에 %s 이벤트 없음\n", name);
+        return false;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 구간을 블록 범위로 (시각 색인 기준으로 넓힘)
+ */
+static bool window_blocks(const char *spec, const Mark *marks, int n, uint32_t *first, uint32_t *end) {
+    char a[32];
+    const char *colon = strchr(spec, ':');
+    if (colon == NULL || (size_t)(colon - spec) >= sizeof(a)) {
+        return false;
+    }
+    memcpy(a, spec, (size_t)(colon - spec));
+    a[colon - spec] = '\0';
+
+    int first_time = -1;
+    for (int i = 0; i < n && first_time < 0; i++) {
+        if (marks[i].kind == FLASH_LOG_INDEX_TIME) {
+            first_time = i;
+        }
+    }
+    if (first_time < 0) {
+        fprintf(stderr, "세션 시각 색인 없음\n");
+        return false;
+    }
+    uint32_t t0 = marks[first_time].timestamp_us;
+    int64_t from;
+    int64_t to;
+    if (!resolve_point(a, marks, n, t0, &from) || !resolve_point(colon + 1, marks, n, t0, &to) ||
+        to < from) {
+        return false;
+    }
+
+    // from 이하의 마지막 시각 항목 블록부터 to 초과 첫 시각 항목 블록까지 (32비트 시각 되감김 고려)
+    uint32_t lo = *first;
+    uint32_t hi = *end;
+    for (int i = 0; i < n; i++) {
+        if (marks[i].kind != FLASH_LOG_INDEX_TIME) {
+            continue;
+        }
+        int64_t t = (int32_t)(marks[i].timestamp_us - t0);
+        if (t <= from && marks[i].block > lo) {
+            lo = marks[i].block;
+        }
+        if (t > to && marks[i].block + 1u < hi) {
+            hi = marks[i].block + 1u;
+            break;
+        }
+    }
+    if (lo >= hi) {
+        return false;
+    }
+    *first = lo;
+    *end = hi;
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    bool list = false;
+    long want_session = -1;
+    const char *window = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "ls:w:")) != -1) {
+        if (opt == 'l') {
+            list = true;
+        } else if (opt == 's') {
+            want_session = strtol(optarg, NULL, 0);
+        } else if (opt == 'w') {
+            window = optarg;
+        } else {
+            break;
+        }
+    }
+    if (optind >= argc || (!list && optind + 1 >= argc)) {
+        fprintf(stderr, "사용법: %s -l 포트\n       %s [-s 세션] [-w 시작:끝] 포트 flash.bin\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    int fd = port_open(argv[optind]);
+    if (fd < 0) {
+        return 1;
+    }
+
+    static Frame frame;
+    send_command(fd, CMD_ABORT, 0, 0);
+    usleep(100000);
+    tcflush(fd, TCIFLUSH);
+    if (!send_command(fd, CMD_INFO, 0, 0) || !expect_frame(fd, &frame, FRAME_INFO, TIMEOUT_MS)) {
+        fprintf(stderr, "장치 응답 없음\n");
+        return 1;
+    }
+    uint32_t blocks = rd32(&frame.data[0]);
+    uint32_t capacity = rd32(&frame.data[8]);
+    uint32_t index_blocks = (frame.length >= 20) ? rd32(&frame.data[16]) : 0;
+    fprintf(stderr, "저장 %u / %u 블록 (%.1f MB), 현재 세션 %u, 저장소 %s\n", blocks, capacity,
+            blocks * (double)FLASH_LOG_BLOCK_SIZE / 1e6, rd16(&frame.data[12]), frame.data[14] ? "SD" : "NOR");
+    fprintf(stderr, "기록 색인 %u 블록\n", index_blocks);
+
+    static Session sessions[MAX_SESSIONS];
+    int count = fetch_index(fd, sessions, &frame);
+    if (count < 0) {
+        return 1;
+    }
+    if (list) {
+        printf("세션,첫블록,블록수,빠진블록\n");
+        for (int i = 0; i < count; i++) {
+            printf("%u,%u,%u,%u\n", sessions[i].session, sessions[i].first_block, sessions[i].block_count,
+                   sessions[i].last_seq + 1u - sessions[i].block_count);
+        }
+        return 0;
+    }
+
+    uint32_t first = 0;
+    uint32_t end = blocks;
+    if (window != NULL && want_session < 0 && count > 0) {
+        want_session = sessions[count - 1].session;
+    }
+    if (want_session >= 0) {
+        int i = 0;
+        while (i < count && sessions[i].session != (uint32_t)want_session) {
+            i++;
+        }
+        if (i == count) {
+            fprintf(stderr, "세션 %ld 없음\n", want_session);
+            return 1;
+        }
+        first = sessions[i].first_block;
+        end = first + sessions[i].block_count;
+    }
+    if (window != NULL) {
+        static Mark marks[MAX_MARKS];
+        int n = (index_blocks > 0) ? fetch_marks(fd, index_blocks, (uint32_t)want_session, marks, &frame) : 0;
+        if (n <= 0) {
+            fprintf(stderr, "세션 %ld 기록 색인 없음\n", want_session);
+            return 1;
+        }
+        if (!window_blocks(window, marks, n, &first, &end)) {
+            fprintf(stderr, "구간 %s를 블록 범위로 바꿀 수 없음\n", window);
+            return 1;
+        }
+        fprintf(stderr, "구간 %s: 블록 %u..%u (%u 블록)\n", window, first, end - 1u, end - first);
+    }
+
+    // 이어받기: 받아 둔 온전한 블록 다음부터
+    const char *out_path = argv[optind + 1];
+    struct stat st;
+    uint32_t next = first;
+    if (stat(out_path, &st) == 0) {
+        next = first + (uint32_t)(st.st_size / FLASH_LOG_BLOCK_SIZE);
+        if (truncate(out_path, (off_t)(next - first) * FLASH_LOG_BLOCK_SIZE) != 0) {
+            perror(out_path);
+            return 1;
+        }
+        if (next > first) {
+            fprintf(stderr, "블록 %u부터 이어받기\n", next);
+        }
+    }
+    FILE *out = fopen(out_path, "ab");
+    if (out == NULL) {
+        perror(out_path);
+        return 1;
+    }
+
+    long long start = now_ms();
+    uint32_t received = 0;
+    int retries = 0;
+    bool requested = false;
+    while (next < end) {
+        if (!requested) {
+            tcflush(fd, TCIFLUSH);
+            if (!send_command(fd, CMD_READ, next, end - next)) {
+                fprintf(stderr, "명령 보내기 실패\n");
+                break;
+            }
+            requested = true;
+        }
+        if (!read_frame(fd, &frame, TIMEOUT_MS)) {
+            if (++retries > MAX_RETRIES) {
+                fprintf(stderr, "응답 없음, 블록 %u에서 멈춤 (다시 실행하면 이어받음)\n", next);
+                break;
+            }
+            fprintf(stderr, "응답 없음, 블록 %u부터 다시 요청\n", next);
+            send_command(fd, CMD_ABORT, 0, 0);
+            usleep(100000);
+            requested = false;
+            continue;
+        }
+        if (frame.type == FRAME_DONE) {
+            if (frame.status != STATUS_OK || next < end) {
+                fprintf(stderr, "요청 끝 (상태 %u, 블록 %u)\n", frame.status, frame.block);
+                if (++retries > MAX_RETRIES) {
+                    break;
+                }
+                requested = false;
+            }
+            continue;
+        }
+        if (frame.type != FRAME_DATA || frame.block != next || frame.length != FLASH_LOG_BLOCK_SIZE) {
+            // 이전 요청의 남은 프레임 또는 순서가 어긋난 블록
+            if (frame.type == FRAME_DATA && frame.block > next) {
+                send_command(fd, CMD_ABORT, 0, 0);
+                usleep(100000);
+                requested = false;
+            }
+            continue;
+        }
+        if (fwrite(frame.data, 1, FLASH_LOG_BLOCK_SIZE, out) != FLASH_LOG_BLOCK_SIZE) {
+            perror(out_path);
+            break;
+        }
+        next++;
+        received++;
+        retries = 0;
+        if ((received % 256u) == 0) {
+            double s = (now_ms() - start) / 1000.0;
+            fprintf(stderr, "\r%u / %u 블록, %.0f kB/s", next - first, end - first,
+                    s > 0 ? received * (double)FLASH_LOG_BLOCK_SIZE / 1e3 / s : 0.0);
+        }
+    }
+    fclose(out);
+
+    double s = (now_ms() - start) / 1000.0;
+    fprintf(stderr, "\n%u 블록 받음 (%.1f s, %.0f kB/s)\n", received, s,
+            s > 0 ? received * (double)FLASH_LOG_BLOCK_SIZE / 1e3 / s : 0.0);
+    close(fd);
+
+    return (next == end) ? 0 : 2;
+}
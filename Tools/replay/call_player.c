@@ -0,0 +1,562 @@
+/**
+ * @file call_player.c
+ * @brief EKF 호출 기록 재생 프로그램 (호스트용)
+ *
+ * 비행 기록의 EKF 호출 레코드(log/call_recorder.h)를 읽어 스냅샷 상태에서 시작하고, 기록된
+ * 공개 호출을 같은 순서와 인자로 Core/Src/ekf에 다시 부른다. 스케줄러와 센서 처리를 거치지
+ * 않으므로 비행 중 EKF 동작을 그대로 재현하며, 검사값(EKF_CHECK)마다 x와 P의 CRC-32를
+ * 비교해 처음 어긋난 호출을 알린다. 펌웨어와 같은 EKF 구성(ekf_config.h)으로 빌드해야 하며,
+ * 스냅샷 배치 지문(ekf_snapshot_layout)이 다르면 재생하지 않는다.
+ *
+ * 레코드를 잃은 구간(호출 번호가 건너뜀)은 다음 스냅샷까지 건너뛴다.
+ *
+ * 출력:
+ * - 궤적 CSV (-o): 예측 호출 decimation개마다 한 행
+ *   index,t_us,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,qw,qx,qy,qz
+ * - 표준 오류: 호출 종류별 수, 검사값 일치/불일치, 건너뛴 호출, 스냅샷 수
+ *
+ * -e로 엔진을 바꾸면(0 공분산, 1 U-D) 첫 스냅샷 뒤 엔진을 바꾸고, 기록된 ekf_set_engine도
+ * 바꾼 엔진으로 부른다. 이때 검사값은 비교하지 않고, 뒤 스냅샷마다 기록 상태와의 x 최대 차를
+ * 알리며 스냅샷을 읽지 않는다 (같은 입력에 대한 엔진 간 차이 비교).
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -ITools/ground -o call_player Tools/replay/call_player.c \
+ *       Tools/ground/ground_decode.c Core/Src/log/log_lz.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c -lm
+ *
+ * 실행:
+ *   ./call_player [-e engine] [-d decimation] [-o traj.csv] flash.bin
+ */
+
+#include "ground_decode.h"
+#include "ekf/ekf.h"
+#include "ekf/ekf_delay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief 기록 형식 (log/call_recorder.h와 같음)
+ */
+#define PLAYER_CALL_HEADER 11u
+#define PLAYER_SNAP_HEADER 6u
+#define PLAYER_CONTINUED 0x80u
+#define PLAYER_SNAP_LAYOUT 0xFFFFu
+
+/**
+ * @brief 호출 인자 최대 길이 (head와 tail 모두 u16)
+ */
+#define PLAYER_ARGS_MAX (2u * 65536u)
+
+/**
+ * @brief 스냅샷 최대 크기
+ */
+#define PLAYER_SNAP_MAX (EKF_SNAPSHOT_SIZE + sizeof(EKF_DelayBuffer))
+
+/**
+ * @brief 재생 상태
+ */
+typedef struct {
+    EKF ekf;
+    EKF_DelayBuffer history;
+    int engine;                /**< 바꾼 엔진 (-1이면 기록 그대로) */
+    bool synced;               /**< 스냅샷을 읽어 재생 중 */
+    bool started;              /**< 첫 스냅샷을 읽음 */
+    uint32_t next_index;       /**< 다음에 올 호출 번호 */
+
+    uint8_t call;              /**< 모으는 중인 호출 (0이면 없음) */
+    uint32_t call_index;
+    uint32_t call_t_us;
+    uint32_t args_len;
+    uint32_t args_have;
+    uint8_t args[PLAYER_ARGS_MAX];
+
+    bool snap_open;            /**< 스냅샷 조각을 모으는 중 */
+    uint32_t snap_index;
+    uint16_t snap_ekf_size;
+    uint16_t snap_history_size;
+    bool snap_initialized;
+    uint32_t snap_have;
+    uint8_t snap[PLAYER_SNAP_MAX];
+
+    FILE *out;
+    uint32_t decimation;
+    uint32_t predicts;
+
+    uint32_t calls[EKF_CALL_COUNT];
+    uint32_t failed;           /**< false를 돌려준 호출 수 */
+    uint32_t unknown;          /**< 모르는 호출 수 */
+    uint32_t skipped;          /**< 동기화 전이라 건너뛴 호출 수 */
+    uint32_t gaps;             /**< 호출 번호가 건너뛴 횟수 */
+    uint32_t snapshots;        /**< 읽은 스냅샷 수 */
+    uint32_t layout_errors;    /**< 배치 지문이 다른 스냅샷 수 */
+    uint32_t checks_ok;
+    uint32_t checks_bad;
+    bool first_bad_reported;
+    float max_state_diff;      /**< 엔진 비교: 스냅샷 대비 x 최대 차 */
+} Player;
+
+static uint16_t rd16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 호출 하나 재생 (인자 모양은 EKF_CallId 설명과 같음)
+ *
+ * @return bool 호출 결과 (인자 길이가 맞지 않으면 false)
+ */
+static bool player_dispatch(Player *p, uint8_t call, const uint8_t *a, uint32_t len) {
+    EKF *ekf = &p->ekf;
+    EKF_DelayBuffer *h = &p->history;
+    EKF_ImuSample imu;
+    EKF_CallGps gps;
+    EKF_GpsAccuracy acc;
+    EKF_GnssHeading heading;
+    EKF_CallNavEstimate nav;
+    EKF_CoincidentMeasurement cm;
+    Vector3f v;
+    float f;
+    uint32_t t;
+
+#define PLAYER_ARG(dst, off) \
+    do { if (len < (off) + sizeof(dst)) { return false; } memcpy(&(dst), a + (off), sizeof(dst)); } while (0)
+
+    switch (call) {
+    case EKF_CALL_PREDICT:
+        PLAYER_ARG(imu, 0);
+        return ekf_predict(ekf, imu.gyro, imu.accel, imu.dt);
+    case EKF_CALL_PREDICT_STATE_ONLY:
+        PLAYER_ARG(imu, 0);
+        return ekf_predict_state_only(ekf, imu.gyro, imu.accel, imu.dt);
+    case EKF_CALL_PREDICT_ATTITUDE:
+        PLAYER_ARG(imu, 0);
+        return ekf_predict_attitude(ekf, imu.gyro, imu.dt);
+    case EKF_CALL_PREDICT_BATCH: {
+        uint16_t n = (uint16_t)(len / sizeof(EKF_ImuSample));
+        EKF_ImuSample *samples = malloc((n > 0 ? n : 1u) * sizeof(EKF_ImuSample));
+        if (samples == NULL) {
+            return false;
+        }
+        memcpy(samples, a, (size_t)n * sizeof(EKF_ImuSample));
+        bool ok = ekf_predict_batch(ekf, samples, n);
+        free(samples);
+        return ok;
+    }
+    case EKF_CALL_FLUSH_COVARIANCE:
+        return ekf_flush_covariance(ekf);
+    case EKF_CALL_UPDATE_GPS:
+        PLAYER_ARG(gps, 0);
+        return ekf_update_gps(ekf, gps.pos, gps.flags != 0, gps.vel);
+    case EKF_CALL_UPDATE_GPS_PARTIAL:
+        PLAYER_ARG(gps, 0);
+        return ekf_update_gps_partial(ekf, gps.pos, gps.vel, (uint8_t)gps.flags);
+    case EKF_CALL_UPDATE_BARO:
+        PLAYER_ARG(f, 0);
+        return ekf_update_baro(ekf, f);
+    case EKF_CALL_UPDATE_COINCIDENT:
+        if (len == 0) {
+            return ekf_update_coincident(ekf, NULL);
+        }
+        PLAYER_ARG(cm, 0);
+        return ekf_update_coincident(ekf, &cm);
+    case EKF_CALL_INFO_BEGIN:
+        return ekf_info_begin(ekf);
+    case EKF_CALL_INFO_APPLY:
+        return ekf_info_apply(ekf);
+    case EKF_CALL_UPDATE_GNSS_RAW: {
+        PLAYER_ARG(v, 0);
+        uint8_t n = (uint8_t)((len - sizeof(v)) / sizeof(EKF_GnssObservation));
+        EKF_GnssObservation obs[256];
+        memcpy(obs, a + sizeof(v), (size_t)n * sizeof(EKF_GnssObservation));
+        return ekf_update_gnss_raw(ekf, v, (n > 0) ? obs : NULL, n) > 0;
+    }
+    case EKF_CALL_UPDATE_MAG:
+        PLAYER_ARG(v, 0);
+        return ekf_update_mag(ekf, v);
+    case EKF_CALL_MAG_CHECK_DISTURBANCE:
+        PLAYER_ARG(v, 0);
+        return ekf_mag_check_disturbance(ekf, v);
+    case EKF_CALL_UPDATE_MAG_HEADING:
+        PLAYER_ARG(v, 0);
+        return ekf_update_mag_heading(ekf, v);
+    case EKF_CALL_UPDATE_GRAVITY:
+        PLAYER_ARG(v, 0);
+        return ekf_update_gravity(ekf, v);
+    case EKF_CALL_UPDATE_ZUPT:
+        return ekf_update_zupt(ekf);
+    case EKF_CALL_UPDATE_RAIL:
+        PLAYER_ARG(f, 0);
+        return ekf_update_rail(ekf, f);
+    case EKF_CALL_UPDATE_ZERO_RATE:
+        PLAYER_ARG(imu, 0);
+        return ekf_update_zero_rate(ekf, imu.gyro, imu.dt);
+    case EKF_CALL_UPDATE_DRAG:
+        PLAYER_ARG(v, 0);
+        return ekf_update_drag(ekf, v);
+    case EKF_CALL_ESTIMATE_DRAG:
+        PLAYER_ARG(v, 0);
+        return ekf_estimate_drag(ekf, v);
+    case EKF_CALL_UPDATE_NAV_ESTIMATE: {
+        float P_ext[EKF_NAV_ERROR_DIM][EKF_NAV_ERROR_DIM];
+        PLAYER_ARG(nav, 0);
+        PLAYER_ARG(P_ext, sizeof(nav));
+        return ekf_update_nav_estimate(ekf, nav.q, nav.vel, nav.pos, (const float (*)[EKF_NAV_ERROR_DIM])P_ext,
+                                       (uint8_t)nav.components, nav.omega);
+    }
+    case EKF_CALL_SET_INITIAL_STATE:
+        PLAYER_ARG(nav, 0);
+        return ekf_set_initial_state(ekf, nav.pos, nav.vel, nav.q);
+    case EKF_CALL_SET_BARO_NOISE_SCALE:
+        PLAYER_ARG(f, 0);
+        return ekf_set_baro_noise_scale(ekf, f);
+    case EKF_CALL_SET_MAG_NOISE_SCALE:
+        PLAYER_ARG(f, 0);
+        return ekf_set_mag_noise_scale(ekf, f);
+    case EKF_CALL_SET_GPS_ACCURACY:
+        PLAYER_ARG(acc, 0);
+        return ekf_set_gps_accuracy(ekf, &acc);
+    case EKF_CALL_UPDATE_GNSS_HEADING:
+        PLAYER_ARG(heading, 0);
+        return ekf_update_gnss_heading(ekf, &heading);
+    case EKF_CALL_DELAY_UPDATE_GNSS_HEADING:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(heading, sizeof(t));
+        return ekf_delay_update_gnss_heading(ekf, h, t, &heading);
+    case EKF_CALL_SET_VELOCITY_NOISE_INFLATION:
+        PLAYER_ARG(f, 0);
+        return ekf_set_velocity_noise_inflation(ekf, f);
+    case EKF_CALL_STEADY_GAIN_RESET:
+        return ekf_steady_gain_reset(ekf);
+    case EKF_CALL_SET_EARTH_MAGNETIC_FIELD:
+        PLAYER_ARG(v, 0);
+        return ekf_set_earth_magnetic_field(ekf, v);
+    case EKF_CALL_SET_RAIL_CONSTRAINT: {
+        float r[3];
+        PLAYER_ARG(r, 0);
+        return ekf_set_rail_constraint(ekf, r[0] != 0.0f, r[1], r[2]);
+    }
+    case EKF_CALL_SET_ENGINE: {
+        uint8_t e;
+        PLAYER_ARG(e, 0);
+        return ekf_set_engine(ekf, (EKF_Engine)((p->engine >= 0) ? p->engine : e));
+    }
+    case EKF_CALL_DELAY_PREDICT:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(imu, sizeof(t));
+        return ekf_delay_predict(ekf, h, &imu, t);
+    case EKF_CALL_DELAY_UPDATE_GPS:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(gps, sizeof(t));
+        return ekf_delay_update_gps(ekf, h, t, gps.pos, gps.flags != 0, gps.vel);
+    case EKF_CALL_DELAY_UPDATE_GPS_PARTIAL:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(gps, sizeof(t));
+        return ekf_delay_update_gps_partial(ekf, h, t, gps.pos, gps.vel, (uint8_t)gps.flags);
+    case EKF_CALL_DELAY_UPDATE_BARO:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(f, sizeof(t));
+        return ekf_delay_update_baro(ekf, h, t, f);
+    case EKF_CALL_DELAY_UPDATE_MAG:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(v, sizeof(t));
+        return ekf_delay_update_mag(ekf, h, t, v);
+    case EKF_CALL_DELAY_UPDATE_COINCIDENT:
+        PLAYER_ARG(t, 0);
+        PLAYER_ARG(cm, sizeof(t));
+        return ekf_delay_update_coincident(ekf, h, t, &cm);
+    case EKF_CALL_DELAY_CLEAR:
+        return ekf_delay_clear(ekf, h);
+    default:
+        p->unknown++;
+        return false;
+    }
+#undef PLAYER_ARG
+}
+
+/**
+ * @brief 모은 호출 재생과 궤적 출력
+ */
+static void player_run_call(Player *p) {
+    const uint8_t call = p->call;
+    if (!player_dispatch(p, call, p->args, p->args_len)) {
+        p->failed++;
+    }
+    if (call < EKF_CALL_COUNT) {
+        p->calls[call]++;
+    }
+    p->next_index = p->call_index + 1u;
+
+    if (call == EKF_CALL_PREDICT || call == EKF_CALL_PREDICT_BATCH || call == EKF_CALL_DELAY_PREDICT) {
+        if (p->out != NULL && (p->predicts++ % p->decimation) == 0) {
+            Vector3f pos = ekf_get_position(&p->ekf);
+            Vector3f vel = ekf_get_velocity(&p->ekf);
+            Quaternion q = ekf_get_attitude(&p->ekf);
+            fprintf(p->out, "%u,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.6f,%.6f,%.6f,%.6f\n",
+                    p->call_index, p->call_t_us, pos.x, pos.y, pos.z, vel.x, vel.y, vel.z, q.w, q.x, q.y, q.z);
+        }
+    }
+}
+
+/**
+ * @brief EKF_CALL 레코드
+ */
+static void player_on_call(Player *p, const uint8_t *d, uint8_t len) {
+    if (len < PLAYER_CALL_HEADER) {
+        return;
+    }
+    const uint32_t index = rd32(&d[0]);
+    const uint8_t call = d[8];
+    const uint16_t n = rd16(&d[9]);
+    const uint8_t *chunk = &d[PLAYER_CALL_HEADER];
+    const uint32_t chunk_len = len - PLAYER_CALL_HEADER;
+
+    if (call & PLAYER_CONTINUED) {
+        if (p->call == 0 || index != p->call_index || n != p->args_have ||
+            p->args_have + chunk_len > p->args_len) {
+            return;
+        }
+        memcpy(&p->args[p->args_have], chunk, chunk_len);
+        p->args_have += chunk_len;
+    } else {
+        if (p->synced && index != p->next_index) {
+            // 레코드를 잃음: 다음 스냅샷까지 건너뜀
+            p->gaps++;
+            p->synced = false;
+        }
+        p->call = 0;
+        if (!p->synced) {
+            p->skipped++;
+            return;
+        }
+        if (chunk_len > n) {
+            return;
+        }
+        p->call = call;
+        p->call_index = index;
+        p->call_t_us = rd32(&d[4]);
+        p->args_len = n;
+        p->args_have = chunk_len;
+        memcpy(p->args, chunk, chunk_len);
+    }
+
+    if (p->call != 0 && p->args_have == p->args_len) {
+        player_run_call(p);
+        p->call = 0;
+    }
+}
+
+/**
+ * @brief 모은 스냅샷 읽기 (엔진 비교 중이면 x 차만 잰다)
+ */
+static void player_load_snapshot(Player *p) {
+    if (p->engine >= 0 && p->started) {
+        EKF_StateVector x;
+        memcpy(&x, p->snap + offsetof(EKF, x), sizeof(x));
+        for (int i = 0; i < EKF_STATE_DIM; i++) {
+            float diff = fabsf(x.data[i][0] - p->ekf.x.data[i][0]);
+            if (diff > p->max_state_diff) {
+                p->max_state_diff = diff;
+            }
+        }
+        fprintf(stderr, "스냅샷 %u: x 최대 차 %.6g\n", p->snap_index, (double)p->max_state_diff);
+        return;
+    }
+
+    // 포인터 필드(스냅샷 범위 뒤)는 ekf_init 값을 그대로 둔다
+    ekf_init(&p->ekf);
+    memcpy(&p->ekf, p->snap, EKF_SNAPSHOT_SIZE);
+    p->ekf.initialized = p->snap_initialized;
+    if (p->snap_history_size == sizeof(EKF_DelayBuffer)) {
+        memcpy(&p->history, p->snap + EKF_SNAPSHOT_SIZE, sizeof(EKF_DelayBuffer));
+    } else {
+        ekf_delay_init(&p->history);
+    }
+    if (p->engine >= 0) {
+        ekf_set_engine(&p->ekf, (EKF_Engine)p->engine);
+    }
+    p->started = true;
+    p->synced = true;
+    p->call = 0;
+    p->next_index = p->snap_index;
+    p->snapshots++;
+}
+
+/**
+ * @brief EKF_SNAP 레코드
+ */
+static void player_on_snap(Player *p, const uint8_t *d, uint8_t len) {
+    if (len < PLAYER_SNAP_HEADER) {
+        return;
+    }
+    const uint32_t index = rd32(&d[0]);
+    const uint16_t offset = rd16(&d[4]);
+
+    if (offset == PLAYER_SNAP_LAYOUT) {
+        p->snap_open = false;
+        if (len < 15u) {
+            return;
+        }
+        p->snap_ekf_size = rd16(&d[6]);
+        p->snap_history_size = rd16(&d[8]);
+        if (p->snap_ekf_size != EKF_SNAPSHOT_SIZE || rd32(&d[10]) != ekf_snapshot_layout() ||
+            (p->snap_history_size != 0 && p->snap_history_size != sizeof(EKF_DelayBuffer))) {
+            p->layout_errors++;
+            return;
+        }
+        p->snap_open = true;
+        p->snap_index = index;
+        p->snap_initialized = d[14] != 0;
+        p->snap_have = 0;
+        return;
+    }
+
+    const uint32_t n = len - PLAYER_SNAP_HEADER;
+    const uint32_t total = (uint32_t)p->snap_ekf_size + p->snap_history_size;
+    if (!p->snap_open || index != p->snap_index || offset != p->snap_have || p->snap_have + n > total) {
+        p->snap_open = false;
+        return;
+    }
+    memcpy(&p->snap[p->snap_have], &d[PLAYER_SNAP_HEADER], n);
+    p->snap_have += n;
+    if (p->snap_have == total) {
+        p->snap_open = false;
+        player_load_snapshot(p);
+    }
+}
+
+/**
+ * @brief EKF_CHECK 레코드
+ */
+static void player_on_check(Player *p, const uint8_t *d, uint8_t len) {
+    if (len < 12u || !p->synced || p->engine >= 0 || rd32(&d[0]) != p->next_index) {
+        return;
+    }
+    const uint32_t crc_x = ground_crc32((const uint8_t *)p->ekf.x.data, sizeof(p->ekf.x.data));
+    const uint32_t crc_p = ground_crc32((const uint8_t *)p->ekf.P.data, sizeof(p->ekf.P.data));
+    if (crc_x == rd32(&d[4]) && crc_p == rd32(&d[8])) {
+        p->checks_ok++;
+        return;
+    }
+    p->checks_bad++;
+    if (!p->first_bad_reported) {
+        fprintf(stderr, "첫 불일치: 호출 %u 직전 (x %s, P %s)\n", p->next_index,
+                (crc_x == rd32(&d[4])) ? "일치" : "다름", (crc_p == rd32(&d[8])) ? "일치" : "다름");
+        p->first_bad_reported = true;
+    }
+}
+
+int main(int argc, char **argv) {
+    static Player player;
+    Player *p = &player;
+    p->engine = -1;
+    p->decimation = 1;
+    const char *out_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "e:d:o:")) != -1) {
+        switch (opt) {
+        case 'e':
+            p->engine = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'd':
+            p->decimation = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc - 1 || p->decimation == 0 || p->engine > EKF_ENGINE_UD) {
+        fprintf(stderr, "사용법: %s [-e engine] [-d decimation] [-o traj.csv] flash.bin\n", argv[0]);
+        return 1;
+    }
+
+    int fd = open(argv[optind], O_RDONLY);
+    if (fd < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        perror("fstat");
+        close(fd);
+        return 1;
+    }
+    const size_t size = (size_t)st.st_size;
+    const uint8_t *image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    if (out_path != NULL) {
+        p->out = fopen(out_path, "w");
+        if (p->out == NULL) {
+            perror(out_path);
+            return 1;
+        }
+        fprintf(p->out, "index,t_us,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,qw,qx,qy,qz\n");
+    }
+
+    static GroundLog log;
+    GroundBlock block;
+    GroundRecord rec;
+    ground_log_open(&log, image, size);
+    while (ground_log_next(&log, &block)) {
+        if (block.index) {
+            continue;
+        }
+        uint32_t offset = FLASH_LOG_BLOCK_HEADER_SIZE;
+        while (ground_block_next_record(&block, &offset, &rec)) {
+            switch (rec.type) {
+            case FLASH_LOG_REC_EKF_CALL:
+                player_on_call(p, rec.payload, rec.len);
+                break;
+            case FLASH_LOG_REC_EKF_CHECK:
+                player_on_check(p, rec.payload, rec.len);
+                break;
+            case FLASH_LOG_REC_EKF_SNAP:
+                player_on_snap(p, rec.payload, rec.len);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    if (p->out != NULL) {
+        fclose(p->out);
+    }
+    munmap((void *)image, size);
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < EKF_CALL_COUNT; i++) {
+        total += p->calls[i];
+    }
+    fprintf(stderr, "호출 %u (실패 %u, 모름 %u), 건너뜀 %u, 번호 끊김 %u, 스냅샷 %u, 배치 불일치 %u\n",
+            total, p->failed, p->unknown, p->skipped, p->gaps, p->snapshots, p->layout_errors);
+    for (uint32_t i = 1; i < EKF_CALL_COUNT; i++) {
+        if (p->calls[i] > 0) {
+            fprintf(stderr, "  호출 %2u: %u\n", i, p->calls[i]);
+        }
+    }
+    if (p->engine >= 0) {
+        fprintf(stderr, "엔진 %d로 재생: x 최대 차 %.6g\n", p->engine, (double)p->max_state_diff);
+        return 0;
+    }
+    fprintf(stderr, "검사값 일치 %u, 불일치 %u\n", p->checks_ok, p->checks_bad);
+
+    return (p->checks_bad > 0 || p->layout_errors > 0) ? 2 : 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file log_replay.c
+ * @brief 비행 기록 재생 프로그램 (호스트용 소프트웨어 인 더 루프)
+ *
+ * 비행 기록(NOR 덤프 또는 SD 기록 파일, 형식은 Tools/log/log_decode.c와 같음)의
+ * 센서 레코드를 기록 순서대로 읽어 Core/Src의 융합 스케줄러(fusion_scheduler)에
+ * 넣고, 수정하지 않은 ekf_predict/ekf_update_* 로 다시 추정한다. 레코드 처리는
+ * Tools/replay/replay.h 를 따른다.
+ *
+ * 출력:
+ * - 궤적 CSV (-o): 게시된 항법 해 decimation개마다 한 행
+ *   t_us,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,qw,qx,qy,qz,phase
+ * - 표준 오류: 기록 시간 대비 처리 시간(실시간 배율), IMU 샘플당 처리 시간,
+ *   스케줄러 통계, 측정별 게이트 거부 수, 기준 궤적이 있으면 위치/속도/자세 RMS 차,
+ *   -q이면 Q31 예비 필터와 부동소수점 해의 기울기/고도/수직 속도 차
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o log_replay Tools/replay/log_replay.c Tools/replay/replay.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c \
+ *       Core/Src/nav/fusion_scheduler.c Core/Src/nav/fusion_monitor.c Core/Src/nav/flight_phase.c \
+ *       Core/Src/nav/event_detector.c Core/Src/nav/nav_publisher.c Core/Src/nav/geodetic.c \
+ *       Core/Src/nav/convergence_monitor.c Core/Src/nav/filter_health.c Core/Src/nav/fixed_lag.c \
+ *       Core/Src/nav/latency_monitor.c Core/Src/nav/predict_rate.c Core/Src/nav/vertical_filter.c \
+ *       Core/Src/sensors/imu_ring.c Core/Src/sensors/baro_altitude.c Core/Src/sensors/baro_isa_table.c \
+ *       Core/Src/sensors/mag_iron_cal.c Core/Src/sensors/static_detector.c Core/Src/sensors/accel_blend.c \
+ *       Core/Src/sensors/gyro_spectrum.c Core/Src/sensors/gyro_notch.c Core/Src/sensors/imu_lever_arm.c \
+ *       Core/Src/sensors/meas_queue.c Core/Src/sensors/mag_average.c Core/Src/sensors/imu_vibration.c -lm
+ *
+ * 실행:
+ *   ./log_replay [-s 세션] [-b batch] [-d decimation] [-n] [-q] [-o traj.csv] flash.bin
+ *   -n: 비행 단계 상태 기계 없이 처음부터 전체 주기로 추정
+ *   -q: Q31 예비 필터(ekf_q31)를 같은 입력으로 함께 돌려 비교
+ */
+
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    ReplayConfig config;
+    replay_default_config(&config);
+    long session_arg = -1;
+    const char *out_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:b:d:nqo:")) != -1) {
+        switch (opt) {
+        case 's':
+            session_arg = strtol(optarg, NULL, 0);
+            break;
+        case 'b':
+            config.batch = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'd':
+            config.decimation = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            config.use_phase = false;
+            break;
+        case 'q':
+            config.backup = true;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc - 1 || config.batch == 0 || config.decimation == 0) {
+        fprintf(stderr, "사용법: %s [-s 세션] [-b batch] [-d decimation] [-n] [-q] [-o traj.csv] flash.bin\n",
+                argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[optind], "rb");
+    if (f == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+    FILE *out = NULL;
+    if (out_path != NULL) {
+        out = fopen(out_path, "w");
+        if (out == NULL) {
+            perror(out_path);
+            fclose(f);
+            return 1;
+        }
+    }
+
+    static Replay r;
+    if (!replay_init(&r, &config, out)) {
+        fprintf(stderr, "필터 초기화 실패\n");
+        return 1;
+    }
+
+    static uint8_t block[FLASH_LOG_BLOCK_SIZE];
+    uint32_t blocks = 0;
+    uint32_t invalid = 0;
+    uint32_t other_session = 0;
+    long session = session_arg;
+    uint64_t wall_start = now_ns();
+    while (fread(block, 1, FLASH_LOG_BLOCK_SIZE, f) == FLASH_LOG_BLOCK_SIZE) {
+        uint32_t block_session;
+        if (!replay_block_valid(block, &block_session)) {
+            invalid++;
+            continue;
+        }
+        // 세션을 지정하지 않으면 첫 유효 블록의 세션만 재생
+        if (session < 0) {
+            session = block_session;
+        }
+        if (block_session != (uint32_t)session) {
+            other_session++;
+            continue;
+        }
+        replay_block(&r, block);
+        blocks++;
+    }
+    replay_finish(&r);
+    uint64_t wall_ns = now_ns() - wall_start;
+    fclose(f);
+    if (out != NULL) {
+        fclose(out);
+    }
+
+    const FusionStats *st = fusion_scheduler_get_stats(&r.sched);
+    double flight_s = r.have_time ? (double)(uint32_t)(r.last_us - r.first_us) * 1e-6 : 0.0;
+    double wall_s = (double)wall_ns * 1e-9;
+    fprintf(stderr, "세션 %ld: 블록 %u개 (빈/깨진 블록 %u, 다른 세션 %u)\n", session, blocks, invalid, other_session);
+    fprintf(stderr, "샘플: IMU %u, 기압 %u, 자기장 %u, GNSS %u (대기열 초과 %u)\n",
+            r.imu_samples, r.baro_samples, r.mag_samples, r.gnss_samples, r.push_failures);
+    fprintf(stderr, "기록 %.2f s, 처리 %.3f s (융합 %.3f s), 실시간 대비 %.0f배, IMU 샘플당 %.2f us\n",
+            flight_s, wall_s, (double)r.fusion_ns * 1e-9, (wall_s > 0.0) ? flight_s / wall_s : 0.0,
+            r.imu_samples ? (double)r.fusion_ns * 1e-3 / r.imu_samples : 0.0);
+    fprintf(stderr, "스케줄러: 예측 %u, 갱신 %u, 갱신 실패 %u, 버림 %u\n",
+            st->predicts, st->updates, st->update_failures, st->dropped);
+    fprintf(stderr, "게이트 거부: 기압 %u, 자력계 %u, GNSS %u\n",
+            ekf_get_innovation_reject_count(&r.ekf, EKF_SENSOR_BARO),
+            ekf_get_innovation_reject_count(&r.ekf, EKF_SENSOR_MAG),
+            ekf_get_innovation_reject_count(&r.ekf, EKF_SENSOR_GPS_POS_VEL));
+    fprintf(stderr, "연속 거부 뒤 강제 수용: 기압 %u, 자력계 %u, GNSS %u\n",
+            ekf_get_innovation_recover_count(&r.ekf, EKF_SENSOR_BARO),
+            ekf_get_innovation_recover_count(&r.ekf, EKF_SENSOR_MAG),
+            ekf_get_innovation_recover_count(&r.ekf, EKF_SENSOR_GPS_POS_VEL));
+
+    ReplayMetrics m;
+    if (replay_metrics(&r, &m)) {
+        fprintf(stderr, "기준 대비 (%zu점): 위치 RMS %.3f m, 최대 %.3f m (t=%u us), 속도 RMS %.3f m/s, "
+                "자세 RMS %.3f deg, 최고 고도 %.1f / %.1f m\n",
+                m.points, m.pos_rms, m.pos_max, m.pos_max_t_us, m.vel_rms, m.att_rms_deg,
+                m.apogee_replay, m.apogee_ref);
+        fprintf(stderr, "일관성: 위치/속도 NEES %.2f (%zu점), NIS 기압 %.2f, 자력계 %.2f, GNSS %.2f\n",
+                m.nees_mean, m.nees_points, m.nis_mean[EKF_SENSOR_BARO], m.nis_mean[EKF_SENSOR_MAG],
+                m.nis_mean[EKF_SENSOR_GPS_POS_VEL]);
+    } else {
+        fprintf(stderr, "기준 항법 해 없음 (궤적 비교 생략)\n");
+    }
+    if (config.backup) {
+        const EKF_Q31_Stats *bs = ekf_q31_get_stats(&r.backup.filter);
+        fprintf(stderr, "Q31 예비 필터 대비 (%zu점): 기울기 RMS %.3f deg, 최대 %.3f deg, 자세 RMS %.3f deg, "
+                "고도 RMS %.3f m, 최대 %.3f m, 수직 속도 RMS %.3f m/s, IMU 샘플당 %.2f us\n",
+                m.backup_points, m.backup_tilt_rms_deg, m.backup_tilt_max_deg, m.backup_att_rms_deg,
+                m.backup_alt_rms, m.backup_alt_max, m.backup_vel_rms, m.backup_us_per_sample);
+        fprintf(stderr, "예비 필터 갱신: 비력 방향 %u (생략 %u, 거부 %u), 기압 %u (거부 %u)\n",
+                bs->gravity_updates, bs->gravity_skips, bs->gravity_rejects, bs->baro_updates, bs->baro_rejects);
+    }
+    replay_free(&r);
+
+    return 0;
+}
@@ -0,0 +1,792 @@
+/**
+ * @file replay.c
+ * @brief 비행 기록 레코드 → 융합 스케줄러 재생 구현
+ */
+
+#include "replay.h"
+#include "math/quaternion.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief 자기장 단위 변환 (uT → G)
+ */
+#define REPLAY_UT_TO_GAUSS 0.01f
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static uint64_t replay_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 스케줄러 시계 (재생 중 고정, 예산 판단이 호스트 속도에 의존하지 않게 함)
+ */
+static uint32_t replay_clock(void) {
+    return 0;
+}
+
+/**
+ * @brief 리틀 엔디언 읽기
+ */
+static uint32_t rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static float rdf(const uint8_t *p) {
+    uint32_t v = rd32(p);
+    float f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief 궤적에 점 추가
+ */
+static void replay_track_push(ReplayTrack *track, uint32_t t_us, Vector3f pos, Vector3f vel, Quaternion q,
+                              const float *p_diag) {
+    if (track->count == track->capacity) {
+        size_t capacity = track->capacity ? track->capacity * 2 : 4096;
+        ReplayPoint *points = realloc(track->points, capacity * sizeof(ReplayPoint));
+        if (points == NULL) {
+            return;
+        }
+        track->points = points;
+        track->capacity = capacity;
+    }
+    ReplayPoint point = { .t_us = t_us, .pos = pos, .vel = vel, .q = q };
+    if (p_diag != NULL) {
+#if EKF_CONFIG_POSITION
+        point.pos_var = vector3f_create(p_diag[EKF_STATE_POS_X], p_diag[EKF_STATE_POS_Y], p_diag[EKF_STATE_POS_Z]);
+#endif
+        point.vel_var = vector3f_create(p_diag[EKF_STATE_VEL_X], p_diag[EKF_STATE_VEL_Y], p_diag[EKF_STATE_VEL_Z]);
+    }
+    track->points[track->count++] = point;
+}
+
+/**
+ * @brief 게시된 해와 예비 필터 비교 (예비 필터는 같은 사이클의 마지막 IMU 샘플까지 적분된 상태)
+ */
+static void replay_backup_compare(Replay *r, const EKF_NavSolution *sol) {
+    ReplayBackup *b = &r->backup;
+    if (!b->ready) {
+        return;
+    }
+
+    int32_t qi[4];
+    int32_t pos_z;
+    int32_t vel_z;
+    ekf_q31_get_attitude(&b->filter, qi);
+    ekf_q31_get_vertical(&b->filter, &pos_z, &vel_z);
+    Quaternion q = quaternion_create(q31_to_float(qi[0], EKF_Q31_QUAT_EXP), q31_to_float(qi[1], EKF_Q31_QUAT_EXP),
+                                     q31_to_float(qi[2], EKF_Q31_QUAT_EXP), q31_to_float(qi[3], EKF_Q31_QUAT_EXP));
+
+    // 기울기 차 = 두 자세의 몸체 z축(NED 성분, 회전 행렬 셋째 행) 사이 각
+    float Ra[3][3];
+    float Rb[3][3];
+    quaternion_to_rotation_matrix(sol->q, Ra);
+    quaternion_to_rotation_matrix(q, Rb);
+    double cz = (double)Ra[2][0] * Rb[2][0] + (double)Ra[2][1] * Rb[2][1] + (double)Ra[2][2] * Rb[2][2];
+    double tilt = acos(fmax(fmin(cz, 1.0), -1.0)) * (180.0 / M_PI);
+    double dot = fabs((double)sol->q.w * q.w + (double)sol->q.x * q.x + (double)sol->q.y * q.y +
+                      (double)sol->q.z * q.z);
+    double att = 2.0 * acos(fmin(dot, 1.0)) * (180.0 / M_PI);
+    double dh = fabs((double)q31_to_float(pos_z, EKF_Q31_POS_EXP) - sol->pos.z);
+    double dv = (double)q31_to_float(vel_z, EKF_Q31_VEL_EXP) - sol->vel.z;
+
+    b->tilt_sq += tilt * tilt;
+    b->tilt_max = fmax(b->tilt_max, tilt);
+    b->att_sq += att * att;
+    b->alt_sq += dh * dh;
+    b->alt_max = fmax(b->alt_max, dh);
+    b->vel_sq += dv * dv;
+    b->points++;
+}
+
+/**
+ * @brief 예비 필터 IMU 샘플 처리 (입력을 고정 소수점으로 바꿔 예측, 일정 간격으로 비력 방향 갱신)
+ */
+static void replay_backup_imu(Replay *r, uint32_t t_us, const float gyro[3], const float accel[3]) {
+    ReplayBackup *b = &r->backup;
+    if (!b->ready) {
+        return;
+    }
+
+    int32_t g[3];
+    int32_t a[3];
+    for (int i = 0; i < 3; i++) {
+        g[i] = q31_from_float(gyro[i], EKF_Q31_GYRO_EXP);
+        a[i] = q31_from_float(accel[i], EKF_Q31_ACCEL_EXP);
+    }
+    uint64_t start = replay_now_ns();
+    ekf_q31_predict(&b->filter, g, a, t_us - b->last_us);
+    if (++b->samples % REPLAY_BACKUP_GRAVITY_DECIMATION == 0) {
+        ekf_q31_update_gravity(&b->filter, a);
+    }
+    b->ns += replay_now_ns() - start;
+    b->last_us = t_us;
+}
+
+/**
+ * @brief 융합 사이클 1회와 게시된 해 수집
+ */
+static void replay_cycle(Replay *r) {
+    uint64_t start = replay_now_ns();
+    fusion_scheduler_run(&r->sched);
+    r->fusion_ns += replay_now_ns() - start;
+    r->pending = 0;
+
+    EKF_NavSolution sol;
+    uint32_t seq;
+    if (!nav_publisher_read(&r->publisher, &sol, &seq) || seq == r->last_seq) {
+        return;
+    }
+    r->last_seq = seq;
+    replay_track_push(&r->replay, sol.timestamp_us, sol.pos, sol.vel, sol.q, sol.p_diag);
+    replay_backup_compare(r, &sol);
+
+    if (r->out != NULL && (r->published % r->config.decimation) == 0) {
+        fprintf(r->out, "%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.6f,%.6f,%.6f,%.6f,%d\n",
+                sol.timestamp_us, sol.pos.x, sol.pos.y, sol.pos.z, sol.vel.x, sol.vel.y, sol.vel.z,
+                sol.q.w, sol.q.x, sol.q.y, sol.q.z,
+                (int)flight_phase_get(r->config.use_phase ? &r->phase : NULL));
+    }
+    r->published++;
+}
+
+/**
+ * @brief 첫 IMU 샘플로 필터 초기화 (정지 가정, 비력 방향으로 수평 자세)
+ */
+static void replay_start_filter(Replay *r, Vector3f accel) {
+    float roll = atan2f(accel.y, accel.z);
+    float pitch = atan2f(-accel.x, sqrtf(accel.y * accel.y + accel.z * accel.z));
+    Quaternion q = quaternion_from_euler(roll, pitch, 0.0f);
+    ekf_set_initial_state(&r->ekf, vector3f_zero(), vector3f_zero(), q);
+    r->filter_ready = true;
+
+    if (r->config.backup) {
+        const int32_t qi[4] = { q31_from_float(q.w, EKF_Q31_QUAT_EXP), q31_from_float(q.x, EKF_Q31_QUAT_EXP),
+                                q31_from_float(q.y, EKF_Q31_QUAT_EXP), q31_from_float(q.z, EKF_Q31_QUAT_EXP) };
+        r->backup.ready = ekf_q31_set_initial_state(&r->backup.filter, qi, 0, 0);
+    }
+}
+
+/**
+ * @brief IMU 샘플 처리
+ */
+static void replay_imu(Replay *r, uint32_t t_us, const float gyro[3], const float accel[3]) {
+    ImuSample s = {
+        .timestamp_us = t_us,
+        .gyro = vector3f_create(gyro[0], gyro[1], gyro[2]),
+        .accel = vector3f_create(accel[0], accel[1], accel[2])
+    };
+    if (!r->filter_ready) {
+        replay_start_filter(r, s.accel);
+        r->backup.last_us = t_us;
+    }
+    r->last_accel = s.accel;
+    replay_backup_imu(r, t_us, gyro, accel);
+    if (!r->have_time) {
+        r->first_us = t_us;
+        r->have_time = true;
+    }
+    r->last_us = t_us;
+    r->imu_samples++;
+
+    // 링이 차면 먼저 비움 (batch가 링보다 큰 경우)
+    if (!imu_ring_push(&r->ring, &s)) {
+        replay_cycle(r);
+        imu_ring_push(&r->ring, &s);
+    }
+    if (++r->pending >= r->config.batch) {
+        replay_cycle(r);
+    }
+}
+
+/**
+ * @brief 보조 측정 재시도 결과 (대기열이 차 있으면 한 사이클 돌린 뒤 다시 넣음)
+ */
+static void replay_push_retry(Replay *r, bool ok) {
+    if (!ok) {
+        r->push_failures++;
+    }
+}
+
+/**
+ * @brief 기압 샘플 처리
+ */
+static void replay_baro(Replay *r, uint32_t t_us, float pressure_pa, float temp_c) {
+    float alt;
+    r->baro_samples++;
+    if (!r->filter_ready || !baro_altitude_update(&r->baro, pressure_pa, temp_c, &alt)) {
+        return;
+    }
+    if (r->backup.ready) {
+        uint64_t start = replay_now_ns();
+        ekf_q31_update_baro(&r->backup.filter, q31_from_float(alt, EKF_Q31_POS_EXP));
+        r->backup.ns += replay_now_ns() - start;
+    }
+    if (!fusion_scheduler_push_baro(&r->sched, t_us, alt)) {
+        replay_cycle(r);
+        replay_push_retry(r, fusion_scheduler_push_baro(&r->sched, t_us, alt));
+    }
+}
+
+/**
+ * @brief 발사대 정렬용 자기장 샘플 누적, 다 모이면 정렬 적용
+ *
+ * 정렬에 실패하면 (수평 자기장이 너무 작음 등) 방위 0의 시작 자세 그대로 자기장을 융합한다.
+ */
+static void replay_align(Replay *r, Vector3f mag) {
+    if (r->align.count < r->config.align_samples) {
+        ekf_mag_field_add_sample(&r->align, mag, r->last_accel);
+        if (r->align.count < r->config.align_samples) {
+            return;
+        }
+    }
+
+    // 스케줄러가 쌓아 둔 예측을 먼저 반영한 상태에 적용
+    replay_cycle(r);
+    r->alignment_ok = ekf_align_coarse(&r->align, r->ekf.earth_mag_ned, &r->alignment) &&
+                      ekf_apply_alignment(&r->ekf, &r->alignment);
+    r->aligned = true;
+}
+
+/**
+ * @brief 자기장 샘플 처리
+ */
+static void replay_mag(Replay *r, uint32_t t_us, const float field[3]) {
+    r->mag_samples++;
+    if (!r->filter_ready) {
+        return;
+    }
+    Vector3f m = vector3f_create(field[0] * REPLAY_UT_TO_GAUSS, field[1] * REPLAY_UT_TO_GAUSS,
+                                 field[2] * REPLAY_UT_TO_GAUSS);
+    if (!r->aligned) {
+        replay_align(r, m);
+        return;
+    }
+    if (!fusion_scheduler_push_mag(&r->sched, t_us, m)) {
+        replay_cycle(r);
+        replay_push_retry(r, fusion_scheduler_push_mag(&r->sched, t_us, m));
+    }
+}
+
+/**
+ * @brief GNSS 레코드 처리
+ */
+static void replay_gnss(Replay *r, const uint8_t *p) {
+    uint32_t t_us = rd32(&p[0]);
+    int32_t lat = (int32_t)rd32(&p[8]);
+    int32_t lon = (int32_t)rd32(&p[12]);
+    int32_t height = (int32_t)rd32(&p[16]);
+    uint8_t fix_type = p[48];
+    uint8_t flags = p[50];
+    r->gnss_samples++;
+    if (!r->filter_ready || fix_type < REPLAY_GNSS_MIN_FIX || (flags & 0x01u) == 0) {
+        return;
+    }
+
+    if (!r->geo_ready) {
+        if (!geodetic_init(&r->geo, lat, lon, height, GEODETIC_DEFAULT_RECENTER_RADIUS)) {
+            return;
+        }
+        ekf_initialize_magnetic_field_from_location(&r->ekf, (float)lat * 1e-7f, (float)lon * 1e-7f);
+        r->geo_ready = true;
+    }
+
+    Vector3f ned;
+    if (!geodetic_to_ned(&r->geo, lat, lon, height, &ned)) {
+        return;
+    }
+    Vector3f pos = vector3f_create(ned.x, ned.y, -ned.z);
+    Vector3f vel = vector3f_create(rdf(&p[24]), rdf(&p[28]), -rdf(&p[32]));
+    if (!fusion_scheduler_push_gps(&r->sched, t_us, pos, true, vel)) {
+        replay_cycle(r);
+        replay_push_retry(r, fusion_scheduler_push_gps(&r->sched, t_us, pos, true, vel));
+    }
+}
+
+/**
+ * @brief 압축 스트림 레코드 복원 후 처리
+ */
+static void replay_stream(Replay *r, uint8_t type, const uint8_t *p, uint8_t len) {
+    const uint8_t *end = p + len;
+    if (len < 1) {
+        return;
+    }
+    ReplayStream *s = &r->streams[p[0]];
+    p++;
+
+    if (type == FLASH_LOG_REC_SCHEMA) {
+        if (len < 12 || p[0] == 0 || p[0] > LOG_CODEC_MAX_FIELDS || len < 12 + 4 * p[0]) {
+            return;
+        }
+        s->field_count = p[0];
+        memcpy(s->name, &p[3], LOG_CODEC_NAME_SIZE);
+        s->name[LOG_CODEC_NAME_SIZE] = '\0';
+        for (int i = 0; i < s->field_count; i++) {
+            s->scale[i] = rdf(&p[3 + LOG_CODEC_NAME_SIZE + 4 * i]);
+        }
+        s->valid = true;
+        s->primed = false;
+        return;
+    }
+
+    if (!s->valid || (type == FLASH_LOG_REC_DELTA && !s->primed)) {
+        return;
+    }
+
+    uint32_t v;
+    if (!log_format_get_varint(&p, end, &v)) {
+        return;
+    }
+    if (type == FLASH_LOG_REC_KEY) {
+        s->t = v;
+        s->dt = 0;
+    } else {
+        s->dt += log_format_unzigzag(v);
+        s->t += s->dt;
+    }
+    for (int i = 0; i < s->field_count; i++) {
+        if (!log_format_get_varint(&p, end, &v)) {
+            s->primed = false;
+            return;
+        }
+        s->q[i] = (int32_t)((type == FLASH_LOG_REC_KEY) ? log_format_unzigzag(v)
+                                                         : (uint32_t)s->q[i] + log_format_unzigzag(v));
+    }
+    s->primed = true;
+
+    float value[LOG_CODEC_MAX_FIELDS];
+    for (int i = 0; i < s->field_count; i++) {
+        value[i] = (float)((double)s->q[i] * (double)s->scale[i]);
+    }
+    if (strcmp(s->name, "imu") == 0 && s->field_count == 6) {
+        replay_imu(r, s->t, &value[0], &value[3]);
+    } else if (strcmp(s->name, "nav") == 0 && s->field_count >= 10) {
+        replay_track_push(&r->reference, s->t, vector3f_create(value[0], value[1], value[2]),
+                          vector3f_create(value[3], value[4], value[5]),
+                          quaternion_create(value[6], value[7], value[8], value[9]), NULL);
+    }
+}
+
+/**
+ * @brief 기본 설정
+ */
+void replay_default_config(ReplayConfig *config) {
+    config->use_phase = true;
+    config->batch = REPLAY_DEFAULT_BATCH;
+    config->decimation = REPLAY_DEFAULT_DECIMATION;
+    config->engine = EKF_ENGINE_COVARIANCE;
+    config->update_mode = EKF_UPDATE_SEQUENTIAL;
+    config->covariance_update = EKF_COVARIANCE_JOSEPH;
+    config->backup = false;
+    memset(&config->noise, 0, sizeof(config->noise));
+    config->align_samples = REPLAY_DEFAULT_ALIGN_SAMPLES;
+    config->static_detect = true;
+}
+
+/**
+ * @brief 잡음 설정을 필터에 적용
+ */
+bool replay_apply_noise(EKF *ekf, const ReplayNoise *noise) {
+    if (noise->pos_std > 0.0f &&
+        !ekf_set_process_noise(ekf, noise->pos_std, noise->vel_std, noise->att_std, noise->gyro_bias_std,
+                               noise->accel_bias_std)) {
+        return false;
+    }
+    if (noise->gps_pos_std > 0.0f && !ekf_set_gps_noise(ekf, noise->gps_pos_std, noise->gps_vel_std)) {
+        return false;
+    }
+    if (noise->baro_std > 0.0f && !ekf_set_baro_noise(ekf, noise->baro_std)) {
+        return false;
+    }
+    if (noise->mag_std > 0.0f && !ekf_set_mag_noise(ekf, noise->mag_std)) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 재생 상태 초기화
+ */
+bool replay_init(Replay *r, const ReplayConfig *config, FILE *out) {
+    memset(r, 0, sizeof(*r));
+    if (config != NULL) {
+        r->config = *config;
+    } else {
+        replay_default_config(&r->config);
+    }
+    if (r->config.batch == 0 || r->config.decimation == 0) {
+        return false;
+    }
+    r->out = out;
+    r->last_seq = UINT32_MAX;
+    r->aligned = (r->config.align_samples == 0);
+
+    if (!ekf_init(&r->ekf) || !scratch_init(&r->scratch, r->scratch_buffer, sizeof(r->scratch_buffer)) ||
+        !ekf_set_scratch_arena(&r->ekf, &r->scratch) || !ekf_initialize_default_magnetic_field(&r->ekf) ||
+        !ekf_set_engine(&r->ekf, r->config.engine) ||
+        !ekf_set_update_mode(&r->ekf, r->config.update_mode) ||
+        !ekf_set_covariance_update(&r->ekf, r->config.covariance_update) ||
+        !imu_ring_init(&r->ring) || !nav_publisher_init(&r->publisher) || !ekf_mag_field_init(&r->align) ||
+        !baro_altitude_init(&r->baro, BARO_ALTITUDE_DEFAULT_GROUND_SAMPLES, 0.0f) ||
+        !fusion_scheduler_init(&r->sched, &r->ekf, &r->history, &r->ring, replay_clock, UINT32_MAX) ||
+        !fusion_scheduler_set_publisher(&r->sched, &r->publisher) ||
+        !replay_apply_noise(&r->ekf, &r->config.noise)) {
+        return false;
+    }
+    if (r->config.backup && !ekf_q31_init(&r->backup.filter, NULL)) {
+        return false;
+    }
+    if (r->config.static_detect &&
+        (!static_detector_init(&r->detector, STATIC_DETECTOR_DEFAULT_WINDOW, STATIC_DETECTOR_DEFAULT_ACCEL_VAR,
+                               STATIC_DETECTOR_DEFAULT_GYRO_VAR) ||
+         !fusion_scheduler_set_static_detector(&r->sched, &r->detector))) {
+        return false;
+    }
+    if (r->config.use_phase) {
+        FlightPhaseConfig phase_config;
+        if (!flight_phase_default_config(&phase_config) || !flight_phase_init(&r->phase, &phase_config) ||
+            !fusion_scheduler_set_flight_phase(&r->sched, &r->phase)) {
+            return false;
+        }
+    }
+    if (out != NULL) {
+        fprintf(out, "t_us,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,qw,qx,qy,qz,phase\n");
+    }
+
+    return true;
+}
+
+/**
+ * @brief 새 블록 시작
+ */
+void replay_begin_block(Replay *r) {
+    memset(r->streams, 0, sizeof(r->streams));
+}
+
+/**
+ * @brief 레코드 하나 처리
+ */
+void replay_record(Replay *r, uint8_t type, const uint8_t *p, uint8_t len) {
+    float v[6];
+    switch (type) {
+    case FLASH_LOG_REC_SCHEMA:
+    case FLASH_LOG_REC_KEY:
+    case FLASH_LOG_REC_DELTA:
+        replay_stream(r, type, p, len);
+        break;
+    case FLASH_LOG_REC_IMU:
+        if (len == sizeof(FlashLogImuRecord)) {
+            for (int i = 0; i < 6; i++) {
+                v[i] = rdf(&p[4 + 4 * i]);
+            }
+            replay_imu(r, rd32(p), &v[0], &v[3]);
+        }
+        break;
+    case FLASH_LOG_REC_BARO:
+        if (len == sizeof(FlashLogBaroRecord)) {
+            replay_baro(r, rd32(p), rdf(&p[4]), rdf(&p[8]));
+        }
+        break;
+    case FLASH_LOG_REC_MAG:
+        if (len == sizeof(FlashLogMagRecord)) {
+            for (int i = 0; i < 3; i++) {
+                v[i] = rdf(&p[4 + 4 * i]);
+            }
+            replay_mag(r, rd32(p), v);
+        }
+        break;
+    case FLASH_LOG_REC_GNSS:
+        if (len >= sizeof(FlashLogGnssRecord)) {
+            replay_gnss(r, p);
+        }
+        break;
+    case FLASH_LOG_REC_NAV:
+        if (len == sizeof(EKF_NavSolution)) {
+            EKF_NavSolution sol;
+            memcpy(&sol, p, sizeof(sol));
+            replay_track_push(&r->reference, sol.timestamp_us, sol.pos, sol.vel, sol.q, NULL);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 블록 헤더와 CRC 확인
+ */
+bool replay_block_valid(const uint8_t *block, uint32_t *session) {
+    uint32_t used = block[FLASH_LOG_HEADER_USED] | ((uint32_t)block[FLASH_LOG_HEADER_USED + 1] << 8);
+    if (rd32(block) != FLASH_LOG_MAGIC || used < FLASH_LOG_BLOCK_HEADER_SIZE || used > FLASH_LOG_BLOCK_SIZE ||
+        log_format_crc32(&block[FLASH_LOG_CRC_OFFSET], FLASH_LOG_BLOCK_SIZE - FLASH_LOG_CRC_OFFSET) !=
+            rd32(&block[FLASH_LOG_HEADER_CRC])) {
+        return false;
+    }
+    if (session != NULL) {
+        *session = block[FLASH_LOG_HEADER_SESSION] | ((uint32_t)block[FLASH_LOG_HEADER_SESSION + 1] << 8);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 블록 레코드 처리
+ */
+void replay_block(Replay *r, const uint8_t *block) {
+    uint32_t used = block[FLASH_LOG_HEADER_USED] | ((uint32_t)block[FLASH_LOG_HEADER_USED + 1] << 8);
+
+    // 블록마다 스트림 상태를 새로 시작 (스키마와 키프레임이 블록 안에 있음)
+    replay_begin_block(r);
+    uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE;
+    while (o + 2 <= used && block[o] != FLASH_LOG_END_TYPE) {
+        uint8_t type = block[o];
+        uint8_t len = block[o + 1];
+        if (o + 2 + len > used) {
+            break;
+        }
+        replay_record(r, type, &block[o + 2], len);
+        o += 2u + len;
+    }
+}
+
+/**
+ * @brief 남은 IMU 샘플 처리
+ */
+void replay_finish(Replay *r) {
+    if (r->pending > 0) {
+        replay_cycle(r);
+    }
+}
+
+/**
+ * @brief 자세 오차 각 (도, 2 acos(|<q_ref, q_rep>|))
+ */
+static double replay_att_error_deg(Quaternion a, Quaternion b) {
+    double dot = fabs((double)a.w * b.w + (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z);
+    return 2.0 * acos(fmin(dot, 1.0)) * (180.0 / M_PI);
+}
+
+/**
+ * @brief 기준 궤적 대비 오차
+ */
+bool replay_metrics(const Replay *r, ReplayMetrics *m) {
+    memset(m, 0, sizeof(*m));
+    const ReplayBackup *b = &r->backup;
+    if (b->points > 0) {
+        m->backup_points = b->points;
+        m->backup_tilt_rms_deg = sqrt(b->tilt_sq / (double)b->points);
+        m->backup_tilt_max_deg = b->tilt_max;
+        m->backup_att_rms_deg = sqrt(b->att_sq / (double)b->points);
+        m->backup_alt_rms = sqrt(b->alt_sq / (double)b->points);
+        m->backup_alt_max = b->alt_max;
+        m->backup_vel_rms = sqrt(b->vel_sq / (double)b->points);
+        m->backup_us_per_sample = b->samples ? (double)b->ns * 1e-3 / b->samples : 0.0;
+    }
+    m->apogee_ref = -INFINITY;
+    m->apogee_replay = -INFINITY;
+    for (size_t i = 0; i < r->reference.count; i++) {
+        m->apogee_ref = fmax(m->apogee_ref, r->reference.points[i].pos.z);
+    }
+    for (size_t i = 0; i < r->replay.count; i++) {
+        m->apogee_replay = fmax(m->apogee_replay, r->replay.points[i].pos.z);
+    }
+    if (r->reference.count == 0 || r->replay.count == 0) {
+        return false;
+    }
+
+    double pos_sq = 0.0;
+    double vel_sq = 0.0;
+    double att_sq = 0.0;
+    double nees_sum = 0.0;
+    size_t j = 0;
+    for (size_t i = 0; i < r->reference.count; i++) {
+        const ReplayPoint *ref = &r->reference.points[i];
+        while (j + 1 < r->replay.count && (int32_t)(r->replay.points[j + 1].t_us - ref->t_us) <= 0) {
+            j++;
+        }
+        const ReplayPoint *rep = &r->replay.points[j];
+        if ((int32_t)(rep->t_us - ref->t_us) > 0) {
+            continue;
+        }
+        double dp = vector3f_magnitude(vector3f_subtract(rep->pos, ref->pos));
+        double dv = vector3f_magnitude(vector3f_subtract(rep->vel, ref->vel));
+        double da = replay_att_error_deg(ref->q, rep->q);
+        pos_sq += dp * dp;
+        vel_sq += dv * dv;
+        att_sq += da * da;
+        // NEES = e^T (P_rep + P_ref)^-1 e (공분산 대각만 사용, 위치/속도 6차원)
+        const float err[6] = { rep->pos.x - ref->pos.x, rep->pos.y - ref->pos.y, rep->pos.z - ref->pos.z,
+                               rep->vel.x - ref->vel.x, rep->vel.y - ref->vel.y, rep->vel.z - ref->vel.z };
+        const float var[6] = { rep->pos_var.x, rep->pos_var.y, rep->pos_var.z,
+                               rep->vel_var.x, rep->vel_var.y, rep->vel_var.z };
+        const float ref_var[6] = { ref->pos_var.x, ref->pos_var.y, ref->pos_var.z,
+                                   ref->vel_var.x, ref->vel_var.y, ref->vel_var.z };
+        if (var[0] > 0.0f && var[1] > 0.0f && var[2] > 0.0f && var[3] > 0.0f && var[4] > 0.0f && var[5] > 0.0f) {
+            double nees = 0.0;
+            for (int k = 0; k < 6; k++) {
+                nees += (double)err[k] * err[k] / ((double)var[k] + ref_var[k]);
+            }
+            nees_sum += nees;
+            m->nees_points++;
+        }
+        if (dp > m->pos_max) {
+            m->pos_max = dp;
+            m->pos_max_t_us = ref->t_us;
+        }
+        m->points++;
+    }
+    if (m->points == 0) {
+        return false;
+    }
+    m->pos_rms = sqrt(pos_sq / (double)m->points);
+    m->vel_rms = sqrt(vel_sq / (double)m->points);
+    m->att_rms_deg = sqrt(att_sq / (double)m->points);
+    m->nees_mean = m->nees_points ? nees_sum / (double)m->nees_points : 0.0;
+    for (int k = 0; k < EKF_SENSOR_COUNT; k++) {
+        m->nis_mean[k] = ekf_get_innovation_nis_mean(&r->ekf, (EKF_Sensor)k, NULL);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 한 시각의 자세 오차
+ */
+bool replay_attitude_error_at(const Replay *r, uint32_t t_us, double *deg) {
+    const ReplayPoint *ref = NULL;
+    for (size_t i = 0; i < r->reference.count && (int32_t)(r->reference.points[i].t_us - t_us) <= 0; i++) {
+        ref = &r->reference.points[i];
+    }
+    if (ref == NULL) {
+        return false;
+    }
+    const ReplayPoint *rep = NULL;
+    for (size_t i = 0; i < r->replay.count && (int32_t)(r->replay.points[i].t_us - ref->t_us) <= 0; i++) {
+        rep = &r->replay.points[i];
+    }
+    if (rep == NULL) {
+        return false;
+    }
+
+    *deg = replay_att_error_deg(ref->q, rep->q);
+    return true;
+}
+
+/**
+ * @brief 레코드 열에 바이트 공간 확보
+ */
+static uint8_t *replay_tape_reserve(ReplayTape *tape, size_t n) {
+    if (tape->size + n > tape->capacity) {
+        size_t capacity = tape->capacity ? tape->capacity : 65536;
+        while (capacity < tape->size + n) {
+            capacity *= 2;
+        }
+        uint8_t *data = realloc(tape->data, capacity);
+        if (data == NULL) {
+            return NULL;
+        }
+        tape->data = data;
+        tape->capacity = capacity;
+    }
+    uint8_t *p = &tape->data[tape->size];
+    tape->size += n;
+    return p;
+}
+
+/**
+ * @brief 레코드 열에 레코드 추가
+ */
+bool replay_tape_append(ReplayTape *tape, uint8_t type, const void *payload, uint8_t len) {
+    uint8_t *p = replay_tape_reserve(tape, 2u + len);
+    if (p == NULL) {
+        return false;
+    }
+    p[0] = type;
+    p[1] = len;
+    memcpy(&p[2], payload, len);
+    tape->records++;
+
+    return true;
+}
+
+/**
+ * @brief 레코드 열에 블록 경계 표시 추가
+ */
+bool replay_tape_begin_block(ReplayTape *tape) {
+    uint8_t *p = replay_tape_reserve(tape, 2u);
+    if (p == NULL) {
+        return false;
+    }
+    p[0] = FLASH_LOG_END_TYPE;
+    p[1] = 0;
+
+    return true;
+}
+
+/**
+ * @brief 레코드 열에 블록 레코드 추가
+ */
+bool replay_tape_add_block(ReplayTape *tape, const uint8_t *block) {
+    uint32_t used = block[FLASH_LOG_HEADER_USED] | ((uint32_t)block[FLASH_LOG_HEADER_USED + 1] << 8);
+    if (!replay_tape_begin_block(tape)) {
+        return false;
+    }
+    uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE;
+    while (o + 2 <= used && block[o] != FLASH_LOG_END_TYPE) {
+        uint8_t len = block[o + 1];
+        if (o + 2 + len > used) {
+            break;
+        }
+        if (!replay_tape_append(tape, block[o], &block[o + 2], len)) {
+            return false;
+        }
+        o += 2u + len;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 레코드 열 재생
+ */
+void replay_tape_play(Replay *r, const ReplayTape *tape) {
+    size_t o = 0;
+    while (o + 2 <= tape->size) {
+        uint8_t type = tape->data[o];
+        uint8_t len = tape->data[o + 1];
+        if (type == FLASH_LOG_END_TYPE) {
+            replay_begin_block(r);
+        } else {
+            replay_record(r, type, &tape->data[o + 2], len);
+        }
+        o += 2u + len;
+    }
+}
+
+/**
+ * @brief 레코드 열 메모리 해제
+ */
+void replay_tape_free(ReplayTape *tape) {
+    free(tape->data);
+    *tape = (ReplayTape){ 0 };
+}
+
+/**
+ * @brief 궤적 메모리 해제
+ */
+void replay_free(Replay *r) {
+    free(r->reference.points);
+    free(r->replay.points);
+    r->reference = (ReplayTrack){ 0 };
+    r->replay = (ReplayTrack){ 0 };
+}
@@ -0,0 +1,370 @@
+/**
+ * @file replay.h
+ * @brief 비행 기록 레코드 → 융합 스케줄러 재생 (호스트용, log_replay와 monte_carlo 공용)
+ *
+ * flash_log 레코드(종류, 페이로드)를 기록 순서대로 받아 펌웨어와 같은 경로로
+ * 융합 스케줄러에 넣는다. IMU 샘플은 ImuRing에, 기압/자력계/GNSS는 스케줄러 대기열에
+ * 넣고 IMU batch개마다 한 사이클을 돌린다 (1 kHz IMU, batch 10이면 100 Hz 융합 태스크).
+ *
+ * 입력 레코드:
+ * - IMU: 원시 레코드(FLASH_LOG_REC_IMU) 또는 압축 스트림 "imu"
+ * - 기압: 원시 레코드, baro_altitude로 지상 기준 고도 변환 (처음 200 샘플로 캡처)
+ * - 자기장: 원시 레코드 (uT), 가우스로 바꿔 자력계 갱신 (ekf earth_mag_ned 단위)
+ * - GNSS: 원시 레코드, 첫 3D 측위를 원점으로 geodetic 변환 (필터 z축은 위 방향)
+ * - 항법 해: 원시 레코드 또는 압축 스트림 "nav"는 기준 궤적으로만 쓴다
+ *
+ * 필터는 첫 IMU 샘플의 비력 방향으로 수평 자세(요 0)를 잡아 시작한다. 처음 align_samples개의
+ * 자력계 샘플은 융합하지 않고 직전 가속도와 함께 모아 TRIAD 정렬(ekf_align_coarse)로 자세와
+ * 자세 공분산을 다시 정한 뒤(ekf_apply_alignment) 자기장 융합을 시작한다. 방위 오차가 큰
+ * 자세에서 작은 R_mag로 갱신하면 선형화가 틀린 자세로 수렴하기 때문이다 (발사대 기울기가
+ * 크면 특히).
+ * static_detect를 켜면 발사대에서 정지 검출기를 스케줄러에 연결해 전체 예측과 영속도(ZUPT),
+ * 정지 창마다 영각속도(ZARU) 갱신을 한다. 발사대에서 자력계만으로는 자기장 축 둘레 회전과
+ * 그 축의 자이로 바이어스를 볼 수 없어, 작은 R_mag에서는 바이어스가 그쪽으로 흘러 자세가 돈다.
+ * backup 설정을 켜면 같은 IMU/기압 입력으로 Q31 예비 필터(ekf_q31)를 함께 돌려,
+ * 게시된 부동소수점 해와 기울기/고도/수직 속도 차를 누적한다.
+ * 스케줄러 시계는 재생 중 0을 돌려주므로 예산 초과에 의한 자력계 지연이 생기지 않고
+ * 결과는 호스트 속도와 관계없이 같다. 처리 시간은 별도로 잰다.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "ekf/ekf.h"
+#include "ekf/ekf_align.h"
+#include "ekf/ekf_delay.h"
+#include "ekf/ekf_q31.h"
+#include "log/log_format.h"
+#include "nav/flight_phase.h"
+#include "nav/fusion_scheduler.h"
+#include "nav/geodetic.h"
+#include "nav/nav_publisher.h"
+#include "sensors/baro_altitude.h"
+#include "sensors/imu_ring.h"
+#include "sensors/static_detector.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief 기본 설정
+ */
+#define REPLAY_DEFAULT_BATCH 10u         /**< 사이클당 IMU 샘플 수 */
+#define REPLAY_DEFAULT_DECIMATION 10u    /**< 궤적 출력 간격 (게시 횟수) */
+#define REPLAY_DEFAULT_ALIGN_SAMPLES 100u /**< 발사대 정렬에 모을 자력계 샘플 수 (100 Hz에서 1 s) */
+#define REPLAY_GNSS_MIN_FIX 3u           /**< 사용할 최소 측위 종류 (3D) */
+#define REPLAY_BACKUP_GRAVITY_DECIMATION 10u /**< 예비 필터 비력 방향 갱신 간격 (IMU 샘플) */
+
+/**
+ * @brief 스트림 복원 상태 (블록마다 스키마부터 다시 채움)
+ */
+typedef struct {
+    bool valid;
+    bool primed;
+    uint8_t field_count;
+    char name[LOG_CODEC_NAME_SIZE + 1];
+    float scale[LOG_CODEC_MAX_FIELDS];
+    int32_t q[LOG_CODEC_MAX_FIELDS];
+    uint32_t t;
+    uint32_t dt;
+} ReplayStream;
+
+/**
+ * @brief 궤적 점 (기준/재생 비교용)
+ */
+typedef struct {
+    uint32_t t_us;
+    Vector3f pos;
+    Vector3f vel;
+    Quaternion q;
+    Vector3f pos_var;          /**< 위치 분산 (m^2, 위치 블록 제외 시 0, 기준 궤적은 0이고 호출자가 채울 수 있음) */
+    Vector3f vel_var;          /**< 속도 분산 ((m/s)^2, NEES에는 재생과 기준 분산의 합을 씀) */
+} ReplayPoint;
+
+/**
+ * @brief 궤적 (가변 길이 배열)
+ */
+typedef struct {
+    ReplayPoint *points;
+    size_t count;
+    size_t capacity;
+} ReplayTrack;
+
+/**
+ * @brief 필터 잡음 설정 (nav/filter_engine.h FilterEngineConfig와 같은 규칙)
+ *
+ * pos_std가 0 이하이면 프로세스 노이즈 다섯 개, gps_pos_std가 0 이하이면 GPS 노이즈 두 개,
+ * 그 밖의 값은 각각 0 이하이면 펌웨어 기본값(ekf_init)을 쓴다.
+ */
+typedef struct {
+    float pos_std;             /**< 위치 프로세스 노이즈 (m) */
+    float vel_std;             /**< 속도 프로세스 노이즈 (m/s) */
+    float att_std;             /**< 자세 프로세스 노이즈 (rad) */
+    float gyro_bias_std;       /**< 자이로 바이어스 프로세스 노이즈 (rad/s) */
+    float accel_bias_std;      /**< 가속도 바이어스 프로세스 노이즈 (m/s^2) */
+    float gps_pos_std;         /**< GPS 위치 측정 노이즈 (m) */
+    float gps_vel_std;         /**< GPS 속도 측정 노이즈 (m/s) */
+    float baro_std;            /**< 기압 고도 측정 노이즈 (m) */
+    float mag_std;             /**< 자력계 측정 노이즈 (G, 재생 입력 단위) */
+} ReplayNoise;
+
+/**
+ * @brief 재생 설정
+ */
+typedef struct {
+    bool use_phase;                    /**< 비행 단계 상태 기계 사용 (false면 처음부터 전체 주기) */
+    uint32_t batch;                    /**< 사이클당 IMU 샘플 수 */
+    uint32_t decimation;               /**< 궤적 CSV 출력 간격 (게시 횟수) */
+    EKF_Engine engine;                 /**< 공분산 엔진 */
+    EKF_UpdateMode update_mode;        /**< 측정 갱신 방식 */
+    EKF_CovarianceUpdate covariance_update; /**< 공분산 갱신 방식 */
+    bool backup;                       /**< Q31 예비 필터를 함께 돌려 부동소수점 해와 비교 */
+    ReplayNoise noise;                 /**< 필터 잡음 (기본: 모두 0, 펌웨어 기본값) */
+    uint32_t align_samples;            /**< 발사대 정렬 자력계 샘플 수 (0이면 정렬 없이 방위 0에서 시작) */
+    bool static_detect;                /**< 발사대 정지 검출 (영속도/영각속도 갱신, 비행 단계 사용 시) */
+} ReplayConfig;
+
+/**
+ * @brief 메모리 안 레코드 열 (한 번 읽은 기록이나 합성 비행을 여러 번 재생)
+ *
+ * 레코드를 (종류, 길이, 페이로드) 그대로 이어 담는다. 블록 경계는 길이 0인 FLASH_LOG_END_TYPE
+ * 표시로 남겨 재생 때 압축 스트림 상태를 블록마다 다시 시작한다. 재생은 읽기만 하므로
+ * 여러 재생기가 같은 열을 동시에 재생해도 된다.
+ */
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    uint32_t records;          /**< 담은 레코드 수 (블록 경계 제외) */
+} ReplayTape;
+
+/**
+ * @brief 기준 궤적 대비 오차
+ */
+typedef struct {
+    size_t points;             /**< 비교한 점 수 */
+    double pos_rms;            /**< 위치 RMS (m) */
+    double pos_max;            /**< 위치 최대 (m) */
+    uint32_t pos_max_t_us;     /**< 위치 최대 시각 (us) */
+    double vel_rms;            /**< 속도 RMS (m/s) */
+    double att_rms_deg;        /**< 자세 각 오차 RMS (도) */
+    double apogee_ref;         /**< 기준 최고 고도 (m, pos.z 최대) */
+    double apogee_replay;      /**< 재생 최고 고도 (m) */
+    double nees_mean;          /**< 위치/속도 평균 NEES (공분산 대각만 사용, 일관되면 약 6) */
+    size_t nees_points;        /**< NEES에 쓴 점 수 (분산이 양수인 점) */
+    float nis_mean[EKF_SENSOR_COUNT]; /**< 측정별 평균 NIS (기록 없으면 0) */
+
+    size_t backup_points;      /**< 예비 필터와 비교한 게시 해 수 (backup 설정 시) */
+    double backup_tilt_rms_deg; /**< 기울기(몸체 z축 방향) 차 RMS (도) */
+    double backup_tilt_max_deg; /**< 기울기 차 최대 (도) */
+    double backup_att_rms_deg; /**< 자세 각 차 RMS (도, 방위 포함) */
+    double backup_alt_rms;     /**< 고도 차 RMS (m) */
+    double backup_alt_max;     /**< 고도 차 최대 (m) */
+    double backup_vel_rms;     /**< 수직 속도 차 RMS (m/s) */
+    double backup_us_per_sample; /**< 예비 필터 IMU 샘플당 처리 시간 (us, 갱신 포함) */
+} ReplayMetrics;
+
+/**
+ * @brief Q31 예비 필터 재생 상태
+ */
+typedef struct {
+    EKF_Q31 filter;
+    bool ready;                /**< 초기 자세를 정했는지 */
+    uint32_t last_us;          /**< 마지막 IMU 샘플 시각 */
+    uint32_t samples;          /**< 처리한 IMU 샘플 수 */
+    uint64_t ns;               /**< 예비 필터 처리 누적 시간 (ns) */
+    size_t points;             /**< 비교한 게시 해 수 */
+    double tilt_sq;            /**< 기울기 차 제곱 합 (도^2) */
+    double tilt_max;           /**< 기울기 차 최대 (도) */
+    double att_sq;             /**< 자세 각 차 제곱 합 (도^2) */
+    double alt_sq;             /**< 고도 차 제곱 합 (m^2) */
+    double alt_max;            /**< 고도 차 최대 (m) */
+    double vel_sq;             /**< 수직 속도 차 제곱 합 ((m/s)^2) */
+} ReplayBackup;
+
+/**
+ * @brief 재생 상태
+ */
+typedef struct {
+    EKF ekf;
+    ScratchArena scratch;      /**< 필터 전용 작업 영역 (재생기끼리 공유하지 않음) */
+    uint8_t scratch_buffer[EKF_SCRATCH_SIZE] __attribute__((aligned(8)));
+    EKF_DelayBuffer history;
+    ImuRing ring;
+    NavPublisher publisher;
+    FlightPhaseMachine phase;
+    FusionScheduler sched;
+    StaticDetector detector;   /**< 발사대 정지 검출기 (static_detect일 때 스케줄러에 연결) */
+    BaroAltitude baro;
+    GeodeticFrame geo;
+    ReplayConfig config;
+    ReplayStream streams[256];
+    bool filter_ready;         /**< 첫 IMU 샘플로 초기 자세를 정했는지 */
+    bool aligned;              /**< 발사대 정렬을 마쳤는지 (그 전의 자기장은 정렬에만 씀) */
+    EKF_MagFieldEstimator align; /**< 정렬용 자력계/가속도 평균 */
+    Vector3f last_accel;       /**< 마지막 IMU 가속도 (자력계 샘플과 짝) */
+    EKF_Alignment alignment;   /**< 적용한 정렬 결과 (aligned이고 ok일 때) */
+    bool alignment_ok;         /**< 정렬을 필터에 적용했는지 (실패하면 방위 0 그대로 자기장 융합) */
+    bool geo_ready;            /**< GNSS 원점을 정했는지 */
+
+    uint32_t pending;          /**< 이번 사이클에 넣은 IMU 샘플 수 */
+    uint32_t last_seq;         /**< 마지막으로 읽은 게시 순번 */
+    uint32_t published;        /**< 읽은 게시 수 */
+    FILE *out;                 /**< 궤적 CSV (NULL이면 쓰지 않음) */
+
+    uint32_t first_us;         /**< 첫 IMU 샘플 시각 */
+    uint32_t last_us;          /**< 마지막 IMU 샘플 시각 */
+    bool have_time;
+
+    uint32_t imu_samples;
+    uint32_t baro_samples;
+    uint32_t mag_samples;
+    uint32_t gnss_samples;
+    uint32_t push_failures;    /**< 사이클을 돌린 뒤에도 대기열에 못 넣은 측정 수 */
+    uint64_t fusion_ns;        /**< 스케줄러 처리 누적 시간 (ns) */
+
+    ReplayTrack reference;     /**< 기록된 항법 해 */
+    ReplayTrack replay;        /**< 재생 항법 해 */
+    ReplayBackup backup;       /**< Q31 예비 필터 (backup 설정 시) */
+} Replay;
+
+/**
+ * @brief 기본 설정 (비행 단계 사용, batch 10, 펌웨어 기본 필터 설정)
+ *
+ * @param config 설정 구조체 포인터
+ */
+void replay_default_config(ReplayConfig *config);
+
+/**
+ * @brief 잡음 설정을 필터에 적용
+ *
+ * @param ekf 필터 (ekf_init 이후)
+ * @param noise 잡음 설정
+ * @return bool 성공 여부
+ */
+bool replay_apply_noise(EKF *ekf, const ReplayNoise *noise);
+
+/**
+ * @brief 재생 상태 초기화
+ *
+ * @param r 재생 상태
+ * @param config 설정 (NULL이면 기본 설정)
+ * @param out 궤적 CSV 출력 (NULL이면 쓰지 않음, 머리행은 이 함수에서 씀)
+ * @return bool 성공 여부
+ */
+bool replay_init(Replay *r, const ReplayConfig *config, FILE *out);
+
+/**
+ * @brief 새 블록 시작 (압축 스트림 상태 초기화)
+ *
+ * @param r 재생 상태
+ */
+void replay_begin_block(Replay *r);
+
+/**
+ * @brief 레코드 하나 처리
+ *
+ * @param r 재생 상태
+ * @param type 레코드 종류
+ * @param payload 페이로드
+ * @param len 페이로드 길이
+ */
+void replay_record(Replay *r, uint8_t type, const uint8_t *payload, uint8_t len);
+
+/**
+ * @brief 블록 헤더와 CRC 확인
+ *
+ * @param block 블록 (FLASH_LOG_BLOCK_SIZE 바이트)
+ * @param session 블록 세션 번호 (NULL 가능)
+ * @return bool 유효한 블록이면 true
+ */
+bool replay_block_valid(const uint8_t *block, uint32_t *session);
+
+/**
+ * @brief 블록 레코드 처리 (replay_block_valid로 확인한 블록)
+ *
+ * @param r 재생 상태
+ * @param block 블록 (FLASH_LOG_BLOCK_SIZE 바이트)
+ */
+void replay_block(Replay *r, const uint8_t *block);
+
+/**
+ * @brief 남은 IMU 샘플 처리
+ *
+ * @param r 재생 상태
+ */
+void replay_finish(Replay *r);
+
+/**
+ * @brief 기준 궤적 대비 오차 (기준 시각 이전의 가장 가까운 재생 해와 비교)
+ *
+ * 예비 필터 비교 값(backup_*)은 기준 궤적과 관계없이 채운다.
+ *
+ * @param r 재생 상태
+ * @param m 결과
+ * @return bool 비교한 점이 있으면 true
+ */
+bool replay_metrics(const Replay *r, ReplayMetrics *m);
+
+/**
+ * @brief 한 시각의 자세 오차 (그 시각 이전 마지막 기준 점과 그 이전 마지막 재생 해)
+ *
+ * @param r 재생 상태 (replay_finish 뒤)
+ * @param t_us 시각 (us)
+ * @param deg 자세 각 오차 (도)
+ * @return bool 두 궤적 모두 그 시각 이전 점이 있으면 true
+ */
+bool replay_attitude_error_at(const Replay *r, uint32_t t_us, double *deg);
+
+/**
+ * @brief 레코드 열에 레코드 추가
+ *
+ * @param tape 레코드 열 (처음에는 0으로 채워 둠)
+ * @param type 레코드 종류
+ * @param payload 페이로드
+ * @param len 페이로드 길이
+ * @return bool 성공 여부 (메모리 부족이면 false)
+ */
+bool replay_tape_append(ReplayTape *tape, uint8_t type, const void *payload, uint8_t len);
+
+/**
+ * @brief 레코드 열에 블록 경계 표시 추가
+ *
+ * @param tape 레코드 열
+ * @return bool 성공 여부
+ */
+bool replay_tape_begin_block(ReplayTape *tape);
+
+/**
+ * @brief 레코드 열에 블록 레코드 추가 (replay_block_valid로 확인한 블록)
+ *
+ * @param tape 레코드 열
+ * @param block 블록 (FLASH_LOG_BLOCK_SIZE 바이트)
+ * @return bool 성공 여부
+ */
+bool replay_tape_add_block(ReplayTape *tape, const uint8_t *block);
+
+/**
+ * @brief 레코드 열 재생 (끝난 뒤 replay_finish는 부르는 쪽에서)
+ *
+ * @param r 재생 상태
+ * @param tape 레코드 열
+ */
+void replay_tape_play(Replay *r, const ReplayTape *tape);
+
+/**
+ * @brief 레코드 열 메모리 해제
+ *
+ * @param tape 레코드 열
+ */
+void replay_tape_free(ReplayTape *tape);
+
+/**
+ * @brief 궤적 메모리 해제
+ *
+ * @param r 재생 상태
+ */
+void replay_free(Replay *r);
+
+#endif /* REPLAY_H */
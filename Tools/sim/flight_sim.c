@@ -0,0 +1,143 @@
+/**
+ * @file flight_sim.c
+ * @brief 합성 비행 기록 생성 프로그램 (호스트용)
+ *
+ * sim_model의 궤적과 센서 레코드를 flash_log와 같은 4 KB 블록(헤더, CRC-32, 0xFF 채움)으로
+ * 파일에 쓴다. 결과 파일은 NOR 덤프나 SD 기록 파일과 같은 형식이므로 log_decode와
+ * log_replay로 그대로 읽힌다. 참값은 항법 해 레코드로 함께 기록되어 log_replay가
+ * 기준 궤적으로 비교한다.
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o flight_sim Tools/sim/flight_sim.c Tools/sim/sim_model.c \
+ *       Core/Src/ekf/ekf_wmm.c Core/Src/ekf/ekf_wmm_table.c $(find Core/Src/math -name '*.c') -lm
+ *
+ * 실행:
+ *   ./flight_sim [-s 시드] [-t 길이(s)] [-k 잡음 배율] [-S 세션] -o flight.bin
+ */
+
+#include "sim_model.h"
+#include "log/log_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief 블록 기록 상태
+ */
+typedef struct {
+    FILE *out;
+    uint8_t block[FLASH_LOG_BLOCK_SIZE];
+    uint32_t fill;
+    uint32_t seq;
+    uint16_t session;
+    bool error;
+} BlockWriter;
+
+static void wr32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief 채운 블록 봉인 (헤더와 CRC 작성 후 파일에 씀)
+ */
+static void writer_seal(BlockWriter *w) {
+    if (w->fill <= FLASH_LOG_BLOCK_HEADER_SIZE) {
+        return;
+    }
+    memset(&w->block[w->fill], 0xFF, FLASH_LOG_BLOCK_SIZE - w->fill);
+    wr32(&w->block[FLASH_LOG_HEADER_MAGIC], FLASH_LOG_MAGIC);
+    wr32(&w->block[FLASH_LOG_HEADER_SEQ], w->seq);
+    w->block[FLASH_LOG_HEADER_SESSION] = (uint8_t)w->session;
+    w->block[FLASH_LOG_HEADER_SESSION + 1] = (uint8_t)(w->session >> 8);
+    w->block[FLASH_LOG_HEADER_USED] = (uint8_t)w->fill;
+    w->block[FLASH_LOG_HEADER_USED + 1] = (uint8_t)(w->fill >> 8);
+    wr32(&w->block[FLASH_LOG_HEADER_CRC],
+         log_format_crc32(&w->block[FLASH_LOG_CRC_OFFSET], FLASH_LOG_BLOCK_SIZE - FLASH_LOG_CRC_OFFSET));
+    if (fwrite(w->block, 1, FLASH_LOG_BLOCK_SIZE, w->out) != FLASH_LOG_BLOCK_SIZE) {
+        w->error = true;
+    }
+    w->seq++;
+    w->fill = FLASH_LOG_BLOCK_HEADER_SIZE;
+}
+
+/**
+ * @brief 레코드 추가 (flash_log_write와 같이 남은 공간이 모자라면 블록을 봉인)
+ */
+static void writer_emit(uint8_t type, const void *payload, uint8_t len, void *context) {
+    BlockWriter *w = context;
+    if (w->fill + 2u + len > FLASH_LOG_BLOCK_SIZE) {
+        writer_seal(w);
+    }
+    w->block[w->fill] = type;
+    w->block[w->fill + 1] = len;
+    memcpy(&w->block[w->fill + 2], payload, len);
+    w->fill += 2u + len;
+}
+
+int main(int argc, char **argv) {
+    SimConfig config;
+    sim_default_config(&config);
+    uint64_t seed = 1;
+    float noise_scale = 1.0f;
+    const char *out_path = NULL;
+    static BlockWriter w;
+    w.session = 1;
+    w.fill = FLASH_LOG_BLOCK_HEADER_SIZE;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:t:k:S:o:")) != -1) {
+        switch (opt) {
+        case 's':
+            seed = strtoull(optarg, NULL, 0);
+            break;
+        case 't':
+            config.duration = strtod(optarg, NULL);
+            break;
+        case 'k':
+            noise_scale = strtof(optarg, NULL);
+            break;
+        case 'S':
+            w.session = (uint16_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            out_path = NULL;
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (out_path == NULL || optind != argc) {
+        fprintf(stderr, "사용법: %s [-s 시드] [-t 길이(s)] [-k 잡음 배율] [-S 세션] -o flight.bin\n", argv[0]);
+        return 1;
+    }
+    sim_scale_noise(&config, noise_scale);
+
+    w.out = fopen(out_path, "wb");
+    if (w.out == NULL) {
+        perror(out_path);
+        return 1;
+    }
+    SimSummary summary;
+    bool ok = sim_run(&config, seed, writer_emit, &w, &summary);
+    writer_seal(&w);
+    if (fclose(w.out) != 0) {
+        w.error = true;
+    }
+    if (!ok || w.error) {
+        fprintf(stderr, "%s\n", ok ? "파일 쓰기 실패" : "잘못된 설정");
+        return 1;
+    }
+
+    fprintf(stderr, "시드 %llu: 레코드 %u개, 블록 %u개\n", (unsigned long long)seed, summary.records, w.seq);
+    fprintf(stderr, "최고 고도 %.1f m (점화 후 %.2f s), 최대 속력 %.1f m/s, 착지 %.1f s\n",
+            summary.apogee, summary.apogee_time, summary.max_speed, summary.landing_time);
+
+    return 0;
+}
@@ -0,0 +1,542 @@
+/**
+ * @file monte_carlo.c
+ * @brief 합성 비행 몬테카를로 실행기 (호스트용)
+ *
+ * 시드마다 sim_model로 궤적과 센서 레코드를 만들어 파일을 거치지 않고 곧바로
+ * replay_record에 넣고, 재생 항법 해를 참값과 비교한다. 필터 설정(엔진, 갱신 방식,
+ * 공분산 갱신, 사이클당 IMU 샘플 수, 비행 단계 사용)을 옵션으로 바꿔 성능 최적화가
+ * 정확도에 주는 영향을 같은 시드 집합에서 비교할 수 있다.
+ *
+ * 필터 측정 잡음(R)과 프로세스 잡음(Q)은 sim 센서 모델에서 구해 넣는다 (mc_noise_from_sim, -k 배율 반영).
+ * 펌웨어 기본 R은 주입 잡음보다 훨씬 커서(자력계 0.1 G^2 대 (0.003 G)^2) 자력계 NIS가 0에 가깝고
+ * 필터가 자력계를 거의 쓰지 않으므로 자세/방위 문제가 가려진다. R만 맞추고 기본 Q를 두면 자이로
+ * 바이어스가 자력계 잔차를 따라 흘러 발산하므로 둘을 같이 맞춘다. -D는 비교용으로 펌웨어 기본 R/Q를 쓴다.
+ * 시드마다 점화 시각의 자세 오차(발사대 정렬)도 내고, 위치/속도 NEES나 측정별 평균 NIS가 차원의 1/2..2배를 벗어나거나
+ * 발사대 자세 오차 중앙값이 MC_PAD_ATT_WARN_DEG를 넘으면 표준 오류에 경고한다.
+ *
+ * 작업자 스레드마다 재생기(필터, 스케줄러, 전용 scratch 영역)를 하나씩 힙에 두고
+ * 공유 카운터에서 다음 시드 순번을 가져가 실행한다. 작업자 사이에 공유하는 가변 상태는
+ * 이 카운터와 각 시드의 결과 칸뿐이므로, 결과는 시드 순서로 출력되어 작업자 수와
+ * 관계없이 같다 (처리 시간 열 제외). -T는 같은 시드를 작업자 1개와 -j개로 두 번 돌려
+ * 결과가 비트 단위로 같은지 확인한다 (필터 코드의 재진입성 점검).
+ *
+ * 출력:
+ * - 표준 출력 CSV: seed,pos_rms,pos_max,vel_rms,att_rms_deg,apogee_err,nees,nis_baro,nis_mag,nis_gnss,
+ *   pad_att_deg,us_per_sample,update_failures,gate_recoveries
+ * - 표준 오류: 사용한 R, 지표별 평균/중앙값/95 백분위/최대, 일관성 경고, 처리 시간과 초당 시드 수
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -pthread -ICore/Inc -ITools/replay -o monte_carlo Tools/sim/monte_carlo.c \
+ *       Tools/sim/sim_model.c Tools/replay/replay.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c \
+ *       Core/Src/nav/fusion_scheduler.c Core/Src/nav/fusion_monitor.c Core/Src/nav/flight_phase.c \
+ *       Core/Src/nav/event_detector.c Core/Src/nav/nav_publisher.c Core/Src/nav/geodetic.c \
+ *       Core/Src/nav/convergence_monitor.c Core/Src/nav/filter_health.c Core/Src/nav/fixed_lag.c \
+ *       Core/Src/nav/latency_monitor.c Core/Src/nav/predict_rate.c Core/Src/nav/vertical_filter.c \
+ *       Core/Src/sensors/imu_ring.c Core/Src/sensors/baro_altitude.c Core/Src/sensors/baro_isa_table.c \
+ *       Core/Src/sensors/mag_iron_cal.c Core/Src/sensors/static_detector.c Core/Src/sensors/accel_blend.c \
+ *       Core/Src/sensors/gyro_spectrum.c Core/Src/sensors/gyro_notch.c Core/Src/sensors/imu_lever_arm.c \
+ *       Core/Src/sensors/meas_queue.c Core/Src/sensors/mag_average.c Core/Src/sensors/imu_vibration.c -lm
+ *
+ * 실행:
+ *   ./monte_carlo [-n 시드 수] [-f 첫 시드] [-j 작업자 수] [-k 잡음 배율] [-t 길이(s)]
+ *                 [-b batch] [-e cov|ud] [-u seq|batch] [-c joseph|standard] [-P] [-D] [-T] > runs.csv
+ *   -P: 비행 단계 상태 기계 없이 처음부터 전체 주기로 추정 (발사대 정지 갱신이 없어 sim 잡음의 Q로는
+ *       자기장 축 방향 자이로 바이어스가 잡히지 않아 자세가 흐른다, 비교용)
+ *   -D: 측정/프로세스 잡음을 sim 모델에서 구하지 않고 펌웨어 기본값(ekf_init) 사용
+ *   -T: 작업자 1개와 -j개 결과 일치 확인 (다르면 종료 코드 2)
+ */
+
+#include "sim_model.h"
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/**
+ * @brief 발사대 자세 오차 경고 기준 (도, 시드 중앙값)
+ */
+#define MC_PAD_ATT_WARN_DEG 2.0
+
+/**
+ * @brief sim 잡음으로 구한 Q에 함께 넣는 위치/속도 프로세스 노이즈 (펌웨어 기본값 sqrt(0.01)과 같음)
+ *
+ * F에 속도-자세 결합이 없어 자세 오차 x 비력과 GNSS 지연이 Q로만 들어가므로 가속도
+ * 백색 잡음(s / sqrt(f))보다 훨씬 크게 둔다.
+ */
+#define MC_POS_PROCESS_STD 0.1f    /**< m */
+#define MC_VEL_PROCESS_STD 0.1f    /**< m/s */
+
+/**
+ * @brief 기압 고도 환산 상수 (ISA 대류권)
+ */
+#define MC_ISA_T0 288.15           /**< 해면 온도 (K) */
+#define MC_ISA_P0 101325.0         /**< 해면 기압 (Pa) */
+#define MC_ISA_LAPSE 0.0065        /**< 기온 감률 (K/m) */
+#define MC_ISA_R 287.05287         /**< 건조 공기 기체 상수 (J/(kg K)) */
+#define MC_ISA_G 9.80665           /**< 표준 중력 (m/s^2) */
+
+/**
+ * @brief 시드 하나의 결과
+ */
+typedef struct {
+    bool ok;
+    double pos_rms;
+    double pos_max;
+    double vel_rms;
+    double att_rms_deg;
+    double apogee_err;         /**< 재생 - 참값 최고 고도 (m) */
+    double nees;               /**< 위치/속도 평균 NEES */
+    double nis_baro;           /**< 기압계 평균 NIS */
+    double nis_mag;            /**< 자력계 평균 NIS */
+    double nis_gnss;           /**< GNSS 위치/속도 평균 NIS */
+    double pad_att_deg;        /**< 점화 시각 자세 오차 (도, 발사대 정렬) */
+    double us_per_sample;      /**< IMU 샘플당 융합 처리 시간 (us) */
+    uint32_t update_failures;
+    uint32_t gate_recoveries;  /**< 게이트 연속 거부 뒤 강제 수용 수 (모든 측정) */
+} McResult;
+
+/**
+ * @brief 작업자 공유 작업 정보
+ */
+typedef struct {
+    const SimConfig *sim;
+    const ReplayConfig *config;
+    uint64_t first;
+    uint32_t count;
+    atomic_uint next;          /**< 다음에 실행할 시드 순번 */
+    McResult *res;
+} McJob;
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief sim 센서 모델의 잡음을 필터 측정/프로세스 잡음으로 환산
+ *
+ * 시드별 상수 바이어스는 원점/지상 기준 캡처가 흡수하므로 R에 넣지 않는다.
+ * - 기압: Pa → m (발사 고도의 ISA dh/dp = R T / (g p))
+ * - 자기장: uT → G (재생 입력 단위)
+ * - GNSS 위치: 세 축 RMS (수직은 수평의 1.5배)
+ *
+ * Q는 초당 분산이므로 자이로 샘플 잡음 s를 주기 f로 나눈 s^2 / f가 각도 랜덤 워크다
+ * (사원수 성분은 dq = q (0, w dt) / 2라서 각도의 절반). 바이어스는 sim의 랜덤 워크를 그대로 쓴다.
+ * 펌웨어 기본 Q(대각 0.01, 자이로 바이어스 0.1 rad/s/sqrt(s))로 R_mag만 맞추면 필터가 자력계
+ * 잔차를 바이어스로 돌려 자세가 발산한다. 위치/속도는 MC_POS/VEL_PROCESS_STD를 쓴다.
+ */
+static void mc_noise_from_sim(const SimConfig *sim, ReplayNoise *noise) {
+    double t = MC_ISA_T0 - MC_ISA_LAPSE * sim->height_m;
+    double p = MC_ISA_P0 * pow(t / MC_ISA_T0, MC_ISA_G / (MC_ISA_R * MC_ISA_LAPSE));
+
+    memset(noise, 0, sizeof(*noise));
+    noise->baro_std = (float)(sim->baro.std * MC_ISA_R * t / (MC_ISA_G * p));
+    noise->mag_std = sim->mag.std * 0.01f;
+    noise->gps_pos_std = sim->gnss_pos.std * sqrtf((2.0f + 1.5f * 1.5f) / 3.0f);
+    noise->gps_vel_std = sim->gnss_vel.std;
+
+    noise->pos_std = MC_POS_PROCESS_STD;
+    noise->vel_std = MC_VEL_PROCESS_STD;
+    noise->att_std = 0.5f * sim->gyro.std / sqrtf((float)sim->imu_hz);
+    noise->gyro_bias_std = sim->gyro.bias_walk;
+    noise->accel_bias_std = sim->accel.bias_walk;
+}
+
+/**
+ * @brief 시드 평균 NIS/NEES가 차원과 맞는지 (1/2..2배)
+ */
+static void mc_check_nis(const char *name, const McResult *res, uint32_t n, size_t offset, double dof) {
+    uint32_t count = 0;
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (res[i].ok) {
+            double x;
+            memcpy(&x, (const uint8_t *)&res[i] + offset, sizeof(x));
+            sum += x;
+            count++;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+    double mean = sum / count;
+    if (mean < 0.5 * dof || mean > 2.0 * dof) {
+        fprintf(stderr, "경고: %s 평균 %.3f (차원 %.0f), 필터 R/Q 또는 모델이 주입 잡음과 맞지 않음\n", name, mean,
+                dof);
+    }
+}
+
+/**
+ * @brief 생성 레코드를 재생기로 전달
+ */
+static void mc_emit(uint8_t type, const void *payload, uint8_t len, void *context) {
+    replay_record(context, type, payload, len);
+}
+
+/**
+ * @brief 시드 하나 실행
+ */
+static void mc_run_seed(Replay *r, const SimConfig *sim, const ReplayConfig *config, uint64_t seed, McResult *res) {
+    memset(res, 0, sizeof(*res));
+    if (!replay_init(r, config, NULL)) {
+        return;
+    }
+    replay_begin_block(r);
+    SimSummary summary;
+    bool ok = sim_run(sim, seed, mc_emit, r, &summary);
+    replay_finish(r);
+
+    // 재생 원점은 첫 측위라서 참값(발사대 원점)과 그 측위 잡음만큼 어긋난다 (필터 P에는 없음)
+    float h_var = sim->gnss_pos.std * sim->gnss_pos.std;
+    Vector3f origin_var = vector3f_create(h_var, h_var, 1.5f * 1.5f * h_var);
+    for (size_t i = 0; i < r->reference.count; i++) {
+        r->reference.points[i].pos_var = origin_var;
+    }
+
+    ReplayMetrics m;
+    if (ok && replay_metrics(r, &m)) {
+        res->ok = true;
+        res->pos_rms = m.pos_rms;
+        res->pos_max = m.pos_max;
+        res->vel_rms = m.vel_rms;
+        res->att_rms_deg = m.att_rms_deg;
+        res->apogee_err = m.apogee_replay - m.apogee_ref;
+        res->nees = m.nees_mean;
+        res->nis_baro = m.nis_mean[EKF_SENSOR_BARO];
+        res->nis_mag = m.nis_mean[EKF_SENSOR_MAG];
+        res->nis_gnss = m.nis_mean[EKF_SENSOR_GPS_POS_VEL];
+        if (!replay_attitude_error_at(r, summary.ignition_us, &res->pad_att_deg)) {
+            res->pad_att_deg = NAN;
+        }
+        res->us_per_sample = r->imu_samples ? (double)r->fusion_ns * 1e-3 / r->imu_samples : 0.0;
+        res->update_failures = fusion_scheduler_get_stats(&r->sched)->update_failures;
+        res->gate_recoveries = 0;
+        for (uint8_t s = 0; s < EKF_SENSOR_COUNT; s++) {
+            res->gate_recoveries += ekf_get_innovation_recover_count(&r->ekf, (EKF_Sensor)s);
+        }
+    }
+    replay_free(r);
+}
+
+/**
+ * @brief 작업자 스레드 (재생기 하나를 힙에 두고 시드를 차례로 가져감)
+ */
+static void *mc_worker(void *arg) {
+    McJob *job = arg;
+    Replay *r = malloc(sizeof(Replay));
+    if (r == NULL) {
+        return NULL;
+    }
+    for (;;) {
+        uint32_t i = atomic_fetch_add(&job->next, 1u);
+        if (i >= job->count) {
+            break;
+        }
+        mc_run_seed(r, job->sim, job->config, job->first + i, &job->res[i]);
+    }
+    free(r);
+    return job;
+}
+
+/**
+ * @brief 작업자 jobs개로 시드 전체 실행
+ *
+ * @return bool 모든 작업자가 재생기를 할당했으면 true
+ */
+static bool mc_run_pool(const SimConfig *sim, const ReplayConfig *config, uint64_t first, uint32_t count,
+                        uint32_t jobs, McResult *res) {
+    McJob job = { sim, config, first, count, 0, res };
+    pthread_t *threads = malloc(jobs * sizeof(pthread_t));
+    if (threads == NULL) {
+        return false;
+    }
+    bool ok = true;
+    uint32_t started = 0;
+    for (; started < jobs; started++) {
+        if (pthread_create(&threads[started], NULL, mc_worker, &job) != 0) {
+            ok = started > 0;
+            break;
+        }
+    }
+    for (uint32_t w = 0; w < started; w++) {
+        void *ret;
+        pthread_join(threads[w], &ret);
+        ok &= ret != NULL;
+    }
+    free(threads);
+    return ok;
+}
+
+/**
+ * @brief 두 실행의 정확도 지표 비교 (처리 시간 제외, 비트 단위)
+ *
+ * @return uint32_t 결과가 다른 시드 수
+ */
+static uint32_t mc_compare(const McResult *a, const McResult *b, uint32_t count, uint64_t first) {
+    uint32_t mismatch = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const size_t begin = offsetof(McResult, pos_rms);
+        const size_t end = offsetof(McResult, pad_att_deg) + sizeof(double);
+        if (a[i].ok != b[i].ok || a[i].update_failures != b[i].update_failures ||
+            a[i].gate_recoveries != b[i].gate_recoveries ||
+            memcmp((const uint8_t *)&a[i] + begin, (const uint8_t *)&b[i] + begin, end - begin) != 0) {
+            fprintf(stderr, "시드 %llu: 작업자 수에 따라 결과가 다름\n", (unsigned long long)(first + i));
+            mismatch++;
+        }
+    }
+    return mismatch;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 지표 하나의 분포 요약
+ */
+static void mc_print_stat(const char *name, const McResult *res, uint32_t n, size_t offset, bool absolute) {
+    double *v = malloc(n * sizeof(double));
+    if (v == NULL) {
+        return;
+    }
+    uint32_t count = 0;
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (!res[i].ok) {
+            continue;
+        }
+        double x;
+        memcpy(&x, (const uint8_t *)&res[i] + offset, sizeof(x));
+        if (!isfinite(x)) {
+            continue;
+        }
+        if (absolute) {
+            x = fabs(x);
+        }
+        v[count++] = x;
+        sum += x;
+    }
+    if (count > 0) {
+        qsort(v, count, sizeof(double), cmp_double);
+        fprintf(stderr, "%-16s 평균 %9.3f  중앙값 %9.3f  p95 %9.3f  최대 %9.3f\n", name, sum / count,
+                v[count / 2], v[(uint32_t)(0.95 * (count - 1))], v[count - 1]);
+    }
+    free(v);
+}
+
+/**
+ * @brief 발사대 정렬 확인 (점화 시각 자세 오차 중앙값)
+ */
+static void mc_check_pad(const McResult *res, uint32_t n) {
+    double *v = malloc(n * sizeof(double));
+    if (v == NULL) {
+        return;
+    }
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (res[i].ok && isfinite(res[i].pad_att_deg)) {
+            v[count++] = res[i].pad_att_deg;
+        }
+    }
+    if (count > 0) {
+        qsort(v, count, sizeof(double), cmp_double);
+        if (v[count / 2] > MC_PAD_ATT_WARN_DEG) {
+            fprintf(stderr, "경고: 점화 시각 자세 오차 중앙값 %.2f도 (기준 %.1f도), 발사대에서 자력계/자세가 "
+                    "맞지 않음\n", v[count / 2], MC_PAD_ATT_WARN_DEG);
+        }
+    }
+    free(v);
+}
+
+static bool parse_engine(const char *s, ReplayConfig *c) {
+    if (strcmp(s, "cov") == 0) {
+        c->engine = EKF_ENGINE_COVARIANCE;
+    } else if (strcmp(s, "ud") == 0) {
+        c->engine = EKF_ENGINE_UD;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parse_update(const char *s, ReplayConfig *c) {
+    if (strcmp(s, "seq") == 0) {
+        c->update_mode = EKF_UPDATE_SEQUENTIAL;
+    } else if (strcmp(s, "batch") == 0) {
+        c->update_mode = EKF_UPDATE_BATCH;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parse_covariance(const char *s, ReplayConfig *c) {
+    if (strcmp(s, "joseph") == 0) {
+        c->covariance_update = EKF_COVARIANCE_JOSEPH;
+    } else if (strcmp(s, "standard") == 0) {
+        c->covariance_update = EKF_COVARIANCE_STANDARD;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    SimConfig sim;
+    sim_default_config(&sim);
+    ReplayConfig config;
+    replay_default_config(&config);
+    uint32_t count = 100;
+    uint64_t first = 1;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    float noise_scale = 1.0f;
+    bool usage = false;
+    bool self_check = false;
+    bool firmware_noise = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:f:j:k:t:b:e:u:c:PDT")) != -1) {
+        switch (opt) {
+        case 'n':
+            count = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            first = strtoull(optarg, NULL, 0);
+            break;
+        case 'j':
+            jobs = strtol(optarg, NULL, 0);
+            break;
+        case 'k':
+            noise_scale = strtof(optarg, NULL);
+            break;
+        case 't':
+            sim.duration = strtod(optarg, NULL);
+            break;
+        case 'b':
+            config.batch = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'e':
+            usage |= !parse_engine(optarg, &config);
+            break;
+        case 'u':
+            usage |= !parse_update(optarg, &config);
+            break;
+        case 'c':
+            usage |= !parse_covariance(optarg, &config);
+            break;
+        case 'P':
+            config.use_phase = false;
+            break;
+        case 'D':
+            firmware_noise = true;
+            break;
+        case 'T':
+            self_check = true;
+            break;
+        default:
+            usage = true;
+            break;
+        }
+    }
+    if (usage || optind != argc || count == 0 || config.batch == 0) {
+        fprintf(stderr, "사용법: %s [-n 시드 수] [-f 첫 시드] [-j 작업자 수] [-k 잡음 배율] [-t 길이(s)]\n"
+                "          [-b batch] [-e cov|ud] [-u seq|batch] [-c joseph|standard] [-P] [-D] [-T]\n", argv[0]);
+        return 1;
+    }
+    if (jobs < 1) {
+        jobs = 1;
+    }
+    if ((uint32_t)jobs > count) {
+        jobs = (long)count;
+    }
+    sim_scale_noise(&sim, noise_scale);
+    if (!firmware_noise) {
+        mc_noise_from_sim(&sim, &config.noise);
+    }
+
+    McResult *res = calloc(count, sizeof(McResult));
+    if (res == NULL) {
+        perror("calloc");
+        return 1;
+    }
+
+    uint64_t wall_start = now_ns();
+    bool pool_ok = mc_run_pool(&sim, &config, first, count, (uint32_t)jobs, res);
+    double wall_s = (double)(now_ns() - wall_start) * 1e-9;
+
+    uint32_t mismatch = 0;
+    if (self_check && pool_ok) {
+        McResult *serial = calloc(count, sizeof(McResult));
+        if (serial == NULL || !mc_run_pool(&sim, &config, first, count, 1, serial)) {
+            pool_ok = false;
+        } else {
+            mismatch = mc_compare(serial, res, count, first);
+        }
+        free(serial);
+    }
+
+    printf("seed,pos_rms,pos_max,vel_rms,att_rms_deg,apogee_err,nees,nis_baro,nis_mag,nis_gnss,"
+           "pad_att_deg,us_per_sample,update_failures,gate_recoveries\n");
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!res[i].ok) {
+            failed++;
+            continue;
+        }
+        printf("%llu,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%u\n",
+               (unsigned long long)(first + i),
+               res[i].pos_rms, res[i].pos_max, res[i].vel_rms, res[i].att_rms_deg, res[i].apogee_err,
+               res[i].nees, res[i].nis_baro, res[i].nis_mag, res[i].nis_gnss, res[i].pad_att_deg,
+               res[i].us_per_sample, res[i].update_failures, res[i].gate_recoveries);
+    }
+
+    fprintf(stderr, "시드 %u개 (실패 %u), 작업자 %ld, %.2f s (초당 %.1f 시드)\n", count, failed, jobs, wall_s,
+            (wall_s > 0.0) ? count / wall_s : 0.0);
+    if (firmware_noise) {
+        fprintf(stderr, "측정/프로세스 잡음: 펌웨어 기본값 (주입 잡음과 무관)\n");
+    } else {
+        fprintf(stderr, "측정 잡음 (sim 모델): 기압 %.3f m, 자력계 %.4f G, GNSS %.2f m / %.2f m/s\n",
+                config.noise.baro_std, config.noise.mag_std, config.noise.gps_pos_std, config.noise.gps_vel_std);
+        fprintf(stderr, "프로세스 잡음 (sim 모델): 속도 %.2e, 자세 %.2e, 자이로/가속도 바이어스 %.1e / %.1e\n",
+                config.noise.vel_std, config.noise.att_std, config.noise.gyro_bias_std, config.noise.accel_bias_std);
+    }
+    mc_print_stat("위치 RMS (m)", res, count, offsetof(McResult, pos_rms), false);
+    mc_print_stat("위치 최대 (m)", res, count, offsetof(McResult, pos_max), false);
+    mc_print_stat("속도 RMS (m/s)", res, count, offsetof(McResult, vel_rms), false);
+    mc_print_stat("자세 RMS (deg)", res, count, offsetof(McResult, att_rms_deg), false);
+    mc_print_stat("|고도 오차| (m)", res, count, offsetof(McResult, apogee_err), true);
+    mc_print_stat("NEES (6)", res, count, offsetof(McResult, nees), false);
+    mc_print_stat("NIS 기압 (1)", res, count, offsetof(McResult, nis_baro), false);
+    mc_print_stat("NIS 자력계 (3)", res, count, offsetof(McResult, nis_mag), false);
+    mc_print_stat("NIS GNSS (6)", res, count, offsetof(McResult, nis_gnss), false);
+    mc_print_stat("발사대 자세 (deg)", res, count, offsetof(McResult, pad_att_deg), false);
+    mc_print_stat("샘플당 (us)", res, count, offsetof(McResult, us_per_sample), false);
+    mc_check_nis("위치/속도 NEES", res, count, offsetof(McResult, nees), 6.0);
+    mc_check_nis("기압 NIS", res, count, offsetof(McResult, nis_baro), 1.0);
+    mc_check_nis("자력계 NIS", res, count, offsetof(McResult, nis_mag), 3.0);
+    mc_check_nis("GNSS NIS", res, count, offsetof(McResult, nis_gnss), 6.0);
+    mc_check_pad(res, count);
+    if (self_check) {
+        fprintf(stderr, "재진입 점검 (작업자 1 / %ld): %s\n", jobs,
+                !pool_ok ? "실행 실패" : (mismatch == 0) ? "일치" : "불일치");
+    }
+    free(res);
+
+    if (self_check && mismatch > 0) {
+        return 2;
+    }
+    return (!pool_ok || failed == count) ? 1 : 0;
+}
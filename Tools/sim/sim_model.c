@@ -0,0 +1,789 @@
+/**
+ * @file sim_model.c
+ * @brief 합성 비행 궤적과 센서 레코드 생성 구현
+ */
+
+#include "sim_model.h"
+#include "ekf/ekf.h"
+#include "ekf/ekf_wmm.h"
+#include "log/log_format.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 물리 상수
+ */
+#define SIM_G 9.80665                  /**< 표준 중력 (m/s^2) */
+#define SIM_WGS84_A 6378137.0          /**< WGS-84 장반경 (m) */
+#define SIM_WGS84_E2 6.69437999014e-3  /**< WGS-84 이심률 제곱 */
+#define SIM_EARTH_R 6356766.0          /**< ISA 지오퍼텐셜 고도 기준 반경 (m) */
+#define SIM_DEG (M_PI / 180.0)
+
+/**
+ * @brief ICM-42688 스케일 (imu_chip_icm42688.c 기본 범위와 같은 float 식)
+ */
+#define SIM_GYRO_SCALE  (3.14159265358979f / 180.0f / 16.4f)
+#define SIM_ACCEL_SCALE (9.80665f / 2048.0f)
+
+/**
+ * @brief 생성 상수
+ */
+#define SIM_START_US 1000000u          /**< 첫 IMU 샘플 시각 (us) */
+#define SIM_ITOW_START_MS 345600000u   /**< 첫 샘플의 GPS 주 시각 (ms) */
+#define SIM_RAIL_LENGTH 3.0            /**< 발사 레일 길이 (m, 이 동안 자세 고정) */
+#define SIM_IMPACT_TAU 0.2             /**< 착지 감속 시상수 (s, 하강 25 m/s에서 최대 약 13 g) */
+#define SIM_WEATHERCOCK_SPEED 20.0     /**< 풍향 안정 이득이 절반이 되는 속력 (m/s) */
+#define SIM_QUEUE_SIZE 128u            /**< 지연 레코드 대기열 크기 */
+#define SIM_GNSS_NUM_SV 12u
+
+/**
+ * @brief 난수 스트림 번호 (센서마다 독립, 한 센서 설정이 다른 센서 잡음을 바꾸지 않음)
+ */
+enum {
+    SIM_RNG_DISPERSION = 0,
+    SIM_RNG_GYRO,
+    SIM_RNG_ACCEL,
+    SIM_RNG_BARO,
+    SIM_RNG_MAG,
+    SIM_RNG_GNSS,
+    SIM_RNG_COUNT
+};
+
+/**
+ * @brief 비행 구간
+ */
+typedef enum {
+    SIM_PAD = 0,
+    SIM_FLIGHT,
+    SIM_CHUTE,
+    SIM_IMPACT,
+    SIM_LANDED
+} SimPhase;
+
+typedef struct {
+    double w, x, y, z;
+} SimQuat;
+
+/**
+ * @brief splitmix64 난수와 Box-Muller 정규 분포
+ */
+typedef struct {
+    uint64_t state;
+    bool has_spare;
+    double spare;
+} SimRng;
+
+/**
+ * @brief 3축 바이어스 (상수 + 랜덤 워크)
+ */
+typedef struct {
+    double b[3];
+} SimBias;
+
+/**
+ * @brief 지연 레코드
+ */
+typedef struct {
+    uint32_t emit_us;
+    uint8_t type;
+    uint8_t len;
+    uint8_t payload[FLASH_LOG_MAX_PAYLOAD];
+} SimPending;
+
+/**
+ * @brief 실행 상태
+ */
+typedef struct {
+    const SimConfig *config;
+    SimEmitFn emit;
+    void *context;
+    SimRng rng[SIM_RNG_COUNT];
+
+    // 시드별 분산 적용 값
+    double thrust;
+    double cd_area;
+    double wind[3];
+
+    // 강체 상태 (세계 좌표계)
+    SimPhase phase;
+    double pos[3];
+    double vel[3];
+    SimQuat q;                 /**< 동체 → 세계 */
+    double omega[3];           /**< 동체 각속도 (rad/s) */
+    double f_body[3];          /**< 비력 (동체, m/s^2) */
+    double apogee_t;           /**< 정점 시각 (점화 후 s, 음수면 아직) */
+
+    SimBias gyro_bias;
+    SimBias accel_bias;
+    SimBias baro_bias;
+    SimBias mag_bias;
+    SimBias gnss_bias;
+    double mag_world[3];       /**< 지구 자기장 (세계, uT) */
+    double sin_lat0, cos_lat0, sin_lon0, cos_lon0;
+    double ecef0[3];
+
+    SimPending queue[SIM_QUEUE_SIZE];
+    uint32_t queue_count;
+
+    SimSummary summary;
+} Sim;
+
+/* ---------------------------------------------------------------------------
+ * 난수
+ * ------------------------------------------------------------------------- */
+
+static uint64_t sim_splitmix(uint64_t *s) {
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static double sim_uniform(SimRng *rng) {
+    return (double)(sim_splitmix(&rng->state) >> 11) * 0x1.0p-53;
+}
+
+static double sim_gauss(SimRng *rng) {
+    if (rng->has_spare) {
+        rng->has_spare = false;
+        return rng->spare;
+    }
+    double u1 = sim_uniform(rng);
+    double u2 = sim_uniform(rng);
+    double r = sqrt(-2.0 * log(u1 > 0.0 ? u1 : 0x1.0p-53));
+    rng->spare = r * sin(2.0 * M_PI * u2);
+    rng->has_spare = true;
+    return r * cos(2.0 * M_PI * u2);
+}
+
+/* ---------------------------------------------------------------------------
+ * 벡터/사원수 (배정밀도 참값)
+ * ------------------------------------------------------------------------- */
+
+static SimQuat sim_qmul(SimQuat a, SimQuat b) {
+    return (SimQuat){
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w
+    };
+}
+
+/**
+ * @brief 회전 벡터 → 사원수 (지수 사상)
+ */
+static SimQuat sim_qexp(const double v[3]) {
+    double angle = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (angle < 1e-12) {
+        return (SimQuat){ 1.0, 0.5 * v[0], 0.5 * v[1], 0.5 * v[2] };
+    }
+    double s = sin(0.5 * angle) / angle;
+    return (SimQuat){ cos(0.5 * angle), v[0] * s, v[1] * s, v[2] * s };
+}
+
+/**
+ * @brief 동체 → 세계 회전 (inverse가 true면 세계 → 동체)
+ */
+static void sim_rotate(SimQuat q, const double v[3], bool inverse, double out[3]) {
+    if (inverse) {
+        q.x = -q.x;
+        q.y = -q.y;
+        q.z = -q.z;
+    }
+    SimQuat p = { 0.0, v[0], v[1], v[2] };
+    SimQuat r = sim_qmul(sim_qmul(q, p), (SimQuat){ q.w, -q.x, -q.y, -q.z });
+    out[0] = r.x;
+    out[1] = r.y;
+    out[2] = r.z;
+}
+
+static double sim_norm(const double v[3]) {
+    return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+/* ---------------------------------------------------------------------------
+ * 대기와 측지
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief ISA 기압 (Pa, 기하 고도 입력, 0..20 km)
+ */
+static double sim_isa_pressure(double h) {
+    double hp = SIM_EARTH_R * h / (SIM_EARTH_R + h);
+    if (hp < 11000.0) {
+        return 101325.0 * pow(1.0 - 0.0065 * hp / 288.15, 5.255877);
+    }
+    return 22632.06 * exp(-1.576883e-4 * (hp - 11000.0));
+}
+
+/**
+ * @brief ISA 밀도 (kg/m^3)
+ */
+static double sim_isa_density(double h) {
+    double hp = SIM_EARTH_R * h / (SIM_EARTH_R + h);
+    double temp = (hp < 11000.0) ? 288.15 - 0.0065 * hp : 216.65;
+    return sim_isa_pressure(h) / (287.05287 * temp);
+}
+
+/**
+ * @brief 측지 → ECEF
+ */
+static void sim_geodetic_to_ecef(double lat, double lon, double h, double ecef[3]) {
+    double n = SIM_WGS84_A / sqrt(1.0 - SIM_WGS84_E2 * sin(lat) * sin(lat));
+    ecef[0] = (n + h) * cos(lat) * cos(lon);
+    ecef[1] = (n + h) * cos(lat) * sin(lon);
+    ecef[2] = (n * (1.0 - SIM_WGS84_E2) + h) * sin(lat);
+}
+
+/**
+ * @brief 원점 NED → 측지 (ECEF 경유, 위도 반복)
+ */
+static void sim_ned_to_geodetic(const Sim *s, const double ned[3], double *lat, double *lon, double *h) {
+    double sl = s->sin_lat0, cl = s->cos_lat0, so = s->sin_lon0, co = s->cos_lon0;
+    double x = s->ecef0[0] - sl * co * ned[0] - so * ned[1] - cl * co * ned[2];
+    double y = s->ecef0[1] - sl * so * ned[0] + co * ned[1] - cl * so * ned[2];
+    double z = s->ecef0[2] + cl * ned[0] - sl * ned[2];
+
+    double p = sqrt(x * x + y * y);
+    *lon = atan2(y, x);
+    double phi = atan2(z, p * (1.0 - SIM_WGS84_E2));
+    for (int i = 0; i < 5; i++) {
+        double n = SIM_WGS84_A / sqrt(1.0 - SIM_WGS84_E2 * sin(phi) * sin(phi));
+        *h = p / cos(phi) - n;
+        phi = atan2(z, p * (1.0 - SIM_WGS84_E2 * n / (n + *h)));
+    }
+    *lat = phi;
+}
+
+/* ---------------------------------------------------------------------------
+ * 레코드
+ * ------------------------------------------------------------------------- */
+
+static uint8_t *sim_put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static uint8_t *sim_putf(uint8_t *p, float f) {
+    uint32_t v;
+    memcpy(&v, &f, sizeof(v));
+    return sim_put32(p, v);
+}
+
+/**
+ * @brief 레코드를 기록 시각 순서로 대기열에 넣음 (같은 시각은 넣은 순서)
+ */
+static void sim_queue(Sim *s, uint32_t emit_us, uint8_t type, const uint8_t *payload, uint8_t len) {
+    if (s->queue_count == SIM_QUEUE_SIZE) {
+        // 가득 차면 가장 이른 레코드를 앞당겨 내보냄
+        s->emit(s->queue[0].type, s->queue[0].payload, s->queue[0].len, s->context);
+        s->summary.records++;
+        memmove(&s->queue[0], &s->queue[1], (SIM_QUEUE_SIZE - 1) * sizeof(SimPending));
+        s->queue_count--;
+    }
+    uint32_t i = s->queue_count;
+    while (i > 0 && (int32_t)(s->queue[i - 1].emit_us - emit_us) > 0) {
+        s->queue[i] = s->queue[i - 1];
+        i--;
+    }
+    s->queue[i].emit_us = emit_us;
+    s->queue[i].type = type;
+    s->queue[i].len = len;
+    memcpy(s->queue[i].payload, payload, len);
+    s->queue_count++;
+}
+
+/**
+ * @brief 기록 시각이 된 레코드 내보내기
+ */
+static void sim_flush(Sim *s, uint32_t now_us, bool all) {
+    uint32_t n = 0;
+    while (n < s->queue_count && (all || (int32_t)(s->queue[n].emit_us - now_us) <= 0)) {
+        s->emit(s->queue[n].type, s->queue[n].payload, s->queue[n].len, s->context);
+        n++;
+    }
+    if (n > 0) {
+        memmove(&s->queue[0], &s->queue[n], (s->queue_count - n) * sizeof(SimPending));
+        s->queue_count -= n;
+        s->summary.records += n;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 센서
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief 바이어스 초기화와 랜덤 워크 한 단계
+ */
+static void sim_bias_init(SimBias *bias, SimRng *rng, float std) {
+    for (int i = 0; i < 3; i++) {
+        bias->b[i] = std * sim_gauss(rng);
+    }
+}
+
+static void sim_bias_step(SimBias *bias, SimRng *rng, float walk, double dt) {
+    if (walk <= 0.0f) {
+        return;
+    }
+    double sigma = walk * sqrt(dt);
+    for (int i = 0; i < 3; i++) {
+        bias->b[i] += sigma * sim_gauss(rng);
+    }
+}
+
+/**
+ * @brief 손실 판정 (잡음을 먼저 뽑은 뒤 호출해 손실 여부가 잡음열을 바꾸지 않게 함)
+ */
+static bool sim_dropped(SimRng *rng, float dropout) {
+    return dropout > 0.0f && sim_uniform(rng) < dropout;
+}
+
+/**
+ * @brief ICM-42688 양자화 (드라이버와 같은 int16 → float 변환)
+ */
+static float sim_quantize(double v, float scale) {
+    double raw = nearbyint(v / (double)scale);
+    if (raw > 32767.0) {
+        raw = 32767.0;
+    } else if (raw < -32768.0) {
+        raw = -32768.0;
+    }
+    return (float)(int16_t)raw * scale;
+}
+
+static void sim_emit_imu(Sim *s, uint32_t t_us, double dt) {
+    const SimConfig *c = s->config;
+    float gyro[3];
+    float accel[3];
+    for (int i = 0; i < 3; i++) {
+        double g = s->omega[i] + s->gyro_bias.b[i] + c->gyro.std * sim_gauss(&s->rng[SIM_RNG_GYRO]);
+        double a = s->f_body[i] + s->accel_bias.b[i] + c->accel.std * sim_gauss(&s->rng[SIM_RNG_ACCEL]);
+        gyro[i] = sim_quantize(g, SIM_GYRO_SCALE);
+        accel[i] = sim_quantize(a, SIM_ACCEL_SCALE);
+    }
+    sim_bias_step(&s->gyro_bias, &s->rng[SIM_RNG_GYRO], c->gyro.bias_walk, dt);
+    sim_bias_step(&s->accel_bias, &s->rng[SIM_RNG_ACCEL], c->accel.bias_walk, dt);
+    if (sim_dropped(&s->rng[SIM_RNG_GYRO], c->gyro.dropout)) {
+        return;
+    }
+
+    uint8_t rec[28];
+    uint8_t *p = sim_put32(rec, t_us);
+    for (int i = 0; i < 3; i++) {
+        p = sim_putf(p, gyro[i]);
+    }
+    for (int i = 0; i < 3; i++) {
+        p = sim_putf(p, accel[i]);
+    }
+    sim_queue(s, t_us + c->gyro.latency_us, FLASH_LOG_REC_IMU, rec, sizeof(rec));
+}
+
+static void sim_emit_baro(Sim *s, uint32_t t_us, double dt) {
+    const SimConfig *c = s->config;
+    SimRng *rng = &s->rng[SIM_RNG_BARO];
+    double p_pa = sim_isa_pressure(c->height_m + s->pos[2]) + s->baro_bias.b[0] + c->baro.std * sim_gauss(rng);
+    sim_bias_step(&s->baro_bias, rng, c->baro.bias_walk, dt);
+    if (sim_dropped(rng, c->baro.dropout)) {
+        return;
+    }
+
+    uint8_t rec[12];
+    uint8_t *p = sim_put32(rec, t_us);
+    p = sim_putf(p, (float)p_pa);
+    sim_putf(p, (float)(15.0 - 0.0065 * c->height_m));  // 발사대 ISA 기온 (비행 중 일정)
+    sim_queue(s, t_us + c->baro.latency_us, FLASH_LOG_REC_BARO, rec, sizeof(rec));
+}
+
+static void sim_emit_mag(Sim *s, uint32_t t_us, double dt) {
+    const SimConfig *c = s->config;
+    SimRng *rng = &s->rng[SIM_RNG_MAG];
+    double body[3];
+    sim_rotate(s->q, s->mag_world, true, body);
+    float field[3];
+    for (int i = 0; i < 3; i++) {
+        field[i] = (float)(body[i] + s->mag_bias.b[i] + c->mag.std * sim_gauss(rng));
+    }
+    sim_bias_step(&s->mag_bias, rng, c->mag.bias_walk, dt);
+    if (sim_dropped(rng, c->mag.dropout)) {
+        return;
+    }
+
+    uint8_t rec[16];
+    uint8_t *p = sim_put32(rec, t_us);
+    for (int i = 0; i < 3; i++) {
+        p = sim_putf(p, field[i]);
+    }
+    sim_queue(s, t_us + c->mag.latency_us, FLASH_LOG_REC_MAG, rec, sizeof(rec));
+}
+
+/**
+ * @brief NAV-PVT 정수 단위 반올림 후 ubx_gnss와 같은 float 변환 (mm → m 등)
+ */
+static float sim_milli(double v) {
+    return (float)(int32_t)lrint(v * 1000.0) * 1e-3f;
+}
+
+static void sim_emit_gnss(Sim *s, uint32_t t_us, double flight_t, double dt) {
+    const SimConfig *c = s->config;
+    SimRng *rng = &s->rng[SIM_RNG_GNSS];
+    double ned[3];
+    double vel_ned[3];
+    for (int i = 0; i < 3; i++) {
+        double scale = (i == 2) ? 1.5 : 1.0;
+        double pos = s->pos[i] + scale * (s->gnss_bias.b[i] + c->gnss_pos.std * sim_gauss(rng));
+        double vel = s->vel[i] + scale * c->gnss_vel.std * sim_gauss(rng);
+        ned[i] = (i == 2) ? -pos : pos;
+        vel_ned[i] = (i == 2) ? -vel : vel;
+    }
+    sim_bias_step(&s->gnss_bias, rng, c->gnss_pos.bias_walk, dt);
+    if (sim_dropped(rng, c->gnss_pos.dropout)) {
+        return;
+    }
+    bool outage = c->gnss_outage_end > c->gnss_outage_start &&
+                  flight_t >= c->gnss_outage_start && flight_t < c->gnss_outage_end;
+
+    uint8_t rec[sizeof(FlashLogGnssRecord)];
+    memset(rec, 0, sizeof(rec));
+    uint8_t *p = sim_put32(rec, t_us);
+    p = sim_put32(p, SIM_ITOW_START_MS + (t_us - SIM_START_US) / 1000u);
+    if (!outage) {
+        double lat, lon, h;
+        sim_ned_to_geodetic(s, ned, &lat, &lon, &h);
+        p = sim_put32(p, (uint32_t)(int32_t)llround(lat / SIM_DEG * 1e7));
+        p = sim_put32(p, (uint32_t)(int32_t)llround(lon / SIM_DEG * 1e7));
+        p = sim_put32(p, (uint32_t)(int32_t)llround(h * 1000.0));
+        p = sim_put32(p, (uint32_t)(int32_t)llround(h * 1000.0));
+        for (int i = 0; i < 3; i++) {
+            p = sim_putf(p, sim_milli(vel_ned[i]));
+        }
+        p = sim_putf(p, sim_milli(c->gnss_pos.std));
+        p = sim_putf(p, sim_milli(1.5 * c->gnss_pos.std));
+        p = sim_putf(p, sim_milli(c->gnss_vel.std));
+        p[0] = 3;                  // 3D
+        p[1] = SIM_GNSS_NUM_SV;
+        p[2] = 0x01u;              // fix_ok
+    }
+    sim_queue(s, t_us + c->gnss_pos.latency_us, FLASH_LOG_REC_GNSS, rec, sizeof(rec));
+}
+
+static void sim_emit_truth(Sim *s, uint32_t t_us) {
+    EKF_NavSolution sol;
+    memset(&sol, 0, sizeof(sol));
+    sol.timestamp_us = t_us;
+    sol.pos = vector3f_create((float)s->pos[0], (float)s->pos[1], (float)s->pos[2]);
+    sol.vel = vector3f_create((float)s->vel[0], (float)s->vel[1], (float)s->vel[2]);
+    sol.q = quaternion_create((float)s->q.w, (float)s->q.x, (float)s->q.y, (float)s->q.z);
+    sim_queue(s, t_us, FLASH_LOG_REC_NAV, (const uint8_t *)&sol, sizeof(sol));
+}
+
+/* ---------------------------------------------------------------------------
+ * 동역학
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief 가속도와 비력 (세계)
+ */
+static void sim_forces(const Sim *s, const double pos[3], const double vel[3], double flight_t,
+                       double accel[3], double f_world[3]) {
+    const SimConfig *c = s->config;
+    if (s->phase == SIM_PAD || s->phase == SIM_LANDED) {
+        // 지면 반력이 중력을 상쇄
+        accel[0] = accel[1] = accel[2] = 0.0;
+        f_world[0] = f_world[1] = 0.0;
+        f_world[2] = SIM_G;
+        return;
+    }
+    if (s->phase == SIM_IMPACT) {
+        // 지면 충돌: 속도가 시상수 SIM_IMPACT_TAU로 감쇠하며 정지 거리만큼 파고듦
+        for (int i = 0; i < 3; i++) {
+            accel[i] = -vel[i] / SIM_IMPACT_TAU;
+            f_world[i] = accel[i];
+        }
+        f_world[2] += SIM_G;
+        return;
+    }
+
+    bool burning = flight_t < c->burn_time;
+    double mass = c->mass_dry + (burning ? c->mass_prop * (1.0 - flight_t / c->burn_time) : 0.0);
+    double axis[3];
+    sim_rotate(s->q, (const double[3]){ 0.0, 0.0, 1.0 }, false, axis);
+
+    double air[3] = { vel[0] - s->wind[0], vel[1] - s->wind[1], vel[2] - s->wind[2] };
+    double speed = sim_norm(air);
+    double cd_area = s->cd_area + ((s->phase == SIM_CHUTE) ? c->chute_cd_area : 0.0);
+    double drag = 0.5 * sim_isa_density(c->height_m + pos[2]) * cd_area * speed / mass;
+    double thrust = burning ? s->thrust / mass : 0.0;
+    for (int i = 0; i < 3; i++) {
+        f_world[i] = thrust * axis[i] - drag * air[i];
+        accel[i] = f_world[i];
+    }
+    accel[2] -= SIM_G;
+}
+
+/**
+ * @brief 동체 각속도 (풍향 안정 + 축 회전, 낙하산 하강 중 진자)
+ */
+static void sim_rates(Sim *s, double flight_t) {
+    const SimConfig *c = s->config;
+    if (s->phase == SIM_PAD || s->phase == SIM_IMPACT || s->phase == SIM_LANDED ||
+        sim_norm(s->pos) < SIM_RAIL_LENGTH) {
+        s->omega[0] = s->omega[1] = s->omega[2] = 0.0;
+        return;
+    }
+    if (s->phase == SIM_CHUTE) {
+        s->omega[0] = 0.4 * sin(1.3 * flight_t);
+        s->omega[1] = 0.4 * cos(0.9 * flight_t);
+        s->omega[2] = 0.2;
+        return;
+    }
+
+    double axis[3];
+    sim_rotate(s->q, (const double[3]){ 0.0, 0.0, 1.0 }, false, axis);
+    double air[3] = { s->vel[0] - s->wind[0], s->vel[1] - s->wind[1], s->vel[2] - s->wind[2] };
+    double speed = sim_norm(air);
+    double w_world[3] = { 0.0, 0.0, 0.0 };
+    if (speed > 1e-3) {
+        double k = c->weathercock_gain * speed / (speed + SIM_WEATHERCOCK_SPEED) / speed;
+        w_world[0] = k * (axis[1] * air[2] - axis[2] * air[1]);
+        w_world[1] = k * (axis[2] * air[0] - axis[0] * air[2]);
+        w_world[2] = k * (axis[0] * air[1] - axis[1] * air[0]);
+    }
+    sim_rotate(s->q, w_world, true, s->omega);
+    s->omega[2] += c->spin_rate;
+}
+
+/**
+ * @brief 한 IMU 주기 적분 (병진 중점법, 회전 지수 사상) 및 구간 전이
+ */
+static void sim_step(Sim *s, double flight_t, double dt) {
+    const SimConfig *c = s->config;
+    double a1[3], f1[3], a2[3], f2[3];
+    sim_forces(s, s->pos, s->vel, flight_t, a1, f1);
+    double pm[3], vm[3];
+    for (int i = 0; i < 3; i++) {
+        vm[i] = s->vel[i] + 0.5 * dt * a1[i];
+        pm[i] = s->pos[i] + 0.5 * dt * s->vel[i];
+    }
+    sim_forces(s, pm, vm, flight_t + 0.5 * dt, a2, f2);
+    double vz_before = s->vel[2];
+    for (int i = 0; i < 3; i++) {
+        s->pos[i] += dt * vm[i];
+        s->vel[i] += dt * a2[i];
+    }
+    double rot[3] = { s->omega[0] * dt, s->omega[1] * dt, s->omega[2] * dt };
+    s->q = sim_qmul(s->q, sim_qexp(rot));
+    double n = sqrt(s->q.w * s->q.w + s->q.x * s->q.x + s->q.y * s->q.y + s->q.z * s->q.z);
+    s->q = (SimQuat){ s->q.w / n, s->q.x / n, s->q.y / n, s->q.z / n };
+
+    double speed = sim_norm(s->vel);
+    if (speed > s->summary.max_speed) {
+        s->summary.max_speed = speed;
+    }
+    if (s->pos[2] > s->summary.apogee) {
+        s->summary.apogee = s->pos[2];
+    }
+
+    if (s->phase == SIM_FLIGHT || s->phase == SIM_CHUTE) {
+        double t_next = flight_t + dt;
+        if (s->apogee_t < 0.0 && t_next > c->burn_time && vz_before > 0.0 && s->vel[2] <= 0.0) {
+            s->apogee_t = t_next;
+            s->summary.apogee_time = t_next;
+        }
+        if (s->phase == SIM_FLIGHT && s->apogee_t >= 0.0 && t_next >= s->apogee_t + c->chute_delay) {
+            s->phase = SIM_CHUTE;
+        }
+        // 감속 거리(|v_z| * tau)만큼 남았을 때 충돌 시작, 지면(z = 0)에서 멈춤
+        if (t_next > 1.0 && s->vel[2] < 0.0 && s->pos[2] <= -s->vel[2] * SIM_IMPACT_TAU) {
+            s->phase = SIM_IMPACT;
+            s->summary.landing_time = t_next;
+        }
+    } else if (s->phase == SIM_IMPACT && sim_norm(s->vel) < 1e-3) {
+        s->phase = SIM_LANDED;
+        s->vel[0] = s->vel[1] = s->vel[2] = 0.0;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 공개 함수
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief 기본 설정
+ */
+void sim_default_config(SimConfig *config) {
+    memset(config, 0, sizeof(*config));
+    config->pad_time = 10.0;
+    config->duration = 180.0;
+
+    config->mass_dry = 16.0;
+    config->mass_prop = 4.0;
+    config->thrust = 2000.0;
+    config->burn_time = 3.0;
+    config->cd_area = 0.5 * M_PI * 0.06 * 0.06;
+    config->chute_cd_area = 0.5;
+    config->chute_delay = 1.0;
+    config->rail_elevation_deg = 85.0;
+    config->rail_azimuth_deg = 45.0;
+    config->spin_rate = 2.0;
+    config->weathercock_gain = 2.0;
+    config->wind[0] = 3.0;
+    config->wind[1] = 1.0;
+
+    config->thrust_std = 0.03;
+    config->cd_std = 0.05;
+    config->wind_std = 1.0;
+
+    config->lat_deg = EKF_WMM_DEFAULT_LAT_DEG;
+    config->lon_deg = EKF_WMM_DEFAULT_LON_DEG;
+    config->height_m = 30.0;
+
+    config->imu_hz = 1000;
+    config->baro_hz = 50;
+    config->mag_hz = 100;
+    config->gnss_hz = 10;
+    config->truth_hz = 100;
+
+    config->gyro = (SimSensorModel){ .std = 2.8e-3f, .bias_std = 2e-3f, .bias_walk = 5e-5f };
+    config->accel = (SimSensorModel){ .std = 2.2e-2f, .bias_std = 5e-2f, .bias_walk = 1e-3f };
+    config->baro = (SimSensorModel){ .std = 2.0f, .bias_std = 10.0f, .bias_walk = 0.5f };
+    config->mag = (SimSensorModel){ .std = 0.3f };  // 철 보정 후 잔차 없음 (필터에 자기장 바이어스 상태가 없음)
+    config->gnss_pos = (SimSensorModel){ .std = 1.5f, .bias_std = 1.0f, .bias_walk = 0.05f, .latency_us = 30000u };
+    config->gnss_vel = (SimSensorModel){ .std = 0.1f };
+    config->gnss_outage_start = 2.0;
+    config->gnss_outage_end = 6.0;
+}
+
+/**
+ * @brief 센서 오차 일괄 배율
+ */
+void sim_scale_noise(SimConfig *config, float scale) {
+    SimSensorModel *models[] = {
+        &config->gyro, &config->accel, &config->baro, &config->mag, &config->gnss_pos, &config->gnss_vel
+    };
+    for (size_t i = 0; i < sizeof(models) / sizeof(models[0]); i++) {
+        models[i]->std *= scale;
+        models[i]->bias_std *= scale;
+        models[i]->bias_walk *= scale;
+    }
+}
+
+/**
+ * @brief 시뮬레이션 실행
+ */
+bool sim_run(const SimConfig *config, uint64_t seed, SimEmitFn emit, void *context, SimSummary *summary) {
+    if (config == NULL || emit == NULL || config->imu_hz == 0 || 1000000u % config->imu_hz != 0 ||
+        config->duration <= 0.0 || config->mass_dry <= 0.0 || config->burn_time <= 0.0) {
+        return false;
+    }
+
+    Sim *s = calloc(1, sizeof(*s));
+    if (s == NULL) {
+        return false;
+    }
+    s->config = config;
+    s->emit = emit;
+    s->context = context;
+    for (uint32_t i = 0; i < SIM_RNG_COUNT; i++) {
+        uint64_t mix = seed ^ (0xD1B54A32D192ED03ull * (i + 1u));
+        s->rng[i].state = sim_splitmix(&mix);
+    }
+
+    SimRng *disp = &s->rng[SIM_RNG_DISPERSION];
+    s->thrust = config->thrust * (1.0 + config->thrust_std * sim_gauss(disp));
+    s->cd_area = config->cd_area * fmax(0.1, 1.0 + config->cd_std * sim_gauss(disp));
+    s->wind[0] = config->wind[0] + config->wind_std * sim_gauss(disp);
+    s->wind[1] = config->wind[1] + config->wind_std * sim_gauss(disp);
+    sim_bias_init(&s->gyro_bias, &s->rng[SIM_RNG_GYRO], config->gyro.bias_std);
+    sim_bias_init(&s->accel_bias, &s->rng[SIM_RNG_ACCEL], config->accel.bias_std);
+    sim_bias_init(&s->baro_bias, &s->rng[SIM_RNG_BARO], config->baro.bias_std);
+    sim_bias_init(&s->mag_bias, &s->rng[SIM_RNG_MAG], config->mag.bias_std);
+    sim_bias_init(&s->gnss_bias, &s->rng[SIM_RNG_GNSS], config->gnss_pos.bias_std);
+
+    // 발사대 자세: 동체 z축을 레일 방향으로 (수평 축 회전, 요 0)
+    double el = config->rail_elevation_deg * SIM_DEG;
+    double az = config->rail_azimuth_deg * SIM_DEG;
+    double rail[3] = { cos(el) * cos(az), cos(el) * sin(az), sin(el) };
+    double tilt[3] = { -rail[1], rail[0], 0.0 };
+    double tilt_norm = sim_norm(tilt);
+    if (tilt_norm > 1e-9) {
+        double angle = acos(fmin(1.0, rail[2]));
+        for (int i = 0; i < 3; i++) {
+            tilt[i] *= angle / tilt_norm;
+        }
+    }
+    s->q = sim_qexp(tilt);
+    s->apogee_t = -1.0;
+    s->phase = SIM_PAD;
+
+    Vector3f field;
+    if (!ekf_wmm_get_field_ned((float)config->lat_deg, (float)config->lon_deg, &field)) {
+        free(s);
+        return false;
+    }
+    s->mag_world[0] = field.x * 100.0;  // G → uT
+    s->mag_world[1] = field.y * 100.0;
+    s->mag_world[2] = field.z * 100.0;
+
+    double lat0 = config->lat_deg * SIM_DEG;
+    double lon0 = config->lon_deg * SIM_DEG;
+    s->sin_lat0 = sin(lat0);
+    s->cos_lat0 = cos(lat0);
+    s->sin_lon0 = sin(lon0);
+    s->cos_lon0 = cos(lon0);
+    sim_geodetic_to_ecef(lat0, lon0, config->height_m, s->ecef0);
+
+    uint32_t period_us = 1000000u / config->imu_hz;
+    double dt = period_us * 1e-6;
+    uint64_t steps = (uint64_t)(config->duration * config->imu_hz);
+    const uint32_t rates[4] = { config->baro_hz, config->mag_hz, config->gnss_hz, config->truth_hz };
+    for (uint64_t k = 0; k < steps; k++) {
+        uint32_t t_us = SIM_START_US + (uint32_t)(k * period_us);
+        double flight_t = (double)k * dt - config->pad_time;
+        if (s->phase == SIM_PAD && flight_t >= 0.0) {
+            s->phase = SIM_FLIGHT;
+            s->summary.ignition_us = t_us;
+        }
+
+        // 현재 상태의 비력과 각속도 (샘플 시각 값)
+        double accel[3], f_world[3];
+        sim_forces(s, s->pos, s->vel, flight_t, accel, f_world);
+        sim_rotate(s->q, f_world, true, s->f_body);
+        sim_rates(s, flight_t);
+
+        // 센서 주기: k에서 floor(k * rate / imu_hz)가 바뀌면 샘플
+        bool due[4];
+        for (int i = 0; i < 4; i++) {
+            due[i] = rates[i] > 0 && (k == 0 || (k * rates[i]) / config->imu_hz != ((k - 1) * rates[i]) / config->imu_hz);
+        }
+        sim_emit_imu(s, t_us, dt);
+        if (due[0]) {
+            sim_emit_baro(s, t_us, 1.0 / rates[0]);
+        }
+        if (due[1]) {
+            sim_emit_mag(s, t_us, 1.0 / rates[1]);
+        }
+        if (due[2]) {
+            sim_emit_gnss(s, t_us, flight_t, 1.0 / rates[2]);
+        }
+        if (due[3]) {
+            sim_emit_truth(s, t_us);
+        }
+        sim_flush(s, t_us, false);
+
+        sim_step(s, flight_t, dt);
+    }
+    sim_flush(s, 0, true);
+
+    if (summary != NULL) {
+        *summary = s->summary;
+    }
+    free(s);
+
+    return true;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file sim_model.h
+ * @brief 합성 비행 궤적과 센서 레코드 생성 (호스트용, flight_sim과 monte_carlo 공용)
+ *
+ * 강체 6자유도 궤적(발사대 대기 → 추진 → 관성 비행 → 낙하산 하강 → 착지)을
+ * IMU 주기로 적분하고, 각 센서 모델의 출력을 flash_log 원시 레코드와 같은 바이트열로
+ * 내보낸다. 기록기가 쓰는 것과 같으므로 log_replay와 replay.h로 그대로 재생된다.
+ * - 병진: 추력(동체 축), 항력 0.5 rho CdA |v - wind| (v - wind) (ISA 밀도), 중력
+ * - 회전: 비행 중 속도 방향으로 동체 축을 돌리는 풍향 안정(weathercock) + 축 회전,
+ *   낙하산 하강 중에는 진자 운동
+ * - 착지: 지면에서 멈추도록 속도를 지수 감쇠 (시상수 0.2 s, 감속이 IMU에 보임)
+ * - 세계 좌표계는 필터와 같다 (x 북, y 동, z 위, 원점 = 발사대)
+ *
+ * 센서 출력은 수신 계층이 내는 값과 비트 단위로 같다:
+ * - IMU: ICM-42688 LSB(±2000 dps, ±16 g)로 양자화하고 포화한 뒤 드라이버와 같은
+ *   float 곱(raw * scale)으로 되돌림
+ * - GNSS: NAV-PVT 정수 단위(1e-7 deg, mm, mm/s)로 반올림한 뒤 ubx_gnss와 같이 변환
+ * - 자기장: uT, 기압: Pa (float)
+ * 센서마다 백색 잡음, 시드별 상수 바이어스, 바이어스 랜덤 워크, 지연(기록 순서는
+ * 도착 순, 타임스탬프는 측정 시각), 샘플 손실 확률을 정한다. GNSS는 정해진 구간에서
+ * 측위를 잃는다(fix 0 보고).
+ *
+ * 참값은 FLASH_LOG_REC_NAV 레코드(EKF_NavSolution, 위치/속도/자세만 채움)로 내보낸다.
+ * 같은 설정과 시드는 항상 같은 레코드열을 낸다.
+ */
+
+#ifndef SIM_MODEL_H
+#define SIM_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 레코드 출력 콜백 (flash_log_write와 같은 인자)
+ */
+typedef void (*SimEmitFn)(uint8_t type, const void *payload, uint8_t len, void *context);
+
+/**
+ * @brief 센서 오차 모델 (단위는 센서 출력 단위)
+ */
+typedef struct {
+    float std;                 /**< 샘플 백색 잡음 표준 편차 */
+    float bias_std;            /**< 시드별 상수 바이어스 표준 편차 */
+    float bias_walk;           /**< 바이어스 랜덤 워크 (단위/sqrt(s)) */
+    uint32_t latency_us;       /**< 측정 → 기록 지연 (us) */
+    float dropout;             /**< 샘플 손실 확률 (0..1) */
+} SimSensorModel;
+
+/**
+ * @brief 시뮬레이션 설정
+ */
+typedef struct {
+    // 시간
+    double pad_time;           /**< 점화 전 발사대 대기 (s) */
+    double duration;           /**< 전체 길이 (s) */
+
+    // 기체
+    double mass_dry;           /**< 건조 질량 (kg) */
+    double mass_prop;          /**< 추진제 질량 (kg) */
+    double thrust;             /**< 평균 추력 (N) */
+    double burn_time;          /**< 연소 시간 (s) */
+    double cd_area;            /**< 동체 항력 계수 x 면적 (m^2) */
+    double chute_cd_area;      /**< 낙하산 항력 계수 x 면적 (m^2) */
+    double chute_delay;        /**< 정점 후 낙하산 전개 지연 (s) */
+    double rail_elevation_deg; /**< 발사대 고각 (도, 90 = 수직) */
+    double rail_azimuth_deg;   /**< 발사대 방위 (도, 북 기준 시계 방향) */
+    double spin_rate;          /**< 비행 중 축 회전 각속도 (rad/s) */
+    double weathercock_gain;   /**< 풍향 안정 이득 (1/s) */
+    double wind[2];            /**< 평균 바람 (북, 동, m/s) */
+
+    // 시드별 분산
+    double thrust_std;         /**< 추력 상대 표준 편차 */
+    double cd_std;             /**< 항력 상대 표준 편차 */
+    double wind_std;           /**< 바람 성분 표준 편차 (m/s) */
+
+    // 발사 장소
+    double lat_deg;            /**< 위도 (도) */
+    double lon_deg;            /**< 경도 (도) */
+    double height_m;           /**< 타원체 고도 (m) */
+
+    // 주기
+    uint32_t imu_hz;           /**< IMU (적분 주기) */
+    uint32_t baro_hz;          /**< 기압계 */
+    uint32_t mag_hz;           /**< 자력계 */
+    uint32_t gnss_hz;          /**< GNSS */
+    uint32_t truth_hz;         /**< 참값 레코드 */
+
+    // 센서 오차
+    SimSensorModel gyro;       /**< rad/s */
+    SimSensorModel accel;      /**< m/s^2 */
+    SimSensorModel baro;       /**< Pa */
+    SimSensorModel mag;        /**< uT */
+    SimSensorModel gnss_pos;   /**< m (수직은 1.5배) */
+    SimSensorModel gnss_vel;   /**< m/s */
+    double gnss_outage_start;  /**< 측위 상실 시작 (점화 후 s, 끝 <= 시작이면 없음) */
+    double gnss_outage_end;    /**< 측위 상실 끝 (점화 후 s) */
+} SimConfig;
+
+/**
+ * @brief 생성 결과 요약
+ */
+typedef struct {
+    double apogee;             /**< 참값 최고 고도 (m) */
+    double apogee_time;        /**< 정점 시각 (점화 후 s) */
+    double max_speed;          /**< 최대 속력 (m/s) */
+    double landing_time;       /**< 착지 시각 (점화 후 s, 착지하지 않았으면 0) */
+    uint32_t ignition_us;      /**< 점화 시각 (레코드 시각, us) */
+    uint32_t records;          /**< 내보낸 레코드 수 */
+} SimSummary;
+
+/**
+ * @brief 기본 설정 (20 kg, 2 kN x 3 s, 정점 약 2.8 km, 착지까지 180 s, 소비자급 MEMS 오차)
+ *
+ * @param config 설정 구조체 포인터
+ */
+void sim_default_config(SimConfig *config);
+
+/**
+ * @brief 센서 잡음/바이어스/랜덤 워크를 일괄 배율
+ *
+ * @param config 설정 구조체 포인터
+ * @param scale 배율
+ */
+void sim_scale_noise(SimConfig *config, float scale);
+
+/**
+ * @brief 시뮬레이션 실행
+ *
+ * @param config 설정
+ * @param seed 난수 시드 (분산, 바이어스, 잡음, 손실)
+ * @param emit 레코드 출력 콜백
+ * @param context 콜백 문맥
+ * @param summary 결과 요약 (NULL 가능)
+ * @return bool 성공 여부 (잘못된 설정이면 false)
+ */
+bool sim_run(const SimConfig *config, uint64_t seed, SimEmitFn emit, void *context, SimSummary *summary);
+
+#endif /* SIM_MODEL_H */
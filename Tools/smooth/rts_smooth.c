@@ -0,0 +1,791 @@
+/**
+ * @file rts_smooth.c
+ * @brief 비행 기록 RTS(Rauch-Tung-Striebel) 고정 구간 스무더 (호스트용 비행 후 분석)
+ *
+ * 비행 기록(NOR 덤프 또는 SD 기록 파일)을 mmap해 Tools/ground/ground_decode로 읽고,
+ * 수정하지 않은 ekf_predict/ekf_update_* 로 앞으로 한 번 추정한 뒤 뒤로 RTS 평활을 수행한다.
+ *
+ * 앞 단계: IMU batch개(기본 10, 100 Hz)마다 한 구간으로 묶는다. 구간 시작에서 사후 (x, P),
+ * 끝에서 사전 (x, P)를 받아 두고, 구간 안에서 P에 반영된 전이(ekf_set_transition_observer)를
+ * 곱해 구간 전이 Φ를 만든다. 보조 측정(기압, 자력계, GNSS)이 오면 진행 중인 구간을 닫고
+ * 그 자리에서 갱신하므로 측정은 가장 가까운 IMU 샘플 시각에 들어간다 (지연 보정 없음).
+ * 구간 기록은 고정 크기 레코드로 이력 파일에 RTS_CHUNK_STEPS개씩 이어 쓴다.
+ *
+ * 뒤 단계: 이력 파일을 끝에서부터 묶음 단위로 읽어
+ *   C = P_a Φ^T P_b^-1,  xs_k = x_a + C (xs_k+1 - x_b),  Ps_k = P_a + C (Ps_k+1 - P_b) C^T
+ * 를 배정밀도로 계산한다 (P_b는 Cholesky 분해, 실패하면 대각에 작은 값을 더해 다시 시도).
+ * 평활 결과도 묶음 단위로 임시 파일 제자리에 쓰고, 마지막에 앞으로 읽어 CSV로 낸다.
+ * 메모리는 묶음 몇 개 분량으로 일정하며 기록 길이와 관계없다. 이력은 구간당 약
+ * (2N + N(N+1) + N^2) x 4 바이트 (N = 16이면 2.2 KB, 100 Hz에서 시간당 약 0.8 GB)이다.
+ *
+ * 입력 레코드 처리는 Tools/replay/replay.c와 같다 (IMU 원시/"imu" 스트림, 기압은 지상 기준 고도,
+ * 자기장은 가우스, GNSS는 첫 3D 측위를 원점으로 하는 위쪽 z 좌표). 세션을 지정하지 않으면
+ * 첫 유효 블록의 세션만 쓴다. 사원수 원소는 평활 뒤 정규화한다.
+ *
+ * 출력 CSV (decimation 구간마다 한 행, 평활 값 다음 같은 시각의 앞 단계 값):
+ *   t_us,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,qw,qx,qy,qz,sd_pos_x,sd_pos_y,sd_pos_z,sd_vel_x,sd_vel_y,sd_vel_z,
+ *   f_pos_x,f_pos_y,f_pos_z,f_vel_x,f_vel_y,f_vel_z,f_sd_pos_z,f_sd_vel_z
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -ITools/ground -o rts_smooth Tools/smooth/rts_smooth.c \
+ *       Tools/ground/ground_decode.c Core/Src/log/log_lz.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c Core/Src/nav/geodetic.c \
+ *       Core/Src/sensors/baro_altitude.c Core/Src/sensors/baro_isa_table.c -lm
+ *
+ * 실행:
+ *   ./rts_smooth [-s 세션] [-b batch] [-d decimation] [-H history.bin] [-o smooth.csv] flash.bin
+ *   -H: 이력 파일을 지우지 않고 남김 (기본은 임시 파일)
+ */
+
+#include "ground_decode.h"
+#include "ekf/ekf.h"
+#include "math/quaternion.h"
+#include "nav/geodetic.h"
+#include "sensors/baro_altitude.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief 이력 파일 형식
+ */
+#define RTS_MAGIC 0x53524C50u            /**< "PLRS" */
+#define RTS_VERSION 1u
+#define RTS_N EKF_STATE_DIM
+#define RTS_S (RTS_N * (RTS_N + 1) / 2)
+#define RTS_CHUNK_STEPS 256u             /**< 파일 입출력 묶음 (구간 수) */
+
+/**
+ * @brief 기본 설정
+ */
+#define RTS_DEFAULT_BATCH 10u            /**< 구간당 IMU 샘플 수 */
+#define RTS_DEFAULT_DECIMATION 1u        /**< CSV 출력 간격 (구간) */
+#define RTS_MAX_IMU_GAP 0.1f             /**< 이보다 긴 IMU 간격은 예측하지 않고 건너뜀 (s) */
+#define RTS_UT_TO_GAUSS 0.01f            /**< 자기장 단위 변환 (uT → G) */
+#define RTS_GNSS_MIN_FIX 3u              /**< 사용할 최소 측위 종류 (3D) */
+#define RTS_JITTER_TRIES 6               /**< Cholesky 재시도 횟수 (더하는 값은 매번 10배) */
+
+/**
+ * @brief 이력 파일 머리 (앞 단계를 마친 뒤 다시 씀)
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t state_dim;
+    uint32_t record_size;
+    uint32_t chunk_steps;
+    uint64_t steps;            /**< 구간 수 */
+    uint32_t t_end_us;         /**< 마지막 사후 상태 시각 */
+    float x_end[RTS_N];        /**< 마지막 사후 상태 (평활 시작점) */
+    float P_end[RTS_S];        /**< 마지막 사후 공분산 (상삼각 압축) */
+} RtsHeader;
+
+/**
+ * @brief 구간 기록
+ */
+typedef struct {
+    uint32_t t_us;             /**< 구간 시작 (사후 상태) 시각 */
+    uint32_t t_next_us;        /**< 구간 끝 (사전 상태) 시각 */
+    float x_a[RTS_N];          /**< 구간 시작 사후 상태 */
+    float P_a[RTS_S];          /**< 구간 시작 사후 공분산 */
+    float x_b[RTS_N];          /**< 구간 끝 사전 상태 */
+    float P_b[RTS_S];          /**< 구간 끝 사전 공분산 */
+    float phi[RTS_N * RTS_N];  /**< 구간 전이 (행 우선) */
+} RtsRecord;
+
+/**
+ * @brief 평활 결과 (구간 시작 시각마다, 마지막은 끝 상태)
+ */
+typedef struct {
+    uint32_t t_us;
+    float xs[RTS_N];           /**< 평활 상태 */
+    float vs[RTS_N];           /**< 평활 분산 (대각) */
+    float xf[RTS_N];           /**< 앞 단계 사후 상태 */
+    float vf[RTS_N];           /**< 앞 단계 사후 분산 (대각) */
+} RtsOutput;
+
+/**
+ * @brief 앞 단계 상태
+ */
+typedef struct {
+    EKF ekf;
+    ScratchArena scratch;
+    uint8_t scratch_buffer[EKF_SCRATCH_SIZE] __attribute__((aligned(8)));
+    BaroAltitude baro;
+    GeodeticFrame geo;
+    bool filter_ready;
+    bool geo_ready;
+    bool have_imu;
+    uint32_t last_imu_us;
+    uint32_t batch;
+
+    uint32_t pending;          /**< 진행 중 구간의 IMU 샘플 수 (0이면 구간 없음) */
+    double phi[RTS_N][RTS_N];  /**< 진행 중 구간의 누적 전이 */
+    RtsRecord *chunk;          /**< 쓰기 묶음 */
+    uint32_t fill;
+    FILE *hist;
+    uint64_t steps;
+
+    uint32_t imu_samples;
+    uint32_t imu_gaps;
+    uint32_t updates[4];       /**< 기압, 자력계, GNSS, 거부 */
+} Forward;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 압축 공분산과 밀집 배정밀도 행렬 변환
+ */
+static void sym_to_dense(const float *s, double d[RTS_N][RTS_N]) {
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        for (uint8_t j = i; j < RTS_N; j++) {
+            d[i][j] = d[j][i] = s[EKF_SYM_FN(index)(i, j)];
+        }
+    }
+}
+
+
+/**
+ * @brief 전이 관찰: 구간 누적 전이에 F = I + E를 왼쪽에서 곱함
+ */
+static void forward_observe(void *context, const MatrixSparseTransition *F, float dt) {
+    (void)dt;
+    Forward *fw = context;
+    if (fw->pending == 0) {
+        return;
+    }
+
+    double delta[MATRIX_SPARSE_TRANSITION_MAX_ROWS][RTS_N];
+    for (uint8_t r = 0; r < F->count; r++) {
+        const MatrixSparseRow *e = &F->e[r];
+        for (uint8_t j = 0; j < RTS_N; j++) {
+            double sum = 0.0;
+            for (uint8_t k = 0; k < e->count; k++) {
+                sum += (double)e->value[k] * fw->phi[e->index[k]][j];
+            }
+            delta[r][j] = sum;
+        }
+    }
+    for (uint8_t r = 0; r < F->count; r++) {
+        for (uint8_t j = 0; j < RTS_N; j++) {
+            fw->phi[F->row[r]][j] += delta[r][j];
+        }
+    }
+}
+
+/**
+ * @brief 진행 중 구간 닫기 (사전 상태 기록, 묶음이 차면 파일에 씀)
+ */
+static bool forward_close(Forward *fw) {
+    if (fw->pending == 0) {
+        return true;
+    }
+
+    RtsRecord *rec = &fw->chunk[fw->fill];
+    rec->t_next_us = fw->last_imu_us;
+    memcpy(rec->x_b, ekf_get_state_data(&fw->ekf), sizeof(rec->x_b));
+    memcpy(rec->P_b, fw->ekf.P.data, sizeof(rec->P_b));
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        for (uint8_t j = 0; j < RTS_N; j++) {
+            rec->phi[i * RTS_N + j] = (float)fw->phi[i][j];
+        }
+    }
+    fw->pending = 0;
+    fw->steps++;
+
+    if (++fw->fill == RTS_CHUNK_STEPS) {
+        if (fwrite(fw->chunk, sizeof(RtsRecord), fw->fill, fw->hist) != fw->fill) {
+            return false;
+        }
+        fw->fill = 0;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 첫 IMU 샘플로 필터 초기화 (정지 가정, 비력 방향으로 수평 자세)
+ */
+static void forward_start_filter(Forward *fw, Vector3f accel) {
+    float roll = atan2f(accel.y, accel.z);
+    float pitch = atan2f(-accel.x, sqrtf(accel.y * accel.y + accel.z * accel.z));
+    ekf_set_initial_state(&fw->ekf, vector3f_zero(), vector3f_zero(), quaternion_from_euler(roll, pitch, 0.0f));
+    fw->filter_ready = true;
+}
+
+/**
+ * @brief IMU 샘플 처리
+ */
+static bool forward_imu(Forward *fw, uint32_t t_us, const float gyro[3], const float accel[3]) {
+    Vector3f g = vector3f_create(gyro[0], gyro[1], gyro[2]);
+    Vector3f a = vector3f_create(accel[0], accel[1], accel[2]);
+    fw->imu_samples++;
+    if (!fw->filter_ready) {
+        forward_start_filter(fw, a);
+    }
+    if (!fw->have_imu) {
+        fw->have_imu = true;
+        fw->last_imu_us = t_us;
+        return true;
+    }
+
+    float dt = (float)(int32_t)(t_us - fw->last_imu_us) * 1e-6f;
+    if (!(dt > 0.0f) || dt > RTS_MAX_IMU_GAP) {
+        // 시각 역행이나 긴 공백은 구간을 끊고 시각만 맞춤
+        fw->imu_gaps++;
+        fw->last_imu_us = t_us;
+        return forward_close(fw);
+    }
+
+    if (fw->pending == 0) {
+        RtsRecord *rec = &fw->chunk[fw->fill];
+        rec->t_us = fw->last_imu_us;
+        memcpy(rec->x_a, ekf_get_state_data(&fw->ekf), sizeof(rec->x_a));
+        memcpy(rec->P_a, fw->ekf.P.data, sizeof(rec->P_a));
+        memset(fw->phi, 0, sizeof(fw->phi));
+        for (uint8_t i = 0; i < RTS_N; i++) {
+            fw->phi[i][i] = 1.0;
+        }
+    }
+    fw->pending++;
+    ekf_predict(&fw->ekf, g, a, dt);
+    fw->last_imu_us = t_us;
+
+    return fw->pending < fw->batch || forward_close(fw);
+}
+
+/**
+ * @brief 보조 측정 갱신 (진행 중 구간을 닫은 뒤 사후 상태에 반영)
+ */
+static void forward_count(Forward *fw, int kind, bool ok) {
+    fw->updates[ok ? kind : 3]++;
+}
+
+static bool forward_baro(Forward *fw, float pressure_pa, float temp_c) {
+    float alt;
+    if (!fw->filter_ready || !baro_altitude_update(&fw->baro, pressure_pa, temp_c, &alt)) {
+        return true;
+    }
+    if (!forward_close(fw)) {
+        return false;
+    }
+    forward_count(fw, 0, ekf_update_baro(&fw->ekf, alt));
+
+    return true;
+}
+
+static bool forward_mag(Forward *fw, const float field[3]) {
+    if (!fw->filter_ready) {
+        return true;
+    }
+    if (!forward_close(fw)) {
+        return false;
+    }
+    Vector3f m = vector3f_create(field[0] * RTS_UT_TO_GAUSS, field[1] * RTS_UT_TO_GAUSS, field[2] * RTS_UT_TO_GAUSS);
+    forward_count(fw, 1, ekf_update_mag(&fw->ekf, m));
+
+    return true;
+}
+
+static bool forward_gnss(Forward *fw, const GroundGnss *gnss) {
+    if (!fw->filter_ready || gnss->fix_type < RTS_GNSS_MIN_FIX || (gnss->flags & 0x01u) == 0) {
+        return true;
+    }
+    if (!fw->geo_ready) {
+        if (!geodetic_init(&fw->geo, gnss->lat_e7, gnss->lon_e7, gnss->height_mm, GEODETIC_DEFAULT_RECENTER_RADIUS)) {
+            return true;
+        }
+        ekf_initialize_magnetic_field_from_location(&fw->ekf, (float)gnss->lat_e7 * 1e-7f,
+                                                    (float)gnss->lon_e7 * 1e-7f);
+        fw->geo_ready = true;
+    }
+
+    Vector3f ned;
+    if (!geodetic_to_ned(&fw->geo, gnss->lat_e7, gnss->lon_e7, gnss->height_mm, &ned)) {
+        return true;
+    }
+    if (!forward_close(fw)) {
+        return false;
+    }
+    Vector3f pos = vector3f_create(ned.x, ned.y, -ned.z);
+    Vector3f vel = vector3f_create(gnss->vel_ned[0], gnss->vel_ned[1], -gnss->vel_ned[2]);
+    forward_count(fw, 2, ekf_update_gps(&fw->ekf, pos, true, vel));
+
+    return true;
+}
+
+/**
+ * @brief 레코드 하나 처리
+ */
+static bool forward_record(Forward *fw, GroundStreams *streams, const GroundRecord *rec) {
+    GroundImu imu;
+    GroundBaro baro;
+    GroundMag mag;
+    GroundGnss gnss;
+    GroundSample s;
+
+    if (ground_record_imu(rec, &imu)) {
+        return forward_imu(fw, imu.timestamp_us, imu.gyro, imu.accel);
+    }
+    if (ground_record_baro(rec, &baro)) {
+        return forward_baro(fw, baro.pressure_pa, baro.temp_c);
+    }
+    if (ground_record_mag(rec, &mag)) {
+        return forward_mag(fw, mag.field);
+    }
+    if (ground_record_gnss(rec, &gnss)) {
+        return forward_gnss(fw, &gnss);
+    }
+    if (ground_stream_decode(streams, rec, &s) && s.stream->field_count == 6 && strcmp(s.stream->name, "imu") == 0) {
+        float v[6];
+        for (uint8_t i = 0; i < 6; i++) {
+            v[i] = (float)ground_sample_value(&s, i);
+        }
+        return forward_imu(fw, s.t_us, &v[0], &v[3]);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 앞 단계: 기록 전체를 추정하며 이력 파일 작성
+ */
+static bool forward_run(Forward *fw, const uint8_t *image, size_t size, long session, RtsHeader *header) {
+    static GroundLog log;
+    static GroundStreams streams;
+    ground_log_open(&log, image, size);
+    ground_streams_init(&streams);
+
+    memset(header, 0, sizeof(*header));
+    if (fwrite(header, sizeof(*header), 1, fw->hist) != 1) {
+        return false;
+    }
+
+    GroundBlock block;
+    while (ground_log_next(&log, &block)) {
+        if (block.index) {
+            continue;
+        }
+        // 세션을 지정하지 않으면 첫 유효 블록의 세션만 씀
+        if (session < 0) {
+            session = block.header.session;
+        }
+        if (block.header.session != (uint32_t)session) {
+            continue;
+        }
+
+        ground_streams_begin_block(&streams);
+        uint32_t o = FLASH_LOG_BLOCK_HEADER_SIZE;
+        GroundRecord rec;
+        while (ground_block_next_record(&block, &o, &rec)) {
+            if (!forward_record(fw, &streams, &rec)) {
+                return false;
+            }
+        }
+    }
+    if (!forward_close(fw) ||
+        (fw->fill > 0 && fwrite(fw->chunk, sizeof(RtsRecord), fw->fill, fw->hist) != fw->fill)) {
+        return false;
+    }
+
+    header->magic = RTS_MAGIC;
+    header->version = RTS_VERSION;
+    header->state_dim = RTS_N;
+    header->record_size = sizeof(RtsRecord);
+    header->chunk_steps = RTS_CHUNK_STEPS;
+    header->steps = fw->steps;
+    header->t_end_us = fw->last_imu_us;
+    memcpy(header->x_end, ekf_get_state_data(&fw->ekf), sizeof(header->x_end));
+    memcpy(header->P_end, fw->ekf.P.data, sizeof(header->P_end));
+
+    return fseeko(fw->hist, 0, SEEK_SET) == 0 && fwrite(header, sizeof(*header), 1, fw->hist) == 1 &&
+           fflush(fw->hist) == 0;
+}
+
+/**
+ * @brief Cholesky 분해 (하삼각 L, 실패하면 false)
+ */
+static bool cholesky(const double A[RTS_N][RTS_N], double jitter, double L[RTS_N][RTS_N]) {
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        for (uint8_t j = 0; j <= i; j++) {
+            double sum = A[i][j] + ((i == j) ? jitter : 0.0);
+            for (uint8_t k = 0; k < j; k++) {
+                sum -= L[i][k] * L[j][k];
+            }
+            if (i == j) {
+                if (!(sum > 0.0)) {
+                    return false;
+                }
+                L[i][i] = sqrt(sum);
+            } else {
+                L[i][j] = sum / L[j][j];
+            }
+        }
+        for (uint8_t j = i + 1; j < RTS_N; j++) {
+            L[i][j] = 0.0;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 평활 상태
+ */
+typedef struct {
+    double xs[RTS_N];
+    double Ps[RTS_N][RTS_N];
+    uint32_t jitter_steps;     /**< 대각 보정이 필요했던 구간 수 */
+    uint32_t failed_steps;     /**< 분해하지 못해 앞 단계 값을 그대로 쓴 구간 수 */
+} Smoother;
+
+/**
+ * @brief 사원수 원소 정규화
+ */
+static void normalize_quat(double *x) {
+    double n = sqrt(x[EKF_STATE_QUAT_W] * x[EKF_STATE_QUAT_W] + x[EKF_STATE_QUAT_X] * x[EKF_STATE_QUAT_X] +
+                    x[EKF_STATE_QUAT_Y] * x[EKF_STATE_QUAT_Y] + x[EKF_STATE_QUAT_Z] * x[EKF_STATE_QUAT_Z]);
+    if (n > 0.0) {
+        for (uint8_t i = EKF_STATE_QUAT_W; i <= EKF_STATE_QUAT_Z; i++) {
+            x[i] /= n;
+        }
+    }
+}
+
+/**
+ * @brief RTS 한 구간 (사후/사전 기록과 다음 구간 평활 값 → 이번 구간 평활 값)
+ */
+static void smooth_step(Smoother *sm, const RtsRecord *rec) {
+    static double Pa[RTS_N][RTS_N];
+    static double Pb[RTS_N][RTS_N];
+    static double L[RTS_N][RTS_N];
+    static double C[RTS_N][RTS_N];
+    static double D[RTS_N][RTS_N];
+    sym_to_dense(rec->P_a, Pa);
+    sym_to_dense(rec->P_b, Pb);
+
+    double scale = 0.0;
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        scale = fmax(scale, Pb[i][i]);
+    }
+    double jitter = 0.0;
+    int tries = 0;
+    while (!cholesky(Pb, jitter, L)) {
+        if (++tries > RTS_JITTER_TRIES) {
+            // 이번 구간은 평활하지 않음 (앞 단계 사후 값에서 다시 시작)
+            for (uint8_t i = 0; i < RTS_N; i++) {
+                sm->xs[i] = rec->x_a[i];
+                for (uint8_t j = 0; j < RTS_N; j++) {
+                    sm->Ps[i][j] = Pa[i][j];
+                }
+            }
+            sm->failed_steps++;
+            return;
+        }
+        jitter = (jitter == 0.0) ? scale * 1e-12 : jitter * 10.0;
+    }
+    if (tries > 0) {
+        sm->jitter_steps++;
+    }
+
+    // C^T = P_b^-1 (Φ P_a): 열마다 L L^T y = b
+    for (uint8_t c = 0; c < RTS_N; c++) {
+        double y[RTS_N];
+        for (uint8_t i = 0; i < RTS_N; i++) {
+            double b = 0.0;
+            for (uint8_t k = 0; k < RTS_N; k++) {
+                b += (double)rec->phi[i * RTS_N + k] * Pa[k][c];
+            }
+            for (uint8_t k = 0; k < i; k++) {
+                b -= L[i][k] * y[k];
+            }
+            y[i] = b / L[i][i];
+        }
+        for (int i = RTS_N - 1; i >= 0; i--) {
+            double b = y[i];
+            for (uint8_t k = (uint8_t)(i + 1); k < RTS_N; k++) {
+                b -= L[k][i] * y[k];
+            }
+            y[i] = b / L[i][i];
+        }
+        for (uint8_t i = 0; i < RTS_N; i++) {
+            C[c][i] = y[i];
+        }
+    }
+
+    // xs = x_a + C (xs' - x_b)
+    double dx[RTS_N];
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        dx[i] = sm->xs[i] - rec->x_b[i];
+    }
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        double sum = rec->x_a[i];
+        for (uint8_t k = 0; k < RTS_N; k++) {
+            sum += C[i][k] * dx[k];
+        }
+        sm->xs[i] = sum;
+    }
+    normalize_quat(sm->xs);
+
+    // Ps = P_a + C (Ps' - P_b) C^T
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        for (uint8_t j = 0; j < RTS_N; j++) {
+            double sum = 0.0;
+            for (uint8_t k = 0; k < RTS_N; k++) {
+                sum += C[i][k] * (sm->Ps[k][j] - Pb[k][j]);
+            }
+            D[i][j] = sum;
+        }
+    }
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        for (uint8_t j = i; j < RTS_N; j++) {
+            double sum = Pa[i][j];
+            for (uint8_t k = 0; k < RTS_N; k++) {
+                sum += D[i][k] * C[j][k];
+            }
+            sm->Ps[i][j] = sm->Ps[j][i] = sum;
+        }
+    }
+}
+
+/**
+ * @brief 평활 결과 한 점 채우기
+ */
+static void fill_output(RtsOutput *out, uint32_t t_us, const Smoother *sm, const float *xf, const float *Pf) {
+    out->t_us = t_us;
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        out->xs[i] = (float)sm->xs[i];
+        out->vs[i] = (float)sm->Ps[i][i];
+        out->xf[i] = xf[i];
+        out->vf[i] = Pf[EKF_SYM_FN(index)(i, i)];
+    }
+}
+
+/**
+ * @brief 뒤 단계: 이력을 끝에서부터 묶음 단위로 읽어 평활 결과 파일 작성
+ */
+static bool backward_run(FILE *hist, const RtsHeader *header, FILE *out, Smoother *sm) {
+    static RtsRecord chunk[RTS_CHUNK_STEPS];
+    static RtsOutput result[RTS_CHUNK_STEPS];
+    uint64_t steps = header->steps;
+
+    static double P_end[RTS_N][RTS_N];
+    sym_to_dense(header->P_end, P_end);
+    for (uint8_t i = 0; i < RTS_N; i++) {
+        sm->xs[i] = header->x_end[i];
+        memcpy(sm->Ps[i], P_end[i], sizeof(sm->Ps[i]));
+    }
+    RtsOutput last;
+    fill_output(&last, header->t_end_us, sm, header->x_end, header->P_end);
+    if (fseeko(out, (off_t)(steps * sizeof(RtsOutput)), SEEK_SET) != 0 || fwrite(&last, sizeof(last), 1, out) != 1) {
+        return false;
+    }
+
+    uint64_t end = steps;
+    while (end > 0) {
+        uint64_t start = (end > RTS_CHUNK_STEPS) ? end - RTS_CHUNK_STEPS : 0;
+        size_t n = (size_t)(end - start);
+        if (fseeko(hist, (off_t)(sizeof(RtsHeader) + start * sizeof(RtsRecord)), SEEK_SET) != 0 ||
+            fread(chunk, sizeof(RtsRecord), n, hist) != n) {
+            return false;
+        }
+        for (size_t k = n; k-- > 0;) {
+            smooth_step(sm, &chunk[k]);
+            fill_output(&result[k], chunk[k].t_us, sm, chunk[k].x_a, chunk[k].P_a);
+        }
+        if (fseeko(out, (off_t)(start * sizeof(RtsOutput)), SEEK_SET) != 0 ||
+            fwrite(result, sizeof(RtsOutput), n, out) != n) {
+            return false;
+        }
+        end = start;
+    }
+
+    return fflush(out) == 0;
+}
+
+/**
+ * @brief 평활 결과를 앞으로 읽어 CSV 출력, 평활/앞 단계 표준 편차 평균 누적
+ */
+static bool write_csv(FILE *res, uint64_t count, uint32_t decimation, FILE *csv, double sd_sum[4]) {
+    static RtsOutput chunk[RTS_CHUNK_STEPS];
+    if (fseeko(res, 0, SEEK_SET) != 0) {
+        return false;
+    }
+
+    fprintf(csv, "t_us,pos_x,pos_y,pos_z,vel_x,vel_y,vel_z,qw,qx,qy,qz,sd_pos_x,sd_pos_y,sd_pos_z,"
+                 "sd_vel_x,sd_vel_y,sd_vel_z,f_pos_x,f_pos_y,f_pos_z,f_vel_x,f_vel_y,f_vel_z,f_sd_pos_z,f_sd_vel_z\n");
+    for (uint64_t base = 0; base < count; base += RTS_CHUNK_STEPS) {
+        size_t n = (size_t)((count - base > RTS_CHUNK_STEPS) ? RTS_CHUNK_STEPS : count - base);
+        if (fread(chunk, sizeof(RtsOutput), n, res) != n) {
+            return false;
+        }
+        for (size_t k = 0; k < n; k++) {
+            const RtsOutput *o = &chunk[k];
+#if EKF_CONFIG_POSITION
+            sd_sum[0] += sqrt(fmax(o->vs[EKF_STATE_POS_Z], 0.0f));
+            sd_sum[1] += sqrt(fmax(o->vf[EKF_STATE_POS_Z], 0.0f));
+#endif
+            sd_sum[2] += sqrt(fmax(o->vs[EKF_STATE_VEL_Z], 0.0f));
+            sd_sum[3] += sqrt(fmax(o->vf[EKF_STATE_VEL_Z], 0.0f));
+            if ((base + k) % decimation != 0) {
+                continue;
+            }
+
+            // 위치 블록이 없는 구성은 위치 열을 0으로 채움
+            double pos[3] = { 0.0, 0.0, 0.0 };
+            double sp[3] = { 0.0, 0.0, 0.0 };
+            double fpos[3] = { 0.0, 0.0, 0.0 };
+            double fsp = 0.0;
+#if EKF_CONFIG_POSITION
+            for (int i = 0; i < 3; i++) {
+                pos[i] = o->xs[EKF_STATE_POS_X + i];
+                sp[i] = sqrt(fmax(o->vs[EKF_STATE_POS_X + i], 0.0f));
+                fpos[i] = o->xf[EKF_STATE_POS_X + i];
+            }
+            fsp = sqrt(fmax(o->vf[EKF_STATE_POS_Z], 0.0f));
+#endif
+            fprintf(csv, "%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.6f,%.6f,%.6f,%.6f,%.4g,%.4g,%.4g,%.4g,%.4g,%.4g,"
+                         "%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4g,%.4g\n",
+                    o->t_us, pos[0], pos[1], pos[2], o->xs[EKF_STATE_VEL_X], o->xs[EKF_STATE_VEL_Y],
+                    o->xs[EKF_STATE_VEL_Z], o->xs[EKF_STATE_QUAT_W], o->xs[EKF_STATE_QUAT_X], o->xs[EKF_STATE_QUAT_Y],
+                    o->xs[EKF_STATE_QUAT_Z], sp[0], sp[1], sp[2], sqrt(fmax(o->vs[EKF_STATE_VEL_X], 0.0f)),
+                    sqrt(fmax(o->vs[EKF_STATE_VEL_Y], 0.0f)), sqrt(fmax(o->vs[EKF_STATE_VEL_Z], 0.0f)),
+                    fpos[0], fpos[1], fpos[2], o->xf[EKF_STATE_VEL_X], o->xf[EKF_STATE_VEL_Y],
+                    o->xf[EKF_STATE_VEL_Z], fsp, sqrt(fmax(o->vf[EKF_STATE_VEL_Z], 0.0f)));
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 앞 단계 상태 초기화
+ */
+static bool forward_init(Forward *fw, uint32_t batch, FILE *hist) {
+    static RtsRecord chunk[RTS_CHUNK_STEPS];
+    memset(fw, 0, sizeof(*fw));
+    fw->batch = batch;
+    fw->chunk = chunk;
+    fw->hist = hist;
+
+    return ekf_init(&fw->ekf) && scratch_init(&fw->scratch, fw->scratch_buffer, sizeof(fw->scratch_buffer)) &&
+           ekf_set_scratch_arena(&fw->ekf, &fw->scratch) && ekf_initialize_default_magnetic_field(&fw->ekf) &&
+           ekf_set_transition_observer(&fw->ekf, forward_observe, fw) &&
+           baro_altitude_init(&fw->baro, BARO_ALTITUDE_DEFAULT_GROUND_SAMPLES, 0.0f);
+}
+
+int main(int argc, char **argv) {
+    uint32_t batch = RTS_DEFAULT_BATCH;
+    uint32_t decimation = RTS_DEFAULT_DECIMATION;
+    long session = -1;
+    const char *hist_path = NULL;
+    const char *out_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:b:d:H:o:")) != -1) {
+        switch (opt) {
+        case 's':
+            session = strtol(optarg, NULL, 0);
+            break;
+        case 'b':
+            batch = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'd':
+            decimation = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'H':
+            hist_path = optarg;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc - 1 || batch == 0 || decimation == 0) {
+        fprintf(stderr, "사용법: %s [-s 세션] [-b batch] [-d decimation] [-H history.bin] [-o smooth.csv] flash.bin\n",
+                argv[0]);
+        return 1;
+    }
+
+    int fd = open(argv[optind], O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+    size_t size = (size_t)st.st_size;
+    const uint8_t *image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (image == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    madvise((void *)image, size, MADV_SEQUENTIAL);
+
+    FILE *hist = (hist_path != NULL) ? fopen(hist_path, "w+b") : tmpfile();
+    FILE *res = tmpfile();
+    FILE *csv = (out_path != NULL) ? fopen(out_path, "w") : stdout;
+    if (hist == NULL || res == NULL || csv == NULL) {
+        perror("파일 열기");
+        return 1;
+    }
+
+    static Forward fw;
+    static RtsHeader header;
+    if (!forward_init(&fw, batch, hist)) {
+        fprintf(stderr, "필터 초기화 실패\n");
+        return 1;
+    }
+    double t0 = now_s();
+    if (!forward_run(&fw, image, size, session, &header)) {
+        fprintf(stderr, "이력 쓰기 실패\n");
+        return 1;
+    }
+    munmap((void *)image, size);
+    close(fd);
+    double t1 = now_s();
+
+    static Smoother sm;
+    if (!backward_run(hist, &header, res, &sm)) {
+        fprintf(stderr, "평활 실패\n");
+        return 1;
+    }
+    double t2 = now_s();
+
+    double sd_sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+    uint64_t count = header.steps + 1u;
+    if (!write_csv(res, count, decimation, csv, sd_sum)) {
+        fprintf(stderr, "출력 실패\n");
+        return 1;
+    }
+    fclose(res);
+    fclose(hist);
+    if (csv != stdout) {
+        fclose(csv);
+    }
+
+    fprintf(stderr, "IMU %u (공백 %u), 갱신 기압 %u 자력계 %u GNSS %u 거부 %u\n", fw.imu_samples, fw.imu_gaps,
+            fw.updates[0], fw.updates[1], fw.updates[2], fw.updates[3]);
+    fprintf(stderr, "구간 %llu개, 이력 %.1f MB (묶음 %u구간, %.0f KB), 대각 보정 %u, 평활 생략 %u\n",
+            (unsigned long long)header.steps,
+            (double)(sizeof(RtsHeader) + header.steps * sizeof(RtsRecord)) / 1e6, RTS_CHUNK_STEPS,
+            (double)(RTS_CHUNK_STEPS * sizeof(RtsRecord)) / 1e3, sm.jitter_steps, sm.failed_steps);
+    fprintf(stderr, "평균 표준 편차 pos_z %.3f -> %.3f m, vel_z %.3f -> %.3f m/s (앞 단계 -> 평활)\n",
+            sd_sum[1] / count, sd_sum[0] / count, sd_sum[3] / count, sd_sum[2] / count);
+    fprintf(stderr, "앞 단계 %.2f s, 뒤 단계 %.2f s\n", t1 - t0, t2 - t1);
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file trace_decode.c
+ * @brief 이벤트 트레이스 복원 프로그램 (호스트용)
+ *
+ * SWO로 받은 ITM 바이트열(예: OpenOCD "itm port 1 on" + tpiu 파일, J-Link SWOViewer 원시 저장)
+ * 또는 trace_dump의 텍스트 출력(UART 캡처, "trace" 머리 줄과 "T" 줄)을 읽어 Chrome 트레이스
+ * JSON을 표준 출력에 쓴다. chrome://tracing 또는 ui.perfetto.dev에서 연다.
+ * 워드 형식과 이벤트 번호는 Core/Inc/sys/trace.h를 따른다. 펌웨어 헤더는 HAL에 의존하므로
+ * 필요한 상수만 여기에 다시 적는다.
+ *
+ * 24비트 사이클 시각은 앞 이벤트와의 차이로 이어 붙이므로, 이벤트 사이 간격이
+ * 2^24 사이클(80 MHz에서 약 210 ms)보다 길면 시간축이 어긋난다. 짝이 없는 끝 표시
+ * (링이 단계 중간에서 시작한 경우)는 버린다. 이벤트별 횟수와 최대/평균 시간은 표준 오류로 알린다.
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -o trace_decode Tools/trace/trace_decode.c
+ *   ./trace_decode swo.bin > trace.json
+ *   ./trace_decode -c 80000000 uart.txt > trace.json
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * @brief 트레이스 형식 (trace.h)
+ */
+#define TRACE_ITM_PORT 1u
+#define TRACE_MAX_EVENTS 128u
+#define TRACE_WRAP (1u << 24)
+
+/**
+ * @brief 기본 코어 클록 (Hz)
+ */
+#define DEFAULT_CLOCK_HZ 80000000.0
+
+/**
+ * @brief 이벤트 이름과 표시 줄 (TraceEvent 순서)
+ */
+typedef struct {
+    const char *name;
+    int tid;
+} EventInfo;
+
+static const EventInfo events[] = {
+    { "imu_isr", 1 },
+    { "cycle", 2 },
+    { "predict", 2 },
+    { "update_gps", 2 },
+    { "update_baro", 2 },
+    { "update_mag", 2 },
+    { "update_heading", 2 },
+    { "update_coincident", 2 },
+    { "log_service", 3 },
+    { "log_flush", 4 },
+};
+
+#define EVENT_COUNT (sizeof(events) / sizeof(events[0]))
+
+static const char *const threads[] = { NULL, "isr", "fusion", "log", "flash" };
+
+/**
+ * @brief 복원 상태
+ */
+typedef struct {
+    double us_per_cycle;
+    bool has_time;
+    uint32_t last24;
+    uint64_t cycles;
+    bool first_event;
+    uint32_t depth[TRACE_MAX_EVENTS];
+    uint64_t begin[TRACE_MAX_EVENTS];
+    uint32_t count[TRACE_MAX_EVENTS];
+    uint64_t max_cycles[TRACE_MAX_EVENTS];
+    uint64_t total_cycles[TRACE_MAX_EVENTS];
+    uint32_t unmatched;
+    uint32_t overflows;
+} Decoder;
+
+static void event_name(uint32_t id, char *buf, size_t len) {
+    if (id < EVENT_COUNT) {
+        snprintf(buf, len, "%s", events[id].name);
+    } else {
+        snprintf(buf, len, "event%u", id);
+    }
+}
+
+/**
+ * @brief 이벤트 워드 하나 처리
+ */
+static void decode_word(Decoder *d, uint32_t word) {
+    uint32_t t24 = word >> 8;
+    uint32_t id = (word >> 1) & 0x7Fu;
+    bool end = (word & 1u) != 0;
+
+    if (d->has_time) {
+        d->cycles += (t24 - d->last24) & (TRACE_WRAP - 1u);
+    }
+    d->last24 = t24;
+    d->has_time = true;
+
+    if (end) {
+        if (d->depth[id] == 0) {
+            d->unmatched++;
+            return;
+        }
+        d->depth[id]--;
+        uint64_t dur = d->cycles - d->begin[id];
+        d->count[id]++;
+        d->total_cycles[id] += dur;
+        if (dur > d->max_cycles[id]) {
+            d->max_cycles[id] = dur;
+        }
+    } else {
+        // 같은 이벤트가 겹치면 (재진입) 가장 바깥 시작만 통계에 씀
+        if (d->depth[id]++ == 0) {
+            d->begin[id] = d->cycles;
+        }
+    }
+
+    char name[32];
+    event_name(id, name, sizeof(name));
+    printf("%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+           d->first_event ? "" : ",", name, end ? 'E' : 'B', (double)d->cycles * d->us_per_cycle,
+           (id < EVENT_COUNT) ? events[id].tid : 0);
+    d->first_event = false;
+}
+
+/**
+ * @brief trace_dump 텍스트 출력 처리 ("T" 줄의 16진수 워드)
+ */
+static void decode_text(Decoder *d, FILE *f) {
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] != 'T' || line[1] != ' ') {
+            continue;
+        }
+        char *p = &line[1];
+        char *next;
+        for (;;) {
+            unsigned long word = strtoul(p, &next, 16);
+            if (next == p) {
+                break;
+            }
+            decode_word(d, (uint32_t)word);
+            p = next;
+        }
+    }
+}
+
+/**
+ * @brief ITM 바이트열 처리 (포트 TRACE_ITM_PORT의 4바이트 소프트웨어 패킷만 사용)
+ */
+static void decode_itm(Decoder *d, FILE *f) {
+    int h;
+    while ((h = fgetc(f)) != EOF) {
+        if (h == 0x00 || h == 0x80) {
+            continue;  // 동기 패킷 (0 바이트 뒤 0x80)
+        }
+        if (h == 0x70) {
+            d->overflows++;
+            continue;
+        }
+        if ((h & 0x03) == 0) {
+            // 시각/확장 패킷: 연속 비트가 있으면 뒤따르는 바이트를 건너뜀
+            int b = h;
+            while ((b & 0x80) != 0 && (b = fgetc(f)) != EOF) {
+            }
+            continue;
+        }
+
+        uint32_t size = ((h & 0x03) == 3) ? 4u : (uint32_t)(h & 0x03);
+        uint32_t value = 0;
+        for (uint32_t k = 0; k < size; k++) {
+            int b = fgetc(f);
+            if (b == EOF) {
+                return;
+            }
+            value |= (uint32_t)b << (8u * k);
+        }
+
+        bool software = (h & 0x04) == 0;
+        if (software && (uint32_t)(h >> 3) == TRACE_ITM_PORT && size == 4u) {
+            decode_word(d, value);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    double clock_hz = DEFAULT_CLOCK_HZ;
+    int arg = 1;
+    if (argc > 3 && strcmp(argv[1], "-c") == 0) {
+        clock_hz = atof(argv[2]);
+        arg = 3;
+    }
+    if (arg >= argc || clock_hz <= 0.0) {
+        fprintf(stderr, "사용법: %s [-c 클록Hz] swo.bin|uart.txt\n", argv[0]);
+        return 1;
+    }
+    FILE *f = fopen(argv[arg], "rb");
+    if (f == NULL) {
+        perror(argv[arg]);
+        return 1;
+    }
+
+    static Decoder d;
+    d.us_per_cycle = 1e6 / clock_hz;
+    d.first_event = true;
+
+    printf("{\"traceEvents\":[");
+    for (int t = 1; t < (int)(sizeof(threads) / sizeof(threads[0])); t++) {
+        printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+               d.first_event ? "" : ",", t, threads[t]);
+        d.first_event = false;
+    }
+
+    // trace_dump 출력은 "trace" 머리 줄이 있음 (앞에 다른 UART 줄이 섞여 있어도 됨)
+    char probe[512];
+    size_t n = fread(probe, 1, sizeof(probe) - 1u, f);
+    probe[n] = '\0';
+    rewind(f);
+    if (strstr(probe, "trace n=") != NULL) {
+        decode_text(&d, f);
+    } else {
+        decode_itm(&d, f);
+    }
+    fclose(f);
+    printf("\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    for (uint32_t id = 0; id < TRACE_MAX_EVENTS; id++) {
+        if (d.count[id] == 0) {
+            continue;
+        }
+        char name[32];
+        event_name(id, name, sizeof(name));
+        fprintf(stderr, "%-18s n=%u max=%.1f us mean=%.1f us\n", name, d.count[id],
+                (double)d.max_cycles[id] * d.us_per_cycle,
+                (double)d.total_cycles[id] / d.count[id] * d.us_per_cycle);
+    }
+    if (d.unmatched > 0 || d.overflows > 0) {
+        fprintf(stderr, "짝 없는 끝 표시 %u, ITM 넘침 %u\n", d.unmatched, d.overflows);
+    }
+
+    return 0;
+}
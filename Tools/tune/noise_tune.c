@@ -0,0 +1,680 @@
+/**
+ * @file noise_tune.c
+ * @brief 필터 잡음(Q/R) 자동 조정기 (호스트용, 재생기 병렬 실행)
+ *
+ * 합성 비행(sim_model, 시드별)이나 비행 기록 파일을 한 번만 읽어 메모리 안 레코드 열
+ * (ReplayTape)로 두고, 후보 잡음 설정마다 모든 비행을 replay로 다시 추정해 목적 함수를 구한다.
+ * 잡음 아홉 개(ekf_set_process_noise 다섯 개, ekf_set_gps_noise 두 개, ekf_set_baro_noise,
+ * ekf_set_mag_noise)를 로그 눈금에서 Nelder-Mead로 찾는다. 반복마다 반사/확장/바깥 수축/
+ * 안쪽 수축 네 후보를 미리 함께 평가하므로(축소는 n개) 한 번에 (후보 x 비행)개의 재생을
+ * 작업자 스레드에 나눈다. 레코드 열은 읽기만 하고 재생기(필터, 스케줄러, scratch)는 작업마다
+ * 따로 두므로 결과는 작업자 수와 관계없이 같다 (-T로 확인).
+ *
+ * 비행 하나의 목적 함수 (작을수록 좋음):
+ *   J = (ln(NEES / 6))^2 + w_pos ln(pos_rms) + w_nis sum_s min(|ln(NIS_s / dof_s)|, 2)^2
+ * NEES와 위치 RMS는 기록된 항법 해가 참값일 때만 쓴다 (합성 비행, -r로 지정한 기록).
+ * 실제 비행 기록의 항법 해는 탑재 필터 출력이므로 기본은 NIS 항만 쓴다. 센서별 NIS는
+ * 갱신이 있었던 측정(GNSS 위치/속도, 기압, 자력계)만 더한다. 재생이 실패하거나 값이 유한하지
+ * 않으면 TUNE_FAIL_COST로 센다. 후보의 목적 함수는 비행 평균이다.
+ *
+ * 출력 (보정 레코드, -o 또는 표준 출력): 한 줄에 "이름=값" 하나, 잡음 값은 ReplayNoise와
+ * nav/filter_engine.h FilterEngineConfig의 같은 이름 항목(각 설정 함수의 단위)이다.
+ * 표준 오류에는 반복 경과, 시작/최종 지표, 재생 수와 후보당 처리 시간을 쓴다.
+ *
+ * 빌드 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -pthread -ICore/Inc -ITools/replay -ITools/sim -o noise_tune Tools/tune/noise_tune.c \
+ *       Tools/sim/sim_model.c Tools/replay/replay.c \
+ *       $(find Core/Src/math Core/Src/ekf -name '*.c') Core/Src/sys/scratch.c \
+ *       Core/Src/nav/fusion_scheduler.c Core/Src/nav/fusion_monitor.c Core/Src/nav/flight_phase.c \
+ *       Core/Src/nav/event_detector.c Core/Src/nav/nav_publisher.c Core/Src/nav/geodetic.c \
+ *       Core/Src/nav/convergence_monitor.c Core/Src/nav/filter_health.c Core/Src/nav/fixed_lag.c \
+ *       Core/Src/nav/latency_monitor.c Core/Src/nav/predict_rate.c Core/Src/nav/vertical_filter.c \
+ *       Core/Src/sensors/imu_ring.c Core/Src/sensors/baro_altitude.c Core/Src/sensors/baro_isa_table.c \
+ *       Core/Src/sensors/mag_iron_cal.c Core/Src/sensors/static_detector.c Core/Src/sensors/accel_blend.c \
+ *       Core/Src/sensors/gyro_spectrum.c Core/Src/sensors/gyro_notch.c Core/Src/sensors/imu_lever_arm.c \
+ *       Core/Src/sensors/meas_queue.c Core/Src/sensors/mag_average.c Core/Src/sensors/imu_vibration.c -lm
+ *
+ * 실행:
+ *   ./noise_tune [-n 시드 수] [-f 첫 시드] [-t 길이(s)] [-k 잡음 배율] [-j 작업자 수] [-i 반복 수]
+ *                [-w w_pos] [-v w_nis] [-b batch] [-P] [-r] [-T] [-o cal.txt] [flash.bin ...]
+ *   기록 파일을 주면 -n 기본값은 0 (기록만), 주지 않으면 8이다. 기록은 파일마다 첫 유효 블록의
+ *   세션만 쓴다. -P: 비행 단계 상태 기계 없이 추정, -r: 기록의 항법 해를 참값으로 봄,
+ *   -T: 시작점을 작업자 1개와 -j개로 평가해 비트 단위로 같은지 확인 (다르면 종료 코드 2)
+ */
+
+#include "sim_model.h"
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/**
+ * @brief 조정 항목 수와 탐색 범위 (표준 편차, 로그 눈금)
+ */
+#define TUNE_PARAM_COUNT 9
+#define TUNE_MIN_STD 1e-7
+#define TUNE_MAX_STD 1e3
+
+/**
+ * @brief 기본 설정
+ */
+#define TUNE_DEFAULT_SEEDS 8u            /**< 기록 파일이 없을 때 합성 비행 수 */
+#define TUNE_DEFAULT_DURATION 40.0       /**< 합성 비행 길이 (s, 추진과 정점 포함) */
+#define TUNE_DEFAULT_ITERATIONS 150u     /**< 최대 Nelder-Mead 반복 수 */
+#define TUNE_DEFAULT_POS_WEIGHT 2.0      /**< w_pos */
+#define TUNE_DEFAULT_NIS_WEIGHT 1.0      /**< w_nis */
+#define TUNE_INITIAL_STEP 0.7            /**< 시작 단체 폭 (로그 눈금, 약 2배) */
+#define TUNE_TOLERANCE 1e-4              /**< 단체 안 목적 함수 차 수렴 문턱 */
+#define TUNE_FAIL_COST 100.0             /**< 실패한 비행의 목적 함수 */
+#define TUNE_NIS_LOG_LIMIT 2.0           /**< 센서별 |ln(NIS / dof)| 상한 (측정 하나가 목적을 덮지 않게) */
+
+/**
+ * @brief Nelder-Mead 계수 (반사, 확장, 수축, 축소)
+ */
+#define TUNE_NM_ALPHA 1.0
+#define TUNE_NM_GAMMA 2.0
+#define TUNE_NM_RHO 0.5
+#define TUNE_NM_SIGMA 0.5
+
+/**
+ * @brief 조정 항목 이름 (ReplayNoise 멤버 순서)
+ */
+static const char *const tune_param_name[TUNE_PARAM_COUNT] = {
+    "pos_std", "vel_std", "att_std", "gyro_bias_std", "accel_bias_std",
+    "gps_pos_std", "gps_vel_std", "baro_std", "mag_std"
+};
+
+/**
+ * @brief 시작점 (ekf_init 기본값: Q 대각 0.01, R_gps 대각 5/0.5, R_baro 1, R_mag 0.1)
+ */
+static const double tune_param_start[TUNE_PARAM_COUNT] = {
+    0.1, 0.1, 0.1, 0.1, 0.1, 2.236, 0.707, 1.0, 0.316
+};
+
+/**
+ * @brief NIS를 보는 측정과 자유도
+ */
+static const EKF_Sensor tune_nis_sensor[] = {
+    EKF_SENSOR_GPS_POS, EKF_SENSOR_GPS_POS_VEL, EKF_SENSOR_BARO, EKF_SENSOR_MAG
+};
+static const double tune_nis_dof[] = { 3.0, 6.0, 1.0, 3.0 };
+#define TUNE_NIS_COUNT (sizeof(tune_nis_dof) / sizeof(tune_nis_dof[0]))
+
+/**
+ * @brief 비행 하나 (메모리 안 레코드 열)
+ */
+typedef struct {
+    ReplayTape tape;
+    bool truth;                /**< 기록된 항법 해가 참값인지 */
+    char name[64];
+} TuneFlight;
+
+/**
+ * @brief 비행 하나의 평가 결과
+ */
+typedef struct {
+    bool ok;
+    double cost;
+    double pos_rms;
+    double nees;
+    double nis[TUNE_NIS_COUNT];
+    uint32_t nis_count[TUNE_NIS_COUNT];
+} TuneScore;
+
+/**
+ * @brief 일괄 평가 작업 (후보 x 비행)
+ */
+typedef struct {
+    const TuneFlight *flights;
+    uint32_t flight_count;
+    const ReplayConfig *base;
+    const double (*theta)[TUNE_PARAM_COUNT];
+    uint32_t count;            /**< 작업 수 (후보 수 x 비행 수) */
+    atomic_uint next;
+    TuneScore *scores;
+    double w_pos;
+    double w_nis;
+} TuneBatch;
+
+/**
+ * @brief 조정 상태
+ */
+typedef struct {
+    TuneFlight *flights;
+    uint32_t flight_count;
+    ReplayConfig base;
+    uint32_t jobs;
+    double w_pos;
+    double w_nis;
+    uint64_t evaluations;      /**< 평가한 후보 수 */
+    uint64_t replays;          /**< 실행한 재생 수 */
+    double wall_s;             /**< 평가에 걸린 시간 (s) */
+} Tuner;
+
+/**
+ * @brief 단조 증가 시계 (ns)
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 로그 눈금 후보를 잡음 설정으로
+ */
+static void tune_to_noise(const double theta[TUNE_PARAM_COUNT], ReplayNoise *noise) {
+    float v[TUNE_PARAM_COUNT];
+    for (int i = 0; i < TUNE_PARAM_COUNT; i++) {
+        double s = exp(theta[i]);
+        v[i] = (float)fmin(fmax(s, TUNE_MIN_STD), TUNE_MAX_STD);
+    }
+    noise->pos_std = v[0];
+    noise->vel_std = v[1];
+    noise->att_std = v[2];
+    noise->gyro_bias_std = v[3];
+    noise->accel_bias_std = v[4];
+    noise->gps_pos_std = v[5];
+    noise->gps_vel_std = v[6];
+    noise->baro_std = v[7];
+    noise->mag_std = v[8];
+}
+
+/**
+ * @brief 비행 하나 재생과 목적 함수
+ */
+static void tune_run_flight(Replay *r, const TuneFlight *flight, const ReplayConfig *config, double w_pos,
+                            double w_nis, TuneScore *score) {
+    memset(score, 0, sizeof(*score));
+    score->cost = TUNE_FAIL_COST;
+    if (!replay_init(r, config, NULL)) {
+        return;
+    }
+    replay_tape_play(r, &flight->tape);
+    replay_finish(r);
+
+    double cost = 0.0;
+    bool ok = true;
+    if (flight->truth) {
+        ReplayMetrics m;
+        if (replay_metrics(r, &m) && m.nees_points > 0 && m.nees_mean > 0.0 && m.pos_rms > 0.0) {
+            score->pos_rms = m.pos_rms;
+            score->nees = m.nees_mean;
+            double ln_nees = log(m.nees_mean / 6.0);
+            cost += ln_nees * ln_nees + w_pos * log(m.pos_rms);
+        } else {
+            ok = false;
+        }
+    }
+    for (size_t s = 0; s < TUNE_NIS_COUNT; s++) {
+        uint32_t n;
+        double nis = ekf_get_innovation_nis_mean(&r->ekf, tune_nis_sensor[s], &n);
+        score->nis[s] = nis;
+        score->nis_count[s] = n;
+        if (n > 0 && nis > 0.0) {
+            double ln_nis = fmin(fmax(log(nis / tune_nis_dof[s]), -TUNE_NIS_LOG_LIMIT), TUNE_NIS_LOG_LIMIT);
+            cost += w_nis * ln_nis * ln_nis;
+        }
+    }
+    replay_free(r);
+
+    if (ok && isfinite(cost)) {
+        score->ok = true;
+        score->cost = cost;
+    }
+}
+
+/**
+ * @brief 작업자 스레드 (재생기 하나를 힙에 두고 작업을 차례로 가져감)
+ */
+static void *tune_worker(void *arg) {
+    TuneBatch *batch = arg;
+    Replay *r = malloc(sizeof(Replay));
+    if (r == NULL) {
+        return NULL;
+    }
+    ReplayConfig config = *batch->base;
+    for (;;) {
+        uint32_t i = atomic_fetch_add(&batch->next, 1u);
+        if (i >= batch->count) {
+            break;
+        }
+        uint32_t c = i / batch->flight_count;
+        uint32_t f = i % batch->flight_count;
+        tune_to_noise(batch->theta[c], &config.noise);
+        tune_run_flight(r, &batch->flights[f], &config, batch->w_pos, batch->w_nis, &batch->scores[i]);
+    }
+    free(r);
+    return batch;
+}
+
+/**
+ * @brief 후보 여러 개를 모든 비행에 대해 병렬 평가
+ *
+ * @param cost 후보별 목적 함수 (비행 평균)
+ * @param scores 작업별 결과 (NULL이면 버림, 아니면 후보 수 x 비행 수)
+ * @return bool 모든 작업자가 재생기를 할당했으면 true
+ */
+static bool tune_evaluate(Tuner *t, const double (*theta)[TUNE_PARAM_COUNT], uint32_t candidates, uint32_t jobs,
+                          double *cost, TuneScore *scores) {
+    uint32_t count = candidates * t->flight_count;
+    TuneScore *own = (scores != NULL) ? scores : malloc(count * sizeof(TuneScore));
+    pthread_t *threads = malloc(jobs * sizeof(pthread_t));
+    if (own == NULL || threads == NULL) {
+        if (scores == NULL) {
+            free(own);
+        }
+        free(threads);
+        return false;
+    }
+
+    TuneBatch batch = { t->flights, t->flight_count, &t->base, theta, count, 0, own, t->w_pos, t->w_nis };
+    uint64_t start = now_ns();
+    bool ok = true;
+    uint32_t started = 0;
+    for (; started < jobs && started < count; started++) {
+        if (pthread_create(&threads[started], NULL, tune_worker, &batch) != 0) {
+            ok = started > 0;
+            break;
+        }
+    }
+    for (uint32_t w = 0; w < started; w++) {
+        void *ret;
+        pthread_join(threads[w], &ret);
+        ok &= ret != NULL;
+    }
+    t->wall_s += (double)(now_ns() - start) * 1e-9;
+    t->evaluations += candidates;
+    t->replays += count;
+
+    // 합은 비행 순서대로 더해 작업자 수와 관계없이 같게 함
+    for (uint32_t c = 0; c < candidates; c++) {
+        double sum = 0.0;
+        for (uint32_t f = 0; f < t->flight_count; f++) {
+            sum += own[c * t->flight_count + f].cost;
+        }
+        cost[c] = sum / (double)t->flight_count;
+    }
+    if (scores == NULL) {
+        free(own);
+    }
+    free(threads);
+    return ok;
+}
+
+/**
+ * @brief 후보 하나의 비행 평균 지표 출력
+ */
+static void tune_report(const Tuner *t, const char *label, double cost, const TuneScore *scores) {
+    double pos = 0.0;
+    double nees = 0.0;
+    uint32_t truth = 0;
+    uint32_t failed = 0;
+    double nis[TUNE_NIS_COUNT] = { 0 };
+    uint32_t nis_flights[TUNE_NIS_COUNT] = { 0 };
+    for (uint32_t f = 0; f < t->flight_count; f++) {
+        const TuneScore *s = &scores[f];
+        if (!s->ok) {
+            failed++;
+            continue;
+        }
+        if (t->flights[f].truth) {
+            pos += s->pos_rms;
+            nees += s->nees;
+            truth++;
+        }
+        for (size_t k = 0; k < TUNE_NIS_COUNT; k++) {
+            if (s->nis_count[k] > 0) {
+                nis[k] += s->nis[k];
+                nis_flights[k]++;
+            }
+        }
+    }
+    fprintf(stderr, "%s: 목적 %.4f, 실패 %u", label, cost, failed);
+    if (truth > 0) {
+        fprintf(stderr, ", 위치 RMS %.3f m, NEES %.2f (6)", pos / truth, nees / truth);
+    }
+    static const char *const nis_name[TUNE_NIS_COUNT] = { "GNSS 위치", "GNSS", "기압", "자력계" };
+    for (size_t k = 0; k < TUNE_NIS_COUNT; k++) {
+        if (nis_flights[k] > 0) {
+            fprintf(stderr, ", NIS %s %.2f (%.0f)", nis_name[k], nis[k] / nis_flights[k], tune_nis_dof[k]);
+        }
+    }
+    fprintf(stderr, "\n");
+}
+
+/**
+ * @brief 단체 정렬 (목적 함수 오름차순, 삽입 정렬)
+ */
+static void tune_sort(double (*x)[TUNE_PARAM_COUNT], double *f, uint32_t n) {
+    for (uint32_t i = 1; i < n; i++) {
+        double fi = f[i];
+        double xi[TUNE_PARAM_COUNT];
+        memcpy(xi, x[i], sizeof(xi));
+        uint32_t j = i;
+        while (j > 0 && f[j - 1] > fi) {
+            f[j] = f[j - 1];
+            memcpy(x[j], x[j - 1], sizeof(xi));
+            j--;
+        }
+        f[j] = fi;
+        memcpy(x[j], xi, sizeof(xi));
+    }
+}
+
+/**
+ * @brief Nelder-Mead 탐색 (반복마다 네 후보를 함께 평가)
+ *
+ * @param x 시작점 (끝나면 최적점)
+ * @param best 최적 목적 함수
+ * @return uint32_t 수행한 반복 수
+ */
+static uint32_t tune_search(Tuner *t, double x[TUNE_PARAM_COUNT], uint32_t iterations, double *best) {
+    const uint32_t n = TUNE_PARAM_COUNT;
+    double simplex[TUNE_PARAM_COUNT + 1][TUNE_PARAM_COUNT];
+    double f[TUNE_PARAM_COUNT + 1];
+    for (uint32_t v = 0; v <= n; v++) {
+        memcpy(simplex[v], x, sizeof(simplex[v]));
+        if (v > 0) {
+            simplex[v][v - 1] += TUNE_INITIAL_STEP;
+        }
+    }
+    tune_evaluate(t, (const double (*)[TUNE_PARAM_COUNT])simplex, n + 1, t->jobs, f, NULL);
+
+    uint32_t it = 0;
+    for (; it < iterations; it++) {
+        tune_sort(simplex, f, n + 1);
+        if (f[n] - f[0] < TUNE_TOLERANCE) {
+            break;
+        }
+        if (it % 10 == 0) {
+            fprintf(stderr, "반복 %3u: 목적 %.4f (최악 %.4f), 후보 %llu개\n", it, f[0], f[n],
+                    (unsigned long long)t->evaluations);
+        }
+
+        double c[TUNE_PARAM_COUNT] = { 0 };
+        for (uint32_t v = 0; v < n; v++) {
+            for (uint32_t k = 0; k < n; k++) {
+                c[k] += simplex[v][k] / (double)n;
+            }
+        }
+
+        // 0: 반사, 1: 확장, 2: 바깥 수축, 3: 안쪽 수축
+        double trial[4][TUNE_PARAM_COUNT];
+        double ft[4];
+        for (uint32_t k = 0; k < n; k++) {
+            double d = c[k] - simplex[n][k];
+            trial[0][k] = c[k] + TUNE_NM_ALPHA * d;
+            trial[1][k] = c[k] + TUNE_NM_GAMMA * TUNE_NM_ALPHA * d;
+            trial[2][k] = c[k] + TUNE_NM_RHO * TUNE_NM_ALPHA * d;
+            trial[3][k] = c[k] - TUNE_NM_RHO * d;
+        }
+        tune_evaluate(t, (const double (*)[TUNE_PARAM_COUNT])trial, 4, t->jobs, ft, NULL);
+
+        int pick = -1;
+        if (ft[0] < f[0]) {
+            pick = (ft[1] < ft[0]) ? 1 : 0;
+        } else if (ft[0] < f[n - 1]) {
+            pick = 0;
+        } else if (ft[0] < f[n]) {
+            pick = (ft[2] <= ft[0]) ? 2 : -1;
+        } else {
+            pick = (ft[3] < f[n]) ? 3 : -1;
+        }
+        if (pick >= 0) {
+            memcpy(simplex[n], trial[pick], sizeof(simplex[n]));
+            f[n] = ft[pick];
+            continue;
+        }
+
+        // 축소: 최적점을 향해 나머지 n개를 당김
+        for (uint32_t v = 1; v <= n; v++) {
+            for (uint32_t k = 0; k < n; k++) {
+                simplex[v][k] = simplex[0][k] + TUNE_NM_SIGMA * (simplex[v][k] - simplex[0][k]);
+            }
+        }
+        tune_evaluate(t, (const double (*)[TUNE_PARAM_COUNT])&simplex[1], n, t->jobs, &f[1], NULL);
+    }
+    tune_sort(simplex, f, n + 1);
+    memcpy(x, simplex[0], sizeof(simplex[0]));
+    *best = f[0];
+
+    return it;
+}
+
+/**
+ * @brief 합성 비행 레코드를 레코드 열에 담음
+ */
+static void tune_emit(uint8_t type, const void *payload, uint8_t len, void *context) {
+    replay_tape_append(context, type, payload, len);
+}
+
+/**
+ * @brief 기록 파일 하나를 레코드 열로 읽기 (첫 유효 블록의 세션만)
+ */
+static bool tune_load_log(const char *path, TuneFlight *flight) {
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror(path);
+        return false;
+    }
+    static uint8_t block[FLASH_LOG_BLOCK_SIZE];
+    long session = -1;
+    bool ok = true;
+    while (ok && fread(block, 1, FLASH_LOG_BLOCK_SIZE, fp) == FLASH_LOG_BLOCK_SIZE) {
+        uint32_t block_session;
+        if (!replay_block_valid(block, &block_session)) {
+            continue;
+        }
+        if (session < 0) {
+            session = block_session;
+        }
+        if (block_session == (uint32_t)session) {
+            ok = replay_tape_add_block(&flight->tape, block);
+        }
+    }
+    fclose(fp);
+    snprintf(flight->name, sizeof(flight->name), "%s", path);
+
+    return ok && flight->tape.records > 0;
+}
+
+/**
+ * @brief 보정 레코드 쓰기
+ */
+static void tune_write_record(FILE *out, const Tuner *t, const double x[TUNE_PARAM_COUNT], double cost,
+                              double start_cost) {
+    ReplayNoise noise;
+    tune_to_noise(x, &noise);
+    const float value[TUNE_PARAM_COUNT] = {
+        noise.pos_std, noise.vel_std, noise.att_std, noise.gyro_bias_std, noise.accel_bias_std,
+        noise.gps_pos_std, noise.gps_vel_std, noise.baro_std, noise.mag_std
+    };
+    fprintf(out, "# noise_tune 보정 레코드 (비행 %u개, 후보 %llu개)\n", t->flight_count,
+            (unsigned long long)t->evaluations);
+    fprintf(out, "version=1\n");
+    fprintf(out, "objective=%.6f\n", cost);
+    fprintf(out, "objective_start=%.6f\n", start_cost);
+    for (int i = 0; i < TUNE_PARAM_COUNT; i++) {
+        fprintf(out, "%s=%.6g\n", tune_param_name[i], value[i]);
+    }
+}
+
+int main(int argc, char **argv) {
+    SimConfig sim;
+    sim_default_config(&sim);
+    sim.duration = TUNE_DEFAULT_DURATION;
+    Tuner t = { 0 };
+    replay_default_config(&t.base);
+    t.w_pos = TUNE_DEFAULT_POS_WEIGHT;
+    t.w_nis = TUNE_DEFAULT_NIS_WEIGHT;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    long seeds = -1;
+    uint64_t first = 1;
+    uint32_t iterations = TUNE_DEFAULT_ITERATIONS;
+    float noise_scale = 1.0f;
+    bool log_truth = false;
+    bool self_check = false;
+    bool usage = false;
+    const char *out_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:f:t:k:j:i:w:v:b:PrTo:")) != -1) {
+        switch (opt) {
+        case 'n':
+            seeds = strtol(optarg, NULL, 0);
+            break;
+        case 'f':
+            first = strtoull(optarg, NULL, 0);
+            break;
+        case 't':
+            sim.duration = strtod(optarg, NULL);
+            break;
+        case 'k':
+            noise_scale = strtof(optarg, NULL);
+            break;
+        case 'j':
+            jobs = strtol(optarg, NULL, 0);
+            break;
+        case 'i':
+            iterations = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            t.w_pos = strtod(optarg, NULL);
+            break;
+        case 'v':
+            t.w_nis = strtod(optarg, NULL);
+            break;
+        case 'b':
+            t.base.batch = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'P':
+            t.base.use_phase = false;
+            break;
+        case 'r':
+            log_truth = true;
+            break;
+        case 'T':
+            self_check = true;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        default:
+            usage = true;
+            break;
+        }
+    }
+    uint32_t logs = (uint32_t)(argc - optind);
+    if (seeds < 0) {
+        seeds = (logs > 0) ? 0 : TUNE_DEFAULT_SEEDS;
+    }
+    if (usage || t.base.batch == 0 || seeds + logs == 0) {
+        fprintf(stderr, "사용법: %s [-n 시드 수] [-f 첫 시드] [-t 길이(s)] [-k 잡음 배율] [-j 작업자 수] [-i 반복 수]\n"
+                "          [-w w_pos] [-v w_nis] [-b batch] [-P] [-r] [-T] [-o cal.txt] [flash.bin ...]\n", argv[0]);
+        return 1;
+    }
+    if (jobs < 1) {
+        jobs = 1;
+    }
+    t.jobs = (uint32_t)jobs;
+    sim_scale_noise(&sim, noise_scale);
+
+    t.flight_count = (uint32_t)seeds + logs;
+    t.flights = calloc(t.flight_count, sizeof(TuneFlight));
+    if (t.flights == NULL) {
+        perror("calloc");
+        return 1;
+    }
+    uint64_t load_start = now_ns();
+    size_t bytes = 0;
+    for (uint32_t i = 0; i < (uint32_t)seeds; i++) {
+        TuneFlight *flight = &t.flights[i];
+        flight->truth = true;
+        snprintf(flight->name, sizeof(flight->name), "시드 %llu", (unsigned long long)(first + i));
+        if (!replay_tape_begin_block(&flight->tape) || !sim_run(&sim, first + i, tune_emit, &flight->tape, NULL)) {
+            fprintf(stderr, "합성 비행 생성 실패\n");
+            return 1;
+        }
+        bytes += flight->tape.size;
+    }
+    for (uint32_t i = 0; i < logs; i++) {
+        TuneFlight *flight = &t.flights[seeds + i];
+        flight->truth = log_truth;
+        if (!tune_load_log(argv[optind + i], flight)) {
+            fprintf(stderr, "%s: 유효한 기록 없음\n", argv[optind + i]);
+            return 1;
+        }
+        bytes += flight->tape.size;
+    }
+    fprintf(stderr, "비행 %u개 (합성 %ld, 기록 %u), 레코드 열 %.1f MB, 준비 %.2f s, 작업자 %u\n", t.flight_count,
+            seeds, logs, (double)bytes / 1e6, (double)(now_ns() - load_start) * 1e-9, t.jobs);
+
+    double x[TUNE_PARAM_COUNT];
+    for (int i = 0; i < TUNE_PARAM_COUNT; i++) {
+        x[i] = log(tune_param_start[i]);
+    }
+    TuneScore *scores = malloc(t.flight_count * sizeof(TuneScore));
+    TuneScore *serial = malloc(t.flight_count * sizeof(TuneScore));
+    if (scores == NULL || serial == NULL) {
+        perror("malloc");
+        return 1;
+    }
+    double start_cost;
+    if (!tune_evaluate(&t, (const double (*)[TUNE_PARAM_COUNT])&x, 1, t.jobs, &start_cost, scores)) {
+        fprintf(stderr, "평가 실패\n");
+        return 1;
+    }
+    tune_report(&t, "시작", start_cost, scores);
+
+    int rc = 0;
+    if (self_check) {
+        double serial_cost;
+        bool same = tune_evaluate(&t, (const double (*)[TUNE_PARAM_COUNT])&x, 1, 1, &serial_cost, serial) &&
+                    memcmp(&serial_cost, &start_cost, sizeof(double)) == 0;
+        for (uint32_t f = 0; same && f < t.flight_count; f++) {
+            same = memcmp(&serial[f].cost, &scores[f].cost, sizeof(double)) == 0;
+        }
+        fprintf(stderr, "재진입 점검 (작업자 1 / %u): %s\n", t.jobs, same ? "일치" : "불일치");
+        if (!same) {
+            rc = 2;
+        }
+    }
+
+    double best;
+    uint32_t it = tune_search(&t, x, iterations, &best);
+    tune_evaluate(&t, (const double (*)[TUNE_PARAM_COUNT])&x, 1, t.jobs, &best, scores);
+    tune_report(&t, "최종", best, scores);
+    fprintf(stderr, "반복 %u회, 후보 %llu개, 재생 %llu회, %.2f s (재생당 %.2f ms, 후보당 %.2f ms)\n", it,
+            (unsigned long long)t.evaluations, (unsigned long long)t.replays, t.wall_s,
+            t.replays ? t.wall_s * 1e3 / (double)t.replays : 0.0,
+            t.evaluations ? t.wall_s * 1e3 / (double)t.evaluations : 0.0);
+
+    FILE *out = stdout;
+    if (out_path != NULL) {
+        out = fopen(out_path, "w");
+        if (out == NULL) {
+            perror(out_path);
+            return 1;
+        }
+    }
+    tune_write_record(out, &t, x, best, start_cost);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    for (uint32_t i = 0; i < t.flight_count; i++) {
+        replay_tape_free(&t.flights[i].tape);
+    }
+    free(t.flights);
+    free(scores);
+    free(serial);
+
+    return rc;
+}
@@ -0,0 +1,320 @@
+/**
+ * @file wmm_grid.c
+ * @brief 지구 자기장 격자 표 생성 프로그램 (호스트용)
+ *
+ * 구면 조화 계수로 격자점마다 편각/복각/전자기력을 계산하여
+ * Core/Src/ekf/ekf_wmm_table.c 를 표준 출력으로 생성한다.
+ * 격자 크기와 저장 단위는 ekf/ekf_wmm.h 를 그대로 사용한다.
+ *
+ * 계수 파일(NOAA WMM.COF 형식: 첫 줄 기준 연도, 이후 "n m g h dg dh")을 주면
+ * 해당 모델을 지정 연도로 외삽하여 사용하고, 없으면 내장 계수
+ * (IGRF-13 2020.0, 6차까지)를 사용한다.
+ * 생성 후 표준 오류로 격자 중간점 보간 오차를 출력한다.
+ *
+ * 빌드 및 실행 (저장소 루트에서):
+ *   gcc -std=gnu11 -O2 -ICore/Inc -o wmm_grid Tools/wmm/wmm_grid.c -lm
+ *   ./wmm_grid [WMM.COF [연도]] > Core/Src/ekf/ekf_wmm_table.c
+ */
+
+#include "ekf/ekf_wmm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief 지원 최대 차수
+ */
+#define WMM_MAX_DEGREE 12
+
+/**
+ * @brief 기준 구 반지름 (km)
+ */
+#define WMM_REFERENCE_RADIUS_KM 6371.2
+
+/**
+ * @brief WGS84 타원체
+ */
+#define WMM_WGS84_A_KM 6378.137
+#define WMM_WGS84_F (1.0 / 298.257223563)
+
+/**
+ * @brief 보간 오차 집계 위도 범위 (자극 부근 제외, 도)
+ */
+#define WMM_ERROR_LAT_LIMIT_DEG 50.0
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief 구면 조화 계수 (Schmidt 준정규화, nT)
+ */
+typedef struct {
+    int degree;
+    double g[WMM_MAX_DEGREE + 1][WMM_MAX_DEGREE + 1];
+    double h[WMM_MAX_DEGREE + 1][WMM_MAX_DEGREE + 1];
+    char name[64];
+} WmmModel;
+
+/**
+ * @brief 내장 계수 (IGRF-13, 2020.0, n <= 6)
+ */
+static const double wmm_builtin[][4] = {
+    { 1, 0, -29404.8,      0.0 }, { 1, 1,  -1450.9,   4652.5 },
+    { 2, 0,  -2499.6,      0.0 }, { 2, 1,   2982.0,  -2991.6 }, { 2, 2,   1677.0,   -734.6 },
+    { 3, 0,   1363.2,      0.0 }, { 3, 1,  -2381.2,    -82.1 }, { 3, 2,   1236.2,    241.9 },
+    { 3, 3,    525.7,   -543.4 },
+    { 4, 0,    903.0,      0.0 }, { 4, 1,    809.5,    281.9 }, { 4, 2,     86.3,   -158.4 },
+    { 4, 3,   -309.4,    199.7 }, { 4, 4,     48.0,   -349.7 },
+    { 5, 0,   -234.3,      0.0 }, { 5, 1,    363.2,     47.7 }, { 5, 2,    187.8,    208.3 },
+    { 5, 3,   -140.7,   -121.2 }, { 5, 4,   -151.2,     32.3 }, { 5, 5,     13.5,     98.9 },
+    { 6, 0,     66.0,      0.0 }, { 6, 1,     65.5,    -19.1 }, { 6, 2,     72.9,     25.1 },
+    { 6, 3,   -121.5,     52.8 }, { 6, 4,    -36.2,    -64.5 }, { 6, 5,     13.5,      8.9 },
+    { 6, 6,    -64.7,     68.1 },
+};
+
+/**
+ * @brief 내장 계수로 모델 설정
+ */
+static void wmm_load_builtin(WmmModel *model) {
+    memset(model, 0, sizeof(*model));
+    for (size_t i = 0; i < sizeof(wmm_builtin) / sizeof(wmm_builtin[0]); i++) {
+        int n = (int)wmm_builtin[i][0];
+        int m = (int)wmm_builtin[i][1];
+        model->g[n][m] = wmm_builtin[i][2];
+        model->h[n][m] = wmm_builtin[i][3];
+        if (n > model->degree) {
+            model->degree = n;
+        }
+    }
+    snprintf(model->name, sizeof(model->name), "IGRF-13 2020.0 (n <= 6)");
+}
+
+/**
+ * @brief WMM.COF 형식 계수 파일 읽기 (year가 0이면 기준 연도 사용)
+ */
+static int wmm_load_cof(WmmModel *model, const char *path, double year) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    memset(model, 0, sizeof(*model));
+
+    char line[256];
+    double epoch = 0.0;
+    char title[32] = "";
+    if (fgets(line, sizeof(line), fp) == NULL || sscanf(line, "%lf %31s", &epoch, title) < 1) {
+        fclose(fp);
+        return 0;
+    }
+    if (year == 0.0) {
+        year = epoch;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        int n, m;
+        double g, h, dg, dh;
+        if (sscanf(line, "%d %d %lf %lf %lf %lf", &n, &m, &g, &h, &dg, &dh) != 6) {
+            break;
+        }
+        if (n < 1 || n > WMM_MAX_DEGREE || m < 0 || m > n) {
+            continue;
+        }
+        model->g[n][m] = g + dg * (year - epoch);
+        model->h[n][m] = h + dh * (year - epoch);
+        if (n > model->degree) {
+            model->degree = n;
+        }
+    }
+    fclose(fp);
+
+    snprintf(model->name, sizeof(model->name), "%s at %.1f", title, year);
+    return model->degree > 0;
+}
+
+/**
+ * @brief 지표면(타원체 높이 0)에서 자기장 요소 계산
+ *
+ * @param decl 편각 (도)
+ * @param incl 복각 (도)
+ * @param intensity 전자기력 (nT)
+ */
+static void wmm_synthesize(const WmmModel *model, double lat_deg, double lon_deg,
+                           double *decl, double *incl, double *intensity) {
+    // 측지 위도 -> 지심 위도, 반지름
+    double phi = lat_deg * M_PI / 180.0;
+    double e2 = WMM_WGS84_F * (2.0 - WMM_WGS84_F);
+    double rn = WMM_WGS84_A_KM / sqrt(1.0 - e2 * sin(phi) * sin(phi));
+    double px = rn * cos(phi);
+    double pz = rn * (1.0 - e2) * sin(phi);
+    double r = sqrt(px * px + pz * pz);
+    double phic = atan2(pz, px);
+
+    double theta = M_PI / 2.0 - phic;
+    double lambda = lon_deg * M_PI / 180.0;
+    double ct = cos(theta);
+    double st = sin(theta);
+    if (st < 1e-10) {
+        st = 1e-10;
+    }
+
+    // Schmidt 준정규화 연관 르장드르 함수와 theta 미분
+    double P[WMM_MAX_DEGREE + 1][WMM_MAX_DEGREE + 1] = { { 0 } };
+    double dP[WMM_MAX_DEGREE + 1][WMM_MAX_DEGREE + 1] = { { 0 } };
+    P[0][0] = 1.0;
+    for (int n = 1; n <= model->degree; n++) {
+        for (int m = 0; m <= n; m++) {
+            if (n == m) {
+                double k = (m > 1) ? sqrt(1.0 - 1.0 / (2.0 * m)) : 1.0;
+                P[n][m] = k * st * P[n - 1][m - 1];
+                dP[n][m] = k * (ct * P[n - 1][m - 1] + st * dP[n - 1][m - 1]);
+            } else {
+                double k1 = (2.0 * n - 1.0) / sqrt((double)(n * n - m * m));
+                double k2 = (n - 2 >= m) ? sqrt((double)((n - 1) * (n - 1) - m * m) / (double)(n * n - m * m)) : 0.0;
+                double p2 = (n - 2 >= m) ? P[n - 2][m] : 0.0;
+                double dp2 = (n - 2 >= m) ? dP[n - 2][m] : 0.0;
+                P[n][m] = k1 * ct * P[n - 1][m] - k2 * p2;
+                dP[n][m] = k1 * (ct * dP[n - 1][m] - st * P[n - 1][m]) - k2 * dp2;
+            }
+        }
+    }
+
+    double br = 0.0, bt = 0.0, bp = 0.0;
+    for (int n = 1; n <= model->degree; n++) {
+        double ar = pow(WMM_REFERENCE_RADIUS_KM / r, n + 2);
+        for (int m = 0; m <= n; m++) {
+            double cm = cos(m * lambda);
+            double sm = sin(m * lambda);
+            double gh = model->g[n][m] * cm + model->h[n][m] * sm;
+            br += (n + 1) * ar * gh * P[n][m];
+            bt -= ar * gh * dP[n][m];
+            bp += ar * m * (model->g[n][m] * sm - model->h[n][m] * cm) * P[n][m] / st;
+        }
+    }
+
+    // 지심 (북, 동, 아래) -> 측지 좌표계로 회전
+    double x = -bt;
+    double y = bp;
+    double z = -br;
+    double psi = phi - phic;
+    double xg = x * cos(psi) - z * sin(psi);
+    double zg = x * sin(psi) + z * cos(psi);
+
+    *decl = atan2(y, xg) * 180.0 / M_PI;
+    *incl = atan2(zg, sqrt(xg * xg + y * y)) * 180.0 / M_PI;
+    *intensity = sqrt(xg * xg + y * y + zg * zg);
+}
+
+/**
+ * @brief 편각 차이를 [-180, 180)으로 정리
+ */
+static double wmm_wrap180(double deg) {
+    while (deg >= 180.0) {
+        deg -= 360.0;
+    }
+    while (deg < -180.0) {
+        deg += 360.0;
+    }
+    return deg;
+}
+
+/**
+ * @brief 표 하나 출력
+ */
+static void wmm_print_table(const char *name, const char *unit,
+                            int16_t table[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT]) {
+    printf("/**\n * @brief %s (%s)\n */\n", name, unit);
+    printf("const int16_t ekf_wmm_%s[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT] = {\n", name);
+    for (int i = 0; i < EKF_WMM_LAT_COUNT; i++) {
+        printf("    /* %+3d */ {", EKF_WMM_LAT_MIN_DEG + i * EKF_WMM_GRID_STEP_DEG);
+        for (int j = 0; j < EKF_WMM_LON_COUNT; j++) {
+            if (j > 0 && j % 12 == 0) {
+                printf("\n              ");
+            }
+            printf(" %6d%s", table[i][j], (j + 1 < EKF_WMM_LON_COUNT) ? "," : "");
+        }
+        printf(" }%s\n", (i + 1 < EKF_WMM_LAT_COUNT) ? "," : "");
+    }
+    printf("};\n");
+}
+
+int main(int argc, char **argv) {
+    static WmmModel model;
+    if (argc > 1) {
+        double year = (argc > 2) ? atof(argv[2]) : 0.0;
+        if (!wmm_load_cof(&model, argv[1], year)) {
+            fprintf(stderr, "계수 파일을 읽을 수 없음: %s\n", argv[1]);
+            return 1;
+        }
+    } else {
+        wmm_load_builtin(&model);
+    }
+
+    static int16_t decl[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT];
+    static int16_t incl[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT];
+    static int16_t inten[EKF_WMM_LAT_COUNT][EKF_WMM_LON_COUNT];
+    for (int i = 0; i < EKF_WMM_LAT_COUNT; i++) {
+        for (int j = 0; j < EKF_WMM_LON_COUNT; j++) {
+            double lat = EKF_WMM_LAT_MIN_DEG + i * EKF_WMM_GRID_STEP_DEG;
+            double lon = EKF_WMM_LON_MIN_DEG + (j % (EKF_WMM_LON_COUNT - 1)) * EKF_WMM_GRID_STEP_DEG;
+            // 극점에서는 경도가 정의되지 않으므로 극에 가까운 위도로 계산
+            if (lat > 89.9) {
+                lat = 89.9;
+            } else if (lat < -89.9) {
+                lat = -89.9;
+            }
+            double d, n, f;
+            wmm_synthesize(&model, lat, lon, &d, &n, &f);
+            decl[i][j] = (int16_t)lrint(d / EKF_WMM_ANGLE_SCALE);
+            incl[i][j] = (int16_t)lrint(n / EKF_WMM_ANGLE_SCALE);
+            inten[i][j] = (int16_t)lrint(f / EKF_WMM_INTENSITY_SCALE);
+        }
+    }
+
+    printf("/**\n");
+    printf(" * @file ekf_wmm_table.c\n");
+    printf(" * @brief 지구 자기장 격자 표 (Tools/wmm/wmm_grid.c 생성 파일, 직접 수정 금지)\n");
+    printf(" *\n");
+    printf(" * 모델: %s\n", model.name);
+    printf(" * 격자: %d도 간격, 위도 %d..%d, 경도 %d..%d\n", EKF_WMM_GRID_STEP_DEG,
+           EKF_WMM_LAT_MIN_DEG, -EKF_WMM_LAT_MIN_DEG, EKF_WMM_LON_MIN_DEG, -EKF_WMM_LON_MIN_DEG);
+    printf(" */\n\n");
+    printf("#include \"ekf/ekf_wmm.h\"\n\n");
+    wmm_print_table("declination", "0.01도", decl);
+    printf("\n");
+    wmm_print_table("inclination", "0.01도", incl);
+    printf("\n");
+    wmm_print_table("intensity", "10 nT", inten);
+
+    // 격자 중간점에서 보간 오차 (ekf_wmm.c와 같은 쌍선형 보간)
+    double err_decl = 0.0, err_incl = 0.0, err_inten = 0.0;
+    for (int i = 0; i + 1 < EKF_WMM_LAT_COUNT; i++) {
+        double lat = EKF_WMM_LAT_MIN_DEG + (i + 0.5) * EKF_WMM_GRID_STEP_DEG;
+        if (fabs(lat) > WMM_ERROR_LAT_LIMIT_DEG) {
+            continue;
+        }
+        for (int j = 0; j + 1 < EKF_WMM_LON_COUNT; j++) {
+            double lon = EKF_WMM_LON_MIN_DEG + (j + 0.5) * EKF_WMM_GRID_STEP_DEG;
+            double d, n, f;
+            wmm_synthesize(&model, lat, lon, &d, &n, &f);
+
+            double d0 = decl[i][j] * EKF_WMM_ANGLE_SCALE;
+            double di = 0.0;
+            di += wmm_wrap180(decl[i][j + 1] * EKF_WMM_ANGLE_SCALE - d0);
+            di += wmm_wrap180(decl[i + 1][j] * EKF_WMM_ANGLE_SCALE - d0);
+            di += wmm_wrap180(decl[i + 1][j + 1] * EKF_WMM_ANGLE_SCALE - d0);
+            double ni = (incl[i][j] + incl[i][j + 1] + incl[i + 1][j] + incl[i + 1][j + 1]) * 0.25 * EKF_WMM_ANGLE_SCALE;
+            double fi = (inten[i][j] + inten[i][j + 1] + inten[i + 1][j] + inten[i + 1][j + 1]) * 0.25 * EKF_WMM_INTENSITY_SCALE;
+
+            err_decl = fmax(err_decl, fabs(wmm_wrap180(d0 + di * 0.25 - d)));
+            err_incl = fmax(err_incl, fabs(ni - n));
+            err_inten = fmax(err_inten, fabs(fi - f));
+        }
+    }
+    fprintf(stderr, "보간 최대 오차 (|위도| <= %.0f도): 편각 %.2f도, 복각 %.2f도, 전자기력 %.0f nT\n",
+            WMM_ERROR_LAT_LIMIT_DEG, err_decl, err_incl, err_inten);
+
+    return 0;
+}